@@ -29,6 +29,7 @@ option(ENABLE_AVX    "Enable compile-time AVX support."    ON)
 option(ENABLE_AVX2   "Enable compile-time AVX2 support."   ON)
 option(ENABLE_FMA    "Enable compile-time FMA support."    ON)
 option(ENABLE_AVX512 "Enable compile-time AVX512 support." ON)
+option(ENABLE_PCLMUL "Enable compile-time PCLMULQDQ support." ON)
 
 if (ENABLE_SSE)
     #
@@ -53,7 +54,30 @@ if (ENABLE_SSE)
         message(STATUS "SSE4.1 is enabled - target CPU must support it")
     endif()
     
-    if (ENABLE_AVX)
+    if (ENABLE_PCLMUL AND NOT ENABLE_SIMD_DISPATCH)
+
+        #
+        # Check compiler for carry-less multiplication intrinsics
+        #
+        if (CMAKE_COMPILER_IS_GNUCC OR (CMAKE_C_COMPILER_ID MATCHES "Clang") OR (CMAKE_CXX_COMPILER_ID MATCHES "Clang"))
+            set(CMAKE_REQUIRED_FLAGS "-msse4.1 -mpclmul")
+            check_c_source_runs("
+            #include <wmmintrin.h>
+            int main()
+            {
+              __m128i a = _mm_set_epi64x(0, 3);
+              __m128i r = _mm_clmulepi64_si128(a, a, 0x00);
+              return (_mm_cvtsi128_si32(r) == 5) ? 0 : -1;
+            }"
+            HAVE_PCLMUL)
+        endif()
+
+        if (HAVE_PCLMUL)
+            message(STATUS "PCLMULQDQ is enabled - target CPU must support it")
+        endif()
+    endif()
+
+    if (ENABLE_AVX AND NOT ENABLE_SIMD_DISPATCH)
 
         #
         # Check compiler for AVX intrinsics
@@ -87,7 +111,7 @@ if (ENABLE_SSE)
         endif()
     endif()
     
-    if (ENABLE_AVX2)
+    if (ENABLE_AVX2 AND NOT ENABLE_SIMD_DISPATCH)
 
       #
       # Check compiler for AVX intrinsics
@@ -121,7 +145,7 @@ if (ENABLE_SSE)
       endif()
     endif()
 
-    if (ENABLE_FMA)
+    if (ENABLE_FMA AND NOT ENABLE_SIMD_DISPATCH)
 
         #
         # Check compiler for AVX intrinsics
@@ -156,7 +180,7 @@ if (ENABLE_SSE)
         endif()
     endif()
 
-    if (ENABLE_AVX512)
+    if (ENABLE_AVX512 AND NOT ENABLE_SIMD_DISPATCH)
 
         #
         # Check compiler for AVX intrinsics
@@ -207,4 +231,4 @@ if (ENABLE_SSE)
 
 endif()
 
-mark_as_advanced(HAVE_SSE, HAVE_AVX, HAVE_AVX2, HAVE_FMA, HAVE_AVX512)
+mark_as_advanced(HAVE_SSE, HAVE_AVX, HAVE_AVX2, HAVE_FMA, HAVE_AVX512, HAVE_PCLMUL)
@@ -0,0 +1,140 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Generates an FFTW wisdom bundle with the plans created by the eNB and UE, so that they start without measuring
+ * them. The output can be installed as the system wisdom (/etc/fftw/wisdomf) or imported with
+ * srsran_dft_import_wisdom().
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "srsran/srsran.h"
+
+static char* output_file_name = "wisdomf";
+
+static const uint32_t lte_nof_prb[] = {6, 15, 25, 50, 75, 100};
+
+// NR symbol sizes, including the ones used for 15 and 30 kHz SCS up to 100 MHz
+static const int nr_symbol_sz[] = {128, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096};
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [ov]\n", prog);
+  printf("\t-o output_file [Default %s]\n", output_file_name);
+  printf("\t-v srsran_verbose\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "ov")) != -1) {
+    switch (opt) {
+      case 'o':
+        output_file_name = argv[optind];
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static int plan_lte(uint32_t nof_prb, srsran_cp_t cp)
+{
+  int           ret     = SRSRAN_ERROR;
+  uint32_t      sf_len  = SRSRAN_SF_LEN_PRB(nof_prb);
+  uint32_t      nof_re  = SRSRAN_SF_LEN_RE(nof_prb, cp);
+  cf_t*         time_sf = srsran_vec_cf_malloc(sf_len);
+  cf_t*         freq_sf = srsran_vec_cf_malloc(nof_re);
+  srsran_ofdm_t ofdm_tx = {};
+  srsran_ofdm_t ofdm_rx = {};
+
+  if (time_sf && freq_sf && srsran_ofdm_tx_init(&ofdm_tx, cp, freq_sf, time_sf, nof_prb) == SRSRAN_SUCCESS &&
+      srsran_ofdm_rx_init(&ofdm_rx, cp, time_sf, freq_sf, nof_prb) == SRSRAN_SUCCESS) {
+    ret = SRSRAN_SUCCESS;
+  }
+
+  srsran_ofdm_tx_free(&ofdm_tx);
+  srsran_ofdm_rx_free(&ofdm_rx);
+  if (time_sf) {
+    free(time_sf);
+  }
+  if (freq_sf) {
+    free(freq_sf);
+  }
+  return ret;
+}
+
+static int plan_symbol(int symbol_sz)
+{
+  srsran_dft_plan_t fwd = {};
+  srsran_dft_plan_t bwd = {};
+  int               ret = SRSRAN_ERROR;
+
+  if (srsran_dft_plan_c(&fwd, symbol_sz, SRSRAN_DFT_FORWARD) == SRSRAN_SUCCESS &&
+      srsran_dft_plan_c(&bwd, symbol_sz, SRSRAN_DFT_BACKWARD) == SRSRAN_SUCCESS) {
+    ret = SRSRAN_SUCCESS;
+  }
+
+  srsran_dft_plan_free(&fwd);
+  srsran_dft_plan_free(&bwd);
+  return ret;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  // Wisdom is only accumulated by FFTW plans
+  srsran_dft_set_backend(SRSRAN_DFT_BACKEND_FFTW);
+
+  for (uint32_t i = 0; i < sizeof(lte_nof_prb) / sizeof(lte_nof_prb[0]); i++) {
+    for (srsran_cp_t cp = SRSRAN_CP_NORM; cp <= SRSRAN_CP_EXT; cp++) {
+      printf("Planning LTE %d PRB %s CP...\n", lte_nof_prb[i], srsran_cp_string(cp));
+      if (plan_lte(lte_nof_prb[i], cp) != SRSRAN_SUCCESS) {
+        ERROR("Error planning LTE %d PRB", lte_nof_prb[i]);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  for (uint32_t i = 0; i < sizeof(nr_symbol_sz) / sizeof(nr_symbol_sz[0]); i++) {
+    printf("Planning symbol size %d...\n", nr_symbol_sz[i]);
+    if (plan_symbol(nr_symbol_sz[i]) != SRSRAN_SUCCESS) {
+      ERROR("Error planning symbol size %d", nr_symbol_sz[i]);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  if (srsran_dft_export_wisdom(output_file_name) != SRSRAN_SUCCESS) {
+    ERROR("Error writing wisdom to %s", output_file_name);
+    return SRSRAN_ERROR;
+  }
+  printf("Wisdom written to %s\n", output_file_name);
+
+  return SRSRAN_SUCCESS;
+}
@@ -273,9 +273,15 @@ public:
   {
     assert_within_bounds_(start, false);
     assert_within_bounds_(stop, false);
-    // NOTE: can be optimized
-    for (size_t i = start; i < stop; ++i) {
-      if (test_(i)) {
+    if (start >= stop) {
+      return false;
+    }
+    size_t startbit, endbit;
+    get_bitrange_(start, stop, startbit, endbit);
+    size_t startword = startbit / bits_per_word;
+    size_t lastword  = (endbit - 1) / bits_per_word;
+    for (size_t i = startword; i <= lastword; ++i) {
+      if (get_masked_word_(i, startbit, endbit) != static_cast<word_t>(0)) {
         return true;
       }
     }
@@ -288,13 +294,25 @@ public:
   {
     size_t result = 0;
     for (size_t i = 0; i < nof_words_(); i++) {
-      //      result += __builtin_popcountl(buffer[i]);
-      // Note: use an "int" for count triggers popcount optimization if SSE instructions are enabled.
-      int c = 0;
-      for (word_t w = buffer[i]; w > 0; c++) {
-        w &= w - 1;
-      }
-      result += c;
+      result += popcount_(buffer[i]);
+    }
+    return result;
+  }
+
+  /// Number of bits set in the range [startpos, endpos)
+  size_t count(size_t startpos, size_t endpos) const noexcept
+  {
+    assert_range_bounds_(startpos, endpos);
+    if (startpos == endpos) {
+      return 0;
+    }
+    size_t startbit, endbit;
+    get_bitrange_(startpos, endpos, startbit, endbit);
+    size_t startword = startbit / bits_per_word;
+    size_t lastword  = (endbit - 1) / bits_per_word;
+    size_t result    = 0;
+    for (size_t i = startword; i <= lastword; ++i) {
+      result += popcount_(get_masked_word_(i, startbit, endbit));
     }
     return result;
   }
@@ -412,6 +430,37 @@ private:
 
   size_t get_bitidx_(size_t bitpos) const noexcept { return reversed ? size() - 1 - bitpos : bitpos; }
 
+  /// Converts the non-empty range of positions [startpos, endpos) into the range of buffer bits it covers
+  void get_bitrange_(size_t startpos, size_t endpos, size_t& startbit, size_t& endbit) const noexcept
+  {
+    startbit = reversed ? size() - endpos : startpos;
+    endbit   = reversed ? size() - startpos : endpos;
+  }
+
+  /// Word "i" of the buffer, with the bits outside [startbit, endbit) cleared
+  word_t get_masked_word_(size_t i, size_t startbit, size_t endbit) const noexcept
+  {
+    word_t w = buffer[i];
+    if (i == startbit / bits_per_word) {
+      w &= mask_lsb_zeros<word_t>(startbit % bits_per_word);
+    }
+    if (i == (endbit - 1) / bits_per_word) {
+      w &= mask_lsb_ones<word_t>((endbit - 1) % bits_per_word + 1);
+    }
+    return w;
+  }
+
+  static int popcount_(word_t w) noexcept
+  {
+    //      return __builtin_popcountl(w);
+    // Note: use an "int" for count triggers popcount optimization if SSE instructions are enabled.
+    int c = 0;
+    for (; w > 0; c++) {
+      w &= w - 1;
+    }
+    return c;
+  }
+
   bool test_(size_t bitpos) const noexcept
   {
     bitpos = get_bitidx_(bitpos);
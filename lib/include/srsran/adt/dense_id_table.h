@@ -0,0 +1,185 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_DENSE_ID_TABLE_H
+#define SRSRAN_DENSE_ID_TABLE_H
+
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Table of objects indexed by IDs that the table allocates itself. The low SlotBits bits of an ID are the index of
+ * the slot where the object is stored, and the high bits are the generation of the slot, which is incremented when
+ * the object is erased, so that a lookup is a bounds check and a comparison, and the IDs of erased objects do not
+ * match the objects that reuse their slots. The freed slots are reused in FIFO order, and slot 0 is never used, so
+ * that 0 is not a valid ID.
+ * Insertions invalidate the iterators and the references to the objects.
+ * @tparam T stored type, it must be default and move constructible
+ * @tparam IdBits number of bits of the IDs, at most 32
+ * @tparam SlotBits number of bits of the slot index, the table stores up to 2^SlotBits - 1 objects
+ */
+template <typename T, unsigned IdBits, unsigned SlotBits>
+class dense_id_table
+{
+  static_assert(IdBits <= 32 and SlotBits < IdBits, "Invalid dense_id_table ID format");
+
+  struct slot_t {
+    uint32_t id      = 0;
+    bool     present = false;
+    T        obj;
+  };
+
+  template <typename Obj, typename Table>
+  class iter_impl
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = Obj;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = Obj*;
+    using reference         = Obj&;
+
+    iter_impl(Table* table_, size_t idx_) : table(table_), idx(idx_)
+    {
+      if (idx < table->slots.size() and not table->slots[idx].present) {
+        ++(*this);
+      }
+    }
+    iter_impl& operator++()
+    {
+      while (++idx < table->slots.size() and not table->slots[idx].present) {
+      }
+      return *this;
+    }
+    reference operator*() const { return table->slots[idx].obj; }
+    pointer   operator->() const { return &table->slots[idx].obj; }
+    /// ID of the object pointed by the iterator
+    uint32_t id() const { return table->slots[idx].id; }
+
+    bool operator==(const iter_impl& other) const { return idx == other.idx and table == other.table; }
+    bool operator!=(const iter_impl& other) const { return not(*this == other); }
+
+  private:
+    Table* table;
+    size_t idx;
+  };
+
+public:
+  using iterator       = iter_impl<T, dense_id_table>;
+  using const_iterator = iter_impl<const T, const dense_id_table>;
+
+  static const uint32_t invalid_id = 0;
+  static const uint32_t max_size   = (1u << SlotBits) - 1;
+
+  dense_id_table() : slots(1) {}
+
+  size_t size() const { return nof_objs; }
+  bool   empty() const { return nof_objs == 0; }
+  bool   full() const { return nof_objs == max_size; }
+
+  iterator       begin() { return iterator(this, 1); }
+  iterator       end() { return iterator(this, slots.size()); }
+  const_iterator begin() const { return const_iterator(this, 1); }
+  const_iterator end() const { return const_iterator(this, slots.size()); }
+
+  /// Stores the object in a free slot and returns its ID, or invalid_id if the table is full
+  uint32_t insert(T obj)
+  {
+    uint32_t slot_idx;
+    if (not free_slots.empty()) {
+      slot_idx = free_slots.front();
+      free_slots.pop_front();
+    } else if (slots.size() <= max_size) {
+      slot_idx = slots.size();
+      slots.emplace_back();
+      slots.back().id = slot_idx;
+    } else {
+      return invalid_id;
+    }
+    slot_t& slot = slots[slot_idx];
+    slot.present = true;
+    slot.obj     = std::move(obj);
+    nof_objs++;
+    return slot.id;
+  }
+
+  T* find(uint32_t id)
+  {
+    uint32_t slot_idx = id & slot_mask;
+    if (slot_idx >= slots.size() or not slots[slot_idx].present or slots[slot_idx].id != id) {
+      return nullptr;
+    }
+    return &slots[slot_idx].obj;
+  }
+  const T* find(uint32_t id) const { return const_cast<dense_id_table*>(this)->find(id); }
+  bool     contains(uint32_t id) const { return find(id) != nullptr; }
+
+  /// Erases the object with the given ID, and returns false if it is not found
+  bool erase(uint32_t id)
+  {
+    if (find(id) == nullptr) {
+      return false;
+    }
+    uint32_t slot_idx = id & slot_mask;
+    slot_t&  slot     = slots[slot_idx];
+    slot.obj          = T{};
+    slot.present      = false;
+    // Next generation of the slot, the ID is never 0 since slot 0 is not used
+    slot.id = (slot.id + (1u << SlotBits)) & id_mask;
+    free_slots.push_back(slot_idx);
+    nof_objs--;
+    return true;
+  }
+
+  void clear()
+  {
+    for (uint32_t i = 1; i < slots.size(); ++i) {
+      if (slots[i].present) {
+        erase(slots[i].id);
+      }
+    }
+  }
+
+private:
+  static const uint32_t slot_mask = (1u << SlotBits) - 1;
+  static const uint32_t id_mask   = IdBits == 32 ? 0xffffffffu : (uint32_t)((1ull << IdBits) - 1);
+
+  std::vector<slot_t>  slots;
+  std::deque<uint32_t> free_slots;
+  size_t               nof_objs = 0;
+};
+
+template <typename T, unsigned IdBits, unsigned SlotBits>
+const uint32_t dense_id_table<T, IdBits, SlotBits>::invalid_id;
+template <typename T, unsigned IdBits, unsigned SlotBits>
+const uint32_t dense_id_table<T, IdBits, SlotBits>::max_size;
+template <typename T, unsigned IdBits, unsigned SlotBits>
+const uint32_t dense_id_table<T, IdBits, SlotBits>::slot_mask;
+template <typename T, unsigned IdBits, unsigned SlotBits>
+const uint32_t dense_id_table<T, IdBits, SlotBits>::id_mask;
+
+} // namespace srsran
+
+#endif // SRSRAN_DENSE_ID_TABLE_H
@@ -0,0 +1,205 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_CALLBACK_POOL_H
+#define SRSRAN_CALLBACK_POOL_H
+
+#include "type_storage.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace srsran {
+
+namespace detail {
+
+/// Counters of the callbacks that did not fit their small buffer
+struct callback_pool_stats {
+  uint64_t nof_spills      = 0; ///< callbacks stored outside of the small buffer
+  uint64_t nof_heap_allocs = 0; ///< spills that were not served by the pool
+};
+
+/**
+ * Pool of memory blocks for the callbacks that do not fit the small buffer of move_callback. The blocks are grouped in
+ * size classes of 64 to 512 bytes. Each thread keeps a cache of free blocks per class, and exchanges batches of blocks
+ * with a global depot when its cache runs empty or grows too large. Tasks are usually created in one thread and
+ * destroyed in another, so the depot moves the blocks back to the producing threads at the cost of one lock per batch.
+ */
+class callback_pool
+{
+  static constexpr size_t   min_block_shift = 6;
+  static constexpr size_t   nof_classes     = 4;
+  static constexpr size_t   max_block_size  = static_cast<size_t>(1U) << (min_block_shift + nof_classes - 1);
+  static constexpr uint32_t batch_size      = 32;
+
+  struct block_t {
+    block_t* next;
+    block_t* next_batch; ///< used in the depot, only valid for the first block of a batch
+    uint32_t batch_len;  ///< used in the depot, only valid for the first block of a batch
+  };
+
+  struct depot_t {
+    std::mutex mutex;
+    block_t*   batches[nof_classes] = {};
+    ~depot_t()
+    {
+      for (block_t*& b : batches) {
+        while (b != nullptr) {
+          block_t* next_batch = b->next_batch;
+          while (b != nullptr) {
+            block_t* next = b->next;
+            ::operator delete(b);
+            b = next;
+          }
+          b = next_batch;
+        }
+      }
+    }
+  };
+
+  struct thread_cache_t {
+    block_t* head[nof_classes]  = {};
+    uint32_t count[nof_classes] = {};
+    ~thread_cache_t()
+    {
+      for (size_t cls = 0; cls < nof_classes; ++cls) {
+        if (head[cls] != nullptr) {
+          push_batch(cls, head[cls], count[cls]);
+        }
+      }
+    }
+  };
+
+  static depot_t& depot()
+  {
+    static depot_t d;
+    return d;
+  }
+  static thread_cache_t& cache()
+  {
+    static thread_local thread_cache_t c;
+    return c;
+  }
+  static std::atomic<uint64_t>& spill_counter()
+  {
+    static std::atomic<uint64_t> c{0};
+    return c;
+  }
+  static std::atomic<uint64_t>& heap_counter()
+  {
+    static std::atomic<uint64_t> c{0};
+    return c;
+  }
+
+  static size_t size_class(size_t sz)
+  {
+    size_t cls = 0;
+    while ((static_cast<size_t>(1U) << (min_block_shift + cls)) < sz) {
+      cls++;
+    }
+    return cls;
+  }
+
+  static void push_batch(size_t cls, block_t* first, uint32_t len)
+  {
+    depot_t&                    d = depot();
+    std::lock_guard<std::mutex> lock(d.mutex);
+    first->batch_len  = len;
+    first->next_batch = d.batches[cls];
+    d.batches[cls]    = first;
+  }
+
+  static block_t* pop_batch(size_t cls, uint32_t& len)
+  {
+    depot_t&                    d = depot();
+    std::lock_guard<std::mutex> lock(d.mutex);
+    block_t*                    first = d.batches[cls];
+    if (first != nullptr) {
+      d.batches[cls] = first->next_batch;
+      len            = first->batch_len;
+    }
+    return first;
+  }
+
+public:
+  /// Returns memory for an object of size sz and alignment align
+  static void* allocate(size_t sz, size_t align)
+  {
+    spill_counter().fetch_add(1, std::memory_order_relaxed);
+    if (sz > max_block_size or align > max_alignment) {
+      heap_counter().fetch_add(1, std::memory_order_relaxed);
+      return ::operator new(sz);
+    }
+    size_t          cls = size_class(sz);
+    thread_cache_t& c   = cache();
+    if (c.head[cls] == nullptr) {
+      c.head[cls] = pop_batch(cls, c.count[cls]);
+      if (c.head[cls] == nullptr) {
+        heap_counter().fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(static_cast<size_t>(1U) << (min_block_shift + cls));
+      }
+    }
+    block_t* b  = c.head[cls];
+    c.head[cls] = b->next;
+    c.count[cls]--;
+    return b;
+  }
+
+  /// Releases the memory returned by allocate() with the same size and alignment
+  static void deallocate(void* p, size_t sz, size_t align)
+  {
+    if (sz > max_block_size or align > max_alignment) {
+      ::operator delete(p);
+      return;
+    }
+    size_t          cls = size_class(sz);
+    thread_cache_t& c   = cache();
+    block_t*        b   = static_cast<block_t*>(p);
+    b->next             = c.head[cls];
+    c.head[cls]         = b;
+    if (++c.count[cls] >= 2 * batch_size) {
+      // hand the last half of the cache to the depot
+      block_t* last = b;
+      for (uint32_t i = 1; i < batch_size; ++i) {
+        last = last->next;
+      }
+      push_batch(cls, last->next, c.count[cls] - batch_size);
+      last->next   = nullptr;
+      c.count[cls] = batch_size;
+    }
+  }
+
+  static callback_pool_stats get_stats()
+  {
+    callback_pool_stats stats;
+    stats.nof_spills      = spill_counter().load(std::memory_order_relaxed);
+    stats.nof_heap_allocs = heap_counter().load(std::memory_order_relaxed);
+    return stats;
+  }
+};
+
+} // namespace detail
+
+} // namespace srsran
+
+#endif // SRSRAN_CALLBACK_POOL_H
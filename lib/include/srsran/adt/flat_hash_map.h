@@ -0,0 +1,361 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_FLAT_HASH_MAP_H
+#define SRSRAN_FLAT_HASH_MAP_H
+
+#include "detail/type_storage.h"
+#include "srsran/support/srsran_assert.h"
+#include <memory>
+
+namespace srsran {
+
+/**
+ * Hash map with integer keys and open addressing. The elements are stored in a single array of slots, probed
+ * linearly from the slot given by the Fibonacci hash of the key, so that lookups of dense (e.g. sequential IDs) and
+ * sparse keys alike touch one or two cache lines and insertions do not allocate unless the table grows. The table
+ * doubles its size when it is 3/4 full and the erasures shift the following elements back instead of leaving
+ * tombstones.
+ * Insertions invalidate the iterators and the references to the elements, erasures invalidate the iterators.
+ * @tparam K integer key type
+ * @tparam T mapped type, it must be move constructible
+ */
+template <typename K, typename T>
+class flat_hash_map
+{
+  static_assert(std::is_integral<K>::value, "Map key must be an integer");
+
+public:
+  using key_type    = K;
+  using mapped_type = T;
+  using value_type  = std::pair<K, T>;
+
+private:
+  struct slot_t {
+    bool                             present = false;
+    detail::type_storage<value_type> storage;
+  };
+
+  template <bool Const>
+  class iter_impl
+  {
+    using map_ptr = typename std::conditional<Const, const flat_hash_map*, flat_hash_map*>::type;
+    using obj_t   = typename std::conditional<Const, const std::pair<K, T>, std::pair<K, T> >::type;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = obj_t;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = obj_t*;
+    using reference         = obj_t&;
+
+    iter_impl() = default;
+    iter_impl(map_ptr map_, size_t idx_) : map(map_), idx(idx_)
+    {
+      if (idx < map->capacity() and not map->slots[idx].present) {
+        ++(*this);
+      }
+    }
+    // Conversion to const_iterator
+    operator iter_impl<true>() const { return iter_impl<true>(map, idx); }
+
+    iter_impl& operator++()
+    {
+      while (++idx < map->capacity() and not map->slots[idx].present) {
+      }
+      return *this;
+    }
+
+    obj_t& operator*() const
+    {
+      srsran_assert(idx < map->capacity(), "Iterator out-of-bounds (%zd >= %zd)", idx, map->capacity());
+      return map->slots[idx].storage.get();
+    }
+    obj_t* operator->() const { return &(**this); }
+
+    bool operator==(const iter_impl& other) const { return map == other.map and idx == other.idx; }
+    bool operator!=(const iter_impl& other) const { return not(*this == other); }
+
+  private:
+    map_ptr map = nullptr;
+    size_t  idx = 0;
+  };
+
+public:
+  using iterator       = iter_impl<false>;
+  using const_iterator = iter_impl<true>;
+
+  flat_hash_map() = default;
+  flat_hash_map(const flat_hash_map& other)
+  {
+    reserve(other.size());
+    for (const value_type& obj : other) {
+      emplace(obj.first, obj.second);
+    }
+  }
+  flat_hash_map(flat_hash_map&& other) noexcept :
+    slots(std::move(other.slots)), mask(other.mask), shift(other.shift), nof_elems(other.nof_elems)
+  {
+    other.mask      = 0;
+    other.nof_elems = 0;
+  }
+  ~flat_hash_map() { clear(); }
+  flat_hash_map& operator=(const flat_hash_map& other)
+  {
+    if (this != &other) {
+      flat_hash_map tmp(other);
+      *this = std::move(tmp);
+    }
+    return *this;
+  }
+  flat_hash_map& operator=(flat_hash_map&& other) noexcept
+  {
+    if (this != &other) {
+      clear();
+      slots           = std::move(other.slots);
+      mask            = other.mask;
+      shift           = other.shift;
+      nof_elems       = other.nof_elems;
+      other.mask      = 0;
+      other.nof_elems = 0;
+    }
+    return *this;
+  }
+
+  size_t size() const { return nof_elems; }
+  bool   empty() const { return nof_elems == 0; }
+  size_t capacity() const { return slots == nullptr ? 0 : mask + 1; }
+
+  iterator       begin() { return iterator(this, 0); }
+  iterator       end() { return iterator(this, capacity()); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, capacity()); }
+
+  iterator find(K key)
+  {
+    size_t idx = find_idx(key);
+    return idx == npos ? end() : iterator(this, idx);
+  }
+  const_iterator find(K key) const
+  {
+    size_t idx = find_idx(key);
+    return idx == npos ? end() : const_iterator(this, idx);
+  }
+  bool   contains(K key) const { return find_idx(key) != npos; }
+  size_t count(K key) const { return contains(key) ? 1 : 0; }
+
+  /// Constructs the element in place if the key is not present. Returns the element and whether it was inserted
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(K key, Args&&... args)
+  {
+    size_t idx = find_idx(key);
+    if (idx != npos) {
+      return {iterator(this, idx), false};
+    }
+    if ((nof_elems + 1) * 4 > capacity() * 3) {
+      rehash(std::max(capacity() * 2, min_capacity));
+    }
+    idx = free_idx(key);
+    slots[idx].storage.emplace(std::piecewise_construct,
+                               std::forward_as_tuple(key),
+                               std::forward_as_tuple(std::forward<Args>(args)...));
+    slots[idx].present = true;
+    nof_elems++;
+    return {iterator(this, idx), true};
+  }
+  std::pair<iterator, bool> insert(const value_type& obj) { return emplace(obj.first, obj.second); }
+  std::pair<iterator, bool> insert(value_type&& obj) { return emplace(obj.first, std::move(obj.second)); }
+
+  /// Returns the element of the key, default constructed if not present
+  T& operator[](K key) { return emplace(key).first->second; }
+
+  size_t erase(K key)
+  {
+    size_t hole = find_idx(key);
+    if (hole == npos) {
+      return 0;
+    }
+    destroy_slot(hole);
+    // Shift back the elements of the probe sequence that can take the hole, i.e. whose home slot is not after it
+    for (size_t idx = (hole + 1) & mask; slots[idx].present; idx = (idx + 1) & mask) {
+      size_t home = hash_idx(slots[idx].storage.get().first);
+      if (((idx - home) & mask) >= ((idx - hole) & mask)) {
+        slots[hole].storage.emplace(std::move(slots[idx].storage.get()));
+        slots[hole].present = true;
+        destroy_slot(idx);
+        hole = idx;
+      }
+    }
+    nof_elems--;
+    return 1;
+  }
+
+  void clear()
+  {
+    for (size_t i = 0; i < capacity() and nof_elems > 0; ++i) {
+      if (slots[i].present) {
+        destroy_slot(i);
+        nof_elems--;
+      }
+    }
+    nof_elems = 0;
+  }
+
+  /// Grows the table to hold at least n elements without rehashing
+  void reserve(size_t n)
+  {
+    size_t cap = min_capacity;
+    while (cap * 3 < n * 4) {
+      cap *= 2;
+    }
+    if (cap > capacity()) {
+      rehash(cap);
+    }
+  }
+
+private:
+  static const size_t npos         = std::numeric_limits<size_t>::max();
+  static const size_t min_capacity = 16;
+
+  size_t hash_idx(K key) const
+  {
+    return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9e3779b97f4a7c15ULL) >> shift) & mask;
+  }
+
+  size_t find_idx(K key) const
+  {
+    if (nof_elems == 0) {
+      return npos;
+    }
+    for (size_t idx = hash_idx(key); slots[idx].present; idx = (idx + 1) & mask) {
+      if (slots[idx].storage.get().first == key) {
+        return idx;
+      }
+    }
+    return npos;
+  }
+
+  size_t free_idx(K key) const
+  {
+    size_t idx = hash_idx(key);
+    while (slots[idx].present) {
+      idx = (idx + 1) & mask;
+    }
+    return idx;
+  }
+
+  void destroy_slot(size_t idx)
+  {
+    slots[idx].storage.destroy();
+    slots[idx].present = false;
+  }
+
+  void rehash(size_t new_capacity)
+  {
+    size_t                    old_capacity = capacity();
+    std::unique_ptr<slot_t[]> old_slots(std::move(slots));
+    slots.reset(new slot_t[new_capacity]);
+    mask  = new_capacity - 1;
+    shift = 64;
+    for (size_t cap = new_capacity; cap > 1; cap /= 2) {
+      shift--;
+    }
+    for (size_t i = 0; i < old_capacity; ++i) {
+      if (old_slots[i].present) {
+        size_t idx = free_idx(old_slots[i].storage.get().first);
+        slots[idx].storage.emplace(std::move(old_slots[i].storage.get()));
+        slots[idx].present = true;
+        old_slots[i].storage.destroy();
+      }
+    }
+  }
+
+  std::unique_ptr<slot_t[]> slots;
+  size_t                    mask      = 0;
+  uint32_t                  shift     = 64;
+  size_t                    nof_elems = 0;
+};
+
+/// Hash set with integer keys and open addressing, see flat_hash_map
+template <typename K>
+class flat_hash_set
+{
+  struct empty_t {};
+  using map_t = flat_hash_map<K, empty_t>;
+
+public:
+  using key_type   = K;
+  using value_type = K;
+
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = const K;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const K*;
+    using reference         = const K&;
+
+    const_iterator() = default;
+    explicit const_iterator(typename map_t::const_iterator it_) : it(it_) {}
+
+    const_iterator& operator++()
+    {
+      ++it;
+      return *this;
+    }
+    const K& operator*() const { return it->first; }
+    const K* operator->() const { return &it->first; }
+
+    bool operator==(const const_iterator& other) const { return it == other.it; }
+    bool operator!=(const const_iterator& other) const { return it != other.it; }
+
+  private:
+    typename map_t::const_iterator it;
+  };
+  using iterator = const_iterator;
+
+  size_t size() const { return map.size(); }
+  bool   empty() const { return map.empty(); }
+
+  const_iterator begin() const { return const_iterator(map.begin()); }
+  const_iterator end() const { return const_iterator(map.end()); }
+
+  const_iterator find(K key) const { return const_iterator(map.find(key)); }
+  bool           contains(K key) const { return map.contains(key); }
+  size_t         count(K key) const { return map.count(key); }
+
+  std::pair<const_iterator, bool> insert(K key)
+  {
+    auto ret = map.emplace(key);
+    return {const_iterator(ret.first), ret.second};
+  }
+  size_t erase(K key) { return map.erase(key); }
+  void   clear() { map.clear(); }
+  void   reserve(size_t n) { map.reserve(n); }
+
+private:
+  map_t map;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_FLAT_HASH_MAP_H
@@ -22,8 +22,10 @@
 #ifndef SRSRAN_INTERVAL_H
 #define SRSRAN_INTERVAL_H
 
+#include "srsran/adt/bounded_vector.h"
 #include "srsran/srslog/bundled/fmt/format.h"
 #include "srsran/support/srsran_assert.h"
+#include <algorithm>
 #include <cassert>
 #include <string>
 #include <type_traits>
@@ -152,6 +154,72 @@ interval<T> make_intersection(const interval<T>& lhs, const interval<T>& rhs)
   return lhs & rhs;
 }
 
+/// Set of up to N disjoint intervals sorted by start point. Overlapping or adjacent intervals are merged on insertion
+template <typename T, size_t N>
+class bounded_interval_set
+{
+  using container_t = bounded_vector<interval<T>, N>;
+
+public:
+  using const_iterator = typename container_t::const_iterator;
+
+  bool               empty() const { return intervals.empty(); }
+  size_t             size() const { return intervals.size(); }
+  void               clear() { intervals.clear(); }
+  const_iterator     begin() const { return intervals.begin(); }
+  const_iterator     end() const { return intervals.end(); }
+  const interval<T>& front() const { return intervals.front(); }
+  const interval<T>& back() const { return intervals.back(); }
+
+  /// Checks whether any point of the given interval is already in the set
+  bool overlaps(const interval<T>& other) const
+  {
+    // first interval that ends after the start of the given one
+    auto it = std::upper_bound(intervals.begin(), intervals.end(), other.start(), [](T p, const interval<T>& i) {
+      return p < i.stop();
+    });
+    return it != intervals.end() and it->overlaps(other);
+  }
+
+  /// Adds an interval to the set. Returns false, leaving the set unchanged, if it would need more than N intervals
+  bool insert(interval<T> other)
+  {
+    if (other.empty()) {
+      return true;
+    }
+    // Merge all the intervals that overlap or touch the new one
+    auto first = first_not_before(other.start());
+    auto last  = first;
+    while (last != intervals.end() and last->start() <= other.stop()) {
+      other.set(std::min(other.start(), last->start()), std::max(other.stop(), last->stop()));
+      ++last;
+    }
+    if (first != last) {
+      *first = other;
+      intervals.erase(first + 1, last);
+      return true;
+    }
+    if (intervals.size() == N) {
+      return false;
+    }
+    size_t pos = first - intervals.begin();
+    intervals.push_back(other);
+    std::rotate(intervals.begin() + pos, intervals.end() - 1, intervals.end());
+    return true;
+  }
+
+private:
+  /// First interval whose stop point is not before the given point, i.e. the first one that may overlap or touch it
+  typename container_t::iterator first_not_before(T point)
+  {
+    return std::lower_bound(intervals.begin(), intervals.end(), point, [](const interval<T>& i, T p) {
+      return i.stop() < p;
+    });
+  }
+
+  container_t intervals;
+};
+
 } // namespace srsran
 
 namespace fmt {
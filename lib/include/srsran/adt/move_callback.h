@@ -22,6 +22,7 @@
 #ifndef SRSRAN_MOVE_CALLBACK_H
 #define SRSRAN_MOVE_CALLBACK_H
 
+#include "detail/callback_pool.h"
 #include "detail/type_storage.h"
 #include "srsran/support/srsran_assert.h"
 #include <cstddef>
@@ -41,8 +42,20 @@
 
 namespace srsran {
 
+// The small buffer sizes can be set at build time (e.g. -DMOVE_TASK_BUFFER_SIZE=128 in CMake)
+#ifndef SRSRAN_MOVE_CALLBACK_BUFFER_SIZE
+#define SRSRAN_MOVE_CALLBACK_BUFFER_SIZE 32
+#endif
+#ifndef SRSRAN_MOVE_TASK_BUFFER_SIZE
+#define SRSRAN_MOVE_TASK_BUFFER_SIZE 64
+#endif
+
 //! Size of the buffer used by "move_callback<R(Args...)>" to store functors without calling "new"
-constexpr size_t default_move_callback_buffer_size = 32;
+constexpr size_t default_move_callback_buffer_size = SRSRAN_MOVE_CALLBACK_BUFFER_SIZE;
+//! Size of the buffer of the generic move task "move_task_t"
+constexpr size_t move_task_buffer_size = SRSRAN_MOVE_TASK_BUFFER_SIZE;
+static_assert(default_move_callback_buffer_size >= 32, "The callbacks of the task pools need at least 32 bytes");
+static_assert(move_task_buffer_size >= 64, "The deferred stack tasks need at least 64 bytes");
 
 template <class Signature, size_t Capacity = default_move_callback_buffer_size, bool ForbidAlloc = false>
 class move_callback;
@@ -92,7 +105,8 @@ public:
   bool is_in_small_buffer() const final { return true; }
 };
 
-//! move/call/destroy operations for when the functor is stored outside of "move_callback<R(Args...)>" buffer
+//! move/call/destroy operations for when the functor is stored outside of "move_callback<R(Args...)>" buffer, in
+//! memory of the callback pool
 template <typename FunT, typename R, typename... Args>
 class heap_table_t : public oper_table_t<R, Args...>
 {
@@ -104,7 +118,14 @@ public:
     *static_cast<FunT**>(dest) = *static_cast<FunT**>(src);
     *static_cast<FunT**>(src)  = nullptr;
   }
-  void dtor(void* src) const final { delete (*static_cast<FunT**>(src)); }
+  void dtor(void* src) const final
+  {
+    FunT* f = *static_cast<FunT**>(src);
+    if (f != nullptr) {
+      f->~FunT();
+      detail::callback_pool::deallocate(f, sizeof(FunT), alignof(FunT));
+    }
+  }
   bool is_in_small_buffer() const final { return false; }
 };
 
@@ -155,7 +176,8 @@ public:
     using FunT = typename std::decay<T>::type;
     static const task_details::heap_table_t<FunT, R, Args...> heap_oper_table{};
     oper_ptr = &heap_oper_table;
-    ptr      = static_cast<void*>(new FunT{std::forward<T>(function)});
+    ptr      = detail::callback_pool::allocate(sizeof(FunT), alignof(FunT));
+    ::new (ptr) FunT{std::forward<T>(function)};
   }
 
   move_callback(move_callback&& other) noexcept : oper_ptr(other.oper_ptr)
@@ -192,7 +214,13 @@ template <typename R, typename... Args, size_t Capacity, bool ForbidAlloc>
 constexpr task_details::empty_table_t<R, Args...> move_callback<R(Args...), Capacity, ForbidAlloc>::empty_table;
 
 //! Generic move task
-using move_task_t = move_callback<void(), 64>;
+using move_task_t = move_callback<void(), move_task_buffer_size>;
+
+//! Number of callbacks that did not fit their small buffer, and of those that needed a heap allocation
+inline detail::callback_pool_stats get_move_callback_stats()
+{
+  return detail::callback_pool::get_stats();
+}
 
 } // namespace srsran
 
@@ -0,0 +1,307 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_MPMC_QUEUE_H
+#define SRSRAN_MPMC_QUEUE_H
+
+#include "srsran/adt/detail/type_storage.h"
+#include "srsran/adt/expected.h"
+#include "srsran/common/futex_util.h"
+#include "srsran/support/srsran_assert.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace srsran {
+
+/**
+ * Bounded multi-producer/multi-consumer queue with the same API as dyn_blocking_queue, without the push/pop callbacks.
+ * Features:
+ * - try_push/try_pop are lock-free. Each cell of the ring carries a sequence number that tells whether it is free for
+ *   the producer of a given position or filled for its consumer, so producers and consumers only contend on the
+ *   atomic position they reserve (D. Vyukov's bounded MPMC queue).
+ * - push_blocking/pop_blocking spin for a short time and then sleep on a futex. The threads that complete an operation
+ *   only make a system call when another thread has announced that it sleeps on the opposite condition, and only the
+ *   first one after the announcement does.
+ * - Size can be defined at runtime, it does not need to be a power of 2.
+ * @tparam T value type stored by the queue
+ */
+template <typename T>
+class mpmc_queue
+{
+  struct cell_t {
+    std::atomic<size_t>     seq;
+    detail::type_storage<T> value;
+  };
+
+  /// Attempts of a blocking operation before the thread goes to sleep. Spinning is useless with a single CPU
+  static uint32_t get_spin_count()
+  {
+    static const uint32_t spin_count = std::thread::hardware_concurrency() > 1 ? 128 : 0;
+    return spin_count;
+  }
+
+public:
+  using value_type = T;
+
+  mpmc_queue() = default;
+  explicit mpmc_queue(size_t size) { set_size(size); }
+  mpmc_queue(const mpmc_queue&) = delete;
+  mpmc_queue(mpmc_queue&&)      = delete;
+  mpmc_queue& operator=(const mpmc_queue&) = delete;
+  mpmc_queue& operator=(mpmc_queue&&) = delete;
+  ~mpmc_queue()
+  {
+    stop();
+    clear();
+  }
+
+  /// Sets the capacity of the queue. It must be called while the queue is empty and not accessed by other threads
+  void set_size(size_t size)
+  {
+    srsran_assert(size > 0, "The capacity of the queue must be positive");
+    srsran_assert(empty(), "The queue must be empty to be resized");
+    capacity = size;
+    cells.reset(new cell_t[size]);
+    for (size_t i = 0; i < size; ++i) {
+      cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+    enqueue_pos.store(0, std::memory_order_relaxed);
+    dequeue_pos.store(0, std::memory_order_relaxed);
+  }
+
+  /// Rejects new elements, wakes up the blocked threads and empties the queue
+  void stop()
+  {
+    if (not active.exchange(false, std::memory_order_acq_rel)) {
+      return;
+    }
+    while (nof_pop_waiters.load(std::memory_order_acquire) > 0 or
+           nof_push_waiters.load(std::memory_order_acquire) > 0) {
+      not_empty.fetch_add(2U, std::memory_order_release);
+      not_full.fetch_add(2U, std::memory_order_release);
+      futex_wake_all(not_empty);
+      futex_wake_all(not_full);
+      std::this_thread::yield();
+    }
+    clear();
+  }
+
+  bool                  try_push(const T& t) { return push_(t, false); }
+  srsran::error_type<T> try_push(T&& t) { return push_(std::move(t), false); }
+  bool                  push_blocking(const T& t) { return push_(t, true); }
+  srsran::error_type<T> push_blocking(T&& t) { return push_(std::move(t), true); }
+  bool                  try_pop(T& obj) { return pop_(obj, false); }
+  T                     pop_blocking(bool* success = nullptr)
+  {
+    T    obj{};
+    bool ret = pop_(obj, true);
+    if (success != nullptr) {
+      *success = ret;
+    }
+    return obj;
+  }
+  bool pop_wait_until(T& obj, const std::chrono::steady_clock::time_point& until) { return pop_(obj, true, &until); }
+  void clear()
+  {
+    T obj;
+    while (try_pop_(obj)) {
+    }
+  }
+
+  /// Number of elements in the queue, only exact while no other thread is accessing it
+  size_t size() const
+  {
+    size_t head = dequeue_pos.load(std::memory_order_relaxed);
+    size_t tail = enqueue_pos.load(std::memory_order_relaxed);
+    return tail > head ? std::min(tail - head, capacity) : 0;
+  }
+  bool   empty() const { return size() == 0; }
+  bool   full() const { return size() == capacity; }
+  size_t max_size() const { return capacity; }
+  bool   is_stopped() const { return not active.load(std::memory_order_relaxed); }
+
+private:
+  template <typename U>
+  bool try_push_(U&& t)
+  {
+    if (capacity == 0) {
+      return false;
+    }
+    cell_t* cell;
+    size_t  pos = enqueue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      cell        = &cells[pos % capacity];
+      size_t   seq = cell->seq.load(std::memory_order_acquire);
+      intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (dif == 0) {
+        if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        // The cell still holds the element of the previous lap, the queue is full
+        return false;
+      } else {
+        pos = enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value.emplace(std::forward<U>(t));
+    cell->seq.store(pos + 1, std::memory_order_release);
+    notify_(not_empty);
+    return true;
+  }
+
+  bool try_pop_(T& obj)
+  {
+    if (capacity == 0) {
+      return false;
+    }
+    cell_t* cell;
+    size_t  pos = dequeue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      cell        = &cells[pos % capacity];
+      size_t   seq = cell->seq.load(std::memory_order_acquire);
+      intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (dif == 0) {
+        if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        // The cell has not been filled yet, the queue is empty
+        return false;
+      } else {
+        pos = dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    obj = std::move(cell->value.get());
+    cell->value.destroy();
+    cell->seq.store(pos + capacity, std::memory_order_release);
+    notify_(not_full);
+    return true;
+  }
+
+  /// Wakes up the threads sleeping on the event, if any. The fence orders the publication of the element before the
+  /// read of the event, whose lowest bit the sleeping side sets before checking the queue again
+  static void notify_(std::atomic<uint32_t>& event)
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint32_t val = event.load(std::memory_order_relaxed);
+    if ((val & 1U) != 0 and event.compare_exchange_strong(val, (val + 2U) & ~1U, std::memory_order_relaxed)) {
+      futex_wake_all(event);
+    }
+  }
+
+  /// Runs op until it succeeds, the queue is stopped or the deadline expires. Returns whether op succeeded
+  template <typename Op>
+  bool wait_(const Op&                                    op,
+             std::atomic<uint32_t>&                       event,
+             std::atomic<uint32_t>&                       nof_waiters,
+             const std::chrono::steady_clock::time_point* until = nullptr)
+  {
+    for (uint32_t i = 0, n = get_spin_count(); i < n; ++i) {
+      cpu_relax();
+      if (op()) {
+        return true;
+      }
+    }
+    bool ret = false;
+    nof_waiters.fetch_add(1, std::memory_order_relaxed);
+    while (true) {
+      // Announce the sleep, so that the next notify_() advances the event and wakes this thread up
+      uint32_t val = event.fetch_or(1U, std::memory_order_seq_cst) | 1U;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (op()) {
+        ret = true;
+        break;
+      }
+      if (not active.load(std::memory_order_acquire)) {
+        break;
+      }
+      if (until == nullptr) {
+        futex_wait(event, val);
+      } else {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= *until) {
+          break;
+        }
+        futex_wait_for(event, val, std::chrono::duration_cast<std::chrono::nanoseconds>(*until - now).count());
+      }
+    }
+    nof_waiters.fetch_sub(1, std::memory_order_release);
+    return ret;
+  }
+
+  bool push_(const T& t, bool block_mode)
+  {
+    if (not active.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    if (try_push_(t)) {
+      return true;
+    }
+    return block_mode and wait_([this, &t]() { return try_push_(t); }, not_full, nof_push_waiters);
+  }
+  srsran::error_type<T> push_(T&& t, bool block_mode)
+  {
+    if (not active.load(std::memory_order_relaxed)) {
+      return std::move(t);
+    }
+    if (try_push_(std::move(t))) {
+      return {};
+    }
+    if (block_mode and wait_([this, &t]() { return try_push_(std::move(t)); }, not_full, nof_push_waiters)) {
+      return {};
+    }
+    return std::move(t);
+  }
+
+  bool pop_(T& obj, bool block, const std::chrono::steady_clock::time_point* until = nullptr)
+  {
+    if (not active.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    if (try_pop_(obj)) {
+      return true;
+    }
+    return block and wait_([this, &obj]() { return try_pop_(obj); }, not_empty, nof_pop_waiters, until);
+  }
+
+  size_t                    capacity = 0;
+  std::unique_ptr<cell_t[]> cells;
+  std::atomic<bool>         active{true};
+
+  alignas(64) std::atomic<size_t> enqueue_pos{0};
+  alignas(64) std::atomic<size_t> dequeue_pos{0};
+
+  // Events the sleeping threads wait on, with a counter in the upper bits and a flag telling that a thread is going to
+  // sleep in the lowest bit, and the number of threads blocked on each of them
+  alignas(64) std::atomic<uint32_t> not_empty{0};
+  std::atomic<uint32_t> nof_pop_waiters{0};
+  alignas(64) std::atomic<uint32_t> not_full{0};
+  std::atomic<uint32_t> nof_push_waiters{0};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_MPMC_QUEUE_H
@@ -23,9 +23,11 @@
 #define SRSRAN_BATCH_MEM_POOL_H
 
 #include "memblock_cache.h"
+#include "pool_registry.h"
 #include "pool_utils.h"
 #include "srsran/common/thread_pool.h"
 #include "srsran/support/srsran_assert.h"
+#include <functional>
 #include <memory>
 #include <mutex>
 
@@ -67,9 +69,15 @@ public:
   size_t cache_size() const { return free_list.size(); }
   size_t size() const { return allocated.size() * objs_per_batch; }
 
+  /// Sets a callback called with the memory of each new batch before its nodes are used, e.g. to bind it to a NUMA node
+  void set_batch_callback(std::function<void(void*, size_t)> callback) { batch_callback = std::move(callback); }
+
   void allocate_batch()
   {
     uint8_t* batch_payload = static_cast<uint8_t*>(allocated.allocate_block());
+    if (batch_callback) {
+      batch_callback(batch_payload, objs_per_batch * memblock_size);
+    }
     for (size_t i = 0; i < objs_per_batch; ++i) {
       void* cache_node = batch_payload + i * memblock_size;
       free_list.push(cache_node);
@@ -90,8 +98,9 @@ private:
   const size_t objs_per_batch;
   const size_t memblock_size;
 
-  memblock_stack     allocated;
-  free_memblock_list free_list;
+  memblock_stack                     allocated;
+  free_memblock_list                 free_list;
+  std::function<void(void*, size_t)> batch_callback;
 };
 
 /**
@@ -105,10 +114,15 @@ class background_mem_pool
 public:
   const size_t batch_threshold;
 
-  explicit background_mem_pool(size_t nodes_per_batch_, size_t node_size_, size_t thres_, int initial_size = -1) :
+  explicit background_mem_pool(size_t      nodes_per_batch_,
+                               size_t      node_size_,
+                               size_t      thres_,
+                               int         initial_size = -1,
+                               std::string name         = "background_mem_pool") :
     batch_threshold(thres_),
     state(std::make_shared<detached_pool_state>(this)),
-    grow_pool(nodes_per_batch_, node_size_, detail::max_alignment, initial_size)
+    grow_pool(nodes_per_batch_, node_size_, detail::max_alignment, initial_size),
+    stats(std::move(name), grow_pool.get_node_max_size(), grow_pool.size())
   {
     srsran_assert(batch_threshold > 1, "Invalid arguments for background memory pool");
   }
@@ -126,12 +140,15 @@ public:
                   "Mismatch of allocated node size=%zd and object size=%zd",
                   sz,
                   grow_pool.get_node_max_size());
+    auto                        t_start = stats.on_alloc_start();
     std::lock_guard<std::mutex> lock(state->mutex);
     void*                       node = grow_pool.allocate_node();
+    stats.set_nof_blocks(grow_pool.size());
 
     if (grow_pool.size() < batch_threshold) {
       allocate_batch_in_background_nolock();
     }
+    stats.on_alloc_end(t_start, sz, true);
     return node;
   }
 
@@ -139,16 +156,25 @@ public:
   {
     std::lock_guard<std::mutex> lock(state->mutex);
     grow_pool.deallocate_node(p);
+    stats.on_dealloc();
   }
 
   void allocate_batch()
   {
     std::lock_guard<std::mutex> lock(state->mutex);
     grow_pool.allocate_batch();
+    stats.set_nof_blocks(grow_pool.size());
+  }
+
+  void set_batch_callback(std::function<void(void*, size_t)> callback)
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    grow_pool.set_batch_callback(std::move(callback));
   }
 
-  size_t get_node_max_size() const { return grow_pool.get_node_max_size(); }
-  size_t cache_size() const
+  size_t         get_node_max_size() const { return grow_pool.get_node_max_size(); }
+  pool_metrics_t get_metrics() const { return stats.get_metrics(); }
+  size_t         cache_size() const
   {
     std::lock_guard<std::mutex> lock(state->mutex);
     return grow_pool.cache_size();
@@ -171,6 +197,7 @@ private:
         do {
           pool->grow_pool.allocate_batch();
         } while (pool->grow_pool.cache_size() < pool->batch_threshold);
+        pool->stats.set_nof_blocks(pool->grow_pool.size());
       }
       state_sptr->dispatched = false;
     });
@@ -186,6 +213,7 @@ private:
   std::shared_ptr<detached_pool_state> state;
 
   growing_batch_mem_pool grow_pool;
+  pool_stats             stats;
 };
 
 } // namespace srsran
@@ -47,8 +47,12 @@ class circular_stack_pool
   };
 
 public:
-  circular_stack_pool(size_t nof_objs_per_batch, size_t stack_size, size_t batch_thres, int initial_size = -1) :
-    central_cache(std::min(NofStacks, nof_objs_per_batch), stack_size, batch_thres, initial_size),
+  circular_stack_pool(size_t      nof_objs_per_batch,
+                      size_t      stack_size,
+                      size_t      batch_thres,
+                      int         initial_size = -1,
+                      std::string name         = "circular_stack_pool") :
+    central_cache(std::min(NofStacks, nof_objs_per_batch), stack_size, batch_thres, initial_size, std::move(name)),
     logger(srslog::fetch_basic_logger("POOL"))
   {}
   circular_stack_pool(circular_stack_pool&&)      = delete;
@@ -110,6 +114,9 @@ public:
 
   size_t cache_size() const { return central_cache.cache_size(); }
 
+  /// Accounting of the stacks taken from the central cache, each stack is one block
+  pool_metrics_t get_metrics() const { return central_cache.get_metrics(); }
+
 private:
   srsran::circular_array<mem_block_elem_t, NofStacks> pools;
   srsran::background_mem_pool                         central_cache;
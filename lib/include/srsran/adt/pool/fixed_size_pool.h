@@ -23,7 +23,11 @@
 #define SRSRAN_FIXED_SIZE_POOL_H
 
 #include "memblock_cache.h"
+#include "pool_registry.h"
 #include "srsran/adt/circular_buffer.h"
+#include "srsran/phy/utils/huge_pages.h"
+#include <atomic>
+#include <cinttypes>
 #include <thread>
 
 namespace srsran {
@@ -31,11 +35,13 @@ namespace srsran {
 /**
  * Concurrent fixed size memory pool made of blocks of equal size
  * Each worker keeps a separate thread-local memory block cache that it uses for fast allocation/deallocation.
- * When this cache gets depleted, the worker tries to obtain blocks from a central memory block cache.
- * When accessing a thread local cache, no locks are required.
+ * When this cache gets depleted, the worker pops a magazine (a batch of up to batch_steal_size blocks) from a central
+ * lock-free stack of magazines. Neither the thread local caches nor the central stack require locks.
  * Since there is no stealing of blocks between workers, it is possible that a worker can't allocate while another
  * worker still has blocks in its own cache. To minimize the impact of this event, an upper bound is place on a worker
- * thread cache size. Once a worker reaches that upper bound, it sends half of its stored blocks to the central cache.
+ * thread cache size. Once a worker reaches that upper bound, it sends half of its stored blocks to the central stack.
+ * The central stack links the magazines through side arrays indexed by block, so the block contents are never read
+ * concurrently, and its head is tagged with a version counter to avoid ABA problems.
  * Note: Taking into account the usage of thread_local, this class is made a singleton
  * Note2: No considerations were made regarding false sharing between threads. It is assumed that the blocks are big
  *        enough to fill a cache line.
@@ -52,37 +58,61 @@ class concurrent_fixed_memory_pool
     typename std::aligned_storage<ObjSize, alignof(detail::max_alignment_t)>::type buffer;
   };
 
-  const static size_t batch_steal_size = 16;
+  /// Links of a block when it is stored in the central stack. Only the magazine head uses next_magazine/nof_blocks
+  struct block_link_t {
+    std::atomic<uint32_t> next_magazine{0}; ///< index + 1 of the next magazine head, 0 if none
+    uint32_t              next_block = 0;   ///< index of the next block of the same magazine
+    uint32_t              nof_blocks = 0;   ///< number of blocks of the magazine
+  };
+
+  /// The blocks are allocated in huge pages when enabled, as the pool spans many pages
+  struct huge_deleter {
+    void operator()(obj_storage_t* p) const { srsran_huge_free(p); }
+  };
+
+  const static size_t   batch_steal_size = 16;
+  const static uint64_t head_index_mask  = 0xffffffffUL;
 
   // ctor only accessible from singleton get_instance()
-  explicit concurrent_fixed_memory_pool(size_t nof_objects_)
+  explicit concurrent_fixed_memory_pool(size_t nof_objects_) :
+    nof_blocks(nof_objects_),
+    blocks(static_cast<obj_storage_t*>(srsran_huge_malloc(sizeof(obj_storage_t) * nof_objects_))),
+    links(new block_link_t[nof_objects_]),
+    stats("fixed_size_pool_" + std::to_string(ObjSize), ObjSize, nof_objects_)
   {
     srsran_assert(nof_objects_ > batch_steal_size, "A positive pool size must be provided");
+    srsran_assert(nof_objects_ < head_index_mask, "Pool size=%zd is too large", nof_objects_);
+    srsran_assert(blocks != nullptr, "Failed to allocate the memory of the pool");
 
-    std::lock_guard<std::mutex> lock(mutex);
-    allocated_blocks.resize(nof_objects_);
-    for (std::unique_ptr<obj_storage_t>& b : allocated_blocks) {
-      b.reset(new obj_storage_t());
-      srsran_assert(b.get() != nullptr, "Failed to instantiate fixed memory pool");
-      central_mem_cache.push(static_cast<void*>(b.get()));
+    free_memblock_list all_blocks;
+    for (size_t i = nof_blocks; i > 0; --i) {
+      all_blocks.push(static_cast<void*>(blocks.get() + i - 1));
+    }
+    while (not all_blocks.empty()) {
+      push_magazine(all_blocks, batch_steal_size);
     }
-    local_growth_thres = allocated_blocks.size() / 16;
+    stats.set_memory(blocks.get(), nof_blocks * sizeof(obj_storage_t));
+    local_growth_thres = nof_blocks / 16;
     local_growth_thres = local_growth_thres < batch_steal_size ? batch_steal_size : local_growth_thres;
   }
 
 public:
   const static size_t BLOCK_SIZE = ObjSize;
 
+  /// Allocation statistics of the thread local cache of a worker
+  struct cache_metrics_t {
+    uint64_t nof_hits     = 0; ///< allocations served by the thread local cache
+    uint64_t nof_misses   = 0; ///< allocations that had to refill the thread local cache from the central stack
+    uint64_t nof_failures = 0; ///< allocations that failed because the pool was depleted
+    uint64_t nof_flushes  = 0; ///< times the thread local cache sent half of its blocks to the central stack
+  };
+
   concurrent_fixed_memory_pool(const concurrent_fixed_memory_pool&) = delete;
   concurrent_fixed_memory_pool(concurrent_fixed_memory_pool&&)      = delete;
   concurrent_fixed_memory_pool& operator=(const concurrent_fixed_memory_pool&) = delete;
   concurrent_fixed_memory_pool& operator=(concurrent_fixed_memory_pool&&) = delete;
 
-  ~concurrent_fixed_memory_pool()
-  {
-    std::lock_guard<std::mutex> lock(mutex);
-    allocated_blocks.clear();
-  }
+  ~concurrent_fixed_memory_pool() = default;
 
   static concurrent_fixed_memory_pool<ObjSize, DebugSanitizeAddress>* get_instance(size_t size = 4096)
   {
@@ -90,57 +120,74 @@ public:
     return &pool;
   }
 
-  size_t size() { return allocated_blocks.size(); }
+  size_t size() { return nof_blocks; }
+
+  /// Memory holding the blocks of the pool, e.g. to bind it to a NUMA node
+  void*  get_memory() { return blocks.get(); }
+  size_t get_memory_size() const { return nof_blocks * sizeof(obj_storage_t); }
 
   void* allocate_node(size_t sz)
   {
     srsran_assert(sz <= ObjSize, "Allocated node size=%zd exceeds max object size=%zd", sz, ObjSize);
     worker_ctxt* worker_ctxt = get_worker_cache();
+    auto         t_start     = stats.on_alloc_start();
 
     void* node = worker_ctxt->cache.try_pop();
-    if (node == nullptr) {
-      // fill the thread local cache enough for this and next allocations
-      std::array<void*, batch_steal_size> popped_blocks;
-      size_t                              n = central_mem_cache.try_pop(popped_blocks);
-      for (size_t i = 0; i < n; ++i) {
-        new (popped_blocks[i]) obj_storage_t();
-        worker_ctxt->cache.push(static_cast<void*>(popped_blocks[i]));
-      }
-      node = worker_ctxt->cache.try_pop();
+    if (node != nullptr) {
+      worker_ctxt->metrics.nof_hits++;
+      stats.on_alloc_end(t_start, sz, true);
+      return node;
     }
 
-#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
+    // fill the thread local cache enough for this and next allocations
+    worker_ctxt->metrics.nof_misses++;
+    pop_magazine(worker_ctxt->cache);
+    node = worker_ctxt->cache.try_pop();
+
     if (node == nullptr) {
+      worker_ctxt->metrics.nof_failures++;
+#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
       print_error("Error allocating buffer in pool of ObjSize=%zd", ObjSize);
-    }
 #endif
+    }
+    stats.on_alloc_end(t_start, sz, node != nullptr);
     return node;
   }
 
   void deallocate_node(void* p)
   {
     srsran_assert(p != nullptr, "Deallocated nodes must have valid address");
-    worker_ctxt*   worker_ctxt = get_worker_cache();
-    obj_storage_t* block_ptr   = static_cast<obj_storage_t*>(p);
+    worker_ctxt* worker_ctxt = get_worker_cache();
 
     if (DebugSanitizeAddress) {
-      std::lock_guard<std::mutex> lock(mutex);
-      srsran_assert(std::any_of(allocated_blocks.begin(),
-                                allocated_blocks.end(),
-                                [block_ptr](const std::unique_ptr<obj_storage_t>& b) { return b.get() == block_ptr; }),
+      obj_storage_t* block_ptr = static_cast<obj_storage_t*>(p);
+      srsran_assert(block_ptr >= blocks.get() and block_ptr < blocks.get() + nof_blocks and
+                        (reinterpret_cast<uint8_t*>(block_ptr) - reinterpret_cast<uint8_t*>(blocks.get())) %
+                                sizeof(obj_storage_t) ==
+                            0,
                     "Error deallocating block with address 0x%lx",
                     (long unsigned)block_ptr);
     }
 
     // push to local memory block cache
+    stats.on_dealloc();
     worker_ctxt->cache.push(static_cast<void*>(p));
 
     if (worker_ctxt->cache.size() >= local_growth_thres) {
-      // if local cache reached max capacity, send half of the blocks to central cache
-      central_mem_cache.steal_blocks(worker_ctxt->cache, worker_ctxt->cache.size() / 2);
+      // if local cache reached max capacity, send half of the blocks to central stack
+      worker_ctxt->metrics.nof_flushes++;
+      for (size_t n = worker_ctxt->cache.size() / 2; n > 0;) {
+        n -= push_magazine(worker_ctxt->cache, std::min(n, size_t(batch_steal_size)));
+      }
     }
   }
 
+  /// Allocation statistics of the calling thread
+  cache_metrics_t get_local_cache_metrics() { return get_worker_cache()->metrics; }
+
+  /// Allocation accounting of all the threads, also reported through the pool_registry
+  pool_metrics_t get_metrics() const { return stats.get_metrics(); }
+
   void enable_logger(bool enabled)
   {
     if (enabled) {
@@ -153,28 +200,30 @@ public:
 
   void print_all_buffers()
   {
-    auto*  worker     = get_worker_cache();
-    size_t tot_blocks = 0;
-    {
-      std::lock_guard<std::mutex> lock(mutex);
-      tot_blocks = allocated_blocks.size();
-    }
-    printf("There are %zd/%zd buffers in shared block container. This thread contains %zd in its local cache\n",
-           central_mem_cache.size(),
-           tot_blocks,
-           worker->cache.size());
+    auto* worker = get_worker_cache();
+    printf("There are %zd/%zd buffers in shared block container. This thread contains %zd in its local cache "
+           "(hits=%" PRIu64 ", misses=%" PRIu64 ", failures=%" PRIu64 ")\n",
+           central_count.load(std::memory_order_relaxed),
+           nof_blocks,
+           worker->cache.size(),
+           worker->metrics.nof_hits,
+           worker->metrics.nof_misses,
+           worker->metrics.nof_failures);
   }
 
 private:
   struct worker_ctxt {
     std::thread::id    id;
     free_memblock_list cache;
+    cache_metrics_t    metrics;
 
     worker_ctxt() : id(std::this_thread::get_id()) {}
     ~worker_ctxt()
     {
-      concurrent_free_memblock_list& central_cache = pool_type::get_instance()->central_mem_cache;
-      central_cache.steal_blocks(cache, cache.size());
+      pool_type* pool = pool_type::get_instance();
+      while (not cache.empty()) {
+        pool->push_magazine(cache, batch_steal_size);
+      }
     }
   };
 
@@ -184,6 +233,67 @@ private:
     return &worker_cache;
   }
 
+  uint32_t get_block_index(void* block) const
+  {
+    return static_cast<uint32_t>(static_cast<obj_storage_t*>(block) - blocks.get());
+  }
+
+  static uint64_t make_head(uint64_t prev_head, uint32_t magazine_index_plus_one)
+  {
+    return (((prev_head >> 32U) + 1) << 32U) | magazine_index_plus_one;
+  }
+
+  /// Moves up to max_n blocks of the given list as a single magazine to the central stack. Returns the number of blocks
+  size_t push_magazine(free_memblock_list& src, size_t max_n)
+  {
+    uint32_t first = get_block_index(src.pop());
+    uint32_t last  = first;
+    uint32_t count = 1;
+    for (; count < max_n and not src.empty(); ++count) {
+      uint32_t idx           = get_block_index(src.pop());
+      links[last].next_block = idx;
+      last                   = idx;
+    }
+    links[first].nof_blocks = count;
+    central_count.fetch_add(count, std::memory_order_relaxed);
+
+    uint64_t head = central_head.load(std::memory_order_relaxed);
+    uint64_t new_head;
+    do {
+      links[first].next_magazine.store(static_cast<uint32_t>(head & head_index_mask), std::memory_order_relaxed);
+      new_head = make_head(head, first + 1);
+    } while (not central_head.compare_exchange_weak(
+        head, new_head, std::memory_order_release, std::memory_order_relaxed));
+    return count;
+  }
+
+  /// Pops a magazine from the central stack into the given list. Returns the number of blocks moved
+  size_t pop_magazine(free_memblock_list& dest)
+  {
+    uint64_t head = central_head.load(std::memory_order_acquire);
+    uint64_t new_head;
+    uint32_t first;
+    do {
+      if ((head & head_index_mask) == 0) {
+        return 0;
+      }
+      first    = static_cast<uint32_t>(head & head_index_mask) - 1;
+      new_head = make_head(head, links[first].next_magazine.load(std::memory_order_relaxed));
+    } while (not central_head.compare_exchange_weak(
+        head, new_head, std::memory_order_acquire, std::memory_order_acquire));
+
+    uint32_t count = links[first].nof_blocks;
+    uint32_t idx   = first;
+    for (uint32_t i = 0; i < count; ++i) {
+      uint32_t next = links[idx].next_block;
+      new (blocks.get() + idx) obj_storage_t();
+      dest.push(static_cast<void*>(blocks.get() + idx));
+      idx = next;
+    }
+    central_count.fetch_sub(count, std::memory_order_relaxed);
+    return count;
+  }
+
   /// Formats and prints the input string and arguments into the configured output stream.
   template <typename... Args>
   void print_error(const char* str, Args&&... args)
@@ -198,9 +308,14 @@ private:
   size_t                local_growth_thres = 0;
   srslog::basic_logger* logger             = nullptr;
 
-  concurrent_free_memblock_list                central_mem_cache;
-  std::mutex                                   mutex;
-  std::vector<std::unique_ptr<obj_storage_t> > allocated_blocks;
+  const size_t                     nof_blocks;
+  std::unique_ptr<obj_storage_t, huge_deleter> blocks;
+  std::unique_ptr<block_link_t[]>              links;
+  pool_stats                                   stats;
+
+  // head of the central stack of magazines, with the version tag in the upper 32 bits
+  alignas(64) std::atomic<uint64_t> central_head{0};
+  alignas(64) std::atomic<size_t> central_count{0};
 };
 
 } // namespace srsran
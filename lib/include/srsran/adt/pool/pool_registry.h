@@ -0,0 +1,158 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_POOL_REGISTRY_H
+#define SRSRAN_POOL_REGISTRY_H
+
+#include "srsran/srslog/srslog.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace srsran {
+
+/// Snapshot of the accounting of a memory pool
+struct pool_metrics_t {
+  std::string name;
+  size_t      block_size           = 0; ///< bytes of each block of the pool
+  size_t      nof_blocks           = 0; ///< blocks owned by the pool
+  size_t      nof_used             = 0; ///< blocks currently allocated
+  size_t      high_water_mark      = 0; ///< maximum number of blocks allocated at the same time
+  uint64_t    nof_allocs           = 0;
+  uint64_t    nof_failures         = 0; ///< allocations that could not be served by the pool
+  float       alloc_latency_avg_us = 0; ///< average latency of the sampled allocations
+  float       alloc_latency_max_us = 0; ///< maximum latency of the sampled allocations
+  float       fragmentation        = 0; ///< fraction of the bytes of the allocated blocks left unused by the objects
+};
+
+/**
+ * Allocation accounting of a memory pool, which registers the pool in the pool_registry for its lifetime.
+ * The counters are relaxed atomics, so that they can be updated from the allocating threads without locks. The latency
+ * is only measured for one in every latency_sample_period allocations, to keep the clock reads out of the common path.
+ */
+class pool_stats
+{
+public:
+  using clock_t = std::chrono::steady_clock;
+
+  static const uint64_t latency_sample_period = 64;
+
+  pool_stats(std::string name_, size_t block_size_, size_t nof_blocks_ = 0);
+  pool_stats(const pool_stats&) = delete;
+  pool_stats& operator=(const pool_stats&) = delete;
+  ~pool_stats();
+
+  void set_nof_blocks(size_t n) { nof_blocks.store(n, std::memory_order_relaxed); }
+
+  /// Sets the memory preallocated by the pool, which pool_registry::prefault() faults in
+  void set_memory(void* ptr, size_t len);
+
+  /// Called before an allocation. Returns its start time if its latency is sampled, or a default time point otherwise
+  clock_t::time_point on_alloc_start()
+  {
+    uint64_t n = nof_allocs.fetch_add(1, std::memory_order_relaxed);
+    return n % latency_sample_period == 0 ? clock_t::now() : clock_t::time_point{};
+  }
+
+  /// Called after an allocation of sz bytes, with the time point returned by on_alloc_start()
+  void on_alloc_end(clock_t::time_point t_start, size_t sz, bool success)
+  {
+    if (t_start != clock_t::time_point{}) {
+      uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - t_start).count();
+      latency_sum_ns.fetch_add(ns, std::memory_order_relaxed);
+      nof_latency_samples.fetch_add(1, std::memory_order_relaxed);
+      update_max(latency_max_ns, ns);
+    }
+    if (not success) {
+      nof_failures.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    requested_bytes.fetch_add(sz, std::memory_order_relaxed);
+    update_max(high_water_mark, nof_used.fetch_add(1, std::memory_order_relaxed) + 1);
+  }
+
+  void on_dealloc() { nof_used.fetch_sub(1, std::memory_order_relaxed); }
+
+  const std::string& get_name() const { return name; }
+  size_t             get_nof_used() const { return nof_used.load(std::memory_order_relaxed); }
+
+  pool_metrics_t get_metrics() const;
+
+private:
+  friend class pool_registry;
+
+  static void update_max(std::atomic<uint64_t>& max_val, uint64_t val)
+  {
+    uint64_t cur = max_val.load(std::memory_order_relaxed);
+    while (val > cur and not max_val.compare_exchange_weak(cur, val, std::memory_order_relaxed)) {
+    }
+  }
+
+  const std::string   name;
+  const size_t        block_size;
+  std::atomic<size_t> nof_blocks;
+  void*               mem_ptr = nullptr; ///< protected by the mutex of the registry
+  size_t              mem_len = 0;
+
+  alignas(64) std::atomic<uint64_t> nof_allocs{0};
+  std::atomic<uint64_t> nof_used{0};
+  std::atomic<uint64_t> high_water_mark{0};
+  std::atomic<uint64_t> nof_failures{0};
+  std::atomic<uint64_t> requested_bytes{0};
+  std::atomic<uint64_t> latency_sum_ns{0};
+  std::atomic<uint64_t> latency_max_ns{0};
+  std::atomic<uint64_t> nof_latency_samples{0};
+};
+
+/**
+ * Central list of the memory pools of the process, to report their usage through the metrics and to detect the blocks
+ * that were not returned to their pool at shutdown.
+ */
+class pool_registry
+{
+public:
+  static pool_registry& get();
+
+  /// Appends the metrics of all the registered pools
+  void get_metrics(std::vector<pool_metrics_t>& metrics);
+
+  /// Logs the pools that still have allocated blocks. Returns the number of such pools
+  size_t log_leaks(srslog::basic_logger& logger);
+
+  /// Faults in the memory preallocated by the pools, so that their blocks do not fault on their first use. Returns the
+  /// number of bytes populated
+  size_t prefault();
+
+private:
+  friend class pool_stats;
+
+  void add(pool_stats* stats);
+  void remove(pool_stats* stats);
+
+  std::mutex               mutex;
+  std::vector<pool_stats*> pools;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_POOL_REGISTRY_H
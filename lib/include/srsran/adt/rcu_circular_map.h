@@ -0,0 +1,207 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RCU_CIRCULAR_MAP_H
+#define SRSRAN_RCU_CIRCULAR_MAP_H
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace srsran {
+
+/**
+ * Read-copy-update domain. Readers enter a read-side critical section by incrementing a per-thread counter, which is
+ * wait-free and does not touch any cache line shared with other reader threads. Writers unpublish an object and then
+ * call synchronize(), which blocks until all the readers that might still hold a reference to it have left their
+ * critical section. The counters are split in two phases, so that new readers cannot starve the writer.
+ */
+class rcu_domain
+{
+  static const size_t NOF_READER_SLOTS = 32;
+
+  struct alignas(64) reader_slot {
+    std::atomic<uint32_t> count{0};
+  };
+
+public:
+  /// Read-side critical section. Objects found inside it remain valid until the guard is destroyed
+  class read_guard
+  {
+  public:
+    explicit read_guard(const rcu_domain& domain) : counter(domain.read_lock()) {}
+    read_guard(const read_guard&) = delete;
+    read_guard(read_guard&&)      = delete;
+    read_guard& operator=(const read_guard&) = delete;
+    read_guard& operator=(read_guard&&) = delete;
+    ~read_guard() { counter->fetch_sub(1, std::memory_order_release); }
+
+  private:
+    std::atomic<uint32_t>* counter;
+  };
+
+  /// Blocks until all the read-side critical sections that started before the call have finished
+  void synchronize()
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    // Pairs with the fence of read_lock(). Readers that are not seen by the loop below see the writer updates
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (uint32_t i = 0; i < 2; ++i) {
+      uint32_t old_phase = phase.load(std::memory_order_relaxed);
+      phase.store(old_phase ^ 1U, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      for (const reader_slot& slot : readers[old_phase]) {
+        while (slot.count.load(std::memory_order_acquire) != 0) {
+          std::this_thread::yield();
+        }
+      }
+    }
+  }
+
+private:
+  std::atomic<uint32_t>* read_lock() const
+  {
+    std::atomic<uint32_t>* counter = &readers[phase.load(std::memory_order_relaxed)][thread_slot()].count;
+    counter->fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return counter;
+  }
+
+  static size_t thread_slot()
+  {
+    static std::atomic<size_t> next_slot{0};
+    thread_local size_t        slot = next_slot.fetch_add(1, std::memory_order_relaxed) % NOF_READER_SLOTS;
+    return slot;
+  }
+
+  mutable std::array<std::array<reader_slot, NOF_READER_SLOTS>, 2> readers;
+  std::atomic<uint32_t>                                            phase{0};
+  std::mutex                                                       writer_mutex;
+};
+
+/**
+ * Map of objects owned through a unique pointer type Ptr, indexed by a key K as in static_circular_map. Lookups and
+ * iterations are lock-free, and must be done inside a read_guard. Insertions and removals are serialized among
+ * themselves, and removals block until no reader can access the removed object anymore.
+ */
+template <typename K, typename Ptr, size_t N>
+class rcu_circular_map
+{
+  static_assert(std::is_integral<K>::value and std::is_unsigned<K>::value, "Map key must be an unsigned integer");
+
+public:
+  using key_type     = K;
+  using element_type = typename Ptr::element_type;
+
+  class read_guard : public rcu_domain::read_guard
+  {
+  public:
+    explicit read_guard(const rcu_circular_map<K, Ptr, N>& map) : rcu_domain::read_guard(map.domain) {}
+  };
+
+  rcu_circular_map()                        = default;
+  rcu_circular_map(const rcu_circular_map&) = delete;
+  rcu_circular_map& operator=(const rcu_circular_map&) = delete;
+  ~rcu_circular_map() { clear(); }
+
+  /// Returns the object with the given key, or nullptr if it does not exist. Caller must hold a read_guard
+  element_type* find(K id) const
+  {
+    element_type* obj = objs[id % N].load(std::memory_order_acquire);
+    return (obj != nullptr and keys[id % N] == id) ? obj : nullptr;
+  }
+  bool contains(K id) const { return find(id) != nullptr; }
+
+  /// Calls f(key, obj) for all the objects in the map. Caller must hold a read_guard
+  template <typename F>
+  void for_each(F&& f) const
+  {
+    for (size_t i = 0; i < N; ++i) {
+      element_type* obj = objs[i].load(std::memory_order_acquire);
+      if (obj != nullptr) {
+        f(keys[i], *obj);
+      }
+    }
+  }
+
+  /// Returns false, leaving the object with the caller, if the key position is already taken
+  bool insert(K id, Ptr&& obj)
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    size_t                      idx = id % N;
+    if (owners[idx] != nullptr) {
+      return false;
+    }
+    keys[idx]   = id;
+    owners[idx] = std::move(obj);
+    objs[idx].store(owners[idx].get(), std::memory_order_release);
+    count.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /// Removes the object, once all the readers that might be accessing it are done
+  bool erase(K id)
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    size_t                      idx = id % N;
+    if (owners[idx] == nullptr or keys[idx] != id) {
+      return false;
+    }
+    objs[idx].store(nullptr, std::memory_order_relaxed);
+    domain.synchronize();
+    owners[idx].reset();
+    count.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    for (auto& obj : objs) {
+      obj.store(nullptr, std::memory_order_relaxed);
+    }
+    domain.synchronize();
+    for (auto& owner : owners) {
+      owner.reset();
+    }
+    count.store(0, std::memory_order_relaxed);
+  }
+
+  size_t size() const { return count.load(std::memory_order_relaxed); }
+  bool   empty() const { return size() == 0; }
+  bool   full() const { return size() == N; }
+  bool   has_space(K id) const { return objs[id % N].load(std::memory_order_relaxed) == nullptr; }
+  size_t capacity() const { return N; }
+
+private:
+  std::array<std::atomic<element_type*>, N> objs{};
+  std::array<K, N>                          keys{};
+  std::array<Ptr, N>                        owners{};
+  std::atomic<size_t>                       count{0};
+  std::mutex                                writer_mutex;
+  rcu_domain                                domain;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_RCU_CIRCULAR_MAP_H
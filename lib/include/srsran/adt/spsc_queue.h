@@ -0,0 +1,149 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SPSC_QUEUE_H
+#define SRSRAN_SPSC_QUEUE_H
+
+#include "srsran/adt/detail/type_storage.h"
+#include "srsran/adt/expected.h"
+#include "srsran/support/srsran_assert.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace srsran {
+
+/**
+ * Bounded single-producer/single-consumer queue.
+ * Features:
+ * - try_push/try_pop are lock-free and wait-free. Each side owns a free running index in its own cache line, and keeps
+ *   a cached copy of the index of the other side, so the shared cache lines are only touched when the cached copy
+ *   says that the queue is full (producer) or empty (consumer).
+ * - pop_batch() consumes all the available elements and publishes the new read index once.
+ * - The capacity is rounded up to a power of 2.
+ * - Only one thread may push and only one thread may pop at any time.
+ * @tparam T value type stored by the queue
+ */
+template <typename T>
+class spsc_queue
+{
+public:
+  using value_type = T;
+
+  explicit spsc_queue(size_t size)
+  {
+    srsran_assert(size > 0, "The capacity of the queue must be positive");
+    size_t nof_slots = 1;
+    while (nof_slots < size) {
+      nof_slots <<= 1;
+    }
+    slots.reset(new detail::type_storage<T>[nof_slots]);
+    mask = nof_slots - 1;
+  }
+  spsc_queue(const spsc_queue&) = delete;
+  spsc_queue(spsc_queue&&)      = delete;
+  spsc_queue& operator=(const spsc_queue&) = delete;
+  spsc_queue& operator=(spsc_queue&&) = delete;
+  ~spsc_queue()
+  {
+    T obj;
+    while (try_pop(obj)) {
+    }
+  }
+
+  /// Producer side. The element is returned as error if the queue is full
+  srsran::error_type<T> try_push(T&& t)
+  {
+    uint64_t wr = wr_idx.load(std::memory_order_relaxed);
+    if (wr - rd_cache > mask) {
+      rd_cache = rd_idx.load(std::memory_order_acquire);
+      if (wr - rd_cache > mask) {
+        return std::move(t);
+      }
+    }
+    slots[wr & mask].emplace(std::move(t));
+    wr_idx.store(wr + 1, std::memory_order_release);
+    return {};
+  }
+
+  /// Consumer side
+  bool try_pop(T& obj)
+  {
+    uint64_t rd = rd_idx.load(std::memory_order_relaxed);
+    if (rd == wr_cache) {
+      wr_cache = wr_idx.load(std::memory_order_acquire);
+      if (rd == wr_cache) {
+        return false;
+      }
+    }
+    obj = std::move(slots[rd & mask].get());
+    slots[rd & mask].destroy();
+    rd_idx.store(rd + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Consumer side. Calls func on up to max_n elements, from the oldest, and returns the number of elements popped
+  template <typename F>
+  size_t pop_batch(F&& func, size_t max_n = SIZE_MAX)
+  {
+    uint64_t rd = rd_idx.load(std::memory_order_relaxed);
+    wr_cache    = wr_idx.load(std::memory_order_acquire);
+    size_t n    = std::min<uint64_t>(wr_cache - rd, max_n);
+    for (size_t i = 0; i < n; ++i) {
+      func(std::move(slots[(rd + i) & mask].get()));
+      slots[(rd + i) & mask].destroy();
+    }
+    rd_idx.store(rd + n, std::memory_order_release);
+    return n;
+  }
+
+  /// Number of elements in the queue, only exact when called from one of the sides while the other is idle
+  size_t size() const
+  {
+    uint64_t rd = rd_idx.load(std::memory_order_acquire);
+    return wr_idx.load(std::memory_order_acquire) - rd;
+  }
+  bool   empty() const { return size() == 0; }
+  bool   full() const { return size() == max_size(); }
+  size_t max_size() const { return mask + 1; }
+
+private:
+  static constexpr size_t cache_line_size = 64;
+
+  // Producer side
+  std::atomic<uint64_t> wr_idx{0};
+  uint64_t              rd_cache = 0; ///< last read index seen by the producer
+  uint8_t               pad_wr[cache_line_size - sizeof(std::atomic<uint64_t>) - sizeof(uint64_t)];
+
+  // Consumer side
+  std::atomic<uint64_t> rd_idx{0};
+  uint64_t              wr_cache = 0; ///< last write index seen by the consumer
+  uint8_t               pad_rd[cache_line_size - sizeof(std::atomic<uint64_t>) - sizeof(uint64_t)];
+
+  // Shared
+  std::unique_ptr<detail::type_storage<T>[]> slots;
+  uint64_t                                   mask = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_SPSC_QUEUE_H
@@ -0,0 +1,364 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_STATIC_HASH_MAP_H
+#define SRSRAN_STATIC_HASH_MAP_H
+
+#include "detail/type_storage.h"
+#include "expected.h"
+#include "srsran/support/srsran_assert.h"
+#include <array>
+#include <limits>
+
+namespace srsran {
+
+/**
+ * Fixed-capacity map with unsigned integer keys, which unlike static_circular_map accepts any set of up to N keys.
+ * The objects are stored in a static array and never move, so the references to them remain valid until they are
+ * erased. They are indexed by a robin-hood hash table with twice as many buckets as N, which keeps the expected probe
+ * length of lookups below two buckets independently of how the keys (e.g. RNTIs or TEIDs) are distributed.
+ * Insertions and erasures do not allocate and do not invalidate the iterators to other objects.
+ * @tparam K unsigned integer key type
+ * @tparam T mapped type
+ * @tparam N maximum number of objects
+ */
+template <typename K, typename T, size_t N>
+class static_hash_map
+{
+  static_assert(std::is_integral<K>::value and std::is_unsigned<K>::value, "Map key must be an unsigned integer");
+  static_assert(N > 0 and N <= std::numeric_limits<uint16_t>::max(), "Map capacity must fit 16 bits");
+
+  using obj_t = std::pair<K, T>;
+
+  static constexpr size_t ceil_pow2(size_t n)
+  {
+    size_t p = 1;
+    while (p < n) {
+      p *= 2;
+    }
+    return p;
+  }
+  static constexpr uint32_t log2_pow2(size_t n)
+  {
+    uint32_t l = 0;
+    while (n > 1) {
+      n /= 2;
+      l++;
+    }
+    return l;
+  }
+
+  static constexpr size_t   nof_buckets = ceil_pow2(2 * N);
+  static constexpr size_t   mask        = nof_buckets - 1;
+  static constexpr uint32_t hash_shift  = 64 - log2_pow2(nof_buckets);
+  static constexpr size_t   npos        = std::numeric_limits<size_t>::max();
+
+  struct bucket_t {
+    K        key;
+    uint16_t idx;      ///< index of the object in the storage array
+    uint16_t dist = 0; ///< distance to the home bucket of the key plus one, zero if the bucket is empty
+  };
+
+  template <bool Const>
+  class iter_impl
+  {
+    using map_ptr = typename std::conditional<Const, const static_hash_map*, static_hash_map*>::type;
+    using elem_t  = typename std::conditional<Const, const obj_t, obj_t>::type;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = elem_t;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = elem_t*;
+    using reference         = elem_t&;
+
+    iter_impl() = default;
+    iter_impl(map_ptr map_, size_t idx_) : map(map_), idx(idx_)
+    {
+      if (idx < N and not map->present[idx]) {
+        ++(*this);
+      }
+    }
+    // Conversion to const_iterator
+    operator iter_impl<true>() const { return iter_impl<true>(map, idx); }
+
+    iter_impl& operator++()
+    {
+      while (++idx < N and not map->present[idx]) {
+      }
+      return *this;
+    }
+
+    elem_t& operator*() const
+    {
+      srsran_assert(idx < N, "Iterator out-of-bounds (%zd >= %zd)", idx, N);
+      return map->get_obj_(idx);
+    }
+    elem_t* operator->() const { return &(**this); }
+
+    bool operator==(const iter_impl& other) const { return map == other.map and idx == other.idx; }
+    bool operator!=(const iter_impl& other) const { return not(*this == other); }
+
+  private:
+    friend class static_hash_map<K, T, N>;
+    map_ptr map = nullptr;
+    size_t  idx = 0;
+  };
+
+public:
+  using key_type        = K;
+  using mapped_type     = T;
+  using value_type      = std::pair<K, T>;
+  using difference_type = std::ptrdiff_t;
+  using iterator        = iter_impl<false>;
+  using const_iterator  = iter_impl<true>;
+
+  static_hash_map()
+  {
+    std::fill(present.begin(), present.end(), false);
+    // hand out the lowest indexes first
+    for (size_t i = 0; i < N; ++i) {
+      free_list[i] = static_cast<uint16_t>(N - 1 - i);
+    }
+  }
+  static_hash_map(const static_hash_map& other) :
+    buckets(other.buckets), present(other.present), free_list(other.free_list), count(other.count)
+  {
+    for (size_t idx = 0; idx < N; ++idx) {
+      if (present[idx]) {
+        buffer[idx].emplace(other.get_obj_(idx));
+      }
+    }
+  }
+  static_hash_map(static_hash_map&& other) noexcept :
+    buckets(other.buckets), present(other.present), free_list(other.free_list), count(other.count)
+  {
+    for (size_t idx = 0; idx < N; ++idx) {
+      if (present[idx]) {
+        buffer[idx].emplace(std::move(other.get_obj_(idx)));
+      }
+    }
+    other.clear();
+  }
+  ~static_hash_map() { clear(); }
+  static_hash_map& operator=(const static_hash_map& other)
+  {
+    if (this != &other) {
+      clear();
+      for (size_t idx = 0; idx < N; ++idx) {
+        if (other.present[idx]) {
+          buffer[idx].emplace(other.get_obj_(idx));
+        }
+      }
+      buckets   = other.buckets;
+      present   = other.present;
+      free_list = other.free_list;
+      count     = other.count;
+    }
+    return *this;
+  }
+  static_hash_map& operator=(static_hash_map&& other) noexcept
+  {
+    if (this != &other) {
+      clear();
+      for (size_t idx = 0; idx < N; ++idx) {
+        if (other.present[idx]) {
+          buffer[idx].emplace(std::move(other.get_obj_(idx)));
+        }
+      }
+      buckets   = other.buckets;
+      present   = other.present;
+      free_list = other.free_list;
+      count     = other.count;
+      other.clear();
+    }
+    return *this;
+  }
+
+  bool contains(K id) const { return find_bucket_(id) != npos; }
+
+  bool insert(K id, const T& obj)
+  {
+    if (full() or contains(id)) {
+      return false;
+    }
+    emplace_(id, obj);
+    return true;
+  }
+  srsran::expected<iterator, T> insert(K id, T&& obj)
+  {
+    if (full() or contains(id)) {
+      return srsran::expected<iterator, T>(std::move(obj));
+    }
+    return iterator(this, emplace_(id, std::move(obj)));
+  }
+
+  template <typename U>
+  void overwrite(K id, U&& obj)
+  {
+    erase(id);
+    insert(id, std::forward<U>(obj));
+  }
+
+  bool erase(K id)
+  {
+    size_t b = find_bucket_(id);
+    if (b == npos) {
+      return false;
+    }
+    size_t idx = buckets[b].idx;
+    erase_bucket_(b);
+    destroy_(idx);
+    return true;
+  }
+
+  iterator erase(iterator it)
+  {
+    srsran_assert(it.idx < N and it.map == this, "Iterator out-of-bounds (%zd >= %zd)", it.idx, N);
+    iterator next = it;
+    ++next;
+    erase_bucket_(find_bucket_(it->first));
+    destroy_(it.idx);
+    return next;
+  }
+
+  void clear()
+  {
+    for (size_t idx = 0; idx < N and count > 0; ++idx) {
+      if (present[idx]) {
+        destroy_(idx);
+      }
+    }
+    for (bucket_t& b : buckets) {
+      b.dist = 0;
+    }
+  }
+
+  T& operator[](K id)
+  {
+    size_t b = find_bucket_(id);
+    srsran_assert(b != npos, "Accessing non-existent ID=%zd", (size_t)id);
+    return get_obj_(buckets[b].idx).second;
+  }
+  const T& operator[](K id) const
+  {
+    size_t b = find_bucket_(id);
+    srsran_assert(b != npos, "Accessing non-existent ID=%zd", (size_t)id);
+    return get_obj_(buckets[b].idx).second;
+  }
+
+  size_t size() const { return count; }
+  bool   empty() const { return count == 0; }
+  bool   full() const { return count == N; }
+  bool   has_space(K id) const { return not full() and not contains(id); }
+  size_t capacity() const { return N; }
+
+  iterator       begin() { return iterator(this, 0); }
+  iterator       end() { return iterator(this, N); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, N); }
+
+  iterator find(K id)
+  {
+    size_t b = find_bucket_(id);
+    return b == npos ? end() : iterator(this, buckets[b].idx);
+  }
+  const_iterator find(K id) const
+  {
+    size_t b = find_bucket_(id);
+    return b == npos ? end() : const_iterator(this, buckets[b].idx);
+  }
+
+private:
+  obj_t&       get_obj_(size_t idx) { return buffer[idx].get(); }
+  const obj_t& get_obj_(size_t idx) const { return buffer[idx].get(); }
+
+  /// Fibonacci hash, which spreads the consecutive keys
+  static size_t home_bucket_(K id)
+  {
+    return static_cast<size_t>((static_cast<uint64_t>(id) * 0x9e3779b97f4a7c15ULL) >> hash_shift);
+  }
+
+  size_t find_bucket_(K id) const
+  {
+    size_t b = home_bucket_(id);
+    // The keys are sorted by distance to their home bucket within a probe sequence, so the search can stop at the
+    // first bucket that is closer to its home than the key would be
+    for (uint16_t dist = 1; buckets[b].dist >= dist; ++dist, b = (b + 1) & mask) {
+      if (buckets[b].key == id) {
+        return b;
+      }
+    }
+    return npos;
+  }
+
+  template <typename U>
+  size_t emplace_(K id, U&& obj)
+  {
+    count++;
+    uint16_t idx = free_list[N - count];
+    buffer[idx].emplace(id, std::forward<U>(obj));
+    present[idx] = true;
+
+    // Robin-hood insertion: the key takes the place of the first key that is closer to its home bucket
+    bucket_t cur;
+    cur.key  = id;
+    cur.idx  = idx;
+    cur.dist = 1;
+    for (size_t b = home_bucket_(id);; b = (b + 1) & mask, cur.dist++) {
+      if (buckets[b].dist == 0) {
+        buckets[b] = cur;
+        break;
+      }
+      if (buckets[b].dist < cur.dist) {
+        std::swap(buckets[b], cur);
+      }
+    }
+    return idx;
+  }
+
+  void erase_bucket_(size_t b)
+  {
+    // Shift back the following keys of the probe sequence, instead of leaving a tombstone
+    for (size_t next = (b + 1) & mask; buckets[next].dist > 1; b = next, next = (next + 1) & mask) {
+      buckets[b] = buckets[next];
+      buckets[b].dist--;
+    }
+    buckets[b].dist = 0;
+  }
+
+  void destroy_(size_t idx)
+  {
+    get_obj_(idx).~obj_t();
+    present[idx]           = false;
+    free_list[N - count--] = static_cast<uint16_t>(idx);
+  }
+
+  std::array<bucket_t, nof_buckets>          buckets = {};
+  std::array<detail::type_storage<obj_t>, N> buffer;
+  std::array<bool, N>                        present;
+  std::array<uint16_t, N>                    free_list; ///< indexes of the free objects, in [0, N - count)
+  size_t                                     count = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_STATIC_HASH_MAP_H
@@ -22,6 +22,7 @@
 #ifndef SRSASN_COMMON_UTILS_H
 #define SRSASN_COMMON_UTILS_H
 
+#include "srsran/adt/pool/linear_allocator.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/support/srsran_assert.h"
@@ -29,7 +30,10 @@
 #include <cmath>
 #include <cstdint>
 #include <limits>
+#include <memory>
+#include <new>
 #include <string>
+#include <vector>
 
 namespace asn1 {
 
@@ -185,6 +189,151 @@ public:
   SRSASN_CODE align_bytes_zero();
 };
 
+/*********************
+     decode arena
+*********************/
+
+/**
+ * Memory arena for the dynamic fields (dyn_array, ext_array and copy_ptr) of decoded messages. While an arena_scope
+ * is active in a thread, these fields are allocated from the arena, and their deallocation only runs the destructors.
+ * The memory is released in one shot by reset() or by the arena destructor, so the objects allocated in the arena must
+ * be destroyed before. Copies made outside of the scope are allocated from the heap as usual.
+ */
+class decode_arena
+{
+public:
+  static const size_t default_chunk_size = 8192;
+
+  /// Arena that allocates chunks of chunk_size_ bytes from the heap
+  explicit decode_arena(size_t chunk_size_ = default_chunk_size) : chunk_size(chunk_size_) {}
+  /// Arena that allocates from buf first, and from heap chunks once buf is exhausted
+  decode_arena(void* buf, size_t buf_size, size_t chunk_size_ = default_chunk_size) :
+    chunk_size(chunk_size_), init_buf(buf), init_buf_size(buf_size), cur(buf, buf_size)
+  {}
+  decode_arena(const decode_arena&) = delete;
+  decode_arena& operator=(const decode_arena&) = delete;
+
+  void* allocate(size_t sz, size_t alignment)
+  {
+    void* p = cur.allocate(sz, alignment);
+    return p != nullptr ? p : allocate_chunk(sz, alignment);
+  }
+
+  /// Rewinds the arena. The heap chunks are kept for the next messages
+  void reset();
+
+  size_t nof_bytes_allocated() const { return prev_bytes + cur.nof_bytes_allocated(); }
+  size_t nof_heap_chunks() const { return chunks.size(); }
+
+private:
+  struct chunk_t {
+    std::unique_ptr<uint8_t[]> mem;
+    size_t                     size;
+  };
+
+  void* allocate_chunk(size_t sz, size_t alignment);
+
+  size_t                   chunk_size;
+  void*                    init_buf      = nullptr;
+  size_t                   init_buf_size = 0;
+  std::vector<chunk_t>     chunks;
+  size_t                   next_chunk = 0; ///< next heap chunk to allocate from
+  size_t                   prev_bytes = 0; ///< bytes allocated in the chunks before the current one
+  srsran::linear_allocator cur;
+};
+
+/// Arena whose first N bytes are stored in the object itself, e.g. on the stack of the decoding function
+template <size_t N>
+class static_decode_arena : public decode_arena
+{
+public:
+  explicit static_decode_arena(size_t chunk_size_ = default_chunk_size) : decode_arena(storage, N, chunk_size_) {}
+
+private:
+  alignas(alignof(std::max_align_t)) uint8_t storage[N];
+};
+
+/// Makes the dynamic fields of the ASN.1 objects created by this thread be allocated from arena during its lifetime
+class arena_scope
+{
+public:
+  explicit arena_scope(decode_arena& arena) : prev(current()) { current() = &arena; }
+  ~arena_scope() { current() = prev; }
+  arena_scope(const arena_scope&) = delete;
+  arena_scope& operator=(const arena_scope&) = delete;
+
+  static decode_arena* active() { return current(); }
+
+private:
+  static decode_arena*& current()
+  {
+    static thread_local decode_arena* arena = nullptr;
+    return arena;
+  }
+
+  decode_arena* prev;
+};
+
+/// Unpacks msg with its dynamic fields allocated from arena
+template <typename Msg>
+SRSASN_CODE unpack_in_arena(Msg& msg, cbit_ref& bref, decode_arena& arena)
+{
+  arena_scope scope(arena);
+  return msg.unpack(bref);
+}
+
+namespace detail {
+
+template <typename T>
+T* alloc_array(uint32_t n, bool& in_arena)
+{
+  decode_arena* arena = arena_scope::active();
+  in_arena            = arena != nullptr;
+  if (arena == nullptr) {
+    return new T[n];
+  }
+  T* p = static_cast<T*>(arena->allocate(sizeof(T) * n, alignof(T)));
+  for (uint32_t i = 0; i < n; ++i) {
+    new (p + i) T;
+  }
+  return p;
+}
+
+template <typename T>
+void free_array(T* p, uint32_t n, bool in_arena)
+{
+  if (not in_arena) {
+    delete[] p;
+    return;
+  }
+  for (uint32_t i = 0; i < n; ++i) {
+    p[i].~T();
+  }
+}
+
+template <typename T, typename... Args>
+T* alloc_object(bool& in_arena, Args&&... args)
+{
+  decode_arena* arena = arena_scope::active();
+  in_arena            = arena != nullptr;
+  if (arena == nullptr) {
+    return new T(std::forward<Args>(args)...);
+  }
+  return new (arena->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+}
+
+template <typename T>
+void free_object(T* p, bool in_arena)
+{
+  if (not in_arena) {
+    delete p;
+    return;
+  }
+  p->~T();
+}
+
+} // namespace detail
+
 /*********************
   function helpers
 *********************/
@@ -197,14 +346,17 @@ public:
   using const_iterator = const T*;
 
   dyn_array() = default;
-  explicit dyn_array(uint32_t new_size) : size_(new_size), cap_(new_size) { data_ = new T[size_]; }
+  explicit dyn_array(uint32_t new_size) : size_(new_size), cap_(new_size)
+  {
+    data_ = detail::alloc_array<T>(size_, in_arena_);
+  }
   dyn_array(const dyn_array<T>& other) : dyn_array(&other[0], other.size_) {}
   dyn_array(const T* ptr, uint32_t nof_items)
   {
     size_ = nof_items;
     cap_  = nof_items;
     if (ptr != NULL) {
-      data_ = new T[cap_];
+      data_ = detail::alloc_array<T>(cap_, in_arena_);
       std::copy(ptr, ptr + size_, data_);
     } else {
       data_ = NULL;
@@ -213,7 +365,7 @@ public:
   ~dyn_array()
   {
     if (data_ != NULL) {
-      delete[] data_;
+      detail::free_array(data_, cap_, in_arena_);
     }
   }
   uint32_t      size() const { return size_; }
@@ -239,10 +391,12 @@ public:
       return;
     }
 
-    T* old_data = data_;
-    cap_        = new_size > new_cap ? new_size : new_cap;
+    T*       old_data     = data_;
+    uint32_t old_cap      = cap_;
+    bool     old_in_arena = in_arena_;
+    cap_                  = new_size > new_cap ? new_size : new_cap;
     if (cap_ > 0) {
-      data_ = new T[cap_];
+      data_ = detail::alloc_array<T>(cap_, in_arena_);
       if (old_data != NULL) {
         srsran_assert(cap_ > size_, "Old size larger than new capacity in dyn_array\n");
         std::copy(&old_data[0], &old_data[size_], data_);
@@ -252,7 +406,7 @@ public:
     }
     size_ = new_size;
     if (old_data != NULL) {
-      delete[] old_data;
+      detail::free_array(old_data, old_cap, old_in_arena);
     }
   }
   iterator erase(iterator it)
@@ -287,9 +441,10 @@ public:
   const_iterator end() const { return &data_[size()]; }
 
 private:
-  T*       data_ = nullptr;
-  uint32_t size_ = 0;
-  uint32_t cap_  = 0;
+  T*       data_     = nullptr;
+  uint32_t size_     = 0;
+  uint32_t cap_      = 0;
+  bool     in_arena_ = false;
 };
 
 template <class T, uint32_t MAX_N>
@@ -360,6 +515,7 @@ public:
     } else {
       head              = other.head;
       small_buffer.cap_ = other.small_buffer.cap_;
+      in_arena_         = other.in_arena_;
       other.head        = &other.small_buffer.data[0];
       other.size_       = 0;
     }
@@ -367,7 +523,7 @@ public:
   ~ext_array()
   {
     if (not is_in_small_buffer()) {
-      delete[] head;
+      detail::free_array(head, small_buffer.cap_, in_arena_);
     }
   }
   ext_array<T, Nthres>& operator=(const ext_array<T, Nthres>& other)
@@ -405,13 +561,14 @@ public:
       size_ = new_size;
       return;
     }
-    T*       old_data = head;
-    uint32_t newcap   = new_size + 5;
-    head              = new T[newcap];
-    std::copy(&small_buffer.data[0], &small_buffer.data[size_], head);
+    T*       old_data     = head;
+    bool     old_in_arena = in_arena_;
+    uint32_t newcap       = new_size + 5;
+    head                  = detail::alloc_array<T>(newcap, in_arena_);
+    std::copy(&old_data[0], &old_data[size_], head);
     size_ = new_size;
     if (old_data != &small_buffer.data[0]) {
-      delete[] old_data;
+      detail::free_array(old_data, small_buffer.cap_, old_in_arena);
     }
     small_buffer.cap_ = newcap;
   }
@@ -423,6 +580,7 @@ private:
     uint32_t cap_;
   } small_buffer;
   uint32_t size_;
+  bool     in_arena_ = false;
   T*       head;
 };
 
@@ -712,9 +870,7 @@ SRSASN_CODE fixed_octstring<N, aligned>::pack(bit_ref& bref) const
   if (aligned and N > 2) {
     bref.align_bytes_zero();
   }
-  for (uint32_t i = 0; i < size(); ++i) {
-    HANDLE_CODE(bref.pack(octets_[i], 8));
-  }
+  HANDLE_CODE(bref.pack_bytes(&octets_[0], size()));
   return SRSASN_SUCCESS;
 }
 
@@ -724,9 +880,7 @@ SRSASN_CODE fixed_octstring<N, aligned>::unpack(cbit_ref& bref)
   if (aligned and N > 2) {
     bref.align_bytes();
   }
-  for (uint32_t i = 0; i < size(); ++i) {
-    HANDLE_CODE(bref.unpack(octets_[i], 8));
-  }
+  HANDLE_CODE(bref.unpack_bytes(&octets_[0], size()));
   return SRSASN_SUCCESS;
 }
 
@@ -770,9 +924,7 @@ public:
     if (aligned) {
       bref.align_bytes_zero();
     }
-    for (uint32_t i = 0; i < size(); ++i) {
-      HANDLE_CODE(bref.pack(octets_[i], 8));
-    }
+    HANDLE_CODE(bref.pack_bytes(&octets_[0], size()));
     return SRSASN_SUCCESS;
   }
   SRSASN_CODE unpack(cbit_ref& bref)
@@ -783,9 +935,7 @@ public:
     if (aligned) {
       bref.align_bytes();
     }
-    for (uint32_t i = 0; i < size(); ++i) {
-      HANDLE_CODE(bref.unpack(octets_[i], 8));
-    }
+    HANDLE_CODE(bref.unpack_bytes(&octets_[0], size()));
     return SRSASN_SUCCESS;
   }
 
@@ -1167,20 +1317,26 @@ class copy_ptr
 public:
   copy_ptr() : ptr(nullptr) {}
   explicit copy_ptr(T* ptr_) : ptr(ptr_) {}
-  copy_ptr(copy_ptr<T>&& other) noexcept : ptr(other.ptr) { other.ptr = nullptr; }
-  copy_ptr(const copy_ptr<T>& other) { ptr = (other.ptr == nullptr) ? nullptr : new T(*other.ptr); }
+  copy_ptr(copy_ptr<T>&& other) noexcept : ptr(other.ptr), in_arena(other.in_arena) { other.ptr = nullptr; }
+  copy_ptr(const copy_ptr<T>& other)
+  {
+    ptr = (other.ptr == nullptr) ? nullptr : detail::alloc_object<T>(in_arena, *other.ptr);
+  }
   ~copy_ptr() { destroy_(); }
   copy_ptr<T>& operator=(const copy_ptr<T>& other)
   {
     if (this != &other) {
-      reset((other.ptr == nullptr) ? nullptr : new T(*other.ptr));
+      destroy_();
+      ptr = (other.ptr == nullptr) ? nullptr : detail::alloc_object<T>(in_arena, *other.ptr);
     }
     return *this;
   }
   copy_ptr<T>& operator=(copy_ptr<T>&& other) noexcept
   {
     if (this != &other) {
+      destroy_();
       ptr       = other.ptr;
+      in_arena  = other.in_arena;
       other.ptr = nullptr;
     }
     return *this;
@@ -1194,6 +1350,12 @@ public:
   const T* get() const { return ptr; }
   T*       release()
   {
+    if (in_arena and ptr != nullptr) {
+      // the caller owns the returned object, so it is moved to the heap
+      T* ret = new T(std::move(*ptr));
+      reset();
+      return ret;
+    }
     T* ret = ptr;
     ptr    = nullptr;
     return ret;
@@ -1201,15 +1363,13 @@ public:
   void reset(T* ptr_ = nullptr)
   {
     destroy_();
-    ptr = ptr_;
+    ptr      = ptr_;
+    in_arena = false;
   }
   void set_present(bool flag = true)
   {
-    if (flag) {
-      reset(new T());
-    } else {
-      reset();
-    }
+    destroy_();
+    ptr = flag ? detail::alloc_object<T>(in_arena) : nullptr;
   }
   bool is_present() const { return get() != nullptr; }
 
@@ -1217,10 +1377,11 @@ private:
   void destroy_()
   {
     if (ptr != NULL) {
-      delete ptr;
+      detail::free_object(ptr, in_arena);
     }
   }
-  T* ptr;
+  T*   ptr;
+  bool in_arena = false;
 };
 
 template <class T>
@@ -1884,6 +2045,54 @@ public:
   }
 };
 
+/************************
+   AP PDU peek helpers
+************************/
+
+/// Location of the value of a ProtocolIE-Field in an encoded PDU
+struct protocol_ie_ref_t {
+  uint32_t       id;
+  const uint8_t* data;
+  uint32_t       len;
+};
+
+/**
+ * Elementary procedure PDU of S1AP/NGAP (a CHOICE of initiatingMessage, successfulOutcome and unsuccessfulOutcome,
+ * with the procedure code and a message made of a ProtocolIE-Container), decoded only up to the location of the IE
+ * values. The IEs needed are decoded with unpack_ie_value(), and the whole PDU can still be unpacked from the buffer.
+ */
+struct ap_pdu_peek_t {
+  static const uint32_t max_ies = 32;
+
+  uint32_t          pdu_type;  ///< index of the PDU CHOICE alternative
+  uint32_t          proc_code; ///< procedureCode
+  bool              msg_ext;   ///< extension bit of the message
+  uint32_t          nof_ies;
+  protocol_ie_ref_t ies[max_ies];
+
+  const protocol_ie_ref_t* find_ie(uint32_t id) const
+  {
+    for (uint32_t i = 0; i < nof_ies; ++i) {
+      if (ies[i].id == id) {
+        return &ies[i];
+      }
+    }
+    return nullptr;
+  }
+};
+
+/// Decodes the PDU type, procedure code and IE locations of an S1AP/NGAP PDU. Fails for messages with more than
+/// ap_pdu_peek_t::max_ies IEs
+SRSASN_CODE peek_ap_pdu(ap_pdu_peek_t& peek, const uint8_t* buf, uint32_t len);
+
+/// Unpacks the value of the IE ie of a peeked PDU
+template <typename T>
+SRSASN_CODE unpack_ie_value(T& value, const protocol_ie_ref_t& ie)
+{
+  cbit_ref bref(ie.data, ie.len);
+  return value.unpack(bref);
+}
+
 } // namespace asn1
 
 #endif // SRSASN_COMMON_UTILS_H
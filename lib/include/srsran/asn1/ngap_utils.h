@@ -34,6 +34,22 @@ struct rrcestablishment_cause_opts;
 struct cause_radio_network_opts;
 using rrcestablishment_cause_e = enumerated<rrcestablishment_cause_opts, true, 1>;
 using cause_radio_network_e    = enumerated<cause_radio_network_opts, true, 2>;
+
+/**************************
+ *     NGAP PDU peek
+ *************************/
+
+/// NGAP PDU decoded up to its IEs, with the UE NGAP IDs of UE-associated messages
+struct ngap_pdu_peek_t : public ap_pdu_peek_t {
+  bool     amf_ue_ngap_id_present;
+  bool     ran_ue_ngap_id_present;
+  uint64_t amf_ue_ngap_id;
+  uint32_t ran_ue_ngap_id;
+};
+
+/// Decodes the procedure code, the IE locations and the AMF-UE-NGAP-ID and RAN-UE-NGAP-ID IEs of an NGAP PDU
+SRSASN_CODE peek_ngap_pdu(ngap_pdu_peek_t& peek, const uint8_t* buf, uint32_t len);
+
 } // namespace ngap
 } // namespace asn1
 
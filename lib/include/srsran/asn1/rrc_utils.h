@@ -59,6 +59,7 @@ struct pucch_cfg_common_s;
 struct srs_ul_cfg_common_c;
 struct ul_pwr_ctrl_common_s;
 struct scell_to_add_mod_r10_s;
+struct drx_cfg_c;
 struct mbms_notif_cfg_r9_s;
 struct mbsfn_area_info_r9_s;
 struct mbsfn_sf_cfg_s;
@@ -136,6 +137,7 @@ void set_phy_cfg_t_common_srs(phy_cfg_t* cfg, const asn1::rrc::srs_ul_cfg_common
 void set_phy_cfg_t_common_pwr_ctrl(phy_cfg_t* cfg, const asn1::rrc::ul_pwr_ctrl_common_s& asn1_type);
 void set_phy_cfg_t_scell_config(phy_cfg_t* cfg, const asn1::rrc::scell_to_add_mod_r10_s& asn1_type);
 void set_phy_cfg_t_enable_64qam(phy_cfg_t* cfg, const bool enabled);
+void set_phy_cfg_t_drx_cfg(phy_cfg_t* cfg, const asn1::rrc::drx_cfg_c& asn1_type);
 
 /***************************
  *      Measurements
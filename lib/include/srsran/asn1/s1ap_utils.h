@@ -85,6 +85,21 @@ bool equal_obj_id(const T& lhs, const T& rhs)
   return get_obj_id(lhs) == get_obj_id(rhs);
 }
 
+/**************************
+ *     S1AP PDU peek
+ *************************/
+
+/// S1AP PDU decoded up to its IEs, with the UE S1AP IDs of UE-associated messages
+struct s1ap_pdu_peek_t : public ap_pdu_peek_t {
+  bool     mme_ue_s1ap_id_present;
+  bool     enb_ue_s1ap_id_present;
+  uint32_t mme_ue_s1ap_id;
+  uint32_t enb_ue_s1ap_id;
+};
+
+/// Decodes the procedure code, the IE locations and the MME-UE-S1AP-ID and eNB-UE-S1AP-ID IEs of an S1AP PDU
+SRSASN_CODE peek_s1ap_pdu(s1ap_pdu_peek_t& peek, const uint8_t* buf, uint32_t len);
+
 } // namespace s1ap
 } // namespace asn1
 
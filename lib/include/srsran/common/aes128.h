@@ -0,0 +1,75 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_AES128_H
+#define SRSRAN_AES128_H
+
+/******************************************************************************
+ * AES-128 block cipher with a key schedule expanded once per key, for the
+ * 128-EEA2 (CTR) and 128-EIA2 (CMAC) algorithms of the PDCP user plane.
+ *
+ * The blocks are encrypted with AES-NI on x86 CPUs that support it (detected
+ * at run time) and with the ARMv8 Cryptography Extension when the compiler
+ * targets it (e.g. -march=armv8-a+crypto), otherwise with a portable
+ * implementation.
+ *
+ * Reference: FIPS 197, NIST SP 800-38A (CTR), RFC 4493 (CMAC)
+ *****************************************************************************/
+
+#include <stdint.h>
+
+#define AES128_BLOCK_LEN 16
+#define AES128_NOF_ROUNDS 10
+
+/* Expanded AES-128 key, with the CMAC subkeys K1 and K2 */
+typedef struct {
+  uint8_t rk[AES128_NOF_ROUNDS + 1][AES128_BLOCK_LEN];
+  uint8_t k1[AES128_BLOCK_LEN];
+  uint8_t k2[AES128_BLOCK_LEN];
+} aes128_key_t;
+
+/* CTR job of a batch, len bytes of in are ciphered into out (which can be the same buffer) from the counter block */
+typedef struct {
+  const uint8_t* in;
+  uint8_t*       out;
+  uint32_t       len;
+  uint8_t        nonce_cnt[AES128_BLOCK_LEN];
+} aes128_ctr_job_t;
+
+/* Expands the 128-bit key k and derives the CMAC subkeys */
+void aes128_set_key(aes128_key_t* key, const uint8_t* k);
+
+/* Returns true if the blocks are encrypted with the CPU AES instructions */
+bool aes128_is_accelerated();
+
+/* Encrypts nof_blocks independent blocks (ECB) */
+void aes128_encrypt_blocks(const aes128_key_t* key, const uint8_t* in, uint8_t* out, uint32_t nof_blocks);
+
+/* Ciphers len bytes in CTR mode, the 128-bit big endian counter block nonce_cnt is advanced past the last block used */
+void aes128_ctr(const aes128_key_t* key, uint8_t* nonce_cnt, const uint8_t* in, uint8_t* out, uint32_t len);
+
+/* Ciphers the jobs in CTR mode, the blocks of the different jobs are encrypted together */
+void aes128_ctr_batch(const aes128_key_t* key, aes128_ctr_job_t* jobs, uint32_t nof_jobs);
+
+/* Chains nof_blocks complete blocks into the CBC-MAC state, the CMAC padding and subkeys are left to the caller */
+void aes128_cbc_mac(const aes128_key_t* key, uint8_t* state, const uint8_t* in, uint32_t nof_blocks);
+
+#endif // SRSRAN_AES128_H
@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "srsran/adt/pool/fixed_size_pool.h"
+#include "srsran/adt/pool/pool_registry.h"
 #include "srsran/common/common.h"
 #include "srsran/srslog/srslog.h"
 
@@ -51,7 +52,8 @@ class buffer_pool
 {
 public:
   // non-static methods
-  buffer_pool(int capacity_ = -1)
+  buffer_pool(int capacity_ = -1, const char* name = "buffer_pool") :
+    stats(name, sizeof(buffer_t), capacity_ > 0 ? size_t(capacity_) : size_t(POOL_SIZE))
   {
     uint32_t nof_buffers = POOL_SIZE;
     if (capacity_ > 0) {
@@ -105,6 +107,7 @@ public:
 
   buffer_t* allocate(const char* debug_name = nullptr, bool blocking = false)
   {
+    auto t_start = stats.on_alloc_start();
     pthread_mutex_lock(&mutex);
     buffer_t* b = nullptr;
 
@@ -141,6 +144,7 @@ public:
     }
 
     pthread_mutex_unlock(&mutex);
+    stats.on_alloc_end(t_start, sizeof(buffer_t), b != nullptr);
     return b;
   }
 
@@ -150,6 +154,7 @@ public:
     pthread_mutex_lock(&mutex);
     if (std::find(pool.cbegin(), pool.cend(), b) != pool.cend()) {
       free_list.push_back(b);
+      stats.on_dealloc();
       ret = true;
     }
     pthread_cond_signal(&cv_not_empty);
@@ -164,6 +169,7 @@ private:
   pthread_mutex_t        mutex;
   pthread_cond_t         cv_not_empty;
   uint32_t               capacity;
+  pool_stats             stats;
 };
 
 /// Type of global byte buffer pool
@@ -0,0 +1,203 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_BYTE_BUFFER_CHAIN_H
+#define SRSRAN_BYTE_BUFFER_CHAIN_H
+
+#include "srsran/adt/bounded_vector.h"
+#include "srsran/common/buffer_pool.h"
+#include <memory>
+
+namespace srsran {
+
+/// Reference counted byte buffer, whose contents can be shared by several byte_buffer_slice objects
+using shared_byte_buffer_t = std::shared_ptr<byte_buffer_t>;
+
+/******************************************************************************
+ * Byte buffer slice
+ *
+ * Contiguous range of bytes of a shared byte buffer. The slice keeps the buffer
+ * alive, so the bytes remain valid after the original owner releases it or
+ * advances its msg pointer.
+ *****************************************************************************/
+class byte_buffer_slice
+{
+public:
+  byte_buffer_slice() = default;
+  byte_buffer_slice(shared_byte_buffer_t buf_, const uint8_t* data_, uint32_t len_) :
+    buf(std::move(buf_)), ptr(data_), len(len_)
+  {
+    srsran_assert(buf != nullptr and ptr >= buf->buffer and ptr + len <= buf->buffer + sizeof(buf->buffer),
+                  "Slice out of the bounds of the byte buffer");
+  }
+
+  const uint8_t* data() const { return ptr; }
+  uint32_t       size() const { return len; }
+  bool           empty() const { return len == 0; }
+  byte_buffer_t* buffer() const { return buf.get(); }
+
+  /// Grows the slice by n bytes of the same buffer
+  void extend(uint32_t n)
+  {
+    srsran_assert(ptr + len + n <= buf->buffer + sizeof(buf->buffer), "Slice out of the bounds of the byte buffer");
+    len += n;
+  }
+
+private:
+  shared_byte_buffer_t buf;
+  const uint8_t*       ptr = nullptr;
+  uint32_t             len = 0;
+};
+
+/******************************************************************************
+ * Byte buffer chain
+ *
+ * Sequence of up to MaxSlices slices, possibly of different buffers, that is
+ * read as a single PDU. Segments are added by reference with append(), so a
+ * PDU can be built from SDU segments without copying them, and gathered into
+ * the transmit buffer with copy_to(). Segments can also be copied with
+ * append_copy(), which packs them into a buffer owned by the chain, e.g.
+ * once the slices are exhausted.
+ *****************************************************************************/
+template <size_t MaxSlices>
+class byte_buffer_chain
+{
+public:
+  using const_iterator = const byte_buffer_slice*;
+
+  byte_buffer_chain()                         = default;
+  byte_buffer_chain(const byte_buffer_chain&) = delete;
+  byte_buffer_chain(byte_buffer_chain&& other) noexcept :
+    slices(std::move(other.slices)), len(other.len), last_is_copy(other.last_is_copy)
+  {
+    other.clear();
+  }
+  byte_buffer_chain& operator=(const byte_buffer_chain&) = delete;
+  byte_buffer_chain& operator=(byte_buffer_chain&& other) noexcept
+  {
+    if (this != &other) {
+      slices       = std::move(other.slices);
+      len          = other.len;
+      last_is_copy = other.last_is_copy;
+      other.clear();
+    }
+    return *this;
+  }
+
+  static constexpr size_t max_slices() { return MaxSlices; }
+  size_t                  nof_slices() const { return slices.size(); }
+  bool                    full() const { return slices.size() == MaxSlices; }
+  bool                    empty() const { return len == 0; }
+  uint32_t                length() const { return len; }
+  const_iterator          begin() const { return slices.begin(); }
+  const_iterator          end() const { return slices.end(); }
+
+  void clear()
+  {
+    slices.clear();
+    len          = 0;
+    last_is_copy = false;
+  }
+
+  /// Appends a slice by reference. The chain must not be full
+  void append(byte_buffer_slice slice)
+  {
+    srsran_assert(not full(), "Byte buffer chain is full (%zd slices)", MaxSlices);
+    len += slice.size();
+    slices.push_back(std::move(slice));
+    last_is_copy = false;
+  }
+
+  /// Makes room for copying nof_bytes at the end of the chain. The last slice is reused if it was also copied,
+  /// otherwise a new buffer is allocated. Returns false if the chain is full or the buffer allocation fails
+  bool reserve_copy(uint32_t nof_bytes)
+  {
+    if (last_is_copy and not slices.empty() and slices.back().buffer()->get_tailroom() >= nof_bytes) {
+      return true;
+    }
+    if (full()) {
+      return false;
+    }
+    shared_byte_buffer_t buf = make_byte_buffer();
+    if (buf == nullptr or buf->get_tailroom() < nof_bytes) {
+      return false;
+    }
+    slices.push_back(byte_buffer_slice(buf, buf->msg, 0));
+    last_is_copy = true;
+    return true;
+  }
+
+  /// Copies nof_bytes at the end of the chain. Returns false if there is no room for them (see reserve_copy())
+  bool append_copy(const uint8_t* src, uint32_t nof_bytes)
+  {
+    if (not reserve_copy(nof_bytes)) {
+      return false;
+    }
+    byte_buffer_slice& last = slices.back();
+    byte_buffer_t*     buf  = last.buffer();
+    memcpy(buf->msg + buf->N_bytes, src, nof_bytes);
+    buf->N_bytes += nof_bytes;
+    last.extend(nof_bytes);
+    len += nof_bytes;
+    return true;
+  }
+
+  /// Gathers all the bytes of the chain into dst. Returns the number of bytes copied
+  uint32_t copy_to(uint8_t* dst) const
+  {
+    uint8_t* ptr = dst;
+    for (const byte_buffer_slice& s : slices) {
+      memcpy(ptr, s.data(), s.size());
+      ptr += s.size();
+    }
+    return ptr - dst;
+  }
+
+  /// Gathers nof_bytes of the chain, starting at the given offset, into dst. Returns the number of bytes copied
+  uint32_t copy_to(uint8_t* dst, uint32_t offset, uint32_t nof_bytes) const
+  {
+    uint8_t* ptr = dst;
+    for (const byte_buffer_slice& s : slices) {
+      if (nof_bytes == 0) {
+        break;
+      }
+      if (offset >= s.size()) {
+        offset -= s.size();
+        continue;
+      }
+      uint32_t n = std::min(s.size() - offset, nof_bytes);
+      memcpy(ptr, s.data() + offset, n);
+      ptr += n;
+      nof_bytes -= n;
+      offset = 0;
+    }
+    return ptr - dst;
+  }
+
+private:
+  bounded_vector<byte_buffer_slice, MaxSlices> slices;
+  uint32_t                                     len          = 0;
+  bool                                         last_is_copy = false; ///< the last slice points to a buffer of the chain
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_BYTE_BUFFER_CHAIN_H
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         futex_util.h
+ *  Description:  Spin-then-sleep waiting on a 32-bit atomic word, with the
+ *                sleep implemented by a process-private Linux futex.
+ *  Reference:    futex(2)
+ *****************************************************************************/
+
+#ifndef SRSRAN_FUTEX_UTIL_H
+#define SRSRAN_FUTEX_UTIL_H
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace srsran {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex words must be plain 32-bit integers");
+
+/// Hint to the CPU that the thread is busy-waiting
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+/// Sleeps while word == val. It may return spuriously, so the caller has to check its condition again
+inline void futex_wait(std::atomic<uint32_t>& word, uint32_t val)
+{
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, val, nullptr, nullptr, 0);
+}
+
+/// Sleeps while word == val, for at most timeout_ns nanoseconds. It may return spuriously
+inline void futex_wait_for(std::atomic<uint32_t>& word, uint32_t val, int64_t timeout_ns)
+{
+  struct timespec ts = {static_cast<time_t>(timeout_ns / 1000000000), static_cast<long>(timeout_ns % 1000000000)};
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, val, &ts, nullptr, 0);
+}
+
+/// Wakes up one of the threads sleeping on word
+inline void futex_wake_one(std::atomic<uint32_t>& word)
+{
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+/// Wakes up all the threads sleeping on word
+inline void futex_wake_all(std::atomic<uint32_t>& word)
+{
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+} // namespace srsran
+
+#endif // SRSRAN_FUTEX_UTIL_H
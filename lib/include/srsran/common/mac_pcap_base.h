@@ -31,8 +31,19 @@
 #include <mutex>
 #include <stdint.h>
 #include <thread>
+#include <vector>
 
 namespace srsran {
+
+/// Filters applied to the MAC PDUs before they are copied into the capture
+struct mac_pcap_filter_t {
+  std::vector<uint16_t> rntis;                 ///< capture only the PDUs of these RNTIs, empty for all
+  std::vector<uint8_t>  lcids;                 ///< capture only the EUTRA PDUs with subheaders of these LCIDs
+  bool                  crc_fail_only = false; ///< capture only the PDUs that failed the CRC
+  uint32_t              sample_rate   = 1;     ///< capture one out of sample_rate PDUs passing the filters
+  uint32_t              snap_len      = 0;     ///< truncate the PDUs to this many bytes, 0 to capture them whole
+};
+
 class mac_pcap_base : protected srsran::thread
 {
 public:
@@ -49,6 +60,9 @@ public:
 
   void set_ue_id(uint16_t ue_id);
 
+  /// Sets the capture filters, must be called before the capture is opened
+  void set_filter(const mac_pcap_filter_t& filter);
+
   // EUTRA
   void
   write_ul_crnti(uint8_t* pdu, uint32_t pdu_len_bytes, uint16_t crnti, uint32_t reTX, uint32_t tti, uint8_t cc_idx);
@@ -103,9 +117,13 @@ protected:
     MAC_Context_Info_t    context;
     mac_nr_context_info_t context_nr;
     unique_byte_buffer_t  pdu;
+    uint32_t              orig_len; // length of the PDU before truncation
   } pcap_pdu_t;
 
-  virtual void write_pdu(pcap_pdu_t& pdu) = 0;
+  /// Called from the PHY worker context with the context of each PDU. By default the payload is copied into a buffer
+  /// and handed to the writer thread, which calls write_pdu().
+  virtual void queue_pdu(pcap_pdu_t& pdu, const uint8_t* payload, uint32_t payload_len);
+  virtual void write_pdu(pcap_pdu_t& pdu) {}
   void         run_thread() final;
 
   std::mutex                              mutex;
@@ -116,6 +134,12 @@ protected:
   int                                     emergency_handler_id = -1;
 
 private:
+  bool filter_pdu(const uint8_t* payload, uint32_t payload_len, uint16_t rnti, bool crc_ok, srsran_rat_t rat);
+
+  mac_pcap_filter_t     filter;
+  uint32_t              lcid_mask = 0;
+  std::atomic<uint32_t> sample_count{0};
+
   void pack_and_queue(uint8_t* payload,
                       uint32_t payload_len,
                       uint16_t ue_id,
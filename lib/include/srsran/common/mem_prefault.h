@@ -0,0 +1,50 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_MEM_PREFAULT_H
+#define SRSRAN_MEM_PREFAULT_H
+
+#include <cstddef>
+#include <string>
+
+namespace srsran {
+
+/**
+ * Startup helpers that fault in the memory of the process before it serves traffic. Without them, the buffers
+ * allocated during the initialization of the PHY and of the memory pools are only backed by physical pages on their
+ * first write, so the first minutes of traffic pay for page faults in the real-time threads.
+ */
+
+/// Faults in the pages of [ptr, ptr + len) for writing, without modifying their contents. It is safe to call while
+/// other threads use the memory. Returns the number of bytes of the pages populated
+size_t mem_prefault(void* ptr, size_t len);
+
+/// Grows the heap of the calling thread by len bytes of faulted in memory, and stops the allocator from returning it to
+/// the kernel and from serving large blocks with their own mapping, so that the allocations that follow reuse these
+/// pages. Only the arena of the calling thread is reserved. Returns the number of bytes reserved
+size_t mem_reserve_heap(size_t len);
+
+/// Locks the current and future pages of the process in memory. On failure, writes the reason to err
+bool mem_lock_all(std::string& err);
+
+} // namespace srsran
+
+#endif // SRSRAN_MEM_PREFAULT_H
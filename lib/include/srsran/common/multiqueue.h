@@ -29,12 +29,19 @@
 #define SRSRAN_MULTIQUEUE_H
 
 #include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/detail/type_storage.h"
 #include "srsran/adt/move_callback.h"
 #include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <queue>
+#include <sys/eventfd.h>
+#include <thread>
+#include <unistd.h>
 #include <vector>
 
 namespace srsran {
@@ -48,6 +55,9 @@ namespace srsran {
  * The class will pop from the several created ports in a round-robin fashion.
  * The popping() interface is not safe-thread. That means, that it is expected that only one thread will
  * be popping tasks.
+ * Each port is a bounded MPSC ring where the producers reserve a slot with atomic operations, so pushing does not
+ * take any lock unless the port is full (blocking push). The consumer sleeps on an eventfd, that the producers only
+ * signal when the consumer is about to sleep or sleeping.
  * @tparam myobj message type
  */
 template <typename myobj>
@@ -56,37 +66,38 @@ class multiqueue_handler
   class input_port_impl
   {
   public:
-    input_port_impl(uint32_t cap, multiqueue_handler<myobj>* parent_) : buffer(cap), parent(parent_) {}
+    input_port_impl(uint32_t cap, multiqueue_handler<myobj>* parent_) : parent(parent_), cap_(cap)
+    {
+      while (ring_size < cap_) {
+        ring_size <<= 1U;
+      }
+      cells.reset(new cell_t[ring_size]);
+      for (size_t i = 0; i < ring_size; ++i) {
+        cells[i].seq.store(i, std::memory_order_relaxed);
+      }
+    }
     input_port_impl(const input_port_impl&) = delete;
     input_port_impl(input_port_impl&&)      = delete;
     input_port_impl& operator=(const input_port_impl&) = delete;
     input_port_impl& operator=(input_port_impl&&) = delete;
     ~input_port_impl() { deactivate_blocking(); }
 
-    size_t capacity() const { return buffer.max_size(); }
-    size_t size() const
-    {
-      std::lock_guard<std::mutex> lock(q_mutex);
-      return buffer.size();
-    }
-    bool active() const
-    {
-      std::lock_guard<std::mutex> lock(q_mutex);
-      return active_;
-    }
+    size_t capacity() const { return cap_; }
+    size_t size() const { return count.load(std::memory_order_relaxed); }
+    bool   active() const { return active_.load(std::memory_order_relaxed); }
+
+    /// Deactivation only unblocks the pushing threads, the port is emptied by deactivate_blocking()
     void set_active(bool val)
     {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      if (val == active_) {
+      if (val == active_.exchange(val)) {
         // no-op
         return;
       }
-      active_ = val;
-
-      if (not active_) {
-        buffer.clear();
-        lock.unlock();
+      if (not val) {
         // unlock blocked pushing threads
+        {
+          std::lock_guard<std::mutex> lock(q_mutex);
+        }
         cv_full.notify_all();
       }
     }
@@ -95,11 +106,15 @@ class multiqueue_handler
     {
       set_active(false);
 
-      // wait for all the pushers to unlock
-      std::unique_lock<std::mutex> lock(q_mutex);
-      while (nof_waiting > 0) {
-        cv_exit.wait(lock);
+      // wait for all the pushers to leave
+      {
+        std::unique_lock<std::mutex> lock(q_mutex);
+        while (nof_pushing.load() > 0) {
+          cv_exit.wait(lock);
+        }
       }
+      std::lock_guard<std::mutex> lock(parent->mutex);
+      clear_();
     }
 
     template <typename T>
@@ -118,67 +133,99 @@ class multiqueue_handler
       return {std::move(o)};
     }
 
+    /// Called by the consumer with the handler mutex held
     bool try_pop(myobj& obj)
     {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      return pop_(lock, obj);
+      cell_t& cell = cells[head & (ring_size - 1)];
+      if (cell.seq.load(std::memory_order_acquire) != head + 1) {
+        return false;
+      }
+      obj = std::move(cell.obj.get());
+      cell.obj.destroy();
+      cell.seq.store(head + ring_size, std::memory_order_release);
+      head++;
+      count.fetch_sub(1);
+      if (nof_waiting.load() > 0) {
+        {
+          std::lock_guard<std::mutex> lock(q_mutex);
+        }
+        cv_full.notify_one();
+      }
+      return true;
     }
 
-    bool try_pop(myobj& obj, bool& try_lock_success)
+    /// Called with the handler mutex held, once there are no pushers
+    void clear_()
     {
-      std::unique_lock<std::mutex> lock(q_mutex, std::try_to_lock);
-      try_lock_success = lock.owns_lock();
-      return try_lock_success ? pop_(lock, obj) : false;
+      myobj obj;
+      while (try_pop(obj)) {
+      }
     }
 
   private:
-    template <typename T>
-    bool push_(T* o, bool blocking) noexcept
+    struct cell_t {
+      std::atomic<size_t>         seq{0};
+      detail::type_storage<myobj> obj;
+    };
+
+    bool try_reserve_()
     {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      if (not blocking) {
-        // non-blocking case
-        if (not active_ or buffer.full()) {
-          return false;
-        }
-      } else {
-        // blocking case
-        while (active_ and buffer.full()) {
-          nof_waiting++;
-          cv_full.wait(lock);
-          nof_waiting--;
-        }
-        if (not active_) {
-          lock.unlock();
-          cv_exit.notify_one();
-          return false;
+      size_t cur = count.load();
+      while (cur < cap_) {
+        if (count.compare_exchange_weak(cur, cur + 1)) {
+          return true;
         }
       }
-      buffer.push(std::forward<T>(*o));
-      return true;
+      return false;
     }
 
-    bool pop_(std::unique_lock<std::mutex>& lock, myobj& obj)
+    template <typename T>
+    bool push_(T* o, bool blocking) noexcept
     {
-      if (buffer.empty()) {
-        return false;
+      nof_pushing.fetch_add(1);
+      bool success = active_.load() and try_reserve_();
+      if (not success and blocking and active_.load()) {
+        // full port. The consumer notifies cv_full when nof_waiting > 0
+        std::unique_lock<std::mutex> lock(q_mutex);
+        nof_waiting.fetch_add(1);
+        while (active_.load() and not(success = try_reserve_())) {
+          cv_full.wait(lock);
+        }
+        nof_waiting.fetch_sub(1);
       }
-      obj = std::move(buffer.top());
-      buffer.pop();
-      if (nof_waiting > 0) {
-        lock.unlock();
-        cv_full.notify_one();
+      if (success) {
+        // The reserved slot was released by the consumer, as count <= cap <= ring_size
+        size_t  pos  = tail.fetch_add(1, std::memory_order_relaxed);
+        cell_t& cell = cells[pos & (ring_size - 1)];
+        while (cell.seq.load(std::memory_order_acquire) != pos) {
+          std::this_thread::yield();
+        }
+        cell.obj.emplace(std::forward<T>(*o));
+        cell.seq.store(pos + 1, std::memory_order_release);
+        parent->notify_consumer_();
       }
-      return true;
+      if (nof_pushing.fetch_sub(1) == 1 and not active_.load()) {
+        {
+          std::lock_guard<std::mutex> lock(q_mutex);
+        }
+        cv_exit.notify_all();
+      }
+      return success;
     }
 
     multiqueue_handler<myobj>* parent = nullptr;
-
-    mutable std::mutex                 q_mutex;
-    srsran::dyn_circular_buffer<myobj> buffer;
-    std::condition_variable            cv_full, cv_exit;
-    bool                               active_     = true;
-    int                                nof_waiting = 0;
+    const size_t               cap_;
+    size_t                     ring_size = 1;
+    std::unique_ptr<cell_t[]>  cells;
+
+    std::atomic<size_t>     tail{0};  ///< next slot reserved by the producers
+    size_t                  head = 0; ///< next slot popped by the consumer
+    std::atomic<size_t>     count{0}; ///< reserved slots that were not popped yet
+    std::atomic<bool>       active_{true};
+    std::atomic<int>        nof_pushing{0};
+    std::atomic<int>        nof_waiting{0};
+    mutable std::mutex      q_mutex; ///< only used by the blocked pushers and deactivation
+    std::condition_variable cv_full, cv_exit;
   };
 
 public:
@@ -222,9 +269,17 @@ public:
   };
 
   explicit multiqueue_handler(uint32_t default_capacity_ = MULTIQUEUE_DEFAULT_CAPACITY) :
-    default_capacity(default_capacity_)
+    default_capacity(default_capacity_), event_fd(eventfd(0, EFD_CLOEXEC))
   {}
-  ~multiqueue_handler() { stop(); }
+  ~multiqueue_handler()
+  {
+    stop();
+    // the queues have to be destroyed before the eventfd and the mutex
+    queues.clear();
+    if (event_fd >= 0) {
+      close(event_fd);
+    }
+  }
 
   void stop()
   {
@@ -234,9 +289,11 @@ public:
       // signal deactivation to pushing threads in a non-blocking way
       q.set_active(false);
     }
+    wake_consumer_();
     while (consumer_state) {
       cv_exit.wait(lock);
     }
+    lock.unlock();
     for (auto& q : queues) {
       // ensure the queues are finished being deactivated
       q.deactivate_blocking();
@@ -265,6 +322,7 @@ public:
       queues.emplace_back(capacity_, this);
       qidx = queues.size() - 1; // update qidx to the last element
     } else {
+      queues[qidx].clear_();
       queues[qidx].set_active(true);
     }
     return queue_handle(&queues[qidx]);
@@ -295,10 +353,23 @@ public:
         consumer_state = false;
         return true;
       }
+
+      // Announce the sleep and check the queues again, as a producer may have pushed in between
+      consumer_sleeping.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (round_robin_pop_(value)) {
+        consumer_sleeping.store(false, std::memory_order_relaxed);
+        consumer_state = false;
+        return true;
+      }
       lock.unlock();
-      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      uint64_t nof_events = 0;
+      if (event_fd < 0 or read(event_fd, &nof_events, sizeof(nof_events)) < 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      }
       lock.lock();
     }
+    consumer_sleeping.store(false, std::memory_order_relaxed);
     consumer_state = false;
     lock.unlock();
     cv_exit.notify_one();
@@ -321,25 +392,39 @@ private:
       if (q_it == queues.end()) {
         q_it = queues.begin(); // wrap-around
       }
-      bool try_lock_success = true;
-      if (q_it->try_pop(*value, try_lock_success)) {
+      if (q_it->try_pop(*value)) {
         spin_idx = (spin_idx + count + 1) % queues.size();
         return true;
       }
-      if (not try_lock_success) {
-        // restart RR search, as there was a collision with a producer
-        count = 0;
-      }
     }
     return false;
   }
 
+  /// Called by the producers after publishing an element
+  void notify_consumer_()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumer_sleeping.load(std::memory_order_relaxed) and consumer_sleeping.exchange(false)) {
+      wake_consumer_();
+    }
+  }
+
+  void wake_consumer_()
+  {
+    uint64_t one = 1;
+    if (event_fd >= 0 and write(event_fd, &one, sizeof(one)) < 0) {
+      // the consumer falls back to polling
+    }
+  }
+
   mutable std::mutex          mutex;
   std::condition_variable     cv_exit;
   uint32_t                    spin_idx = 0;
   bool                        running = true, consumer_state = false;
+  std::atomic<bool>           consumer_sleeping{false};
   std::deque<input_port_impl> queues;
   uint32_t                    default_capacity = 0;
+  int                         event_fd         = -1;
 };
 
 template <typename T>
@@ -23,7 +23,7 @@
 #define SRSRAN_NAS_PCAP_H
 
 #include "srsran/common/common.h"
-#include "srsran/common/pcap.h"
+#include "srsran/common/pcap_writer.h"
 #include <string>
 
 namespace srsran {
@@ -34,17 +34,18 @@ public:
   nas_pcap();
   ~nas_pcap();
   void     enable();
-  uint32_t open(std::string filename_, uint32_t ue_id = 0, srsran_rat_t rat_type = srsran_rat_t::lte);
+  uint32_t open(std::string               filename_,
+                uint32_t                  ue_id    = 0,
+                srsran_rat_t              rat_type = srsran_rat_t::lte,
+                const pcap_writer_args_t& args     = {});
   void     close();
   void     write_nas(uint8_t* pdu, uint32_t pdu_len_bytes);
 
 private:
   bool        enable_write = false;
-  std::string filename;
-  FILE*       pcap_file            = nullptr;
+  pcap_writer writer{"PCAP_WRITER_NAS"};
   uint32_t    ue_id                = 0;
   int         emergency_handler_id = -1;
-  void        pack_and_write(uint8_t* pdu, uint32_t pdu_len_bytes);
 };
 
 } // namespace srsran
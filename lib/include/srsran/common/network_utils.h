@@ -28,6 +28,7 @@
 
 #include <arpa/inet.h>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <netinet/in.h>
 #include <netinet/sctp.h>
@@ -132,8 +133,8 @@ protected:
 };
 
 /**
- * Description - Instantiates a thread that will block waiting for IO from multiple sockets, via a select
- *               The user can register their own (socket fd, data handler) in this class via the
+ * Description - Instantiates a thread that will block waiting for IO from multiple sockets, via a select or an
+ *               io_uring. The user can register their own (socket fd, data handler) in this class via the
  *               add_socket_handler(fd, task) API or its other variants
  */
 class socket_manager final : public thread, public socket_manager_itf
@@ -141,9 +142,16 @@ class socket_manager final : public thread, public socket_manager_itf
   using recv_callback_t = socket_manager_itf::recv_callback_t;
 
 public:
-  socket_manager();
+  /// Mechanism used to wait for data in the sockets. With io_uring, a poll request is kept armed in the ring for each
+  /// socket and the requests of the sockets that were handled are re-armed with the same system call that waits for
+  /// the next ones. It falls back to select if io_uring is not available.
+  enum class backend_t { select, io_uring };
+
+  explicit socket_manager(backend_t backend = backend_t::select);
   ~socket_manager() final;
 
+  backend_t get_backend() const { return uring != nullptr ? backend_t::io_uring : backend_t::select; }
+
   void stop();
   bool remove_socket_nonblocking(int fd, bool signal_completion = false);
   bool remove_socket(int fd) final;
@@ -162,9 +170,14 @@ private:
     bool     signal_rm_complete;
     ctrl_cmd_t() { bzero(this, sizeof(ctrl_cmd_t)); }
   };
+  class io_uring_poller;
+
   std::map<int, recv_callback_t>::iterator remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max_fd);
+  void                                     run_select_loop();
+  void                                     run_io_uring_loop();
 
   // state
+  std::unique_ptr<io_uring_poller> uring;
   std::mutex                     socket_mutex;
   std::map<int, recv_callback_t> active_sockets;
   std::atomic<bool>              running   = {false};
@@ -200,11 +213,15 @@ make_sctp_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& q
 socket_manager_itf::recv_callback_t
 make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, recvfrom_callback_t rx_callback);
 
-inline socket_manager& get_rx_io_manager()
-{
-  static socket_manager io;
-  return io;
-}
+/// Sets the backend of the socket manager returned by get_rx_io_manager(), before its first use
+void set_rx_io_backend(socket_manager::backend_t backend);
+
+const char* to_string(socket_manager::backend_t backend);
+
+/// Parses "select" or "io_uring", returns false if the string is not valid
+bool from_string(const std::string& str, socket_manager::backend_t& backend);
+
+socket_manager& get_rx_io_manager();
 
 } // namespace srsran
 
@@ -22,7 +22,7 @@
 #ifndef SRSRAN_NGAP_PCAP_H
 #define SRSRAN_NGAP_PCAP_H
 
-#include "srsran/common/pcap.h"
+#include "srsran/common/pcap_writer.h"
 #include <string>
 
 namespace srsran {
@@ -38,14 +38,13 @@ public:
   ngap_pcap& operator=(ngap_pcap&& other) = delete;
 
   void enable();
-  void open(const char* filename_);
+  void open(const char* filename_, const pcap_writer_args_t& args = {});
   void close();
   void write_ngap(uint8_t* pdu, uint32_t pdu_len_bytes);
 
 private:
   bool        enable_write = false;
-  std::string filename;
-  FILE*       pcap_file            = nullptr;
+  pcap_writer writer{"PCAP_WRITER_NGAP"};
   int         emergency_handler_id = -1;
 };
 
@@ -0,0 +1,104 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSRAN_NUMA_PLACEMENT_H
+#define SRSRAN_NUMA_PLACEMENT_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace srsran {
+
+/// Memory pools that can be bound to a NUMA node
+enum class numa_pool_t { bearers, buffers, harq, nof_pools };
+
+const char* to_string(numa_pool_t pool);
+
+/**
+ * Central NUMA placement of the memory pools. It binds each pool to the node of the threads that access it the most,
+ * so that a stack and PHY workers running on different sockets do not pay for remote memory accesses.
+ *
+ * A profile is a list of rules separated by ';', each of them POOL=NODE:
+ * - POOL is bearers (RLC entities), buffers (byte buffer pool) or harq (MAC HARQ softbuffers).
+ * - NODE is a node index, or "auto" for the node of the CPUs that the thread placement profile assigns to the thread
+ *   that accesses the pool the most (STACK for bearers and buffers, WORKER0 for harq).
+ *
+ * The node is set as the preferred node of the pool memory, the kernel falls back to other nodes if it is full. Pools
+ * without a rule keep the first-touch placement of the kernel.
+ */
+class numa_placement
+{
+public:
+  /// Sets the node of a pool as the preferred node of the memory the calling thread allocates while it is in scope.
+  /// Used for pools made of many small allocations. The default policy of the thread is restored on destruction
+  class scoped_policy
+  {
+  public:
+    explicit scoped_policy(numa_pool_t pool);
+    ~scoped_policy();
+    scoped_policy(const scoped_policy&) = delete;
+    scoped_policy& operator=(const scoped_policy&) = delete;
+
+  private:
+    bool active = false;
+  };
+
+  static numa_placement& get();
+
+  /// Parses and validates a profile, an empty profile disables the placement. On error, the previous profile is kept
+  /// and the reason is written to err. The thread placement has to be configured first for "auto" to resolve
+  bool configure(const std::string& profile, std::string& err);
+
+  bool is_enabled() const { return enabled; }
+
+  /// Returns the node of the pool, or -1 if the pool is not bound
+  int get_node(numa_pool_t pool) const { return nodes[(size_t)pool]; }
+
+  /// Binds the pages fully contained in [ptr, ptr + len) to the node of the pool, the pages already touched are
+  /// moved. Returns false if the pool is not bound or the kernel refused the binding
+  bool bind(numa_pool_t pool, void* ptr, size_t len);
+
+  /// Returns a textual description of the profile and of the memory bound to each node, one pool per line
+  std::string to_string() const;
+
+  /// Number of NUMA nodes of the system, 1 if the system does not expose them
+  static uint32_t get_nof_nodes();
+
+  /// Returns the node of a CPU, or -1 if unknown
+  static int get_cpu_node(uint32_t cpu);
+
+private:
+  static const size_t nof_pools = (size_t)numa_pool_t::nof_pools;
+
+  numa_placement();
+
+  std::atomic<bool>                            enabled = {false};
+  std::array<std::atomic<int>, nof_pools>      nodes;
+  std::array<std::atomic<uint64_t>, nof_pools> bound_bytes;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_NUMA_PLACEMENT_H
@@ -0,0 +1,111 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PCAP_WRITER_H
+#define SRSRAN_PCAP_WRITER_H
+
+#include "srsran/common/pcap.h"
+#include "srsran/common/threads.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace srsran {
+
+/// Configuration of the PCAP files
+struct pcap_writer_args_t {
+  uint32_t ring_size_kb      = 4096;  ///< size of the record ring shared by the producers
+  uint32_t max_file_size_mb  = 0;     ///< the file is rotated when it reaches this size, 0 for no limit
+  uint32_t rotation_period_s = 0;     ///< the file is rotated after this many seconds, 0 for no limit
+  bool     compress          = false; ///< pipe the files through gzip
+};
+
+/**
+ * Writes the PCAP records of one file from a background thread. The producers pack each record (PCAP header, context
+ * header and PDU) into a preallocated byte ring under a short lock, and the writer thread drains the ring with one
+ * large write per wake up. Records that do not fit the ring are dropped and counted, so a slow disk never blocks the
+ * PHY or stack threads.
+ *
+ * The files can be rotated by size or by age; the rotated files get an index before the extension (enb_mac.pcap,
+ * enb_mac_1.pcap, ...). Rotation happens between two batches, so a file may exceed the size limit by one batch.
+ */
+class pcap_writer : protected srsran::thread
+{
+public:
+  explicit pcap_writer(const std::string& thread_name);
+  ~pcap_writer();
+
+  pcap_writer(const pcap_writer& other) = delete;
+  pcap_writer& operator=(const pcap_writer& other) = delete;
+
+  /// Opens the first file with the given Data Link Type and starts the writer thread
+  bool open(const std::string& filename, uint32_t dlt, const pcap_writer_args_t& args = {});
+
+  /// Writes the remaining records, closes the file and stops the writer thread
+  void close();
+
+  bool is_open() const { return running.load(std::memory_order_relaxed); }
+
+  /// Queues one record made of the context header hdr followed by the PDU, timestamped now. orig_pdu_len is the
+  /// length of the PDU before it was truncated, 0 if it was not. Thread-safe.
+  bool write(const uint8_t* hdr, uint32_t hdr_len, const uint8_t* pdu, uint32_t pdu_len, uint32_t orig_pdu_len = 0);
+
+  const std::string& get_filename() const { return filename; }
+  uint32_t           get_dlt() const { return dlt; }
+  uint32_t           get_nof_files() const { return file_idx.load(std::memory_order_relaxed) + 1; }
+  uint64_t           get_nof_dropped() const { return nof_dropped.load(std::memory_order_relaxed); }
+
+private:
+  void run_thread() final;
+  bool open_file();
+  void close_file();
+  void copy_to_ring(const void* data, uint32_t len);
+  void write_batch();
+
+  static constexpr std::chrono::milliseconds flush_period{50};
+
+  std::string        filename;
+  uint32_t           dlt = 0;
+  pcap_writer_args_t args;
+
+  // record ring, head and tail count the bytes written and drained since open
+  std::mutex              ring_mutex;
+  std::condition_variable cvar;
+  std::vector<uint8_t>    ring;
+  uint64_t                head = 0;
+  uint64_t                tail = 0;
+  std::atomic<bool>       running{false};
+  std::atomic<uint64_t>   nof_dropped{0};
+
+  // owned by the writer thread while running
+  FILE*                                 file       = nullptr;
+  bool                                  file_piped = false;
+  std::atomic<uint32_t>                 file_idx{0};
+  uint64_t                              file_bytes = 0;
+  std::chrono::steady_clock::time_point file_start;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PCAP_WRITER_H
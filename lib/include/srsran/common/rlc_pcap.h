@@ -22,7 +22,7 @@
 #ifndef RLCPCAP_H
 #define RLCPCAP_H
 
-#include "srsran/common/pcap.h"
+#include "srsran/common/pcap_writer.h"
 #include "srsran/interfaces/rlc_interface_types.h"
 #include <stdint.h>
 
@@ -33,7 +33,7 @@ class rlc_pcap
 public:
   rlc_pcap() {}
   void enable(bool en);
-  void open(const char* filename, const rlc_config_t& config);
+  void open(const char* filename, const rlc_config_t& config, const pcap_writer_args_t& args = {});
   void close();
 
   void set_ue_id(uint16_t ue_id);
@@ -42,20 +42,20 @@ public:
   void write_ul_ccch(uint8_t* pdu, uint32_t pdu_len_bytes);
 
 private:
-  bool     enable_write = false;
-  FILE*    pcap_file    = nullptr;
-  uint32_t ue_id        = 0;
-  uint8_t  mode         = 0;
-  uint8_t  sn_length    = 0;
-  void     pack_and_write(uint8_t* pdu,
-                          uint32_t pdu_len_bytes,
-                          uint8_t  mode,
-                          uint8_t  direction,
-                          uint8_t  priority,
-                          uint8_t  seqnumberlength,
-                          uint16_t ueid,
-                          uint16_t channel_type,
-                          uint16_t channel_id);
+  bool        enable_write = false;
+  pcap_writer writer{"PCAP_WRITER_RLC"};
+  uint32_t    ue_id     = 0;
+  uint8_t     mode      = 0;
+  uint8_t     sn_length = 0;
+  void        pack_and_write(uint8_t* pdu,
+                             uint32_t pdu_len_bytes,
+                             uint8_t  mode,
+                             uint8_t  direction,
+                             uint8_t  priority,
+                             uint8_t  seqnumberlength,
+                             uint16_t ueid,
+                             uint16_t channel_type,
+                             uint16_t channel_id);
 };
 
 } // namespace srsran
@@ -72,6 +72,33 @@ void s3g_deinitialize(S3G_STATE* state);
 
 void s3g_generate_keystream(S3G_STATE* state, uint32_t n, uint32_t* ks);
 
+/* Number of keystreams generated in parallel, one per SIMD lane */
+#define S3G_MAX_LANES 8
+
+/* The states of up to S3G_MAX_LANES independent keystreams (e.g. one per PDU), stored lane by lane so the
+ * keystreams can be generated with SIMD instructions.
+ */
+typedef struct {
+  uint32_t lfsr[16][S3G_MAX_LANES];
+  uint32_t fsm[3][S3G_MAX_LANES];
+} S3G_LANES_STATE;
+
+/* Initialization of the lanes.
+ * Input k[l]: Four 32-bit words making up the 128-bit key of the lane l.
+ * Input iv[l]: Four 32-bit words making the 128-bit initialization variable of the lane l.
+ * Input nof_lanes: Number of lanes used, up to S3G_MAX_LANES.
+ * Output: All the LFSRs and FSM are initialized and clocked once, like in s3g_generate_keystream(), so the keystream
+ * can be generated in several calls.
+ */
+void s3g_lanes_initialize(S3G_LANES_STATE* state, const uint32_t (*k)[4], const uint32_t (*iv)[4], uint32_t nof_lanes);
+
+/* Generation of the keystream of every lane.
+ * input n: number of 32-bit words of keystream per lane.
+ * output ks: n * S3G_MAX_LANES words, word t of the lane l is ks[t * S3G_MAX_LANES + l].
+ * It uses AVX2 if the CPU supports it.
+ */
+void s3g_lanes_generate_keystream(S3G_LANES_STATE* state, uint32_t n, uint32_t* ks);
+
 /* f8.
  * Input key: 128 bit Confidentiality Key.
  * Input count:32-bit Count, Frame dependent input.
@@ -26,6 +26,7 @@
  * Common security header - wraps ciphering/integrity check algorithms.
  *****************************************************************************/
 
+#include "srsran/common/aes128.h"
 #include "srsran/common/common.h"
 #include "srsran/srslog/srslog.h"
 
@@ -272,6 +273,15 @@ uint8_t security_128_eia2(const uint8_t* key,
                           uint32_t       msg_len,
                           uint8_t*       mac);
 
+/// 128-EIA2 with the AES key schedule expanded beforehand with aes128_set_key()
+uint8_t security_128_eia2(const aes128_key_t* key,
+                          uint32_t            count,
+                          uint32_t            bearer,
+                          uint8_t             direction,
+                          uint8_t*            msg,
+                          uint32_t            msg_len,
+                          uint8_t*            mac);
+
 uint8_t security_128_eia3(const uint8_t* key,
                           uint32_t       count,
                           uint32_t       bearer,
@@ -301,6 +311,31 @@ uint8_t security_128_eea2(uint8_t* key,
                           uint32_t msg_len,
                           uint8_t* msg_out);
 
+/// 128-EEA2 with the AES key schedule expanded beforehand with aes128_set_key(), msg_out can be the same as msg
+uint8_t security_128_eea2(const aes128_key_t* key,
+                          uint32_t            count,
+                          uint8_t             bearer,
+                          uint8_t             direction,
+                          uint8_t*            msg,
+                          uint32_t            msg_len,
+                          uint8_t*            msg_out);
+
+/// PDU of a ciphering batch, msg_len bytes of msg are ciphered into msg_out, which can be the same as msg. The buffers
+/// of empty PDUs are not accessed
+struct security_cipher_pdu_t {
+  uint8_t* msg;
+  uint32_t msg_len;
+  uint32_t count;
+  uint8_t* msg_out;
+};
+
+/// Ciphers (or deciphers) the PDUs of a bearer in one call, the AES blocks of all the PDUs are encrypted together
+uint8_t security_128_eea2_batch(const aes128_key_t*    key,
+                                uint8_t                bearer,
+                                uint8_t                direction,
+                                security_cipher_pdu_t* pdus,
+                                uint32_t               nof_pdus);
+
 uint8_t security_128_eea3(uint8_t* key,
                           uint32_t count,
                           uint8_t  bearer,
@@ -309,6 +344,20 @@ uint8_t security_128_eea3(uint8_t* key,
                           uint32_t msg_len,
                           uint8_t* msg_out);
 
+/// Ciphers (or deciphers) the PDUs of a bearer in one call, the keystreams of up to 8 PDUs are generated together
+uint8_t security_128_eea1_batch(const uint8_t*         key,
+                                uint8_t                bearer,
+                                uint8_t                direction,
+                                security_cipher_pdu_t* pdus,
+                                uint32_t               nof_pdus);
+
+/// Ciphers (or deciphers) the PDUs of a bearer in one call, the keystreams of up to 8 PDUs are generated together
+uint8_t security_128_eea3_batch(const uint8_t*         key,
+                                uint8_t                bearer,
+                                uint8_t                direction,
+                                security_cipher_pdu_t* pdus,
+                                uint32_t               nof_pdus);
+
 /******************************************************************************
  * Authentication
  *****************************************************************************/
@@ -323,6 +372,25 @@ security_milenage_f2345(uint8_t* k, uint8_t* op, uint8_t* rand, uint8_t* res, ui
 
 uint8_t security_milenage_f5_star(uint8_t* k, uint8_t* op, uint8_t* rand, uint8_t* ak);
 
+/// Authentication vector of the Milenage functions f1 to f5, for the RAND and SQN set by the caller
+struct security_milenage_vector_t {
+  uint8_t rand[16];
+  uint8_t sqn[6];
+  uint8_t mac_a[8];
+  uint8_t res[8];
+  uint8_t ck[16];
+  uint8_t ik[16];
+  uint8_t ak[6];
+};
+
+/// Computes f1 to f5 for several vectors of a subscriber, the key is expanded once and the AES blocks of all the
+/// vectors are encrypted together
+uint8_t security_milenage_batch(const uint8_t*              k,
+                                const uint8_t*              op_c,
+                                const uint8_t*              amf,
+                                security_milenage_vector_t* vectors,
+                                uint32_t                    nof_vectors);
+
 int security_xor_f2345(uint8_t* k, uint8_t* rand, uint8_t* res, uint8_t* ck, uint8_t* ik, uint8_t* ak);
 int security_xor_f1(uint8_t* k, uint8_t* rand, uint8_t* sqn, uint8_t* amf, uint8_t* mac_a);
 
@@ -0,0 +1,91 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSRAN_THREAD_PLACEMENT_H
+#define SRSRAN_THREAD_PLACEMENT_H
+
+#include <atomic>
+#include <mutex>
+#include <sched.h>
+#include <string>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Central thread placement profile. It maps thread names to a CPU set and a scheduling class, and overrides the CPU
+ * masks and priorities the components pick for their own threads.
+ *
+ * A profile is a list of rules separated by ';', each of them NAME=CPUS[:POLICY[:PRIORITY]]:
+ * - NAME is the thread name, a trailing '*' matches any suffix. The first matching rule applies.
+ * - CPUS is a list of CPUs and CPU ranges separated by ',' (e.g. 2-5,8), or "any" for keeping the affinity.
+ * - POLICY is fifo, rr or other. The scheduling class is kept if omitted.
+ * - PRIORITY is the real-time priority for fifo and rr.
+ *
+ * For example "TXRX=2:fifo:95;WORKER*=3-6:fifo:90;PRACH*=7;*=8-31:other" isolates the PHY in the CPUs 2 to 7.
+ */
+class thread_placement
+{
+public:
+  struct rule_t {
+    std::string pattern;
+    bool        set_cpus = false;
+    cpu_set_t   cpus     = {};
+    int         policy   = -1; ///< -1 keeps the scheduling class
+    int         priority = 0;
+  };
+
+  static thread_placement& get();
+
+  /// Parses and validates a profile, an empty profile disables the placement. On error, the previous profile is kept
+  /// and the reason is written to err. Warnings, e.g. real-time threads sharing CPUs with other rules, do not fail
+  bool configure(const std::string& profile, std::string& err, std::vector<std::string>* warnings = nullptr);
+
+  bool is_enabled() const { return enabled; }
+
+  /// Returns the CPUs of the rule matching a thread name, false if none matches or the rule keeps the affinity
+  bool get_cpus(const std::string& name, cpu_set_t& cpus) const;
+
+  /// Applies the matching rule to the calling thread, returns false if none matches or it could not be applied
+  bool apply_self(const std::string& name);
+
+  /// Applies the profile to all the threads of the process, including those not created through srsran::thread.
+  /// Returns the number of threads placed
+  uint32_t apply_all();
+
+  /// Returns a textual description of the profile, one rule per line
+  std::string to_string() const;
+
+private:
+  thread_placement() = default;
+
+  const rule_t* find(const std::string& name) const;
+  bool          apply(const rule_t& rule, pid_t tid, const std::string& name);
+
+  mutable std::mutex  mutex;
+  std::atomic<bool>   enabled = {false};
+  std::vector<rule_t> rules;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_THREAD_PLACEMENT_H
@@ -33,7 +33,9 @@
 #include "srsran/adt/move_callback.h"
 #include "srsran/srslog/srslog.h"
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -85,8 +87,16 @@ public:
   uint32_t    get_nof_workers();
   std::string get_id();
 
+  /// Enables the adaptive sizing of the pool. wait_worker() only hands out the first active workers, the others stay
+  /// parked. The active set grows when no active worker is idle or when a worker exceeds deadline_us, and shrinks
+  /// when the longest processing time of the last window_len jobs fits in one worker less, with tti_us per job.
+  void     set_adaptive(uint32_t min_workers, uint32_t tti_us, uint32_t deadline_us, uint32_t window_len = 1000);
+  uint32_t get_nof_active_workers();
+
 private:
   bool find_finished_worker(uint32_t tti, uint32_t* id);
+  void job_finished(uint32_t id);
+  void adapt_active_workers(bool idle_found);
 
   typedef enum { STOP, IDLE, START_WORK, WORKER_READY, WORKING } worker_status;
 
@@ -99,15 +109,49 @@ private:
   std::mutex                           mutex_queue = {};
   std::vector<worker_status>           status      = {};
   std::vector<std::condition_variable> cvar_worker = {};
+
+  // Adaptive sizing, all the workers are active while min_active_workers is 0
+  srslog::basic_logger&                              logger;
+  std::vector<std::chrono::steady_clock::time_point> start_time         = {};
+  uint32_t                                           nof_active_workers = 0;
+  uint32_t                                           min_active_workers = 0;
+  uint32_t                                           tti_us             = 1000;
+  uint32_t                                           deadline_us        = 0;
+  uint32_t                                           window_len         = 0;
+  uint32_t                                           window_count       = 0;
+  uint32_t                                           window_max_us      = 0;
+  uint32_t                                           window_late        = 0;
 };
 
+/**
+ * Pool of workers that run the pushed tasks. Each worker owns a queue per priority. A task pushed from a worker of the
+ * pool goes to the queue of that worker, and the tasks pushed from other threads are spread among the queues in
+ * round-robin. A worker runs the tasks of its own queue in FIFO order, and when it is empty it steals the oldest task of
+ * another queue. The high priority tasks (e.g. the PHY deadline work of parallel_for) of all the queues are run before
+ * the normal priority ones.
+ */
 class task_thread_pool
 {
   using task_t                             = srsran::move_callback<void(), default_move_callback_buffer_size, true>;
   static constexpr uint32_t max_task_shift = 14;
   static constexpr uint32_t max_task_num   = 1u << max_task_shift;
+  static constexpr uint32_t max_workers    = 64;
 
 public:
+  enum class task_priority { high, normal };
+  static constexpr uint32_t nof_priorities = 2;
+
+  struct worker_metrics_t {
+    uint32_t queue_depth = 0; ///< tasks currently in the worker queues
+    uint64_t nof_tasks   = 0; ///< tasks run by the worker
+    uint64_t nof_steals  = 0; ///< tasks taken from the queues of other workers
+  };
+  struct metrics_t {
+    uint32_t                      nof_pending_tasks = 0;
+    uint32_t                      max_pending_tasks = 0; ///< highest number of pending tasks since the last report
+    std::vector<worker_metrics_t> workers;
+  };
+
   task_thread_pool(uint32_t nof_workers = 1, bool start_deferred = false, int32_t prio_ = -1, uint32_t mask_ = 255);
   task_thread_pool(const task_thread_pool&) = delete;
   task_thread_pool(task_thread_pool&&)      = delete;
@@ -119,9 +163,15 @@ public:
   void start(int32_t prio_ = -1, uint32_t mask_ = 255);
   void set_nof_workers(uint32_t nof_workers);
 
-  void     push_task(task_t&& task);
+  void     push_task(task_t&& task, task_priority priority = task_priority::normal);
   uint32_t nof_pending_tasks() const;
   size_t   nof_workers() const { return workers.size(); }
+  void     get_metrics(metrics_t& metrics);
+
+  /// Runs task(arg, idx) for every idx in [0, nof_tasks) in the workers and in the calling thread, and returns once
+  /// all of them have finished. The calling thread keeps picking up pending indexes, so a busy pool only delays it.
+  /// The work is pushed with high priority.
+  void parallel_for(uint32_t nof_tasks, void (*task)(void* arg, uint32_t idx), void* arg);
 
 private:
   class worker_t : public thread
@@ -142,15 +192,31 @@ private:
     bool              running = false;
   };
 
+  /// Task queues of a worker, that other workers can steal from
+  struct task_queue_t {
+    std::mutex            mutex;
+    std::deque<task_t>    tasks[nof_priorities];
+    std::atomic<uint32_t> size{0};
+    std::atomic<uint64_t> nof_tasks{0};
+    std::atomic<uint64_t> nof_steals{0};
+  };
+
+  bool pop_task(uint32_t worker_idx, task_t* task);
+
   int32_t               prio = -1;
   uint32_t              mask = 255;
   srslog::basic_logger& logger;
 
-  srsran::dyn_circular_buffer<task_t>     pending_tasks;
+  std::unique_ptr<task_queue_t[]>         queues;
+  std::atomic<uint32_t>                   nof_queues{0};
+  std::atomic<uint32_t>                   next_queue{0};
+  std::atomic<uint32_t>                   nof_pending{0};
+  std::atomic<uint32_t>                   max_pending{0};
+  std::atomic<uint32_t>                   nof_sleeping{0};
   std::vector<std::unique_ptr<worker_t> > workers;
   mutable std::mutex                      queue_mutex;
   std::condition_variable                 cv_empty;
-  bool                                    running = false;
+  std::atomic<bool>                       running{false};
 };
 
 /// Class used to create a single worker with an input task queue with a single reader
@@ -44,6 +44,7 @@ void threads_print_self();
 #ifdef __cplusplus
 }
 
+#include "srsran/common/thread_placement.h"
 #include <atomic>
 #include <string>
 
@@ -85,6 +86,7 @@ public:
   {
     name = name_;
     pthread_setname_np(pthread_self(), name.c_str());
+    thread_placement::get().apply_self(name);
   }
 
   void wait_thread_finish() { pthread_join(_thread, NULL); }
@@ -109,6 +111,7 @@ private:
   static void* thread_function_entry(void* _this)
   {
     pthread_setname_np(pthread_self(), ((thread*)_this)->name.c_str());
+    thread_placement::get().apply_self(((thread*)_this)->name);
     ((thread*)_this)->run_thread();
     return NULL;
   }
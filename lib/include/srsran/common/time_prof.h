@@ -23,8 +23,12 @@
 #define SRSRAN_TIME_PROF_H
 
 #include "srsran/srslog/srslog.h"
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #ifdef ENABLE_TIMEPROF
 #define TPROF_ENABLE_DEFAULT true
@@ -162,6 +166,95 @@ public:
 };
 using sliding_window_stats_ms = sliding_window_stats<std::chrono::milliseconds>;
 
+/// Summary of the durations recorded by a tprof_histogram
+struct tprof_histogram_metrics_t {
+  std::string name;
+  uint64_t    count   = 0;
+  float       avg_us  = 0;
+  float       p50_us  = 0;
+  float       p99_us  = 0;
+  float       p999_us = 0;
+  float       max_us  = 0;
+};
+
+/**
+ * Histogram of durations with HDR-style log-linear buckets: each power of two is split in nof_sub_buckets buckets, so
+ * that any duration is kept with a relative error below 1/nof_sub_buckets. The buckets are relaxed atomic counters,
+ * so it can be fed by several threads without locks and cheap enough to be always on.
+ */
+class tprof_histogram
+{
+public:
+  static constexpr uint32_t sub_bucket_bits = 3;
+  static constexpr uint32_t nof_sub_buckets = 1U << sub_bucket_bits;
+  static constexpr uint32_t nof_buckets     = (64 - sub_bucket_bits + 1) * nof_sub_buckets;
+
+  explicit tprof_histogram(std::string name_) : name(std::move(name_)) {}
+
+  void operator()(std::chrono::nanoseconds duration)
+  {
+    uint64_t ns = duration.count() > 0 ? duration.count() : 0;
+    buckets[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+    sum_ns.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t cur = max_ns.load(std::memory_order_relaxed);
+    while (ns > cur and not max_ns.compare_exchange_weak(cur, ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  /// Returns the summary of the durations recorded since the previous call, and restarts the histogram
+  tprof_histogram_metrics_t get_metrics_and_reset();
+
+  static uint32_t bucket_index(uint64_t ns)
+  {
+    if (ns < nof_sub_buckets) {
+      return ns;
+    }
+    uint32_t msb = 63 - __builtin_clzll(ns);
+    return (msb - sub_bucket_bits + 1) * nof_sub_buckets + ((ns >> (msb - sub_bucket_bits)) & (nof_sub_buckets - 1));
+  }
+
+  /// Returns the value in the middle of the range of durations of a bucket
+  static uint64_t bucket_value(uint32_t idx)
+  {
+    if (idx < nof_sub_buckets) {
+      return idx;
+    }
+    uint32_t shift = idx / nof_sub_buckets - 1;
+    uint64_t base  = static_cast<uint64_t>(nof_sub_buckets + idx % nof_sub_buckets) << shift;
+    return base + ((1ULL << shift) >> 1U);
+  }
+
+private:
+  const std::string                              name;
+  std::array<std::atomic<uint64_t>, nof_buckets> buckets = {};
+  std::atomic<uint64_t>                          sum_ns{0};
+  std::atomic<uint64_t>                          max_ns{0};
+};
+
+/// Processing stages of a TTI with an always-on duration histogram. The stages that depend on the link direction are
+/// the ones of the node, e.g. pdsch is the PDSCH encoding in the eNB and its decoding in the UE
+enum class tti_stage { ofdm, chest, pdcch, pdsch, pusch, fec, sched, mac_pdu, nof_stages };
+
+/// Returns the histogram of a stage
+tprof_histogram& get_stage_histogram(tti_stage stage);
+
+/// Appends the metrics of every stage, with the durations recorded since the previous call, and restarts them
+void get_stage_metrics(std::vector<tprof_histogram_metrics_t>& metrics);
+
+/// Records the duration of the enclosing scope in the histogram of a stage
+class scoped_stage_prof
+{
+public:
+  explicit scoped_stage_prof(tti_stage stage) : hist(get_stage_histogram(stage)) { meas.start(); }
+  scoped_stage_prof(const scoped_stage_prof&) = delete;
+  scoped_stage_prof& operator=(const scoped_stage_prof&) = delete;
+  ~scoped_stage_prof() { hist(meas.stop()); }
+
+private:
+  tprof_histogram& hist;
+  tprof_measure    meas;
+};
+
 } // namespace srsran
 
 #endif // SRSRAN_TIME_PROF_H
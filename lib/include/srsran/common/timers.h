@@ -32,6 +32,8 @@
 #include "srsran/adt/intrusive_list.h"
 #include "srsran/adt/move_callback.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <deque>
 #include <inttypes.h>
@@ -56,20 +58,24 @@ public:
  *   This deque will only grow in size. Erased timers are just tagged in the deque as empty, and can be reused for the
  *   creation of new timers. To avoid unnecessary runtime allocations, the user can set an initial capacity.
  * - free_list - intrusive forward linked list to keep track of the empty timers and speed up new timer creation.
- * - A large circular vector of size WHEEL_SIZE which works as a time wheel, storing and circularly indexing the
- *   currently running timers by their respective timeout value.
- *   For a number of running timers N, and uniform distribution of timeout values, the step_all() complexity
- *   should be O(N/WHEEL_SIZE). Thus, the performance should improve with a larger WHEEL_SIZE, at the expense of more
- *   used memory.
+ * - A hierarchical time wheel of NOF_LEVELS levels with LEVEL_SIZE slots each, that stores the running timers by
+ *   timeout. A timer is placed in the level of the highest byte where its timeout differs from the current time, and
+ *   the slots of the upper levels are cascaded to the lower ones as the time reaches them. Start, stop and expiry are
+ *   O(1) (a timer is moved at most NOF_LEVELS - 1 times before expiring), with 1024 list heads instead of a 64k
+ *   entries wheel.
+ * - The wheel position of a timer is only a lower bound of its timeout. Stopping a timer or extending its timeout are
+ *   atomic updates of the timer state that do not take the lock nor touch the wheel. The timer is moved or unlinked
+ *   when the wheel reaches its old position.
  */
 class timer_handler
 {
   using tic_diff_t                      = uint32_t;
   using tic_t                           = uint32_t;
   constexpr static uint32_t INVALID_ID  = std::numeric_limits<uint32_t>::max();
-  constexpr static size_t   WHEEL_SHIFT = 16U;
-  constexpr static size_t   WHEEL_SIZE  = 1U << WHEEL_SHIFT;
-  constexpr static size_t   WHEEL_MASK  = WHEEL_SIZE - 1U;
+  constexpr static size_t   LEVEL_SHIFT = 8U;
+  constexpr static size_t   LEVEL_SIZE  = 1U << LEVEL_SHIFT;
+  constexpr static size_t   LEVEL_MASK  = LEVEL_SIZE - 1U;
+  constexpr static size_t   NOF_LEVELS  = 32U / LEVEL_SHIFT;
 
   constexpr static uint64_t   STOPPED_FLAG       = 0U;
   constexpr static uint64_t   RUNNING_FLAG       = static_cast<uint64_t>(1U) << 63U;
@@ -85,6 +91,9 @@ class timer_handler
     return mode_flag + (static_cast<uint64_t>(duration) << 32U) + timeout;
   }
 
+  struct timer_impl;
+  using wheel_list_t = srsran::intrusive_double_linked_list<timer_impl>;
+
   struct timer_impl : public intrusive_double_linked_list_element<>, public intrusive_forward_list_element<> {
     // const
     const uint32_t id;
@@ -93,6 +102,8 @@ class timer_handler
     bool                                  allocated = false;
     std::atomic<uint64_t>                 state{0}; ///< read can be without lock, thus writes must be atomic
     srsran::move_callback<void(uint32_t)> callback;
+    wheel_list_t*                         wheel_list    = nullptr; ///< wheel slot where the timer is linked
+    tic_t                                 wheel_timeout = 0;       ///< timeout used to place the timer in the wheel
 
     explicit timer_impl(timer_handler& parent_, uint32_t id_) : parent(parent_), id(id_) {}
     timer_impl(const timer_impl&) = delete;
@@ -136,15 +147,27 @@ class timer_handler
 
     void run()
     {
+      // Fast path: restarting a running timer only pushes its timeout forward, which does not need the wheel
+      uint64_t old_state = state.load(std::memory_order_relaxed);
+      while (decode_is_running(old_state)) {
+        uint32_t duration    = decode_duration(old_state);
+        tic_t    new_timeout = parent.cur_time.load(std::memory_order_relaxed) + duration;
+        if (static_cast<int32_t>(new_timeout - decode_timeout(old_state)) < 0) {
+          break;
+        }
+        if (state.compare_exchange_weak(
+                old_state, encode_state(RUNNING_FLAG, duration, new_timeout), std::memory_order_relaxed)) {
+          return;
+        }
+      }
       std::lock_guard<std::mutex> lock(parent.mutex);
       parent.start_run_(*this);
     }
 
     void stop()
     {
-      std::lock_guard<std::mutex> lock(parent.mutex);
-      // does not call callback
-      parent.stop_timer_(*this, false);
+      // does not call callback. The timer is unlinked from the wheel once its position is reached
+      parent.stop_timer_(*this);
     }
 
     void deallocate()
@@ -163,6 +186,7 @@ class timer_handler
         // if already running, just extends timer lifetime
         parent.start_run_(*this, duration_);
       } else {
+        // a stopped timer can only be started with the lock held
         state.store(encode_state(STOPPED_FLAG, duration_, 0), std::memory_order_relaxed);
       }
     }
@@ -234,7 +258,6 @@ public:
 
   explicit timer_handler(uint32_t capacity = 64)
   {
-    time_wheel.resize(WHEEL_SIZE);
     // Pre-reserve timers
     while (timer_list.size() < capacity) {
       timer_list.emplace_back(*this, timer_list.size());
@@ -249,15 +272,44 @@ public:
   void step_all()
   {
     std::unique_lock<std::mutex> lock(mutex);
-    uint32_t                     cur_time_local = cur_time.load(std::memory_order_relaxed) + 1;
-    auto&                        wheel_list     = time_wheel[cur_time_local & WHEEL_MASK];
+    tic_t                        cur_time_local = cur_time.load(std::memory_order_relaxed) + 1;
+    // the timers started from now on (e.g. in the callbacks) are placed ahead of the current step
+    cur_time.store(cur_time_local, std::memory_order_relaxed);
+
+    // Cascade the upper level slots reached by the current time, from the top level down
+    for (size_t level = NOF_LEVELS - 1; level > 0; --level) {
+      if ((cur_time_local & ((1U << (LEVEL_SHIFT * level)) - 1U)) == 0) {
+        wheel_list_t& slot = get_slot(level, cur_time_local);
+        while (not slot.empty()) {
+          timer_impl& timer = slot.front();
+          unlink_timer_(timer);
+          uint64_t timer_state = timer.state.load(std::memory_order_relaxed);
+          if (decode_is_running(timer_state)) {
+            link_timer_(timer, decode_timeout(timer_state));
+          }
+        }
+      }
+    }
 
-    for (auto it = wheel_list.begin(); it != wheel_list.end();) {
-      timer_impl& timer = timer_list[it->id];
-      ++it;
-      if (decode_timeout(timer.state.load(std::memory_order_relaxed)) == cur_time_local) {
+    // Expire the timers of the current slot. Timers whose timeout was extended are moved ahead
+    wheel_list_t& slot = get_slot(0, cur_time_local);
+    while (not slot.empty()) {
+      timer_impl& timer = slot.front();
+      unlink_timer_(timer);
+      uint64_t timer_state = timer.state.load(std::memory_order_relaxed);
+      while (decode_is_running(timer_state)) {
+        if (decode_timeout(timer_state) != cur_time_local) {
+          link_timer_(timer, decode_timeout(timer_state));
+          break;
+        }
         // stop timer (callback has to see the timer has already expired)
-        stop_timer_(timer, true);
+        if (not timer.state.compare_exchange_weak(
+                timer_state,
+                encode_state(EXPIRED_FLAG, decode_duration(timer_state), cur_time_local),
+                std::memory_order_relaxed)) {
+          continue;
+        }
+        nof_timers_running_.fetch_sub(1, std::memory_order_relaxed);
 
         // Call callback if configured
         if (not timer.callback.is_empty()) {
@@ -269,10 +321,9 @@ public:
           // Lock again to keep protecting the wheel
           lock.lock();
         }
+        break;
       }
     }
-
-    cur_time.fetch_add(1, std::memory_order_relaxed);
   }
 
   void stop_all()
@@ -280,7 +331,8 @@ public:
     std::lock_guard<std::mutex> lock(mutex);
     // does not call callback
     for (timer_impl& timer : timer_list) {
-      stop_timer_(timer, false);
+      stop_timer_(timer);
+      unlink_timer_(timer);
     }
   }
 
@@ -292,11 +344,7 @@ public:
     return timer_list.size() - nof_free_timers;
   }
 
-  uint32_t nof_running_timers() const
-  {
-    std::lock_guard<std::mutex> lock(mutex);
-    return nof_timers_running_;
-  }
+  uint32_t nof_running_timers() const { return nof_timers_running_.load(std::memory_order_relaxed); }
 
   constexpr static uint32_t max_timer_duration() { return MAX_TIMER_DURATION; }
 
@@ -314,7 +362,7 @@ public:
   }
 
   // useful for testing
-  static size_t get_wheel_size() { return WHEEL_SIZE; }
+  static size_t get_wheel_size() { return LEVEL_SIZE; }
 
 private:
   timer_impl& alloc_timer()
@@ -341,7 +389,8 @@ private:
       // already deallocated
       return;
     }
-    stop_timer_(timer, false);
+    stop_timer_(timer);
+    unlink_timer_(timer);
     timer.allocated = false;
     timer.state.store(encode_state(STOPPED_FLAG, 0, 0), std::memory_order_relaxed);
     timer.callback = srsran::move_callback<void(uint32_t)>();
@@ -350,57 +399,83 @@ private:
     // leave id unchanged.
   }
 
+  /// called with the lock held to start a timer, or to shorten/change the duration of a running timer
   void start_run_(timer_impl& timer, uint32_t duration_ = 0)
   {
-    uint64_t timer_old_state = timer.state.load(std::memory_order_relaxed);
-    duration_                = duration_ == 0 ? decode_duration(timer_old_state) : duration_;
-    uint32_t new_timeout     = cur_time.load(std::memory_order_relaxed) + duration_;
-    size_t   new_wheel_pos   = new_timeout & WHEEL_MASK;
-
-    uint32_t old_timeout = decode_timeout(timer_old_state);
-    bool     was_running = decode_is_running(timer_old_state);
-    if (was_running and (old_timeout & WHEEL_MASK) == new_wheel_pos) {
-      // If no change in timer wheel position. Just update absolute timeout
-      timer.state.store(encode_state(RUNNING_FLAG, duration_, new_timeout), std::memory_order_relaxed);
-      return;
+    tic_t    now       = cur_time.load(std::memory_order_relaxed);
+    uint64_t old_state = timer.state.load(std::memory_order_relaxed);
+    uint32_t duration;
+    tic_t    new_timeout;
+    do {
+      duration    = duration_ == 0 ? decode_duration(old_state) : duration_;
+      new_timeout = now + duration;
+    } while (not timer.state.compare_exchange_weak(
+        old_state, encode_state(RUNNING_FLAG, duration, new_timeout), std::memory_order_relaxed));
+    if (not decode_is_running(old_state)) {
+      nof_timers_running_.fetch_add(1, std::memory_order_relaxed);
     }
 
-    // Stop timer if it was running, removing it from wheel in the process
-    if (was_running) {
-      time_wheel[old_timeout & WHEEL_MASK].pop(&timer);
-      nof_timers_running_--;
+    if (timer.wheel_list != nullptr) {
+      if (new_timeout - now >= timer.wheel_timeout - now) {
+        // The timer is moved ahead once the wheel reaches its current position
+        return;
+      }
+      unlink_timer_(timer);
+    }
+    link_timer_(timer, new_timeout);
+  }
+
+  /// called when user manually stops timer (as an alternative to expiry). Leaves the timer linked in the wheel
+  void stop_timer_(timer_impl& timer)
+  {
+    uint64_t old_state = timer.state.load(std::memory_order_relaxed);
+    while (decode_is_running(old_state)) {
+      if (timer.state.compare_exchange_weak(old_state,
+                                            encode_state(STOPPED_FLAG,
+                                                         decode_duration(old_state),
+                                                         decode_timeout(old_state)),
+                                            std::memory_order_relaxed)) {
+        nof_timers_running_.fetch_sub(1, std::memory_order_relaxed);
+        return;
+      }
     }
+  }
 
-    // Insert timer in wheel
-    time_wheel[new_wheel_pos].push_front(&timer);
-    timer.state.store(encode_state(RUNNING_FLAG, duration_, new_timeout), std::memory_order_relaxed);
-    nof_timers_running_++;
+  wheel_list_t& get_slot(size_t level, tic_t timeout)
+  {
+    return time_wheel[level * LEVEL_SIZE + ((timeout >> (LEVEL_SHIFT * level)) & LEVEL_MASK)];
   }
 
-  /// called when user manually stops timer (as an alternative to expiry)
-  void stop_timer_(timer_impl& timer, bool expiry)
+  /// places the timer in the level of the highest byte where its timeout differs from the current time
+  void link_timer_(timer_impl& timer, tic_t timeout)
   {
-    uint64_t timer_old_state = timer.state.load(std::memory_order_relaxed);
-    if (not decode_is_running(timer_old_state)) {
-      return;
+    tic_t  diff  = timeout ^ cur_time.load(std::memory_order_relaxed);
+    size_t level = 0;
+    while (level < NOF_LEVELS - 1 and (diff >> (LEVEL_SHIFT * (level + 1))) != 0) {
+      level++;
     }
+    wheel_list_t& slot = get_slot(level, timeout);
+    slot.push_front(&timer);
+    timer.wheel_list    = &slot;
+    timer.wheel_timeout = timeout;
+  }
 
-    // If already running, need to disconnect it from previous wheel
-    uint32_t old_timeout = decode_timeout(timer_old_state);
-    time_wheel[old_timeout & WHEEL_MASK].pop(&timer);
-    uint64_t new_state =
-        encode_state(expiry ? EXPIRED_FLAG : STOPPED_FLAG, decode_duration(timer_old_state), old_timeout);
-    timer.state.store(new_state, std::memory_order_relaxed);
-    nof_timers_running_--;
+  void unlink_timer_(timer_impl& timer)
+  {
+    if (timer.wheel_list != nullptr) {
+      timer.wheel_list->pop(&timer);
+      timer.wheel_list = nullptr;
+    }
   }
 
-  std::atomic<tic_t> cur_time{0};
-  size_t             nof_timers_running_ = 0, nof_free_timers = 0;
+  std::atomic<tic_t>  cur_time{0};
+  std::atomic<size_t> nof_timers_running_{0};
+  size_t              nof_free_timers = 0;
   // using a deque to maintain reference validity on emplace_back. Also, this deque will only grow.
-  std::deque<timer_impl>                                         timer_list;
-  srsran::intrusive_forward_list<timer_impl>                     free_list;
-  std::vector<srsran::intrusive_double_linked_list<timer_impl> > time_wheel;
-  mutable std::mutex                                             mutex; // Protect priority queue
+  std::deque<timer_impl>                             timer_list;
+  srsran::intrusive_forward_list<timer_impl>         free_list;
+  std::array<wheel_list_t, NOF_LEVELS * LEVEL_SIZE> time_wheel;
+  mutable std::mutex                                 mutex; // Protect time wheel
 };
 
 using unique_timer = timer_handler::unique_timer;
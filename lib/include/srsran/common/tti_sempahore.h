@@ -19,9 +19,11 @@
  *
  */
 
+#include "srsran/common/futex_util.h"
+#include <array>
 #include <assert.h>
-#include <condition_variable>
-#include <deque>
+#include <atomic>
+#include <chrono>
 #include <inttypes.h>
 #include <mutex>
 
@@ -30,23 +32,91 @@
 
 namespace srsran {
 
+/// Wait time statistics of a tti_semaphore
+struct tti_semaphore_stats_t {
+  static constexpr uint32_t nof_bins = 16;
+  uint64_t                  nof_waits  = 0; ///< calls to wait() and wait_all()
+  uint64_t                  nof_sleeps = 0; ///< waits that exhausted the spin budget and slept on the futex
+  /// Histogram of the wait times, bin i counts the waits of [2^(i-1), 2^i) us (bin 0 is < 1 us, the last bin is open)
+  std::array<uint64_t, nof_bins> wait_us_hist = {};
+};
+
 /**
  * Implements priority semaphore based on a FIFO queue wait . This class enqueues T type element identifiers (method
  * push) and waits until the enqueued object is the first (method wait). The first element is released by method
  * release. The method release_all waits for all the elements to be released.
  *
- * @tparam T Object identifier type
+ * The FIFO is a ring of up to N identifiers indexed by two free running counters. The waiting threads spin for a
+ * configurable number of iterations, which keeps the handoff between workers well below a millisecond, and then sleep
+ * on a futex on the head counter, as only a release can end a wait.
+ *
+ * @tparam T Object identifier type, it has to be trivially copyable
+ * @tparam N Maximum number of enqueued identifiers, push() waits for a release when the FIFO is full
  */
-template <class T>
+template <class T, uint32_t N = 64>
 class tti_semaphore
 {
 private:
-  std::mutex              mutex; ///< Used for scope mutexes
-  std::condition_variable cvar;  ///< Used for notifying element identifier releases
-  std::deque<T>           fifo;  ///< Queue to keep order
+  using clock_t = std::chrono::steady_clock;
+
+  std::array<std::atomic<T>, N> fifo;            ///< Ring of element identifiers
+  std::atomic<uint32_t>         head{0};         ///< Index of the first element, futex word of the waiting threads
+  std::atomic<uint32_t>         tail{0};         ///< Index past the last element
+  std::atomic<uint32_t>         nof_sleepers{0}; ///< Threads sleeping on the head futex
+  std::mutex                    push_mutex;      ///< Serializes concurrent pushes
+  std::atomic<uint32_t>         spin_budget;     ///< Spin iterations before sleeping
+
+  // Wait time statistics
+  std::atomic<uint64_t>                                              nof_waits{0};
+  std::atomic<uint64_t>                                              nof_sleeps{0};
+  std::array<std::atomic<uint64_t>, tti_semaphore_stats_t::nof_bins> wait_hist = {};
+
+  /// Waits while must_wait(h) holds, h being the last value read of the head counter
+  template <typename Cond>
+  void wait_head_(const Cond& must_wait)
+  {
+    clock_t::time_point tp     = clock_t::now();
+    uint32_t            spins  = 0;
+    uint32_t            budget = spin_budget.load(std::memory_order_relaxed);
+    bool                slept  = false;
+    uint32_t            h      = head.load(std::memory_order_acquire);
+    while (must_wait(h)) {
+      if (spins < budget) {
+        spins++;
+        cpu_relax();
+      } else {
+        slept = true;
+        nof_sleepers.fetch_add(1);
+        futex_wait(head, h);
+        nof_sleepers.fetch_sub(1);
+      }
+      h = head.load(std::memory_order_acquire);
+    }
+    record_wait_(clock_t::now() - tp, slept);
+  }
+
+  void record_wait_(clock_t::duration d, bool slept)
+  {
+    uint64_t us  = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    uint32_t bin = 0;
+    while (us > 0 and bin < tti_semaphore_stats_t::nof_bins - 1) {
+      us >>= 1U;
+      bin++;
+    }
+    wait_hist[bin].fetch_add(1, std::memory_order_relaxed);
+    nof_waits.fetch_add(1, std::memory_order_relaxed);
+    if (slept) {
+      nof_sleeps.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
 
 public:
-  tti_semaphore() = default;
+  static constexpr uint32_t default_spin_budget = 1000;
+
+  explicit tti_semaphore(uint32_t spin_budget_ = default_spin_budget) : spin_budget(spin_budget_) {}
+
+  /// Sets the number of spin iterations before a waiting thread sleeps, 0 sleeps right away
+  void set_spin_budget(uint32_t spin_budget_) { spin_budget.store(spin_budget_, std::memory_order_relaxed); }
 
   /**
    * Waits for the first element of the queue match the element identifier provided.
@@ -55,13 +125,15 @@ public:
    */
   void wait(T id)
   {
-    std::unique_lock<std::mutex> lock(mutex);
-
     // While the FIFO is not empty and the front ID does not match the provided element identifier, keep waiting
-    while (not fifo.empty() and fifo.front() != id) {
-      // Wait for a release
-      cvar.wait(lock);
-    }
+    wait_head_([this, id](uint32_t h) {
+      if (h == tail.load(std::memory_order_acquire)) {
+        return false;
+      }
+      T front = fifo[h % N].load(std::memory_order_relaxed);
+      // The slot of the front can be reused once the head moves, in which case the front is read again
+      return h != head.load(std::memory_order_acquire) or front != id;
+    });
   }
 
   /**
@@ -71,10 +143,17 @@ public:
    */
   void push(T id)
   {
-    std::unique_lock<std::mutex> lock(mutex);
+    std::lock_guard<std::mutex> lock(push_mutex);
+    uint32_t                    t = tail.load(std::memory_order_relaxed);
+
+    // Wait for a free position
+    if (t - head.load(std::memory_order_acquire) >= N) {
+      wait_head_([t](uint32_t h) { return t - h >= N; });
+    }
 
     // Append the element identifier
-    fifo.push_back(id);
+    fifo[t % N].store(id, std::memory_order_relaxed);
+    tail.store(t + 1, std::memory_order_release);
   }
 
   /**
@@ -82,15 +161,18 @@ public:
    */
   void release()
   {
-    std::unique_lock<std::mutex> lock(mutex);
-
     // If the FIFO is not empty pop first element
-    if (not fifo.empty()) {
-      fifo.pop_front();
+    uint32_t h = head.load(std::memory_order_relaxed);
+    while (h != tail.load(std::memory_order_acquire)) {
+      if (head.compare_exchange_weak(h, h + 1)) {
+        break;
+      }
     }
 
     // Notify release
-    cvar.notify_all();
+    if (nof_sleepers.load() > 0) {
+      futex_wake_all(head);
+    }
   }
 
   /**
@@ -98,12 +180,20 @@ public:
    */
   void wait_all()
   {
-    std::unique_lock<std::mutex> lock(mutex);
-
     // Wait until the FIFO is empty
-    while (not fifo.empty()) {
-      cvar.wait(lock);
+    wait_head_([this](uint32_t h) { return h != tail.load(std::memory_order_acquire); });
+  }
+
+  /// Returns the wait time statistics since the creation of the semaphore
+  tti_semaphore_stats_t get_wait_stats() const
+  {
+    tti_semaphore_stats_t stats;
+    stats.nof_waits  = nof_waits.load(std::memory_order_relaxed);
+    stats.nof_sleeps = nof_sleeps.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < tti_semaphore_stats_t::nof_bins; ++i) {
+      stats.wait_us_hist[i] = wait_hist[i].load(std::memory_order_relaxed);
     }
+    return stats;
   }
 };
 } // namespace srsran
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_TUN_UTILS_H
+#define SRSRAN_TUN_UTILS_H
+
+/******************************************************************************
+ * Queue steering and offloads of the TUN devices.
+ *
+ * The packets sent through a multi-queue TUN device (IFF_MULTI_QUEUE) are
+ * spread across its queues by an eBPF program, so that each flow is always
+ * read from the same queue.
+ *
+ * Each packet read from or written to such a TUN queue is preceded by a
+ * virtio_net_hdr. With the checksum and TCP segmentation offloads enabled, the
+ * kernel hands over the TCP segments of a flow coalesced in packets of up to
+ * 64 KB (GSO) with the checksum left to the reader, so a single read returns
+ * what would otherwise take tens of them. The packets are split back into
+ * segments of the MSS in user space.
+ *****************************************************************************/
+
+#include "srsran/common/byte_buffer.h"
+
+#include <cstdint>
+#include <sys/types.h>
+#include <vector>
+
+namespace srsran {
+
+/// Steers the packets sent through the multi-queue TUN device of the queue tun_fd to the queue
+/// ntohl(daddr) % nof_queues, by IPv4 destination address
+bool tun_set_steering_by_daddr(int tun_fd);
+
+/// Steers the packets sent through the multi-queue TUN device of the queue tun_fd by the flow hash of the sending
+/// socket, or by IPv4 destination address for the packets without it
+bool tun_set_steering_by_flow(int tun_fd);
+
+/// Size of the virtio_net_hdr preceding each packet of a TUN queue opened with IFF_VNET_HDR
+const uint32_t tun_vnet_hdr_size = 10;
+
+/// Size of the buffer needed to read any packet of a TUN queue with the TCP segmentation offloads enabled
+const uint32_t tun_vnet_max_frame_size = tun_vnet_hdr_size + 65535 + 40;
+
+/// Enables the checksum and TCP segmentation offloads of the TUN device of the queue tun_fd, opened with IFF_VNET_HDR
+bool tun_vnet_enable_offloads(int tun_fd);
+
+/// Splits the packet read from a TUN queue opened with IFF_VNET_HDR (frame holds its virtio_net_hdr) into the IP
+/// packets the kernel coalesced, with the checksums filled in, and appends them to pkts. Returns the number of packets
+/// appended, or -1 if the packet is malformed, uses an offload that is not enabled or runs out of byte buffers (pkts
+/// may then hold part of the packets)
+int tun_vnet_split(const uint8_t* frame, uint32_t len, std::vector<unique_byte_buffer_t>& pkts);
+
+/// Writes the IP packet pkt to a TUN queue opened with IFF_VNET_HDR, behind a virtio_net_hdr with no offloads. Returns
+/// the number of bytes of pkt written, or -1 on error
+ssize_t tun_vnet_write(int tun_fd, const uint8_t* pkt, uint32_t len);
+
+} // namespace srsran
+
+#endif // SRSRAN_TUN_UTILS_H
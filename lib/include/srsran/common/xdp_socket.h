@@ -0,0 +1,113 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_XDP_SOCKET_H
+#define SRSRAN_XDP_SOCKET_H
+
+#include "srsran/common/network_utils.h"
+#include "srsran/srslog/srslog.h"
+
+#include <cstdint>
+#include <netinet/in.h>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * AF_XDP socket receiving the UDP datagrams sent to a port through one Rx queue of a network interface, bypassing the
+ * kernel network stack.
+ *
+ * An XDP program attached to the interface redirects the IPv4 datagrams (without IP options nor fragments) sent to the
+ * port to the socket, any other packet goes on to the kernel. The UMEM of the socket is the memory of the byte buffer
+ * pool, so the frames are written by the kernel (or the NIC, in zero-copy mode) right into byte buffers that are
+ * handed over to the upper layers with msg pointing at the UDP payload. The UDP checksum is not verified.
+ *
+ * Only the Rx path goes through the socket, datagrams received in other queues of the interface are delivered by the
+ * kernel to the regular UDP socket bound to the port, which is also used to transmit.
+ */
+class xdp_udp_socket
+{
+public:
+  /// Maximum number of datagrams returned by each recv() call
+  static const uint32_t max_batch_size = 32;
+
+  explicit xdp_udp_socket(srslog::basic_logger& logger_) : logger(logger_) {}
+  xdp_udp_socket(const xdp_udp_socket&) = delete;
+  xdp_udp_socket& operator=(const xdp_udp_socket&) = delete;
+  ~xdp_udp_socket() { close(); }
+
+  /// Opens the socket on the queue queue_id of the interface ifname, for the datagrams sent to bind_addr:port. An
+  /// empty or "0.0.0.0" bind_addr accepts any destination address. ring_size is the number of byte buffers handed to
+  /// the kernel to receive frames (a power of 2)
+  bool open(const char* ifname, uint32_t queue_id, const char* bind_addr, int port, uint32_t ring_size = 512);
+  void close();
+
+  bool is_open() const { return xsk_fd >= 0; }
+  /// File descriptor to wait for data with poll/select
+  int fd() const { return xsk_fd; }
+  /// Returns true if the frames are received in zero-copy mode, i.e. the driver supports AF_XDP
+  bool is_zero_copy() const { return zero_copy; }
+
+  /// Reads up to max_batch_size datagrams, with the source address of each of them. Returns the number of datagrams
+  int recv(unique_byte_buffer_t* pdus, sockaddr_in* from, uint32_t max_pdus);
+
+private:
+  struct ring_t {
+    uint32_t* producer = nullptr;
+    uint32_t* consumer = nullptr;
+    void*     descs    = nullptr;
+    void*     map      = nullptr;
+    size_t    map_len  = 0;
+  };
+
+  bool attach_program(uint32_t ifindex, in_addr_t addr, int port);
+  bool map_ring(ring_t& ring, const void* offsets, size_t desc_sz, off_t pgoff);
+  void refill();
+
+  srslog::basic_logger& logger;
+  int                   xsk_fd    = -1;
+  int                   map_fd    = -1;
+  int                   prog_fd   = -1;
+  int                   link_fd   = -1;
+  uint32_t              queue_id  = 0;
+  bool                  zero_copy = false;
+  uint32_t              nof_descs = 0;
+  ring_t                fill_ring, comp_ring, rx_ring;
+
+  // UMEM, the byte buffer pool memory rounded to pages
+  uint8_t* umem_base  = nullptr;
+  uint8_t* pool_base  = nullptr;
+  size_t   block_size = 0;
+  // Buffers of the pool lent to the kernel through the fill ring, by block index
+  std::vector<bool> lent_blocks;
+};
+
+/**
+ * Similar to make_sdu_handler, but for an AF_XDP UDP socket. The socket must outlive the returned callback
+ */
+socket_manager_itf::recv_callback_t make_xdp_sdu_handler(srslog::basic_logger&      logger,
+                                                         srsran::task_queue_handle& queue,
+                                                         xdp_udp_socket&            socket,
+                                                         recvfrom_callback_t        rx_callback);
+
+} // namespace srsran
+
+#endif // SRSRAN_XDP_SOCKET_H
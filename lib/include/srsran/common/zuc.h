@@ -56,4 +56,22 @@ typedef struct {
 void zuc_initialize(zuc_state_t* state, const u8* k, u8* iv);
 void zuc_generate_keystream(zuc_state_t* state, int key_stream_len, u32* p_keystream);
 
+/* number of keystreams generated in parallel, one per SIMD lane */
+#define ZUC_MAX_LANES 8
+
+/* the states of up to ZUC_MAX_LANES independent keystreams (e.g. one per PDU), stored lane by lane */
+typedef struct {
+  u32 LFSR_S[16][ZUC_MAX_LANES];
+  u32 F_R1[ZUC_MAX_LANES];
+  u32 F_R2[ZUC_MAX_LANES];
+} zuc_lanes_state_t;
+
+/* initializes nof_lanes lanes with the keys k[l] and the ivs iv[l], and discards the first output of F like
+ * zuc_generate_keystream(), so the keystream can be generated in several calls */
+void zuc_lanes_initialize(zuc_lanes_state_t* state, const u8* const* k, const u8* const* iv, u32 nof_lanes);
+
+/* generates key_stream_len words of every lane, the word t of the lane l is p_keystream[t * ZUC_MAX_LANES + l].
+ * It uses AVX2 if the CPU supports it */
+void zuc_lanes_generate_keystream(zuc_lanes_state_t* state, int key_stream_len, u32* p_keystream);
+
 #endif // SRSRAN_ZUC_H
@@ -23,6 +23,7 @@
 #define SRSRAN_ENB_COMMAND_INTERFACE_H
 
 #include <cstdint>
+#include <string>
 
 namespace srsenb {
 class enb_command_interface
@@ -41,6 +42,14 @@ public:
   virtual void cmd_cell_gain(uint32_t cell_id, float gain) = 0;
 
   virtual void toggle_padding() = 0;
+
+  /**
+   * Changes scheduler and PHY tunables without a restart. All the values are validated before any is applied, and
+   * the change takes effect at the next TTI boundary.
+   * @param settings Space separated list of name=value pairs, with the names of the configuration file options
+   * @return true if all the values were valid and applied
+   */
+  virtual bool cmd_set_tunables(const std::string& settings) = 0;
 };
 } // namespace srsenb
 
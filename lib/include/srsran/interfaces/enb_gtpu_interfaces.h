@@ -34,6 +34,8 @@ struct gtpu_args_t {
   std::string embms_m1u_if_addr;
   bool        embms_enable                 = false;
   uint32_t    indirect_tunnel_timeout_msec = 0;
+  std::string xdp_ifname;                       ///< Interface of the AF_XDP socket of the Rx path, disabled if empty
+  uint32_t    xdp_queue_id                 = 0; ///< Rx queue of xdp_ifname received through the AF_XDP socket
 };
 
 // GTPU interface for PDCP
@@ -35,6 +35,8 @@ struct mac_args_t {
   uint32_t                      nof_prealloc_ues; ///< Number of UE resources to pre-allocate at eNB startup
   uint32_t                      max_nof_kos;
   int                           rlf_min_ul_snr_estim;
+  bool                          ul_softbuffer_8bit       = false; ///< Store UL soft bits in 8 bit, for 8-bit decoding
+  bool                          ul_softbuffer_lazy_alloc = false; ///< Allocate UL soft bits on first use
 };
 
 /* Interface PHY -> MAC */
@@ -197,6 +199,56 @@ public:
    */
   virtual int crc_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t nof_bytes, bool crc_res) = 0;
 
+  using ul_feedback_t      = sched_interface::ul_feedback_t;
+  using ul_feedback_list_t = sched_interface::ul_feedback_list_t;
+
+  /**
+   * PHY callback for giving MAC, in a single call, all the SR, ACK, CRC, CQI, RI, PMI, SNR and TA reports decoded in a
+   * TTI for an eNb cell/carrier. The reports are processed in the order of the list, as if they had been given with the
+   * individual callbacks above, which is what the default implementation does.
+   *
+   * The CRC reports must be given before calling push_pdu() for the same transmissions.
+   *
+   * @param tti the given TTI
+   * @param feedback the list of reports, the MAC may modify it
+   * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR* if an error occurs
+   */
+  virtual int ul_feedback_info(uint32_t tti, ul_feedback_list_t& feedback)
+  {
+    for (const ul_feedback_t& fb : feedback) {
+      switch (fb.type) {
+        case ul_feedback_t::sr:
+          sr_detected(tti, fb.rnti);
+          break;
+        case ul_feedback_t::dl_ack:
+          ack_info(tti, fb.rnti, fb.enb_cc_idx, fb.param, fb.value > 0);
+          break;
+        case ul_feedback_t::ul_crc:
+          crc_info(tti, fb.rnti, fb.enb_cc_idx, fb.param, fb.value > 0);
+          break;
+        case ul_feedback_t::dl_ri:
+          ri_info(tti, fb.rnti, fb.enb_cc_idx, fb.value);
+          break;
+        case ul_feedback_t::dl_pmi:
+          pmi_info(tti, fb.rnti, fb.enb_cc_idx, fb.value);
+          break;
+        case ul_feedback_t::dl_cqi:
+          cqi_info(tti, fb.rnti, fb.enb_cc_idx, fb.value);
+          break;
+        case ul_feedback_t::dl_sb_cqi:
+          sb_cqi_info(tti, fb.rnti, fb.enb_cc_idx, fb.param, fb.value);
+          break;
+        case ul_feedback_t::ul_snr:
+          snr_info(tti, fb.rnti, fb.enb_cc_idx, fb.meas, (ul_channel_t)fb.param);
+          break;
+        case ul_feedback_t::ta:
+          ta_info(tti, fb.rnti, fb.meas);
+          break;
+      }
+    }
+    return SRSRAN_SUCCESS;
+  }
+
   /**
    * Pushes an uplink PDU through the stack if crc_res==true or discards it if crc_res==false
    *
@@ -29,7 +29,9 @@
 #include "srsenb/hdr/stack/mac/common/mac_metrics.h"
 #include "srsenb/hdr/stack/rrc/rrc_metrics.h"
 #include "srsenb/hdr/stack/s1ap/s1ap_metrics.h"
+#include "srsran/adt/pool/pool_registry.h"
 #include "srsran/common/metrics_hub.h"
+#include "srsran/common/time_prof.h"
 #include "srsran/radio/radio_metrics.h"
 #include "srsran/rlc/rlc_metrics.h"
 #include "srsran/system/sys_metrics.h"
@@ -57,10 +59,13 @@ struct stack_metrics_t {
 struct enb_metrics_t {
   srsran::rf_metrics_t       rf;
   std::vector<phy_metrics_t> phy;
+  phy_timing_metrics_t       phy_timing;
   stack_metrics_t            stack;
   stack_metrics_t            nr_stack;
-  srsran::sys_metrics_t      sys;
-  bool                       running;
+  srsran::sys_metrics_t                          sys;
+  std::vector<srsran::pool_metrics_t>            pools;
+  std::vector<srsran::tprof_histogram_metrics_t> stages; ///< processing time of the TTI stages
+  bool                                           running;
 };
 
 // ENB interface
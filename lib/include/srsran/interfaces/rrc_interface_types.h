@@ -241,6 +241,19 @@ inline std::string to_string(const nr_establishment_cause_t& cause)
  *      PHY Config
  **************************/
 
+/// Connected mode DRX configuration (TS 36.321 5.7), the timers are given in PDCCH-subframes
+struct drx_cfg_t {
+  bool     enabled             = false;
+  uint32_t on_duration_timer   = 0;
+  uint32_t inactivity_timer    = 0;
+  uint32_t retx_timer          = 0;
+  uint32_t long_cycle          = 0;
+  uint32_t start_offset        = 0;
+  bool     short_cycle_enabled = false;
+  uint32_t short_cycle         = 0;
+  uint32_t short_cycle_timer   = 0; ///< In multiples of the short cycle
+};
+
 struct phy_cfg_t {
   phy_cfg_t() { set_defaults(); }
 
@@ -252,6 +265,8 @@ struct phy_cfg_t {
     prach_cfg_present = false;
     prach_cfg         = {};
 
+    drx_cfg = {};
+
     // CommonConfig defaults for non-zero values
     ul_cfg.pucch.delta_pucch_shift     = 1;
     ul_cfg.power_ctrl.delta_f_pucch[0] = 0;
@@ -318,6 +333,8 @@ struct phy_cfg_t {
 
   bool               prach_cfg_present = false;
   srsran_prach_cfg_t prach_cfg         = {};
+
+  drx_cfg_t drx_cfg = {};
 };
 
 struct mbsfn_sf_cfg_t {
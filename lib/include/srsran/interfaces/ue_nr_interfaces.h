@@ -28,6 +28,7 @@
 #include <array>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace srsue {
 
@@ -231,6 +232,8 @@ struct phy_args_nr_t {
   float                  trs_sinr_ema_alpha    = 0.1f; ///< SINR measurement exponential average alpha
   float                  trs_cfo_ema_alpha     = 0.1f; ///< RSRP measurement exponential average alpha
   bool                   enable_worker_cfo     = true; ///< Enable/Disable open loop CFO correction at the workers
+  uint32_t               nof_rx_slots          = 0; ///< SA RX queue depth while all the workers are busy (0 disables)
+  uint32_t               nof_search_threads    = 0; ///< Extra threads for the wideband SSB search (0 disables)
 
   phy_args_nr_t()
   {
@@ -321,6 +324,7 @@ public:
     srsran_subcarrier_spacing_t ssb_scs;
     srsran_ssb_pattern_t        ssb_pattern;
     srsran_duplex_mode_t        duplex_mode;
+    std::vector<double>         ssb_freq_list; ///< SSB raster frequencies searched in a single capture (optional)
   };
 
   /**
@@ -56,6 +56,8 @@ struct phy_args_t {
   int force_N_id_2 = -1; // Cell identity within the identity group (PSS) to filter.
   int force_N_id_1 = -1; // Cell identity group (SSS) to filter.
 
+  bool cell_search_single_pass = false; // Search the three PSS (N_id_2) on the same frames instead of one after another
+
   float dl_freq = -1.0f;
   float ul_freq = -1.0f;
 
@@ -82,6 +84,7 @@ struct phy_args_t {
   bool        cfo_is_doppler               = false;
   bool        cfo_integer_enabled          = false;
   float       cfo_correct_tol_hz           = 1.0f;
+  bool        cfo_correct_in_ofdm          = false;
   float       cfo_pss_ema                  = DEFAULT_CFO_EMA_TRACK;
   float       cfo_loop_bw_pss              = DEFAULT_CFO_BW_PSS;
   float       cfo_loop_bw_ref              = DEFAULT_CFO_BW_REF;
@@ -89,6 +92,8 @@ struct phy_args_t {
   float       cfo_loop_pss_tol             = DEFAULT_CFO_PSS_MIN;
   float       sfo_ema                      = DEFAULT_SFO_EMA_COEFF;
   uint32_t    sfo_correct_period           = DEFAULT_SAMPLE_OFFSET_CORRECT_PERIOD;
+  uint32_t    pss_track_window             = 0;
+  bool        pss_track_fft                = false;
   uint32_t    cfo_loop_pss_conv            = DEFAULT_PSS_STABLE_TIMEOUT;
   uint32_t    cfo_ref_mask                 = 1023;
   bool        interpolate_subframe_enabled = false;
@@ -96,16 +101,23 @@ struct phy_args_t {
   float       estimator_fil_stddev         = 1.0f;
   uint32_t    estimator_fil_order          = 4;
   float       snr_to_cqi_offset            = 0.0f;
+  float       pdcch_prescreen_ratio        = 0.1f;
+  bool        dl_ctrl_first                = false;
   std::string sss_algorithm                = "full";
   float       rx_gain_offset               = 62;
   bool        pdsch_csi_enabled            = true;
   bool        pdsch_8bit_decoder           = false;
+  uint32_t    nof_cb_decoder_threads       = 0;
+  bool        ul_early_encode              = false;
   uint32_t    intra_freq_meas_len_ms       = 20;
   uint32_t    intra_freq_meas_period_ms    = 200;
+  uint32_t    intra_freq_meas_duty_cycle   = 100;
   float       force_ul_amplitude           = 0.0f;
   bool        detect_cp                    = false;
 
-  bool nr_store_pdsch_ko = false;
+  bool     nr_store_pdsch_ko = false;
+  uint32_t nr_nof_rx_slots   = 0;
+  uint32_t nr_search_threads = 0;
 
   float    in_sync_rsrp_dbm_th    = -130.0f;
   float    in_sync_snr_db_th      = 1.0f;
@@ -42,7 +42,7 @@ public:
     virtual void process_pdu(uint8_t* buff, uint32_t len, channel_t channel, int ul_nof_prbs = -1) = 0;
   };
 
-  pdu_queue(srslog::basic_logger& logger) : pool(DEFAULT_POOL_SIZE), callback(NULL), logger(logger) {}
+  pdu_queue(srslog::basic_logger& logger) : pool(DEFAULT_POOL_SIZE, "mac_pdu_queue"), callback(NULL), logger(logger) {}
   void init(process_callback* callback);
 
   uint8_t* request(uint32_t len);
@@ -105,4 +105,13 @@ SRSRAN_API void srsran_agc_set_gain(srsran_agc_t* q, float init_gain_value_db);
 
 SRSRAN_API void srsran_agc_process(srsran_agc_t* q, cf_t* signal, uint32_t len);
 
+/* Runs the AGC on int16 I/Q samples, which are converted to float as x / scale. The samples are not modified, when
+ * there is no gain callback the software gain, srsran_agc_get_gain(), must be folded into the conversion scale */
+SRSRAN_API void srsran_agc_process_sc16(srsran_agc_t* q, const int16_t* signal, float scale, uint32_t len);
+
+/* Runs the AGC with the average and peak power of the samples, as measured by srsran_vec_max_avg_power_cf() or as a
+ * by-product of another pass over them (e.g. srsran_cfo_correct_power()). The samples are not modified, so the software
+ * gain is only applied to the measurement */
+SRSRAN_API void srsran_agc_process_power(srsran_agc_t* q, float avg_pwr, float max_pwr);
+
 #endif // SRSRAN_AGC_H
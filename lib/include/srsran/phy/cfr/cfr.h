@@ -55,11 +55,22 @@ typedef struct SRSRAN_API {
   float manual_thr; ///< Fixed threshold used in SRSRAN_CFR_THR_MANUAL mode
 
   // SRSRAN_CFR_THR_AUTO_CMA and SRSRAN_CFR_THR_AUTO_EMA mode parameters
-  bool  measure_out_papr; ///< Enable / disable output PAPR measurement
+  bool  measure_out_papr; ///< Enable / disable output PAPR measurement in the metrics (any mode)
   float max_papr_db;      ///< Input PAPR threshold used in SRSRAN_CFR_THR_AUTO_CMA and SRSRAN_CFR_THR_AUTO_EMA modes
   float ema_alpha;        ///< EMA alpha parameter for avg power calculation, used in SRSRAN_CFR_THR_AUTO_EMA mode
 } srsran_cfr_cfg_t;
 
+/**
+ * @brief CFR metrics, accumulated over the processed OFDM symbols since the last reset
+ */
+typedef struct SRSRAN_API {
+  uint64_t nof_symbols; ///< Number of processed OFDM symbols
+  uint64_t nof_clipped; ///< Number of OFDM symbols with at least one sample above the clipping threshold
+  float    papr_in_db;  ///< Input PAPR, peak power over the average power of all the symbols
+  float    papr_out_db; ///< Output PAPR, only measured if measure_out_papr is enabled, 0 otherwise
+  float    evm;         ///< In-band error introduced by the CFR relative to the input power, in percent
+} srsran_cfr_metrics_t;
+
 typedef struct SRSRAN_API {
   srsran_cfr_cfg_t cfg;
   float            max_papr_lin;
@@ -69,15 +80,22 @@ typedef struct SRSRAN_API {
   float*            lpf_spectrum; ///< FFT filter spectrum
   uint32_t          lpf_bw;       ///< Bandwidth of the LPF
 
-  float* abs_buffer_in;  ///< Store the input absolute value
-  float* abs_buffer_out; ///< Store the output absolute value
-  cf_t*  peak_buffer;
+  cf_t* peak_buffer; ///< Peak signal in time domain, filtered in place
+  cf_t* freq_buffer; ///< Peak signal spectrum
 
-  float pwr_avg_in;  ///< store the avg. input power with MA or EMA averaging
-  float pwr_avg_out; ///< store the avg. output power with MA or EMA averaging
+  float pwr_avg_in; ///< store the avg. input power with MA or EMA averaging
 
   // Power average buffers, used in SRSRAN_CFR_THR_AUTO_CMA mode
   uint64_t cma_n;
+
+  // Metrics accumulators
+  uint64_t metrics_nof_symbols;
+  uint64_t metrics_nof_clipped;
+  float    metrics_peak_in;
+  float    metrics_peak_out;
+  double   metrics_energy_in;
+  double   metrics_energy_out;
+  double   metrics_energy_err;
 } srsran_cfr_t;
 
 SRSRAN_API int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg);
@@ -85,6 +103,10 @@ SRSRAN_API int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg);
 /**
  * @brief Applies the CFR algorithm to the time domain OFDM symbols
  *
+ * The part of the symbol above the threshold is extracted, filtered to the symbol bandwidth and scaled by alpha, and
+ * then subtracted from the symbol. Symbols without any sample above the threshold are not filtered. The input and
+ * output buffers can be the same.
+ *
  * @attention This function must be called once per symbol, and it will process q->symbol_sz samples
  *
  * @param[in]  q    The CFR object and configuration
@@ -96,6 +118,23 @@ SRSRAN_API void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out);
 
 SRSRAN_API void srsran_cfr_free(srsran_cfr_t* q);
 
+/**
+ * @brief Gets the CFR metrics accumulated since the initialization or the last reset
+ *
+ * @param[in]  q        the CFR object
+ * @param[out] metrics  the CFR metrics
+ */
+SRSRAN_API void srsran_cfr_get_metrics(const srsran_cfr_t* q, srsran_cfr_metrics_t* metrics);
+
+/**
+ * @brief Resets the CFR metrics
+ *
+ * @attention this is not thread-safe
+ *
+ * @param[in] q the CFR object
+ */
+SRSRAN_API void srsran_cfr_reset_metrics(srsran_cfr_t* q);
+
 /**
  * @brief Checks the validity of the CFR algorithm parameters.
  *
@@ -47,6 +47,9 @@
 #include "srsran/phy/sync/pss.h"
 #include "wiener_dl.h"
 
+/// Number of OFDM symbols at the start of a subframe holding the control region and at least one CRS of every port
+#define SRSRAN_CHEST_DL_CTRL_NOF_SYMBOLS(cp) (SRSRAN_CP_ISNORM(cp) ? 5 : 4)
+
 typedef struct SRSRAN_API {
   cf_t*    ce[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS];
   uint32_t nof_re;
@@ -74,6 +77,24 @@ typedef enum SRSRAN_API {
   SRSRAN_NOISE_ALG_EMPTY,
 } srsran_chest_dl_noise_alg_t;
 
+/* Runs task(arg, idx) for every idx from 0 to nof_tasks - 1, possibly concurrently, and returns once all of them
+ * have finished. Used to run the Wiener estimation of the ports and antennas in parallel. */
+typedef void (*srsran_chest_dl_task_t)(void* arg, uint32_t idx);
+typedef void (*srsran_chest_dl_parallel_for_t)(void*                  executor,
+                                               srsran_chest_dl_task_t task,
+                                               void*                  arg,
+                                               uint32_t               nof_tasks);
+
+/* Wiener estimation of a port and antenna, deferred until the least squares estimates of all of them are available */
+typedef struct SRSRAN_API {
+  uint32_t port_id;
+  uint32_t rxant_id;
+  uint32_t shift;
+  uint32_t nsymb;
+  float    snr_lin;
+  cf_t*    ce;
+} srsran_chest_dl_wiener_job_t;
+
 // Channel estimator algorithm
 typedef enum SRSRAN_API {
   SRSRAN_ESTIMATOR_ALG_AVERAGE = 0,
@@ -90,6 +111,13 @@ typedef struct SRSRAN_API {
 
   srsran_wiener_dl_t* wiener_dl;
 
+  /* parallel Wiener estimation */
+  srsran_chest_dl_parallel_for_t parallel_for;
+  void*                          executor;
+  cf_t*                          wiener_pilots[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS]; // [rxant][port]
+  srsran_chest_dl_wiener_job_t   wiener_jobs[SRSRAN_MAX_PORTS * SRSRAN_MAX_PORTS];
+  uint32_t                       nof_wiener_jobs;
+
   cf_t* pilot_estimates;
   cf_t* pilot_estimates_average;
   cf_t* pilot_recv_signal;
@@ -133,6 +161,10 @@ typedef struct SRSRAN_API {
   uint32_t cfo_estimate_sf_mask;
   bool     sync_error_enable;
 
+  /// Estimates the channel from the CRS of the first SRSRAN_CHEST_DL_CTRL_NOF_SYMBOLS OFDM symbols only and writes the
+  /// estimates of those symbols. The CFO, the synchronization error and the PSS/SSS based noise are not estimated
+  bool ctrl_region_only;
+
 } srsran_chest_dl_cfg_t;
 
 SRSRAN_API int srsran_chest_dl_init(srsran_chest_dl_t* q, uint32_t max_prb, uint32_t nof_rx_antennas);
@@ -154,6 +186,11 @@ SRSRAN_API int srsran_chest_dl_set_mbsfn_area_id(srsran_chest_dl_t* q, uint16_t
 
 SRSRAN_API int srsran_chest_dl_set_cell(srsran_chest_dl_t* q, srsran_cell_t cell);
 
+/* Estimates the ports and antennas with the Wiener estimator in concurrent tasks run through parallel_for, once its
+ * filters are trained. Set parallel_for to NULL to estimate them sequentially. */
+SRSRAN_API int
+srsran_chest_dl_set_executor(srsran_chest_dl_t* q, srsran_chest_dl_parallel_for_t parallel_for, void* executor);
+
 /* These functions do not change the internal state */
 
 SRSRAN_API int srsran_chest_dl_estimate(srsran_chest_dl_t*     q,
@@ -66,6 +66,12 @@ typedef struct SRSRAN_API {
 
   // Group Hopping Flag
   uint32_t* f_gh_pattern;
+  bool      f_gh_valid;
+  uint32_t  f_gh_N_x_id; // N_x_id the PSSCH group hopping pattern was generated for
+
+  // The PSSCH DMRS is only generated again if N_x_id, nof_prb or (TM3/4) the subframe change
+  bool                  pssch_dmrs_valid;
+  srsran_chest_sl_cfg_t pssch_dmrs_cfg;
 
   cf_t* r_sequence[SRSRAN_SL_MAX_DMRS_SYMB][SRSRAN_SL_MAX_PSCCH_NOF_DMRS_CYCLIC_SHIFTS];
 
@@ -73,8 +79,9 @@ typedef struct SRSRAN_API {
 
   cf_t* ce;
   cf_t* ce_average;
-  cf_t* noise_tmp;
-  float noise_estimated;
+  cf_t*  noise_tmp;
+  float* ce_abs_square;
+  float  noise_estimated;
 
   srsran_interp_linsrsran_vec_t lin_vec_sl;
 
@@ -106,6 +113,8 @@ SRSRAN_API int srsran_chest_sl_get_dmrs(srsran_chest_sl_t* q, cf_t* sf_buffer, c
 
 SRSRAN_API void srsran_chest_sl_ls_estimate(srsran_chest_sl_t* q, cf_t* sf_buffer);
 
+/* For PSCCH and PSSCH only the REs of the configured allocation are estimated and equalized, the rest of
+ * equalized_sf_buffer is left untouched */
 SRSRAN_API void srsran_chest_sl_ls_equalize(srsran_chest_sl_t* q, cf_t* sf_buffer, cf_t* equalized_sf_buffer);
 
 SRSRAN_API void srsran_chest_sl_ls_estimate_equalize(srsran_chest_sl_t* q, cf_t* sf_buffer, cf_t* equalized_sf_buffer);
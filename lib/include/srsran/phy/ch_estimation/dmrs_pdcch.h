@@ -23,6 +23,7 @@
 #define SRSRAN_DMRS_PDCCH_H
 
 #include "srsran/phy/common/phy_common_nr.h"
+#include "srsran/phy/common/sequence.h"
 #include "srsran/phy/phch/dci_nr.h"
 #include "srsran/phy/resampling/interp.h"
 #include "srsran/phy/resampling/resampler.h"
@@ -81,6 +82,9 @@ typedef struct SRSRAN_API {
   /// Frequency domain smoothing filter
   float*   filter;
   uint32_t filter_len;
+
+  /// DMRS sequences of the carrier, by slot and CORESET symbol
+  srsran_sequence_rs_cache_t sequence_cache;
 } srsran_dmrs_pdcch_estimator_t;
 
 /**
@@ -24,6 +24,7 @@
 
 #include "srsran/phy/ch_estimation/chest_dl.h"
 #include "srsran/phy/common/phy_common_nr.h"
+#include "srsran/phy/common/sequence.h"
 #include "srsran/phy/phch/phch_cfg_nr.h"
 #include <stdint.h>
 
@@ -60,7 +61,12 @@ typedef struct {
 
   float* filter; ///< Smoothing filter
 
+  cf_t* wiener_coeffs; ///< Precomputed frequency domain Wiener filters, NULL if the linear interpolation is used
+  cf_t* wiener_temp;   ///< Temporal data vector of size 2 * SRSRAN_NRE * max_nof_prb for the Wiener interpolation
+
   srsran_csi_trs_measurements_t csi; ///< Last estimated channel state information
+
+  srsran_sequence_rs_cache_t sequence_cache; ///< DMRS sequences of the carrier, by slot and symbol
 } srsran_dmrs_sch_t;
 
 /**
@@ -131,6 +137,18 @@ SRSRAN_API void srsran_dmrs_sch_free(srsran_dmrs_sch_t* q);
  */
 SRSRAN_API int srsran_dmrs_sch_set_carrier(srsran_dmrs_sch_t* q, const srsran_carrier_nr_t* carrier);
 
+/**
+ * @brief Selects the frequency domain interpolation of the estimates. The Wiener (MMSE) interpolation filters are
+ * computed once for a set of SNR and delay spread buckets, the estimation selects the bucket that matches its
+ * measurements. Otherwise, the pilots are smoothed and linearly interpolated.
+ *
+ * @param q DMRS PDSCH object, initialised as receiver
+ * @param enable Set to true for the Wiener interpolation, false for the linear interpolation
+ *
+ * @return it returns SRSRAN_ERROR code if an error occurs, otherwise it returns SRSRAN_SUCCESS
+ */
+SRSRAN_API int srsran_dmrs_sch_set_wiener(srsran_dmrs_sch_t* q, bool enable);
+
 /**
  * @brief Puts PDSCH DMRS into a given resource grid
  *
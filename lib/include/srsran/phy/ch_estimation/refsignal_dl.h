@@ -49,6 +49,7 @@ typedef struct SRSRAN_API {
   cf_t*         pilots[2][SRSRAN_NOF_SF_X_FRAME]; // Saves the reference signal per subframe for ports 0,1 and ports 2,3
   srsran_sf_t   type;
   uint16_t      mbsfn_area_id;
+  bool          mbsfn_valid; // MBSFN pilots are generated for the current area ID and bandwidth
 } srsran_refsignal_t;
 
 SRSRAN_API int srsran_refsignal_cs_init(srsran_refsignal_t* q, uint32_t max_prb);
@@ -36,6 +36,9 @@
 #define SRSRAN_WIENER_DL_XFIFO_SIZE (400U)
 #define SRSRAN_WIENER_DL_TIMEFIFO_SIZE (32U)
 #define SRSRAN_WIENER_DL_CXFIFO_SIZE (400U)
+#define SRSRAN_WIENER_DL_BANK_CACHE_SIZE (4U)
+#define SRSRAN_WIENER_DL_BANK_SNR_STEP_DB (1.0f) // SNR quantisation step of the filter banks
+#define SRSRAN_WIENER_DL_BANK_MAX_CV_ERR (1e-3f) // Relative correlation error up to which a cached bank is reused
 
 typedef struct {
   cf_t*    hls_fifo_1[SRSRAN_WIENER_DL_HLS_FIFO_SIZE]; // Least square channel estimates on odd pilots
@@ -51,8 +54,32 @@ typedef struct {
   uint32_t sumlen; // length of dynamic average window for time domain channel correlation vector
   uint32_t skip;   // pilot OFDM symbols to skip when training Wiener matrices (skip = 1,..,4)
   uint32_t cnt;    // counter for skipping pilot OFDM symbols
+
+  // Training since the last srsran_wiener_dl_update(), the bank is computed with the last channel values
+  bool     trained;
+  float    snr_lin;
+  uint32_t shift;
+
+  // Calculation support, owned by the channel so that the channels can be run concurrently
+  cf_t*           tmp;
+  cf_t            hlsv[SRSRAN_WIENER_DL_MIN_RE];
+  cf_t            hlsv_sum[SRSRAN_WIENER_DL_MIN_RE];
+  srsran_random_t random;
 } srsran_wiener_dl_state_t;
 
+// Wiener matrices for a correlation, pilot shift and quantised SNR, stored by pilot (wm[pilot][re]) so the estimate of
+// all the resource elements is a sum of SRSRAN_WIENER_DL_MIN_REF vectors scaled by the pilots
+typedef struct {
+  cf_t     wm1[SRSRAN_WIENER_DL_MIN_REF][SRSRAN_WIENER_DL_MIN_RE];
+  cf_t     wm2[SRSRAN_WIENER_DL_MIN_REF][SRSRAN_WIENER_DL_MIN_RE];
+  cf_t     acV[SRSRAN_WIENER_DL_MIN_RE]; // correlation vector the matrices were computed with
+  float    acV_pwr;
+  uint32_t shift;
+  int32_t  snr_idx;
+  uint32_t last_used;
+  bool     valid;
+} srsran_wiener_dl_bank_t;
+
 typedef struct {
   // Maximum allocated number of...
   uint32_t max_prb;      // Resource Blocks
@@ -71,15 +98,14 @@ typedef struct {
   // One state per possible channel (allocated in init)
   srsran_wiener_dl_state_t* state[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS];
 
-  // Wiener matrices
-  cf_t wm1[SRSRAN_WIENER_DL_MIN_RE][SRSRAN_WIENER_DL_MIN_REF];
-  cf_t wm2[SRSRAN_WIENER_DL_MIN_RE][SRSRAN_WIENER_DL_MIN_REF];
-  bool wm_computed;
-  bool ready;
+  // Cache of Wiener matrices, the current ones are pointed by bank
+  srsran_wiener_dl_bank_t  banks[SRSRAN_WIENER_DL_BANK_CACHE_SIZE];
+  srsran_wiener_dl_bank_t* bank;
+  uint32_t                 bank_count;
+  bool                     wm_computed;
+  bool                     ready;
 
   // Calculation support
-  cf_t hlsv[SRSRAN_WIENER_DL_MIN_RE];
-  cf_t hlsv_sum[SRSRAN_WIENER_DL_MIN_RE];
   cf_t acV[SRSRAN_WIENER_DL_MIN_RE];
 
   union {
@@ -96,9 +122,6 @@ typedef struct {
   // Temporal vector
   cf_t* tmp;
 
-  // Random generator
-  srsran_random_t random;
-
   // FFT/iFFT
   srsran_dft_plan_t fft;
   srsran_dft_plan_t ifft;
@@ -115,6 +138,9 @@ SRSRAN_API int srsran_wiener_dl_set_cell(srsran_wiener_dl_t* q, srsran_cell_t ce
 
 SRSRAN_API void srsran_wiener_dl_reset(srsran_wiener_dl_t* q);
 
+/* Estimates the channel of the Tx port tx and Rx antenna rx in the OFDM symbol m of the subframe, the pilots of the
+ * symbols carrying them are used for training. Different channels can be run concurrently, the Wiener matrices are
+ * only updated by srsran_wiener_dl_update() */
 SRSRAN_API int srsran_wiener_dl_run(srsran_wiener_dl_t* q,
                                     uint32_t            tx,
                                     uint32_t            rx,
@@ -124,6 +150,10 @@ SRSRAN_API int srsran_wiener_dl_run(srsran_wiener_dl_t* q,
                                     cf_t*               estimated,
                                     float               snr_lin);
 
+/* Updates the Wiener matrices with the training of the channels run since the last call, it shall be called after
+ * running all the channels of a subframe. The matrices are taken from the cache if the correlation did not change */
+SRSRAN_API void srsran_wiener_dl_update(srsran_wiener_dl_t* q);
+
 SRSRAN_API void srsran_wiener_dl_free(srsran_wiener_dl_t* q);
 
 #endif // SRSRAN_WIENER_DL_H_
@@ -52,7 +52,11 @@ typedef struct {
   float coeff_alpha[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS]; // Angle of arrival
   float coeff_a[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS];     // Random phase
   float coeff_b[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS];     // Random phase
-  cf_t* h_tap[SRSRAN_CHANNEL_FADING_MAXTAPS]; // Static tap signal in frequency domain
+  cf_t* h_tap[SRSRAN_CHANNEL_FADING_MAXTAPS]; // Static tap signal in frequency domain, FFT shifted
+
+  // Doppler dispersion terms, the phasors rotate by doppler_rot every N/2 samples
+  cf_t doppler_phasor[SRSRAN_CHANNEL_FADING_MAXTAPS][2][SRSRAN_CHANNEL_FADING_NTERMS]; // Real and imaginary terms
+  cf_t doppler_rot[SRSRAN_CHANNEL_FADING_MAXTAPS][2][SRSRAN_CHANNEL_FADING_NTERMS];
 
   // Utils
   srsran_dft_plan_t fft;             // DFT to frequency domain
@@ -60,7 +64,6 @@ typedef struct {
   cf_t*             temp;            // Temporal buffer, length fft_size
   cf_t*             h_freq;          // Channel frequency response, length fft_size
   cf_t*             y_freq;          // Intermediate frequency domain buffer
-  float             sin_table[1024]; // Table of sinus values
 
   // State variables
   cf_t* state; // To save impulse response of the filter
@@ -83,6 +83,100 @@ SRSRAN_API void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, ui
 
 SRSRAN_API void srsran_sequence_apply_bit(const uint8_t* in, uint8_t* out, uint32_t length, uint32_t seed);
 
+/**
+ * @brief Generates length bits of the sequence with the given seed, packed MSB first as srsran_bit_pack_vector() does.
+ * The bits beyond length in the last byte are set to zero.
+ */
+SRSRAN_API void srsran_sequence_gen_packed(uint8_t* c_bytes, uint32_t length, uint32_t seed);
+
+/**
+ * @brief Applies a sequence generated by srsran_sequence_gen_packed(), changing the sign of the soft bits
+ */
+SRSRAN_API void srsran_sequence_bytes_apply_c(const uint8_t* c_bytes, const int8_t* in, int8_t* out, uint32_t length);
+
+SRSRAN_API void
+srsran_sequence_bytes_apply_s(const uint8_t* c_bytes, const int16_t* in, int16_t* out, uint32_t length);
+
+/**
+ * @brief Applies a sequence generated by srsran_sequence_gen_packed() to unpacked bits
+ */
+SRSRAN_API void
+srsran_sequence_bytes_apply_bit(const uint8_t* c_bytes, const uint8_t* in, uint8_t* out, uint32_t length);
+
+/**
+ * @brief Applies a sequence generated by srsran_sequence_gen_packed() to packed bits
+ */
+SRSRAN_API void
+srsran_sequence_bytes_apply_packed(const uint8_t* c_bytes, const uint8_t* in, uint8_t* out, uint32_t length);
+
+/**
+ * @brief Default number of sequences kept by the physical channel caches
+ */
+#define SRSRAN_SEQUENCE_CACHE_DEFAULT_NOF_ENTRIES 16
+
+typedef struct SRSRAN_API {
+  uint32_t seed;
+  uint32_t len;      ///< Number of generated bits
+  uint32_t max_len;  ///< Number of bits c_bytes fits
+  uint64_t last_use; ///< Cache clock of the last access, zero if the entry is empty
+  uint8_t* c_bytes;  ///< Sequence packed MSB first
+} srsran_sequence_cache_entry_t;
+
+/**
+ * @brief Bounded least recently used cache of packed sequences, indexed by seed. Sequences are generated on a miss.
+ * It is not thread safe, concurrent users shall keep their own cache.
+ */
+typedef struct SRSRAN_API {
+  srsran_sequence_cache_entry_t* entries;
+  uint32_t                       nof_entries;
+  uint64_t                       clock;
+  uint64_t                       nof_hits;
+  uint64_t                       nof_misses;
+} srsran_sequence_cache_t;
+
+SRSRAN_API int srsran_sequence_cache_init(srsran_sequence_cache_t* q, uint32_t nof_entries);
+
+SRSRAN_API void srsran_sequence_cache_free(srsran_sequence_cache_t* q);
+
+/**
+ * @brief Gets at least length bits of the sequence with the given seed, packed MSB first
+ * @return The sequence, valid until the next call, or NULL if the entry could not be allocated
+ */
+SRSRAN_API const uint8_t* srsran_sequence_cache_get(srsran_sequence_cache_t* q, uint32_t seed, uint32_t length);
+
+/**
+ * @brief Cache of QPSK modulated reference signal sequences, r(m) = ((1 - 2c(2m)) + j(1 - 2c(2m + 1))) / sqrt(2), with
+ * one entry for every slot of a radio frame and symbol of a slot. An entry is generated the first time its slot and
+ * symbol are used, and again if the seed changes, so only the symbols carrying the reference signal take memory.
+ * It is not thread safe, concurrent users shall keep their own cache.
+ */
+typedef struct SRSRAN_API {
+  uint32_t  nof_slots;   ///< Number of slots in a radio frame
+  uint32_t  nof_symbols; ///< Number of symbols in a slot
+  uint32_t  len;         ///< Number of modulated symbols of every entry
+  uint32_t* seeds;       ///< Seed of every entry
+  cf_t**    entries;     ///< Modulated sequence of every entry, NULL until it is used
+  uint64_t  nof_hits;
+  uint64_t  nof_misses;
+} srsran_sequence_rs_cache_t;
+
+/**
+ * @brief Initialises or reconfigures the cache, the entries are kept if the dimensions do not change
+ * @attention The object must be zeroed before the first initialization
+ */
+SRSRAN_API int
+srsran_sequence_rs_cache_init(srsran_sequence_rs_cache_t* q, uint32_t nof_slots, uint32_t nof_symbols, uint32_t len);
+
+SRSRAN_API void srsran_sequence_rs_cache_free(srsran_sequence_rs_cache_t* q);
+
+/**
+ * @brief Gets the modulated sequence for the given slot and symbol, len symbols long
+ * @return The sequence, valid until the seed of the same slot and symbol changes, or NULL if the inputs are invalid or
+ * the entry could not be allocated
+ */
+SRSRAN_API const cf_t*
+srsran_sequence_rs_cache_get(srsran_sequence_rs_cache_t* q, uint32_t slot_idx, uint32_t symbol_idx, uint32_t seed);
+
 SRSRAN_API int srsran_sequence_pbch(srsran_sequence_t* seq, srsran_cp_t cp, uint32_t cell_id);
 
 SRSRAN_API int srsran_sequence_pcfich(srsran_sequence_t* seq, uint32_t nslot, uint32_t cell_id);
@@ -126,6 +220,13 @@ SRSRAN_API void srsran_sequence_pdsch_apply_c(const int8_t* in,
                                               uint32_t      cell_id,
                                               uint32_t      len);
 
+SRSRAN_API const uint8_t* srsran_sequence_pdsch_cache_get(srsran_sequence_cache_t* cache,
+                                                          uint16_t                 rnti,
+                                                          int                      q,
+                                                          uint32_t                 nslot,
+                                                          uint32_t                 cell_id,
+                                                          uint32_t                 len);
+
 SRSRAN_API int
 srsran_sequence_pusch(srsran_sequence_t* seq, uint16_t rnti, uint32_t nslot, uint32_t cell_id, uint32_t len);
 
@@ -153,6 +254,12 @@ SRSRAN_API void srsran_sequence_pusch_apply_s(const int16_t* in,
 SRSRAN_API void
 srsran_sequence_pusch_gen_unpack(uint8_t* out, uint16_t rnti, uint32_t nslot, uint32_t cell_id, uint32_t len);
 
+SRSRAN_API const uint8_t* srsran_sequence_pusch_cache_get(srsran_sequence_cache_t* cache,
+                                                          uint16_t                 rnti,
+                                                          uint32_t                 nslot,
+                                                          uint32_t                 cell_id,
+                                                          uint32_t                 len);
+
 SRSRAN_API int srsran_sequence_pucch(srsran_sequence_t* seq, uint16_t rnti, uint32_t nslot, uint32_t cell_id);
 
 SRSRAN_API int srsran_sequence_pmch(srsran_sequence_t* seq, uint32_t nslot, uint32_t mbsfn_id, uint32_t len);
@@ -40,6 +40,11 @@
  *                norm   - Normalizes output (by sqrt(len) for complex, len for real).
  *                dc     - Handles insertion and removal of null DC carrier internally.
  *
+ *                Complex transforms are computed by the backend selected with
+ *                srsran_dft_set_backend() when the plan is created. FFTW is the
+ *                default, and the fallback for the sizes (or strides) a backend
+ *                does not support. Real transforms always use FFTW.
+ *
  *  Reference:
  *********************************************************************************************/
 
@@ -51,6 +56,12 @@ typedef enum { SRSRAN_DFT_COMPLEX, SRSRAN_REAL } srsran_dft_mode_t;
 
 typedef enum { SRSRAN_DFT_FORWARD, SRSRAN_DFT_BACKWARD } srsran_dft_dir_t;
 
+typedef enum {
+  SRSRAN_DFT_BACKEND_FFTW = 0, // FFTW library
+  SRSRAN_DFT_BACKEND_RADIX,    // Native mixed radix 2, 3, 4 and 5 SIMD engine
+  SRSRAN_DFT_BACKEND_NOF
+} srsran_dft_backend_t;
+
 typedef struct SRSRAN_API {
   int               init_size; // DFT length used in the first initialization
   int               size;      // DFT length
@@ -65,8 +76,32 @@ typedef struct SRSRAN_API {
   bool              dc;      // Handle insertion/removal of null DC carrier internally?
   srsran_dft_dir_t  dir;     // Forward/Backward
   srsran_dft_mode_t mode;    // Complex/Real
+
+  srsran_dft_backend_t backend; // Engine the plan p belongs to
+  cf_t*                guru_in; // Guru parameters, used by the backends other than FFTW
+  cf_t*                guru_out;
+  int                  guru_how_many;
+  int                  guru_idist;
+  int                  guru_odist;
 } srsran_dft_plan_t;
 
+/* Selects the backend for the complex plans created, or re-planned, from now on */
+SRSRAN_API void srsran_dft_set_backend(srsran_dft_backend_t backend);
+
+SRSRAN_API srsran_dft_backend_t srsran_dft_get_backend();
+
+SRSRAN_API const char* srsran_dft_backend_to_string(srsran_dft_backend_t backend);
+
+/* Parses "fftw" or "radix", returns SRSRAN_ERROR for unknown backends */
+SRSRAN_API int srsran_dft_backend_from_string(const char* str, srsran_dft_backend_t* backend);
+
+/* Imports FFTW wisdom from a file, e.g. one generated by the fftw_wisdom example. The system wisdom and
+ * ~/.srsran_fftwisdom are imported automatically when the library is loaded. */
+SRSRAN_API int srsran_dft_import_wisdom(const char* filename);
+
+/* Exports the FFTW wisdom accumulated so far to a file */
+SRSRAN_API int srsran_dft_export_wisdom(const char* filename);
+
 SRSRAN_API int srsran_dft_plan(srsran_dft_plan_t* plan, int dft_points, srsran_dft_dir_t dir, srsran_dft_mode_t type);
 
 SRSRAN_API int srsran_dft_plan_c(srsran_dft_plan_t* plan, int dft_points, srsran_dft_dir_t dir);
@@ -87,6 +87,7 @@ typedef struct SRSRAN_API {
   cf_t*             shift_buffer;
   cf_t*             window_offset_buffer;
   cf_t              phase_compensation[SRSRAN_MAX_NSYMB * SRSRAN_NOF_SLOTS_PER_SF];
+  float             rx_cfo; ///< CFO corrected at the DFT input, normalised by the sampling rate. Rx only
   srsran_cfr_t      tx_cfr; ///< Tx CFR object
 } srsran_ofdm_t;
 
@@ -130,6 +131,35 @@ SRSRAN_API void srsran_ofdm_rx_sf(srsran_ofdm_t* q);
 
 SRSRAN_API void srsran_ofdm_rx_sf_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output);
 
+/**
+ * @brief Demodulates a subframe of interleaved int16 I/Q samples (sc16) as delivered by the radio, into the configured
+ * output buffer
+ *
+ * The samples are converted to float as x / scale symbol by symbol at the FFT input, fused with the frequency shift,
+ * so the configured input buffer is not used and only a sc16 copy of the subframe needs to be kept in memory.
+ *
+ * @param q OFDM receiver object
+ * @param input Subframe samples, 2 x sf_sz int16 values
+ * @param scale Conversion scale, e.g. INT16_MAX for full scale samples
+ * @return SRSRAN_SUCCESS if the subframe is demodulated, SRSRAN_ERROR code otherwise (MBSFN is not supported)
+ */
+SRSRAN_API int srsran_ofdm_rx_sf_sc16(srsran_ofdm_t* q, const int16_t* input, float scale);
+
+/**
+ * @brief Demodulates a range of OFDM symbols of the subframe in the configured input buffer into the configured output
+ * buffer, the other symbols of the resource grid are not written
+ *
+ * It allows demodulating the control region first and the rest of the subframe only if it is needed. Unlike
+ * srsran_ofdm_rx_sf(), the input buffer is not modified, so the frequency shift and the CFO are applied on every
+ * symbol regardless of the symbols demodulated before.
+ *
+ * @param q OFDM receiver object
+ * @param first_symbol Index of the first symbol within the subframe
+ * @param nof_symbols Number of symbols to demodulate
+ * @return SRSRAN_SUCCESS if the symbols are demodulated, SRSRAN_ERROR code otherwise (MBSFN is not supported)
+ */
+SRSRAN_API int srsran_ofdm_rx_sf_symbols(srsran_ofdm_t* q, uint32_t first_symbol, uint32_t nof_symbols);
+
 SRSRAN_API int
 srsran_ofdm_tx_init(srsran_ofdm_t* q, srsran_cp_t cp_type, cf_t* in_buffer, cf_t* out_buffer, uint32_t nof_prb);
 
@@ -140,6 +170,18 @@ SRSRAN_API void srsran_ofdm_tx_free(srsran_ofdm_t* q);
 
 SRSRAN_API void srsran_ofdm_tx_sf(srsran_ofdm_t* q);
 
+/**
+ * @brief Modulates the OFDM symbols of the subframe selected by a mask, the samples of the other symbols are set to zero
+ *
+ * It is meant for subframes where most of the symbols are known to be empty, their inverse-DFT is skipped. The output
+ * is the same as srsran_ofdm_tx_sf() when the symbols left out of the mask are empty.
+ *
+ * @param q OFDM transmitter object
+ * @param symbol_mask Bit l selects the symbol l within the subframe
+ * @return SRSRAN_SUCCESS if the subframe is modulated, SRSRAN_ERROR code otherwise (MBSFN is not supported)
+ */
+SRSRAN_API int srsran_ofdm_tx_sf_symbols(srsran_ofdm_t* q, uint32_t symbol_mask);
+
 SRSRAN_API int srsran_ofdm_set_freq_shift(srsran_ofdm_t* q, float freq_shift);
 
 SRSRAN_API void srsran_ofdm_set_normalize(srsran_ofdm_t* q, bool normalize_enable);
@@ -150,4 +192,18 @@ SRSRAN_API void srsran_ofdm_set_non_mbsfn_region(srsran_ofdm_t* q, uint8_t non_m
 
 SRSRAN_API int srsran_ofdm_set_cfr(srsran_ofdm_t* q, srsran_cfr_cfg_t* cfr);
 
+/**
+ * @brief Sets the CFO the OFDM receiver corrects from the next subframe, with the phase origin at the first sample of
+ * the subframe
+ *
+ * The rotation is applied to the DFT windows only, right before each DFT, so the cyclic prefixes are skipped and the
+ * samples are rotated while they are in cache. The phase of each window start is folded into the DFT output scaling.
+ * In the sc16 demodulator the rotation is fused with the int16 conversion of each symbol. As with the frequency shift,
+ * the float input buffer is modified in place.
+ *
+ * @param q OFDM receiver object
+ * @param cfo Frequency offset normalised by the sampling rate, set to 0 to disable
+ */
+SRSRAN_API void srsran_ofdm_set_rx_cfo(srsran_ofdm_t* q, float cfo);
+
 #endif // SRSRAN_OFDM_H
@@ -89,6 +89,20 @@ typedef struct SRSRAN_API {
   uint32_t              nof_common_locations[3];
   srsran_dci_location_t common_locations[3][SRSRAN_MAX_CANDIDATES_COM];
 
+  // Resource grid templates of the normal subframes with the signals that only depend on the cell and the subframe
+  // index (PSS/SSS and CRS), they are generated on first use and copied at the start of every subframe
+  cf_t*               sf_template[SRSRAN_NOF_SF_X_FRAME][SRSRAN_MAX_PORTS];
+  bool                template_valid[SRSRAN_NOF_SF_X_FRAME];
+  srsran_tdd_config_t template_tdd_config[SRSRAN_NOF_SF_X_FRAME]; ///< TDD configuration the template was built with
+  uint32_t            template_symbol_mask[SRSRAN_NOF_SF_X_FRAME]; ///< Symbols with any signal in the template
+
+  // Time domain signal of the template symbols, each symbol is modulated the first time it is transmitted without any
+  // other channel and reused afterwards
+  cf_t*    template_signal[SRSRAN_NOF_SF_X_FRAME][SRSRAN_MAX_PORTS];
+  uint32_t template_signal_mask[SRSRAN_NOF_SF_X_FRAME]; ///< Template symbols with a valid time domain signal
+
+  uint32_t sf_symbol_mask; ///< Symbols of the current subframe with other signals than the template
+
 } srsran_enb_dl_t;
 
 typedef struct {
@@ -108,6 +122,13 @@ SRSRAN_API int srsran_enb_dl_set_cfr(srsran_enb_dl_t* q, const srsran_cfr_cfg_t*
 
 SRSRAN_API bool srsran_enb_dl_location_is_common_ncce(srsran_enb_dl_t* q, const srsran_dci_location_t* loc);
 
+/**
+ * Puts the base signals of the subframe into the resource grid: PSS/SSS, reference signals, PBCH and PCFICH. The
+ * PSS/SSS and CRS of normal subframes are copied from a per subframe index template.
+ *
+ * srsran_enb_dl_gen_signal() tracks the symbols where other channels are put afterwards. Symbols without any signal
+ * are not modulated, and the ones with only the template reuse its cached time domain signal.
+ */
 SRSRAN_API void srsran_enb_dl_put_base(srsran_enb_dl_t* q, srsran_dl_sf_cfg_t* dl_sf);
 
 SRSRAN_API void srsran_enb_dl_put_phich(srsran_enb_dl_t* q, srsran_phich_grant_t* grant, bool ack);
@@ -116,11 +137,27 @@ SRSRAN_API int srsran_enb_dl_put_pdcch_dl(srsran_enb_dl_t* q, srsran_dci_cfg_t*
 
 SRSRAN_API int srsran_enb_dl_put_pdcch_ul(srsran_enb_dl_t* q, srsran_dci_cfg_t* dci_cfg, srsran_dci_ul_t* dci_ul);
 
+/**
+ * Shares the channel coding of the broadcast PDSCH with the other cells using the same cache, see
+ * srsran_pdsch_set_tb_cache()
+ */
+SRSRAN_API void srsran_enb_dl_set_tb_cache(srsran_enb_dl_t* q, srsran_pdsch_tb_cache_t* cache);
+
 SRSRAN_API int
 srsran_enb_dl_put_pdsch(srsran_enb_dl_t* q, srsran_pdsch_cfg_t* pdsch, uint8_t* data[SRSRAN_MAX_CODEWORDS]);
 
 SRSRAN_API int srsran_enb_dl_put_pmch(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, uint8_t* data);
 
+/**
+ * Encodes the PMCH without mapping it, the returned symbols stay valid until the next PMCH encoding of this object. All
+ * the cells of one MBSFN area transmit the same PMCH, so it is encoded once and mapped to each cell after
+ * srsran_enb_dl_put_base() with srsran_enb_dl_put_pmch_symbols()
+ */
+SRSRAN_API const cf_t*
+srsran_enb_dl_encode_pmch(srsran_enb_dl_t* q, srsran_dl_sf_cfg_t* dl_sf, srsran_pmch_cfg_t* pmch_cfg, uint8_t* data);
+
+SRSRAN_API int srsran_enb_dl_put_pmch_symbols(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, const cf_t* symbols);
+
 SRSRAN_API void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q);
 
 SRSRAN_API bool srsran_enb_dl_gen_cqi_periodic(const srsran_cell_t*   cell,
@@ -49,6 +49,8 @@
 
 #include "srsran/config.h"
 
+#define SRSRAN_ENB_UL_PUCCH_BATCH_MAX_RES 256
+
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
 
@@ -61,6 +63,12 @@ typedef struct SRSRAN_API {
   srsran_pusch_t    pusch;
   srsran_pucch_t    pucch;
 
+  // Batched PUCCH detection
+  srsran_pucch_cfg_t* pucch_batch_cfg;
+  srsran_pucch_res_t* pucch_batch_res;
+  uint32_t            pucch_batch_ue[SRSRAN_ENB_UL_PUCCH_BATCH_MAX_RES];
+  uint32_t            pucch_batch_res_idx[SRSRAN_ENB_UL_PUCCH_BATCH_MAX_RES];
+
 } srsran_enb_ul_t;
 
 /* This function shall be called just after the initial synchronization */
@@ -80,9 +88,39 @@ SRSRAN_API int srsran_enb_ul_get_pucch(srsran_enb_ul_t*    q,
                                        srsran_pucch_cfg_t* cfg,
                                        srsran_pucch_res_t* res);
 
+/**
+ * @brief Decodes the PUCCH of several UE in the same subframe
+ *
+ * The PUCCH format 1, 1a and 1b resources of all configurations, including the channel selection and SR alternatives,
+ * are detected in a single batch with srsran_pucch_decode_format1_batch(). Configurations selecting other formats, or
+ * that do not fit in the batch, are decoded with srsran_enb_ul_get_pucch(). The result of cfg[i] is written in res[i]
+ * and cfg[i] is updated as srsran_enb_ul_get_pucch() does. A configuration that cannot be decoded is reported as not
+ * detected without stopping the rest.
+ *
+ * @param q eNb uplink object
+ * @param ul_sf Uplink subframe configuration
+ * @param cfg Array of nof_cfg PUCCH configurations
+ * @param res Array of nof_cfg PUCCH results
+ * @param nof_cfg Number of configurations
+ * @return SRSRAN_SUCCESS if the batch is decoded, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_enb_ul_get_pucch_batch(srsran_enb_ul_t*    q,
+                                             srsran_ul_sf_cfg_t* ul_sf,
+                                             srsran_pucch_cfg_t* cfg,
+                                             srsran_pucch_res_t* res,
+                                             uint32_t            nof_cfg);
+
 SRSRAN_API int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
                                        srsran_ul_sf_cfg_t* ul_sf,
                                        srsran_pusch_cfg_t* cfg,
                                        srsran_pusch_res_t* res);
 
+/* Same as srsran_enb_ul_get_pusch() but reads the resource grid of another object, so that several objects can decode
+ * the PUSCH of different users of the same subframe concurrently. The grid is not modified. */
+SRSRAN_API int srsran_enb_ul_get_pusch_grid(srsran_enb_ul_t*    q,
+                                            cf_t*               sf_symbols,
+                                            srsran_ul_sf_cfg_t* ul_sf,
+                                            srsran_pusch_cfg_t* cfg,
+                                            srsran_pusch_res_t* res);
+
 #endif // SRSRAN_ENB_UL_H
@@ -36,6 +36,63 @@
  */
 #define SRSRAN_FEC_BLOCK_SIZE 32U
 
+/**
+ * @brief Maximum number of bits of the block codes decoded by srsran_block_rm_decode()
+ */
+#define SRSRAN_FEC_BLOCK_RM_MAX_NOF_BITS 13U
+
+/**
+ * @brief Number of combinations of the basis sequences that are not part of the first order Reed–Muller code
+ */
+#define SRSRAN_FEC_BLOCK_RM_NOF_MASKS (1U << (SRSRAN_FEC_BLOCK_RM_MAX_NOF_BITS - 6U))
+
+/**
+ * @brief Maximum likelihood decoder for the block codes whose first basis sequence is all ones and the next five are
+ * the linear part of a first order Reed–Muller code, such as the (32, O) and (20, A) codes of 3GPP 36.212. For every
+ * combination of the remaining basis sequences, the correlation with all the codewords is computed at once with a
+ * 32-point fast Walsh–Hadamard transform.
+ */
+typedef struct SRSRAN_API {
+  int32_t  bin_sign[32][SRSRAN_FEC_BLOCK_RM_NOF_MASKS]; ///< Sign mask (0 or -1) of each transform bin for each mask
+  int32_t  bin_row[32];                                 ///< Codeword bit of each transform bin, -1 if none
+  uint32_t nof_rows;                                    ///< Codeword length, up to 32 bits
+  uint32_t nof_bits;                                    ///< Maximum number of data bits
+  bool     msb_first; ///< Ties are resolved to the lowest word taking the first data bit as the most significant
+} srsran_block_rm_t;
+
+/**
+ * @brief Initialises the maximum likelihood decoder of a block code.
+ *
+ * @remark The object shall be aligned to SRSRAN_SIMD_BIT_ALIGN, the transform uses aligned SIMD loads.
+ *
+ * @param[out] q Decoder object
+ * @param[in] basis_seq Basis sequences, the bit n of the entry i is the element M(i, n)
+ * @param[in] nof_rows Codeword length, up to 32
+ * @param[in] nof_bits Maximum number of data bits, up to SRSRAN_FEC_BLOCK_RM_MAX_NOF_BITS
+ * @param[in] msb_first Set to true to resolve ties as a search in which the first data bit is the most significant
+ * @return SRSRAN_SUCCESS if the basis sequences have the expected structure, otherwise SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_block_rm_init(srsran_block_rm_t* q,
+                                    const uint16_t*    basis_seq,
+                                    uint32_t           nof_rows,
+                                    uint32_t           nof_bits,
+                                    bool               msb_first);
+
+/**
+ * @brief Decodes a block code word, returns the same word and correlation as correlating the LLRs with every codeword
+ * and keeping the maximum.
+ *
+ * @param[in] q Decoder object
+ * @param[in] llr Provides nof_rows received LLRs
+ * @param[out] data Data destination to store the data_len unpacked received bits
+ * @param[in] data_len Number of bits to decode
+ * @return The correlation of the decoded word
+ */
+SRSRAN_API int32_t srsran_block_rm_decode(const srsran_block_rm_t* q,
+                                          const int16_t*           llr,
+                                          uint8_t*                 data,
+                                          uint32_t                 data_len);
+
 /**
  * @brief Encodes unpacked data using Reed–Muller code block channel coding.
  *
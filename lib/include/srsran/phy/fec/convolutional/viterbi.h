@@ -36,6 +36,9 @@
 
 typedef enum { SRSRAN_VITERBI_27 = 0, SRSRAN_VITERBI_29, SRSRAN_VITERBI_37, SRSRAN_VITERBI_39 } srsran_viterbi_type_t;
 
+/* Maximum number of frames the decoder processes together in srsran_viterbi_decode_f_multi() */
+#define SRSRAN_VITERBI_MAX_MULTI 4
+
 typedef struct SRSRAN_API {
   void*    ptr;
   uint32_t R;
@@ -47,11 +50,13 @@ typedef struct SRSRAN_API {
   int (*decode)(void*, uint8_t*, uint8_t*, uint32_t);
   int (*decode_s)(void*, uint16_t*, uint8_t*, uint32_t);
   int (*decode_f)(void*, float*, uint8_t*, uint32_t);
+  int (*decode_s_multi)(void*, uint16_t**, uint8_t**, uint32_t, uint32_t);
   void (*free)(void*);
   uint8_t*  tmp;
   uint16_t* tmp_s;
   uint8_t*  symbols_uc;
   uint16_t* symbols_us;
+  void*     ptr_multi[SRSRAN_VITERBI_MAX_MULTI]; // Decoder instances of decode_s_multi, ptr_multi[0] is ptr
 } srsran_viterbi_t;
 
 SRSRAN_API int srsran_viterbi_init(srsran_viterbi_t*     q,
@@ -70,6 +75,14 @@ SRSRAN_API int srsran_viterbi_decode_f(srsran_viterbi_t* q, float* symbols, uint
 
 SRSRAN_API int srsran_viterbi_decode_s(srsran_viterbi_t* q, int16_t* symbols, uint8_t* data, uint32_t frame_length);
 
+/* Decodes nof_frames frames of the same length, symbols[i] is decoded into data[i]. The decoders that support it
+ * (AVX512) interleave the recursions of up to SRSRAN_VITERBI_MAX_MULTI frames, the others decode them one by one. */
+SRSRAN_API int srsran_viterbi_decode_f_multi(srsran_viterbi_t* q,
+                                             float**           symbols,
+                                             uint8_t**         data,
+                                             uint32_t          nof_frames,
+                                             uint32_t          frame_length);
+
 SRSRAN_API int srsran_viterbi_decode_us(srsran_viterbi_t* q, uint16_t* symbols, uint8_t* data, uint32_t frame_length);
 
 SRSRAN_API int srsran_viterbi_decode_uc(srsran_viterbi_t* q, uint8_t* symbols, uint8_t* data, uint32_t frame_length);
@@ -92,4 +105,10 @@ SRSRAN_API int srsran_viterbi_init_avx2(srsran_viterbi_t*     q,
                                         uint32_t              max_frame_length,
                                         bool                  tail_bitting);
 
+SRSRAN_API int srsran_viterbi_init_avx512(srsran_viterbi_t*     q,
+                                          srsran_viterbi_type_t type,
+                                          int                   poly[3],
+                                          uint32_t              max_frame_length,
+                                          bool                  tail_bitting);
+
 #endif // SRSRAN_VITERBI_H
@@ -26,6 +26,11 @@
  *                LTE requires CRC lengths 8, 16, 24A and 24B, each with it's own generator
  *                polynomial.
  *
+ *                Long messages are folded 128 bits at a time with carry-less multiplications
+ *                (PCLMULQDQ on x86, PMULL on ARMv8 with the crypto extension) and the byte
+ *                table only processes the folded remainder. Without them, the byte table
+ *                processes all the message.
+ *
  *  Reference:    3GPP TS 36.212 version 10.0.0 Release 10 Sec. 5.1.1
  *********************************************************************************************/
 
@@ -44,6 +49,7 @@ typedef struct SRSRAN_API {
   uint64_t crcmask;
   uint64_t crchighbit;
   uint32_t srsran_crc_out;
+  uint64_t clmul_k[4]; // Folding constants x^576, x^512, x^192 and x^128 modulo polynom, for the carry-less multiply
 } srsran_crc_t;
 
 SRSRAN_API int srsran_crc_init(srsran_crc_t* h, uint32_t srsran_crc_poly, int srsran_crc_order);
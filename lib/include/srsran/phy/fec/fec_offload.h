@@ -0,0 +1,151 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         fec_offload.h
+ *
+ *  Description:  Look-aside FEC offload. The PHY enqueues code block
+ *                operations and polls their completions, so that the FEC runs
+ *                on an accelerator (or other CPU cores) while the PHY carries
+ *                on with other processing.
+ *
+ *                The operations follow the DPDK BBDev model: an LDPC decode
+ *                operation takes the rate matched LLRs of a code block and its
+ *                HARQ soft buffer, and runs the rate dematching, the soft
+ *                combining, the decoding and the CRC check. Operations may
+ *                complete out of order, they carry an opaque pointer for the
+ *                caller to match them.
+ *
+ *                An offload object is one queue, it shall not be used by
+ *                several threads at the same time.
+ *
+ *                Backends:
+ *                - CPU: reference implementation with the srsRAN decoders, run
+ *                  by a pool of worker threads. Without workers the operations
+ *                  run in the thread polling the completions.
+ *                - BBDev: DPDK BBDev devices, requires srsRAN built with
+ *                  ENABLE_BBDEV.
+ *
+ *  Reference:    DPDK Programmer's Guide, Wireless Baseband Device Library
+ *****************************************************************************/
+
+#ifndef SRSRAN_FEC_OFFLOAD_H
+#define SRSRAN_FEC_OFFLOAD_H
+
+#include "srsran/config.h"
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/fec/ldpc/base_graph.h"
+#include "srsran/phy/fec/ldpc/ldpc_decoder.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SRSRAN_FEC_OFFLOAD_MAX_WORKERS 16
+
+typedef enum SRSRAN_API {
+  SRSRAN_FEC_OFFLOAD_CPU = 0,
+  SRSRAN_FEC_OFFLOAD_BBDEV,
+} srsran_fec_offload_backend_t;
+
+/**
+ * @brief Code block CRC checked by the decoder for early stop
+ */
+typedef enum SRSRAN_API {
+  SRSRAN_FEC_OFFLOAD_CRC_NONE = 0,
+  SRSRAN_FEC_OFFLOAD_CRC_16,
+  SRSRAN_FEC_OFFLOAD_CRC_24A,
+  SRSRAN_FEC_OFFLOAD_CRC_24B,
+  SRSRAN_FEC_OFFLOAD_NOF_CRC,
+} srsran_fec_offload_crc_t;
+
+typedef struct SRSRAN_API {
+  srsran_fec_offload_backend_t backend;
+  uint32_t                     queue_size;  ///< Maximum number of operations in flight
+  uint32_t                     nof_workers; ///< CPU backend threads, 0 runs the operations when polling
+  srsran_ldpc_decoder_type_t   ldpc_decoder_type;    ///< CPU backend LDPC decoder
+  float                        ldpc_scaling_factor;  ///< CPU backend normalized min-sum scaling factor
+  uint32_t                     ldpc_max_nof_iter;    ///< Maximum number of LDPC iterations
+  uint16_t                     bbdev_dev_id;         ///< BBDev device
+  uint16_t                     bbdev_queue_id;       ///< BBDev queue of the device used by this object
+} srsran_fec_offload_args_t;
+
+/**
+ * @brief LDPC decoding of one code block, TS 38.212 5.4.2 rate dematching followed by the decoding
+ */
+typedef struct SRSRAN_API {
+  // Code block
+  srsran_basegraph_t       bg;   ///< Base graph
+  uint16_t                 ls;   ///< Lifting size
+  uint32_t                 F;    ///< Number of filler bits
+  uint32_t                 Nref; ///< Limited buffer rate matching size
+  uint32_t                 rv;   ///< Redundancy version
+  srsran_mod_t             mod;  ///< Modulation
+  uint32_t                 E;    ///< Number of rate matched LLRs
+  srsran_fec_offload_crc_t crc;  ///< CRC attached to the code block
+
+  const int8_t* llr;         ///< E rate matched LLRs
+  int8_t*       harq_buffer; ///< Soft combining buffer, kept by the caller between retransmissions
+  uint8_t*      output;      ///< Packed decoded bits
+  uint32_t      nof_bits;    ///< Number of decoded bits written in output
+
+  // Result
+  int      status;   ///< SRSRAN_SUCCESS or an error code
+  bool     crc_ok;   ///< The CRC matched, always true without CRC
+  uint32_t nof_iter; ///< Number of decoder iterations
+
+  void* opaque; ///< Left untouched for the caller
+} srsran_fec_offload_ldpc_dec_op_t;
+
+typedef struct SRSRAN_API {
+  const void* dev;
+  void*       handler;
+} srsran_fec_offload_t;
+
+SRSRAN_API int srsran_fec_offload_init(srsran_fec_offload_t* q, const srsran_fec_offload_args_t* args);
+
+SRSRAN_API void srsran_fec_offload_free(srsran_fec_offload_t* q);
+
+SRSRAN_API const char* srsran_fec_offload_name(const srsran_fec_offload_t* q);
+
+/**
+ * @brief Enqueues LDPC decode operations. The operations and their buffers shall be valid until dequeued
+ * @return The number of operations accepted, less than nof_ops when the queue is full
+ */
+SRSRAN_API uint32_t srsran_fec_offload_enqueue_ldpc_dec(srsran_fec_offload_t*              q,
+                                                        srsran_fec_offload_ldpc_dec_op_t** ops,
+                                                        uint32_t                           nof_ops);
+
+/**
+ * @brief Polls for completed LDPC decode operations
+ * @return The number of completed operations written in ops, up to max_nof_ops
+ */
+SRSRAN_API uint32_t srsran_fec_offload_dequeue_ldpc_dec(srsran_fec_offload_t*              q,
+                                                        srsran_fec_offload_ldpc_dec_op_t** ops,
+                                                        uint32_t                           max_nof_ops);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_FEC_OFFLOAD_H
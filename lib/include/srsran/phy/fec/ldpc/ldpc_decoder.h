@@ -99,8 +99,28 @@ typedef struct SRSRAN_API {
                   uint8_t*,
                   uint32_t,
                   srsran_crc_t*); /*!< \brief Pointer to the decoding function (16-bit version). */
+
+  void* (*create_state)(void*); /*!< \brief Pointer to the allocator of an independent set of decoder registers. */
+  void (*free_state)(void*);    /*!< \brief Pointer to the "destructor" of a set of decoder registers. */
+  int (*start_c)(void*,
+                 void*,
+                 const int8_t*,
+                 uint32_t); /*!< \brief Pointer to the function loading a codeword into a set of registers. */
+  void (*iterate_c)(void*, void*, uint8_t); /*!< \brief Pointer to the function running one decoder iteration. */
+  int (*extract_c)(void*, uint8_t*, uint16_t); /*!< \brief Pointer to the message extraction function. */
 } srsran_ldpc_decoder_t;
 
+/*!
+ * \brief Describes the decoding state of one codeword, so that several codewords can be decoded iteration by
+ * iteration with the same decoder.
+ */
+typedef struct SRSRAN_API {
+  srsran_ldpc_decoder_t* decoder;  /*!< \brief Decoder this state belongs to (sets base graph and lifting size). */
+  void*                  ptr;      /*!< \brief Registers of the decoder for this codeword. */
+  uint8_t                n_layers; /*!< \brief Number of layers of the current codeword. */
+  uint32_t               nof_iter; /*!< \brief Number of iterations run on the current codeword. */
+} srsran_ldpc_decoder_state_t;
+
 /*!
  * Initializes all the LDPC decoder variables according to the given base graph
  * and lifting size.
@@ -179,4 +199,40 @@ SRSRAN_API int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
                                                 uint32_t               cdwd_rm_length,
                                                 srsran_crc_t*          crc);
 
+/*!
+ * Allocates an independent decoding state for the given decoder. Only available for the 8-bit decoders.
+ * \param[out] s A pointer to the state.
+ * \param[in]  q A pointer to an initialized LDPC decoder.
+ * \return SRSRAN_SUCCESS if the state was created, SRSRAN_ERROR otherwise.
+ */
+SRSRAN_API int srsran_ldpc_decoder_state_init(srsran_ldpc_decoder_state_t* s, srsran_ldpc_decoder_t* q);
+
+/*!
+ * Frees the registers of a decoding state. It must be called before freeing the decoder of the state.
+ * \param[in] s A pointer to the state.
+ */
+SRSRAN_API void srsran_ldpc_decoder_state_free(srsran_ldpc_decoder_state_t* s);
+
+/*!
+ * Loads a new codeword with 8-bit integer-valued LLRs into a decoding state, no iteration is run.
+ * \param[in,out] s A pointer to the state.
+ * \param[in] llrs The LLRs of the codeword to be decoded.
+ * \param[in] cdwd_rm_length The number of bits forming the codeword (after rate matching).
+ * \return SRSRAN_SUCCESS, or SRSRAN_ERROR if the state is not valid.
+ */
+SRSRAN_API int srsran_ldpc_decoder_state_start_c(srsran_ldpc_decoder_state_t* s,
+                                                 const int8_t*                llrs,
+                                                 uint32_t                     cdwd_rm_length);
+
+/*!
+ * Runs one decoder iteration on a decoding state and extracts the message.
+ * \param[in,out] s A pointer to the state.
+ * \param[out] message The message (uncoded bits) after this iteration.
+ * \param[in] crc Code-block CRC object for early stop. Set for NULL to disable check.
+ * \return -1 if an error occurred, 1 if the CRC matched (or no CRC is given) and 0 otherwise.
+ */
+SRSRAN_API int srsran_ldpc_decoder_state_iterate_crc_c(srsran_ldpc_decoder_state_t* s,
+                                                       uint8_t*                     message,
+                                                       srsran_crc_t*                crc);
+
 #endif // SRSRAN_LDPCDECODER_H
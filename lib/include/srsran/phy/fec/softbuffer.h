@@ -45,8 +45,20 @@ typedef struct SRSRAN_API {
   uint8_t** data;
   bool*     cb_crc;
   bool      tb_crc;
+  bool      llr_is_8bit; ///< buffer_f points to buffers of max_cb_size 8-bit soft bits
+  bool      lazy_alloc;  ///< The code block buffers are allocated when they are reset for a transmission
 } srsran_softbuffer_rx_t;
 
+/**
+ * @brief Rx soft-buffer initialisation arguments
+ */
+typedef struct SRSRAN_API {
+  uint32_t max_cb;      ///< Maximum number of code blocks
+  uint32_t max_cb_size; ///< Code block size in soft bits
+  bool     llr_is_8bit; ///< Stores 8-bit soft bits, halving the memory. Only valid for the 8-bit LLR decoders
+  bool     lazy_alloc;  ///< Allocates each code block buffer the first time it is reset for a transmission
+} srsran_softbuffer_rx_args_t;
+
 typedef struct SRSRAN_API {
   uint32_t  max_cb;
   uint32_t  max_cb_size;
@@ -55,6 +67,13 @@ typedef struct SRSRAN_API {
 
 #define SOFTBUFFER_SIZE 18600
 
+/**
+ * @brief Computes the maximum number of code blocks of a transport block for a number of PRB
+ * @param nof_prb The number of PRB
+ * @return The number of code blocks, SRSRAN_ERROR if the number of PRB is not valid
+ */
+SRSRAN_API int srsran_softbuffer_max_cb(uint32_t nof_prb);
+
 SRSRAN_API int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof_prb);
 
 /**
@@ -67,6 +86,24 @@ SRSRAN_API int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof
  */
 SRSRAN_API int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size);
 
+/**
+ * @brief Initialises Rx soft-buffer with the storage options given in the arguments
+ * @note With lazy allocation, srsran_softbuffer_rx_reset_tbs() or srsran_softbuffer_rx_reset_cb() must be called
+ * before receiving a new transmission, they allocate the code block buffers it needs
+ * @param q The Rx soft-buffer pointer
+ * @param args The initialisation arguments
+ * @return It returns SRSRAN_SUCCESS if it initialises the soft-buffer successfully, otherwise it returns SRSRAN_ERROR
+ * code
+ */
+SRSRAN_API int srsran_softbuffer_rx_init_args(srsran_softbuffer_rx_t* q, const srsran_softbuffer_rx_args_t* args);
+
+/**
+ * @brief Frees the code block buffers of a lazily allocated Rx soft-buffer, they are allocated again the next time
+ * they are reset for a transmission. It does nothing for the other soft-buffers.
+ * @param q The Rx soft-buffer pointer
+ */
+SRSRAN_API void srsran_softbuffer_rx_free_cb(srsran_softbuffer_rx_t* q);
+
 SRSRAN_API void srsran_softbuffer_rx_reset(srsran_softbuffer_rx_t* p);
 
 SRSRAN_API void srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs);
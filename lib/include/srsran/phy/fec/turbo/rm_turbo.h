@@ -64,6 +64,18 @@ SRSRAN_API int srsran_rm_turbo_tx_lut(uint8_t* w_buff,
                                       uint32_t w_offset,
                                       uint32_t rv_idx);
 
+/* Sub-block interleaving and bit collection of a coded block into the circular buffer w_buff (5.1.4.1.1), it is the
+ * first step of srsran_rm_turbo_tx_lut() with rv_idx=0 */
+SRSRAN_API int srsran_rm_turbo_tx_lut_fill(uint8_t* w_buff, uint8_t* systematic, uint8_t* parity, uint32_t cb_idx);
+
+/* Bit selection of out_len bits from the circular buffer w_buff (5.1.4.1.2), filled before for any rv_idx */
+SRSRAN_API int srsran_rm_turbo_tx_lut_select(uint8_t* w_buff,
+                                             uint8_t* output,
+                                             uint32_t cb_idx,
+                                             uint32_t out_len,
+                                             uint32_t w_offset,
+                                             uint32_t rv_idx);
+
 SRSRAN_API int srsran_rm_turbo_rx(float*   w_buff,
                                   uint32_t buff_len,
                                   float*   input,
@@ -0,0 +1,89 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**********************************************************************************************
+ *  File:         turbodecoder_batch.h
+ *
+ *  Description:  Batched Turbo Decoder.
+ *                Decodes several code blocks of the same length at once, each code block in
+ *                one lane of a SIMD register (inter-block vectorization). Unlike the windowed
+ *                decoders, every lane runs the full MAX-LOG-MAP recursion of one code block,
+ *                so the lanes are kept busy regardless of the code block length.
+ *
+ *  Reference:    3GPP TS 36.212 version 10.0.0 Release 10 Sec. 5.1.3.2
+ *********************************************************************************************/
+
+#ifndef SRSRAN_TURBODECODER_BATCH_H
+#define SRSRAN_TURBODECODER_BATCH_H
+
+#include "srsran/config.h"
+#include "srsran/phy/fec/turbo/tc_interl.h"
+#include "srsran/phy/fec/turbo/turbodecoder.h"
+
+// Maximum number of code blocks in a batch for any SIMD width
+#define SRSRAN_TDEC_BATCH_MAX_NOF_CB 32
+
+typedef struct SRSRAN_API {
+  uint32_t max_long_cb;
+  uint32_t nof_lanes;
+
+  uint32_t current_long_cb;
+  uint32_t current_nof_cb;
+  int      n_iter;
+
+  // All buffers are interleaved across lanes: sample k of code block l is in position k * nof_lanes + l
+  int16_t* syst;
+  int16_t* parity0;
+  int16_t* parity1;
+  int16_t* app1;
+  int16_t* app2;
+  int16_t* ext1;
+  int16_t* ext2;
+  int16_t* beta;
+
+  srsran_tc_interl_t interleaver;
+} srsran_tdec_batch_t;
+
+SRSRAN_API int srsran_tdec_batch_init(srsran_tdec_batch_t* q, uint32_t max_long_cb);
+
+SRSRAN_API void srsran_tdec_batch_free(srsran_tdec_batch_t* q);
+
+/* Returns the maximum number of code blocks decoded in parallel, 0 if not supported by the instruction set */
+SRSRAN_API uint32_t srsran_tdec_batch_max_nof_cb(srsran_tdec_batch_t* q);
+
+/* Loads nof_cb code blocks of length long_cb. Input is in the non sub-block format (see srsran_rm_turbo_rx_lut_) */
+SRSRAN_API int srsran_tdec_batch_new_cb(srsran_tdec_batch_t* q, int16_t** input, uint32_t nof_cb, uint32_t long_cb);
+
+SRSRAN_API void srsran_tdec_batch_iteration(srsran_tdec_batch_t* q);
+
+/* Writes the hard decision of every code block in the batch to output[cb_idx], NULL entries are skipped */
+SRSRAN_API void srsran_tdec_batch_decision_byte(srsran_tdec_batch_t* q, uint8_t** output);
+
+SRSRAN_API int srsran_tdec_batch_run_all(srsran_tdec_batch_t* q,
+                                         int16_t**            input,
+                                         uint8_t**            output,
+                                         uint32_t             nof_cb,
+                                         uint32_t             nof_iterations,
+                                         uint32_t             long_cb);
+
+SRSRAN_API int srsran_tdec_batch_get_nof_iterations(srsran_tdec_batch_t* q);
+
+#endif // SRSRAN_TURBODECODER_BATCH_H
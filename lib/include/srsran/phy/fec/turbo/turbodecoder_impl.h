@@ -32,8 +32,10 @@ typedef enum SRSRAN_API {
   SRSRAN_TDEC_SSE_WINDOW,
   SRSRAN_TDEC_NEON_WINDOW,
   SRSRAN_TDEC_AVX_WINDOW,
+  SRSRAN_TDEC_AVX512_WINDOW,
   SRSRAN_TDEC_SSE8_WINDOW,
   SRSRAN_TDEC_AVX8_WINDOW,
+  SRSRAN_TDEC_AVX512_8_WINDOW,
   SRSRAN_TDEC_NOF_IMP
 } srsran_tdec_impl_type_t;
 
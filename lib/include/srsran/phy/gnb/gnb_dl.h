@@ -37,6 +37,7 @@ typedef struct SRSRAN_API {
   uint32_t                    nof_max_prb; ///< Maximum number of allocated RB
   double                      srate_hz;    ///< Fix sampling rate, set to 0 for minimum to fit nof_max_prb
   srsran_subcarrier_spacing_t scs;
+  uint32_t                    nof_pdsch_encoders; ///< PDSCH encoded at the same time, 0 or 1 for a single encoder
 } srsran_gnb_dl_args_t;
 
 typedef struct SRSRAN_API {
@@ -53,6 +54,9 @@ typedef struct SRSRAN_API {
   srsran_pdsch_nr_t pdsch;
   srsran_dmrs_sch_t dmrs;
 
+  srsran_pdsch_nr_t* pdsch_enc;     ///< Encoders other than pdsch, indexed from 1
+  uint32_t           nof_pdsch_enc; ///< Number of PDSCH encoders, including pdsch
+
   srsran_dci_nr_t   dci; ///< Stores DCI configuration
   srsran_pdcch_nr_t pdcch;
   srsran_ssb_t      ssb;
@@ -87,11 +91,35 @@ SRSRAN_API int srsran_gnb_dl_pdsch_put(srsran_gnb_dl_t*           q,
                                        const srsran_sch_cfg_nr_t* cfg,
                                        uint8_t*                   data[SRSRAN_MAX_TB]);
 
+/**
+ * @brief Puts the PDSCH DMRS of a grant in the resource grid. It shares state with the other DL channels, so it is
+ * called from the thread that owns the gNb DL object
+ */
+SRSRAN_API int
+srsran_gnb_dl_pdsch_put_dmrs(srsran_gnb_dl_t* q, const srsran_slot_cfg_t* slot, const srsran_sch_cfg_nr_t* cfg);
+
+/**
+ * @brief Encodes a PDSCH with the given encoder and maps it to the REs of its grant. Different encoders can be used
+ * concurrently, as long as the grants do not overlap. The DMRS is put separately by srsran_gnb_dl_pdsch_put_dmrs()
+ * @param enc_idx Encoder index, lower than nof_pdsch_enc
+ */
+SRSRAN_API int srsran_gnb_dl_pdsch_encode(srsran_gnb_dl_t*           q,
+                                          uint32_t                   enc_idx,
+                                          const srsran_sch_cfg_nr_t* cfg,
+                                          uint8_t*                   data[SRSRAN_MAX_TB]);
+
 SRSRAN_API float srsran_gnb_dl_get_maximum_signal_power_dBfs(uint32_t nof_prb);
 
 SRSRAN_API int
 srsran_gnb_dl_pdsch_info(const srsran_gnb_dl_t* q, const srsran_sch_cfg_nr_t* cfg, char* str, uint32_t str_len);
 
+/// Same as srsran_gnb_dl_pdsch_info() for a PDSCH encoded by srsran_gnb_dl_pdsch_encode() with the encoder enc_idx
+SRSRAN_API int srsran_gnb_dl_pdsch_enc_info(const srsran_gnb_dl_t*     q,
+                                            uint32_t                   enc_idx,
+                                            const srsran_sch_cfg_nr_t* cfg,
+                                            char*                      str,
+                                            uint32_t                   str_len);
+
 SRSRAN_API int
 srsran_gnb_dl_pdcch_dl_info(const srsran_gnb_dl_t* q, const srsran_dci_dl_nr_t* dci, char* str, uint32_t str_len);
 
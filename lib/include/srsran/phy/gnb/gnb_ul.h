@@ -31,6 +31,7 @@ typedef struct SRSRAN_API {
   srsran_pusch_nr_args_t pusch;
   srsran_pucch_nr_args_t pucch;
   float                  pusch_min_snr_dB; ///< Minimum SNR threshold to decode PUSCH, set to 0 for default value
+  bool                   pusch_wiener;     ///< Interpolates the PUSCH DMRS with Wiener filters instead of linearly
   uint32_t               nof_max_prb;
 } srsran_gnb_ul_args_t;
 
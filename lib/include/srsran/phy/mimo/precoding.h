@@ -65,11 +65,43 @@ SRSRAN_API int srsran_precoding_type(cf_t*              x[SRSRAN_MAX_LAYERS],
                                      float              scaling,
                                      srsran_tx_scheme_t type);
 
+/* Same as srsran_layermap_diversity() followed by srsran_precoding_diversity(), the layer mapping is done while
+ * precoding so the layer vectors are not needed. The input "d" holds the nof_symbols modulated symbols.
+ */
+SRSRAN_API int
+srsran_precoding_diversity_cw(cf_t* d, cf_t* y[SRSRAN_MAX_PORTS], int nof_ports, int nof_symbols, float scaling);
+
+/* Same as srsran_layermap_type() followed by srsran_precoding_type() for the combinations supported by the precoder,
+ * the ports vectors "y" are generated straight from the codewords "d" of nof_symbols modulated symbols each.
+ */
+SRSRAN_API int srsran_precoding_cw_type(cf_t*              d[SRSRAN_MAX_CODEWORDS],
+                                        cf_t*              y[SRSRAN_MAX_PORTS],
+                                        int                nof_cw,
+                                        int                nof_layers,
+                                        int                nof_ports,
+                                        int                codebook_idx,
+                                        int                nof_symbols,
+                                        float              scaling,
+                                        srsran_tx_scheme_t type);
+
 /* Estimates the vector "x" based on the received signal "y" and the channel estimates "h"
  */
 SRSRAN_API int
 srsran_predecoding_single(cf_t* y, cf_t* h, cf_t* x, float* csi, int nof_symbols, float scaling, float noise_estimate);
 
+/* Same as srsran_predecoding_single() for received symbols and channel estimates in split (SoA) layout, the real and
+ * imaginary parts are loaded in SIMD registers without deinterleaving. The output is interleaved.
+ */
+SRSRAN_API int srsran_predecoding_single_split(const float* y_re,
+                                               const float* y_im,
+                                               const float* h_re,
+                                               const float* h_im,
+                                               cf_t*        x,
+                                               float*       csi,
+                                               int          nof_symbols,
+                                               float        scaling,
+                                               float        noise_estimate);
+
 SRSRAN_API int srsran_predecoding_single_multi(cf_t*  y[SRSRAN_MAX_PORTS],
                                                cf_t*  h[SRSRAN_MAX_PORTS],
                                                cf_t*  x,
@@ -97,6 +129,20 @@ SRSRAN_API int srsran_predecoding_diversity_multi(cf_t*  y[SRSRAN_MAX_PORTS],
 
 SRSRAN_API void srsran_predecoding_set_mimo_decoder(srsran_mimo_decoder_t _mimo_decoder);
 
+/* MMSE equalizer of up to SRSRAN_MAX_LAYERS layers received by up to SRSRAN_MAX_PORTS antennas, from the channel
+ * estimates h[layer][rx] that already include the precoding (e.g. NR and LTE TM9 DMRS). The Hermitian H' x H + No is
+ * factorized as LDL' (square root free Cholesky) for every RE, in SIMD batches. The csi of every layer is optional.
+ */
+SRSRAN_API int srsran_predecoding_mmse(cf_t*  y[SRSRAN_MAX_PORTS],
+                                       cf_t*  h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                                       cf_t*  x[SRSRAN_MAX_LAYERS],
+                                       float* csi[SRSRAN_MAX_LAYERS],
+                                       int    nof_rxant,
+                                       int    nof_layers,
+                                       int    nof_symbols,
+                                       float  scaling,
+                                       float  noise_estimate);
+
 SRSRAN_API int srsran_predecoding_type(cf_t*              y[SRSRAN_MAX_PORTS],
                                        cf_t*              h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
                                        cf_t*              x[SRSRAN_MAX_LAYERS],
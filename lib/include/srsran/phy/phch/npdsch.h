@@ -143,6 +143,14 @@ SRSRAN_API int srsran_npdsch_decode_rnti(srsran_npdsch_t*        q,
                                          uint8_t*                data,
                                          uint32_t                rep_counter);
 
+SRSRAN_API int srsran_npdsch_extract_llr_rnti(srsran_npdsch_t*     q,
+                                              srsran_npdsch_cfg_t* cfg,
+                                              cf_t*                sf_symbols,
+                                              cf_t*                ce[SRSRAN_MAX_PORTS],
+                                              float                noise_estimate,
+                                              uint16_t             rnti,
+                                              uint32_t             sfn);
+
 SRSRAN_API int
 srsran_npdsch_rm_and_decode(srsran_npdsch_t* q, srsran_npdsch_cfg_t* cfg, float* softbits, uint8_t* data);
 
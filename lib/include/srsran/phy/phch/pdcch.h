@@ -64,7 +64,7 @@ typedef struct SRSRAN_API {
   cf_t*    x[SRSRAN_MAX_PORTS];
   cf_t*    d;
   uint8_t* e;
-  float    rm_f[3 * (SRSRAN_DCI_MAX_BITS + 16)];
+  float    rm_f[SRSRAN_VITERBI_MAX_MULTI][3 * (SRSRAN_DCI_MAX_BITS + 16)];
   float*   llr;
 
   /* tx & rx objects */
@@ -104,6 +104,25 @@ SRSRAN_API int srsran_pdcch_extract_llr(srsran_pdcch_t*        q,
 SRSRAN_API int
 srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dci_cfg_t* dci_cfg, srsran_dci_msg_t* msg);
 
+/* Same as srsran_pdcch_decode_msg() for nof_msg candidates. The candidates of the same size are Viterbi decoded
+ * together, in groups of up to SRSRAN_VITERBI_MAX_MULTI */
+SRSRAN_API int srsran_pdcch_decode_msg_multi(srsran_pdcch_t*     q,
+                                             srsran_dl_sf_cfg_t* sf,
+                                             srsran_dci_cfg_t*   dci_cfg,
+                                             srsran_dci_msg_t*   msg,
+                                             uint32_t            nof_msg);
+
+/**
+ * @brief Computes the mean energy of the LLRs of a candidate location, it is a cheap indicator of the presence of a
+ * PDCCH transmission that can be used to rank and discard candidates before decoding them
+ * @param q PDCCH object, after calling srsran_pdcch_extract_llr()
+ * @param sf Subframe configuration
+ * @param location Candidate location
+ * @return The mean squared LLR of the candidate, or a negative value if the location is not valid
+ */
+SRSRAN_API float
+srsran_pdcch_candidate_energy(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, const srsran_dci_location_t* location);
+
 /**
  * @brief Computes decoded DCI correlation. It encodes the given DCI message and compares it with the received LLRs
  * @param q PDCCH object
@@ -41,6 +41,11 @@
 #include "srsran/phy/modem/evm.h"
 #include "srsran/phy/modem/modem_table.h"
 
+/**
+ * @brief Maximum number of candidates decoded at once by srsran_pdcch_nr_decode_multi()
+ */
+#define SRSRAN_PDCCH_NR_MAX_MULTI SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR
+
 /**
  * @brief PDCCH configuration initialization arguments
  */
@@ -58,14 +63,17 @@ typedef struct SRSRAN_API {
   srsran_polar_code_t    code;
   srsran_polar_encoder_t encoder;
   srsran_polar_decoder_t decoder;
+  srsran_polar_decoder_t decoder_batch; // Decodes several candidates at once, initialised only if SIMD is enabled
   srsran_polar_rm_t      rm;
   srsran_carrier_nr_t    carrier;
   srsran_coreset_t       coreset;
   srsran_crc_t           crc24c;
-  uint8_t*               c;         // Message bits with attached CRC
-  uint8_t*               d;         // encoded bits
-  uint8_t*               f;         // bits at the Rate matching output
-  uint8_t*               allocated; // Allocated polar bit buffer, encoder input, decoder output
+  uint8_t*               c;               // Message bits with attached CRC
+  uint8_t*               d;               // encoded bits
+  uint8_t*               f;               // bits at the Rate matching output
+  uint8_t*               allocated;       // Allocated polar bit buffer, encoder input, decoder output
+  int8_t*                d_multi;         // Rate-dematched LLR of every candidate, receiver only
+  uint8_t*               allocated_multi; // Decoder output of every candidate, receiver only
   cf_t*                  symbols;
   srsran_modem_table_t   modem_table;
   srsran_evm_buffer_t*   evm_buffer;
@@ -154,6 +162,27 @@ SRSRAN_API int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
                                       srsran_dci_msg_nr_t*    dci_msg,
                                       srsran_pdcch_nr_res_t*  res);
 
+/**
+ * @brief Decodes several DCI candidates with the same aggregation level and payload size
+ *
+ * The candidates share the polar code, so their codewords are decoded at once by the batch polar decoder when it is
+ * available. The results are the same as calling srsran_pdcch_nr_decode() for every candidate.
+ *
+ * @param[in,out] q provides PDCCH encoder/decoder object
+ * @param[in] slot_symbols provides slot resource grid
+ * @param[in] ce provides channel estimated resource elements, one per candidate
+ * @param[in,out] dci_msg Provides with the DCI message location, RNTI, RNTI type and payload of every candidate
+ * @param[out] res Provides the PDCCH result information of every candidate
+ * @param[in] nof_msg Number of candidates, up to SRSRAN_PDCCH_NR_MAX_MULTI
+ * @return SRSRAN_SUCCESS if the configurations are valid, otherwise it returns an SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_pdcch_nr_decode_multi(srsran_pdcch_nr_t*       q,
+                                            cf_t*                    slot_symbols,
+                                            srsran_dmrs_pdcch_ce_t** ce,
+                                            srsran_dci_msg_nr_t*     dci_msg,
+                                            srsran_pdcch_nr_res_t*   res,
+                                            uint32_t                 nof_msg);
+
 /**
  * @brief Stringifies NR PDCCH decoding information from the latest encoded/decoded transmission
  *
@@ -43,6 +43,38 @@
 #include "srsran/phy/phch/regs.h"
 #include "srsran/phy/phch/sch.h"
 #include "srsran/phy/scrambling/scrambling.h"
+#include <pthread.h>
+
+/**
+ * @brief Default number of transport blocks kept by the broadcast transport block cache
+ */
+#define SRSRAN_PDSCH_TB_CACHE_DEFAULT_NOF_ENTRIES 8
+
+typedef struct SRSRAN_API {
+  uint32_t tbs;
+  uint32_t rv;
+  uint32_t nof_bits; ///< Number of rate matched bits
+  uint32_t qm_nl;    ///< Modulation order times the layers of the codeword
+  uint32_t max_len;  ///< Number of bytes data and e_bytes fit
+  uint64_t last_use; ///< Cache clock of the last access, zero if the entry is empty
+  uint8_t* data;     ///< Copy of the transport block
+  uint8_t* e_bytes;  ///< Rate matched bits before scrambling, packed MSB first
+} srsran_pdsch_tb_cache_entry_t;
+
+/**
+ * @brief Bounded least recently used cache of rate matched transport blocks, indexed by their content and rate matching
+ * parameters. The channel coding does not depend on the cell, so the broadcast transport blocks that several cells
+ * send with the same content are encoded once and only scrambled and mapped per cell. It is thread safe, so the PDSCH
+ * of cells processed in parallel can share it.
+ */
+typedef struct SRSRAN_API {
+  srsran_pdsch_tb_cache_entry_t* entries;
+  uint32_t                       nof_entries;
+  uint64_t                       clock;
+  uint64_t                       nof_hits;
+  uint64_t                       nof_misses;
+  pthread_mutex_t                mutex;
+} srsran_pdsch_tb_cache_t;
 
 /* PDSCH object */
 typedef struct SRSRAN_API {
@@ -74,8 +106,14 @@ typedef struct SRSRAN_API {
 
   srsran_sch_t dl_sch;
 
+  // Scrambling sequences, one cache for each codeword (avoid concurrency issue with coworker)
+  srsran_sequence_cache_t seq_cache[SRSRAN_MAX_CODEWORDS];
+
   void* coworker_ptr;
 
+  // Shared channel coding of the SI-RNTI and P-RNTI transport blocks, optional
+  srsran_pdsch_tb_cache_t* tb_cache;
+
 } srsran_pdsch_t;
 
 typedef struct {
@@ -83,6 +121,7 @@ typedef struct {
   bool     crc;
   float    avg_iterations_block;
   float    evm;
+  uint64_t fec_time_ns; ///< Rate matching and turbo decoding time of the transport block
 } srsran_pdsch_res_t;
 
 SRSRAN_API int srsran_pdsch_init_ue(srsran_pdsch_t* q, uint32_t max_prb, uint32_t nof_rx_antennas);
@@ -96,6 +135,17 @@ SRSRAN_API int srsran_pdsch_enable_coworker(srsran_pdsch_t* q);
 
 SRSRAN_API int srsran_pdsch_set_cell(srsran_pdsch_t* q, srsran_cell_t cell);
 
+SRSRAN_API int srsran_pdsch_tb_cache_init(srsran_pdsch_tb_cache_t* q, uint32_t nof_entries);
+
+SRSRAN_API void srsran_pdsch_tb_cache_free(srsran_pdsch_tb_cache_t* q);
+
+/**
+ * @brief Makes the PDSCH encode the SI-RNTI and P-RNTI transport blocks through a cache shared with other PDSCH
+ * objects. The transport blocks found in the cache skip the channel coding and leave the softbuffer untouched, so
+ * their retransmissions shall carry the data again. Set NULL to disable it.
+ */
+SRSRAN_API void srsran_pdsch_set_tb_cache(srsran_pdsch_t* q, srsran_pdsch_tb_cache_t* cache);
+
 /* These functions do not modify the state and run in real-time */
 SRSRAN_API int srsran_pdsch_encode(srsran_pdsch_t*     q,
                                    srsran_dl_sf_cfg_t* sf,
@@ -68,6 +68,8 @@ typedef struct SRSRAN_API {
   uint32_t             meas_time_us;
   srsran_re_pattern_t  dmrs_re_pattern;
   uint32_t             nof_rvd_re;
+
+  srsran_sequence_cache_t seq_cache; ///< Scrambling sequences
 } srsran_pdsch_nr_t;
 
 /**
@@ -102,6 +102,13 @@ typedef struct SRSRAN_API {
   srsran_dft_plan_t zc_fft;
   srsran_dft_plan_t zc_ifft;
 
+  // Batched detection, one row of N_zc samples per root sequence
+  srsran_dft_plan_t zc_ifft_batch;   // Single guru IFFT over all the rows
+  cf_t*             corr_spec_batch; // Frequency domain correlations
+  cf_t*             corr_td_batch;   // Time domain correlations
+  float*            corr_batch;      // Correlation powers
+  uint32_t          nof_batch_roots; // Number of rows transformed by zc_ifft_batch
+
   cf_t* signal_fft;
   float detect_factor;
 
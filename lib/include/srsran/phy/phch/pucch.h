@@ -78,6 +78,11 @@ typedef struct SRSRAN_API {
   cf_t* z_tmp;
   cf_t* ce;
 
+  // Batched format 1 detection (eNb only)
+  cf_t     batch_dft[SRSRAN_NRE][SRSRAN_NRE];                      ///< 12-point DFT matrix
+  cf_t*    batch_corr;                                             ///< Cyclic shift correlations per slot and PRB
+  uint32_t batch_corr_u[SRSRAN_NOF_SLOTS_PER_SF][SRSRAN_MAX_PRB]; ///< Group u of the correlations, UINT32_MAX if none
+
 } srsran_pucch_t;
 
 typedef struct SRSRAN_API {
@@ -119,6 +124,32 @@ SRSRAN_API int srsran_pucch_decode(srsran_pucch_t*        q,
                                    cf_t*                  sf_symbols,
                                    srsran_pucch_res_t*    data);
 
+/**
+ * @brief Detects a batch of PUCCH format 1, 1a and 1b transmissions sharing the same subframe
+ *
+ * For every PRB and slot in use, each PUCCH symbol is multiplied by the conjugated base sequence and transformed with a
+ * 12-point DFT, which gives the correlation with the 12 cyclic shifts at once. Every configuration then picks the bins
+ * of its cyclic shifts, removes its orthogonal cover and estimates its channel from its own DMRS bins, so the cost per
+ * resource does not depend on the number of UE multiplexed in the PRB and no per-UE channel estimation is needed.
+ *
+ * The correlation, DMRS detection and thresholds have the same meaning as in srsran_pucch_decode(). The results of
+ * cfg[i] are written in res[i]; the format and n_pucch must be already selected in every configuration.
+ *
+ * @param q PUCCH object, initialised with srsran_pucch_init_enb()
+ * @param sf Uplink subframe configuration
+ * @param cfg Array of nof_cfg PUCCH configurations
+ * @param sf_symbols Resource grid of the subframe
+ * @param res Array of nof_cfg results
+ * @param nof_cfg Number of configurations
+ * @return SRSRAN_SUCCESS if all the configurations are processed, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_pucch_decode_format1_batch(srsran_pucch_t*     q,
+                                                 srsran_ul_sf_cfg_t* sf,
+                                                 srsran_pucch_cfg_t* cfg,
+                                                 cf_t*               sf_symbols,
+                                                 srsran_pucch_res_t* res,
+                                                 uint32_t            nof_cfg);
+
 /* Other utilities. These functions do not modify the state and run in real-time */
 SRSRAN_API float srsran_pucch_alpha_format1(const uint32_t n_cs_cell[SRSRAN_NSLOTS_X_FRAME][SRSRAN_CP_NORM_NSYMB],
                                             const srsran_pucch_cfg_t* cfg,
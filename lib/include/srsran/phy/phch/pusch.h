@@ -73,6 +73,9 @@ typedef struct SRSRAN_API {
   // EVM buffer
   srsran_evm_buffer_t* evm_buffer;
 
+  // Scrambling sequences
+  srsran_sequence_cache_t seq_cache;
+
 } srsran_pusch_t;
 
 typedef struct SRSRAN_API {
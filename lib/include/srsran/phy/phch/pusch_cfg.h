@@ -70,6 +70,7 @@ typedef struct SRSRAN_API {
   uint32_t current_tx_nb;
   bool     csi_enable;
   bool     enable_64qam;
+  bool     tb_pre_encoded; ///< The code blocks are in the softbuffer (srsran_ulsch_pre_encode()), cleared when encoding
 
   union {
     srsran_softbuffer_tx_t* tx;
@@ -75,6 +75,8 @@ typedef struct SRSRAN_API {
   uint32_t             G_csi1;    ///< Number of encoded CSI part 1 bits
   uint32_t             G_csi2;    ///< Number of encoded CSI part 2 bits
   uint32_t             G_ulsch;   ///< Number of encoded shared channel
+
+  srsran_sequence_cache_t seq_cache; ///< Scrambling sequences
 } srsran_pusch_nr_t;
 
 /**
@@ -36,6 +36,7 @@
 #include "srsran/phy/fec/turbo/rm_turbo.h"
 #include "srsran/phy/fec/turbo/turbocoder.h"
 #include "srsran/phy/fec/turbo/turbodecoder.h"
+#include "srsran/phy/fec/turbo/turbodecoder_batch.h"
 #include "srsran/phy/phch/pdsch_cfg.h"
 #include "srsran/phy/phch/pusch_cfg.h"
 #include "srsran/phy/phch/uci.h"
@@ -48,13 +49,29 @@
 #define SRSRAN_TX_NULL 100
 #endif
 
+/* Runs task(arg, idx) for every idx from 0 to nof_tasks - 1, possibly concurrently, and returns once all of them
+ * have finished. Used to decode the code blocks of a transport block in parallel. */
+typedef void (*srsran_sch_task_t)(void* arg, uint32_t idx);
+typedef void (*srsran_sch_parallel_for_t)(void* executor, srsran_sch_task_t task, void* arg, uint32_t nof_tasks);
+
+/* Decoder and buffers owned by each of the parallel code block decoding tasks */
+typedef struct SRSRAN_API {
+  srsran_tdec_t decoder;
+  srsran_crc_t  crc_tb;
+  srsran_crc_t  crc_cb;
+  uint8_t*      cb_data;
+  uint32_t      nof_iterations;
+} srsran_sch_cb_worker_t;
+
 /* DL-SCH AND UL-SCH common functions */
 typedef struct SRSRAN_API {
 
   uint32_t max_iterations;
   float    avg_iterations;
+  uint64_t decode_time_ns; // rate matching and turbo decoding time of the last transport block
 
   bool llr_is_8bit;
+  bool tdec_batch_enabled;
 
   /* buffers */
   uint8_t*         cb_in;
@@ -66,11 +83,18 @@ typedef struct SRSRAN_API {
 
   srsran_tcod_t encoder;
   srsran_tdec_t decoder;
+  srsran_tdec_batch_t decoder_batch;
   srsran_crc_t  crc_tb;
   srsran_crc_t  crc_cb;
 
   srsran_uci_cqi_pusch_t uci_cqi;
 
+  /* parallel code block decoding */
+  srsran_sch_parallel_for_t parallel_for;
+  void*                     executor;
+  srsran_sch_cb_worker_t*   cb_workers;
+  uint32_t                  nof_cb_workers;
+
 } srsran_sch_t;
 
 SRSRAN_API int srsran_sch_init(srsran_sch_t* q);
@@ -81,6 +105,21 @@ SRSRAN_API void srsran_sch_set_max_noi(srsran_sch_t* q, uint32_t max_iterations)
 
 SRSRAN_API float srsran_sch_last_noi(srsran_sch_t* q);
 
+/* Time spent rate matching and turbo decoding the code blocks of the last transport block */
+SRSRAN_API uint64_t srsran_sch_last_decode_time_ns(srsran_sch_t* q);
+
+/* Decodes all the code blocks of equal length of a transport block at once with the batched turbo decoder.
+ * Only applies to 16-bit LLRs. Returns SRSRAN_ERROR if the batched decoder is not available. */
+SRSRAN_API int srsran_sch_enable_tdec_batch(srsran_sch_t* q, bool enable);
+
+/* Decodes the code blocks of a transport block in up to nof_tasks concurrent tasks run through parallel_for, each of
+ * them with its own turbo decoder. Set parallel_for to NULL (or nof_tasks to 1 or less) to decode sequentially.
+ * The batched decoder takes precedence when it is enabled. */
+SRSRAN_API int srsran_sch_set_cb_executor(srsran_sch_t*             q,
+                                          srsran_sch_parallel_for_t parallel_for,
+                                          void*                     executor,
+                                          uint32_t                  nof_tasks);
+
 SRSRAN_API int srsran_dlsch_encode(srsran_sch_t* q, srsran_pdsch_cfg_t* cfg, uint8_t* data, uint8_t* e_bits);
 
 SRSRAN_API int srsran_dlsch_encode2(srsran_sch_t*       q,
@@ -99,6 +138,10 @@ SRSRAN_API int srsran_dlsch_decode2(srsran_sch_t*       q,
                                     int                 codeword_idx,
                                     uint32_t            nof_layers);
 
+/* Encodes the code blocks of the transport block into the softbuffer of cfg ahead of srsran_ulsch_encode(), which then
+ * only does the bit selection, the UCI multiplexing and the interleaving. It sets cfg->tb_pre_encoded. */
+SRSRAN_API int srsran_ulsch_pre_encode(srsran_sch_t* q, srsran_pusch_cfg_t* cfg, uint8_t* data);
+
 SRSRAN_API int srsran_ulsch_encode(srsran_sch_t*       q,
                                    srsran_pusch_cfg_t* cfg,
                                    uint8_t*            data,
@@ -33,6 +33,7 @@
 #include "srsran/config.h"
 #include "srsran/phy/common/phy_common_nr.h"
 #include "srsran/phy/fec/crc.h"
+#include "srsran/phy/fec/fec_offload.h"
 #include "srsran/phy/fec/ldpc/ldpc_decoder.h"
 #include "srsran/phy/fec/ldpc/ldpc_encoder.h"
 #include "srsran/phy/fec/ldpc/ldpc_rm.h"
@@ -45,6 +46,11 @@
 #define SRSRAN_SCH_NR_MAX_NOF_CB_LDPC                                                                                  \
   ((SRSRAN_SLOT_MAX_NOF_BITS_NR + (SRSRAN_LDPC_MAX_LEN_CB - 1)) / SRSRAN_LDPC_MAX_LEN_CB)
 
+/**
+ * @brief Maximum number of code blocks the decoder can run iteration by iteration at the same time
+ */
+#define SRSRAN_SCH_NR_MAX_NOF_INTERLEAVED_CB 8
+
 /**
  * @brief Groups NR-PUSCH data for reception
  */
@@ -76,6 +82,17 @@ typedef struct SRSRAN_API {
   /// LDPC Rate matcher
   srsran_ldpc_rm_t tx_rm;
   srsran_ldpc_rm_t rx_rm;
+
+  /// LDPC code block scheduler
+  uint32_t                    nof_interleaved_cb;
+  float                       decoder_avg_nof_iter;
+  srsran_ldpc_decoder_state_t decoder_state[SRSRAN_SCH_NR_MAX_NOF_INTERLEAVED_CB];
+  uint8_t*                    decoder_state_cb[SRSRAN_SCH_NR_MAX_NOF_INTERLEAVED_CB];
+
+  /// Look-aside FEC offload
+  srsran_fec_offload_t*             fec_offload;
+  srsran_fec_offload_ldpc_dec_op_t  offload_op[SRSRAN_SCH_NR_MAX_NOF_CB_LDPC];
+  srsran_fec_offload_ldpc_dec_op_t* offload_op_ptr[SRSRAN_SCH_NR_MAX_NOF_CB_LDPC];
 } srsran_sch_nr_t;
 
 /**
@@ -86,6 +103,11 @@ typedef struct SRSRAN_API {
   bool     decoder_use_flooded;
   float    decoder_scaling_factor;
   uint32_t max_nof_iter; ///< Maximum number of LDPC iterations
+  uint32_t decoder_nof_interleaved_cb; ///< Code blocks decoded iteration by iteration together, 0 or 1 to disable
+  float    decoder_avg_nof_iter; ///< Transport block iteration budget per code block for the scheduler, 0 for no limit
+
+  /// Optional LDPC decoding offload, not owned. When set, it replaces the local decoders and the code block scheduler
+  srsran_fec_offload_t* fec_offload;
 } srsran_sch_nr_args_t;
 
 /**
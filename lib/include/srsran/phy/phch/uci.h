@@ -52,7 +52,6 @@ typedef struct SRSRAN_API {
 
 typedef struct SRSRAN_API {
   uint8_t** cqi_table;
-  int16_t** cqi_table_s;
 } srsran_uci_cqi_pucch_t;
 
 SRSRAN_API void srsran_uci_cqi_pucch_init(srsran_uci_cqi_pucch_t* q);
@@ -22,7 +22,8 @@
 /******************************************************************************
  *  File:         resampler.h
  *
- *  Description:  Linear and vector interpolation
+ *  Description:  Linear and vector interpolation. FFT based integer ratio and polyphase
+ *                rational ratio resamplers.
  *
  *  Reference:
  *****************************************************************************/
@@ -106,6 +107,80 @@ SRSRAN_API void srsran_resampler_fft_run(srsran_resampler_fft_t* q, const cf_t*
  */
 SRSRAN_API void srsran_resampler_fft_free(srsran_resampler_fft_t* q);
 
+/**
+ * @brief Rational L/M polyphase resampler internal buffers
+ */
+typedef struct {
+  uint32_t L;         ///< Interpolation factor, 0 if not initialised
+  uint32_t M;         ///< Decimation factor
+  uint32_t nof_taps;  ///< Number of coefficients of each polyphase branch, at the input rate
+  uint32_t phase;     ///< Polyphase branch of the next output sample
+  uint32_t offset;    ///< Input sample index of the next output, relative to the next input block
+  float*   bank;      ///< L polyphase branches of nof_taps time reversed coefficients
+  cf_t*    buffer;    ///< Last nof_taps - 1 input samples followed by the input block being processed
+} srsran_resampler_poly_t;
+
+/**
+ * Initialise a polyphase resampler that changes the sampling rate by the rational factor L/M. The factors are reduced
+ * by their greatest common divisor and the filter bank is computed once for the resulting ratio.
+ * @param q Object pointer
+ * @param L Interpolation factor
+ * @param M Decimation factor
+ * @return SRSRAN_SUCCES if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_resampler_poly_init(srsran_resampler_poly_t* q, uint32_t L, uint32_t M);
+
+/**
+ * @brief resets internal re-sampler state
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_resampler_poly_reset_state(srsran_resampler_poly_t* q);
+
+/**
+ * Get the filter delay of the polyphase resampler
+ * @param q Object pointer
+ * @return the delay in number of output samples
+ */
+SRSRAN_API float srsran_resampler_poly_get_delay(srsran_resampler_poly_t* q);
+
+/**
+ * Get the number of output samples the next call to srsran_resampler_poly_run() produces from nof_input samples
+ * @param q Object pointer
+ * @param nof_input Number of input samples
+ * @return the number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_nof_output(srsran_resampler_poly_t* q, uint32_t nof_input);
+
+/**
+ * Get the number of input samples the next call to srsran_resampler_poly_run() needs to produce nof_output samples
+ * @param q Object pointer
+ * @param nof_output Number of output samples
+ * @return the number of input samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_nof_input(srsran_resampler_poly_t* q, uint32_t nof_output);
+
+/**
+ * @brief Run the polyphase resampler. The filter state is kept between calls.
+ *
+ * @note Setting the input to NULL is equivalent of feeding zeroes
+ *
+ * @param q Object pointer, make sure it has been initialised
+ * @param input Points at the input complex buffer
+ * @param output Points at the output complex buffer, it shall fit srsran_resampler_poly_nof_output() samples
+ * @param nof_input Number of input samples
+ * @return the number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_run(srsran_resampler_poly_t* q,
+                                             const cf_t*              input,
+                                             cf_t*                    output,
+                                             uint32_t                 nof_input);
+
+/**
+ * Free polyphase resampler buffers
+ * @param q  Object pointer
+ */
+SRSRAN_API void srsran_resampler_poly_free(srsran_resampler_poly_t* q);
+
 #ifdef __cplusplus
 }
 #endif
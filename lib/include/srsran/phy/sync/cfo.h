@@ -57,6 +57,11 @@ SRSRAN_API void srsran_cfo_set_tol(srsran_cfo_t* h, float tol);
 
 SRSRAN_API void srsran_cfo_correct(srsran_cfo_t* h, const cf_t* input, cf_t* output, float freq);
 
+/* Same as srsran_cfo_correct() that also returns the average power of the corrected samples and, if max_pwr is not
+ * NULL, their peak power, measured while the samples are corrected */
+SRSRAN_API float
+srsran_cfo_correct_power(srsran_cfo_t* h, const cf_t* input, cf_t* output, float freq, float* max_pwr);
+
 SRSRAN_API void
 srsran_cfo_correct_offset(srsran_cfo_t* h, const cf_t* input, cf_t* output, float freq, int cexp_offset, int nsamples);
 
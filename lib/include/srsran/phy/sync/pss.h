@@ -91,6 +91,7 @@ typedef struct SRSRAN_API {
   float  ema_alpha;
   float* conv_output_avg;
   float  peak_value;
+  bool   short_window_fft; // Correlate windows shorter than fft_size through the DFT instead of dot products
 
   bool              filter_pss_enable;
   srsran_dft_plan_t dftp_input;
@@ -136,10 +137,14 @@ SRSRAN_API void srsran_pss_put_slot(cf_t* pss_signal, cf_t* slot, uint32_t nof_p
 
 SRSRAN_API void srsran_pss_set_ema_alpha(srsran_pss_t* q, float alpha);
 
+SRSRAN_API void srsran_pss_set_short_window_fft(srsran_pss_t* q, bool enable);
+
 SRSRAN_API int srsran_pss_set_N_id_2(srsran_pss_t* q, uint32_t N_id_2);
 
 SRSRAN_API int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_value);
 
+SRSRAN_API int srsran_pss_find_pss_all(srsran_pss_t* q, const cf_t* input, uint32_t* N_id_2, float* corr_peak_value);
+
 SRSRAN_API int srsran_pss_chest(srsran_pss_t* q, const cf_t* input, cf_t ce[SRSRAN_PSS_LEN]);
 
 SRSRAN_API float srsran_pss_cfo_compute(srsran_pss_t* q, const cf_t* pss_recv);
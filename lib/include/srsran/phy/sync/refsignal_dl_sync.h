@@ -35,6 +35,13 @@ typedef struct {
   cf_t*                correlation;
   srsran_conv_fft_cc_t conv_fft_cc;
 
+  // DFT of every correlation window of the buffer given to srsran_refsignal_dl_sync_prepare()
+  cf_t*    buffer;
+  uint32_t buffer_nsamples;
+  cf_t*    buffer_fft;
+  uint32_t buffer_fft_max_len;
+  uint32_t buffer_fft_sf_sz;
+
   // Results
   bool     found;
   float    rsrp_dBfs;
@@ -52,6 +59,18 @@ SRSRAN_API void srsran_refsignal_dl_sync_free(srsran_refsignal_dl_sync_t* q);
 
 SRSRAN_API int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples);
 
+/**
+ * Computes the DFT of the correlation windows of a buffer once, so that it can be measured for several cells with
+ * srsran_refsignal_dl_sync_run_prepared(). The cells must have the same number of PRB as the one set when this is
+ * called. The buffer content must not change while it is being measured.
+ */
+SRSRAN_API int srsran_refsignal_dl_sync_prepare(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples);
+
+/**
+ * Same as srsran_refsignal_dl_sync_run() on the buffer given to srsran_refsignal_dl_sync_prepare(), reusing its DFT
+ */
+SRSRAN_API int srsran_refsignal_dl_sync_run_prepared(srsran_refsignal_dl_sync_t* q);
+
 SRSRAN_API void srsran_refsignal_dl_sync_measure_sf(srsran_refsignal_dl_sync_t* q,
                                                     cf_t*                       buffer,
                                                     uint32_t                    sf_idx,
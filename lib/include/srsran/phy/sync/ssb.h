@@ -88,18 +88,20 @@ typedef struct SRSRAN_API {
   srsran_ssb_cfg_t  cfg;  ///< Stores last configuration
 
   /// Sampling rate dependent parameters
-  float    scs_hz;        ///< Subcarrier spacing in Hz
-  uint32_t max_sf_sz;     ///< Maximum subframe size at the specified sampling rate
-  uint32_t max_symbol_sz; ///< Maximum symbol size given the minimum supported SCS and sampling rate
-  uint32_t max_corr_sz;   ///< Maximum correlation size
-  uint32_t max_ssb_sz;    ///< Maximum SSB size in samples at the configured sampling rate
-  uint32_t sf_sz;         ///< Current subframe size at the specified sampling rate
-  uint32_t symbol_sz;     ///< Current SSB symbol size (for the given base-band sampling rate)
-  uint32_t corr_sz;       ///< Correlation size
-  uint32_t corr_window;   ///< Correlation window length
-  uint32_t ssb_sz;        ///< SSB size in samples at the configured sampling rate
-  int32_t  f_offset;      ///< SSB integer frequency offset (multiple of SCS) between DC and the SSB center
-  uint32_t cp_sz;         ///< CP length for the given symbol size
+  float    scs_hz;         ///< Subcarrier spacing in Hz
+  uint32_t max_sf_sz;      ///< Maximum subframe size at the specified sampling rate
+  uint32_t max_symbol_sz;  ///< Maximum symbol size given the minimum supported SCS and sampling rate
+  uint32_t max_corr_sz;    ///< Maximum correlation size
+  uint32_t max_ssb_sz;     ///< Maximum SSB size in samples at the configured sampling rate
+  uint32_t sf_sz;          ///< Current subframe size at the specified sampling rate
+  uint32_t symbol_sz;      ///< Current SSB symbol size (for the given base-band sampling rate)
+  uint32_t corr_sz;        ///< Correlation size
+  uint32_t corr_window;    ///< Correlation window length
+  uint32_t corr_symbol_sz; ///< Symbol size the PSS correlation sequences were generated for
+  int32_t  corr_f_offset;  ///< SSB integer frequency offset the PSS correlation sequences were generated for
+  uint32_t ssb_sz;         ///< SSB size in samples at the configured sampling rate
+  int32_t  f_offset;       ///< SSB integer frequency offset (multiple of SCS) between DC and the SSB center
+  uint32_t cp_sz;          ///< CP length for the given symbol size
 
   /// Other parameters
   uint32_t l_first[SRSRAN_SSB_NOF_CANDIDATES]; ///< Start symbol for each SSB candidate in half radio frame
@@ -131,6 +133,17 @@ typedef struct {
   srsran_csi_trs_measurements_t measurements; ///< Measurements
 } srsran_ssb_search_res_t;
 
+/**
+ * @brief Describes the PSS correlation of an SSB candidate center frequency
+ */
+typedef struct {
+  double   ssb_freq_hz;   ///< SSB candidate center frequency, set by the caller
+  uint32_t N_id_2;        ///< Best matching PSS sequence
+  uint32_t t_offset;      ///< SSB time offset in the input samples
+  float    corr;          ///< Normalised PSS correlation, zero if nothing correlated
+  float    coarse_cfo_hz; ///< Coarse CFO estimate
+} srsran_ssb_pss_res_t;
+
 /**
  * @brief Initialises configures NR SSB with the given arguments
  * @param q SSB object
@@ -163,6 +176,24 @@ SRSRAN_API int srsran_ssb_set_cfg(srsran_ssb_t* q, const srsran_ssb_cfg_t* cfg);
  */
 SRSRAN_API int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srsran_ssb_search_res_t* res);
 
+/**
+ * @brief Correlates the PSS of several SSB candidate center frequencies, e.g. the GSCN raster points of a wide
+ * base-band, in a single pass
+ * @note The input is converted to frequency domain once per correlation window and every candidate is a circular shift
+ * of the configured SSB PSS sequences. The candidates must fit within the configured sampling rate and center frequency
+ * @param q SSB object
+ * @param in Input baseband buffer
+ * @param nof_samples Number of samples available in the buffer
+ * @param res PSS correlation results, the SSB center frequency of each candidate is provided by the caller
+ * @param nof_res Number of candidates
+ * @return SRSRAN_SUCCESS if the parameters are valid, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ssb_pss_search_multi(srsran_ssb_t*         q,
+                                           const cf_t*           in,
+                                           uint32_t              nof_samples,
+                                           srsran_ssb_pss_res_t* res,
+                                           uint32_t              nof_res);
+
 /**
  * @brief Decides if the SSB object is configured and a given subframe is configured for SSB transmission
  * @param q SSB object
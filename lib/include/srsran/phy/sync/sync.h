@@ -64,6 +64,7 @@ typedef struct SRSRAN_API {
   float             threshold;
   float             peak_value;
   uint32_t          N_id_2;
+  bool              N_id_2_search;
   uint32_t          N_id_1;
   uint32_t          sf_idx;
   uint32_t          fft_size;
@@ -170,6 +171,11 @@ SRSRAN_API void srsran_sync_set_em_alpha(srsran_sync_t* q, float alpha);
 /* Sets the N_id_2 to search for */
 SRSRAN_API int srsran_sync_set_N_id_2(srsran_sync_t* q, uint32_t N_id_2);
 
+/* Enables/disables the search of the three N_id_2 in a single correlation pass. When enabled, srsran_sync_find()
+ * detects the most likely N_id_2 and replaces the one set by srsran_sync_set_N_id_2(). Requires the PSS averaging to be
+ * disabled with srsran_sync_set_em_alpha() */
+SRSRAN_API void srsran_sync_set_N_id_2_search(srsran_sync_t* q, bool enable);
+
 SRSRAN_API int srsran_sync_set_N_id_1(srsran_sync_t* q, uint32_t N_id_1);
 
 /* Gets the Physical CellId from the last call to synch_run() */
@@ -178,6 +184,9 @@ SRSRAN_API int srsran_sync_get_cell_id(srsran_sync_t* q);
 /* Enables/disables filtering of the central PRBs before PSS CFO estimation or SSS correlation*/
 SRSRAN_API void srsran_sync_set_pss_filt_enable(srsran_sync_t* q, bool enable);
 
+/* Enables/disables the DFT-based PSS correlation when the search window (max_offset) is shorter than the FFT size */
+SRSRAN_API void srsran_sync_set_pss_short_window_fft(srsran_sync_t* q, bool enable);
+
 SRSRAN_API void srsran_sync_set_sss_eq_enable(srsran_sync_t* q, bool enable);
 
 /* Gets the CFO estimation from the last call to synch_run() */
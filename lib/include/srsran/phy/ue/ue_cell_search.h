@@ -97,6 +97,10 @@ SRSRAN_API int srsran_ue_cellsearch_scan(srsran_ue_cellsearch_t*       q,
                                          srsran_ue_cellsearch_result_t found_cells[3],
                                          uint32_t*                     max_N_id_2);
 
+SRSRAN_API int srsran_ue_cellsearch_scan_all(srsran_ue_cellsearch_t*       q,
+                                             srsran_ue_cellsearch_result_t found_cells[3],
+                                             uint32_t*                     max_N_id_2);
+
 SRSRAN_API int srsran_ue_cellsearch_set_nof_valid_frames(srsran_ue_cellsearch_t* q, uint32_t nof_frames);
 
 SRSRAN_API void srsran_set_detect_cp(srsran_ue_cellsearch_t* q, bool enable);
@@ -74,6 +74,13 @@ typedef struct SRSRAN_API {
   uint32_t              nof_formats;
 } dci_blind_search_t;
 
+// PDCCH blind search counters, accumulated until srsran_ue_dl_reset_pdcch_stats() is called
+typedef struct SRSRAN_API {
+  uint64_t nof_candidates; // Candidates (location and format) in the searched spaces
+  uint64_t nof_decoded;    // Candidates the PDCCH decoder was called for
+  uint64_t nof_skipped;    // Candidates skipped by the LLR energy pre-screening
+} srsran_ue_dl_pdcch_stats_t;
+
 typedef struct SRSRAN_API {
   // Cell configuration
   srsran_cell_t cell;
@@ -97,6 +104,7 @@ typedef struct SRSRAN_API {
   srsran_chest_dl_res_t chest_res;
   srsran_ofdm_t         fft[SRSRAN_MAX_PORTS];
   srsran_ofdm_t         fft_mbsfn;
+  bool                  ctrl_region_only; ///< Only the control region of the current subframe is demodulated
 
   // Buffers to store channel symbols after demodulation
   cf_t*              sf_symbols[SRSRAN_MAX_PORTS];
@@ -107,6 +115,8 @@ typedef struct SRSRAN_API {
 
   srsran_dci_location_t allocated_locations[SRSRAN_MAX_DCI_MSG];
   uint32_t              nof_allocated_locations;
+
+  srsran_ue_dl_pdcch_stats_t pdcch_stats;
 } srsran_ue_dl_t;
 
 // Downlink config (includes common and dedicated variables)
@@ -123,6 +133,9 @@ typedef struct SRSRAN_API {
   srsran_chest_dl_cfg_t chest_cfg;
   uint32_t              last_ri;
   float                 snr_to_cqi_offset;
+  float                 pdcch_prescreen_ratio; // Skip the candidates whose LLR energy is below this ratio of the
+                                               // strongest one in the search space, and decode the rest from the
+                                               // strongest. Set to 0 to disable it
 } srsran_ue_dl_cfg_t;
 
 typedef struct {
@@ -168,13 +181,29 @@ SRSRAN_API int srsran_ue_dl_set_mbsfn_area_id(srsran_ue_dl_t* q, uint16_t mbsfn_
 
 SRSRAN_API void srsran_ue_dl_set_non_mbsfn_region(srsran_ue_dl_t* q, uint8_t non_mbsfn_region_length);
 
+/* Sets the CFO in Hz the OFDM demodulator corrects, for the buffers the UE sync left uncorrected. 0 disables it */
+SRSRAN_API void srsran_ue_dl_set_rx_cfo(srsran_ue_dl_t* q, float cfo_hz);
+
 SRSRAN_API void srsran_ue_dl_set_mi_manual(srsran_ue_dl_t* q, uint32_t mi_idx);
 
 SRSRAN_API void srsran_ue_dl_set_mi_auto(srsran_ue_dl_t* q);
 
+SRSRAN_API void srsran_ue_dl_reset_pdcch_stats(srsran_ue_dl_t* q);
+
 /* Perform signal demodulation and channel estimation and store signals in the object */
 SRSRAN_API int srsran_ue_dl_decode_fft_estimate(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl_cfg_t* cfg);
 
+/* Demodulates and estimates the control region only, unless the subframe is MBSFN, the CFO is estimated in it or the
+ * transmission mode reports RI/PMI from the channel estimates. The rest of the subframe is left for
+ * srsran_ue_dl_decode_fft_estimate_data(), which must be called before decoding the PDSCH */
+SRSRAN_API int
+srsran_ue_dl_decode_fft_estimate_ctrl(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl_cfg_t* cfg);
+
+/* Demodulates the symbols left by srsran_ue_dl_decode_fft_estimate_ctrl() and estimates the channel of the whole
+ * subframe. It does nothing if the whole subframe is already demodulated */
+SRSRAN_API int
+srsran_ue_dl_decode_fft_estimate_data(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl_cfg_t* cfg);
+
 SRSRAN_API int srsran_ue_dl_decode_fft_estimate_noguru(srsran_ue_dl_t*     q,
                                                        srsran_dl_sf_cfg_t* sf,
                                                        srsran_ue_dl_cfg_t* cfg,
@@ -86,6 +86,9 @@ typedef struct SRSRAN_API {
   srsran_agc_t agc;
   bool do_agc; 
   uint32_t agc_period; 
+  bool     agc_pwr_valid; ///< The AGC power of the current subframe was measured while correcting its CFO
+  float    agc_avg_pwr;
+  float    agc_max_pwr;
   int decimate;
   void *stream; 
   void *stream_single;
@@ -125,6 +128,8 @@ typedef struct SRSRAN_API {
   bool  cfo_is_copied;
   bool  cfo_correct_enable_track;
   bool  cfo_correct_enable_find;
+  bool  cfo_correct_defer_track; ///< In tracking, leave the CFO correction of the buffers to the OFDM demodulator
+  float cfo_sf_value;            ///< CFO the last tracked subframe shall be corrected with
   float cfo_current_value;
   float cfo_loop_bw_pss;
   float cfo_loop_bw_ref;
@@ -142,6 +147,8 @@ typedef struct SRSRAN_API {
   float mean_sample_offset; 
   uint32_t sample_offset_correct_period;
   float sfo_ema; 
+
+  uint32_t track_window; ///< Samples searched around the expected PSS position while tracking, 0 for the default
   
 
   #ifdef MEASURE_EXEC_TIME
@@ -247,6 +254,22 @@ SRSRAN_API uint32_t srsran_ue_sync_get_sfidx(srsran_ue_sync_t* q);
 
 SRSRAN_API float srsran_ue_sync_get_cfo(srsran_ue_sync_t* q);
 
+/**
+ * @brief Leaves the CFO correction of the tracked subframes to the OFDM demodulator, which corrects only the DFT windows
+ * while they are in cache, instead of rotating every buffer in a separate pass. The PSS tracking measures then the
+ * total CFO and the residual is derived from the CFO pending correction.
+ * @param q UE sync object
+ * @param enable True to defer the correction, false to correct the buffers in the UE sync (default)
+ */
+SRSRAN_API void srsran_ue_sync_set_cfo_correct_defer(srsran_ue_sync_t* q, bool enable);
+
+/**
+ * @brief Gets the CFO in Hz the last received subframe is still to be corrected with, 0 if the UE sync corrected it
+ * @param q UE sync object
+ * @return The CFO the OFDM demodulator shall correct, see srsran_ue_dl_set_rx_cfo()
+ */
+SRSRAN_API float srsran_ue_sync_get_sf_cfo(srsran_ue_sync_t* q);
+
 SRSRAN_API void srsran_ue_sync_cp_en(srsran_ue_sync_t* q, bool enabled);
 
 SRSRAN_API float srsran_ue_sync_get_sfo(srsran_ue_sync_t* q);
@@ -257,6 +280,13 @@ SRSRAN_API void srsran_ue_sync_set_sfo_correct_period(srsran_ue_sync_t* q, uint3
 
 SRSRAN_API void srsran_ue_sync_set_sfo_ema(srsran_ue_sync_t* q, float ema_coefficient);
 
+/**
+ * Sets the number of samples searched around the expected PSS position while tracking. It can only reduce the default
+ * window, and it is limited to a minimum that keeps the correlation side-lobes in the window. Set 0 for the default.
+ * If fft is true, the tracking correlation is computed through the DFT rather than with one dot product per sample.
+ */
+SRSRAN_API int srsran_ue_sync_set_track_window(srsran_ue_sync_t* q, uint32_t nof_samples, bool fft);
+
 SRSRAN_API void srsran_ue_sync_get_last_timestamp(srsran_ue_sync_t* q, srsran_timestamp_t* timestamp);
 
 SRSRAN_API int srsran_ue_sync_run_find_pss_mode(srsran_ue_sync_t* q, cf_t* input_buffer[SRSRAN_MAX_CHANNELS]);
@@ -0,0 +1,68 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         bfp.h
+ *
+ *  Description:  Block floating point compression of 16-bit complex samples,
+ *                to carry baseband between processes with less bandwidth.
+ *
+ *                The samples are grouped in blocks of one PRB (12 complex
+ *                samples) that share an exponent. A block is coded as one byte
+ *                with the exponent in its 4 LSB, followed by the 24 I and Q
+ *                mantissas of mantissa_bits bits each, packed MSB first. The
+ *                mantissas are the samples shifted right by the exponent, the
+ *                smallest one that fits the largest sample of the block.
+ *                A last incomplete block is padded with zeros.
+ *
+ *  Reference:    O-RAN.WG4.CUS, Annex A.1 Block Floating Point Compression
+ *****************************************************************************/
+
+#ifndef SRSRAN_BFP_H
+#define SRSRAN_BFP_H
+
+#include "srsran/config.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SRSRAN_BFP_BLOCK_LEN 12 // complex samples per block
+#define SRSRAN_BFP_MIN_MANTISSA_BITS 4
+#define SRSRAN_BFP_MAX_MANTISSA_BITS 16
+
+/* Returns the number of bytes of nof_samples compressed samples */
+SRSRAN_API uint32_t srsran_bfp_nof_bytes(uint32_t nof_samples, uint32_t mantissa_bits);
+
+/* Compresses nof_samples interleaved I/Q samples of x into y. Returns the number of bytes written, or SRSRAN_ERROR if
+ * the number of mantissa bits is not supported */
+SRSRAN_API int srsran_bfp_compress(const int16_t* x, uint8_t* y, uint32_t nof_samples, uint32_t mantissa_bits);
+
+/* Decompresses nof_samples samples of x into y as interleaved I/Q. Returns the number of bytes read, or SRSRAN_ERROR
+ * if the number of mantissa bits is not supported */
+SRSRAN_API int srsran_bfp_decompress(const uint8_t* x, int16_t* y, uint32_t nof_samples, uint32_t mantissa_bits);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_BFP_H
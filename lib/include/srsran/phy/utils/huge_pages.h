@@ -0,0 +1,92 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         huge_pages.h
+ *
+ *  Description:  Allocator of memory backed by huge pages, for the large and
+ *                long lived buffers of the PHY (worker sample buffers,
+ *                softbuffers) and of the memory pools. With several GB of such
+ *                buffers, regular 4 kB pages cause many TLB misses.
+ *
+ *                The memory is mapped with MAP_HUGETLB from the pages reserved
+ *                in /proc/sys/vm/nr_hugepages (or the 1 GB equivalent). When no
+ *                reserved page is left, it falls back to regular pages advised
+ *                as transparent huge pages. Allocations up to 1 MB are carved
+ *                out of shared huge pages and recycled per size class, larger
+ *                ones get their own mapping.
+ *
+ *                The memory has to be released with srsran_huge_free(), which
+ *                also accepts pointers from malloc(). With the huge pages
+ *                disabled (default), srsran_huge_malloc() is srsran_vec_malloc().
+ *
+ *  Reference:    Documentation/admin-guide/mm/hugetlbpage.rst
+ *****************************************************************************/
+
+#ifndef SRSRAN_HUGE_PAGES_H
+#define SRSRAN_HUGE_PAGES_H
+
+#include "srsran/config.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum SRSRAN_API {
+  SRSRAN_HUGE_PAGES_NONE = 0, // regular allocations
+  SRSRAN_HUGE_PAGES_2MB,
+  SRSRAN_HUGE_PAGES_1GB,
+} srsran_huge_pages_t;
+
+typedef struct SRSRAN_API {
+  uint64_t hugetlb_bytes; // bytes mapped from the reserved huge pages
+  uint64_t thp_bytes;     // bytes mapped in regular pages because no reserved huge page was left
+  uint64_t used_bytes;    // bytes of the allocations currently served, including their headers
+} srsran_huge_pages_stats_t;
+
+/* Selects the page size of the following allocations. The memory already allocated is not moved */
+SRSRAN_API void srsran_huge_pages_set_mode(srsran_huge_pages_t mode);
+
+SRSRAN_API srsran_huge_pages_t srsran_huge_pages_get_mode(void);
+
+/* Parses "none", "2M" or "1G". Returns SRSRAN_ERROR if the string is not valid */
+SRSRAN_API int srsran_huge_pages_from_string(const char* str, srsran_huge_pages_t* mode);
+
+SRSRAN_API const char* srsran_huge_pages_to_string(srsran_huge_pages_t mode);
+
+/* Returns the number of free reserved pages of the given size, or -1 if the system does not support them */
+SRSRAN_API int srsran_huge_pages_nof_free(srsran_huge_pages_t mode);
+
+/* Allocates size bytes aligned to SRSRAN_SIMD_BIT_ALIGN. Returns NULL on failure */
+SRSRAN_API void* srsran_huge_malloc(size_t size);
+
+/* Releases memory returned by srsran_huge_malloc() or by malloc() */
+SRSRAN_API void srsran_huge_free(void* ptr);
+
+SRSRAN_API void srsran_huge_pages_get_stats(srsran_huge_pages_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_HUGE_PAGES_H
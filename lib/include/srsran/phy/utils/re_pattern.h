@@ -29,6 +29,11 @@
  */
 #define SRSRAN_RE_PATTERN_LIST_SIZE 4
 
+/**
+ * @brief Maximum number of runs of contiguous RE in a symbol, reached when every other subcarrier is reserved
+ */
+#define SRSRAN_RE_PATTERN_MAX_RUNS (SRSRAN_NRE * SRSRAN_MAX_PRB_NR / 2)
+
 /**
  * @brief Characterizes a pattern in frequency-time domain in an NR slot resource grid
  */
@@ -48,6 +53,17 @@ typedef struct SRSRAN_API {
   uint32_t            count;                             ///< Number of RE patterns
 } srsran_re_pattern_list_t;
 
+/**
+ * @brief Available RE of a transmission in an OFDM symbol, as runs of contiguous subcarriers. It is compiled once from
+ * the reserved RE mask and the PRB allocation, and then maps the symbols with block copies instead of testing each RE
+ */
+typedef struct SRSRAN_API {
+  uint16_t k_begin[SRSRAN_RE_PATTERN_MAX_RUNS]; ///< First subcarrier of each run
+  uint16_t len[SRSRAN_RE_PATTERN_MAX_RUNS];     ///< Number of subcarriers of each run
+  uint32_t count;                               ///< Number of runs
+  uint32_t nof_re;                              ///< Total number of RE in the runs
+} srsran_re_pattern_runs_t;
+
 /**
  * @brief Calculates if a pattern matches a RE given a symbol l and a subcarrier k
  * @param list Provides a list of patterns
@@ -129,4 +145,38 @@ SRSRAN_API uint32_t srsran_re_pattern_list_count(const srsran_re_pattern_list_t*
                                                  uint32_t                        symbol_end,
                                                  const bool                      prb_mask[SRSRAN_MAX_PRB_NR]);
 
+/**
+ * @brief Compiles the available RE of a symbol into runs of contiguous subcarriers
+ * @param mask Reserved RE mask of the symbol, as given by srsran_re_pattern_list_to_symbol_mask()
+ * @param prb_mask Frequency domain resource block mask of the transmission
+ * @param nof_prb Number of resource blocks of the carrier
+ * @param[out] runs Resulting runs
+ */
+SRSRAN_API void srsran_re_pattern_mask_to_runs(const bool*               mask,
+                                               const bool                prb_mask[SRSRAN_MAX_PRB_NR],
+                                               uint32_t                  nof_prb,
+                                               srsran_re_pattern_runs_t* runs);
+
+/**
+ * @brief Writes consecutive symbols into the RE of the runs
+ * @param runs Runs of the symbol
+ * @param symbols Symbols to write
+ * @param[out] sf_symbol Resource grid of the OFDM symbol
+ * @return The number of symbols written
+ */
+SRSRAN_API uint32_t srsran_re_pattern_runs_put(const srsran_re_pattern_runs_t* runs,
+                                               const cf_t*                     symbols,
+                                               cf_t*                           sf_symbol);
+
+/**
+ * @brief Reads the RE of the runs into consecutive symbols
+ * @param runs Runs of the symbol
+ * @param sf_symbol Resource grid of the OFDM symbol
+ * @param[out] symbols Read symbols
+ * @return The number of symbols read
+ */
+SRSRAN_API uint32_t srsran_re_pattern_runs_get(const srsran_re_pattern_runs_t* runs,
+                                               const cf_t*                     sf_symbol,
+                                               cf_t*                           symbols);
+
 #endif // SRSRAN_RE_PATTERN_H
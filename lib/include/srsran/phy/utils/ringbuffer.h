@@ -39,6 +39,33 @@ typedef struct {
   pthread_cond_t  read_cvar;
 } srsran_ringbuffer_t;
 
+#define SRSRAN_RINGBUFFER_SPSC_CACHE_LINE 64
+
+/*
+ * Lock-free single-producer/single-consumer variant. The producer and the consumer each own a free running byte
+ * counter, kept in its own cache line, so the fast path of a transfer is a memcpy and an atomic store. The mutex and
+ * the condition variables are only taken when one side has to wait for the other (buffer empty or full).
+ */
+typedef struct {
+  // Producer side
+  uint64_t wr_count;
+  bool     writer_waiting;
+  uint8_t  _pad_wr[SRSRAN_RINGBUFFER_SPSC_CACHE_LINE - sizeof(uint64_t) - sizeof(bool)];
+
+  // Consumer side
+  uint64_t rd_count;
+  bool     reader_waiting;
+  uint8_t  _pad_rd[SRSRAN_RINGBUFFER_SPSC_CACHE_LINE - sizeof(uint64_t) - sizeof(bool)];
+
+  // Shared, written only on init, resize and stop
+  uint8_t*        buffer;
+  int             capacity;
+  bool            active;
+  pthread_mutex_t mutex;
+  pthread_cond_t  write_cvar;
+  pthread_cond_t  read_cvar;
+} srsran_ringbuffer_spsc_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -82,6 +109,41 @@ SRSRAN_API int srsran_ringbuffer_read_block(srsran_ringbuffer_t* q, void** p, in
 
 SRSRAN_API void srsran_ringbuffer_stop(srsran_ringbuffer_t* q);
 
+/*
+ * SPSC ring buffer. Only one thread may call the write functions and only one thread may call the read functions.
+ * Reset and resize must not race with either of them. Timeouts and return values follow the locked ring buffer.
+ */
+SRSRAN_API int srsran_ringbuffer_spsc_init(srsran_ringbuffer_spsc_t* q, int capacity);
+
+SRSRAN_API void srsran_ringbuffer_spsc_free(srsran_ringbuffer_spsc_t* q);
+
+SRSRAN_API void srsran_ringbuffer_spsc_reset(srsran_ringbuffer_spsc_t* q);
+
+SRSRAN_API int srsran_ringbuffer_spsc_status(srsran_ringbuffer_spsc_t* q);
+
+SRSRAN_API int srsran_ringbuffer_spsc_space(srsran_ringbuffer_spsc_t* q);
+
+SRSRAN_API int srsran_ringbuffer_spsc_resize(srsran_ringbuffer_spsc_t* q, int capacity);
+
+// write to the buffer immediately, if there isnt enough space it will overflow. A NULL ptr writes zeros
+SRSRAN_API int srsran_ringbuffer_spsc_write(srsran_ringbuffer_spsc_t* q, void* ptr, int nof_bytes);
+
+// block forever until there is enough space then write to buffer
+SRSRAN_API int srsran_ringbuffer_spsc_write_block(srsran_ringbuffer_spsc_t* q, void* ptr, int nof_bytes);
+
+// block for timeout_ms milliseconds, then either write to buffer if there is space or return an error without writing
+SRSRAN_API int
+srsran_ringbuffer_spsc_write_timed(srsran_ringbuffer_spsc_t* q, void* ptr, int nof_bytes, int32_t timeout_ms);
+
+// read from buffer, blocking until there is enough samples
+SRSRAN_API int srsran_ringbuffer_spsc_read(srsran_ringbuffer_spsc_t* q, void* ptr, int nof_bytes);
+
+// read from buffer, blocking for timeout_ms milliseconds until there is enough samples or return an error
+SRSRAN_API int
+srsran_ringbuffer_spsc_read_timed(srsran_ringbuffer_spsc_t* q, void* ptr, int nof_bytes, int32_t timeout_ms);
+
+SRSRAN_API void srsran_ringbuffer_spsc_stop(srsran_ringbuffer_spsc_t* q);
+
 #ifdef __cplusplus
 }
 #endif
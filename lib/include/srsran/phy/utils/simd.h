@@ -783,6 +783,30 @@ static inline void srsran_simd_cfi_storeu(cf_t* ptr, simd_cf_t simdreg)
 #endif /* LV_HAVE_AVX512 */
 }
 
+/* With AVX2, srsran_simd_cfi_load() and srsran_simd_cfi_store() leave the samples in the lane order of the unpack
+ * instructions, which is only fine while they are stored back interleaved. The following keep the samples in order, as
+ * the split loads and stores expect. */
+static inline simd_cf_t srsran_simd_cfi_loadu_ordered(const cf_t* ptr)
+{
+  simd_cf_t ret = srsran_simd_cfi_loadu(ptr);
+#if defined(LV_HAVE_AVX2) && !defined(LV_HAVE_AVX512)
+  __m256i idx = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+  ret.re      = _mm256_permutevar8x32_ps(ret.re, idx);
+  ret.im      = _mm256_permutevar8x32_ps(ret.im, idx);
+#endif /* defined(LV_HAVE_AVX2) && !defined(LV_HAVE_AVX512) */
+  return ret;
+}
+
+static inline void srsran_simd_cfi_storeu_ordered(cf_t* ptr, simd_cf_t simdreg)
+{
+#if defined(LV_HAVE_AVX2) && !defined(LV_HAVE_AVX512)
+  __m256i idx = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  simdreg.re  = _mm256_permutevar8x32_ps(simdreg.re, idx);
+  simdreg.im  = _mm256_permutevar8x32_ps(simdreg.im, idx);
+#endif /* defined(LV_HAVE_AVX2) && !defined(LV_HAVE_AVX512) */
+  srsran_simd_cfi_storeu(ptr, simdreg);
+}
+
 static inline void srsran_simd_cf_store(float* re, float* im, simd_cf_t simdreg)
 {
 #ifdef LV_HAVE_AVX512
@@ -1259,6 +1283,44 @@ static inline simd_i_t srsran_simd_i_add(simd_i_t a, simd_i_t b)
 #endif /* LV_HAVE_AVX512 */
 }
 
+static inline simd_i_t srsran_simd_i_sub(simd_i_t a, simd_i_t b)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_sub_epi32(a, b);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_sub_epi32(a, b);
+#else
+#ifdef LV_HAVE_SSE
+  return _mm_sub_epi32(a, b);
+#else
+#ifdef HAVE_NEON
+  return vsubq_s32(a, b);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+static inline simd_i_t srsran_simd_i_xor(simd_i_t a, simd_i_t b)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_xor_si512(a, b);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_xor_si256(a, b);
+#else
+#ifdef LV_HAVE_SSE
+  return _mm_xor_si128(a, b);
+#else
+#ifdef HAVE_NEON
+  return veorq_s32(a, b);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
 static inline simd_i_t srsran_simd_i_mul(simd_i_t a, simd_i_t b)
 {
 #ifdef LV_HAVE_AVX512
@@ -1584,6 +1646,63 @@ static inline simd_s_t srsran_simd_s_sub(simd_s_t a, simd_s_t b)
 #endif /* LV_HAVE_AVX512 */
 }
 
+static inline simd_s_t srsran_simd_s_set1(int16_t x)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_set1_epi16(x);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_set1_epi16(x);
+#else /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_SSE
+  return _mm_set1_epi16(x);
+#else /* LV_HAVE_SSE */
+#ifdef HAVE_NEON
+  return vdupq_n_s16(x);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+static inline simd_s_t srsran_simd_s_max(simd_s_t a, simd_s_t b)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_max_epi16(a, b);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_max_epi16(a, b);
+#else /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_SSE
+  return _mm_max_epi16(a, b);
+#else /* LV_HAVE_SSE */
+#ifdef HAVE_NEON
+  return vmaxq_s16(a, b);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+static inline simd_s_t srsran_simd_s_min(simd_s_t a, simd_s_t b)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_min_epi16(a, b);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_min_epi16(a, b);
+#else /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_SSE
+  return _mm_min_epi16(a, b);
+#else /* LV_HAVE_SSE */
+#ifdef HAVE_NEON
+  return vminq_s16(a, b);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
 #endif /* SRSRAN_SIMD_S_SIZE */
 
 #if SRSRAN_SIMD_C16_SIZE
@@ -193,6 +193,7 @@ SRSRAN_API void srsran_vec_convert_fi(const float* x, const float scale, int16_t
 SRSRAN_API void srsran_vec_convert_conj_cs(const cf_t* x, const float scale, int16_t* z, const uint32_t len);
 SRSRAN_API void srsran_vec_convert_if(const int16_t* x, const float scale, float* z, const uint32_t len);
 SRSRAN_API void srsran_vec_convert_fb(const float* x, const float scale, int8_t* z, const uint32_t len);
+SRSRAN_API void srsran_vec_convert_bf(const int8_t* x, const float scale, float* z, const uint32_t len);
 
 SRSRAN_API void srsran_vec_lut_sss(const short* x, const unsigned short* lut, short* y, const uint32_t len);
 SRSRAN_API void srsran_vec_lut_bbb(const int8_t* x, const unsigned short* lut, int8_t* y, const uint32_t len);
@@ -214,6 +215,9 @@ SRSRAN_API void srsran_vec_prod_cfc(const cf_t* x, const float* y, cf_t* z, cons
 /* conjugate vector product (element-wise) */
 SRSRAN_API void srsran_vec_prod_conj_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t len);
 
+/* vector product (element-wise) scaled by a complex scalar, z = x * y * h */
+SRSRAN_API void srsran_vec_prod_sc_ccc(const cf_t* x, const cf_t* y, const cf_t h, cf_t* z, const uint32_t len);
+
 /* real vector product (element-wise) */
 SRSRAN_API void srsran_vec_prod_fff(const float* x, const float* y, float* z, const uint32_t len);
 SRSRAN_API void srsran_vec_prod_sss(const int16_t* x, const int16_t* y, int16_t* z, const uint32_t len);
@@ -365,6 +369,11 @@ SRSRAN_API void srsran_vec_interleave(const cf_t* x, const cf_t* y, cf_t* z, con
 
 SRSRAN_API void srsran_vec_interleave_add(const cf_t* x, const cf_t* y, cf_t* z, const int len);
 
+/* Converts between interleaved complex and split (SoA) complex, where real and imaginary parts are separate arrays */
+SRSRAN_API void srsran_vec_cf_to_split(const cf_t* x, float* re, float* im, const uint32_t len);
+
+SRSRAN_API void srsran_vec_split_to_cf(const float* re, const float* im, cf_t* z, const uint32_t len);
+
 SRSRAN_API cf_t srsran_vec_gen_sine(cf_t amplitude, float freq, cf_t* z, int len);
 
 SRSRAN_API void srsran_vec_apply_cfo(const cf_t* x, float cfo, cf_t* z, int len);
@@ -382,6 +391,39 @@ SRSRAN_API float srsran_vec_estimate_frequency(const cf_t* x, int len);
 SRSRAN_API void
 srsran_vec_gen_clip_env(const float* x_abs, const float thres, const float alpha, float* env, const int len);
 
+/*!
+ * @brief Extracts the peaks of a complex vector above an amplitude threshold, that is, the part of every sample that
+ * exceeds the threshold, x * (1 - thres / |x|), and zero for the samples below it. Subtracting the peaks from the
+ * vector results in clipping by the threshold.
+ * @param[in]  x      Signal to be clipped
+ * @param[in]  thres  Clipping threshold
+ * @param[out] peak   The extracted peaks
+ * @param[in]  len    Length of the vector.
+ */
+SRSRAN_API void srsran_vec_gen_clip_peak(const cf_t* x, const float thres, cf_t* peak, const int len);
+
+/*!
+ * @brief Calculates the peak and the average power of a complex vector in a single pass
+ * @param[in]  x        Input vector
+ * @param[out] max_pwr  Peak power, it can be NULL
+ * @param[in]  len      Vector length.
+ * @return The average power
+ */
+SRSRAN_API float srsran_vec_max_avg_power_cf(const cf_t* x, float* max_pwr, const uint32_t len);
+
+/*!
+ * @brief Element-wise product z = x * y that also calculates the peak and the average power of z, like
+ * srsran_vec_max_avg_power_cf(), without a second pass over the result
+ * @param[in]  x        First input vector
+ * @param[in]  y        Second input vector
+ * @param[out] z        Output vector, it can be x or y
+ * @param[out] max_pwr  Peak power, it can be NULL
+ * @param[in]  len      Vector length.
+ * @return The average power of z
+ */
+SRSRAN_API float
+srsran_vec_prod_ccc_max_avg_power(const cf_t* x, const cf_t* y, cf_t* z, float* max_pwr, const uint32_t len);
+
 /*!
  * @brief Calculates the PAPR of a complex vector
  * @param[in]  in  Input vector
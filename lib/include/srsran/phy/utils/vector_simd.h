@@ -90,8 +90,13 @@ SRSRAN_API void srsran_vec_prod_fff_simd(const float* x, const float* y, float*
 
 SRSRAN_API void srsran_vec_prod_ccc_simd(const cf_t* x, const cf_t* y, cf_t* z, const int len);
 
+SRSRAN_API float
+srsran_vec_prod_ccc_max_acc_power_simd(const cf_t* x, const cf_t* y, cf_t* z, float* max_pwr, const int len);
+
 SRSRAN_API void srsran_vec_prod_conj_ccc_simd(const cf_t* x, const cf_t* y, cf_t* z, const int len);
 
+SRSRAN_API void srsran_vec_prod_sc_ccc_simd(const cf_t* x, const cf_t* y, const cf_t h, cf_t* z, const int len);
+
 /* SIMD Division */
 SRSRAN_API void srsran_vec_div_ccc_simd(const cf_t* x, const cf_t* y, cf_t* z, const int len);
 
@@ -104,6 +109,8 @@ SRSRAN_API cf_t srsran_vec_dot_prod_conj_ccc_simd(const cf_t* x, const cf_t* y,
 
 SRSRAN_API cf_t srsran_vec_dot_prod_ccc_simd(const cf_t* x, const cf_t* y, const int len);
 
+SRSRAN_API cf_t srsran_vec_dot_prod_cfc_simd(const cf_t* x, const float* y, const int len);
+
 #ifdef ENABLE_C16
 SRSRAN_API c16_t srsran_vec_dot_prod_ccc_c16i_simd(const c16_t* x, const c16_t* y, const int len);
 #endif /* ENABLE_C16 */
@@ -115,6 +122,10 @@ SRSRAN_API void srsran_vec_abs_cf_simd(const cf_t* x, float* z, const int len);
 
 SRSRAN_API void srsran_vec_abs_square_cf_simd(const cf_t* x, float* z, const int len);
 
+SRSRAN_API float srsran_vec_max_acc_power_cf_simd(const cf_t* x, float* max_pwr, const int len);
+
+SRSRAN_API void srsran_vec_gen_clip_peak_simd(const cf_t* x, const float thres, cf_t* z, const int len);
+
 /* Other Functions */
 SRSRAN_API void srsran_vec_lut_sss_simd(const short* x, const unsigned short* lut, short* y, const int len);
 
@@ -132,6 +143,10 @@ SRSRAN_API void srsran_vec_interleave_simd(const cf_t* x, const cf_t* y, cf_t* z
 
 SRSRAN_API void srsran_vec_interleave_add_simd(const cf_t* x, const cf_t* y, cf_t* z, const int len);
 
+SRSRAN_API void srsran_vec_cf_to_split_simd(const cf_t* x, float* re, float* im, const int len);
+
+SRSRAN_API void srsran_vec_split_to_cf_simd(const float* re, const float* im, cf_t* z, const int len);
+
 SRSRAN_API cf_t srsran_vec_gen_sine_simd(cf_t amplitude, float freq, cf_t* z, int len);
 
 SRSRAN_API void srsran_vec_apply_cfo_simd(const cf_t* x, float cfo, cf_t* z, int len);
@@ -145,6 +160,10 @@ SRSRAN_API uint32_t srsran_vec_max_abs_fi_simd(const float* x, const int len);
 
 SRSRAN_API uint32_t srsran_vec_max_ci_simd(const cf_t* x, const int len);
 
+/* Name of the instruction set used by the functions above: "generic", "sse", "avx", "avx2", "avx512" or "neon". With
+ * ENABLE_SIMD_DISPATCH it is selected when the library is loaded, otherwise it is fixed at compile time. */
+SRSRAN_API const char* srsran_vec_simd_isa();
+
 #ifdef __cplusplus
 }
 #endif
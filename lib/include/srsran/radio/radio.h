@@ -32,6 +32,7 @@
 #include "srsran/srsran.h"
 
 #include <list>
+#include <memory>
 #include <string>
 
 #ifndef SRSRAN_RADIO_H
@@ -95,21 +96,45 @@ public:
   static void rf_msg_callback(void* arg, srsran_rf_error_t error);
 
 private:
-  std::vector<srsran_rf_t>                                rf_devices  = {};
-  std::vector<srsran_rf_info_t>                           rf_info     = {};
-  std::vector<int32_t>                                    rx_offset_n = {};
-  rf_metrics_t                                            rf_metrics  = {};
-  std::mutex                                              metrics_mutex;
-  srslog::basic_logger&                                   logger = srslog::fetch_basic_logger("RF", false);
-  phy_interface_radio*                                    phy    = nullptr;
-  std::vector<cf_t>                                       zeros;
-  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      dummy_buffers;
-  std::mutex                                              tx_mutex;
-  std::mutex                                              rx_mutex;
-  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      tx_buffer;
-  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      rx_buffer;
-  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> interpolators = {};
-  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> decimators    = {};
+  /// I/O timing of an RF device. The device clock is estimated from the RX calls, as the end of the last received
+  /// samples plus the samples still queued in the driver, so that the TX lead time does not need to query the device
+  struct dev_timing_t {
+    tprof_histogram       tx_lead{"tx_lead"};
+    tprof_histogram       rx_latency{"rx_latency"};
+    tprof_histogram       rx_backlog{"rx_backlog"};
+    std::atomic<uint32_t> nof_tx_late{0};
+    std::atomic<int64_t>  clock_offset_ns{0}; ///< device time minus steady clock time
+    std::atomic<bool>     clock_valid{false};
+    // Only accessed from the RX thread
+    int64_t last_rx_end_ns  = 0;
+    int64_t last_rx_wall_ns = 0;
+    int64_t backlog_ns      = 0;
+  };
+
+  void record_rx_timing(uint32_t                  device_idx,
+                        std::chrono::nanoseconds  call_duration,
+                        const srsran_timestamp_t* rxd_time,
+                        uint32_t                  nof_samples);
+  void record_tx_timing(uint32_t device_idx, const srsran_timestamp_t& tx_time);
+
+  std::vector<srsran_rf_t>                                 rf_devices  = {};
+  std::vector<srsran_rf_info_t>                            rf_info     = {};
+  std::vector<int32_t>                                     rx_offset_n = {};
+  std::vector<std::unique_ptr<dev_timing_t>>               dev_timing;
+  rf_metrics_t                                             rf_metrics  = {};
+  std::mutex                                               metrics_mutex;
+  srslog::basic_logger&                                    logger = srslog::fetch_basic_logger("RF", false);
+  phy_interface_radio*                                     phy    = nullptr;
+  std::vector<cf_t>                                        zeros;
+  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>       dummy_buffers;
+  std::mutex                                               tx_mutex;
+  std::mutex                                               rx_mutex;
+  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>       tx_buffer;
+  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>       rx_buffer;
+  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS>  interpolators = {};
+  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS>  decimators    = {};
+  std::array<srsran_resampler_poly_t, SRSRAN_MAX_CHANNELS> tx_resamplers = {}; ///< Used for non-integer ratios
+  std::array<srsran_resampler_poly_t, SRSRAN_MAX_CHANNELS> rx_resamplers = {}; ///< Used for non-integer ratios
   std::atomic<bool> decimator_busy = {false}; ///< Indicates the decimator is changing the rate
 
   rf_timestamp_t    end_of_burst_time = {};
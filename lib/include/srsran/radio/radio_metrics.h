@@ -22,13 +22,25 @@
 #ifndef SRSRAN_RADIO_METRICS_H
 #define SRSRAN_RADIO_METRICS_H
 
+#include "srsran/common/time_prof.h"
+#include <vector>
+
 namespace srsran {
 
+/// Timing of the I/O of an RF device over the metrics period
+struct rf_dev_timing_metrics_t {
+  tprof_histogram_metrics_t tx_lead;         ///< time from the TX call to the timestamp of its samples
+  tprof_histogram_metrics_t rx_latency;      ///< duration of the RX calls into the driver
+  tprof_histogram_metrics_t rx_backlog;      ///< samples queued in the driver when the RX calls return, in time
+  uint32_t                  nof_tx_late = 0; ///< TX calls whose timestamp had already passed
+};
+
 typedef struct {
-  uint32_t rf_o;
-  uint32_t rf_u;
-  uint32_t rf_l;
-  bool     rf_error;
+  uint32_t                             rf_o;
+  uint32_t                             rf_u;
+  uint32_t                             rf_l;
+  bool                                 rf_error;
+  std::vector<rf_dev_timing_metrics_t> dev; ///< one entry per RF device
 } rf_metrics_t;
 
 } // namespace srsran
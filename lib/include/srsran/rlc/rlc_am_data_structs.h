@@ -26,6 +26,7 @@
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/intrusive_list.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/byte_buffer_chain.h"
 #include <array>
 #include <list>
 #include <vector>
@@ -125,10 +126,13 @@ public:
   using iterator       = typename list_type::iterator;
   using const_iterator = typename list_type::const_iterator;
 
-  const uint32_t       rlc_sn     = invalid_rlc_sn;
-  uint32_t             retx_count = 0;
-  HeaderType           header     = {};
-  unique_byte_buffer_t buf        = nullptr;
+  /// PDU data field, made of references to the SDU segments it carries
+  using payload_type = byte_buffer_chain<8>;
+
+  const uint32_t rlc_sn     = invalid_rlc_sn;
+  uint32_t       retx_count = 0;
+  HeaderType     header     = {};
+  payload_type   buf;
 
   explicit rlc_amd_tx_pdu(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
   rlc_amd_tx_pdu(const rlc_amd_tx_pdu&)           = delete;
@@ -496,7 +500,7 @@ public:
     if (queue.empty()) {
       return false;
     }
-    for (auto elem : queue) {
+    for (const auto& elem : queue) {
       if (elem.sn == sn) {
         return true;
       }
@@ -509,7 +513,7 @@ public:
     if (queue.empty()) {
       return false;
     }
-    for (auto elem : queue) {
+    for (const auto& elem : queue) {
       if (elem.sn == sn) {
         if (elem.overlaps(so)) {
           return true;
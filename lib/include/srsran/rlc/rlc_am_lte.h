@@ -89,6 +89,7 @@ private:
   int  build_retx_pdu(uint8_t* payload, uint32_t nof_bytes);
   int  build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_retx_lte_t retx);
   int  build_data_pdu(uint8_t* payload, uint32_t nof_bytes);
+  void append_sdu_segment(rlc_amd_tx_pdu<rlc_amd_pdu_header_t>& tx_pdu, uint32_t nof_bytes);
   void update_notification_ack_info(uint32_t rlc_sn);
 
   int  required_buffer_size(const rlc_amd_retx_lte_t& retx);
@@ -113,8 +114,8 @@ private:
 
   rlc_am_config_t cfg = {};
 
-  // TX SDU buffers
-  unique_byte_buffer_t tx_sdu;
+  // TX SDU buffers. The SDU is shared with the PDUs in the tx window that reference its segments
+  shared_byte_buffer_t tx_sdu;
 
   /****************************************************************************
    * State variables and counters
@@ -185,7 +186,16 @@ private:
   void handle_data_pdu(uint8_t* payload, uint32_t nof_bytes) final;
   void handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header);
   void handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header);
+  void update_rx_state(const rlc_amd_pdu_header_t& header);
+  void reassemble_in_sequence_pdu(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header);
   void reassemble_rx_sdus();
+  bool reassemble_pdu(uint8_t*&                                      msg,
+                      uint32_t&                                      nof_bytes,
+                      const rlc_amd_pdu_header_t&                    header,
+                      std::chrono::high_resolution_clock::time_point rx_time);
+  bool alloc_rx_sdu();
+  void deliver_rx_sdu();
+  void advance_rx_window();
   bool inside_rx_window(const int16_t sn);
   void debug_state();
   void print_rx_segments();
@@ -221,8 +231,8 @@ private:
   std::mutex mutex;
 
   // Rx windows
-  rlc_ringbuffer_t<rlc_amd_rx_pdu, RLC_AM_WINDOW_SIZE> rx_window;
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>        rx_segments;
+  rlc_ringbuffer_t<rlc_amd_rx_pdu, RLC_AM_WINDOW_SIZE>            rx_window;
+  rlc_ringbuffer_t<rlc_amd_rx_pdu_segments_t, RLC_AM_WINDOW_SIZE> rx_segments;
 
   bool              poll_received = false;
   std::atomic<bool> do_status     = {false}; // light-weight access from Tx entity
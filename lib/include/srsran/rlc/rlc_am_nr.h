@@ -22,6 +22,7 @@
 #ifndef SRSRAN_RLC_AM_NR_H
 #define SRSRAN_RLC_AM_NR_H
 
+#include "srsran/adt/bounded_bitset.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/timers.h"
@@ -86,6 +87,7 @@ struct rlc_amd_tx_pdu_nr {
   rlc_am_nr_pdu_header_t header     = {};
   unique_byte_buffer_t   sdu_buf    = nullptr;
   uint32_t               retx_count = RETX_COUNT_NOT_STARTED;
+  uint32_t               nof_queued_retx = 0; ///< Number of entries of this SDU in the retx_queue
   struct pdu_segment {
     uint32_t so          = 0;
     uint32_t payload_len = 0;
@@ -104,7 +106,7 @@ public:
   bool     configure(const rlc_config_t& cfg_) final;
   uint32_t read_pdu(uint8_t* payload, uint32_t nof_bytes) final;
   void     handle_control_pdu(uint8_t* payload, uint32_t nof_bytes) final;
-  void     handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>& retx_sn_set);
+  void     handle_nack(const rlc_status_nack_t& nack, std::vector<uint32_t>& retx_sn_list);
 
   void reestablish() final;
   void stop() final;
@@ -168,6 +170,9 @@ private:
   uint32_t         sdu_under_segmentation_sn = INVALID_RLC_SN; // SN of the SDU currently being segmented.
   pdcp_sn_vector_t notify_info_vec;
 
+  // SNs scheduled for retransmission by the last status PDU, in NACK order
+  std::vector<uint32_t> retx_sn_list;
+
   // Helper constants
   uint32_t min_hdr_size = 2; // Pre-initialized for 12 bit SN, updated by configure()
   uint32_t so_size      = 2;
@@ -252,7 +257,7 @@ public:
   bool inside_rx_window(uint32_t sn) const;
   bool valid_ack_sn(uint32_t sn) const;
   void write_to_upper_layers(uint32_t lcid, unique_byte_buffer_t sdu);
-  void insert_received_segment(rlc_amd_rx_pdu_nr segment, rlc_amd_rx_sdu_nr_t::segment_list_t& segment_list) const;
+  bool insert_received_segment(rlc_amd_rx_sdu_nr_t& rx_sdu, uint32_t so, const uint8_t* data, uint32_t len) const;
   /**
    * @brief update_segment_inventory This function updates the flags has_gap and fully_received of an SDU
    * according to the current inventory of received SDU segments
@@ -281,6 +286,15 @@ private:
 
   // RX Window
   std::unique_ptr<rlc_ringbuffer_base<rlc_amd_rx_sdu_nr_t> > rx_window;
+  // Fully received SDUs of the RX window, indexed by SN modulo the window size
+  std::unique_ptr<bounded_bitset<am_window_size(rlc_am_nr_sn_size_t::size18bits)> > rx_sdu_complete;
+
+  // Length of the status PDU, kept until the RX state changes
+  uint32_t status_pdu_len       = 0;
+  bool     status_pdu_len_valid = false;
+
+  uint32_t find_first_missing_sn(uint32_t start_sn, uint32_t end_sn) const;
+  void     build_status_pdu(rlc_am_nr_status_pdu_t* status) const;
 
   // Mutexes
   std::mutex mutex;
@@ -312,7 +326,11 @@ private:
 
 public:
   // Getters/Setters
-  void set_rx_state(const rlc_am_nr_rx_state_t& st_) { st = st_; }        // This should only be used for testing.
+  void set_rx_state(const rlc_am_nr_rx_state_t& st_) // This should only be used for testing.
+  {
+    st                   = st_;
+    status_pdu_len_valid = false;
+  }
   rlc_am_nr_rx_state_t get_rx_state() { return st; }                      // This should only be used for testing.
   uint32_t             get_rx_window_size() { return rx_window->size(); } // This should only be used for testing.
 };
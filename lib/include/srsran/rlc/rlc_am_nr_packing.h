@@ -22,9 +22,9 @@
 #ifndef SRSRAN_RLC_AM_NR_PACKING_H
 #define SRSRAN_RLC_AM_NR_PACKING_H
 
+#include "srsran/adt/interval.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/rlc/rlc_am_base.h"
-#include <set>
 
 namespace srsran {
 
@@ -54,26 +54,18 @@ struct rlc_amd_pdu_nr_t {
   unique_byte_buffer_t   buf;
 };
 
-struct rlc_amd_rx_pdu_nr {
-  rlc_am_nr_pdu_header_t header = {};
-  unique_byte_buffer_t   buf    = nullptr;
-  uint32_t               rlc_sn = {};
-
-  rlc_amd_rx_pdu_nr() = default;
-  explicit rlc_amd_rx_pdu_nr(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
-};
-
-struct rlc_amd_rx_pdu_nr_cmp {
-  bool operator()(const rlc_amd_rx_pdu_nr& a, const rlc_amd_rx_pdu_nr& b) const { return a.header.so < b.header.so; }
-};
-
 struct rlc_amd_rx_sdu_nr_t {
-  uint32_t             rlc_sn         = 0;
-  bool                 fully_received = false;
-  bool                 has_gap        = false;
-  unique_byte_buffer_t buf;
-  using segment_list_t = std::set<rlc_amd_rx_pdu_nr, rlc_amd_rx_pdu_nr_cmp>;
-  segment_list_t segments;
+  /// Max number of disjoint byte ranges of a segmented SDU, segments that would need more ones are discarded
+  static const size_t max_segment_ranges = 8;
+
+  uint32_t             rlc_sn                = 0;
+  bool                 fully_received        = false;
+  bool                 has_gap               = false;
+  bool                 last_segment_received = false;
+  uint32_t             sdu_len               = 0; ///< SDU length, known once the last segment is received
+  unique_byte_buffer_t buf;                       ///< SDU, the segments are written at their SO as they arrive
+  using segment_list_t = bounded_interval_set<uint32_t, max_segment_ranges>;
+  segment_list_t segments; ///< byte ranges of the SDU received so far
 
   rlc_amd_rx_sdu_nr_t() = default;
   explicit rlc_amd_rx_sdu_nr_t(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
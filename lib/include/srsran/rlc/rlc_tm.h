@@ -83,8 +83,9 @@ private:
   std::mutex           metrics_mutex;
   rlc_bearer_metrics_t metrics = {};
 
-  // Thread-safe queues for MAC messages
+  // Lock-free queue for MAC messages. The mutex serializes its readers, read_pdu() and empty_queue()
   byte_buffer_queue ul_queue;
+  std::mutex        read_mutex;
 };
 
 } // namespace srsran
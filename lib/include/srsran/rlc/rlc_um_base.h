@@ -28,6 +28,7 @@
 #include "srsran/common/task_scheduler.h"
 #include "srsran/rlc/rlc_common.h"
 #include "srsran/upper/byte_buffer_queue.h"
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <pthread.h>
@@ -114,6 +115,9 @@ protected:
     byte_buffer_queue    tx_sdu_queue;
     unique_byte_buffer_t tx_sdu;
 
+    // Bytes left in tx_sdu, updated under the mutex so that get_buffer_state() does not have to take it
+    std::atomic<uint32_t> tx_sdu_bytes = {0};
+
     // Mutexes
     std::mutex mutex;
 
@@ -122,7 +126,7 @@ protected:
     srsran::rolling_average<double> mean_pdu_latency_us;
 #endif
 
-    virtual uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes) = 0;
+    virtual uint32_t build_data_pdu_impl(uint8_t* payload, uint32_t nof_bytes) = 0;
 
     // helper functions
     virtual void debug_state() = 0;
@@ -30,6 +30,7 @@
 #include <mutex>
 #include <pthread.h>
 #include <queue>
+#include <vector>
 
 namespace srsran {
 
@@ -57,13 +58,14 @@ private:
     rlc_um_lte_tx(rlc_um_base* parent_);
 
     bool     configure(const rlc_config_t& cfg, std::string rb_name);
-    uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes);
+    uint32_t build_data_pdu_impl(uint8_t* payload, uint32_t nof_bytes);
     void     discard_sdu(uint32_t discard_sn);
     uint32_t get_buffer_state();
     bool     sdu_queue_is_full();
 
   private:
     void reset();
+    void copy_sdu_segment(uint8_t** pdu_ptr, uint32_t nof_bytes);
 
     /****************************************************************************
      * State variables and counters
@@ -71,6 +73,9 @@ private:
      ***************************************************************************/
     uint32_t vt_us = 0; // Send state. SN to be assigned for next PDU.
 
+    // SDUs read from the queue while building a PDU, kept until they are copied into the MAC payload
+    std::vector<unique_byte_buffer_t> pdu_sdus;
+
     // Metrics
     void debug_state();
   };
@@ -128,6 +133,7 @@ void rlc_um_read_data_pdu_header(uint8_t*              payload,
                                  rlc_umd_sn_size_t     sn_size,
                                  rlc_umd_pdu_header_t* header);
 void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* pdu);
+void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, uint8_t** payload);
 
 uint32_t rlc_um_packed_length(rlc_umd_pdu_header_t* header);
 bool     rlc_um_start_aligned(uint8_t fi);
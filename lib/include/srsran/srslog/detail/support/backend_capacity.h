@@ -27,4 +27,24 @@
 #define SRSLOG_QUEUE_CAPACITY 8192
 #endif
 
+/// Maximum number of backend worker threads, each one with its own queue of
+/// SRSLOG_QUEUE_CAPACITY entries.
+#ifndef SRSLOG_MAX_BACKEND_WORKERS
+#define SRSLOG_MAX_BACKEND_WORKERS 8
+#endif
+
+#include <cstdint>
+
+namespace srslog {
+
+/// Number of log entries discarded because the backend ran out of capacity.
+struct backend_drop_stats {
+  /// Entries that did not fit in the queue of their backend worker.
+  uint64_t queue_full = 0;
+  /// Entries discarded because all the argument stores were in use.
+  uint64_t no_arg_store = 0;
+};
+
+} // namespace srslog
+
 #endif // SRSLOG_DETAIL_SUPPORT_BACKEND_CAPACITY_H
@@ -22,6 +22,7 @@
 #ifndef SRSLOG_DETAIL_SUPPORT_DYN_ARG_STORE_POOL_H
 #define SRSLOG_DETAIL_SUPPORT_DYN_ARG_STORE_POOL_H
 
+#include "srsran/adt/mpmc_queue.h"
 #include "srsran/srslog/bundled/fmt/printf.h"
 #include "srsran/srslog/detail/support/backend_capacity.h"
 
@@ -32,33 +33,26 @@ namespace detail {
 /// Keeps a pool of dynamic_format_arg_store objects. The main reason for this class is that the arg store objects are
 /// implemented with std::vectors, so we want to avoid allocating memory each time we create a new object. Instead,
 /// reserve memory for each vector during initialization and recycle the objects.
+/// The free objects are kept in a lock-free queue, so that allocating a store from the threads that generate log entries
+/// never blocks.
 class dyn_arg_store_pool
 {
 public:
-  dyn_arg_store_pool()
+  dyn_arg_store_pool() : free_list(SRSLOG_QUEUE_CAPACITY)
   {
     pool.resize(SRSLOG_QUEUE_CAPACITY);
     for (auto& elem : pool) {
       // Reserve for 10 normal and 2 named arguments.
       elem.reserve(10, 2);
-    }
-    free_list.reserve(SRSLOG_QUEUE_CAPACITY);
-    for (auto& elem : pool) {
-      free_list.push_back(&elem);
+      free_list.try_push(&elem);
     }
   }
 
   /// Returns a pointer to a free dyn arg store object, otherwise returns nullptr.
   fmt::dynamic_format_arg_store<fmt::printf_context>* alloc()
   {
-    scoped_lock lock(m);
-    if (free_list.empty()) {
-      return nullptr;
-    }
-
-    auto* p = free_list.back();
-    free_list.pop_back();
-
+    fmt::dynamic_format_arg_store<fmt::printf_context>* p = nullptr;
+    free_list.try_pop(p);
     return p;
   }
 
@@ -70,14 +64,12 @@ public:
     }
 
     p->clear();
-    scoped_lock lock(m);
-    free_list.push_back(p);
+    free_list.try_push(p);
   }
 
 private:
-  std::vector<fmt::dynamic_format_arg_store<fmt::printf_context> > pool;
-  std::vector<fmt::dynamic_format_arg_store<fmt::printf_context>*> free_list;
-  mutable mutex                                                    m;
+  std::vector<fmt::dynamic_format_arg_store<fmt::printf_context> >     pool;
+  srsran::mpmc_queue<fmt::dynamic_format_arg_store<fmt::printf_context>*> free_list;
 };
 
 } // namespace detail
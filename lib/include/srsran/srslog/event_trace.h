@@ -22,8 +22,13 @@
 #ifndef SRSLOG_EVENT_TRACE_H
 #define SRSLOG_EVENT_TRACE_H
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <string>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 namespace srslog {
 
@@ -51,6 +56,20 @@ void event_trace_init(log_channel& c);
 /// Returns true on success, otherwise false.
 bool event_trace_init(const std::string& filename, std::size_t capacity = 1024 * 1024);
 
+/// Initializes the hot path tracer. Each thread records its hot path events
+/// into its own ring buffer of events_per_thread entries, keeping the most
+/// recent ones, with timestamps taken from the CPU time stamp counter. Nothing
+/// is formatted or written until event_trace_hot_export() is called.
+/// Returns true on success, otherwise false.
+bool event_trace_hot_init(const std::string& filename, std::size_t events_per_thread = 64 * 1024);
+
+/// Stops the hot path tracer and writes the recorded events into the filename
+/// passed to event_trace_hot_init() in the Chrome trace event JSON format, that
+/// can be opened with Perfetto (ui.perfetto.dev) or chrome://tracing. It should
+/// be called after the traced threads have stopped.
+/// Returns true on success, otherwise false.
+bool event_trace_hot_export();
+
 #ifdef ENABLE_SRSLOG_EVENT_TRACE
 
 /// Generates the begin phase of a duration event.
@@ -70,6 +89,16 @@ void trace_duration_end(const std::string& category, const std::string& name);
 #define trace_threshold_complete_event(C, N, T)                                                                        \
   auto SRSLOG_TRACE_COMBINE(scoped_complete_event, __LINE__) = srslog::detail::scoped_complete_event(C, N, T)
 
+/// Generates a hot path event covering the enclosing scope. C and N must be
+/// string literals, only their addresses are stored.
+#define trace_hot_scope(C, N)                                                                                          \
+  srslog::detail::scoped_hot_event SRSLOG_TRACE_COMBINE(scoped_hot_event, __LINE__)("" C, "" N)
+
+/// Generates a hot path event covering the enclosing scope with an integer
+/// argument attached, e.g. the TTI.
+#define trace_hot_scope_arg(C, N, A)                                                                                   \
+  srslog::detail::scoped_hot_event SRSLOG_TRACE_COMBINE(scoped_hot_event, __LINE__)("" C, "" N, (A))
+
 #else
 
 /// No-ops.
@@ -77,6 +106,8 @@ void trace_duration_end(const std::string& category, const std::string& name);
 #define trace_duration_end(C, N)
 #define trace_complete_event(C, N)
 #define trace_threshold_complete_event(C, N, T)
+#define trace_hot_scope(C, N)
+#define trace_hot_scope_arg(C, N, A)
 
 #endif
 
@@ -101,6 +132,51 @@ private:
   std::chrono::microseconds                          threshold;
 };
 
+/// Set while the hot path tracer is recording.
+extern std::atomic<bool> hot_trace_enabled;
+
+/// Returns the current time in hot path tracer ticks.
+inline uint64_t hot_trace_now()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+/// Value of the argument of the hot path events that have none.
+constexpr int64_t hot_trace_no_arg = INT64_MIN;
+
+/// Stores a hot path event in the buffer of the calling thread.
+void hot_trace_record(const char* category, const char* name, uint64_t start, uint64_t end, int64_t arg);
+
+/// Scoped type object for implementing a hot path event.
+class scoped_hot_event
+{
+public:
+  scoped_hot_event(const char* cat, const char* n, int64_t arg = hot_trace_no_arg) :
+    category(cat), name(n), arg(arg), start(hot_trace_enabled.load(std::memory_order_relaxed) ? hot_trace_now() : 0)
+  {}
+
+  scoped_hot_event(const scoped_hot_event&) = delete;
+  scoped_hot_event& operator=(const scoped_hot_event&) = delete;
+
+  ~scoped_hot_event()
+  {
+    if (start != 0) {
+      hot_trace_record(category, name, start, hot_trace_now(), arg);
+    }
+  }
+
+private:
+  const char* const category;
+  const char* const name;
+  const int64_t     arg;
+  const uint64_t    start;
+};
+
 } // namespace detail
 
 } // namespace srslog
@@ -25,6 +25,7 @@
 #include "srsran/srslog/detail/support/error_string.h"
 #include "srsran/srslog/detail/support/memory_buffer.h"
 #include "srsran/srslog/formatter.h"
+#include <atomic>
 #include <cassert>
 
 namespace srslog {
@@ -51,8 +52,14 @@ public:
   /// Flushes any buffered contents to the backing store.
   virtual detail::error_string flush() = 0;
 
+  /// Index of the backend worker that writes into this sink, -1 until the
+  /// backend receives the first entry for it. All the entries of a sink go
+  /// through the same worker, so sinks need not be thread safe.
+  std::atomic<int>& backend_worker_index() { return worker_index; }
+
 private:
   std::unique_ptr<log_formatter> formatter;
+  std::atomic<int>               worker_index{-1};
 };
 
 } // namespace srslog
@@ -23,6 +23,7 @@
 #define SRSLOG_SRSLOG_H
 
 #include "srsran/srslog/detail/support/any.h"
+#include "srsran/srslog/detail/support/backend_capacity.h"
 #include "srsran/srslog/logger.h"
 #include "srsran/srslog/shared_types.h"
 
@@ -156,6 +157,11 @@ std::unique_ptr<log_formatter> create_text_formatter();
 /// Creates a new instance of a JSON formatter.
 std::unique_ptr<log_formatter> create_json_formatter();
 
+/// Creates a new instance of a binary formatter. Log entries are stored with
+/// their raw arguments instead of being formatted, the resulting file is turned
+/// into text offline with the srslog_decode tool.
+std::unique_ptr<log_formatter> create_binary_formatter();
+
 ///
 /// Sink management functions.
 ///
@@ -254,6 +260,17 @@ void flush();
 /// NOTE: This function should be called before init() and is NOT thread safe.
 void set_error_handler(error_handler handler);
 
+/// Sets the number of backend worker threads, one by default and at most
+/// SRSLOG_MAX_BACKEND_WORKERS. Each sink is written by a single worker, so
+/// more workers help when the log entries go to several sinks.
+/// NOTE: This function should be called before init() and before any log entry
+/// is generated, and is NOT thread safe.
+void set_backend_workers(unsigned nof_workers);
+
+/// Returns the number of log entries discarded so far because the backend ran
+/// out of capacity.
+backend_drop_stats get_backend_drop_stats();
+
 } // namespace srslog
 
 #endif // SRSLOG_SRSLOG_H
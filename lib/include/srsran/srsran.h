@@ -34,10 +34,12 @@ extern "C" {
 #include "srsran/config.h"
 #include "srsran/version.h"
 
+#include "srsran/phy/utils/bfp.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/cexptab.h"
 #include "srsran/phy/utils/convolution.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/huge_pages.h"
 #include "srsran/phy/utils/ringbuffer.h"
 #include "srsran/phy/utils/vector.h"
 
@@ -75,6 +77,7 @@ extern "C" {
 #include "srsran/phy/fec/turbo/tc_interl.h"
 #include "srsran/phy/fec/turbo/turbocoder.h"
 #include "srsran/phy/fec/turbo/turbodecoder.h"
+#include "srsran/phy/fec/turbo/turbodecoder_batch.h"
 
 #include "srsran/phy/io/binsource.h"
 #include "srsran/phy/io/filesink.h"
@@ -24,21 +24,40 @@
 
 #include <array>
 #include <cstdint>
+#include <string>
+#include <vector>
 
 namespace srsran {
 
-constexpr uint32_t metrics_max_supported_cpu = 32u;
+constexpr uint32_t metrics_max_supported_cpu        = 32u;
+constexpr uint32_t metrics_max_supported_numa_nodes = 8u;
+
+/// Hardware and scheduler counters of a thread of the process, counted over the last metrics period. The counters
+/// that are not available in the system are left at 0.
+struct sys_thread_metrics_t {
+  std::string name;
+  uint32_t    tid              = 0;
+  uint64_t    cycles           = 0;
+  uint64_t    instructions     = 0;
+  uint64_t    llc_misses       = 0;
+  uint64_t    context_switches = 0;
+};
 
 /// Metrics of cpu usage, memory consumption and number of thread used by the process.
 struct sys_metrics_t {
-  uint32_t                                     process_realmem_kB    = 0;
-  uint32_t                                     process_virtualmem_kB = 0;
-  float                                        process_realmem       = 0.f;
-  uint32_t                                     thread_count          = 0;
-  float                                        process_cpu_usage     = 0.f;
-  float                                        system_mem            = 0.f;
-  uint32_t                                     cpu_count             = 0;
-  std::array<float, metrics_max_supported_cpu> cpu_load              = {};
+  uint32_t                                               process_realmem_kB    = 0;
+  uint32_t                                               process_virtualmem_kB = 0;
+  float                                                  process_realmem       = 0.f;
+  uint32_t                                               thread_count          = 0;
+  float                                                  process_cpu_usage     = 0.f;
+  float                                                  system_mem            = 0.f;
+  uint32_t                                               cpu_count             = 0;
+  std::array<float, metrics_max_supported_cpu>           cpu_load              = {};
+  /// Resident memory of the process in each NUMA node, only filled in systems with several nodes
+  uint32_t                                               numa_node_count       = 0;
+  std::array<uint32_t, metrics_max_supported_numa_nodes> numa_node_mem_kB      = {};
+  /// Counters of each thread, only filled when the thread counters are enabled in the sys_metrics_processor
+  std::vector<sys_thread_metrics_t>                      threads;
 };
 
 } // namespace srsran
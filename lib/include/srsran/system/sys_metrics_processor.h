@@ -25,6 +25,7 @@
 #include "srsran/srslog/logger.h"
 #include "srsran/system/sys_metrics.h"
 #include <chrono>
+#include <map>
 #include <string>
 
 namespace srsran {
@@ -64,11 +65,30 @@ class sys_metrics_processor
     int32_t     softirq = 0;
   };
 
+  /// Counters of sys_thread_metrics_t read through perf_event_open
+  enum thread_counter_idx { cycles, instructions, llc_misses, context_switches, nof_thread_counters };
+
+  /// perf_event file descriptors of a thread, -1 for the counters that could not be opened.
+  struct thread_counters_t {
+    std::string                               name;
+    std::array<int, nof_thread_counters>      fds    = {-1, -1, -1, -1};
+    std::array<uint64_t, nof_thread_counters> last   = {};
+    bool                                      seen   = false;
+    bool                                      primed = false; ///< false until the first full period is counted
+  };
+
 public:
   explicit sys_metrics_processor(srslog::basic_logger& logger);
+  ~sys_metrics_processor();
+
   /// Measures and returns the system metrics.
   sys_metrics_t get_metrics();
 
+  /// Enables the per thread counters of cycles, instructions, LLC misses and context switches, which are read with
+  /// perf_event_open. The threads of the process are discovered at each measurement. Returns false if the counters are
+  /// not available, e.g. when forbidden by kernel.perf_event_paranoid.
+  bool enable_thread_counters();
+
 private:
   /// Calculates and returns the cpu usage in %. current_query is the most recent proc_stats_info, and
   /// delta_time_in_seconds is the elapsed time between the last measure and current in seconds. NOTE: Returns -1.0f on
@@ -79,6 +99,9 @@ private:
   /// NOTE: on error, metrics memory parameters are set to 0.
   void calculate_mem_usage(sys_metrics_t& metrics) const;
 
+  /// Calculates the resident memory of the process in each NUMA node and writes it in metrics.
+  void calculate_numa_mem_usage(sys_metrics_t& metrics) const;
+
   /// Calculate the cpu metrics and stores them in the given metrics. delta_time_in_seconds is the number of seconds
   /// elapsed since the last cpu metrics measurement.
   void calculate_cpu_metrics(sys_metrics_t& metrics, float delta_time_in_seconds);
@@ -86,11 +109,22 @@ private:
   /// Returns the cpu metrics from the given line.
   cpu_metrics_t read_cpu_idle_from_line(const std::string& line) const;
 
+  /// Attaches the counters to the new threads of the process, reads them and writes the counts of the period in
+  /// metrics.
+  void calculate_thread_metrics(sys_metrics_t& metrics);
+
+  /// Opens the counters of the given thread, returns false if none could be opened.
+  static bool open_thread_counters(uint32_t tid, thread_counters_t& counters);
+  static void close_thread_counters(thread_counters_t& counters);
+
 private:
   srslog::basic_logger&                              logger;
+  uint32_t                                           numa_node_count                            = 0;
   proc_stats_info                                    last_query                                 = {};
   cpu_metrics_t                                      last_cpu_thread[metrics_max_supported_cpu] = {};
-  std::chrono::time_point<std::chrono::steady_clock> last_query_time = std::chrono::steady_clock::now();
+  std::chrono::time_point<std::chrono::steady_clock> last_query_time         = std::chrono::steady_clock::now();
+  bool                                               thread_counters_enabled = false;
+  std::map<uint32_t, thread_counters_t>              thread_counters;
 };
 
 } // namespace srsran
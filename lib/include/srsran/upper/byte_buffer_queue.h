@@ -23,106 +23,224 @@
  * @file byte_buffer_queue.h
  *
  * @brief Queue of unique pointers to byte buffers used in PDCP and RLC TX queues.
- *        Uses a blocking queue with bounded capacity to block higher layers
- *        when pushing uplink traffic
+ *        Lock-free single-producer/single-consumer queue with bounded capacity. The
+ *        higher layer is blocked when pushing uplink traffic into a full queue.
  */
 
 #ifndef SRSRAN_BYTE_BUFFERQUEUE_H
 #define SRSRAN_BYTE_BUFFERQUEUE_H
 
-#include "srsran/adt/circular_buffer.h"
-#include "srsran/common/block_queue.h"
+#include "srsran/adt/expected.h"
 #include "srsran/common/byte_buffer.h"
 #include "srsran/common/common.h"
-#include <functional>
-#include <pthread.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
 
 namespace srsran {
 
+/**
+ * SDU queue between one producer (e.g. PDCP in the stack thread) and one consumer (e.g. RLC read_pdu() in the PHY
+ * workers). Writing, reading and querying the number of SDUs and bytes are lock-free: each side owns a free running
+ * index, kept in its own cache line, and the byte and SDU counters are atomics. The mutex and the condition variables
+ * are only used when the blocking write()/read() have to wait for the other side.
+ *
+ * The slots between the read and write indexes belong to the consumer, so apply_first() and size_tail_bytes() must be
+ * serialized with read()/try_read() by the caller. resize() must not race with either side.
+ */
 class byte_buffer_queue
 {
 public:
-  byte_buffer_queue(int capacity = 128) :
-    queue(capacity, push_callback(unread_bytes, n_sdus), pop_callback(unread_bytes, n_sdus))
-  {}
+  byte_buffer_queue(int capacity = 128) { resize(capacity); }
 
-  void write(unique_byte_buffer_t msg) { queue.push_blocking(std::move(msg)); }
+  /// Pushes an SDU, blocking while the queue is full
+  void write(unique_byte_buffer_t msg)
+  {
+    while (is_full()) {
+      wait(writer_waiting, [this]() { return not is_full(); });
+    }
+    push(std::move(msg));
+  }
 
+  /// Pushes an SDU if the queue is not full, otherwise the SDU is returned as error
   srsran::error_type<unique_byte_buffer_t> try_write(unique_byte_buffer_t&& msg)
   {
-    return queue.try_push(std::move(msg));
+    if (is_full()) {
+      return std::move(msg);
+    }
+    push(std::move(msg));
+    return {};
   }
 
-  unique_byte_buffer_t read() { return queue.pop_blocking(); }
-
-  bool try_read(unique_byte_buffer_t* msg) { return queue.try_pop(*msg); }
-
-  void     resize(uint32_t capacity) { queue.set_size(capacity); }
-  uint32_t size() { return (uint32_t)queue.size(); }
-  uint32_t get_n_sdus() { return n_sdus; }
+  /// Pops an SDU, blocking while the queue is empty. The SDU is nullptr if it was discarded with apply_first()
+  unique_byte_buffer_t read()
+  {
+    while (is_empty()) {
+      wait(reader_waiting, [this]() { return not is_empty(); });
+    }
+    return pop();
+  }
 
-  uint32_t size_bytes() { return unread_bytes; }
+  bool try_read(unique_byte_buffer_t* msg)
+  {
+    if (is_empty()) {
+      return false;
+    }
+    *msg = pop();
+    return true;
+  }
 
-  uint32_t size_tail_bytes()
+  void resize(uint32_t capacity)
   {
-    uint32_t size_next = 0;
-    queue.try_call_on_front([&size_next](const unique_byte_buffer_t& front_val) {
-      if (front_val != nullptr) {
-        size_next += front_val->N_bytes;
+    uint32_t nof_slots = 1;
+    while (nof_slots < capacity) {
+      nof_slots <<= 1;
+    }
+    if (nof_slots != slots.size()) {
+      std::vector<unique_byte_buffer_t> new_slots(nof_slots);
+      uint64_t                          rd    = rd_idx.load(std::memory_order_relaxed);
+      uint64_t                          count = wr_idx.load(std::memory_order_relaxed) - rd;
+      for (uint64_t i = 0; i < count; ++i) {
+        new_slots[i] = std::move(slots[(rd + i) & mask]);
       }
-    });
-    return size_next;
+      slots = std::move(new_slots);
+      mask  = nof_slots - 1;
+      rd_idx.store(0, std::memory_order_relaxed);
+      wr_idx.store(count, std::memory_order_relaxed);
+    }
+    max_size = capacity;
+  }
+
+  /// Number of queued SDUs, including the ones discarded with apply_first()
+  uint32_t size() const
+  {
+    uint64_t rd = rd_idx.load(std::memory_order_acquire);
+    return (uint32_t)(wr_idx.load(std::memory_order_acquire) - rd);
   }
 
-  // This is a hack to reset N_bytes counter when queue is corrupted (see line 89)
-  void reset() { unread_bytes = 0; }
+  /// Number of queued SDUs that were not discarded
+  uint32_t get_n_sdus() const { return n_sdus.load(std::memory_order_relaxed); }
+
+  uint32_t size_bytes() const { return unread_bytes.load(std::memory_order_relaxed); }
+
+  uint32_t size_tail_bytes() const
+  {
+    if (is_empty()) {
+      return 0;
+    }
+    const unique_byte_buffer_t& front_val = slots[rd_idx.load(std::memory_order_relaxed) & mask];
+    return front_val != nullptr ? front_val->N_bytes : 0;
+  }
 
-  bool is_empty() { return queue.empty(); }
+  bool is_empty() const { return size() == 0; }
 
-  bool is_full() { return queue.full(); }
+  bool is_full() const { return size() >= max_size; }
 
+  /// Calls func on the queued SDUs, from the oldest, until it returns true. If func sets an SDU to nullptr, the SDU is
+  /// considered discarded and is no longer counted in get_n_sdus() and size_bytes()
   template <typename F>
   bool apply_first(const F& func)
   {
-    return queue.apply_first(func);
+    uint64_t rd = rd_idx.load(std::memory_order_relaxed);
+    uint64_t wr = wr_idx.load(std::memory_order_acquire);
+    for (uint64_t i = rd; i != wr; ++i) {
+      unique_byte_buffer_t& sdu     = slots[i & mask];
+      uint32_t              n_bytes = sdu != nullptr ? sdu->N_bytes : 0;
+      bool                  valid   = sdu != nullptr;
+      bool                  ret     = func(sdu);
+      if (valid and sdu == nullptr) {
+        sub_counters(n_bytes);
+      }
+      if (ret) {
+        return true;
+      }
+    }
+    return false;
   }
 
 private:
-  struct push_callback {
-    explicit push_callback(std::atomic<uint32_t>& unread_bytes_, std::atomic<uint32_t>& n_sdus_) :
-      unread_bytes(unread_bytes_), n_sdus(n_sdus_)
-    {}
-    void operator()(const unique_byte_buffer_t& msg)
-    {
+  static constexpr size_t cache_line_size = 64;
+  // Number of polls of the other side before falling back to the condition variable
+  static constexpr uint32_t spin_count = 128;
+
+  void push(unique_byte_buffer_t&& msg)
+  {
+    uint64_t wr = wr_idx.load(std::memory_order_relaxed);
+    // The counters are updated before the SDU is visible, so they never go below the size of the queued SDUs
+    if (msg != nullptr) {
       unread_bytes.fetch_add(msg->N_bytes, std::memory_order_relaxed);
       n_sdus.fetch_add(1, std::memory_order_relaxed);
     }
-    std::atomic<uint32_t>& unread_bytes;
-    std::atomic<uint32_t>& n_sdus;
-  };
-  struct pop_callback {
-    explicit pop_callback(std::atomic<uint32_t>& unread_bytes_, std::atomic<uint32_t>& n_sdus_) :
-      unread_bytes(unread_bytes_), n_sdus(n_sdus_)
-    {}
-    void operator()(const unique_byte_buffer_t& msg)
-    {
-      if (msg == nullptr) {
+    slots[wr & mask] = std::move(msg);
+    wr_idx.store(wr + 1, std::memory_order_release);
+    notify(reader_waiting);
+  }
+
+  unique_byte_buffer_t pop()
+  {
+    uint64_t             rd  = rd_idx.load(std::memory_order_relaxed);
+    unique_byte_buffer_t msg = std::move(slots[rd & mask]);
+    rd_idx.store(rd + 1, std::memory_order_release);
+    if (msg != nullptr) {
+      sub_counters(msg->N_bytes);
+    }
+    notify(writer_waiting);
+    return msg;
+  }
+
+  void sub_counters(uint32_t n_bytes)
+  {
+    unread_bytes.fetch_sub(n_bytes, std::memory_order_relaxed);
+    n_sdus.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  // The fence after the index store pairs with the fence after the waiting flag store in wait(), so either the waiter
+  // sees the new index or the notifier sees the flag
+  void notify(std::atomic<bool>& waiting)
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock(mutex);
+      cvar.notify_all();
+    }
+  }
+
+  template <typename Predicate>
+  void wait(std::atomic<bool>& waiting, const Predicate& ready)
+  {
+    for (uint32_t i = 0; i < spin_count; ++i) {
+      if (ready()) {
         return;
       }
-      // non-atomic update of both state variables
-      unread_bytes.fetch_sub(std::min(msg->N_bytes, unread_bytes.load(std::memory_order_relaxed)),
-                             std::memory_order_relaxed);
-      n_sdus.store(std::max(0, (int32_t)(n_sdus.load(std::memory_order_relaxed)) - 1), std::memory_order_relaxed);
     }
-    std::atomic<uint32_t>& unread_bytes;
-    std::atomic<uint32_t>& n_sdus;
-  };
-
-  std::atomic<uint32_t> unread_bytes = {0};
-  std::atomic<uint32_t> n_sdus       = {0};
+    std::unique_lock<std::mutex> lock(mutex);
+    waiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (not ready()) {
+      cvar.wait(lock);
+    }
+    waiting.store(false, std::memory_order_relaxed);
+  }
 
-public:
-  dyn_blocking_queue<unique_byte_buffer_t, push_callback, pop_callback> queue;
+  // Producer side
+  std::atomic<uint64_t> wr_idx{0};
+  std::atomic<bool>     writer_waiting{false};
+  uint8_t               pad_wr[cache_line_size - sizeof(std::atomic<uint64_t>) - sizeof(std::atomic<bool>)];
+
+  // Consumer side
+  std::atomic<uint64_t> rd_idx{0};
+  std::atomic<bool>     reader_waiting{false};
+  uint8_t               pad_rd[cache_line_size - sizeof(std::atomic<uint64_t>) - sizeof(std::atomic<bool>)];
+
+  // Shared
+  std::atomic<uint32_t>             unread_bytes{0};
+  std::atomic<uint32_t>             n_sdus{0};
+  std::vector<unique_byte_buffer_t> slots;
+  uint64_t                          mask     = 0;
+  uint32_t                          max_size = 0;
+  std::mutex                        mutex;
+  std::condition_variable           cvar;
 };
 
 } // namespace srsran
@@ -25,6 +25,7 @@
 #include "srsran/common/byte_buffer.h"
 #include "srsran/common/common.h"
 #include "srsran/srslog/srslog.h"
+#include <array>
 #include <stdint.h>
 
 namespace srsran {
@@ -72,6 +73,7 @@ namespace srsran {
 #define GTPU_EXT_HEADER_PDU_SESSION_CONTAINER 0x85
 
 #define GTPU_EXT_HEADER_PDU_SESSION_CONTAINER_LEN 4
+#define GTPU_EXT_HEADER_PDCP_PDU_NUMBER_LEN 4
 struct gtpu_header_t {
   uint8_t              flags             = 0;
   uint8_t              message_type      = 0;
@@ -83,10 +85,55 @@ struct gtpu_header_t {
   std::vector<uint8_t> ext_buffer;
 };
 
+/**
+ * Precomputed header of the G-PDUs sent on a tunnel. It holds the header with the PDCP PDU number extension header,
+ * the header without it is its first GTPU_BASE_HEADER_LEN bytes with the E flag cleared. Only the length and the PDCP
+ * SN change from one PDU to the next.
+ */
+struct gtpu_header_template_t {
+  std::array<uint8_t, GTPU_EXTENDED_HEADER_LEN + GTPU_EXT_HEADER_PDCP_PDU_NUMBER_LEN> buffer = {};
+};
+
 bool gtpu_read_header(srsran::byte_buffer_t* pdu, gtpu_header_t* header, srslog::basic_logger& logger);
 bool gtpu_write_header(gtpu_header_t* header, srsran::byte_buffer_t* pdu, srslog::basic_logger& logger);
 void gtpu_ntoa(fmt::memory_buffer& buffer, uint32_t addr);
 
+/// Fills the G-PDU header template of a tunnel with the given remote TEID
+void gtpu_set_header_template(gtpu_header_template_t& hdr_template, uint32_t teid);
+
+/// Writes the G-PDU header of a tunnel in the headroom of the PDU, with the PDCP PDU number extension header if
+/// pdcp_sn >= 0. Same result as gtpu_write_header() for these headers. Returns false if there is no room for the header
+inline bool gtpu_write_header(const gtpu_header_template_t& hdr_template, srsran::byte_buffer_t* pdu, int pdcp_sn)
+{
+  if (pdcp_sn < 0) {
+    if (pdu->get_headroom() < GTPU_BASE_HEADER_LEN) {
+      return false;
+    }
+    uint16_t length = pdu->N_bytes;
+    pdu->msg -= GTPU_BASE_HEADER_LEN;
+    pdu->N_bytes += GTPU_BASE_HEADER_LEN;
+    memcpy(pdu->msg, hdr_template.buffer.data(), GTPU_BASE_HEADER_LEN);
+    pdu->msg[0] &= ~GTPU_FLAGS_EXTENDED_HDR;
+    pdu->msg[2] = (length >> 8u) & 0xffu;
+    pdu->msg[3] = length & 0xffu;
+    return true;
+  }
+
+  const uint32_t hdr_len = hdr_template.buffer.size();
+  if (pdu->get_headroom() < hdr_len) {
+    return false;
+  }
+  uint16_t length = pdu->N_bytes + hdr_len - GTPU_BASE_HEADER_LEN;
+  pdu->msg -= hdr_len;
+  pdu->N_bytes += hdr_len;
+  memcpy(pdu->msg, hdr_template.buffer.data(), hdr_len);
+  pdu->msg[2]                            = (length >> 8u) & 0xffu;
+  pdu->msg[3]                            = length & 0xffu;
+  pdu->msg[GTPU_EXTENDED_HEADER_LEN + 1] = (pdcp_sn >> 8u) & 0xffu;
+  pdu->msg[GTPU_EXTENDED_HEADER_LEN + 2] = pdcp_sn & 0xffu;
+  return true;
+}
+
 inline bool gtpu_supported_flags_check(gtpu_header_t* header, srslog::basic_logger& logger)
 {
   // flags
@@ -40,6 +40,7 @@ public:
 
   // Stack interface
   bool is_lcid_enabled(uint32_t lcid);
+  void set_crypto_pool(task_thread_pool* crypto_pool_);
 
   // RRC interface
   void reestablish() override;
@@ -84,6 +85,7 @@ private:
   srsue::gw_interface_pdcp*  gw     = nullptr;
   srsran::task_sched_handle  task_sched;
   srslog::basic_logger&      logger;
+  srsran::task_thread_pool*  crypto_pool = nullptr;
 
   using pdcp_map_t = std::map<uint16_t, std::unique_ptr<pdcp_entity_base> >;
   pdcp_map_t pdcp_array, pdcp_array_mrb;
@@ -33,6 +33,8 @@
 #include "srsran/interfaces/pdcp_interface_types.h"
 #include "srsran/upper/byte_buffer_queue.h"
 #include "srsran/upper/pdcp_metrics.h"
+#include <deque>
+#include <memory>
 
 namespace srsran {
 
@@ -118,6 +120,9 @@ public:
 
   void config_security(const as_security_config_t& sec_cfg_);
 
+  // Ciphers the TX PDUs of DRBs in the workers of the pool instead of the calling thread, nullptr to disable
+  void set_crypto_pool(task_thread_pool* crypto_pool_) { crypto_pool = crypto_pool_; }
+
   // GW/SDAP/RRC interface
   virtual void write_sdu(unique_byte_buffer_t sdu, int sn = -1) = 0;
 
@@ -169,12 +174,38 @@ protected:
 
   srsran::as_security_config_t sec_cfg = {};
 
+  // AES key schedules of the 128-EEA2/128-EIA2 keys, expanded once in config_security()
+  aes128_key_t k_rrc_enc_aes = {};
+  aes128_key_t k_up_enc_aes  = {};
+  aes128_key_t k_rrc_int_aes = {};
+  aes128_key_t k_up_int_aes  = {};
+
   // Security functions
   void integrity_generate(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
   bool integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
   void cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* ct);
   void cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t count, uint8_t* msg);
 
+  // Ciphering offload. The PDUs ciphered in the crypto pool are passed to the lower layers in the order they were
+  // submitted, and so are the PDUs passed with tx_pdu_in_order() while others are still being ciphered.
+  struct crypto_tx_pdu_t {
+    uint32_t             count;
+    unique_byte_buffer_t pdu; // nullptr while the PDU is being ciphered
+  };
+  using crypto_tx_queue_t = std::deque<crypto_tx_pdu_t>;
+  struct crypto_job_t;
+
+  task_thread_pool*                  crypto_pool     = nullptr;
+  std::shared_ptr<crypto_tx_queue_t> crypto_tx_queue = std::make_shared<crypto_tx_queue_t>();
+
+  bool crypto_offload_enabled() { return crypto_pool != nullptr && is_drb(); }
+  void cipher_encrypt_in_pool(unique_byte_buffer_t pdu, uint32_t count);
+  void tx_pdu_in_order(unique_byte_buffer_t pdu, uint32_t count);
+  void crypto_tx_pdu_done(uint32_t count, unique_byte_buffer_t pdu);
+
+  // Passes a TX PDU to the lower layers
+  virtual void write_lower_layers(unique_byte_buffer_t pdu) = 0;
+
   // Common packing functions
   bool            is_control_pdu(const unique_byte_buffer_t& pdu);
   pdcp_pdu_type_t get_control_pdu_type(const unique_byte_buffer_t& pdu);
@@ -29,6 +29,7 @@
 #include "srsran/common/threads.h"
 #include "srsran/interfaces/ue_rrc_interfaces.h"
 #include "srsran/upper/pdcp_entity_base.h"
+#include <deque>
 
 namespace srsue {
 
@@ -42,7 +43,9 @@ namespace srsran {
 class undelivered_sdus_queue
 {
 public:
-  explicit undelivered_sdus_queue(srsran::task_sched_handle task_sched, uint32_t sn_mod);
+  undelivered_sdus_queue(srsran::task_sched_handle             task_sched,
+                         uint32_t                              sn_mod,
+                         srsran::move_callback<void(uint32_t)> discard_callback_);
 
   bool            empty() const { return count == 0; }
   bool            is_full() const { return count >= capacity; }
@@ -56,10 +59,7 @@ public:
   // Getter for the number of discard timers. Used for debugging.
   size_t nof_discard_timers() const;
 
-  bool add_sdu(uint32_t                              sn,
-               const srsran::unique_byte_buffer_t&   sdu,
-               uint32_t                              discard_timeout,
-               srsran::move_callback<void(uint32_t)> callback);
+  bool add_sdu(uint32_t sn, const srsran::unique_byte_buffer_t& sdu, uint32_t discard_timeout);
 
   unique_byte_buffer_t& operator[](uint32_t sn)
   {
@@ -88,14 +88,35 @@ private:
 
   struct sdu_data {
     srsran::unique_byte_buffer_t sdu;
-    srsran::unique_timer         discard_timer;
+    uint32_t                     discard_id = 0; // Entry of the discard queue, 0 if the SDU has no discard timeout
   };
 
+  // The discard timeout is the same for all the SDUs, so they expire in the order they were added. The deadlines are
+  // kept in a FIFO, in ms since discard_time_base, and a single timer is armed for the oldest one. The entries of the
+  // SDUs cleared before their deadline are removed lazily.
+  struct discard_entry_t {
+    uint32_t sn;
+    uint32_t discard_id;
+    uint32_t deadline;
+  };
+
+  bool     is_discard_pending(const discard_entry_t& entry) const;
+  void     pop_stale_discards();
+  uint32_t discard_time_now() const { return discard_time_base + discard_timer.time_elapsed(); }
+  void     handle_discard_timer();
+
   uint32_t                                   count = 0;
   uint32_t                                   bytes = 0;
   uint32_t                                   fms   = 0; // SN of the first missing PDCP SDU
   uint32_t                                   lms   = 0;
   srsran::circular_array<sdu_data, capacity> sdus;
+
+  std::deque<discard_entry_t>           discard_queue;
+  srsran::unique_timer                  discard_timer;
+  srsran::move_callback<void(uint32_t)> discard_callback;
+  uint32_t                              discard_time_base = 0;
+  uint32_t                              next_discard_id   = 1;
+  uint32_t                              nof_discards      = 0; // Number of SDUs waiting for their discard timeout
 };
 
 /****************************************************************************
@@ -166,6 +187,8 @@ private:
   uint32_t reordering_window = 0;
   uint32_t maximum_pdcp_sn   = 0;
 
+  void write_lower_layers(unique_byte_buffer_t pdu) override;
+
   // PDU handlers
   void handle_control_pdu(srsran::unique_byte_buffer_t pdu);
   void handle_srb_pdu(srsran::unique_byte_buffer_t pdu);
@@ -206,16 +229,11 @@ private:
 class pdcp_entity_lte::discard_callback
 {
 public:
-  discard_callback(pdcp_entity_lte* parent_, uint32_t sn_)
-  {
-    parent     = parent_;
-    discard_sn = sn_;
-  };
-  void operator()(uint32_t timer_id);
+  discard_callback(pdcp_entity_lte* parent_) { parent = parent_; };
+  void operator()(uint32_t discard_sn);
 
 private:
   pdcp_entity_lte* parent;
-  uint32_t         discard_sn;
 };
 
 } // namespace srsran
@@ -32,7 +32,9 @@
 #include "srsran/interfaces/ue_gw_interfaces.h"
 #include "srsran/interfaces/ue_interfaces.h"
 #include "srsran/interfaces/ue_rlc_interfaces.h"
+#include <deque>
 #include <map>
+#include <vector>
 
 namespace srsran {
 /****************************************************************************
@@ -71,7 +73,7 @@ public:
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus() override { return {}; }
 
   // State variable getters (useful for testing)
-  uint32_t nof_discard_timers() { return discard_timers_map.size(); }
+  uint32_t nof_discard_timers() { return nof_pending_discards; }
   bool     is_reordering_timer_running() { return reordering_timer.is_running(); }
 
   // State variable setters (should be used only for testing)
@@ -95,12 +97,23 @@ private:
   uint32_t rx_deliv = 0; // COUNT value of first SDU not delivered to upper layers, but still waited for.
   uint32_t rx_reord = 0; // COUNT value following the COUNT value of PDCP Data PDU which triggered t-Reordering.
 
+  void write_lower_layers(unique_byte_buffer_t pdu) override;
+
   // Constants: 3GPP TS 38.323 v15.2.0, section 7.2
   uint32_t window_size = 0;
 
   // Reordering Queue / Timers
-  std::map<uint32_t, unique_byte_buffer_t> reorder_queue;
-  timer_handler::unique_timer              reordering_timer;
+  // The received COUNTs are always in [RX_DELIV, RX_DELIV + Window_Size), so each one has its own slot in a ring of
+  // Window_Size entries indexed by COUNT modulo Window_Size
+  struct rx_pdu_t {
+    uint32_t             count = 0;
+    unique_byte_buffer_t pdu;
+  };
+  std::vector<rx_pdu_t>       reorder_queue;
+  timer_handler::unique_timer reordering_timer;
+
+  bool                 has_rx_pdu(uint32_t count) const;
+  unique_byte_buffer_t pop_rx_pdu(uint32_t count);
 
   // Pass to Upper Layers Helper function
   void deliver_all_consecutive_counts();
@@ -111,8 +124,21 @@ private:
   std::unique_ptr<reordering_callback> reordering_fnc;
 
   // Discard callback (discardTimer)
+  // All the SDUs have the same discardTimer, so they expire in the order they were written. A single timer is armed
+  // for the oldest pending SDU and the deadlines are kept in a FIFO, counted in ms since discard_time_base
   class discard_callback;
-  std::map<uint32_t, timer_handler::unique_timer> discard_timers_map;
+  struct discard_entry_t {
+    uint32_t count    = 0;
+    uint32_t deadline = 0;
+    bool     pending  = true;
+  };
+  std::deque<discard_entry_t> discard_queue;
+  timer_handler::unique_timer discard_timer;
+  uint32_t                    discard_time_base    = 0;
+  uint32_t                    nof_pending_discards = 0;
+
+  uint32_t discard_time_now() const;
+  void     pop_delivered_discards();
 
   // COUNT overflow protection
   bool tx_overflow = false;
@@ -142,16 +168,11 @@ private:
 class pdcp_entity_nr::discard_callback
 {
 public:
-  discard_callback(pdcp_entity_nr* parent_, uint32_t sn_)
-  {
-    parent     = parent_;
-    discard_sn = sn_;
-  };
+  discard_callback(pdcp_entity_nr* parent_) { parent = parent_; };
   void operator()(uint32_t timer_id);
 
 private:
   pdcp_entity_nr* parent;
-  uint32_t        discard_sn;
 };
 
 /*
@@ -150,28 +150,28 @@ SRSASN_CODE bit_ref::pack(uint64_t val, uint32_t n_bits)
     log_error("This method only supports packing up to 64 bits");
     return SRSASN_ERROR_ENCODE_FAIL;
   }
-  uint64_t mask;
-  while (n_bits > 0) {
-    if (ptr >= max_ptr) {
-      log_error("pack: Buffer size limit was achieved");
-      return SRSASN_ERROR_ENCODE_FAIL;
-    }
-    mask             = ((1ul << n_bits) - 1ul);
-    val              = val & mask;
-    uint8_t keepmask = ((uint8_t)-1) - (uint8_t)((1u << (8u - offset)) - 1u);
-    if ((uint32_t)(8 - offset) > n_bits) {
-      auto bit = static_cast<uint8_t>(val << (8u - offset - n_bits));
-      *ptr     = ((*ptr) & keepmask) + bit;
-      offset += n_bits;
-      n_bits = 0;
-    } else {
-      auto bit = static_cast<uint8_t>(val >> (n_bits - 8u + offset));
-      *ptr     = (*ptr & keepmask) + bit;
-      n_bits -= (8 - offset);
-      offset = 0;
-      ptr++;
-    }
+  if (n_bits == 0) {
+    return SRSASN_SUCCESS;
+  }
+  uint32_t end_bit = offset + n_bits;
+  if (end_bit > 64) {
+    // The field spans 9 octets, split it in two words
+    HANDLE_CODE(pack(val >> 32u, n_bits - 32));
+    return pack(val, 32);
+  }
+  uint32_t n_octets = (end_bit + 7) / 8;
+  if (ptr + n_octets > max_ptr) {
+    log_error("pack: Buffer size limit was achieved");
+    return SRSASN_ERROR_ENCODE_FAIL;
+  }
+  // Left-align the bits already written in the current octet and the new field in a 64-bit word
+  auto     keepmask = static_cast<uint8_t>(0xff00u >> offset);
+  uint64_t word     = ((uint64_t)(*ptr & keepmask) << 56u) | ((val & ((1ul << n_bits) - 1ul)) << (64u - end_bit));
+  for (uint32_t i = 0; i < n_octets; ++i) {
+    ptr[i] = static_cast<uint8_t>(word >> (56u - 8u * i));
   }
+  ptr += end_bit / 8;
+  offset = end_bit % 8;
   return SRSASN_SUCCESS;
 }
 
@@ -182,25 +182,33 @@ SRSASN_CODE unpack_bits(T& val, Ptr& ptr, uint8_t& offset, const uint8_t* max_pt
     log_error("This method only supports unpacking up to %d bits", (int)sizeof(T) * 8);
     return SRSASN_ERROR_DECODE_FAIL;
   }
-  val = 0;
-  while (n_bits > 0) {
-    if (ptr >= max_ptr) {
-      log_error("unpack_bits: Buffer size limit was achieved");
-      return SRSASN_ERROR_DECODE_FAIL;
-    }
-    if ((uint32_t)(8 - offset) > n_bits) {
-      uint8_t mask = (uint8_t)(1u << (8u - offset)) - (uint8_t)(1u << (8u - offset - n_bits));
-      val += ((uint32_t)((*ptr) & mask)) >> (8u - offset - n_bits);
-      offset += n_bits;
-      n_bits = 0;
-    } else {
-      auto mask = static_cast<uint8_t>((1u << (8u - offset)) - 1u);
-      val += static_cast<T>((*ptr) & mask) << (n_bits - 8 + offset);
-      n_bits -= 8 - offset;
-      offset = 0;
-      ptr++;
-    }
+  if (n_bits == 0) {
+    val = 0;
+    return SRSASN_SUCCESS;
   }
+  uint32_t end_bit = offset + n_bits;
+  if (end_bit > 64) {
+    // The field spans 9 octets, split it in two words
+    uint64_t hi = 0, lo = 0;
+    HANDLE_CODE(unpack_bits(hi, ptr, offset, max_ptr, n_bits - 32));
+    HANDLE_CODE(unpack_bits(lo, ptr, offset, max_ptr, 32));
+    val = static_cast<T>((hi << 32u) | lo);
+    return SRSASN_SUCCESS;
+  }
+  uint32_t n_octets = (end_bit + 7) / 8;
+  if (ptr + n_octets > max_ptr) {
+    val = 0;
+    log_error("unpack_bits: Buffer size limit was achieved");
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+  // Load the octets spanned by the field big-endian into a 64-bit word and extract it
+  uint64_t word = 0;
+  for (uint32_t i = 0; i < n_octets; ++i) {
+    word |= (uint64_t)ptr[i] << (56u - 8u * i);
+  }
+  val = static_cast<T>((word << offset) >> (64u - n_bits));
+  ptr += end_bit / 8;
+  offset = end_bit % 8;
   return SRSASN_SUCCESS;
 }
 
@@ -260,9 +268,12 @@ SRSASN_CODE bit_ref_impl<Ptr>::unpack_bytes(uint8_t* buf, uint32_t n_bytes)
       log_error("unpack_bytes (unaligned): Buffer size limit was achieved");
       return SRSASN_ERROR_DECODE_FAIL;
     }
+    // Each octet is made of the low bits of the current octet and the high bits of the next one
+    uint32_t lshift = offset, rshift = 8u - offset;
     for (uint32_t i = 0; i < n_bytes; ++i) {
-      HANDLE_CODE(unpack(buf[i], 8));
+      buf[i] = static_cast<uint8_t>((ptr[i] << lshift) | (ptr[i + 1] >> rshift));
     }
+    ptr += n_bytes;
   }
   return SRSASN_SUCCESS;
 }
@@ -314,7 +325,8 @@ SRSASN_CODE bit_ref::pack_bytes(const uint8_t* buf, uint32_t n_bytes)
   if (n_bytes == 0) {
     return SRSASN_SUCCESS;
   }
-  if (ptr + n_bytes >= max_ptr) {
+  // The unaligned case also writes the leading bits of the octet following the last one
+  if (ptr + n_bytes + (offset ? 1 : 0) > max_ptr) {
     log_error("pack_bytes: Buffer size limit was achieved");
     return SRSASN_ERROR_ENCODE_FAIL;
   }
@@ -323,9 +335,15 @@ SRSASN_CODE bit_ref::pack_bytes(const uint8_t* buf, uint32_t n_bytes)
     memcpy(ptr, buf, n_bytes);
     ptr += n_bytes;
   } else {
+    // Unaligned case, the octets are shifted into place keeping the bits already written in the current octet
+    uint32_t rshift = offset, lshift = 8u - offset;
+    uint8_t  carry  = static_cast<uint8_t>(*ptr & (0xffu << lshift));
     for (uint32_t i = 0; i < n_bytes; ++i) {
-      pack(buf[i], 8);
+      ptr[i] = carry | static_cast<uint8_t>(buf[i] >> rshift);
+      carry  = static_cast<uint8_t>(buf[i] << lshift);
     }
+    ptr += n_bytes;
+    *ptr = carry;
   }
   return SRSASN_SUCCESS;
 }
@@ -345,6 +363,44 @@ SRSASN_CODE bit_ref::align_bytes_zero()
   return SRSASN_SUCCESS;
 }
 
+/*********************
+     decode arena
+*********************/
+
+void* decode_arena::allocate_chunk(size_t sz, size_t alignment)
+{
+  // Reuse the heap chunks kept by reset() first
+  while (next_chunk < chunks.size()) {
+    prev_bytes += cur.nof_bytes_allocated();
+    chunk_t& chunk = chunks[next_chunk++];
+    cur            = srsran::linear_allocator(chunk.mem.get(), chunk.size);
+    void* p        = cur.allocate(sz, alignment);
+    if (p != nullptr) {
+      return p;
+    }
+  }
+  prev_bytes += cur.nof_bytes_allocated();
+  size_t new_size = std::max(chunk_size, sz + alignment);
+  chunks.push_back(chunk_t{std::unique_ptr<uint8_t[]>(new uint8_t[new_size]), new_size});
+  next_chunk = chunks.size();
+  cur        = srsran::linear_allocator(chunks.back().mem.get(), new_size);
+  return cur.allocate(sz, alignment);
+}
+
+void decode_arena::reset()
+{
+  prev_bytes = 0;
+  next_chunk = 0;
+  if (init_buf != nullptr) {
+    cur = srsran::linear_allocator(init_buf, init_buf_size);
+  } else if (not chunks.empty()) {
+    cur        = srsran::linear_allocator(chunks[0].mem.get(), chunks[0].size);
+    next_chunk = 1;
+  } else {
+    cur = srsran::linear_allocator();
+  }
+}
+
 /*********************
      ext packing
 *********************/
@@ -1021,9 +1077,7 @@ template <bool Al>
 SRSASN_CODE unbounded_octstring<Al>::pack(bit_ref& bref) const
 {
   HANDLE_CODE(pack_length(bref, size(), aligned));
-  for (uint32_t i = 0; i < size(); ++i) {
-    HANDLE_CODE(bref.pack(octets_[i], 8));
-  }
+  HANDLE_CODE(bref.pack_bytes(&octets_[0], size()));
   return SRSASN_SUCCESS;
 }
 
@@ -1033,9 +1087,7 @@ SRSASN_CODE unbounded_octstring<Al>::unpack(cbit_ref& bref)
   uint32_t len;
   HANDLE_CODE(unpack_length(len, bref, aligned));
   resize(len);
-  for (uint32_t i = 0; i < size(); ++i) {
-    HANDLE_CODE(bref.unpack(octets_[i], 8));
-  }
+  HANDLE_CODE(bref.unpack_bytes(&octets_[0], size()));
   return SRSASN_SUCCESS;
 }
 
@@ -1448,9 +1500,7 @@ varlength_field_pack_guard::~varlength_field_pack_guard()
   pack_length(brefstart, nof_bytes, align);
 
   // pack encoded bytes
-  for (uint32_t i = 0; i < nof_bytes; ++i) {
-    brefstart.pack((*buffer_ptr)[i], 8);
-  }
+  brefstart.pack_bytes(buffer_ptr->data(), nof_bytes);
   *bref_tracker = brefstart;
 }
 
@@ -1467,6 +1517,52 @@ varlength_field_unpack_guard::~varlength_field_unpack_guard()
   bref_tracker->unpack(pad, len * 8 - bref_tracker->distance(bref0));
 }
 
+/************************
+   AP PDU peek helpers
+************************/
+
+const uint32_t ap_pdu_peek_t::max_ies;
+
+SRSASN_CODE peek_ap_pdu(ap_pdu_peek_t& peek, const uint8_t* buf, uint32_t len)
+{
+  cbit_ref bref(buf, len);
+  bool     ext;
+  HANDLE_CODE(bref.unpack(ext, 1));
+  if (ext) {
+    log_error("peek_ap_pdu: PDU type extensions are not supported");
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+  HANDLE_CODE(bref.unpack(peek.pdu_type, 2));
+  HANDLE_CODE(unpack_integer(peek.proc_code, bref, 0u, 255u, false, true));
+  uint32_t crit;
+  HANDLE_CODE(bref.unpack(crit, 2));
+
+  // The message is an open type, whose protocol IEs are open types too
+  uint32_t msg_len;
+  HANDLE_CODE(unpack_length(msg_len, bref, true));
+  if (msg_len > (uint32_t)bref.distance_bytes_end()) {
+    log_error("peek_ap_pdu: Message length %d exceeds the PDU", msg_len);
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+  const uint8_t* msg_buf = buf + bref.distance_bytes();
+  cbit_ref       msg_bref(msg_buf, msg_len);
+  HANDLE_CODE(msg_bref.unpack(peek.msg_ext, 1));
+  HANDLE_CODE(unpack_length(peek.nof_ies, msg_bref, 0u, 65535u, true));
+  if (peek.nof_ies > ap_pdu_peek_t::max_ies) {
+    log_error("peek_ap_pdu: Messages with more than %d IEs are not supported", ap_pdu_peek_t::max_ies);
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+  for (uint32_t i = 0; i < peek.nof_ies; ++i) {
+    protocol_ie_ref_t& ie = peek.ies[i];
+    HANDLE_CODE(unpack_integer(ie.id, msg_bref, 0u, 65535u, false, true));
+    HANDLE_CODE(msg_bref.unpack(crit, 2));
+    HANDLE_CODE(unpack_length(ie.len, msg_bref, true));
+    ie.data = msg_buf + msg_bref.distance_bytes();
+    HANDLE_CODE(msg_bref.advance_bits(ie.len * 8));
+  }
+  return SRSASN_SUCCESS;
+}
+
 /*******************
     JsonWriter
 *******************/
@@ -0,0 +1,49 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/asn1/ngap_utils.h"
+
+namespace asn1 {
+namespace ngap {
+
+SRSASN_CODE peek_ngap_pdu(ngap_pdu_peek_t& peek, const uint8_t* buf, uint32_t len)
+{
+  HANDLE_CODE(peek_ap_pdu(peek, buf, len));
+
+  const protocol_ie_ref_t* ie = peek.find_ie(ASN1_NGAP_ID_AMF_UE_NGAP_ID);
+  peek.amf_ue_ngap_id_present = ie != nullptr;
+  if (peek.amf_ue_ngap_id_present) {
+    amf_ue_ngap_id_t id;
+    HANDLE_CODE(unpack_ie_value(id, *ie));
+    peek.amf_ue_ngap_id = id.value;
+  }
+  ie                          = peek.find_ie(ASN1_NGAP_ID_RAN_UE_NGAP_ID);
+  peek.ran_ue_ngap_id_present = ie != nullptr;
+  if (peek.ran_ue_ngap_id_present) {
+    ran_ue_ngap_id_t id;
+    HANDLE_CODE(unpack_ie_value(id, *ie));
+    peek.ran_ue_ngap_id = id.value;
+  }
+  return SRSASN_SUCCESS;
+}
+
+} // namespace ngap
+} // namespace asn1
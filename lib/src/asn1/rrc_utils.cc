@@ -711,6 +711,83 @@ void set_phy_cfg_t_enable_64qam(phy_cfg_t* cfg, const bool enabled)
   cfg->ul_cfg.pusch.enable_64qam = enabled;
 }
 
+void set_phy_cfg_t_drx_cfg(phy_cfg_t* cfg, const asn1::rrc::drx_cfg_c& asn1_type)
+{
+  cfg->drx_cfg = {};
+  if (asn1_type.type() != asn1::rrc::setup_e::setup) {
+    return;
+  }
+  const asn1::rrc::drx_cfg_c::setup_s_& drx = asn1_type.setup();
+
+  using cycle_types = asn1::rrc::drx_cfg_c::setup_s_::long_drx_cycle_start_offset_c_::types;
+
+  const auto& cycle_start_offset = drx.long_drx_cycle_start_offset;
+  cfg->drx_cfg.long_cycle        = cycle_start_offset.type().to_number();
+  switch (cycle_start_offset.type().value) {
+    case cycle_types::sf10:
+      cfg->drx_cfg.start_offset = cycle_start_offset.sf10();
+      break;
+    case cycle_types::sf20:
+      cfg->drx_cfg.start_offset = cycle_start_offset.sf20();
+      break;
+    case cycle_types::sf32:
+      cfg->drx_cfg.start_offset = cycle_start_offset.sf32();
+      break;
+    case cycle_types::sf40:
+      cfg->drx_cfg.start_offset = cycle_start_offset.sf40();
+      break;
+    case cycle_types::sf64:
+      cfg->drx_cfg.start_offset = cycle_start_offset.sf64();
+      break;
+    case cycle_types::sf80:
+      cfg->drx_cfg.start_offset = cycle_start_offset.sf80();
+      break;
+    case cycle_types::sf128:
+      cfg->drx_cfg.start_offset = cycle_start_offset.sf128();
+      break;
+    case cycle_types::sf160:
+      cfg->drx_cfg.start_offset = cycle_start_offset.sf160();
+      break;
+    case cycle_types::sf256:
+      cfg->drx_cfg.start_offset = cycle_start_offset.sf256();
+      break;
+    case cycle_types::sf320:
+      cfg->drx_cfg.start_offset = cycle_start_offset.sf320();
+      break;
+    case cycle_types::sf512:
+      cfg->drx_cfg.start_offset = cycle_start_offset.sf512();
+      break;
+    case cycle_types::sf640:
+      cfg->drx_cfg.start_offset = cycle_start_offset.sf640();
+      break;
+    case cycle_types::sf1024:
+      cfg->drx_cfg.start_offset = cycle_start_offset.sf1024();
+      break;
+    case cycle_types::sf1280:
+      cfg->drx_cfg.start_offset = cycle_start_offset.sf1280();
+      break;
+    case cycle_types::sf2048:
+      cfg->drx_cfg.start_offset = cycle_start_offset.sf2048();
+      break;
+    case cycle_types::sf2560:
+      cfg->drx_cfg.start_offset = cycle_start_offset.sf2560();
+      break;
+    default:
+      // Unknown cycle, keep DRX disabled
+      return;
+  }
+
+  cfg->drx_cfg.on_duration_timer = drx.on_dur_timer.to_number();
+  cfg->drx_cfg.inactivity_timer  = drx.drx_inactivity_timer.to_number();
+  cfg->drx_cfg.retx_timer        = drx.drx_retx_timer.to_number();
+  if (drx.short_drx_present) {
+    cfg->drx_cfg.short_cycle_enabled = true;
+    cfg->drx_cfg.short_cycle         = drx.short_drx.short_drx_cycle.to_number();
+    cfg->drx_cfg.short_cycle_timer   = drx.short_drx.drx_short_cycle_timer;
+  }
+  cfg->drx_cfg.enabled = true;
+}
+
 void set_phy_cfg_t_common_pusch(phy_cfg_t* cfg, const asn1::rrc::pusch_cfg_common_s& asn1_type)
 {
   /* PUSCH DMRS signal configuration */
@@ -52,5 +52,26 @@ uint32_t get_obj_id<protocol_ie_single_container_s<erab_to_be_modified_item_bear
   return obj->erab_to_be_modified_item_bearer_mod_req().erab_id;
 }
 
+SRSASN_CODE peek_s1ap_pdu(s1ap_pdu_peek_t& peek, const uint8_t* buf, uint32_t len)
+{
+  HANDLE_CODE(peek_ap_pdu(peek, buf, len));
+
+  const protocol_ie_ref_t* ie = peek.find_ie(ASN1_S1AP_ID_MME_UE_S1AP_ID);
+  peek.mme_ue_s1ap_id_present = ie != nullptr;
+  if (peek.mme_ue_s1ap_id_present) {
+    mme_ue_s1ap_id_t id;
+    HANDLE_CODE(unpack_ie_value(id, *ie));
+    peek.mme_ue_s1ap_id = id.value;
+  }
+  ie                          = peek.find_ie(ASN1_S1AP_ID_ENB_UE_S1AP_ID);
+  peek.enb_ue_s1ap_id_present = ie != nullptr;
+  if (peek.enb_ue_s1ap_id_present) {
+    enb_ue_s1ap_id_t id;
+    HANDLE_CODE(unpack_ie_value(id, *ie));
+    peek.enb_ue_s1ap_id = id.value;
+  }
+  return SRSASN_SUCCESS;
+}
+
 } // namespace s1ap
 } // namespace asn1
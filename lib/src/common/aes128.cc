@@ -0,0 +1,416 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/aes128.h"
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define AES128_HAVE_AESNI
+#include <wmmintrin.h>
+#elif defined(__aarch64__) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES))
+#define AES128_HAVE_ARMV8_CE
+#include <arm_neon.h>
+#endif
+
+/* Number of blocks of keystream generated at once in CTR mode */
+#define AES128_CTR_NOF_BLOCKS 32
+
+static const uint8_t sbox[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76, 0xca, 0x82, 0xc9,
+    0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0, 0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f,
+    0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15, 0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07,
+    0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75, 0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3,
+    0x29, 0xe3, 0x2f, 0x84, 0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58,
+    0xcf, 0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8, 0x51, 0xa3,
+    0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2, 0xcd, 0x0c, 0x13, 0xec, 0x5f,
+    0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73, 0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88,
+    0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb, 0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac,
+    0x62, 0x91, 0x95, 0xe4, 0x79, 0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a,
+    0xae, 0x08, 0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a, 0x70,
+    0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e, 0xe1, 0xf8, 0x98, 0x11,
+    0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf, 0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42,
+    0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16};
+
+static const uint8_t rcon[AES128_NOF_ROUNDS] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36};
+
+/*
+ * Portable implementation
+ */
+static inline uint8_t xtime(uint8_t x)
+{
+  return (uint8_t)((x << 1) ^ ((x & 0x80) ? 0x1b : 0x00));
+}
+
+static void aes128_encrypt_block_gen(const aes128_key_t* key, const uint8_t* in, uint8_t* out)
+{
+  uint8_t s[AES128_BLOCK_LEN];
+  uint8_t t[AES128_BLOCK_LEN];
+
+  for (uint32_t i = 0; i < AES128_BLOCK_LEN; i++) {
+    s[i] = in[i] ^ key->rk[0][i];
+  }
+
+  for (uint32_t r = 1; r <= AES128_NOF_ROUNDS; r++) {
+    // SubBytes and ShiftRows, the state is stored column by column
+    for (uint32_t c = 0; c < 4; c++) {
+      for (uint32_t row = 0; row < 4; row++) {
+        t[4 * c + row] = sbox[s[4 * ((c + row) % 4) + row]];
+      }
+    }
+
+    // MixColumns, except in the last round
+    if (r < AES128_NOF_ROUNDS) {
+      for (uint32_t c = 0; c < 4; c++) {
+        uint8_t* col = &t[4 * c];
+        uint8_t  a   = col[0] ^ col[1] ^ col[2] ^ col[3];
+        uint8_t  c0  = col[0];
+        col[0] ^= a ^ xtime(col[0] ^ col[1]);
+        col[1] ^= a ^ xtime(col[1] ^ col[2]);
+        col[2] ^= a ^ xtime(col[2] ^ col[3]);
+        col[3] ^= a ^ xtime(col[3] ^ c0);
+      }
+    }
+
+    for (uint32_t i = 0; i < AES128_BLOCK_LEN; i++) {
+      s[i] = t[i] ^ key->rk[r][i];
+    }
+  }
+
+  memcpy(out, s, AES128_BLOCK_LEN);
+}
+
+static void aes128_encrypt_blocks_gen(const aes128_key_t* key, const uint8_t* in, uint8_t* out, uint32_t nof_blocks)
+{
+  for (uint32_t i = 0; i < nof_blocks; i++) {
+    aes128_encrypt_block_gen(key, &in[i * AES128_BLOCK_LEN], &out[i * AES128_BLOCK_LEN]);
+  }
+}
+
+static void aes128_cbc_mac_gen(const aes128_key_t* key, uint8_t* state, const uint8_t* in, uint32_t nof_blocks)
+{
+  for (uint32_t i = 0; i < nof_blocks; i++) {
+    for (uint32_t j = 0; j < AES128_BLOCK_LEN; j++) {
+      state[j] ^= in[i * AES128_BLOCK_LEN + j];
+    }
+    aes128_encrypt_block_gen(key, state, state);
+  }
+}
+
+/*
+ * AES-NI implementation, compiled for the AES extension and selected at run time
+ */
+#ifdef AES128_HAVE_AESNI
+#define AES128_AESNI_TARGET __attribute__((target("sse2,aes")))
+
+AES128_AESNI_TARGET static inline __m128i aes128_encrypt_aesni(const __m128i* rk, __m128i b)
+{
+  b = _mm_xor_si128(b, rk[0]);
+  for (uint32_t r = 1; r < AES128_NOF_ROUNDS; r++) {
+    b = _mm_aesenc_si128(b, rk[r]);
+  }
+  return _mm_aesenclast_si128(b, rk[AES128_NOF_ROUNDS]);
+}
+
+AES128_AESNI_TARGET static void
+aes128_encrypt_blocks_aesni(const aes128_key_t* key, const uint8_t* in, uint8_t* out, uint32_t nof_blocks)
+{
+  __m128i rk[AES128_NOF_ROUNDS + 1];
+  for (uint32_t r = 0; r <= AES128_NOF_ROUNDS; r++) {
+    rk[r] = _mm_loadu_si128((const __m128i*)key->rk[r]);
+  }
+
+  // Four independent blocks are interleaved to hide the latency of the AES instructions
+  uint32_t i = 0;
+  for (; i + 4 <= nof_blocks; i += 4) {
+    const __m128i* src = (const __m128i*)&in[i * AES128_BLOCK_LEN];
+    __m128i*       dst = (__m128i*)&out[i * AES128_BLOCK_LEN];
+
+    __m128i b0 = _mm_xor_si128(_mm_loadu_si128(src + 0), rk[0]);
+    __m128i b1 = _mm_xor_si128(_mm_loadu_si128(src + 1), rk[0]);
+    __m128i b2 = _mm_xor_si128(_mm_loadu_si128(src + 2), rk[0]);
+    __m128i b3 = _mm_xor_si128(_mm_loadu_si128(src + 3), rk[0]);
+    for (uint32_t r = 1; r < AES128_NOF_ROUNDS; r++) {
+      b0 = _mm_aesenc_si128(b0, rk[r]);
+      b1 = _mm_aesenc_si128(b1, rk[r]);
+      b2 = _mm_aesenc_si128(b2, rk[r]);
+      b3 = _mm_aesenc_si128(b3, rk[r]);
+    }
+    _mm_storeu_si128(dst + 0, _mm_aesenclast_si128(b0, rk[AES128_NOF_ROUNDS]));
+    _mm_storeu_si128(dst + 1, _mm_aesenclast_si128(b1, rk[AES128_NOF_ROUNDS]));
+    _mm_storeu_si128(dst + 2, _mm_aesenclast_si128(b2, rk[AES128_NOF_ROUNDS]));
+    _mm_storeu_si128(dst + 3, _mm_aesenclast_si128(b3, rk[AES128_NOF_ROUNDS]));
+  }
+
+  for (; i < nof_blocks; i++) {
+    __m128i b = _mm_loadu_si128((const __m128i*)&in[i * AES128_BLOCK_LEN]);
+    _mm_storeu_si128((__m128i*)&out[i * AES128_BLOCK_LEN], aes128_encrypt_aesni(rk, b));
+  }
+}
+
+AES128_AESNI_TARGET static void
+aes128_cbc_mac_aesni(const aes128_key_t* key, uint8_t* state, const uint8_t* in, uint32_t nof_blocks)
+{
+  __m128i rk[AES128_NOF_ROUNDS + 1];
+  for (uint32_t r = 0; r <= AES128_NOF_ROUNDS; r++) {
+    rk[r] = _mm_loadu_si128((const __m128i*)key->rk[r]);
+  }
+
+  __m128i t = _mm_loadu_si128((const __m128i*)state);
+  for (uint32_t i = 0; i < nof_blocks; i++) {
+    t = aes128_encrypt_aesni(rk, _mm_xor_si128(t, _mm_loadu_si128((const __m128i*)&in[i * AES128_BLOCK_LEN])));
+  }
+  _mm_storeu_si128((__m128i*)state, t);
+}
+
+static bool aes128_aesni_supported()
+{
+  static const bool supported = []() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("aes") != 0;
+  }();
+  return supported;
+}
+#endif // AES128_HAVE_AESNI
+
+/*
+ * ARMv8 Cryptography Extension implementation, selected when the compiler targets it
+ */
+#ifdef AES128_HAVE_ARMV8_CE
+static inline uint8x16_t aes128_encrypt_armv8(const uint8x16_t* rk, uint8x16_t b)
+{
+  for (uint32_t r = 0; r < AES128_NOF_ROUNDS - 1; r++) {
+    b = vaesmcq_u8(vaeseq_u8(b, rk[r]));
+  }
+  return veorq_u8(vaeseq_u8(b, rk[AES128_NOF_ROUNDS - 1]), rk[AES128_NOF_ROUNDS]);
+}
+
+static void aes128_encrypt_blocks_armv8(const aes128_key_t* key, const uint8_t* in, uint8_t* out, uint32_t nof_blocks)
+{
+  uint8x16_t rk[AES128_NOF_ROUNDS + 1];
+  for (uint32_t r = 0; r <= AES128_NOF_ROUNDS; r++) {
+    rk[r] = vld1q_u8(key->rk[r]);
+  }
+
+  // Four independent blocks are interleaved to hide the latency of the AES instructions
+  uint32_t i = 0;
+  for (; i + 4 <= nof_blocks; i += 4) {
+    const uint8_t* src = &in[i * AES128_BLOCK_LEN];
+    uint8_t*       dst = &out[i * AES128_BLOCK_LEN];
+
+    uint8x16_t b0 = vld1q_u8(src + 0 * AES128_BLOCK_LEN);
+    uint8x16_t b1 = vld1q_u8(src + 1 * AES128_BLOCK_LEN);
+    uint8x16_t b2 = vld1q_u8(src + 2 * AES128_BLOCK_LEN);
+    uint8x16_t b3 = vld1q_u8(src + 3 * AES128_BLOCK_LEN);
+    for (uint32_t r = 0; r < AES128_NOF_ROUNDS - 1; r++) {
+      b0 = vaesmcq_u8(vaeseq_u8(b0, rk[r]));
+      b1 = vaesmcq_u8(vaeseq_u8(b1, rk[r]));
+      b2 = vaesmcq_u8(vaeseq_u8(b2, rk[r]));
+      b3 = vaesmcq_u8(vaeseq_u8(b3, rk[r]));
+    }
+    vst1q_u8(dst + 0 * AES128_BLOCK_LEN, veorq_u8(vaeseq_u8(b0, rk[AES128_NOF_ROUNDS - 1]), rk[AES128_NOF_ROUNDS]));
+    vst1q_u8(dst + 1 * AES128_BLOCK_LEN, veorq_u8(vaeseq_u8(b1, rk[AES128_NOF_ROUNDS - 1]), rk[AES128_NOF_ROUNDS]));
+    vst1q_u8(dst + 2 * AES128_BLOCK_LEN, veorq_u8(vaeseq_u8(b2, rk[AES128_NOF_ROUNDS - 1]), rk[AES128_NOF_ROUNDS]));
+    vst1q_u8(dst + 3 * AES128_BLOCK_LEN, veorq_u8(vaeseq_u8(b3, rk[AES128_NOF_ROUNDS - 1]), rk[AES128_NOF_ROUNDS]));
+  }
+
+  for (; i < nof_blocks; i++) {
+    vst1q_u8(&out[i * AES128_BLOCK_LEN], aes128_encrypt_armv8(rk, vld1q_u8(&in[i * AES128_BLOCK_LEN])));
+  }
+}
+
+static void aes128_cbc_mac_armv8(const aes128_key_t* key, uint8_t* state, const uint8_t* in, uint32_t nof_blocks)
+{
+  uint8x16_t rk[AES128_NOF_ROUNDS + 1];
+  for (uint32_t r = 0; r <= AES128_NOF_ROUNDS; r++) {
+    rk[r] = vld1q_u8(key->rk[r]);
+  }
+
+  uint8x16_t t = vld1q_u8(state);
+  for (uint32_t i = 0; i < nof_blocks; i++) {
+    t = aes128_encrypt_armv8(rk, veorq_u8(t, vld1q_u8(&in[i * AES128_BLOCK_LEN])));
+  }
+  vst1q_u8(state, t);
+}
+#endif // AES128_HAVE_ARMV8_CE
+
+/*
+ * Public functions
+ */
+bool aes128_is_accelerated()
+{
+#if defined(AES128_HAVE_AESNI)
+  return aes128_aesni_supported();
+#elif defined(AES128_HAVE_ARMV8_CE)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void aes128_encrypt_blocks(const aes128_key_t* key, const uint8_t* in, uint8_t* out, uint32_t nof_blocks)
+{
+#if defined(AES128_HAVE_AESNI)
+  if (aes128_aesni_supported()) {
+    aes128_encrypt_blocks_aesni(key, in, out, nof_blocks);
+    return;
+  }
+#elif defined(AES128_HAVE_ARMV8_CE)
+  aes128_encrypt_blocks_armv8(key, in, out, nof_blocks);
+  return;
+#endif
+  aes128_encrypt_blocks_gen(key, in, out, nof_blocks);
+}
+
+void aes128_cbc_mac(const aes128_key_t* key, uint8_t* state, const uint8_t* in, uint32_t nof_blocks)
+{
+#if defined(AES128_HAVE_AESNI)
+  if (aes128_aesni_supported()) {
+    aes128_cbc_mac_aesni(key, state, in, nof_blocks);
+    return;
+  }
+#elif defined(AES128_HAVE_ARMV8_CE)
+  aes128_cbc_mac_armv8(key, state, in, nof_blocks);
+  return;
+#endif
+  aes128_cbc_mac_gen(key, state, in, nof_blocks);
+}
+
+/* Derives a CMAC subkey, RFC 4493 Section 2.3 */
+static void aes128_cmac_subkey(const uint8_t* in, uint8_t* out)
+{
+  for (uint32_t i = 0; i < AES128_BLOCK_LEN - 1; i++) {
+    out[i] = (uint8_t)((in[i] << 1) | (in[i + 1] >> 7));
+  }
+  out[AES128_BLOCK_LEN - 1] = (uint8_t)(in[AES128_BLOCK_LEN - 1] << 1);
+  if (in[0] & 0x80) {
+    out[AES128_BLOCK_LEN - 1] ^= 0x87;
+  }
+}
+
+void aes128_set_key(aes128_key_t* key, const uint8_t* k)
+{
+  memcpy(key->rk[0], k, AES128_BLOCK_LEN);
+
+  for (uint32_t r = 1; r <= AES128_NOF_ROUNDS; r++) {
+    const uint8_t* prev = key->rk[r - 1];
+    uint8_t*       next = key->rk[r];
+
+    // RotWord, SubWord and Rcon of the last word of the previous round key
+    next[0] = prev[0] ^ sbox[prev[13]] ^ rcon[r - 1];
+    next[1] = prev[1] ^ sbox[prev[14]];
+    next[2] = prev[2] ^ sbox[prev[15]];
+    next[3] = prev[3] ^ sbox[prev[12]];
+    for (uint32_t i = 4; i < AES128_BLOCK_LEN; i++) {
+      next[i] = prev[i] ^ next[i - 4];
+    }
+  }
+
+  // CMAC subkeys from L = AES(K, 0)
+  uint8_t l[AES128_BLOCK_LEN] = {};
+  aes128_encrypt_blocks(key, l, l, 1);
+  aes128_cmac_subkey(l, key->k1);
+  aes128_cmac_subkey(key->k1, key->k2);
+}
+
+static inline void aes128_ctr_inc(uint8_t* nonce_cnt)
+{
+  for (int i = AES128_BLOCK_LEN - 1; i >= 0; i--) {
+    if (++nonce_cnt[i] != 0) {
+      break;
+    }
+  }
+}
+
+static inline void aes128_xor(const uint8_t* in, const uint8_t* ks, uint8_t* out, uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i++) {
+    out[i] = in[i] ^ ks[i];
+  }
+}
+
+void aes128_ctr(const aes128_key_t* key, uint8_t* nonce_cnt, const uint8_t* in, uint8_t* out, uint32_t len)
+{
+  uint8_t ks[AES128_CTR_NOF_BLOCKS * AES128_BLOCK_LEN];
+
+  while (len > 0) {
+    // Keystream of the next counter blocks
+    uint32_t nof_blocks = (len + AES128_BLOCK_LEN - 1) / AES128_BLOCK_LEN;
+    if (nof_blocks > AES128_CTR_NOF_BLOCKS) {
+      nof_blocks = AES128_CTR_NOF_BLOCKS;
+    }
+    for (uint32_t i = 0; i < nof_blocks; i++) {
+      memcpy(&ks[i * AES128_BLOCK_LEN], nonce_cnt, AES128_BLOCK_LEN);
+      aes128_ctr_inc(nonce_cnt);
+    }
+    aes128_encrypt_blocks(key, ks, ks, nof_blocks);
+
+    uint32_t n = nof_blocks * AES128_BLOCK_LEN < len ? nof_blocks * AES128_BLOCK_LEN : len;
+    aes128_xor(in, ks, out, n);
+    in += n;
+    out += n;
+    len -= n;
+  }
+}
+
+/* Encrypts the gathered counter blocks and ciphers the bytes of the jobs they belong to */
+static void aes128_ctr_batch_flush(const aes128_key_t* key,
+                                   uint8_t*            ks,
+                                   aes128_ctr_job_t**  block_job,
+                                   const uint32_t*     block_offset,
+                                   uint32_t            nof_blocks)
+{
+  aes128_encrypt_blocks(key, ks, ks, nof_blocks);
+  for (uint32_t i = 0; i < nof_blocks; i++) {
+    uint32_t o = block_offset[i];
+    uint32_t n = block_job[i]->len - o < AES128_BLOCK_LEN ? block_job[i]->len - o : AES128_BLOCK_LEN;
+    aes128_xor(&block_job[i]->in[o], &ks[i * AES128_BLOCK_LEN], &block_job[i]->out[o], n);
+  }
+}
+
+void aes128_ctr_batch(const aes128_key_t* key, aes128_ctr_job_t* jobs, uint32_t nof_jobs)
+{
+  uint8_t           ks[AES128_CTR_NOF_BLOCKS * AES128_BLOCK_LEN];
+  aes128_ctr_job_t* block_job[AES128_CTR_NOF_BLOCKS];
+  uint32_t          block_offset[AES128_CTR_NOF_BLOCKS];
+  uint32_t          nof_blocks = 0;
+
+  // The counter blocks of all the jobs are gathered, so short PDUs also fill the pipeline of the AES instructions
+  for (uint32_t j = 0; j < nof_jobs; j++) {
+    aes128_ctr_job_t* job = &jobs[j];
+    for (uint32_t offset = 0; offset < job->len; offset += AES128_BLOCK_LEN) {
+      memcpy(&ks[nof_blocks * AES128_BLOCK_LEN], job->nonce_cnt, AES128_BLOCK_LEN);
+      aes128_ctr_inc(job->nonce_cnt);
+      block_job[nof_blocks]    = job;
+      block_offset[nof_blocks] = offset;
+      nof_blocks++;
+
+      if (nof_blocks == AES128_CTR_NOF_BLOCKS) {
+        aes128_ctr_batch_flush(key, ks, block_job, block_offset, nof_blocks);
+        nof_blocks = 0;
+      }
+    }
+  }
+
+  if (nof_blocks > 0) {
+    aes128_ctr_batch_flush(key, ks, block_job, block_offset, nof_blocks);
+  }
+}
@@ -24,79 +24,66 @@
 #include "srsran/common/threads.h"
 
 namespace srsran {
-mac_pcap::mac_pcap() : mac_pcap_base() {}
+mac_pcap::mac_pcap() : mac_pcap_base(), writer("PCAP_WRITER_MAC") {}
 
 mac_pcap::~mac_pcap()
 {
   close();
 }
 
-uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_)
+uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_, const pcap_writer_args_t& args)
 {
   std::lock_guard<std::mutex> lock(mutex);
-  if (pcap_file != nullptr) {
+  if (writer.is_open()) {
     logger.error("PCAP writer for %s already running. Close first.", filename_.c_str());
     return SRSRAN_ERROR;
   }
 
   // set UDP DLT
-  dlt       = UDP_DLT;
-  pcap_file = DLT_PCAP_Open(dlt, filename_.c_str());
-  if (pcap_file == nullptr) {
+  if (not writer.open(filename_, UDP_DLT, args)) {
     logger.error("Couldn't open %s to write PCAP", filename_.c_str());
     return SRSRAN_ERROR;
   }
 
-  filename = filename_;
-  ue_id    = ue_id_;
-  running  = true;
-
-  // start writer thread
-  start();
+  ue_id   = ue_id_;
+  running = true;
 
   return SRSRAN_SUCCESS;
 }
 
 uint32_t mac_pcap::close()
 {
-  {
-    std::lock_guard<std::mutex> lock(mutex);
-    if (running == false || pcap_file == nullptr) {
-      return SRSRAN_ERROR;
-    }
-
-    // tell writer thread to stop
-    running        = false;
-    pcap_pdu_t pdu = {};
-    queue.push_blocking(std::move(pdu));
+  std::lock_guard<std::mutex> lock(mutex);
+  if (running == false || not writer.is_open()) {
+    return SRSRAN_ERROR;
   }
 
-  wait_thread_finish();
-
-  // close file handle
-  {
-    std::lock_guard<std::mutex> lock(mutex);
-    srsran::console("Saving MAC PCAP (DLT=%d) to %s\n", dlt, filename.c_str());
-    DLT_PCAP_Close(pcap_file);
-    pcap_file = nullptr;
-  }
+  // stop queueing PDUs and let the writer thread drain the ring
+  running = false;
+  writer.close();
+  srsran::console("Saving MAC PCAP (DLT=%d) to %s\n", writer.get_dlt(), writer.get_filename().c_str());
 
   return SRSRAN_SUCCESS;
 }
 
-void mac_pcap::write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu)
+// Function called from PHY worker context, the headers and payload are packed straight into the writer ring
+void mac_pcap::queue_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu, const uint8_t* payload, uint32_t payload_len)
 {
-  if (pdu.pdu != nullptr) {
-    switch (pdu.rat) {
-      case srsran_rat_t::lte:
-        LTE_PCAP_MAC_UDP_WritePDU(pcap_file, &pdu.context, pdu.pdu->msg, pdu.pdu->N_bytes);
-        break;
-      case srsran_rat_t::nr:
-        NR_PCAP_MAC_UDP_WritePDU(pcap_file, &pdu.context_nr, pdu.pdu->msg, pdu.pdu->N_bytes);
-        break;
-      default:
-        logger.error("Error writing PDU to PCAP. Unsupported RAT selected.");
-    }
+  uint8_t header[PCAP_CONTEXT_HEADER_MAX];
+  int     header_len;
+  switch (pdu.rat) {
+    case srsran_rat_t::lte:
+      header_len = LTE_PCAP_PACK_MAC_UDP_HEADER_TO_BUFFER(&pdu.context, payload_len, header);
+      break;
+    case srsran_rat_t::nr:
+      header_len = NR_PCAP_PACK_MAC_UDP_HEADER_TO_BUFFER(&pdu.context_nr, payload_len, header);
+      break;
+    default:
+      logger.error("Error writing PDU to PCAP. Unsupported RAT selected.");
+      return;
+  }
+  if (not writer.write(header, header_len, payload, payload_len, pdu.orig_len) and running) {
+    logger.warning("Dropping PDU (%d B) in PCAP. Write ring full.", payload_len);
   }
 }
 
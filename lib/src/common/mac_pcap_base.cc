@@ -23,6 +23,7 @@
 #include "srsran/config.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/support/emergency_handlers.h"
+#include <algorithm>
 #include <stdint.h>
 
 namespace srsran {
@@ -57,6 +58,56 @@ void mac_pcap_base::set_ue_id(uint16_t ue_id_)
   ue_id = ue_id_;
 }
 
+void mac_pcap_base::set_filter(const mac_pcap_filter_t& filter_)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  filter    = filter_;
+  lcid_mask = 0;
+  for (uint8_t lcid : filter.lcids) {
+    lcid_mask |= 1U << (lcid & 0x1fU);
+  }
+  sample_count = 0;
+}
+
+/// Returns the mask of the LCIDs found in the subheaders of an EUTRA MAC PDU (TS 36.321 Section 6.1.2)
+static uint32_t get_lcid_mask(const uint8_t* payload, uint32_t payload_len)
+{
+  uint32_t mask = 0;
+  uint32_t pos  = 0;
+  bool     ext  = true;
+  while (ext and pos < payload_len) {
+    uint8_t lcid = payload[pos] & 0x1fU;
+    bool    f2   = (payload[pos] & 0x40U) != 0;
+    ext          = (payload[pos] & 0x20U) != 0;
+    pos++;
+    mask |= 1U << lcid;
+
+    // All but the last SDU subheader carry the F and L fields
+    if (ext and lcid <= 10 and pos < payload_len) {
+      bool f = (payload[pos] & 0x80U) != 0;
+      pos += (f2 or f) ? 2 : 1;
+    }
+  }
+  return mask;
+}
+
+bool mac_pcap_base::filter_pdu(const uint8_t* payload, uint32_t payload_len, uint16_t rnti, bool crc_ok, srsran_rat_t rat)
+{
+  if (not filter.rntis.empty() and std::find(filter.rntis.begin(), filter.rntis.end(), rnti) == filter.rntis.end()) {
+    return false;
+  }
+  if (filter.crc_fail_only and crc_ok) {
+    return false;
+  }
+  if (lcid_mask != 0 and rat == srsran_rat_t::lte and (get_lcid_mask(payload, payload_len) & lcid_mask) == 0) {
+    return false;
+  }
+  if (filter.sample_rate > 1 and sample_count.fetch_add(1, std::memory_order_relaxed) % filter.sample_rate != 0) {
+    return false;
+  }
+  return true;
+}
+
 void mac_pcap_base::run_thread()
 {
   // blocking write until stopped
@@ -89,6 +140,9 @@ void mac_pcap_base::pack_and_queue(uint8_t* payload,
                                    uint8_t  rnti_type)
 {
   if (running && payload != nullptr) {
+    if (not filter_pdu(payload, payload_len, crnti, crc_ok, srsran_rat_t::lte)) {
+      return;
+    }
     pcap_pdu_t pdu             = {};
     pdu.rat                    = srsran::srsran_rat_t::lte;
     pdu.context.radioType      = FDD_RADIO;
@@ -101,19 +155,11 @@ void mac_pcap_base::pack_and_queue(uint8_t* payload,
     pdu.context.cc_idx         = cc_idx;
     pdu.context.sysFrameNumber = (uint16_t)(tti / 10);
     pdu.context.subFrameNumber = (uint16_t)(tti % 10);
-
-    // try to allocate PDU buffer
-    pdu.pdu = srsran::make_byte_buffer();
-    if (pdu.pdu != nullptr && pdu.pdu->get_tailroom() >= payload_len) {
-      // copy payload into PDU buffer
-      memcpy(pdu.pdu->msg, payload, payload_len);
-      pdu.pdu->N_bytes = payload_len;
-      if (not queue.try_push(std::move(pdu))) {
-        logger.warning("Dropping PDU (%d B) in PCAP. Write queue full.", payload_len);
-      }
-    } else {
-      logger.warning("Dropping PDU in PCAP. No buffer available or not enough space (pdu_len=%d).", payload_len);
+    pdu.orig_len               = payload_len;
+    if (filter.snap_len > 0) {
+      payload_len = std::min(payload_len, filter.snap_len);
     }
+    queue_pdu(pdu, payload, payload_len);
   }
 }
 
@@ -128,6 +174,9 @@ void mac_pcap_base::pack_and_queue_nr(uint8_t* payload,
                                       uint8_t  rnti_type)
 {
   if (running && payload != nullptr) {
+    if (not filter_pdu(payload, payload_len, crnti, true, srsran_rat_t::nr)) {
+      return;
+    }
     pcap_pdu_t pdu                     = {};
     pdu.rat                            = srsran_rat_t::nr;
     pdu.context_nr.radioType           = FDD_RADIO;
@@ -138,19 +187,28 @@ void mac_pcap_base::pack_and_queue_nr(uint8_t* payload,
     pdu.context_nr.harqid              = harqid;
     pdu.context_nr.system_frame_number = tti / 10;
     pdu.context_nr.sub_frame_number    = tti % 10;
+    pdu.orig_len                       = payload_len;
+    if (filter.snap_len > 0) {
+      payload_len = std::min(payload_len, filter.snap_len);
+    }
+    queue_pdu(pdu, payload, payload_len);
+  }
+}
 
-    // try to allocate PDU buffer
-    pdu.pdu = srsran::make_byte_buffer();
-    if (pdu.pdu != nullptr && pdu.pdu->get_tailroom() >= payload_len) {
-      // copy payload into PDU buffer
-      memcpy(pdu.pdu->msg, payload, payload_len);
-      pdu.pdu->N_bytes = payload_len;
-      if (not queue.try_push(std::move(pdu))) {
-        logger.warning("Dropping PDU (%d B) in NR PCAP. Write queue full.", payload_len);
-      }
-    } else {
-      logger.warning("Dropping PDU in NR PCAP. No buffer available or not enough space (pdu_len=%d).", payload_len);
+// Function called from PHY worker context, locking not needed as PDU queue is thread-safe
+void mac_pcap_base::queue_pdu(pcap_pdu_t& pdu, const uint8_t* payload, uint32_t payload_len)
+{
+  // try to allocate PDU buffer
+  pdu.pdu = srsran::make_byte_buffer();
+  if (pdu.pdu != nullptr && pdu.pdu->get_tailroom() >= payload_len) {
+    // copy payload into PDU buffer
+    memcpy(pdu.pdu->msg, payload, payload_len);
+    pdu.pdu->N_bytes = payload_len;
+    if (not queue.try_push(std::move(pdu))) {
+      logger.warning("Dropping PDU (%d B) in PCAP. Write queue full.", payload_len);
     }
+  } else {
+    logger.warning("Dropping PDU in PCAP. No buffer available or not enough space (pdu_len=%d).", payload_len);
   }
 }
 
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/mem_prefault.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <errno.h>
+#include <malloc.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
+
+namespace srsran {
+
+static size_t get_page_size()
+{
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+
+size_t mem_prefault(void* ptr, size_t len)
+{
+  if (ptr == nullptr or len == 0) {
+    return 0;
+  }
+  size_t    page_size = get_page_size();
+  uintptr_t begin     = reinterpret_cast<uintptr_t>(ptr) & ~(page_size - 1);
+  uintptr_t end       = reinterpret_cast<uintptr_t>(ptr) + len;
+  size_t    map_len   = (end - begin + page_size - 1) & ~(page_size - 1);
+
+  // Since Linux 5.14 the kernel populates the range without touching its contents
+  if (madvise(reinterpret_cast<void*>(begin), map_len, MADV_POPULATE_WRITE) == 0) {
+    return map_len;
+  }
+
+  // Otherwise, write each page with an atomic addition of zero, which keeps the concurrent writes of other threads
+  for (uintptr_t page = begin; page < end; page += page_size) {
+    uint8_t* p = reinterpret_cast<uint8_t*>(std::max(page, reinterpret_cast<uintptr_t>(ptr)));
+    __atomic_fetch_add(p, 0, __ATOMIC_RELAXED);
+  }
+  return map_len;
+}
+
+size_t mem_reserve_heap(size_t len)
+{
+  if (len == 0) {
+    return 0;
+  }
+  // Keep the freed memory in the heap and allocate the large blocks in it as well
+  mallopt(M_TRIM_THRESHOLD, -1);
+  mallopt(M_MMAP_MAX, 0);
+
+  void* reserve = malloc(len);
+  if (reserve == nullptr) {
+    return 0;
+  }
+  mem_prefault(reserve, len);
+  free(reserve);
+  return len;
+}
+
+bool mem_lock_all(std::string& err)
+{
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    err = strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+} // namespace srsran
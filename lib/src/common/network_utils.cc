@@ -22,10 +22,17 @@
 #include "srsran/common/network_utils.h"
 
 #include <netinet/sctp.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h> // for the pipe
 
+#ifdef HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
 #define rxSockError(fmt, ...) logger.error("RxSockets: " fmt, ##__VA_ARGS__)
 #define rxSockWarn(fmt, ...) logger.warning("RxSockets: " fmt, ##__VA_ARGS__)
 #define rxSockInfo(fmt, ...) logger.info("RxSockets: " fmt, ##__VA_ARGS__)
@@ -395,11 +402,246 @@ bool unique_socket::sctp_set_init_msg_opts(int max_init_attempts, int max_init_t
  *                 Rx Multisocket Handler
  **************************************************************/
 
-socket_manager::socket_manager() : thread("RXsockets"), socket_manager_itf(srslog::fetch_basic_logger("COMN"))
+/**
+ * Minimal io_uring used to wait for the sockets to become readable, driven through the raw system calls so that no
+ * extra library is needed. Each armed socket has a one-shot POLLIN request in the ring, tagged with the fd and an
+ * arming sequence number, so that the completions of requests that were cancelled or belong to a closed fd can be told
+ * apart from the ones of the fd currently registered with the same number.
+ */
+class socket_manager::io_uring_poller
+{
+public:
+  explicit io_uring_poller(srslog::basic_logger& logger_) : logger(logger_) {}
+  ~io_uring_poller();
+  io_uring_poller(const io_uring_poller&) = delete;
+  io_uring_poller& operator=(const io_uring_poller&) = delete;
+
+  /// Sets up the ring, returns false if the kernel does not support it
+  bool init(unsigned nof_entries);
+
+  /// Queues a poll request for the fd, which is submitted on the next call to wait()
+  void arm(int fd);
+
+  /// Forgets the fd, cancelling its poll request if it is still armed
+  void disarm(int fd);
+
+  /// Submits the queued requests and waits for at least one completion. The fds that became readable are written
+  /// in ready_fds, they are no longer armed. Returns false on error
+  bool wait(std::vector<int>& ready_fds);
+
+private:
+#ifdef HAVE_IO_URING
+  io_uring_sqe* get_sqe();
+
+  int           ring_fd   = -1;
+  void*         sq_ptr    = MAP_FAILED;
+  size_t        sq_size   = 0;
+  void*         cq_ptr    = MAP_FAILED;
+  size_t        cq_size   = 0;
+  io_uring_sqe* sqes      = nullptr;
+  size_t        sqes_size = 0;
+  unsigned*     sq_head   = nullptr;
+  unsigned*     sq_tail   = nullptr;
+  unsigned*     sq_mask   = nullptr;
+  unsigned*     sq_array  = nullptr;
+  unsigned*     cq_head   = nullptr;
+  unsigned*     cq_tail   = nullptr;
+  unsigned*     cq_mask   = nullptr;
+  io_uring_cqe* cqes      = nullptr;
+  unsigned      to_submit = 0;
+#endif
+
+  srslog::basic_logger&   logger;
+  uint32_t                arm_seq = 0;
+  std::map<int, uint64_t> armed; ///< tag of the poll request of each armed fd
+};
+
+#ifdef HAVE_IO_URING
+
+socket_manager::io_uring_poller::~io_uring_poller()
+{
+  if (sqes != nullptr) {
+    munmap(sqes, sqes_size);
+  }
+  if (cq_ptr != MAP_FAILED and cq_ptr != sq_ptr) {
+    munmap(cq_ptr, cq_size);
+  }
+  if (sq_ptr != MAP_FAILED) {
+    munmap(sq_ptr, sq_size);
+  }
+  if (ring_fd >= 0) {
+    close(ring_fd);
+  }
+}
+
+bool socket_manager::io_uring_poller::init(unsigned nof_entries)
+{
+  io_uring_params params = {};
+  ring_fd                = syscall(__NR_io_uring_setup, nof_entries, &params);
+  if (ring_fd < 0) {
+    logger.warning("RxSockets: io_uring is not available: %s", strerror(errno));
+    return false;
+  }
+
+  // Map the submission and completion rings, which share a mapping in recent kernels, and the submission entries
+  sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    sq_size = std::max(sq_size, cq_size);
+  }
+  sq_ptr = mmap(nullptr, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+  if (sq_ptr == MAP_FAILED) {
+    logger.warning("RxSockets: Failed to map the io_uring submission ring: %s", strerror(errno));
+    return false;
+  }
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    cq_ptr = sq_ptr;
+  } else {
+    cq_ptr = mmap(nullptr, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+    if (cq_ptr == MAP_FAILED) {
+      logger.warning("RxSockets: Failed to map the io_uring completion ring: %s", strerror(errno));
+      return false;
+    }
+  }
+  sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+  void* ptr = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+  if (ptr == MAP_FAILED) {
+    logger.warning("RxSockets: Failed to map the io_uring submission entries: %s", strerror(errno));
+    return false;
+  }
+  sqes = static_cast<io_uring_sqe*>(ptr);
+
+  uint8_t* sq = static_cast<uint8_t*>(sq_ptr);
+  uint8_t* cq = static_cast<uint8_t*>(cq_ptr);
+  sq_head     = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  sq_tail     = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sq_mask     = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sq_array    = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  cq_head     = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cq_tail     = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cq_mask     = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  cqes        = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+  return true;
+}
+
+io_uring_sqe* socket_manager::io_uring_poller::get_sqe()
+{
+  unsigned tail = *sq_tail;
+  if (tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) > *sq_mask) {
+    // Ring full, hand the pending entries over to the kernel
+    if (syscall(__NR_io_uring_enter, ring_fd, to_submit, 0, 0, nullptr, 0) < 0) {
+      logger.error("RxSockets: Failed to submit io_uring requests: %s", strerror(errno));
+      return nullptr;
+    }
+    to_submit = 0;
+  }
+  unsigned      idx = tail & *sq_mask;
+  io_uring_sqe* sqe = &sqes[idx];
+  memset(sqe, 0, sizeof(*sqe));
+  sq_array[idx] = idx;
+  __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+  to_submit++;
+  return sqe;
+}
+
+void socket_manager::io_uring_poller::arm(int fd)
+{
+  io_uring_sqe* sqe = get_sqe();
+  if (sqe == nullptr) {
+    return;
+  }
+  uint64_t tag       = (uint64_t(++arm_seq) << 32u) | uint32_t(fd);
+  sqe->opcode        = IORING_OP_POLL_ADD;
+  sqe->fd            = fd;
+  sqe->poll32_events = POLLIN;
+  sqe->user_data     = tag;
+  armed[fd]          = tag;
+}
+
+void socket_manager::io_uring_poller::disarm(int fd)
+{
+  auto it = armed.find(fd);
+  if (it == armed.end()) {
+    return;
+  }
+  io_uring_sqe* sqe = get_sqe();
+  if (sqe != nullptr) {
+    sqe->opcode    = IORING_OP_POLL_REMOVE;
+    sqe->fd        = -1;
+    sqe->addr      = it->second;
+    sqe->user_data = 0;
+  }
+  armed.erase(it);
+}
+
+bool socket_manager::io_uring_poller::wait(std::vector<int>& ready_fds)
+{
+  ready_fds.clear();
+  int ret = syscall(__NR_io_uring_enter, ring_fd, to_submit, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+  if (ret < 0 and errno != EINTR) {
+    return false;
+  }
+  if (ret >= 0) {
+    to_submit = 0;
+  }
+
+  unsigned head = *cq_head;
+  unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+  for (; head != tail; ++head) {
+    const io_uring_cqe& cqe = cqes[head & *cq_mask];
+    int                 fd  = int(uint32_t(cqe.user_data));
+    auto                it  = armed.find(fd);
+    // Skip the completions of the removal requests and of the poll requests that were cancelled or replaced
+    if (cqe.user_data == 0 or it == armed.end() or it->second != cqe.user_data) {
+      continue;
+    }
+    armed.erase(it);
+    if (cqe.res < 0) {
+      // The fd is not polled anymore, e.g. it was closed before being removed
+      logger.error("RxSockets: Poll request for fd=%d failed: %s", fd, strerror(-cqe.res));
+      continue;
+    }
+    ready_fds.push_back(fd);
+  }
+  __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+  return true;
+}
+
+#else
+
+socket_manager::io_uring_poller::~io_uring_poller() {}
+
+bool socket_manager::io_uring_poller::init(unsigned nof_entries)
+{
+  logger.warning("RxSockets: io_uring is not supported in this build");
+  return false;
+}
+
+void socket_manager::io_uring_poller::arm(int fd) {}
+
+void socket_manager::io_uring_poller::disarm(int fd) {}
+
+bool socket_manager::io_uring_poller::wait(std::vector<int>& ready_fds)
+{
+  return false;
+}
+
+#endif
+
+socket_manager::socket_manager(backend_t backend) :
+  thread("RXsockets"), socket_manager_itf(srslog::fetch_basic_logger("COMN"))
 {
   // register control pipe fd
   int fd = pipe(pipefd);
   srsran_assert(fd != -1, "Failed to open control pipe");
+
+  if (backend == backend_t::io_uring) {
+    uring.reset(new io_uring_poller(logger));
+    if (not uring->init(256)) {
+      rxSockWarn("Falling back to select");
+      uring.reset();
+    }
+  }
   start(thread_prio);
 }
 
@@ -514,6 +756,88 @@ socket_manager::remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max
 void socket_manager::run_thread()
 {
   running = true;
+  if (uring != nullptr) {
+    run_io_uring_loop();
+  } else {
+    run_select_loop();
+  }
+}
+
+void socket_manager::run_io_uring_loop()
+{
+  std::vector<int> ready_fds;
+  uring->arm(pipefd[0]);
+
+  while (running.load(std::memory_order_relaxed)) {
+    if (not uring->wait(ready_fds)) {
+      rxSockError("Error waiting for io_uring completions: %s", strerror(errno));
+      continue;
+    }
+
+    // Shared state area
+    std::lock_guard<std::mutex> lock(socket_mutex);
+
+    // call read callback for all SCTP/TCP/UDP connections, and re-arm their poll requests
+    bool ctrl_ready = false;
+    for (int fd : ready_fds) {
+      if (fd == pipefd[0]) {
+        ctrl_ready = true;
+        continue;
+      }
+      auto handler_it = active_sockets.find(fd);
+      if (handler_it == active_sockets.end()) {
+        continue;
+      }
+      bool socket_valid = handler_it->second(fd);
+      if (not socket_valid) {
+        rxSockInfo("The socket fd=%d has been closed by peer", fd);
+        active_sockets.erase(handler_it);
+        uring->disarm(fd);
+        rxSockDebug("Socket fd=%d has been successfully removed", fd);
+      } else {
+        uring->arm(fd);
+      }
+    }
+
+    // handle ctrl messages
+    if (not ctrl_ready) {
+      continue;
+    }
+    uring->arm(pipefd[0]);
+    ctrl_cmd_t msg;
+    ssize_t    nrd = read(pipefd[0], &msg, sizeof(msg));
+    if (nrd <= 0) {
+      rxSockError("Unable to read control message.");
+      continue;
+    }
+    switch (msg.cmd) {
+      case ctrl_cmd_t::cmd_id_t::EXIT:
+        running = false;
+        return;
+      case ctrl_cmd_t::cmd_id_t::NEW_FD:
+        if (msg.new_fd >= 0) {
+          uring->arm(msg.new_fd);
+        } else {
+          rxSockError("added fd is not valid");
+        }
+        break;
+      case ctrl_cmd_t::cmd_id_t::RM_FD:
+        active_sockets.erase(msg.new_fd);
+        uring->disarm(msg.new_fd);
+        if (msg.signal_rm_complete) {
+          rem_fd_tmp_list.push_back(msg.new_fd);
+          rem_cvar.notify_one();
+        }
+        rxSockDebug("Socket fd=%d has been successfully removed", msg.new_fd);
+        break;
+      default:
+        rxSockError("ctrl message command %d is not valid", (int)msg.cmd);
+    }
+  }
+}
+
+void socket_manager::run_select_loop()
+{
   fd_set total_fd_set, read_fd_set;
   FD_ZERO(&total_fd_set);
   int max_fd = 0;
@@ -650,27 +974,50 @@ make_sctp_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& q
 
 /**
  * Description: Functor for the case the received data is
- * in the form of unique_byte_buffer, and a recvfrom(...) call is used
+ * in the form of unique_byte_buffer, and a recvfrom(...) call is used.
+ * The datagrams waiting in the socket are read with a single recvmmsg(...) call into byte buffers allocated beforehand,
+ * and handed over to the queue as a single task.
  */
 class recvfrom_pdu_task
 {
 public:
   using callback_t = recvfrom_callback_t;
+
+  /// Maximum number of datagrams read per call
+  static const size_t max_batch_size = 32;
+
   explicit recvfrom_pdu_task(srslog::basic_logger& logger, srsran::task_queue_handle& queue_, callback_t func_) :
     logger(logger), queue(queue_), func(std::move(func_))
   {}
 
   bool operator()(int fd)
   {
-    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-    if (pdu == nullptr) {
+    // Refill the buffers handed over in the previous call. The message headers are set up here, as this object is
+    // moved around before it is registered in the socket manager
+    size_t nof_bufs = 0;
+    for (; nof_bufs < max_batch_size; ++nof_bufs) {
+      srsran::unique_byte_buffer_t& pdu = pdus[nof_bufs];
+      if (pdu == nullptr) {
+        pdu = srsran::make_byte_buffer();
+        if (pdu == nullptr) {
+          break;
+        }
+      }
+      iovs[nof_bufs].iov_base            = pdu->msg;
+      iovs[nof_bufs].iov_len             = pdu->get_tailroom();
+      msgs[nof_bufs].msg_hdr             = {};
+      msgs[nof_bufs].msg_hdr.msg_name    = &addrs[nof_bufs];
+      msgs[nof_bufs].msg_hdr.msg_namelen = sizeof(addrs[nof_bufs]);
+      msgs[nof_bufs].msg_hdr.msg_iov     = &iovs[nof_bufs];
+      msgs[nof_bufs].msg_hdr.msg_iovlen  = 1;
+    }
+    if (nof_bufs == 0) {
       logger.error("Unable to allocate byte buffer");
       return true;
     }
-    sockaddr_in from    = {};
-    socklen_t   fromlen = sizeof(from);
 
-    ssize_t n_recv = recvfrom(fd, pdu->msg, pdu->get_tailroom(), 0, (struct sockaddr*)&from, &fromlen);
+    // The socket is known to be readable, so do not wait for the batch to fill up
+    int n_recv = recvmmsg(fd, msgs.data(), nof_bufs, MSG_DONTWAIT, nullptr);
     if (n_recv == -1 and errno != EAGAIN) {
       logger.error("Error reading from socket: %s", strerror(errno));
       return true;
@@ -680,19 +1027,36 @@ public:
       return true;
     }
 
-    pdu->N_bytes = static_cast<uint32_t>(n_recv);
+    rx_batch_t batch;
+    batch.reserve(n_recv);
+    for (int i = 0; i < n_recv; ++i) {
+      pdus[i]->N_bytes = msgs[i].msg_len;
+      batch.emplace_back(std::move(pdus[i]), addrs[i]);
+    }
 
-    // Defer handling of received packet to provided queue
-    queue.push(
-        std::bind([this, from](srsran::unique_byte_buffer_t& sdu) { func(std::move(sdu), from); }, std::move(pdu)));
+    // Defer handling of the received packets to provided queue
+    queue.push(std::bind(
+        [this](rx_batch_t& sdus) {
+          for (auto& sdu : sdus) {
+            func(std::move(sdu.first), sdu.second);
+          }
+        },
+        std::move(batch)));
 
     return true;
   }
 
 private:
+  using rx_batch_t = std::vector<std::pair<srsran::unique_byte_buffer_t, sockaddr_in>>;
+
   srslog::basic_logger&      logger;
   srsran::task_queue_handle& queue;
   callback_t                 func;
+
+  std::array<srsran::unique_byte_buffer_t, max_batch_size> pdus;
+  std::array<mmsghdr, max_batch_size>                      msgs  = {};
+  std::array<iovec, max_batch_size>                        iovs  = {};
+  std::array<sockaddr_in, max_batch_size>                  addrs = {};
 };
 
 socket_manager_itf::recv_callback_t
@@ -701,4 +1065,34 @@ make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue,
   return socket_manager_itf::recv_callback_t(recvfrom_pdu_task(logger, queue, std::move(rx_callback)));
 }
 
+static socket_manager::backend_t rx_io_backend = socket_manager::backend_t::select;
+
+void set_rx_io_backend(socket_manager::backend_t backend)
+{
+  rx_io_backend = backend;
+}
+
+const char* to_string(socket_manager::backend_t backend)
+{
+  return backend == socket_manager::backend_t::io_uring ? "io_uring" : "select";
+}
+
+bool from_string(const std::string& str, socket_manager::backend_t& backend)
+{
+  if (str == "select") {
+    backend = socket_manager::backend_t::select;
+  } else if (str == "io_uring") {
+    backend = socket_manager::backend_t::io_uring;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+socket_manager& get_rx_io_manager()
+{
+  static socket_manager io(rx_io_backend);
+  return io;
+}
+
 } // namespace srsran
@@ -20,7 +20,6 @@
  */
 
 #include "srsran/common/ngap_pcap.h"
-#include "srsran/common/pcap.h"
 #include "srsran/srsran.h"
 #include "srsran/support/emergency_handlers.h"
 #include <stdint.h>
@@ -49,27 +48,25 @@ void ngap_pcap::enable()
 {
   enable_write = true;
 }
-void ngap_pcap::open(const char* filename_)
+void ngap_pcap::open(const char* filename_, const pcap_writer_args_t& args)
 {
-  filename     = filename_;
-  pcap_file    = DLT_PCAP_Open(NGAP_5G_DLT, filename.c_str());
-  enable_write = true;
+  enable_write = writer.open(filename_, NGAP_5G_DLT, args);
 }
 void ngap_pcap::close()
 {
   if (!enable_write) {
     return;
   }
-  fprintf(stdout, "Saving NGAP PCAP file (DLT=%d) to %s\n", NGAP_5G_DLT, filename.c_str());
-  DLT_PCAP_Close(pcap_file);
+  enable_write = false;
+  writer.close();
+  fprintf(stdout, "Saving NGAP PCAP file (DLT=%d) to %s\n", NGAP_5G_DLT, writer.get_filename().c_str());
 }
 
 void ngap_pcap::write_ngap(uint8_t* pdu, uint32_t pdu_len_bytes)
 {
   if (enable_write) {
-    NGAP_Context_Info_t context;
     if (pdu) {
-      LTE_PCAP_NGAP_WritePDU(pcap_file, &context, pdu, pdu_len_bytes);
+      writer.write(nullptr, 0, pdu, pdu_len_bytes);
     }
   }
 }
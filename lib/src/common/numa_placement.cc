@@ -0,0 +1,267 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsran/common/numa_placement.h"
+#include "srsran/common/thread_placement.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fstream>
+#include <linux/mempolicy.h>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+namespace srsran {
+
+// Node masks passed to the kernel, enough for any NUMA system
+static const size_t max_nof_nodes = 1024;
+using node_mask_t                 = std::array<unsigned long, max_nof_nodes / (8 * sizeof(unsigned long))>;
+
+static const char* pool_names[] = {"bearers", "buffers", "harq"};
+// Thread that accesses each pool the most, for the "auto" node
+static const char* pool_threads[] = {"STACK", "STACK", "WORKER0"};
+
+const char* to_string(numa_pool_t pool)
+{
+  return pool < numa_pool_t::nof_pools ? pool_names[(size_t)pool] : "invalid";
+}
+
+static std::vector<std::string> split(const std::string& str, char sep)
+{
+  std::vector<std::string> ret;
+  std::stringstream        ss(str);
+  std::string              item;
+  while (std::getline(ss, item, sep)) {
+    // Trim the white spaces around each item
+    size_t first = item.find_first_not_of(" \t");
+    size_t last  = item.find_last_not_of(" \t");
+    ret.push_back(first == std::string::npos ? "" : item.substr(first, last - first + 1));
+  }
+  return ret;
+}
+
+static bool parse_uint(const std::string& str, int& value)
+{
+  if (str.empty() || str.find_first_not_of("0123456789") != std::string::npos || str.size() > 6) {
+    return false;
+  }
+  value = atoi(str.c_str());
+  return true;
+}
+
+static node_mask_t make_node_mask(int node)
+{
+  node_mask_t mask = {};
+  mask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+  return mask;
+}
+
+numa_placement::scoped_policy::scoped_policy(numa_pool_t pool)
+{
+  int node = numa_placement::get().get_node(pool);
+  if (node < 0) {
+    return;
+  }
+  node_mask_t mask = make_node_mask(node);
+  active           = syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask.data(), max_nof_nodes) == 0;
+}
+
+numa_placement::scoped_policy::~scoped_policy()
+{
+  if (active) {
+    syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0);
+  }
+}
+
+numa_placement& numa_placement::get()
+{
+  static numa_placement instance;
+  return instance;
+}
+
+numa_placement::numa_placement()
+{
+  for (size_t i = 0; i < nof_pools; i++) {
+    nodes[i]       = -1;
+    bound_bytes[i] = 0;
+  }
+}
+
+// Resolves the node of the CPUs the thread placement assigns to a thread
+static bool get_thread_node(const std::string& thread_name, int& node, std::string& err)
+{
+  cpu_set_t cpus;
+  if (!thread_placement::get().get_cpus(thread_name, cpus)) {
+    err = "\"auto\" needs a thread profile rule with the CPUs of " + thread_name;
+    return false;
+  }
+  node = -1;
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (!CPU_ISSET(cpu, &cpus)) {
+      continue;
+    }
+    int cpu_node = numa_placement::get_cpu_node(cpu);
+    if (cpu_node < 0) {
+      err = "the node of CPU " + std::to_string(cpu) + " is unknown";
+      return false;
+    }
+    if (node >= 0 && cpu_node != node) {
+      err = "the CPUs of " + thread_name + " span several nodes";
+      return false;
+    }
+    node = cpu_node;
+  }
+  return true;
+}
+
+bool numa_placement::configure(const std::string& profile, std::string& err)
+{
+  std::array<int, nof_pools> new_nodes;
+  new_nodes.fill(-1);
+  uint32_t nof_nodes = get_nof_nodes();
+
+  for (const std::string& str : split(profile, ';')) {
+    if (str.empty()) {
+      continue;
+    }
+    std::vector<std::string> fields = split(str, '=');
+    size_t                   pool   = 0;
+    while (pool < nof_pools && (fields.size() != 2 || fields[0] != pool_names[pool])) {
+      pool++;
+    }
+    if (fields.size() != 2) {
+      err = "rule '" + str + "': expected POOL=NODE";
+      return false;
+    }
+    if (pool == nof_pools) {
+      err = "rule '" + str + "': unknown pool '" + fields[0] + "'";
+      return false;
+    }
+    if (new_nodes[pool] >= 0) {
+      err = "rule '" + str + "': duplicated pool";
+      return false;
+    }
+
+    int node = -1;
+    if (fields[1] == "auto") {
+      if (!get_thread_node(pool_threads[pool], node, err)) {
+        err = "rule '" + str + "': " + err;
+        return false;
+      }
+    } else if (!parse_uint(fields[1], node) || node >= (int)nof_nodes || node >= (int)max_nof_nodes) {
+      err = "rule '" + str + "': invalid node '" + fields[1] + "', there are " + std::to_string(nof_nodes) + " nodes";
+      return false;
+    }
+    new_nodes[pool] = node;
+  }
+
+  bool any = false;
+  for (size_t i = 0; i < nof_pools; i++) {
+    nodes[i] = new_nodes[i];
+    any |= new_nodes[i] >= 0;
+  }
+  enabled = any;
+  return true;
+}
+
+bool numa_placement::bind(numa_pool_t pool, void* ptr, size_t len)
+{
+  int node = get_node(pool);
+  if (node < 0 || ptr == nullptr) {
+    return false;
+  }
+
+  // Only whole pages can be bound, the pages at the edges may be shared with other allocations
+  uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  uintptr_t begin     = ((uintptr_t)ptr + page_size - 1) & ~(page_size - 1);
+  uintptr_t end       = ((uintptr_t)ptr + len) & ~(page_size - 1);
+  if (end <= begin) {
+    return false;
+  }
+
+  node_mask_t mask = make_node_mask(node);
+  if (syscall(SYS_mbind, begin, end - begin, MPOL_PREFERRED, mask.data(), max_nof_nodes, MPOL_MF_MOVE) != 0) {
+    fprintf(stderr,
+            "Error: failed to bind the %s memory to NUMA node %d: %s\n",
+            srsran::to_string(pool),
+            node,
+            strerror(errno));
+    return false;
+  }
+  bound_bytes[(size_t)pool] += end - begin;
+  return true;
+}
+
+std::string numa_placement::to_string() const
+{
+  std::stringstream ss;
+  for (size_t i = 0; i < nof_pools; i++) {
+    if (nodes[i] < 0) {
+      continue;
+    }
+    ss << pool_names[i] << ": node " << nodes[i] << ", " << bound_bytes[i] / 1024 << " kB bound\n";
+  }
+  return ss.str();
+}
+
+uint32_t numa_placement::get_nof_nodes()
+{
+  // The online nodes are listed as ranges, e.g. 0-1
+  std::ifstream file("/sys/devices/system/node/online");
+  std::string   line;
+  if (!std::getline(file, line)) {
+    return 1;
+  }
+  int max_node = 0;
+  for (const std::string& range : split(line, ',')) {
+    int last = 0;
+    if (parse_uint(split(range, '-').back(), last)) {
+      max_node = std::max(max_node, last);
+    }
+  }
+  return max_node + 1;
+}
+
+int numa_placement::get_cpu_node(uint32_t cpu)
+{
+  // The CPU directory holds a nodeN link to its node
+  std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+  DIR*        dir  = opendir(path.c_str());
+  if (dir == nullptr) {
+    return -1;
+  }
+  int            node  = -1;
+  struct dirent* entry = nullptr;
+  while ((entry = readdir(dir)) != nullptr && node < 0) {
+    if (strncmp(entry->d_name, "node", 4) == 0 && !parse_uint(entry->d_name + 4, node)) {
+      node = -1;
+    }
+  }
+  closedir(dir);
+  return node;
+}
+
+} // namespace srsran
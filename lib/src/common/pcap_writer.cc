@@ -0,0 +1,254 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/pcap_writer.h"
+#include "srsran/common/standard_streams.h"
+#include <algorithm>
+#include <string.h>
+#include <sys/time.h>
+
+namespace srsran {
+
+constexpr std::chrono::milliseconds pcap_writer::flush_period;
+
+/// Name of the file with the given rotation index, the index is placed before the extension
+static std::string make_file_name(const std::string& filename, uint32_t idx, bool compress)
+{
+  std::string name = filename;
+  if (idx > 0) {
+    size_t dot   = name.rfind('.');
+    size_t slash = name.rfind('/');
+    if (dot == std::string::npos or (slash != std::string::npos and dot < slash)) {
+      dot = name.size();
+    }
+    name.insert(dot, "_" + std::to_string(idx));
+  }
+  if (compress) {
+    name += ".gz";
+  }
+  return name;
+}
+
+pcap_writer::pcap_writer(const std::string& thread_name) : thread(thread_name) {}
+
+pcap_writer::~pcap_writer()
+{
+  close();
+}
+
+bool pcap_writer::open(const std::string& filename_, uint32_t dlt_, const pcap_writer_args_t& args_)
+{
+  if (running) {
+    srsran::console("PCAP writer for %s already running. Close first.\n", filename.c_str());
+    return false;
+  }
+
+  filename = filename_;
+  dlt      = dlt_;
+  args     = args_;
+  file_idx = 0;
+  if (not open_file()) {
+    return false;
+  }
+
+  // Touch the whole ring now so that the producers never page fault on it
+  ring.assign(std::max(args.ring_size_kb, 1U) * 1024U, 0);
+  head        = 0;
+  tail        = 0;
+  nof_dropped = 0;
+  running     = true;
+  start();
+
+  return true;
+}
+
+void pcap_writer::close()
+{
+  {
+    std::lock_guard<std::mutex> lock(ring_mutex);
+    if (not running) {
+      return;
+    }
+    running = false;
+  }
+  cvar.notify_one();
+  wait_thread_finish();
+  close_file();
+
+  if (nof_dropped > 0) {
+    srsran::console("PCAP writer for %s dropped %" PRIu64 " records\n", filename.c_str(), nof_dropped.load());
+  }
+}
+
+bool pcap_writer::write(const uint8_t* hdr,
+                        uint32_t       hdr_len,
+                        const uint8_t* pdu,
+                        uint32_t       pdu_len,
+                        uint32_t       orig_pdu_len)
+{
+  struct timeval t;
+  gettimeofday(&t, nullptr);
+  pcaprec_hdr_t rec_header;
+  rec_header.ts_sec   = t.tv_sec;
+  rec_header.ts_usec  = t.tv_usec;
+  rec_header.incl_len = hdr_len + pdu_len;
+  rec_header.orig_len = hdr_len + std::max(pdu_len, orig_pdu_len);
+
+  uint64_t rec_len = sizeof(rec_header) + hdr_len + pdu_len;
+  bool     wake_up = false;
+  {
+    std::lock_guard<std::mutex> lock(ring_mutex);
+    if (not running) {
+      return false;
+    }
+    uint64_t used = head - tail;
+    if (used + rec_len > ring.size()) {
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    copy_to_ring(&rec_header, sizeof(rec_header));
+    copy_to_ring(hdr, hdr_len);
+    copy_to_ring(pdu, pdu_len);
+
+    // Wake the writer up early once the ring is half full
+    wake_up = used < ring.size() / 2 and used + rec_len >= ring.size() / 2;
+  }
+  if (wake_up) {
+    cvar.notify_one();
+  }
+  return true;
+}
+
+void pcap_writer::copy_to_ring(const void* data, uint32_t len)
+{
+  if (len == 0) {
+    return;
+  }
+  size_t pos   = head % ring.size();
+  size_t first = std::min<size_t>(len, ring.size() - pos);
+  memcpy(&ring[pos], data, first);
+  if (first < len) {
+    memcpy(&ring[0], static_cast<const uint8_t*>(data) + first, len - first);
+  }
+  head += len;
+}
+
+void pcap_writer::run_thread()
+{
+  while (running) {
+    {
+      std::unique_lock<std::mutex> lock(ring_mutex);
+      cvar.wait_for(lock, flush_period, [this]() { return not running or head - tail >= ring.size() / 2; });
+    }
+    write_batch();
+
+    bool rotate = false;
+    if (args.max_file_size_mb > 0 and file_bytes >= (uint64_t)args.max_file_size_mb * 1024 * 1024) {
+      rotate = true;
+    }
+    if (args.rotation_period_s > 0 and
+        std::chrono::steady_clock::now() - file_start >= std::chrono::seconds(args.rotation_period_s)) {
+      rotate = true;
+    }
+    if (rotate) {
+      close_file();
+      file_idx++;
+      open_file();
+    }
+  }
+
+  // write remainder of the ring
+  write_batch();
+}
+
+void pcap_writer::write_batch()
+{
+  uint64_t end;
+  {
+    std::lock_guard<std::mutex> lock(ring_mutex);
+    end = head;
+  }
+  if (end == tail) {
+    return;
+  }
+
+  // The producers never touch [tail, end) until tail is advanced, so it is written without holding the lock
+  for (uint64_t pos = tail; pos < end;) {
+    size_t offset = pos % ring.size();
+    size_t len    = std::min<uint64_t>(end - pos, ring.size() - offset);
+    if (file != nullptr) {
+      fwrite(&ring[offset], 1, len, file);
+    }
+    pos += len;
+  }
+  if (file != nullptr) {
+    fflush(file);
+  }
+  file_bytes += end - tail;
+
+  std::lock_guard<std::mutex> lock(ring_mutex);
+  tail = end;
+}
+
+bool pcap_writer::open_file()
+{
+  std::string name = make_file_name(filename, file_idx, args.compress);
+  if (args.compress) {
+    std::string cmd = "gzip -c > '" + name + "'";
+    file            = popen(cmd.c_str(), "w");
+  } else {
+    file = fopen(name.c_str(), "w");
+  }
+  file_piped = args.compress;
+  if (file == nullptr) {
+    srsran::console("Failed to open file \"%s\" for writing\n", name.c_str());
+    return false;
+  }
+
+  pcap_hdr_t file_header = {
+      0xa1b2c3d4, /* magic number */
+      2,
+      4,     /* version number is 2.4 */
+      0,     /* timezone */
+      0,     /* sigfigs - apparently all tools do this */
+      65535, /* snaplen - this should be long enough */
+      dlt    /* Data Link Type (DLT) */
+  };
+  fwrite(&file_header, sizeof(pcap_hdr_t), 1, file);
+  file_bytes = sizeof(pcap_hdr_t);
+  file_start = std::chrono::steady_clock::now();
+  return true;
+}
+
+void pcap_writer::close_file()
+{
+  if (file == nullptr) {
+    return;
+  }
+  if (file_piped) {
+    pclose(file);
+  } else {
+    fclose(file);
+  }
+  file = nullptr;
+}
+
+} // namespace srsran
@@ -0,0 +1,125 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/pool/pool_registry.h"
+#include "srsran/common/mem_prefault.h"
+#include <algorithm>
+
+namespace srsran {
+
+pool_stats::pool_stats(std::string name_, size_t block_size_, size_t nof_blocks_) :
+  name(std::move(name_)), block_size(block_size_), nof_blocks(nof_blocks_)
+{
+  pool_registry::get().add(this);
+}
+
+pool_stats::~pool_stats()
+{
+  pool_registry::get().remove(this);
+}
+
+void pool_stats::set_memory(void* ptr, size_t len)
+{
+  std::lock_guard<std::mutex> lock(pool_registry::get().mutex);
+  mem_ptr = ptr;
+  mem_len = len;
+}
+
+pool_metrics_t pool_stats::get_metrics() const
+{
+  pool_metrics_t m;
+  m.name            = name;
+  m.block_size      = block_size;
+  m.nof_blocks      = nof_blocks.load(std::memory_order_relaxed);
+  m.nof_used        = nof_used.load(std::memory_order_relaxed);
+  m.high_water_mark = high_water_mark.load(std::memory_order_relaxed);
+  m.nof_allocs      = nof_allocs.load(std::memory_order_relaxed);
+  m.nof_failures    = nof_failures.load(std::memory_order_relaxed);
+
+  uint64_t nof_samples = nof_latency_samples.load(std::memory_order_relaxed);
+  if (nof_samples > 0) {
+    m.alloc_latency_avg_us = latency_sum_ns.load(std::memory_order_relaxed) / (nof_samples * 1000.0f);
+    m.alloc_latency_max_us = latency_max_ns.load(std::memory_order_relaxed) / 1000.0f;
+  }
+  uint64_t nof_served = m.nof_allocs > m.nof_failures ? m.nof_allocs - m.nof_failures : 0;
+  if (nof_served > 0 and block_size > 0) {
+    double used_fraction = requested_bytes.load(std::memory_order_relaxed) / (double(nof_served) * block_size);
+    m.fragmentation      = static_cast<float>(std::max(0.0, 1.0 - used_fraction));
+  }
+  return m;
+}
+
+pool_registry& pool_registry::get()
+{
+  static pool_registry registry;
+  return registry;
+}
+
+void pool_registry::add(pool_stats* stats)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  pools.push_back(stats);
+}
+
+void pool_registry::remove(pool_stats* stats)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  pools.erase(std::remove(pools.begin(), pools.end(), stats), pools.end());
+}
+
+void pool_registry::get_metrics(std::vector<pool_metrics_t>& metrics)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  for (const pool_stats* stats : pools) {
+    metrics.push_back(stats->get_metrics());
+  }
+}
+
+size_t pool_registry::log_leaks(srslog::basic_logger& logger)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  size_t                      nof_leaks = 0;
+  for (const pool_stats* stats : pools) {
+    pool_metrics_t m = stats->get_metrics();
+    if (m.nof_used > 0) {
+      logger.warning("Pool \"%s\" still has %zd blocks of %zd bytes allocated (high-water mark=%zd/%zd blocks)",
+                     m.name.c_str(),
+                     m.nof_used,
+                     m.block_size,
+                     m.high_water_mark,
+                     m.nof_blocks);
+      nof_leaks++;
+    }
+  }
+  return nof_leaks;
+}
+
+size_t pool_registry::prefault()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  size_t                      nof_bytes = 0;
+  for (const pool_stats* stats : pools) {
+    nof_bytes += mem_prefault(stats->mem_ptr, stats->mem_len);
+  }
+  return nof_bytes;
+}
+
+} // namespace srsran
@@ -31,11 +31,10 @@ void rlc_pcap::enable(bool en)
   enable_write = true;
 }
 
-void rlc_pcap::open(const char* filename, const rlc_config_t& config)
+void rlc_pcap::open(const char* filename, const rlc_config_t& config, const pcap_writer_args_t& args)
 {
   fprintf(stdout, "Opening RLC PCAP with DLT=%d\n", UDP_DLT);
-  pcap_file    = DLT_PCAP_Open(UDP_DLT, filename);
-  enable_write = true;
+  enable_write = writer.open(filename, UDP_DLT, args);
 
   if (config.rlc_mode == rlc_mode_t::am) {
     mode      = RLC_AM_MODE;
@@ -54,7 +53,7 @@ void rlc_pcap::open(const char* filename, const rlc_config_t& config)
 void rlc_pcap::close()
 {
   fprintf(stdout, "Saving RLC PCAP file\n");
-  DLT_PCAP_Close(pcap_file);
+  writer.close();
 }
 
 void rlc_pcap::set_ue_id(uint16_t ue_id_)
@@ -83,7 +82,9 @@ void rlc_pcap::pack_and_write(uint8_t* pdu,
     context.channelId            = channel_id;
     context.pduLength            = pdu_len_bytes;
     if (pdu) {
-      LTE_PCAP_RLC_WritePDU(pcap_file, &context, pdu, pdu_len_bytes);
+      uint8_t header[PCAP_CONTEXT_HEADER_MAX];
+      int     header_len = LTE_PCAP_PACK_RLC_UDP_HEADER_TO_BUFFER(&context, pdu_len_bytes, header);
+      writer.write(header, header_len, pdu, pdu_len_bytes);
     }
   }
 }
@@ -20,7 +20,6 @@
  */
 
 #include "srsran/common/s1ap_pcap.h"
-#include "srsran/common/pcap.h"
 #include "srsran/srsran.h"
 #include "srsran/support/emergency_handlers.h"
 #include <stdint.h>
@@ -49,27 +48,25 @@ void s1ap_pcap::enable()
 {
   enable_write = true;
 }
-void s1ap_pcap::open(const char* filename_)
+void s1ap_pcap::open(const char* filename_, const pcap_writer_args_t& args)
 {
-  filename     = filename_;
-  pcap_file    = DLT_PCAP_Open(S1AP_LTE_DLT, filename.c_str());
-  enable_write = true;
+  enable_write = writer.open(filename_, S1AP_LTE_DLT, args);
 }
 void s1ap_pcap::close()
 {
   if (!enable_write) {
     return;
   }
-  fprintf(stdout, "Saving S1AP PCAP file (DLT=%d) to %s\n", S1AP_LTE_DLT, filename.c_str());
-  DLT_PCAP_Close(pcap_file);
+  enable_write = false;
+  writer.close();
+  fprintf(stdout, "Saving S1AP PCAP file (DLT=%d) to %s\n", S1AP_LTE_DLT, writer.get_filename().c_str());
 }
 
 void s1ap_pcap::write_s1ap(uint8_t* pdu, uint32_t pdu_len_bytes)
 {
   if (enable_write) {
-    S1AP_Context_Info_t context;
     if (pdu) {
-      LTE_PCAP_S1AP_WritePDU(pcap_file, &context, pdu, pdu_len_bytes);
+      writer.write(nullptr, 0, pdu, pdu_len_bytes);
     }
   }
 }
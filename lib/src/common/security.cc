@@ -24,7 +24,9 @@
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/s3g.h"
 #include "srsran/common/ssl.h"
+#include "srsran/common/zuc.h"
 #include "srsran/config.h"
+#include <algorithm>
 #include <arpa/inet.h>
 
 #define FC_EPS_K_ASME_DERIVATION 0x10
@@ -830,6 +832,59 @@ uint8_t security_128_eia2(const uint8_t* key,
   return liblte_security_128_eia2(key, count, bearer, direction, msg, msg_len, mac);
 }
 
+uint8_t security_128_eia2(const aes128_key_t* key,
+                          uint32_t            count,
+                          uint32_t            bearer,
+                          uint8_t             direction,
+                          uint8_t*            msg,
+                          uint32_t            msg_len,
+                          uint8_t*            mac)
+{
+  if (key == NULL || msg == NULL || mac == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  // M = COUNT | BEARER | DIRECTION | 0 (64 bits) | MESSAGE, only the first and the last block are copied
+  uint8_t  blk[AES128_BLOCK_LEN] = {};
+  uint8_t  T[AES128_BLOCK_LEN]   = {};
+  uint32_t m_len                 = msg_len + 8;
+  uint32_t n                     = (m_len + AES128_BLOCK_LEN - 1) / AES128_BLOCK_LEN;
+  blk[0]                         = (count >> 24) & 0xFF;
+  blk[1]                         = (count >> 16) & 0xFF;
+  blk[2]                         = (count >> 8) & 0xFF;
+  blk[3]                         = count & 0xFF;
+  blk[4]                         = (bearer << 3) | (direction << 2);
+
+  if (n > 1) {
+    memcpy(&blk[8], msg, 8);
+    aes128_cbc_mac(key, T, blk, 1);
+    aes128_cbc_mac(key, T, &msg[8], n - 2);
+
+    // Last block
+    memset(blk, 0, AES128_BLOCK_LEN);
+    memcpy(blk, &msg[(n - 1) * AES128_BLOCK_LEN - 8], m_len - (n - 1) * AES128_BLOCK_LEN);
+  } else {
+    memcpy(&blk[8], msg, msg_len);
+  }
+
+  // Padding and subkey of the last block, RFC4493
+  uint32_t last_len = m_len - (n - 1) * AES128_BLOCK_LEN;
+  if (last_len == AES128_BLOCK_LEN) {
+    for (uint32_t i = 0; i < AES128_BLOCK_LEN; i++) {
+      blk[i] ^= key->k1[i];
+    }
+  } else {
+    blk[last_len] = 0x80;
+    for (uint32_t i = 0; i < AES128_BLOCK_LEN; i++) {
+      blk[i] ^= key->k2[i];
+    }
+  }
+  aes128_cbc_mac(key, T, blk, 1);
+
+  memcpy(mac, T, 4);
+  return SRSRAN_SUCCESS;
+}
+
 uint8_t security_128_eia3(const uint8_t* key,
                           uint32_t       count,
                           uint32_t       bearer,
@@ -874,6 +929,67 @@ uint8_t security_128_eea2(uint8_t* key,
   return liblte_security_encryption_eea2(key, count, bearer, direction, msg, msg_len * 8, msg_out);
 }
 
+/* EEA2 counter block, 33.401 Annex B.1.3 */
+static void security_eea2_nonce(uint32_t count, uint8_t bearer, uint8_t direction, uint8_t* nonce_cnt)
+{
+  memset(nonce_cnt, 0, AES128_BLOCK_LEN);
+  nonce_cnt[0] = (count >> 24) & 0xFF;
+  nonce_cnt[1] = (count >> 16) & 0xFF;
+  nonce_cnt[2] = (count >> 8) & 0xFF;
+  nonce_cnt[3] = count & 0xFF;
+  nonce_cnt[4] = ((bearer & 0x1F) << 3) | ((direction & 0x01) << 2);
+}
+
+uint8_t security_128_eea2(const aes128_key_t* key,
+                          uint32_t            count,
+                          uint8_t             bearer,
+                          uint8_t             direction,
+                          uint8_t*            msg,
+                          uint32_t            msg_len,
+                          uint8_t*            msg_out)
+{
+  if (key == NULL || msg == NULL || msg_out == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  uint8_t nonce_cnt[AES128_BLOCK_LEN];
+  security_eea2_nonce(count, bearer, direction, nonce_cnt);
+  aes128_ctr(key, nonce_cnt, msg, msg_out, msg_len);
+  return SRSRAN_SUCCESS;
+}
+
+uint8_t security_128_eea2_batch(const aes128_key_t*    key,
+                                uint8_t                bearer,
+                                uint8_t                direction,
+                                security_cipher_pdu_t* pdus,
+                                uint32_t               nof_pdus)
+{
+  if (key == NULL || (pdus == NULL && nof_pdus > 0)) {
+    return SRSRAN_ERROR;
+  }
+
+  // The jobs are processed in chunks so the batch can be of any size
+  aes128_ctr_job_t jobs[32];
+  for (uint32_t i = 0; i < nof_pdus;) {
+    uint32_t nof_jobs = 0;
+    for (; i < nof_pdus && nof_jobs < sizeof(jobs) / sizeof(jobs[0]); i++) {
+      if (pdus[i].msg_len == 0) {
+        continue;
+      }
+      if (pdus[i].msg == NULL || pdus[i].msg_out == NULL) {
+        return SRSRAN_ERROR;
+      }
+      aes128_ctr_job_t& job = jobs[nof_jobs++];
+      job.in                = pdus[i].msg;
+      job.out               = pdus[i].msg_out;
+      job.len               = pdus[i].msg_len;
+      security_eea2_nonce(pdus[i].count, bearer, direction, job.nonce_cnt);
+    }
+    aes128_ctr_batch(key, jobs, nof_jobs);
+  }
+  return SRSRAN_SUCCESS;
+}
+
 uint8_t security_128_eea3(uint8_t* key,
                           uint32_t count,
                           uint8_t  bearer,
@@ -885,6 +1001,119 @@ uint8_t security_128_eea3(uint8_t* key,
   return liblte_security_encryption_eea3(key, count, bearer, direction, msg, msg_len * 8, msg_out);
 }
 
+/* Keystream words generated per PDU at a time by the EEA1/EEA3 batches */
+#define SECURITY_BATCH_KS_WORDS 64
+
+/* Ciphers the PDUs of a batch nof_lanes at a time. init() initializes the keystream generator with a group of PDUs and
+ * gen() generates the next words of the keystream of every PDU of the group, stored as ks[t * nof_lanes + lane] */
+template <uint32_t nof_lanes, class init_func_t, class gen_func_t>
+static uint8_t
+security_stream_cipher_batch(security_cipher_pdu_t* pdus, uint32_t nof_pdus, init_func_t&& init, gen_func_t&& gen)
+{
+  if (pdus == NULL && nof_pdus > 0) {
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t ks[SECURITY_BATCH_KS_WORDS * nof_lanes];
+  for (uint32_t i = 0; i < nof_pdus; i += nof_lanes) {
+    security_cipher_pdu_t* group     = &pdus[i];
+    uint32_t               nof_group = std::min(nof_lanes, nof_pdus - i);
+    uint32_t               nof_words = 0;
+    for (uint32_t l = 0; l < nof_group; l++) {
+      if (group[l].msg_len > 0 && (group[l].msg == NULL || group[l].msg_out == NULL)) {
+        return SRSRAN_ERROR;
+      }
+      nof_words = std::max(nof_words, (group[l].msg_len + 3) / 4);
+    }
+
+    init(group, nof_group);
+    for (uint32_t w = 0; w < nof_words; w += SECURITY_BATCH_KS_WORDS) {
+      uint32_t n = std::min((uint32_t)SECURITY_BATCH_KS_WORDS, nof_words - w);
+      gen(n, ks);
+
+      // The keystream words are big endian
+      for (uint32_t l = 0; l < nof_group; l++) {
+        security_cipher_pdu_t& pdu = group[l];
+        for (uint32_t j = w * 4; j < std::min(pdu.msg_len, (w + n) * 4); j++) {
+          uint32_t word  = ks[(j / 4 - w) * nof_lanes + l];
+          pdu.msg_out[j] = pdu.msg[j] ^ (uint8_t)(word >> ((3 - (j % 4)) * 8));
+        }
+      }
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+uint8_t security_128_eea1_batch(const uint8_t*         key,
+                                uint8_t                bearer,
+                                uint8_t                direction,
+                                security_cipher_pdu_t* pdus,
+                                uint32_t               nof_pdus)
+{
+  if (key == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  // Key and IV as in liblte_security_encryption_eea1()
+  uint32_t k[4];
+  for (int32_t i = 3; i >= 0; i--) {
+    k[i] = (key[4 * (3 - i) + 0] << 24) | (key[4 * (3 - i) + 1] << 16) | (key[4 * (3 - i) + 2] << 8) |
+           (key[4 * (3 - i) + 3]);
+  }
+
+  S3G_LANES_STATE state;
+  return security_stream_cipher_batch<S3G_MAX_LANES>(
+      pdus,
+      nof_pdus,
+      [&](const security_cipher_pdu_t* group, uint32_t nof_group) {
+        uint32_t keys[S3G_MAX_LANES][4];
+        uint32_t ivs[S3G_MAX_LANES][4];
+        for (uint32_t l = 0; l < nof_group; l++) {
+          memcpy(keys[l], k, sizeof(k));
+          ivs[l][3] = group[l].count;
+          ivs[l][2] = ((bearer & 0x1F) << 27) | ((direction & 0x01) << 26);
+          ivs[l][1] = ivs[l][3];
+          ivs[l][0] = ivs[l][2];
+        }
+        s3g_lanes_initialize(&state, keys, ivs, nof_group);
+      },
+      [&](uint32_t n, uint32_t* ks) { s3g_lanes_generate_keystream(&state, n, ks); });
+}
+
+uint8_t security_128_eea3_batch(const uint8_t*         key,
+                                uint8_t                bearer,
+                                uint8_t                direction,
+                                security_cipher_pdu_t* pdus,
+                                uint32_t               nof_pdus)
+{
+  if (key == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  zuc_lanes_state_t state;
+  return security_stream_cipher_batch<ZUC_MAX_LANES>(
+      pdus,
+      nof_pdus,
+      [&](const security_cipher_pdu_t* group, uint32_t nof_group) {
+        // IV as in liblte_security_encryption_eea3()
+        uint8_t   ivs[ZUC_MAX_LANES][16] = {};
+        const u8* k[ZUC_MAX_LANES];
+        const u8* iv[ZUC_MAX_LANES];
+        for (uint32_t l = 0; l < nof_group; l++) {
+          ivs[l][0] = (group[l].count >> 24) & 0xFF;
+          ivs[l][1] = (group[l].count >> 16) & 0xFF;
+          ivs[l][2] = (group[l].count >> 8) & 0xFF;
+          ivs[l][3] = group[l].count & 0xFF;
+          ivs[l][4] = ((bearer & 0x1F) << 3) | ((direction & 0x01) << 2);
+          memcpy(&ivs[l][8], &ivs[l][0], 8);
+          k[l]  = key;
+          iv[l] = ivs[l];
+        }
+        zuc_lanes_initialize(&state, k, iv, nof_group);
+      },
+      [&](uint32_t n, uint32_t* ks) { zuc_lanes_generate_keystream(&state, n, ks); });
+}
+
 /******************************************************************************
  * Authentication
  *****************************************************************************/
@@ -914,6 +1143,82 @@ uint8_t security_milenage_f5_star(uint8_t* k, uint8_t* op, uint8_t* rand, uint8_
   return liblte_security_milenage_f5_star(k, op, rand, ak);
 }
 
+uint8_t security_milenage_batch(const uint8_t*              k,
+                                const uint8_t*              op_c,
+                                const uint8_t*              amf,
+                                security_milenage_vector_t* vectors,
+                                uint32_t                    nof_vectors)
+{
+  if (k == NULL || op_c == NULL || amf == NULL || (vectors == NULL && nof_vectors > 0)) {
+    return SRSRAN_ERROR;
+  }
+
+  // Rotation (in bytes) and constant of OUT1 to OUT4, as in TS 35.206 Section 4.1
+  static const uint32_t rot[4] = {8, 0, 12, 8};
+  static const uint8_t  c[4]   = {0, 1, 2, 4};
+
+  aes128_key_t key;
+  aes128_set_key(&key, k);
+
+  // The vectors are processed in chunks so the batch can be of any size
+  const uint32_t max_chunk = 8;
+  uint8_t        temp[max_chunk][16];
+  uint8_t        in[max_chunk][4][16];
+  uint8_t        out[max_chunk][4][16];
+  for (uint32_t v0 = 0; v0 < nof_vectors; v0 += max_chunk) {
+    uint32_t                    n   = std::min(nof_vectors - v0, max_chunk);
+    security_milenage_vector_t* vec = &vectors[v0];
+
+    // TEMP = E_K(RAND xor OPc)
+    for (uint32_t v = 0; v < n; v++) {
+      for (uint32_t i = 0; i < 16; i++) {
+        temp[v][i] = vec[v].rand[i] ^ op_c[i];
+      }
+    }
+    aes128_encrypt_blocks(&key, temp[0], temp[0], n);
+
+    // OUTx = E_K(rot(TEMP xor OPc, rx) xor cx) xor OPc, with IN1 = SQN || AMF || SQN || AMF added for OUT1
+    for (uint32_t v = 0; v < n; v++) {
+      uint8_t in1[16];
+      for (uint32_t i = 0; i < 6; i++) {
+        in1[i]     = vec[v].sqn[i];
+        in1[i + 8] = vec[v].sqn[i];
+      }
+      for (uint32_t i = 0; i < 2; i++) {
+        in1[i + 6]  = amf[i];
+        in1[i + 14] = amf[i];
+      }
+      for (uint32_t i = 0; i < 16; i++) {
+        in[v][0][(i + rot[0]) % 16] = in1[i] ^ op_c[i];
+      }
+      for (uint32_t i = 0; i < 16; i++) {
+        in[v][0][i] ^= temp[v][i];
+      }
+      for (uint32_t j = 1; j < 4; j++) {
+        for (uint32_t i = 0; i < 16; i++) {
+          in[v][j][(i + rot[j]) % 16] = temp[v][i] ^ op_c[i];
+        }
+        in[v][j][15] ^= c[j];
+      }
+    }
+    aes128_encrypt_blocks(&key, in[0][0], out[0][0], 4 * n);
+
+    for (uint32_t v = 0; v < n; v++) {
+      for (uint32_t j = 0; j < 4; j++) {
+        for (uint32_t i = 0; i < 16; i++) {
+          out[v][j][i] ^= op_c[i];
+        }
+      }
+      memcpy(vec[v].mac_a, &out[v][0][0], 8);
+      memcpy(vec[v].res, &out[v][1][8], 8);
+      memcpy(vec[v].ak, &out[v][1][0], 6);
+      memcpy(vec[v].ck, out[v][2], 16);
+      memcpy(vec[v].ik, out[v][3], 16);
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
 int security_xor_f2345(uint8_t* k, uint8_t* rand, uint8_t* res, uint8_t* ck, uint8_t* ik, uint8_t* ak)
 {
   uint8_t xdout[16];
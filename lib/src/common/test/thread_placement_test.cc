@@ -0,0 +1,100 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsran/common/thread_placement.h"
+#include "srsran/support/srsran_test.h"
+#include <sys/sysinfo.h>
+
+using srsran::thread_placement;
+
+void test_parse()
+{
+  thread_placement&        placement = thread_placement::get();
+  std::string              err;
+  std::vector<std::string> warnings;
+
+  // Empty profile disables the placement
+  TESTASSERT(placement.configure("", err));
+  TESTASSERT(not placement.is_enabled());
+  TESTASSERT(not placement.apply_self("TXRX"));
+
+  // Valid profile, a single CPU is enough for any machine
+  TESTASSERT(placement.configure("TXRX=0:fifo:90; WORKER*=0:rr ;*=any:other", err, &warnings));
+  TESTASSERT(placement.is_enabled());
+  TESTASSERT(placement.to_string() == "TXRX: CPUs 0 fifo 90\nWORKER*: CPUs 0 rr 50\n*: CPUs any other\n");
+
+  // Both real-time rules share CPU 0 and the last one may use any CPU
+  TESTASSERT(not warnings.empty());
+
+  // CPU ranges and lists
+  if (get_nprocs_conf() >= 4) {
+    TESTASSERT(placement.configure("STACK=0,2-3", err));
+    TESTASSERT(placement.to_string() == "STACK: CPUs 0 2-3 inherited\n");
+  }
+}
+
+void test_invalid()
+{
+  thread_placement& placement = thread_placement::get();
+  std::string       err;
+
+  TESTASSERT(placement.configure("STACK=0", err));
+  TESTASSERT(not placement.configure("STACK", err));
+  TESTASSERT(not placement.configure("=0", err));
+  TESTASSERT(not placement.configure("STACK=a", err));
+  TESTASSERT(not placement.configure("STACK=3-1", err));
+  TESTASSERT(not placement.configure("STACK=" + std::to_string(get_nprocs_conf()), err));
+  TESTASSERT(not placement.configure("STACK=0:idle", err));
+  TESTASSERT(not placement.configure("STACK=0:fifo:100", err));
+  TESTASSERT(not placement.configure("STACK=0:other:10", err));
+  TESTASSERT(not placement.configure("ST*CK=0", err));
+  TESTASSERT(not placement.configure("STACK=0;STACK=0", err));
+  TESTASSERT(not err.empty());
+
+  // The previous valid profile is kept
+  TESTASSERT(placement.to_string() == "STACK: CPUs 0 inherited\n");
+}
+
+void test_apply()
+{
+  thread_placement& placement = thread_placement::get();
+  std::string       err;
+
+  // Pinning to CPU 0 without changing the scheduling does not require privileges
+  TESTASSERT(placement.configure("PLACEMENT_TEST*=0", err));
+  TESTASSERT(placement.apply_self("PLACEMENT_TEST_THREAD"));
+  TESTASSERT(not placement.apply_self("OTHER"));
+
+  cpu_set_t cpus;
+  TESTASSERT(sched_getaffinity(0, sizeof(cpus), &cpus) == 0);
+  TESTASSERT(CPU_COUNT(&cpus) == 1 and CPU_ISSET(0, &cpus));
+
+  TESTASSERT(placement.configure("", err));
+}
+
+int main()
+{
+  test_parse();
+  test_invalid();
+  test_apply();
+  return 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/tti_sempahore.h"
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Workers pick up TTIs in any order, but they have to be released in the order the TTIs were pushed, as the TX of the
+ * PHY workers. The test is run with and without spinning, to cover both the spin and the futex paths.
+ */
+static int test_tti_semaphore_order(uint32_t spin_budget)
+{
+  const uint32_t nof_workers = 4, nof_ttis = 20000;
+
+  srsran::tti_semaphore<uint32_t> semaphore(spin_budget);
+  std::vector<uint32_t>           released;
+  std::mutex                      sync_mutex;
+  uint32_t                        next_tti = 0;
+
+  // Each worker takes the next TTI and pushes it in order, as the sync thread does
+  std::vector<std::thread> workers;
+  for (uint32_t w = 0; w < nof_workers; ++w) {
+    workers.emplace_back([&]() {
+      while (true) {
+        uint32_t tti;
+        {
+          std::lock_guard<std::mutex> lock(sync_mutex);
+          if (next_tti >= nof_ttis) {
+            break;
+          }
+          tti = next_tti++;
+          semaphore.push(tti);
+        }
+        // fake processing, with varying duration
+        if (tti % 7 == 0) {
+          std::this_thread::sleep_for(std::chrono::microseconds(10));
+        }
+        semaphore.wait(tti);
+        released.push_back(tti);
+        semaphore.release();
+      }
+    });
+  }
+  for (auto& t : workers) {
+    t.join();
+  }
+  semaphore.wait_all();
+
+  TESTASSERT(released.size() == nof_ttis);
+  for (uint32_t i = 0; i < nof_ttis; ++i) {
+    TESTASSERT(released[i] == i);
+  }
+
+  srsran::tti_semaphore_stats_t stats = semaphore.get_wait_stats();
+  uint64_t                      total = 0;
+  for (uint64_t count : stats.wait_us_hist) {
+    total += count;
+  }
+  TESTASSERT(stats.nof_waits >= nof_ttis + 1);
+  TESTASSERT(total == stats.nof_waits);
+  TESTASSERT(stats.nof_sleeps <= stats.nof_waits);
+  printf("spin_budget=%d: waits=%" PRIu64 ", sleeps=%" PRIu64 ", waits < 1us=%" PRIu64 "\n",
+         spin_budget,
+         stats.nof_waits,
+         stats.nof_sleeps,
+         stats.wait_us_hist[0]);
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * The pushing thread waits for a release when the FIFO is full
+ */
+static int test_tti_semaphore_full()
+{
+  srsran::tti_semaphore<uint32_t, 4> semaphore(0);
+  std::atomic<bool>                  pushed{false};
+
+  for (uint32_t i = 0; i < 4; ++i) {
+    semaphore.push(i);
+  }
+  std::thread t([&]() {
+    semaphore.push(4);
+    pushed = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  TESTASSERT(not pushed);
+
+  semaphore.wait(0);
+  semaphore.release();
+  t.join();
+  TESTASSERT(pushed);
+
+  for (uint32_t i = 1; i < 5; ++i) {
+    semaphore.wait(i);
+    semaphore.release();
+  }
+  semaphore.wait_all();
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_tti_semaphore_order(srsran::tti_semaphore<uint32_t>::default_spin_budget) == SRSRAN_SUCCESS);
+  TESTASSERT(test_tti_semaphore_order(0) == SRSRAN_SUCCESS);
+  TESTASSERT(test_tti_semaphore_full() == SRSRAN_SUCCESS);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
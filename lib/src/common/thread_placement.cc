@@ -0,0 +1,341 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsran/common/thread_placement.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/sysinfo.h>
+#include <unistd.h>
+
+namespace srsran {
+
+static std::vector<std::string> split(const std::string& str, char sep)
+{
+  std::vector<std::string> ret;
+  std::stringstream        ss(str);
+  std::string              item;
+  while (std::getline(ss, item, sep)) {
+    // Trim the white spaces around each item
+    size_t first = item.find_first_not_of(" \t");
+    size_t last  = item.find_last_not_of(" \t");
+    ret.push_back(first == std::string::npos ? "" : item.substr(first, last - first + 1));
+  }
+  return ret;
+}
+
+static bool parse_uint(const std::string& str, int& value)
+{
+  if (str.empty() || str.find_first_not_of("0123456789") != std::string::npos || str.size() > 6) {
+    return false;
+  }
+  value = atoi(str.c_str());
+  return true;
+}
+
+static bool parse_cpus(const std::string& str, thread_placement::rule_t& rule, std::string& err)
+{
+  if (str == "any") {
+    rule.set_cpus = false;
+    return true;
+  }
+
+  int nof_cpus = get_nprocs_conf();
+  CPU_ZERO(&rule.cpus);
+  for (const std::string& range : split(str, ',')) {
+    std::vector<std::string> limits = split(range, '-');
+    int                      first = 0, last = 0;
+    if (limits.empty() || limits.size() > 2 || !parse_uint(limits.front(), first) ||
+        !parse_uint(limits.back(), last) || first > last) {
+      err = "invalid CPU range '" + range + "'";
+      return false;
+    }
+    if (last >= nof_cpus || last >= CPU_SETSIZE) {
+      err = "CPU " + std::to_string(last) + " does not exist, there are " + std::to_string(nof_cpus) + " CPUs";
+      return false;
+    }
+    for (int cpu = first; cpu <= last; cpu++) {
+      CPU_SET(cpu, &rule.cpus);
+    }
+  }
+  rule.set_cpus = true;
+  return true;
+}
+
+static bool parse_rule(const std::string& str, thread_placement::rule_t& rule, std::string& err)
+{
+  size_t eq = str.find('=');
+  if (eq == std::string::npos || eq == 0) {
+    err = "expected NAME=CPUS[:POLICY[:PRIORITY]]";
+    return false;
+  }
+  rule.pattern = str.substr(0, eq);
+  if (rule.pattern.find('*') != std::string::npos && rule.pattern.find('*') != rule.pattern.size() - 1) {
+    err = "'*' is only supported at the end of the name";
+    return false;
+  }
+
+  std::vector<std::string> fields = split(str.substr(eq + 1), ':');
+  if (fields.empty() || fields.size() > 3) {
+    err = "expected NAME=CPUS[:POLICY[:PRIORITY]]";
+    return false;
+  }
+  if (!parse_cpus(fields[0], rule, err)) {
+    return false;
+  }
+
+  if (fields.size() > 1) {
+    if (fields[1] == "fifo") {
+      rule.policy = SCHED_FIFO;
+    } else if (fields[1] == "rr") {
+      rule.policy = SCHED_RR;
+    } else if (fields[1] == "other") {
+      rule.policy = SCHED_OTHER;
+    } else {
+      err = "unknown scheduling policy '" + fields[1] + "'";
+      return false;
+    }
+  }
+
+  if (rule.policy == SCHED_FIFO || rule.policy == SCHED_RR) {
+    int min = sched_get_priority_min(rule.policy);
+    int max = sched_get_priority_max(rule.policy);
+    rule.priority = (min + max) / 2;
+    if (fields.size() > 2 && (!parse_uint(fields[2], rule.priority) || rule.priority < min || rule.priority > max)) {
+      err = "the priority must be between " + std::to_string(min) + " and " + std::to_string(max);
+      return false;
+    }
+  } else if (fields.size() > 2) {
+    err = "a priority is only valid with the fifo and rr policies";
+    return false;
+  }
+  return true;
+}
+
+static bool matches(const std::string& pattern, const std::string& name)
+{
+  if (!pattern.empty() && pattern.back() == '*') {
+    return name.compare(0, pattern.size() - 1, pattern, 0, pattern.size() - 1) == 0;
+  }
+  return name == pattern;
+}
+
+thread_placement& thread_placement::get()
+{
+  static thread_placement instance;
+  return instance;
+}
+
+bool thread_placement::configure(const std::string& profile, std::string& err, std::vector<std::string>* warnings)
+{
+  std::vector<rule_t> new_rules;
+  for (const std::string& str : split(profile, ';')) {
+    if (str.empty()) {
+      continue;
+    }
+    rule_t rule = {};
+    if (!parse_rule(str, rule, err)) {
+      err = "rule '" + str + "': " + err;
+      return false;
+    }
+    for (const rule_t& r : new_rules) {
+      if (r.pattern == rule.pattern) {
+        err = "rule '" + str + "': duplicated thread name";
+        return false;
+      }
+    }
+    new_rules.push_back(rule);
+  }
+
+  // Real-time threads sharing CPUs with the threads of other rules are not isolated
+  if (warnings != nullptr) {
+    for (const rule_t& a : new_rules) {
+      if (a.policy != SCHED_FIFO && a.policy != SCHED_RR) {
+        continue;
+      }
+      for (const rule_t& b : new_rules) {
+        cpu_set_t both;
+        if (&a == &b) {
+          continue;
+        }
+        if (!a.set_cpus || !b.set_cpus) {
+          warnings->push_back("threads " + a.pattern + " are real-time but may share CPUs with " + b.pattern);
+          continue;
+        }
+        CPU_AND(&both, &a.cpus, &b.cpus);
+        if (CPU_COUNT(&both) > 0) {
+          warnings->push_back("threads " + a.pattern + " are real-time and share CPUs with " + b.pattern);
+        }
+      }
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  rules   = std::move(new_rules);
+  enabled = !rules.empty();
+  return true;
+}
+
+const thread_placement::rule_t* thread_placement::find(const std::string& name) const
+{
+  for (const rule_t& rule : rules) {
+    if (matches(rule.pattern, name)) {
+      return &rule;
+    }
+  }
+  return nullptr;
+}
+
+bool thread_placement::get_cpus(const std::string& name, cpu_set_t& cpus) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  const rule_t*               r = find(name);
+  if (r == nullptr || !r->set_cpus) {
+    return false;
+  }
+  cpus = r->cpus;
+  return true;
+}
+
+bool thread_placement::apply(const rule_t& rule, pid_t tid, const std::string& name)
+{
+  bool ret = true;
+  if (rule.set_cpus && sched_setaffinity(tid, sizeof(cpu_set_t), &rule.cpus)) {
+    fprintf(stderr, "Error: failed to set the CPU affinity of thread %s: %s\n", name.c_str(), strerror(errno));
+    ret = false;
+  }
+  if (rule.policy >= 0) {
+    struct sched_param param = {};
+    param.sched_priority     = (rule.policy == SCHED_OTHER) ? 0 : rule.priority;
+    if (sched_setscheduler(tid, rule.policy, &param)) {
+      fprintf(stderr, "Error: failed to set the scheduling of thread %s: %s\n", name.c_str(), strerror(errno));
+      ret = false;
+    }
+  }
+  return ret;
+}
+
+bool thread_placement::apply_self(const std::string& name)
+{
+  if (!enabled) {
+    return false;
+  }
+  rule_t rule = {};
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    const rule_t*               r = find(name);
+    if (r == nullptr) {
+      return false;
+    }
+    rule = *r;
+  }
+  return apply(rule, 0, name);
+}
+
+uint32_t thread_placement::apply_all()
+{
+  if (!enabled) {
+    return 0;
+  }
+
+  DIR* dir = opendir("/proc/self/task");
+  if (dir == nullptr) {
+    perror("opendir /proc/self/task");
+    return 0;
+  }
+
+  uint32_t       count = 0;
+  struct dirent* entry = nullptr;
+  while ((entry = readdir(dir)) != nullptr) {
+    if (entry->d_name[0] == '.') {
+      continue;
+    }
+    std::ifstream comm(std::string("/proc/self/task/") + entry->d_name + "/comm");
+    std::string   name;
+    if (!std::getline(comm, name)) {
+      continue;
+    }
+
+    rule_t rule = {};
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      const rule_t*               r = find(name);
+      if (r == nullptr) {
+        continue;
+      }
+      rule = *r;
+    }
+    if (apply(rule, (pid_t)atoi(entry->d_name), name)) {
+      count++;
+    }
+  }
+  closedir(dir);
+  return count;
+}
+
+std::string thread_placement::to_string() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  std::stringstream           ss;
+  for (const rule_t& rule : rules) {
+    ss << rule.pattern << ": CPUs ";
+    if (rule.set_cpus) {
+      for (int cpu = 0, first = -1; cpu <= CPU_SETSIZE; cpu++) {
+        bool set = cpu < CPU_SETSIZE && CPU_ISSET(cpu, &rule.cpus);
+        if (set && first < 0) {
+          first = cpu;
+        } else if (!set && first >= 0) {
+          ss << first;
+          if (cpu - 1 > first) {
+            ss << "-" << cpu - 1;
+          }
+          ss << " ";
+          first = -1;
+        }
+      }
+    } else {
+      ss << "any ";
+    }
+    switch (rule.policy) {
+      case SCHED_FIFO:
+        ss << "fifo " << rule.priority;
+        break;
+      case SCHED_RR:
+        ss << "rr " << rule.priority;
+        break;
+      case SCHED_OTHER:
+        ss << "other";
+        break;
+      default:
+        ss << "inherited";
+        break;
+    }
+    ss << "\n";
+  }
+  return ss.str();
+}
+
+} // namespace srsran
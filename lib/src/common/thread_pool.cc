@@ -71,7 +71,13 @@ uint32_t thread_pool::worker::get_id()
 }
 
 thread_pool::thread_pool(uint32_t max_workers_, std::string id_) :
-  workers(max_workers_), max_workers(max_workers_), status(max_workers_), cvar_worker(max_workers_), id(id_)
+  workers(max_workers_),
+  max_workers(max_workers_),
+  status(max_workers_),
+  cvar_worker(max_workers_),
+  id(id_),
+  logger(srslog::fetch_basic_logger("POOL")),
+  start_time(max_workers_)
 {
   for (uint32_t i = 0; i < max_workers; i++) {
     workers[i] = NULL;
@@ -145,6 +151,9 @@ void thread_pool::worker::wait_to_start()
 void thread_pool::worker::finished()
 {
   std::lock_guard<std::mutex> lock(my_parent->mutex_queue);
+  if (my_parent->status[my_id] == WORKING) {
+    my_parent->job_finished(my_id);
+  }
   if (my_parent->status[my_id] != STOP) {
     my_parent->status[my_id] = IDLE;
     my_parent->cvar_worker[my_id].notify_all();
@@ -160,7 +169,8 @@ bool thread_pool::worker::is_stopped() const
 
 bool thread_pool::find_finished_worker(uint32_t tti, uint32_t* id)
 {
-  for (uint32_t i = 0; i < nof_workers; i++) {
+  uint32_t nof_candidates = (min_active_workers > 0) ? nof_active_workers : nof_workers;
+  for (uint32_t i = 0; i < nof_candidates; i++) {
     if (status[i] == IDLE) {
       *id = i;
       return true;
@@ -197,6 +207,10 @@ thread_pool::worker* thread_pool::wait_worker(uint32_t tti)
   thread_pool::worker* ret = nullptr;
   uint32_t             id  = 0;
 
+  if (min_active_workers > 0) {
+    adapt_active_workers(find_finished_worker(tti, &id));
+  }
+
   while (!find_finished_worker(tti, &id) && running) {
     cvar_queue.wait(lock);
   }
@@ -232,7 +246,8 @@ void thread_pool::start_worker(uint32_t id)
   if (id < nof_workers) {
     debug_thread("start_worker() id=%d, status=%d\n", id, status[id]);
     if (status[id] != STOP) {
-      status[id] = START_WORK;
+      status[id]     = START_WORK;
+      start_time[id] = std::chrono::steady_clock::now();
       cvar_worker[id].notify_all();
       cvar_queue.notify_all();
     }
@@ -267,14 +282,96 @@ std::string thread_pool::get_id()
   return id;
 }
 
+void thread_pool::set_adaptive(uint32_t min_workers, uint32_t tti_us_, uint32_t deadline_us_, uint32_t window_len_)
+{
+  std::lock_guard<std::mutex> lock(mutex_queue);
+  min_active_workers = std::min(min_workers, nof_workers);
+  nof_active_workers = nof_workers;
+  tti_us             = std::max(tti_us_, 1u);
+  deadline_us        = deadline_us_;
+  window_len         = std::max(window_len_, 1u);
+  window_count       = 0;
+  window_max_us      = 0;
+  window_late        = 0;
+  cvar_queue.notify_all();
+}
+
+uint32_t thread_pool::get_nof_active_workers()
+{
+  std::lock_guard<std::mutex> lock(mutex_queue);
+  return (min_active_workers > 0) ? nof_active_workers : nof_workers;
+}
+
+// Called with the queue mutex locked when a worker ends its job
+void thread_pool::job_finished(uint32_t id_)
+{
+  if (min_active_workers == 0) {
+    return;
+  }
+  auto elapsed_us = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start_time[id_])
+                        .count();
+  window_max_us = std::max(window_max_us, elapsed_us);
+  window_count++;
+  if (deadline_us > 0 && elapsed_us > deadline_us) {
+    window_late++;
+  }
+}
+
+// Called with the queue mutex locked before handing out a worker
+void thread_pool::adapt_active_workers(bool idle_found)
+{
+  // Grow right away if the caller would have to wait for a worker, or if a job missed its deadline
+  if ((!idle_found || window_late > 0) && nof_active_workers < nof_workers) {
+    nof_active_workers++;
+    logger.info("Thread pool %s: growing to %d active workers (idle=%s, late=%d, max=%d us)",
+                id.c_str(),
+                nof_active_workers,
+                idle_found ? "yes" : "no",
+                window_late,
+                window_max_us);
+    window_count  = 0;
+    window_max_us = 0;
+    window_late   = 0;
+    return;
+  }
+
+  if (window_count < window_len) {
+    return;
+  }
+
+  // Shrink if the longest job of the window would still leave a worker idle at every TTI with one worker less, a
+  // quarter of margin is left for the processing time variations
+  if (window_late == 0 && nof_active_workers > min_active_workers &&
+      window_max_us * 4 < (nof_active_workers - 1) * tti_us * 3) {
+    nof_active_workers--;
+    logger.info(
+        "Thread pool %s: parking a worker, %d active (max=%d us)", id.c_str(), nof_active_workers, window_max_us);
+  }
+  window_count  = 0;
+  window_max_us = 0;
+  window_late   = 0;
+}
+
 /**************************************************************************
- *  task_thread_pool - uses a queue to enqueue callables, that start
- *  once a worker is available
+ *  task_thread_pool - uses a queue per worker to enqueue callables, that
+ *  start once a worker is available. Idle workers steal from the others
  *************************************************************************/
 
+namespace {
+
+/// Pool and worker index of the calling thread, when it is a task_thread_pool worker
+thread_local const void* current_pool       = nullptr;
+thread_local uint32_t    current_worker_idx = 0;
+
+} // namespace
+
 task_thread_pool::task_thread_pool(uint32_t nof_workers, bool start_deferred, int32_t prio_, uint32_t mask_) :
-  logger(srslog::fetch_basic_logger("POOL")), pending_tasks(max_task_num), workers(std::max(1u, nof_workers))
+  logger(srslog::fetch_basic_logger("POOL")),
+  queues(new task_queue_t[max_workers]),
+  workers(std::min(std::max(1u, nof_workers), uint32_t(max_workers)))
 {
+  nof_queues = workers.size();
   if (not start_deferred) {
     start(prio_, mask_);
   }
@@ -292,8 +389,13 @@ void task_thread_pool::set_nof_workers(uint32_t nof_workers)
     logger.error("Reducing the number of workers dynamically not supported");
     return;
   }
+  if (nof_workers > max_workers) {
+    logger.error("The number of workers is limited to %u", uint32_t(max_workers));
+    nof_workers = max_workers;
+  }
   uint32_t old_size = workers.size();
   workers.resize(nof_workers);
+  nof_queues.store(nof_workers, std::memory_order_release);
   if (running) {
     for (uint32_t i = old_size; i < nof_workers; ++i) {
       workers[i].reset(new worker_t(this, i));
@@ -338,23 +440,141 @@ void task_thread_pool::stop()
   }
 }
 
-void task_thread_pool::push_task(task_t&& task)
+void task_thread_pool::push_task(task_t&& task, task_priority priority)
 {
+  if (nof_pending.load(std::memory_order_relaxed) >= max_task_num) {
+    logger.error("Cannot push anymore tasks into the queue, maximum size is %u", uint32_t(max_task_num));
+    return;
+  }
+
+  // Workers keep the tasks they push, the other threads spread them among the workers
+  uint32_t idx = current_pool == this
+                     ? current_worker_idx
+                     : next_queue.fetch_add(1, std::memory_order_relaxed) % nof_queues.load(std::memory_order_acquire);
+  task_queue_t& q = queues[idx];
   {
-    std::lock_guard<std::mutex> lock(queue_mutex);
-    if (pending_tasks.full()) {
-      logger.error("Cannot push anymore tasks into the queue, maximum size is %u", uint32_t(max_task_num));
-      return;
+    std::lock_guard<std::mutex> lock(q.mutex);
+    q.tasks[static_cast<uint32_t>(priority)].push_back(std::move(task));
+    q.size.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  uint32_t pending      = nof_pending.fetch_add(1) + 1;
+  uint32_t max_pending_ = max_pending.load(std::memory_order_relaxed);
+  while (pending > max_pending_ and
+         not max_pending.compare_exchange_weak(max_pending_, pending, std::memory_order_relaxed)) {
+  }
+
+  // The sleeping workers check nof_pending with the lock held, after increasing nof_sleeping
+  if (nof_sleeping.load() > 0) {
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex);
+    }
+    cv_empty.notify_one();
+  }
+}
+
+bool task_thread_pool::pop_task(uint32_t worker_idx, task_t* task)
+{
+  uint32_t n = nof_queues.load(std::memory_order_acquire);
+  for (uint32_t p = 0; p < nof_priorities; ++p) {
+    // Own queue first, then steal from the next workers
+    for (uint32_t k = 0; k < n; ++k) {
+      task_queue_t& q = queues[(worker_idx + k) % n];
+      if (q.size.load(std::memory_order_relaxed) == 0) {
+        continue;
+      }
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (q.tasks[p].empty()) {
+        continue;
+      }
+      *task = std::move(q.tasks[p].front());
+      q.tasks[p].pop_front();
+      q.size.fetch_sub(1, std::memory_order_relaxed);
+      nof_pending.fetch_sub(1, std::memory_order_relaxed);
+      if (k > 0) {
+        queues[worker_idx].nof_steals.fetch_add(1, std::memory_order_relaxed);
+      }
+      return true;
     }
-    pending_tasks.push(std::move(task));
   }
-  cv_empty.notify_one();
+  return false;
 }
 
 uint32_t task_thread_pool::nof_pending_tasks() const
 {
-  std::lock_guard<std::mutex> lock(queue_mutex);
-  return pending_tasks.size();
+  return nof_pending.load(std::memory_order_relaxed);
+}
+
+void task_thread_pool::get_metrics(metrics_t& metrics)
+{
+  metrics.nof_pending_tasks = nof_pending.load(std::memory_order_relaxed);
+  metrics.max_pending_tasks = max_pending.exchange(metrics.nof_pending_tasks, std::memory_order_relaxed);
+  metrics.workers.resize(nof_queues.load(std::memory_order_acquire));
+  for (uint32_t i = 0; i < metrics.workers.size(); ++i) {
+    metrics.workers[i].queue_depth = queues[i].size.load(std::memory_order_relaxed);
+    metrics.workers[i].nof_tasks   = queues[i].nof_tasks.load(std::memory_order_relaxed);
+    metrics.workers[i].nof_steals  = queues[i].nof_steals.load(std::memory_order_relaxed);
+  }
+}
+
+namespace {
+
+/// State shared by the calling thread and the pool workers taking part in a parallel_for. It is reference counted,
+/// as workers may only pick up their task after all the indexes have been run.
+struct parallel_for_state {
+  void (*task)(void*, uint32_t) = nullptr;
+  void*                   arg       = nullptr;
+  uint32_t                nof_tasks = 0;
+  std::atomic<uint32_t>   next_idx{0};
+  uint32_t                nof_done = 0;
+  std::mutex              mutex;
+  std::condition_variable cvar;
+
+  /// Runs the next pending index, returns false if there is none left
+  bool run_next()
+  {
+    uint32_t idx = next_idx.fetch_add(1);
+    if (idx >= nof_tasks) {
+      return false;
+    }
+    task(arg, idx);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (++nof_done == nof_tasks) {
+      cvar.notify_one();
+    }
+    return true;
+  }
+};
+
+} // namespace
+
+void task_thread_pool::parallel_for(uint32_t nof_tasks, void (*task)(void* arg, uint32_t idx), void* arg)
+{
+  if (nof_tasks == 0) {
+    return;
+  }
+
+  std::shared_ptr<parallel_for_state> state = std::make_shared<parallel_for_state>();
+  state->task                               = task;
+  state->arg                                = arg;
+  state->nof_tasks                          = nof_tasks;
+
+  for (uint32_t i = 1; i < nof_tasks; ++i) {
+    push_task(
+        [state]() {
+          while (state->run_next()) {
+          }
+        },
+        task_priority::high);
+  }
+  while (state->run_next()) {
+  }
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  while (state->nof_done != nof_tasks) {
+    state->cvar.wait(lock);
+  }
 }
 
 task_thread_pool::worker_t::worker_t(srsran::task_thread_pool* parent_, uint32_t my_id) :
@@ -374,26 +594,30 @@ void task_thread_pool::worker_t::stop()
 
 bool task_thread_pool::worker_t::wait_task(task_t* task)
 {
-  std::unique_lock<std::mutex> lock(parent->queue_mutex);
-  while (parent->running and parent->pending_tasks.empty()) {
-    parent->cv_empty.wait(lock);
-  }
-  if (not parent->running) {
-    return false;
-  }
-  if (task) {
-    *task = std::move(parent->pending_tasks.top());
+  while (parent->running) {
+    if (parent->pop_task(id_, task)) {
+      return true;
+    }
+    std::unique_lock<std::mutex> lock(parent->queue_mutex);
+    parent->nof_sleeping++;
+    while (parent->running and parent->nof_pending == 0) {
+      parent->cv_empty.wait(lock);
+    }
+    parent->nof_sleeping--;
   }
-  parent->pending_tasks.pop();
-  return true;
+  return false;
 }
 
 void task_thread_pool::worker_t::run_thread()
 {
+  current_pool       = parent;
+  current_worker_idx = id_;
+
   // main loop
   task_t task;
   while (wait_task(&task)) {
     task();
+    parent->queues[id_].nof_tasks.fetch_add(1, std::memory_order_relaxed);
   }
 
   // on exit, notify pool class
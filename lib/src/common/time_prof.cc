@@ -22,6 +22,7 @@
 #include "srsran/common/time_prof.h"
 #include <algorithm>
 #include <inttypes.h>
+#include <memory>
 #include <numeric>
 
 using namespace srsran;
@@ -115,3 +116,76 @@ void sliding_window_stats<TUnit>::operator()(nanoseconds duration)
 
 template class srsran::sliding_window_stats<std::chrono::microseconds>;
 template class srsran::sliding_window_stats<std::chrono::milliseconds>;
+
+// tprof histograms
+
+tprof_histogram_metrics_t tprof_histogram::get_metrics_and_reset()
+{
+  std::array<uint64_t, nof_buckets> counts;
+  tprof_histogram_metrics_t         m;
+  m.name = name;
+  for (uint32_t i = 0; i != nof_buckets; ++i) {
+    counts[i] = buckets[i].exchange(0, std::memory_order_relaxed);
+    m.count += counts[i];
+  }
+  uint64_t sum = sum_ns.exchange(0, std::memory_order_relaxed);
+  uint64_t max = max_ns.exchange(0, std::memory_order_relaxed);
+  if (m.count == 0) {
+    return m;
+  }
+
+  // The bucket values are capped with the exact maximum, which is better than the precision of the last bucket
+  auto percentile_us = [&counts, &m, max](double q) {
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(q * m.count + 0.5));
+    uint64_t acc    = 0;
+    for (uint32_t i = 0; i != nof_buckets; ++i) {
+      acc += counts[i];
+      if (acc >= target) {
+        return std::min(bucket_value(i), max) / 1e3f;
+      }
+    }
+    return max / 1e3f;
+  };
+  m.avg_us  = sum / 1e3f / m.count;
+  m.p50_us  = percentile_us(0.5);
+  m.p99_us  = percentile_us(0.99);
+  m.p999_us = percentile_us(0.999);
+  m.max_us  = max / 1e3f;
+  return m;
+}
+
+static const char* tti_stage_names[] = {"ofdm", "chest", "pdcch", "pdsch", "pusch", "fec", "sched", "mac_pdu"};
+static_assert(sizeof(tti_stage_names) / sizeof(tti_stage_names[0]) == static_cast<size_t>(tti_stage::nof_stages),
+              "Missing TTI stage names");
+
+namespace {
+
+struct stage_histograms {
+  std::vector<std::unique_ptr<tprof_histogram> > hists;
+  stage_histograms()
+  {
+    for (const char* name : tti_stage_names) {
+      hists.emplace_back(new tprof_histogram(name));
+    }
+  }
+};
+
+} // namespace
+
+static stage_histograms& get_stage_histograms()
+{
+  static stage_histograms h;
+  return h;
+}
+
+tprof_histogram& srsran::get_stage_histogram(tti_stage stage)
+{
+  return *get_stage_histograms().hists[static_cast<size_t>(stage)];
+}
+
+void srsran::get_stage_metrics(std::vector<tprof_histogram_metrics_t>& metrics)
+{
+  for (auto& h : get_stage_histograms().hists) {
+    metrics.push_back(h->get_metrics_and_reset());
+  }
+}
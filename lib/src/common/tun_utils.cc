@@ -0,0 +1,292 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/tun_utils.h"
+#include "srsran/common/buffer_pool.h"
+
+#include <algorithm>
+#include <linux/bpf.h>
+#include <linux/if_tun.h>
+#include <linux/ip.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <stddef.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace srsran {
+
+// struct virtio_net_hdr, linux/virtio_net.h can not be included from C++
+struct vnet_hdr_t {
+  uint8_t  flags;
+  uint8_t  gso_type;
+  uint16_t hdr_len;
+  uint16_t gso_size;
+  uint16_t csum_start;
+  uint16_t csum_offset;
+};
+static const uint8_t vnet_hdr_f_needs_csum = 1;
+static const uint8_t vnet_hdr_gso_none     = 0;
+static const uint8_t vnet_hdr_gso_tcpv4    = 1;
+static const uint8_t vnet_hdr_gso_tcpv6    = 4;
+static const uint8_t vnet_hdr_gso_ecn      = 0x80;
+
+static const uint8_t tcp_flag_fin = 0x01;
+static const uint8_t tcp_flag_psh = 0x08;
+static const uint8_t tcp_flag_cwr = 0x80;
+
+// Loads a socket filter program and installs it as the queue selector of the TUN device, which takes its return value
+// modulo the number of queues
+static bool set_tun_steering_prog(int tun_fd, struct bpf_insn* prog, uint32_t nof_insns)
+{
+#ifdef TUNSETSTEERINGEBPF
+  static const char license[] = "GPL";
+  union bpf_attr    attr      = {};
+  attr.prog_type              = BPF_PROG_TYPE_SOCKET_FILTER;
+  attr.insns                  = (uint64_t)(uintptr_t)prog;
+  attr.insn_cnt               = nof_insns;
+  attr.license                = (uint64_t)(uintptr_t)license;
+  int prog_fd                 = syscall(__NR_bpf, BPF_PROG_LOAD, &attr, sizeof(attr));
+  if (prog_fd < 0) {
+    return false;
+  }
+  // The TUN device keeps a reference to the program
+  bool ret = ioctl(tun_fd, TUNSETSTEERINGEBPF, &prog_fd) == 0;
+  close(prog_fd);
+  return ret;
+#else
+  return false;
+#endif
+}
+
+bool tun_set_steering_by_daddr(int tun_fd)
+{
+  struct bpf_insn prog[3] = {};
+  // r6 = skb, needed by the packet loads
+  prog[0].code    = BPF_ALU64 | BPF_MOV | BPF_X;
+  prog[0].dst_reg = BPF_REG_6;
+  prog[0].src_reg = BPF_REG_1;
+  // r0 = ntohl(iph->daddr)
+  prog[1].code = BPF_LD | BPF_ABS | BPF_W;
+  prog[1].imm  = offsetof(struct iphdr, daddr);
+  prog[2].code = BPF_JMP | BPF_EXIT;
+  return set_tun_steering_prog(tun_fd, prog, 3);
+}
+
+bool tun_set_steering_by_flow(int tun_fd)
+{
+  struct bpf_insn prog[5] = {};
+  // r6 = skb, needed by the packet loads
+  prog[0].code    = BPF_ALU64 | BPF_MOV | BPF_X;
+  prog[0].dst_reg = BPF_REG_6;
+  prog[0].src_reg = BPF_REG_1;
+  // r0 = skb->hash, set from the socket for the locally generated packets
+  prog[1].code    = BPF_LDX | BPF_MEM | BPF_W;
+  prog[1].dst_reg = BPF_REG_0;
+  prog[1].src_reg = BPF_REG_1;
+  prog[1].off     = offsetof(struct __sk_buff, hash);
+  // if (r0 == 0) r0 = ntohl(iph->daddr)
+  prog[2].code    = BPF_JMP | BPF_JNE | BPF_K;
+  prog[2].dst_reg = BPF_REG_0;
+  prog[2].off     = 1;
+  prog[3].code    = BPF_LD | BPF_ABS | BPF_W;
+  prog[3].imm     = offsetof(struct iphdr, daddr);
+  prog[4].code    = BPF_JMP | BPF_EXIT;
+  return set_tun_steering_prog(tun_fd, prog, 5);
+}
+
+/// Ones' complement sum of the 16-bit words of data, in network byte order as laid out in memory
+static uint64_t csum_add(uint64_t sum, const uint8_t* data, uint32_t len)
+{
+  uint32_t i = 0;
+  for (; i + 4 <= len; i += 4) {
+    uint32_t w;
+    memcpy(&w, &data[i], 4);
+    sum += w;
+  }
+  for (; i + 2 <= len; i += 2) {
+    uint16_t w;
+    memcpy(&w, &data[i], 2);
+    sum += w;
+  }
+  if (i < len) {
+    uint8_t  last[2] = {data[i], 0};
+    uint16_t w;
+    memcpy(&w, last, 2);
+    sum += w;
+  }
+  return sum;
+}
+
+static uint16_t csum_fold(uint64_t sum)
+{
+  while (sum >> 16) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+  return ~(uint16_t)sum;
+}
+
+static void put_csum(uint8_t* field, uint16_t csum)
+{
+  memcpy(field, &csum, 2);
+}
+
+bool tun_vnet_enable_offloads(int tun_fd)
+{
+  int hdr_size = tun_vnet_hdr_size;
+  if (ioctl(tun_fd, TUNSETVNETHDRSZ, &hdr_size) < 0) {
+    return false;
+  }
+  unsigned int offloads = TUN_F_CSUM | TUN_F_TSO4 | TUN_F_TSO6 | TUN_F_TSO_ECN;
+  return ioctl(tun_fd, TUNSETOFFLOAD, offloads) == 0;
+}
+
+int tun_vnet_split(const uint8_t* frame, uint32_t len, std::vector<unique_byte_buffer_t>& pkts)
+{
+  if (len < tun_vnet_hdr_size) {
+    return -1;
+  }
+  vnet_hdr_t vnet_hdr;
+  memcpy(&vnet_hdr, frame, sizeof(vnet_hdr));
+  const uint8_t* pkt     = frame + tun_vnet_hdr_size;
+  uint32_t       pkt_len = len - tun_vnet_hdr_size;
+
+  uint8_t gso_type = vnet_hdr.gso_type & ~vnet_hdr_gso_ecn;
+  if (gso_type == vnet_hdr_gso_none) {
+    unique_byte_buffer_t out = make_byte_buffer();
+    if (out == nullptr or pkt_len > out->get_tailroom()) {
+      return -1;
+    }
+    memcpy(out->msg, pkt, pkt_len);
+    out->N_bytes = pkt_len;
+    // The checksum field holds the sum of the pseudo-header, the rest is summed from csum_start on
+    if (vnet_hdr.flags & vnet_hdr_f_needs_csum) {
+      uint32_t field = vnet_hdr.csum_start + vnet_hdr.csum_offset;
+      if (field + 2 > pkt_len) {
+        return -1;
+      }
+      uint16_t csum = csum_fold(csum_add(0, &out->msg[vnet_hdr.csum_start], pkt_len - vnet_hdr.csum_start));
+      put_csum(&out->msg[field], csum);
+    }
+    pkts.push_back(std::move(out));
+    return 1;
+  }
+  if (gso_type != vnet_hdr_gso_tcpv4 and gso_type != vnet_hdr_gso_tcpv6) {
+    return -1;
+  }
+
+  // IP and TCP headers, repeated in every segment
+  bool     ipv4   = gso_type == vnet_hdr_gso_tcpv4;
+  uint32_t ip_len = 0;
+  if (ipv4) {
+    if (pkt_len < 20 or (pkt[0] >> 4) != 4 or pkt[9] != IPPROTO_TCP) {
+      return -1;
+    }
+    ip_len = (pkt[0] & 0xf) * 4;
+  } else {
+    // Extension headers are not expected in front of the TCP header
+    if (pkt_len < 40 or (pkt[0] >> 4) != 6 or pkt[6] != IPPROTO_TCP) {
+      return -1;
+    }
+    ip_len = 40;
+  }
+  if (ip_len + 20 > pkt_len) {
+    return -1;
+  }
+  uint32_t tcp_len = (pkt[ip_len + 12] >> 4) * 4;
+  uint32_t hdr_len = ip_len + tcp_len;
+  uint32_t mss     = vnet_hdr.gso_size;
+  if (tcp_len < 20 or hdr_len >= pkt_len or mss == 0) {
+    return -1;
+  }
+
+  uint32_t seq0;
+  uint16_t id0;
+  memcpy(&seq0, &pkt[ip_len + 4], 4);
+  memcpy(&id0, &pkt[4], 2);
+  seq0 = ntohl(seq0);
+  id0  = ntohs(id0);
+
+  // Sum of the addresses of the pseudo-header, the same for all the segments
+  uint64_t addr_sum = ipv4 ? csum_add(0, &pkt[12], 8) : csum_add(0, &pkt[8], 32);
+
+  uint32_t payload_len = pkt_len - hdr_len;
+  int      nof_pkts    = 0;
+  for (uint32_t offset = 0; offset < payload_len; offset += mss) {
+    uint32_t seg_len = std::min(mss, payload_len - offset);
+    bool     first   = offset == 0;
+    bool     last    = offset + seg_len == payload_len;
+
+    unique_byte_buffer_t out = make_byte_buffer();
+    if (out == nullptr or hdr_len + seg_len > out->get_tailroom()) {
+      return -1;
+    }
+    uint8_t* ip  = out->msg;
+    uint8_t* tcp = out->msg + ip_len;
+    memcpy(ip, pkt, hdr_len);
+    memcpy(ip + hdr_len, pkt + hdr_len + offset, seg_len);
+    out->N_bytes = hdr_len + seg_len;
+
+    if (ipv4) {
+      uint16_t tot_len = htons(hdr_len + seg_len);
+      uint16_t id      = htons(id0 + nof_pkts);
+      memcpy(&ip[2], &tot_len, 2);
+      memcpy(&ip[4], &id, 2);
+      put_csum(&ip[10], 0);
+      put_csum(&ip[10], csum_fold(csum_add(0, ip, ip_len)));
+    } else {
+      uint16_t ip6_payload_len = htons(tcp_len + seg_len);
+      memcpy(&ip[4], &ip6_payload_len, 2);
+    }
+
+    uint32_t seq = htonl(seq0 + offset);
+    memcpy(&tcp[4], &seq, 4);
+    if (not last) {
+      tcp[13] &= ~(tcp_flag_fin | tcp_flag_psh);
+    }
+    if (not first) {
+      tcp[13] &= ~tcp_flag_cwr;
+    }
+    uint64_t sum = addr_sum + htons(IPPROTO_TCP) + htons(tcp_len + seg_len);
+    put_csum(&tcp[16], 0);
+    put_csum(&tcp[16], csum_fold(csum_add(sum, tcp, tcp_len + seg_len)));
+
+    pkts.push_back(std::move(out));
+    nof_pkts++;
+  }
+  return nof_pkts;
+}
+
+ssize_t tun_vnet_write(int tun_fd, const uint8_t* pkt, uint32_t len)
+{
+  uint8_t      vnet_hdr[tun_vnet_hdr_size] = {};
+  struct iovec iov[2];
+  iov[0].iov_base = vnet_hdr;
+  iov[0].iov_len  = tun_vnet_hdr_size;
+  iov[1].iov_base = const_cast<uint8_t*>(pkt);
+  iov[1].iov_len  = len;
+  ssize_t n       = writev(tun_fd, iov, 2);
+  return n < 0 ? n : std::max(n - (ssize_t)tun_vnet_hdr_size, (ssize_t)0);
+}
+
+} // namespace srsran
@@ -0,0 +1,451 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/xdp_socket.h"
+#include <array>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef HAVE_AF_XDP
+#include <linux/bpf.h>
+#include <linux/if_ether.h>
+#include <linux/if_link.h>
+#include <linux/if_xdp.h>
+#include <net/if.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace srsran {
+
+#ifdef HAVE_AF_XDP
+
+// Frames are received in 4 kB chunks aligned to 4 kB, so that they never cross a page of the pool memory
+static const size_t xdp_frame_size = 4096;
+static_assert(SRSRAN_MAX_BUFFER_SIZE_BYTES >= 2 * xdp_frame_size, "A byte buffer must hold an aligned frame");
+
+// Offsets of the Ethernet, IPv4 (without options) and UDP header fields
+static const uint32_t eth_type_offset    = 12;
+static const uint32_t ip_vihl_offset     = 14;
+static const uint32_t ip_frag_offset     = 20;
+static const uint32_t ip_proto_offset    = 23;
+static const uint32_t ip_src_offset      = 26;
+static const uint32_t ip_dst_offset      = 30;
+static const uint32_t udp_src_offset     = 34;
+static const uint32_t udp_dst_offset     = 36;
+static const uint32_t udp_len_offset     = 38;
+static const uint32_t udp_payload_offset = 42;
+
+static long sys_bpf(int cmd, union bpf_attr* attr)
+{
+  return syscall(__NR_bpf, cmd, attr, sizeof(*attr));
+}
+
+static bpf_insn make_insn(uint8_t code, uint8_t dst, uint8_t src, int16_t off, int32_t imm)
+{
+  bpf_insn insn = {};
+  insn.code     = code;
+  insn.dst_reg  = dst;
+  insn.src_reg  = src;
+  insn.off      = off;
+  insn.imm      = imm;
+  return insn;
+}
+
+// Value of a 16-bit field of the packet as loaded by the XDP program, i.e. its network order bytes read in host order
+static int32_t packet_u16(uint16_t host_value)
+{
+  return htons(host_value);
+}
+
+bool xdp_udp_socket::attach_program(uint32_t ifindex, in_addr_t addr, int port)
+{
+  union bpf_attr attr = {};
+
+  // XSKMAP indexed by the Rx queue, holding this socket in the entry of its queue
+  attr.map_type    = BPF_MAP_TYPE_XSKMAP;
+  attr.key_size    = sizeof(uint32_t);
+  attr.value_size  = sizeof(uint32_t);
+  attr.max_entries = queue_id + 1;
+  map_fd           = sys_bpf(BPF_MAP_CREATE, &attr);
+  if (map_fd < 0) {
+    logger.error("Failed to create the XSKMAP: %s", strerror(errno));
+    return false;
+  }
+  uint32_t key   = queue_id;
+  uint32_t value = xsk_fd;
+  attr           = {};
+  attr.map_fd    = map_fd;
+  attr.key       = (uint64_t)(uintptr_t)&key;
+  attr.value     = (uint64_t)(uintptr_t)&value;
+  attr.flags     = BPF_ANY;
+  if (sys_bpf(BPF_MAP_UPDATE_ELEM, &attr) < 0) {
+    logger.error("Failed to insert the AF_XDP socket in the XSKMAP: %s", strerror(errno));
+    return false;
+  }
+
+  // r1 = ctx, r2 = data, r3 = data_end. The datagrams that do not match jump to "pass"
+  std::vector<bpf_insn> prog;
+  std::vector<size_t>   jumps_to_pass;
+
+  auto check_field = [&prog, &jumps_to_pass](uint8_t size, uint32_t offset, int32_t value) {
+    prog.push_back(make_insn(BPF_LDX | BPF_MEM | size, BPF_REG_5, BPF_REG_2, offset, 0));
+    jumps_to_pass.push_back(prog.size());
+    prog.push_back(make_insn(BPF_JMP32 | BPF_JNE | BPF_K, BPF_REG_5, 0, 0, value));
+  };
+  prog.push_back(make_insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_6, BPF_REG_1, 0, 0));
+  prog.push_back(make_insn(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_2, BPF_REG_1, offsetof(xdp_md, data), 0));
+  prog.push_back(make_insn(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_3, BPF_REG_1, offsetof(xdp_md, data_end), 0));
+  prog.push_back(make_insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_4, BPF_REG_2, 0, 0));
+  prog.push_back(make_insn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_4, 0, 0, udp_payload_offset));
+  jumps_to_pass.push_back(prog.size());
+  prog.push_back(make_insn(BPF_JMP | BPF_JGT | BPF_X, BPF_REG_4, BPF_REG_3, 0, 0));
+  check_field(BPF_H, eth_type_offset, packet_u16(ETH_P_IP));
+  check_field(BPF_B, ip_vihl_offset, 0x45);
+  check_field(BPF_B, ip_proto_offset, IPPROTO_UDP);
+  // Fragments (MF flag or fragment offset) go to the kernel for reassembly
+  prog.push_back(make_insn(BPF_LDX | BPF_MEM | BPF_H, BPF_REG_5, BPF_REG_2, ip_frag_offset, 0));
+  prog.push_back(make_insn(BPF_ALU | BPF_AND | BPF_K, BPF_REG_5, 0, 0, packet_u16(0x3fff)));
+  jumps_to_pass.push_back(prog.size());
+  prog.push_back(make_insn(BPF_JMP32 | BPF_JNE | BPF_K, BPF_REG_5, 0, 0, 0));
+  check_field(BPF_H, udp_dst_offset, packet_u16(port));
+  if (addr != INADDR_ANY) {
+    check_field(BPF_W, ip_dst_offset, (int32_t)addr);
+  }
+  // return bpf_redirect_map(&xskmap, ctx->rx_queue_index, XDP_PASS)
+  prog.push_back(make_insn(BPF_LD | BPF_DW | BPF_IMM, BPF_REG_1, BPF_PSEUDO_MAP_FD, 0, map_fd));
+  prog.push_back(make_insn(0, 0, 0, 0, 0));
+  prog.push_back(make_insn(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_2, BPF_REG_6, offsetof(xdp_md, rx_queue_index), 0));
+  prog.push_back(make_insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_3, 0, 0, XDP_PASS));
+  prog.push_back(make_insn(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map));
+  prog.push_back(make_insn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+  for (size_t pc : jumps_to_pass) {
+    prog[pc].off = prog.size() - pc - 1;
+  }
+  prog.push_back(make_insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_PASS));
+  prog.push_back(make_insn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+
+  static const char license[] = "GPL";
+  std::array<char, 4096> verifier_log = {};
+  attr                                = {};
+  attr.prog_type                      = BPF_PROG_TYPE_XDP;
+  attr.insns                          = (uint64_t)(uintptr_t)prog.data();
+  attr.insn_cnt                       = prog.size();
+  attr.license                        = (uint64_t)(uintptr_t)license;
+  attr.log_buf                        = (uint64_t)(uintptr_t)verifier_log.data();
+  attr.log_size                       = verifier_log.size();
+  attr.log_level                      = 1;
+  prog_fd                             = sys_bpf(BPF_PROG_LOAD, &attr);
+  if (prog_fd < 0) {
+    logger.error("Failed to load the XDP program: %s\n%s", strerror(errno), verifier_log.data());
+    return false;
+  }
+
+  // Attach the program in native mode if the driver supports it, otherwise in generic mode. It is detached when the
+  // link is closed
+  for (uint32_t mode : {XDP_FLAGS_DRV_MODE, XDP_FLAGS_SKB_MODE}) {
+    attr                         = {};
+    attr.link_create.prog_fd     = prog_fd;
+    attr.link_create.target_fd   = ifindex;
+    attr.link_create.attach_type = BPF_XDP;
+    attr.link_create.flags       = mode;
+    link_fd                      = sys_bpf(BPF_LINK_CREATE, &attr);
+    if (link_fd >= 0) {
+      logger.info("XDP program attached in %s mode", mode == XDP_FLAGS_DRV_MODE ? "native" : "generic");
+      return true;
+    }
+  }
+  logger.error("Failed to attach the XDP program: %s", strerror(errno));
+  return false;
+}
+
+bool xdp_udp_socket::map_ring(ring_t& ring, const void* offsets_, size_t desc_sz, off_t pgoff)
+{
+  const xdp_ring_offset* offsets = static_cast<const xdp_ring_offset*>(offsets_);
+
+  ring.map_len = offsets->desc + nof_descs * desc_sz;
+  ring.map     = mmap(nullptr, ring.map_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, xsk_fd, pgoff);
+  if (ring.map == MAP_FAILED) {
+    ring.map = nullptr;
+    logger.error("Failed to map an AF_XDP ring: %s", strerror(errno));
+    return false;
+  }
+  ring.producer = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(ring.map) + offsets->producer);
+  ring.consumer = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(ring.map) + offsets->consumer);
+  ring.descs    = static_cast<uint8_t*>(ring.map) + offsets->desc;
+  return true;
+}
+
+bool xdp_udp_socket::open(const char* ifname, uint32_t queue_id_, const char* bind_addr, int port, uint32_t ring_size)
+{
+  close();
+  queue_id  = queue_id_;
+  nof_descs = ring_size;
+  if (nof_descs == 0 or (nof_descs & (nof_descs - 1)) != 0) {
+    logger.error("The AF_XDP ring size %d is not a power of 2", nof_descs);
+    return false;
+  }
+  uint32_t ifindex = if_nametoindex(ifname);
+  if (ifindex == 0) {
+    logger.error("Unknown network interface %s", ifname);
+    return false;
+  }
+  in_addr_t addr = INADDR_ANY;
+  if (bind_addr != nullptr and strlen(bind_addr) > 0 and inet_pton(AF_INET, bind_addr, &addr) != 1) {
+    logger.error("Invalid bind address %s", bind_addr);
+    return false;
+  }
+
+  // The UMEM is the whole byte buffer pool, the kernel only writes in the chunks passed through the fill ring
+  byte_buffer_pool* pool = byte_buffer_pool::get_instance();
+  size_t            page = sysconf(_SC_PAGESIZE);
+  pool_base              = static_cast<uint8_t*>(pool->get_memory());
+  block_size             = pool->get_memory_size() / pool->size();
+  umem_base              = reinterpret_cast<uint8_t*>((uintptr_t)pool_base & ~(page - 1));
+  size_t umem_len        = (pool_base + pool->get_memory_size() - umem_base + page - 1) & ~(page - 1);
+  lent_blocks.assign(pool->size(), false);
+
+  xsk_fd = socket(AF_XDP, SOCK_RAW, 0);
+  if (xsk_fd < 0) {
+    logger.error("Failed to create the AF_XDP socket: %s", strerror(errno));
+    return false;
+  }
+  xdp_umem_reg umem = {};
+  umem.addr         = (uint64_t)(uintptr_t)umem_base;
+  umem.len          = umem_len;
+  umem.chunk_size   = xdp_frame_size;
+  umem.flags        = XDP_UMEM_UNALIGNED_CHUNK_FLAG;
+  if (setsockopt(xsk_fd, SOL_XDP, XDP_UMEM_REG, &umem, sizeof(umem)) < 0) {
+    logger.error("Failed to register the byte buffer pool as UMEM: %s", strerror(errno));
+    close();
+    return false;
+  }
+  int ring_sz = nof_descs;
+  if (setsockopt(xsk_fd, SOL_XDP, XDP_UMEM_FILL_RING, &ring_sz, sizeof(ring_sz)) < 0 or
+      setsockopt(xsk_fd, SOL_XDP, XDP_UMEM_COMPLETION_RING, &ring_sz, sizeof(ring_sz)) < 0 or
+      setsockopt(xsk_fd, SOL_XDP, XDP_RX_RING, &ring_sz, sizeof(ring_sz)) < 0) {
+    logger.error("Failed to set up the AF_XDP rings: %s", strerror(errno));
+    close();
+    return false;
+  }
+  xdp_mmap_offsets offsets     = {};
+  socklen_t        offsets_len = sizeof(offsets);
+  if (getsockopt(xsk_fd, SOL_XDP, XDP_MMAP_OFFSETS, &offsets, &offsets_len) < 0) {
+    logger.error("Failed to get the AF_XDP ring offsets: %s", strerror(errno));
+    close();
+    return false;
+  }
+  if (not map_ring(fill_ring, &offsets.fr, sizeof(uint64_t), XDP_UMEM_PGOFF_FILL_RING) or
+      not map_ring(comp_ring, &offsets.cr, sizeof(uint64_t), XDP_UMEM_PGOFF_COMPLETION_RING) or
+      not map_ring(rx_ring, &offsets.rx, sizeof(xdp_desc), XDP_PGOFF_RX_RING)) {
+    close();
+    return false;
+  }
+  refill();
+
+  // Zero-copy is used if the driver supports it
+  sockaddr_xdp sxdp  = {};
+  sxdp.sxdp_family   = AF_XDP;
+  sxdp.sxdp_ifindex  = ifindex;
+  sxdp.sxdp_queue_id = queue_id;
+  if (bind(xsk_fd, (sockaddr*)&sxdp, sizeof(sxdp)) < 0) {
+    logger.error("Failed to bind the AF_XDP socket to %s queue %d: %s", ifname, queue_id, strerror(errno));
+    close();
+    return false;
+  }
+  xdp_options opts     = {};
+  socklen_t   opts_len = sizeof(opts);
+  zero_copy = getsockopt(xsk_fd, SOL_XDP, XDP_OPTIONS, &opts, &opts_len) == 0 and (opts.flags & XDP_OPTIONS_ZEROCOPY);
+
+  if (not attach_program(ifindex, addr, port)) {
+    close();
+    return false;
+  }
+  logger.info("AF_XDP socket receiving UDP port %d on %s queue %d in %s mode",
+              port,
+              ifname,
+              queue_id,
+              zero_copy ? "zero-copy" : "copy");
+  return true;
+}
+
+void xdp_udp_socket::close()
+{
+  for (int* fd : {&link_fd, &prog_fd, &map_fd, &xsk_fd}) {
+    if (*fd >= 0) {
+      ::close(*fd);
+      *fd = -1;
+    }
+  }
+  for (ring_t* ring : {&fill_ring, &comp_ring, &rx_ring}) {
+    if (ring->map != nullptr) {
+      munmap(ring->map, ring->map_len);
+    }
+    *ring = {};
+  }
+  // The kernel no longer owns the buffers of the fill and Rx rings
+  for (size_t i = 0; i < lent_blocks.size(); ++i) {
+    if (lent_blocks[i]) {
+      delete reinterpret_cast<byte_buffer_t*>(pool_base + i * block_size);
+    }
+  }
+  lent_blocks.clear();
+  zero_copy = false;
+}
+
+void xdp_udp_socket::refill()
+{
+  uint32_t  prod  = *fill_ring.producer;
+  uint32_t  cons  = __atomic_load_n(fill_ring.consumer, __ATOMIC_ACQUIRE);
+  uint64_t* addrs = static_cast<uint64_t*>(fill_ring.descs);
+  for (; prod - cons < nof_descs; ++prod) {
+    unique_byte_buffer_t pdu = make_byte_buffer();
+    if (pdu == nullptr) {
+      logger.error("Unable to allocate byte buffer for the AF_XDP fill ring");
+      break;
+    }
+    uint8_t* chunk = reinterpret_cast<uint8_t*>(((uintptr_t)pdu->buffer + xdp_frame_size - 1) & ~(xdp_frame_size - 1));
+    addrs[prod & (nof_descs - 1)] = chunk - umem_base;
+    lent_blocks[(reinterpret_cast<uint8_t*>(pdu.get()) - pool_base) / block_size] = true;
+    pdu.release();
+  }
+  __atomic_store_n(fill_ring.producer, prod, __ATOMIC_RELEASE);
+}
+
+int xdp_udp_socket::recv(unique_byte_buffer_t* pdus, sockaddr_in* from, uint32_t max_pdus)
+{
+  if (xsk_fd < 0) {
+    return 0;
+  }
+  uint32_t        cons     = *rx_ring.consumer;
+  uint32_t        prod     = __atomic_load_n(rx_ring.producer, __ATOMIC_ACQUIRE);
+  uint32_t        nof_rx   = std::min(prod - cons, std::min(max_pdus, max_batch_size));
+  const xdp_desc* descs    = static_cast<const xdp_desc*>(rx_ring.descs);
+  int             nof_pdus = 0;
+  for (uint32_t i = 0; i < nof_rx; ++i) {
+    const xdp_desc& desc  = descs[(cons + i) & (nof_descs - 1)];
+    uint8_t*        frame = umem_base + (desc.addr & XSK_UNALIGNED_BUF_ADDR_MASK) +
+                     (desc.addr >> XSK_UNALIGNED_BUF_OFFSET_SHIFT);
+    size_t          block = (frame - pool_base) / block_size;
+    lent_blocks[block]    = false;
+    unique_byte_buffer_t pdu(reinterpret_cast<byte_buffer_t*>(pool_base + block * block_size));
+
+    // The XDP program only redirects IPv4 datagrams without options, the UDP length still has to be checked
+    uint16_t udp_len = 0;
+    memcpy(&udp_len, frame + udp_len_offset, sizeof(udp_len));
+    udp_len = ntohs(udp_len);
+    if (desc.len < udp_payload_offset or udp_len < sizeof(udphdr) or udp_len > desc.len - udp_src_offset) {
+      logger.warning("Discarding malformed UDP datagram of %d bytes", desc.len);
+      continue;
+    }
+    pdu->msg     = frame + udp_payload_offset;
+    pdu->N_bytes = udp_len - sizeof(udphdr);
+
+    sockaddr_in& addr = from[nof_pdus];
+    addr              = {};
+    addr.sin_family   = AF_INET;
+    memcpy(&addr.sin_addr.s_addr, frame + ip_src_offset, sizeof(addr.sin_addr.s_addr));
+    memcpy(&addr.sin_port, frame + udp_src_offset, sizeof(addr.sin_port));
+    pdus[nof_pdus++] = std::move(pdu);
+  }
+  __atomic_store_n(rx_ring.consumer, cons + nof_rx, __ATOMIC_RELEASE);
+
+  refill();
+  return nof_pdus;
+}
+
+#else // HAVE_AF_XDP
+
+bool xdp_udp_socket::open(const char* ifname, uint32_t queue_id_, const char* bind_addr, int port, uint32_t ring_size)
+{
+  logger.error("AF_XDP sockets are not supported in this build");
+  return false;
+}
+
+void xdp_udp_socket::close() {}
+
+int xdp_udp_socket::recv(unique_byte_buffer_t* pdus, sockaddr_in* from, uint32_t max_pdus)
+{
+  return 0;
+}
+
+#endif // HAVE_AF_XDP
+
+namespace {
+
+/// Reads a batch of datagrams from the AF_XDP socket and pushes them as a single task to the queue
+class xdp_recv_pdu_task
+{
+public:
+  xdp_recv_pdu_task(srslog::basic_logger&      logger_,
+                    srsran::task_queue_handle& queue_,
+                    xdp_udp_socket&            socket_,
+                    recvfrom_callback_t        func_) :
+    logger(logger_), queue(queue_), socket(socket_), func(std::move(func_))
+  {}
+
+  bool operator()(int fd)
+  {
+    std::array<unique_byte_buffer_t, xdp_udp_socket::max_batch_size> pdus;
+    std::array<sockaddr_in, xdp_udp_socket::max_batch_size>          addrs;
+
+    int n_recv = socket.recv(pdus.data(), addrs.data(), pdus.size());
+    if (n_recv <= 0) {
+      return true;
+    }
+    rx_batch_t batch;
+    batch.reserve(n_recv);
+    for (int i = 0; i < n_recv; ++i) {
+      batch.emplace_back(std::move(pdus[i]), addrs[i]);
+    }
+
+    // Defer handling of the received packets to provided queue
+    queue.push(std::bind(
+        [this](rx_batch_t& sdus) {
+          for (auto& sdu : sdus) {
+            func(std::move(sdu.first), sdu.second);
+          }
+        },
+        std::move(batch)));
+    return true;
+  }
+
+private:
+  using rx_batch_t = std::vector<std::pair<srsran::unique_byte_buffer_t, sockaddr_in>>;
+
+  srslog::basic_logger&      logger;
+  srsran::task_queue_handle& queue;
+  xdp_udp_socket&            socket;
+  recvfrom_callback_t        func;
+};
+
+} // namespace
+
+socket_manager_itf::recv_callback_t make_xdp_sdu_handler(srslog::basic_logger&      logger,
+                                                         srsran::task_queue_handle& queue,
+                                                         xdp_udp_socket&            socket,
+                                                         recvfrom_callback_t        rx_callback)
+{
+  return socket_manager_itf::recv_callback_t(xdp_recv_pdu_task(logger, queue, socket, std::move(rx_callback)));
+}
+
+} // namespace srsran
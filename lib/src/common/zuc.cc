@@ -31,6 +31,8 @@
 
 #include "srsran/common/zuc.h"
 
+#include <string.h>
+
 #define MAKEU32(a, b, c, d) (((u32)(a) << 24) | ((u32)(b) << 16) | ((u32)(c) << 8) | ((u32)(d)))
 #define MulByPow2(x, k) ((((x) << k) | ((x) >> (31 - k))) & 0x7FFFFFFF)
 #define MAKEU31(a, b, c) (((u32)(a) << 23) | ((u32)(b) << 8) | (u32)(c))
@@ -252,3 +254,207 @@ void zuc_generate_keystream(zuc_state_t* state, int key_stream_len, u32* p_keyst
     LFSRWithWorkMode(state);
   }
 }
+
+/*
+ * keystream generation of several lanes in parallel
+ */
+
+/* generic implementation, lane by lane. A NULL p_keystream clocks the LFSR in initialisation mode */
+static void zuc_lanes_clock_gen(zuc_lanes_state_t* state, int n, u32* p_keystream)
+{
+  for (u32 l = 0; l < ZUC_MAX_LANES; l++) {
+    u32 s[16];
+    u32 R1 = state->F_R1[l];
+    u32 R2 = state->F_R2[l];
+    for (int i = 0; i < 16; i++) {
+      s[i] = state->LFSR_S[i][l];
+    }
+
+    for (int t = 0; t < n; t++) {
+      /* BitReorganization */
+      u32 X0 = ((s[15] & 0x7FFF8000) << 1) | (s[14] & 0xFFFF);
+      u32 X1 = ((s[11] & 0xFFFF) << 16) | (s[9] >> 15);
+      u32 X2 = ((s[7] & 0xFFFF) << 16) | (s[5] >> 15);
+      u32 X3 = ((s[2] & 0xFFFF) << 16) | (s[0] >> 15);
+
+      /* F */
+      u32 W  = (X0 ^ R1) + R2;
+      u32 W1 = R1 + X1;
+      u32 W2 = R2 ^ X2;
+      u32 u  = L1((W1 << 16) | (W2 >> 16));
+      u32 v  = L2((W2 << 16) | (W1 >> 16));
+      R1     = MAKEU32(S0[u >> 24], S1[(u >> 16) & 0xFF], S0[(u >> 8) & 0xFF], S1[u & 0xFF]);
+      R2     = MAKEU32(S0[v >> 24], S1[(v >> 16) & 0xFF], S0[(v >> 8) & 0xFF], S1[v & 0xFF]);
+
+      /* LFSR */
+      u32 f = s[0];
+      f     = AddM(f, MulByPow2(s[0], 8));
+      f     = AddM(f, MulByPow2(s[4], 20));
+      f     = AddM(f, MulByPow2(s[10], 21));
+      f     = AddM(f, MulByPow2(s[13], 17));
+      f     = AddM(f, MulByPow2(s[15], 15));
+      if (p_keystream == NULL) {
+        f = AddM(f, W >> 1);
+      } else {
+        p_keystream[t * ZUC_MAX_LANES + l] = W ^ X3;
+      }
+      memmove(&s[0], &s[1], 15 * sizeof(u32));
+      s[15] = f;
+    }
+
+    state->F_R1[l] = R1;
+    state->F_R2[l] = R2;
+    for (int i = 0; i < 16; i++) {
+      state->LFSR_S[i][l] = s[i];
+    }
+  }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+
+#define ZUC_AVX2_TARGET __attribute__((target("avx2")))
+#define ROT_AVX2(a, k) _mm256_or_si256(_mm256_slli_epi32(a, k), _mm256_srli_epi32(a, 32 - (k)))
+#define MulByPow2_AVX2(x, k)                                                                                         \
+  _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi32(x, k), _mm256_srli_epi32(x, 31 - (k))), m31)
+
+/* the s-boxes widened to 32 bits for the gathers */
+typedef struct {
+  u32 S0[256];
+  u32 S1[256];
+} zuc_sbox32_t;
+
+static const zuc_sbox32_t& zuc_sbox32()
+{
+  static const zuc_sbox32_t sbox = []() {
+    zuc_sbox32_t t;
+    for (int i = 0; i < 256; i++) {
+      t.S0[i] = S0[i];
+      t.S1[i] = S1[i];
+    }
+    return t;
+  }();
+  return sbox;
+}
+
+ZUC_AVX2_TARGET static inline __m256i AddM_AVX2(__m256i a, __m256i b, __m256i m31)
+{
+  __m256i c = _mm256_add_epi32(a, b);
+  return _mm256_add_epi32(_mm256_and_si256(c, m31), _mm256_srli_epi32(c, 31));
+}
+
+/* the s-boxes of the 4 bytes of every lane, MAKEU32(S0[], S1[], S0[], S1[]) */
+ZUC_AVX2_TARGET static inline __m256i SBOX_AVX2(const zuc_sbox32_t& sbox, __m256i x)
+{
+  const __m256i mask = _mm256_set1_epi32(0xFF);
+
+  __m256i b0 = _mm256_i32gather_epi32((const int*)sbox.S0, _mm256_srli_epi32(x, 24), 4);
+  __m256i b1 = _mm256_i32gather_epi32((const int*)sbox.S1, _mm256_and_si256(_mm256_srli_epi32(x, 16), mask), 4);
+  __m256i b2 = _mm256_i32gather_epi32((const int*)sbox.S0, _mm256_and_si256(_mm256_srli_epi32(x, 8), mask), 4);
+  __m256i b3 = _mm256_i32gather_epi32((const int*)sbox.S1, _mm256_and_si256(x, mask), 4);
+  return _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(b0, 24), _mm256_slli_epi32(b1, 16)),
+                         _mm256_or_si256(_mm256_slli_epi32(b2, 8), b3));
+}
+
+/* same as zuc_lanes_clock_gen(), with the 8 lanes in the 32-bit elements of AVX2 registers. The LFSR is a circular
+ * buffer, so it is not shifted in every clock */
+ZUC_AVX2_TARGET static void zuc_lanes_clock_avx2(zuc_lanes_state_t* state, int n, u32* p_keystream)
+{
+  const zuc_sbox32_t& sbox = zuc_sbox32();
+  const __m256i       m31  = _mm256_set1_epi32(0x7FFFFFFF);
+  const __m256i       m16  = _mm256_set1_epi32(0xFFFF);
+
+  __m256i s[16];
+  for (int i = 0; i < 16; i++) {
+    s[i] = _mm256_loadu_si256((const __m256i*)state->LFSR_S[i]);
+  }
+  __m256i R1 = _mm256_loadu_si256((const __m256i*)state->F_R1);
+  __m256i R2 = _mm256_loadu_si256((const __m256i*)state->F_R2);
+
+  for (int t = 0; t < n; t++) {
+#define LFSR_S(i) s[(t + (i)) & 15]
+    /* BitReorganization */
+    __m256i X0 = _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(LFSR_S(15), _mm256_set1_epi32(0x7FFF8000)), 1),
+                                 _mm256_and_si256(LFSR_S(14), m16));
+    __m256i X1 = _mm256_or_si256(_mm256_slli_epi32(LFSR_S(11), 16), _mm256_srli_epi32(LFSR_S(9), 15));
+    __m256i X2 = _mm256_or_si256(_mm256_slli_epi32(LFSR_S(7), 16), _mm256_srli_epi32(LFSR_S(5), 15));
+    __m256i X3 = _mm256_or_si256(_mm256_slli_epi32(LFSR_S(2), 16), _mm256_srli_epi32(LFSR_S(0), 15));
+
+    /* F */
+    __m256i W  = _mm256_add_epi32(_mm256_xor_si256(X0, R1), R2);
+    __m256i W1 = _mm256_add_epi32(R1, X1);
+    __m256i W2 = _mm256_xor_si256(R2, X2);
+    __m256i u  = _mm256_or_si256(_mm256_slli_epi32(W1, 16), _mm256_srli_epi32(W2, 16));
+    __m256i v  = _mm256_or_si256(_mm256_slli_epi32(W2, 16), _mm256_srli_epi32(W1, 16));
+    u          = _mm256_xor_si256(_mm256_xor_si256(u, ROT_AVX2(u, 2)),
+                         _mm256_xor_si256(_mm256_xor_si256(ROT_AVX2(u, 10), ROT_AVX2(u, 18)), ROT_AVX2(u, 24)));
+    v          = _mm256_xor_si256(_mm256_xor_si256(v, ROT_AVX2(v, 8)),
+                         _mm256_xor_si256(_mm256_xor_si256(ROT_AVX2(v, 14), ROT_AVX2(v, 22)), ROT_AVX2(v, 30)));
+    R1         = SBOX_AVX2(sbox, u);
+    R2         = SBOX_AVX2(sbox, v);
+
+    /* LFSR */
+    __m256i f = LFSR_S(0);
+    f         = AddM_AVX2(f, MulByPow2_AVX2(LFSR_S(0), 8), m31);
+    f         = AddM_AVX2(f, MulByPow2_AVX2(LFSR_S(4), 20), m31);
+    f         = AddM_AVX2(f, MulByPow2_AVX2(LFSR_S(10), 21), m31);
+    f         = AddM_AVX2(f, MulByPow2_AVX2(LFSR_S(13), 17), m31);
+    f         = AddM_AVX2(f, MulByPow2_AVX2(LFSR_S(15), 15), m31);
+    if (p_keystream == NULL) {
+      f = AddM_AVX2(f, _mm256_srli_epi32(W, 1), m31);
+    } else {
+      _mm256_storeu_si256((__m256i*)&p_keystream[t * ZUC_MAX_LANES], _mm256_xor_si256(W, X3));
+    }
+    LFSR_S(0) = f;
+#undef LFSR_S
+  }
+
+  for (int i = 0; i < 16; i++) {
+    _mm256_storeu_si256((__m256i*)state->LFSR_S[i], s[(n + i) & 15]);
+  }
+  _mm256_storeu_si256((__m256i*)state->F_R1, R1);
+  _mm256_storeu_si256((__m256i*)state->F_R2, R2);
+}
+
+static bool zuc_avx2_supported()
+{
+  static const bool supported = []() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }();
+  return supported;
+}
+#endif
+
+static void zuc_lanes_clock(zuc_lanes_state_t* state, int n, u32* p_keystream)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  if (zuc_avx2_supported()) {
+    zuc_lanes_clock_avx2(state, n, p_keystream);
+    return;
+  }
+#endif
+  zuc_lanes_clock_gen(state, n, p_keystream);
+}
+
+void zuc_lanes_initialize(zuc_lanes_state_t* state, const u8* const* k, const u8* const* iv, u32 nof_lanes)
+{
+  memset(state, 0, sizeof(zuc_lanes_state_t));
+
+  /* expand key */
+  for (u32 l = 0; l < nof_lanes && l < ZUC_MAX_LANES; l++) {
+    for (int i = 0; i < 16; i++) {
+      state->LFSR_S[i][l] = MAKEU31(k[l][i], EK_d[i], iv[l][i]);
+    }
+  }
+
+  /* 32 clocks in initialisation mode, then the clock of zuc_generate_keystream() whose output is discarded */
+  u32 discard[ZUC_MAX_LANES];
+  zuc_lanes_clock(state, 32, NULL);
+  zuc_lanes_clock(state, 1, discard);
+}
+
+void zuc_lanes_generate_keystream(zuc_lanes_state_t* state, int key_stream_len, u32* p_keystream)
+{
+  zuc_lanes_clock(state, key_stream_len, p_keystream);
+}
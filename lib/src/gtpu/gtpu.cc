@@ -26,7 +26,7 @@
 
 namespace srsran {
 
-const static size_t HEADER_PDCP_PDU_NUMBER_SIZE = 4;
+const static size_t HEADER_PDCP_PDU_NUMBER_SIZE = GTPU_EXT_HEADER_PDCP_PDU_NUMBER_LEN;
 
 /****************************************************************************
  * Header pack/unpack helper functions
@@ -112,6 +112,28 @@ bool gtpu_write_header(gtpu_header_t* header, srsran::byte_buffer_t* pdu, srslog
   return true;
 }
 
+void gtpu_set_header_template(gtpu_header_template_t& hdr_template, uint32_t teid)
+{
+  uint8_t* ptr = hdr_template.buffer.data();
+  *ptr++       = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL | GTPU_FLAGS_EXTENDED_HDR;
+  *ptr++       = GTPU_MSG_DATA_PDU;
+  // The length is written for each PDU
+  uint16_to_uint8(0, ptr);
+  ptr += 2;
+  uint32_to_uint8(teid, ptr);
+  ptr += 4;
+  // Sequence number and N-PDU are not used
+  uint16_to_uint8(0, ptr);
+  ptr += 2;
+  *ptr++ = 0;
+  *ptr++ = GTPU_EXT_HEADER_PDCP_PDU_NUMBER;
+  // PDCP PDU number extension header: length in units of 4 bytes, the SN written for each PDU, no next header
+  *ptr++ = 0x01u;
+  *ptr++ = 0;
+  *ptr++ = 0;
+  *ptr   = GTPU_EXT_NO_MORE_EXTENSION_HEADERS;
+}
+
 bool gtpu_read_ext_header(srsran::byte_buffer_t* pdu,
                           uint8_t**              ptr,
                           gtpu_header_t*         header,
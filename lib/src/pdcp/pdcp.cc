@@ -92,6 +92,12 @@ bool pdcp::is_lcid_enabled(uint32_t lcid)
   return valid_lcids_cached.count(lcid) > 0;
 }
 
+// Applies to the bearers added afterwards
+void pdcp::set_crypto_pool(task_thread_pool* crypto_pool_)
+{
+  crypto_pool = crypto_pool_;
+}
+
 void pdcp::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu, int sn)
 {
   if (valid_lcid(lcid)) {
@@ -127,6 +133,7 @@ int pdcp::add_bearer(uint32_t lcid, const pdcp_config_t& cfg)
     logger.error("Can not configure PDCP entity");
     return SRSRAN_ERROR;
   }
+  entity->set_crypto_pool(crypto_pool);
 
   if (not pdcp_array.insert(std::make_pair(lcid, std::move(entity))).second) {
     logger.error("Error inserting PDCP entity in to array.");
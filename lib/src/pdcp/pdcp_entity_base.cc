@@ -36,6 +36,11 @@ void pdcp_entity_base::config_security(const as_security_config_t& sec_cfg_)
 {
   sec_cfg = sec_cfg_;
 
+  aes128_set_key(&k_rrc_enc_aes, &sec_cfg.k_rrc_enc[16]);
+  aes128_set_key(&k_up_enc_aes, &sec_cfg.k_up_enc[16]);
+  aes128_set_key(&k_rrc_int_aes, &sec_cfg.k_rrc_int[16]);
+  aes128_set_key(&k_up_int_aes, &sec_cfg.k_up_int[16]);
+
   logger.info("Configuring security with %s and %s",
               integrity_algorithm_id_text[sec_cfg.integ_algo],
               ciphering_algorithm_id_text[sec_cfg.cipher_algo]);
@@ -67,7 +72,13 @@ void pdcp_entity_base::integrity_generate(uint8_t* msg, uint32_t msg_len, uint32
       security_128_eia1(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
+      security_128_eia2(is_srb() ? &k_rrc_int_aes : &k_up_int_aes,
+                        count,
+                        cfg.bearer_id - 1,
+                        cfg.tx_direction,
+                        msg,
+                        msg_len,
+                        mac);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA3:
       security_128_eia3(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
@@ -105,7 +116,13 @@ bool pdcp_entity_base::integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t
       security_128_eia1(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
+      security_128_eia2(is_srb() ? &k_rrc_int_aes : &k_up_int_aes,
+                        count,
+                        cfg.bearer_id - 1,
+                        cfg.rx_direction,
+                        msg,
+                        msg_len,
+                        mac_exp);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA3:
       security_128_eia3(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
@@ -162,8 +179,9 @@ void pdcp_entity_base::cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t c
       memcpy(ct, ct_tmp, msg_len);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
-      memcpy(ct, ct_tmp, msg_len);
+      // CTR mode ciphers in place, no copy needed
+      security_128_eea2(
+          is_srb() ? &k_rrc_enc_aes : &k_up_enc_aes, count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA3:
       security_128_eea3(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
@@ -202,8 +220,8 @@ void pdcp_entity_base::cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t cou
       memcpy(msg, msg_tmp, ct_len);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
-      memcpy(msg, msg_tmp, ct_len);
+      security_128_eea2(
+          is_srb() ? &k_rrc_enc_aes : &k_up_enc_aes, count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA3:
       security_128_eea3(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
@@ -215,6 +233,101 @@ void pdcp_entity_base::cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t cou
   logger.debug(msg, ct_len, "Cipher decrypt output msg");
 }
 
+/****************************************************************************
+ * Ciphering offload
+ ***************************************************************************/
+
+// Ciphering of a TX PDU in the crypto pool. It keeps a copy of the security context, so the entity can be reconfigured
+// or removed while the PDU is being ciphered
+struct pdcp_entity_base::crypto_job_t {
+  CIPHERING_ALGORITHM_ID_ENUM      cipher_algo;
+  as_key_t                         k_enc;
+  aes128_key_t                     k_enc_aes;
+  uint8_t                          bearer;
+  uint8_t                          direction;
+  uint32_t                         count;
+  uint32_t                         hdr_len_bytes;
+  unique_byte_buffer_t             pdu;
+  pdcp_entity_base*                entity;
+  std::weak_ptr<crypto_tx_queue_t> tx_queue;
+
+  // The data part is ciphered in place
+  void run()
+  {
+    uint8_t* msg     = &pdu->msg[hdr_len_bytes];
+    uint32_t msg_len = pdu->N_bytes - hdr_len_bytes;
+    switch (cipher_algo) {
+      case CIPHERING_ALGORITHM_ID_128_EEA1:
+        security_128_eea1(&k_enc[16], count, bearer, direction, msg, msg_len, msg);
+        break;
+      case CIPHERING_ALGORITHM_ID_128_EEA2:
+        security_128_eea2(&k_enc_aes, count, bearer, direction, msg, msg_len, msg);
+        break;
+      case CIPHERING_ALGORITHM_ID_128_EEA3:
+        security_128_eea3(&k_enc[16], count, bearer, direction, msg, msg_len, msg);
+        break;
+      default:
+        break;
+    }
+  }
+};
+
+void pdcp_entity_base::cipher_encrypt_in_pool(unique_byte_buffer_t pdu, uint32_t count)
+{
+  std::unique_ptr<crypto_job_t> job(new crypto_job_t);
+  job->cipher_algo   = sec_cfg.cipher_algo;
+  job->k_enc         = is_srb() ? sec_cfg.k_rrc_enc : sec_cfg.k_up_enc;
+  job->k_enc_aes     = is_srb() ? k_rrc_enc_aes : k_up_enc_aes;
+  job->bearer        = cfg.bearer_id - 1;
+  job->direction     = cfg.tx_direction;
+  job->count         = count;
+  job->hdr_len_bytes = cfg.hdr_len_bytes;
+  job->pdu           = std::move(pdu);
+  job->entity        = this;
+  job->tx_queue      = crypto_tx_queue;
+
+  // Reserve the position of the PDU in the TX order
+  crypto_tx_queue->push_back({count, nullptr});
+
+  task_sched_handle sched = task_sched;
+  crypto_pool->push_task([job = std::move(job), sched]() mutable {
+    job->run();
+
+    // Back to the stack thread, where the entity may have been removed meanwhile
+    sched.notify_background_task_result([job = std::move(job)]() {
+      if (not job->tx_queue.expired()) {
+        job->entity->crypto_tx_pdu_done(job->count, std::move(job->pdu));
+      }
+    });
+  });
+}
+
+void pdcp_entity_base::tx_pdu_in_order(unique_byte_buffer_t pdu, uint32_t count)
+{
+  if (crypto_tx_queue->empty()) {
+    write_lower_layers(std::move(pdu));
+    return;
+  }
+  crypto_tx_queue->push_back({count, std::move(pdu)});
+}
+
+void pdcp_entity_base::crypto_tx_pdu_done(uint32_t count, unique_byte_buffer_t pdu)
+{
+  for (crypto_tx_pdu_t& tx_pdu : *crypto_tx_queue) {
+    if (tx_pdu.count == count && tx_pdu.pdu == nullptr) {
+      tx_pdu.pdu = std::move(pdu);
+      break;
+    }
+  }
+
+  // Pass the PDUs ready at the head of the queue
+  while (not crypto_tx_queue->empty() && crypto_tx_queue->front().pdu != nullptr) {
+    unique_byte_buffer_t tx_pdu = std::move(crypto_tx_queue->front().pdu);
+    crypto_tx_queue->pop_front();
+    write_lower_layers(std::move(tx_pdu));
+  }
+}
+
 /****************************************************************************
  * Common pack functions
  ***************************************************************************/
@@ -25,6 +25,7 @@
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/ue_gw_interfaces.h"
 #include "srsran/interfaces/ue_rlc_interfaces.h"
+#include "srsran/srslog/event_trace.h"
 #include <bitset>
 
 namespace srsran {
@@ -100,7 +101,8 @@ bool pdcp_entity_lte::configure(const pdcp_config_t& cnfg_)
   logger.info("Status Report Required: %s", cfg.status_report_required ? "True" : "False");
 
   if (is_drb() and not rlc->rb_is_um(lcid)) {
-    undelivered_sdus = std::unique_ptr<undelivered_sdus_queue>(new undelivered_sdus_queue(task_sched, maximum_pdcp_sn));
+    undelivered_sdus = std::unique_ptr<undelivered_sdus_queue>(
+        new undelivered_sdus_queue(task_sched, maximum_pdcp_sn, discard_callback(this)));
     rx_counts_info.reserve(reordering_window);
   }
 
@@ -145,6 +147,7 @@ void pdcp_entity_lte::reset()
 // GW/RRC interface
 void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
 {
+  trace_hot_scope_arg("pdcp", "write_sdu", lcid);
   if (!active) {
     logger.warning("Dropping %s SDU due to inactive bearer", rb_name.c_str());
     return;
@@ -202,7 +205,8 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
     append_mac(sdu, mac);
   }
 
-  if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
+  bool do_encryption = encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX;
+  if (do_encryption && not crypto_offload_enabled()) {
     cipher_encrypt(
         &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, tx_count, &sdu->msg[cfg.hdr_len_bytes]);
   }
@@ -234,12 +238,22 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
   if (rlc->rb_is_um(lcid)) {
     metrics.num_tx_acked_bytes = metrics.num_tx_pdu_bytes;
   }
-  rlc->write_sdu(lcid, std::move(sdu));
+  if (do_encryption && crypto_offload_enabled()) {
+    cipher_encrypt_in_pool(std::move(sdu), tx_count);
+  } else {
+    tx_pdu_in_order(std::move(sdu), tx_count);
+  }
+}
+
+void pdcp_entity_lte::write_lower_layers(unique_byte_buffer_t pdu)
+{
+  rlc->write_sdu(lcid, std::move(pdu));
 }
 
 // RLC interface
 void pdcp_entity_lte::write_pdu(unique_byte_buffer_t pdu)
 {
+  trace_hot_scope_arg("pdcp", "write_pdu", lcid);
   if (!active) {
     logger.warning("Dropping %s PDU due to inactive bearer", rb_name.c_str());
     return;
@@ -718,9 +732,8 @@ bool pdcp_entity_lte::store_sdu(uint32_t sn, const unique_byte_buffer_t& sdu)
   }
 
   // Copy PDU contents into queue and start discard timer
-  uint32_t         discard_timeout = static_cast<uint32_t>(cfg.discard_timer);
-  discard_callback discard_fnc(this, sn);
-  bool             ret = undelivered_sdus->add_sdu(sn, sdu, discard_timeout, discard_fnc);
+  uint32_t discard_timeout = static_cast<uint32_t>(cfg.discard_timer);
+  bool     ret             = undelivered_sdus->add_sdu(sn, sdu, discard_timeout);
   if (ret and discard_timeout > 0) {
     logger.debug("Discard Timer set for SN %u. Timeout: %ums", sn, discard_timeout);
   }
@@ -731,7 +744,7 @@ bool pdcp_entity_lte::store_sdu(uint32_t sn, const unique_byte_buffer_t& sdu)
  * Discard functionality
  ***************************************************************************/
 // Discard Timer Callback (discardTimer)
-void pdcp_entity_lte::discard_callback::operator()(uint32_t timer_id)
+void pdcp_entity_lte::discard_callback::operator()(uint32_t discard_sn)
 {
   parent->logger.info("Discard timer for SN=%d expired", discard_sn);
 
@@ -873,17 +886,13 @@ void pdcp_entity_lte::reset_metrics()
 /****************************************************************************
  * Undelivered SDUs queue helpers
  ***************************************************************************/
-undelivered_sdus_queue::undelivered_sdus_queue(srsran::task_sched_handle task_sched, uint32_t sn_mod) : sn_mod(sn_mod)
-{
-  for (auto& e : sdus) {
-    e.discard_timer = task_sched.get_unique_timer();
-  }
-}
+undelivered_sdus_queue::undelivered_sdus_queue(srsran::task_sched_handle             task_sched,
+                                               uint32_t                              sn_mod,
+                                               srsran::move_callback<void(uint32_t)> discard_callback_) :
+  sn_mod(sn_mod), discard_timer(task_sched.get_unique_timer()), discard_callback(std::move(discard_callback_))
+{}
 
-bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
-                                     const srsran::unique_byte_buffer_t&   sdu,
-                                     uint32_t                              discard_timeout,
-                                     srsran::move_callback<void(uint32_t)> callback)
+bool undelivered_sdus_queue::add_sdu(uint32_t sn, const srsran::unique_byte_buffer_t& sdu, uint32_t discard_timeout)
 {
   assert(not has_sdu(sn) && "Cannot add repeated SNs");
 
@@ -922,8 +931,17 @@ bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
   sdus[sn].sdu->N_bytes    = sdu->N_bytes;
   memcpy(sdus[sn].sdu->msg, sdu->msg, sdu->N_bytes);
   if (discard_timeout > 0) {
-    sdus[sn].discard_timer.set(discard_timeout, std::move(callback));
-    sdus[sn].discard_timer.run();
+    uint32_t now         = discard_time_now();
+    sdus[sn].discard_id  = next_discard_id;
+    next_discard_id      = next_discard_id + 1 == 0 ? 1 : next_discard_id + 1;
+    discard_queue.push_back({sn, sdus[sn].discard_id, now + discard_timeout});
+    nof_discards++;
+    if (not discard_timer.is_running()) {
+      // No SDU was waiting, the timer is armed for this one
+      discard_time_base = now;
+      discard_timer.set(discard_timeout, [this](uint32_t tid) { handle_discard_timer(); });
+      discard_timer.run();
+    }
   }
   sdus[sn].sdu->set_timestamp(); // Metrics
   bytes += sdu->N_bytes;
@@ -937,8 +955,12 @@ bool undelivered_sdus_queue::clear_sdu(uint32_t sn)
   }
   count--;
   bytes -= sdus[sn].sdu->N_bytes;
-  sdus[sn].discard_timer.stop();
+  if (sdus[sn].discard_id != 0) {
+    sdus[sn].discard_id = 0;
+    nof_discards--;
+  }
   sdus[sn].sdu.reset();
+  pop_stale_discards();
   // Find next FMS, if necessary
   if (sn == fms) {
     update_fms();
@@ -952,16 +974,55 @@ void undelivered_sdus_queue::clear()
   bytes = 0;
   fms   = 0;
   for (uint32_t sn = 0; sn < capacity; sn++) {
-    sdus[sn].discard_timer.stop();
+    sdus[sn].discard_id = 0;
     sdus[sn].sdu.reset();
   }
+  discard_queue.clear();
+  discard_timer.stop();
+  nof_discards = 0;
 }
 
 size_t undelivered_sdus_queue::nof_discard_timers() const
 {
-  return std::count_if(sdus.begin(), sdus.end(), [](const sdu_data& s) {
-    return s.sdu != nullptr and s.discard_timer.is_valid() and s.discard_timer.is_running();
-  });
+  return nof_discards;
+}
+
+bool undelivered_sdus_queue::is_discard_pending(const discard_entry_t& entry) const
+{
+  return has_sdu(entry.sn) and sdus[entry.sn].discard_id == entry.discard_id;
+}
+
+// Remove the entries of the cleared SDUs from the head of the discard queue
+void undelivered_sdus_queue::pop_stale_discards()
+{
+  while (not discard_queue.empty() and not is_discard_pending(discard_queue.front())) {
+    discard_queue.pop_front();
+  }
+  if (discard_queue.empty()) {
+    discard_timer.stop();
+  }
+}
+
+void undelivered_sdus_queue::handle_discard_timer()
+{
+  uint32_t now = discard_time_now();
+
+  // All the SDUs whose deadline was reached are at the head of the queue. The callback clears the SDU.
+  while (not discard_queue.empty() and static_cast<int32_t>(discard_queue.front().deadline - now) <= 0) {
+    discard_entry_t entry = discard_queue.front();
+    discard_queue.pop_front();
+    if (is_discard_pending(entry)) {
+      discard_callback(entry.sn);
+    }
+  }
+  pop_stale_discards();
+
+  // Re-arm the timer for the oldest SDU still waiting
+  if (not discard_queue.empty()) {
+    discard_time_base = now;
+    discard_timer.set(discard_queue.front().deadline - now);
+    discard_timer.run();
+  }
 }
 
 void undelivered_sdus_queue::update_fms()
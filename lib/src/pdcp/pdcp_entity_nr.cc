@@ -55,6 +55,7 @@ bool pdcp_entity_nr::configure(const pdcp_config_t& cnfg_)
   cfg         = cnfg_;
   rb_name     = cfg.get_rb_name();
   window_size = 1 << (cfg.sn_len - 1);
+  reorder_queue.resize(window_size);
 
   rlc_mode = rlc->rb_is_um(lcid) ? rlc_mode_t::UM : rlc_mode_t::AM;
 
@@ -82,6 +83,12 @@ bool pdcp_entity_nr::configure(const pdcp_config_t& cnfg_)
   if (rlc_mode == rlc_mode_t::UM) {
     cfg.discard_timer = pdcp_discard_timer_t::infinity;
   }
+
+  // discardTimer, shared by all the SDUs of the bearer
+  if (cfg.discard_timer != pdcp_discard_timer_t::infinity) {
+    discard_timer = task_sched.get_unique_timer();
+    discard_timer.set(static_cast<uint32_t>(cfg.discard_timer), discard_callback(this));
+  }
   return true;
 }
 
@@ -127,11 +134,15 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
 
   // Start discard timer
   if (cfg.discard_timer != pdcp_discard_timer_t::infinity) {
-    timer_handler::unique_timer discard_timer = task_sched.get_unique_timer();
-    discard_callback            discard_fnc(this, tx_next);
-    discard_timer.set(static_cast<uint32_t>(cfg.discard_timer), discard_fnc);
-    discard_timer.run();
-    discard_timers_map.insert(std::make_pair(tx_next, std::move(discard_timer)));
+    uint32_t now = discard_time_now();
+    discard_queue.push_back({tx_next, now + static_cast<uint32_t>(cfg.discard_timer), true});
+    nof_pending_discards++;
+    if (not discard_timer.is_running()) {
+      // No SDU was pending, the timer is armed for this one
+      discard_time_base = now;
+      discard_timer.set(static_cast<uint32_t>(cfg.discard_timer));
+      discard_timer.run();
+    }
     logger.debug("Discard Timer set for SN %u. Timeout: %ums", tx_next, static_cast<uint32_t>(cfg.discard_timer));
   }
 
@@ -156,7 +167,8 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
   // The data unit that is ciphered is the MAC-I and the
   // data part of the PDCP Data PDU except the
   // SDAP header and the SDAP Control PDU if included in the PDCP SDU.
-  if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
+  bool do_encryption = encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX;
+  if (do_encryption && not crypto_offload_enabled()) {
     cipher_encrypt(
         &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, tx_next, &sdu->msg[cfg.hdr_len_bytes]);
   }
@@ -176,12 +188,21 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
 
   // Check if PDCP is associated with more than on RLC entity TODO
   // Write to lower layers
-  rlc->write_sdu(lcid, std::move(sdu));
+  if (do_encryption && crypto_offload_enabled()) {
+    cipher_encrypt_in_pool(std::move(sdu), tx_next);
+  } else {
+    tx_pdu_in_order(std::move(sdu), tx_next);
+  }
 
   // Increment TX_NEXT
   tx_next++;
 }
 
+void pdcp_entity_nr::write_lower_layers(unique_byte_buffer_t pdu)
+{
+  rlc->write_sdu(lcid, std::move(pdu));
+}
+
 // RLC interface
 void pdcp_entity_nr::write_pdu(unique_byte_buffer_t pdu)
 {
@@ -286,13 +307,15 @@ void pdcp_entity_nr::write_pdu(unique_byte_buffer_t pdu)
   }
 
   // Check if PDU has been received
-  if (reorder_queue.find(rcvd_count) != reorder_queue.end()) {
+  if (has_rx_pdu(rcvd_count)) {
     logger.debug("Duplicate PDU, dropping");
     return; // PDU already present, drop.
   }
 
   // Store PDU in reception buffer
-  reorder_queue[rcvd_count] = std::move(pdu);
+  rx_pdu_t& rx_pdu = reorder_queue[rcvd_count % window_size];
+  rx_pdu.count     = rcvd_count;
+  rx_pdu.pdu       = std::move(pdu);
 
   // Update RX_NEXT
   if (rcvd_count >= rx_next) {
@@ -328,9 +351,20 @@ void pdcp_entity_nr::notify_delivery(const pdcp_sn_vector_t& pdcp_sns)
 {
   logger.debug("Received delivery notification from RLC. Nof SNs=%ld", pdcp_sns.size());
   for (uint32_t sn : pdcp_sns) {
-    // Remove timer from map
-    logger.debug("Stopping discard timer for SN=%ld", sn);
-    discard_timers_map.erase(sn);
+    // The queued COUNTs are consecutive, the SDU is found from its distance to the oldest one
+    if (discard_queue.empty() or sn - discard_queue.front().count >= discard_queue.size()) {
+      continue;
+    }
+    discard_entry_t& entry = discard_queue[sn - discard_queue.front().count];
+    if (entry.count == sn and entry.pending) {
+      logger.debug("Stopping discard timer for SN=%ld", sn);
+      entry.pending = false;
+      nof_pending_discards--;
+    }
+  }
+  pop_delivered_discards();
+  if (discard_queue.empty() and discard_timer.is_running()) {
+    discard_timer.stop();
   }
 }
 
@@ -347,10 +381,8 @@ void pdcp_entity_nr::notify_failure(const pdcp_sn_vector_t& pdcp_sns)
 // Update RX_NEXT after submitting to higher layers
 void pdcp_entity_nr::deliver_all_consecutive_counts()
 {
-  for (std::map<uint32_t, unique_byte_buffer_t>::iterator it = reorder_queue.begin();
-       it != reorder_queue.end() && it->first == rx_deliv;
-       reorder_queue.erase(it++)) {
-    logger.debug("Delivering SDU with RCVD_COUNT %u", it->first);
+  while (has_rx_pdu(rx_deliv)) {
+    logger.debug("Delivering SDU with RCVD_COUNT %u", rx_deliv);
 
     // Check RX_DELIV overflow
     if (rx_overflow) {
@@ -362,28 +394,52 @@ void pdcp_entity_nr::deliver_all_consecutive_counts()
     }
 
     // Pass PDCP SDU to the next layers
-    pass_to_upper_layers(std::move(it->second));
+    pass_to_upper_layers(pop_rx_pdu(rx_deliv));
 
     // Update RX_DELIV
     rx_deliv = rx_deliv + 1;
   }
 }
 
+bool pdcp_entity_nr::has_rx_pdu(uint32_t count) const
+{
+  const rx_pdu_t& rx_pdu = reorder_queue[count % window_size];
+  return rx_pdu.pdu != nullptr and rx_pdu.count == count;
+}
+
+unique_byte_buffer_t pdcp_entity_nr::pop_rx_pdu(uint32_t count)
+{
+  return std::move(reorder_queue[count % window_size].pdu);
+}
+
+// Time of the discard timer, in ms since discard_time_base. Only meaningful while SDUs are pending
+uint32_t pdcp_entity_nr::discard_time_now() const
+{
+  return discard_time_base + discard_timer.time_elapsed();
+}
+
+// Remove the delivered SDUs from the head of the discard queue
+void pdcp_entity_nr::pop_delivered_discards()
+{
+  while (not discard_queue.empty() and not discard_queue.front().pending) {
+    discard_queue.pop_front();
+  }
+}
+
 /*
  * Timers
  */
 // Reordering Timer Callback (t-reordering)
 void pdcp_entity_nr::reordering_callback::operator()(uint32_t timer_id)
 {
-  parent->logger.info(
-      "Reordering timer expired. RX_REORD=%u, re-order queue size=%ld", parent->rx_reord, parent->reorder_queue.size());
+  parent->logger.info("Reordering timer expired. RX_REORD=%u, RX_DELIV=%u", parent->rx_reord, parent->rx_deliv);
 
   // Deliver all PDCP SDU(s) with associated COUNT value(s) < RX_REORD
-  for (std::map<uint32_t, unique_byte_buffer_t>::iterator it = parent->reorder_queue.begin();
-       it != parent->reorder_queue.end() && it->first < parent->rx_reord;
-       parent->reorder_queue.erase(it++)) {
-    // Deliver to upper layers
-    parent->pass_to_upper_layers(std::move(it->second));
+  for (uint32_t count = parent->rx_deliv; count < parent->rx_reord; ++count) {
+    if (parent->has_rx_pdu(count)) {
+      // Deliver to upper layers
+      parent->pass_to_upper_layers(parent->pop_rx_pdu(count));
+    }
   }
 
   // Update RX_DELIV to the first PDCP SDU not delivered to the upper layers
@@ -405,14 +461,30 @@ void pdcp_entity_nr::reordering_callback::operator()(uint32_t timer_id)
 // Discard Timer Callback (discardTimer)
 void pdcp_entity_nr::discard_callback::operator()(uint32_t timer_id)
 {
-  parent->logger.debug("Discard timer expired for PDU with SN=%d", discard_sn);
+  uint32_t now = parent->discard_time_now();
+
+  // All the SDUs whose deadline was reached are at the head of the queue
+  while (not parent->discard_queue.empty() and
+         static_cast<int32_t>(parent->discard_queue.front().deadline - now) <= 0) {
+    discard_entry_t entry = parent->discard_queue.front();
+    parent->discard_queue.pop_front();
+    if (not entry.pending) {
+      continue;
+    }
+    parent->nof_pending_discards--;
+    parent->logger.debug("Discard timer expired for PDU with SN=%d", entry.count);
 
-  // Notify the RLC of the discard. It's the RLC to actually discard, if no segment was transmitted yet.
-  parent->rlc->discard_sdu(parent->lcid, discard_sn);
+    // Notify the RLC of the discard. It's the RLC to actually discard, if no segment was transmitted yet.
+    parent->rlc->discard_sdu(parent->lcid, entry.count);
+  }
+  parent->pop_delivered_discards();
 
-  // Remove timer from map
-  // NOTE: this will delete the callback. It *must* be the last instruction.
-  parent->discard_timers_map.erase(discard_sn);
+  // Re-arm the timer for the oldest pending SDU
+  if (not parent->discard_queue.empty()) {
+    parent->discard_time_base = now;
+    parent->discard_timer.set(parent->discard_queue.front().deadline - now);
+    parent->discard_timer.run();
+  }
 }
 
 void pdcp_entity_nr::get_bearer_state(pdcp_lte_state_t* state)
@@ -139,24 +139,77 @@ static inline void agc_run_state_init(srsran_agc_t* q)
   agc_enter_state_measure(q);
 }
 
-static inline void agc_run_state_measure(srsran_agc_t* q, cf_t* signal, uint32_t len)
+static inline int agc_measure(srsran_agc_t* q, const cf_t* signal, uint32_t len, float* y)
 {
-  // Perform measurement of the frame
-  float  y = 0;
-  float* t;
+  const float* t;
   switch (q->mode) {
     case SRSRAN_AGC_MODE_ENERGY:
-      y = sqrtf(crealf(srsran_vec_dot_prod_conj_ccc(signal, signal, len)) / len);
+      *y = sqrtf(crealf(srsran_vec_dot_prod_conj_ccc(signal, signal, len)) / len);
       break;
     case SRSRAN_AGC_MODE_PEAK_AMPLITUDE:
-      t = (float*)signal;
-      y = t[srsran_vec_max_fi(t, 2 * len)]; // take only positive max to avoid abs() (should be similar)
+      t  = (const float*)signal;
+      *y = t[srsran_vec_max_fi(t, 2 * len)]; // take only positive max to avoid abs() (should be similar)
       break;
     default:
       ERROR("Unsupported AGC mode");
-      return;
+      return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+static inline int agc_measure_sc16(srsran_agc_t* q, const int16_t* signal, float scale, uint32_t len, float* y)
+{
+  // The measurement is referred to the float domain the samples are converted to, after the current gain
+  float gain = srsran_convert_dB_to_amplitude(q->gain_db) / scale;
+  if (q->uhd_handler) {
+    gain = 1.0f / scale;
+  }
+
+  int16_t max = 0;
+  switch (q->mode) {
+    case SRSRAN_AGC_MODE_ENERGY:
+      // The average over the 2 * len real components is half the complex average power
+      *y = sqrtf(2.0f * srsran_vec_avg_power_sf(signal, 2 * len)) * gain;
+      break;
+    case SRSRAN_AGC_MODE_PEAK_AMPLITUDE:
+      // take only positive max to avoid abs() (should be similar)
+      for (uint32_t i = 0; i < 2 * len; i++) {
+        max = SRSRAN_MAX(max, signal[i]);
+      }
+      *y = (float)max * gain;
+      break;
+    default:
+      ERROR("Unsupported AGC mode");
+      return SRSRAN_ERROR;
   }
+  return SRSRAN_SUCCESS;
+}
+
+static inline int agc_measure_power(srsran_agc_t* q, float avg_pwr, float max_pwr, float* y)
+{
+  // The measurement is referred to the samples after the current gain
+  float gain = srsran_convert_dB_to_amplitude(q->gain_db);
+  if (q->uhd_handler) {
+    gain = 1.0f;
+  }
+
+  switch (q->mode) {
+    case SRSRAN_AGC_MODE_ENERGY:
+      *y = sqrtf(avg_pwr) * gain;
+      break;
+    case SRSRAN_AGC_MODE_PEAK_AMPLITUDE:
+      // peak modulus instead of the peak real/imaginary component, it is up to 3 dB above
+      *y = sqrtf(max_pwr) * gain;
+      break;
+    default:
+      ERROR("Unsupported AGC mode");
+      return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
 
+static inline void agc_run_state_measure(srsran_agc_t* q, float y)
+{
   // Perform averaging if configured
   if (q->nof_frames > 0) {
     q->y_tmp[q->frame_cnt++] = y;
@@ -216,6 +269,8 @@ static inline void agc_run_state_hold(srsran_agc_t* q)
  */
 void srsran_agc_process(srsran_agc_t* q, cf_t* signal, uint32_t len)
 {
+  float y = 0.0f;
+
   // Apply current gain to input signal
   if (!q->uhd_handler) {
     srsran_vec_sc_prod_cfc(signal, srsran_convert_dB_to_amplitude(q->gain_db), signal, len);
@@ -227,7 +282,49 @@ void srsran_agc_process(srsran_agc_t* q, cf_t* signal, uint32_t len)
       agc_run_state_hold(q);
       break;
     case SRSRAN_AGC_STATE_MEASURE:
-      agc_run_state_measure(q, signal, len);
+      if (agc_measure(q, signal, len, &y) == SRSRAN_SUCCESS) {
+        agc_run_state_measure(q, y);
+      }
+      break;
+    case SRSRAN_AGC_STATE_INIT:
+    default:
+      agc_run_state_init(q);
+  }
+}
+
+void srsran_agc_process_sc16(srsran_agc_t* q, const int16_t* signal, float scale, uint32_t len)
+{
+  float y = 0.0f;
+
+  // Run FSM state, the software gain is not applied to the samples
+  switch (q->state) {
+    case SRSRAN_AGC_STATE_HOLD:
+      agc_run_state_hold(q);
+      break;
+    case SRSRAN_AGC_STATE_MEASURE:
+      if (agc_measure_sc16(q, signal, scale, len, &y) == SRSRAN_SUCCESS) {
+        agc_run_state_measure(q, y);
+      }
+      break;
+    case SRSRAN_AGC_STATE_INIT:
+    default:
+      agc_run_state_init(q);
+  }
+}
+
+void srsran_agc_process_power(srsran_agc_t* q, float avg_pwr, float max_pwr)
+{
+  float y = 0.0f;
+
+  // Run FSM state, the measurement was taken by the caller while processing the samples
+  switch (q->state) {
+    case SRSRAN_AGC_STATE_HOLD:
+      agc_run_state_hold(q);
+      break;
+    case SRSRAN_AGC_STATE_MEASURE:
+      if (agc_measure_power(q, avg_pwr, max_pwr, &y) == SRSRAN_SUCCESS) {
+        agc_run_state_measure(q, y);
+      }
       break;
     case SRSRAN_AGC_STATE_INIT:
     default:
@@ -19,18 +19,15 @@
  *
  */
 
+#include <complex.h>
+
 #include "srsran/phy/cfr/cfr.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 
-// Uncomment this to use a literal implementation of the CFR algorithm
-// #define CFR_PEAK_EXTRACTION
-
 // Uncomment this to filter by zeroing the FFT bins instead of applying a frequency window
 #define CFR_LPF_WITH_ZEROS
 
-static inline float cfr_symb_peak(float* in_abs, int len);
-
 void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
 {
   if (q == NULL || in == NULL || out == NULL) {
@@ -48,17 +45,15 @@ void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
   const uint32_t symbol_sz = q->cfg.symbol_sz;
   float          beta      = 0.0f;
 
-  // Calculate absolute input values
-  srsran_vec_abs_cf(in, q->abs_buffer_in, symbol_sz);
+  // Peak and average power of the input symbol, used by the auto modes and the metrics
+  float       pwr_symb_peak = 0.0f;
+  const float pwr_symb_avg  = srsran_vec_max_avg_power_cf(in, &pwr_symb_peak, symbol_sz);
 
   // In auto modes, the beta threshold is calculated based on the measured PAPR
   if (q->cfg.cfr_mode == SRSRAN_CFR_THR_MANUAL) {
     beta = q->cfg.manual_thr;
   } else {
-    const float symb_peak     = cfr_symb_peak(q->abs_buffer_in, q->cfg.symbol_sz);
-    const float pwr_symb_peak = symb_peak * symb_peak;
-    const float pwr_symb_avg  = srsran_vec_avg_power_ff(q->abs_buffer_in, q->cfg.symbol_sz);
-    float       symb_papr     = 0.0f;
+    float symb_papr = 0.0f;
 
     if (isnormal(pwr_symb_avg) && isnormal(pwr_symb_peak)) {
       if (q->cfg.cfr_mode == SRSRAN_CFR_THR_AUTO_CMA) {
@@ -73,80 +68,57 @@ void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
       symb_papr = pwr_symb_peak / q->pwr_avg_in;
     }
     float papr_reduction = symb_papr / q->max_papr_lin;
-    beta                 = (papr_reduction > 1) ? symb_peak / sqrtf(papr_reduction) : 0;
-  }
-
-  // Clipping algorithm
-  if (isnormal(beta)) {
-#ifdef CFR_PEAK_EXTRACTION
-    srsran_vec_cf_zero(q->peak_buffer, symbol_sz);
-    cf_t clip_thr = 0;
-    for (int i = 0; i < symbol_sz; i++) {
-      if (q->abs_buffer_in[i] > beta) {
-        clip_thr          = beta * (in[i] / q->abs_buffer_in[i]);
-        q->peak_buffer[i] = in[i] - clip_thr;
-      }
-    }
-
-    // Apply FFT filter to the peak signal
-    srsran_dft_run_c(&q->fft_plan, q->peak_buffer, q->peak_buffer);
-#ifdef CFR_LPF_WITH_ZEROS
-    srsran_vec_cf_zero(q->peak_buffer + q->lpf_bw / 2 + q->cfg.dc_sc, symbol_sz - q->cfg.symbol_bw - q->cfg.dc_sc);
-#else  /* CFR_LPF_WITH_ZEROS */
-    srsran_vec_prod_cfc(q->peak_buffer, q->lpf_spectrum, q->peak_buffer, symbol_sz);
-#endif /* CFR_LPF_WITH_ZEROS */
-    srsran_dft_run_c(&q->ifft_plan, q->peak_buffer, q->peak_buffer);
-
-    // Scale the peak signal according to alpha
-    srsran_vec_sc_prod_cfc(q->peak_buffer, alpha, q->peak_buffer, symbol_sz);
+    beta                 = (papr_reduction > 1) ? sqrtf(pwr_symb_peak / papr_reduction) : 0;
+  }
 
-    // Apply the filtered clipping
-    srsran_vec_sub_ccc(in, q->peak_buffer, out, symbol_sz);
-#else /* CFR_PEAK_EXTRACTION */
+  q->metrics_nof_symbols++;
+  q->metrics_peak_in = SRSRAN_MAX(q->metrics_peak_in, pwr_symb_peak);
+  q->metrics_energy_in += (double)pwr_symb_avg * symbol_sz;
 
-    // Generate a clipping envelope and clip the signal
-    srsran_vec_gen_clip_env(q->abs_buffer_in, beta, alpha, q->abs_buffer_in, symbol_sz);
-    srsran_vec_prod_cfc(in, q->abs_buffer_in, out, symbol_sz);
+  // Clipping algorithm, skipped if no sample is above the threshold
+  if (isnormal(beta) && pwr_symb_peak > beta * beta) {
+    // Extract the part of the signal above the threshold
+    srsran_vec_gen_clip_peak(in, beta, q->peak_buffer, symbol_sz);
 
-    // FFT filter
-    srsran_dft_run_c(&q->fft_plan, out, out);
+    // Filter the peak signal, the DFT normalisation and alpha are applied together on the in-band bins only
+    const float gain = -alpha / (float)symbol_sz;
+    srsran_dft_run_c_zerocopy(&q->fft_plan, q->peak_buffer, q->freq_buffer);
 #ifdef CFR_LPF_WITH_ZEROS
-    srsran_vec_cf_zero(out + q->lpf_bw / 2 + q->cfg.dc_sc, symbol_sz - q->cfg.symbol_bw - q->cfg.dc_sc);
+    const uint32_t pos_bw = q->lpf_bw / 2 + q->cfg.dc_sc;
+    const uint32_t neg_bw = q->lpf_bw / 2;
+    srsran_vec_sc_prod_cfc(q->freq_buffer, gain, q->freq_buffer, pos_bw);
+    srsran_vec_sc_prod_cfc(&q->freq_buffer[symbol_sz - neg_bw], gain, &q->freq_buffer[symbol_sz - neg_bw], neg_bw);
+    srsran_vec_cf_zero(&q->freq_buffer[pos_bw], symbol_sz - pos_bw - neg_bw);
+
+    // The clipping error is in-band only, its energy is measured in the frequency domain (Parseval)
+    float pwr_err = crealf(srsran_vec_dot_prod_conj_ccc(q->freq_buffer, q->freq_buffer, pos_bw));
+    pwr_err += crealf(srsran_vec_dot_prod_conj_ccc(
+        &q->freq_buffer[symbol_sz - neg_bw], &q->freq_buffer[symbol_sz - neg_bw], neg_bw));
 #else  /* CFR_LPF_WITH_ZEROS */
-    srsran_vec_prod_cfc(out, q->lpf_spectrum, out, symbol_sz);
+    srsran_vec_prod_cfc(q->freq_buffer, q->lpf_spectrum, q->freq_buffer, symbol_sz);
+    srsran_vec_sc_prod_cfc(q->freq_buffer, gain, q->freq_buffer, symbol_sz);
+
+    // The clipping error is measured in the frequency domain (Parseval)
+    float pwr_err = crealf(srsran_vec_dot_prod_conj_ccc(q->freq_buffer, q->freq_buffer, symbol_sz));
 #endif /* CFR_LPF_WITH_ZEROS */
-    srsran_dft_run_c(&q->ifft_plan, out, out);
-#endif /* CFR_PEAK_EXTRACTION */
+    srsran_dft_run_c_zerocopy(&q->ifft_plan, q->freq_buffer, q->peak_buffer);
+
+    // Apply the filtered clipping
+    srsran_vec_sum_ccc(in, q->peak_buffer, out, symbol_sz);
 
+    q->metrics_nof_clipped++;
+    q->metrics_energy_err += (double)pwr_err * symbol_sz;
   } else {
     // If no processing, copy the input samples into the output buffer
     if (in != out) {
       srsran_vec_cf_copy(out, in, symbol_sz);
     }
   }
-  if (q->cfg.cfr_mode != SRSRAN_CFR_THR_MANUAL && q->cfg.measure_out_papr) {
-    srsran_vec_abs_cf(in, q->abs_buffer_out, symbol_sz);
 
-    const float symb_peak     = cfr_symb_peak(q->abs_buffer_out, q->cfg.symbol_sz);
-    const float pwr_symb_peak = symb_peak * symb_peak;
-    const float pwr_symb_avg  = srsran_vec_avg_power_ff(q->abs_buffer_out, q->cfg.symbol_sz);
-    float       symb_papr     = 0.0f;
-
-    if (isnormal(pwr_symb_avg) && isnormal(pwr_symb_peak)) {
-      if (q->cfg.cfr_mode == SRSRAN_CFR_THR_AUTO_CMA) {
-        // Do not increment cma_n here, as it is being done when calculating input PAPR
-        q->pwr_avg_out = SRSRAN_VEC_CMA(pwr_symb_avg, q->pwr_avg_out, q->cma_n);
-      }
-
-      else if (q->cfg.cfr_mode == SRSRAN_CFR_THR_AUTO_EMA) {
-        q->pwr_avg_out = SRSRAN_VEC_EMA(pwr_symb_avg, q->pwr_avg_out, q->cfg.ema_alpha);
-      }
-
-      symb_papr = pwr_symb_peak / q->pwr_avg_out;
-    }
-
-    const float papr_out_db = srsran_convert_power_to_dB(symb_papr);
-    printf("Output  PAPR: %f dB\n", papr_out_db);
+  if (q->cfg.measure_out_papr) {
+    float pwr_out_peak = 0.0f;
+    q->metrics_energy_out += (double)srsran_vec_max_avg_power_cf(out, &pwr_out_peak, symbol_sz) * symbol_sz;
+    q->metrics_peak_out = SRSRAN_MAX(q->metrics_peak_out, pwr_out_peak);
   }
 }
 
@@ -186,28 +158,6 @@ int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg)
   q->pwr_avg_in   = CFR_EMA_INIT_AVG_PWR;
   q->cma_n        = 0;
 
-  if (q->cfg.measure_out_papr) {
-    q->pwr_avg_out = CFR_EMA_INIT_AVG_PWR;
-  }
-
-  if (q->abs_buffer_in) {
-    free(q->abs_buffer_in);
-  }
-  q->abs_buffer_in = srsran_vec_f_malloc(q->cfg.symbol_sz);
-  if (!q->abs_buffer_in) {
-    ERROR("Error allocating abs_buffer_in");
-    goto clean_exit;
-  }
-
-  if (q->abs_buffer_out) {
-    free(q->abs_buffer_out);
-  }
-  q->abs_buffer_out = srsran_vec_f_malloc(q->cfg.symbol_sz);
-  if (!q->abs_buffer_out) {
-    ERROR("Error allocating abs_buffer_out");
-    goto clean_exit;
-  }
-
   if (q->peak_buffer) {
     free(q->peak_buffer);
   }
@@ -217,6 +167,15 @@ int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg)
     goto clean_exit;
   }
 
+  if (q->freq_buffer) {
+    free(q->freq_buffer);
+  }
+  q->freq_buffer = srsran_vec_cf_malloc(q->cfg.symbol_sz);
+  if (!q->freq_buffer) {
+    ERROR("Error allocating freq_buffer");
+    goto clean_exit;
+  }
+
   // Allocate the filter
   if (q->lpf_spectrum) {
     free(q->lpf_spectrum);
@@ -286,12 +245,9 @@ int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg)
     }
   }
 
-  srsran_dft_plan_set_norm(&q->fft_plan, true);
-  srsran_dft_plan_set_norm(&q->ifft_plan, true);
-
   srsran_vec_cf_zero(q->peak_buffer, q->cfg.symbol_sz);
-  srsran_vec_f_zero(q->abs_buffer_in, q->cfg.symbol_sz);
-  srsran_vec_f_zero(q->abs_buffer_out, q->cfg.symbol_sz);
+  srsran_vec_cf_zero(q->freq_buffer, q->cfg.symbol_sz);
+  srsran_cfr_reset_metrics(q);
   ret = SRSRAN_SUCCESS;
 
 clean_exit:
@@ -306,15 +262,12 @@ void srsran_cfr_free(srsran_cfr_t* q)
   if (q) {
     srsran_dft_plan_free(&q->fft_plan);
     srsran_dft_plan_free(&q->ifft_plan);
-    if (q->abs_buffer_in) {
-      free(q->abs_buffer_in);
-    }
-    if (q->abs_buffer_out) {
-      free(q->abs_buffer_out);
-    }
     if (q->peak_buffer) {
       free(q->peak_buffer);
     }
+    if (q->freq_buffer) {
+      free(q->freq_buffer);
+    }
     if (q->lpf_spectrum) {
       free(q->lpf_spectrum);
     }
@@ -322,11 +275,39 @@ void srsran_cfr_free(srsran_cfr_t* q)
   }
 }
 
-// Find the peak absolute value of an OFDM symbol
-static inline float cfr_symb_peak(float* in_abs, int len)
+void srsran_cfr_get_metrics(const srsran_cfr_t* q, srsran_cfr_metrics_t* metrics)
+{
+  if (q == NULL || metrics == NULL) {
+    return;
+  }
+
+  SRSRAN_MEM_ZERO(metrics, srsran_cfr_metrics_t, 1);
+  metrics->nof_symbols = q->metrics_nof_symbols;
+  metrics->nof_clipped = q->metrics_nof_clipped;
+
+  const double nof_samples = (double)q->metrics_nof_symbols * q->cfg.symbol_sz;
+  if (isnormal(q->metrics_energy_in)) {
+    metrics->papr_in_db = srsran_convert_power_to_dB(q->metrics_peak_in * nof_samples / q->metrics_energy_in);
+    metrics->evm        = 100.0f * sqrtf(q->metrics_energy_err / q->metrics_energy_in);
+  }
+  if (isnormal(q->metrics_energy_out)) {
+    metrics->papr_out_db = srsran_convert_power_to_dB(q->metrics_peak_out * nof_samples / q->metrics_energy_out);
+  }
+}
+
+void srsran_cfr_reset_metrics(srsran_cfr_t* q)
 {
-  const uint32_t max_index = srsran_vec_max_fi(in_abs, len);
-  return in_abs[max_index];
+  if (q == NULL) {
+    return;
+  }
+
+  q->metrics_nof_symbols = 0;
+  q->metrics_nof_clipped = 0;
+  q->metrics_peak_in     = 0.0f;
+  q->metrics_peak_out    = 0.0f;
+  q->metrics_energy_in   = 0.0;
+  q->metrics_energy_out  = 0.0;
+  q->metrics_energy_err  = 0.0;
 }
 
 bool srsran_cfr_params_valid(srsran_cfr_cfg_t* cfr_conf)
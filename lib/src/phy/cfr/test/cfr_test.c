@@ -29,6 +29,8 @@
 #include "srsran/srsran.h"
 
 #define MAX_ACPR_DB -100
+#define MAX_METRICS_PAPR_ERR_DB 0.05f
+#define MAX_METRICS_EVM_ERR 0.05f
 
 
 // Default CFR type
@@ -192,6 +194,7 @@ int main(int argc, char** argv)
     cfr_tx_cfg.manual_thr       = thr_manual;
     cfr_tx_cfg.ema_alpha        = ema_alpha;
     cfr_tx_cfg.dc_sc            = dc_empty;
+    cfr_tx_cfg.measure_out_papr = true;
 
     if (!srsran_cfr_params_valid(&cfr_tx_cfg)) {
       ERROR("Invalid CFR configuration");
@@ -272,6 +275,19 @@ int main(int argc, char** argv)
     printf("  In-PAPR=%.3fdB  Out-PAPR=%.3fdB", papr_in, papr_out);
     printf("  In-ACPR=%.3fdB  Out-ACPR=%.3fdB\n", acpr_in_dB, acpr_out_dB);
 
+    // The metrics reported by the CFR must match the measured ones
+    srsran_cfr_metrics_t cfr_metrics = {};
+    srsran_cfr_get_metrics(&cfr, &cfr_metrics);
+    if (fabsf(cfr_metrics.papr_in_db - papr_in) > MAX_METRICS_PAPR_ERR_DB ||
+        fabsf(cfr_metrics.papr_out_db - papr_out) > MAX_METRICS_PAPR_ERR_DB ||
+        fabsf(cfr_metrics.evm - evm) > MAX_METRICS_EVM_ERR * evm + MAX_METRICS_EVM_ERR) {
+      printf("CFR metrics mismatch: In-PAPR=%.3fdB  Out-PAPR=%.3fdB  EVM=%.3f%%\n",
+             cfr_metrics.papr_in_db,
+             cfr_metrics.papr_out_db,
+             cfr_metrics.evm);
+      goto clean_exit;
+    }
+
     srsran_dft_plan_free(&ofdm_ifft);
     srsran_dft_plan_free(&ofdm_fft);
     free(input);
@@ -198,6 +198,13 @@ void srsran_chest_dl_free(srsran_chest_dl_t* q)
   if (q->pilot_recv_signal) {
     free(q->pilot_recv_signal);
   }
+  for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    for (uint32_t j = 0; j < SRSRAN_MAX_PORTS; j++) {
+      if (q->wiener_pilots[i][j]) {
+        free(q->wiener_pilots[i][j]);
+      }
+    }
+  }
   if (q->wiener_dl) {
     srsran_wiener_dl_free(q->wiener_dl);
     free(q->wiener_dl);
@@ -321,17 +328,57 @@ int srsran_chest_dl_set_cell(srsran_chest_dl_t* q, srsran_cell_t cell)
   return ret;
 }
 
+int srsran_chest_dl_set_executor(srsran_chest_dl_t* q, srsran_chest_dl_parallel_for_t parallel_for, void* executor)
+{
+  if (q == NULL || q->wiener_dl == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Least squares estimates of every port and antenna run by the Wiener estimator
+  if (parallel_for != NULL) {
+    for (uint32_t i = 0; i < q->nof_rx_antennas; i++) {
+      for (uint32_t j = 0; j < q->wiener_dl->max_tx_ports; j++) {
+        if (q->wiener_pilots[i][j] == NULL) {
+          q->wiener_pilots[i][j] = srsran_vec_cf_malloc(SRSRAN_REFSIGNAL_MAX_NUM_SF(q->wiener_dl->max_prb));
+          if (q->wiener_pilots[i][j] == NULL) {
+            perror("malloc");
+            return SRSRAN_ERROR;
+          }
+        }
+      }
+    }
+  }
+
+  q->parallel_for = parallel_for;
+  q->executor     = executor;
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Number of OFDM symbols with CRS of a port used for the estimation, the ones in the control region if it is the only
+ * region estimated: the first two of ports 0 and 1 and the first one of ports 2 and 3 */
+static uint32_t
+chest_dl_nof_symbols(srsran_chest_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_chest_dl_cfg_t* cfg, uint32_t port_id)
+{
+  uint32_t nsymbols = srsran_refsignal_cs_nof_symbols(&q->csr_refs, sf, port_id);
+  if (cfg->ctrl_region_only) {
+    nsymbols = SRSRAN_MIN(nsymbols, (port_id < 2) ? 2 : 1);
+  }
+  return nsymbols;
+}
+
 /* Uses the difference between the averaged and non-averaged pilot estimates */
-static float estimate_noise_pilots(srsran_chest_dl_t* q, srsran_dl_sf_cfg_t* sf, uint32_t port_id)
+static float
+estimate_noise_pilots(srsran_chest_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_chest_dl_cfg_t* cfg, uint32_t port_id)
 {
   srsran_sf_t ch_mode   = sf->sf_type;
   const float weight    = 1.0f;
   float       sum_power = 0.0f;
   uint32_t    count     = 0;
   uint32_t    npilots   = (ch_mode == SRSRAN_SF_MBSFN) ? SRSRAN_REFSIGNAL_NUM_SF_MBSFN(q->cell.nof_prb, port_id)
-                                                       : srsran_refsignal_cs_nof_re(&q->csr_refs, sf, port_id);
+                                                       : chest_dl_nof_symbols(q, sf, cfg, port_id) * 2 * q->cell.nof_prb;
   uint32_t    nsymbols  = (ch_mode == SRSRAN_SF_MBSFN) ? srsran_refsignal_mbsfn_nof_symbols()
-                                                       : srsran_refsignal_cs_nof_symbols(&q->csr_refs, sf, port_id);
+                                                       : chest_dl_nof_symbols(q, sf, cfg, port_id);
   if (nsymbols == 0) {
     ERROR("Invalid number of CRS symbols\n");
     return SRSRAN_ERROR;
@@ -443,7 +490,7 @@ static void interpolate_pilots(srsran_chest_dl_t*     q,
 {
   /* interpolate the symbols with references in the freq domain */
   uint32_t nsymbols    = (sf->sf_type == SRSRAN_SF_MBSFN) ? srsran_refsignal_mbsfn_nof_symbols() + 1
-                                                          : srsran_refsignal_cs_nof_symbols(&q->csr_refs, sf, port_id);
+                                                          : chest_dl_nof_symbols(q, sf, cfg, port_id);
   uint32_t fidx_offset = 0;
 
   /* Interpolate in the frequency domain */
@@ -508,7 +555,17 @@ static void interpolate_pilots(srsran_chest_dl_t*     q,
   }
 
   /* Now interpolate in the time domain between symbols */
-  if (sf->sf_type == SRSRAN_SF_NORM && (cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_AVERAGE || nsymbols < 2)) {
+  if (sf->sf_type == SRSRAN_SF_NORM && cfg->ctrl_region_only) {
+    // Only the control region symbols are written, up to the second CRS of ports 0 and 1
+    if (cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_AVERAGE || nsymbols < 2) {
+      for (uint32_t l = 1; l < SRSRAN_CHEST_DL_CTRL_NOF_SYMBOLS(q->cell.cp); l++) {
+        memcpy(&ce[l * SRSRAN_NRE * q->cell.nof_prb], ce, sizeof(cf_t) * SRSRAN_NRE * q->cell.nof_prb);
+      }
+    } else {
+      uint32_t l1 = srsran_refsignal_cs_nsymbol(1, q->cell.cp, port_id);
+      srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(0), &cesymb(l1), &cesymb(1), l1, l1 - 1);
+    }
+  } else if (sf->sf_type == SRSRAN_SF_NORM && (cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_AVERAGE || nsymbols < 2)) {
     // If we average per subframe, just copy the estimates in the time domain
     for (uint32_t l = 1; l < 2 * SRSRAN_CP_NSYMB(q->cell.cp); l++) {
       memcpy(&ce[l * SRSRAN_NRE * q->cell.nof_prb], ce, sizeof(cf_t) * SRSRAN_NRE * q->cell.nof_prb);
@@ -564,7 +621,7 @@ static void average_pilots(srsran_chest_dl_t*     q,
                            uint32_t               filter_len)
 {
   uint32_t nsymbols = (sf->sf_type == SRSRAN_SF_MBSFN) ? srsran_refsignal_mbsfn_nof_symbols()
-                                                       : srsran_refsignal_cs_nof_symbols(&q->csr_refs, sf, port_id);
+                                                       : chest_dl_nof_symbols(q, sf, cfg, port_id);
   uint32_t nref     = (sf->sf_type == SRSRAN_SF_MBSFN) ? 6 * q->cell.nof_prb : 2 * q->cell.nof_prb;
 
   // Average in the time domain if enabled
@@ -599,12 +656,16 @@ static void average_pilots(srsran_chest_dl_t*     q,
   }
 }
 
-static float chest_dl_rssi(srsran_chest_dl_t* q, srsran_dl_sf_cfg_t* sf, cf_t* input, uint32_t port_id)
+static float chest_dl_rssi(srsran_chest_dl_t*     q,
+                           srsran_dl_sf_cfg_t*    sf,
+                           srsran_chest_dl_cfg_t* cfg,
+                           cf_t*                  input,
+                           uint32_t               port_id)
 {
   uint32_t l;
 
   float    rssi     = 0;
-  uint32_t nsymbols = srsran_refsignal_cs_nof_symbols(&q->csr_refs, sf, port_id);
+  uint32_t nsymbols = chest_dl_nof_symbols(q, sf, cfg, port_id);
   for (l = 0; l < nsymbols; l++) {
     cf_t* tmp = &input[srsran_refsignal_cs_nsymbol(l, q->cell.cp, port_id) * q->cell.nof_prb * SRSRAN_NRE];
     rssi += srsran_vec_dot_prod_conj_ccc(tmp, tmp, q->cell.nof_prb * SRSRAN_NRE);
@@ -639,6 +700,49 @@ static float chest_estimate_cfo(srsran_chest_dl_t* q)
   return -cargf(sum) * n / (ns * (n + ng)) / 2 / M_PI;
 }
 
+static void chest_dl_wiener_run(srsran_chest_dl_t* q,
+                                uint32_t           port_id,
+                                uint32_t           rxant_id,
+                                uint32_t           shift,
+                                uint32_t           nsymb,
+                                cf_t*              pilot_estimates,
+                                cf_t*              ce,
+                                float              snr_lin)
+{
+  uint32_t nre  = q->cell.nof_prb * SRSRAN_NRE;
+  uint32_t nref = q->cell.nof_prb * 2;
+
+  for (uint32_t m = 0, l = 0; m < 2 * SRSRAN_CP_NORM_NSYMB + 4; m++) {
+    uint32_t ce_idx = 0;
+
+    if (m >= 4) {
+      ce_idx = (m - 4) * nre;
+    }
+
+    uint32_t k = srsran_refsignal_cs_nsymbol(l, q->cell.cp, port_id);
+    srsran_wiener_dl_run(q->wiener_dl, port_id, rxant_id, m, shift, &pilot_estimates[nref * l], &ce[ce_idx], snr_lin);
+
+    if (m == k) {
+      l = (l + 1) % nsymb;
+    }
+  }
+}
+
+static void chest_dl_wiener_task(void* arg, uint32_t idx)
+{
+  srsran_chest_dl_t*            q   = (srsran_chest_dl_t*)arg;
+  srsran_chest_dl_wiener_job_t* job = &q->wiener_jobs[idx];
+
+  chest_dl_wiener_run(q,
+                      job->port_id,
+                      job->rxant_id,
+                      job->shift,
+                      job->nsymb,
+                      q->wiener_pilots[job->rxant_id][job->port_id],
+                      job->ce,
+                      job->snr_lin);
+}
+
 static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
                                         srsran_dl_sf_cfg_t*    sf,
                                         srsran_chest_dl_cfg_t* cfg,
@@ -652,7 +756,8 @@ static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
   uint32_t    sf_idx     = sf->tti % 10;
   srsran_sf_t ch_mode    = sf->sf_type;
 
-  if (cfg->cfo_estimate_enable && ((1 << sf_idx) & cfg->cfo_estimate_sf_mask) && ch_mode != SRSRAN_SF_MBSFN) {
+  if (cfg->cfo_estimate_enable && ((1 << sf_idx) & cfg->cfo_estimate_sf_mask) && ch_mode != SRSRAN_SF_MBSFN &&
+      !cfg->ctrl_region_only) {
     q->cfo = chest_estimate_cfo(q);
   }
 
@@ -662,13 +767,12 @@ static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
       ERROR("Warning: REFS noise estimation algorithm not supported in MBSFN subframes");
     }
 
-    q->noise_estimate[rxant_id][port_id] = estimate_noise_pilots(q, sf, port_id);
+    q->noise_estimate[rxant_id][port_id] = estimate_noise_pilots(q, sf, cfg, port_id);
   }
 
-  if (q->wiener_dl && ch_mode == SRSRAN_SF_NORM && cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_WIENER) {
+  if (q->wiener_dl && ch_mode == SRSRAN_SF_NORM && cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_WIENER &&
+      !cfg->ctrl_region_only && port_id < q->wiener_dl->nof_tx_ports) {
     bool     ready   = q->wiener_dl->ready;
-    uint32_t nre     = q->cell.nof_prb * SRSRAN_NRE;
-    uint32_t nref    = q->cell.nof_prb * 2;
     uint32_t shift   = srsran_refsignal_cs_fidx(q->cell, 0, port_id, 0);
     uint32_t nsymb   = srsran_refsignal_cs_nof_symbols(&q->csr_refs, sf, port_id);
     float    snr_lin = +INFINITY;
@@ -677,21 +781,20 @@ static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
       snr_lin = q->rsrp[rxant_id][port_id] / q->noise_estimate[rxant_id][port_id] / 2;
     }
 
-    for (uint32_t m = 0, l = 0; m < 2 * SRSRAN_CP_NORM_NSYMB + 4; m++) {
-      uint32_t ce_idx = 0;
-
-      if (m >= 4) {
-        ce_idx = (m - 4) * nre;
-      }
-
-      uint32_t k = srsran_refsignal_cs_nsymbol(l, q->cell.cp, port_id);
-      srsran_wiener_dl_run(
-          q->wiener_dl, port_id, rxant_id, m, shift, &q->pilot_estimates[nref * l], &ce[ce_idx], snr_lin);
-
-      if (m == k) {
-        l = (l + 1) % nsymb;
-      }
+    // Once trained, the estimates are not interpolated and the Wiener estimation can be run with the other ports
+    if (ready && q->parallel_for != NULL) {
+      srsran_chest_dl_wiener_job_t* job = &q->wiener_jobs[q->nof_wiener_jobs++];
+      job->port_id                      = port_id;
+      job->rxant_id                     = rxant_id;
+      job->shift                        = shift;
+      job->nsymb                        = nsymb;
+      job->snr_lin                      = snr_lin;
+      job->ce                           = ce;
+      srsran_vec_cf_copy(q->wiener_pilots[rxant_id][port_id], q->pilot_estimates, 2 * q->cell.nof_prb * nsymb);
+      return;
     }
+
+    chest_dl_wiener_run(q, port_id, rxant_id, shift, nsymb, q->pilot_estimates, ce, snr_lin);
     if (ready) {
       return;
     }
@@ -728,8 +831,8 @@ static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
       interpolate_pilots(q, sf, cfg, q->pilot_estimates_average, ce, port_id);
     }
 
-    /* Estimate noise for PSS and EMPTY algorithms */
-    switch (cfg->noise_alg) {
+    /* Estimate noise for PSS and EMPTY algorithms, the synchronization signals are outside the control region */
+    switch (cfg->ctrl_region_only ? SRSRAN_NOISE_ALG_REFS : cfg->noise_alg) {
       case SRSRAN_NOISE_ALG_PSS:
         if (sf_idx == 0 || sf_idx == 5) {
           q->noise_estimate[rxant_id][port_id] = estimate_noise_pss(q, input, ce);
@@ -811,7 +914,7 @@ static int estimate_port(srsran_chest_dl_t*     q,
                          uint32_t               port_id,
                          uint32_t               rxant_id)
 {
-  uint32_t npilots = srsran_refsignal_cs_nof_re(&q->csr_refs, sf, port_id);
+  uint32_t npilots = chest_dl_nof_symbols(q, sf, cfg, port_id) * 2 * q->cell.nof_prb;
 
   /* Get references from the input signal */
   srsran_refsignal_cs_get_sf(&q->csr_refs, sf, port_id, input, q->pilot_recv_signal);
@@ -826,7 +929,7 @@ static int estimate_port(srsran_chest_dl_t*     q,
     q->rsrp_corr[rxant_id][port_id] = energy * energy;
   }
   q->rsrp[rxant_id][port_id] = srsran_vec_avg_power_cf(q->pilot_recv_signal, npilots);
-  q->rssi[rxant_id][port_id] = chest_dl_rssi(q, sf, input, port_id);
+  q->rssi[rxant_id][port_id] = chest_dl_rssi(q, sf, cfg, input, port_id);
 
   chest_interpolate_noise_est(q, sf, cfg, input, ce, port_id, rxant_id);
 
@@ -1002,9 +1105,11 @@ int srsran_chest_dl_estimate_cfg(srsran_chest_dl_t*     q,
                                  cf_t*                  input[SRSRAN_MAX_PORTS],
                                  srsran_chest_dl_res_t* res)
 {
+  q->nof_wiener_jobs = 0;
+
   for (uint32_t rxant_id = 0; rxant_id < q->nof_rx_antennas; rxant_id++) {
-    // Estimate and correct synchronization error if enabled
-    if (cfg->sync_error_enable) {
+    // Estimate and correct synchronization error if enabled, it needs the whole subframe
+    if (cfg->sync_error_enable && !cfg->ctrl_region_only) {
       chest_dl_estimate_correct_sync_error(q, sf, input[rxant_id], rxant_id);
     }
 
@@ -1021,6 +1126,17 @@ int srsran_chest_dl_estimate_cfg(srsran_chest_dl_t*     q,
     }
   }
 
+  // Run the deferred Wiener estimations and train the filters with all the ports and antennas of the subframe
+  if (q->nof_wiener_jobs > 1) {
+    q->parallel_for(q->executor, chest_dl_wiener_task, q, q->nof_wiener_jobs);
+  } else if (q->nof_wiener_jobs == 1) {
+    chest_dl_wiener_task(q, 0);
+  }
+  if (q->wiener_dl && sf->sf_type == SRSRAN_SF_NORM && cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_WIENER &&
+      !cfg->ctrl_region_only) {
+    srsran_wiener_dl_update(q->wiener_dl);
+  }
+
   fill_res(q, res);
 
   return SRSRAN_SUCCESS;
@@ -77,6 +77,12 @@ static int chest_sl_init(srsran_chest_sl_t* q, uint32_t nof_cyclic_shift_seq)
     return SRSRAN_ERROR;
   }
 
+  q->ce_abs_square = srsran_vec_f_malloc(SRSRAN_NRE * SRSRAN_MAX_PRB);
+  if (!q->ce_abs_square) {
+    ERROR("Error allocating memory");
+    return SRSRAN_ERROR;
+  }
+
   q->sync_error_enable = true;
   q->rsrp_enable       = true;
 
@@ -441,9 +447,8 @@ static void interpolate_pilots_sl_pscch(srsran_chest_sl_t* q)
 static void chest_sl_pscch_ls_estimate(srsran_chest_sl_t* q, cf_t* sf_buffer)
 {
   // Get Pilot Estimates
-  // Use the known DMRS signal to compute least-squares estimates
-  srsran_vec_cf_zero(q->ce, q->sf_n_re);
-
+  // Use the known DMRS signal to compute least-squares estimates. The interpolation fills every symbol of the
+  // allocation, which is all the equalizer reads, so the rest of the subframe does not need to be cleared
   uint32_t dmrs_idx = 0;
   for (uint32_t i = 0; i < srsran_sl_get_num_symbols(q->cell.tm, q->cell.cp); i++) {
     if (srsran_pscch_is_symbol(SRSRAN_SIDELINK_DMRS_SYMBOL, q->cell.tm, i, q->cell.cp)) {
@@ -487,7 +492,11 @@ static int chest_sl_pssch_gen(srsran_chest_sl_t* q)
   uint32_t u[SRSRAN_SL_MAX_DMRS_SYMB] = {}; // Sequence Group Number
 
   // 36.211, Section 10.1.4.1.3 Base Sequence Number - always 0 for sidelink
-  srsran_sl_group_hopping_f_gh(q->f_gh_pattern, q->chest_sl_cfg.N_x_id);
+  if (!q->f_gh_valid || q->f_gh_N_x_id != q->chest_sl_cfg.N_x_id) {
+    srsran_sl_group_hopping_f_gh(q->f_gh_pattern, q->chest_sl_cfg.N_x_id);
+    q->f_gh_N_x_id = q->chest_sl_cfg.N_x_id;
+    q->f_gh_valid  = true;
+  }
 
   if (q->cell.tm <= SRSRAN_SIDELINK_TM2) {
     f_ss              = q->chest_sl_cfg.N_x_id % SRSRAN_SL_N_RU_SEQ;
@@ -812,7 +821,7 @@ static void chest_sl_pssch_ls_estimate(srsran_chest_sl_t* q, cf_t* sf_buffer)
   int      dmrs_idx = 0;
   uint32_t k        = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
 
-  srsran_vec_cf_zero(q->ce, q->sf_n_re);
+  // Only the allocation is interpolated and equalized, see chest_sl_pscch_ls_estimate()
   for (int i = 0; i < srsran_sl_get_num_symbols(q->cell.tm, q->cell.cp); i++) {
     if (srsran_pssch_is_symbol(SRSRAN_SIDELINK_DMRS_SYMBOL, q->cell.tm, i, q->cell.cp)) {
       if (q->cell.tm == SRSRAN_SIDELINK_TM1 || q->cell.tm == SRSRAN_SIDELINK_TM2) {
@@ -883,63 +892,74 @@ static void get_subband_noise(srsran_chest_sl_t* q, uint32_t k_start, uint32_t k
   }
 }
 
-float srsran_chest_sl_estimate_noise(srsran_chest_sl_t* q)
+// Gets the subcarrier ranges [k_start, k_end) of the current allocation, returns the number of bands (up to 2)
+static int chest_sl_get_subbands(srsran_chest_sl_t* q, uint32_t k_start[2], uint32_t k_end[2])
 {
-  uint32_t sf_nsymbols = srsran_sl_get_num_symbols(q->cell.tm, q->cell.cp);
-  if (sf_nsymbols == 0) {
-    ERROR("Error estimating channel noise. Invalid number of OFDM symbols.");
-    return SRSRAN_ERROR;
-  }
-
-  srsran_vec_cf_zero(q->ce_average, q->sf_n_re);
-  q->noise_estimated = 0.0;
-
-  uint32_t k_start = 0;
-  uint32_t k_end   = 0;
-
   switch (q->channel) {
     case SRSRAN_SIDELINK_PSBCH:
-      k_start = q->cell.nof_prb * SRSRAN_NRE / 2 - 36;
-      k_end   = k_start + q->M_sc_rs;
-      get_subband_noise(q, k_start, k_end, sf_nsymbols);
-      break;
+      k_start[0] = q->cell.nof_prb * SRSRAN_NRE / 2 - 36;
+      k_end[0]   = k_start[0] + q->M_sc_rs;
+      return 1;
     case SRSRAN_SIDELINK_PSCCH:
-      k_start = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
-      k_end   = k_start + q->M_sc_rs;
-      get_subband_noise(q, k_start, k_end, sf_nsymbols);
-      break;
+      k_start[0] = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
+      k_end[0]   = k_start[0] + q->M_sc_rs;
+      return 1;
     case SRSRAN_SIDELINK_PSSCH:
       if (q->cell.tm == SRSRAN_SIDELINK_TM1 || q->cell.tm == SRSRAN_SIDELINK_TM2) {
         if (q->chest_sl_cfg.nof_prb <= q->sl_comm_resource_pool.prb_num) {
-          k_start = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
-          k_end   = (q->chest_sl_cfg.nof_prb + q->chest_sl_cfg.prb_start_idx) * SRSRAN_NRE;
-          get_subband_noise(q, k_start, k_end, sf_nsymbols);
+          k_start[0] = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
+          k_end[0]   = (q->chest_sl_cfg.nof_prb + q->chest_sl_cfg.prb_start_idx) * SRSRAN_NRE;
+          return 1;
+        }
+        // First band
+        k_start[0] = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
+        k_end[0]   = k_start[0] + q->sl_comm_resource_pool.prb_num * SRSRAN_NRE;
+
+        // Second band
+        if ((q->sl_comm_resource_pool.prb_num * 2) >
+            (q->sl_comm_resource_pool.prb_end - q->sl_comm_resource_pool.prb_start + 1)) {
+          k_start[1] = (q->sl_comm_resource_pool.prb_end + 1 - q->sl_comm_resource_pool.prb_num + 1) * SRSRAN_NRE;
         } else {
-          // First band
-          k_start = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
-          k_end   = k_start + q->sl_comm_resource_pool.prb_num * SRSRAN_NRE;
-          get_subband_noise(q, k_start, k_end, sf_nsymbols);
-
-          // Second band
-          if ((q->sl_comm_resource_pool.prb_num * 2) >
-              (q->sl_comm_resource_pool.prb_end - q->sl_comm_resource_pool.prb_start + 1)) {
-            k_start = (q->sl_comm_resource_pool.prb_end + 1 - q->sl_comm_resource_pool.prb_num + 1) * SRSRAN_NRE;
-          } else {
-            k_start = (q->sl_comm_resource_pool.prb_end + 1 - q->sl_comm_resource_pool.prb_num) * SRSRAN_NRE;
-          }
-          k_end = k_start + (q->chest_sl_cfg.nof_prb - q->sl_comm_resource_pool.prb_num) * SRSRAN_NRE;
-          get_subband_noise(q, k_start, k_end, sf_nsymbols);
+          k_start[1] = (q->sl_comm_resource_pool.prb_end + 1 - q->sl_comm_resource_pool.prb_num) * SRSRAN_NRE;
         }
+        k_end[1] = k_start[1] + (q->chest_sl_cfg.nof_prb - q->sl_comm_resource_pool.prb_num) * SRSRAN_NRE;
+        return 2;
       } else if (q->cell.tm == SRSRAN_SIDELINK_TM3 || q->cell.tm == SRSRAN_SIDELINK_TM4) {
-        k_start = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
-        k_end   = (q->chest_sl_cfg.nof_prb + q->chest_sl_cfg.prb_start_idx) * SRSRAN_NRE;
-        get_subband_noise(q, k_start, k_end, sf_nsymbols);
+        k_start[0] = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
+        k_end[0]   = (q->chest_sl_cfg.nof_prb + q->chest_sl_cfg.prb_start_idx) * SRSRAN_NRE;
+        return 1;
       }
-      break;
+      return 0;
     default:
-      ERROR("Invalid Sidelink channel");
       return SRSRAN_ERROR;
   }
+}
+
+float srsran_chest_sl_estimate_noise(srsran_chest_sl_t* q)
+{
+  uint32_t sf_nsymbols = srsran_sl_get_num_symbols(q->cell.tm, q->cell.cp);
+  if (sf_nsymbols == 0) {
+    ERROR("Error estimating channel noise. Invalid number of OFDM symbols.");
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t k_start[2] = {};
+  uint32_t k_end[2]   = {};
+  int      nof_bands  = chest_sl_get_subbands(q, k_start, k_end);
+  if (nof_bands < 0) {
+    ERROR("Invalid Sidelink channel");
+    return SRSRAN_ERROR;
+  }
+
+  // The PSBCH is equalized over the whole subframe, PSCCH and PSSCH only over the allocation
+  if (q->channel == SRSRAN_SIDELINK_PSBCH) {
+    srsran_vec_cf_zero(q->ce_average, q->sf_n_re);
+  }
+  q->noise_estimated = 0.0;
+
+  for (int b = 0; b < nof_bands; b++) {
+    get_subband_noise(q, k_start[b], k_end[b], sf_nsymbols);
+  }
   q->noise_estimated = q->noise_estimated / (float)sf_nsymbols;
   return q->noise_estimated;
 }
@@ -1046,7 +1066,8 @@ int srsran_chest_sl_set_cell(srsran_chest_sl_t* q, srsran_cell_sl_t cell)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
   if (q != NULL) {
-    q->cell = cell;
+    q->cell             = cell;
+    q->pssch_dmrs_valid = false;
     if (q->channel == SRSRAN_SIDELINK_PSBCH) {
       if (chest_sl_psbch_gen(q) != SRSRAN_SUCCESS) {
         return SRSRAN_ERROR;
@@ -1064,8 +1085,17 @@ int srsran_chest_sl_set_cfg(srsran_chest_sl_t* q, srsran_chest_sl_cfg_t chest_sl
     q->chest_sl_cfg = chest_sl_cfg;
 
     if (q->channel == SRSRAN_SIDELINK_PSSCH) {
-      if (chest_sl_pssch_gen(q) != SRSRAN_SUCCESS) {
-        return SRSRAN_ERROR;
+      // The DMRS depends on the subframe only through the TM3/4 group hopping
+      bool same_dmrs = q->pssch_dmrs_valid && q->pssch_dmrs_cfg.N_x_id == chest_sl_cfg.N_x_id &&
+                       q->pssch_dmrs_cfg.nof_prb == chest_sl_cfg.nof_prb &&
+                       (q->cell.tm <= SRSRAN_SIDELINK_TM2 || q->pssch_dmrs_cfg.sf_idx % 10 == chest_sl_cfg.sf_idx % 10);
+      if (!same_dmrs) {
+        if (chest_sl_pssch_gen(q) != SRSRAN_SUCCESS) {
+          q->pssch_dmrs_valid = false;
+          return SRSRAN_ERROR;
+        }
+        q->pssch_dmrs_cfg   = chest_sl_cfg;
+        q->pssch_dmrs_valid = true;
       }
     }
     ret = SRSRAN_SUCCESS;
@@ -1130,7 +1160,29 @@ void srsran_chest_sl_ls_equalize(srsran_chest_sl_t* q, cf_t* sf_buffer, cf_t* eq
   srsran_chest_sl_estimate_noise(q);
 
   // Perform channel equalization
-  srsran_predecoding_single(sf_buffer, q->ce_average, equalized_sf_buffer, NULL, q->sf_n_re, 1.0, q->noise_estimated);
+  if (q->channel == SRSRAN_SIDELINK_PSBCH) {
+    srsran_predecoding_single(sf_buffer, q->ce_average, equalized_sf_buffer, NULL, q->sf_n_re, 1.0, q->noise_estimated);
+    return;
+  }
+
+  // PSCCH and PSSCH candidates only need their own allocation, which is a small part of the subframe when blind
+  // decoding every sub-channel
+  uint32_t k_start[2] = {};
+  uint32_t k_end[2]   = {};
+  int      nof_bands  = chest_sl_get_subbands(q, k_start, k_end);
+  uint32_t n_re       = q->cell.nof_prb * SRSRAN_NRE;
+  for (uint32_t l = 0; l < srsran_sl_get_num_symbols(q->cell.tm, q->cell.cp); l++) {
+    for (int b = 0; b < nof_bands; b++) {
+      uint32_t idx = l * n_re + k_start[b];
+      uint32_t len = k_end[b] - k_start[b];
+
+      // MMSE y * conj(h) / (|h|^2 + n0) with vector operations, the bands are too narrow for the SIMD predecoder
+      srsran_vec_prod_conj_ccc(&sf_buffer[idx], &q->ce_average[idx], &equalized_sf_buffer[idx], len);
+      srsran_vec_abs_square_cf(&q->ce_average[idx], q->ce_abs_square, len);
+      srsran_vec_sc_sum_fff(q->ce_abs_square, q->noise_estimated, q->ce_abs_square, len);
+      srsran_vec_div_cfc(&equalized_sf_buffer[idx], q->ce_abs_square, &equalized_sf_buffer[idx], len);
+    }
+  }
 }
 
 void srsran_chest_sl_ls_estimate_equalize(srsran_chest_sl_t* q, cf_t* sf_buffer, cf_t* equalized_sf_buffer)
@@ -1168,5 +1220,8 @@ void srsran_chest_sl_free(srsran_chest_sl_t* q)
     if (q->noise_tmp) {
       free(q->noise_tmp);
     }
+    if (q->ce_abs_square) {
+      free(q->ce_abs_square);
+    }
   }
 }
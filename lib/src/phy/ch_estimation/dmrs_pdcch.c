@@ -188,6 +188,15 @@ int srsran_dmrs_pdcch_estimator_init(srsran_dmrs_pdcch_estimator_t* q,
   // The carrier configuration is not used for initialization, so copy it always
   q->carrier = *carrier;
 
+  // The sequences cover all the possible pilots of the carrier, for every slot and CORESET symbol of a radio frame
+  uint32_t nof_freq_res = SRSRAN_MIN(carrier->nof_prb / 6, SRSRAN_CORESET_FREQ_DOMAIN_RES_SIZE);
+  if (srsran_sequence_rs_cache_init(&q->sequence_cache,
+                                    SRSRAN_NSLOTS_PER_FRAME_NR(carrier->scs),
+                                    SRSRAN_CORESET_DURATION_MAX,
+                                    SRSRAN_MAX(nof_freq_res, 1) * NOF_PILOTS_X_FREQ_RES) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   // Detect change in CORESET, if none, return early
   if (memcmp(&q->coreset, coreset, sizeof(srsran_coreset_t)) == 0) {
     return SRSRAN_SUCCESS;
@@ -276,23 +285,17 @@ void srsran_dmrs_pdcch_estimator_free(srsran_dmrs_pdcch_estimator_t* q)
   }
 
   srsran_interp_linear_free(&q->interpolator);
+  srsran_sequence_rs_cache_free(&q->sequence_cache);
 
   SRSRAN_MEM_ZERO(q, srsran_dmrs_pdcch_estimator_t, 1);
 }
 
 static void
-srsran_dmrs_pdcch_extract(srsran_dmrs_pdcch_estimator_t* q, uint32_t cinit, const cf_t* sf_symbol, cf_t* lse)
+srsran_dmrs_pdcch_extract(srsran_dmrs_pdcch_estimator_t* q, const cf_t* r, const cf_t* sf_symbol, cf_t* lse)
 {
   // Get CORESET offset
   uint32_t offset_k = q->coreset.offset_rb * SRSRAN_NRE;
 
-  // Initialise pseudo-random sequence
-  srsran_sequence_state_t sequence_state = {};
-  srsran_sequence_state_init(&sequence_state, cinit);
-
-  // Counter for skipping unused pilot locations
-  uint32_t sequence_skip = 0;
-
   // Counts enabled frequency domain resources
   uint32_t lse_count = 0;
 
@@ -301,18 +304,9 @@ srsran_dmrs_pdcch_extract(srsran_dmrs_pdcch_estimator_t* q, uint32_t cinit, cons
   for (uint32_t i = 0; i < freq_domain_res_size; i++) {
     // Skip disabled frequency resources
     if (!q->coreset.freq_resources[i]) {
-      sequence_skip += NOF_PILOTS_X_FREQ_RES;
       continue;
     }
 
-    // Skip unused pilots
-    srsran_sequence_state_advance(&sequence_state, 2 * sequence_skip);
-    sequence_skip = 0;
-
-    // Generate sequence
-    cf_t rl[NOF_PILOTS_X_FREQ_RES];
-    srsran_sequence_state_gen_f(&sequence_state, M_SQRT1_2, (float*)rl, NOF_PILOTS_X_FREQ_RES * 2);
-
     // Iterate all PRBs in the enabled frequency domain resource
     cf_t* lse_ptr = &lse[lse_count];
     for (uint32_t j = 0; j < 6; j++) {
@@ -329,8 +323,8 @@ srsran_dmrs_pdcch_extract(srsran_dmrs_pdcch_estimator_t* q, uint32_t cinit, cons
       }
     }
 
-    // Calculate least squared estimates
-    srsran_vec_prod_conj_ccc(lse_ptr, rl, lse_ptr, NOF_PILOTS_X_FREQ_RES);
+    // Calculate least squared estimates, the sequence of the frequency resource starts at its first possible pilot
+    srsran_vec_prod_conj_ccc(lse_ptr, &r[i * NOF_PILOTS_X_FREQ_RES], lse_ptr, NOF_PILOTS_X_FREQ_RES);
   }
 }
 
@@ -356,8 +350,14 @@ int srsran_dmrs_pdcch_estimate(srsran_dmrs_pdcch_estimator_t* q,
     // Calculate PRN sequence initial state
     uint32_t cinit = dmrs_pdcch_get_cinit(slot_idx, l, n_id);
 
+    // Get the modulated sequence of the symbol
+    const cf_t* r = srsran_sequence_rs_cache_get(&q->sequence_cache, slot_idx, l, cinit);
+    if (r == NULL) {
+      return SRSRAN_ERROR;
+    }
+
     // Extract pilots least square estimates
-    srsran_dmrs_pdcch_extract(q, cinit, &sf_symbols[l * q->carrier.nof_prb * SRSRAN_NRE], q->lse[l]);
+    srsran_dmrs_pdcch_extract(q, r, &sf_symbols[l * q->carrier.nof_prb * SRSRAN_NRE], q->lse[l]);
   }
 
   // Time averaging and smoothing should be implemented here
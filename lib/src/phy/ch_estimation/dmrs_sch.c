@@ -53,6 +53,32 @@
  */
 #define DMRS_SCH_MAX_NOF_PRB 106
 
+/**
+ * @brief Number of pilots combined by the Wiener interpolation filters for every estimated RE
+ */
+#define DMRS_SCH_WIENER_NOF_PILOTS 4
+
+/**
+ * @brief SNR buckets of the Wiener filters, from DMRS_SCH_WIENER_SNR_MIN_DB in steps of DMRS_SCH_WIENER_SNR_STEP_DB
+ */
+#define DMRS_SCH_WIENER_NOF_SNR 9
+#define DMRS_SCH_WIENER_SNR_MIN_DB (-5.0f)
+#define DMRS_SCH_WIENER_SNR_STEP_DB 5.0f
+
+/**
+ * @brief Delay spread buckets of the Wiener filters, as RMS delay spread times the subcarrier spacing
+ */
+#define DMRS_SCH_WIENER_NOF_DELAY 6
+static const float dmrs_sch_wiener_delay[DMRS_SCH_WIENER_NOF_DELAY] = {0.002f, 0.005f, 0.01f, 0.02f, 0.05f, 0.1f};
+
+/**
+ * @brief Size of a Wiener filter, one row of coefficients for every RE offset from the first pilot of the window
+ */
+#define DMRS_SCH_WIENER_MAX_STRIDE 3
+#define DMRS_SCH_WIENER_FILTER_SIZE                                                                                    \
+  (DMRS_SCH_WIENER_NOF_PILOTS * DMRS_SCH_WIENER_MAX_STRIDE * DMRS_SCH_WIENER_NOF_PILOTS)
+#define DMRS_SCH_WIENER_NOF_FILTERS (2 * DMRS_SCH_WIENER_NOF_SNR * DMRS_SCH_WIENER_NOF_DELAY)
+
 int srsran_dmrs_sch_cfg_to_str(const srsran_dmrs_sch_cfg_t* cfg, char* msg, uint32_t max_len)
 {
   int type           = (int)cfg->type + 1;
@@ -100,15 +126,15 @@ srsran_dmrs_get_pilots_type2(uint32_t start_prb, uint32_t nof_prb, uint32_t delt
   return count;
 }
 
-static uint32_t srsran_dmrs_get_lse(srsran_dmrs_sch_t*       q,
-                                    srsran_sequence_state_t* sequence_state,
-                                    srsran_dmrs_sch_type_t   dmrs_type,
-                                    uint32_t                 start_prb,
-                                    uint32_t                 nof_prb,
-                                    uint32_t                 delta,
-                                    float                    amplitude,
-                                    const cf_t*              symbols,
-                                    cf_t*                    least_square_estimates)
+static uint32_t srsran_dmrs_get_lse(srsran_dmrs_sch_t*     q,
+                                    const cf_t*            r,
+                                    srsran_dmrs_sch_type_t dmrs_type,
+                                    uint32_t               start_prb,
+                                    uint32_t               nof_prb,
+                                    uint32_t               delta,
+                                    float                  scale,
+                                    const cf_t*            symbols,
+                                    cf_t*                  least_square_estimates)
 {
   uint32_t count = 0;
 
@@ -123,11 +149,11 @@ static uint32_t srsran_dmrs_get_lse(srsran_dmrs_sch_t*       q,
       ERROR("Unknown DMRS type.");
   }
 
-  // Generate sequence for the given pilots
-  srsran_sequence_state_gen_f(sequence_state, amplitude, (float*)q->temp, count * 2);
-
   // Calculate least square estimates
-  srsran_vec_prod_conj_ccc(least_square_estimates, q->temp, least_square_estimates, count);
+  srsran_vec_prod_conj_ccc(least_square_estimates, r, least_square_estimates, count);
+  if (scale != 1.0f) {
+    srsran_vec_sc_prod_cfc(least_square_estimates, scale, least_square_estimates, count);
+  }
 
   return count;
 }
@@ -164,26 +190,29 @@ srsran_dmrs_put_pilots_type2(uint32_t start_prb, uint32_t nof_prb, uint32_t delt
   return count;
 }
 
-static uint32_t srsran_dmrs_put_pilots(srsran_dmrs_sch_t*       q,
-                                       srsran_sequence_state_t* sequence_state,
-                                       srsran_dmrs_sch_type_t   dmrs_type,
-                                       uint32_t                 start_prb,
-                                       uint32_t                 nof_prb,
-                                       uint32_t                 delta,
-                                       float                    amplitude,
-                                       cf_t*                    symbols)
+static uint32_t srsran_dmrs_put_pilots(srsran_dmrs_sch_t*     q,
+                                       const cf_t*            r,
+                                       srsran_dmrs_sch_type_t dmrs_type,
+                                       uint32_t               start_prb,
+                                       uint32_t               nof_prb,
+                                       uint32_t               delta,
+                                       float                  scale,
+                                       cf_t*                  symbols)
 {
   uint32_t count = (dmrs_type == srsran_dmrs_sch_type_1) ? nof_prb * 6 : nof_prb * 4;
 
-  // Generate sequence for the given pilots
-  srsran_sequence_state_gen_f(sequence_state, amplitude, (float*)q->temp, count * 2);
+  // Scale the sequence for the given pilots if the DMRS power is boosted
+  if (scale != 1.0f) {
+    srsran_vec_sc_prod_cfc(r, scale, q->temp, count);
+    r = q->temp;
+  }
 
   switch (dmrs_type) {
     case srsran_dmrs_sch_type_1:
-      count = srsran_dmrs_put_pilots_type1(start_prb, nof_prb, delta, symbols, q->temp);
+      count = srsran_dmrs_put_pilots_type1(start_prb, nof_prb, delta, symbols, r);
       break;
     case srsran_dmrs_sch_type_2:
-      count = srsran_dmrs_put_pilots_type2(start_prb, nof_prb, delta, symbols, q->temp);
+      count = srsran_dmrs_put_pilots_type2(start_prb, nof_prb, delta, symbols, r);
       break;
     default:
       ERROR("Unknown DMRS type.");
@@ -195,14 +224,14 @@ static uint32_t srsran_dmrs_put_pilots(srsran_dmrs_sch_t*       q,
 static int srsran_dmrs_sch_put_symbol(srsran_dmrs_sch_t*           q,
                                       const srsran_sch_cfg_nr_t*   pdsch_cfg,
                                       const srsran_sch_grant_nr_t* grant,
-                                      uint32_t                     cinit,
+                                      const cf_t*                  r,
                                       uint32_t                     delta,
                                       cf_t*                        symbols)
 {
-  // Get signal amplitude
-  float amplitude = M_SQRT1_2;
+  // Get signal amplitude relative to the cached sequence
+  float scale = 1.0f;
   if (isnormal(grant->beta_dmrs)) {
-    amplitude *= grant->beta_dmrs;
+    scale = grant->beta_dmrs;
   }
 
   const srsran_dmrs_sch_cfg_t* dmrs_cfg         = &pdsch_cfg->dmrs;
@@ -211,10 +240,7 @@ static int srsran_dmrs_sch_put_symbol(srsran_dmrs_sch_t*           q,
   uint32_t                     prb_skip         = 0; // Number of PRB to skip
   uint32_t                     nof_pilots_x_prb = dmrs_cfg->type == srsran_dmrs_sch_type_1 ? 6 : 4;
   uint32_t                     pilot_count      = 0;
-
-  // Initialise sequence
-  srsran_sequence_state_t sequence_state = {};
-  srsran_sequence_state_init(&sequence_state, cinit);
+  uint32_t                     r_idx            = 0; // Sequence index
 
   // Iterate over PRBs
   for (uint32_t prb_idx = 0; prb_idx < q->carrier.nof_prb; prb_idx++) {
@@ -227,7 +253,7 @@ static int srsran_dmrs_sch_put_symbol(srsran_dmrs_sch_t*           q,
 
         // ... discard unused pilots and reset counter unless the PDSCH transmission carries SIB
         prb_skip = SRSRAN_MAX(0, (int)prb_skip - (int)dmrs_cfg->reference_point_k_rb);
-        srsran_sequence_state_advance(&sequence_state, prb_skip * nof_pilots_x_prb * 2);
+        r_idx += prb_skip * nof_pilots_x_prb;
         prb_skip = 0;
       }
       prb_count++;
@@ -244,16 +270,16 @@ static int srsran_dmrs_sch_put_symbol(srsran_dmrs_sch_t*           q,
     }
 
     // Get contiguous pilots
-    pilot_count +=
-        srsran_dmrs_put_pilots(q, &sequence_state, dmrs_cfg->type, prb_start, prb_count, delta, amplitude, symbols);
+    uint32_t count = srsran_dmrs_put_pilots(q, &r[r_idx], dmrs_cfg->type, prb_start, prb_count, delta, scale, symbols);
+    pilot_count += count;
+    r_idx += count;
 
     // Reset counter
     prb_count = 0;
   }
 
   if (prb_count > 0) {
-    pilot_count +=
-        srsran_dmrs_put_pilots(q, &sequence_state, dmrs_cfg->type, prb_start, prb_count, delta, amplitude, symbols);
+    pilot_count += srsran_dmrs_put_pilots(q, &r[r_idx], dmrs_cfg->type, prb_start, prb_count, delta, scale, symbols);
   }
 
   return pilot_count;
@@ -569,6 +595,16 @@ static int dmrs_sch_alloc(srsran_dmrs_sch_t* q, uint32_t max_nof_prb)
       return SRSRAN_ERROR;
     }
 
+    if (q->wiener_temp) {
+      free(q->wiener_temp);
+    }
+
+    q->wiener_temp = srsran_vec_cf_malloc(2 * max_nof_prb * SRSRAN_NRE);
+    if (!q->wiener_temp) {
+      ERROR("malloc");
+      return SRSRAN_ERROR;
+    }
+
     if (q->pilot_estimates) {
       free(q->pilot_estimates);
     }
@@ -630,6 +666,13 @@ void srsran_dmrs_sch_free(srsran_dmrs_sch_t* q)
   if (q->filter) {
     free(q->filter);
   }
+  if (q->wiener_coeffs) {
+    free(q->wiener_coeffs);
+  }
+  if (q->wiener_temp) {
+    free(q->wiener_temp);
+  }
+  srsran_sequence_rs_cache_free(&q->sequence_cache);
 
   SRSRAN_MEM_ZERO(q, srsran_dmrs_sch_t, 1);
 }
@@ -643,9 +686,201 @@ int srsran_dmrs_sch_set_carrier(srsran_dmrs_sch_t* q, const srsran_carrier_nr_t*
     return SRSRAN_ERROR;
   }
 
+  // The sequences cover the type 1 pilots of the whole carrier, for every slot and symbol of a radio frame
+  if (srsran_sequence_rs_cache_init(&q->sequence_cache,
+                                    SRSRAN_NSLOTS_PER_FRAME_NR(carrier->scs),
+                                    SRSRAN_NSYMB_PER_SLOT_NR,
+                                    carrier->nof_prb * 6) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   return SRSRAN_SUCCESS;
 }
 
+/**
+ * @brief Frequency correlation between two RE k subcarriers apart, for a uniform power delay profile centred in zero
+ * (the pilots are synchronization pre-compensated) with the given RMS delay spread times the subcarrier spacing
+ */
+static double dmrs_sch_wiener_corr(double k, double delay)
+{
+  double x = M_PI * k * delay * sqrt(12.0);
+  return (fabs(x) < 1e-9) ? 1.0 : sin(x) / x;
+}
+
+/**
+ * @brief Computes the Wiener filter estimating the RE at every offset d from the first of DMRS_SCH_WIENER_NOF_PILOTS
+ * pilots, spaced stride subcarriers
+ */
+static void dmrs_sch_wiener_compute(cf_t* filter, uint32_t stride, double snr_lin, double delay)
+{
+  const uint32_t N = DMRS_SCH_WIENER_NOF_PILOTS;
+
+  for (uint32_t d = 0; d < N * stride; d++) {
+    // Augmented system [A | r], where A is the pilots correlation plus noise and r the pilots correlation with RE d
+    double complex a[DMRS_SCH_WIENER_NOF_PILOTS][DMRS_SCH_WIENER_NOF_PILOTS + 1];
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j < N; j++) {
+        a[i][j] = dmrs_sch_wiener_corr((double)(i * stride) - (double)(j * stride), delay);
+      }
+      a[i][i] += 1.0 / snr_lin;
+      a[i][N] = dmrs_sch_wiener_corr((double)(i * stride) - (double)d, delay);
+    }
+
+    // Gauss-Jordan elimination, A is Hermitian positive definite and does not need pivoting
+    for (uint32_t i = 0; i < N; i++) {
+      double complex pivot = a[i][i];
+      for (uint32_t j = i; j <= N; j++) {
+        a[i][j] /= pivot;
+      }
+      for (uint32_t r = 0; r < N; r++) {
+        if (r == i) {
+          continue;
+        }
+        double complex f = a[r][i];
+        for (uint32_t j = i; j <= N; j++) {
+          a[r][j] -= f * a[i][j];
+        }
+      }
+    }
+
+    // The RE estimate is w^H * pilots
+    for (uint32_t j = 0; j < N; j++) {
+      filter[d * N + j] = (cf_t)conj(a[j][N]);
+    }
+  }
+}
+
+static cf_t* dmrs_sch_wiener_filter(const srsran_dmrs_sch_t* q,
+                                    srsran_dmrs_sch_type_t   type,
+                                    uint32_t                 snr_idx,
+                                    uint32_t                 delay_idx)
+{
+  uint32_t idx = ((uint32_t)type * DMRS_SCH_WIENER_NOF_SNR + snr_idx) * DMRS_SCH_WIENER_NOF_DELAY + delay_idx;
+  return &q->wiener_coeffs[idx * DMRS_SCH_WIENER_FILTER_SIZE];
+}
+
+int srsran_dmrs_sch_set_wiener(srsran_dmrs_sch_t* q, bool enable)
+{
+  if (q == NULL || !q->is_rx) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!enable) {
+    if (q->wiener_coeffs) {
+      free(q->wiener_coeffs);
+      q->wiener_coeffs = NULL;
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  if (q->wiener_coeffs) {
+    return SRSRAN_SUCCESS;
+  }
+
+  q->wiener_coeffs = srsran_vec_cf_malloc(DMRS_SCH_WIENER_NOF_FILTERS * DMRS_SCH_WIENER_FILTER_SIZE);
+  if (q->wiener_coeffs == NULL) {
+    ERROR("malloc");
+    return SRSRAN_ERROR;
+  }
+
+  for (srsran_dmrs_sch_type_t type = srsran_dmrs_sch_type_1; type <= srsran_dmrs_sch_type_2; type++) {
+    uint32_t stride = (type == srsran_dmrs_sch_type_1) ? 2 : 3;
+    for (uint32_t snr_idx = 0; snr_idx < DMRS_SCH_WIENER_NOF_SNR; snr_idx++) {
+      float snr_dB = DMRS_SCH_WIENER_SNR_MIN_DB + DMRS_SCH_WIENER_SNR_STEP_DB * (float)snr_idx;
+      for (uint32_t delay_idx = 0; delay_idx < DMRS_SCH_WIENER_NOF_DELAY; delay_idx++) {
+        dmrs_sch_wiener_compute(dmrs_sch_wiener_filter(q, type, snr_idx, delay_idx),
+                                stride,
+                                srsran_convert_dB_to_power(snr_dB),
+                                dmrs_sch_wiener_delay[delay_idx]);
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Interpolates the pilots with the Wiener filter. Every RE combines the window of pilots starting one before
+ * its closest preceding pilot, the windows are shifted inwards at the edges
+ */
+static void dmrs_sch_wiener_interpolate(srsran_dmrs_sch_t* q,
+                                        const cf_t*        filter,
+                                        uint32_t           stride,
+                                        const cf_t*        pilots,
+                                        uint32_t           nof_pilots,
+                                        cf_t*              ce)
+{
+  const uint32_t N = DMRS_SCH_WIENER_NOF_PILOTS;
+
+  // Inner pilots share the same filter rows, each RE offset is accumulated with vector operations along the pilots
+  uint32_t nof_inner = nof_pilots - (N - 1);
+  cf_t*    tmp       = &q->wiener_temp[stride * nof_inner];
+  for (uint32_t m = 0; m < stride; m++) {
+    const cf_t* w   = &filter[(stride + m) * N];
+    cf_t*       acc = &q->wiener_temp[m * nof_inner];
+    srsran_vec_sc_prod_ccc(&pilots[0], w[0], acc, nof_inner);
+    for (uint32_t j = 1; j < N; j++) {
+      srsran_vec_sc_prod_ccc(&pilots[j], w[j], tmp, nof_inner);
+      srsran_vec_sum_ccc(acc, tmp, acc, nof_inner);
+    }
+  }
+  for (uint32_t i = 0; i < nof_inner; i++) {
+    for (uint32_t m = 0; m < stride; m++) {
+      ce[(i + 1) * stride + m] = q->wiener_temp[m * nof_inner + i];
+    }
+  }
+
+  // Edges, the first pilot and the last two
+  const uint32_t edges[3] = {0, nof_pilots - 2, nof_pilots - 1};
+  for (uint32_t e = 0; e < 3; e++) {
+    uint32_t i  = edges[e];
+    uint32_t w0 = (i == 0) ? 0 : nof_pilots - N;
+    for (uint32_t m = 0; m < stride; m++) {
+      const cf_t* w   = &filter[((i - w0) * stride + m) * N];
+      cf_t        acc = 0;
+      for (uint32_t j = 0; j < N; j++) {
+        acc += w[j] * pilots[w0 + j];
+      }
+      ce[i * stride + m] = acc;
+    }
+  }
+}
+
+/**
+ * @brief Selects the Wiener filter from the SNR of the averaged pilots and their correlation between neighbours
+ */
+static const cf_t* dmrs_sch_wiener_select(const srsran_dmrs_sch_t* q,
+                                          srsran_dmrs_sch_type_t   type,
+                                          const cf_t*              pilots,
+                                          uint32_t                 nof_pilots,
+                                          uint32_t                 nof_symbols)
+{
+  float stride = (type == srsran_dmrs_sch_type_1) ? 2 : 3;
+
+  // The time averaging reduces the noise of the pilots
+  float    snr_dB  = q->csi.snr_dB + srsran_convert_power_to_dB((float)nof_symbols);
+  uint32_t snr_idx = 0;
+  if (!isnan(snr_dB)) {
+    float idx = roundf((snr_dB - DMRS_SCH_WIENER_SNR_MIN_DB) / DMRS_SCH_WIENER_SNR_STEP_DB);
+    snr_idx   = (uint32_t)SRSRAN_MAX(0.0f, SRSRAN_MIN((float)(DMRS_SCH_WIENER_NOF_SNR - 1), idx));
+  }
+
+  // Delay spread from the neighbour pilots correlation, after removing the noise power
+  float n0    = q->csi.n0 / (float)nof_symbols;
+  float power = srsran_vec_avg_power_cf(pilots, nof_pilots) - n0;
+  float corr  = cabsf(srsran_vec_dot_prod_conj_ccc(&pilots[1], pilots, nof_pilots - 1)) / (float)(nof_pilots - 1);
+  float rho   = (isnormal(power) && power > 0.0f) ? SRSRAN_MIN(1.0f, corr / power) : 1.0f;
+  float delay = (rho > 1e-3f) ? sqrtf(1.0f / (rho * rho) - 1.0f) / (2.0f * (float)M_PI * stride) : INFINITY;
+
+  // Select the smallest delay spread that is not below the estimated one, overestimating it degrades less
+  uint32_t delay_idx = 0;
+  while (delay_idx < DMRS_SCH_WIENER_NOF_DELAY - 1 && dmrs_sch_wiener_delay[delay_idx] < delay) {
+    delay_idx++;
+  }
+
+  return dmrs_sch_wiener_filter(q, type, snr_idx, delay_idx);
+}
+
 int srsran_dmrs_sch_put_sf(srsran_dmrs_sch_t*           q,
                            const srsran_slot_cfg_t*     slot_cfg,
                            const srsran_sch_cfg_nr_t*   pdsch_cfg,
@@ -673,7 +908,12 @@ int srsran_dmrs_sch_put_sf(srsran_dmrs_sch_t*           q,
     uint32_t slot_idx = SRSRAN_SLOT_NR_MOD(q->carrier.scs, slot_cfg->idx); // Slot index in the frame
     uint32_t cinit    = srsran_dmrs_sch_seed(&q->carrier, pdsch_cfg, grant, slot_idx, l);
 
-    srsran_dmrs_sch_put_symbol(q, pdsch_cfg, grant, cinit, delta, &sf_symbols[symbol_sz * l]);
+    const cf_t* r = srsran_sequence_rs_cache_get(&q->sequence_cache, slot_idx, l, cinit);
+    if (r == NULL) {
+      return SRSRAN_ERROR;
+    }
+
+    srsran_dmrs_sch_put_symbol(q, pdsch_cfg, grant, r, delta, &sf_symbols[symbol_sz * l]);
   }
 
   return SRSRAN_SUCCESS;
@@ -682,15 +922,15 @@ int srsran_dmrs_sch_put_sf(srsran_dmrs_sch_t*           q,
 static int srsran_dmrs_sch_get_symbol(srsran_dmrs_sch_t*           q,
                                       const srsran_sch_cfg_nr_t*   pdsch_cfg,
                                       const srsran_sch_grant_nr_t* grant,
-                                      uint32_t                     cinit,
+                                      const cf_t*                  r,
                                       uint32_t                     delta,
                                       const cf_t*                  symbols,
                                       cf_t*                        least_square_estimates)
 {
-  // Get signal amplitude
-  float amplitude = M_SQRT1_2;
+  // Get signal amplitude relative to the cached sequence
+  float scale = 1.0f;
   if (isnormal(grant->beta_dmrs)) {
-    amplitude /= grant->beta_dmrs;
+    scale /= grant->beta_dmrs;
   }
 
   const srsran_dmrs_sch_cfg_t* dmrs_cfg = &pdsch_cfg->dmrs;
@@ -700,10 +940,7 @@ static int srsran_dmrs_sch_get_symbol(srsran_dmrs_sch_t*           q,
   uint32_t prb_skip         = 0; // Number of PRB to skip
   uint32_t nof_pilots_x_prb = dmrs_cfg->type == srsran_dmrs_sch_type_1 ? 6 : 4;
   uint32_t pilot_count      = 0;
-
-  // Initialise sequence
-  srsran_sequence_state_t sequence_state = {};
-  srsran_sequence_state_init(&sequence_state, cinit);
+  uint32_t r_idx            = 0; // Sequence index
 
   // Iterate over PRBs
   for (uint32_t prb_idx = 0; prb_idx < q->carrier.nof_prb; prb_idx++) {
@@ -716,7 +953,7 @@ static int srsran_dmrs_sch_get_symbol(srsran_dmrs_sch_t*           q,
 
         // ... discard unused pilots and reset counter unless the PDSCH transmission carries SIB
         prb_skip = SRSRAN_MAX(0, (int)prb_skip - (int)dmrs_cfg->reference_point_k_rb);
-        srsran_sequence_state_advance(&sequence_state, prb_skip * nof_pilots_x_prb * 2);
+        r_idx += prb_skip * nof_pilots_x_prb;
         prb_skip = 0;
       }
       prb_count++;
@@ -733,15 +970,17 @@ static int srsran_dmrs_sch_get_symbol(srsran_dmrs_sch_t*           q,
     }
 
     // Get contiguous pilots
-    pilot_count += srsran_dmrs_get_lse(q,
-                                       &sequence_state,
-                                       dmrs_cfg->type,
-                                       prb_start,
-                                       prb_count,
-                                       delta,
-                                       amplitude,
-                                       symbols,
-                                       &least_square_estimates[pilot_count]);
+    uint32_t count = srsran_dmrs_get_lse(q,
+                                         &r[r_idx],
+                                         dmrs_cfg->type,
+                                         prb_start,
+                                         prb_count,
+                                         delta,
+                                         scale,
+                                         symbols,
+                                         &least_square_estimates[pilot_count]);
+    pilot_count += count;
+    r_idx += count;
 
     // Reset counter
     prb_count = 0;
@@ -749,12 +988,12 @@ static int srsran_dmrs_sch_get_symbol(srsran_dmrs_sch_t*           q,
 
   if (prb_count > 0) {
     pilot_count += srsran_dmrs_get_lse(q,
-                                       &sequence_state,
+                                       &r[r_idx],
                                        dmrs_cfg->type,
                                        prb_start,
                                        prb_count,
                                        delta,
-                                       amplitude,
+                                       scale,
                                        symbols,
                                        &least_square_estimates[pilot_count]);
   }
@@ -801,10 +1040,17 @@ int srsran_dmrs_sch_estimate(srsran_dmrs_sch_t*           q,
   for (uint32_t i = 0; i < nof_symbols; i++) {
     uint32_t l = symbols[i]; // Symbol index inside the slot
 
-    uint32_t cinit = srsran_dmrs_sch_seed(&q->carrier, cfg, grant, SRSRAN_SLOT_NR_MOD(q->carrier.scs, slot->idx), l);
+    uint32_t slot_idx = SRSRAN_SLOT_NR_MOD(q->carrier.scs, slot->idx);
+    uint32_t cinit    = srsran_dmrs_sch_seed(&q->carrier, cfg, grant, slot_idx, l);
+
+    const cf_t* r = srsran_sequence_rs_cache_get(&q->sequence_cache, slot_idx, l, cinit);
+    if (r == NULL) {
+      ERROR("Error getting DMRS sequence (slot=%d, l=%d)", slot_idx, l);
+      return SRSRAN_ERROR;
+    }
 
     nof_pilots_x_symbol = srsran_dmrs_sch_get_symbol(
-        q, cfg, grant, cinit, delta, &sf_symbols[symbol_sz * l], &q->pilot_estimates[nof_pilots_x_symbol * i]);
+        q, cfg, grant, r, delta, &sf_symbols[symbol_sz * l], &q->pilot_estimates[nof_pilots_x_symbol * i]);
 
     if (nof_pilots_x_symbol == 0) {
       ERROR("Error, no pilots extracted (i=%d, l=%d)", i, l);
@@ -922,16 +1168,25 @@ int srsran_dmrs_sch_estimate(srsran_dmrs_sch_t*           q,
     srsran_vec_sc_prod_cfc(q->pilot_estimates, 1.0f / (float)nof_symbols, q->pilot_estimates, nof_pilots_x_symbol);
   }
 
-#if DMRS_SCH_SMOOTH_FILTER_LEN
-  // Apply smoothing filter
-  srsran_conv_same_cf(
-      q->pilot_estimates, q->filter, q->pilot_estimates, nof_pilots_x_symbol, DMRS_SCH_SMOOTH_FILTER_LEN);
-#endif // DMRS_SCH_SMOOTH_FILTER_LEN
-
   // Frequency domain interpolate
   uint32_t nof_re_x_symbol =
       (dmrs_cfg->type == srsran_dmrs_sch_type_1) ? nof_pilots_x_symbol * 2 : nof_pilots_x_symbol * 3;
-  if (dmrs_cfg->type == srsran_dmrs_sch_type_1) {
+  if (q->wiener_coeffs != NULL && nof_pilots_x_symbol >= DMRS_SCH_WIENER_NOF_PILOTS) {
+    const cf_t* filter =
+        dmrs_sch_wiener_select(q, dmrs_cfg->type, q->pilot_estimates, nof_pilots_x_symbol, (uint32_t)nof_symbols);
+    dmrs_sch_wiener_interpolate(q,
+                                filter,
+                                (dmrs_cfg->type == srsran_dmrs_sch_type_1) ? 2 : 3,
+                                q->pilot_estimates,
+                                nof_pilots_x_symbol,
+                                ce);
+  } else if (dmrs_cfg->type == srsran_dmrs_sch_type_1) {
+#if DMRS_SCH_SMOOTH_FILTER_LEN
+    // Apply smoothing filter
+    srsran_conv_same_cf(
+        q->pilot_estimates, q->filter, q->pilot_estimates, nof_pilots_x_symbol, DMRS_SCH_SMOOTH_FILTER_LEN);
+#endif // DMRS_SCH_SMOOTH_FILTER_LEN
+
     // Prepare interpolator
     if (srsran_interp_linear_resize(&q->interpolator_type1, nof_pilots_x_symbol, 2) < SRSRAN_SUCCESS) {
       ERROR("Resizing interpolator nof_pilots_x_symbol=%d; M=%d;", nof_pilots_x_symbol, 2);
@@ -942,6 +1197,12 @@ int srsran_dmrs_sch_estimate(srsran_dmrs_sch_t*           q,
     srsran_interp_linear_offset(&q->interpolator_type1, q->pilot_estimates, ce, delta, 2 - delta);
 
   } else {
+#if DMRS_SCH_SMOOTH_FILTER_LEN
+    // Apply smoothing filter
+    srsran_conv_same_cf(
+        q->pilot_estimates, q->filter, q->pilot_estimates, nof_pilots_x_symbol, DMRS_SCH_SMOOTH_FILTER_LEN);
+#endif // DMRS_SCH_SMOOTH_FILTER_LEN
+
     // Prepare interpolator
     if (srsran_interp_linear_resize(&q->interpolator_type2, nof_pilots_x_symbol, 3) < SRSRAN_SUCCESS) {
       ERROR("Resizing interpolator nof_pilots_x_symbol=%d; M=%d;", nof_pilots_x_symbol, 3);
@@ -382,10 +382,13 @@ inline uint32_t srsran_refsignal_mbsfn_nsymbol(uint32_t l)
 int srsran_refsignal_mbsfn_gen_seq(srsran_refsignal_t* q, srsran_cell_t cell, uint32_t N_mbsfn_id)
 {
   uint32_t c_init;
-  uint32_t i, ns, l, p;
+  uint32_t i, ns, l;
   uint32_t mp;
   int      ret = SRSRAN_ERROR;
 
+  // Only the bits of the centred nof_prb resource blocks are used, m' = i + 3 * (N_max_RB - N_RB)
+  uint32_t seq_len = 2 * (3 * (SRSRAN_MAX_PRB - cell.nof_prb) + 6 * q->cell.nof_prb);
+
   srsran_sequence_t seq_mbsfn;
   bzero(&seq_mbsfn, sizeof(srsran_sequence_t));
   if (srsran_sequence_init(&seq_mbsfn, 20 * SRSRAN_MAX_PRB)) {
@@ -393,21 +396,22 @@ int srsran_refsignal_mbsfn_gen_seq(srsran_refsignal_t* q, srsran_cell_t cell, ui
   }
 
   for (ns = 0; ns < SRSRAN_NOF_SF_X_FRAME; ns++) {
-    for (p = 0; p < 2; p++) {
-      uint32_t nsymbols = 3; // replace with function
-      for (l = 0; l < nsymbols; l++) {
-        uint32_t lp   = (srsran_refsignal_mbsfn_nsymbol(l)) % 6;
-        uint32_t slot = (l) ? (ns * 2 + 1) : (ns * 2);
-        c_init        = 512 * (7 * (slot + 1) + lp + 1) * (2 * N_mbsfn_id + 1) + N_mbsfn_id;
-        srsran_sequence_set_LTE_pr(&seq_mbsfn, SRSRAN_MAX_PRB * 20, c_init);
-        for (i = 0; i < 6 * q->cell.nof_prb; i++) {
-          uint32_t idx                   = SRSRAN_REFSIGNAL_PILOT_IDX_MBSFN(i, l, q->cell);
-          mp                             = i + 3 * (SRSRAN_MAX_PRB - cell.nof_prb);
-          __real__ q->pilots[p][ns][idx] = (1 - 2 * (float)seq_mbsfn.c[2 * mp + 0]) * M_SQRT1_2;
-          __imag__ q->pilots[p][ns][idx] = (1 - 2 * (float)seq_mbsfn.c[2 * mp + 1]) * M_SQRT1_2;
-        }
+    uint32_t nsymbols = 3; // replace with function
+    for (l = 0; l < nsymbols; l++) {
+      uint32_t lp   = (srsran_refsignal_mbsfn_nsymbol(l)) % 6;
+      uint32_t slot = (l) ? (ns * 2 + 1) : (ns * 2);
+      c_init        = 512 * (7 * (slot + 1) + lp + 1) * (2 * N_mbsfn_id + 1) + N_mbsfn_id;
+      srsran_sequence_set_LTE_pr(&seq_mbsfn, seq_len, c_init);
+      for (i = 0; i < 6 * q->cell.nof_prb; i++) {
+        uint32_t idx                   = SRSRAN_REFSIGNAL_PILOT_IDX_MBSFN(i, l, q->cell);
+        mp                             = i + 3 * (SRSRAN_MAX_PRB - cell.nof_prb);
+        __real__ q->pilots[0][ns][idx] = (1 - 2 * (float)seq_mbsfn.c[2 * mp + 0]) * M_SQRT1_2;
+        __imag__ q->pilots[0][ns][idx] = (1 - 2 * (float)seq_mbsfn.c[2 * mp + 1]) * M_SQRT1_2;
       }
     }
+
+    // The sequence does not depend on the port, both ports hold the same pilots
+    srsran_vec_cf_copy(q->pilots[1][ns], q->pilots[0][ns], SRSRAN_REFSIGNAL_PILOT_IDX_MBSFN(0, nsymbols, q->cell));
   }
 
   srsran_sequence_free(&seq_mbsfn);
@@ -460,12 +464,20 @@ int srsran_refsignal_mbsfn_set_cell(srsran_refsignal_t* q, srsran_cell_t cell, u
     goto exit;
   }
 
+  // The MBSFN reference signal only depends on the bandwidth and the area, it is kept across cell ID changes
+  if (q->cell.nof_prb == cell.nof_prb && q->mbsfn_area_id == mbsfn_area_id && q->mbsfn_valid) {
+    q->cell = cell;
+    goto exit;
+  }
+
   q->cell          = cell;
   q->mbsfn_area_id = mbsfn_area_id;
+  q->mbsfn_valid   = false;
   if (srsran_refsignal_mbsfn_gen_seq(q, q->cell, q->mbsfn_area_id) < SRSRAN_SUCCESS) {
     ret = SRSRAN_ERROR;
     goto exit;
   }
+  q->mbsfn_valid = true;
 
 exit:
   return ret;
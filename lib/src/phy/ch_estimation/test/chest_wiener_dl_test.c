@@ -0,0 +1,220 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/srsran.h"
+#include "srsran/support/srsran_test.h"
+#include <getopt.h>
+
+#define NOF_RX_ANT 2
+#define NOF_SF 200
+#define SNR_DB 20.0f
+#define MAX_MSE_DB -10.0f
+
+static srsran_cell_t cell = {25,             // nof_prb
+                             2,              // nof_ports
+                             1,              // cell_id
+                             SRSRAN_CP_NORM, // cyclic prefix
+                             SRSRAN_PHICH_NORM,
+                             SRSRAN_PHICH_R_1_6,
+                             SRSRAN_FDD};
+
+static srsran_channel_awgn_t awgn = {};
+
+static cf_t* input[SRSRAN_MAX_PORTS];
+static cf_t* grid = NULL;
+static cf_t* tmp  = NULL;
+static cf_t* h[SRSRAN_MAX_PORTS][NOF_RX_ANT];
+static cf_t* ce_seq[SRSRAN_MAX_PORTS][NOF_RX_ANT];
+static cf_t* ce_par[SRSRAN_MAX_PORTS][NOF_RX_ANT];
+
+// Runs the tasks sequentially in reverse order, the estimates must not depend on the execution order
+static void reverse_parallel_for(void* executor, srsran_chest_dl_task_t task, void* arg, uint32_t nof_tasks)
+{
+  uint32_t* count = (uint32_t*)executor;
+  for (uint32_t i = nof_tasks; i > 0; i--) {
+    task(arg, i - 1);
+  }
+  (*count)++;
+}
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [rp]\n", prog);
+  printf("\t-r nof_prb [Default %d]\n", cell.nof_prb);
+  printf("\t-p nof_ports [Default %d]\n", cell.nof_ports);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "rp")) != -1) {
+    switch (opt) {
+      case 'r':
+        cell.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'p':
+        cell.nof_ports = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// Generates the received subframe of every antenna from the CRS of every port through a frequency selective channel
+static void generate_sf(srsran_chest_dl_t* est, srsran_dl_sf_cfg_t* sf_cfg, uint32_t nof_re)
+{
+  for (uint32_t rx = 0; rx < NOF_RX_ANT; rx++) {
+    srsran_vec_cf_zero(input[rx], nof_re);
+  }
+
+  for (uint32_t p = 0; p < cell.nof_ports; p++) {
+    srsran_vec_cf_zero(grid, nof_re);
+    srsran_refsignal_cs_put_sf(&est->csr_refs, sf_cfg, p, grid);
+    for (uint32_t rx = 0; rx < NOF_RX_ANT; rx++) {
+      srsran_vec_prod_ccc(grid, h[p][rx], tmp, nof_re);
+      srsran_vec_sum_ccc(input[rx], tmp, input[rx], nof_re);
+    }
+  }
+
+  for (uint32_t rx = 0; rx < NOF_RX_ANT; rx++) {
+    srsran_channel_awgn_run_c(&awgn, input[rx], input[rx], nof_re);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  srsran_chest_dl_t est_seq          = {};
+  srsran_chest_dl_t est_par          = {};
+  uint32_t          nof_parallel_for = 0;
+
+  parse_args(argc, argv);
+
+  TESTASSERT(srsran_channel_awgn_init(&awgn, 0x1234) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_channel_awgn_set_n0(&awgn, -SNR_DB) == SRSRAN_SUCCESS);
+
+  uint32_t nof_sc = cell.nof_prb * SRSRAN_NRE;
+  uint32_t nof_re = SRSRAN_NOF_RE(cell);
+
+  grid = srsran_vec_cf_malloc(nof_re);
+  tmp  = srsran_vec_cf_malloc(nof_re);
+  TESTASSERT(grid != NULL && tmp != NULL);
+  for (uint32_t rx = 0; rx < NOF_RX_ANT; rx++) {
+    input[rx] = srsran_vec_cf_malloc(nof_re);
+    TESTASSERT(input[rx] != NULL);
+  }
+
+  // Static channel with a different delay and phase for every port and antenna
+  for (uint32_t p = 0; p < cell.nof_ports; p++) {
+    for (uint32_t rx = 0; rx < NOF_RX_ANT; rx++) {
+      h[p][rx]      = srsran_vec_cf_malloc(nof_re);
+      ce_seq[p][rx] = srsran_vec_cf_malloc(nof_re);
+      ce_par[p][rx] = srsran_vec_cf_malloc(nof_re);
+      TESTASSERT(h[p][rx] != NULL && ce_seq[p][rx] != NULL && ce_par[p][rx] != NULL);
+
+      float phase = 2.0f * (float)M_PI * (p * NOF_RX_ANT + rx) / (cell.nof_ports * NOF_RX_ANT);
+      float delay = 0.2f + 0.1f * (p + rx);
+      for (uint32_t k = 0; k < nof_sc; k++) {
+        cf_t h_k = cexpf(I * (phase + 2.0f * (float)M_PI * delay * k / SRSRAN_NRE)) *
+                   (0.8f + 0.2f * cosf(2.0f * (float)M_PI * k / nof_sc));
+        for (uint32_t l = 0; l < SRSRAN_CP_NSYMB(cell.cp) * SRSRAN_NOF_SLOTS_PER_SF; l++) {
+          h[p][rx][l * nof_sc + k] = h_k;
+        }
+      }
+    }
+  }
+
+  TESTASSERT(srsran_chest_dl_init(&est_seq, cell.nof_prb, NOF_RX_ANT) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_chest_dl_init(&est_par, cell.nof_prb, NOF_RX_ANT) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_chest_dl_set_cell(&est_seq, cell) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_chest_dl_set_cell(&est_par, cell) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_chest_dl_set_executor(&est_par, reverse_parallel_for, &nof_parallel_for) == SRSRAN_SUCCESS);
+
+  srsran_chest_dl_cfg_t chest_cfg = {};
+  chest_cfg.estimator_alg         = SRSRAN_ESTIMATOR_ALG_WIENER;
+  chest_cfg.noise_alg             = SRSRAN_NOISE_ALG_REFS;
+
+  srsran_chest_dl_res_t res_seq = {};
+  srsran_chest_dl_res_t res_par = {};
+  for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+    for (uint32_t rx = 0; rx < SRSRAN_MAX_PORTS; rx++) {
+      bool valid        = p < cell.nof_ports && rx < NOF_RX_ANT;
+      res_seq.ce[p][rx] = valid ? ce_seq[p][rx] : NULL;
+      res_par.ce[p][rx] = valid ? ce_par[p][rx] : NULL;
+    }
+  }
+
+  uint32_t nof_wiener_ports = est_seq.wiener_dl->nof_tx_ports;
+  float    mse              = 0.0f;
+  for (uint32_t n = 0; n < NOF_SF; n++) {
+    srsran_dl_sf_cfg_t sf_cfg = {};
+    sf_cfg.tti                = n % SRSRAN_NOF_SF_X_FRAME;
+
+    generate_sf(&est_seq, &sf_cfg, nof_re);
+
+    TESTASSERT(srsran_chest_dl_estimate_cfg(&est_seq, &sf_cfg, &chest_cfg, input, &res_seq) == SRSRAN_SUCCESS);
+    TESTASSERT(srsran_chest_dl_estimate_cfg(&est_par, &sf_cfg, &chest_cfg, input, &res_par) == SRSRAN_SUCCESS);
+
+    // The parallel estimation gives the same estimates as the sequential one
+    for (uint32_t p = 0; p < cell.nof_ports; p++) {
+      for (uint32_t rx = 0; rx < NOF_RX_ANT; rx++) {
+        TESTASSERT(memcmp(ce_seq[p][rx], ce_par[p][rx], sizeof(cf_t) * nof_re) == 0);
+      }
+    }
+
+    // Error of the ports estimated by the Wiener filter, the others are interpolated
+    mse = 0.0f;
+    for (uint32_t p = 0; p < nof_wiener_ports; p++) {
+      for (uint32_t rx = 0; rx < NOF_RX_ANT; rx++) {
+        srsran_vec_sub_ccc(ce_seq[p][rx], h[p][rx], grid, nof_re);
+        mse += srsran_vec_avg_power_cf(grid, nof_re) / (nof_wiener_ports * NOF_RX_ANT);
+      }
+    }
+  }
+
+  // The Wiener filter has been trained and the estimates run in parallel
+  TESTASSERT(est_seq.wiener_dl->ready && est_par.wiener_dl->ready);
+  TESTASSERT(nof_parallel_for > 0);
+
+  // The estimates of the last subframe follow the channel
+  printf("nof_prb=%d nof_ports=%d MSE=%.2f dB\n", cell.nof_prb, cell.nof_ports, srsran_convert_power_to_dB(mse));
+  TESTASSERT(srsran_convert_power_to_dB(mse) < MAX_MSE_DB);
+
+  srsran_chest_dl_free(&est_seq);
+  srsran_chest_dl_free(&est_par);
+  for (uint32_t p = 0; p < cell.nof_ports; p++) {
+    for (uint32_t rx = 0; rx < NOF_RX_ANT; rx++) {
+      free(h[p][rx]);
+      free(ce_seq[p][rx]);
+      free(ce_par[p][rx]);
+    }
+  }
+  for (uint32_t rx = 0; rx < NOF_RX_ANT; rx++) {
+    free(input[rx]);
+  }
+  free(grid);
+  free(tmp);
+  srsran_channel_awgn_free(&awgn);
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
@@ -30,6 +30,7 @@
 #include <unistd.h>
 
 static srsran_carrier_nr_t carrier = SRSRAN_DEFAULT_CARRIER_NR;
+static bool                wiener  = false;
 
 typedef struct {
   srsran_sch_mapping_type_t   mapping_type;
@@ -129,19 +130,21 @@ static const golden_t gold[] = {{.mapping_type   = srsran_sch_mapping_type_A,
 
 static void usage(char* prog)
 {
-  printf("Usage: %s [recov]\n", prog);
+  printf("Usage: %s [recovw]\n", prog);
 
   printf("\t-r nof_prb [Default %d]\n", carrier.nof_prb);
 
   printf("\t-c cell_id [Default %d]\n", carrier.pci);
 
+  printf("\t-w use the Wiener interpolation [Default %s]\n", wiener ? "enabled" : "disabled");
+
   printf("\t-v increase verbosity\n");
 }
 
 static void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "rcov")) != -1) {
+  while ((opt = getopt(argc, argv, "rcovw")) != -1) {
     switch (opt) {
       case 'r':
         carrier.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -149,6 +152,9 @@ static void parse_args(int argc, char** argv)
       case 'c':
         carrier.pci = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'w':
+        wiener = true;
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -235,7 +241,8 @@ static int run_test(srsran_dmrs_sch_t*           dmrs_pdsch,
     mse /= (float)chest_res->nof_re;
 
     TESTASSERT(!isnan(mse));
-    TESTASSERT(mse < 1e-6f);
+    // The Wiener filters are biased by the regularization of their noise term
+    TESTASSERT(mse < (wiener ? 1e-3f : 1e-6f));
   }
 
   return SRSRAN_SUCCESS;
@@ -264,6 +271,11 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
+  if (srsran_dmrs_sch_set_wiener(&dmrs_pdsch, wiener) != SRSRAN_SUCCESS) {
+    ERROR("Setting Wiener interpolation");
+    goto clean_exit;
+  }
+
   // Set carrier configuration
   if (srsran_dmrs_sch_set_carrier(&dmrs_pdsch, &carrier) != SRSRAN_SUCCESS) {
     ERROR("Setting carrier");
@@ -85,7 +85,7 @@ const float hlsv_sum_norm[SRSRAN_WIENER_DL_MIN_RE] = {0.0625f,
                                                       2.99999985900001};
 
 // Local state function prototypes
-static srsran_wiener_dl_state_t* srsran_wiener_dl_state_malloc(srsran_wiener_dl_t* q);
+static srsran_wiener_dl_state_t* srsran_wiener_dl_state_malloc(srsran_wiener_dl_t* q, uint32_t seed);
 static void                      srsran_wiener_dl_state_free(srsran_wiener_dl_state_t* q);
 static void                      srsran_wiener_dl_state_reset(srsran_wiener_dl_t* q, srsran_wiener_dl_state_t* state);
 
@@ -96,13 +96,11 @@ static void srsran_wiener_dl_run_symbol_2_9(srsran_wiener_dl_t* q, srsran_wiener
 static void srsran_wiener_dl_run_symbol_5_12(srsran_wiener_dl_t*       q,
                                              srsran_wiener_dl_state_t* state,
                                              cf_t*                     pilots,
-                                             uint32_t                  tx,
-                                             uint32_t                  rx,
                                              uint32_t                  shift,
                                              float                     snr_lin);
 
 // Local state related functions
-static srsran_wiener_dl_state_t* srsran_wiener_dl_state_malloc(srsran_wiener_dl_t* q)
+static srsran_wiener_dl_state_t* srsran_wiener_dl_state_malloc(srsran_wiener_dl_t* q, uint32_t seed)
 {
   // Allocate Channel state
   srsran_wiener_dl_state_t* state = calloc(sizeof(srsran_wiener_dl_state_t), 1);
@@ -162,6 +160,22 @@ static srsran_wiener_dl_state_t* srsran_wiener_dl_state_malloc(srsran_wiener_dl_
       }
     }
 
+    if (!ret) {
+      state->tmp = srsran_vec_malloc(NSAMPLES2NBYTES(SRSRAN_MAX(q->max_re, SRSRAN_WIENER_DL_MIN_RE)));
+      if (!state->tmp) {
+        perror("malloc");
+        ret = SRSRAN_ERROR;
+      }
+    }
+
+    if (!ret) {
+      state->random = srsran_random_init(seed);
+      if (!state->random) {
+        perror("srsran_random_init");
+        ret = SRSRAN_ERROR;
+      }
+    }
+
     // Initialise the rest
     state->deltan       = 0.0f;
     state->nfifosamps   = 0;
@@ -210,6 +224,9 @@ static void srsran_wiener_dl_state_reset(srsran_wiener_dl_t* q, srsran_wiener_dl
     state->sumlen       = 0;
     state->skip         = 0;
     state->cnt          = 0;
+    state->trained      = false;
+    state->snr_lin      = 0.0f;
+    state->shift        = 0;
   }
 }
 
@@ -243,6 +260,12 @@ static void srsran_wiener_dl_state_free(srsran_wiener_dl_state_t* q)
     if (q->timefifo) {
       free(q->timefifo);
     }
+    if (q->tmp) {
+      free(q->tmp);
+    }
+    if (q->random) {
+      srsran_random_free(q->random);
+    }
 
     // Free state
     free(q);
@@ -267,7 +290,7 @@ int srsran_wiener_dl_init(srsran_wiener_dl_t* q, uint32_t max_prb, uint32_t max_
     // Allocate state
     for (uint32_t tx = 0; tx < q->max_tx_ports && !ret; tx++) {
       for (uint32_t rx = 0; rx < q->max_rx_ant && !ret; rx++) {
-        srsran_wiener_dl_state_t* state = srsran_wiener_dl_state_malloc(q);
+        srsran_wiener_dl_state_t* state = srsran_wiener_dl_state_malloc(q, 0xdead + tx * SRSRAN_MAX_PORTS + rx);
         if (!state) {
           perror("srsran_wiener_dl_state_malloc");
           ret = SRSRAN_ERROR;
@@ -286,14 +309,6 @@ int srsran_wiener_dl_init(srsran_wiener_dl_t* q, uint32_t max_prb, uint32_t max_
       }
     }
 
-    if (!ret) {
-      q->random = srsran_random_init(0xdead);
-      if (!q->random) {
-        perror("srsran_random_init");
-        ret = SRSRAN_ERROR;
-      }
-    }
-
     // Create filter FFT/iFFT plans
     if (!ret) {
       ret = srsran_dft_plan_c(&q->fft, SRSRAN_WIENER_DL_MIN_RE, SRSRAN_DFT_FORWARD);
@@ -341,7 +356,7 @@ int srsran_wiener_dl_set_cell(srsran_wiener_dl_t* q, srsran_cell_t cell)
     q->nof_prb      = cell.nof_prb;
     q->nof_ref      = cell.nof_prb * 2;
     q->nof_re       = cell.nof_prb * SRSRAN_NRE;
-    q->nof_tx_ports = cell.nof_ports;
+    q->nof_tx_ports = SRSRAN_MIN(cell.nof_ports, q->max_tx_ports);
     q->nof_rx_ant   = q->max_rx_ant;
     q->ready        = false;
     q->wm_computed  = false;
@@ -366,8 +381,13 @@ void srsran_wiener_dl_reset(srsran_wiener_dl_t* q)
     }
 
     // Reset wiener
-    bzero(q->wm1, NSAMPLES2NBYTES(SRSRAN_WIENER_DL_MIN_REF * SRSRAN_WIENER_DL_MIN_RE));
-    bzero(q->wm2, NSAMPLES2NBYTES(SRSRAN_WIENER_DL_MIN_REF * SRSRAN_WIENER_DL_MIN_RE));
+    for (uint32_t i = 0; i < SRSRAN_WIENER_DL_BANK_CACHE_SIZE; i++) {
+      q->banks[i].valid = false;
+    }
+    q->bank        = NULL;
+    q->bank_count  = 0;
+    q->wm_computed = false;
+    q->ready       = false;
   }
 }
 
@@ -464,70 +484,59 @@ static inline uint32_t vec_find_first_smaller_than_cf(cf_t* x, float y, uint32_t
   return ret;
 }
 
-static inline cf_t _srsran_vec_dot_prod_ccc_simd(const cf_t* x, const cf_t* y, const int len)
+// Estimates nof_re resource elements from SRSRAN_WIENER_DL_MIN_REF pilots, starting at the resource element re_offset
+// of the Wiener matrix. Every pilot scales its matrix row, accumulated over SIMD registers of resource elements
+static void wiener_filter(const cf_t  wm[SRSRAN_WIENER_DL_MIN_REF][SRSRAN_WIENER_DL_MIN_RE],
+                          uint32_t    re_offset,
+                          const cf_t* ref,
+                          cf_t*       h,
+                          uint32_t    nof_re)
 {
-  int  i      = 0;
-  cf_t result = 0;
+  int i = 0;
 
 #if SRSRAN_SIMD_CF_SIZE
-  if (len >= SRSRAN_SIMD_CF_SIZE) {
-    simd_cf_t avx_result = srsran_simd_cf_zero();
-    for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
-      simd_cf_t xVal = srsran_simd_cfi_loadu(&x[i]);
-      simd_cf_t yVal = srsran_simd_cfi_loadu(&y[i]);
-
-      avx_result = srsran_simd_cf_add(srsran_simd_cf_prod(xVal, yVal), avx_result);
-    }
-
-    __attribute__((aligned(64))) float simd_dotProdVector[SRSRAN_SIMD_CF_SIZE];
-    simd_f_t                           acc_re = srsran_simd_cf_re(avx_result);
-    simd_f_t                           acc_im = srsran_simd_cf_im(avx_result);
+  simd_cf_t pilots[SRSRAN_WIENER_DL_MIN_REF];
+  for (uint32_t k = 0; k < SRSRAN_WIENER_DL_MIN_REF; k++) {
+    pilots[k] = srsran_simd_cf_set1(ref[k]);
+  }
 
-    simd_f_t acc = srsran_simd_f_hadd(acc_re, acc_im);
-    for (int j = 2; j < SRSRAN_SIMD_F_SIZE; j *= 2) {
-      acc = srsran_simd_f_hadd(acc, acc);
+  for (; i < (int)nof_re - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t acc = srsran_simd_cf_zero();
+    for (uint32_t k = 0; k < SRSRAN_WIENER_DL_MIN_REF; k++) {
+      acc = srsran_simd_cf_add(acc, srsran_simd_cf_prod(pilots[k], srsran_simd_cfi_loadu(&wm[k][re_offset + i])));
     }
-    srsran_simd_f_store(simd_dotProdVector, acc);
-    __real__ result = simd_dotProdVector[0];
-    __imag__ result = simd_dotProdVector[1];
+    srsran_simd_cfi_storeu(&h[i], acc);
   }
 #endif
 
-  for (; i < len; i++) {
-    result += (x[i] * y[i]);
+  for (; i < nof_re; i++) {
+    cf_t acc = 0;
+    for (uint32_t k = 0; k < SRSRAN_WIENER_DL_MIN_REF; k++) {
+      acc += ref[k] * wm[k][re_offset + i];
+    }
+    h[i] = acc;
   }
-
-  return result;
 }
 
 static void estimate_wiener(srsran_wiener_dl_t* q,
-                            const cf_t          wm[SRSRAN_WIENER_DL_MIN_RE][SRSRAN_WIENER_DL_MIN_REF],
+                            const cf_t          wm[SRSRAN_WIENER_DL_MIN_REF][SRSRAN_WIENER_DL_MIN_RE],
                             cf_t*               ref,
                             cf_t*               h)
 {
-  uint32_t r_offset = 0; // Resource Element indexing offset
-  uint32_t p_offset = 0; // Pilot indexing offset
-
   // Estimate lower band
-  for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_RE; i++) {
-    h[r_offset + i] = _srsran_vec_dot_prod_ccc_simd(&ref[p_offset], wm[i], SRSRAN_WIENER_DL_MIN_REF);
-  }
+  wiener_filter(wm, 0, ref, h, SRSRAN_WIENER_DL_MIN_RE);
 
   // Estimate Upper band (it might overlap in 6PRB cells with the lower band)
-  r_offset = q->nof_re - SRSRAN_WIENER_DL_MIN_RE;
-  p_offset = q->nof_ref - SRSRAN_WIENER_DL_MIN_REF;
-  for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_RE; i++) {
-    h[r_offset + i] = _srsran_vec_dot_prod_ccc_simd(&ref[p_offset], wm[i], SRSRAN_WIENER_DL_MIN_REF);
-  }
+  uint32_t r_offset = q->nof_re - SRSRAN_WIENER_DL_MIN_RE;
+  uint32_t p_offset = q->nof_ref - SRSRAN_WIENER_DL_MIN_REF;
+  wiener_filter(wm, 0, &ref[p_offset], &h[r_offset], SRSRAN_WIENER_DL_MIN_RE);
 
   // Estimate center Resource elements
   if (q->nof_re > 2 * SRSRAN_WIENER_DL_MIN_RE) {
     for (uint32_t prb = 2; prb < q->nof_prb - 2; prb += 2) {
       p_offset = (prb - 1) * 2;
       r_offset = prb * SRSRAN_NRE;
-      for (uint32_t i = 0; i < SRSRAN_NRE * 2; i++) {
-        h[r_offset + i] = _srsran_vec_dot_prod_ccc_simd(&ref[p_offset], wm[i + SRSRAN_NRE], SRSRAN_WIENER_DL_MIN_REF);
-      }
+      wiener_filter(wm, SRSRAN_NRE, &ref[p_offset], &h[r_offset], SRSRAN_NRE * 2);
     }
   }
 }
@@ -559,11 +568,12 @@ srsran_wiener_dl_run_symbol_1_8(srsran_wiener_dl_t* q, srsran_wiener_dl_state_t*
       state->timefifo, pilots[SRSRAN_WIENER_HALFREF_IDX], state->cxfifo[0], SRSRAN_WIENER_DL_TIMEFIFO_SIZE);
 
   // Calculate auto-correlation and normalize
-  matrix_acc_dim1_cc(state->cxfifo, q->tmp, SRSRAN_WIENER_DL_CXFIFO_SIZE, SRSRAN_WIENER_DL_TIMEFIFO_SIZE);
-  srsran_vec_sc_prod_cfc(q->tmp, 1.0f / SRSRAN_WIENER_DL_CXFIFO_SIZE, q->tmp, SRSRAN_WIENER_DL_TIMEFIFO_SIZE);
+  matrix_acc_dim1_cc(state->cxfifo, state->tmp, SRSRAN_WIENER_DL_CXFIFO_SIZE, SRSRAN_WIENER_DL_TIMEFIFO_SIZE);
+  srsran_vec_sc_prod_cfc(state->tmp, 1.0f / SRSRAN_WIENER_DL_CXFIFO_SIZE, state->tmp, SRSRAN_WIENER_DL_TIMEFIFO_SIZE);
 
   // Find index of half amplitude
-  uint32_t halfcx = vec_find_first_smaller_than_cf(q->tmp, cabsf(q->tmp[1]) * 0.5f, SRSRAN_WIENER_DL_TIMEFIFO_SIZE, 2);
+  uint32_t halfcx =
+      vec_find_first_smaller_than_cf(state->tmp, cabsf(state->tmp[1]) * 0.5f, SRSRAN_WIENER_DL_TIMEFIFO_SIZE, 2);
 
   // Update internal states
   state->sumlen       = SRSRAN_MAX(1, floorf(halfcx / 8.0f * SRSRAN_MIN(2.0f, 1.0f + 1.0f / snr_lin)));
@@ -577,11 +587,15 @@ static void srsran_wiener_dl_run_symbol_2_9(srsran_wiener_dl_t* q, srsran_wiener
   circshift_dim1(state->tfifo, SRSRAN_WIENER_DL_TFIFO_SIZE, 1); // shift matrix columns right by one position
 
   // Average Reference Signals
-  matrix_acc_dim1_cc(state->hls_fifo_2, q->tmp, state->sumlen, q->nof_ref); // Sum values
-  srsran_vec_sc_prod_cfc(q->tmp, 1.0f / state->sumlen, q->tmp, q->nof_ref); // Scale sum
+  matrix_acc_dim1_cc(state->hls_fifo_2, state->tmp, state->sumlen, q->nof_ref);     // Sum values
+  srsran_vec_sc_prod_cfc(state->tmp, 1.0f / state->sumlen, state->tmp, q->nof_ref); // Scale sum
 
   // Estimate channel based on the wiener matrix 2
-  estimate_wiener(q, q->wm2, q->tmp, state->tfifo[0]);
+  if (q->bank) {
+    estimate_wiener(q, q->bank->wm2, state->tmp, state->tfifo[0]);
+  } else {
+    srsran_vec_cf_zero(state->tfifo[0], q->nof_re);
+  }
 
   // Update internal states
   state->deltan       = 0.0f;
@@ -591,8 +605,6 @@ static void srsran_wiener_dl_run_symbol_2_9(srsran_wiener_dl_t* q, srsran_wiener
 static void srsran_wiener_dl_run_symbol_5_12(srsran_wiener_dl_t*       q,
                                              srsran_wiener_dl_state_t* state,
                                              cf_t*                     pilots,
-                                             uint32_t                  tx,
-                                             uint32_t                  rx,
                                              uint32_t                  shift,
                                              float                     snr_lin)
 {
@@ -603,11 +615,15 @@ static void srsran_wiener_dl_run_symbol_5_12(srsran_wiener_dl_t*       q,
   circshift_dim1(state->tfifo, SRSRAN_WIENER_DL_TFIFO_SIZE, 1); // shift matrix columns right by one position
 
   // Average Reference Signals
-  matrix_acc_dim1_cc(state->hls_fifo_1, q->tmp, state->sumlen, q->nof_ref); // Sum values
-  srsran_vec_sc_prod_cfc(q->tmp, 1.0f / state->sumlen, q->tmp, q->nof_ref); // Scale sum
+  matrix_acc_dim1_cc(state->hls_fifo_1, state->tmp, state->sumlen, q->nof_ref);     // Sum values
+  srsran_vec_sc_prod_cfc(state->tmp, 1.0f / state->sumlen, state->tmp, q->nof_ref); // Scale sum
 
   // Estimate channel based on the wiener matrix 1
-  estimate_wiener(q, q->wm1, q->tmp, state->tfifo[0]);
+  if (q->bank) {
+    estimate_wiener(q, q->bank->wm1, state->tmp, state->tfifo[0]);
+  } else {
+    srsran_vec_cf_zero(state->tfifo[0], q->nof_re);
+  }
 
   // Update internal states
   state->deltan       = 0.0f;
@@ -623,7 +639,7 @@ static void srsran_wiener_dl_run_symbol_5_12(srsran_wiener_dl_t*       q,
     pos1 = (pos2 + 3) % 6;
 
     // Choose randomly a pair of PRB and calculate the start reference signal
-    nsbb = srsran_random_uniform_int_dist(q->random, 0, q->nof_prb / 2);
+    nsbb = srsran_random_uniform_int_dist(state->random, 0, q->nof_prb / 2);
     if (nsbb == 0) {
       pstart = 0;
     } else if (nsbb >= (q->nof_prb / 2) - 1) {
@@ -632,121 +648,34 @@ static void srsran_wiener_dl_run_symbol_5_12(srsran_wiener_dl_t*       q,
       pstart = (SRSRAN_WIENER_DL_MIN_REF / 2) * nsbb - 2;
     }
 
-    bzero(q->hlsv, NSAMPLES2NBYTES(SRSRAN_WIENER_DL_MIN_RE));
+    bzero(state->hlsv, NSAMPLES2NBYTES(SRSRAN_WIENER_DL_MIN_RE));
     for (uint32_t i = pos2, k = pstart; i < SRSRAN_WIENER_DL_MIN_RE; i += 6, k++) {
-      q->hlsv[i] = conjf(state->hls_fifo_2[1][k] + (state->hls_fifo_2[0][k] - state->hls_fifo_2[1][k]) * M_4_7);
+      state->hlsv[i] = conjf(state->hls_fifo_2[1][k] + (state->hls_fifo_2[0][k] - state->hls_fifo_2[1][k]) * M_4_7);
     }
     for (uint32_t i = pos1, k = pstart; i < SRSRAN_WIENER_DL_MIN_RE; i += 6, k++) {
-      q->hlsv[i] = conjf(state->hls_fifo_1[1][k]);
+      state->hlsv[i] = conjf(state->hls_fifo_1[1][k]);
     }
 
     // Correlate Least Squares estimation
-    bzero(q->hlsv_sum, NSAMPLES2NBYTES(SRSRAN_WIENER_DL_MIN_RE)); // Zero correlation vector
+    bzero(state->hlsv_sum, NSAMPLES2NBYTES(SRSRAN_WIENER_DL_MIN_RE)); // Zero correlation vector
     for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_REF * 2; i++) {
       uint32_t offset  = i * 3;
       uint32_t sum_len = SRSRAN_WIENER_DL_MIN_RE - offset;
-      srsran_vec_sc_prod_ccc(&q->hlsv[offset], conjf(q->hlsv[offset]), q->tmp, sum_len);
-      srsran_vec_sum_ccc(q->tmp, q->hlsv_sum, q->hlsv_sum, sum_len);
+      srsran_vec_sc_prod_ccc(&state->hlsv[offset], conjf(state->hlsv[offset]), state->tmp, sum_len);
+      srsran_vec_sum_ccc(state->tmp, state->hlsv_sum, state->hlsv_sum, sum_len);
     }
-    srsran_vec_prod_cfc(q->hlsv_sum, hlsv_sum_norm, q->hlsv_sum, SRSRAN_WIENER_DL_MIN_RE); // Normalize correlation
+    srsran_vec_prod_cfc(
+        state->hlsv_sum, hlsv_sum_norm, state->hlsv_sum, SRSRAN_WIENER_DL_MIN_RE); // Normalize correlation
 
     // Put correlation in FIFO
     state->nfifosamps = SRSRAN_MIN(state->nfifosamps + 1, SRSRAN_WIENER_DL_XFIFO_SIZE);
     circshift_dim1(state->xfifo, state->nfifosamps, 1);
-    memcpy(state->xfifo[0], q->hlsv_sum, NSAMPLES2NBYTES(SRSRAN_WIENER_DL_MIN_RE));
-
-    // Average samples in FIFO
-    matrix_acc_dim1_cc(state->xfifo, state->cV, SRSRAN_WIENER_DL_XFIFO_SIZE, SRSRAN_WIENER_DL_MIN_RE);
-    if (state->nfifosamps) {
-      srsran_vec_sc_prod_cfc(state->cV, 1.0f / state->nfifosamps, state->cV, SRSRAN_WIENER_DL_MIN_RE);
-    }
-
-    // Interpolate
-    srsran_dft_run_c(&q->fft, state->cV, q->tmp);
-    srsran_vec_prod_ccc(q->tmp, q->filter, q->tmp, SRSRAN_WIENER_DL_MIN_RE);
-    srsran_dft_run_c(&q->ifft, q->tmp, state->cV);
-
-    // Interpolate last edge
-    state->cV[SRSRAN_WIENER_DL_MIN_RE - 2] =
-        state->cV[SRSRAN_WIENER_DL_MIN_RE - 6] +
-        (state->cV[SRSRAN_WIENER_DL_MIN_RE - 3] - state->cV[SRSRAN_WIENER_DL_MIN_RE - 6]) * M_4_3;
-    state->cV[SRSRAN_WIENER_DL_MIN_RE - 1] =
-        state->cV[SRSRAN_WIENER_DL_MIN_RE - 6] +
-        (state->cV[SRSRAN_WIENER_DL_MIN_RE - 3] - state->cV[SRSRAN_WIENER_DL_MIN_RE - 6]) * M_5_3;
-
-    if (tx == q->nof_tx_ports - 1 && rx == q->nof_rx_ant - 1) {
-      // Average correlation vectors
-      for (uint32_t i = 0; i < q->nof_tx_ports; i++) {
-        for (uint32_t j = 0; j < q->nof_rx_ant; j++) {
-          if (i == 0 && j == 0) {
-            // Copy if first one
-            memcpy(q->acV, q->state[i][j]->cV, NSAMPLES2NBYTES(SRSRAN_WIENER_DL_MIN_RE));
-
-          } else {
-            // Accumulate otherwise
-            srsran_vec_sum_ccc(q->state[i][j]->cV, q->acV, q->acV, SRSRAN_WIENER_DL_MIN_RE);
-          }
-        }
-      }
-
-      // Apply averaging scale
-      srsran_vec_sc_prod_cfc(q->acV, 1.0f / (q->nof_tx_ports * q->nof_rx_ant), q->acV, SRSRAN_WIENER_DL_MIN_RE);
-
-      // Compute square wiener correlation matrix
-      for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_REF; i++) {
-        for (uint32_t k = i; k < SRSRAN_WIENER_DL_MIN_REF; k++) {
-          q->RH.m[i][k] = q->acV[6 * (k - i)];
-          q->RH.m[k][i] = conjf(q->RH.m[i][k]);
-        }
-      }
-
-      // Add noise contribution to the square wiener
-      float N = 0.0f;
-
-      if (isnormal(__real__ q->acV[0]) && isnormal(snr_lin) && state->sumlen > 0) {
-        N = (__real__ q->acV[0] / SRSRAN_MIN(15, snr_lin * state->sumlen));
-      }
+    memcpy(state->xfifo[0], state->hlsv_sum, NSAMPLES2NBYTES(SRSRAN_WIENER_DL_MIN_RE));
 
-      for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_REF; i++) {
-        q->RH.m[i][i] += N;
-      }
-
-      // Compute wiener correlation inverse matrix
-      srsran_matrix_NxN_inv_run(q->matrix_inverter, q->RH.v, q->invRH.v);
-
-      // Generate Rectangular Wiener
-      for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_RE; i++) {
-        for (uint32_t k = 0; k < SRSRAN_WIENER_DL_MIN_REF; k++) {
-          int m1 = ((shift + 3) % 6) + 6 * k - i;
-          int m2 = shift + 6 * k - i;
-
-          if (m1 >= 0) {
-            q->hH1[i][k] = q->acV[m1];
-          } else {
-            q->hH1[i][k] = conjf(q->acV[-m1]);
-          }
-
-          if (m2 >= 0) {
-            q->hH2[i][k] = q->acV[m2];
-          } else {
-            q->hH2[i][k] = conjf(q->acV[-m2]);
-          }
-        }
-      }
-
-      // Compute Wiener matrices
-      for (uint32_t dim1 = 0; dim1 < SRSRAN_WIENER_DL_MIN_RE; dim1++) {
-        for (uint32_t dim2 = 0; dim2 < SRSRAN_WIENER_DL_MIN_REF; dim2++) {
-          q->wm1[dim1][dim2] = 0;
-          q->wm2[dim1][dim2] = 0;
-          for (int i = 0; i < SRSRAN_WIENER_DL_MIN_REF; i++) {
-            q->wm1[dim1][dim2] += _cmul(q->hH1[dim1][i], q->invRH.m[i][dim2]);
-            q->wm2[dim1][dim2] += _cmul(q->hH2[dim1][i], q->invRH.m[i][dim2]);
-          }
-        }
-      }
-      q->wm_computed = true;
-    }
+    // The correlation is averaged and the Wiener matrices are updated in srsran_wiener_dl_update()
+    state->trained = true;
+    state->snr_lin = snr_lin;
+    state->shift   = shift;
   }
 }
 
@@ -761,7 +690,7 @@ int srsran_wiener_dl_run(srsran_wiener_dl_t* q,
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
 
-  if (q) {
+  if (q && tx < q->nof_tx_ports && rx < q->nof_rx_ant) {
     // m is based on 0, increase one;
     m++;
 
@@ -771,7 +700,6 @@ int srsran_wiener_dl_run(srsran_wiener_dl_t* q,
     // Process symbol
     switch (m) {
       case 1:
-        q->ready = q->wm_computed;
       case 8:
         srsran_wiener_dl_run_symbol_1_8(q, state, pilots, snr_lin);
         break;
@@ -781,16 +709,16 @@ int srsran_wiener_dl_run(srsran_wiener_dl_t* q,
         break;
       case 5:
       case 12:
-        srsran_wiener_dl_run_symbol_5_12(q, state, pilots, tx, rx, shift, snr_lin);
+        srsran_wiener_dl_run_symbol_5_12(q, state, pilots, shift, snr_lin);
         break;
       default:
           /* Do nothing */;
     }
 
     // Estimate
-    srsran_vec_sub_ccc(state->tfifo[0], state->tfifo[1], q->tmp, q->nof_re);
-    srsran_vec_sc_prod_cfc(q->tmp, state->deltan * state->invtpilotoff, q->tmp, q->nof_re);
-    srsran_vec_sum_ccc(state->tfifo[1], q->tmp, estimated, q->nof_re);
+    srsran_vec_sub_ccc(state->tfifo[0], state->tfifo[1], state->tmp, q->nof_re);
+    srsran_vec_sc_prod_cfc(state->tmp, state->deltan * state->invtpilotoff, state->tmp, q->nof_re);
+    srsran_vec_sum_ccc(state->tfifo[1], state->tmp, estimated, q->nof_re);
     state->deltan += 1.0f;
 
     ret = SRSRAN_SUCCESS;
@@ -799,6 +727,173 @@ int srsran_wiener_dl_run(srsran_wiener_dl_t* q,
   return ret;
 }
 
+// Averages the correlation vectors in the FIFO of a channel and interpolates the missing frequency lags
+static void srsran_wiener_dl_state_correlation(srsran_wiener_dl_t* q, srsran_wiener_dl_state_t* state)
+{
+  // Average samples in FIFO
+  matrix_acc_dim1_cc(state->xfifo, state->cV, SRSRAN_WIENER_DL_XFIFO_SIZE, SRSRAN_WIENER_DL_MIN_RE);
+  if (state->nfifosamps) {
+    srsran_vec_sc_prod_cfc(state->cV, 1.0f / state->nfifosamps, state->cV, SRSRAN_WIENER_DL_MIN_RE);
+  }
+
+  // Interpolate
+  srsran_dft_run_c(&q->fft, state->cV, q->tmp);
+  srsran_vec_prod_ccc(q->tmp, q->filter, q->tmp, SRSRAN_WIENER_DL_MIN_RE);
+  srsran_dft_run_c(&q->ifft, q->tmp, state->cV);
+
+  // Interpolate last edge
+  state->cV[SRSRAN_WIENER_DL_MIN_RE - 2] =
+      state->cV[SRSRAN_WIENER_DL_MIN_RE - 6] +
+      (state->cV[SRSRAN_WIENER_DL_MIN_RE - 3] - state->cV[SRSRAN_WIENER_DL_MIN_RE - 6]) * M_4_3;
+  state->cV[SRSRAN_WIENER_DL_MIN_RE - 1] =
+      state->cV[SRSRAN_WIENER_DL_MIN_RE - 6] +
+      (state->cV[SRSRAN_WIENER_DL_MIN_RE - 3] - state->cV[SRSRAN_WIENER_DL_MIN_RE - 6]) * M_5_3;
+}
+
+// Computes the Wiener matrices from the averaged correlation vector q->acV and the noise contribution N
+static void srsran_wiener_dl_bank_compute(srsran_wiener_dl_t* q, srsran_wiener_dl_bank_t* bank, uint32_t shift, float N)
+{
+  // Compute square wiener correlation matrix
+  for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_REF; i++) {
+    for (uint32_t k = i; k < SRSRAN_WIENER_DL_MIN_REF; k++) {
+      q->RH.m[i][k] = q->acV[6 * (k - i)];
+      q->RH.m[k][i] = conjf(q->RH.m[i][k]);
+    }
+  }
+
+  // Add noise contribution to the square wiener
+  for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_REF; i++) {
+    q->RH.m[i][i] += N;
+  }
+
+  // Compute wiener correlation inverse matrix
+  srsran_matrix_NxN_inv_run(q->matrix_inverter, q->RH.v, q->invRH.v);
+
+  // Generate Rectangular Wiener
+  for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_RE; i++) {
+    for (uint32_t k = 0; k < SRSRAN_WIENER_DL_MIN_REF; k++) {
+      int m1 = ((shift + 3) % 6) + 6 * k - i;
+      int m2 = shift + 6 * k - i;
+
+      if (m1 >= 0) {
+        q->hH1[i][k] = q->acV[m1];
+      } else {
+        q->hH1[i][k] = conjf(q->acV[-m1]);
+      }
+
+      if (m2 >= 0) {
+        q->hH2[i][k] = q->acV[m2];
+      } else {
+        q->hH2[i][k] = conjf(q->acV[-m2]);
+      }
+    }
+  }
+
+  // Compute Wiener matrices, stored by pilot
+  for (uint32_t dim1 = 0; dim1 < SRSRAN_WIENER_DL_MIN_RE; dim1++) {
+    for (uint32_t dim2 = 0; dim2 < SRSRAN_WIENER_DL_MIN_REF; dim2++) {
+      cf_t wm1 = 0;
+      cf_t wm2 = 0;
+      for (int i = 0; i < SRSRAN_WIENER_DL_MIN_REF; i++) {
+        wm1 += _cmul(q->hH1[dim1][i], q->invRH.m[i][dim2]);
+        wm2 += _cmul(q->hH2[dim1][i], q->invRH.m[i][dim2]);
+      }
+      bank->wm1[dim2][dim1] = wm1;
+      bank->wm2[dim2][dim1] = wm2;
+    }
+  }
+}
+
+// Returns the cached bank computed with the same pilot shift and SNR and a close enough correlation, NULL otherwise
+static srsran_wiener_dl_bank_t* srsran_wiener_dl_bank_find(srsran_wiener_dl_t* q, uint32_t shift, int32_t snr_idx)
+{
+  float acV_pwr = srsran_vec_avg_power_cf(q->acV, SRSRAN_WIENER_DL_MIN_RE);
+
+  for (uint32_t i = 0; i < SRSRAN_WIENER_DL_BANK_CACHE_SIZE; i++) {
+    srsran_wiener_dl_bank_t* bank = &q->banks[i];
+    if (bank->valid && bank->shift == shift && bank->snr_idx == snr_idx) {
+      srsran_vec_sub_ccc(q->acV, bank->acV, q->tmp, SRSRAN_WIENER_DL_MIN_RE);
+      float err_pwr = srsran_vec_avg_power_cf(q->tmp, SRSRAN_WIENER_DL_MIN_RE);
+      if (err_pwr <= SRSRAN_WIENER_DL_BANK_MAX_CV_ERR * SRSRAN_MIN(acV_pwr, bank->acV_pwr)) {
+        return bank;
+      }
+    }
+  }
+
+  return NULL;
+}
+
+void srsran_wiener_dl_update(srsran_wiener_dl_t* q)
+{
+  if (q == NULL || q->nof_tx_ports == 0 || q->nof_rx_ant == 0) {
+    return;
+  }
+
+  // Average the correlation of the channels trained in the last subframe
+  srsran_wiener_dl_state_t* last = q->state[q->nof_tx_ports - 1][q->nof_rx_ant - 1];
+  bool                      update_wm = last->trained;
+  for (uint32_t i = 0; i < q->nof_tx_ports; i++) {
+    for (uint32_t j = 0; j < q->nof_rx_ant; j++) {
+      if (q->state[i][j]->trained) {
+        srsran_wiener_dl_state_correlation(q, q->state[i][j]);
+        q->state[i][j]->trained = false;
+      }
+    }
+  }
+
+  // The Wiener matrices follow the training of the last channel
+  if (update_wm) {
+    // Average correlation vectors
+    for (uint32_t i = 0; i < q->nof_tx_ports; i++) {
+      for (uint32_t j = 0; j < q->nof_rx_ant; j++) {
+        if (i == 0 && j == 0) {
+          // Copy if first one
+          memcpy(q->acV, q->state[i][j]->cV, NSAMPLES2NBYTES(SRSRAN_WIENER_DL_MIN_RE));
+
+        } else {
+          // Accumulate otherwise
+          srsran_vec_sum_ccc(q->state[i][j]->cV, q->acV, q->acV, SRSRAN_WIENER_DL_MIN_RE);
+        }
+      }
+    }
+
+    // Apply averaging scale
+    srsran_vec_sc_prod_cfc(q->acV, 1.0f / (q->nof_tx_ports * q->nof_rx_ant), q->acV, SRSRAN_WIENER_DL_MIN_RE);
+
+    // Noise contribution to the square wiener, from the SNR quantised in SRSRAN_WIENER_DL_BANK_SNR_STEP_DB steps
+    float   N       = 0.0f;
+    int32_t snr_idx = INT32_MAX;
+    if (isnormal(__real__ q->acV[0]) && isnormal(last->snr_lin) && last->sumlen > 0) {
+      float snr_db = srsran_convert_power_to_dB(SRSRAN_MIN(15, last->snr_lin * last->sumlen));
+      snr_idx      = (int32_t)roundf(snr_db / SRSRAN_WIENER_DL_BANK_SNR_STEP_DB);
+      N            = __real__ q->acV[0] / srsran_convert_dB_to_power(snr_idx * SRSRAN_WIENER_DL_BANK_SNR_STEP_DB);
+    }
+
+    // Reuse the cached bank if possible, otherwise replace the least recently used one
+    srsran_wiener_dl_bank_t* bank = srsran_wiener_dl_bank_find(q, last->shift, snr_idx);
+    if (bank == NULL) {
+      bank = &q->banks[0];
+      for (uint32_t i = 1; i < SRSRAN_WIENER_DL_BANK_CACHE_SIZE && bank->valid; i++) {
+        if (!q->banks[i].valid || q->banks[i].last_used < bank->last_used) {
+          bank = &q->banks[i];
+        }
+      }
+
+      srsran_wiener_dl_bank_compute(q, bank, last->shift, N);
+      memcpy(bank->acV, q->acV, NSAMPLES2NBYTES(SRSRAN_WIENER_DL_MIN_RE));
+      bank->acV_pwr = srsran_vec_avg_power_cf(q->acV, SRSRAN_WIENER_DL_MIN_RE);
+      bank->shift   = last->shift;
+      bank->snr_idx = snr_idx;
+      bank->valid   = true;
+    }
+    bank->last_used = ++q->bank_count;
+    q->bank         = bank;
+    q->wm_computed  = true;
+  }
+
+  q->ready = q->wm_computed;
+}
+
 void srsran_wiener_dl_free(srsran_wiener_dl_t* q)
 {
   if (q) {
@@ -815,10 +910,6 @@ void srsran_wiener_dl_free(srsran_wiener_dl_t* q)
       free(q->tmp);
     }
 
-    if (q->random) {
-      srsran_random_free(q->random);
-    }
-
     srsran_dft_plan_free(&q->fft);
     srsran_dft_plan_free(&q->ifft);
 
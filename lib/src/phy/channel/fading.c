@@ -21,7 +21,9 @@
 
 #include "srsran/phy/channel/fading.h"
 #include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
+#include <complex.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -77,80 +79,37 @@ static inline int parse_model(srsran_channel_fading_t* q, const char* str)
   return ret;
 }
 
-#ifdef LV_HAVE_SSE
-#include <immintrin.h>
-static inline __m128 _sine(const float* table, __m128 arg)
+// Computes the Doppler dispersion term phasors at the given time
+static void doppler_set_time(srsran_channel_fading_t* q, double t)
 {
-  __m128 ret;
-  int    idx[4];
-  float  sine[4];
-
-  __m128 turns =
-      _mm_round_ps(_mm_mul_ps(arg, _mm_set1_ps(1.0f / (2.0f * (float)M_PI))), (_MM_FROUND_TO_ZERO + _MM_FROUND_NO_EXC));
-  __m128  argmod   = _mm_sub_ps(arg, _mm_mul_ps(turns, _mm_set1_ps(2.0f * (float)M_PI)));
-  __m128  indexps  = _mm_mul_ps(argmod, _mm_set1_ps(1024.0f / (2.0f * (float)M_PI)));
-  __m128i indexi32 = _mm_abs_epi32(_mm_cvtps_epi32(indexps));
-  _mm_store_si128((__m128i*)idx, indexi32);
-
-  for (int i = 0; i < 4; i++) {
-    sine[i] = table[idx[i]];
-  }
+  for (uint32_t i = 0; i < nof_taps[q->model]; i++) {
+    for (uint32_t j = 0; j < SRSRAN_CHANNEL_FADING_NTERMS; j++) {
+      double arg = fmod(M_PI * q->doppler * cos(q->coeff_alpha[i][j]) * t, 2.0 * M_PI);
 
-  ret = _mm_load_ps(sine);
-  return ret;
+      q->doppler_phasor[i][0][j] = cexpf(_Complex_I * (float)(arg + q->coeff_a[i][j]));
+      q->doppler_phasor[i][1][j] = cexpf(_Complex_I * (float)(arg + q->coeff_b[i][j]));
+    }
+  }
 }
 
-static inline __m128 _cosine(float* table, __m128 arg)
+// Advances the Doppler dispersion term phasors by N/2 samples, for all taps at once
+static inline void doppler_advance(srsran_channel_fading_t* q)
 {
-  arg = _mm_add_ps(arg, _mm_set1_ps((float)M_PI_2));
-  return _sine(table, arg);
+  srsran_vec_prod_ccc(&q->doppler_phasor[0][0][0],
+                      &q->doppler_rot[0][0][0],
+                      &q->doppler_phasor[0][0][0],
+                      nof_taps[q->model] * 2 * SRSRAN_CHANNEL_FADING_NTERMS);
 }
-#endif /*LV_HAVE_SSE*/
 
-static inline cf_t
-get_doppler_dispersion(srsran_channel_fading_t* q, float t, float F_d, float* alpha, float* a, float* b)
+static inline cf_t get_doppler_dispersion(srsran_channel_fading_t* q, uint32_t tap)
 {
-#ifdef LV_HAVE_SSE
-  const float recN   = 1.0f / sqrtf(SRSRAN_CHANNEL_FADING_NTERMS);
-  cf_t        ret    = 0;
-  __m128      _reacc = _mm_setzero_ps();
-  __m128      _imacc = _mm_setzero_ps();
-  __m128      _arg   = _mm_set1_ps((float)M_PI * F_d);
-  __m128      _t     = _mm_set1_ps(t);
-  __m128      _arg_  = (_mm_mul_ps(_arg, _t));
-
-  for (int i = 0; i < SRSRAN_CHANNEL_FADING_NTERMS; i += 4) {
-    __m128 _alpha = _mm_loadu_ps(&alpha[i]);
-    __m128 _a     = _mm_loadu_ps(&a[i]);
-    __m128 _b     = _mm_loadu_ps(&b[i]);
-    __m128 _arg1  = _mm_mul_ps(_arg_, _cosine(q->sin_table, _alpha));
-    __m128 _re    = _cosine(q->sin_table, _mm_add_ps(_arg1, _a));
-    __m128 _im    = _sine(q->sin_table, _mm_add_ps(_arg1, _b));
-    _reacc        = _mm_add_ps(_reacc, _re);
-    _imacc        = _mm_add_ps(_imacc, _im);
-  }
-
-  __m128 _tmp = _mm_hadd_ps(_reacc, _imacc);
-  _tmp        = _mm_hadd_ps(_tmp, _tmp);
-  float r[4];
-  _mm_store_ps(r, _tmp);
-  __real__ ret = r[0];
-  __imag__ ret = r[1];
-
-  return ret * recN;
-
-#else
   const float recN = 1.0f / sqrtf(SRSRAN_CHANNEL_FADING_NTERMS);
   cf_t        r    = 0;
 
-  for (uint32_t i = 0; i < SRSRAN_CHANNEL_FADING_NTERMS; i++) {
-    float arg = (float)M_PI * F_d * cosf(alpha[i]) * t;
-    __real__ r += cosf(arg + a[i]);
-    __imag__ r += sinf(arg + b[i]);
-  }
+  __real__ r = __real__ srsran_vec_acc_cc(q->doppler_phasor[tap][0], SRSRAN_CHANNEL_FADING_NTERMS);
+  __imag__ r = __imag__ srsran_vec_acc_cc(q->doppler_phasor[tap][1], SRSRAN_CHANNEL_FADING_NTERMS);
 
   return recN * r;
-#endif /*LV_HAVE_SSE*/
 }
 
 static inline void generate_tap(float delay_ns, float power_db, float srate, cf_t* buf, uint32_t N, uint32_t path_delay)
@@ -159,28 +118,48 @@ static inline void generate_tap(float delay_ns, float power_db, float srate, cf_
   float O         = (delay_ns * 1e-9f * srate + path_delay) / (float)N;
   cf_t  a0        = amplitude / N;
 
-  srsran_vec_gen_sine(a0, -O, buf, N);
+  // Generate the response swapping the negative and positive frequencies
+  srsran_vec_gen_sine(a0 * (cf_t)cexp(-_Complex_I * 2.0 * M_PI * O * (N / 2)), -O, buf, N / 2);
+  srsran_vec_gen_sine(a0, -O, &buf[N / 2], N / 2);
 }
 
-static inline void generate_taps(srsran_channel_fading_t* q, float time)
+static inline void generate_taps(srsran_channel_fading_t* q)
 {
-  // Generate taps
-  for (int i = 0; i < nof_taps[q->model]; i++) {
-    // Compute phase for the doppler dispersion
-    cf_t a = get_doppler_dispersion(q, time, q->doppler, q->coeff_alpha[i], q->coeff_a[i], q->coeff_b[i]);
-
-    if (i) {
-      // Copy tap frequency response
-      srsran_vec_sc_prod_ccc(q->h_tap[i], a, q->temp, q->N);
-
-      // Add to frequency response, shifts FFT at same time
-      srsran_vec_sum_ccc(q->h_freq, &q->temp[q->N / 2], q->h_freq, q->N / 2);
-      srsran_vec_sum_ccc(&q->h_freq[q->N / 2], q->temp, &q->h_freq[q->N / 2], q->N / 2);
-    } else {
-      // Copy tap frequency response
-      srsran_vec_sc_prod_ccc(&q->h_tap[i][q->N / 2], a, q->h_freq, q->N / 2);
-      srsran_vec_sc_prod_ccc(&q->h_tap[i][0], a, &q->h_freq[q->N / 2], q->N / 2);
+  uint32_t ntaps = nof_taps[q->model];
+  cf_t     a[SRSRAN_CHANNEL_FADING_MAXTAPS];
+
+  // Compute phase for the doppler dispersion
+  for (uint32_t i = 0; i < ntaps; i++) {
+    a[i] = get_doppler_dispersion(q, i);
+  }
+
+  // Add all the tap frequency responses in a single pass, they are already FFT shifted
+  uint32_t k = 0;
+#if SRSRAN_SIMD_F_SIZE && !defined(HAVE_NEON)
+  simd_f_t a_re[SRSRAN_CHANNEL_FADING_MAXTAPS];
+  simd_f_t a_im[SRSRAN_CHANNEL_FADING_MAXTAPS];
+  for (uint32_t i = 0; i < ntaps; i++) {
+    a_re[i] = srsran_simd_f_set1(__real__ a[i]);
+    a_im[i] = srsran_simd_f_set1(__imag__ a[i]);
+  }
+
+  for (; k + SRSRAN_SIMD_F_SIZE / 2 <= q->N; k += SRSRAN_SIMD_F_SIZE / 2) {
+    simd_f_t acc = srsran_simd_f_zero();
+    for (uint32_t i = 0; i < ntaps; i++) {
+      simd_f_t h  = srsran_simd_f_load((float*)&q->h_tap[i][k]);
+      simd_f_t m1 = srsran_simd_f_mul(a_re[i], h);
+      simd_f_t m2 = srsran_simd_f_mul(a_im[i], srsran_simd_f_swap(h));
+      acc         = srsran_simd_f_add(acc, srsran_simd_f_addsub(m1, m2));
+    }
+    srsran_simd_f_store((float*)&q->h_freq[k], acc);
+  }
+#endif /* SRSRAN_SIMD_F_SIZE && !defined(HAVE_NEON) */
+  for (; k < q->N; k++) {
+    cf_t acc = 0;
+    for (uint32_t i = 0; i < ntaps; i++) {
+      acc += a[i] * q->h_tap[i][k];
     }
+    q->h_freq[k] = acc;
   }
   // at this stage, q->h_freq should contain the frequency response
 }
@@ -250,11 +229,14 @@ int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const c
       // Generate tap frequency response
       generate_tap(
           excess_tap_delay_ns[q->model][i], relative_power_db[q->model][i], q->srate, q->h_tap[i], q->N, q->path_delay);
-    }
 
-    // Generate sine Table
-    for (uint32_t i = 0; i < 1024; i++) {
-      q->sin_table[i] = sinf((float)i * 2.0f * (float)M_PI / 1024);
+      // Rotation of the Doppler dispersion terms over a segment of N/2 samples
+      for (uint32_t j = 0; j < SRSRAN_CHANNEL_FADING_NTERMS; j++) {
+        double w = M_PI * q->doppler * cos(q->coeff_alpha[i][j]) * (q->N / 2) / srate;
+
+        q->doppler_rot[i][0][j] = cexpf(_Complex_I * (float)fmod(w, 2.0 * M_PI));
+        q->doppler_rot[i][1][j] = q->doppler_rot[i][0][j];
+      }
     }
 
     // Free random
@@ -344,9 +326,11 @@ double srsran_channel_fading_execute(srsran_channel_fading_t* q,
   uint32_t counter = 0;
 
   if (q) {
+    doppler_set_time(q, init_time);
+
     while (counter < nsamples) {
       // Generate taps
-      generate_taps(q, (float)init_time);
+      generate_taps(q);
 
       // Do not process more than N/2 samples
       uint32_t n = SRSRAN_MIN(q->N / 2, nsamples - counter);
@@ -359,6 +343,9 @@ double srsran_channel_fading_execute(srsran_channel_fading_t* q,
 
       // Increment counter
       counter += n;
+
+      // Only the last segment may be shorter than N/2
+      doppler_advance(q);
     }
   }
 
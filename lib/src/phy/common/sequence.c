@@ -146,6 +146,45 @@ static inline uint32_t sequence_gen_LTE_pr_memless_step_x2(uint32_t state)
 static uint32_t sequence_x1_init                    = 0;
 static uint32_t sequence_x2_init[SEQUENCE_SEED_LEN] = {};
 
+/**
+ * Packed sequence generation
+ * --------------------------
+ *
+ * Since p(D)^16 = p(D^16) in GF(2), raising the x1 and x2 characteristic polynomials to the 16th power gives the
+ * recursions:
+ *     x1(n + 496) = x1(n + 48) ^ x1(n)
+ *     x2(n + 496) = x2(n + 48) ^ x2(n + 32) ^ x2(n + 16) ^ x2(n)
+ *
+ * All the taps are byte aligned, so a window of the last 496 bits packed in bytes produces the next 448 bits with byte
+ * XORs only, 256 bits per step with AVX2. The first 496 bits (after Nc) of x1 are fixed and the ones of x2 are linear
+ * with the seed, so they are pre-computed for every seed bit.
+ *
+ * Inside the window, the bit n of the sequence is the bit (n % 8) of the byte n / 8, LSB first.
+ */
+#define SEQUENCE_HEAD_BYTES (62)
+#define SEQUENCE_HEAD_STRIDE (64)
+#define SEQUENCE_CHUNK_BYTES (1024)
+#define SEQUENCE_STEP_BYTES (32)
+
+static uint8_t sequence_x1_head[SEQUENCE_HEAD_STRIDE]                    = {};
+static uint8_t sequence_x2_head[SEQUENCE_SEED_LEN][SEQUENCE_HEAD_STRIDE] = {};
+
+typedef struct {
+  uint8_t x1[SEQUENCE_HEAD_BYTES + SEQUENCE_CHUNK_BYTES + SEQUENCE_STEP_BYTES];
+  uint8_t x2[SEQUENCE_HEAD_BYTES + SEQUENCE_CHUNK_BYTES + SEQUENCE_STEP_BYTES];
+} sequence_packed_gen_t;
+
+/**
+ * Packs the first SEQUENCE_HEAD_BYTES bytes of a x1 or x2 sequence starting from the given state
+ */
+static void sequence_gen_head(uint32_t state, bool is_x2, uint8_t* head)
+{
+  for (uint32_t n = 0; n < SEQUENCE_HEAD_BYTES * 8; n++) {
+    head[n / 8] |= (uint8_t)((state & 1U) << (n % 8));
+    state = is_x2 ? sequence_gen_LTE_pr_memless_step_x2(state) : sequence_gen_LTE_pr_memless_step_x1(state);
+  }
+}
+
 /**
  * C constructor, pre-computes X1 and X2 initial states
  */
@@ -165,6 +204,12 @@ __attribute__((constructor)) __attribute__((unused)) static void srsran_lte_pr_p
       sequence_x2_init[i] = sequence_gen_LTE_pr_memless_step_x2(sequence_x2_init[i]);
     }
   }
+
+  // Pre-compute the heads of the packed generator
+  sequence_gen_head(sequence_x1_init, false, sequence_x1_head);
+  for (uint32_t i = 0; i < SEQUENCE_SEED_LEN; i++) {
+    sequence_gen_head(sequence_x2_init[i], true, sequence_x2_head[i]);
+  }
 }
 
 static uint32_t sequence_get_x2_init(uint32_t seed)
@@ -797,3 +842,389 @@ void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t leng
   }
 #endif // SEQUENCE_PAR_BITS % 8 == 0
 }
+
+static void sequence_packed_gen_init(sequence_packed_gen_t* g, uint32_t seed)
+{
+  memcpy(g->x1, sequence_x1_head, SEQUENCE_HEAD_STRIDE);
+  srsran_vec_u8_zero(g->x2, SEQUENCE_HEAD_STRIDE);
+
+  for (uint32_t i = 0; i < SEQUENCE_SEED_LEN; i++) {
+    if ((seed >> i) & 1U) {
+      srsran_vec_xor_bbb(g->x2, sequence_x2_head[i], g->x2, SEQUENCE_HEAD_STRIDE);
+    }
+  }
+}
+
+/**
+ * Extends the window nof_bytes (up to SEQUENCE_CHUNK_BYTES) after the head
+ */
+static void sequence_packed_gen_fill(sequence_packed_gen_t* g, uint32_t nof_bytes)
+{
+  uint32_t j = 0;
+
+#ifdef LV_HAVE_AVX2
+  for (; j < nof_bytes; j += SEQUENCE_STEP_BYTES) {
+    __m256i a1 = _mm256_loadu_si256((__m256i*)(g->x1 + j));
+    __m256i b1 = _mm256_loadu_si256((__m256i*)(g->x1 + j + 6));
+    _mm256_storeu_si256((__m256i*)(g->x1 + SEQUENCE_HEAD_BYTES + j), _mm256_xor_si256(a1, b1));
+
+    __m256i a2 = _mm256_loadu_si256((__m256i*)(g->x2 + j));
+    __m256i b2 = _mm256_loadu_si256((__m256i*)(g->x2 + j + 2));
+    __m256i c2 = _mm256_loadu_si256((__m256i*)(g->x2 + j + 4));
+    __m256i d2 = _mm256_loadu_si256((__m256i*)(g->x2 + j + 6));
+    a2         = _mm256_xor_si256(_mm256_xor_si256(a2, b2), _mm256_xor_si256(c2, d2));
+    _mm256_storeu_si256((__m256i*)(g->x2 + SEQUENCE_HEAD_BYTES + j), a2);
+  }
+#endif // LV_HAVE_AVX2
+
+  for (; j < nof_bytes; j += sizeof(uint64_t)) {
+    uint64_t a1, b1, a2, b2, c2, d2;
+    memcpy(&a1, g->x1 + j, sizeof(uint64_t));
+    memcpy(&b1, g->x1 + j + 6, sizeof(uint64_t));
+    a1 ^= b1;
+    memcpy(g->x1 + SEQUENCE_HEAD_BYTES + j, &a1, sizeof(uint64_t));
+
+    memcpy(&a2, g->x2 + j, sizeof(uint64_t));
+    memcpy(&b2, g->x2 + j + 2, sizeof(uint64_t));
+    memcpy(&c2, g->x2 + j + 4, sizeof(uint64_t));
+    memcpy(&d2, g->x2 + j + 6, sizeof(uint64_t));
+    a2 ^= b2 ^ c2 ^ d2;
+    memcpy(g->x2 + SEQUENCE_HEAD_BYTES + j, &a2, sizeof(uint64_t));
+  }
+}
+
+/**
+ * Writes the first nof_bytes of the window c = x1 ^ x2, reversing the bits of every byte so the output is packed MSB
+ * first as srsran_bit_pack_vector() does
+ */
+static void sequence_packed_gen_emit(const sequence_packed_gen_t* g, uint8_t* c, uint32_t nof_bytes)
+{
+  uint32_t i = 0;
+
+#ifdef LV_HAVE_AVX2
+  const __m256i lut_lo = _mm256_setr_epi8(0x00, 0x80, 0x40, 0xc0, 0x20, 0xa0, 0x60, 0xe0, 0x10, 0x90, 0x50, 0xd0, 0x30,
+                                          0xb0, 0x70, 0xf0, 0x00, 0x80, 0x40, 0xc0, 0x20, 0xa0, 0x60, 0xe0, 0x10, 0x90,
+                                          0x50, 0xd0, 0x30, 0xb0, 0x70, 0xf0);
+  const __m256i lut_hi = _mm256_srli_epi16(lut_lo, 4);
+  const __m256i mask   = _mm256_set1_epi8(0x0f);
+  for (; i + SEQUENCE_STEP_BYTES <= nof_bytes; i += SEQUENCE_STEP_BYTES) {
+    __m256i x = _mm256_xor_si256(_mm256_loadu_si256((__m256i*)(g->x1 + i)), _mm256_loadu_si256((__m256i*)(g->x2 + i)));
+    __m256i lo = _mm256_shuffle_epi8(lut_lo, _mm256_and_si256(x, mask));
+    __m256i hi = _mm256_shuffle_epi8(_mm256_and_si256(lut_hi, mask), _mm256_and_si256(_mm256_srli_epi16(x, 4), mask));
+    _mm256_storeu_si256((__m256i*)(c + i), _mm256_or_si256(lo, hi));
+  }
+#endif // LV_HAVE_AVX2
+
+  for (; i < nof_bytes; i++) {
+    uint8_t x = g->x1[i] ^ g->x2[i];
+    x         = (uint8_t)(((x & 0xf0U) >> 4U) | ((x & 0x0fU) << 4U));
+    x         = (uint8_t)(((x & 0xccU) >> 2U) | ((x & 0x33U) << 2U));
+    x         = (uint8_t)(((x & 0xaaU) >> 1U) | ((x & 0x55U) << 1U));
+    c[i]      = x;
+  }
+}
+
+void srsran_sequence_gen_packed(uint8_t* c_bytes, uint32_t length, uint32_t seed)
+{
+  sequence_packed_gen_t g;
+  sequence_packed_gen_init(&g, seed);
+
+  uint32_t nof_bytes = SRSRAN_CEIL(length, 8);
+  for (uint32_t i = 0; i < nof_bytes; i += SEQUENCE_CHUNK_BYTES) {
+    uint32_t n = SRSRAN_MIN(SEQUENCE_CHUNK_BYTES, nof_bytes - i);
+
+    // The head covers the shortest sequences
+    if (n > SEQUENCE_HEAD_BYTES || i + n < nof_bytes) {
+      sequence_packed_gen_fill(&g, n);
+    }
+
+    sequence_packed_gen_emit(&g, c_bytes + i, n);
+
+    // Slide the window
+    if (i + n < nof_bytes) {
+      memmove(g.x1, g.x1 + n, SEQUENCE_HEAD_BYTES);
+      memmove(g.x2, g.x2 + n, SEQUENCE_HEAD_BYTES);
+    }
+  }
+
+  // Clear the bits beyond the sequence length
+  if (length % 8 != 0) {
+    c_bytes[nof_bytes - 1] &= (uint8_t)(0xffU << (8U - length % 8U));
+  }
+}
+
+void srsran_sequence_bytes_apply_c(const uint8_t* c_bytes, const int8_t* in, int8_t* out, uint32_t length)
+{
+  uint32_t i = 0;
+
+#ifdef LV_HAVE_AVX2
+  const __m256i shuffle = _mm256_setr_epi8(
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+  const __m256i bits = _mm256_set1_epi64x(0x0102040810204080);
+  for (; i + 32 <= length; i += 32) {
+    // Spread 32 sequence bits, MSB first, in a byte mask
+    int32_t w;
+    memcpy(&w, c_bytes + i / 8, sizeof(int32_t));
+    __m256i mask = _mm256_shuffle_epi8(_mm256_set1_epi32(w), shuffle);
+    mask         = _mm256_cmpeq_epi8(_mm256_and_si256(mask, bits), bits);
+
+    // Negate where the sequence is one
+    __m256i v = _mm256_loadu_si256((__m256i*)(in + i));
+    v         = _mm256_sub_epi8(_mm256_xor_si256(v, mask), mask);
+    _mm256_storeu_si256((__m256i*)(out + i), v);
+  }
+#endif // LV_HAVE_AVX2
+
+  for (; i < length; i++) {
+    out[i] = in[i] * (((c_bytes[i / 8] >> (7U - i % 8U)) & 1U) ? -1 : +1);
+  }
+}
+
+void srsran_sequence_bytes_apply_s(const uint8_t* c_bytes, const int16_t* in, int16_t* out, uint32_t length)
+{
+  uint32_t i = 0;
+
+#ifdef LV_HAVE_AVX2
+  const __m256i bits = _mm256_setr_epi16(0x0080,
+                                         0x0040,
+                                         0x0020,
+                                         0x0010,
+                                         0x0008,
+                                         0x0004,
+                                         0x0002,
+                                         0x0001,
+                                         (int16_t)0x8000,
+                                         0x4000,
+                                         0x2000,
+                                         0x1000,
+                                         0x0800,
+                                         0x0400,
+                                         0x0200,
+                                         0x0100);
+  for (; i + 16 <= length; i += 16) {
+    // Spread 16 sequence bits, MSB first, in a 16 bit mask
+    int16_t w;
+    memcpy(&w, c_bytes + i / 8, sizeof(int16_t));
+    __m256i mask = _mm256_set1_epi16(w);
+    mask         = _mm256_cmpeq_epi16(_mm256_and_si256(mask, bits), bits);
+
+    // Negate where the sequence is one
+    __m256i v = _mm256_loadu_si256((__m256i*)(in + i));
+    v         = _mm256_sub_epi16(_mm256_xor_si256(v, mask), mask);
+    _mm256_storeu_si256((__m256i*)(out + i), v);
+  }
+#endif // LV_HAVE_AVX2
+
+  for (; i < length; i++) {
+    out[i] = in[i] * (((c_bytes[i / 8] >> (7U - i % 8U)) & 1U) ? -1 : +1);
+  }
+}
+
+void srsran_sequence_bytes_apply_bit(const uint8_t* c_bytes, const uint8_t* in, uint8_t* out, uint32_t length)
+{
+  uint32_t i = 0;
+
+#ifdef LV_HAVE_AVX2
+  const __m256i shuffle = _mm256_setr_epi8(
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+  const __m256i bits = _mm256_set1_epi64x(0x0102040810204080);
+  for (; i + 32 <= length; i += 32) {
+    int32_t w;
+    memcpy(&w, c_bytes + i / 8, sizeof(int32_t));
+    __m256i mask = _mm256_shuffle_epi8(_mm256_set1_epi32(w), shuffle);
+    mask         = _mm256_cmpeq_epi8(_mm256_and_si256(mask, bits), bits);
+
+    __m256i v = _mm256_loadu_si256((__m256i*)(in + i));
+    v         = _mm256_xor_si256(v, _mm256_and_si256(mask, _mm256_set1_epi8(1)));
+    _mm256_storeu_si256((__m256i*)(out + i), v);
+  }
+#endif // LV_HAVE_AVX2
+
+  for (; i < length; i++) {
+    out[i] = in[i] ^ ((c_bytes[i / 8] >> (7U - i % 8U)) & 1U);
+  }
+}
+
+void srsran_sequence_bytes_apply_packed(const uint8_t* c_bytes, const uint8_t* in, uint8_t* out, uint32_t length)
+{
+  srsran_vec_xor_bbb(in, c_bytes, out, length / 8);
+
+  // A cached sequence may be longer than length, only the spare bits are applied
+  uint32_t rem8 = length % 8;
+  if (rem8 != 0) {
+    out[length / 8] = in[length / 8] ^ (c_bytes[length / 8] & (uint8_t)(0xffU << (8U - rem8)));
+  }
+}
+
+int srsran_sequence_cache_init(srsran_sequence_cache_t* q, uint32_t nof_entries)
+{
+  if (q == NULL || nof_entries == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_sequence_cache_t, 1);
+
+  q->entries = SRSRAN_MEM_ALLOC(srsran_sequence_cache_entry_t, nof_entries);
+  if (q->entries == NULL) {
+    ERROR("Error allocating sequence cache");
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(q->entries, srsran_sequence_cache_entry_t, nof_entries);
+  q->nof_entries = nof_entries;
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_sequence_cache_free(srsran_sequence_cache_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->entries != NULL) {
+    for (uint32_t i = 0; i < q->nof_entries; i++) {
+      if (q->entries[i].c_bytes != NULL) {
+        free(q->entries[i].c_bytes);
+      }
+    }
+    free(q->entries);
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_sequence_cache_t, 1);
+}
+
+const uint8_t* srsran_sequence_cache_get(srsran_sequence_cache_t* q, uint32_t seed, uint32_t length)
+{
+  if (q == NULL || q->entries == NULL) {
+    return NULL;
+  }
+
+  q->clock++;
+
+  // Look up the seed, keeping track of the least recently used entry
+  srsran_sequence_cache_entry_t* victim = &q->entries[0];
+  for (uint32_t i = 0; i < q->nof_entries; i++) {
+    srsran_sequence_cache_entry_t* e = &q->entries[i];
+    if (e->last_use != 0 && e->seed == seed) {
+      if (e->len >= length) {
+        e->last_use = q->clock;
+        q->nof_hits++;
+        return e->c_bytes;
+      }
+
+      // Same seed but too short, regenerate it in place
+      victim = e;
+      break;
+    }
+    if (e->last_use < victim->last_use) {
+      victim = e;
+    }
+  }
+
+  q->nof_misses++;
+
+  // Make room for the sequence
+  if (victim->max_len < length) {
+    if (victim->c_bytes != NULL) {
+      free(victim->c_bytes);
+    }
+    victim->max_len = SRSRAN_CEIL(length, 8) * 8;
+    victim->c_bytes = srsran_vec_u8_malloc(victim->max_len / 8);
+    if (victim->c_bytes == NULL) {
+      ERROR("Error allocating sequence cache entry");
+      SRSRAN_MEM_ZERO(victim, srsran_sequence_cache_entry_t, 1);
+      return NULL;
+    }
+  }
+
+  srsran_sequence_gen_packed(victim->c_bytes, length, seed);
+  victim->seed     = seed;
+  victim->len      = length;
+  victim->last_use = q->clock;
+
+  return victim->c_bytes;
+}
+
+int srsran_sequence_rs_cache_init(srsran_sequence_rs_cache_t* q, uint32_t nof_slots, uint32_t nof_symbols, uint32_t len)
+{
+  if (q == NULL || nof_slots == 0 || nof_symbols == 0 || len == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Keep the entries if the dimensions did not change
+  if (q->entries != NULL && q->nof_slots == nof_slots && q->nof_symbols == nof_symbols && q->len == len) {
+    return SRSRAN_SUCCESS;
+  }
+
+  srsran_sequence_rs_cache_free(q);
+
+  uint32_t nof_entries = nof_slots * nof_symbols;
+  q->seeds             = SRSRAN_MEM_ALLOC(uint32_t, nof_entries);
+  q->entries           = SRSRAN_MEM_ALLOC(cf_t*, nof_entries);
+  if (q->seeds == NULL || q->entries == NULL) {
+    ERROR("Error allocating reference signal sequence cache");
+    srsran_sequence_rs_cache_free(q);
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(q->seeds, uint32_t, nof_entries);
+  SRSRAN_MEM_ZERO(q->entries, cf_t*, nof_entries);
+
+  q->nof_slots   = nof_slots;
+  q->nof_symbols = nof_symbols;
+  q->len         = len;
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_sequence_rs_cache_free(srsran_sequence_rs_cache_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->entries != NULL) {
+    for (uint32_t i = 0; i < q->nof_slots * q->nof_symbols; i++) {
+      if (q->entries[i] != NULL) {
+        free(q->entries[i]);
+      }
+    }
+    free(q->entries);
+  }
+  if (q->seeds != NULL) {
+    free(q->seeds);
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_sequence_rs_cache_t, 1);
+}
+
+const cf_t*
+srsran_sequence_rs_cache_get(srsran_sequence_rs_cache_t* q, uint32_t slot_idx, uint32_t symbol_idx, uint32_t seed)
+{
+  if (q == NULL || q->entries == NULL || slot_idx >= q->nof_slots || symbol_idx >= q->nof_symbols) {
+    return NULL;
+  }
+
+  uint32_t idx = slot_idx * q->nof_symbols + symbol_idx;
+  if (q->entries[idx] != NULL && q->seeds[idx] == seed) {
+    q->nof_hits++;
+    return q->entries[idx];
+  }
+
+  q->nof_misses++;
+
+  // First use of the slot and symbol
+  if (q->entries[idx] == NULL) {
+    q->entries[idx] = srsran_vec_cf_malloc(q->len);
+    if (q->entries[idx] == NULL) {
+      ERROR("Error allocating reference signal sequence cache entry");
+      return NULL;
+    }
+  }
+
+  srsran_sequence_state_t sequence_state = {};
+  srsran_sequence_state_init(&sequence_state, seed);
+  srsran_sequence_state_gen_f(&sequence_state, M_SQRT1_2, (float*)q->entries[idx], 2 * q->len);
+  q->seeds[idx] = seed;
+
+  return q->entries[idx];
+}
@@ -23,6 +23,7 @@
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/random.h"
+#include "srsran/support/srsran_test.h"
 
 #define Nc 1600
 #define MAX_SEQ_LEN (256 * 1024)
@@ -36,6 +37,11 @@ static int8_t  c_char[Nc + MAX_SEQ_LEN + 31];
 static uint8_t c_packed_gold[MAX_SEQ_LEN / 8];
 static uint8_t c_packed[MAX_SEQ_LEN / 8];
 static uint8_t c_unpacked[MAX_SEQ_LEN];
+static uint8_t c_bytes[MAX_SEQ_LEN / 8];
+static int16_t c_bytes_short[MAX_SEQ_LEN];
+static int8_t  c_bytes_char[MAX_SEQ_LEN];
+static uint8_t c_bytes_unpacked[MAX_SEQ_LEN];
+static uint8_t c_bytes_packed[MAX_SEQ_LEN / 8];
 
 static float   ones_float[Nc + MAX_SEQ_LEN + 31];
 static int16_t ones_short[Nc + MAX_SEQ_LEN + 31];
@@ -53,6 +59,7 @@ static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t le
   uint64_t       interval_xor_char_us     = 0;
   uint64_t       interval_xor_unpacked_us = 0;
   uint64_t       interval_xor_packed_us   = 0;
+  uint64_t       interval_gen_bytes_us    = 0;
 
   gettimeofday(&t[1], NULL);
 
@@ -178,7 +185,47 @@ static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t le
     ret = SRSRAN_ERROR;
   }
 
-  printf("%08x; %8d; %8.1f; %8.1f; %8.1f; %8.1f; %8.1f; %8.1f; %8c\n",
+  // Test packed generation
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < repetitions; r++) {
+    srsran_sequence_gen_packed(c_bytes, length, seed);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  interval_gen_bytes_us = t->tv_sec * 1000000UL + t->tv_usec;
+
+  if (memcmp(c_packed_gold, c_bytes, (length + 7) / 8) != 0) {
+    ERROR("Unmatched c_bytes");
+    ret = SRSRAN_ERROR;
+  }
+
+  // Test applying the packed sequence
+  srsran_sequence_bytes_apply_s(c_bytes, ones_short, c_bytes_short, length);
+  srsran_sequence_bytes_apply_c(c_bytes, ones_char, c_bytes_char, length);
+  srsran_sequence_bytes_apply_bit(c_bytes, ones_unpacked, c_bytes_unpacked, length);
+  srsran_sequence_bytes_apply_packed(c_bytes, ones_packed, c_bytes_packed, length);
+
+  if (memcmp(c_short, c_bytes_short, length * sizeof(int16_t)) != 0) {
+    ERROR("Unmatched bytes c_short");
+    ret = SRSRAN_ERROR;
+  }
+
+  if (memcmp(c_char, c_bytes_char, length * sizeof(int8_t)) != 0) {
+    ERROR("Unmatched bytes c_char");
+    ret = SRSRAN_ERROR;
+  }
+
+  if (memcmp(c, c_bytes_unpacked, length) != 0) {
+    ERROR("Unmatched bytes c_unpacked");
+    ret = SRSRAN_ERROR;
+  }
+
+  if (memcmp(c_packed_gold, c_bytes_packed, (length + 7) / 8) != 0) {
+    ERROR("Unmatched bytes c_packed");
+    ret = SRSRAN_ERROR;
+  }
+
+  printf("%08x; %8d; %8.1f; %8.1f; %8.1f; %8.1f; %8.1f; %8.1f; %8.1f; %8c\n",
          seed,
          length,
          (double)(length * repetitions) / (double)interval_gen_us,
@@ -187,8 +234,79 @@ static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t le
          (double)(length * repetitions) / (double)interval_xor_char_us,
          (double)(length * repetitions) / (double)interval_xor_unpacked_us,
          (double)(length * repetitions) / (double)interval_xor_packed_us,
+         (double)(length * repetitions) / (double)interval_gen_bytes_us,
          ret == SRSRAN_SUCCESS ? 'y' : 'n');
 
+  return ret;
+}
+
+static int test_cache()
+{
+  srsran_sequence_cache_t cache = {};
+  TESTASSERT(srsran_sequence_cache_init(&cache, 2) == SRSRAN_SUCCESS);
+
+  // Miss, then hit for the same and shorter lengths
+  const uint8_t* c_a = srsran_sequence_cache_get(&cache, 1234, 1000);
+  TESTASSERT(c_a != NULL);
+  srsran_sequence_gen_packed(c_bytes, 1000, 1234);
+  TESTASSERT(memcmp(c_a, c_bytes, 1000 / 8) == 0);
+  TESTASSERT(srsran_sequence_cache_get(&cache, 1234, 1000) == c_a);
+  TESTASSERT(srsran_sequence_cache_get(&cache, 1234, 500) == c_a);
+  TESTASSERT(cache.nof_hits == 2 && cache.nof_misses == 1);
+
+  // A longer sequence with the same seed is regenerated in place
+  c_a = srsran_sequence_cache_get(&cache, 1234, 4000);
+  TESTASSERT(c_a != NULL);
+  srsran_sequence_gen_packed(c_bytes, 4000, 1234);
+  TESTASSERT(memcmp(c_a, c_bytes, 4000 / 8) == 0);
+
+  // Filling the cache evicts the least recently used seed
+  TESTASSERT(srsran_sequence_cache_get(&cache, 5678, 1000) != NULL);
+  TESTASSERT(srsran_sequence_cache_get(&cache, 1234, 4000) != NULL);
+  TESTASSERT(srsran_sequence_cache_get(&cache, 9012, 1000) != NULL);
+  uint64_t nof_misses = cache.nof_misses;
+  TESTASSERT(srsran_sequence_cache_get(&cache, 1234, 4000) == c_a);
+  TESTASSERT(cache.nof_misses == nof_misses);
+  TESTASSERT(srsran_sequence_cache_get(&cache, 5678, 1000) != NULL);
+  TESTASSERT(cache.nof_misses == nof_misses + 1);
+
+  srsran_sequence_cache_free(&cache);
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_rs_cache()
+{
+  srsran_sequence_rs_cache_t cache = {};
+  TESTASSERT(srsran_sequence_rs_cache_init(&cache, 20, 14, 600) == SRSRAN_SUCCESS);
+
+  // The entry matches the directly generated sequence
+  const cf_t* r = srsran_sequence_rs_cache_get(&cache, 19, 13, 1234);
+  TESTASSERT(r != NULL);
+  srsran_sequence_state_t sequence_state = {};
+  srsran_sequence_state_init(&sequence_state, 1234);
+  srsran_sequence_state_gen_f(&sequence_state, M_SQRT1_2, c_float, 2 * 600);
+  TESTASSERT(memcmp(r, c_float, 600 * sizeof(cf_t)) == 0);
+
+  // Hit for the same slot, symbol and seed, regenerated for another seed and out-of-bounds slot or symbol rejected
+  TESTASSERT(srsran_sequence_rs_cache_get(&cache, 19, 13, 1234) == r);
+  TESTASSERT(cache.nof_hits == 1 && cache.nof_misses == 1);
+  TESTASSERT(srsran_sequence_rs_cache_get(&cache, 19, 13, 5678) == r);
+  TESTASSERT(cache.nof_misses == 2);
+  srsran_sequence_state_init(&sequence_state, 5678);
+  srsran_sequence_state_gen_f(&sequence_state, M_SQRT1_2, c_float, 2 * 600);
+  TESTASSERT(memcmp(r, c_float, 600 * sizeof(cf_t)) == 0);
+  TESTASSERT(srsran_sequence_rs_cache_get(&cache, 20, 0, 1234) == NULL);
+  TESTASSERT(srsran_sequence_rs_cache_get(&cache, 0, 14, 1234) == NULL);
+
+  // Reconfiguring with the same dimensions keeps the entries
+  TESTASSERT(srsran_sequence_rs_cache_init(&cache, 20, 14, 600) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_sequence_rs_cache_get(&cache, 19, 13, 5678) == r);
+  TESTASSERT(srsran_sequence_rs_cache_init(&cache, 10, 14, 300) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_sequence_rs_cache_get(&cache, 19, 13, 5678) == NULL);
+
+  srsran_sequence_rs_cache_free(&cache);
+
   return SRSRAN_SUCCESS;
 }
 
@@ -218,7 +336,7 @@ int main(int argc, char** argv)
     return SRSRAN_ERROR;
   }
 
-  printf("%8s; %8s; %8s; %8s; %8s; %8s; %8s; %8s; %8s;\n",
+  printf("%8s; %8s; %8s; %8s; %8s; %8s; %8s; %8s; %8s; %8s;\n",
          "seed",
          "length",
          "GEN",
@@ -227,15 +345,29 @@ int main(int argc, char** argv)
          "XOR 8",
          "XOR Unpack",
          "XOR Pack",
+         "GEN Pack",
          "Passed");
 
+  int ret = SRSRAN_SUCCESS;
   for (uint32_t length = min_length; length <= max_length; length = (length * 5) / 4) {
-    test_sequence(&sequence, (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX), length, repetitions);
+    if (test_sequence(
+            &sequence, (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX), length, repetitions) !=
+        SRSRAN_SUCCESS) {
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  if (test_cache() != SRSRAN_SUCCESS) {
+    ret = SRSRAN_ERROR;
+  }
+
+  if (test_rs_cache() != SRSRAN_SUCCESS) {
+    ret = SRSRAN_ERROR;
   }
 
   // Free sequence object
   srsran_sequence_free(&sequence);
   srsran_random_free(random_gen);
 
-  return SRSRAN_SUCCESS;
+  return ret;
 }
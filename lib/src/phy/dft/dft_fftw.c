@@ -27,6 +27,7 @@
 #include <string.h>
 #include <unistd.h>
 
+#include "dft_radix.h"
 #include "srsran/phy/dft/dft.h"
 #include "srsran/phy/utils/vector.h"
 
@@ -53,56 +54,253 @@ static int get_fftw_wisdom_file(char* full_path, uint32_t n)
 
 static pthread_mutex_t fft_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-// This function is called in the beggining of any executable where it is linked
-__attribute__((constructor)) static void srsran_dft_load()
+static srsran_dft_backend_t dft_backend = SRSRAN_DFT_BACKEND_FFTW;
+
+void srsran_dft_set_backend(srsran_dft_backend_t backend)
+{
+  if (backend < SRSRAN_DFT_BACKEND_NOF) {
+    dft_backend = backend;
+  }
+}
+
+srsran_dft_backend_t srsran_dft_get_backend()
+{
+  return dft_backend;
+}
+
+const char* srsran_dft_backend_to_string(srsran_dft_backend_t backend)
+{
+  switch (backend) {
+    case SRSRAN_DFT_BACKEND_FFTW:
+      return "fftw";
+    case SRSRAN_DFT_BACKEND_RADIX:
+      return "radix";
+    default:
+      break;
+  }
+  return "invalid";
+}
+
+int srsran_dft_backend_from_string(const char* str, srsran_dft_backend_t* backend)
+{
+  if (str == NULL || backend == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (int i = 0; i < SRSRAN_DFT_BACKEND_NOF; i++) {
+    if (strcasecmp(str, srsran_dft_backend_to_string((srsran_dft_backend_t)i)) == 0) {
+      *backend = (srsran_dft_backend_t)i;
+      return SRSRAN_SUCCESS;
+    }
+  }
+  return SRSRAN_ERROR;
+}
+
+// Creates a complex plan with the selected backend if it is not FFTW and supports the size. Returns NULL otherwise.
+static void* backend_plan_c(int dft_points, srsran_dft_dir_t dir)
+{
+  if (dft_backend != SRSRAN_DFT_BACKEND_RADIX) {
+    return NULL;
+  }
+
+  srsran_dft_radix_t* radix = calloc(1, sizeof(srsran_dft_radix_t));
+  if (radix == NULL) {
+    return NULL;
+  }
+  if (srsran_dft_radix_init(radix, (uint32_t)dft_points, dir == SRSRAN_DFT_FORWARD) < SRSRAN_SUCCESS) {
+    free(radix);
+    return NULL;
+  }
+  return radix;
+}
+
+/* FFTW plans are shared by all the srsran_dft_plan_t computing the same transform, as the eNB and UE workers create the
+ * same plans for every port and carrier. Shared plans are always executed with the new-array interface, on buffers
+ * with the same alignment and placement as the ones they were planned with. */
+#define DFT_MAX_SHARED_PLANS 256
+
+typedef struct {
+  fftwf_plan        p;
+  uint32_t          count; // Number of srsran_dft_plan_t using the plan, 0 if the entry is free
+  srsran_dft_mode_t mode;
+  int               sign; // FFTW sign for complex transforms, kind for real ones
+  fftwf_iodim       iodim;
+  fftwf_iodim       howmany;
+  int               in_align;
+  int               out_align;
+  bool              in_place;
+} dft_shared_plan_t;
+
+static dft_shared_plan_t dft_shared_plans[DFT_MAX_SHARED_PLANS];
+
+static bool iodim_equal(const fftwf_iodim* a, const fftwf_iodim* b)
+{
+  return a->n == b->n && a->is == b->is && a->os == b->os;
+}
+
+// Returns an FFTW plan for the transform, created only if no other plan computes it. Requires fft_mutex locked.
+static fftwf_plan
+shared_plan_get(srsran_dft_mode_t mode, int sign, fftwf_iodim iodim, fftwf_iodim howmany, void* in, void* out)
+{
+  dft_shared_plan_t key = {};
+  key.mode              = mode;
+  key.sign              = sign;
+  key.iodim             = iodim;
+  key.howmany           = howmany;
+  key.in_align          = fftwf_alignment_of(in);
+  key.out_align         = fftwf_alignment_of(out);
+  key.in_place          = (in == out);
+
+  dft_shared_plan_t* free_entry = NULL;
+  for (uint32_t i = 0; i < DFT_MAX_SHARED_PLANS; i++) {
+    dft_shared_plan_t* e = &dft_shared_plans[i];
+    if (e->count == 0) {
+      free_entry = free_entry ? free_entry : e;
+      continue;
+    }
+    if (e->mode == key.mode && e->sign == key.sign && iodim_equal(&e->iodim, &key.iodim) &&
+        iodim_equal(&e->howmany, &key.howmany) && e->in_align == key.in_align && e->out_align == key.out_align &&
+        e->in_place == key.in_place) {
+      e->count++;
+      return e->p;
+    }
+  }
+
+  fftwf_plan p = NULL;
+  if (mode == SRSRAN_REAL) {
+    p = fftwf_plan_r2r_1d(iodim.n, in, out, (fftwf_r2r_kind)sign, FFTW_TYPE);
+  } else if (howmany.n == 1 && iodim.is == 1 && iodim.os == 1) {
+    p = fftwf_plan_dft_1d(iodim.n, in, out, sign, FFTW_TYPE);
+  } else {
+    p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany, in, out, sign, FFTW_TYPE);
+  }
+
+  // When all the entries are in use the plan is not shared
+  if (p != NULL && free_entry != NULL) {
+    *free_entry       = key;
+    free_entry->p     = p;
+    free_entry->count = 1;
+  }
+  return p;
+}
+
+static fftwf_plan shared_plan_get_1d(srsran_dft_mode_t mode, int sign, int dft_points, void* in, void* out)
+{
+  const fftwf_iodim iodim   = {dft_points, 1, 1};
+  const fftwf_iodim howmany = {1, 0, 0};
+  return shared_plan_get(mode, sign, iodim, howmany, in, out);
+}
+
+// Requires fft_mutex locked
+static void shared_plan_release(fftwf_plan p)
+{
+  for (uint32_t i = 0; i < DFT_MAX_SHARED_PLANS; i++) {
+    dft_shared_plan_t* e = &dft_shared_plans[i];
+    if (e->count > 0 && e->p == p) {
+      e->count--;
+      if (e->count == 0) {
+        fftwf_destroy_plan(p);
+        e->p = NULL;
+      }
+      return;
+    }
+  }
+  fftwf_destroy_plan(p);
+}
+
+// Destroys the plan of any backend, it must be called with fft_mutex locked
+static void destroy_plan(srsran_dft_plan_t* plan)
+{
+  if (plan->p == NULL) {
+    return;
+  }
+  if (plan->backend == SRSRAN_DFT_BACKEND_RADIX) {
+    srsran_dft_radix_free(plan->p);
+    free(plan->p);
+  } else {
+    shared_plan_release(plan->p);
+  }
+  plan->p = NULL;
+}
+
+static void execute_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
+{
+  if (plan->backend == SRSRAN_DFT_BACKEND_RADIX) {
+    srsran_dft_radix_run(plan->p, in, out);
+  } else {
+    fftwf_execute_dft(plan->p, (cf_t*)in, out);
+  }
+}
+
+int srsran_dft_import_wisdom(const char* filename)
 {
-#ifdef FFTW_WISDOM_FILE
-  char full_path[256];
-  get_fftw_wisdom_file(full_path, sizeof(full_path));
   // lockf needs a file descriptor open for writing, so this must be r+
-  FILE* fd = fopen(full_path, "r+");
+  FILE* fd = fopen(filename, "r+");
   if (fd == NULL) {
-    return;
+    return SRSRAN_ERROR;
   }
   if (lockf(fileno(fd), F_LOCK, 0) == -1) {
     perror("lockf()");
     fclose(fd);
-    return;
+    return SRSRAN_ERROR;
   }
-  fftwf_import_wisdom_from_file(fd);
+  pthread_mutex_lock(&fft_mutex);
+  int ret = fftwf_import_wisdom_from_file(fd) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+  pthread_mutex_unlock(&fft_mutex);
   if (lockf(fileno(fd), F_ULOCK, 0) == -1) {
     perror("u-lockf()");
     fclose(fd);
-    return;
+    return SRSRAN_ERROR;
   }
   fclose(fd);
-#else
-  printf("Warning: FFTW Wisdom file not defined\n");
-#endif
+  return ret;
 }
 
-// This function is called in the ending of any executable where it is linked
-__attribute__((destructor)) void srsran_dft_exit()
+int srsran_dft_export_wisdom(const char* filename)
 {
-#ifdef FFTW_WISDOM_FILE
-  char full_path[256];
-  get_fftw_wisdom_file(full_path, sizeof(full_path));
-  FILE* fd = fopen(full_path, "w");
+  FILE* fd = fopen(filename, "w");
   if (fd == NULL) {
-    return;
+    return SRSRAN_ERROR;
   }
   if (lockf(fileno(fd), F_LOCK, 0) == -1) {
     perror("lockf()");
     fclose(fd);
-    return;
+    return SRSRAN_ERROR;
   }
+  pthread_mutex_lock(&fft_mutex);
   fftwf_export_wisdom_to_file(fd);
+  pthread_mutex_unlock(&fft_mutex);
   if (lockf(fileno(fd), F_ULOCK, 0) == -1) {
     perror("u-lockf()");
     fclose(fd);
-    return;
+    return SRSRAN_ERROR;
   }
   fclose(fd);
+  return SRSRAN_SUCCESS;
+}
+
+// This function is called in the beggining of any executable where it is linked
+__attribute__((constructor)) static void srsran_dft_load()
+{
+#ifdef FFTW_WISDOM_FILE
+  // The system wisdom (/etc/fftw/wisdomf) is where a bundle shared by all the users is installed
+  fftwf_import_system_wisdom();
+
+  char full_path[256];
+  get_fftw_wisdom_file(full_path, sizeof(full_path));
+  srsran_dft_import_wisdom(full_path);
+#else
+  printf("Warning: FFTW Wisdom file not defined\n");
+#endif
+}
+
+// This function is called in the ending of any executable where it is linked
+__attribute__((destructor)) void srsran_dft_exit()
+{
+#ifdef FFTW_WISDOM_FILE
+  char full_path[256];
+  get_fftw_wisdom_file(full_path, sizeof(full_path));
+  srsran_dft_export_wisdom(full_path);
 #endif
   fftwf_cleanup();
 }
@@ -159,17 +357,27 @@ int srsran_dft_replan_guru_c(srsran_dft_plan_t* plan,
   pthread_mutex_lock(&fft_mutex);
 
   /* Destroy current plan */
-  fftwf_destroy_plan(plan->p);
+  destroy_plan(plan);
 
-  plan->p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+  // Only FFTW supports strided transforms
+  plan->p       = (istride == 1 && ostride == 1) ? backend_plan_c(new_dft_points, plan->dir) : NULL;
+  plan->backend = plan->p ? dft_backend : SRSRAN_DFT_BACKEND_FFTW;
+  if (!plan->p) {
+    plan->p = shared_plan_get(SRSRAN_DFT_COMPLEX, sign, iodim, howmany_dims, in_buffer, out_buffer);
+  }
 
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
     return -1;
   }
-  plan->size      = new_dft_points;
-  plan->init_size = plan->size;
+  plan->size          = new_dft_points;
+  plan->init_size     = plan->size;
+  plan->guru_in       = in_buffer;
+  plan->guru_out      = out_buffer;
+  plan->guru_how_many = how_many;
+  plan->guru_idist    = idist;
+  plan->guru_odist    = odist;
 
   return 0;
 }
@@ -184,11 +392,12 @@ int srsran_dft_replan_c(srsran_dft_plan_t* plan, const int new_dft_points)
   }
 
   pthread_mutex_lock(&fft_mutex);
-  if (plan->p) {
-    fftwf_destroy_plan(plan->p);
-    plan->p = NULL;
+  destroy_plan(plan);
+  plan->p       = backend_plan_c(new_dft_points, plan->dir);
+  plan->backend = plan->p ? dft_backend : SRSRAN_DFT_BACKEND_FFTW;
+  if (!plan->p) {
+    plan->p = shared_plan_get_1d(SRSRAN_DFT_COMPLEX, sign, new_dft_points, plan->in, plan->out);
   }
-  plan->p = fftwf_plan_dft_1d(new_dft_points, plan->in, plan->out, sign, FFTW_TYPE);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -216,13 +425,24 @@ int srsran_dft_plan_guru_c(srsran_dft_plan_t* plan,
 
   pthread_mutex_lock(&fft_mutex);
 
-  plan->p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+  // Only FFTW supports strided transforms
+  plan->p       = (istride == 1 && ostride == 1) ? backend_plan_c(dft_points, dir) : NULL;
+  plan->backend = plan->p ? dft_backend : SRSRAN_DFT_BACKEND_FFTW;
+  if (!plan->p) {
+    plan->p = shared_plan_get(SRSRAN_DFT_COMPLEX, sign, iodim, howmany_dims, in_buffer, out_buffer);
+  }
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
     return -1;
   }
 
+  plan->guru_in       = in_buffer;
+  plan->guru_out      = out_buffer;
+  plan->guru_how_many = how_many;
+  plan->guru_idist    = idist;
+  plan->guru_odist    = odist;
+
   plan->size      = dft_points;
   plan->init_size = plan->size;
   plan->mode      = SRSRAN_DFT_COMPLEX;
@@ -243,8 +463,12 @@ int srsran_dft_plan_c(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_
 
   pthread_mutex_lock(&fft_mutex);
 
-  int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
-  plan->p  = fftwf_plan_dft_1d(dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  int sign      = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
+  plan->p       = backend_plan_c(dft_points, dir);
+  plan->backend = plan->p ? dft_backend : SRSRAN_DFT_BACKEND_FFTW;
+  if (!plan->p) {
+    plan->p = shared_plan_get_1d(SRSRAN_DFT_COMPLEX, sign, dft_points, plan->in, plan->out);
+  }
 
   pthread_mutex_unlock(&fft_mutex);
 
@@ -270,11 +494,8 @@ int srsran_dft_replan_r(srsran_dft_plan_t* plan, const int new_dft_points)
   int sign = (plan->dir == SRSRAN_DFT_FORWARD) ? FFTW_R2HC : FFTW_HC2R;
 
   pthread_mutex_lock(&fft_mutex);
-  if (plan->p) {
-    fftwf_destroy_plan(plan->p);
-    plan->p = NULL;
-  }
-  plan->p = fftwf_plan_r2r_1d(new_dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  destroy_plan(plan);
+  plan->p = shared_plan_get_1d(SRSRAN_REAL, sign, new_dft_points, plan->in, plan->out);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -287,10 +508,11 @@ int srsran_dft_replan_r(srsran_dft_plan_t* plan, const int new_dft_points)
 int srsran_dft_plan_r(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_dir_t dir)
 {
   allocate(plan, sizeof(float), sizeof(float), dft_points);
-  int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_R2HC : FFTW_HC2R;
+  int sign      = (dir == SRSRAN_DFT_FORWARD) ? FFTW_R2HC : FFTW_HC2R;
+  plan->backend = SRSRAN_DFT_BACKEND_FFTW;
 
   pthread_mutex_lock(&fft_mutex);
-  plan->p = fftwf_plan_r2r_1d(dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  plan->p = shared_plan_get_1d(SRSRAN_REAL, sign, dft_points, plan->in, plan->out);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -362,7 +584,7 @@ void srsran_dft_run(srsran_dft_plan_t* plan, const void* in, void* out)
 
 void srsran_dft_run_c_zerocopy(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
 {
-  fftwf_execute_dft(plan->p, (cf_t*)in, out);
+  execute_c(plan, in, out);
 }
 
 void srsran_dft_run_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
@@ -372,7 +594,7 @@ void srsran_dft_run_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
   fftwf_complex* f_out = plan->out;
 
   copy_pre((uint8_t*)plan->in, (uint8_t*)in, sizeof(cf_t), plan->size, plan->forward, plan->mirror, plan->dc);
-  fftwf_execute(plan->p);
+  execute_c(plan, plan->in, plan->out);
   if (plan->norm) {
     norm = 1.0 / sqrtf(plan->size);
     srsran_vec_sc_prod_cfc(f_out, norm, f_out, plan->size);
@@ -387,8 +609,12 @@ void srsran_dft_run_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
 
 void srsran_dft_run_guru_c(srsran_dft_plan_t* plan)
 {
-  if (plan->is_guru == true) {
-    fftwf_execute(plan->p);
+  if (plan->is_guru == true && plan->backend != SRSRAN_DFT_BACKEND_FFTW) {
+    for (int i = 0; i < plan->guru_how_many; i++) {
+      execute_c(plan, &plan->guru_in[i * plan->guru_idist], &plan->guru_out[i * plan->guru_odist]);
+    }
+  } else if (plan->is_guru == true) {
+    fftwf_execute_dft(plan->p, plan->guru_in, plan->guru_out);
   } else {
     ERROR("srsran_dft_run_guru_c: the selected plan is not guru!");
   }
@@ -402,7 +628,7 @@ void srsran_dft_run_r(srsran_dft_plan_t* plan, const float* in, float* out)
   float* f_out = plan->out;
 
   memcpy(plan->in, in, sizeof(float) * plan->size);
-  fftwf_execute(plan->p);
+  fftwf_execute_r2r(plan->p, plan->in, plan->out);
   if (plan->norm) {
     norm = 1.0 / plan->size;
     srsran_vec_sc_prod_fff(f_out, norm, f_out, plan->size);
@@ -429,8 +655,7 @@ void srsran_dft_plan_free(srsran_dft_plan_t* plan)
     if (plan->out)
       fftwf_free(plan->out);
   }
-  if (plan->p)
-    fftwf_destroy_plan(plan->p);
+  destroy_plan(plan);
   pthread_mutex_unlock(&fft_mutex);
   bzero(plan, sizeof(srsran_dft_plan_t));
 }
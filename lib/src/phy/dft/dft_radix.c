@@ -0,0 +1,403 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "dft_radix.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/srsran.h"
+#include <complex.h>
+#include <math.h>
+#include <string.h>
+
+/*
+ * The transform is a Stockham auto-sort decimation in frequency. Stage k splits the remaining sub-transforms of
+ * length n = m * radix into radix interleaved sub-transforms of length m, so no bit reversal is needed. The inputs
+ * of a butterfly are s samples apart consecutive in memory, hence the butterflies of the s sub-transforms are
+ * computed in SIMD registers once s reaches the SIMD width.
+ */
+
+#define DFT_RADIX_SIN_3 0.86602540378443864676f // sin(2 * pi / 3)
+#define DFT_RADIX_COS_5_1 0.30901699437494742410f // cos(2 * pi / 5)
+#define DFT_RADIX_COS_5_2 -0.80901699437494742410f // cos(4 * pi / 5)
+#define DFT_RADIX_SIN_5_1 0.95105651629515357212f // sin(2 * pi / 5)
+#define DFT_RADIX_SIN_5_2 0.58778525229247312917f // sin(4 * pi / 5)
+
+static inline cf_t dft_radix_mulj(cf_t a, float sign)
+{
+  cf_t ret;
+  __real__ ret = -sign * __imag__ a;
+  __imag__ ret = sign * __real__ a;
+  return ret;
+}
+
+static inline cf_t dft_radix_prod(cf_t a, cf_t b)
+{
+  cf_t ret;
+  __real__ ret = __real__ a * __real__ b - __imag__ a * __imag__ b;
+  __imag__ ret = __real__ a * __imag__ b + __imag__ a * __real__ b;
+  return ret;
+}
+
+// In place DFT of length radix, sign is -1 for the forward transform and +1 for the backward
+static inline void dft_radix_bfly(uint32_t radix, cf_t* a, float sign)
+{
+  switch (radix) {
+    case 2: {
+      cf_t t = a[0] - a[1];
+      a[0] += a[1];
+      a[1] = t;
+    } break;
+    case 3: {
+      cf_t t1 = a[1] + a[2];
+      cf_t t2 = dft_radix_mulj(a[1] - a[2], sign * DFT_RADIX_SIN_3);
+      cf_t m  = a[0] - 0.5f * t1;
+      a[0] += t1;
+      a[1] = m + t2;
+      a[2] = m - t2;
+    } break;
+    case 4: {
+      cf_t t0 = a[0] + a[2];
+      cf_t t1 = a[0] - a[2];
+      cf_t t2 = a[1] + a[3];
+      cf_t t3 = dft_radix_mulj(a[1] - a[3], sign);
+      a[0]    = t0 + t2;
+      a[1]    = t1 + t3;
+      a[2]    = t0 - t2;
+      a[3]    = t1 - t3;
+    } break;
+    case 5: {
+      cf_t t1 = a[1] + a[4];
+      cf_t t2 = a[2] + a[3];
+      cf_t t3 = a[1] - a[4];
+      cf_t t4 = a[2] - a[3];
+      cf_t m1 = a[0] + DFT_RADIX_COS_5_1 * t1 + DFT_RADIX_COS_5_2 * t2;
+      cf_t m2 = a[0] + DFT_RADIX_COS_5_2 * t1 + DFT_RADIX_COS_5_1 * t2;
+      cf_t n1 = dft_radix_mulj(DFT_RADIX_SIN_5_1 * t3 + DFT_RADIX_SIN_5_2 * t4, sign);
+      cf_t n2 = dft_radix_mulj(DFT_RADIX_SIN_5_2 * t3 - DFT_RADIX_SIN_5_1 * t4, sign);
+      a[0] += t1 + t2;
+      a[1] = m1 + n1;
+      a[2] = m2 + n2;
+      a[3] = m2 - n2;
+      a[4] = m1 - n1;
+    } break;
+    default:
+      break;
+  }
+}
+
+#if SRSRAN_SIMD_CF_SIZE
+static inline simd_cf_t dft_radix_simd_mulj(simd_cf_t a, float sign)
+{
+  return srsran_simd_cf_mul(srsran_simd_cf_mulj(a), srsran_simd_f_set1(sign));
+}
+
+static inline simd_cf_t dft_radix_simd_axpy(simd_cf_t y, float a, simd_cf_t x)
+{
+  return srsran_simd_cf_add(y, srsran_simd_cf_mul(x, srsran_simd_f_set1(a)));
+}
+
+static inline void dft_radix_simd_bfly(uint32_t radix, simd_cf_t* a, float sign)
+{
+  switch (radix) {
+    case 2: {
+      simd_cf_t t = srsran_simd_cf_sub(a[0], a[1]);
+      a[0]        = srsran_simd_cf_add(a[0], a[1]);
+      a[1]        = t;
+    } break;
+    case 3: {
+      simd_cf_t t1 = srsran_simd_cf_add(a[1], a[2]);
+      simd_cf_t t2 = dft_radix_simd_mulj(srsran_simd_cf_sub(a[1], a[2]), sign * DFT_RADIX_SIN_3);
+      simd_cf_t m  = dft_radix_simd_axpy(a[0], -0.5f, t1);
+      a[0]         = srsran_simd_cf_add(a[0], t1);
+      a[1]         = srsran_simd_cf_add(m, t2);
+      a[2]         = srsran_simd_cf_sub(m, t2);
+    } break;
+    case 4: {
+      simd_cf_t t0 = srsran_simd_cf_add(a[0], a[2]);
+      simd_cf_t t1 = srsran_simd_cf_sub(a[0], a[2]);
+      simd_cf_t t2 = srsran_simd_cf_add(a[1], a[3]);
+      simd_cf_t t3 = dft_radix_simd_mulj(srsran_simd_cf_sub(a[1], a[3]), sign);
+      a[0]         = srsran_simd_cf_add(t0, t2);
+      a[1]         = srsran_simd_cf_add(t1, t3);
+      a[2]         = srsran_simd_cf_sub(t0, t2);
+      a[3]         = srsran_simd_cf_sub(t1, t3);
+    } break;
+    case 5: {
+      simd_cf_t t1 = srsran_simd_cf_add(a[1], a[4]);
+      simd_cf_t t2 = srsran_simd_cf_add(a[2], a[3]);
+      simd_cf_t t3 = srsran_simd_cf_sub(a[1], a[4]);
+      simd_cf_t t4 = srsran_simd_cf_sub(a[2], a[3]);
+      simd_cf_t m1 = dft_radix_simd_axpy(dft_radix_simd_axpy(a[0], DFT_RADIX_COS_5_1, t1), DFT_RADIX_COS_5_2, t2);
+      simd_cf_t m2 = dft_radix_simd_axpy(dft_radix_simd_axpy(a[0], DFT_RADIX_COS_5_2, t1), DFT_RADIX_COS_5_1, t2);
+      simd_cf_t n1 = dft_radix_simd_axpy(srsran_simd_cf_mul(t3, srsran_simd_f_set1(DFT_RADIX_SIN_5_1)),
+                                         DFT_RADIX_SIN_5_2,
+                                         t4);
+      simd_cf_t n2 = dft_radix_simd_axpy(srsran_simd_cf_mul(t3, srsran_simd_f_set1(DFT_RADIX_SIN_5_2)),
+                                         -DFT_RADIX_SIN_5_1,
+                                         t4);
+      n1           = dft_radix_simd_mulj(n1, sign);
+      n2           = dft_radix_simd_mulj(n2, sign);
+      a[0]         = srsran_simd_cf_add(a[0], srsran_simd_cf_add(t1, t2));
+      a[1]         = srsran_simd_cf_add(m1, n1);
+      a[2]         = srsran_simd_cf_add(m2, n2);
+      a[3]         = srsran_simd_cf_sub(m2, n2);
+      a[4]         = srsran_simd_cf_sub(m1, n1);
+    } break;
+    default:
+      break;
+  }
+}
+#endif // SRSRAN_SIMD_CF_SIZE
+
+// Always inlined with a constant radix, so the butterfly loops are unrolled for each radix
+static inline __attribute__((always_inline)) void
+dft_radix_stage_run_(const srsran_dft_radix_stage_t* st, const uint32_t radix, float sign, const cf_t* x, cf_t* y)
+{
+  uint32_t m = st->m;
+  uint32_t s = st->s;
+
+#if SRSRAN_SIMD_CF_SIZE
+  // Few sub-transforms, the SIMD registers take consecutive butterflies of all the sub-transforms. The inputs are
+  // contiguous but the outputs of each butterfly are s samples long chunks radix * s samples apart.
+  if (st->tw_simd != NULL) {
+    uint32_t                 ms = m * s;
+    srsran_simd_aligned cf_t tmp[SRSRAN_SIMD_CF_SIZE];
+    for (uint32_t t = 0; t < ms; t += SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t a[5];
+      for (uint32_t k = 0; k < radix; k++) {
+        a[k] = srsran_simd_cfi_loadu(&x[t + k * ms]);
+      }
+
+      dft_radix_simd_bfly(radix, a, sign);
+
+      for (uint32_t j = 0; j < radix; j++) {
+        if (j > 0) {
+          a[j] = srsran_simd_cf_prod(a[j], srsran_simd_cfi_load(&st->tw_simd[(j - 1) * ms + t]));
+        }
+        srsran_simd_cfi_store(tmp, a[j]);
+        for (uint32_t i = 0; i < SRSRAN_SIMD_CF_SIZE; i += s) {
+          cf_t* dst = &y[s * (radix * ((t + i) / s) + j)];
+          for (uint32_t l = 0; l < s; l++) {
+            dst[l] = tmp[i + l];
+          }
+        }
+      }
+    }
+    return;
+  }
+#endif // SRSRAN_SIMD_CF_SIZE
+
+  for (uint32_t p = 0; p < m; p++) {
+    const cf_t* w = &st->tw[p * (radix - 1)];
+    uint32_t    q = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+    if (s >= SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t simd_w[4];
+      for (uint32_t j = 1; j < radix; j++) {
+        simd_w[j - 1] = srsran_simd_cf_set1(w[j - 1]);
+      }
+
+      for (; q + SRSRAN_SIMD_CF_SIZE <= s; q += SRSRAN_SIMD_CF_SIZE) {
+        simd_cf_t a[5];
+        for (uint32_t k = 0; k < radix; k++) {
+          a[k] = srsran_simd_cfi_loadu(&x[q + s * (p + k * m)]);
+        }
+
+        dft_radix_simd_bfly(radix, a, sign);
+
+        srsran_simd_cfi_storeu(&y[q + s * radix * p], a[0]);
+        for (uint32_t j = 1; j < radix; j++) {
+          srsran_simd_cfi_storeu(&y[q + s * (radix * p + j)], srsran_simd_cf_prod(a[j], simd_w[j - 1]));
+        }
+      }
+    }
+#endif // SRSRAN_SIMD_CF_SIZE
+
+    for (; q < s; q++) {
+      cf_t a[5];
+      for (uint32_t k = 0; k < radix; k++) {
+        a[k] = x[q + s * (p + k * m)];
+      }
+
+      dft_radix_bfly(radix, a, sign);
+
+      y[q + s * radix * p] = a[0];
+      for (uint32_t j = 1; j < radix; j++) {
+        y[q + s * (radix * p + j)] = dft_radix_prod(a[j], w[j - 1]);
+      }
+    }
+  }
+}
+
+static void dft_radix_stage_run(const srsran_dft_radix_stage_t* st, float sign, const cf_t* x, cf_t* y)
+{
+  switch (st->radix) {
+    case 2:
+      dft_radix_stage_run_(st, 2, sign, x, y);
+      break;
+    case 3:
+      dft_radix_stage_run_(st, 3, sign, x, y);
+      break;
+    case 4:
+      dft_radix_stage_run_(st, 4, sign, x, y);
+      break;
+    case 5:
+      dft_radix_stage_run_(st, 5, sign, x, y);
+      break;
+    default:
+      break;
+  }
+}
+
+int srsran_dft_radix_init(srsran_dft_radix_t* q, uint32_t size, bool forward)
+{
+  if (q == NULL || size == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  bzero(q, sizeof(srsran_dft_radix_t));
+
+  // Factorise the size: as many radix 4 as possible, then 2, 3 and 5
+  uint32_t radices[SRSRAN_DFT_RADIX_MAX_STAGES];
+  uint32_t nof_stages = 0;
+  uint32_t n          = size;
+  while (n > 1 && nof_stages < SRSRAN_DFT_RADIX_MAX_STAGES) {
+    if (n % 4 == 0) {
+      radices[nof_stages++] = 4;
+      n /= 4;
+    } else if (n % 2 == 0) {
+      radices[nof_stages++] = 2;
+      n /= 2;
+    } else if (n % 3 == 0) {
+      radices[nof_stages++] = 3;
+      n /= 3;
+    } else if (n % 5 == 0) {
+      radices[nof_stages++] = 5;
+      n /= 5;
+    } else {
+      return SRSRAN_ERROR;
+    }
+  }
+  if (n != 1) {
+    return SRSRAN_ERROR;
+  }
+
+  q->size       = size;
+  q->forward    = forward;
+  q->nof_stages = nof_stages;
+
+  double sign = forward ? -1.0 : 1.0;
+  uint32_t len  = size; // Length of the sub-transforms processed by the stage
+  uint32_t s    = 1;
+  for (uint32_t i = 0; i < nof_stages; i++) {
+    srsran_dft_radix_stage_t* st = &q->stages[i];
+    st->radix                    = radices[i];
+    st->m                        = len / st->radix;
+    st->s                        = s;
+    st->tw                       = srsran_vec_cf_malloc(SRSRAN_MAX(1, st->m * (st->radix - 1)));
+    if (st->tw == NULL) {
+      srsran_dft_radix_free(q);
+      return SRSRAN_ERROR;
+    }
+
+    for (uint32_t p = 0; p < st->m; p++) {
+      for (uint32_t j = 1; j < st->radix; j++) {
+        double arg                           = sign * 2.0 * M_PI * (double)(j * p) / (double)len;
+        st->tw[p * (st->radix - 1) + j - 1] = (float)cos(arg) + _Complex_I * (float)sin(arg);
+      }
+    }
+
+#if SRSRAN_SIMD_CF_SIZE
+    if (s < SRSRAN_SIMD_CF_SIZE && SRSRAN_SIMD_CF_SIZE % s == 0 && (st->m * s) % SRSRAN_SIMD_CF_SIZE == 0) {
+      st->tw_simd = srsran_vec_cf_malloc(st->m * s * (st->radix - 1));
+      if (st->tw_simd == NULL) {
+        srsran_dft_radix_free(q);
+        return SRSRAN_ERROR;
+      }
+      for (uint32_t j = 1; j < st->radix; j++) {
+        for (uint32_t t = 0; t < st->m * s; t++) {
+          st->tw_simd[(j - 1) * st->m * s + t] = st->tw[(t / s) * (st->radix - 1) + j - 1];
+        }
+      }
+    }
+#endif // SRSRAN_SIMD_CF_SIZE
+
+    len /= st->radix;
+    s *= st->radix;
+  }
+
+  for (uint32_t i = 0; i < 2; i++) {
+    q->buffer[i] = srsran_vec_cf_malloc(size);
+    if (q->buffer[i] == NULL) {
+      srsran_dft_radix_free(q);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_dft_radix_free(srsran_dft_radix_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < SRSRAN_DFT_RADIX_MAX_STAGES; i++) {
+    if (q->stages[i].tw) {
+      free(q->stages[i].tw);
+    }
+    if (q->stages[i].tw_simd) {
+      free(q->stages[i].tw_simd);
+    }
+  }
+  for (uint32_t i = 0; i < 2; i++) {
+    if (q->buffer[i]) {
+      free(q->buffer[i]);
+    }
+  }
+  bzero(q, sizeof(srsran_dft_radix_t));
+}
+
+void srsran_dft_radix_run(srsran_dft_radix_t* q, const cf_t* in, cf_t* out)
+{
+  float sign = q->forward ? -1.0f : 1.0f;
+
+  if (q->nof_stages == 0) {
+    out[0] = in[0];
+    return;
+  }
+
+  // The stages alternate between the internal buffers, the first one reads the input and the last one writes the
+  // output. A single stage transform is run out of place in case the input and output are the same buffer.
+  const cf_t* x = in;
+  for (uint32_t i = 0; i < q->nof_stages; i++) {
+    bool  last = (i == q->nof_stages - 1) && (q->nof_stages > 1 || in != out);
+    cf_t* y    = last ? out : q->buffer[i % 2];
+    dft_radix_stage_run(&q->stages[i], sign, x, y);
+    x = y;
+  }
+
+  if (x != out) {
+    srsran_vec_cf_copy(out, x, q->size);
+  }
+}
@@ -0,0 +1,63 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         dft_radix.h
+ *  Description:  Native mixed radix (2, 3, 4 and 5) complex DFT engine used as
+ *                an alternative to FFTW. It covers every LTE and NR symbol
+ *                size, other sizes are left to FFTW.
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_DFT_RADIX_H
+#define SRSRAN_DFT_RADIX_H
+
+#include "srsran/config.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SRSRAN_DFT_RADIX_MAX_STAGES 32
+
+typedef struct {
+  uint32_t radix;
+  uint32_t m;  // Number of butterflies, length of the stage divided by the radix
+  uint32_t s;  // Stride between the butterfly inputs of consecutive sub-transforms
+  cf_t*    tw; // Twiddle factors, radix - 1 for each butterfly
+  cf_t*    tw_simd; // Twiddle factors repeated s times, for the stages vectorised across butterflies
+} srsran_dft_radix_stage_t;
+
+typedef struct {
+  uint32_t                 size;
+  bool                     forward;
+  uint32_t                 nof_stages;
+  srsran_dft_radix_stage_t stages[SRSRAN_DFT_RADIX_MAX_STAGES];
+  cf_t*                    buffer[2];
+} srsran_dft_radix_t;
+
+/* Returns SRSRAN_ERROR if the size has other prime factors than 2, 3 and 5 */
+int srsran_dft_radix_init(srsran_dft_radix_t* q, uint32_t size, bool forward);
+
+void srsran_dft_radix_free(srsran_dft_radix_t* q);
+
+/* Unnormalized transform with FFTW sign convention, in and out may be the same buffer */
+void srsran_dft_radix_run(srsran_dft_radix_t* q, const cf_t* in, cf_t* out);
+
+#endif // SRSRAN_DFT_RADIX_H
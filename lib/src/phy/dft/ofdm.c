@@ -354,6 +354,15 @@ int srsran_ofdm_tx_set_prb(srsran_ofdm_t* q, srsran_cp_t cp, uint32_t nof_prb)
   return ofdm_init_mbsfn_(q, &cfg, SRSRAN_DFT_BACKWARD);
 }
 
+void srsran_ofdm_set_rx_cfo(srsran_ofdm_t* q, float cfo)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  q->rx_cfo = cfo;
+}
+
 int srsran_ofdm_set_phase_compensation(srsran_ofdm_t* q, double center_freq_hz)
 {
   // Validate pointer
@@ -468,56 +477,128 @@ void srsran_ofdm_rx_slot_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output)
   }
 }
 
+#ifndef AVOID_GURU
+static void ofdm_rx_slot_demap(srsran_ofdm_t* q, int slot_in_sf, uint32_t first_symbol, uint32_t nof_symbols);
+#endif
+
+/* The CFO is corrected symbol by symbol unless the subframe is MBSFN, which is rotated as a whole */
+static inline bool ofdm_rx_cfo_per_symbol(const srsran_ofdm_t* q)
+{
+  return isnormal(q->rx_cfo) && !q->mbsfn_subframe;
+}
+
+/* Index of the first sample of the DFT window of a symbol within the subframe */
+static uint32_t ofdm_rx_symbol_start(const srsran_ofdm_t* q, uint32_t slot_in_sf, uint32_t symbol_idx)
+{
+  uint32_t    symbol_sz = q->cfg.symbol_sz;
+  srsran_cp_t cp        = q->cfg.cp;
+  uint32_t    n         = slot_in_sf * q->slot_sz + symbol_idx * symbol_sz;
+  for (uint32_t i = 0; i <= symbol_idx; i++) {
+    n += SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+  }
+  return n - q->window_offset_n;
+}
+
+/* Phase of the CFO rotation at a sample of the subframe, the rotation of every window starts with a zero phase */
+static cf_t ofdm_rx_cfo_phase(const srsran_ofdm_t* q, uint32_t n)
+{
+  return (cf_t)cexp(I * 2.0 * M_PI * fmod((double)q->rx_cfo * (double)n, 1.0));
+}
+
+/* Rotates in place the DFT windows of a slot, skipping the cyclic prefixes */
+static void ofdm_rx_slot_cfo(srsran_ofdm_t* q, cf_t* input, uint32_t slot_in_sf)
+{
+  for (uint32_t i = 0; i < q->nof_symbols; i++) {
+    cf_t* ptr = &input[ofdm_rx_symbol_start(q, slot_in_sf, i) - slot_in_sf * q->slot_sz];
+    srsran_vec_apply_cfo(ptr, q->rx_cfo, ptr, (int)q->cfg.symbol_sz);
+  }
+}
+
+/* Slot demodulation without Guru DFT, correcting the CFO of a subframe slot */
+static void ofdm_rx_slot_ng_cfo(srsran_ofdm_t* q, cf_t* input, cf_t* output, uint32_t slot_in_sf)
+{
+  if (ofdm_rx_cfo_per_symbol(q)) {
+    ofdm_rx_slot_cfo(q, input, slot_in_sf);
+  }
+
+  srsran_ofdm_rx_slot_ng(q, input, output);
+
+  if (ofdm_rx_cfo_per_symbol(q)) {
+    for (uint32_t i = 0; i < q->nof_symbols; i++) {
+      cf_t phase = ofdm_rx_cfo_phase(q, ofdm_rx_symbol_start(q, slot_in_sf, i));
+      srsran_vec_sc_prod_ccc(&output[i * q->nof_re], phase, &output[i * q->nof_re], q->nof_re);
+    }
+  }
+}
+
 /* Transforms input samples into output OFDM symbols.
  * Performs FFT on a each symbol and removes CP.
  */
 static void ofdm_rx_slot(srsran_ofdm_t* q, int slot_in_sf)
 {
 #ifdef AVOID_GURU
-  srsran_ofdm_rx_slot_ng(
-      q, q->cfg.in_buffer + slot_in_sf * q->slot_sz, q->cfg.out_buffer + slot_in_sf * q->nof_re * q->nof_symbols);
+  ofdm_rx_slot_ng_cfo(q,
+                      q->cfg.in_buffer + slot_in_sf * q->slot_sz,
+                      q->cfg.out_buffer + slot_in_sf * q->nof_re * q->nof_symbols,
+                      slot_in_sf);
 #else
-  uint32_t nof_symbols = q->nof_symbols;
+  if (ofdm_rx_cfo_per_symbol(q)) {
+    ofdm_rx_slot_cfo(q, q->cfg.in_buffer + slot_in_sf * q->slot_sz, slot_in_sf);
+  }
+  srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
+  ofdm_rx_slot_demap(q, slot_in_sf, 0, q->nof_symbols);
+#endif
+}
+
+#ifndef AVOID_GURU
+/* Maps the FFT outputs of a range of symbols of a slot, stored symbol after symbol in q->tmp, into the resource grid */
+static void ofdm_rx_slot_demap(srsran_ofdm_t* q, int slot_in_sf, uint32_t first_symbol, uint32_t nof_symbols)
+{
   uint32_t nof_re = q->nof_re;
-  cf_t* output = q->cfg.out_buffer + slot_in_sf * nof_re * nof_symbols;
+  cf_t* output = q->cfg.out_buffer + (slot_in_sf * q->nof_symbols + first_symbol) * nof_re;
   uint32_t symbol_sz = q->cfg.symbol_sz;
   float norm = 1.0f / sqrtf(q->fft_plan.size);
-  cf_t* tmp = q->tmp;
+  cf_t* tmp = q->tmp + first_symbol * symbol_sz;
   uint32_t dc = (q->fft_plan.dc) ? 1 : 0;
 
-  srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
-
-  for (int i = 0; i < q->nof_symbols; i++) {
-    // Apply frequency domain window offset
-    if (q->window_offset_n) {
-      srsran_vec_prod_ccc(tmp, q->window_offset_buffer, tmp, symbol_sz);
-    }
-
-    // Perform FFT shift
-    memcpy(output, tmp + symbol_sz - nof_re / 2, sizeof(cf_t) * nof_re / 2);
-    memcpy(output + nof_re / 2, &tmp[dc], sizeof(cf_t) * nof_re / 2);
-
-    // Normalize output
+  // The window offset, the phase compensation and the normalization are applied while the FFT shift copies the RE
+  // into the resource grid, so every subcarrier is read and written once
+  const cf_t* window = q->window_offset_n ? q->window_offset_buffer : NULL;
+  for (uint32_t i = first_symbol; i < first_symbol + nof_symbols; i++) {
+    cf_t scale     = 1.0f;
+    bool has_scale = false;
     if (isnormal(q->cfg.phase_compensation_hz)) {
-      // Get phase compensation
-      cf_t phase_compensation = conjf(q->phase_compensation[slot_in_sf * q->nof_symbols + i]);
+      scale     = conjf(q->phase_compensation[slot_in_sf * q->nof_symbols + i]);
+      has_scale = true;
+    }
+    if (q->fft_plan.norm) {
+      scale *= norm;
+      has_scale = true;
+    }
+    if (ofdm_rx_cfo_per_symbol(q)) {
+      scale *= ofdm_rx_cfo_phase(q, ofdm_rx_symbol_start(q, slot_in_sf, i));
+      has_scale = true;
+    }
 
-      // Apply normalization
-      if (q->fft_plan.norm) {
-        phase_compensation *= norm;
+    // Negative subcarriers are at the end of the FFT output, positive after the DC
+    const uint32_t half      = nof_re / 2;
+    const uint32_t offset[2] = {symbol_sz - half, dc};
+    for (uint32_t k = 0; k < 2; k++) {
+      cf_t* dst = output + k * half;
+      if (window != NULL) {
+        srsran_vec_prod_sc_ccc(&tmp[offset[k]], &window[offset[k]], scale, dst, half);
+      } else if (has_scale) {
+        srsran_vec_sc_prod_ccc(&tmp[offset[k]], scale, dst, half);
+      } else {
+        srsran_vec_cf_copy(dst, &tmp[offset[k]], half);
       }
-
-      // Apply correction
-      srsran_vec_sc_prod_ccc(output, phase_compensation, output, nof_re);
-    } else if (q->fft_plan.norm) {
-      srsran_vec_sc_prod_cfc(output, norm, output, nof_re);
     }
 
     tmp += symbol_sz;
     output += nof_re;
   }
-#endif
 }
+#endif
 
 static void ofdm_rx_slot_mbsfn(srsran_ofdm_t* q, cf_t* input, cf_t* output)
 {
@@ -553,6 +634,9 @@ void srsran_ofdm_rx_sf(srsran_ofdm_t* q)
   if (isnormal(q->cfg.freq_shift_f)) {
     srsran_vec_prod_ccc(q->cfg.in_buffer, q->shift_buffer, q->cfg.in_buffer, q->sf_sz);
   }
+  if (isnormal(q->rx_cfo) && q->mbsfn_subframe) {
+    srsran_vec_apply_cfo(q->cfg.in_buffer, q->rx_cfo, q->cfg.in_buffer, (int)q->sf_sz);
+  }
   if (!q->mbsfn_subframe) {
     for (uint32_t n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
       ofdm_rx_slot(q, n);
@@ -563,15 +647,107 @@ void srsran_ofdm_rx_sf(srsran_ofdm_t* q)
   }
 }
 
+int srsran_ofdm_rx_sf_sc16(srsran_ofdm_t* q, const int16_t* input, float scale)
+{
+  if (q == NULL || input == NULL || !isnormal(scale)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+#ifdef AVOID_GURU
+  ERROR("The sc16 OFDM demodulator requires the Guru DFT");
+  return SRSRAN_ERROR;
+#else
+  if (q->mbsfn_subframe) {
+    ERROR("The sc16 OFDM demodulator does not support MBSFN subframes");
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t    symbol_sz = q->cfg.symbol_sz;
+  srsran_cp_t cp        = q->cfg.cp;
+  bool        shift     = isnormal(q->cfg.freq_shift_f);
+
+  // The samples are converted symbol by symbol into the DFT plan input, so neither the CP nor a float copy of the
+  // subframe are ever written. The CFO is corrected on the converted symbol while it is still in cache
+  cf_t*    fft_in = q->fft_plan.in;
+  uint32_t n      = 0;
+  for (uint32_t slot = 0; slot < SRSRAN_NOF_SLOTS_PER_SF; slot++) {
+    cf_t* tmp = q->tmp;
+    for (uint32_t i = 0; i < q->nof_symbols; i++) {
+      n += SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+      uint32_t start = n - q->window_offset_n;
+      srsran_vec_convert_if(&input[2 * start], scale, (float*)fft_in, 2 * symbol_sz);
+      if (shift) {
+        srsran_vec_prod_ccc(fft_in, &q->shift_buffer[start], fft_in, symbol_sz);
+      }
+      if (isnormal(q->rx_cfo)) {
+        srsran_vec_apply_cfo(fft_in, q->rx_cfo, fft_in, (int)symbol_sz);
+      }
+      srsran_dft_run_c_zerocopy(&q->fft_plan, fft_in, tmp);
+      tmp += symbol_sz;
+      n += symbol_sz;
+    }
+    ofdm_rx_slot_demap(q, slot, 0, q->nof_symbols);
+  }
+
+  return SRSRAN_SUCCESS;
+#endif
+}
+
+int srsran_ofdm_rx_sf_symbols(srsran_ofdm_t* q, uint32_t first_symbol, uint32_t nof_symbols)
+{
+  if (q == NULL || first_symbol + nof_symbols > SRSRAN_NOF_SLOTS_PER_SF * q->nof_symbols) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+#ifdef AVOID_GURU
+  ERROR("The OFDM symbol range demodulator requires the Guru DFT");
+  return SRSRAN_ERROR;
+#else
+  if (q->mbsfn_subframe) {
+    ERROR("The OFDM symbol range demodulator does not support MBSFN subframes");
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t symbol_sz = q->cfg.symbol_sz;
+  bool     shift     = isnormal(q->cfg.freq_shift_f);
+
+  // Every window goes through the aligned DFT plan input, the frequency shift and the CFO are applied on the way, so
+  // the input buffer is left untouched and the remaining symbols can be demodulated later
+  cf_t* fft_in = q->fft_plan.in;
+  for (uint32_t l = first_symbol; l < first_symbol + nof_symbols; l++) {
+    uint32_t    slot  = l / q->nof_symbols;
+    uint32_t    i     = l % q->nof_symbols;
+    uint32_t    start = ofdm_rx_symbol_start(q, slot, i);
+    const cf_t* src   = &q->cfg.in_buffer[start];
+    if (shift) {
+      srsran_vec_prod_ccc(src, &q->shift_buffer[start], fft_in, symbol_sz);
+      src = fft_in;
+    }
+    if (isnormal(q->rx_cfo)) {
+      srsran_vec_apply_cfo(src, q->rx_cfo, fft_in, (int)symbol_sz);
+      src = fft_in;
+    }
+    if (src != fft_in) {
+      srsran_vec_cf_copy(fft_in, src, symbol_sz);
+    }
+    srsran_dft_run_c_zerocopy(&q->fft_plan, fft_in, &q->tmp[i * symbol_sz]);
+    ofdm_rx_slot_demap(q, slot, i, 1);
+  }
+
+  return SRSRAN_SUCCESS;
+#endif
+}
+
 void srsran_ofdm_rx_sf_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output)
 {
   uint32_t n;
   if (isnormal(q->cfg.freq_shift_f)) {
     srsran_vec_prod_ccc(input, q->shift_buffer, input, q->sf_sz);
   }
+  if (isnormal(q->rx_cfo) && q->mbsfn_subframe) {
+    srsran_vec_apply_cfo(input, q->rx_cfo, input, (int)q->sf_sz);
+  }
   if (!q->mbsfn_subframe) {
     for (n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
-      srsran_ofdm_rx_slot_ng(q, &input[n * q->slot_sz], &output[n * q->nof_re * q->nof_symbols]);
+      ofdm_rx_slot_ng_cfo(q, &input[n * q->slot_sz], &output[n * q->nof_re * q->nof_symbols], n);
     }
   } else {
     ofdm_rx_slot_mbsfn(q, q->cfg.in_buffer, q->cfg.out_buffer);
@@ -689,6 +865,70 @@ void srsran_ofdm_tx_sf(srsran_ofdm_t* q)
   }
 }
 
+int srsran_ofdm_tx_sf_symbols(srsran_ofdm_t* q, uint32_t symbol_mask)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  if (q->mbsfn_subframe) {
+    ERROR("The OFDM symbol mask modulator does not support MBSFN subframes");
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t symbol_sz = q->cfg.symbol_sz;
+  uint32_t nof_re    = q->nof_re;
+  uint32_t dc        = (q->fft_plan.dc) ? 1 : 0;
+  float    norm      = 1.0f / sqrtf(symbol_sz);
+  cf_t*    input     = q->cfg.in_buffer;
+  cf_t*    output    = q->cfg.out_buffer;
+
+  // Each selected symbol goes through the single symbol plan buffers, the Guru plan temporal buffer is left untouched
+  cf_t* fft_in  = q->fft_plan.in;
+  cf_t* fft_out = q->fft_plan.out;
+  for (uint32_t l = 0; l < SRSRAN_NOF_SLOTS_PER_SF * q->nof_symbols; l++) {
+    uint32_t i      = l % q->nof_symbols;
+    uint32_t cp_len = SRSRAN_CP_ISNORM(q->cfg.cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+
+    if (symbol_mask & (1U << l)) {
+      srsran_vec_cf_zero(fft_in, symbol_sz);
+      srsran_vec_cf_copy(&fft_in[dc], &input[nof_re / 2], nof_re / 2);
+      srsran_vec_cf_copy(&fft_in[symbol_sz - nof_re / 2], &input[0], nof_re / 2);
+      srsran_dft_run_c_zerocopy(&q->fft_plan, fft_in, fft_out);
+
+      if (isnormal(q->cfg.phase_compensation_hz)) {
+        cf_t phase_compensation = q->phase_compensation[l];
+        if (q->fft_plan.norm) {
+          phase_compensation *= norm;
+        }
+        srsran_vec_sc_prod_ccc(fft_out, phase_compensation, &output[cp_len], symbol_sz);
+      } else if (q->fft_plan.norm) {
+        srsran_vec_sc_prod_cfc(fft_out, norm, &output[cp_len], symbol_sz);
+      } else {
+        srsran_vec_cf_copy(&output[cp_len], fft_out, symbol_sz);
+      }
+
+      // CFR: Process the time-domain signal without the CP
+      if (q->cfg.cfr_tx_cfg.cfr_enable) {
+        srsran_cfr_process(&q->tx_cfr, output + cp_len, output + cp_len);
+      }
+
+      /* add CP */
+      srsran_vec_cf_copy(output, &output[symbol_sz], cp_len);
+    } else {
+      srsran_vec_cf_zero(output, symbol_sz + cp_len);
+    }
+
+    input += nof_re;
+    output += symbol_sz + cp_len;
+  }
+
+  if (isnormal(q->cfg.freq_shift_f)) {
+    srsran_vec_prod_ccc(q->cfg.out_buffer, q->shift_buffer, q->cfg.out_buffer, q->sf_sz);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_ofdm_set_cfr(srsran_ofdm_t* q, srsran_cfr_cfg_t* cfr)
 {
   if (q == NULL || cfr == NULL) {
@@ -0,0 +1,208 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+
+static uint32_t dft_size        = 0;
+static int      nof_repetitions = 100;
+static float    max_nmse        = 1e-10f;
+
+// Transform sizes used by LTE and NR for the OFDM symbols
+static const uint32_t dft_sizes[] = {128, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096};
+
+static void usage(char* prog)
+{
+  printf("Usage: %s\n", prog);
+  printf("\t-N DFT size, 0 for all the LTE and NR symbol sizes [Default %d]\n", dft_size);
+  printf("\t-r nof_repetitions for the latency measurement [Default %d]\n", nof_repetitions);
+  printf("\t-e Maximum normalised mean square error against FFTW [Default %.1e]\n", max_nmse);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "Nre")) != -1) {
+    switch (opt) {
+      case 'N':
+        dft_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_repetitions = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'e':
+        max_nmse = strtof(argv[optind], NULL);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static float nmse(const cf_t* x, const cf_t* ref, cf_t* tmp, uint32_t len)
+{
+  srsran_vec_sub_ccc(x, ref, tmp, len);
+  return srsran_vec_avg_power_cf(tmp, len) / srsran_vec_avg_power_cf(ref, len);
+}
+
+// Mean latency of a symbol transform in microseconds
+static double latency_us(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
+{
+  struct timeval t[3];
+  gettimeofday(&t[1], NULL);
+  for (int i = 0; i < nof_repetitions; i++) {
+    srsran_dft_run_c_zerocopy(plan, in, out);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  return ((double)t[0].tv_sec * 1e6 + (double)t[0].tv_usec) / (double)SRSRAN_MAX(1, nof_repetitions);
+}
+
+static int test_size(srsran_random_t random_gen, uint32_t size, srsran_dft_dir_t dir)
+{
+  int   ret = SRSRAN_ERROR;
+  cf_t* in  = srsran_vec_cf_malloc(2 * size);
+  cf_t* ref = srsran_vec_cf_malloc(2 * size);
+  cf_t* out = srsran_vec_cf_malloc(2 * size);
+  cf_t* tmp = srsran_vec_cf_malloc(2 * size);
+
+  srsran_dft_plan_t plan[SRSRAN_DFT_BACKEND_NOF] = {};
+  srsran_dft_plan_t guru                         = {};
+
+  if (!in || !ref || !out || !tmp) {
+    goto clean_exit;
+  }
+  srsran_random_uniform_complex_dist_vector(random_gen, in, 2 * size, -1.0f, 1.0f);
+
+  for (int b = 0; b < SRSRAN_DFT_BACKEND_NOF; b++) {
+    srsran_dft_set_backend((srsran_dft_backend_t)b);
+    if (srsran_dft_plan_c(&plan[b], size, dir) || plan[b].backend != (srsran_dft_backend_t)b) {
+      ERROR("Error creating %s plan of size %d", srsran_dft_backend_to_string((srsran_dft_backend_t)b), size);
+      goto clean_exit;
+    }
+  }
+  srsran_dft_plan_set_mirror(&plan[SRSRAN_DFT_BACKEND_FFTW], true);
+  srsran_dft_plan_set_norm(&plan[SRSRAN_DFT_BACKEND_FFTW], true);
+  srsran_dft_run_c(&plan[SRSRAN_DFT_BACKEND_FFTW], in, ref);
+  srsran_dft_plan_set_mirror(&plan[SRSRAN_DFT_BACKEND_FFTW], false);
+  srsran_dft_plan_set_norm(&plan[SRSRAN_DFT_BACKEND_FFTW], false);
+
+  printf("%-8s %5d", dir == SRSRAN_DFT_FORWARD ? "forward" : "backward", size);
+
+  for (int b = 1; b < SRSRAN_DFT_BACKEND_NOF; b++) {
+    // Options are applied by the common code, the backend only computes the transform
+    srsran_dft_plan_set_mirror(&plan[b], true);
+    srsran_dft_plan_set_norm(&plan[b], true);
+    srsran_dft_run_c(&plan[b], in, out);
+    float e = nmse(out, ref, tmp, size);
+    printf("  %s nmse=%.1e", srsran_dft_backend_to_string((srsran_dft_backend_t)b), e);
+    if (!(e <= max_nmse)) {
+      printf("\n");
+      ERROR("The %s backend exceeds the error", srsran_dft_backend_to_string((srsran_dft_backend_t)b));
+      goto clean_exit;
+    }
+
+    // Two transforms with a gap, as the OFDM guru plans do for the cyclic prefix
+    srsran_dft_set_backend((srsran_dft_backend_t)b);
+    if (srsran_dft_plan_guru_c(&guru, size / 2, dir, in, out, 1, 1, 2, size / 2 + size / 4, size / 2) ||
+        guru.backend != (srsran_dft_backend_t)b) {
+      printf("\n");
+      ERROR("Error creating %s guru plan", srsran_dft_backend_to_string((srsran_dft_backend_t)b));
+      goto clean_exit;
+    }
+    srsran_dft_run_guru_c(&guru);
+    srsran_dft_plan_free(&guru);
+
+    srsran_dft_set_backend(SRSRAN_DFT_BACKEND_FFTW);
+    if (srsran_dft_plan_guru_c(&guru, size / 2, dir, in, ref, 1, 1, 2, size / 2 + size / 4, size / 2)) {
+      printf("\n");
+      ERROR("Error creating FFTW guru plan");
+      goto clean_exit;
+    }
+    srsran_dft_run_guru_c(&guru);
+    srsran_dft_plan_free(&guru);
+
+    e = nmse(out, ref, tmp, size);
+    if (!(e <= max_nmse)) {
+      printf("\n");
+      ERROR("The %s guru plan exceeds the error (%.1e)", srsran_dft_backend_to_string((srsran_dft_backend_t)b), e);
+      goto clean_exit;
+    }
+  }
+
+  for (int b = 0; b < SRSRAN_DFT_BACKEND_NOF; b++) {
+    printf("  %s=%.2f us", srsran_dft_backend_to_string((srsran_dft_backend_t)b), latency_us(&plan[b], in, out));
+  }
+  printf("\n");
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  for (int b = 0; b < SRSRAN_DFT_BACKEND_NOF; b++) {
+    srsran_dft_plan_free(&plan[b]);
+  }
+  srsran_dft_plan_free(&guru);
+  if (in) {
+    free(in);
+  }
+  if (ref) {
+    free(ref);
+  }
+  if (out) {
+    free(out);
+  }
+  if (tmp) {
+    free(tmp);
+  }
+  return ret;
+}
+
+int main(int argc, char** argv)
+{
+  int             ret        = SRSRAN_SUCCESS;
+  srsran_random_t random_gen = srsran_random_init(0);
+
+  parse_args(argc, argv);
+
+  for (uint32_t i = 0; i < sizeof(dft_sizes) / sizeof(dft_sizes[0]) && ret == SRSRAN_SUCCESS; i++) {
+    uint32_t size = dft_size ? dft_size : dft_sizes[i];
+    ret           = test_size(random_gen, size, SRSRAN_DFT_FORWARD);
+    if (ret == SRSRAN_SUCCESS) {
+      ret = test_size(random_gen, size, SRSRAN_DFT_BACKWARD);
+    }
+    if (dft_size) {
+      break;
+    }
+  }
+
+  srsran_dft_set_backend(SRSRAN_DFT_BACKEND_FFTW);
+  srsran_random_free(random_gen);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Failed");
+  return ret;
+}
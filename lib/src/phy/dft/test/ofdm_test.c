@@ -36,6 +36,11 @@ static float       rx_window_offset      = 0.5f;
 static float       freq_shift_f          = 0.0f;
 static double      phase_compensation_hz = 0.0;
 static uint32_t    force_symbol_sz       = 0;
+static char*       dft_backend           = "fftw";
+static bool        rx_sc16               = false;
+static float       rx_cfo                = 0.0f;
+static uint32_t    rx_first_symbols      = 0;
+static const float sc16_scale            = 8192.0f;
 static double      elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
 {
   if (ts_end->tv_usec > ts_start->tv_usec) {
@@ -57,12 +62,16 @@ static void usage(char* prog)
   printf("\t-o rx window offset (portion of CP length) [Default %.1f]\n", rx_window_offset);
   printf("\t-s frequency shift (normalised with sampling rate) [Default %.1f]\n", freq_shift_f);
   printf("\t-p Phase compensation carrier frequency in Hz [Default %.1f]\n", phase_compensation_hz);
+  printf("\t-b DFT backend, fftw or radix [Default %s]\n", dft_backend);
+  printf("\t-q demodulate int16 (sc16) samples [Default %s]\n", rx_sc16 ? "true" : "false");
+  printf("\t-c CFO corrected by the receiver (normalised with sampling rate) [Default %.1f]\n", rx_cfo);
+  printf("\t-t demodulate first this number of symbols, then the rest [Default %d, whole subframe]\n", rx_first_symbols);
 }
 
 static void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "Nnerosp")) != -1) {
+  while ((opt = getopt(argc, argv, "Nnerospbqct")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (int)strtol(argv[optind], NULL, 10);
@@ -85,6 +94,18 @@ static void parse_args(int argc, char** argv)
       case 'p':
         phase_compensation_hz = strtod(argv[optind], NULL);
         break;
+      case 'b':
+        dft_backend = argv[optind];
+        break;
+      case 'q':
+        rx_sc16 = true;
+        break;
+      case 'c':
+        rx_cfo = strtof(argv[optind], NULL);
+        break;
+      case 't':
+        rx_first_symbols = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -98,11 +119,19 @@ int main(int argc, char** argv)
   struct timeval  start, end;
   srsran_ofdm_t   fft = {}, ifft = {};
   cf_t *          input, *outfft, *outifft;
+  int16_t*        outifft_sc16;
   float           mse;
   uint32_t        n_prb, max_prb;
 
   parse_args(argc, argv);
 
+  srsran_dft_backend_t backend = SRSRAN_DFT_BACKEND_FFTW;
+  if (srsran_dft_backend_from_string(dft_backend, &backend) < SRSRAN_SUCCESS) {
+    ERROR("Invalid DFT backend %s", dft_backend);
+    return SRSRAN_ERROR;
+  }
+  srsran_dft_set_backend(backend);
+
   if (nof_prb == -1) {
     n_prb   = 6;
     max_prb = SRSRAN_MAX_PRB;
@@ -121,7 +150,8 @@ int main(int argc, char** argv)
     input   = srsran_vec_cf_malloc(n_re);
     outfft  = srsran_vec_cf_malloc(n_re);
     outifft = srsran_vec_cf_malloc(sf_len);
-    if (!input || !outfft || !outifft) {
+    outifft_sc16 = srsran_vec_i16_malloc(2 * sf_len);
+    if (!input || !outfft || !outifft || !outifft_sc16) {
       perror("malloc");
       exit(-1);
     }
@@ -150,9 +180,10 @@ int main(int argc, char** argv)
       exit(-1);
     }
 
-    if (isnormal(freq_shift_f)) {
+    if (isnormal(freq_shift_f) || isnormal(rx_cfo)) {
       nof_repetitions = 1;
     }
+    srsran_ofdm_set_rx_cfo(&fft, -rx_cfo);
 
     // Generate Random data
     srsran_random_uniform_complex_dist_vector(random_gen, input, n_re, -1.0f, +1.0f);
@@ -165,10 +196,38 @@ int main(int argc, char** argv)
     gettimeofday(&end, NULL);
     printf(" Tx@%.1fMsps", (float)(sf_len * nof_repetitions) / elapsed_us(&start, &end));
 
+    // Apply the CFO the receiver corrects, with the phase origin at the start of the subframe
+    if (isnormal(rx_cfo)) {
+      for (uint32_t i = 0; i < sf_len; i++) {
+        outifft[i] *= (cf_t)cexp(I * 2.0 * M_PI * (double)rx_cfo * (double)i);
+      }
+    }
+
     // Execute Rx
+    if (rx_sc16) {
+      // Round like an ADC, the truncation of srsran_vec_convert_fi() correlates the error with the signal
+      const float* outifft_f = (const float*)outifft;
+      for (uint32_t i = 0; i < 2 * sf_len; i++) {
+        outifft_sc16[i] = (int16_t)roundf(outifft_f[i] * sc16_scale);
+      }
+    }
     gettimeofday(&start, NULL);
     for (uint32_t i = 0; i < nof_repetitions; i++) {
-      srsran_ofdm_rx_sf(&fft);
+      if (rx_sc16) {
+        if (srsran_ofdm_rx_sf_sc16(&fft, outifft_sc16, sc16_scale) < SRSRAN_SUCCESS) {
+          ERROR("Error demodulating sc16 samples");
+          exit(-1);
+        }
+      } else if (rx_first_symbols) {
+        uint32_t nof_symbols = SRSRAN_CP_NSYMB(cp) * SRSRAN_NOF_SLOTS_PER_SF;
+        if (srsran_ofdm_rx_sf_symbols(&fft, 0, rx_first_symbols) < SRSRAN_SUCCESS ||
+            srsran_ofdm_rx_sf_symbols(&fft, rx_first_symbols, nof_symbols - rx_first_symbols) < SRSRAN_SUCCESS) {
+          ERROR("Error demodulating symbol ranges");
+          exit(-1);
+        }
+      } else {
+        srsran_ofdm_rx_sf(&fft);
+      }
     }
     gettimeofday(&end, NULL);
     printf(" Rx@%.1fMsps", (double)(sf_len * nof_repetitions) / elapsed_us(&start, &end));
@@ -190,6 +249,7 @@ int main(int argc, char** argv)
     free(input);
     free(outfft);
     free(outifft);
+    free(outifft_sc16);
 
     n_prb++;
   }
@@ -34,6 +34,40 @@ static float enb_dl_get_norm_factor(uint32_t nof_prb)
   return 0.05f / sqrtf(nof_prb);
 }
 
+static void enb_dl_free_templates(srsran_enb_dl_t* q)
+{
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+      if (q->sf_template[sf_idx][p]) {
+        free(q->sf_template[sf_idx][p]);
+        q->sf_template[sf_idx][p] = NULL;
+      }
+      if (q->template_signal[sf_idx][p]) {
+        free(q->template_signal[sf_idx][p]);
+        q->template_signal[sf_idx][p] = NULL;
+      }
+    }
+    q->template_valid[sf_idx]       = false;
+    q->template_signal_mask[sf_idx] = 0;
+  }
+}
+
+static int enb_dl_alloc_templates(srsran_enb_dl_t* q)
+{
+  enb_dl_free_templates(q);
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    for (uint32_t p = 0; p < q->cell.nof_ports; p++) {
+      q->sf_template[sf_idx][p]     = srsran_vec_cf_malloc(CURRENT_SFLEN_RE);
+      q->template_signal[sf_idx][p] = srsran_vec_cf_malloc(SRSRAN_SF_LEN_PRB(q->cell.nof_prb));
+      if (!q->sf_template[sf_idx][p] || !q->template_signal[sf_idx][p]) {
+        perror("malloc");
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_enb_dl_init(srsran_enb_dl_t* q, cf_t* out_buffer[SRSRAN_MAX_PORTS], uint32_t max_prb)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
@@ -133,6 +167,7 @@ void srsran_enb_dl_free(srsran_enb_dl_t* q)
     srsran_pmch_free(&q->pmch);
     srsran_refsignal_free(&q->csr_signal);
     srsran_refsignal_free(&q->mbsfnr_signal);
+    enb_dl_free_templates(q);
     for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
       if (q->sf_symbols[i]) {
         free(q->sf_symbols[i]);
@@ -225,6 +260,12 @@ int srsran_enb_dl_set_cell(srsran_enb_dl_t* q, srsran_cell_t cell)
       srsran_pss_generate(q->pss_signal, cell.id % 3);
       srsran_sss_generate(q->sss_signal0, q->sss_signal5, cell.id);
 
+      // The subframe templates depend on the cell, they are generated again on first use
+      if (enb_dl_alloc_templates(q) < SRSRAN_SUCCESS) {
+        ERROR("Error allocating subframe templates");
+        return SRSRAN_ERROR;
+      }
+
       // Calculate common DCI locations
       for (int32_t cfi = 1; cfi <= 3; cfi++) {
         q->nof_common_locations[SRSRAN_CFI_IDX(cfi)] = srsran_pdcch_common_locations(
@@ -249,6 +290,11 @@ int srsran_enb_dl_set_cfr(srsran_enb_dl_t* q, const srsran_cfr_cfg_t* cfr)
   // Copy the cfr config into the eNB
   q->cfr_config = *cfr;
 
+  // The cached template signals were modulated with the previous configuration
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    q->template_signal_mask[sf_idx] = 0;
+  }
+
   // Set the cfr for the ifft's
   if (srsran_ofdm_set_cfr(&q->ifft_mbsfn, &q->cfr_config) < SRSRAN_SUCCESS) {
     ERROR("Error setting the CFR for ifft_mbsfn");
@@ -355,6 +401,77 @@ static void put_refs(srsran_enb_dl_t* q)
   }
 }
 
+static bool enb_dl_tdd_config_equal(const srsran_tdd_config_t* a, const srsran_tdd_config_t* b)
+{
+  return a->configured == b->configured && a->sf_config == b->sf_config && a->ss_config == b->ss_config;
+}
+
+/* Generates the template of a subframe index in the resource grid, and saves it along with the symbols it occupies */
+static void build_template(srsran_enb_dl_t* q, uint32_t sf_idx)
+{
+  uint32_t nof_re_symbol = SRSRAN_NRE * q->cell.nof_prb;
+  uint32_t nof_symbols   = SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_CP_NSYMB(q->cell.cp);
+
+  clear_sf(q);
+  put_sync(q);
+  put_refs(q);
+
+  q->template_symbol_mask[sf_idx] = 0;
+  for (int p = 0; p < q->cell.nof_ports; p++) {
+    srsran_vec_cf_copy(q->sf_template[sf_idx][p], q->sf_symbols[p], CURRENT_SFLEN_RE);
+    for (uint32_t l = 0; l < nof_symbols; l++) {
+      if (srsran_vec_avg_power_cf(&q->sf_symbols[p][l * nof_re_symbol], nof_re_symbol) > 0.0f) {
+        q->template_symbol_mask[sf_idx] |= 1U << l;
+      }
+    }
+  }
+  q->template_tdd_config[sf_idx]  = q->dl_sf.tdd_config;
+  q->template_valid[sf_idx]       = true;
+  q->template_signal_mask[sf_idx] = 0;
+}
+
+/* Puts PSS/SSS and CRS of a normal subframe, the special subframe CRS depend on the TDD configuration */
+static void put_template(srsran_enb_dl_t* q)
+{
+  uint32_t sf_idx = q->dl_sf.tti % SRSRAN_NOF_SF_X_FRAME;
+
+  if (!q->template_valid[sf_idx] ||
+      !enb_dl_tdd_config_equal(&q->template_tdd_config[sf_idx], &q->dl_sf.tdd_config)) {
+    build_template(q, sf_idx);
+    return;
+  }
+
+  for (int p = 0; p < q->cell.nof_ports; p++) {
+    srsran_vec_cf_copy(q->sf_symbols[p], q->sf_template[sf_idx][p], CURRENT_SFLEN_RE);
+  }
+}
+
+/* Symbols of the control region, PHICH extended duration takes at least 3 symbols */
+static uint32_t ctrl_symbol_mask(srsran_enb_dl_t* q)
+{
+  uint32_t nof_ctrl_symbols = SRSRAN_NOF_CTRL_SYMBOLS(q->cell, q->dl_sf.cfi);
+  if (q->cell.phich_length == SRSRAN_PHICH_EXT) {
+    nof_ctrl_symbols = SRSRAN_MAX(nof_ctrl_symbols, 3);
+  }
+  return (1U << nof_ctrl_symbols) - 1;
+}
+
+/* Copies the time domain signal of the symbols in the mask, cyclic prefix included */
+static void copy_signal_symbols(srsran_enb_dl_t* q, cf_t* dst, const cf_t* src, uint32_t symbol_mask)
+{
+  uint32_t symbol_sz = q->ifft[0].cfg.symbol_sz;
+  uint32_t nof_symb  = SRSRAN_CP_NSYMB(q->cell.cp);
+  uint32_t offset    = 0;
+  for (uint32_t l = 0; l < SRSRAN_NOF_SLOTS_PER_SF * nof_symb && symbol_mask >> l; l++) {
+    uint32_t cp_len =
+        SRSRAN_CP_ISNORM(q->cell.cp) ? SRSRAN_CP_LEN_NORM(l % nof_symb, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+    if (symbol_mask & (1U << l)) {
+      srsran_vec_cf_copy(&dst[offset], &src[offset], symbol_sz + cp_len);
+    }
+    offset += symbol_sz + cp_len;
+  }
+}
+
 static void put_mib(srsran_enb_dl_t* q)
 {
   uint8_t bch_payload[SRSRAN_BCH_PAYLOAD_LEN];
@@ -377,9 +494,20 @@ void srsran_enb_dl_put_base(srsran_enb_dl_t* q, srsran_dl_sf_cfg_t* dl_sf)
 {
   srsran_ofdm_set_non_mbsfn_region(&q->ifft_mbsfn, dl_sf->non_mbsfn_region);
   q->dl_sf = *dl_sf;
-  clear_sf(q);
-  put_sync(q);
-  put_refs(q);
+
+  // PCFICH is always in the first symbol and PBCH takes the four first symbols of the second slot of subframe 0
+  q->sf_symbol_mask = 1U;
+  if (q->dl_sf.tti % SRSRAN_NOF_SF_X_FRAME == 0) {
+    q->sf_symbol_mask |= 0xfU << SRSRAN_CP_NSYMB(q->cell.cp);
+  }
+
+  if (q->dl_sf.sf_type == SRSRAN_SF_MBSFN) {
+    clear_sf(q);
+    put_sync(q);
+    put_refs(q);
+  } else {
+    put_template(q);
+  }
   put_mib(q);
   put_pcfich(q);
 }
@@ -389,6 +517,7 @@ void srsran_enb_dl_put_phich(srsran_enb_dl_t* q, srsran_phich_grant_t* grant, bo
   srsran_phich_resource_t resource;
   srsran_phich_calc(&q->phich, grant, &resource);
   srsran_phich_encode(&q->phich, &q->dl_sf, resource, ack, q->sf_symbols);
+  q->sf_symbol_mask |= ctrl_symbol_mask(q);
 }
 
 bool srsran_enb_dl_location_is_common_ncce(srsran_enb_dl_t* q, const srsran_dci_location_t* loc)
@@ -409,6 +538,7 @@ int srsran_enb_dl_put_pdcch_dl(srsran_enb_dl_t* q, srsran_dci_cfg_t* dci_cfg, sr
   if (srsran_dci_msg_pack_pdsch(&q->cell, &q->dl_sf, dci_cfg, dci_dl, &dci_msg)) {
     ERROR("Error packing DL DCI");
   }
+  q->sf_symbol_mask |= ctrl_symbol_mask(q);
   if (srsran_pdcch_encode(&q->pdcch, &q->dl_sf, &dci_msg, q->sf_symbols)) {
     ERROR("Error encoding DL DCI message");
     return SRSRAN_ERROR;
@@ -425,6 +555,7 @@ int srsran_enb_dl_put_pdcch_ul(srsran_enb_dl_t* q, srsran_dci_cfg_t* dci_cfg, sr
   if (srsran_dci_msg_pack_pusch(&q->cell, &q->dl_sf, dci_cfg, dci_ul, &dci_msg)) {
     ERROR("Error packing UL DCI");
   }
+  q->sf_symbol_mask |= ctrl_symbol_mask(q);
   if (srsran_pdcch_encode(&q->pdcch, &q->dl_sf, &dci_msg, q->sf_symbols)) {
     ERROR("Error encoding UL DCI message");
     return SRSRAN_ERROR;
@@ -433,19 +564,43 @@ int srsran_enb_dl_put_pdcch_ul(srsran_enb_dl_t* q, srsran_dci_cfg_t* dci_cfg, sr
   return SRSRAN_SUCCESS;
 }
 
+void srsran_enb_dl_set_tb_cache(srsran_enb_dl_t* q, srsran_pdsch_tb_cache_t* cache)
+{
+  srsran_pdsch_set_tb_cache(&q->pdsch, cache);
+}
+
 int srsran_enb_dl_put_pdsch(srsran_enb_dl_t* q, srsran_pdsch_cfg_t* pdsch, uint8_t* data[SRSRAN_MAX_CODEWORDS])
 {
+  q->sf_symbol_mask = UINT32_MAX;
   return srsran_pdsch_encode(&q->pdsch, &q->dl_sf, pdsch, data, q->sf_symbols);
 }
 
 int srsran_enb_dl_put_pmch(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, uint8_t* data)
 {
+  q->sf_symbol_mask = UINT32_MAX;
   return srsran_pmch_encode(&q->pmch, &q->dl_sf, pmch_cfg, data, q->sf_symbols);
 }
 
+const cf_t*
+srsran_enb_dl_encode_pmch(srsran_enb_dl_t* q, srsran_dl_sf_cfg_t* dl_sf, srsran_pmch_cfg_t* pmch_cfg, uint8_t* data)
+{
+  if (srsran_pmch_encode_symbols(&q->pmch, dl_sf, pmch_cfg, data) < SRSRAN_SUCCESS) {
+    return NULL;
+  }
+  return q->pmch.d;
+}
+
+int srsran_enb_dl_put_pmch_symbols(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, const cf_t* symbols)
+{
+  q->sf_symbol_mask = UINT32_MAX;
+  return srsran_pmch_put_symbols(&q->pmch, &q->dl_sf, pmch_cfg, symbols, q->sf_symbols);
+}
+
 void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q)
 {
-  float norm_factor = enb_dl_get_norm_factor(q->cell.nof_prb);
+  float    norm_factor = enb_dl_get_norm_factor(q->cell.nof_prb);
+  uint32_t nof_symbols = SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_CP_NSYMB(q->cell.cp);
+  uint32_t all_symbols = (1U << nof_symbols) - 1;
 
   // First apply the amplitude normalization, then perform the IFFT and optional CFR reduction
   if (q->dl_sf.sf_type == SRSRAN_SF_MBSFN) {
@@ -454,6 +609,27 @@ void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q)
                            q->ifft_mbsfn.cfg.in_buffer,
                            SRSRAN_NOF_SLOTS_PER_SF * q->cell.nof_prb * SRSRAN_NRE * SRSRAN_CP_NSYMB(q->cell.cp));
     srsran_ofdm_tx_sf(&q->ifft_mbsfn);
+  } else if ((~q->sf_symbol_mask & all_symbols) && !q->cfr_config.cfr_enable) {
+    // Symbols that only carry the template reuse its time domain signal, modulated the first time it is needed. The
+    // rest of symbols are modulated if they carry any signal. The CFR keeps state across symbols so it takes the full
+    // path.
+    uint32_t sf_idx        = q->dl_sf.tti % SRSRAN_NOF_SF_X_FRAME;
+    uint32_t template_mask = q->template_symbol_mask[sf_idx] & ~q->sf_symbol_mask;
+    uint32_t cached_mask   = q->template_signal_mask[sf_idx] & template_mask;
+    uint32_t ifft_mask     = (q->sf_symbol_mask | template_mask) & ~cached_mask & all_symbols;
+    uint32_t nof_re_symbol = q->cell.nof_prb * SRSRAN_NRE;
+    for (int i = 0; i < q->cell.nof_ports; i++) {
+      for (uint32_t l = 0; l < nof_symbols; l++) {
+        if (ifft_mask & (1U << l)) {
+          cf_t* symbol = &q->ifft[i].cfg.in_buffer[l * nof_re_symbol];
+          srsran_vec_sc_prod_cfc(symbol, norm_factor, symbol, nof_re_symbol);
+        }
+      }
+      srsran_ofdm_tx_sf_symbols(&q->ifft[i], ifft_mask);
+      copy_signal_symbols(q, q->ifft[i].cfg.out_buffer, q->template_signal[sf_idx][i], cached_mask);
+      copy_signal_symbols(q, q->template_signal[sf_idx][i], q->ifft[i].cfg.out_buffer, template_mask & ~cached_mask);
+    }
+    q->template_signal_mask[sf_idx] |= template_mask;
   } else {
     for (int i = 0; i < q->cell.nof_ports; i++) {
       srsran_vec_sc_prod_cfc(q->ifft[i].cfg.in_buffer,
@@ -63,6 +63,13 @@ int srsran_enb_ul_init(srsran_enb_ul_t* q, cf_t* in_buffer, uint32_t max_prb)
       goto clean_exit;
     }
 
+    q->pucch_batch_cfg = calloc(SRSRAN_ENB_UL_PUCCH_BATCH_MAX_RES, sizeof(srsran_pucch_cfg_t));
+    q->pucch_batch_res = calloc(SRSRAN_ENB_UL_PUCCH_BATCH_MAX_RES, sizeof(srsran_pucch_res_t));
+    if (!q->pucch_batch_cfg || !q->pucch_batch_res) {
+      perror("malloc");
+      goto clean_exit;
+    }
+
     ret = SRSRAN_SUCCESS;
 
   } else {
@@ -90,6 +97,12 @@ void srsran_enb_ul_free(srsran_enb_ul_t* q)
     if (q->chest_res.ce) {
       free(q->chest_res.ce);
     }
+    if (q->pucch_batch_cfg) {
+      free(q->pucch_batch_cfg);
+    }
+    if (q->pucch_batch_res) {
+      free(q->pucch_batch_res);
+    }
     bzero(q, sizeof(srsran_enb_ul_t));
   }
 }
@@ -153,11 +166,10 @@ void srsran_enb_ul_fft(srsran_enb_ul_t* q)
   srsran_ofdm_rx_sf(&q->fft);
 }
 
-static int get_pucch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pucch_cfg_t* cfg, srsran_pucch_res_t* res)
+/* Drops the CQI if it collides with ACK, selects the PUCCH format and computes the possible resources */
+static int get_pucch_resources(srsran_enb_ul_t* q, srsran_pucch_cfg_t* cfg, uint32_t n_pucch_i[SRSRAN_PUCCH_MAX_ALLOC])
 {
-  int      ret                               = SRSRAN_SUCCESS;
-  uint32_t n_pucch_i[SRSRAN_PUCCH_MAX_ALLOC] = {};
-  uint32_t uci_cfg_total_ack                 = srsran_uci_cfg_total_ack(&cfg->uci_cfg);
+  uint32_t uci_cfg_total_ack = srsran_uci_cfg_total_ack(&cfg->uci_cfg);
 
   // Drop CQI if there is collision with ACK
   if (!cfg->simul_cqi_ack && uci_cfg_total_ack > 0 && cfg->uci_cfg.cqi.data_enable) {
@@ -178,6 +190,57 @@ static int get_pucch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pucch
     return SRSRAN_ERROR;
   }
 
+  return nof_resources;
+}
+
+/* Keeps in res the result of the possible resource i if it has the greatest correlation so far */
+static void
+select_pucch_res(srsran_pucch_cfg_t* cfg, uint32_t i, srsran_pucch_res_t* pucch_res, srsran_pucch_res_t* res)
+{
+  // Get PUCCH Format 1b with channel selection if:
+  // - At least one ACK bit needs to be received; and
+  // - PUCCH Format 1b was used; and
+  // - HARQ feedback mode is set to PUCCH Format1b with Channel Selection (CS); and
+  // - No scheduling request is expected; and
+  // - Data is valid (invalid data does not make sense to decode).
+  if (srsran_uci_cfg_total_ack(&cfg->uci_cfg) > 0 && cfg->format == SRSRAN_PUCCH_FORMAT_1B &&
+      cfg->ack_nack_feedback_mode == SRSRAN_PUCCH_ACK_NACK_FEEDBACK_MODE_CS &&
+      !cfg->uci_cfg.is_scheduling_request_tti && pucch_res->uci_data.ack.valid) {
+    uint8_t b[2] = {pucch_res->uci_data.ack.ack_value[0], pucch_res->uci_data.ack.ack_value[1]};
+    srsran_pucch_cs_get_ack(cfg, &cfg->uci_cfg, i, b, &pucch_res->uci_data);
+  }
+
+  // Compares correlation value, it stores the PUCCH result with the greatest correlation
+  if (i == 0 || pucch_res->correlation > res->correlation) {
+    *res = *pucch_res;
+  }
+}
+
+/* Chooses between the PUCCH results with and without SR, the configuration shall have the SR disabled */
+static void
+select_pucch_res_no_sr(srsran_pucch_cfg_t* cfg, srsran_pucch_res_t* res, const srsran_pucch_res_t* res_no_sr)
+{
+  // Override PUCCH result if PUCCH without SR was detected, and
+  // - no PUCCH with SR was detected; or
+  // - PUCCH without SR has better correlation
+  if (res_no_sr->detected && (!res->detected || res_no_sr->correlation > res->correlation)) {
+    *res = *res_no_sr;
+  } else {
+    // If the PUCCH decode result is not overridden, flag SR
+    cfg->uci_cfg.is_scheduling_request_tti = true;
+  }
+}
+
+static int get_pucch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pucch_cfg_t* cfg, srsran_pucch_res_t* res)
+{
+  int      ret                               = SRSRAN_SUCCESS;
+  uint32_t n_pucch_i[SRSRAN_PUCCH_MAX_ALLOC] = {};
+
+  int nof_resources = get_pucch_resources(q, cfg, n_pucch_i);
+  if (nof_resources < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   // Initialise minimum correlation
   res->correlation = 0.0f;
 
@@ -201,29 +264,13 @@ static int get_pucch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pucch
     if (ret < SRSRAN_SUCCESS) {
       ERROR("Error decoding PUCCH");
     } else {
-      // Get PUCCH Format 1b with channel selection if:
-      // - At least one ACK bit needs to be received; and
-      // - PUCCH Format 1b was used; and
-      // - HARQ feedback mode is set to PUCCH Format1b with Channel Selection (CS); and
-      // - No scheduling request is expected; and
-      // - Data is valid (invalid data does not make sense to decode).
-      if (uci_cfg_total_ack > 0 && cfg->format == SRSRAN_PUCCH_FORMAT_1B &&
-          cfg->ack_nack_feedback_mode == SRSRAN_PUCCH_ACK_NACK_FEEDBACK_MODE_CS &&
-          !cfg->uci_cfg.is_scheduling_request_tti && pucch_res.uci_data.ack.valid) {
-        uint8_t b[2] = {pucch_res.uci_data.ack.ack_value[0], pucch_res.uci_data.ack.ack_value[1]};
-        srsran_pucch_cs_get_ack(cfg, &cfg->uci_cfg, i, b, &pucch_res.uci_data);
+      // Copy measurements, they are kept only if the resource is selected
+      if (cfg->meas_ta_en) {
+        pucch_res.ta_valid = !(isnan(q->chest_res.ta_us) || isinf(q->chest_res.ta_us));
+        pucch_res.ta_us    = q->chest_res.ta_us;
       }
 
-      // Compares correlation value, it stores the PUCCH result with the greatest correlation
-      if (i == 0 || pucch_res.correlation > res->correlation) {
-        // Copy measurements only if PUCCH was decoded successfully
-        if (cfg->meas_ta_en) {
-          pucch_res.ta_valid = !(isnan(q->chest_res.ta_us) || isinf(q->chest_res.ta_us));
-          pucch_res.ta_us    = q->chest_res.ta_us;
-        }
-
-        *res = pucch_res;
-      }
+      select_pucch_res(cfg, i, &pucch_res, res);
     }
   }
 
@@ -258,14 +305,106 @@ int srsran_enb_ul_get_pucch(srsran_enb_ul_t*    q,
       return SRSRAN_ERROR;
     }
 
-    // Override PUCCH result if PUCCH without SR was detected, and
-    // - no PUCCH with SR was detected; or
-    // - PUCCH without SR has better correlation
-    if (res_no_sr.detected && (!res->detected || res_no_sr.correlation > res->correlation)) {
-      *res = res_no_sr;
-    } else {
-      // If the PUCCH decode result is not overridden, flag SR
-      cfg->uci_cfg.is_scheduling_request_tti = true;
+    select_pucch_res_no_sr(cfg, res, &res_no_sr);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Appends the possible PUCCH resources of a configuration to the batch. Returns the number of resources, 0 if the
+ * configuration cannot be batched or SRSRAN_ERROR */
+static int pucch_batch_add(srsran_enb_ul_t* q, srsran_pucch_cfg_t* cfg, uint32_t ue_idx, uint32_t* nof_res)
+{
+  uint32_t           n_pucch_i[SRSRAN_PUCCH_MAX_ALLOC] = {};
+  srsran_pucch_cfg_t cfg_res                           = *cfg;
+
+  int nof_resources = get_pucch_resources(q, &cfg_res, n_pucch_i);
+  if (nof_resources < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // Only formats 1, 1a and 1b are batched
+  if (cfg_res.format != SRSRAN_PUCCH_FORMAT_1 && cfg_res.format != SRSRAN_PUCCH_FORMAT_1A &&
+      cfg_res.format != SRSRAN_PUCCH_FORMAT_1B) {
+    return 0;
+  }
+  if (*nof_res + nof_resources > SRSRAN_ENB_UL_PUCCH_BATCH_MAX_RES) {
+    return 0;
+  }
+
+  for (int i = 0; i < nof_resources; i++) {
+    cfg_res.n_pucch                  = n_pucch_i[i];
+    q->pucch_batch_cfg[*nof_res]     = cfg_res;
+    q->pucch_batch_ue[*nof_res]      = ue_idx;
+    q->pucch_batch_res_idx[*nof_res] = i;
+    (*nof_res)++;
+  }
+
+  return nof_resources;
+}
+
+int srsran_enb_ul_get_pucch_batch(srsran_enb_ul_t*    q,
+                                  srsran_ul_sf_cfg_t* ul_sf,
+                                  srsran_pucch_cfg_t* cfg,
+                                  srsran_pucch_res_t* res,
+                                  uint32_t            nof_cfg)
+{
+  if (q == NULL || ul_sf == NULL || (nof_cfg > 0 && (cfg == NULL || res == NULL))) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Collect the possible resources of all configurations, with and without SR. The rest are decoded one by one and the
+  // configurations that cannot be decoded are reported as not detected
+  uint32_t nof_res = 0;
+  for (uint32_t ue_idx = 0; ue_idx < nof_cfg; ue_idx++) {
+    res[ue_idx] = (srsran_pucch_res_t){};
+    if (!srsran_pucch_cfg_isvalid(&cfg[ue_idx], q->cell.nof_prb)) {
+      ERROR("Invalid PUCCH configuration rnti=0x%x", cfg[ue_idx].rnti);
+      continue;
+    }
+
+    uint32_t first_res = nof_res;
+    int      n         = pucch_batch_add(q, &cfg[ue_idx], ue_idx, &nof_res);
+    if (n > 0 && cfg[ue_idx].uci_cfg.is_scheduling_request_tti && srsran_uci_cfg_total_ack(&cfg[ue_idx].uci_cfg)) {
+      srsran_pucch_cfg_t cfg_no_sr                = cfg[ue_idx];
+      cfg_no_sr.uci_cfg.is_scheduling_request_tti = false;
+      n                                           = pucch_batch_add(q, &cfg_no_sr, ue_idx, &nof_res);
+    }
+    if (n <= 0) {
+      nof_res = first_res;
+    }
+    if (n == 0 && srsran_enb_ul_get_pucch(q, ul_sf, &cfg[ue_idx], &res[ue_idx])) {
+      ERROR("Error getting PUCCH rnti=0x%x", cfg[ue_idx].rnti);
+      res[ue_idx] = (srsran_pucch_res_t){};
+    }
+  }
+
+  // Detect all resources at once
+  if (srsran_pucch_decode_format1_batch(
+          &q->pucch, ul_sf, q->pucch_batch_cfg, q->sf_symbols, q->pucch_batch_res, nof_res) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // Dispatch the results to each configuration, as srsran_enb_ul_get_pucch() does
+  for (uint32_t i = 0; i < nof_res;) {
+    uint32_t            ue_idx    = q->pucch_batch_ue[i];
+    bool                sr        = cfg[ue_idx].uci_cfg.is_scheduling_request_tti;
+    srsran_pucch_res_t  res_no_sr = {};
+    srsran_pucch_cfg_t* cfg_res   = NULL;
+
+    for (; i < nof_res && q->pucch_batch_ue[i] == ue_idx; i++) {
+      cfg_res = &q->pucch_batch_cfg[i];
+      if (sr && !cfg_res->uci_cfg.is_scheduling_request_tti) {
+        select_pucch_res(cfg_res, q->pucch_batch_res_idx[i], &q->pucch_batch_res[i], &res_no_sr);
+      } else {
+        select_pucch_res(cfg_res, q->pucch_batch_res_idx[i], &q->pucch_batch_res[i], &res[ue_idx]);
+      }
+    }
+
+    // Leave the configuration as the last decoded resource
+    cfg[ue_idx] = *cfg_res;
+    if (sr && !cfg_res->uci_cfg.is_scheduling_request_tti) {
+      select_pucch_res_no_sr(&cfg[ue_idx], &res[ue_idx], &res_no_sr);
     }
   }
 
@@ -277,7 +416,16 @@ int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
                             srsran_pusch_cfg_t* cfg,
                             srsran_pusch_res_t* res)
 {
-  srsran_chest_ul_estimate_pusch(&q->chest, ul_sf, cfg, q->sf_symbols, &q->chest_res);
+  return srsran_enb_ul_get_pusch_grid(q, q->sf_symbols, ul_sf, cfg, res);
+}
+
+int srsran_enb_ul_get_pusch_grid(srsran_enb_ul_t*    q,
+                                 cf_t*               sf_symbols,
+                                 srsran_ul_sf_cfg_t* ul_sf,
+                                 srsran_pusch_cfg_t* cfg,
+                                 srsran_pusch_res_t* res)
+{
+  srsran_chest_ul_estimate_pusch(&q->chest, ul_sf, cfg, sf_symbols, &q->chest_res);
 
-  return srsran_pusch_decode(&q->pusch, ul_sf, cfg, &q->chest_res, q->sf_symbols, res);
+  return srsran_pusch_decode(&q->pusch, ul_sf, cfg, &q->chest_res, sf_symbols, res);
 }
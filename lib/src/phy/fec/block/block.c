@@ -21,6 +21,7 @@
 
 #include "srsran/phy/fec/block/block.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 
 // The following MACRO enables/disables LUT for the decoder
@@ -55,26 +56,30 @@ static inline uint8_t encode_M_basis_seq_u16(uint16_t w, uint32_t bit_idx)
 #if USE_LUT
 // Encoded unpacked table
 static uint8_t block_unpacked_lut[1U << SRSRAN_FEC_BLOCK_MAX_NOF_BITS][SRSRAN_FEC_BLOCK_SIZE];
+#endif
 
-// LLR signed table
-static block_llr_t block_llr_lut[1U << SRSRAN_FEC_BLOCK_MAX_NOF_BITS][SRSRAN_FEC_BLOCK_SIZE];
+// Maximum likelihood decoder of the (32, O) code
+static srsran_block_rm_t block_rm_32 srsran_simd_aligned;
 
-// Initialization function, as the table is read-only after initialization, it can be initialised from constructor
+// Initialization function, as the tables are read-only after initialization, they can be initialised from constructor
 __attribute__((constructor)) static void srsran_block_init()
 {
+#if USE_LUT
   for (uint32_t word = 0; word < (1U << SRSRAN_FEC_BLOCK_MAX_NOF_BITS); word++) {
     for (uint32_t i = 0; i < SRSRAN_FEC_BLOCK_SIZE; i++) {
-      uint8_t e = encode_M_basis_seq_u16(word, i);
       // Encoded unpacked byte
-      block_unpacked_lut[word][i] = e;
-
-      // Encoded LLR
-      block_llr_lut[word][i] = (block_llr_t)e * 2 - 1;
+      block_unpacked_lut[word][i] = encode_M_basis_seq_u16(word, i);
     }
   }
-}
 #endif
 
+  uint16_t basis_seq[SRSRAN_FEC_BLOCK_SIZE];
+  for (uint32_t i = 0; i < SRSRAN_FEC_BLOCK_SIZE; i++) {
+    basis_seq[i] = (uint16_t)M_basis_seq_b[i];
+  }
+  srsran_block_rm_init(&block_rm_32, basis_seq, SRSRAN_FEC_BLOCK_SIZE, SRSRAN_FEC_BLOCK_MAX_NOF_BITS, false);
+}
+
 void srsran_block_encode(const uint8_t* input, uint32_t input_len, uint8_t* output, uint32_t output_len)
 {
   if (!input || !output) {
@@ -110,41 +115,192 @@ void srsran_block_encode(const uint8_t* input, uint32_t input_len, uint8_t* outp
 #endif // USE_LUT
 }
 
-static int32_t block_decode(const block_llr_t* llr, uint8_t* data, uint32_t data_len)
+// Number of transform bins, the linear part of the code takes 5 bits
+#define BLOCK_RM_NOF_BINS 32U
+#define BLOCK_RM_NOF_LIN 5U
+
+// Number of masks transformed at once, it is a multiple of every SIMD size
+#define BLOCK_RM_BATCH 16U
+
+static inline uint32_t block_parity(uint32_t d)
 {
-  int32_t  max_corr = 0; //< Stores maximum correlation
-  uint32_t max_data = 0; //< Stores the word for maximum correlation
+  d ^= d >> 8UL;
+  d ^= d >> 4UL;
+  d &= 0xFUL;
+  return (0x6996U >> d) & 1U;
+}
 
-  // Limit data to maximum
-  data_len = SRSRAN_MIN(data_len, SRSRAN_FEC_BLOCK_MAX_NOF_BITS);
+int srsran_block_rm_init(srsran_block_rm_t* q,
+                         const uint16_t*    basis_seq,
+                         uint32_t           nof_rows,
+                         uint32_t           nof_bits,
+                         bool               msb_first)
+{
+  if (q == NULL || basis_seq == NULL || nof_rows > BLOCK_RM_NOF_BINS || nof_bits > SRSRAN_FEC_BLOCK_RM_MAX_NOF_BITS) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-  // Brute force all possible sequences
-  uint16_t max_guess = (1U << data_len); //< Maximum guess bit combination (excluded)
-  for (uint16_t guess = 0; guess < max_guess; guess++) {
-    int32_t corr = 0;
-#if USE_LUT
-    // Load sequence from LUT
-    // Dot product
-    for (uint32_t i = 0; i < SRSRAN_FEC_BLOCK_SIZE; i++) {
-      corr += llr[i] * block_llr_lut[guess][i];
+  q->nof_rows  = nof_rows;
+  q->nof_bits  = nof_bits;
+  q->msb_first = msb_first;
+
+  // Every codeword bit is assigned to the bin given by the linear basis sequences
+  for (uint32_t p = 0; p < BLOCK_RM_NOF_BINS; p++) {
+    q->bin_row[p] = -1;
+  }
+  for (uint32_t i = 0; i < nof_rows; i++) {
+    uint32_t p = (basis_seq[i] >> 1U) & (BLOCK_RM_NOF_BINS - 1);
+    if ((basis_seq[i] & 1U) == 0 || q->bin_row[p] >= 0) {
+      ERROR("Basis sequences are not based on a first order Reed-Muller code");
+      return SRSRAN_ERROR;
     }
-#else
-    for (uint32_t i = 0; i < SRSRAN_FEC_BLOCK_SIZE; i++) {
-      // On-the-fly sequence generation and product
-      corr += llr[i] * (encode_M_basis_seq_u16(guess, i) * 2 - 1);
+    q->bin_row[p] = (int32_t)i;
+  }
+
+  // Precompute the sign of every bin for every combination of the remaining basis sequences
+  for (uint32_t p = 0; p < BLOCK_RM_NOF_BINS; p++) {
+    for (uint32_t m = 0; m < SRSRAN_FEC_BLOCK_RM_NOF_MASKS; m++) {
+      q->bin_sign[p][m] = 0;
+      if (q->bin_row[p] >= 0 && block_parity((basis_seq[q->bin_row[p]] >> (BLOCK_RM_NOF_LIN + 1U)) & m)) {
+        q->bin_sign[p][m] = -1;
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+// Computes the transform of the LLRs multiplied by the sign of nof_masks masks starting at the given one
+static void block_rm_transform(const srsran_block_rm_t* q,
+                               const int32_t            llr_bin[BLOCK_RM_NOF_BINS],
+                               uint32_t                 mask,
+                               uint32_t                 nof_masks,
+                               int32_t                  v[BLOCK_RM_NOF_BINS][BLOCK_RM_BATCH])
+{
+  uint32_t j = 0;
+
+#if SRSRAN_SIMD_I_SIZE
+  // Every lane transforms a different mask
+  for (; j < nof_masks; j += SRSRAN_SIMD_I_SIZE) {
+    simd_i_t r[BLOCK_RM_NOF_BINS];
+
+    // (x ^ s) - s negates x when the sign mask s is -1
+    for (uint32_t p = 0; p < BLOCK_RM_NOF_BINS; p++) {
+      simd_i_t s = srsran_simd_i_load((int*)&q->bin_sign[p][mask + j]);
+      r[p]       = srsran_simd_i_sub(srsran_simd_i_xor(srsran_simd_i_set1(llr_bin[p]), s), s);
     }
-#endif
 
-    // Take decision
-    if (corr > max_corr) {
-      max_corr = corr;
-      max_data = guess;
+    for (uint32_t len = 1; len < BLOCK_RM_NOF_BINS; len <<= 1U) {
+      for (uint32_t i = 0; i < BLOCK_RM_NOF_BINS; i += 2 * len) {
+        for (uint32_t k = i; k < i + len; k++) {
+          simd_i_t a = r[k];
+          simd_i_t b = r[k + len];
+          r[k]       = srsran_simd_i_add(a, b);
+          r[k + len] = srsran_simd_i_sub(a, b);
+        }
+      }
+    }
+
+    for (uint32_t p = 0; p < BLOCK_RM_NOF_BINS; p++) {
+      srsran_simd_i_store((int*)&v[p][j], r[p]);
+    }
+  }
+#endif /* SRSRAN_SIMD_I_SIZE */
+
+  for (; j < nof_masks; j++) {
+    for (uint32_t p = 0; p < BLOCK_RM_NOF_BINS; p++) {
+      int32_t s = q->bin_sign[p][mask + j];
+      v[p][j]   = (llr_bin[p] ^ s) - s;
+    }
+
+    for (uint32_t len = 1; len < BLOCK_RM_NOF_BINS; len <<= 1U) {
+      for (uint32_t i = 0; i < BLOCK_RM_NOF_BINS; i += 2 * len) {
+        for (uint32_t k = i; k < i + len; k++) {
+          int32_t a     = v[k][j];
+          int32_t b     = v[k + len][j];
+          v[k][j]       = a + b;
+          v[k + len][j] = a - b;
+        }
+      }
+    }
+  }
+}
+
+static inline uint32_t block_rm_word_key(const srsran_block_rm_t* q, uint32_t word)
+{
+  if (!q->msb_first) {
+    return word;
+  }
+
+  uint32_t key = 0;
+  for (uint32_t n = 0; n < q->nof_bits; n++) {
+    key |= ((word >> n) & 1U) << (q->nof_bits - 1 - n);
+  }
+  return key;
+}
+
+int32_t srsran_block_rm_decode(const srsran_block_rm_t* q, const int16_t* llr, uint8_t* data, uint32_t data_len)
+{
+  srsran_simd_aligned int32_t v[BLOCK_RM_NOF_BINS][BLOCK_RM_BATCH];
+  int32_t                     llr_bin[BLOCK_RM_NOF_BINS];
+
+  data_len = SRSRAN_MIN(data_len, q->nof_bits);
+
+  // Data bit 0 selects the all ones sequence, the next 5 the transform output and the rest the mask
+  uint32_t nof_ones  = data_len > 0 ? 2 : 1;
+  uint32_t nof_lin   = 1U << SRSRAN_MIN(data_len > 0 ? data_len - 1 : 0, BLOCK_RM_NOF_LIN);
+  uint32_t nof_masks = 1U << (data_len > BLOCK_RM_NOF_LIN + 1 ? data_len - BLOCK_RM_NOF_LIN - 1 : 0);
+
+  for (uint32_t p = 0; p < BLOCK_RM_NOF_BINS; p++) {
+    llr_bin[p] = q->bin_row[p] < 0 ? 0 : llr[q->bin_row[p]];
+  }
+
+  int32_t  max_corr = INT32_MIN;
+  uint32_t max_word = 0;
+  uint32_t max_key  = 0;
+  for (uint32_t mask = 0; mask < nof_masks; mask += BLOCK_RM_BATCH) {
+    uint32_t n = SRSRAN_MIN(nof_masks - mask, BLOCK_RM_BATCH);
+    block_rm_transform(q, llr_bin, mask, n, v);
+
+    // The LLR are positive for ones, the correlation with the word is the opposite of the transform if the all ones
+    // sequence is not selected
+    for (uint32_t a = 0; a < nof_lin; a++) {
+      for (uint32_t j = 0; j < n; j++) {
+        for (uint32_t c = 0; c < nof_ones; c++) {
+          int32_t corr = c ? v[a][j] : -v[a][j];
+          if (corr < max_corr) {
+            continue;
+          }
+          uint32_t word = c | (a << 1U) | ((mask + j) << (BLOCK_RM_NOF_LIN + 1U));
+          uint32_t key  = block_rm_word_key(q, word);
+          if (corr > max_corr || key < max_key) {
+            max_corr = corr;
+            max_word = word;
+            max_key  = key;
+          }
+        }
+      }
     }
   }
 
   // Bit unpack (reversed)
   for (uint32_t i = 0; i < data_len; i++) {
-    data[i] = (uint8_t)((max_data >> i) & 1U);
+    data[i] = (uint8_t)((max_word >> i) & 1U);
+  }
+
+  return max_corr;
+}
+
+static int32_t block_decode(const block_llr_t* llr, uint8_t* data, uint32_t data_len)
+{
+  // Limit data to maximum
+  data_len = SRSRAN_MIN(data_len, SRSRAN_FEC_BLOCK_MAX_NOF_BITS);
+
+  // Words with no positive correlation decode as zeros
+  int32_t max_corr = srsran_block_rm_decode(&block_rm_32, llr, data, data_len);
+  if (max_corr <= 0) {
+    srsran_vec_u8_zero(data, data_len);
+    max_corr = 0;
   }
 
   // Return correlation
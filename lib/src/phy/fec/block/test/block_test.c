@@ -19,6 +19,7 @@
  *
  */
 #include "srsran/phy/fec/block/block.h"
+#include "srsran/phy/phch/uci.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/random.h"
 #include "srsran/support/srsran_test.h"
@@ -130,6 +131,83 @@ int test(uint32_t block_size)
   return SRSRAN_SUCCESS;
 }
 
+// Generates random LLRs, the small range produces correlation ties
+static void random_llr(int16_t* llr, uint32_t nof_llr, int32_t range)
+{
+  for (uint32_t i = 0; i < nof_llr; i++) {
+    llr[i] = (int16_t)srsran_random_uniform_int_dist(random_gen, -range, range);
+  }
+}
+
+// The fast decoder selects the same word as correlating the LLRs with every (32, O) codeword
+int test_noisy(uint32_t block_size, int32_t range)
+{
+  uint8_t data[SRSRAN_FEC_BLOCK_MAX_NOF_BITS]     = {};
+  uint8_t rx[SRSRAN_FEC_BLOCK_MAX_NOF_BITS]       = {};
+  uint8_t max_data[SRSRAN_FEC_BLOCK_MAX_NOF_BITS] = {};
+  uint8_t encoded[SRSRAN_FEC_BLOCK_SIZE]          = {};
+  int16_t llr[SRSRAN_FEC_BLOCK_SIZE]              = {};
+
+  random_llr(llr, SRSRAN_FEC_BLOCK_SIZE, range);
+
+  int32_t max_corr = 0;
+  for (uint32_t w = 0; w < (1U << block_size); w++) {
+    for (uint32_t i = 0; i < block_size; i++) {
+      data[i] = (uint8_t)((w >> i) & 1U);
+    }
+    srsran_block_encode(data, block_size, encoded, SRSRAN_FEC_BLOCK_SIZE);
+
+    int32_t corr = 0;
+    for (uint32_t i = 0; i < SRSRAN_FEC_BLOCK_SIZE; i++) {
+      corr += encoded[i] ? llr[i] : -llr[i];
+    }
+    if (corr > max_corr) {
+      max_corr = corr;
+      memcpy(max_data, data, block_size);
+    }
+  }
+
+  TESTASSERT(srsran_block_decode_i16(llr, SRSRAN_FEC_BLOCK_SIZE, rx, block_size) == max_corr);
+  TESTASSERT(memcmp(rx, max_data, block_size) == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+// The fast decoder selects the same word as correlating the LLRs with every (20, A) codeword
+int test_noisy_cqi_pucch(srsran_uci_cqi_pucch_t* q, uint32_t cqi_len, int32_t range)
+{
+  uint8_t data[SRSRAN_UCI_MAX_CQI_LEN_PUCCH]     = {};
+  uint8_t rx[SRSRAN_UCI_MAX_CQI_LEN_PUCCH]       = {};
+  uint8_t max_data[SRSRAN_UCI_MAX_CQI_LEN_PUCCH] = {};
+  uint8_t encoded[SRSRAN_UCI_CQI_CODED_PUCCH_B]  = {};
+  int16_t llr[SRSRAN_CQI_MAX_BITS]               = {};
+
+  random_llr(llr, SRSRAN_UCI_CQI_CODED_PUCCH_B, range);
+
+  // Words are visited with the first bit as the most significant
+  int32_t max_corr = INT32_MIN;
+  for (uint32_t w = 0; w < (1U << cqi_len); w++) {
+    for (uint32_t i = 0; i < cqi_len; i++) {
+      data[i] = (uint8_t)((w >> (cqi_len - 1 - i)) & 1U);
+    }
+    srsran_uci_encode_cqi_pucch(data, cqi_len, encoded);
+
+    int32_t corr = 0;
+    for (uint32_t i = 0; i < SRSRAN_UCI_CQI_CODED_PUCCH_B; i++) {
+      corr += encoded[i] ? llr[i] : -llr[i];
+    }
+    if (corr > max_corr) {
+      max_corr = corr;
+      memcpy(max_data, data, cqi_len);
+    }
+  }
+
+  TESTASSERT(srsran_uci_decode_cqi_pucch(q, llr, rx, cqi_len) == max_corr);
+  TESTASSERT(memcmp(rx, max_data, SRSRAN_UCI_MAX_CQI_LEN_PUCCH) == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   parse_args(argc, argv);
@@ -141,5 +219,22 @@ int main(int argc, char** argv)
     }
   }
 
+  for (uint32_t block_size = 1; block_size <= SRSRAN_FEC_BLOCK_MAX_NOF_BITS; block_size++) {
+    for (uint32_t r = 0; r < 20; r++) {
+      TESTASSERT(test_noisy(block_size, A) == SRSRAN_SUCCESS);
+      TESTASSERT(test_noisy(block_size, 2) == SRSRAN_SUCCESS);
+    }
+  }
+
+  srsran_uci_cqi_pucch_t cqi_pucch = {};
+  srsran_uci_cqi_pucch_init(&cqi_pucch);
+  for (uint32_t cqi_len = 1; cqi_len < SRSRAN_UCI_MAX_CQI_LEN_PUCCH; cqi_len++) {
+    for (uint32_t r = 0; r < 20; r++) {
+      TESTASSERT(test_noisy_cqi_pucch(&cqi_pucch, cqi_len, A) == SRSRAN_SUCCESS);
+      TESTASSERT(test_noisy_cqi_pucch(&cqi_pucch, cqi_len, 2) == SRSRAN_SUCCESS);
+    }
+  }
+  srsran_uci_cqi_pucch_free(&cqi_pucch);
+
   srsran_random_free(random_gen);
 }
@@ -97,6 +97,26 @@ void parse_args(int argc, char** argv)
     }                                                                                                                  \
   } while (0)
 
+// Decodes NOF_MULTI copies of the frame at once, counts the errors of the worst one
+#define NOF_MULTI (SRSRAN_VITERBI_MAX_MULTI + 1)
+#define VITERBI_TEST_MULTI(DEC, LLR, NOF_ERRORS)                                                                       \
+  do {                                                                                                                 \
+    float*   llr_multi[NOF_MULTI];                                                                                     \
+    uint32_t max_errors = 0;                                                                                           \
+    for (uint32_t k = 0; k < NOF_MULTI; k++) {                                                                         \
+      llr_multi[k] = LLR;                                                                                              \
+    }                                                                                                                  \
+    if (srsran_viterbi_decode_f_multi(&DEC, llr_multi, data_rx_multi, NOF_MULTI, frame_length) < SRSRAN_SUCCESS) {     \
+      NOF_ERRORS = SRSRAN_ERROR;                                                                                       \
+    }                                                                                                                  \
+    if (NOF_ERRORS >= 0) {                                                                                             \
+      for (uint32_t k = 0; k < NOF_MULTI; k++) {                                                                       \
+        max_errors = SRSRAN_MAX(max_errors, srsran_bit_diff(data_tx, data_rx_multi[k], frame_length));                 \
+      }                                                                                                                \
+      NOF_ERRORS += max_errors;                                                                                        \
+    }                                                                                                                  \
+  } while (0)
+
 //#define TEST_SSE
 
 int main(int argc, char** argv)
@@ -114,6 +134,8 @@ int main(int argc, char** argv)
   int       errors_c   = 0;
   int       errors_f   = 0;
   int       errors_sse = 0;
+  int       errors_m   = 0;
+  uint8_t*  data_rx_multi[NOF_MULTI];
 #ifdef TEST_SSE
   srsran_viterbi_t dec_sse;
 #endif
@@ -160,6 +182,14 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
+  for (uint32_t k = 0; k < NOF_MULTI; k++) {
+    data_rx_multi[k] = srsran_vec_u8_malloc(frame_length);
+    if (!data_rx_multi[k]) {
+      perror("malloc");
+      exit(-1);
+    }
+  }
+
   symbols = srsran_vec_u8_malloc(coded_length);
   if (!symbols) {
     perror("malloc");
@@ -209,6 +239,7 @@ int main(int argc, char** argv)
     errors_c   = 0;
     errors_f   = 0;
     errors_sse = 0;
+    errors_m   = 0;
     while (frame_cnt < nof_frames) {
       /* generate data_tx */
       srsran_random_t random_gen = srsran_random_init(0);
@@ -241,6 +272,7 @@ int main(int argc, char** argv)
       VITERBI_TEST(srsran_viterbi_decode_us, dec, llr_us, errors_us);
       VITERBI_TEST(srsran_viterbi_decode_uc, dec, llr_c, errors_c);
       VITERBI_TEST(srsran_viterbi_decode_f, dec, llr, errors_f);
+      VITERBI_TEST_MULTI(dec, llr, errors_m);
 #ifdef TEST_SSE
       VITERBI_TEST(srsran_viterbi_decode_uc, dec_sse, llr_c, errors_sse);
 #endif
@@ -254,6 +286,8 @@ int main(int argc, char** argv)
         printf("uint8  BER: %.2e  ", (float)errors_c / (frame_cnt * frame_length));
       if (errors_f >= 0)
         printf("float  BER: %.2e  ", (float)errors_f / (frame_cnt * frame_length));
+      if (errors_m >= 0)
+        printf("multi  BER: %.2e  ", (float)errors_m / (frame_cnt * frame_length));
 #ifdef TEST_SSE
       printf("sse    BER: %.2e  ", (float)errors_sse / (frame_cnt * frame_length));
 #endif
@@ -270,6 +304,8 @@ int main(int argc, char** argv)
         printf("uint8  BER    :    %g\t%u errors\n", (float)errors_c / (frame_cnt * frame_length), errors_c);
       if (errors_f >= 0)
         printf("float  BER    :    %g\t%u errors\n", (float)errors_f / (frame_cnt * frame_length), errors_f);
+      if (errors_m >= 0)
+        printf("multi  BER    :    %g\t%u errors\n", (float)errors_m / (frame_cnt * frame_length), errors_m);
 #ifdef TEST_SSE
       printf("sse    BER    :    %g\t%u errors\n", (float)errors_sse / (frame_cnt * frame_length), errors_sse);
 #endif
@@ -287,6 +323,9 @@ int main(int argc, char** argv)
   free(llr_s);
   free(llr_us);
   free(data_rx);
+  for (uint32_t k = 0; k < NOF_MULTI; k++) {
+    free(data_rx_multi[k]);
+  }
 
   if (snr_points == 1) {
     int expected_e = get_expected_errors(nof_frames, seed, frame_length, tail_biting, ebno_db);
@@ -294,14 +333,21 @@ int main(int argc, char** argv)
       ERROR("Test parameters not defined in test_results.h");
       exit(-1);
     } else {
-      printf(
-          "errors =(%d,%d,%d,%d,%d), expected =%d\n", errors_s, errors_us, errors_c, errors_f, errors_sse, expected_e);
+      printf("errors =(%d,%d,%d,%d,%d,%d), expected =%d\n",
+             errors_s,
+             errors_us,
+             errors_c,
+             errors_f,
+             errors_sse,
+             errors_m,
+             expected_e);
       bool passed = true;
       passed &= (bool)(errors_us <= expected_e);
       passed &= (bool)(errors_s <= expected_e);
       passed &= (bool)(errors_c <= expected_e);
       passed &= (bool)(errors_f <= expected_e);
       passed &= (bool)(errors_sse <= expected_e);
+      passed &= (bool)(errors_m <= expected_e);
       exit(!passed);
     }
   } else {
@@ -217,6 +217,107 @@ void free37_avx2(void* o)
 
 #endif
 
+#ifdef LV_HAVE_AVX512
+int decode37_avx512_16bit(void* o, uint16_t* symbols, uint8_t* data, uint32_t frame_length)
+{
+  srsran_viterbi_t* q = o;
+
+  uint32_t best_state;
+
+  if (frame_length > q->framebits) {
+    ERROR("Initialized decoder for max frame length %d bits", q->framebits);
+    return -1;
+  }
+
+  /* Initialize Viterbi decoder */
+  init_viterbi37_avx512_16bit(q->ptr, q->tail_biting ? -1 : 0);
+
+  /* Decode block */
+  if (q->tail_biting) {
+    for (int i = 0; i < TB_ITER; i++) {
+      memcpy(&q->tmp_s[i * 3 * frame_length], symbols, 3 * frame_length * sizeof(uint16_t));
+    }
+    update_viterbi37_blk_avx512_16bit(q->ptr, q->tmp_s, TB_ITER * frame_length, &best_state);
+    /* The chainback looks 6 decisions past the tail, start it from the last decision computed */
+    chainback_viterbi37_avx512_16bit(q->ptr, q->tmp, TB_ITER * frame_length - 6, best_state);
+    memcpy(data, &q->tmp[((int)(TB_ITER / 2)) * frame_length], frame_length * sizeof(uint8_t));
+  } else {
+    update_viterbi37_blk_avx512_16bit(q->ptr, symbols, frame_length + q->K - 1, NULL);
+    chainback_viterbi37_avx512_16bit(q->ptr, data, frame_length, 0);
+  }
+
+  return q->framebits;
+}
+
+int decode37_avx512_16bit_multi(void*      o,
+                                uint16_t** symbols,
+                                uint8_t**  data,
+                                uint32_t   nof_frames,
+                                uint32_t   frame_length)
+{
+  srsran_viterbi_t* q = o;
+
+  uint32_t best_state[SRSRAN_VITERBI_MAX_MULTI];
+
+  if (frame_length > q->framebits || nof_frames > SRSRAN_VITERBI_MAX_MULTI) {
+    ERROR("Initialized decoder for max frame length %d bits and %d frames", q->framebits, SRSRAN_VITERBI_MAX_MULTI);
+    return -1;
+  }
+
+  /* Initialize Viterbi decoders */
+  for (uint32_t f = 0; f < nof_frames; f++) {
+    init_viterbi37_avx512_16bit(q->ptr_multi[f], q->tail_biting ? -1 : 0);
+  }
+
+  /* Decode blocks, every frame uses its own slice of the temporal buffers */
+  if (q->tail_biting) {
+    uint16_t* tmp_s[SRSRAN_VITERBI_MAX_MULTI];
+    for (uint32_t f = 0; f < nof_frames; f++) {
+      tmp_s[f] = &q->tmp_s[f * TB_ITER * 3 * (q->framebits + q->K - 1)];
+      for (int i = 0; i < TB_ITER; i++) {
+        memcpy(&tmp_s[f][i * 3 * frame_length], symbols[f], 3 * frame_length * sizeof(uint16_t));
+      }
+    }
+    update_viterbi37_blk_multi_avx512_16bit(q->ptr_multi, tmp_s, nof_frames, TB_ITER * frame_length, best_state);
+    for (uint32_t f = 0; f < nof_frames; f++) {
+      uint8_t* tmp = &q->tmp[f * TB_ITER * 3 * (q->framebits + q->K - 1)];
+      chainback_viterbi37_avx512_16bit(q->ptr_multi[f], tmp, TB_ITER * frame_length - 6, best_state[f]);
+      memcpy(data[f], &tmp[((int)(TB_ITER / 2)) * frame_length], frame_length * sizeof(uint8_t));
+    }
+  } else {
+    update_viterbi37_blk_multi_avx512_16bit(q->ptr_multi, symbols, nof_frames, frame_length + q->K - 1, NULL);
+    for (uint32_t f = 0; f < nof_frames; f++) {
+      chainback_viterbi37_avx512_16bit(q->ptr_multi[f], data[f], frame_length, 0);
+    }
+  }
+
+  return q->framebits;
+}
+
+void free37_avx512_16bit(void* o)
+{
+  srsran_viterbi_t* q = o;
+
+  if (q->symbols_uc) {
+    free(q->symbols_uc);
+  }
+  if (q->symbols_us) {
+    free(q->symbols_us);
+  }
+  if (q->tmp) {
+    free(q->tmp);
+  }
+  if (q->tmp_s) {
+    free(q->tmp_s);
+  }
+  // ptr is ptr_multi[0]
+  for (uint32_t f = 0; f < SRSRAN_VITERBI_MAX_MULTI; f++) {
+    delete_viterbi37_avx512_16bit(q->ptr_multi[f]);
+  }
+}
+
+#endif
+
 #ifdef HAVE_NEON
 int decode37_neon(void* o, uint8_t* symbols, uint8_t* data, uint32_t frame_length)
 {
@@ -471,6 +572,54 @@ int init37_avx2_16bit(srsran_viterbi_t* q, int poly[3], uint32_t framebits, bool
 
 #endif
 
+#ifdef LV_HAVE_AVX512
+int init37_avx512_16bit(srsran_viterbi_t* q, int poly[3], uint32_t framebits, bool tail_biting)
+{
+  q->K              = 7;
+  q->R              = 3;
+  q->framebits      = framebits;
+  q->gain_quant_s   = 4;
+  q->gain_quant     = DEFAULT_GAIN_16;
+  q->tail_biting    = tail_biting;
+  q->decode_s       = decode37_avx512_16bit;
+  q->decode_s_multi = decode37_avx512_16bit_multi;
+  q->free           = free37_avx512_16bit;
+  q->decode_f       = NULL;
+
+  /* The symbols and temporal buffers hold one frame for each of the decoders in ptr_multi */
+  uint32_t nof_symbols = 3 * (q->framebits + q->K - 1);
+  q->symbols_uc        = srsran_vec_u8_malloc(nof_symbols);
+  q->symbols_us        = srsran_vec_u16_malloc(SRSRAN_VITERBI_MAX_MULTI * nof_symbols);
+  if (!q->symbols_uc || !q->symbols_us) {
+    perror("malloc");
+    free37_avx512_16bit(q);
+    return -1;
+  }
+  if (q->tail_biting) {
+    q->tmp   = srsran_vec_u8_malloc(SRSRAN_VITERBI_MAX_MULTI * TB_ITER * nof_symbols);
+    q->tmp_s = srsran_vec_u16_malloc(SRSRAN_VITERBI_MAX_MULTI * TB_ITER * nof_symbols);
+    if (!q->tmp || !q->tmp_s) {
+      perror("malloc");
+      free37_avx512_16bit(q);
+      return -1;
+    }
+  } else {
+    q->tmp = NULL;
+  }
+
+  for (uint32_t f = 0; f < SRSRAN_VITERBI_MAX_MULTI; f++) {
+    if ((q->ptr_multi[f] = create_viterbi37_avx512_16bit(poly, TB_ITER * framebits)) == NULL) {
+      ERROR("create_viterbi37 failed");
+      free37_avx512_16bit(q);
+      return -1;
+    }
+  }
+  q->ptr = q->ptr_multi[0];
+
+  return 0;
+}
+#endif
+
 void srsran_viterbi_set_gain_quant(srsran_viterbi_t* q, float gain_quant)
 {
   q->gain_quant = gain_quant;
@@ -492,7 +641,9 @@ int srsran_viterbi_init(srsran_viterbi_t*     q,
     case SRSRAN_VITERBI_37:
 #ifdef LV_HAVE_SSE
 
-#ifdef LV_HAVE_AVX2
+#ifdef LV_HAVE_AVX512
+      return init37_avx512_16bit(q, poly, max_frame_length, tail_bitting);
+#elif defined(LV_HAVE_AVX2)
 #ifdef VITERBI_16
       return init37_avx2_16bit(q, poly, max_frame_length, tail_bitting);
 #else
@@ -536,6 +687,18 @@ int srsran_viterbi_init_avx2(srsran_viterbi_t*     q,
 }
 #endif
 
+#ifdef LV_HAVE_AVX512
+int srsran_viterbi_init_avx512(srsran_viterbi_t*     q,
+                               srsran_viterbi_type_t type,
+                               int                   poly[3],
+                               uint32_t              max_frame_length,
+                               bool                  tail_bitting)
+{
+  bzero(q, sizeof(srsran_viterbi_t));
+  return init37_avx512_16bit(q, poly, max_frame_length, tail_bitting);
+}
+#endif
+
 void srsran_viterbi_free(srsran_viterbi_t* q)
 {
   if (q->free) {
@@ -604,6 +767,65 @@ int srsran_viterbi_decode_s(srsran_viterbi_t* q, int16_t* symbols, uint8_t* data
 #endif
 }
 
+int srsran_viterbi_decode_f_multi(srsran_viterbi_t* q,
+                                  float**           symbols,
+                                  uint8_t**         data,
+                                  uint32_t          nof_frames,
+                                  uint32_t          frame_length)
+{
+  int ret = SRSRAN_ERROR;
+
+  if (q == NULL || symbols == NULL || data == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Without a multi-frame decoder, decode the frames one by one
+  if (q->decode_s_multi == NULL) {
+    for (uint32_t f = 0; f < nof_frames; f++) {
+      ret = srsran_viterbi_decode_f(q, symbols[f], data[f], frame_length);
+      if (ret < SRSRAN_SUCCESS) {
+        return ret;
+      }
+    }
+    return ret;
+  }
+
+  if (frame_length > q->framebits) {
+    ERROR("Initialized decoder for max frame length %d bits", q->framebits);
+    return -1;
+  }
+
+  uint32_t len;
+  if (q->tail_biting) {
+    len = 3 * frame_length;
+  } else {
+    len = 3 * (frame_length + q->K - 1);
+  }
+
+  for (uint32_t f0 = 0; f0 < nof_frames; f0 += SRSRAN_VITERBI_MAX_MULTI) {
+    uint32_t  n = SRSRAN_MIN(nof_frames - f0, SRSRAN_VITERBI_MAX_MULTI);
+    uint16_t* symbols_us[SRSRAN_VITERBI_MAX_MULTI];
+
+    // Quantize every frame with its own gain, in the same way srsran_viterbi_decode_f() does
+    for (uint32_t f = 0; f < n; f++) {
+      float    max   = 1e-9;
+      uint32_t max_i = srsran_vec_max_abs_fi(symbols[f0 + f], len);
+      if (max_i < len && isnormal(symbols[f0 + f][max_i])) {
+        max = fabsf(symbols[f0 + f][max_i]);
+      }
+      symbols_us[f] = &q->symbols_us[f * 3 * (q->framebits + q->K - 1)];
+      srsran_vec_quant_fus(symbols[f0 + f], symbols_us[f], q->gain_quant / max, 32767.5, 65535, len);
+    }
+
+    ret = q->decode_s_multi(q, symbols_us, &data[f0], n, frame_length);
+    if (ret < SRSRAN_SUCCESS) {
+      return ret;
+    }
+  }
+
+  return ret;
+}
+
 int srsran_viterbi_decode_us(srsran_viterbi_t* q, uint16_t* symbols, uint8_t* data, uint32_t frame_length)
 {
   int ret = SRSRAN_ERROR;
@@ -82,4 +82,23 @@ void delete_viterbi37_avx2_16bit(void* p);
 
 int update_viterbi37_blk_avx2_16bit(void* p, uint16_t* syms, uint32_t nbits, uint32_t* best_state);
 
+/* Maximum number of frames decoded at once by update_viterbi37_blk_multi_avx512_16bit() */
+#define VITERBI37_AVX512_MAX_FRAMES 4
+
+void* create_viterbi37_avx512_16bit(int polys[3], uint32_t len);
+
+int init_viterbi37_avx512_16bit(void* p, int starting_state);
+
+int chainback_viterbi37_avx512_16bit(void* p, uint8_t* data, uint32_t nbits, uint32_t endstate);
+
+void delete_viterbi37_avx512_16bit(void* p);
+
+int update_viterbi37_blk_avx512_16bit(void* p, uint16_t* syms, uint32_t nbits, uint32_t* best_state);
+
+int update_viterbi37_blk_multi_avx512_16bit(void**     p,
+                                            uint16_t** syms,
+                                            uint32_t   nof_frames,
+                                            uint32_t   nbits,
+                                            uint32_t*  best_state);
+
 #endif /* SRSRAN_VITERBI37_H_ */
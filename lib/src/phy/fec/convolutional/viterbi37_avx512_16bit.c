@@ -0,0 +1,282 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "parity.h"
+#include "viterbi37.h"
+
+#ifdef LV_HAVE_AVX512
+
+#include <immintrin.h>
+
+/*
+ * 16-bit K=7 r=1/3 decoder. The 64 path metrics take two AVX512 registers, the states 0 to 31 in the first one and 32
+ * to 63 in the second one, so all the 32 butterflies of a bit are computed at once. The decisions are stored with the
+ * even states in w[0] and the odd states in w[1], as they come out of the mask compares.
+ */
+
+typedef union {
+  uint16_t c[64];
+  __m512i  v[2];
+} metric_t;
+
+typedef union {
+  uint32_t w[2];
+  uint8_t  c[8];
+} decision_t;
+
+static union branchtab37 {
+  uint16_t c[32];
+  __m512i  v;
+} Branchtab37_avx512[3];
+
+/* State info for instance of Viterbi decoder */
+struct v37 {
+  metric_t    metrics;   /* path metrics */
+  decision_t* dp;        /* Pointer to current decision */
+  decision_t* decisions; /* Beginning of decisions for block */
+  uint32_t    len;
+};
+
+static void set_viterbi37_polynomial_avx512_16bit(int polys[3])
+{
+  for (int state = 0; state < 32; state++) {
+    Branchtab37_avx512[0].c[state] = (polys[0] < 0) ^ parity((2 * state) & polys[0]) ? UINT16_MAX : 0;
+    Branchtab37_avx512[1].c[state] = (polys[1] < 0) ^ parity((2 * state) & polys[1]) ? UINT16_MAX : 0;
+    Branchtab37_avx512[2].c[state] = (polys[2] < 0) ^ parity((2 * state) & polys[2]) ? UINT16_MAX : 0;
+  }
+}
+
+/* Initialize Viterbi decoder for start of new frame */
+int init_viterbi37_avx512_16bit(void* p, int starting_state)
+{
+  struct v37* vp = p;
+
+  for (uint32_t i = 0; i < 64; i++) {
+    vp->metrics.c[i] = 63;
+  }
+  if (starting_state != -1) {
+    vp->metrics.c[starting_state & 63] = 0; /* Bias known start state */
+  }
+
+  vp->dp = vp->decisions;
+  return 0;
+}
+
+/* Create a new instance of a Viterbi decoder */
+void* create_viterbi37_avx512_16bit(int polys[3], uint32_t len)
+{
+  void*       p;
+  struct v37* vp;
+
+  set_viterbi37_polynomial_avx512_16bit(polys);
+
+  if (posix_memalign(&p, sizeof(__m512i), sizeof(struct v37))) {
+    return NULL;
+  }
+
+  vp = (struct v37*)p;
+  if (posix_memalign(&p, sizeof(__m512i), (len + 6) * sizeof(decision_t))) {
+    free(vp);
+    return NULL;
+  }
+  vp->decisions = (decision_t*)p;
+  vp->len       = len + 6;
+  return vp;
+}
+
+/* Viterbi chainback */
+int chainback_viterbi37_avx512_16bit(void*    p,
+                                     uint8_t* data,  /* Decoded output data */
+                                     uint32_t nbits, /* Number of data bits */
+                                     uint32_t endstate)
+{ /* Terminal encoder state */
+  struct v37* vp = p;
+
+  if (p == NULL) {
+    return -1;
+  }
+
+  decision_t* d = vp->decisions;
+
+  endstate %= 64;
+
+  d += 6; /* Look past tail */
+  while (nbits--) {
+    uint32_t k  = (d[nbits].w[endstate & 1] >> (endstate >> 1)) & 1;
+    endstate    = (endstate >> 1) | (k << 5);
+    data[nbits] = k;
+  }
+  return 0;
+}
+
+/* Delete instance of a Viterbi decoder */
+void delete_viterbi37_avx512_16bit(void* p)
+{
+  struct v37* vp = p;
+
+  if (vp != NULL) {
+    free(vp->decisions);
+    free(vp);
+  }
+}
+
+/* Add-compare-select of one bit, updates the path metrics of the states 0-31 (lo) and 32-63 (hi) */
+static inline void
+viterbi37_acs_avx512_16bit(__m512i* lo, __m512i* hi, const uint16_t* syms, decision_t* d, __m512i idx_lo, __m512i idx_hi)
+{
+  /* Form branch metrics */
+  __m512i m0     = _mm512_avg_epu16(_mm512_xor_si512(Branchtab37_avx512[0].v, _mm512_set1_epi16(syms[0])),
+                                _mm512_xor_si512(Branchtab37_avx512[1].v, _mm512_set1_epi16(syms[1])));
+  __m512i metric = _mm512_avg_epu16(_mm512_xor_si512(Branchtab37_avx512[2].v, _mm512_set1_epi16(syms[2])), m0);
+
+  metric           = _mm512_srli_epi16(metric, 3);
+  __m512i m_metric = _mm512_sub_epi16(_mm512_set1_epi16(8191), metric);
+
+  /* Add branch metrics to path metrics */
+  m0         = _mm512_add_epi16(*lo, metric);
+  __m512i m1 = _mm512_add_epi16(*hi, m_metric);
+  __m512i m2 = _mm512_add_epi16(*lo, m_metric);
+  __m512i m3 = _mm512_add_epi16(*hi, metric);
+
+  /* Compare and select, using modulo arithmetic */
+  __mmask32 decision0 = _mm512_cmpgt_epi16_mask(_mm512_sub_epi16(m0, m1), _mm512_setzero_si512());
+  __mmask32 decision1 = _mm512_cmpgt_epi16_mask(_mm512_sub_epi16(m2, m3), _mm512_setzero_si512());
+  __m512i   survivor0 = _mm512_mask_blend_epi16(decision0, m0, m1);
+  __m512i   survivor1 = _mm512_mask_blend_epi16(decision1, m2, m3);
+
+  d->w[0] = decision0;
+  d->w[1] = decision1;
+
+  /* The survivors are the even and odd states, interleave them */
+  *lo = _mm512_permutex2var_epi16(survivor0, idx_lo, survivor1);
+  *hi = _mm512_permutex2var_epi16(survivor0, idx_hi, survivor1);
+
+  /* See if we need to normalize */
+  if (_mm_extract_epi16(_mm512_castsi512_si128(*lo), 0) > 12288) {
+    __m256i adjust = _mm256_min_epu16(_mm512_castsi512_si256(*lo), _mm512_extracti64x4_epi64(*lo, 1));
+    adjust         = _mm256_min_epu16(adjust, _mm512_castsi512_si256(*hi));
+    adjust         = _mm256_min_epu16(adjust, _mm512_extracti64x4_epi64(*hi, 1));
+
+    __m128i adjust128 = _mm_min_epu16(_mm256_castsi256_si128(adjust), _mm256_extracti128_si256(adjust, 1));
+    __m512i adjustv   = _mm512_set1_epi16(_mm_extract_epi16(_mm_minpos_epu16(adjust128), 0));
+
+    *lo = _mm512_sub_epi16(*lo, adjustv);
+    *hi = _mm512_sub_epi16(*hi, adjustv);
+  }
+}
+
+static uint32_t viterbi37_best_state_avx512_16bit(struct v37* vp)
+{
+  uint32_t bst       = 0;
+  uint16_t minmetric = UINT16_MAX;
+  for (uint32_t i = 0; i < 64; i++) {
+    if (vp->metrics.c[i] <= minmetric) {
+      bst       = i;
+      minmetric = vp->metrics.c[i];
+    }
+  }
+  return bst;
+}
+
+/* Interleaving indexes of the even (first operand) and odd (second operand) state survivors */
+static const uint16_t viterbi37_avx512_idx[64] = {0,  32, 1,  33, 2,  34, 3,  35, 4,  36, 5,  37, 6,  38, 7,  39,
+                                                  8,  40, 9,  41, 10, 42, 11, 43, 12, 44, 13, 45, 14, 46, 15, 47,
+                                                  16, 48, 17, 49, 18, 50, 19, 51, 20, 52, 21, 53, 22, 54, 23, 55,
+                                                  24, 56, 25, 57, 26, 58, 27, 59, 28, 60, 29, 61, 30, 62, 31, 63};
+
+int update_viterbi37_blk_avx512_16bit(void* p, uint16_t* syms, uint32_t nbits, uint32_t* best_state)
+{
+  struct v37* vp = p;
+
+  if (p == NULL) {
+    return -1;
+  }
+
+  const __m512i idx_lo = _mm512_loadu_si512(&viterbi37_avx512_idx[0]);
+  const __m512i idx_hi = _mm512_loadu_si512(&viterbi37_avx512_idx[32]);
+
+  decision_t* d  = vp->dp;
+  __m512i     lo = vp->metrics.v[0];
+  __m512i     hi = vp->metrics.v[1];
+
+  for (uint32_t i = 0; i < nbits; i++) {
+    viterbi37_acs_avx512_16bit(&lo, &hi, &syms[3 * i], &d[i], idx_lo, idx_hi);
+  }
+
+  vp->metrics.v[0] = lo;
+  vp->metrics.v[1] = hi;
+  vp->dp           = d + nbits;
+
+  if (best_state) {
+    *best_state = viterbi37_best_state_avx512_16bit(vp);
+  }
+
+  return 0;
+}
+
+int update_viterbi37_blk_multi_avx512_16bit(void**    p,
+                                            uint16_t** syms,
+                                            uint32_t   nof_frames,
+                                            uint32_t   nbits,
+                                            uint32_t*  best_state)
+{
+  if (p == NULL || nof_frames > VITERBI37_AVX512_MAX_FRAMES) {
+    return -1;
+  }
+
+  const __m512i idx_lo = _mm512_loadu_si512(&viterbi37_avx512_idx[0]);
+  const __m512i idx_hi = _mm512_loadu_si512(&viterbi37_avx512_idx[32]);
+
+  struct v37* vp[VITERBI37_AVX512_MAX_FRAMES];
+  __m512i     lo[VITERBI37_AVX512_MAX_FRAMES];
+  __m512i     hi[VITERBI37_AVX512_MAX_FRAMES];
+  for (uint32_t f = 0; f < nof_frames; f++) {
+    vp[f] = p[f];
+    lo[f] = vp[f]->metrics.v[0];
+    hi[f] = vp[f]->metrics.v[1];
+  }
+
+  /* The frames are independent, interleaving their recursions hides the latency of the add-compare-select chain */
+  for (uint32_t i = 0; i < nbits; i++) {
+    for (uint32_t f = 0; f < nof_frames; f++) {
+      viterbi37_acs_avx512_16bit(&lo[f], &hi[f], &syms[f][3 * i], &vp[f]->dp[i], idx_lo, idx_hi);
+    }
+  }
+
+  for (uint32_t f = 0; f < nof_frames; f++) {
+    vp[f]->metrics.v[0] = lo[f];
+    vp[f]->metrics.v[1] = hi[f];
+    vp[f]->dp += nbits;
+    if (best_state) {
+      best_state[f] = viterbi37_best_state_avx512_16bit(vp[f]);
+    }
+  }
+
+  return 0;
+}
+
+#endif /* LV_HAVE_AVX512 */
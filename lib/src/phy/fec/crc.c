@@ -27,6 +27,19 @@
 #include <immintrin.h>
 #endif // LV_HAVE_SSE
 
+#if defined(LV_HAVE_SSE) && defined(LV_HAVE_PCLMUL)
+#include <wmmintrin.h>
+#define CRC_HAVE_CLMUL
+typedef __m128i crc_v128_t;
+#elif defined(HAVE_NEONv8) && defined(__ARM_FEATURE_CRYPTO)
+#include <arm_neon.h>
+#define CRC_HAVE_CLMUL
+typedef uint64x2_t crc_v128_t;
+#endif
+
+// Minimum number of 128-bit blocks for folding the message, shorter messages are faster with the byte table
+#define CRC_CLMUL_MIN_BLOCKS 2
+
 static void gen_crc_table(srsran_crc_t* h)
 {
   uint32_t pad        = (h->order < 8) ? (8 - h->order) : 0;
@@ -47,6 +60,149 @@ static void gen_crc_table(srsran_crc_t* h)
   }
 }
 
+// Computes x^n modulo the CRC polynomial
+static uint64_t crc_xpow_mod(const srsran_crc_t* h, uint32_t n)
+{
+  uint64_t polynom = ((uint64_t)h->polynom & h->crcmask) | ((uint64_t)1 << h->order);
+  uint64_t r       = 1;
+
+  for (uint32_t i = 0; i < n; i++) {
+    r <<= 1U;
+    if (r & ((uint64_t)1 << h->order)) {
+      r ^= polynom;
+    }
+  }
+  return r;
+}
+
+#ifdef CRC_HAVE_CLMUL
+/*
+ * The blocks are kept in the vector registers with the first bit of the message in the most significant position, so
+ * a 128-bit block H * x^64 + L is moved forward by n bits as H * (x^(n + 64) mod P) + L * (x^n mod P). Both products
+ * are shorter than 128 bits for CRC orders up to 64.
+ */
+static inline crc_v128_t crc_clmul_set(uint64_t hi, uint64_t lo)
+{
+#ifdef LV_HAVE_SSE
+  return _mm_set_epi64x((long long)hi, (long long)lo);
+#else
+  return vcombine_u64(vcreate_u64(lo), vcreate_u64(hi));
+#endif
+}
+
+static inline crc_v128_t crc_clmul_load(const uint8_t* bytes)
+{
+#ifdef LV_HAVE_SSE
+  return _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)bytes),
+                          _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+#else
+  uint8x16_t v = vrev64q_u8(vld1q_u8(bytes));
+  return vreinterpretq_u64_u8(vextq_u8(v, v, 8));
+#endif
+}
+
+static inline void crc_clmul_store(uint8_t* bytes, crc_v128_t v)
+{
+#ifdef LV_HAVE_SSE
+  _mm_storeu_si128((__m128i*)bytes,
+                   _mm_shuffle_epi8(v, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)));
+#else
+  uint8x16_t b = vrev64q_u8(vreinterpretq_u8_u64(v));
+  vst1q_u8(bytes, vextq_u8(b, b, 8));
+#endif
+}
+
+static inline crc_v128_t crc_clmul_xor(crc_v128_t a, crc_v128_t b)
+{
+#ifdef LV_HAVE_SSE
+  return _mm_xor_si128(a, b);
+#else
+  return veorq_u64(a, b);
+#endif
+}
+
+// Multiplies the high half of x by the high half of k, the low half of x by the low half of k and adds the results
+static inline crc_v128_t crc_clmul_fold(crc_v128_t x, crc_v128_t k)
+{
+#ifdef LV_HAVE_SSE
+  return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), _mm_clmulepi64_si128(x, k, 0x00));
+#else
+  poly128_t hi = vmull_p64((poly64_t)vgetq_lane_u64(x, 1), (poly64_t)vgetq_lane_u64(k, 1));
+  poly128_t lo = vmull_p64((poly64_t)vgetq_lane_u64(x, 0), (poly64_t)vgetq_lane_u64(k, 0));
+  return veorq_u64(vreinterpretq_u64_p128(hi), vreinterpretq_u64_p128(lo));
+#endif
+}
+
+// Packs 128 unpacked bits, most significant bit first, into 16 bytes
+static inline void crc_clmul_pack(const uint8_t* bits, uint8_t* bytes)
+{
+#ifdef LV_HAVE_SSE
+  const __m128i reverse = _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+  for (uint32_t i = 0; i < 8; i++) {
+    __m128i mask = _mm_cmpgt_epi8(_mm_loadu_si128((__m128i*)&bits[16 * i]), _mm_setzero_si128());
+    uint32_t word = (uint32_t)_mm_movemask_epi8(_mm_shuffle_epi8(mask, reverse));
+    bytes[2 * i]     = (uint8_t)(word & 0xffU);
+    bytes[2 * i + 1] = (uint8_t)(word >> 8U);
+  }
+#else
+  uint8_t* ptr = (uint8_t*)bits;
+  for (uint32_t i = 0; i < 16; i++) {
+    bytes[i] = (uint8_t)(srsran_bit_pack(&ptr, 8) & 0xffU);
+  }
+#endif
+}
+
+static inline crc_v128_t crc_clmul_get(const uint8_t* data, uint32_t block, bool unpacked)
+{
+  if (unpacked) {
+    uint8_t bytes[16];
+    crc_clmul_pack(&data[128 * block], bytes);
+    return crc_clmul_load(bytes);
+  }
+  return crc_clmul_load(&data[16 * block]);
+}
+
+/*
+ * Folds the first nof_blocks 128-bit blocks of the message into a single block with the same remainder, and feeds it
+ * into the byte table state. The data is either unpacked bits or packed bytes.
+ */
+static inline void crc_clmul_run(srsran_crc_t* h, const uint8_t* data, uint32_t nof_blocks, bool unpacked)
+{
+  const crc_v128_t k512 = crc_clmul_set(h->clmul_k[0], h->clmul_k[1]);
+  const crc_v128_t k128 = crc_clmul_set(h->clmul_k[2], h->clmul_k[3]);
+
+  uint32_t   i = 0;
+  crc_v128_t x = crc_clmul_get(data, i++, unpacked);
+
+  // Fold four independent blocks at a time, they are combined at the end
+  if (nof_blocks >= 8) {
+    crc_v128_t x1 = crc_clmul_get(data, i++, unpacked);
+    crc_v128_t x2 = crc_clmul_get(data, i++, unpacked);
+    crc_v128_t x3 = crc_clmul_get(data, i++, unpacked);
+    for (; i + 4 <= nof_blocks; i += 4) {
+      x  = crc_clmul_xor(crc_clmul_fold(x, k512), crc_clmul_get(data, i, unpacked));
+      x1 = crc_clmul_xor(crc_clmul_fold(x1, k512), crc_clmul_get(data, i + 1, unpacked));
+      x2 = crc_clmul_xor(crc_clmul_fold(x2, k512), crc_clmul_get(data, i + 2, unpacked));
+      x3 = crc_clmul_xor(crc_clmul_fold(x3, k512), crc_clmul_get(data, i + 3, unpacked));
+    }
+    x = crc_clmul_xor(crc_clmul_fold(x, k128), x1);
+    x = crc_clmul_xor(crc_clmul_fold(x, k128), x2);
+    x = crc_clmul_xor(crc_clmul_fold(x, k128), x3);
+  }
+
+  for (; i < nof_blocks; i++) {
+    x = crc_clmul_xor(crc_clmul_fold(x, k128), crc_clmul_get(data, i, unpacked));
+  }
+
+  // The remainder of the folded block is the one of the message
+  uint8_t folded[16];
+  crc_clmul_store(folded, x);
+  for (uint32_t j = 0; j < 16; j++) {
+    srsran_crc_checksum_put_byte(h, folded[j]);
+  }
+}
+#endif // CRC_HAVE_CLMUL
+
 uint64_t reversecrcbit(uint32_t crc, int nbits, srsran_crc_t* h)
 {
   uint64_t m, rmask = 0x1;
@@ -89,6 +245,12 @@ int srsran_crc_init(srsran_crc_t* h, uint32_t crc_poly, int crc_order)
   // generate lookup table
   gen_crc_table(h);
 
+  // folding constants
+  h->clmul_k[0] = crc_xpow_mod(h, 512 + 64);
+  h->clmul_k[1] = crc_xpow_mod(h, 512);
+  h->clmul_k[2] = crc_xpow_mod(h, 128 + 64);
+  h->clmul_k[3] = crc_xpow_mod(h, 128);
+
   return 0;
 }
 
@@ -107,8 +269,16 @@ uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len)
     a = 1;
   }
 
+  i = 0;
+#ifdef CRC_HAVE_CLMUL
+  if (len / 128 >= CRC_CLMUL_MIN_BLOCKS) {
+    crc_clmul_run(h, data, len / 128, true);
+    i = (len / 128) * 16;
+  }
+#endif // CRC_HAVE_CLMUL
+
   // Calculate CRC
-  for (i = 0; i < len8 + a; i++) {
+  for (; i < len8 + a; i++) {
     pter = (uint8_t*)(data + 8 * i);
     uint8_t byte;
     if (i == len8) {
@@ -151,8 +321,16 @@ uint32_t srsran_crc_checksum_byte(srsran_crc_t* h, const uint8_t* data, int len)
 
   srsran_crc_set_init(h, 0);
 
+  i = 0;
+#ifdef CRC_HAVE_CLMUL
+  if (len / 128 >= CRC_CLMUL_MIN_BLOCKS) {
+    crc_clmul_run(h, data, len / 128, false);
+    i = (len / 128) * 16;
+  }
+#endif // CRC_HAVE_CLMUL
+
   // Calculate CRC
-  for (i = 0; i < len / 8; i++) {
+  for (; i < len / 8; i++) {
     srsran_crc_checksum_put_byte(h, data[i]);
   }
   crc = (uint32_t)srsran_crc_checksum_get(h);
@@ -0,0 +1,449 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/fec/fec_offload.h"
+#include "srsran/phy/fec/crc.h"
+#include "srsran/phy/fec/ldpc/ldpc_rm.h"
+#include "srsran/phy/utils/bit.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+  const char* name;
+  int (*init)(void** h, const srsran_fec_offload_args_t* args);
+  void (*free)(void* h);
+  uint32_t (*enqueue_ldpc_dec)(void* h, srsran_fec_offload_ldpc_dec_op_t** ops, uint32_t nof_ops);
+  uint32_t (*dequeue_ldpc_dec)(void* h, srsran_fec_offload_ldpc_dec_op_t** ops, uint32_t max_nof_ops);
+} fec_offload_dev_t;
+
+/*
+ * CPU backend
+ */
+
+// Per thread decoding resources, the decoders are created on first use of a base graph and lifting size
+typedef struct {
+  srsran_ldpc_decoder_t* decoder[2][MAX_LIFTSIZE + 1];
+  srsran_ldpc_rm_t       rm;
+  srsran_crc_t           crc[SRSRAN_FEC_OFFLOAD_NOF_CRC];
+  uint8_t*               cb;
+} fec_cpu_engine_t;
+
+typedef struct {
+  srsran_fec_offload_args_t args;
+
+  pthread_mutex_t mutex;
+  pthread_cond_t  cvar_pending;
+  pthread_cond_t  cvar_done;
+  bool            running;
+
+  // Operations waiting for a worker and completed operations, both hold at most queue_size operations
+  srsran_fec_offload_ldpc_dec_op_t** pending;
+  srsran_fec_offload_ldpc_dec_op_t** done;
+  uint32_t                           pending_head;
+  uint32_t                           nof_pending;
+  uint32_t                           done_head;
+  uint32_t                           nof_done;
+  uint32_t                           nof_in_flight;
+
+  // Engine 0 serves the polling thread, the others the workers
+  fec_cpu_engine_t engine[SRSRAN_FEC_OFFLOAD_MAX_WORKERS + 1];
+  pthread_t        worker[SRSRAN_FEC_OFFLOAD_MAX_WORKERS];
+  uint32_t         nof_workers;
+} fec_cpu_t;
+
+typedef struct {
+  fec_cpu_t* h;
+  uint32_t   id;
+} fec_cpu_worker_args_t;
+
+static int fec_cpu_engine_init(fec_cpu_engine_t* e)
+{
+  if (srsran_ldpc_rm_rx_init_c(&e->rm) < SRSRAN_SUCCESS) {
+    ERROR("Error: initialising Rx LDPC Rate matching");
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_crc_init(&e->crc[SRSRAN_FEC_OFFLOAD_CRC_16], SRSRAN_LTE_CRC16, 16) < SRSRAN_SUCCESS ||
+      srsran_crc_init(&e->crc[SRSRAN_FEC_OFFLOAD_CRC_24A], SRSRAN_LTE_CRC24A, 24) < SRSRAN_SUCCESS ||
+      srsran_crc_init(&e->crc[SRSRAN_FEC_OFFLOAD_CRC_24B], SRSRAN_LTE_CRC24B, 24) < SRSRAN_SUCCESS) {
+    ERROR("Error: initialising CRC");
+    return SRSRAN_ERROR;
+  }
+
+  e->cb = srsran_vec_u8_malloc(SRSRAN_LDPC_MAX_LEN_CB * 8);
+  if (e->cb == NULL) {
+    ERROR("Error: malloc");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static void fec_cpu_engine_free(fec_cpu_engine_t* e)
+{
+  for (uint32_t i = 0; i < 2; i++) {
+    for (uint32_t ls = 0; ls <= MAX_LIFTSIZE; ls++) {
+      if (e->decoder[i][ls]) {
+        srsran_ldpc_decoder_free(e->decoder[i][ls]);
+        free(e->decoder[i][ls]);
+      }
+    }
+  }
+  srsran_ldpc_rm_rx_free_c(&e->rm);
+  if (e->cb) {
+    free(e->cb);
+  }
+}
+
+static srsran_ldpc_decoder_t*
+fec_cpu_engine_decoder(fec_cpu_engine_t* e, const srsran_fec_offload_args_t* args, srsran_basegraph_t bg, uint16_t ls)
+{
+  if (ls > MAX_LIFTSIZE || get_ls_index(ls) == VOID_LIFTSIZE) {
+    ERROR("Error: invalid lifting size %d", ls);
+    return NULL;
+  }
+
+  srsran_ldpc_decoder_t** decoder = &e->decoder[bg == BG1 ? 0 : 1][ls];
+  if (*decoder != NULL) {
+    return *decoder;
+  }
+
+  srsran_ldpc_decoder_args_t decoder_args = {};
+  decoder_args.type                       = args->ldpc_decoder_type;
+  decoder_args.bg                         = bg;
+  decoder_args.ls                         = ls;
+  decoder_args.scaling_fctr               = args->ldpc_scaling_factor;
+  decoder_args.max_nof_iter               = args->ldpc_max_nof_iter;
+
+  *decoder = SRSRAN_MEM_ALLOC(srsran_ldpc_decoder_t, 1);
+  if (*decoder == NULL) {
+    ERROR("Error: calloc");
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(*decoder, srsran_ldpc_decoder_t, 1);
+
+  if (srsran_ldpc_decoder_init(*decoder, &decoder_args) < SRSRAN_SUCCESS) {
+    ERROR("Error: initialising LDPC decoder for ls=%d", ls);
+    free(*decoder);
+    *decoder = NULL;
+    return NULL;
+  }
+
+  return *decoder;
+}
+
+static void fec_cpu_ldpc_dec(fec_cpu_engine_t*                 e,
+                             const srsran_fec_offload_args_t*  args,
+                             srsran_fec_offload_ldpc_dec_op_t* op)
+{
+  op->status   = SRSRAN_ERROR;
+  op->crc_ok   = false;
+  op->nof_iter = 0;
+
+  srsran_ldpc_decoder_t* decoder = fec_cpu_engine_decoder(e, args, op->bg, op->ls);
+  if (decoder == NULL || op->crc >= SRSRAN_FEC_OFFLOAD_NOF_CRC) {
+    return;
+  }
+
+  int n_llr = srsran_ldpc_rm_rx_c(
+      &e->rm, op->llr, op->harq_buffer, op->E, op->F, op->bg, op->ls, (uint8_t)op->rv, op->mod, op->Nref);
+  if (n_llr < SRSRAN_SUCCESS) {
+    ERROR("Error in LDPC rate mateching");
+    return;
+  }
+
+  // Decode. if CRC=KO, then ret=0
+  srsran_crc_t* crc = (op->crc == SRSRAN_FEC_OFFLOAD_CRC_NONE) ? NULL : &e->crc[op->crc];
+  int           ret = srsran_ldpc_decoder_decode_crc_c(decoder, op->harq_buffer, e->cb, (uint32_t)n_llr, crc);
+  if (ret < SRSRAN_SUCCESS) {
+    ERROR("Error decoding CB");
+    return;
+  }
+
+  op->nof_iter = (ret == 0) ? decoder->max_nof_iter : (uint32_t)ret;
+  op->crc_ok   = (ret != 0);
+  srsran_bit_pack_vector(e->cb, op->output, op->nof_bits);
+  op->status = SRSRAN_SUCCESS;
+}
+
+// Pops the oldest pending operation, the mutex must be held
+static srsran_fec_offload_ldpc_dec_op_t* fec_cpu_pop_pending(fec_cpu_t* h)
+{
+  srsran_fec_offload_ldpc_dec_op_t* op = h->pending[h->pending_head];
+  h->pending_head                       = (h->pending_head + 1) % h->args.queue_size;
+  h->nof_pending--;
+  return op;
+}
+
+static void fec_cpu_push_done(fec_cpu_t* h, srsran_fec_offload_ldpc_dec_op_t* op)
+{
+  h->done[(h->done_head + h->nof_done) % h->args.queue_size] = op;
+  h->nof_done++;
+}
+
+static void* fec_cpu_worker(void* arg)
+{
+  fec_cpu_worker_args_t* a = (fec_cpu_worker_args_t*)arg;
+  fec_cpu_t*             h = a->h;
+  fec_cpu_engine_t*      e = &h->engine[a->id];
+  free(a);
+
+  pthread_mutex_lock(&h->mutex);
+  while (true) {
+    while (h->running && h->nof_pending == 0) {
+      pthread_cond_wait(&h->cvar_pending, &h->mutex);
+    }
+    if (!h->running) {
+      break;
+    }
+
+    srsran_fec_offload_ldpc_dec_op_t* op = fec_cpu_pop_pending(h);
+    pthread_mutex_unlock(&h->mutex);
+
+    fec_cpu_ldpc_dec(e, &h->args, op);
+
+    pthread_mutex_lock(&h->mutex);
+    fec_cpu_push_done(h, op);
+    pthread_cond_signal(&h->cvar_done);
+  }
+  pthread_mutex_unlock(&h->mutex);
+
+  return NULL;
+}
+
+static void fec_cpu_free(void* ptr)
+{
+  fec_cpu_t* h = (fec_cpu_t*)ptr;
+  if (h == NULL) {
+    return;
+  }
+
+  pthread_mutex_lock(&h->mutex);
+  h->running = false;
+  pthread_cond_broadcast(&h->cvar_pending);
+  pthread_mutex_unlock(&h->mutex);
+  for (uint32_t i = 0; i < h->nof_workers; i++) {
+    pthread_join(h->worker[i], NULL);
+  }
+
+  for (uint32_t i = 0; i < SRSRAN_FEC_OFFLOAD_MAX_WORKERS + 1; i++) {
+    fec_cpu_engine_free(&h->engine[i]);
+  }
+  if (h->pending) {
+    free(h->pending);
+  }
+  if (h->done) {
+    free(h->done);
+  }
+
+  pthread_cond_destroy(&h->cvar_done);
+  pthread_cond_destroy(&h->cvar_pending);
+  pthread_mutex_destroy(&h->mutex);
+  free(h);
+}
+
+static int fec_cpu_init(void** ptr, const srsran_fec_offload_args_t* args)
+{
+  if (args->nof_workers > SRSRAN_FEC_OFFLOAD_MAX_WORKERS) {
+    ERROR("Error: the CPU FEC offload supports up to %d workers", SRSRAN_FEC_OFFLOAD_MAX_WORKERS);
+    return SRSRAN_ERROR;
+  }
+
+  fec_cpu_t* h = SRSRAN_MEM_ALLOC(fec_cpu_t, 1);
+  if (h == NULL) {
+    ERROR("Error: calloc");
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(h, fec_cpu_t, 1);
+
+  h->args    = *args;
+  h->running = true;
+  pthread_mutex_init(&h->mutex, NULL);
+  pthread_cond_init(&h->cvar_pending, NULL);
+  pthread_cond_init(&h->cvar_done, NULL);
+
+  h->pending = SRSRAN_MEM_ALLOC(srsran_fec_offload_ldpc_dec_op_t*, args->queue_size);
+  h->done    = SRSRAN_MEM_ALLOC(srsran_fec_offload_ldpc_dec_op_t*, args->queue_size);
+  if (h->pending == NULL || h->done == NULL) {
+    ERROR("Error: calloc");
+    fec_cpu_free(h);
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < args->nof_workers + 1; i++) {
+    if (fec_cpu_engine_init(&h->engine[i]) < SRSRAN_SUCCESS) {
+      fec_cpu_free(h);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  for (uint32_t i = 0; i < args->nof_workers; i++) {
+    fec_cpu_worker_args_t* a = SRSRAN_MEM_ALLOC(fec_cpu_worker_args_t, 1);
+    if (a == NULL) {
+      fec_cpu_free(h);
+      return SRSRAN_ERROR;
+    }
+    a->h  = h;
+    a->id = i + 1;
+    if (pthread_create(&h->worker[i], NULL, fec_cpu_worker, a) != 0) {
+      ERROR("Error: creating FEC offload worker");
+      free(a);
+      fec_cpu_free(h);
+      return SRSRAN_ERROR;
+    }
+    h->nof_workers++;
+  }
+
+  *ptr = h;
+  return SRSRAN_SUCCESS;
+}
+
+static uint32_t fec_cpu_enqueue_ldpc_dec(void* ptr, srsran_fec_offload_ldpc_dec_op_t** ops, uint32_t nof_ops)
+{
+  fec_cpu_t* h = (fec_cpu_t*)ptr;
+
+  pthread_mutex_lock(&h->mutex);
+  uint32_t n = SRSRAN_MIN(nof_ops, h->args.queue_size - h->nof_in_flight);
+  for (uint32_t i = 0; i < n; i++) {
+    h->pending[(h->pending_head + h->nof_pending) % h->args.queue_size] = ops[i];
+    h->nof_pending++;
+  }
+  h->nof_in_flight += n;
+  if (n > 0 && h->nof_workers > 0) {
+    pthread_cond_broadcast(&h->cvar_pending);
+  }
+  pthread_mutex_unlock(&h->mutex);
+
+  return n;
+}
+
+static uint32_t fec_cpu_dequeue_ldpc_dec(void* ptr, srsran_fec_offload_ldpc_dec_op_t** ops, uint32_t max_nof_ops)
+{
+  fec_cpu_t* h = (fec_cpu_t*)ptr;
+
+  pthread_mutex_lock(&h->mutex);
+  if (max_nof_ops > 0 && h->nof_done == 0) {
+    if (h->nof_pending > 0) {
+      // Nothing completed yet, the polling thread helps with a pending operation instead of spinning
+      srsran_fec_offload_ldpc_dec_op_t* op = fec_cpu_pop_pending(h);
+      pthread_mutex_unlock(&h->mutex);
+
+      fec_cpu_ldpc_dec(&h->engine[0], &h->args, op);
+
+      pthread_mutex_lock(&h->mutex);
+      fec_cpu_push_done(h, op);
+    } else if (h->nof_in_flight > 0) {
+      // All the remaining operations are in the workers
+      pthread_cond_wait(&h->cvar_done, &h->mutex);
+    }
+  }
+
+  uint32_t n = SRSRAN_MIN(max_nof_ops, h->nof_done);
+  for (uint32_t i = 0; i < n; i++) {
+    ops[i]      = h->done[h->done_head];
+    h->done_head = (h->done_head + 1) % h->args.queue_size;
+  }
+  h->nof_done -= n;
+  h->nof_in_flight -= n;
+  pthread_mutex_unlock(&h->mutex);
+
+  return n;
+}
+
+static const fec_offload_dev_t fec_offload_dev_cpu = {.name             = "cpu",
+                                                      .init             = fec_cpu_init,
+                                                      .free             = fec_cpu_free,
+                                                      .enqueue_ldpc_dec = fec_cpu_enqueue_ldpc_dec,
+                                                      .dequeue_ldpc_dec = fec_cpu_dequeue_ldpc_dec};
+
+/*
+ * Public API
+ */
+
+int srsran_fec_offload_init(srsran_fec_offload_t* q, const srsran_fec_offload_args_t* args)
+{
+  if (q == NULL || args == NULL || args->queue_size == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  q->dev     = NULL;
+  q->handler = NULL;
+
+  const fec_offload_dev_t* dev = NULL;
+  switch (args->backend) {
+    case SRSRAN_FEC_OFFLOAD_CPU:
+      dev = &fec_offload_dev_cpu;
+      break;
+    case SRSRAN_FEC_OFFLOAD_BBDEV:
+    default:
+      ERROR("Error: FEC offload backend %d is not available in this build", args->backend);
+      return SRSRAN_ERROR;
+  }
+
+  if (dev->init(&q->handler, args) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  q->dev = dev;
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_fec_offload_free(srsran_fec_offload_t* q)
+{
+  if (q == NULL || q->dev == NULL) {
+    return;
+  }
+
+  ((const fec_offload_dev_t*)q->dev)->free(q->handler);
+  q->dev     = NULL;
+  q->handler = NULL;
+}
+
+const char* srsran_fec_offload_name(const srsran_fec_offload_t* q)
+{
+  if (q == NULL || q->dev == NULL) {
+    return "none";
+  }
+  return ((const fec_offload_dev_t*)q->dev)->name;
+}
+
+uint32_t srsran_fec_offload_enqueue_ldpc_dec(srsran_fec_offload_t*              q,
+                                             srsran_fec_offload_ldpc_dec_op_t** ops,
+                                             uint32_t                           nof_ops)
+{
+  if (q == NULL || q->dev == NULL || ops == NULL) {
+    return 0;
+  }
+  return ((const fec_offload_dev_t*)q->dev)->enqueue_ldpc_dec(q->handler, ops, nof_ops);
+}
+
+uint32_t srsran_fec_offload_dequeue_ldpc_dec(srsran_fec_offload_t*              q,
+                                             srsran_fec_offload_ldpc_dec_op_t** ops,
+                                             uint32_t                           max_nof_ops)
+{
+  if (q == NULL || q->dev == NULL || ops == NULL) {
+    return 0;
+  }
+  return ((const fec_offload_dev_t*)q->dev)->dequeue_ldpc_dec(q->handler, ops, max_nof_ops);
+}
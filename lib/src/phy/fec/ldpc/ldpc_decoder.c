@@ -41,28 +41,39 @@
 
 #define LDPC_DECODER_DEFAULT_MAX_NOF_ITER 10 /*!< \brief Default maximum number of iterations of the BP algorithm. */
 
+/*!
+ * Adjusts the rate-matched codeword length to what the decoder can process: it can not exceed the codeword size, it
+ * must cover the high-rate region and it must be a multiple of the lifting size.
+ */
+static uint32_t get_cdwd_rm_length(const srsran_ldpc_decoder_t* q, uint32_t cdwd_rm_length)
+{
+  /* it must be smaller than the codeword size */
+  if (cdwd_rm_length > q->liftN - 2 * q->ls) {
+    cdwd_rm_length = q->liftN - 2 * q->ls;
+  }
+  /* We need at least q->bgK + 4 variable nodes to cover the high-rate region. However,*/
+  /* 2 variable nodes are systematically punctured by the encoder. */
+  if (cdwd_rm_length < (q->bgK + 2) * q->ls) {
+    /* ERROR("The rate-matched codeword should have a length at least equal to the high-rate region.");*/
+    cdwd_rm_length = (q->bgK + 2) * q->ls;
+    /* return -1;*/
+  }
+  if (cdwd_rm_length % q->ls) {
+    cdwd_rm_length = (cdwd_rm_length / q->ls + 1) * q->ls;
+    /* ERROR("The rate-matched codeword length should be a multiple of the lifting size."); */
+    /* return -1;*/
+  }
+  return cdwd_rm_length;
+}
+
 #define LDPC_DECODER_TEMPLATE(LLR_TYPE, SUFFIX)                                                                        \
   static int decode_##SUFFIX(                                                                                          \
       void* o, const LLR_TYPE* llrs, uint8_t* message, uint32_t cdwd_rm_length, srsran_crc_t* crc)                     \
   {                                                                                                                    \
     srsran_ldpc_decoder_t* q = o;                                                                                      \
                                                                                                                        \
-    /* it must be smaller than the codeword size */                                                                    \
-    if (cdwd_rm_length > q->liftN - 2 * q->ls) {                                                                       \
-      cdwd_rm_length = q->liftN - 2 * q->ls;                                                                           \
-    }                                                                                                                  \
-    /* We need at least q->bgK + 4 variable nodes to cover the high-rate region. However,*/                            \
-    /* 2 variable nodes are systematically punctured by the encoder. */                                                \
-    if (cdwd_rm_length < (q->bgK + 2) * q->ls) {                                                                       \
-      /* ERROR("The rate-matched codeword should have a length at least equal to the high-rate region.");*/            \
-      cdwd_rm_length = (q->bgK + 2) * q->ls;                                                                           \
-      /* return -1;*/                                                                                                  \
-    }                                                                                                                  \
-    if (cdwd_rm_length % q->ls) {                                                                                      \
-      cdwd_rm_length = (cdwd_rm_length / q->ls + 1) * q->ls;                                                           \
-      /* ERROR("The rate-matched codeword length should be a multiple of the lifting size."); */                       \
-      /* return -1;*/                                                                                                  \
-    }                                                                                                                  \
+    cdwd_rm_length = get_cdwd_rm_length(q, cdwd_rm_length);                                                            \
+                                                                                                                       \
     init_ldpc_dec_##SUFFIX(q->ptr, llrs, q->ls);                                                                       \
                                                                                                                        \
     uint16_t* this_pcm                   = NULL;                                                                       \
@@ -108,22 +119,8 @@
   {                                                                                                                    \
     srsran_ldpc_decoder_t* q = o;                                                                                      \
                                                                                                                        \
-    /* it must be smaller than the codeword size */                                                                    \
-    if (cdwd_rm_length > q->liftN - 2 * q->ls) {                                                                       \
-      cdwd_rm_length = q->liftN - 2 * q->ls;                                                                           \
-    }                                                                                                                  \
-    /* We need at least q->bgK + 4 variable nodes to cover the high-rate region. However,*/                            \
-    /* 2 variable nodes are systematically punctured by the encoder. */                                                \
-    if (cdwd_rm_length < (q->bgK + 2) * q->ls) {                                                                       \
-      /* ERROR("The rate-matched codeword should have a length at least equal to the high-rate region.");*/            \
-      cdwd_rm_length = (q->bgK + 2) * q->ls;                                                                           \
-      /* return -1;*/                                                                                                  \
-    }                                                                                                                  \
-    if (cdwd_rm_length % q->ls) {                                                                                      \
-      cdwd_rm_length = (cdwd_rm_length / q->ls + 1) * q->ls;                                                           \
-      /* ERROR("The rate-matched codeword length should be a multiple of the lifting size."); */                       \
-      /* return -1;*/                                                                                                  \
-    }                                                                                                                  \
+    cdwd_rm_length = get_cdwd_rm_length(q, cdwd_rm_length);                                                            \
+                                                                                                                       \
     init_ldpc_dec_##SUFFIX(q->ptr, llrs, q->ls);                                                                       \
                                                                                                                        \
     uint16_t* this_pcm                   = NULL;                                                                       \
@@ -167,6 +164,88 @@
     return q->max_nof_iter;                                                                                            \
   }
 
+/*! Defines the functions that run the layered decoder one iteration at a time on an independent set of registers. */
+#define LDPC_DECODER_STATE_TEMPLATE(LLR_TYPE, SUFFIX)                                                                  \
+  static void* create_state_##SUFFIX(void* o)                                                                          \
+  {                                                                                                                    \
+    srsran_ldpc_decoder_t* q = o;                                                                                      \
+    return create_ldpc_dec_##SUFFIX(q->bgN, q->bgM, q->ls, q->scaling_fctr);                                           \
+  }                                                                                                                    \
+                                                                                                                       \
+  static int start_##SUFFIX(void* o, void* p, const LLR_TYPE* llrs, uint32_t cdwd_rm_length)                           \
+  {                                                                                                                    \
+    srsran_ldpc_decoder_t* q = o;                                                                                      \
+                                                                                                                       \
+    cdwd_rm_length = get_cdwd_rm_length(q, cdwd_rm_length);                                                            \
+    init_ldpc_dec_##SUFFIX(p, llrs, q->ls);                                                                            \
+                                                                                                                       \
+    /* Number of layers, the first two variable nodes are always removed from the final codeword */                    \
+    return cdwd_rm_length / q->ls - q->bgK + 2;                                                                        \
+  }                                                                                                                    \
+                                                                                                                       \
+  static void iterate_##SUFFIX(void* o, void* p, uint8_t n_layers)                                                     \
+  {                                                                                                                    \
+    srsran_ldpc_decoder_t* q = o;                                                                                      \
+                                                                                                                       \
+    for (int i_layer = 0; i_layer < n_layers; i_layer++) {                                                             \
+      update_ldpc_var_to_check_##SUFFIX(p, i_layer);                                                                   \
+      update_ldpc_check_to_var_##SUFFIX(p, i_layer, q->pcm + i_layer * q->bgN, q->var_indices + i_layer);              \
+      update_ldpc_soft_bits_##SUFFIX(p, i_layer, q->var_indices + i_layer);                                            \
+    }                                                                                                                  \
+  }                                                                                                                    \
+                                                                                                                       \
+  static void set_state_##SUFFIX(srsran_ldpc_decoder_t* q)                                                             \
+  {                                                                                                                    \
+    q->create_state = create_state_##SUFFIX;                                                                           \
+    q->free_state   = delete_ldpc_dec_##SUFFIX;                                                                        \
+    q->start_c      = start_##SUFFIX;                                                                                  \
+    q->iterate_c    = iterate_##SUFFIX;                                                                                \
+    q->extract_c    = extract_ldpc_message_##SUFFIX;                                                                   \
+  }
+
+/*! Same as LDPC_DECODER_STATE_TEMPLATE for the flooded schedule. As in the flooded decoding function, one iteration
+ * runs two flooded updates of all the layers. */
+#define LDPC_DECODER_STATE_TEMPLATE_FLOOD(LLR_TYPE, SUFFIX)                                                            \
+  static void* create_state_##SUFFIX(void* o)                                                                          \
+  {                                                                                                                    \
+    srsran_ldpc_decoder_t* q = o;                                                                                      \
+    return create_ldpc_dec_##SUFFIX(q->bgN, q->bgM, q->ls, q->scaling_fctr);                                           \
+  }                                                                                                                    \
+                                                                                                                       \
+  static int start_##SUFFIX(void* o, void* p, const LLR_TYPE* llrs, uint32_t cdwd_rm_length)                           \
+  {                                                                                                                    \
+    srsran_ldpc_decoder_t* q = o;                                                                                      \
+                                                                                                                       \
+    cdwd_rm_length = get_cdwd_rm_length(q, cdwd_rm_length);                                                            \
+    init_ldpc_dec_##SUFFIX(p, llrs, q->ls);                                                                            \
+                                                                                                                       \
+    return cdwd_rm_length / q->ls - q->bgK + 2;                                                                        \
+  }                                                                                                                    \
+                                                                                                                       \
+  static void iterate_##SUFFIX(void* o, void* p, uint8_t n_layers)                                                     \
+  {                                                                                                                    \
+    srsran_ldpc_decoder_t* q = o;                                                                                      \
+                                                                                                                       \
+    for (int i_pass = 0; i_pass < 2; i_pass++) {                                                                       \
+      for (int i_layer = 0; i_layer < n_layers; i_layer++) {                                                           \
+        update_ldpc_var_to_check_##SUFFIX(p, i_layer);                                                                 \
+      }                                                                                                                \
+      for (int i_layer = 0; i_layer < n_layers; i_layer++) {                                                           \
+        update_ldpc_check_to_var_##SUFFIX(p, i_layer, q->pcm + i_layer * q->bgN, q->var_indices + i_layer);            \
+      }                                                                                                                \
+      update_ldpc_soft_bits_##SUFFIX(p, q->var_indices);                                                               \
+    }                                                                                                                  \
+  }                                                                                                                    \
+                                                                                                                       \
+  static void set_state_##SUFFIX(srsran_ldpc_decoder_t* q)                                                             \
+  {                                                                                                                    \
+    q->create_state = create_state_##SUFFIX;                                                                           \
+    q->free_state   = delete_ldpc_dec_##SUFFIX;                                                                        \
+    q->start_c      = start_##SUFFIX;                                                                                  \
+    q->iterate_c    = iterate_##SUFFIX;                                                                                \
+    q->extract_c    = extract_ldpc_message_##SUFFIX;                                                                   \
+  }
+
 /*! Carries out the actual destruction of the memory allocated to the decoder, float-LLR case. */
 static void free_dec_f(void* o)
 {
@@ -246,6 +325,7 @@ static void free_dec_c(void* o)
 
 /*! Carries out the decoding with 8-bit integer-valued LLRs. */
 LDPC_DECODER_TEMPLATE(int8_t, c)
+LDPC_DECODER_STATE_TEMPLATE(int8_t, c)
 
 /*! Initializes the decoder to work with 8-bit integer-valued LLRs. */
 static int init_c(srsran_ldpc_decoder_t* q)
@@ -259,6 +339,7 @@ static int init_c(srsran_ldpc_decoder_t* q)
   }
 
   q->decode_c = decode_c;
+  set_state_c(q);
 
   return 0;
 }
@@ -278,6 +359,7 @@ static void free_dec_c_flood(void* o)
 
 /*! Carries out the decoding with 8-bit integer-valued LLRs, flooded scheduling. */
 LDPC_DECODER_TEMPLATE_FLOOD(int8_t, c_flood);
+LDPC_DECODER_STATE_TEMPLATE_FLOOD(int8_t, c_flood);
 
 /*! Initializes the decoder to work with 8-bit integer-valued LLRs. */
 static int init_c_flood(srsran_ldpc_decoder_t* q)
@@ -291,6 +373,7 @@ static int init_c_flood(srsran_ldpc_decoder_t* q)
   }
 
   q->decode_c = decode_c_flood;
+  set_state_c_flood(q);
 
   return 0;
 }
@@ -311,6 +394,7 @@ static void free_dec_c_avx2(void* o)
 
 /*! Carries out the decoding with 8-bit integer-valued LLRs (AVX2 implementation). */
 LDPC_DECODER_TEMPLATE(int8_t, c_avx2);
+LDPC_DECODER_STATE_TEMPLATE(int8_t, c_avx2);
 
 /*! Initializes the decoder to work with 8-bit integer-valued LLRs (AVX2 implementation). */
 static int init_c_avx2(srsran_ldpc_decoder_t* q)
@@ -324,6 +408,7 @@ static int init_c_avx2(srsran_ldpc_decoder_t* q)
   }
 
   q->decode_c = decode_c_avx2;
+  set_state_c_avx2(q);
 
   return 0;
 }
@@ -344,6 +429,7 @@ static void free_dec_c_avx2long(void* o)
 
 /*! Carries out the decoding with 8-bit integer-valued LLRs (AVX2 implementation, large lifting size). */
 LDPC_DECODER_TEMPLATE(int8_t, c_avx2long);
+LDPC_DECODER_STATE_TEMPLATE(int8_t, c_avx2long);
 
 /*! Initializes the decoder to work with 8-bit integer-valued LLRs (AVX2 implementation, large lifting size). */
 static int init_c_avx2long(srsran_ldpc_decoder_t* q)
@@ -357,6 +443,7 @@ static int init_c_avx2long(srsran_ldpc_decoder_t* q)
   }
 
   q->decode_c = decode_c_avx2long;
+  set_state_c_avx2long(q);
 
   return 0;
 }
@@ -377,6 +464,7 @@ static void free_dec_c_avx2_flood(void* o)
 
 /*! Carries out the decoding with 8-bit integer-valued LLRs (AVX2 implementation, flooded scheduling). */
 LDPC_DECODER_TEMPLATE_FLOOD(int8_t, c_avx2_flood);
+LDPC_DECODER_STATE_TEMPLATE_FLOOD(int8_t, c_avx2_flood);
 
 /*! Initializes the decoder to work with 8-bit integer-valued LLRs (AVX2 implementation, flooded scheduling). */
 static int init_c_avx2_flood(srsran_ldpc_decoder_t* q)
@@ -390,6 +478,7 @@ static int init_c_avx2_flood(srsran_ldpc_decoder_t* q)
   }
 
   q->decode_c = decode_c_avx2_flood;
+  set_state_c_avx2_flood(q);
 
   return 0;
 }
@@ -411,6 +500,7 @@ static void free_dec_c_avx2long_flood(void* o)
 /*! Carries out the decoding with 8-bit integer-valued LLRs (flooded scheduling, AVX2 implementation, large lifting
  * size). */
 LDPC_DECODER_TEMPLATE_FLOOD(int8_t, c_avx2long_flood)
+LDPC_DECODER_STATE_TEMPLATE_FLOOD(int8_t, c_avx2long_flood)
 
 /*! Initializes the decoder to work with 8-bit integer-valued LLRs
  * (flooded scheduling, AVX2 implementation, large lifting size). */
@@ -425,6 +515,7 @@ static int init_c_avx2long_flood(srsran_ldpc_decoder_t* q)
   }
 
   q->decode_c = decode_c_avx2long_flood;
+  set_state_c_avx2long_flood(q);
 
   return 0;
 }
@@ -450,6 +541,7 @@ static void free_dec_c_avx512(void* o)
 
 /*! Carries out the decoding with 8-bit integer-valued LLRs (AVX512 implementation). */
 LDPC_DECODER_TEMPLATE(int8_t, c_avx512)
+LDPC_DECODER_STATE_TEMPLATE(int8_t, c_avx512)
 
 /*! Initializes the decoder to work with 8-bit integer-valued LLRs (AVX512 implementation). */
 static int init_c_avx512(srsran_ldpc_decoder_t* q)
@@ -463,6 +555,7 @@ static int init_c_avx512(srsran_ldpc_decoder_t* q)
   }
 
   q->decode_c = decode_c_avx512;
+  set_state_c_avx512(q);
 
   return 0;
 }
@@ -483,6 +576,7 @@ static void free_dec_c_avx512long(void* o)
 
 /*! Carries out the decoding with 8-bit integer-valued LLRs (AVX512 implementation, large lifting size). */
 LDPC_DECODER_TEMPLATE(int8_t, c_avx512long)
+LDPC_DECODER_STATE_TEMPLATE(int8_t, c_avx512long)
 
 /*! Initializes the decoder to work with 8-bit integer-valued LLRs (AVX512 implementation, large lifting size). */
 static int init_c_avx512long(srsran_ldpc_decoder_t* q)
@@ -496,6 +590,7 @@ static int init_c_avx512long(srsran_ldpc_decoder_t* q)
   }
 
   q->decode_c = decode_c_avx512long;
+  set_state_c_avx512long(q);
 
   return 0;
 }
@@ -517,6 +612,7 @@ static void free_dec_c_avx512long_flood(void* o)
 /*! Carries out the decoding with 8-bit integer-valued LLRs (flooded scheduling, AVX512 implementation, large lifting
  * size). */
 LDPC_DECODER_TEMPLATE_FLOOD(int8_t, c_avx512long_flood)
+LDPC_DECODER_STATE_TEMPLATE_FLOOD(int8_t, c_avx512long_flood)
 
 /*! Initializes the decoder to work with 8-bit integer-valued LLRs
  * (flooded scheduling, AVX512 implementation, large lifting size). */
@@ -531,6 +627,7 @@ static int init_c_avx512long_flood(srsran_ldpc_decoder_t* q)
   }
 
   q->decode_c = decode_c_avx512long_flood;
+  set_state_c_avx512long_flood(q);
 
   return 0;
 }
@@ -683,3 +780,70 @@ int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
 {
   return q->decode_c(q, llrs, message, cdwd_rm_length, crc);
 }
+
+int srsran_ldpc_decoder_state_init(srsran_ldpc_decoder_state_t* s, srsran_ldpc_decoder_t* q)
+{
+  if (s == NULL || q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  bzero(s, sizeof(srsran_ldpc_decoder_state_t));
+
+  if (q->create_state == NULL) {
+    ERROR("The decoder does not support independent decoding states");
+    return SRSRAN_ERROR;
+  }
+
+  s->ptr = q->create_state(q);
+  if (s->ptr == NULL) {
+    ERROR("Create_ldpc_dec failed");
+    return SRSRAN_ERROR;
+  }
+  s->decoder = q;
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_ldpc_decoder_state_free(srsran_ldpc_decoder_state_t* s)
+{
+  if (s == NULL) {
+    return;
+  }
+
+  if (s->decoder != NULL && s->ptr != NULL) {
+    s->decoder->free_state(s->ptr);
+  }
+  bzero(s, sizeof(srsran_ldpc_decoder_state_t));
+}
+
+int srsran_ldpc_decoder_state_start_c(srsran_ldpc_decoder_state_t* s, const int8_t* llrs, uint32_t cdwd_rm_length)
+{
+  if (s == NULL || s->ptr == NULL || llrs == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  s->n_layers = (uint8_t)s->decoder->start_c(s->decoder, s->ptr, llrs, cdwd_rm_length);
+  s->nof_iter = 0;
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_ldpc_decoder_state_iterate_crc_c(srsran_ldpc_decoder_state_t* s, uint8_t* message, srsran_crc_t* crc)
+{
+  if (s == NULL || s->ptr == NULL || message == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  srsran_ldpc_decoder_t* q = s->decoder;
+
+  q->iterate_c(q, s->ptr, s->n_layers);
+  s->nof_iter++;
+
+  q->extract_c(s->ptr, message, q->liftK);
+
+  if (crc == NULL) {
+    return 1;
+  }
+
+  return srsran_crc_match(crc, message, q->liftK - crc->order) ? 1 : 0;
+}
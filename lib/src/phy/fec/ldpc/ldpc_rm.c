@@ -79,10 +79,6 @@ static const uint32_t MAXE = 273 * 13 * 12 * 8 * 4;
 /*!
  * \brief Describes an rate matcher.
  */
-struct pRM_tx {
-  uint8_t* tmp_rm_codeword; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
-};
-
 /*!
  * \brief Describes an rate dematcher (float version).
  */
@@ -99,14 +95,6 @@ struct pRM_rx_s {
   uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
 };
 
-/*!
- * \brief Describes an rate dematcher (char version).
- */
-struct pRM_rx_c {
-  int8_t*   tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
-  uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
-};
-
 /*!
  * Initialize rate-matching parameters
  */
@@ -167,29 +155,33 @@ static int init_rm(srsran_ldpc_rm_t*  p,
 }
 
 /*!
- * Bit selection for the rate-matching block. Selects out_len bits, starting from
- * the k0th, ingoring filler bits, and consider an input buffer of length Ncb.
+ * Bit selection and bit interleaving for the rate-matching block, in a single pass. Selects out_len bits, starting
+ * from the k0th, ignoring filler bits, and considering an input buffer of length Ncb. The k-th selected bit goes to
+ * row k / cols and column k % cols of the interleaver, so each row is a run of consecutive selected bits written with
+ * a stride of mod_order.
  */
-static void bit_selection_rm_tx(const uint8_t* input,
-                                uint8_t*       output,
-                                const uint32_t out_len,
-                                const uint32_t k0,
-                                const uint32_t Ncb)
+static void bit_selection_interleaver_rm_tx(const uint8_t* input,
+                                            uint8_t*       output,
+                                            const uint32_t out_len,
+                                            const uint32_t k0,
+                                            const uint32_t Ncb,
+                                            const uint32_t mod_order)
 {
-  uint32_t E = out_len;
-
-  uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-
-  while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (input[icwd] != FILLER_BIT) {
-      output[k] = input[icwd];
-      k         = k + 1;
+  uint32_t cols = out_len / mod_order;
+  uint32_t icwd = k0 % Ncb;
+
+  for (uint32_t i = 0; i < mod_order; i++) {
+    uint8_t* row = &output[i];
+    uint32_t j   = 0;
+    while (j < cols) {
+      uint8_t bit = input[icwd];
+      icwd        = (icwd + 1 == Ncb) ? 0 : icwd + 1;
+      if (bit != FILLER_BIT) {
+        row[j * mod_order] = bit;
+        j++;
+      }
     }
-    j = j + 1;
-  } // while
+  }
 }
 
 /*!
@@ -289,72 +281,45 @@ static void bit_selection_rm_rx_s(const int16_t* input,
 }
 
 /*!
- * Undoes bit selection for the rate-dematching block (int8_t).
- * The output has the codeword length N. It inserts filler bits as INFINITY symbols
- * (to indicate very reliable 0 bit), and set to 0 (completely unknown bit) all
- * missing symbol. Repeated symbols are added.
- * The input memory *output shall be either initialized to all zeros or to the
- * result of previous redundancy versions is available.
+ * Bit deinterleaving, bit selection and soft combining for the 8-bit rate-dematching block, in a single pass. The k-th
+ * selected bit is read from row k / cols and column k % cols of the interleaver, that is from
+ * input[(k % cols) * mod_order + k / cols], and it is added with saturation to its position in the circular buffer.
+ * The output has the codeword length N, filler bits are set to INFINITY. The output memory shall be either
+ * initialized to all zeros or to the result of previous redundancy versions.
  */
-static void bit_selection_rm_rx_c(const int8_t*  input,
-                                  const uint32_t in_len,
-                                  int8_t*        output,
-                                  uint32_t*      indices,
-                                  const uint32_t ini_exclude,
-                                  const uint32_t end_exclude,
-                                  const uint32_t k0,
-                                  const uint32_t Ncb)
+static void bit_selection_interleaver_rm_rx_c(const int8_t*  input,
+                                              const uint32_t in_len,
+                                              int8_t*        output,
+                                              const uint32_t ini_exclude,
+                                              const uint32_t end_exclude,
+                                              const uint32_t k0,
+                                              const uint32_t Ncb,
+                                              const uint32_t mod_order)
 {
-  uint32_t E = in_len;
-
-  uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-  while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (!(icwd >= ini_exclude && icwd < end_exclude)) { // avoid filler bits
-      indices[k] = icwd;
-      k          = k + 1;
-    }
-    j = j + 1;
-  } // while
-
   // set filler bits to INFINITY
-  const long infinity8 = (1U << 7U) - 1; // Max positive value in 8-bit representation
+  const int8_t infinity8 = (1U << 7U) - 1; // Max positive value in 8-bit representation
   for (uint32_t i = ini_exclude; i < end_exclude; i++) {
     output[i] = infinity8;
   }
 
-  // Add soft bits, in case of repetition
-  const int16_t infinity7 =
-      (1U << 6U) - 1; // Messages use a 15-bit quantization. Soft bits use the remaining bit to denote infinity.
-  // input is assume to be quantized from -infinity15 to infinity15. Only filler bits can be infinity16
-  long tmp = 0;
-  for (uint32_t i = 0; i < E; i++) {
-    tmp = (long)output[indices[i]] + input[i];
-    if (tmp > infinity7) {
-      tmp = infinity7;
-    }
-    if (tmp < -infinity7) {
-      tmp = -infinity7;
-    }
-    output[indices[i]] = (int8_t)tmp;
-  }
-}
+  // Add soft bits, in case of repetition. Soft bits use the remaining bit to denote infinity
+  const int16_t infinity7 = (1U << 6U) - 1;
+  uint32_t      cols      = in_len / mod_order;
+  uint32_t      icwd      = k0 % Ncb;
+  for (uint32_t i = 0; i < mod_order; i++) {
+    const int8_t* row = &input[i];
+    for (uint32_t j = 0; j < cols; j++) {
+      // avoid filler bits
+      while (icwd >= ini_exclude && icwd < end_exclude) {
+        icwd = (icwd + 1 == Ncb) ? 0 : icwd + 1;
+      }
 
-/*!
- * Bit interleaver
- */
-static void
-bit_interleaver_rm_tx(const uint8_t* input, uint8_t* output, const uint32_t in_out_len, const uint32_t mod_order)
-{
-  uint32_t cols = 0;
-  uint32_t rows = 0;
-  rows          = mod_order;
-  cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
-    for (uint32_t i = 0; i < rows; i++) {
-      output[i + j * rows] = input[i * cols + j];
+      int16_t tmp  = (int16_t)output[icwd] + row[j * mod_order];
+      tmp          = SRSRAN_MIN(tmp, infinity7);
+      tmp          = SRSRAN_MAX(tmp, -infinity7);
+      output[icwd] = (int8_t)tmp;
+
+      icwd = (icwd + 1 == Ncb) ? 0 : icwd + 1;
     }
   }
 }
@@ -393,42 +358,14 @@ bit_interleaver_rm_rx_s(const int16_t* input, int16_t* output, const uint32_t in
   }
 }
 
-/*!
- * Bit deinterleaver (short)
- */
-static void
-bit_interleaver_rm_rx_c(const int8_t* input, int8_t* output, const uint32_t in_out_len, const uint32_t mod_order)
-{
-  uint32_t cols = 0;
-  uint32_t rows = 0;
-  rows          = mod_order;
-  cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
-    for (uint32_t i = 0; i < rows; i++) {
-      output[i * cols + j] = input[j * rows + i];
-    }
-  }
-}
-
 int srsran_ldpc_rm_tx_init(srsran_ldpc_rm_t* p)
 {
   if (p == NULL) {
     return -1;
   }
 
-  struct pRM_tx* pp = NULL; // pointer to the rate matcher instance
-
-  // allocate memory to the rate-matcher instance
-  if ((pp = malloc(sizeof(struct pRM_tx))) == NULL) {
-    return -1;
-  }
-  p->ptr = pp;
-
-  // allocate memory to the rm_codeword after bit selection.
-  if ((pp->tmp_rm_codeword = srsran_vec_u8_malloc(MAXE)) == NULL) {
-    free(pp);
-    return -1;
-  }
+  // The bit selection writes straight into the interleaver output, no registers are needed
+  p->ptr = NULL;
 
   return 0;
 }
@@ -495,25 +432,8 @@ int srsran_ldpc_rm_rx_init_c(srsran_ldpc_rm_t* p)
     return -1;
   }
 
-  struct pRM_rx_c* pp = NULL; // pointer to the rate matcher instance
-
-  // allocate memory to ther rate-demacher instance
-  if ((pp = malloc(sizeof(struct pRM_rx_c))) == NULL) {
-    return -1;
-  }
-  p->ptr = pp;
-
-  // allocate memory to the temporal buffer
-  if ((pp->tmp_rm_symbol = srsran_vec_i8_malloc(MAXE)) == NULL) {
-    free(pp);
-    return -1;
-  }
-
-  if ((pp->indices = srsran_vec_u32_malloc(MAXE)) == NULL) {
-    free(pp->tmp_rm_symbol);
-    free(pp);
-    return -1;
-  }
+  // The rate dematching combines straight from the interleaved input, no registers are needed
+  p->ptr = NULL;
 
   return 0;
 }
@@ -521,13 +441,7 @@ int srsran_ldpc_rm_rx_init_c(srsran_ldpc_rm_t* p)
 void srsran_ldpc_rm_tx_free(srsran_ldpc_rm_t* q)
 {
   if (q != NULL) {
-    struct pRM_tx* qq = q->ptr;
-    if (qq != NULL) {
-      if (qq->tmp_rm_codeword != NULL) {
-        free(qq->tmp_rm_codeword);
-      }
-      free(qq);
-    }
+    q->ptr = NULL;
   }
 }
 
@@ -566,16 +480,7 @@ void srsran_ldpc_rm_rx_free_s(srsran_ldpc_rm_t* q)
 void srsran_ldpc_rm_rx_free_c(srsran_ldpc_rm_t* q)
 {
   if (q != NULL) {
-    struct pRM_rx_c* qq = q->ptr;
-    if (qq != NULL) {
-      if (qq->tmp_rm_symbol != NULL) {
-        free(qq->tmp_rm_symbol);
-      }
-      if (qq->indices != NULL) {
-        free(qq->indices);
-      }
-      free(qq);
-    }
+    q->ptr = NULL;
   }
 }
 
@@ -596,15 +501,7 @@ int srsran_ldpc_rm_tx(srsran_ldpc_rm_t*        q,
     exit(-1);
   }
 
-  struct pRM_tx* pp              = q->ptr;
-  uint8_t*       tmp_rm_codeword = pp->tmp_rm_codeword;
-
-  if (q->mod_order == 1) { // interleaver can be skipped
-    bit_selection_rm_tx(input, output, q->E, q->k0, q->Ncb);
-  } else {
-    bit_selection_rm_tx(input, tmp_rm_codeword, q->E, q->k0, q->Ncb);
-    bit_interleaver_rm_tx(tmp_rm_codeword, output, q->E, q->mod_order);
-  }
+  bit_selection_interleaver_rm_tx(input, output, q->E, q->k0, q->Ncb, q->mod_order);
 
   return 0;
 }
@@ -688,18 +585,10 @@ int srsran_ldpc_rm_rx_c(srsran_ldpc_rm_t*        q,
     exit(-1);
   }
 
-  struct pRM_rx_c* pp            = q->ptr;
-  int8_t*          tmp_rm_symbol = pp->tmp_rm_symbol;
-  uint32_t*        indices       = pp->indices;
-  uint32_t         end_exclude   = q->K - 2 * q->ls;
-  uint32_t         ini_exclude   = end_exclude - q->F;
+  uint32_t end_exclude = q->K - 2 * q->ls;
+  uint32_t ini_exclude = end_exclude - q->F;
 
-  if (q->mod_order == 1) { // interleaver can be skipped
-    bit_selection_rm_rx_c(input, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
-  } else {
-    bit_interleaver_rm_rx_c(input, tmp_rm_symbol, q->E, q->mod_order);
-    bit_selection_rm_rx_c(tmp_rm_symbol, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
-  }
+  bit_selection_interleaver_rm_rx_c(input, q->E, output, ini_exclude, end_exclude, q->k0, q->Ncb, q->mod_order);
 
   // Return the number of useful LLR
   return (int)SRSRAN_MIN(q->k0 + q->E, q->Ncb);
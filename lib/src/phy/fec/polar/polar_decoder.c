@@ -39,10 +39,12 @@
 
 #include "polar_decoder_ssc_c.h"
 #include "polar_decoder_ssc_c_avx2.h"
+#include "polar_decoder_ssc_c_batch.h"
 #include "polar_decoder_ssc_f.h"
 #include "polar_decoder_ssc_s.h"
 #include "srsran/phy/fec/polar/polar_decoder.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
 
 /*! SSC Polar decoder with float LLR inputs. */
 static int decode_ssc_f(void*           o,
@@ -114,6 +116,35 @@ static int decode_ssc_c_avx2(void*           o,
 }
 #endif // LV_HAVE_AVX2
 
+/*! SSC Polar decoder with int8_t LLR inputs of several codewords. */
+static int decode_ssc_c_batch(void*           o,
+                              const int8_t**  symbols,
+                              uint8_t**       data,
+                              const uint32_t  nof_codewords,
+                              const uint8_t   n,
+                              const uint16_t* frozen_set,
+                              const uint16_t  frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  if (init_polar_decoder_ssc_c_batch(q->ptr, symbols, nof_codewords, n, frozen_set, frozen_set_size) < 0) {
+    return -1;
+  }
+
+  return polar_decoder_ssc_c_batch(q->ptr, data);
+}
+
+/*! SSC Polar decoder with int8_t LLR inputs, as a batch of a single codeword. */
+static int decode_ssc_c_batch_single(void*           o,
+                                     const int8_t*   symbols,
+                                     uint8_t*        data,
+                                     const uint8_t   n,
+                                     const uint16_t* frozen_set,
+                                     const uint16_t  frozen_set_size)
+{
+  return decode_ssc_c_batch(o, &symbols, &data, 1, n, frozen_set, frozen_set_size);
+}
+
 /*! Destructor of a (float) SSC polar decoder. */
 static void free_ssc_f(void* o)
 {
@@ -144,6 +175,13 @@ static void free_ssc_c_avx2(void* o)
 }
 #endif
 
+/*! Destructor of a (int8_t, batch) SSC polar decoder. */
+static void free_ssc_c_batch(void* o)
+{
+  srsran_polar_decoder_t* q = o;
+  delete_polar_decoder_ssc_c_batch(q->ptr);
+}
+
 /*! Initializes a polar decoder structure to use the SSC polar decoder algorithm with float LLR inputs. */
 static int init_ssc_f(srsran_polar_decoder_t* q)
 {
@@ -203,6 +241,22 @@ static int init_ssc_c_avx2(srsran_polar_decoder_t* q)
 }
 #endif
 
+/*! Initializes a polar decoder structure to use the SSC polar decoder algorithm with uint8_t LLR inputs on several
+ * codewords at once. */
+static int init_ssc_c_batch(srsran_polar_decoder_t* q)
+{
+  q->decode_c       = decode_ssc_c_batch_single;
+  q->decode_c_batch = decode_ssc_c_batch;
+  q->free           = free_ssc_c_batch;
+
+  if ((q->ptr = create_polar_decoder_ssc_c_batch(q->nMax, SRSRAN_POLAR_DECODER_MAX_BATCH)) == NULL) {
+    ERROR("create_polar_decoder_ssc_c_batch failed");
+    free_ssc_c_batch(q);
+    return -1;
+  }
+  return 0;
+}
+
 int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_type_t type, const uint8_t nMax)
 {
   q->nMax = nMax;
@@ -217,6 +271,8 @@ int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_ty
     case SRSRAN_POLAR_DECODER_SSC_C_AVX2:
       return init_ssc_c_avx2(q);
 #endif
+    case SRSRAN_POLAR_DECODER_SSC_C_BATCH:
+      return init_ssc_c_batch(q);
     default:
       ERROR("Decoder not implemented");
       return -1;
@@ -273,3 +329,35 @@ int srsran_polar_decoder_decode_c(srsran_polar_decoder_t* q,
 
   return -1;
 }
+
+int srsran_polar_decoder_decode_c_batch(srsran_polar_decoder_t* q,
+                                        const int8_t**          llr,
+                                        uint8_t**               data_decoded,
+                                        const uint32_t          nof_codewords,
+                                        const uint8_t           n,
+                                        const uint16_t*         frozen_set,
+                                        const uint16_t          frozen_set_size)
+{
+  if (q->nMax < n || llr == NULL || data_decoded == NULL) {
+    return -1;
+  }
+
+  uint32_t count = 0;
+  while (count < nof_codewords) {
+    uint32_t nof = nof_codewords - count;
+    if (q->decode_c_batch != NULL) {
+      nof = SRSRAN_MIN(nof, SRSRAN_POLAR_DECODER_MAX_BATCH);
+      if (q->decode_c_batch(q, &llr[count], &data_decoded[count], nof, n, frozen_set, frozen_set_size) < 0) {
+        return -1;
+      }
+    } else {
+      nof = 1;
+      if (q->decode_c(q, llr[count], data_decoded[count], n, frozen_set, frozen_set_size) < 0) {
+        return -1;
+      }
+    }
+    count += nof;
+  }
+
+  return 0;
+}
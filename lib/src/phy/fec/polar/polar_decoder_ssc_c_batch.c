@@ -0,0 +1,403 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_ssc_c_batch.c
+ * \brief Definition of the SSC polar decoder inner functions working with
+ * 8-bit integer-valued LLRs, which decodes several codewords with the same frozen set at once.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ * The codewords are interleaved with a power of 2 number of lanes, element \f$i\f$ of lane \f$b\f$ is stored at
+ * \f$i \times lanes + b\f$. Since all the codewords share the decoding tree, the functions f and g, the hard decisions
+ * and the partial sums of a node operate on \f$2^s \times lanes\f$ contiguous bytes, which fill the SIMD registers
+ * even at the lowest stages, where the single codeword decoders fall back to short (or scalar) operations.
+ *
+ * The bits are represented by {0, 128} as in polar_decoder_ssc_c_avx2.c, and the functions reproduce the AVX2
+ * saturation, so the results are bit-exact with that decoder.
+ */
+
+#include "polar_decoder_ssc_c_batch.h"
+#include "srsran/phy/fec/polar/polar_code.h"
+#include "srsran/phy/utils/vector.h"
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+#endif // LV_HAVE_AVX2
+
+/*!
+ * \brief Describes an SSC polar decoder (8-bit, batch version).
+ */
+struct pSSC_c_batch {
+  int8_t*        llr0[NMAX_LOG + 1]; /*!< \brief Pointers to the upper half of LLRs values at all stages. */
+  int8_t*        llr1[NMAX_LOG + 1]; /*!< \brief Pointers to the lower half of LLRs values at all stages. */
+  int8_t*        llr;                /*!< \brief LLR buffer of all the stages. */
+  uint8_t*       est_bit;            /*!< \brief Temporary estimated bits of all the lanes. */
+  struct Params* param;              /*!< \brief Pointer to a Params structure. */
+  void*          tmp_node_type;      /*!< \brief Pointer to a Tmp_node_type. */
+  uint8_t        stage;              /*!< \brief Current stage [0 - code_size_log] of the decoding algorithm. */
+  uint16_t       bit_pos;            /*!< \brief Position of the next bit to be estimated (per lane). */
+  uint32_t       max_batch;          /*!< \brief Maximum number of lanes. */
+  uint32_t       nof_lanes;          /*!< \brief Number of lanes of the current codewords, a power of 2. */
+  uint32_t       nof_codewords;      /*!< \brief Number of codewords being decoded. */
+};
+
+/*!
+ * Scalar versions of the AVX2 instructions, used for the vector tails and when AVX2 is not available.
+ */
+static inline int8_t sign_c(int8_t a, int8_t b)
+{
+  return (b < 0) ? (int8_t)(-a) : ((b == 0) ? 0 : a);
+}
+
+static inline int8_t abs_c(int8_t a)
+{
+  return (a < 0) ? (int8_t)(-a) : a;
+}
+
+static inline int8_t adds_c(int8_t a, int8_t b)
+{
+  int s = (int)a + (int)b;
+  return (int8_t)((s > 127) ? 127 : ((s < -128) ? -128 : s));
+}
+
+/*!
+ * Box-plus operator, \f$ z = sign(x) \times sign(y) \times \min(abs(x), abs(y)) \f$.
+ */
+static void function_f(const int8_t* x, const int8_t* y, int8_t* z, uint32_t len)
+{
+  uint32_t i = 0;
+#ifdef LV_HAVE_AVX2
+  for (; i + 32 <= len; i += 32) {
+    __m256i m_x    = _mm256_loadu_si256((__m256i*)&x[i]);
+    __m256i m_y    = _mm256_loadu_si256((__m256i*)&y[i]);
+    __m256i m_sign = _mm256_sign_epi8(m_x, m_y);
+    __m256i m_min  = _mm256_min_epi8(_mm256_abs_epi8(m_x), _mm256_abs_epi8(m_y));
+    _mm256_storeu_si256((__m256i*)&z[i], _mm256_sign_epi8(m_min, m_sign));
+  }
+#endif // LV_HAVE_AVX2
+  for (; i < len; i++) {
+    int8_t abs_x = abs_c(x[i]);
+    int8_t abs_y = abs_c(y[i]);
+    z[i]         = sign_c((abs_x < abs_y) ? abs_x : abs_y, sign_c(x[i], y[i]));
+  }
+}
+
+/*!
+ * Returns \f$ z = y + x \f$ if \f$ b = 0 \f$ and \f$ z = y - x \f$ if \f$ b = 128 \f$, saturated to [-127, 127].
+ */
+static void function_g(const uint8_t* b, const int8_t* x, const int8_t* y, int8_t* z, uint32_t len)
+{
+  uint32_t i = 0;
+#ifdef LV_HAVE_AVX2
+  const __m256i M_1      = _mm256_set1_epi8(1);
+  const __m256i M_NEG127 = _mm256_set1_epi8(-127);
+  for (; i + 32 <= len; i += 32) {
+    __m256i m_x      = _mm256_loadu_si256((__m256i*)&x[i]);
+    __m256i m_y      = _mm256_loadu_si256((__m256i*)&y[i]);
+    __m256i m_b      = _mm256_loadu_si256((__m256i*)&b[i]);
+    __m256i m_sign_x = _mm256_sign_epi8(m_x, _mm256_or_si256(m_b, M_1));
+    __m256i m_z      = _mm256_max_epi8(M_NEG127, _mm256_adds_epi8(m_sign_x, m_y));
+    _mm256_storeu_si256((__m256i*)&z[i], m_z);
+  }
+#endif // LV_HAVE_AVX2
+  for (; i < len; i++) {
+    int8_t s = adds_c(sign_c(x[i], (int8_t)(b[i] | 1U)), y[i]);
+    z[i]     = (s < -127) ? -127 : s;
+  }
+}
+
+/*!
+ * Bitwise XOR, \f$ z = x \oplus y \f$.
+ */
+static void xor_bbb(const uint8_t* x, const uint8_t* y, uint8_t* z, uint32_t len)
+{
+  uint32_t i = 0;
+#ifdef LV_HAVE_AVX2
+  for (; i + 32 <= len; i += 32) {
+    __m256i m_x = _mm256_loadu_si256((__m256i*)&x[i]);
+    __m256i m_y = _mm256_loadu_si256((__m256i*)&y[i]);
+    _mm256_storeu_si256((__m256i*)&z[i], _mm256_xor_si256(m_x, m_y));
+  }
+#endif // LV_HAVE_AVX2
+  for (; i < len; i++) {
+    z[i] = x[i] ^ y[i];
+  }
+}
+
+/*!
+ * Hard decision, returns 128 if \f$ x < 0 \f$ and 0 otherwise.
+ */
+static void hard_bit(const int8_t* x, uint8_t* z, uint32_t len)
+{
+  uint32_t i = 0;
+#ifdef LV_HAVE_AVX2
+  const __m256i M_MSB_MASK = _mm256_set1_epi8(-128);
+  for (; i + 32 <= len; i += 32) {
+    __m256i m_x = _mm256_loadu_si256((__m256i*)&x[i]);
+    _mm256_storeu_si256((__m256i*)&z[i], _mm256_and_si256(m_x, M_MSB_MASK));
+  }
+#endif // LV_HAVE_AVX2
+  for (; i < len; i++) {
+    z[i] = (uint8_t)x[i] & 0x80U;
+  }
+}
+
+void delete_polar_decoder_ssc_c_batch(void* p)
+{
+  struct pSSC_c_batch* pp = p;
+
+  if (pp == NULL) {
+    return;
+  }
+
+  if (pp->llr) {
+    free(pp->llr);
+  }
+  if (pp->est_bit) {
+    free(pp->est_bit);
+  }
+  if (pp->param) {
+    if (pp->param->node_type) {
+      if (pp->param->node_type[0]) {
+        free(pp->param->node_type[0]);
+      }
+      free(pp->param->node_type);
+    }
+    if (pp->param->code_stage_size) {
+      free(pp->param->code_stage_size);
+    }
+    free(pp->param);
+  }
+  if (pp->tmp_node_type) {
+    delete_tmp_node_type(pp->tmp_node_type);
+  }
+  free(pp);
+}
+
+void* create_polar_decoder_ssc_c_batch(const uint8_t nMax, const uint32_t max_batch)
+{
+  if (nMax > NMAX_LOG || max_batch == 0 || (max_batch & (max_batch - 1)) != 0) {
+    return NULL;
+  }
+
+  struct pSSC_c_batch* pp = SRSRAN_MEM_ALLOC(struct pSSC_c_batch, 1);
+  if (pp == NULL) {
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(pp, struct pSSC_c_batch, 1);
+  pp->max_batch = max_batch;
+
+  // algorithm constants/parameters
+  pp->param = SRSRAN_MEM_ALLOC(struct Params, 1);
+  if (pp->param == NULL) {
+    delete_polar_decoder_ssc_c_batch(pp);
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(pp->param, struct Params, 1);
+
+  pp->param->code_stage_size = srsran_vec_u16_malloc(nMax + 1);
+  if (pp->param->code_stage_size == NULL) {
+    delete_polar_decoder_ssc_c_batch(pp);
+    return NULL;
+  }
+  pp->param->code_stage_size[0] = 1;
+  for (uint8_t i = 1; i < nMax + 1; i++) {
+    pp->param->code_stage_size[i] = 2 * pp->param->code_stage_size[i - 1];
+  }
+
+  // There are LLR buffers for n = 0 to n = code_size_log, each with 2^n vectors of max_batch lanes
+  uint32_t llr_all_stages = 1U << (nMax + 1U);
+  pp->llr                 = srsran_vec_i8_malloc(llr_all_stages * max_batch);
+  pp->est_bit             = srsran_vec_u8_malloc(pp->param->code_stage_size[nMax] * max_batch);
+  if (pp->llr == NULL || pp->est_bit == NULL) {
+    delete_polar_decoder_ssc_c_batch(pp);
+    return NULL;
+  }
+
+  // allocate memory for node type pointers, one per stage. Stage s has 2^(N-s) nodes s=0,...,N.
+  pp->param->node_type = SRSRAN_MEM_ALLOC(uint8_t*, nMax + 1);
+  if (pp->param->node_type == NULL) {
+    delete_polar_decoder_ssc_c_batch(pp);
+    return NULL;
+  }
+  pp->param->node_type[0] = srsran_vec_u8_malloc(llr_all_stages);
+  if (pp->param->node_type[0] == NULL) {
+    delete_polar_decoder_ssc_c_batch(pp);
+    return NULL;
+  }
+  for (uint8_t s = 1; s < nMax + 1; s++) {
+    pp->param->node_type[s] = pp->param->node_type[s - 1] + pp->param->code_stage_size[nMax - s + 1];
+  }
+
+  // memory allocation to compute node_type
+  pp->tmp_node_type = create_tmp_node_type(nMax);
+  if (pp->tmp_node_type == NULL) {
+    delete_polar_decoder_ssc_c_batch(pp);
+    return NULL;
+  }
+
+  return pp;
+}
+
+int init_polar_decoder_ssc_c_batch(void*           p,
+                                   const int8_t**  input_llr,
+                                   const uint32_t  nof_codewords,
+                                   const uint8_t   code_size_log,
+                                   const uint16_t* frozen_set,
+                                   const uint16_t  frozen_set_size)
+{
+  struct pSSC_c_batch* pp = p;
+
+  if (pp == NULL || input_llr == NULL || nof_codewords == 0 || nof_codewords > pp->max_batch) {
+    return -1;
+  }
+
+  // Select the smallest power of 2 number of lanes that fits all the codewords
+  uint32_t nof_lanes = 1;
+  while (nof_lanes < nof_codewords) {
+    nof_lanes *= 2;
+  }
+  pp->nof_lanes     = nof_lanes;
+  pp->nof_codewords = nof_codewords;
+
+  pp->param->code_size_log = code_size_log;
+  uint16_t code_size       = pp->param->code_stage_size[code_size_log];
+
+  // The LLR buffers of every stage hold 2^s vectors of nof_lanes
+  int8_t* llr = pp->llr;
+  for (uint8_t s = 0; s < code_size_log + 1; s++) {
+    pp->llr0[s] = llr;
+    pp->llr1[s] = llr + ((s == 0) ? 1 : pp->param->code_stage_size[s - 1]) * nof_lanes;
+    llr += pp->param->code_stage_size[s] * nof_lanes;
+  }
+
+  // Initialize est_bit vector to all zeros
+  srsran_vec_u8_zero(pp->est_bit, code_size * nof_lanes);
+
+  // Interleaves the input LLRs in the buffer of the last stage, the unused lanes are set to zero
+  int8_t* llr_n = pp->llr0[code_size_log];
+  for (uint32_t b = 0; b < nof_lanes; b++) {
+    if (b < nof_codewords) {
+      for (uint16_t i = 0; i < code_size; i++) {
+        llr_n[i * nof_lanes + b] = input_llr[b][i];
+      }
+    } else {
+      for (uint16_t i = 0; i < code_size; i++) {
+        llr_n[i * nof_lanes + b] = 0;
+      }
+    }
+  }
+
+  // Initializes the state of the decoding tree
+  pp->stage   = code_size_log + 1; // start from the only one node at the last stage + 1.
+  pp->bit_pos = 0;
+
+  // frozen_set
+  pp->param->frozen_set_size = frozen_set_size;
+
+  // computes the node types for the decoding tree
+  compute_node_type(pp->tmp_node_type, pp->param->node_type, frozen_set, code_size_log, frozen_set_size);
+
+  return 0;
+}
+
+static void simplified_node(struct pSSC_c_batch* pp)
+{
+  pp->stage--; // to child node.
+
+  uint8_t  stage     = pp->stage;
+  uint32_t nof_lanes = pp->nof_lanes;
+  uint16_t node      = pp->bit_pos >> stage;
+
+  uint16_t stage_size      = pp->param->code_stage_size[stage];
+  uint16_t stage_half_size = 0;
+  uint8_t* estbits0        = NULL;
+  uint8_t* estbits1        = NULL;
+
+  switch (pp->param->node_type[stage][node]) {
+    case RATE_1:
+      hard_bit(pp->llr0[stage], pp->est_bit + pp->bit_pos * nof_lanes, stage_size * nof_lanes);
+      pp->bit_pos += stage_size;
+      break;
+
+    case RATE_0:
+      pp->bit_pos += stage_size;
+      break;
+
+    case RATE_R:
+      stage_half_size = pp->param->code_stage_size[stage - 1];
+
+      function_f(pp->llr0[stage], pp->llr1[stage], pp->llr0[stage - 1], stage_half_size * nof_lanes);
+
+      // move to the child node to the left (up) of the tree.
+      simplified_node(pp);
+
+      estbits0 = pp->est_bit + (pp->bit_pos - stage_half_size) * nof_lanes;
+      function_g(estbits0, pp->llr0[stage], pp->llr1[stage], pp->llr0[stage - 1], stage_half_size * nof_lanes);
+
+      // move to the child node to the right (down) of the tree.
+      simplified_node(pp);
+
+      estbits0 = pp->est_bit + (pp->bit_pos - stage_size) * nof_lanes;
+      estbits1 = estbits0 + stage_half_size * nof_lanes;
+      xor_bbb(estbits0, estbits1, estbits0, stage_half_size * nof_lanes);
+      break;
+
+    default:
+      printf("ERROR: wrong node type %d\n", pp->param->node_type[stage][node]);
+      exit(-1);
+      break;
+  }
+
+  pp->stage++; // to parent node.
+}
+
+int polar_decoder_ssc_c_batch(void* p, uint8_t** data_decoded)
+{
+  struct pSSC_c_batch* pp = p;
+
+  if (pp == NULL || data_decoded == NULL) {
+    return -1;
+  }
+
+  simplified_node(pp);
+
+  // est_bit contains the coded bits of all the lanes, the messages are obtained by encoding them in place
+  uint32_t nof_lanes = pp->nof_lanes;
+  uint16_t code_size = pp->param->code_stage_size[pp->param->code_size_log];
+  for (uint16_t half = 1; half < code_size; half *= 2) {
+    for (uint16_t start = 0; start < code_size; start += 2 * half) {
+      uint8_t* u0 = pp->est_bit + start * nof_lanes;
+      uint8_t* u1 = u0 + half * nof_lanes;
+      xor_bbb(u0, u1, u0, half * nof_lanes);
+    }
+  }
+
+  // De-interleaves the messages and transforms {0, 128} into {0, 1}
+  for (uint32_t b = 0; b < pp->nof_codewords; b++) {
+    for (uint16_t i = 0; i < code_size; i++) {
+      data_decoded[b][i] = pp->est_bit[i * nof_lanes + b] >> 7U;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_ssc_c_batch.h
+ * \brief Declaration of the SSC polar decoder inner functions working with
+ * 8-bit integer-valued LLRs, which decodes several codewords with the same frozen set at once.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#ifndef POLAR_DECODER_SSC_C_BATCH_H
+#define POLAR_DECODER_SSC_C_BATCH_H
+
+#include "polar_decoder_ssc_all.h"
+
+/*!
+ * Creates an SSC polar decoder structure of type pSSC_c_batch, and allocates memory for the decoding buffers.
+ *
+ * \param[in] nMax \f$log_2\f$ of the number of bits in the codeword.
+ * \param[in] max_batch Maximum number of codewords decoded at once, it must be a power of 2.
+ * \return A pointer to a pSSC_c_batch structure if the function executes correctly, NULL otherwise.
+ */
+void* create_polar_decoder_ssc_c_batch(uint8_t nMax, uint32_t max_batch);
+
+/*!
+ * The (8-bit, batch) polar decoder SSC "destructor": it frees all the resources allocated to the decoder.
+ *
+ * \param[in, out] p A pointer to the dismantled decoder.
+ */
+void delete_polar_decoder_ssc_c_batch(void* p);
+
+/*!
+ * Initializes an (8-bit, batch) SSC polar decoder before processing new codewords. The LLRs of the codewords are
+ * interleaved, so that every LLR of the decoding tree is a vector with one lane per codeword and all the decoder
+ * operations run on contiguous memory for all the codewords.
+ *
+ * \param[in, out] p A void pointer used to declare a pSSC_c_batch structure.
+ * \param[in] llr LLRs for every new codeword.
+ * \param[in] nof_codewords Number of codewords, up to the max_batch given at creation.
+ * \param[in] code_size_log \f$log_2\f$ of the number of bits in the codeword.
+ * \param[in] frozen_set The position of the frozen bits in the codeword, common to all the codewords.
+ * \param[in] frozen_set_size Number of frozen bits.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int init_polar_decoder_ssc_c_batch(void*           p,
+                                   const int8_t**  llr,
+                                   const uint32_t  nof_codewords,
+                                   const uint8_t   code_size_log,
+                                   const uint16_t* frozen_set,
+                                   const uint16_t  frozen_set_size);
+
+/*!
+ * Decodes the data messages of the codewords given to init_polar_decoder_ssc_c_batch(). The result is bit-exact with
+ * the one of polar_decoder_ssc_c_avx2() for every codeword.
+ *
+ * \param[in] p A pointer to the desired decoder.
+ * \param[out] data The decoded messages, one per codeword.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int polar_decoder_ssc_c_batch(void* p, uint8_t** data);
+
+#endif // POLAR_DECODER_SSC_C_BATCH_H
@@ -237,8 +237,12 @@ int main(int argc, char** argv)
 
 #ifdef LV_HAVE_AVX2
   srsran_polar_encoder_t enc_avx2;
-  srsran_polar_decoder_t dec_c_avx2; // 8-bit
-#endif                               // LV_HAVE_AVX2
+  srsran_polar_decoder_t dec_c_avx2;  // 8-bit
+  srsran_polar_decoder_t dec_c_batch; // 8-bit, several codewords at once
+  uint8_t*               output_dec_c_batch = NULL;
+  const int8_t*          llr_c_batch[BATCH_SIZE];
+  uint8_t*               output_c_batch[BATCH_SIZE];
+#endif                                // LV_HAVE_AVX2
 
   parse_args(argc, argv);
 
@@ -276,6 +280,14 @@ int main(int argc, char** argv)
 
   // initialize a POLAR decoder (8 bit, avx2)
   srsran_polar_decoder_init(&dec_c_avx2, SRSRAN_POLAR_DECODER_SSC_C_AVX2, nMax);
+
+  // initialize a POLAR decoder (8 bit, batch)
+  srsran_polar_decoder_init(&dec_c_batch, SRSRAN_POLAR_DECODER_SSC_C_BATCH, nMax);
+  output_dec_c_batch = srsran_vec_u8_malloc(NMAX * BATCH_SIZE);
+  if (!output_dec_c_batch) {
+    perror("malloc");
+    exit(-1);
+  }
 #endif // LV_HAVE_AVX2
 
 #ifdef DATA_ALL_ONES
@@ -629,6 +641,18 @@ int main(int argc, char** argv)
           n_error_words_c_avx2[i_snr]++;
         }
       }
+
+      // batch decoding, must be bit-exact with the avx2 decoder
+      for (j = 0; j < BATCH_SIZE; j++) {
+        llr_c_batch[j]    = llr_c_avx2 + j * code.N;
+        output_c_batch[j] = output_dec_c_batch + j * code.N;
+      }
+      srsran_polar_decoder_decode_c_batch(
+          &dec_c_batch, llr_c_batch, output_c_batch, BATCH_SIZE, code.n, code.F_set, code.F_set_size);
+      if (memcmp(output_dec_c_batch, output_dec_c_avx2, BATCH_SIZE * code.N) != 0) {
+        printf("ERROR: Wrong batch decoder output. SNR= %f, Batch: %d\n", snr_db_vec[i_snr], i_batch);
+        exit(-1);
+      }
 #endif // LV_HAVE_AVX2
 
       last_i_batch[i_snr] = i_batch;
@@ -819,6 +843,8 @@ int main(int argc, char** argv)
 #ifdef LV_HAVE_AVX2
   srsran_polar_encoder_free(&enc_avx2);
   srsran_polar_decoder_free(&dec_c_avx2);
+  srsran_polar_decoder_free(&dec_c_batch);
+  free(output_dec_c_batch);
 #endif // LV_HAVE_AVX2
 
   int expected_errors = 0;
@@ -29,29 +29,93 @@
 #include "srsran/phy/fec/softbuffer.h"
 #include "srsran/phy/fec/turbo/turbodecoder_gen.h"
 #include "srsran/phy/phch/ra.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/huge_pages.h"
 #include "srsran/phy/utils/vector.h"
 
 #define MAX_PDSCH_RE(cp) (2 * SRSRAN_CP_NSYMB(cp) * 12)
 
-int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof_prb)
+int srsran_softbuffer_max_cb(uint32_t nof_prb)
 {
   int ret = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
 
   if (ret == SRSRAN_ERROR) {
     return SRSRAN_ERROR;
   }
-  uint32_t max_cb      = (uint32_t)ret / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
+  return ret / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
+}
+
+int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof_prb)
+{
+  int max_cb = srsran_softbuffer_max_cb(nof_prb);
+
+  if (max_cb == SRSRAN_ERROR) {
+    return SRSRAN_ERROR;
+  }
   uint32_t max_cb_size = SOFTBUFFER_SIZE;
 
-  return srsran_softbuffer_rx_init_guru(q, max_cb, max_cb_size);
+  return srsran_softbuffer_rx_init_guru(q, (uint32_t)max_cb, max_cb_size);
 }
 
 int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+{
+  srsran_softbuffer_rx_args_t args = {};
+  args.max_cb                      = max_cb;
+  args.max_cb_size                 = max_cb_size;
+
+  return srsran_softbuffer_rx_init_args(q, &args);
+}
+
+// Allocates the buffers of the code block cb_idx
+static int softbuffer_rx_alloc_cb(srsran_softbuffer_rx_t* q, uint32_t cb_idx)
+{
+  if (q->llr_is_8bit) {
+    q->buffer_f[cb_idx] = (int16_t*)srsran_huge_malloc(sizeof(int8_t) * q->max_cb_size);
+  } else {
+    q->buffer_f[cb_idx] = (int16_t*)srsran_huge_malloc(sizeof(int16_t) * q->max_cb_size);
+  }
+  if (!q->buffer_f[cb_idx]) {
+    perror("malloc");
+    return SRSRAN_ERROR;
+  }
+
+  q->data[cb_idx] = (uint8_t*)srsran_huge_malloc(q->max_cb_size / 8);
+  if (!q->data[cb_idx]) {
+    perror("malloc");
+    srsran_huge_free(q->buffer_f[cb_idx]);
+    q->buffer_f[cb_idx] = NULL;
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static void softbuffer_rx_free_cb(srsran_softbuffer_rx_t* q)
+{
+  if (q->buffer_f) {
+    for (uint32_t i = 0; i < q->max_cb; i++) {
+      if (q->buffer_f[i]) {
+        srsran_huge_free(q->buffer_f[i]);
+        q->buffer_f[i] = NULL;
+      }
+    }
+  }
+  if (q->data) {
+    for (uint32_t i = 0; i < q->max_cb; i++) {
+      if (q->data[i]) {
+        srsran_huge_free(q->data[i]);
+        q->data[i] = NULL;
+      }
+    }
+  }
+}
+
+int srsran_softbuffer_rx_init_args(srsran_softbuffer_rx_t* q, const srsran_softbuffer_rx_args_t* args)
 {
   int ret = SRSRAN_ERROR;
 
   // Protect pointer
-  if (!q) {
+  if (!q || !args) {
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
@@ -59,8 +123,10 @@ int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, u
   SRSRAN_MEM_ZERO(q, srsran_softbuffer_rx_t, 1);
 
   // Set internal attributes
-  q->max_cb      = max_cb;
-  q->max_cb_size = max_cb_size;
+  q->max_cb      = args->max_cb;
+  q->max_cb_size = args->max_cb_size;
+  q->llr_is_8bit = args->llr_is_8bit;
+  q->lazy_alloc  = args->lazy_alloc;
 
   q->buffer_f = SRSRAN_MEM_ALLOC(int16_t*, q->max_cb);
   if (!q->buffer_f) {
@@ -82,16 +148,9 @@ int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, u
     goto clean_exit;
   }
 
-  for (uint32_t i = 0; i < q->max_cb; i++) {
-    q->buffer_f[i] = srsran_vec_i16_malloc(q->max_cb_size);
-    if (!q->buffer_f[i]) {
-      perror("malloc");
-      goto clean_exit;
-    }
-
-    q->data[i] = srsran_vec_u8_malloc(q->max_cb_size / 8);
-    if (!q->data[i]) {
-      perror("malloc");
+  // The lazily allocated code block buffers are allocated when they are reset for a transmission
+  for (uint32_t i = 0; i < q->max_cb && !q->lazy_alloc; i++) {
+    if (softbuffer_rx_alloc_cb(q, i) < SRSRAN_SUCCESS) {
       goto clean_exit;
     }
   }
@@ -112,20 +171,11 @@ clean_exit:
 void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* q)
 {
   if (q) {
+    softbuffer_rx_free_cb(q);
     if (q->buffer_f) {
-      for (uint32_t i = 0; i < q->max_cb; i++) {
-        if (q->buffer_f[i]) {
-          free(q->buffer_f[i]);
-        }
-      }
       free(q->buffer_f);
     }
     if (q->data) {
-      for (uint32_t i = 0; i < q->max_cb; i++) {
-        if (q->data[i]) {
-          free(q->data[i]);
-        }
-      }
       free(q->data);
     }
     if (q->cb_crc) {
@@ -136,18 +186,22 @@ void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* q)
   }
 }
 
-void srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs)
+void srsran_softbuffer_rx_free_cb(srsran_softbuffer_rx_t* q)
 {
-  uint32_t nof_cb = (tbs + 24) / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
-  srsran_softbuffer_rx_reset_cb(q, SRSRAN_MIN(nof_cb, q->max_cb));
+  if (q && q->lazy_alloc) {
+    softbuffer_rx_free_cb(q);
+    srsran_softbuffer_rx_reset(q);
+  }
 }
 
-void srsran_softbuffer_rx_reset(srsran_softbuffer_rx_t* q)
+void srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs)
 {
-  srsran_softbuffer_rx_reset_cb(q, q->max_cb);
+  uint32_t nof_cb = (tbs + 24) / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
+  srsran_softbuffer_rx_reset_cb(q, SRSRAN_MIN(nof_cb, q->max_cb));
 }
 
-void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
+// Zeroes the first nof_cb code blocks that are allocated
+static void softbuffer_rx_zero_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
 {
   if (q->buffer_f) {
     if (nof_cb > q->max_cb) {
@@ -155,7 +209,11 @@ void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
     }
     for (uint32_t i = 0; i < nof_cb; i++) {
       if (q->buffer_f[i]) {
-        srsran_vec_i16_zero(q->buffer_f[i], q->max_cb_size);
+        if (q->llr_is_8bit) {
+          srsran_vec_i8_zero((int8_t*)q->buffer_f[i], q->max_cb_size);
+        } else {
+          srsran_vec_i16_zero(q->buffer_f[i], q->max_cb_size);
+        }
       }
       if (q->data[i]) {
         srsran_vec_u8_zero(q->data[i], q->max_cb_size / 8);
@@ -168,6 +226,25 @@ void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
   q->tb_crc = false;
 }
 
+void srsran_softbuffer_rx_reset(srsran_softbuffer_rx_t* q)
+{
+  softbuffer_rx_zero_cb(q, q->max_cb);
+}
+
+void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
+{
+  if (q->lazy_alloc && q->buffer_f) {
+    for (uint32_t i = 0; i < SRSRAN_MIN(nof_cb, q->max_cb); i++) {
+      // The code blocks that fail to allocate are left unallocated, the decoders report an error on them
+      if (q->buffer_f[i] == NULL && softbuffer_rx_alloc_cb(q, i) < SRSRAN_SUCCESS) {
+        ERROR("Error allocating soft-buffer for CB %d", i);
+        break;
+      }
+    }
+  }
+  softbuffer_rx_zero_cb(q, nof_cb);
+}
+
 void srsran_softbuffer_rx_reset_cb_crc(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
 {
   if (q == NULL || nof_cb == 0) {
@@ -179,14 +256,13 @@ void srsran_softbuffer_rx_reset_cb_crc(srsran_softbuffer_rx_t* q, uint32_t nof_c
 
 int srsran_softbuffer_tx_init(srsran_softbuffer_tx_t* q, uint32_t nof_prb)
 {
-  int ret = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
-  if (ret == SRSRAN_ERROR) {
+  int max_cb = srsran_softbuffer_max_cb(nof_prb);
+  if (max_cb == SRSRAN_ERROR) {
     return SRSRAN_ERROR;
   }
-  uint32_t max_cb      = (uint32_t)ret / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
   uint32_t max_cb_size = SOFTBUFFER_SIZE;
 
-  return srsran_softbuffer_tx_init_guru(q, max_cb, max_cb_size);
+  return srsran_softbuffer_tx_init_guru(q, (uint32_t)max_cb, max_cb_size);
 }
 
 int srsran_softbuffer_tx_init_guru(srsran_softbuffer_tx_t* q, uint32_t max_cb, uint32_t max_cb_size)
@@ -212,7 +288,7 @@ int srsran_softbuffer_tx_init_guru(srsran_softbuffer_tx_t* q, uint32_t max_cb, u
 
   // TODO: Use HARQ buffer limitation based on UE category
   for (uint32_t i = 0; i < q->max_cb; i++) {
-    q->buffer_b[i] = srsran_vec_u8_malloc(q->max_cb_size);
+    q->buffer_b[i] = (uint8_t*)srsran_huge_malloc(q->max_cb_size);
     if (!q->buffer_b[i]) {
       perror("malloc");
       return SRSRAN_ERROR;
@@ -230,7 +306,7 @@ void srsran_softbuffer_tx_free(srsran_softbuffer_tx_t* q)
     if (q->buffer_b) {
       for (uint32_t i = 0; i < q->max_cb; i++) {
         if (q->buffer_b[i]) {
-          free(q->buffer_b[i]);
+          srsran_huge_free(q->buffer_b[i]);
         }
       }
       free(q->buffer_b);
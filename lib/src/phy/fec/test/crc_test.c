@@ -24,6 +24,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
+#include <sys/time.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -33,21 +34,23 @@
 int      num_bits = 5001, crc_length = 24;
 uint32_t crc_poly = 0x1864CFB;
 uint32_t seed     = 1;
+int      nof_reps = 1000;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [nlps]\n", prog);
+  printf("Usage: %s [nlpst]\n", prog);
   printf("\t-n num_bits [Default %d]\n", num_bits);
   printf("\t-l crc_length [Default %d]\n", crc_length);
   printf("\t-p crc_poly (Hex) [Default 0x%x]\n", crc_poly);
   printf("\t-s seed [Default 0=time]\n");
+  printf("\t-t number of repetitions for measuring the throughput [Default %d]\n", nof_reps);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "nlpsv")) != -1) {
+  while ((opt = getopt(argc, argv, "nlpstv")) != -1) {
     switch (opt) {
       case 'n':
         num_bits = (int)strtol(argv[optind], NULL, 10);
@@ -61,6 +64,9 @@ void parse_args(int argc, char** argv)
       case 's':
         seed = (uint32_t)strtoul(argv[optind], NULL, 0);
         break;
+      case 't':
+        nof_reps = (int)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -71,6 +77,22 @@ void parse_args(int argc, char** argv)
   }
 }
 
+// Bit by bit polynomial division, used as reference for all the message lengths
+static uint32_t crc_reference(const uint8_t* bits, int len)
+{
+  uint64_t mask = ((uint64_t)1 << crc_length) - 1;
+  uint64_t crc  = 0;
+
+  for (int i = 0; i < len; i++) {
+    uint64_t feedback = ((crc >> (crc_length - 1)) & 1) ^ (bits[i] & 1);
+    crc               = (crc << 1) & mask;
+    if (feedback) {
+      crc ^= crc_poly & mask;
+    }
+  }
+  return (uint32_t)crc;
+}
+
 int main(int argc, char** argv)
 {
   int          i;
@@ -111,7 +133,51 @@ int main(int argc, char** argv)
 
   INFO("checksum=%x", crc_word);
 
+  // Compare all the lengths with the reference, packed and unpacked
+  uint8_t* data_bytes = srsran_vec_u8_malloc(num_bits / 8 + 1);
+  if (!data_bytes) {
+    perror("malloc");
+    exit(-1);
+  }
+  srsran_bit_pack_vector(data, data_bytes, num_bits);
+  for (int len = 0; len <= num_bits; len++) {
+    uint32_t reference = crc_reference(data, len);
+    if (srsran_crc_checksum(&crc_p, data, len) != reference) {
+      ERROR("Wrong checksum for %d bits", len);
+      exit(-1);
+    }
+    if (len % 8 == 0 && srsran_crc_checksum_byte(&crc_p, data_bytes, len) != reference) {
+      ERROR("Wrong byte checksum for %d bits", len);
+      exit(-1);
+    }
+  }
+
+  // Measure the throughput
+  struct timeval t[3];
+  gettimeofday(&t[1], NULL);
+  for (i = 0; i < nof_reps; i++) {
+    srsran_crc_checksum(&crc_p, data, num_bits);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double elapsed_us = t[0].tv_sec * 1e6 + t[0].tv_usec;
+
+  gettimeofday(&t[1], NULL);
+  for (i = 0; i < nof_reps; i++) {
+    srsran_crc_checksum_byte(&crc_p, data_bytes, num_bits - num_bits % 8);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double elapsed_byte_us = t[0].tv_sec * 1e6 + t[0].tv_usec;
+
+  printf("CRC%d %d bits: %.3f Gbps (bits), %.3f Gbps (bytes)\n",
+         crc_length,
+         num_bits,
+         (double)num_bits * nof_reps / (elapsed_us * 1000.0),
+         (double)(num_bits - num_bits % 8) * nof_reps / (elapsed_byte_us * 1000.0));
+
   free(data);
+  free(data_bytes);
 
   // check if generated word is as expected
   if (get_expected_word(num_bits, crc_length, crc_poly, seed, &expected_word)) {
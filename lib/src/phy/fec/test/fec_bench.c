@@ -0,0 +1,1063 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        fec_bench.c
+ * Description: Measures the decoding throughput of the turbo, LDPC, polar and
+ *              Viterbi decoders for a matrix of block sizes, code rates,
+ *              implementations and number of threads, and reports Mbps and
+ *              nanoseconds per information bit as JSON. Only the decoder call
+ *              is timed; encoding, rate matching and quantization are done
+ *              beforehand.
+ *****************************************************************************/
+
+#include <inttypes.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/fec/convolutional/convcoder.h"
+#include "srsran/phy/fec/convolutional/viterbi.h"
+#include "srsran/phy/fec/ldpc/ldpc_decoder.h"
+#include "srsran/phy/fec/ldpc/ldpc_encoder.h"
+#include "srsran/phy/fec/polar/polar_chanalloc.h"
+#include "srsran/phy/fec/polar/polar_code.h"
+#include "srsran/phy/fec/polar/polar_decoder.h"
+#include "srsran/phy/fec/polar/polar_encoder.h"
+#include "srsran/phy/fec/polar/polar_rm.h"
+#include "srsran/phy/fec/turbo/turbocoder.h"
+#include "srsran/phy/fec/turbo/turbodecoder.h"
+#include "srsran/phy/utils/bit.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+
+/* Every worker encodes this many different codewords and decodes them in a round robin, so that the decoder does not
+ * keep reading the very same input. It is also the batch size of the polar batch decoder. */
+#define BENCH_NOF_BUFFERS 8
+
+#define BENCH_MAX_THREADS 64
+
+typedef enum { FEC_TURBO = 0, FEC_LDPC, FEC_POLAR, FEC_VITERBI, FEC_NOF_FAMILIES } fec_family_t;
+
+static const char* family_names[FEC_NOF_FAMILIES] = {"turbo", "ldpc", "polar", "viterbi"};
+
+/* Width of the LLR the decoder takes */
+typedef enum { LLR_FLOAT = 0, LLR_16BIT, LLR_8BIT } bench_llr_t;
+
+typedef struct {
+  const char* name;
+  int         type; ///< Family specific decoder type, or the Viterbi init function index
+  bench_llr_t llr;
+  bool        batch;
+} bench_impl_t;
+
+typedef struct {
+  fec_family_t        family;
+  const bench_impl_t* impl;
+  uint32_t            K;    ///< Information bits per codeword
+  uint32_t            E;    ///< Coded bits at the decoder input
+  uint32_t            bg;   ///< LDPC base graph
+  uint32_t            ls;   ///< LDPC lifting size
+  uint32_t            nMax; ///< Polar maximum log2 of the code size
+} bench_point_t;
+
+typedef struct {
+  fec_family_t family;
+  const char*  impl;
+  uint32_t     K;
+  uint32_t     E;
+  uint32_t     nof_threads;
+  uint64_t     nof_bits;
+  uint64_t     nof_checked_bits; ///< The errors are counted on the last decoding of every buffer
+  uint64_t     nof_errors;
+  uint64_t     elapsed_ns;
+} bench_result_t;
+
+typedef struct {
+  const bench_point_t* point;
+  pthread_barrier_t*   barrier;
+  int                  ret;
+  uint64_t             nof_codewords;
+  uint64_t             elapsed_ns;
+
+  uint8_t* data_tx[BENCH_NOF_BUFFERS];
+  uint8_t* data_rx[BENCH_NOF_BUFFERS];
+  void*    llr[BENCH_NOF_BUFFERS];
+  uint32_t llr_len;
+
+  srsran_tdec_t          tdec;
+  srsran_ldpc_decoder_t  ldpc;
+  srsran_polar_code_t    code;
+  srsran_polar_decoder_t polar;
+  srsran_viterbi_t       viterbi;
+} bench_worker_t;
+
+/* Implementations of every family. The ones that are not compiled for this CPU are not listed. */
+static const bench_impl_t turbo_impl[] = {
+    {"generic", SRSRAN_TDEC_GENERIC, LLR_16BIT, false},
+#ifdef LV_HAVE_SSE
+    {"sse", SRSRAN_TDEC_SSE, LLR_16BIT, false},
+    {"sse-win", SRSRAN_TDEC_SSE_WINDOW, LLR_16BIT, false},
+    {"sse8-win", SRSRAN_TDEC_SSE8_WINDOW, LLR_8BIT, false},
+#endif // LV_HAVE_SSE
+#ifdef HAVE_NEON
+    {"neon-win", SRSRAN_TDEC_NEON_WINDOW, LLR_16BIT, false},
+#endif // HAVE_NEON
+#ifdef LV_HAVE_AVX2
+    {"avx2-win", SRSRAN_TDEC_AVX_WINDOW, LLR_16BIT, false},
+    {"avx2-8-win", SRSRAN_TDEC_AVX8_WINDOW, LLR_8BIT, false},
+#endif // LV_HAVE_AVX2
+#ifdef LV_HAVE_AVX512
+    {"avx512-win", SRSRAN_TDEC_AVX512_WINDOW, LLR_16BIT, false},
+    {"avx512-8-win", SRSRAN_TDEC_AVX512_8_WINDOW, LLR_8BIT, false},
+#endif // LV_HAVE_AVX512
+};
+
+static const bench_impl_t ldpc_impl[] = {
+    {"float", SRSRAN_LDPC_DECODER_F, LLR_FLOAT, false},
+    {"16bit", SRSRAN_LDPC_DECODER_S, LLR_16BIT, false},
+    {"8bit", SRSRAN_LDPC_DECODER_C, LLR_8BIT, false},
+    {"8bit-flood", SRSRAN_LDPC_DECODER_C_FLOOD, LLR_8BIT, false},
+#ifdef LV_HAVE_AVX2
+    {"avx2", SRSRAN_LDPC_DECODER_C_AVX2, LLR_8BIT, false},
+    {"avx2-flood", SRSRAN_LDPC_DECODER_C_AVX2_FLOOD, LLR_8BIT, false},
+#endif // LV_HAVE_AVX2
+#ifdef LV_HAVE_AVX512
+    {"avx512", SRSRAN_LDPC_DECODER_C_AVX512, LLR_8BIT, false},
+    {"avx512-flood", SRSRAN_LDPC_DECODER_C_AVX512_FLOOD, LLR_8BIT, false},
+#endif // LV_HAVE_AVX512
+};
+
+static const bench_impl_t polar_impl[] = {
+    {"float", SRSRAN_POLAR_DECODER_SSC_F, LLR_FLOAT, false},
+    {"16bit", SRSRAN_POLAR_DECODER_SSC_S, LLR_16BIT, false},
+    {"8bit", SRSRAN_POLAR_DECODER_SSC_C, LLR_8BIT, false},
+#ifdef LV_HAVE_AVX2
+    {"avx2", SRSRAN_POLAR_DECODER_SSC_C_AVX2, LLR_8BIT, false},
+    {"avx2-batch", SRSRAN_POLAR_DECODER_SSC_C_BATCH, LLR_8BIT, true},
+#endif // LV_HAVE_AVX2
+};
+
+/* The generic Viterbi decoder can not be selected explicitly, srsran_viterbi_init() picks the best one available. With
+ * AVX2 that is a 16 bit decoder. */
+typedef enum { VITERBI_AUTO = 0, VITERBI_SSE, VITERBI_NEON, VITERBI_AVX2, VITERBI_AVX512 } bench_viterbi_init_t;
+
+static const bench_impl_t viterbi_impl[] = {
+#ifdef LV_HAVE_AVX2
+    {"auto", VITERBI_AUTO, LLR_16BIT, false},
+#else  // LV_HAVE_AVX2
+    {"auto", VITERBI_AUTO, LLR_8BIT, false},
+#endif // LV_HAVE_AVX2
+#ifdef LV_HAVE_SSE
+    {"sse", VITERBI_SSE, LLR_8BIT, false},
+#endif // LV_HAVE_SSE
+#ifdef HAVE_NEON
+    {"neon", VITERBI_NEON, LLR_8BIT, false},
+#endif // HAVE_NEON
+#ifdef LV_HAVE_AVX2
+    {"avx2", VITERBI_AVX2, LLR_8BIT, false},
+#endif // LV_HAVE_AVX2
+#ifdef LV_HAVE_AVX512
+    {"avx512", VITERBI_AVX512, LLR_16BIT, false},
+#endif // LV_HAVE_AVX512
+};
+
+/* Block sizes and code rates of the default matrix. The turbo and the Viterbi decoders take the mother code (rate 1/3),
+ * rate matching is not part of their kernel. */
+static const uint32_t turbo_K[]   = {40, 1024, 6144};
+static const uint32_t viterbi_K[] = {40, 80, 512};
+
+static const struct {
+  uint32_t bg;
+  uint32_t ls;
+  float    rates[4];
+} ldpc_cfg[] = {
+    {BG1, 32, {1.0f / 3.0f, 1.0f / 2.0f, 2.0f / 3.0f, 8.0f / 9.0f}},
+    {BG1, 384, {1.0f / 3.0f, 1.0f / 2.0f, 2.0f / 3.0f, 8.0f / 9.0f}},
+    {BG2, 32, {1.0f / 5.0f, 1.0f / 3.0f, 1.0f / 2.0f, 2.0f / 3.0f}},
+    {BG2, 384, {1.0f / 5.0f, 1.0f / 3.0f, 1.0f / 2.0f, 2.0f / 3.0f}},
+};
+
+static const struct {
+  uint32_t nMax;
+  uint32_t K;
+  float    rates[3];
+} polar_cfg[] = {
+    {9, 56, {1.0f / 4.0f, 1.0f / 2.0f, 3.0f / 4.0f}},
+    {9, 128, {1.0f / 4.0f, 1.0f / 2.0f, 3.0f / 4.0f}},
+    {10, 256, {1.0f / 4.0f, 1.0f / 2.0f, 3.0f / 4.0f}},
+    {10, 512, {1.0f / 4.0f, 1.0f / 2.0f, 3.0f / 4.0f}},
+};
+
+static char*    family_filter   = NULL;
+static char*    impl_filter     = NULL;
+static int      block_size      = -1;
+static uint32_t nof_codewords   = 200;
+static uint32_t max_threads     = 4;
+static uint32_t nof_iterations  = 4;
+static float    snr_db          = 100.0f;
+static char*    output_file     = NULL;
+static float    ldpc_ms_factor  = 0.75f;
+static int      viterbi_poly[3] = {0x6D, 0x4F, 0x57};
+
+void usage(char* prog)
+{
+  printf("Usage: %s [fiknTtso]\n", prog);
+  printf("\t-f FEC family: turbo, ldpc, polar or viterbi [Default all]\n");
+  printf("\t-i decoder implementation name [Default all]\n");
+  printf("\t-k information bits per codeword [Default the whole matrix]\n");
+  printf("\t-n number of codewords decoded by every thread [Default %d]\n", nof_codewords);
+  printf("\t-T maximum number of threads, doubled from 1 [Default %d]\n", max_threads);
+  printf("\t-t turbo decoder iterations [Default %d]\n", nof_iterations);
+  printf("\t-s Es/N0 in dB, 100 or more disables the noise [Default %.0f]\n", snr_db);
+  printf("\t-o JSON output file [Default stdout]\n");
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "fiknTtsov")) != -1) {
+    switch (opt) {
+      case 'f':
+        family_filter = argv[optind];
+        break;
+      case 'i':
+        impl_filter = argv[optind];
+        break;
+      case 'k':
+        block_size = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_codewords = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'T':
+        max_threads = SRSRAN_MIN((uint32_t)strtol(argv[optind], NULL, 10), BENCH_MAX_THREADS);
+        break;
+      case 't':
+        nof_iterations = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        snr_db = strtof(argv[optind], NULL);
+        break;
+      case 'o':
+        output_file = argv[optind];
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static uint64_t bench_time_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000UL + (uint64_t)ts.tv_nsec;
+}
+
+static bool bench_noise(void)
+{
+  return snr_db < 100.0f;
+}
+
+/* Maps the coded bits onto BPSK symbols of amplitude one and returns the LLRs 2y/N0. Without noise N0 is taken as
+ * one. The sign of a one bit depends on the decoder convention. */
+static void bench_llr_f(const uint8_t* bits, float* llr, uint32_t len, float one)
+{
+  float n0 = bench_noise() ? srsran_convert_dB_to_power(-snr_db) : 1.0f;
+
+  for (uint32_t i = 0; i < len; i++) {
+    llr[i] = bits[i] ? one : -one;
+  }
+  if (bench_noise()) {
+    srsran_ch_awgn_f(llr, llr, n0, len);
+  }
+  srsran_vec_sc_prod_fff(llr, 2.0f / n0, llr, len);
+}
+
+static void* bench_llr_malloc(bench_llr_t type, uint32_t len)
+{
+  switch (type) {
+    case LLR_16BIT:
+      return srsran_vec_i16_malloc(len);
+    case LLR_8BIT:
+      return srsran_vec_i8_malloc(len);
+    case LLR_FLOAT:
+    default:
+      return srsran_vec_f_malloc(len);
+  }
+}
+
+/******************************************************************************
+ * Turbo
+ *****************************************************************************/
+
+static int turbo_init(bench_worker_t* w)
+{
+  const bench_point_t* p      = w->point;
+  srsran_tcod_t        tcod   = {};
+  uint8_t*             coded  = srsran_vec_u8_malloc(p->E);
+  float*               llr_f  = srsran_vec_f_malloc(p->E);
+  int                  ret    = SRSRAN_ERROR;
+  int                  nof_sb = 0;
+
+  if (coded == NULL || llr_f == NULL) {
+    goto clean_exit;
+  }
+  if (srsran_tcod_init(&tcod, p->K)) {
+    ERROR("Error initiating Turbo coder");
+    goto clean_exit;
+  }
+  if (srsran_tdec_init_manual(&w->tdec, p->K, p->impl->type)) {
+    ERROR("Error initiating Turbo decoder");
+    goto clean_exit;
+  }
+
+  // Sub-block decoders need at least the window overlap length per sub-block
+  nof_sb = p->impl->llr == LLR_8BIT ? w->tdec.nof_blocks8[0] : w->tdec.nof_blocks16[0];
+  if (nof_sb > 1 && ((p->K % nof_sb) || (p->K / nof_sb) < 40)) {
+    ret = SRSRAN_SUCCESS + 1;
+    goto clean_exit;
+  }
+  srsran_tdec_force_not_sb(&w->tdec);
+
+  for (uint32_t b = 0; b < BENCH_NOF_BUFFERS; b++) {
+    srsran_tcod_encode(&tcod, w->data_tx[b], coded, p->K);
+    bench_llr_f(coded, llr_f, p->E, 1.0f);
+    for (uint32_t j = 0; j < p->E; j++) {
+      if (p->impl->llr == LLR_8BIT) {
+        ((int8_t*)w->llr[b])[j] = (int8_t)SRSRAN_MAX(-127, SRSRAN_MIN(127, 5 * llr_f[j]));
+      } else {
+        ((int16_t*)w->llr[b])[j] = (int16_t)(50 * llr_f[j]);
+      }
+    }
+  }
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_tcod_free(&tcod);
+  free(coded);
+  free(llr_f);
+  return ret;
+}
+
+static uint32_t turbo_decode(bench_worker_t* w, uint32_t b)
+{
+  if (w->point->impl->llr == LLR_8BIT) {
+    srsran_tdec_run_all_8bit(&w->tdec, w->llr[b], w->data_rx[b], nof_iterations, w->point->K);
+  } else {
+    srsran_tdec_run_all(&w->tdec, w->llr[b], w->data_rx[b], nof_iterations, w->point->K);
+  }
+  return 1;
+}
+
+static uint32_t turbo_errors(bench_worker_t* w, uint32_t b, uint8_t* tmp)
+{
+  srsran_bit_unpack_vector(w->data_rx[b], tmp, w->point->K);
+  return srsran_bit_diff(w->data_tx[b], tmp, w->point->K);
+}
+
+static void turbo_free(bench_worker_t* w)
+{
+  srsran_tdec_free(&w->tdec);
+}
+
+/******************************************************************************
+ * LDPC
+ *****************************************************************************/
+
+static int ldpc_init(bench_worker_t* w)
+{
+  const bench_point_t*       p       = w->point;
+  srsran_ldpc_encoder_t      encoder = {};
+  srsran_ldpc_decoder_args_t args    = {};
+  uint8_t*                   coded   = srsran_vec_u8_malloc(w->llr_len);
+  float*                     llr_f   = srsran_vec_f_malloc(w->llr_len);
+  int                        ret     = SRSRAN_ERROR;
+
+  if (coded == NULL || llr_f == NULL) {
+    goto clean_exit;
+  }
+  if (srsran_ldpc_encoder_init(&encoder, SRSRAN_LDPC_ENCODER_C, p->bg, p->ls)) {
+    ERROR("Error initiating LDPC encoder");
+    goto clean_exit;
+  }
+
+  args.type         = p->impl->type;
+  args.bg           = p->bg;
+  args.ls           = p->ls;
+  args.scaling_fctr = ldpc_ms_factor;
+  if (srsran_ldpc_decoder_init(&w->ldpc, &args)) {
+    ERROR("Error initiating LDPC decoder");
+    goto clean_exit;
+  }
+
+  // Same quantization as ldpc_chain_test
+  float  std_dev = bench_noise() ? sqrtf(srsran_convert_dB_to_power(-snr_db)) : 1.0f;
+  int8_t inf7    = (1U << 6U) - 1;
+  float  gain_c  = inf7 * std_dev / 8 / (1 / std_dev + 2);
+  float  gain_s  = ((1U << 14U) - 1) * std_dev / 20 / (1 / std_dev + 2);
+
+  for (uint32_t b = 0; b < BENCH_NOF_BUFFERS; b++) {
+    srsran_ldpc_encoder_encode_rm(&encoder, w->data_tx[b], coded, p->K, p->E);
+    bench_llr_f(coded, llr_f, p->E, -1.0f);
+    srsran_vec_f_zero(llr_f + p->E, w->llr_len - p->E);
+    switch (p->impl->llr) {
+      case LLR_FLOAT:
+        srsran_vec_f_copy(w->llr[b], llr_f, w->llr_len);
+        break;
+      case LLR_16BIT:
+        srsran_vec_quant_fs(llr_f, w->llr[b], gain_s, 0, (1U << 14U) - 1, w->llr_len);
+        break;
+      case LLR_8BIT:
+        srsran_vec_quant_fc(llr_f, w->llr[b], gain_c, 0, inf7, w->llr_len);
+        break;
+    }
+  }
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_ldpc_encoder_free(&encoder);
+  free(coded);
+  free(llr_f);
+  return ret;
+}
+
+static uint32_t ldpc_decode(bench_worker_t* w, uint32_t b)
+{
+  switch (w->point->impl->llr) {
+    case LLR_FLOAT:
+      srsran_ldpc_decoder_decode_f(&w->ldpc, w->llr[b], w->data_rx[b], w->point->E);
+      break;
+    case LLR_16BIT:
+      srsran_ldpc_decoder_decode_s(&w->ldpc, w->llr[b], w->data_rx[b], w->point->E);
+      break;
+    case LLR_8BIT:
+      srsran_ldpc_decoder_decode_c(&w->ldpc, w->llr[b], w->data_rx[b], w->point->E);
+      break;
+  }
+  return 1;
+}
+
+static uint32_t ldpc_errors(bench_worker_t* w, uint32_t b, uint8_t* tmp)
+{
+  return srsran_bit_diff(w->data_tx[b], w->data_rx[b], w->point->K);
+}
+
+static void ldpc_free(bench_worker_t* w)
+{
+  srsran_ldpc_decoder_free(&w->ldpc);
+}
+
+/******************************************************************************
+ * Polar
+ *****************************************************************************/
+
+static int polar_init(bench_worker_t* w)
+{
+  const bench_point_t*   p     = w->point;
+  srsran_polar_encoder_t enc   = {};
+  srsran_polar_rm_t      rm_tx = {};
+  srsran_polar_rm_t      rm_rx = {};
+  int                    rm_ret = SRSRAN_ERROR;
+  uint8_t                bil   = p->nMax == 10 ? 1 : 0;
+  uint32_t               N     = 1U << p->nMax;
+  uint8_t*               input = srsran_vec_u8_malloc(N);
+  uint8_t*               coded = srsran_vec_u8_malloc(N);
+  uint8_t*               rm_cw = srsran_vec_u8_malloc(p->E);
+  float*                 llr_f = srsran_vec_f_malloc(p->E);
+  void*                  llr_e = bench_llr_malloc(p->impl->llr, p->E);
+  int                    ret   = SRSRAN_ERROR;
+
+  if (input == NULL || coded == NULL || rm_cw == NULL || llr_f == NULL || llr_e == NULL) {
+    goto clean_exit;
+  }
+  if (srsran_polar_code_init(&w->code) || srsran_polar_code_get(&w->code, p->K, p->E, p->nMax)) {
+    ERROR("Error getting the polar code K=%d E=%d nMax=%d", p->K, p->E, p->nMax);
+    goto clean_exit;
+  }
+  if (srsran_polar_encoder_init(&enc, SRSRAN_POLAR_ENCODER_PIPELINED, p->nMax) || srsran_polar_rm_tx_init(&rm_tx)) {
+    ERROR("Error initiating polar encoder");
+    goto clean_exit;
+  }
+  if (srsran_polar_decoder_init(&w->polar, p->impl->type, p->nMax)) {
+    ERROR("Error initiating polar decoder");
+    goto clean_exit;
+  }
+  switch (p->impl->llr) {
+    case LLR_FLOAT:
+      rm_ret = srsran_polar_rm_rx_init_f(&rm_rx);
+      break;
+    case LLR_16BIT:
+      rm_ret = srsran_polar_rm_rx_init_s(&rm_rx);
+      break;
+    case LLR_8BIT:
+      rm_ret = srsran_polar_rm_rx_init_c(&rm_rx);
+      break;
+  }
+  if (rm_ret) {
+    ERROR("Error initiating polar rate dematcher");
+    goto clean_exit;
+  }
+
+  const srsran_polar_code_t* c = &w->code;
+  for (uint32_t b = 0; b < BENCH_NOF_BUFFERS; b++) {
+    srsran_polar_chanalloc_tx(w->data_tx[b], input, c->N, c->K, c->nPC, c->K_set, c->PC_set);
+    srsran_polar_encoder_encode(&enc, input, coded, c->n);
+    srsran_polar_rm_tx(&rm_tx, coded, rm_cw, c->n, p->E, p->K, bil);
+    bench_llr_f(rm_cw, llr_f, p->E, -1.0f);
+
+    // Same fixed gains as the noiseless polar_chain_test, the LLRs are two without noise
+    switch (p->impl->llr) {
+      case LLR_FLOAT:
+        srsran_polar_rm_rx_f(&rm_rx, llr_f, w->llr[b], p->E, c->n, p->K, bil);
+        break;
+      case LLR_16BIT:
+        srsran_vec_quant_fs(llr_f, llr_e, 4096, 0, 32767, p->E);
+        srsran_polar_rm_rx_s(&rm_rx, llr_e, w->llr[b], p->E, c->n, p->K, bil);
+        break;
+      case LLR_8BIT:
+        srsran_vec_quant_fc(llr_f, llr_e, 16, 0, 127, p->E);
+        srsran_polar_rm_rx_c(&rm_rx, llr_e, w->llr[b], p->E, c->n, p->K, bil);
+        break;
+    }
+  }
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_polar_encoder_free(&enc);
+  srsran_polar_rm_tx_free(&rm_tx);
+  if (rm_ret == SRSRAN_SUCCESS) {
+    switch (p->impl->llr) {
+      case LLR_FLOAT:
+        srsran_polar_rm_rx_free_f(&rm_rx);
+        break;
+      case LLR_16BIT:
+        srsran_polar_rm_rx_free_s(&rm_rx);
+        break;
+      case LLR_8BIT:
+        srsran_polar_rm_rx_free_c(&rm_rx);
+        break;
+    }
+  }
+  free(input);
+  free(coded);
+  free(rm_cw);
+  free(llr_f);
+  free(llr_e);
+  return ret;
+}
+
+static uint32_t polar_decode(bench_worker_t* w, uint32_t b)
+{
+  const srsran_polar_code_t* c = &w->code;
+
+  if (w->point->impl->batch) {
+    srsran_polar_decoder_decode_c_batch(
+        &w->polar, (const int8_t**)w->llr, w->data_rx, BENCH_NOF_BUFFERS, c->n, c->F_set, c->F_set_size);
+    return BENCH_NOF_BUFFERS;
+  }
+
+  switch (w->point->impl->llr) {
+    case LLR_FLOAT:
+      srsran_polar_decoder_decode_f(&w->polar, w->llr[b], w->data_rx[b], c->n, c->F_set, c->F_set_size);
+      break;
+    case LLR_16BIT:
+      srsran_polar_decoder_decode_s(&w->polar, w->llr[b], w->data_rx[b], c->n, c->F_set, c->F_set_size);
+      break;
+    case LLR_8BIT:
+      srsran_polar_decoder_decode_c(&w->polar, w->llr[b], w->data_rx[b], c->n, c->F_set, c->F_set_size);
+      break;
+  }
+  return 1;
+}
+
+static uint32_t polar_errors(bench_worker_t* w, uint32_t b, uint8_t* tmp)
+{
+  const srsran_polar_code_t* c = &w->code;
+
+  srsran_polar_chanalloc_rx(w->data_rx[b], tmp, c->K, c->nPC, c->K_set, c->PC_set);
+  return srsran_bit_diff(w->data_tx[b], tmp, w->point->K);
+}
+
+static void polar_free(bench_worker_t* w)
+{
+  srsran_polar_decoder_free(&w->polar);
+  srsran_polar_code_free(&w->code);
+}
+
+/******************************************************************************
+ * Viterbi
+ *****************************************************************************/
+
+static int viterbi_init(bench_worker_t* w)
+{
+  const bench_point_t* p     = w->point;
+  srsran_convcoder_t   cod   = {};
+  uint8_t*             coded = srsran_vec_u8_malloc(p->E);
+  float*               llr_f = srsran_vec_f_malloc(p->E);
+  int                  ret   = SRSRAN_ERROR;
+
+  if (coded == NULL || llr_f == NULL) {
+    goto clean_exit;
+  }
+
+  cod.R           = 3;
+  cod.K           = 7;
+  cod.tail_biting = true;
+  memcpy(cod.poly, viterbi_poly, sizeof(cod.poly));
+
+  switch (p->impl->type) {
+    case VITERBI_AUTO:
+      ret = srsran_viterbi_init(&w->viterbi, SRSRAN_VITERBI_37, viterbi_poly, p->K, true);
+      break;
+#ifdef LV_HAVE_SSE
+    case VITERBI_SSE:
+      ret = srsran_viterbi_init_sse(&w->viterbi, SRSRAN_VITERBI_37, viterbi_poly, p->K, true);
+      break;
+#endif // LV_HAVE_SSE
+#ifdef HAVE_NEON
+    case VITERBI_NEON:
+      ret = srsran_viterbi_init_neon(&w->viterbi, SRSRAN_VITERBI_37, viterbi_poly, p->K, true);
+      break;
+#endif // HAVE_NEON
+#ifdef LV_HAVE_AVX2
+    case VITERBI_AVX2:
+      ret = srsran_viterbi_init_avx2(&w->viterbi, SRSRAN_VITERBI_37, viterbi_poly, p->K, true);
+      break;
+#endif // LV_HAVE_AVX2
+#ifdef LV_HAVE_AVX512
+    case VITERBI_AVX512:
+      ret = srsran_viterbi_init_avx512(&w->viterbi, SRSRAN_VITERBI_37, viterbi_poly, p->K, true);
+      break;
+#endif // LV_HAVE_AVX512
+    default:
+      break;
+  }
+  if (ret) {
+    ERROR("Error initiating Viterbi decoder");
+    ret = SRSRAN_ERROR;
+    goto clean_exit;
+  }
+
+  // Same quantization as viterbi_test, the decoders take unsigned LLRs of their own width
+  for (uint32_t b = 0; b < BENCH_NOF_BUFFERS; b++) {
+    srsran_convcoder_encode(&cod, w->data_tx[b], coded, p->K);
+    bench_llr_f(coded, llr_f, p->E, 1.0f);
+    if (p->impl->llr == LLR_16BIT) {
+      srsran_vec_quant_fus(llr_f, w->llr[b], 8192, INT16_MAX, UINT16_MAX, p->E);
+    } else {
+      srsran_vec_quant_fuc(llr_f, w->llr[b], 32, INT8_MAX, UINT8_MAX, p->E);
+    }
+  }
+
+clean_exit:
+  free(coded);
+  free(llr_f);
+  return ret;
+}
+
+static uint32_t viterbi_decode(bench_worker_t* w, uint32_t b)
+{
+  if (w->point->impl->llr == LLR_16BIT) {
+    srsran_viterbi_decode_us(&w->viterbi, w->llr[b], w->data_rx[b], w->point->K);
+  } else {
+    srsran_viterbi_decode_uc(&w->viterbi, w->llr[b], w->data_rx[b], w->point->K);
+  }
+  return 1;
+}
+
+static uint32_t viterbi_errors(bench_worker_t* w, uint32_t b, uint8_t* tmp)
+{
+  return srsran_bit_diff(w->data_tx[b], w->data_rx[b], w->point->K);
+}
+
+static void viterbi_free(bench_worker_t* w)
+{
+  srsran_viterbi_free(&w->viterbi);
+}
+
+/******************************************************************************
+ * Common
+ *****************************************************************************/
+
+/* Every family encodes its own codewords in init(), and returns a positive value when the point does not apply to the
+ * implementation. decode() returns the number of codewords it decoded. */
+static const struct {
+  int (*init)(bench_worker_t* w);
+  uint32_t (*decode)(bench_worker_t* w, uint32_t b);
+  uint32_t (*errors)(bench_worker_t* w, uint32_t b, uint8_t* tmp);
+  void (*free)(bench_worker_t* w);
+} family_ops[FEC_NOF_FAMILIES] = {
+    {turbo_init, turbo_decode, turbo_errors, turbo_free},
+    {ldpc_init, ldpc_decode, ldpc_errors, ldpc_free},
+    {polar_init, polar_decode, polar_errors, polar_free},
+    {viterbi_init, viterbi_decode, viterbi_errors, viterbi_free},
+};
+
+/* Length of the decoder input buffer and of the decoded output buffer */
+static void bench_buffer_len(const bench_point_t* p, uint32_t* llr_len, uint32_t* rx_len)
+{
+  switch (p->family) {
+    case FEC_LDPC:
+      // The decoder reads the whole codeword, without the 2 punctured systematic columns
+      *llr_len = (p->bg == BG1 ? 66 : 50) * p->ls;
+      *rx_len  = p->K;
+      break;
+    case FEC_POLAR:
+      *llr_len = 1U << p->nMax;
+      *rx_len  = 1U << p->nMax;
+      break;
+    default:
+      *llr_len = p->E;
+      *rx_len  = p->K;
+      break;
+  }
+}
+
+/* Allocates the buffers, encodes the codewords and initializes the decoder. It runs in the main thread because the
+ * encoders share global tables. */
+static int bench_worker_init(bench_worker_t* w, srsran_random_t random)
+{
+  const bench_point_t* p      = w->point;
+  uint32_t             rx_len = 0;
+
+  w->ret = SRSRAN_ERROR;
+  bench_buffer_len(p, &w->llr_len, &rx_len);
+
+  for (uint32_t b = 0; b < BENCH_NOF_BUFFERS; b++) {
+    w->data_tx[b] = srsran_vec_u8_malloc(p->K);
+    w->data_rx[b] = srsran_vec_u8_malloc(rx_len);
+    w->llr[b]     = bench_llr_malloc(p->impl->llr, w->llr_len);
+    if (w->data_tx[b] == NULL || w->data_rx[b] == NULL || w->llr[b] == NULL) {
+      ERROR("Error allocating buffers");
+      return SRSRAN_ERROR;
+    }
+    for (uint32_t j = 0; j < p->K; j++) {
+      w->data_tx[b][j] = (uint8_t)srsran_random_uniform_int_dist(random, 0, 1);
+    }
+  }
+
+  w->ret = family_ops[p->family].init(w);
+  return w->ret;
+}
+
+static void bench_worker_free(bench_worker_t* w)
+{
+  if (w->ret != SRSRAN_ERROR) {
+    family_ops[w->point->family].free(w);
+  }
+  for (uint32_t b = 0; b < BENCH_NOF_BUFFERS; b++) {
+    free(w->data_tx[b]);
+    free(w->data_rx[b]);
+    free(w->llr[b]);
+  }
+}
+
+static void* bench_worker(void* arg)
+{
+  bench_worker_t*      w = (bench_worker_t*)arg;
+  const bench_point_t* p = w->point;
+
+  // Start all the threads at the same time
+  pthread_barrier_wait(w->barrier);
+
+  uint64_t t0 = bench_time_ns();
+  while (w->nof_codewords < nof_codewords) {
+    w->nof_codewords += family_ops[p->family].decode(w, (uint32_t)(w->nof_codewords % BENCH_NOF_BUFFERS));
+  }
+  w->elapsed_ns = bench_time_ns() - t0;
+
+  return NULL;
+}
+
+/* Runs the point in nof_threads threads at the same time, every one with its own decoder. Returns a positive value if
+ * the point was skipped. */
+static int bench_run(srsran_random_t random, const bench_point_t* p, uint32_t nof_threads, bench_result_t* res)
+{
+  bench_worker_t*   workers = calloc(nof_threads, sizeof(bench_worker_t));
+  uint8_t*          tmp     = srsran_vec_u8_malloc(p->K);
+  pthread_t         threads[BENCH_MAX_THREADS];
+  pthread_barrier_t barrier;
+  int               ret = SRSRAN_SUCCESS;
+
+  if (workers == NULL || tmp == NULL) {
+    ERROR("Error allocating workers");
+    free(workers);
+    free(tmp);
+    return SRSRAN_ERROR;
+  }
+  pthread_barrier_init(&barrier, NULL, nof_threads);
+
+  for (uint32_t i = 0; i < nof_threads && ret == SRSRAN_SUCCESS; i++) {
+    workers[i].point   = p;
+    workers[i].barrier = &barrier;
+    ret                = bench_worker_init(&workers[i], random);
+  }
+
+  if (ret == SRSRAN_SUCCESS) {
+    for (uint32_t i = 0; i < nof_threads; i++) {
+      if (pthread_create(&threads[i], NULL, bench_worker, &workers[i])) {
+        ERROR("Error creating thread");
+        exit(-1);
+      }
+    }
+    for (uint32_t i = 0; i < nof_threads; i++) {
+      pthread_join(threads[i], NULL);
+    }
+  }
+
+  memset(res, 0, sizeof(bench_result_t));
+  res->family      = p->family;
+  res->impl        = p->impl->name;
+  res->K           = p->K;
+  res->E           = p->E;
+  res->nof_threads = nof_threads;
+
+  // The aggregated throughput is given by the slowest thread
+  for (uint32_t i = 0; i < nof_threads; i++) {
+    for (uint32_t b = 0; ret == SRSRAN_SUCCESS && b < SRSRAN_MIN(BENCH_NOF_BUFFERS, workers[i].nof_codewords); b++) {
+      res->nof_errors += family_ops[p->family].errors(&workers[i], b, tmp);
+      res->nof_checked_bits += p->K;
+    }
+    res->nof_bits += workers[i].nof_codewords * p->K;
+    res->elapsed_ns = SRSRAN_MAX(res->elapsed_ns, workers[i].elapsed_ns);
+    if (workers[i].point) {
+      bench_worker_free(&workers[i]);
+    }
+  }
+
+  pthread_barrier_destroy(&barrier);
+  free(workers);
+  free(tmp);
+  return ret;
+}
+
+static bool bench_match(const char* filter, const char* name)
+{
+  return filter == NULL || strcmp(filter, name) == 0;
+}
+
+/* Fills the points of a family and returns how many there are */
+static uint32_t bench_points(fec_family_t family, bench_point_t* points)
+{
+  const bench_impl_t* impl      = NULL;
+  uint32_t            nof_impl  = 0;
+  uint32_t            n         = 0;
+  bench_point_t       templ[64] = {};
+  uint32_t            nof_templ = 0;
+
+  switch (family) {
+    case FEC_TURBO:
+      impl     = turbo_impl;
+      nof_impl = sizeof(turbo_impl) / sizeof(bench_impl_t);
+      for (uint32_t i = 0; i < sizeof(turbo_K) / sizeof(uint32_t); i++) {
+        templ[nof_templ].K   = turbo_K[i];
+        templ[nof_templ++].E = 3 * turbo_K[i] + SRSRAN_TCOD_TOTALTAIL;
+      }
+      break;
+    case FEC_LDPC:
+      impl     = ldpc_impl;
+      nof_impl = sizeof(ldpc_impl) / sizeof(bench_impl_t);
+      for (uint32_t i = 0; i < sizeof(ldpc_cfg) / sizeof(ldpc_cfg[0]); i++) {
+        for (uint32_t r = 0; r < sizeof(ldpc_cfg[i].rates) / sizeof(float); r++) {
+          uint32_t K = (ldpc_cfg[i].bg == BG1 ? 22 : 10) * ldpc_cfg[i].ls;
+          uint32_t E = (uint32_t)ceilf(K / ldpc_cfg[i].rates[r]);
+
+          // The decoder takes whole lifting size blocks
+          templ[nof_templ].bg  = ldpc_cfg[i].bg;
+          templ[nof_templ].ls  = ldpc_cfg[i].ls;
+          templ[nof_templ].K   = K;
+          templ[nof_templ++].E = SRSRAN_CEIL(E, ldpc_cfg[i].ls) * ldpc_cfg[i].ls;
+        }
+      }
+      break;
+    case FEC_POLAR:
+      impl     = polar_impl;
+      nof_impl = sizeof(polar_impl) / sizeof(bench_impl_t);
+      for (uint32_t i = 0; i < sizeof(polar_cfg) / sizeof(polar_cfg[0]); i++) {
+        for (uint32_t r = 0; r < sizeof(polar_cfg[i].rates) / sizeof(float); r++) {
+          templ[nof_templ].nMax = polar_cfg[i].nMax;
+          templ[nof_templ].K    = polar_cfg[i].K;
+          templ[nof_templ++].E  = (uint32_t)ceilf(polar_cfg[i].K / polar_cfg[i].rates[r]);
+        }
+      }
+      break;
+    case FEC_VITERBI:
+      impl     = viterbi_impl;
+      nof_impl = sizeof(viterbi_impl) / sizeof(bench_impl_t);
+      for (uint32_t i = 0; i < sizeof(viterbi_K) / sizeof(uint32_t); i++) {
+        templ[nof_templ].K   = viterbi_K[i];
+        templ[nof_templ++].E = 3 * viterbi_K[i];
+      }
+      break;
+    default:
+      return 0;
+  }
+
+  for (uint32_t t = 0; t < nof_templ; t++) {
+    if (block_size > 0 && templ[t].K != (uint32_t)block_size) {
+      continue;
+    }
+    for (uint32_t i = 0; i < nof_impl; i++) {
+      if (!bench_match(impl_filter, impl[i].name)) {
+        continue;
+      }
+      if (points) {
+        points[n]        = templ[t];
+        points[n].family = family;
+        points[n].impl   = &impl[i];
+      }
+      n++;
+    }
+  }
+  return n;
+}
+
+/* Mbps and ns per bit are given for all threads together */
+static void print_result(FILE* f, const bench_result_t* res, bool last)
+{
+  fprintf(f,
+          "    {\"family\": \"%s\", \"impl\": \"%s\", \"K\": %d, \"E\": %d, \"rate\": %.4f, \"nof_threads\": %d, ",
+          family_names[res->family],
+          res->impl,
+          res->K,
+          res->E,
+          (double)res->K / res->E,
+          res->nof_threads);
+  fprintf(f,
+          "\"nof_bits\": %" PRIu64 ", \"ber\": %.3e, \"mbps\": %.2f, \"ns_per_bit\": %.3f}%s\n",
+          res->nof_bits,
+          res->nof_checked_bits ? (double)res->nof_errors / res->nof_checked_bits : 0.0,
+          res->elapsed_ns ? (double)res->nof_bits * 1000.0 / res->elapsed_ns : 0.0,
+          res->nof_bits ? (double)res->elapsed_ns / res->nof_bits : 0.0,
+          last ? "" : ",");
+}
+
+int main(int argc, char** argv)
+{
+  int             ret         = SRSRAN_ERROR;
+  srsran_random_t random      = srsran_random_init(0);
+  FILE*           f           = stdout;
+  bench_point_t*  points      = NULL;
+  bench_result_t* results     = NULL;
+  uint32_t        nof_points  = 0;
+  uint32_t        nof_results = 0;
+  uint32_t        nof_counts  = 0;
+
+  parse_args(argc, argv);
+
+  for (fec_family_t fam = 0; fam < FEC_NOF_FAMILIES; fam++) {
+    if (bench_match(family_filter, family_names[fam])) {
+      nof_points += bench_points(fam, NULL);
+    }
+  }
+  for (uint32_t t = 1; t <= max_threads; t *= 2) {
+    nof_counts++;
+  }
+
+  points  = calloc(SRSRAN_MAX(nof_points, 1), sizeof(bench_point_t));
+  results = calloc(SRSRAN_MAX(nof_points * nof_counts, 1), sizeof(bench_result_t));
+  if (points == NULL || results == NULL) {
+    ERROR("Error allocating results");
+    goto quit;
+  }
+
+  nof_points = 0;
+  for (fec_family_t fam = 0; fam < FEC_NOF_FAMILIES; fam++) {
+    if (bench_match(family_filter, family_names[fam])) {
+      nof_points += bench_points(fam, points + nof_points);
+    }
+  }
+
+  for (uint32_t i = 0; i < nof_points; i++) {
+    for (uint32_t t = 1; t <= max_threads; t *= 2) {
+      int r = bench_run(random, &points[i], t, &results[nof_results]);
+      if (r < SRSRAN_SUCCESS) {
+        ERROR("Error running %s %s K=%d E=%d",
+              family_names[points[i].family],
+              points[i].impl->name,
+              points[i].K,
+              points[i].E);
+        goto quit;
+      }
+      if (r == SRSRAN_SUCCESS) {
+        nof_results++;
+      }
+    }
+  }
+
+  if (output_file) {
+    f = fopen(output_file, "w");
+    if (f == NULL) {
+      ERROR("Error opening %s", output_file);
+      goto quit;
+    }
+  }
+
+  fprintf(f, "{\n  \"nof_codewords\": %d,\n  \"snr_db\": ", nof_codewords);
+  if (bench_noise()) {
+    fprintf(f, "%.2f,\n", snr_db);
+  } else {
+    fprintf(f, "null,\n");
+  }
+  fprintf(f, "  \"turbo_iterations\": %d,\n  \"results\": [\n", nof_iterations);
+  for (uint32_t i = 0; i < nof_results; i++) {
+    print_result(f, &results[i], i + 1 == nof_results);
+  }
+  fprintf(f, "  ]\n}\n");
+
+  if (f != stdout) {
+    fclose(f);
+  }
+
+  // Without noise every decoder must recover the data, otherwise the measurement is meaningless
+  ret = SRSRAN_SUCCESS;
+  for (uint32_t i = 0; i < nof_results && !bench_noise(); i++) {
+    if (results[i].nof_errors) {
+      ERROR("%s %s K=%d E=%d threads=%d decoded %" PRIu64 " wrong bits",
+            family_names[results[i].family],
+            results[i].impl,
+            results[i].K,
+            results[i].E,
+            results[i].nof_threads,
+            results[i].nof_errors);
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+quit:
+  free(points);
+  free(results);
+  srsran_random_free(random);
+  return ret;
+}
@@ -20,6 +20,7 @@
  */
 
 #include <math.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -64,6 +65,23 @@ int srsran_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
                                     uint32_t  rv_idx);
 #endif
 
+#ifdef LV_HAVE_AVX2
+static int rm_turbo_rx_gather_avx2(const int16_t*  input,
+                                   int16_t*        output,
+                                   const uint16_t* inter,
+                                   uint32_t        shift,
+                                   uint32_t        in_len,
+                                   uint32_t        out_len,
+                                   uint32_t        gather_len);
+static int rm_turbo_rx_gather_avx2_8bit(const int8_t*   input,
+                                        int8_t*         output,
+                                        const uint16_t* inter,
+                                        uint32_t        shift,
+                                        uint32_t        in_len,
+                                        uint32_t        out_len,
+                                        uint32_t        gather_len);
+#endif
+
 #define NCOLS 32
 #define NROWS_MAX NCOLS
 
@@ -80,11 +98,19 @@ static uint16_t                 deinterleaver[192][4][18448];
 static int                      k0_vec[SRSRAN_NOF_TC_CB_SIZES][4][2];
 static bool                     rm_turbo_tables_generated = false;
 
+// The tables are shared by all the instances, which can be initialised from several threads
+static pthread_mutex_t rm_turbo_tables_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 // Store deinterleaver version for sub-block turbo decoder
 #if SRSRAN_TDEC_EXPECT_INPUT_SB == 1
 // Prepare bit for sub-block decoder processing. These are the nof subblock sizes
+#ifdef LV_HAVE_AVX512
+#define NOF_DEINTER_TABLE_SB_IDX 4
+const static int deinter_table_sb_idx[NOF_DEINTER_TABLE_SB_IDX] = {8, 16, 32, 64};
+#else
 #define NOF_DEINTER_TABLE_SB_IDX 3
 const static int deinter_table_sb_idx[NOF_DEINTER_TABLE_SB_IDX] = {8, 16, 32};
+#endif
 int              deinter_table_idx_from_sb_len(uint32_t nof_subblocks)
 {
   for (int i = 0; i < NOF_DEINTER_TABLE_SB_IDX; i++) {
@@ -100,6 +126,22 @@ int              deinter_table_idx_from_sb_len(uint32_t nof_subblocks)
 static uint16_t deinterleaver_sb[NOF_DEINTER_TABLE_SB_IDX][192][4][18448];
 #endif
 
+#ifdef LV_HAVE_AVX2
+/* Soft combining by gathering. The deinterleaver of every redundancy version is a rotation of the rv_idx=0 one, so the
+ * received soft bits are first folded into a circular buffer in rv_idx=0 order and then each decoder input position
+ * gathers its soft bit from it. interleaver_rx is the inverse of the rv_idx=0 deinterleaver: it maps the decoder
+ * input positions to the circular buffer positions, or to out_len (always zero) for the sub-block alignment gaps. */
+#define RM_TURBO_GATHER_MAX_LEN (3 * (SRSRAN_TCOD_MAX_LEN_CB + 32) + 12)
+static uint16_t interleaver_rx[192][RM_TURBO_GATHER_MAX_LEN];
+static uint16_t interleaver_rx_shift[192][4];
+#if SRSRAN_TDEC_EXPECT_INPUT_SB == 1
+static uint16_t interleaver_rx_sb[NOF_DEINTER_TABLE_SB_IDX][192][RM_TURBO_GATHER_MAX_LEN];
+#endif
+
+/* Below about half the circular buffer the scatter implementations are faster, they touch fewer positions */
+#define RM_TURBO_GATHER_MIN_LEN(out_len) ((out_len) / 2)
+#endif
+
 static uint16_t temp_table1[3 * 6176], temp_table2[3 * 6176];
 
 static void srsran_rm_turbo_gentable_systematic(uint16_t* table_bits, int k0_vec_[4][2], uint32_t nrows, int ndummy)
@@ -246,6 +288,28 @@ static void srsran_rm_turbo_gentable_receive(uint16_t* table, uint32_t cb_len, u
     table[i] = temp_table2[temp_table1[i]];
   }
 }
+#ifdef LV_HAVE_AVX2
+static void srsran_rm_turbo_gentable_gather(const uint16_t* deinter, uint16_t* table, uint32_t out_len, uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i++) {
+    table[i] = out_len;
+  }
+  for (uint32_t i = 0; i < out_len; i++) {
+    table[deinter[i]] = i;
+  }
+}
+
+static uint16_t srsran_rm_turbo_gentable_shift(const uint16_t* deinter_rv0, const uint16_t* deinter, uint32_t out_len)
+{
+  for (uint32_t i = 0; i < out_len; i++) {
+    if (deinter_rv0[i] == deinter[0]) {
+      return i;
+    }
+  }
+  return 0;
+}
+#endif
+
 #if SRSRAN_TDEC_EXPECT_INPUT_SB == 1
 #define inter(x, win) ((x % (long_cb / win)) * (win) + x / (long_cb / win))
 
@@ -275,6 +339,7 @@ static void interleave_table_sb(uint16_t* in, uint16_t* out, uint32_t cb_idx, ui
 
 void srsran_rm_turbo_gentables()
 {
+  pthread_mutex_lock(&rm_turbo_tables_mutex);
   if (!rm_turbo_tables_generated) {
     rm_turbo_tables_generated = true;
     for (int cb_idx = 0; cb_idx < SRSRAN_NOF_TC_CB_SIZES; cb_idx++) {
@@ -307,17 +372,40 @@ void srsran_rm_turbo_gentables()
 
 #if SRSRAN_TDEC_EXPECT_INPUT_SB == 1
         for (uint32_t s = 0; s < NOF_DEINTER_TABLE_SB_IDX; s++) {
+          // Skip code blocks shorter than the number of sub-blocks, they are never decoded with this window
+          if (cb_len < deinter_table_sb_idx[s]) {
+            continue;
+          }
           interleave_table_sb(
               deinterleaver[cb_idx][i], deinterleaver_sb[s][cb_idx][i], cb_idx, deinter_table_sb_idx[s]);
         }
+#endif
+#ifdef LV_HAVE_AVX2
+        interleaver_rx_shift[cb_idx][i] =
+            srsran_rm_turbo_gentable_shift(deinterleaver[cb_idx][0], deinterleaver[cb_idx][i], in_len);
 #endif
       }
+
+#ifdef LV_HAVE_AVX2
+      srsran_rm_turbo_gentable_gather(deinterleaver[cb_idx][0], interleaver_rx[cb_idx], in_len, in_len);
+#if SRSRAN_TDEC_EXPECT_INPUT_SB == 1
+      for (uint32_t s = 0; s < NOF_DEINTER_TABLE_SB_IDX; s++) {
+        if (cb_len < deinter_table_sb_idx[s]) {
+          continue;
+        }
+        srsran_rm_turbo_gentable_gather(
+            deinterleaver_sb[s][cb_idx][0], interleaver_rx_sb[s][cb_idx], in_len, 3 * (cb_len + 32) + 12);
+      }
+#endif
+#endif
     }
   }
+  pthread_mutex_unlock(&rm_turbo_tables_mutex);
 }
 
 void srsran_rm_turbo_free_tables()
 {
+  pthread_mutex_lock(&rm_turbo_tables_mutex);
   if (rm_turbo_tables_generated) {
     for (int i = 0; i < SRSRAN_NOF_TC_CB_SIZES; i++) {
       srsran_bit_interleaver_free(&bit_interleavers_systematic_bits[i]);
@@ -326,6 +414,59 @@ void srsran_rm_turbo_free_tables()
     rm_turbo_tables_generated = false;
   }
   rm_turbo_tables_generated = false;
+  pthread_mutex_unlock(&rm_turbo_tables_mutex);
+}
+
+int srsran_rm_turbo_tx_lut_fill(uint8_t* w_buff, uint8_t* systematic, uint8_t* parity, uint32_t cb_idx)
+{
+  if (cb_idx < SRSRAN_NOF_TC_CB_SIZES) {
+    int in_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
+
+    /* Sub-block interleaver (5.1.4.1.1) and bit collection */
+    // Systematic bits
+    // srsran_bit_interleave(systematic, w_buff, interleaver_systematic_bits[cb_idx], in_len/3);
+    srsran_bit_interleaver_run(&bit_interleavers_systematic_bits[cb_idx], systematic, w_buff, 0);
+
+    // Parity bits
+    // srsran_bit_interleave_w_offset(parity, &w_buff[in_len/24], interleaver_parity_bits[cb_idx], 2*in_len/3, 4);
+    srsran_bit_interleaver_run(&bit_interleavers_parity_bits[cb_idx], parity, &w_buff[in_len / 24], 4);
+
+    return 0;
+  } else {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+}
+
+int srsran_rm_turbo_tx_lut_select(uint8_t* w_buff,
+                                  uint8_t* output,
+                                  uint32_t cb_idx,
+                                  uint32_t out_len,
+                                  uint32_t w_offset,
+                                  uint32_t rv_idx)
+{
+  if (rv_idx < 4 && cb_idx < SRSRAN_NOF_TC_CB_SIZES) {
+    int in_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
+
+    /* Bit selection and transmission 5.1.4.1.2 */
+    int w_len = 0;
+    int r_ptr = k0_vec[cb_idx][rv_idx][1];
+    while (w_len < out_len) {
+      int cp_len = out_len - w_len;
+      if (cp_len + r_ptr >= in_len) {
+        cp_len = in_len - r_ptr;
+      }
+      srsran_bit_copy(output, w_len + w_offset, w_buff, r_ptr, cp_len);
+      r_ptr += cp_len;
+      if (r_ptr >= in_len) {
+        r_ptr -= in_len;
+      }
+      w_len += cp_len;
+    }
+
+    return 0;
+  } else {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 }
 
 /**
@@ -352,36 +493,10 @@ int srsran_rm_turbo_tx_lut(uint8_t* w_buff,
                            uint32_t rv_idx)
 {
   if (rv_idx < 4 && cb_idx < SRSRAN_NOF_TC_CB_SIZES) {
-    int in_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
-
-    /* Sub-block interleaver (5.1.4.1.1) and bit collection */
     if (rv_idx == 0) {
-      // Systematic bits
-      // srsran_bit_interleave(systematic, w_buff, interleaver_systematic_bits[cb_idx], in_len/3);
-      srsran_bit_interleaver_run(&bit_interleavers_systematic_bits[cb_idx], systematic, w_buff, 0);
-
-      // Parity bits
-      // srsran_bit_interleave_w_offset(parity, &w_buff[in_len/24], interleaver_parity_bits[cb_idx], 2*in_len/3, 4);
-      srsran_bit_interleaver_run(&bit_interleavers_parity_bits[cb_idx], parity, &w_buff[in_len / 24], 4);
+      srsran_rm_turbo_tx_lut_fill(w_buff, systematic, parity, cb_idx);
     }
-
-    /* Bit selection and transmission 5.1.4.1.2 */
-    int w_len = 0;
-    int r_ptr = k0_vec[cb_idx][rv_idx][1];
-    while (w_len < out_len) {
-      int cp_len = out_len - w_len;
-      if (cp_len + r_ptr >= in_len) {
-        cp_len = in_len - r_ptr;
-      }
-      srsran_bit_copy(output, w_len + w_offset, w_buff, r_ptr, cp_len);
-      r_ptr += cp_len;
-      if (r_ptr >= in_len) {
-        r_ptr -= in_len;
-      }
-      w_len += cp_len;
-    }
-
-    return 0;
+    return srsran_rm_turbo_tx_lut_select(w_buff, output, cb_idx, out_len, w_offset, rv_idx);
   } else {
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
@@ -412,16 +527,36 @@ int srsran_rm_turbo_rx_lut_(int16_t* input,
     int       cb_len  = srsran_cbsegm_cbsize(cb_idx);
     int       idx     = deinter_table_idx_from_sb_len(srsran_tdec_autoimp_get_subblocks(cb_len));
     uint16_t* deinter = NULL;
+#ifdef LV_HAVE_AVX2
+    uint16_t* inter      = interleaver_rx[cb_idx];
+    uint32_t  gather_len = 3 * cb_len + 12;
+#endif
     if (idx < 0 || !enable_input_tdec) {
       deinter = deinterleaver[cb_idx][rv_idx];
     } else if (idx < NOF_DEINTER_TABLE_SB_IDX) {
       deinter = deinterleaver_sb[idx][cb_idx][rv_idx];
+#ifdef LV_HAVE_AVX2
+      inter      = interleaver_rx_sb[idx][cb_idx];
+      gather_len = 3 * (cb_len + 32) + 12;
+#endif
     } else {
       ERROR("Sub-block size index %d not supported in srsran_rm_turbo_rx_lut()", idx);
       return -1;
     }
 #else
     uint16_t* deinter = deinterleaver[cb_idx][rv_idx];
+#ifdef LV_HAVE_AVX2
+    uint16_t* inter      = interleaver_rx[cb_idx];
+    uint32_t  gather_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
+#endif
+#endif
+
+#ifdef LV_HAVE_AVX2
+    uint32_t rx_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
+    if (in_len >= RM_TURBO_GATHER_MIN_LEN(rx_len)) {
+      return rm_turbo_rx_gather_avx2(
+          input, output, inter, interleaver_rx_shift[cb_idx][rv_idx], in_len, rx_len, gather_len);
+    }
 #endif
 
 #ifdef LV_HAVE_AVX
@@ -451,16 +586,36 @@ int srsran_rm_turbo_rx_lut_8bit(int8_t* input, int8_t* output, uint32_t in_len,
     int       cb_len  = srsran_cbsegm_cbsize(cb_idx);
     int       idx     = deinter_table_idx_from_sb_len(srsran_tdec_autoimp_get_subblocks_8bit(cb_len));
     uint16_t* deinter = NULL;
+#ifdef LV_HAVE_AVX2
+    uint16_t* inter      = interleaver_rx[cb_idx];
+    uint32_t  gather_len = 3 * cb_len + 12;
+#endif
     if (idx < 0) {
       deinter = deinterleaver[cb_idx][rv_idx];
     } else if (idx < NOF_DEINTER_TABLE_SB_IDX) {
       deinter = deinterleaver_sb[idx][cb_idx][rv_idx];
+#ifdef LV_HAVE_AVX2
+      inter      = interleaver_rx_sb[idx][cb_idx];
+      gather_len = 3 * (cb_len + 32) + 12;
+#endif
     } else {
       ERROR("Sub-block size index %d not supported in srsran_rm_turbo_rx_lut()", idx);
       return -1;
     }
 #else
     uint16_t* deinter = deinterleaver[cb_idx][rv_idx];
+#ifdef LV_HAVE_AVX2
+    uint16_t* inter      = interleaver_rx[cb_idx];
+    uint32_t  gather_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
+#endif
+#endif
+
+#ifdef LV_HAVE_AVX2
+    uint32_t rx_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
+    if (in_len >= RM_TURBO_GATHER_MIN_LEN(rx_len)) {
+      return rm_turbo_rx_gather_avx2_8bit(
+          input, output, inter, interleaver_rx_shift[cb_idx][rv_idx], in_len, rx_len, gather_len);
+    }
 #endif
 
     // TODO: AVX version of rm_turbo_rx_lut not working
@@ -966,6 +1121,107 @@ int srsran_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
 
 #endif
 
+#ifdef LV_HAVE_AVX2
+
+/* Folds the in_len received soft bits into a circular buffer of out_len soft bits in rv_idx=0 order, starting at
+ * the position shift of the redundancy version. The positions past out_len are left zero. */
+#define RM_TURBO_FOLD(SUM)                                                                                             \
+  do {                                                                                                                 \
+    uint32_t j = shift;                                                                                                \
+    for (uint32_t i = 0; i < in_len;) {                                                                                \
+      uint32_t n = SRSRAN_MIN(in_len - i, out_len - j);                                                                \
+      SUM(&w_buff[j], &input[i], &w_buff[j], n);                                                                       \
+      i += n;                                                                                                          \
+      j = (j + n == out_len) ? 0 : j + n;                                                                              \
+    }                                                                                                                  \
+  } while (0)
+
+static void rm_turbo_sum_bbb(const int8_t* x, const int8_t* y, int8_t* z, uint32_t len)
+{
+  uint32_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    __m256i a = _mm256_loadu_si256((const __m256i*)&x[i]);
+    __m256i b = _mm256_loadu_si256((const __m256i*)&y[i]);
+    _mm256_storeu_si256((__m256i*)&z[i], _mm256_add_epi8(a, b));
+  }
+  for (; i < len; i++) {
+    z[i] = x[i] + y[i];
+  }
+}
+
+static int rm_turbo_rx_gather_avx2(const int16_t*  input,
+                                   int16_t*        output,
+                                   const uint16_t* inter,
+                                   uint32_t        shift,
+                                   uint32_t        in_len,
+                                   uint32_t        out_len,
+                                   uint32_t        gather_len)
+{
+  // The gathers read 32 bits, keep 2 zero soft bits after the circular buffer
+  int16_t w_buff[3 * SRSRAN_TCOD_MAX_LEN_CB + 12 + 16];
+  srsran_vec_i16_zero(w_buff, out_len + 16);
+  RM_TURBO_FOLD(srsran_vec_sum_sss);
+
+  const __m256i mask = _mm256_set1_epi32(0xffff);
+
+  uint32_t i = 0;
+  for (; i + 16 <= gather_len; i += 16) {
+    __m256i idx0 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)&inter[i]));
+    __m256i idx1 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)&inter[i + 8]));
+    __m256i x0   = _mm256_and_si256(_mm256_i32gather_epi32((const int*)w_buff, idx0, 2), mask);
+    __m256i x1   = _mm256_and_si256(_mm256_i32gather_epi32((const int*)w_buff, idx1, 2), mask);
+    __m256i x    = _mm256_permute4x64_epi64(_mm256_packus_epi32(x0, x1), 0xd8);
+    __m256i y    = _mm256_loadu_si256((__m256i*)&output[i]);
+    _mm256_storeu_si256((__m256i*)&output[i], _mm256_add_epi16(x, y));
+  }
+  for (; i < gather_len; i++) {
+    output[i] += w_buff[inter[i]];
+  }
+
+  return 0;
+}
+
+static int rm_turbo_rx_gather_avx2_8bit(const int8_t*   input,
+                                        int8_t*         output,
+                                        const uint16_t* inter,
+                                        uint32_t        shift,
+                                        uint32_t        in_len,
+                                        uint32_t        out_len,
+                                        uint32_t        gather_len)
+{
+  // The gathers read 32 bits, keep 3 zero soft bits after the circular buffer
+  int8_t w_buff[3 * SRSRAN_TCOD_MAX_LEN_CB + 12 + 32];
+  srsran_vec_i8_zero(w_buff, out_len + 32);
+  RM_TURBO_FOLD(rm_turbo_sum_bbb);
+
+  const __m256i mask = _mm256_set1_epi32(0xff);
+  const __m256i perm = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+  uint32_t i = 0;
+  for (; i + 32 <= gather_len; i += 32) {
+    __m256i idx0 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)&inter[i]));
+    __m256i idx1 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)&inter[i + 8]));
+    __m256i idx2 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)&inter[i + 16]));
+    __m256i idx3 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)&inter[i + 24]));
+    __m256i x0   = _mm256_and_si256(_mm256_i32gather_epi32((const int*)w_buff, idx0, 1), mask);
+    __m256i x1   = _mm256_and_si256(_mm256_i32gather_epi32((const int*)w_buff, idx1, 1), mask);
+    __m256i x2   = _mm256_and_si256(_mm256_i32gather_epi32((const int*)w_buff, idx2, 1), mask);
+    __m256i x3   = _mm256_and_si256(_mm256_i32gather_epi32((const int*)w_buff, idx3, 1), mask);
+    __m256i x01  = _mm256_packus_epi32(x0, x1);
+    __m256i x23  = _mm256_packus_epi32(x2, x3);
+    __m256i x    = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(x01, x23), perm);
+    __m256i y    = _mm256_loadu_si256((__m256i*)&output[i]);
+    _mm256_storeu_si256((__m256i*)&output[i], _mm256_add_epi8(x, y));
+  }
+  for (; i < gather_len; i++) {
+    output[i] += w_buff[inter[i]];
+  }
+
+  return 0;
+}
+
+#endif
+
 /* Turbo Code Rate Matching.
  * 3GPP TS 36.212 v10.1.0 section 5.1.4.1
  *
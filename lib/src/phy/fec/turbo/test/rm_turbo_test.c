@@ -188,7 +188,26 @@ int main(int argc, char** argv)
         }
       }
 
-      printf("OK RX\n");
+      printf("OK RX...");
+
+      // Soft combine a retransmission with the next redundancy version
+      uint32_t rv_idx2 = (rv_idx + 1) % 4;
+      for (int i = 0; i < nof_e_bits; i++) {
+        rm_bits_f[i] = rand() % 10 - 5;
+        rm_bits_s[i] = (short)rm_bits_f[i];
+      }
+
+      srsran_rm_turbo_rx(buff_f, BUFFSZ, rm_bits_f, nof_e_bits, bits_f, long_cb_enc, rv_idx2, 0);
+      srsran_rm_turbo_rx_lut_(rm_bits_s, bits2_s, nof_e_bits, cb_idx, rv_idx2, false);
+
+      for (int i = 0; i < long_cb_enc; i++) {
+        if (bits_f[i] != bits2_s[i]) {
+          printf("error combining RX in bit %d %f!=%d\n", i, bits_f[i], bits2_s[i]);
+          exit(-1);
+        }
+      }
+
+      printf("OK combining\n");
     }
   }
 
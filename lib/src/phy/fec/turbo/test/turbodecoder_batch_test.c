@@ -0,0 +1,236 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/srsran.h"
+#include <srsran/phy/utils/random.h>
+
+static uint32_t frame_length   = 6144;
+static uint32_t nof_frames     = 10;
+static uint32_t nof_cb         = 0;
+static uint32_t nof_iterations = 8;
+static float    ebno_db        = 1.5;
+static uint32_t seed           = 0;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [lcineps]\n", prog);
+  printf("\t-l frame_length [Default %d]\n", frame_length);
+  printf("\t-c nof_cb per batch [Default 0=max]\n");
+  printf("\t-i nof_iterations [Default %d]\n", nof_iterations);
+  printf("\t-n nof_frames [Default %d]\n", nof_frames);
+  printf("\t-e ebno in dB [Default %.1f]\n", ebno_db);
+  printf("\t-s seed [Default 0=time]\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "lcines")) != -1) {
+    switch (opt) {
+      case 'l':
+        frame_length = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'c':
+        nof_cb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'i':
+        nof_iterations = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_frames = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'e':
+        ebno_db = strtof(argv[optind], NULL);
+        break;
+      case 's':
+        seed = (uint32_t)strtoul(argv[optind], NULL, 0);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int                 ret = SRSRAN_ERROR;
+  srsran_tcod_t       tcod;
+  srsran_tdec_t       tdec;
+  srsran_tdec_batch_t tdec_batch;
+  int16_t*            llr_s[SRSRAN_TDEC_BATCH_MAX_NOF_CB]   = {};
+  uint8_t*            data_ref[SRSRAN_TDEC_BATCH_MAX_NOF_CB] = {};
+  uint8_t*            data_rx[SRSRAN_TDEC_BATCH_MAX_NOF_CB]  = {};
+  uint8_t*            data_tx  = NULL;
+  uint8_t*            symbols  = NULL;
+  float*              llr      = NULL;
+  uint64_t            t_single = 0;
+  uint64_t            t_batch  = 0;
+  uint32_t            errors   = 0;
+  uint32_t            mismatch = 0;
+  struct timeval      t[3];
+
+  parse_args(argc, argv);
+
+  if (!seed) {
+    seed = time(NULL);
+  }
+  srsran_random_t random_gen = srsran_random_init(seed);
+
+  int n = srsran_cbsegm_cbsize(srsran_cbsegm_cbindex(frame_length));
+  if (n < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  frame_length = (uint32_t)n;
+
+  uint32_t coded_length = SRSRAN_TCOD_RATE * frame_length + SRSRAN_TCOD_TOTALTAIL;
+
+  if (srsran_tcod_init(&tcod, frame_length) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating Turbo coder");
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_tdec_init_manual(&tdec, frame_length, SRSRAN_TDEC_GENERIC) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating Turbo decoder");
+    return SRSRAN_ERROR;
+  }
+  srsran_tdec_force_not_sb(&tdec);
+
+  if (srsran_tdec_batch_init(&tdec_batch, frame_length) < SRSRAN_SUCCESS) {
+    printf("Batched turbo decoder not supported in this architecture, skipping\n");
+    srsran_tdec_free(&tdec);
+    srsran_tcod_free(&tcod);
+    return SRSRAN_SUCCESS;
+  }
+
+  uint32_t max_nof_cb = srsran_tdec_batch_max_nof_cb(&tdec_batch);
+  if (nof_cb == 0 || nof_cb > max_nof_cb) {
+    nof_cb = max_nof_cb;
+  }
+
+  data_tx = srsran_vec_u8_malloc(frame_length);
+  symbols = srsran_vec_u8_malloc(coded_length);
+  llr     = srsran_vec_f_malloc(coded_length);
+  if (!data_tx || !symbols || !llr) {
+    perror("malloc");
+    goto clean_exit;
+  }
+  for (uint32_t i = 0; i < nof_cb; i++) {
+    llr_s[i]    = srsran_vec_i16_malloc(coded_length);
+    data_ref[i] = srsran_vec_u8_malloc(frame_length / 8);
+    data_rx[i]  = srsran_vec_u8_malloc(frame_length / 8);
+    if (!llr_s[i] || !data_ref[i] || !data_rx[i]) {
+      perror("malloc");
+      goto clean_exit;
+    }
+  }
+
+  float var = srsran_convert_dB_to_power(-(ebno_db + srsran_convert_power_to_dB(1.0f / 3.0f)));
+
+  printf("  Frame length: %d, nof_cb: %d, iterations: %d, EbNo: %.2f\n", frame_length, nof_cb, nof_iterations, ebno_db);
+
+  for (uint32_t frame = 0; frame < nof_frames; frame++) {
+    for (uint32_t cb = 0; cb < nof_cb; cb++) {
+      for (uint32_t j = 0; j < frame_length; j++) {
+        data_tx[j] = srsran_random_uniform_int_dist(random_gen, 0, 1);
+      }
+      srsran_tcod_encode(&tcod, data_tx, symbols, frame_length);
+      for (uint32_t j = 0; j < coded_length; j++) {
+        llr[j] = symbols[j] ? 1 : -1;
+      }
+      srsran_ch_awgn_f(llr, llr, var, coded_length);
+      for (uint32_t j = 0; j < coded_length; j++) {
+        llr_s[cb][j] = (int16_t)(100 * llr[j]);
+      }
+
+      // Reference: one code block at a time with the generic decoder
+      gettimeofday(&t[1], NULL);
+      srsran_tdec_new_cb(&tdec, frame_length);
+      srsran_tdec_run_all(&tdec, llr_s[cb], data_ref[cb], nof_iterations, frame_length);
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      t_single += t[0].tv_sec * 1000000 + t[0].tv_usec;
+
+      uint8_t bits[SRSRAN_TCOD_MAX_LEN_CB];
+      srsran_bit_unpack_vector(data_ref[cb], bits, frame_length);
+      errors += srsran_bit_diff(data_tx, bits, frame_length);
+    }
+
+    gettimeofday(&t[1], NULL);
+    srsran_tdec_batch_run_all(&tdec_batch, llr_s, data_rx, nof_cb, nof_iterations, frame_length);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    t_batch += t[0].tv_sec * 1000000 + t[0].tv_usec;
+
+    // The batched decoder runs the same fixed-point algorithm, the output must match bit by bit
+    for (uint32_t cb = 0; cb < nof_cb; cb++) {
+      if (memcmp(data_ref[cb], data_rx[cb], frame_length / 8) != 0) {
+        mismatch++;
+      }
+    }
+  }
+
+  uint32_t nof_bits = nof_frames * nof_cb * frame_length;
+  printf("  BER: %.2e\n", (float)errors / nof_bits);
+  printf("  Generic: %.1f Mbps\n", (float)nof_bits / t_single);
+  printf("  Batch:   %.1f Mbps\n", (float)nof_bits / t_batch);
+
+  if (mismatch) {
+    printf("  %d code blocks do not match the generic decoder\n", mismatch);
+  } else {
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  for (uint32_t i = 0; i < SRSRAN_TDEC_BATCH_MAX_NOF_CB; i++) {
+    if (llr_s[i]) {
+      free(llr_s[i]);
+    }
+    if (data_ref[i]) {
+      free(data_ref[i]);
+    }
+    if (data_rx[i]) {
+      free(data_rx[i]);
+    }
+  }
+  if (data_tx) {
+    free(data_tx);
+  }
+  if (symbols) {
+    free(symbols);
+  }
+  if (llr) {
+    free(llr);
+  }
+  srsran_tdec_batch_free(&tdec_batch);
+  srsran_tdec_free(&tdec);
+  srsran_tcod_free(&tcod);
+  srsran_random_free(random_gen);
+
+  printf("%s\n", ret ? "Failed" : "Ok");
+  return ret;
+}
@@ -45,16 +45,53 @@ int nof_iterations  = MAX_ITERATIONS;
 int test_known_data = 0;
 int test_errors     = 0;
 int nof_repetitions = 1;
+int test_all_impl   = 0;
 
 srsran_tdec_impl_type_t tdec_type;
 
+// Sub-block decoders need at least the window overlap length per sub-block
+#define MIN_SB_LEN 40
+
 #define SNR_POINTS 4
 #define SNR_MIN 1.0
 #define SNR_MAX 8.0
 
+static const char* tdec_type_to_str(srsran_tdec_impl_type_t type)
+{
+  switch (type) {
+    case SRSRAN_TDEC_AUTO:
+      return "auto";
+    case SRSRAN_TDEC_GENERIC:
+      return "generic";
+    case SRSRAN_TDEC_SSE:
+      return "sse";
+    case SRSRAN_TDEC_SSE_WINDOW:
+      return "sse-win";
+    case SRSRAN_TDEC_NEON_WINDOW:
+      return "neon-win";
+    case SRSRAN_TDEC_AVX_WINDOW:
+      return "avx2-win";
+    case SRSRAN_TDEC_AVX512_WINDOW:
+      return "avx512-win";
+    case SRSRAN_TDEC_SSE8_WINDOW:
+      return "sse8-win";
+    case SRSRAN_TDEC_AVX8_WINDOW:
+      return "avx2-8-win";
+    case SRSRAN_TDEC_AVX512_8_WINDOW:
+      return "avx512-8-win";
+    default:
+      return "unknown";
+  }
+}
+
+static bool tdec_type_is_8bit(srsran_tdec_impl_type_t type)
+{
+  return type >= SRSRAN_TDEC_SSE8_WINDOW;
+}
+
 void usage(char* prog)
 {
-  printf("Usage: %s [kcinNledts]\n", prog);
+  printf("Usage: %s [kcinNledtsa]\n", prog);
   printf("\t-k Test with known data (ignores frame_length) [Default disabled]\n");
   printf("\t-c nof_cb in parallel [Default %d]\n", nof_cb);
   printf("\t-i nof_iterations [Default %d]\n", nof_iterations);
@@ -62,7 +99,8 @@ void usage(char* prog)
   printf("\t-N nof_repetitions [Default %d]\n", nof_repetitions);
   printf("\t-l frame_length [Default %d]\n", frame_length);
   printf("\t-e ebno in dB [Default scan]\n");
-  printf("\t-d Decoder implementation type: 0: Generic, 1: SSE, 2: SSE-window\n");
+  printf("\t-d Decoder implementation type (srsran_tdec_impl_type_t) [Default %d]\n", tdec_type);
+  printf("\t-a Run all available decoder implementations and report throughput [Default disabled]\n");
   printf("\t-t test: check errors on exit [Default disabled]\n");
   printf("\t-s seed [Default 0=time]\n");
 }
@@ -70,7 +108,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "kcinNledts")) != -1) {
+  while ((opt = getopt(argc, argv, "kcinNledtsa")) != -1) {
     switch (opt) {
       case 'c':
         nof_cb = (int)strtol(argv[optind], NULL, 10);
@@ -87,6 +125,9 @@ void parse_args(int argc, char** argv)
       case 't':
         test_errors = 1;
         break;
+      case 'a':
+        test_all_impl = 1;
+        break;
       case 'i':
         nof_iterations = (int)strtol(argv[optind], NULL, 10);
         break;
@@ -197,16 +238,12 @@ int main(int argc, char** argv)
   }
 
 #ifdef HAVE_NEON
-  tdec_type = SRSRAN_TDEC_NEON_WINDOW;
+  if (!test_all_impl) {
+    tdec_type = SRSRAN_TDEC_NEON_WINDOW;
+  }
 #else
   // tdec_type = SRSRAN_TDEC_SSE_WINDOW;
 #endif
-  if (srsran_tdec_init_manual(&tdec, frame_length, tdec_type)) {
-    ERROR("Error initiating Turbo decoder");
-    exit(-1);
-  }
-
-  srsran_tdec_force_not_sb(&tdec);
 
   float ebno_inc, esno_db;
   ebno_inc = (SNR_MAX - SNR_MIN) / SNR_POINTS;
@@ -222,75 +259,127 @@ int main(int argc, char** argv)
     var[0]     = srsran_convert_dB_to_power(-esno_db);
     snr_points = 1;
   }
-  for (uint32_t i = 0; i < snr_points; i++) {
-    mean_usec = 0;
-    errors    = 0;
-    frame_cnt = 0;
-    while (frame_cnt < nof_frames) {
-      /* generate data_tx */
-      for (uint32_t j = 0; j < frame_length; j++) {
+
+  srsran_tdec_impl_type_t first_type = test_all_impl ? SRSRAN_TDEC_AUTO : tdec_type;
+  srsran_tdec_impl_type_t last_type  = test_all_impl ? SRSRAN_TDEC_NOF_IMP - 1 : tdec_type;
+  float                   mbps[SRSRAN_TDEC_NOF_IMP] = {};
+
+  for (srsran_tdec_impl_type_t type = first_type; type <= last_type; type++) {
+    if (srsran_tdec_init_manual(&tdec, frame_length, type)) {
+      if (test_all_impl) {
+        continue;
+      }
+      ERROR("Error initiating Turbo decoder");
+      exit(-1);
+    }
+
+    // Skip sub-block decoders that can not split this frame length
+    int nof_sb = tdec_type_is_8bit(type) ? tdec.nof_blocks8[0] : tdec.nof_blocks16[0];
+    if (test_all_impl && type != SRSRAN_TDEC_AUTO && nof_sb > 1 &&
+        ((frame_length % nof_sb) || (frame_length / nof_sb) < MIN_SB_LEN)) {
+      printf("  %s: skipped, frame length %d not supported\n", tdec_type_to_str(type), frame_length);
+      srsran_tdec_free(&tdec);
+      continue;
+    }
+
+    srsran_tdec_force_not_sb(&tdec);
+
+    printf("  Decoder: %s\n", tdec_type_to_str(type));
+
+    for (uint32_t i = 0; i < snr_points; i++) {
+      float total_usec = 0;
+      mean_usec        = 0;
+      errors           = 0;
+      frame_cnt        = 0;
+      while (frame_cnt < nof_frames) {
+        /* generate data_tx */
+        for (uint32_t j = 0; j < frame_length; j++) {
+          if (test_known_data) {
+            data_tx[j] = known_data[j];
+          } else {
+            data_tx[j] = srsran_random_uniform_int_dist(random_gen, 0, 1);
+          }
+        }
+
+        /* coded BER */
         if (test_known_data) {
-          data_tx[j] = known_data[j];
+          for (uint32_t j = 0; j < coded_length; j++) {
+            symbols[j] = known_data_encoded[j];
+          }
         } else {
-          data_tx[j] = srsran_random_uniform_int_dist(random_gen, 0, 1);
+          srsran_tcod_encode(&tcod, data_tx, symbols, frame_length);
         }
-      }
 
-      /* coded BER */
-      if (test_known_data) {
         for (uint32_t j = 0; j < coded_length; j++) {
-          symbols[j] = known_data_encoded[j];
+          llr[j] = symbols[j] ? 1 : -1;
         }
-      } else {
-        srsran_tcod_encode(&tcod, data_tx, symbols, frame_length);
-      }
+        srsran_ch_awgn_f(llr, llr, var[i], coded_length);
 
-      for (uint32_t j = 0; j < coded_length; j++) {
-        llr[j] = symbols[j] ? 1 : -1;
-      }
-      srsran_ch_awgn_f(llr, llr, var[i], coded_length);
+        for (uint32_t j = 0; j < coded_length; j++) {
+          llr_s[j] = (int16_t)(100 * llr[j]);
+        }
 
-      for (uint32_t j = 0; j < coded_length; j++) {
-        llr_s[j] = (int16_t)(100 * llr[j]);
-      }
+        // The 8-bit decoders take a smaller, saturated LLR range
+        int8_t* llr_b = (int8_t*)llr_c;
+        for (uint32_t j = 0; j < coded_length; j++) {
+          llr_b[j] = (int8_t)SRSRAN_MAX(-127, SRSRAN_MIN(127, 10 * llr[j]));
+        }
 
-      /* decoder */
-      srsran_tdec_new_cb(&tdec, frame_length);
+        /* decoder */
+        srsran_tdec_new_cb(&tdec, frame_length);
 
-      uint32_t t;
-      if (nof_iterations == -1) {
-        t = MAX_ITERATIONS;
-      } else {
-        t = nof_iterations;
-      }
+        uint32_t t;
+        if (nof_iterations == -1) {
+          t = MAX_ITERATIONS;
+        } else {
+          t = nof_iterations;
+        }
 
-      gettimeofday(&tdata[1], NULL);
-      for (int k = 0; k < nof_repetitions; k++) {
-        srsran_tdec_run_all(&tdec, llr_s, data_rx_bytes, t, frame_length);
+        gettimeofday(&tdata[1], NULL);
+        for (int k = 0; k < nof_repetitions; k++) {
+          if (tdec_type_is_8bit(type)) {
+            srsran_tdec_run_all_8bit(&tdec, llr_b, data_rx_bytes, t, frame_length);
+          } else {
+            srsran_tdec_run_all(&tdec, llr_s, data_rx_bytes, t, frame_length);
+          }
+        }
+        gettimeofday(&tdata[2], NULL);
+        get_time_interval(tdata);
+        mean_usec = (tdata[0].tv_sec * 1e6 + tdata[0].tv_usec) / nof_repetitions;
+        total_usec += mean_usec;
+
+        frame_cnt++;
+        uint32_t errors_this = 0;
+        srsran_bit_unpack_vector(data_rx_bytes, data_rx, frame_length);
+
+        errors_this = srsran_bit_diff(data_tx, data_rx, frame_length);
+        // printf("error[%d]=%d\n", cb, errors_this);
+        errors += errors_this;
+        printf("Eb/No: %2.2f %10d/%d   ", SNR_MIN + i * ebno_inc, frame_cnt, nof_frames);
+        printf("BER: %.2e  ", (float)errors / (nof_cb * frame_cnt * frame_length));
+        printf("%3.1f Mbps (%6.2f usec)", (float)(nof_cb * frame_length) / mean_usec, mean_usec);
+        printf("\r");
       }
-      gettimeofday(&tdata[2], NULL);
-      get_time_interval(tdata);
-      mean_usec = (tdata[0].tv_sec * 1e6 + tdata[0].tv_usec) / nof_repetitions;
-
-      frame_cnt++;
-      uint32_t errors_this = 0;
-      srsran_bit_unpack_vector(data_rx_bytes, data_rx, frame_length);
-
-      errors_this = srsran_bit_diff(data_tx, data_rx, frame_length);
-      // printf("error[%d]=%d\n", cb, errors_this);
-      errors += errors_this;
-      printf("Eb/No: %2.2f %10d/%d   ", SNR_MIN + i * ebno_inc, frame_cnt, nof_frames);
-      printf("BER: %.2e  ", (float)errors / (nof_cb * frame_cnt * frame_length));
-      printf("%3.1f Mbps (%6.2f usec)", (float)(nof_cb * frame_length) / mean_usec, mean_usec);
-      printf("\r");
+      printf("\n");
+      mbps[type] = (float)(nof_cb * frame_length * frame_cnt) / total_usec;
     }
+
     printf("\n");
+    if (snr_points == 1) {
+      if (errors) {
+        printf("%d Errors\n", errors / nof_cb);
+      }
+    }
+
+    srsran_tdec_free(&tdec);
   }
 
-  printf("\n");
-  if (snr_points == 1) {
-    if (errors) {
-      printf("%d Errors\n", errors / nof_cb);
+  if (test_all_impl) {
+    printf("Throughput per implementation (frame length %d, %d iterations):\n", frame_length, nof_iterations);
+    for (srsran_tdec_impl_type_t type = first_type; type <= last_type; type++) {
+      if (mbps[type] > 0) {
+        printf("  %-14s %8.1f Mbps\n", tdec_type_to_str(type), mbps[type]);
+      }
     }
   }
 
@@ -302,7 +391,6 @@ int main(int argc, char** argv)
   free(llr_s);
   free(data_rx);
 
-  srsran_tdec_free(&tdec);
   srsran_tcod_free(&tcod);
   srsran_random_free(random_gen);
 
@@ -19,6 +19,7 @@
  *
  */
 
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -46,15 +47,20 @@ static srsran_bit_interleaver_t tcod_interleavers[188];
 
 static bool table_initiated = false;
 
+// The tables are shared by all the encoders, which can be initialised from several threads
+static pthread_mutex_t table_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 int srsran_tcod_init(srsran_tcod_t* h, uint32_t max_long_cb)
 {
   h->max_long_cb = max_long_cb;
   h->temp        = srsran_vec_malloc(max_long_cb / 8);
 
+  pthread_mutex_lock(&table_mutex);
   if (!table_initiated) {
     table_initiated = true;
     srsran_tcod_gentable();
   }
+  pthread_mutex_unlock(&table_mutex);
   return 0;
 }
 
@@ -65,12 +71,14 @@ void srsran_tcod_free(srsran_tcod_t* h)
     free(h->temp);
   }
 
+  pthread_mutex_lock(&table_mutex);
   if (table_initiated) {
     for (int i = 0; i < 188; i++) {
       srsran_bit_interleaver_free(&tcod_interleavers[i]);
     }
     table_initiated = false;
   }
+  pthread_mutex_unlock(&table_mutex);
 }
 
 /* Expects bits (1 byte = 1 bit) and produces bits. The systematic and parity bits are interlaced in the output */
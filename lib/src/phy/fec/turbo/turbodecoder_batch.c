@@ -0,0 +1,441 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "srsran/phy/fec/turbo/turbodecoder_batch.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+
+#define NUMSTATES 8
+#define NINPUTS 2
+#define TAIL 3
+
+#define INF 10000
+
+#if SRSRAN_SIMD_S_SIZE
+
+/************************************************
+ *
+ *  Vectorized version of the MAX-LOG-MAP generic
+ *  implementation (turbodecoder_gen.c). Each lane
+ *  of the SIMD register runs one code block.
+ *
+ ************************************************/
+static void map_batch_beta(srsran_tdec_batch_t* q, int16_t* input, int16_t* app, int16_t* parity, uint32_t long_cb)
+{
+  simd_s_t m_b[8], new[8], old[8];
+  simd_s_t x, y, xy;
+  uint32_t L    = SRSRAN_SIMD_S_SIZE;
+  uint32_t end  = long_cb + TAIL;
+  int16_t* beta = q->beta;
+
+  // Trellis is terminated, the last state is known
+  old[0] = srsran_simd_s_zero();
+  for (int i = 1; i < NUMSTATES; i++) {
+    old[i] = srsran_simd_s_set1(-INF);
+  }
+  for (int i = 0; i < NUMSTATES; i++) {
+    srsran_simd_s_store(&beta[(NUMSTATES * end + i) * L], old[i]);
+  }
+
+  for (int k = end - 1; k >= 0; k--) {
+    x = srsran_simd_s_load(&input[k * L]);
+    if (app && k < long_cb) {
+      x = srsran_simd_s_add(x, srsran_simd_s_load(&app[k * L]));
+    }
+    y = srsran_simd_s_load(&parity[k * L]);
+
+    xy = srsran_simd_s_add(x, y);
+
+    m_b[0] = srsran_simd_s_add(old[4], xy);
+    m_b[1] = old[4];
+    m_b[2] = srsran_simd_s_add(old[5], y);
+    m_b[3] = srsran_simd_s_add(old[5], x);
+    m_b[4] = srsran_simd_s_add(old[6], x);
+    m_b[5] = srsran_simd_s_add(old[6], y);
+    m_b[6] = old[7];
+    m_b[7] = srsran_simd_s_add(old[7], xy);
+
+    new[0] = old[0];
+    new[1] = srsran_simd_s_add(old[0], xy);
+    new[2] = srsran_simd_s_add(old[1], x);
+    new[3] = srsran_simd_s_add(old[1], y);
+    new[4] = srsran_simd_s_add(old[2], y);
+    new[5] = srsran_simd_s_add(old[2], x);
+    new[6] = srsran_simd_s_add(old[3], xy);
+    new[7] = old[3];
+
+    for (int i = 0; i < NUMSTATES; i++) {
+      old[i] = srsran_simd_s_max(m_b[i], new[i]);
+      srsran_simd_s_store(&beta[(NUMSTATES * k + i) * L], old[i]);
+    }
+
+    if ((k % 4) == 0 && k < long_cb) {
+      for (int i = 1; i < NUMSTATES; i++) {
+        old[i] = srsran_simd_s_sub(old[i], old[0]);
+      }
+      old[0] = srsran_simd_s_zero();
+    }
+  }
+}
+
+static void map_batch_alpha(srsran_tdec_batch_t* q,
+                            int16_t*             input,
+                            int16_t*             app,
+                            int16_t*             parity,
+                            int16_t*             output,
+                            uint32_t             long_cb)
+{
+  simd_s_t m_b[8], new[8], old[8], max1[8], max0[8];
+  simd_s_t m1, m0, beta;
+  simd_s_t x, y, xy;
+  uint32_t L = SRSRAN_SIMD_S_SIZE;
+
+  old[0] = srsran_simd_s_zero();
+  for (int i = 1; i < NUMSTATES; i++) {
+    old[i] = srsran_simd_s_set1(-INF);
+  }
+
+  for (uint32_t k = 1; k < long_cb + 1; k++) {
+    x = srsran_simd_s_load(&input[(k - 1) * L]);
+    if (app) {
+      x = srsran_simd_s_add(x, srsran_simd_s_load(&app[(k - 1) * L]));
+    }
+    y = srsran_simd_s_load(&parity[(k - 1) * L]);
+
+    xy = srsran_simd_s_add(x, y);
+
+    m_b[0] = old[0];
+    m_b[1] = srsran_simd_s_add(old[3], y);
+    m_b[2] = srsran_simd_s_add(old[4], y);
+    m_b[3] = old[7];
+    m_b[4] = old[1];
+    m_b[5] = srsran_simd_s_add(old[2], y);
+    m_b[6] = srsran_simd_s_add(old[5], y);
+    m_b[7] = old[6];
+
+    new[0] = srsran_simd_s_add(old[1], xy);
+    new[1] = srsran_simd_s_add(old[2], x);
+    new[2] = srsran_simd_s_add(old[5], x);
+    new[3] = srsran_simd_s_add(old[6], xy);
+    new[4] = srsran_simd_s_add(old[0], xy);
+    new[5] = srsran_simd_s_add(old[3], x);
+    new[6] = srsran_simd_s_add(old[4], x);
+    new[7] = srsran_simd_s_add(old[7], xy);
+
+    for (int i = 0; i < NUMSTATES; i++) {
+      beta    = srsran_simd_s_load(&q->beta[(NUMSTATES * k + i) * L]);
+      max0[i] = srsran_simd_s_add(m_b[i], beta);
+      max1[i] = srsran_simd_s_add(new[i], beta);
+    }
+
+    m1 = max1[0];
+    m0 = max0[0];
+    for (int i = 1; i < NUMSTATES; i++) {
+      m1 = srsran_simd_s_max(m1, max1[i]);
+      m0 = srsran_simd_s_max(m0, max0[i]);
+    }
+
+    for (int i = 0; i < NUMSTATES; i++) {
+      old[i] = srsran_simd_s_max(m_b[i], new[i]);
+    }
+
+    if ((k % 4) == 0) {
+      for (int i = 1; i < NUMSTATES; i++) {
+        old[i] = srsran_simd_s_sub(old[i], old[0]);
+      }
+      old[0] = srsran_simd_s_zero();
+    }
+
+    srsran_simd_s_store(&output[(k - 1) * L], srsran_simd_s_sub(m1, m0));
+  }
+}
+
+static void map_batch_dec(srsran_tdec_batch_t* q,
+                          int16_t*             input,
+                          int16_t*             app,
+                          int16_t*             parity,
+                          int16_t*             output,
+                          uint32_t             long_cb)
+{
+  map_batch_beta(q, input, app, parity, long_cb);
+  map_batch_alpha(q, input, app, parity, output, long_cb);
+}
+
+static void vec_batch_sub(int16_t* x, int16_t* y, int16_t* z, uint32_t long_cb)
+{
+  for (uint32_t k = 0; k < long_cb * SRSRAN_SIMD_S_SIZE; k += SRSRAN_SIMD_S_SIZE) {
+    srsran_simd_s_store(&z[k], srsran_simd_s_sub(srsran_simd_s_load(&x[k]), srsran_simd_s_load(&y[k])));
+  }
+}
+
+/* Same as srsran_vec_lut_sss() but moving all lanes of one sample at once */
+static void vec_batch_lut(int16_t* x, uint16_t* lut, int16_t* y, uint32_t long_cb)
+{
+  for (uint32_t k = 0; k < long_cb; k++) {
+    srsran_simd_s_store(&y[lut[k] * SRSRAN_SIMD_S_SIZE], srsran_simd_s_load(&x[k * SRSRAN_SIMD_S_SIZE]));
+  }
+}
+
+#endif /* SRSRAN_SIMD_S_SIZE */
+
+int srsran_tdec_batch_init(srsran_tdec_batch_t* q, uint32_t max_long_cb)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  bzero(q, sizeof(srsran_tdec_batch_t));
+
+#if SRSRAN_SIMD_S_SIZE
+  q->max_long_cb = max_long_cb;
+  q->nof_lanes   = SRSRAN_SIMD_S_SIZE;
+
+  uint32_t len = (max_long_cb + TAIL) * q->nof_lanes;
+
+  q->syst    = srsran_vec_i16_malloc(len);
+  q->parity0 = srsran_vec_i16_malloc(len);
+  q->parity1 = srsran_vec_i16_malloc(len);
+  q->app1    = srsran_vec_i16_malloc(len);
+  q->app2    = srsran_vec_i16_malloc(len);
+  q->ext1    = srsran_vec_i16_malloc(len);
+  q->ext2    = srsran_vec_i16_malloc(len);
+  q->beta    = srsran_vec_i16_malloc((max_long_cb + TAIL + 1) * NUMSTATES * q->nof_lanes);
+  if (!q->syst || !q->parity0 || !q->parity1 || !q->app1 || !q->app2 || !q->ext1 || !q->ext2 || !q->beta) {
+    perror("srsran_vec_malloc");
+    srsran_tdec_batch_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_tc_interl_init(&q->interleaver, max_long_cb) < 0) {
+    srsran_tdec_batch_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+#else  /* SRSRAN_SIMD_S_SIZE */
+  ERROR("Batched turbo decoder requires SIMD support");
+  return SRSRAN_ERROR;
+#endif /* SRSRAN_SIMD_S_SIZE */
+}
+
+void srsran_tdec_batch_free(srsran_tdec_batch_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->syst) {
+    free(q->syst);
+  }
+  if (q->parity0) {
+    free(q->parity0);
+  }
+  if (q->parity1) {
+    free(q->parity1);
+  }
+  if (q->app1) {
+    free(q->app1);
+  }
+  if (q->app2) {
+    free(q->app2);
+  }
+  if (q->ext1) {
+    free(q->ext1);
+  }
+  if (q->ext2) {
+    free(q->ext2);
+  }
+  if (q->beta) {
+    free(q->beta);
+  }
+  srsran_tc_interl_free(&q->interleaver);
+
+  bzero(q, sizeof(srsran_tdec_batch_t));
+}
+
+uint32_t srsran_tdec_batch_max_nof_cb(srsran_tdec_batch_t* q)
+{
+  return q ? q->nof_lanes : 0;
+}
+
+int srsran_tdec_batch_new_cb(srsran_tdec_batch_t* q, int16_t** input, uint32_t nof_cb, uint32_t long_cb)
+{
+  if (q == NULL || input == NULL || nof_cb == 0 || nof_cb > q->nof_lanes) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (long_cb > q->max_long_cb) {
+    ERROR("TDEC batch was initialized for max_long_cb=%d", q->max_long_cb);
+    return SRSRAN_ERROR;
+  }
+
+  // The interleaver tables are only regenerated when the code block length changes
+  if (long_cb != q->current_long_cb) {
+    if (srsran_tc_interl_LTE_gen(&q->interleaver, long_cb) < 0) {
+      return SRSRAN_ERROR;
+    }
+    q->current_long_cb = long_cb;
+  }
+
+  q->current_nof_cb = nof_cb;
+  q->n_iter         = 0;
+
+  uint32_t L = q->nof_lanes;
+
+  // Unused lanes decode an all-zero LLR code block
+  if (nof_cb < L) {
+    srsran_vec_i16_zero(q->syst, (long_cb + TAIL) * L);
+    srsran_vec_i16_zero(q->parity0, (long_cb + TAIL) * L);
+    srsran_vec_i16_zero(q->parity1, (long_cb + TAIL) * L);
+    srsran_vec_i16_zero(q->app2, (long_cb + TAIL) * L);
+  }
+
+  // Prepare systematic and parity bits for MAP DEC #1, interleaving them across lanes. The lane loop is the inner
+  // one so that the interleaved buffers are written sequentially.
+  for (uint32_t i = 0; i < long_cb; i++) {
+    for (uint32_t l = 0; l < nof_cb; l++) {
+      q->syst[i * L + l]    = input[l][SRSRAN_TCOD_RATE * i];
+      q->parity0[i * L + l] = input[l][SRSRAN_TCOD_RATE * i + 1];
+      q->parity1[i * L + l] = input[l][SRSRAN_TCOD_RATE * i + 2];
+    }
+  }
+  for (uint32_t i = long_cb; i < long_cb + TAIL; i++) {
+    for (uint32_t l = 0; l < nof_cb; l++) {
+      int16_t* tail = &input[l][SRSRAN_TCOD_RATE * long_cb];
+
+      q->syst[i * L + l]    = tail[NINPUTS * (i - long_cb)];
+      q->parity0[i * L + l] = tail[NINPUTS * (i - long_cb) + 1];
+
+      q->app2[i * L + l]    = tail[NINPUTS * SRSRAN_TCOD_RATE + NINPUTS * (i - long_cb)];
+      q->parity1[i * L + l] = tail[NINPUTS * SRSRAN_TCOD_RATE + NINPUTS * (i - long_cb) + 1];
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Runs 1 turbo decoder half-iteration for all code blocks, same schedule as srsran_tdec_iteration() */
+void srsran_tdec_batch_iteration(srsran_tdec_batch_t* q)
+{
+#if SRSRAN_SIMD_S_SIZE
+  if (q == NULL || q->current_nof_cb == 0) {
+    ERROR("Error CB not set (call srsran_tdec_batch_new_cb() first");
+    return;
+  }
+
+  uint32_t long_cb = q->current_long_cb;
+
+  if ((q->n_iter % 2) == 0) {
+    // Add apriori information to decoder 1
+    if (q->n_iter) {
+      vec_batch_sub(q->app1, q->ext1, q->app1, long_cb);
+    }
+
+    // Run MAP DEC #1
+    map_batch_dec(q, q->syst, q->n_iter ? q->app1 : NULL, q->parity0, q->ext1, long_cb);
+  } else {
+    // Convert aposteriori information into extrinsic information
+    if (q->n_iter > 1) {
+      vec_batch_sub(q->ext1, q->app1, q->ext1, long_cb);
+    }
+
+    // Interleave extrinsic output of DEC1 to form apriori info for decoder 2
+    vec_batch_lut(q->ext1, q->interleaver.reverse, q->app2, long_cb);
+
+    // Run MAP DEC #2. 2nd decoder uses apriori information as systematic bits
+    map_batch_dec(q, q->app2, NULL, q->parity1, q->ext2, long_cb);
+
+    // Deinterleaved extrinsic bits become apriori info for decoder 1
+    vec_batch_lut(q->ext2, q->interleaver.forward, q->app1, long_cb);
+  }
+
+  q->n_iter++;
+#endif /* SRSRAN_SIMD_S_SIZE */
+}
+
+void srsran_tdec_batch_decision_byte(srsran_tdec_batch_t* q, uint8_t** output)
+{
+#if SRSRAN_SIMD_S_SIZE
+  if (q == NULL || output == NULL) {
+    return;
+  }
+
+  int16_t* app = !(q->n_iter % 2) ? q->app1 : q->ext1;
+  uint32_t L   = SRSRAN_SIMD_S_SIZE;
+  int16_t  bytes[SRSRAN_SIMD_S_SIZE];
+
+  simd_s_t zero = srsran_simd_s_zero();
+  simd_s_t one  = srsran_simd_s_set1(1);
+
+  // long_cb is always byte aligned
+  for (uint32_t i = 0; i < q->current_long_cb / 8; i++) {
+    simd_s_t acc = zero;
+    for (uint32_t j = 0; j < 8; j++) {
+      // Saturate each LLR to {0, 1} and weight it with its bit position, MSB first
+      simd_s_t a   = srsran_simd_s_load(&app[(8 * i + j) * L]);
+      simd_s_t bit = srsran_simd_s_min(srsran_simd_s_max(a, zero), one);
+      acc          = srsran_simd_s_add(acc, srsran_simd_s_mul(bit, srsran_simd_s_set1(0x80 >> j)));
+    }
+    srsran_simd_s_storeu(bytes, acc);
+
+    for (uint32_t l = 0; l < q->current_nof_cb; l++) {
+      if (output[l]) {
+        output[l][i] = (uint8_t)bytes[l];
+      }
+    }
+  }
+#endif /* SRSRAN_SIMD_S_SIZE */
+}
+
+int srsran_tdec_batch_run_all(srsran_tdec_batch_t* q,
+                              int16_t**            input,
+                              uint8_t**            output,
+                              uint32_t             nof_cb,
+                              uint32_t             nof_iterations,
+                              uint32_t             long_cb)
+{
+  if (output == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (srsran_tdec_batch_new_cb(q, input, nof_cb, long_cb)) {
+    return SRSRAN_ERROR;
+  }
+
+  do {
+    srsran_tdec_batch_iteration(q);
+  } while (q->n_iter < nof_iterations);
+
+  srsran_tdec_batch_decision_byte(q, output);
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_tdec_batch_get_nof_iterations(srsran_tdec_batch_t* q)
+{
+  return q ? q->n_iter : 0;
+}
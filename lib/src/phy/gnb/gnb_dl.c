@@ -27,6 +27,15 @@ static float gnb_dl_get_norm_factor(uint32_t nof_prb)
   return 0.05f / sqrtf(nof_prb);
 }
 
+static srsran_pdsch_nr_t* gnb_dl_pdsch_enc(const srsran_gnb_dl_t* q, uint32_t enc_idx)
+{
+  if (enc_idx >= q->nof_pdsch_enc) {
+    ERROR("Invalid PDSCH encoder index (%d), %d encoders", enc_idx, q->nof_pdsch_enc);
+    return NULL;
+  }
+  return enc_idx == 0 ? (srsran_pdsch_nr_t*)&q->pdsch : &q->pdsch_enc[enc_idx - 1];
+}
+
 static int gnb_dl_alloc_prb(srsran_gnb_dl_t* q, uint32_t new_nof_prb)
 {
   if (q->max_prb < new_nof_prb) {
@@ -65,6 +74,22 @@ int srsran_gnb_dl_init(srsran_gnb_dl_t* q, cf_t* output[SRSRAN_MAX_PORTS], const
     return SRSRAN_ERROR;
   }
 
+  // Every additional encoder has its own codeword, symbol and LDPC buffers, so that PDSCH can be encoded in parallel
+  q->nof_pdsch_enc = SRSRAN_MAX(args->nof_pdsch_encoders, 1);
+  if (q->nof_pdsch_enc > 1) {
+    q->pdsch_enc = SRSRAN_MEM_ALLOC(srsran_pdsch_nr_t, q->nof_pdsch_enc - 1);
+    if (q->pdsch_enc == NULL) {
+      ERROR("Malloc");
+      return SRSRAN_ERROR;
+    }
+    SRSRAN_MEM_ZERO(q->pdsch_enc, srsran_pdsch_nr_t, q->nof_pdsch_enc - 1);
+    for (uint32_t i = 0; i < q->nof_pdsch_enc - 1; i++) {
+      if (srsran_pdsch_nr_init_enb(&q->pdsch_enc[i], &args->pdsch) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
   if (gnb_dl_alloc_prb(q, args->nof_max_prb) < SRSRAN_SUCCESS) {
     ERROR("Error allocating");
     return SRSRAN_ERROR;
@@ -130,6 +155,12 @@ void srsran_gnb_dl_free(srsran_gnb_dl_t* q)
   }
 
   srsran_pdsch_nr_free(&q->pdsch);
+  if (q->pdsch_enc != NULL) {
+    for (uint32_t i = 0; i < q->nof_pdsch_enc - 1; i++) {
+      srsran_pdsch_nr_free(&q->pdsch_enc[i]);
+    }
+    free(q->pdsch_enc);
+  }
   srsran_dmrs_sch_free(&q->dmrs);
 
   srsran_pdcch_nr_free(&q->pdcch);
@@ -140,8 +171,10 @@ void srsran_gnb_dl_free(srsran_gnb_dl_t* q)
 
 int srsran_gnb_dl_set_carrier(srsran_gnb_dl_t* q, const srsran_carrier_nr_t* carrier)
 {
-  if (srsran_pdsch_nr_set_carrier(&q->pdsch, carrier) < SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
+  for (uint32_t i = 0; i < q->nof_pdsch_enc; i++) {
+    if (srsran_pdsch_nr_set_carrier(gnb_dl_pdsch_enc(q, i), carrier) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
   }
 
   if (srsran_dmrs_sch_set_carrier(&q->dmrs, carrier) < SRSRAN_SUCCESS) {
@@ -333,11 +366,41 @@ int srsran_gnb_dl_pdsch_put(srsran_gnb_dl_t*           q,
                             const srsran_sch_cfg_nr_t* cfg,
                             uint8_t*                   data[SRSRAN_MAX_TB])
 {
+  if (srsran_gnb_dl_pdsch_put_dmrs(q, slot, cfg) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  return srsran_gnb_dl_pdsch_encode(q, 0, cfg, data);
+}
+
+int srsran_gnb_dl_pdsch_put_dmrs(srsran_gnb_dl_t* q, const srsran_slot_cfg_t* slot, const srsran_sch_cfg_nr_t* cfg)
+{
+  if (q == NULL || slot == NULL || cfg == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
   if (srsran_dmrs_sch_put_sf(&q->dmrs, slot, cfg, &cfg->grant, q->sf_symbols[0]) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
-  if (srsran_pdsch_nr_encode(&q->pdsch, cfg, &cfg->grant, data, q->sf_symbols) < SRSRAN_SUCCESS) {
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_gnb_dl_pdsch_encode(srsran_gnb_dl_t*           q,
+                               uint32_t                   enc_idx,
+                               const srsran_sch_cfg_nr_t* cfg,
+                               uint8_t*                   data[SRSRAN_MAX_TB])
+{
+  if (q == NULL || cfg == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  srsran_pdsch_nr_t* pdsch = gnb_dl_pdsch_enc(q, enc_idx);
+  if (pdsch == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_pdsch_nr_encode(pdsch, cfg, &cfg->grant, data, q->sf_symbols) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
@@ -354,6 +417,20 @@ int srsran_gnb_dl_pdsch_info(const srsran_gnb_dl_t* q, const srsran_sch_cfg_nr_t
   return len;
 }
 
+int srsran_gnb_dl_pdsch_enc_info(const srsran_gnb_dl_t*     q,
+                                 uint32_t                   enc_idx,
+                                 const srsran_sch_cfg_nr_t* cfg,
+                                 char*                      str,
+                                 uint32_t                   str_len)
+{
+  const srsran_pdsch_nr_t* pdsch = gnb_dl_pdsch_enc(q, enc_idx);
+  if (pdsch == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  return srsran_pdsch_nr_tx_info(pdsch, cfg, &cfg->grant, str, str_len);
+}
+
 int srsran_gnb_dl_pdcch_dl_info(const srsran_gnb_dl_t* q, const srsran_dci_dl_nr_t* dci, char* str, uint32_t str_len)
 {
   int len = 0;
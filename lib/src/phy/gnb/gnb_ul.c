@@ -85,6 +85,10 @@ int srsran_gnb_ul_init(srsran_gnb_ul_t* q, cf_t* input, const srsran_gnb_ul_args
     return SRSRAN_ERROR;
   }
 
+  if (srsran_dmrs_sch_set_wiener(&q->dmrs, args->pusch_wiener) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   srsran_ofdm_cfg_t ofdm_cfg = {};
   ofdm_cfg.nof_prb           = args->nof_max_prb;
   ofdm_cfg.in_buffer         = input;
@@ -391,6 +391,54 @@ int srsran_predecoding_single(cf_t*  y_,
 #endif
 }
 
+/* ZF/MMSE SISO equalizer x=y(h'h+no)^(-1)h' (ZF if n0=0.0) for split complex inputs */
+int srsran_predecoding_single_split(const float* y_re,
+                                    const float* y_im,
+                                    const float* h_re,
+                                    const float* h_im,
+                                    cf_t*        x,
+                                    float*       csi,
+                                    int          nof_symbols,
+                                    float        scaling,
+                                    float        noise_estimate)
+{
+  int i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  const simd_f_t _noise   = srsran_simd_f_set1(noise_estimate);
+  const simd_f_t _scaling = srsran_simd_f_set1(1.0f / scaling);
+
+  for (; i < nof_symbols - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t _y = srsran_simd_cf_loadu(&y_re[i], &y_im[i]);
+    simd_cf_t _h = srsran_simd_cf_loadu(&h_re[i], &h_im[i]);
+
+    simd_f_t _hre = srsran_simd_cf_re(_h);
+    simd_f_t _him = srsran_simd_cf_im(_h);
+    simd_f_t _hh  = srsran_simd_f_add(srsran_simd_f_mul(_hre, _hre), srsran_simd_f_mul(_him, _him));
+
+    simd_f_t  _csi  = srsran_simd_f_add(_hh, _noise);
+    simd_f_t  _norm = srsran_simd_f_mul(_scaling, srsran_simd_f_rcp(_csi));
+    simd_cf_t _x    = srsran_simd_cf_mul(srsran_simd_cf_conjprod(_y, _h), _norm);
+
+    if (csi) {
+      srsran_simd_f_storeu(&csi[i], _csi);
+    }
+    srsran_simd_cfi_storeu_ordered(&x[i], _x);
+  }
+#endif
+
+  for (; i < nof_symbols; i++) {
+    cf_t  y  = y_re[i] + _Complex_I * y_im[i];
+    cf_t  h  = h_re[i] + _Complex_I * h_im[i];
+    float hh = h_re[i] * h_re[i] + h_im[i] * h_im[i] + noise_estimate;
+    if (csi) {
+      csi[i] = hh;
+    }
+    x[i] = y * conjf(h) / (hh * scaling);
+  }
+  return nof_symbols;
+}
+
 /* ZF/MMSE SISO equalizer x=y(h'h+no)^(-1)h' (ZF if n0=0.0)*/
 int srsran_predecoding_single_multi(cf_t*  y[SRSRAN_MAX_PORTS],
                                     cf_t*  h[SRSRAN_MAX_PORTS],
@@ -1862,6 +1910,215 @@ void srsran_predecoding_set_mimo_decoder(srsran_mimo_decoder_t _mimo_decoder)
   mimo_decoder = _mimo_decoder;
 }
 
+#if SRSRAN_SIMD_CF_SIZE != 0
+// Reciprocal refined with one Newton-Raphson iteration, the LDL' recursion accumulates the estimate error
+static inline simd_f_t predecoding_mmse_rcp_simd(simd_f_t a)
+{
+  simd_f_t r = srsran_simd_f_rcp(a);
+  return srsran_simd_f_mul(r, srsran_simd_f_sub(srsran_simd_f_set1(2.0f), srsran_simd_f_mul(a, r)));
+}
+
+static void predecoding_mmse_simd(cf_t*  y[SRSRAN_MAX_PORTS],
+                                  cf_t*  h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                                  cf_t*  x[SRSRAN_MAX_LAYERS],
+                                  float* csi[SRSRAN_MAX_LAYERS],
+                                  int    nof_rxant,
+                                  int    nof_layers,
+                                  int    i,
+                                  float  norm,
+                                  float  noise_estimate)
+{
+  simd_cf_t hv[SRSRAN_MAX_LAYERS][SRSRAN_MAX_PORTS];
+  simd_cf_t yv[SRSRAN_MAX_PORTS];
+  simd_cf_t l[SRSRAN_MAX_LAYERS][SRSRAN_MAX_LAYERS];
+  simd_f_t  d_rcp[SRSRAN_MAX_LAYERS];
+  simd_cf_t u[SRSRAN_MAX_LAYERS];
+
+  for (int r = 0; r < nof_rxant; r++) {
+    yv[r] = srsran_simd_cfi_loadu(&y[r][i]);
+    for (int j = 0; j < nof_layers; j++) {
+      hv[j][r] = srsran_simd_cfi_loadu(&h[j][r][i]);
+    }
+  }
+
+  for (int j = 0; j < nof_layers; j++) {
+    // 1. Row j of A = H' x H + No, and z = H' x Y
+    simd_f_t d = srsran_simd_f_set1(noise_estimate);
+    u[j]       = srsran_simd_cf_zero();
+    for (int k = 0; k < j; k++) {
+      l[j][k] = srsran_simd_cf_zero();
+    }
+    for (int r = 0; r < nof_rxant; r++) {
+      d    = srsran_simd_f_add(d, srsran_simd_cf_re(srsran_simd_cf_conjprod(hv[j][r], hv[j][r])));
+      u[j] = srsran_simd_cf_add(u[j], srsran_simd_cf_conjprod(yv[r], hv[j][r]));
+      for (int k = 0; k < j; k++) {
+        l[j][k] = srsran_simd_cf_add(l[j][k], srsran_simd_cf_conjprod(hv[k][r], hv[j][r]));
+      }
+    }
+
+    // 2. LDL' factorization, row j of L and D from the previous rows
+    for (int k = 0; k < j; k++) {
+      for (int m = 0; m < k; m++) {
+        l[j][k] = srsran_simd_cf_sub(l[j][k], srsran_simd_cf_conjprod(l[j][m], l[k][m]));
+      }
+      // l[j][k] holds L(j,k) * D(k) until here, the unscaled value is used by the next columns
+    }
+    for (int k = 0; k < j; k++) {
+      simd_cf_t ldl = l[j][k];
+      l[j][k]       = srsran_simd_cf_mul(ldl, d_rcp[k]);
+      d             = srsran_simd_f_sub(d, srsran_simd_cf_re(srsran_simd_cf_conjprod(ldl, l[j][k])));
+    }
+    d_rcp[j] = predecoding_mmse_rcp_simd(d);
+
+    // 3. Forward substitution L x U = Z
+    for (int k = 0; k < j; k++) {
+      u[j] = srsran_simd_cf_sub(u[j], srsran_simd_cf_prod(l[j][k], u[k]));
+    }
+  }
+
+  // 4. Backward substitution D x L' x X = U
+  for (int j = nof_layers - 1; j >= 0; j--) {
+    simd_cf_t xj = srsran_simd_cf_mul(u[j], d_rcp[j]);
+    for (int k = j + 1; k < nof_layers; k++) {
+      xj = srsran_simd_cf_sub(xj, srsran_simd_cf_conjprod(u[k], l[k][j]));
+    }
+    u[j] = xj;
+    srsran_simd_cfi_storeu(&x[j][i], srsran_simd_cf_mul(xj, srsran_simd_f_set1(norm)));
+  }
+
+  // 5. CSI from the diagonal of inv(A) = inv(L)' x inv(D) x inv(L)
+  if (csi != NULL) {
+    for (int j = 0; j < nof_layers; j++) {
+      simd_cf_t m[SRSRAN_MAX_LAYERS];
+      simd_f_t  b = d_rcp[j];
+      m[j]        = srsran_simd_cf_set1(1.0f);
+      for (int k = j + 1; k < nof_layers; k++) {
+        m[k] = srsran_simd_cf_zero();
+        for (int n = j; n < k; n++) {
+          m[k] = srsran_simd_cf_sub(m[k], srsran_simd_cf_prod(l[k][n], m[n]));
+        }
+        b = srsran_simd_f_add(b, srsran_simd_f_mul(srsran_simd_cf_re(srsran_simd_cf_conjprod(m[k], m[k])), d_rcp[k]));
+      }
+      srsran_simd_f_storeu(&csi[j][i], srsran_simd_f_rcp(srsran_simd_f_mul(b, srsran_simd_f_set1(norm))));
+    }
+  }
+}
+#endif /* SRSRAN_SIMD_CF_SIZE != 0 */
+
+static void predecoding_mmse_gen(cf_t*  y[SRSRAN_MAX_PORTS],
+                                 cf_t*  h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                                 cf_t*  x[SRSRAN_MAX_LAYERS],
+                                 float* csi[SRSRAN_MAX_LAYERS],
+                                 int    nof_rxant,
+                                 int    nof_layers,
+                                 int    i,
+                                 float  norm,
+                                 float  noise_estimate)
+{
+  cf_t  l[SRSRAN_MAX_LAYERS][SRSRAN_MAX_LAYERS];
+  float d_rcp[SRSRAN_MAX_LAYERS];
+  cf_t  u[SRSRAN_MAX_LAYERS];
+
+  for (int j = 0; j < nof_layers; j++) {
+    // 1. Row j of A = H' x H + No, and z = H' x Y
+    float d = noise_estimate;
+    u[j]    = 0.0f;
+    for (int k = 0; k < j; k++) {
+      l[j][k] = 0.0f;
+    }
+    for (int r = 0; r < nof_rxant; r++) {
+      cf_t hjr = h[j][r][i];
+      d += crealf(hjr) * crealf(hjr) + cimagf(hjr) * cimagf(hjr);
+      u[j] += conjf(hjr) * y[r][i];
+      for (int k = 0; k < j; k++) {
+        l[j][k] += conjf(hjr) * h[k][r][i];
+      }
+    }
+
+    // 2. LDL' factorization, row j of L and D from the previous rows
+    for (int k = 0; k < j; k++) {
+      for (int m = 0; m < k; m++) {
+        l[j][k] -= l[j][m] * conjf(l[k][m]);
+      }
+    }
+    for (int k = 0; k < j; k++) {
+      cf_t ldl = l[j][k];
+      l[j][k]  = ldl * d_rcp[k];
+      d -= crealf(ldl * conjf(l[j][k]));
+    }
+    d_rcp[j] = 1.0f / d;
+
+    // 3. Forward substitution L x U = Z
+    for (int k = 0; k < j; k++) {
+      u[j] -= l[j][k] * u[k];
+    }
+  }
+
+  // 4. Backward substitution D x L' x X = U
+  for (int j = nof_layers - 1; j >= 0; j--) {
+    cf_t xj = u[j] * d_rcp[j];
+    for (int k = j + 1; k < nof_layers; k++) {
+      xj -= conjf(l[k][j]) * u[k];
+    }
+    u[j]    = xj;
+    x[j][i] = xj * norm;
+  }
+
+  // 5. CSI from the diagonal of inv(A) = inv(L)' x inv(D) x inv(L)
+  if (csi != NULL) {
+    for (int j = 0; j < nof_layers; j++) {
+      cf_t  m[SRSRAN_MAX_LAYERS];
+      float b = d_rcp[j];
+      m[j]    = 1.0f;
+      for (int k = j + 1; k < nof_layers; k++) {
+        m[k] = 0.0f;
+        for (int n = j; n < k; n++) {
+          m[k] -= l[k][n] * m[n];
+        }
+        b += (crealf(m[k]) * crealf(m[k]) + cimagf(m[k]) * cimagf(m[k])) * d_rcp[k];
+      }
+      csi[j][i] = 1.0f / (b * norm);
+    }
+  }
+}
+
+int srsran_predecoding_mmse(cf_t*  y[SRSRAN_MAX_PORTS],
+                            cf_t*  h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                            cf_t*  x[SRSRAN_MAX_LAYERS],
+                            float* csi[SRSRAN_MAX_LAYERS],
+                            int    nof_rxant,
+                            int    nof_layers,
+                            int    nof_symbols,
+                            float  scaling,
+                            float  noise_estimate)
+{
+  if (nof_rxant < 1 || nof_rxant > SRSRAN_MAX_PORTS || nof_layers < 1 || nof_layers > SRSRAN_MAX_LAYERS ||
+      nof_layers > nof_rxant) {
+    ERROR("Invalid MMSE equalizer nof_layers=%d nof_rxant=%d", nof_layers, nof_rxant);
+    return SRSRAN_ERROR;
+  }
+
+  // A null first pointer disables the CSI, as in the other equalizers
+  if (csi != NULL && csi[0] == NULL) {
+    csi = NULL;
+  }
+
+  float norm = 1.0f / scaling;
+  int   i    = 0;
+
+#if SRSRAN_SIMD_CF_SIZE != 0
+  for (; i < nof_symbols - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+    predecoding_mmse_simd(y, h, x, csi, nof_rxant, nof_layers, i, norm, noise_estimate);
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE != 0 */
+
+  for (; i < nof_symbols; i++) {
+    predecoding_mmse_gen(y, h, x, csi, nof_rxant, nof_layers, i, norm, noise_estimate);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 /* 36.211 v10.3.0 Section 6.3.4 */
 int srsran_predecoding_type(cf_t*              y[SRSRAN_MAX_PORTS],
                             cf_t*              h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
@@ -2255,6 +2512,194 @@ int srsran_precoding_type(cf_t*              x[SRSRAN_MAX_LAYERS],
   return SRSRAN_ERROR;
 }
 
+int srsran_precoding_diversity_cw(cf_t* d, cf_t* y[SRSRAN_MAX_PORTS], int nof_ports, int nof_symbols, float scaling)
+{
+  int i = 0;
+  if (nof_ports == 2) {
+    // Layer 0 takes the even symbols and layer 1 the odd ones, so port 0 is the scaled codeword and port 1 the
+    // swapped and conjugated pairs
+    float norm = scaling * M_SQRT1_2;
+    int   n    = 2 * (nof_symbols / 2);
+#ifdef LV_HAVE_AVX
+    __m256 norm_avx = _mm256_set1_ps(norm);
+    __m256 sign_avx = _mm256_setr_ps(-0.0f, +0.0f, +0.0f, -0.0f, -0.0f, +0.0f, +0.0f, -0.0f);
+    for (; i < n - 3; i += 4) {
+      __m256 d0 = _mm256_loadu_ps((float*)&d[i]);
+      __m256 d1 = _mm256_xor_ps(_mm256_permute_ps(d0, 0b01001110), sign_avx);
+
+      _mm256_storeu_ps((float*)&y[0][i], _mm256_mul_ps(norm_avx, d0));
+      _mm256_storeu_ps((float*)&y[1][i], _mm256_mul_ps(norm_avx, d1));
+    }
+#endif /* LV_HAVE_AVX */
+
+#ifdef LV_HAVE_SSE
+    __m128 norm_sse = _mm_set1_ps(norm);
+    __m128 sign_sse = _mm_setr_ps(-0.0f, +0.0f, +0.0f, -0.0f);
+    for (; i < n - 1; i += 2) {
+      __m128 d0 = _mm_loadu_ps((float*)&d[i]);
+      __m128 d1 = _mm_xor_ps(_mm_shuffle_ps(d0, d0, _MM_SHUFFLE(1, 0, 3, 2)), sign_sse);
+
+      _mm_storeu_ps((float*)&y[0][i], _mm_mul_ps(norm_sse, d0));
+      _mm_storeu_ps((float*)&y[1][i], _mm_mul_ps(norm_sse, d1));
+    }
+#endif /* LV_HAVE_SSE */
+
+    for (; i < n; i += 2) {
+      cf_t d0 = d[i];
+      cf_t d1 = d[i + 1];
+
+      y[0][i]     = d0 * norm;
+      y[1][i]     = -conjf(d1) * norm;
+      y[0][i + 1] = d1 * norm;
+      y[1][i + 1] = conjf(d0) * norm;
+    }
+    return n;
+  } else if (nof_ports == 4) {
+    scaling /= M_SQRT2;
+
+    for (i = 0; i < nof_symbols / 4; i++) {
+      cf_t d0 = d[4 * i];
+      cf_t d1 = d[4 * i + 1];
+      cf_t d2 = d[4 * i + 2];
+      cf_t d3 = d[4 * i + 3];
+
+      y[0][4 * i] = d0 * scaling;
+      y[1][4 * i] = 0;
+      y[2][4 * i] = -conjf(d1) * scaling;
+      y[3][4 * i] = 0;
+
+      y[0][4 * i + 1] = d1 * scaling;
+      y[1][4 * i + 1] = 0;
+      y[2][4 * i + 1] = conjf(d0) * scaling;
+      y[3][4 * i + 1] = 0;
+
+      y[0][4 * i + 2] = 0;
+      y[1][4 * i + 2] = d2 * scaling;
+      y[2][4 * i + 2] = 0;
+      y[3][4 * i + 2] = -conjf(d3) * scaling;
+
+      y[0][4 * i + 3] = 0;
+      y[1][4 * i + 3] = d3 * scaling;
+      y[2][4 * i + 3] = 0;
+      y[3][4 * i + 3] = conjf(d2) * scaling;
+    }
+    return 4 * i;
+  } else {
+    ERROR("Number of ports must be 2 or 4 for transmit diversity (nof_ports=%d)", nof_ports);
+    return -1;
+  }
+}
+
+/* One codeword mapped onto two layers and precoded for two ports, the layers are read from the even and odd codeword
+ * symbols */
+static int precoding_cw_2x2(cf_t*              d,
+                            cf_t*              y[SRSRAN_MAX_PORTS],
+                            int                codebook_idx,
+                            int                nof_symbols,
+                            float              scaling,
+                            srsran_tx_scheme_t type)
+{
+  int n = nof_symbols / 2;
+
+  if (type == SRSRAN_TXSCHEME_CDD) {
+    scaling /= 2.0f;
+    for (int i = 0; i < n; i++) {
+      cf_t x0 = d[2 * i];
+      cf_t x1 = d[2 * i + 1];
+
+      y[0][i] = (x0 + x1) * scaling;
+      y[1][i] = ((i % 2) ? (x1 - x0) : (x0 - x1)) * scaling;
+    }
+    return 2 * n;
+  }
+
+  switch (codebook_idx) {
+    case 0:
+      scaling *= M_SQRT1_2;
+      for (int i = 0; i < n; i++) {
+        y[0][i] = d[2 * i] * scaling;
+        y[1][i] = d[2 * i + 1] * scaling;
+      }
+      break;
+    case 1:
+      scaling /= 2.0f;
+      for (int i = 0; i < n; i++) {
+        cf_t x0 = d[2 * i];
+        cf_t x1 = d[2 * i + 1];
+
+        y[0][i] = (x0 + x1) * scaling;
+        y[1][i] = (x0 - x1) * scaling;
+      }
+      break;
+    case 2:
+      scaling /= 2.0f;
+      for (int i = 0; i < n; i++) {
+        cf_t x0 = d[2 * i];
+        cf_t x1 = d[2 * i + 1];
+
+        y[0][i] = (x0 + x1) * scaling;
+        y[1][i] = (_Complex_I * (x0 - x1)) * scaling;
+      }
+      break;
+    default:
+      ERROR("Invalid multiplex combination: codebook_idx=%d, nof_layers=2, nof_ports=2", codebook_idx);
+      return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_precoding_cw_type(cf_t*              d[SRSRAN_MAX_CODEWORDS],
+                             cf_t*              y[SRSRAN_MAX_PORTS],
+                             int                nof_cw,
+                             int                nof_layers,
+                             int                nof_ports,
+                             int                codebook_idx,
+                             int                nof_symbols,
+                             float              scaling,
+                             srsran_tx_scheme_t type)
+{
+  if (nof_cw < 1 || nof_cw > SRSRAN_MAX_CODEWORDS) {
+    ERROR("Invalid number of codewords (nof_cw=%d)", nof_cw);
+    return -1;
+  }
+  if (nof_layers < nof_cw) {
+    ERROR("Number of codewords must be lower or equal than number of layers");
+    return -1;
+  }
+
+  // Each codeword is a layer
+  if (nof_layers == nof_cw) {
+    cf_t* x[SRSRAN_MAX_LAYERS] = {};
+    for (int i = 0; i < nof_cw; i++) {
+      x[i] = d[i];
+    }
+    return srsran_precoding_type(x, y, nof_layers, nof_ports, codebook_idx, nof_symbols, scaling, type);
+  }
+
+  switch (type) {
+    case SRSRAN_TXSCHEME_DIVERSITY:
+      if (nof_cw == 1 && nof_layers == nof_ports) {
+        return srsran_precoding_diversity_cw(d[0], y, nof_ports, nof_symbols, scaling);
+      }
+      break;
+    case SRSRAN_TXSCHEME_CDD:
+    case SRSRAN_TXSCHEME_SPATIALMUX:
+      if (nof_cw == 1 && nof_layers == 2 && nof_ports == 2) {
+        return precoding_cw_2x2(d[0], y, codebook_idx, nof_symbols, scaling, type);
+      }
+      break;
+    default:
+      break;
+  }
+
+  ERROR("Not implemented (nof_cw=%d, nof_layers=%d, nof_ports=%d, type=%s)",
+        nof_cw,
+        nof_layers,
+        nof_ports,
+        srsran_mimotype2str(type));
+  return SRSRAN_ERROR;
+}
+
 #define PMI_SEL_PRECISION 24
 
 /* PMI Select for 1 layer */
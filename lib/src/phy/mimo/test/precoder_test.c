@@ -41,6 +41,8 @@ char*                  mimo_type_name        = NULL;
 char                   decoder_type_name[17] = "zf";
 float                  snr_db                = 100.0f;
 float                  scaling               = 0.1f;
+bool                   split                 = false;
+bool                   effective             = false;
 static srsran_random_t random_gen            = NULL;
 
 void usage(char* prog)
@@ -57,6 +59,9 @@ void usage(char* prog)
   printf("\t-s SNR in dB [Default %.1fdB]*\n", snr_db);
   printf("\t-g Scaling [Default %.1f]*\n", scaling);
   printf("\t-d decoder type [zf|mmse] [Default %s]\n", decoder_type_name);
+  printf("\t-S use split complex equalizer, single antenna only [Default %s]\n", split ? "yes" : "no");
+  printf("\t-E map the layers to the ports without precoding and use the up to 4x4 MMSE equalizer [Default %s]\n",
+         effective ? "yes" : "no");
   printf("\n");
   printf("* Performance test example:\n\t for snr in {0..20..1}; do ./precoding_test -m single -s $snr; done; \n\n");
 }
@@ -64,7 +69,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "mplnrcdsg")) != -1) {
+  while ((opt = getopt(argc, argv, "mplnrcdsgSE")) != -1) {
     switch (opt) {
       case 'n':
         nof_symbols = (int)strtol(argv[optind], NULL, 10);
@@ -94,6 +99,12 @@ void parse_args(int argc, char** argv)
       case 'g':
         scaling = strtof(argv[optind], NULL);
         break;
+      case 'S':
+        split = true;
+        break;
+      case 'E':
+        effective = true;
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -199,6 +210,10 @@ int main(int argc, char** argv)
       break;
     case SRSRAN_TXSCHEME_SPATIALMUX:
       nof_re = nof_symbols;
+      if (effective && nof_tx_ports != nof_layers) {
+        ERROR("Effective channel requires nof_tx_ports=%d equal to nof_layers=%d", nof_tx_ports, nof_layers);
+        exit(-1);
+      }
       break;
     case SRSRAN_TXSCHEME_CDD:
       nof_re = nof_symbols * nof_tx_ports / nof_layers;
@@ -267,7 +282,11 @@ int main(int argc, char** argv)
   }
 
   /* Execute Precoding (Tx) */
-  if (srsran_precoding_type(x, y, nof_layers, nof_tx_ports, codebook_idx, nof_symbols, scaling, type) < 0) {
+  if (effective) {
+    for (i = 0; i < nof_layers; i++) {
+      srsran_vec_sc_prod_cfc(x[i], scaling, y[i], nof_symbols);
+    }
+  } else if (srsran_precoding_type(x, y, nof_layers, nof_tx_ports, codebook_idx, nof_symbols, scaling, type) < 0) {
     ERROR("Error layer mapper encoder");
     exit(-1);
   }
@@ -301,19 +320,50 @@ int main(int argc, char** argv)
   /* predecoding / equalization */
   struct timeval t[3];
   gettimeofday(&t[1], NULL);
-  srsran_predecoding_type(r,
-                          h,
-                          xr,
-                          NULL,
-                          nof_rx_ports,
-                          nof_tx_ports,
-                          nof_layers,
-                          codebook_idx,
-                          nof_re,
-                          type,
-                          scaling,
-                          srsran_convert_dB_to_power(-snr_db));
-  gettimeofday(&t[2], NULL);
+  if (split) {
+    if (type != SRSRAN_TXSCHEME_PORT0 || nof_rx_ports != 1) {
+      ERROR("Split complex equalizer is only supported for single antenna");
+      ret = SRSRAN_ERROR;
+      goto quit;
+    }
+
+    float* split_buf = srsran_vec_f_malloc(4 * nof_re);
+    if (!split_buf) {
+      perror("srsran_vec_f_malloc");
+      ret = SRSRAN_ERROR;
+      goto quit;
+    }
+    float* r_re = split_buf;
+    float* r_im = r_re + nof_re;
+    float* h_re = r_im + nof_re;
+    float* h_im = h_re + nof_re;
+    srsran_vec_cf_to_split(r[0], r_re, r_im, nof_re);
+    srsran_vec_cf_to_split(h[0][0], h_re, h_im, nof_re);
+
+    gettimeofday(&t[1], NULL);
+    srsran_predecoding_single_split(
+        r_re, r_im, h_re, h_im, xr[0], NULL, nof_re, scaling, srsran_convert_dB_to_power(-snr_db));
+    gettimeofday(&t[2], NULL);
+    free(split_buf);
+  } else if (effective) {
+    srsran_predecoding_mmse(
+        r, h, xr, NULL, nof_rx_ports, nof_layers, nof_re, scaling, srsran_convert_dB_to_power(-snr_db));
+    gettimeofday(&t[2], NULL);
+  } else {
+    srsran_predecoding_type(r,
+                            h,
+                            xr,
+                            NULL,
+                            nof_rx_ports,
+                            nof_tx_ports,
+                            nof_layers,
+                            codebook_idx,
+                            nof_re,
+                            type,
+                            scaling,
+                            srsran_convert_dB_to_power(-snr_db));
+    gettimeofday(&t[2], NULL);
+  }
   get_time_interval(t);
 
   /* check errors */
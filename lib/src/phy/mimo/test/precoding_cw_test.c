@@ -0,0 +1,148 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+#include "srsran/support/srsran_test.h"
+
+#define MAX_NOF_SYMBOLS 1206
+
+static srsran_random_t random_gen = NULL;
+
+static cf_t* d[SRSRAN_MAX_CODEWORDS];
+static cf_t* x[SRSRAN_MAX_LAYERS];
+static cf_t* y_ref[SRSRAN_MAX_PORTS];
+static cf_t* y[SRSRAN_MAX_PORTS];
+
+// The fused layer mapping and precoding generates the same port symbols as the layer mapper followed by the precoder
+static int test_case(srsran_tx_scheme_t type, int nof_cw, int nof_layers, int nof_ports, int codebook_idx, int n)
+{
+  for (int i = 0; i < nof_cw; i++) {
+    srsran_random_uniform_complex_dist_vector(random_gen, d[i], n, -1.0f, +1.0f);
+  }
+  for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    srsran_vec_cf_zero(y_ref[i], MAX_NOF_SYMBOLS);
+    srsran_vec_cf_zero(y[i], MAX_NOF_SYMBOLS);
+  }
+
+  // Reference, the layer mapping is skipped if each codeword is a layer
+  cf_t* layers[SRSRAN_MAX_LAYERS] = {d[0], d[1]};
+  int   nof_layer_symbols         = n;
+  if (nof_cw != nof_layers) {
+    nof_layer_symbols = srsran_layermap_type(d, x, nof_cw, nof_layers, (int[SRSRAN_MAX_CODEWORDS]){n, n}, type);
+    TESTASSERT(nof_layer_symbols > 0);
+    for (int i = 0; i < SRSRAN_MAX_LAYERS; i++) {
+      layers[i] = x[i];
+    }
+  }
+  float scaling = 0.7f;
+  TESTASSERT(srsran_precoding_type(layers,
+                                   y_ref,
+                                   nof_layers,
+                                   nof_ports,
+                                   codebook_idx,
+                                   nof_layer_symbols,
+                                   scaling,
+                                   type) >= SRSRAN_SUCCESS);
+  TESTASSERT(srsran_precoding_cw_type(d, y, nof_cw, nof_layers, nof_ports, codebook_idx, n, scaling, type) >=
+             SRSRAN_SUCCESS);
+
+  for (int i = 0; i < nof_ports; i++) {
+    for (int j = 0; j < MAX_NOF_SYMBOLS; j++) {
+      if (crealf(y[i][j]) != crealf(y_ref[i][j]) || cimagf(y[i][j]) != cimagf(y_ref[i][j])) {
+        printf("Mismatch %s cw=%d layers=%d ports=%d cb=%d n=%d: y[%d][%d]=%+f%+fi, expected %+f%+fi\n",
+               srsran_mimotype2str(type),
+               nof_cw,
+               nof_layers,
+               nof_ports,
+               codebook_idx,
+               n,
+               i,
+               j,
+               crealf(y[i][j]),
+               cimagf(y[i][j]),
+               crealf(y_ref[i][j]),
+               cimagf(y_ref[i][j]));
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  random_gen = srsran_random_init(0x1234);
+  for (int i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+    d[i] = srsran_vec_cf_malloc(MAX_NOF_SYMBOLS);
+  }
+  for (int i = 0; i < SRSRAN_MAX_LAYERS; i++) {
+    x[i] = srsran_vec_cf_malloc(MAX_NOF_SYMBOLS);
+  }
+  for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    y_ref[i] = srsran_vec_cf_malloc(MAX_NOF_SYMBOLS);
+    y[i]     = srsran_vec_cf_malloc(MAX_NOF_SYMBOLS);
+  }
+
+  // Odd and non SIMD multiple lengths exercise the tails
+  int nof_symbols[] = {8, 1200, 1203, 1206};
+  for (uint32_t k = 0; k < sizeof(nof_symbols) / sizeof(nof_symbols[0]); k++) {
+    int n = nof_symbols[k];
+
+    TESTASSERT(test_case(SRSRAN_TXSCHEME_DIVERSITY, 1, 2, 2, 0, n) == SRSRAN_SUCCESS);
+    TESTASSERT(test_case(SRSRAN_TXSCHEME_DIVERSITY, 1, 4, 4, 0, n) == SRSRAN_SUCCESS);
+    for (int cb = 0; cb < 4; cb++) {
+      TESTASSERT(test_case(SRSRAN_TXSCHEME_SPATIALMUX, 1, 1, 2, cb, n) == SRSRAN_SUCCESS);
+    }
+    for (int cb = 0; cb < 3; cb++) {
+      TESTASSERT(test_case(SRSRAN_TXSCHEME_SPATIALMUX, 1, 2, 2, cb, n) == SRSRAN_SUCCESS);
+    }
+    for (int cb = 1; cb < 3; cb++) {
+      TESTASSERT(test_case(SRSRAN_TXSCHEME_SPATIALMUX, 2, 2, 2, cb, n) == SRSRAN_SUCCESS);
+    }
+
+    // The reference CDD precoder only processes multiples of 4 symbols per layer
+    if ((n / 2) % 4 == 0) {
+      TESTASSERT(test_case(SRSRAN_TXSCHEME_CDD, 1, 2, 2, 0, n) == SRSRAN_SUCCESS);
+      TESTASSERT(test_case(SRSRAN_TXSCHEME_CDD, 2, 2, 2, 0, n) == SRSRAN_SUCCESS);
+    }
+  }
+
+  // Layer mapping combinations that the precoder does not support
+  TESTASSERT(srsran_precoding_cw_type(d, y, 1, 2, 4, 0, 1200, 1.0f, SRSRAN_TXSCHEME_SPATIALMUX) < SRSRAN_SUCCESS);
+  TESTASSERT(srsran_precoding_cw_type(d, y, 1, 2, 4, 0, 1200, 1.0f, SRSRAN_TXSCHEME_DIVERSITY) < SRSRAN_SUCCESS);
+
+  for (int i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+    free(d[i]);
+  }
+  for (int i = 0; i < SRSRAN_MAX_LAYERS; i++) {
+    free(x[i]);
+  }
+  for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    free(y_ref[i]);
+    free(y[i]);
+  }
+  srsran_random_free(random_gen);
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
@@ -76,6 +76,10 @@
 void demod_16qam_lte_s_sse(const cf_t* symbols, short* llr, int nsymbols);
 #endif
 
+#if defined(LV_HAVE_AVX2) || defined(LV_HAVE_AVX512)
+#include <immintrin.h>
+#endif
+
 #define SCALE_SHORT_CONV_QPSK 100
 #define SCALE_SHORT_CONV_QAM16 400
 #define SCALE_SHORT_CONV_QAM64 700
@@ -777,7 +781,12 @@ void demod_64qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 #endif
 }
 
-void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
+/* 256QAM LLR of every symbol are the real and imaginary parts of four levels: the negated symbol followed by the
+ * absolute value of the previous level minus the thresholds 8, 4 and 2 (normalised by sqrt(170)). The SIMD kernels
+ * compute the four levels in separate registers and transpose them into the symbol order. They return the number of
+ * processed symbols and leave the remaining ones to the narrower kernels and finally to the generic implementation. */
+
+static void demod_256qam_lte_generic(const cf_t* symbols, float* llr, int nsymbols)
 {
   for (int i = 0; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
@@ -799,7 +808,7 @@ void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
   }
 }
 
-void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
+static void demod_256qam_lte_b_generic(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
   for (int i = 0; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
@@ -821,7 +830,7 @@ void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
   }
 }
 
-void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
+static void demod_256qam_lte_s_generic(const cf_t* symbols, short* llr, int nsymbols)
 {
   for (int i = 0; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
@@ -843,6 +852,491 @@ void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
   }
 }
 
+#ifdef LV_HAVE_SSE
+
+static int demod_256qam_lte_sse(const cf_t* symbols, float* llr, int nsymbols)
+{
+  const float* x    = (const float*)symbols;
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  const __m128 t1   = _mm_set1_ps(8.0f / sqrtf(170.0f));
+  const __m128 t2   = _mm_set1_ps(4.0f / sqrtf(170.0f));
+  const __m128 t3   = _mm_set1_ps(2.0f / sqrtf(170.0f));
+
+  int i = 0;
+  for (; i + 2 <= nsymbols; i += 2) {
+    __m128 l0 = _mm_xor_ps(_mm_loadu_ps(&x[2 * i]), sign);
+    __m128 l1 = _mm_sub_ps(_mm_andnot_ps(sign, l0), t1);
+    __m128 l2 = _mm_sub_ps(_mm_andnot_ps(sign, l1), t2);
+    __m128 l3 = _mm_sub_ps(_mm_andnot_ps(sign, l2), t3);
+
+    _mm_storeu_ps(&llr[8 * i + 0], _mm_movelh_ps(l0, l1));
+    _mm_storeu_ps(&llr[8 * i + 4], _mm_movelh_ps(l2, l3));
+    _mm_storeu_ps(&llr[8 * i + 8], _mm_movehl_ps(l1, l0));
+    _mm_storeu_ps(&llr[8 * i + 12], _mm_movehl_ps(l3, l2));
+  }
+  return i;
+}
+
+static int demod_256qam_lte_s_sse(const cf_t* symbols, int16_t* llr, int nsymbols)
+{
+  const float*  x     = (const float*)symbols;
+  const __m128  scale = _mm_set1_ps(-SCALE_SHORT_CONV_QAM256);
+  const __m128i min   = _mm_set1_epi16(-INT16_MAX);
+  const __m128i t1    = _mm_set1_epi16(8 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  const __m128i t2    = _mm_set1_epi16(4 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  const __m128i t3    = _mm_set1_epi16(2 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  __m128i*      out   = (__m128i*)llr;
+
+  int i = 0;
+  for (; i + 4 <= nsymbols; i += 4) {
+    __m128i q0 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(&x[2 * i]), scale));
+    __m128i q1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(&x[2 * i + 4]), scale));
+
+    // Clamping to -INT16_MAX keeps the absolute value from overflowing
+    __m128i l0 = _mm_max_epi16(_mm_packs_epi32(q0, q1), min);
+    __m128i l1 = _mm_sub_epi16(_mm_abs_epi16(l0), t1);
+    __m128i l2 = _mm_sub_epi16(_mm_abs_epi16(l1), t2);
+    __m128i l3 = _mm_sub_epi16(_mm_abs_epi16(l2), t3);
+
+    __m128i a = _mm_unpacklo_epi32(l0, l1);
+    __m128i b = _mm_unpackhi_epi32(l0, l1);
+    __m128i c = _mm_unpacklo_epi32(l2, l3);
+    __m128i d = _mm_unpackhi_epi32(l2, l3);
+
+    _mm_storeu_si128(out++, _mm_unpacklo_epi64(a, c));
+    _mm_storeu_si128(out++, _mm_unpackhi_epi64(a, c));
+    _mm_storeu_si128(out++, _mm_unpacklo_epi64(b, d));
+    _mm_storeu_si128(out++, _mm_unpackhi_epi64(b, d));
+  }
+  return i;
+}
+
+static int demod_256qam_lte_b_sse(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  const float*  x     = (const float*)symbols;
+  const __m128  scale = _mm_set1_ps(-SCALE_BYTE_CONV_QAM256);
+  const __m128i min   = _mm_set1_epi8(-INT8_MAX);
+  const __m128i t1    = _mm_set1_epi8(8 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  const __m128i t2    = _mm_set1_epi8(4 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  const __m128i t3    = _mm_set1_epi8(2 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  __m128i*      out   = (__m128i*)llr;
+
+  int i = 0;
+  for (; i + 8 <= nsymbols; i += 8) {
+    __m128i q0 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(&x[2 * i]), scale));
+    __m128i q1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(&x[2 * i + 4]), scale));
+    __m128i q2 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(&x[2 * i + 8]), scale));
+    __m128i q3 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(&x[2 * i + 12]), scale));
+
+    // Clamping to -INT8_MAX keeps the absolute value from overflowing
+    __m128i l0 = _mm_packs_epi16(_mm_packs_epi32(q0, q1), _mm_packs_epi32(q2, q3));
+    l0         = _mm_max_epi8(l0, min);
+    __m128i l1 = _mm_sub_epi8(_mm_abs_epi8(l0), t1);
+    __m128i l2 = _mm_sub_epi8(_mm_abs_epi8(l1), t2);
+    __m128i l3 = _mm_sub_epi8(_mm_abs_epi8(l2), t3);
+
+    __m128i a = _mm_unpacklo_epi16(l0, l1);
+    __m128i b = _mm_unpackhi_epi16(l0, l1);
+    __m128i c = _mm_unpacklo_epi16(l2, l3);
+    __m128i d = _mm_unpackhi_epi16(l2, l3);
+
+    _mm_storeu_si128(out++, _mm_unpacklo_epi32(a, c));
+    _mm_storeu_si128(out++, _mm_unpackhi_epi32(a, c));
+    _mm_storeu_si128(out++, _mm_unpacklo_epi32(b, d));
+    _mm_storeu_si128(out++, _mm_unpackhi_epi32(b, d));
+  }
+  return i;
+}
+
+#endif /* LV_HAVE_SSE */
+
+#ifdef LV_HAVE_AVX2
+
+// Stores four registers in which the 128 bit lane j of register k holds the output chunk 4 * j + k
+static inline void demod_256qam_store_avx2(void* llr, __m256i o0, __m256i o1, __m256i o2, __m256i o3)
+{
+  __m256i* out = (__m256i*)llr;
+  _mm256_storeu_si256(out++, _mm256_permute2x128_si256(o0, o1, 0x20));
+  _mm256_storeu_si256(out++, _mm256_permute2x128_si256(o2, o3, 0x20));
+  _mm256_storeu_si256(out++, _mm256_permute2x128_si256(o0, o1, 0x31));
+  _mm256_storeu_si256(out++, _mm256_permute2x128_si256(o2, o3, 0x31));
+}
+
+static int demod_256qam_lte_avx2(const cf_t* symbols, float* llr, int nsymbols)
+{
+  const float* x    = (const float*)symbols;
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  const __m256 t1   = _mm256_set1_ps(8.0f / sqrtf(170.0f));
+  const __m256 t2   = _mm256_set1_ps(4.0f / sqrtf(170.0f));
+  const __m256 t3   = _mm256_set1_ps(2.0f / sqrtf(170.0f));
+
+  int i = 0;
+  for (; i + 4 <= nsymbols; i += 4) {
+    __m256 l0 = _mm256_xor_ps(_mm256_loadu_ps(&x[2 * i]), sign);
+    __m256 l1 = _mm256_sub_ps(_mm256_andnot_ps(sign, l0), t1);
+    __m256 l2 = _mm256_sub_ps(_mm256_andnot_ps(sign, l1), t2);
+    __m256 l3 = _mm256_sub_ps(_mm256_andnot_ps(sign, l2), t3);
+
+    // Every complex LLR pair is moved as one 64 bit element
+    __m256d a = _mm256_unpacklo_pd(_mm256_castps_pd(l0), _mm256_castps_pd(l1));
+    __m256d b = _mm256_unpackhi_pd(_mm256_castps_pd(l0), _mm256_castps_pd(l1));
+    __m256d c = _mm256_unpacklo_pd(_mm256_castps_pd(l2), _mm256_castps_pd(l3));
+    __m256d d = _mm256_unpackhi_pd(_mm256_castps_pd(l2), _mm256_castps_pd(l3));
+
+    demod_256qam_store_avx2(&llr[8 * i],
+                            _mm256_castpd_si256(a),
+                            _mm256_castpd_si256(c),
+                            _mm256_castpd_si256(b),
+                            _mm256_castpd_si256(d));
+  }
+  return i;
+}
+
+static int demod_256qam_lte_s_avx2(const cf_t* symbols, int16_t* llr, int nsymbols)
+{
+  const float*  x     = (const float*)symbols;
+  const __m256  scale = _mm256_set1_ps(-SCALE_SHORT_CONV_QAM256);
+  const __m256i min   = _mm256_set1_epi16(-INT16_MAX);
+  const __m256i t1    = _mm256_set1_epi16(8 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  const __m256i t2    = _mm256_set1_epi16(4 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  const __m256i t3    = _mm256_set1_epi16(2 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+
+  int i = 0;
+  for (; i + 8 <= nsymbols; i += 8) {
+    __m256i q0 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(&x[2 * i]), scale));
+    __m256i q1 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(&x[2 * i + 8]), scale));
+
+    // Packing works in 128 bit lanes, the permutation restores the symbol order
+    __m256i l0 = _mm256_permute4x64_epi64(_mm256_packs_epi32(q0, q1), 0xD8);
+    l0         = _mm256_max_epi16(l0, min);
+    __m256i l1 = _mm256_sub_epi16(_mm256_abs_epi16(l0), t1);
+    __m256i l2 = _mm256_sub_epi16(_mm256_abs_epi16(l1), t2);
+    __m256i l3 = _mm256_sub_epi16(_mm256_abs_epi16(l2), t3);
+
+    __m256i a = _mm256_unpacklo_epi32(l0, l1);
+    __m256i b = _mm256_unpackhi_epi32(l0, l1);
+    __m256i c = _mm256_unpacklo_epi32(l2, l3);
+    __m256i d = _mm256_unpackhi_epi32(l2, l3);
+
+    demod_256qam_store_avx2(&llr[8 * i],
+                            _mm256_unpacklo_epi64(a, c),
+                            _mm256_unpackhi_epi64(a, c),
+                            _mm256_unpacklo_epi64(b, d),
+                            _mm256_unpackhi_epi64(b, d));
+  }
+  return i;
+}
+
+static int demod_256qam_lte_b_avx2(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  const float*  x     = (const float*)symbols;
+  const __m256  scale = _mm256_set1_ps(-SCALE_BYTE_CONV_QAM256);
+  const __m256i min   = _mm256_set1_epi8(-INT8_MAX);
+  const __m256i t1    = _mm256_set1_epi8(8 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  const __m256i t2    = _mm256_set1_epi8(4 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  const __m256i t3    = _mm256_set1_epi8(2 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+
+  int i = 0;
+  for (; i + 16 <= nsymbols; i += 16) {
+    __m256i q0 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(&x[2 * i]), scale));
+    __m256i q1 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(&x[2 * i + 8]), scale));
+    __m256i q2 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(&x[2 * i + 16]), scale));
+    __m256i q3 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(&x[2 * i + 24]), scale));
+
+    // Packing works in 128 bit lanes, the permutations restore the symbol order
+    __m256i s01 = _mm256_permute4x64_epi64(_mm256_packs_epi32(q0, q1), 0xD8);
+    __m256i s23 = _mm256_permute4x64_epi64(_mm256_packs_epi32(q2, q3), 0xD8);
+    __m256i l0  = _mm256_permute4x64_epi64(_mm256_packs_epi16(s01, s23), 0xD8);
+    l0          = _mm256_max_epi8(l0, min);
+    __m256i l1  = _mm256_sub_epi8(_mm256_abs_epi8(l0), t1);
+    __m256i l2  = _mm256_sub_epi8(_mm256_abs_epi8(l1), t2);
+    __m256i l3  = _mm256_sub_epi8(_mm256_abs_epi8(l2), t3);
+
+    __m256i a = _mm256_unpacklo_epi16(l0, l1);
+    __m256i b = _mm256_unpackhi_epi16(l0, l1);
+    __m256i c = _mm256_unpacklo_epi16(l2, l3);
+    __m256i d = _mm256_unpackhi_epi16(l2, l3);
+
+    demod_256qam_store_avx2(&llr[8 * i],
+                            _mm256_unpacklo_epi32(a, c),
+                            _mm256_unpackhi_epi32(a, c),
+                            _mm256_unpacklo_epi32(b, d),
+                            _mm256_unpackhi_epi32(b, d));
+  }
+  return i;
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_AVX512
+
+// Stores four registers in which the 128 bit lane j of register k holds the output chunk 4 * j + k
+static inline void demod_256qam_store_avx512(void* llr, __m512i o0, __m512i o1, __m512i o2, __m512i o3)
+{
+  __m512i p = _mm512_shuffle_i64x2(o0, o1, 0x44);
+  __m512i q = _mm512_shuffle_i64x2(o2, o3, 0x44);
+  __m512i r = _mm512_shuffle_i64x2(o0, o1, 0xEE);
+  __m512i s = _mm512_shuffle_i64x2(o2, o3, 0xEE);
+
+  __m512i* out = (__m512i*)llr;
+  _mm512_storeu_si512(out++, _mm512_shuffle_i64x2(p, q, 0x88));
+  _mm512_storeu_si512(out++, _mm512_shuffle_i64x2(p, q, 0xDD));
+  _mm512_storeu_si512(out++, _mm512_shuffle_i64x2(r, s, 0x88));
+  _mm512_storeu_si512(out++, _mm512_shuffle_i64x2(r, s, 0xDD));
+}
+
+static int demod_256qam_lte_avx512(const cf_t* symbols, float* llr, int nsymbols)
+{
+  const float* x    = (const float*)symbols;
+  const __m512 sign = _mm512_set1_ps(-0.0f);
+  const __m512 t1   = _mm512_set1_ps(8.0f / sqrtf(170.0f));
+  const __m512 t2   = _mm512_set1_ps(4.0f / sqrtf(170.0f));
+  const __m512 t3   = _mm512_set1_ps(2.0f / sqrtf(170.0f));
+
+  int i = 0;
+  for (; i + 8 <= nsymbols; i += 8) {
+    __m512 l0 = _mm512_xor_ps(_mm512_loadu_ps(&x[2 * i]), sign);
+    __m512 l1 = _mm512_sub_ps(_mm512_abs_ps(l0), t1);
+    __m512 l2 = _mm512_sub_ps(_mm512_abs_ps(l1), t2);
+    __m512 l3 = _mm512_sub_ps(_mm512_abs_ps(l2), t3);
+
+    // Every complex LLR pair is moved as one 64 bit element
+    __m512d a = _mm512_unpacklo_pd(_mm512_castps_pd(l0), _mm512_castps_pd(l1));
+    __m512d b = _mm512_unpackhi_pd(_mm512_castps_pd(l0), _mm512_castps_pd(l1));
+    __m512d c = _mm512_unpacklo_pd(_mm512_castps_pd(l2), _mm512_castps_pd(l3));
+    __m512d d = _mm512_unpackhi_pd(_mm512_castps_pd(l2), _mm512_castps_pd(l3));
+
+    demod_256qam_store_avx512(&llr[8 * i],
+                              _mm512_castpd_si512(a),
+                              _mm512_castpd_si512(c),
+                              _mm512_castpd_si512(b),
+                              _mm512_castpd_si512(d));
+  }
+  return i;
+}
+
+static int demod_256qam_lte_s_avx512(const cf_t* symbols, int16_t* llr, int nsymbols)
+{
+  const float*  x     = (const float*)symbols;
+  const __m512  scale = _mm512_set1_ps(-SCALE_SHORT_CONV_QAM256);
+  const __m512i order = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+  const __m512i min   = _mm512_set1_epi16(-INT16_MAX);
+  const __m512i t1    = _mm512_set1_epi16(8 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  const __m512i t2    = _mm512_set1_epi16(4 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  const __m512i t3    = _mm512_set1_epi16(2 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+
+  int i = 0;
+  for (; i + 16 <= nsymbols; i += 16) {
+    __m512i q0 = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_loadu_ps(&x[2 * i]), scale));
+    __m512i q1 = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_loadu_ps(&x[2 * i + 16]), scale));
+
+    // Packing works in 128 bit lanes, the permutation restores the symbol order
+    __m512i l0 = _mm512_permutexvar_epi64(order, _mm512_packs_epi32(q0, q1));
+    l0         = _mm512_max_epi16(l0, min);
+    __m512i l1 = _mm512_sub_epi16(_mm512_abs_epi16(l0), t1);
+    __m512i l2 = _mm512_sub_epi16(_mm512_abs_epi16(l1), t2);
+    __m512i l3 = _mm512_sub_epi16(_mm512_abs_epi16(l2), t3);
+
+    __m512i a = _mm512_unpacklo_epi32(l0, l1);
+    __m512i b = _mm512_unpackhi_epi32(l0, l1);
+    __m512i c = _mm512_unpacklo_epi32(l2, l3);
+    __m512i d = _mm512_unpackhi_epi32(l2, l3);
+
+    demod_256qam_store_avx512(&llr[8 * i],
+                              _mm512_unpacklo_epi64(a, c),
+                              _mm512_unpackhi_epi64(a, c),
+                              _mm512_unpacklo_epi64(b, d),
+                              _mm512_unpackhi_epi64(b, d));
+  }
+  return i;
+}
+
+static int demod_256qam_lte_b_avx512(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  const float*  x     = (const float*)symbols;
+  const __m512  scale = _mm512_set1_ps(-SCALE_BYTE_CONV_QAM256);
+  const __m512i order = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+  const __m512i min   = _mm512_set1_epi8(-INT8_MAX);
+  const __m512i t1    = _mm512_set1_epi8(8 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  const __m512i t2    = _mm512_set1_epi8(4 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  const __m512i t3    = _mm512_set1_epi8(2 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+
+  int i = 0;
+  for (; i + 32 <= nsymbols; i += 32) {
+    __m512i q0 = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_loadu_ps(&x[2 * i]), scale));
+    __m512i q1 = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_loadu_ps(&x[2 * i + 16]), scale));
+    __m512i q2 = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_loadu_ps(&x[2 * i + 32]), scale));
+    __m512i q3 = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_loadu_ps(&x[2 * i + 48]), scale));
+
+    // Packing works in 128 bit lanes, the permutations restore the symbol order
+    __m512i s01 = _mm512_permutexvar_epi64(order, _mm512_packs_epi32(q0, q1));
+    __m512i s23 = _mm512_permutexvar_epi64(order, _mm512_packs_epi32(q2, q3));
+    __m512i l0  = _mm512_permutexvar_epi64(order, _mm512_packs_epi16(s01, s23));
+    l0          = _mm512_max_epi8(l0, min);
+    __m512i l1  = _mm512_sub_epi8(_mm512_abs_epi8(l0), t1);
+    __m512i l2  = _mm512_sub_epi8(_mm512_abs_epi8(l1), t2);
+    __m512i l3  = _mm512_sub_epi8(_mm512_abs_epi8(l2), t3);
+
+    __m512i a = _mm512_unpacklo_epi16(l0, l1);
+    __m512i b = _mm512_unpackhi_epi16(l0, l1);
+    __m512i c = _mm512_unpacklo_epi16(l2, l3);
+    __m512i d = _mm512_unpackhi_epi16(l2, l3);
+
+    demod_256qam_store_avx512(&llr[8 * i],
+                              _mm512_unpacklo_epi32(a, c),
+                              _mm512_unpackhi_epi32(a, c),
+                              _mm512_unpacklo_epi32(b, d),
+                              _mm512_unpackhi_epi32(b, d));
+  }
+  return i;
+}
+
+#endif /* LV_HAVE_AVX512 */
+
+#ifdef HAVE_NEONv8
+
+static int demod_256qam_lte_neon(const cf_t* symbols, float* llr, int nsymbols)
+{
+  const float*      x  = (const float*)symbols;
+  const float32x4_t t1 = vdupq_n_f32(8.0f / sqrtf(170.0f));
+  const float32x4_t t2 = vdupq_n_f32(4.0f / sqrtf(170.0f));
+  const float32x4_t t3 = vdupq_n_f32(2.0f / sqrtf(170.0f));
+
+  int i = 0;
+  for (; i + 2 <= nsymbols; i += 2) {
+    float32x4_t l0 = vnegq_f32(vld1q_f32(&x[2 * i]));
+    float32x4_t l1 = vsubq_f32(vabsq_f32(l0), t1);
+    float32x4_t l2 = vsubq_f32(vabsq_f32(l1), t2);
+    float32x4_t l3 = vsubq_f32(vabsq_f32(l2), t3);
+
+    vst1q_f32(&llr[8 * i + 0], vcombine_f32(vget_low_f32(l0), vget_low_f32(l1)));
+    vst1q_f32(&llr[8 * i + 4], vcombine_f32(vget_low_f32(l2), vget_low_f32(l3)));
+    vst1q_f32(&llr[8 * i + 8], vcombine_f32(vget_high_f32(l0), vget_high_f32(l1)));
+    vst1q_f32(&llr[8 * i + 12], vcombine_f32(vget_high_f32(l2), vget_high_f32(l3)));
+  }
+  return i;
+}
+
+static int demod_256qam_lte_s_neon(const cf_t* symbols, int16_t* llr, int nsymbols)
+{
+  const float*      x     = (const float*)symbols;
+  const float32x4_t scale = vdupq_n_f32(-SCALE_SHORT_CONV_QAM256);
+  const int16x8_t   t1    = vdupq_n_s16(8 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  const int16x8_t   t2    = vdupq_n_s16(4 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  const int16x8_t   t3    = vdupq_n_s16(2 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+
+  int i = 0;
+  for (; i + 4 <= nsymbols; i += 4) {
+    int32x4_t q0 = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(&x[2 * i]), scale));
+    int32x4_t q1 = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(&x[2 * i + 4]), scale));
+
+    int16x8_t l0 = vcombine_s16(vqmovn_s32(q0), vqmovn_s32(q1));
+    int16x8_t l1 = vsubq_s16(vqabsq_s16(l0), t1);
+    int16x8_t l2 = vsubq_s16(vqabsq_s16(l1), t2);
+    int16x8_t l3 = vsubq_s16(vqabsq_s16(l2), t3);
+
+    int32x4x2_t ab = vzipq_s32(vreinterpretq_s32_s16(l0), vreinterpretq_s32_s16(l1));
+    int32x4x2_t cd = vzipq_s32(vreinterpretq_s32_s16(l2), vreinterpretq_s32_s16(l3));
+
+    vst1q_s32((int32_t*)&llr[8 * i + 0], vcombine_s32(vget_low_s32(ab.val[0]), vget_low_s32(cd.val[0])));
+    vst1q_s32((int32_t*)&llr[8 * i + 8], vcombine_s32(vget_high_s32(ab.val[0]), vget_high_s32(cd.val[0])));
+    vst1q_s32((int32_t*)&llr[8 * i + 16], vcombine_s32(vget_low_s32(ab.val[1]), vget_low_s32(cd.val[1])));
+    vst1q_s32((int32_t*)&llr[8 * i + 24], vcombine_s32(vget_high_s32(ab.val[1]), vget_high_s32(cd.val[1])));
+  }
+  return i;
+}
+
+static int demod_256qam_lte_b_neon(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  const float*      x     = (const float*)symbols;
+  const float32x4_t scale = vdupq_n_f32(-SCALE_BYTE_CONV_QAM256);
+  const int8x16_t   t1    = vdupq_n_s8(8 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  const int8x16_t   t2    = vdupq_n_s8(4 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  const int8x16_t   t3    = vdupq_n_s8(2 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+
+  int i = 0;
+  for (; i + 8 <= nsymbols; i += 8) {
+    int32x4_t q0 = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(&x[2 * i]), scale));
+    int32x4_t q1 = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(&x[2 * i + 4]), scale));
+    int32x4_t q2 = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(&x[2 * i + 8]), scale));
+    int32x4_t q3 = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(&x[2 * i + 12]), scale));
+
+    int16x8_t s01 = vcombine_s16(vqmovn_s32(q0), vqmovn_s32(q1));
+    int16x8_t s23 = vcombine_s16(vqmovn_s32(q2), vqmovn_s32(q3));
+    int8x16_t l0  = vcombine_s8(vqmovn_s16(s01), vqmovn_s16(s23));
+    int8x16_t l1  = vsubq_s8(vqabsq_s8(l0), t1);
+    int8x16_t l2  = vsubq_s8(vqabsq_s8(l1), t2);
+    int8x16_t l3  = vsubq_s8(vqabsq_s8(l2), t3);
+
+    int16x8x2_t ab = vzipq_s16(vreinterpretq_s16_s8(l0), vreinterpretq_s16_s8(l1));
+    int16x8x2_t cd = vzipq_s16(vreinterpretq_s16_s8(l2), vreinterpretq_s16_s8(l3));
+    int32x4x2_t lo = vzipq_s32(vreinterpretq_s32_s16(ab.val[0]), vreinterpretq_s32_s16(cd.val[0]));
+    int32x4x2_t hi = vzipq_s32(vreinterpretq_s32_s16(ab.val[1]), vreinterpretq_s32_s16(cd.val[1]));
+
+    vst1q_s32((int32_t*)&llr[8 * i + 0], lo.val[0]);
+    vst1q_s32((int32_t*)&llr[8 * i + 16], lo.val[1]);
+    vst1q_s32((int32_t*)&llr[8 * i + 32], hi.val[0]);
+    vst1q_s32((int32_t*)&llr[8 * i + 48], hi.val[1]);
+  }
+  return i;
+}
+
+#endif /* HAVE_NEONv8 */
+
+void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
+{
+  int i = 0;
+#ifdef LV_HAVE_AVX512
+  i += demod_256qam_lte_avx512(&symbols[i], &llr[8 * i], nsymbols - i);
+#endif
+#ifdef LV_HAVE_AVX2
+  i += demod_256qam_lte_avx2(&symbols[i], &llr[8 * i], nsymbols - i);
+#endif
+#ifdef LV_HAVE_SSE
+  i += demod_256qam_lte_sse(&symbols[i], &llr[8 * i], nsymbols - i);
+#endif
+#ifdef HAVE_NEONv8
+  i += demod_256qam_lte_neon(&symbols[i], &llr[8 * i], nsymbols - i);
+#endif
+  demod_256qam_lte_generic(&symbols[i], &llr[8 * i], nsymbols - i);
+}
+
+void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  int i = 0;
+#ifdef LV_HAVE_AVX512
+  i += demod_256qam_lte_b_avx512(&symbols[i], &llr[8 * i], nsymbols - i);
+#endif
+#ifdef LV_HAVE_AVX2
+  i += demod_256qam_lte_b_avx2(&symbols[i], &llr[8 * i], nsymbols - i);
+#endif
+#ifdef LV_HAVE_SSE
+  i += demod_256qam_lte_b_sse(&symbols[i], &llr[8 * i], nsymbols - i);
+#endif
+#ifdef HAVE_NEONv8
+  i += demod_256qam_lte_b_neon(&symbols[i], &llr[8 * i], nsymbols - i);
+#endif
+  demod_256qam_lte_b_generic(&symbols[i], &llr[8 * i], nsymbols - i);
+}
+
+void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
+{
+  int i = 0;
+#ifdef LV_HAVE_AVX512
+  i += demod_256qam_lte_s_avx512(&symbols[i], &llr[8 * i], nsymbols - i);
+#endif
+#ifdef LV_HAVE_AVX2
+  i += demod_256qam_lte_s_avx2(&symbols[i], &llr[8 * i], nsymbols - i);
+#endif
+#ifdef LV_HAVE_SSE
+  i += demod_256qam_lte_s_sse(&symbols[i], &llr[8 * i], nsymbols - i);
+#endif
+#ifdef HAVE_NEONv8
+  i += demod_256qam_lte_s_neon(&symbols[i], &llr[8 * i], nsymbols - i);
+#endif
+  demod_256qam_lte_s_generic(&symbols[i], &llr[8 * i], nsymbols - i);
+}
+
 int srsran_demod_soft_demodulate(srsran_mod_t modulation, const cf_t* symbols, float* llr, int nsymbols)
 {
   switch (modulation) {
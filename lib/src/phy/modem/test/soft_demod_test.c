@@ -36,7 +36,7 @@ static srsran_mod_t modulation = SRSRAN_MOD_NITEMS;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [nfv] -m modulation (1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64)\n", prog);
+  printf("Usage: %s [nfv] -m modulation (1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64, 8: QAM256)\n", prog);
   printf("\t-n num_bits [Default %d]\n", num_bits);
   printf("\t-f nof_frames [Default %d]\n", nof_frames);
   printf("\t-v srsran_verbose [Default None]\n");
@@ -75,7 +75,7 @@ void parse_args(int argc, char** argv)
             break;
           default:
             ERROR("Invalid modulation %d. Possible values: "
-                  "(1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64)",
+                  "(1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64, 8: QAM256)",
                   (int)strtol(argv[optind], NULL, 10));
             break;
         }
@@ -232,6 +232,14 @@ int main(int argc, char** argv)
         printf("Error in bit %d\n", i);
         goto clean_exit;
       }
+      if (input[i] != (llr_s[i] > 0 ? 1 : 0)) {
+        printf("Error in 16 bit LLR %d\n", i);
+        goto clean_exit;
+      }
+      if (input[i] != (llr_b[i] > 0 ? 1 : 0)) {
+        printf("Error in 8 bit LLR %d\n", i);
+        goto clean_exit;
+      }
     }
   }
   ret = 0;
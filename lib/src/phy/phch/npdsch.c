@@ -370,12 +370,36 @@ int srsran_npdsch_decode_rnti(srsran_npdsch_t*        q,
                               uint32_t                sfn,
                               uint8_t*                data,
                               uint32_t                rep_counter)
+{
+  if (q != NULL && sf_symbols != NULL && data != NULL && cfg != NULL) {
+    if (srsran_npdsch_extract_llr_rnti(q, cfg, sf_symbols, ce, noise_estimate, rnti, sfn) != SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    // decode only this transmission
+    return srsran_npdsch_rm_and_decode(q, cfg, q->llr, data);
+  } else {
+    fprintf(stderr, "srsran_npdsch_decode_rnti() called with invalid parameters.\n");
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+}
+
+/** Extracts the descrambled soft-bits of all subframes of the grant into q->llr without decoding them, so that
+ *  the caller can soft-combine several repetitions before calling srsran_npdsch_rm_and_decode()
+ */
+int srsran_npdsch_extract_llr_rnti(srsran_npdsch_t*     q,
+                                   srsran_npdsch_cfg_t* cfg,
+                                   cf_t*                sf_symbols,
+                                   cf_t*                ce[SRSRAN_MAX_PORTS],
+                                   float                noise_estimate,
+                                   uint16_t             rnti,
+                                   uint32_t             sfn)
 {
   // Set pointers for layermapping & precoding
   uint32_t n;
   cf_t*    x[SRSRAN_MAX_LAYERS];
 
-  if (q != NULL && sf_symbols != NULL && data != NULL && cfg != NULL) {
+  if (q != NULL && sf_symbols != NULL && cfg != NULL) {
     INFO("%d.x: Decoding NPDSCH: RNTI: 0x%x, Mod %s, TBS: %d, NofSymbols: %d * %d, NofBitsE: %d * %d",
          sfn,
          rnti,
@@ -496,10 +520,9 @@ int srsran_npdsch_decode_rnti(srsran_npdsch_t*        q,
     }
 #endif
 
-    // decode only this transmission
-    return srsran_npdsch_rm_and_decode(q, cfg, q->llr, data);
+    return SRSRAN_SUCCESS;
   } else {
-    fprintf(stderr, "srsran_npdsch_decode_rnti() called with invalid parameters.\n");
+    fprintf(stderr, "srsran_npdsch_extract_llr_rnti() called with invalid parameters.\n");
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 }
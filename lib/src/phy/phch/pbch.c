@@ -559,20 +559,12 @@ int srsran_pbch_encode(srsran_pbch_t* q,
                        cf_t*          sf_symbols[SRSRAN_MAX_PORTS],
                        uint32_t       frame_idx)
 {
-  int   i;
-  int   nof_bits;
-  cf_t* x[SRSRAN_MAX_LAYERS];
+  int i;
+  int nof_bits;
 
   if (q != NULL && bch_payload != NULL) {
-    /* Set pointers for layermapping & precoding */
     nof_bits = 2 * q->nof_symbols;
 
-    /* number of layers equals number of ports */
-    for (i = 0; i < q->cell.nof_ports; i++) {
-      x[i] = q->x[i];
-    }
-    memset(&x[q->cell.nof_ports], 0, sizeof(cf_t*) * (SRSRAN_MAX_LAYERS - q->cell.nof_ports));
-
     frame_idx = frame_idx % 4;
 
     memcpy(q->data, bch_payload, sizeof(uint8_t) * SRSRAN_BCH_PAYLOAD_LEN);
@@ -590,8 +582,7 @@ int srsran_pbch_encode(srsran_pbch_t* q,
 
     /* layer mapping & precoding */
     if (q->cell.nof_ports > 1) {
-      srsran_layermap_diversity(q->d, x, q->cell.nof_ports, q->nof_symbols);
-      srsran_precoding_diversity(x, q->symbols, q->cell.nof_ports, q->nof_symbols / q->cell.nof_ports, 1.0f);
+      srsran_precoding_diversity_cw(q->d, q->symbols, q->cell.nof_ports, q->nof_symbols, 1.0f);
     } else {
       memcpy(q->symbols[0], q->d, q->nof_symbols * sizeof(cf_t));
     }
@@ -230,14 +230,9 @@ int srsran_pcfich_encode(srsran_pcfich_t* q, srsran_dl_sf_cfg_t* sf, cf_t* slot_
   if (q != NULL && slot_symbols != NULL) {
     uint32_t sf_idx = sf->tti % 10;
 
-    /* Set pointers for layermapping & precoding */
-    cf_t* x[SRSRAN_MAX_LAYERS];
+    /* Set pointers for precoding */
     cf_t* q_symbols[SRSRAN_MAX_PORTS];
 
-    /* number of layers equals number of ports */
-    for (i = 0; i < q->cell.nof_ports; i++) {
-      x[i] = q->x[i];
-    }
     for (i = 0; i < SRSRAN_MAX_PORTS; i++) {
       q_symbols[i] = q->symbols[i];
     }
@@ -252,8 +247,7 @@ int srsran_pcfich_encode(srsran_pcfich_t* q, srsran_dl_sf_cfg_t* sf, cf_t* slot_
 
     /* layer mapping & precoding */
     if (q->cell.nof_ports > 1) {
-      srsran_layermap_diversity(q->d, x, q->cell.nof_ports, q->nof_symbols);
-      srsran_precoding_diversity(x, q_symbols, q->cell.nof_ports, q->nof_symbols / q->cell.nof_ports, 1.0f);
+      srsran_precoding_diversity_cw(q->d, q_symbols, q->cell.nof_ports, q->nof_symbols, 1.0f);
     } else {
       memcpy(q->symbols[0], q->d, q->nof_symbols * sizeof(cf_t));
     }
@@ -41,6 +41,9 @@
 #define PDCCH_FORMAT_NOF_REGS(i) ((1 << i) * 9)
 #define PDCCH_FORMAT_NOF_BITS(i) ((1 << i) * 72)
 
+// Number of candidates srsran_pdcch_decode_msg_multi() groups by size at once
+#define PDCCH_MAX_MULTI_MSG 64
+
 #define NOF_CCE(cfi) ((cfi > 0 && cfi < 4) ? q->nof_cce[cfi - 1] : 0)
 #define NOF_REGS(cfi) ((cfi > 0 && cfi < 4) ? q->nof_regs[cfi - 1] : 0)
 
@@ -341,15 +344,15 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
 
   if (q != NULL) {
     if (data != NULL && E <= q->max_bits && nof_bits <= SRSRAN_DCI_MAX_BITS) {
-      srsran_vec_f_zero(q->rm_f, 3 * (SRSRAN_DCI_MAX_BITS + 16));
+      srsran_vec_f_zero(q->rm_f[0], 3 * (SRSRAN_DCI_MAX_BITS + 16));
 
       uint32_t coded_len = 3 * (nof_bits + 16);
 
       /* unrate matching */
-      srsran_rm_conv_rx(e, E, q->rm_f, coded_len);
+      srsran_rm_conv_rx(e, E, q->rm_f[0], coded_len);
 
       /* viterbi decoder */
-      srsran_viterbi_decode_f(&q->decoder, q->rm_f, data, nof_bits + 16);
+      srsran_viterbi_decode_f(&q->decoder, q->rm_f[0], data, nof_bits + 16);
 
       x       = &data[nof_bits];
       p_bits  = (uint16_t)srsran_bit_pack(&x, 16);
@@ -369,6 +372,91 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
   }
 }
 
+float srsran_pdcch_candidate_energy(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, const srsran_dci_location_t* location)
+{
+  if (q == NULL || sf == NULL || location == NULL || !srsran_dci_location_isvalid(location)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t e_bits = PDCCH_FORMAT_NOF_BITS(location->L);
+  if (location->ncce * 72 + e_bits > NOF_CCE(sf->cfi) * 72) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  const float* llr = &q->llr[location->ncce * 72];
+  return srsran_vec_dot_prod_fff(llr, llr, e_bits) / (float)e_bits;
+}
+
+/* Checks the location of a DCI candidate and computes the absolute mean of its LLRs, returns false if the location is
+ * not valid */
+static bool pdcch_candidate_mean(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dci_msg_t* msg, double* mean)
+{
+  if (!srsran_dci_location_isvalid(&msg->location)) {
+    ERROR("Invalid parameters, location=%d,%d", msg->location.ncce, msg->location.L);
+    return false;
+  }
+  if (msg->location.ncce * 72 + PDCCH_FORMAT_NOF_BITS(msg->location.L) > NOF_CCE(sf->cfi) * 72) {
+    ERROR("Invalid location: nCCE: %d, L: %d, NofCCE: %d", msg->location.ncce, msg->location.L, NOF_CCE(sf->cfi));
+    return false;
+  }
+
+  // Compute absolute mean of the LLRs
+  uint32_t e_bits = PDCCH_FORMAT_NOF_BITS(msg->location.L);
+  *mean           = 0;
+  for (int i = 0; i < e_bits; i++) {
+    *mean += fabsf(q->llr[msg->location.ncce * 72 + i]);
+  }
+  *mean /= e_bits;
+
+  return true;
+}
+
+/* Viterbi decodes together nof_msg candidates of nof_bits, checks their CRC and format */
+static void pdcch_decode_candidates(srsran_pdcch_t*    q,
+                                    srsran_dci_cfg_t*  dci_cfg,
+                                    srsran_dci_msg_t** msg,
+                                    const double*      mean,
+                                    uint32_t           nof_msg,
+                                    uint32_t           nof_bits)
+{
+  float*   rm_f[SRSRAN_VITERBI_MAX_MULTI];
+  uint8_t* data[SRSRAN_VITERBI_MAX_MULTI];
+
+  uint32_t coded_len = 3 * (nof_bits + 16);
+
+  /* unrate matching */
+  for (uint32_t i = 0; i < nof_msg; i++) {
+    rm_f[i] = q->rm_f[i];
+    data[i] = msg[i]->payload;
+    srsran_vec_f_zero(rm_f[i], 3 * (SRSRAN_DCI_MAX_BITS + 16));
+    srsran_rm_conv_rx(
+        &q->llr[msg[i]->location.ncce * 72], PDCCH_FORMAT_NOF_BITS(msg[i]->location.L), rm_f[i], coded_len);
+  }
+
+  /* viterbi decoder */
+  srsran_viterbi_decode_f_multi(&q->decoder, rm_f, data, nof_msg, nof_bits + 16);
+
+  for (uint32_t i = 0; i < nof_msg; i++) {
+    uint8_t* x       = &data[i][nof_bits];
+    uint16_t p_bits  = (uint16_t)srsran_bit_pack(&x, 16);
+    uint16_t crc_res = ((uint16_t)srsran_crc_checksum(&q->crc, data[i], nof_bits) & 0xffff);
+
+    msg[i]->rnti     = p_bits ^ crc_res;
+    msg[i]->nof_bits = nof_bits;
+    // Check format differentiation
+    if (msg[i]->format == SRSRAN_DCI_FORMAT0 || msg[i]->format == SRSRAN_DCI_FORMAT1A) {
+      msg[i]->format = (msg[i]->payload[dci_cfg->cif_enabled ? 3 : 0] == 0) ? SRSRAN_DCI_FORMAT0 : SRSRAN_DCI_FORMAT1A;
+    }
+    INFO("Decoded DCI: nCCE=%d, L=%d, format=%s, msg_len=%d, mean=%f, crc_rem=0x%x",
+         msg[i]->location.ncce,
+         msg[i]->location.L,
+         srsran_dci_format_string(msg[i]->format),
+         nof_bits,
+         mean[i],
+         msg[i]->rnti);
+  }
+}
+
 /** Tries to decode a DCI message from the LLRs stored in the srsran_pdcch_t structure by the function
  * srsran_pdcch_extract_llr(). This function can be called multiple times.
  * The location to search for is obtained from msg.
@@ -377,48 +465,85 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
  */
 int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dci_cfg_t* dci_cfg, srsran_dci_msg_t* msg)
 {
-  int ret = SRSRAN_ERROR_INVALID_INPUTS;
-  if (q != NULL && msg != NULL && srsran_dci_location_isvalid(&msg->location)) {
-    if (msg->location.ncce * 72 + PDCCH_FORMAT_NOF_BITS(msg->location.L) > NOF_CCE(sf->cfi) * 72) {
-      ERROR("Invalid location: nCCE: %d, L: %d, NofCCE: %d", msg->location.ncce, msg->location.L, NOF_CCE(sf->cfi));
+  return srsran_pdcch_decode_msg_multi(q, sf, dci_cfg, msg, 1);
+}
+
+static int pdcch_decode_msg_multi(srsran_pdcch_t*     q,
+                                  srsran_dl_sf_cfg_t* sf,
+                                  srsran_dci_cfg_t*   dci_cfg,
+                                  srsran_dci_msg_t*   msg,
+                                  uint32_t            nof_msg)
+{
+  int      ret = SRSRAN_SUCCESS;
+  uint32_t nof_bits[PDCCH_MAX_MULTI_MSG];
+  double   mean[PDCCH_MAX_MULTI_MSG];
+  bool     pending[PDCCH_MAX_MULTI_MSG];
+
+  for (uint32_t i = 0; i < nof_msg; i++) {
+    pending[i] = false;
+    if (!pdcch_candidate_mean(q, sf, &msg[i], &mean[i])) {
+      ret = SRSRAN_ERROR_INVALID_INPUTS;
+      continue;
+    }
+    nof_bits[i] = srsran_dci_format_sizeof(&q->cell, sf, dci_cfg, msg[i].format);
+    if (mean[i] > 0.3f) {
+      if (nof_bits[i] > 0 && nof_bits[i] <= SRSRAN_DCI_MAX_BITS) {
+        pending[i] = true;
+      } else {
+        ERROR("Invalid DCI size %d", nof_bits[i]);
+        ret = SRSRAN_ERROR_INVALID_INPUTS;
+      }
     } else {
-      ret = SRSRAN_SUCCESS;
+      INFO("Skipping DCI:  nCCE=%d, L=%d, msg_len=%d, mean=%f",
+           msg[i].location.ncce,
+           msg[i].location.L,
+           nof_bits[i],
+           mean[i]);
+    }
+  }
 
-      uint32_t nof_bits = srsran_dci_format_sizeof(&q->cell, sf, dci_cfg, msg->format);
-      uint32_t e_bits   = PDCCH_FORMAT_NOF_BITS(msg->location.L);
+  // Decode the pending candidates, grouping the ones with the same size
+  for (uint32_t i = 0; i < nof_msg; i++) {
+    if (!pending[i]) {
+      continue;
+    }
 
-      // Compute absolute mean of the LLRs
-      double mean = 0;
-      for (int i = 0; i < e_bits; i++) {
-        mean += fabsf(q->llr[msg->location.ncce * 72 + i]);
-      }
-      mean /= e_bits;
-
-      if (mean > 0.3f) {
-        ret = srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
-        if (ret == SRSRAN_SUCCESS) {
-          msg->nof_bits = nof_bits;
-          // Check format differentiation
-          if (msg->format == SRSRAN_DCI_FORMAT0 || msg->format == SRSRAN_DCI_FORMAT1A) {
-            msg->format = (msg->payload[dci_cfg->cif_enabled ? 3 : 0] == 0) ? SRSRAN_DCI_FORMAT0 : SRSRAN_DCI_FORMAT1A;
-          }
-        } else {
-          ERROR("Error calling pdcch_dci_decode");
-        }
-        INFO("Decoded DCI: nCCE=%d, L=%d, format=%s, msg_len=%d, mean=%f, crc_rem=0x%x",
-             msg->location.ncce,
-             msg->location.L,
-             srsran_dci_format_string(msg->format),
-             nof_bits,
-             mean,
-             msg->rnti);
-      } else {
-        INFO("Skipping DCI:  nCCE=%d, L=%d, msg_len=%d, mean=%f", msg->location.ncce, msg->location.L, nof_bits, mean);
+    srsran_dci_msg_t* group[SRSRAN_VITERBI_MAX_MULTI];
+    double            group_mean[SRSRAN_VITERBI_MAX_MULTI];
+    uint32_t          nof_group = 0;
+    for (uint32_t j = i; j < nof_msg && nof_group < SRSRAN_VITERBI_MAX_MULTI; j++) {
+      if (pending[j] && nof_bits[j] == nof_bits[i]) {
+        group[nof_group]      = &msg[j];
+        group_mean[nof_group] = mean[j];
+        nof_group++;
+        pending[j] = false;
       }
     }
-  } else if (msg != NULL) {
-    ERROR("Invalid parameters, location=%d,%d", msg->location.ncce, msg->location.L);
+
+    pdcch_decode_candidates(q, dci_cfg, group, group_mean, nof_group, nof_bits[i]);
   }
+
+  return ret;
+}
+
+int srsran_pdcch_decode_msg_multi(srsran_pdcch_t*     q,
+                                  srsran_dl_sf_cfg_t* sf,
+                                  srsran_dci_cfg_t*   dci_cfg,
+                                  srsran_dci_msg_t*   msg,
+                                  uint32_t            nof_msg)
+{
+  if (q == NULL || sf == NULL || dci_cfg == NULL || msg == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  int ret = SRSRAN_SUCCESS;
+  for (uint32_t i = 0; i < nof_msg; i += PDCCH_MAX_MULTI_MSG) {
+    uint32_t n = SRSRAN_MIN(nof_msg - i, PDCCH_MAX_MULTI_MSG);
+    if (pdcch_decode_msg_multi(q, sf, dci_cfg, &msg[i], n) < SRSRAN_SUCCESS) {
+      ret = SRSRAN_ERROR_INVALID_INPUTS;
+    }
+  }
+
   return ret;
 }
 
@@ -582,7 +707,6 @@ int srsran_pdcch_encode(srsran_pdcch_t*     q,
 {
   int      ret = SRSRAN_ERROR_INVALID_INPUTS;
   uint32_t i;
-  cf_t*    x[SRSRAN_MAX_LAYERS];
   uint32_t nof_symbols;
 
   if (q != NULL && sf_symbols != NULL && sf->cfi > 0 && sf->cfi < 4 && srsran_dci_location_isvalid(&msg->location)) {
@@ -601,12 +725,6 @@ int srsran_pdcch_encode(srsran_pdcch_t*     q,
 
       srsran_pdcch_dci_encode(q, msg->payload, q->e, msg->nof_bits, e_bits, msg->rnti);
 
-      /* number of layers equals number of ports */
-      for (i = 0; i < q->cell.nof_ports; i++) {
-        x[i] = q->x[i];
-      }
-      memset(&x[q->cell.nof_ports], 0, sizeof(cf_t*) * (SRSRAN_MAX_LAYERS - q->cell.nof_ports));
-
       srsran_scrambling_b_offset(&q->seq[sf->tti % 10], q->e, 72 * msg->location.ncce, e_bits);
 
       DEBUG("Scrambling output: ");
@@ -618,8 +736,7 @@ int srsran_pdcch_encode(srsran_pdcch_t*     q,
 
       /* layer mapping & precoding */
       if (q->cell.nof_ports > 1) {
-        srsran_layermap_diversity(q->d, x, q->cell.nof_ports, nof_symbols);
-        srsran_precoding_diversity(x, q->symbols, q->cell.nof_ports, nof_symbols / q->cell.nof_ports, 1.0f);
+        srsran_precoding_diversity_cw(q->d, q->symbols, q->cell.nof_ports, nof_symbols, 1.0f);
       } else {
         memcpy(q->symbols[0], q->d, nof_symbols * sizeof(cf_t));
       }
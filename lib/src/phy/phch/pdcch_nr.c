@@ -31,6 +31,9 @@
 
 #define PDCCH_NR_POLAR_RM_IBIL 0
 
+// Minimum number of candidates for decoding them with the batch polar decoder, fewer candidates are faster one by one
+#define PDCCH_NR_POLAR_BATCH_MIN 4
+
 #define PDCCH_INFO_TX(...) INFO("PDCCH Tx: " __VA_ARGS__)
 #define PDCCH_INFO_RX(...) INFO("PDCCH Rx: " __VA_ARGS__)
 #define PDCCH_DEBUG_RX(...) DEBUG("PDCCH Rx: " __VA_ARGS__)
@@ -238,6 +241,25 @@ int srsran_pdcch_nr_init_rx(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args_t*
     return SRSRAN_ERROR;
   }
 
+  SRSRAN_MEM_ZERO(&q->decoder_batch, srsran_polar_decoder_t, 1);
+#ifdef LV_HAVE_AVX2
+  if (!args->disable_simd) {
+    if (srsran_polar_decoder_init(&q->decoder_batch, SRSRAN_POLAR_DECODER_SSC_C_BATCH, NMAX_LOG) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+#endif // LV_HAVE_AVX2
+
+  q->d_multi = srsran_vec_i8_malloc(NMAX * SRSRAN_PDCCH_NR_MAX_MULTI);
+  if (q->d_multi == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  q->allocated_multi = srsran_vec_u8_malloc(NMAX * SRSRAN_PDCCH_NR_MAX_MULTI);
+  if (q->allocated_multi == NULL) {
+    return SRSRAN_ERROR;
+  }
+
   if (srsran_polar_rm_rx_init_c(&q->rm) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
@@ -262,6 +284,7 @@ void srsran_pdcch_nr_free(srsran_pdcch_nr_t* q)
     srsran_polar_rm_tx_free(&q->rm);
   } else {
     srsran_polar_decoder_free(&q->decoder);
+    srsran_polar_decoder_free(&q->decoder_batch);
     srsran_polar_rm_rx_free_c(&q->rm);
   }
 
@@ -281,6 +304,14 @@ void srsran_pdcch_nr_free(srsran_pdcch_nr_t* q)
     free(q->allocated);
   }
 
+  if (q->d_multi) {
+    free(q->d_multi);
+  }
+
+  if (q->allocated_multi) {
+    free(q->allocated_multi);
+  }
+
   if (q->symbols) {
     free(q->symbols);
   }
@@ -569,38 +600,22 @@ int srsran_pdcch_nr_encode(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_
   return SRSRAN_SUCCESS;
 }
 
-int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
-                           cf_t*                   slot_symbols,
-                           srsran_dmrs_pdcch_ce_t* ce,
-                           srsran_dci_msg_nr_t*    dci_msg,
-                           srsran_pdcch_nr_res_t*  res)
+/**
+ * @brief Extracts, equalises, demodulates, descrambles and rate-dematches a candidate into the LLR of the polar code
+ */
+static int pdcch_nr_decode_llr(srsran_pdcch_nr_t*      q,
+                               cf_t*                   slot_symbols,
+                               srsran_dmrs_pdcch_ce_t* ce,
+                               srsran_dci_msg_nr_t*    dci_msg,
+                               srsran_pdcch_nr_res_t*  res,
+                               int8_t*                 d)
 {
-  if (q == NULL || dci_msg == NULL || ce == NULL || slot_symbols == NULL || res == NULL) {
-    return SRSRAN_ERROR;
-  }
-
-  struct timeval t[3];
-  if (q->meas_time_en) {
-    gettimeofday(&t[1], NULL);
-  }
-
-  // Calculate...
-  q->K = dci_msg->nof_bits + 24U;                                  // Payload size including CRC
-  q->M = (1U << dci_msg->ctx.location.L) * (SRSRAN_NRE - 3U) * 6U; // Number of RE
-  q->E = q->M * 2;                                                 // Number of Rate-Matched bits
-
   // Check number of estimates is correct
-  if (ce->nof_re != q->M) {
+  if (ce == NULL || ce->nof_re != q->M) {
     ERROR("Invalid number of channel estimates (%d != %d)", q->M, ce->nof_re);
     return SRSRAN_ERROR;
   }
 
-  // Get polar code
-  if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
-  }
-  PDCCH_INFO_RX("K=%d; E=%d; M=%d; n=%d;", q->K, q->E, q->M, q->code.n);
-
   // Get symbols from grid
   uint32_t m = pdcch_nr_cp(q, &dci_msg->ctx.location, slot_symbols, q->symbols, false);
   if (q->M != m) {
@@ -643,7 +658,6 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
   srsran_sequence_apply_c(llr, llr, q->E, pdcch_nr_c_init(q, dci_msg));
 
   // Un-rate matching
-  int8_t* d = (int8_t*)q->d;
   if (srsran_polar_rm_rx_c(&q->rm, llr, d, q->E, q->code.n, q->K, PDCCH_NR_POLAR_RM_IBIL) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
@@ -654,15 +668,20 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
     srsran_vec_fprint_bs(stdout, d, q->K);
   }
 
-  // Decode
-  if (srsran_polar_decoder_decode_c(&q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size) <
-      SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
-  }
+  return SRSRAN_SUCCESS;
+}
 
+/**
+ * @brief De-allocates, de-interleaves and checks the CRC of a decoded candidate
+ */
+static void pdcch_nr_decode_msg(srsran_pdcch_nr_t*     q,
+                                const uint8_t*         allocated,
+                                srsran_dci_msg_nr_t*   dci_msg,
+                                srsran_pdcch_nr_res_t* res)
+{
   // De-allocate channel
   uint8_t c_prime[SRSRAN_POLAR_INTERLEAVER_K_MAX_IL];
-  srsran_polar_chanalloc_rx(q->allocated, c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
+  srsran_polar_chanalloc_rx(allocated, c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
 
   // Set first L bits to ones, c will have an offset of 24 bits
   uint8_t* c = q->c;
@@ -700,6 +719,77 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
 
   // Copy DCI message
   srsran_vec_u8_copy(dci_msg->payload, c, dci_msg->nof_bits);
+}
+
+int srsran_pdcch_nr_decode_multi(srsran_pdcch_nr_t*       q,
+                                 cf_t*                    slot_symbols,
+                                 srsran_dmrs_pdcch_ce_t** ce,
+                                 srsran_dci_msg_nr_t*     dci_msg,
+                                 srsran_pdcch_nr_res_t*   res,
+                                 uint32_t                 nof_msg)
+{
+  if (q == NULL || dci_msg == NULL || ce == NULL || slot_symbols == NULL || res == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  if (nof_msg == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  if (nof_msg > SRSRAN_PDCCH_NR_MAX_MULTI) {
+    ERROR("Invalid number of candidates (%d > %d)", nof_msg, SRSRAN_PDCCH_NR_MAX_MULTI);
+    return SRSRAN_ERROR;
+  }
+
+  // All the candidates must share the polar code
+  for (uint32_t i = 1; i < nof_msg; i++) {
+    if (dci_msg[i].nof_bits != dci_msg[0].nof_bits || dci_msg[i].ctx.location.L != dci_msg[0].ctx.location.L) {
+      ERROR("Candidates with different size or aggregation level can not be decoded together");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  struct timeval t[3];
+  if (q->meas_time_en) {
+    gettimeofday(&t[1], NULL);
+  }
+
+  // Calculate...
+  q->K = dci_msg[0].nof_bits + 24U;                                  // Payload size including CRC
+  q->M = (1U << dci_msg[0].ctx.location.L) * (SRSRAN_NRE - 3U) * 6U; // Number of RE
+  q->E = q->M * 2;                                                   // Number of Rate-Matched bits
+
+  // Get polar code
+  if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  PDCCH_INFO_RX("K=%d; E=%d; M=%d; n=%d;", q->K, q->E, q->M, q->code.n);
+
+  // Get the polar code LLR of every candidate
+  const int8_t* d[SRSRAN_PDCCH_NR_MAX_MULTI];
+  uint8_t*      allocated[SRSRAN_PDCCH_NR_MAX_MULTI];
+  for (uint32_t i = 0; i < nof_msg; i++) {
+    d[i]         = q->d_multi + i * NMAX;
+    allocated[i] = q->allocated_multi + i * NMAX;
+    if (pdcch_nr_decode_llr(q, slot_symbols, ce[i], &dci_msg[i], &res[i], q->d_multi + i * NMAX) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // Decode, the candidates are polar decoded at once if there are enough of them
+  srsran_polar_decoder_t* decoder = &q->decoder;
+  if (nof_msg >= PDCCH_NR_POLAR_BATCH_MIN && q->decoder_batch.ptr != NULL) {
+    decoder = &q->decoder_batch;
+  }
+  if (srsran_polar_decoder_decode_c_batch(
+          decoder, d, allocated, nof_msg, q->code.n, q->code.F_set, q->code.F_set_size) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // Check the CRC and extract the message of every candidate
+  for (uint32_t i = 0; i < nof_msg; i++) {
+    pdcch_nr_decode_msg(q, allocated[i], &dci_msg[i], &res[i]);
+  }
 
   if (q->meas_time_en) {
     gettimeofday(&t[2], NULL);
@@ -708,14 +798,25 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
   }
 
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
-    char str[128] = {};
-    srsran_pdcch_nr_info(q, res, str, sizeof(str));
-    PDCCH_INFO_RX("%s", str);
+    for (uint32_t i = 0; i < nof_msg; i++) {
+      char str[128] = {};
+      srsran_pdcch_nr_info(q, &res[i], str, sizeof(str));
+      PDCCH_INFO_RX("%s", str);
+    }
   }
 
   return SRSRAN_SUCCESS;
 }
 
+int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
+                           cf_t*                   slot_symbols,
+                           srsran_dmrs_pdcch_ce_t* ce,
+                           srsran_dci_msg_nr_t*    dci_msg,
+                           srsran_pdcch_nr_res_t*  res)
+{
+  return srsran_pdcch_nr_decode_multi(q, slot_symbols, &ce, dci_msg, res, 1);
+}
+
 uint32_t srsran_pdcch_nr_info(const srsran_pdcch_nr_t* q, const srsran_pdcch_nr_res_t* res, char* str, uint32_t str_len)
 {
   int len = 0;
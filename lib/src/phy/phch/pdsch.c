@@ -292,6 +292,10 @@ static int pdsch_init(srsran_pdsch_t* q, uint32_t max_prb, bool is_ue, uint32_t
         goto clean;
       }
 
+      if (srsran_sequence_cache_init(&q->seq_cache[i], SRSRAN_SEQUENCE_CACHE_DEFAULT_NOF_ENTRIES)) {
+        goto clean;
+      }
+
       // If it is the UE, allocate EVM buffer, for only minimum PRB
       if (is_ue) {
         q->evm_buffer[i] = srsran_evm_buffer_alloc(srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, 6));
@@ -429,6 +433,8 @@ void srsran_pdsch_free(srsran_pdsch_t* q)
     if (q->evm_buffer[i]) {
       srsran_evm_free(q->evm_buffer[i]);
     }
+
+    srsran_sequence_cache_free(&q->seq_cache[i]);
   }
 
   /* Free sch objects */
@@ -483,6 +489,144 @@ int srsran_pdsch_set_cell(srsran_pdsch_t* q, srsran_cell_t cell)
   return ret;
 }
 
+int srsran_pdsch_tb_cache_init(srsran_pdsch_tb_cache_t* q, uint32_t nof_entries)
+{
+  if (q == NULL || nof_entries == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_pdsch_tb_cache_t, 1);
+
+  q->entries = SRSRAN_MEM_ALLOC(srsran_pdsch_tb_cache_entry_t, nof_entries);
+  if (q->entries == NULL) {
+    ERROR("Error allocating transport block cache");
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(q->entries, srsran_pdsch_tb_cache_entry_t, nof_entries);
+  q->nof_entries = nof_entries;
+
+  if (pthread_mutex_init(&q->mutex, NULL)) {
+    free(q->entries);
+    q->entries = NULL;
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_pdsch_tb_cache_free(srsran_pdsch_tb_cache_t* q)
+{
+  if (q == NULL || q->entries == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < q->nof_entries; i++) {
+    if (q->entries[i].data != NULL) {
+      free(q->entries[i].data);
+    }
+    if (q->entries[i].e_bytes != NULL) {
+      free(q->entries[i].e_bytes);
+    }
+  }
+  free(q->entries);
+  pthread_mutex_destroy(&q->mutex);
+
+  SRSRAN_MEM_ZERO(q, srsran_pdsch_tb_cache_t, 1);
+}
+
+void srsran_pdsch_set_tb_cache(srsran_pdsch_t* q, srsran_pdsch_tb_cache_t* cache)
+{
+  if (q != NULL) {
+    q->tb_cache = cache;
+  }
+}
+
+static void pdsch_tb_cache_store(srsran_pdsch_tb_cache_entry_t* e,
+                                 const srsran_ra_tb_t*          tb,
+                                 uint32_t                       qm_nl,
+                                 const uint8_t*                 data,
+                                 const uint8_t*                 e_bits,
+                                 uint64_t                       clock)
+{
+  uint32_t tb_bytes = SRSRAN_CEIL(tb->tbs, 8);
+  uint32_t e_bytes  = SRSRAN_CEIL(tb->nof_bits, 8);
+  uint32_t len      = SRSRAN_MAX(tb_bytes, e_bytes);
+
+  // Make room for the TB, it is not cached if the allocation fails
+  if (e->max_len < len) {
+    if (e->data != NULL) {
+      free(e->data);
+    }
+    if (e->e_bytes != NULL) {
+      free(e->e_bytes);
+    }
+    SRSRAN_MEM_ZERO(e, srsran_pdsch_tb_cache_entry_t, 1);
+    e->data    = srsran_vec_u8_malloc(len);
+    e->e_bytes = srsran_vec_u8_malloc(len);
+    if (e->data == NULL || e->e_bytes == NULL) {
+      ERROR("Error allocating transport block cache entry");
+      return;
+    }
+    e->max_len = len;
+  }
+
+  memcpy(e->data, data, tb_bytes);
+  memcpy(e->e_bytes, e_bits, e_bytes);
+  e->tbs      = tb->tbs;
+  e->rv       = tb->rv;
+  e->nof_bits = tb->nof_bits;
+  e->qm_nl    = qm_nl;
+  e->last_use = clock;
+}
+
+/* Writes the rate matched bits of the TB to e_bits, encoding them on a cache miss. The lock is held while encoding, so
+ * the cells processed in parallel wait for the first one instead of encoding the same TB again */
+static int pdsch_tb_cache_encode(srsran_pdsch_tb_cache_t* cache,
+                                 srsran_sch_t*            dl_sch,
+                                 srsran_pdsch_cfg_t*      cfg,
+                                 uint8_t*                 data,
+                                 uint8_t*                 e_bits,
+                                 uint32_t                 tb_idx,
+                                 uint32_t                 nof_layers)
+{
+  srsran_ra_tb_t* tb       = &cfg->grant.tb[tb_idx];
+  uint32_t        qm_nl    = srsran_mod_bits_x_symbol(tb->mod) * ((nof_layers != cfg->grant.nof_tb) ? 2 : 1);
+  uint32_t        tb_bytes = SRSRAN_CEIL(tb->tbs, 8);
+  uint32_t        e_bytes  = SRSRAN_CEIL(tb->nof_bits, 8);
+  int             ret      = SRSRAN_SUCCESS;
+
+  pthread_mutex_lock(&cache->mutex);
+  cache->clock++;
+
+  // Look up the TB, keeping track of the least recently used entry
+  srsran_pdsch_tb_cache_entry_t* victim = &cache->entries[0];
+  for (uint32_t i = 0; i < cache->nof_entries; i++) {
+    srsran_pdsch_tb_cache_entry_t* e = &cache->entries[i];
+    if (e->last_use != 0 && e->tbs == (uint32_t)tb->tbs && e->rv == (uint32_t)tb->rv && e->nof_bits == tb->nof_bits &&
+        e->qm_nl == qm_nl && memcmp(e->data, data, tb_bytes) == 0) {
+      e->last_use = cache->clock;
+      cache->nof_hits++;
+      memcpy(e_bits, e->e_bytes, e_bytes);
+      pthread_mutex_unlock(&cache->mutex);
+      return SRSRAN_SUCCESS;
+    }
+    if (e->last_use < victim->last_use) {
+      victim = e;
+    }
+  }
+
+  cache->nof_misses++;
+
+  if (srsran_dlsch_encode2(dl_sch, cfg, data, e_bits, tb_idx, nof_layers)) {
+    ret = SRSRAN_ERROR;
+  } else {
+    pdsch_tb_cache_store(victim, tb, qm_nl, data, e_bits, cache->clock);
+  }
+
+  pthread_mutex_unlock(&cache->mutex);
+  return ret;
+}
+
 static float apply_power_allocation(srsran_pdsch_t* q, srsran_pdsch_cfg_t* cfg, cf_t* sf_symbols_m[SRSRAN_MAX_PORTS])
 {
   uint32_t nof_symbols_slot = cfg->grant.nof_symb_slot[0];
@@ -714,22 +858,20 @@ static int srsran_pdsch_codeword_decode(srsran_pdsch_t*     q,
     }
 
     /* Bit scrambling */
+    const uint8_t* c = srsran_sequence_pdsch_cache_get(&q->seq_cache[codeword_idx],
+                                                       cfg->rnti,
+                                                       codeword_idx,
+                                                       2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
+                                                       q->cell.id,
+                                                       cfg->grant.tb[tb_idx].nof_bits);
+    if (c == NULL) {
+      ERROR("Error generating scrambling sequence");
+      return SRSRAN_ERROR;
+    }
     if (q->llr_is_8bit) {
-      srsran_sequence_pdsch_apply_c(q->e[codeword_idx],
-                                    q->e[codeword_idx],
-                                    cfg->rnti,
-                                    codeword_idx,
-                                    2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                    q->cell.id,
-                                    cfg->grant.tb[tb_idx].nof_bits);
+      srsran_sequence_bytes_apply_c(c, q->e[codeword_idx], q->e[codeword_idx], cfg->grant.tb[tb_idx].nof_bits);
     } else {
-      srsran_sequence_pdsch_apply_s(q->e[codeword_idx],
-                                    q->e[codeword_idx],
-                                    cfg->rnti,
-                                    codeword_idx,
-                                    2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                    q->cell.id,
-                                    cfg->grant.tb[tb_idx].nof_bits);
+      srsran_sequence_bytes_apply_s(c, q->e[codeword_idx], q->e[codeword_idx], cfg->grant.tb[tb_idx].nof_bits);
     }
 
     if (cfg->csi_enable) {
@@ -909,6 +1051,7 @@ int srsran_pdsch_decode(srsran_pdsch_t*        q,
             ret = srsran_pdsch_codeword_decode(q, sf, cfg, &q->dl_sch, data, tb_idx, &data[tb_idx].crc);
 
             data[tb_idx].avg_iterations_block = srsran_sch_last_noi(&q->dl_sch);
+            data[tb_idx].fec_time_ns          = srsran_sch_last_decode_time_ns(&q->dl_sch);
           }
 
           /* Check if there has been any execution error */
@@ -930,6 +1073,7 @@ int srsran_pdsch_decode(srsran_pdsch_t*        q,
           ERROR("PDSCH Coworker Decoder: Error decoding");
         }
         data[h->tb_idx].avg_iterations_block = srsran_sch_last_noi(&q->dl_sch);
+        data[h->tb_idx].fec_time_ns          = srsran_sch_last_decode_time_ns(&h->dl_sch);
         h->started                           = false;
       }
     }
@@ -988,20 +1132,31 @@ static int srsran_pdsch_codeword_encode(srsran_pdsch_t*         q,
            rv);
     }
 
-    /* Channel coding */
-    if (srsran_dlsch_encode2(&q->dl_sch, cfg, data, q->e[codeword_idx], tb_idx, nof_layers)) {
+    /* Channel coding, the broadcast TB are shared with the cells using the same cache */
+    int ret;
+    if (q->tb_cache != NULL && data != NULL && (cfg->rnti == SRSRAN_SIRNTI || cfg->rnti == SRSRAN_PRNTI)) {
+      ret = pdsch_tb_cache_encode(q->tb_cache, &q->dl_sch, cfg, data, q->e[codeword_idx], tb_idx, nof_layers);
+    } else {
+      ret = srsran_dlsch_encode2(&q->dl_sch, cfg, data, q->e[codeword_idx], tb_idx, nof_layers);
+    }
+    if (ret) {
       ERROR("Error encoding (TB%d -> CW%d)", tb_idx, codeword_idx);
       return SRSRAN_ERROR;
     }
 
     /* Bit scrambling */
-    srsran_sequence_pdsch_apply_pack((uint8_t*)q->e[codeword_idx],
-                                     (uint8_t*)q->e[codeword_idx],
-                                     cfg->rnti,
-                                     codeword_idx,
-                                     2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                     q->cell.id,
-                                     cfg->grant.tb[tb_idx].nof_bits);
+    const uint8_t* c = srsran_sequence_pdsch_cache_get(&q->seq_cache[codeword_idx],
+                                                       cfg->rnti,
+                                                       codeword_idx,
+                                                       2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
+                                                       q->cell.id,
+                                                       cfg->grant.tb[tb_idx].nof_bits);
+    if (c == NULL) {
+      ERROR("Error generating scrambling sequence");
+      return SRSRAN_ERROR;
+    }
+    srsran_sequence_bytes_apply_packed(
+        c, (uint8_t*)q->e[codeword_idx], (uint8_t*)q->e[codeword_idx], cfg->grant.tb[tb_idx].nof_bits);
 
     /* Bit mapping */
     srsran_mod_modulate_bytes(
@@ -1021,9 +1176,7 @@ int srsran_pdsch_encode(srsran_pdsch_t*     q,
                         cf_t*               sf_symbols[SRSRAN_MAX_PORTS])
 {
   int i;
-  /* Set pointers for layermapping & precoding */
-  cf_t* x[SRSRAN_MAX_LAYERS];
-  int   ret = SRSRAN_ERROR_INVALID_INPUTS;
+  int ret = SRSRAN_ERROR_INVALID_INPUTS;
 
   if (q != NULL && cfg != NULL) {
     struct timeval t[3];
@@ -1081,52 +1234,30 @@ int srsran_pdsch_encode(srsran_pdsch_t*     q,
            srsran_mimotype2str(cfg->grant.tx_scheme));
     }
 
-    // Layer mapping & precode if necessary
+    // Layer mapping & precode if necessary, the layers are read straight from the codewords
+    cf_t** symbols = q->symbols;
     if (q->cell.nof_ports > 1) {
-      int nof_symbols;
-      /* If number of layers is equal to transport blocks (codewords) skip layer mapping */
-      if (cfg->grant.nof_layers == nof_tb) {
-        for (i = 0; i < cfg->grant.nof_layers; i++) {
-          x[i] = q->d[i];
-        }
-        nof_symbols = cfg->grant.nof_re;
-      } else {
-        /* Initialise layer map pointers */
-        for (i = 0; i < cfg->grant.nof_layers; i++) {
-          x[i] = q->x[i];
-        }
-        memset(&x[cfg->grant.nof_layers], 0, sizeof(cf_t*) * (SRSRAN_MAX_LAYERS - cfg->grant.nof_layers));
-
-        nof_symbols = srsran_layermap_type(q->d,
-                                           x,
-                                           nof_tb,
-                                           cfg->grant.nof_layers,
-                                           (int[SRSRAN_MAX_CODEWORDS]){cfg->grant.nof_re, cfg->grant.nof_re},
-                                           cfg->grant.tx_scheme);
-      }
-
-      /* Precode */
       uint32_t codebook_idx = nof_tb == 1 ? cfg->grant.pmi : (cfg->grant.pmi + 1);
-      srsran_precoding_type(x,
-                            q->symbols,
-                            cfg->grant.nof_layers,
-                            q->cell.nof_ports,
-                            codebook_idx,
-                            nof_symbols,
-                            scaling,
-                            cfg->grant.tx_scheme);
+      srsran_precoding_cw_type(q->d,
+                               q->symbols,
+                               nof_tb,
+                               cfg->grant.nof_layers,
+                               q->cell.nof_ports,
+                               codebook_idx,
+                               cfg->grant.nof_re,
+                               scaling,
+                               cfg->grant.tx_scheme);
+    } else if (scaling != 1.0f) {
+      srsran_vec_sc_prod_cfc(q->d[0], scaling, q->symbols[0], cfg->grant.nof_re);
     } else {
-      if (scaling == 1.0f) {
-        memcpy(q->symbols[0], q->d[0], cfg->grant.nof_re * sizeof(cf_t));
-      } else {
-        srsran_vec_sc_prod_cfc(q->d[0], scaling, q->symbols[0], cfg->grant.nof_re);
-      }
+      // Single port without scaling, the modulated symbols are mapped without copying them
+      symbols = q->d;
     }
 
     /* mapping to resource elements */
     uint32_t lstart = SRSRAN_NOF_CTRL_SYMBOLS(q->cell, sf->cfi);
     for (i = 0; i < q->cell.nof_ports; i++) {
-      srsran_pdsch_put(q, q->symbols[i], sf_symbols[i], &cfg->grant, lstart, sf->tti % 10);
+      srsran_pdsch_put(q, symbols[i], sf_symbols[i], &cfg->grant, lstart, sf->tti % 10);
     }
 
     if (cfg->meas_time_en) {
@@ -570,6 +570,15 @@ int srsran_prach_init(srsran_prach_t* p, uint32_t max_N_ifft_ul)
     p->cross      = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
     p->corr_freq  = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
 
+    // Set up the batched correlation containers, the IFFT is planned in set_cell() once the number of roots is known
+    p->corr_spec_batch = srsran_vec_cf_malloc(N_SEQS * SRSRAN_PRACH_N_ZC_LONG);
+    p->corr_td_batch   = srsran_vec_cf_malloc(N_SEQS * SRSRAN_PRACH_N_ZC_LONG);
+    p->corr_batch      = srsran_vec_f_malloc(N_SEQS * SRSRAN_PRACH_N_ZC_LONG);
+    if (!p->corr_spec_batch || !p->corr_td_batch || !p->corr_batch) {
+      ERROR("Error allocating memory");
+      return SRSRAN_ERROR;
+    }
+
     // Set up ZC FFTS
     if (srsran_dft_plan(&p->zc_fft, SRSRAN_PRACH_N_ZC_LONG, SRSRAN_DFT_FORWARD, SRSRAN_DFT_COMPLEX)) {
       return SRSRAN_ERROR;
@@ -696,6 +705,38 @@ int srsran_prach_set_cell_(srsran_prach_t*      p,
       p->num_ra_preambles = p->N_roots;
     }
 
+    // Plan a single IFFT for the correlations of all the roots, keeping the plan if the shape did not change
+    uint32_t nof_batch_roots = SRSRAN_MIN(p->num_ra_preambles, N_SEQS);
+    if (p->zc_ifft_batch.size == 0) {
+      if (srsran_dft_plan_guru_c(&p->zc_ifft_batch,
+                                 p->N_zc,
+                                 SRSRAN_DFT_BACKWARD,
+                                 p->corr_spec_batch,
+                                 p->corr_td_batch,
+                                 1,
+                                 1,
+                                 nof_batch_roots,
+                                 p->N_zc,
+                                 p->N_zc)) {
+        ERROR("Error creating batched DFT plan");
+        return SRSRAN_ERROR;
+      }
+    } else if (p->zc_ifft_batch.size != p->N_zc || p->nof_batch_roots != nof_batch_roots) {
+      if (srsran_dft_replan_guru_c(&p->zc_ifft_batch,
+                                   p->N_zc,
+                                   p->corr_spec_batch,
+                                   p->corr_td_batch,
+                                   1,
+                                   1,
+                                   nof_batch_roots,
+                                   p->N_zc,
+                                   p->N_zc)) {
+        ERROR("Error creating batched DFT plan");
+        return SRSRAN_ERROR;
+      }
+    }
+    p->nof_batch_roots = nof_batch_roots;
+
     // Create our FFT objects and buffers
     p->N_ifft_ul = N_ifft_ul;
     if (4 == preamble_format) {
@@ -879,31 +920,28 @@ int srsran_prach_process(srsran_prach_t* p,
 {
   float max_to_cancel = 0;
   cancellation_idx    = -1;
-  int max_idx         = 0;
   srsran_vec_cf_zero(p->cross, p->N_zc);
-  srsran_vec_cf_zero(p->corr_freq, p->N_zc);
-  for (int i = 0; i < p->num_ra_preambles; i++) {
-    cf_t* root_spec = get_precoded_dft(p, p->root_seqs_idx[i]);
-
-    srsran_vec_prod_conj_ccc(p->prach_bins, root_spec, p->corr_spec, p->N_zc);
 
-    srsran_vec_prod_conj_ccc(p->corr_spec, &p->corr_spec[1], p->cross, p->N_zc - 1);
-    if (p->successive_cancellation) {
-      srsran_vec_cf_copy(p->corr_freq, p->corr_spec, p->N_zc);
-    }
-    srsran_dft_run(&p->zc_ifft, p->corr_spec, p->corr_spec);
+  // Correlate the received bins with every root, then bring all the correlations to time domain with one IFFT
+  for (int i = 0; i < p->nof_batch_roots; i++) {
+    srsran_vec_prod_conj_ccc(
+        p->prach_bins, get_precoded_dft(p, p->root_seqs_idx[i]), &p->corr_spec_batch[i * p->N_zc], p->N_zc);
+  }
+  srsran_dft_run_guru_c(&p->zc_ifft_batch);
+  srsran_vec_abs_square_cf(p->corr_td_batch, p->corr_batch, p->nof_batch_roots * p->N_zc);
 
-    srsran_vec_abs_square_cf(p->corr_spec, p->corr, p->N_zc);
+  uint32_t winsize = (p->N_cs != 0) ? p->N_cs : p->N_zc;
+  uint32_t n_wins  = p->N_zc / winsize;
 
-    float corr_ave = srsran_vec_acc_ff(p->corr, p->N_zc) / p->N_zc;
+  for (int i = 0; i < p->nof_batch_roots; i++) {
+    cf_t*  corr_spec = &p->corr_spec_batch[i * p->N_zc];
+    float* corr      = &p->corr_batch[i * p->N_zc];
 
-    uint32_t winsize = 0;
-    if (p->N_cs != 0) {
-      winsize = p->N_cs;
-    } else {
-      winsize = p->N_zc;
+    if (p->freq_domain_offset_calc) {
+      srsran_vec_prod_conj_ccc(corr_spec, &corr_spec[1], p->cross, p->N_zc - 1);
     }
-    uint32_t n_wins = p->N_zc / winsize;
+
+    float corr_ave = srsran_vec_acc_ff(corr, p->N_zc) / p->N_zc;
 
     float max_peak = 0;
     for (int j = 0; j < n_wins; j++) {
@@ -914,14 +952,12 @@ int srsran_prach_process(srsran_prach_t* p,
       }
       start += p->deadzone;
       p->peak_values[j] = 0;
-      for (int k = start; k < end; k++) {
-        if (p->corr[k] > p->peak_values[j]) {
-          p->peak_values[j]  = p->corr[k];
-          p->peak_offsets[j] = k - start;
-          if (p->peak_values[j] > max_peak) {
-            max_peak = p->peak_values[j];
-            max_idx  = k;
-          }
+      if (end > start) {
+        uint32_t k = srsran_vec_max_fi(&corr[start], end - start);
+        if (corr[start + k] > 0) {
+          p->peak_values[j]  = corr[start + k];
+          p->peak_offsets[j] = k;
+          max_peak           = SRSRAN_MAX(max_peak, p->peak_values[j]);
         }
       }
     }
@@ -935,7 +971,7 @@ int srsran_prach_process(srsran_prach_t* p,
                 max_to_cancel          = max_peak;
                 p->prach_cancel.idx    = cancellation_idx;
                 p->prach_cancel.factor = (sqrt(max_peak / (p->N_zc * p->N_zc)));
-                srsran_prach_calculate_correction_array(p, p->corr_freq);
+                srsran_prach_calculate_correction_array(p, corr_spec);
               }
               if (srsran_prach_have_stored(((i * n_wins) + j), indices, *n_indices)) {
                 break;
@@ -1021,6 +1057,10 @@ int srsran_prach_free(srsran_prach_t* p)
   free(p->ifft_out);
   free(p->cross);
   free(p->corr_freq);
+  free(p->corr_spec_batch);
+  free(p->corr_td_batch);
+  free(p->corr_batch);
+  srsran_dft_plan_free(&p->zc_ifft_batch);
   srsran_dft_plan_free(&p->fft);
   srsran_dft_plan_free(&p->zc_fft);
   srsran_dft_plan_free(&p->zc_ifft);
@@ -23,6 +23,7 @@
 #include "srsran/srsran.h"
 #include <assert.h>
 #include <complex.h>
+#include <float.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -69,6 +70,17 @@ int srsran_pucch_init_(srsran_pucch_t* q, bool is_ue)
 
     if (!q->is_ue) {
       q->ce = srsran_vec_cf_malloc(SRSRAN_PUCCH_MAX_SYMBOLS);
+
+      q->batch_corr =
+          srsran_vec_cf_malloc(SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_MAX_PRB * SRSRAN_CP_NORM_NSYMB * SRSRAN_NRE);
+      if (q->batch_corr == NULL) {
+        goto clean_exit;
+      }
+      for (uint32_t k = 0; k < SRSRAN_NRE; k++) {
+        for (uint32_t n = 0; n < SRSRAN_NRE; n++) {
+          q->batch_dft[k][n] = cexpf(-I * 2 * M_PI * ((k * n) % SRSRAN_NRE) / SRSRAN_NRE);
+        }
+      }
     }
 
     ret = SRSRAN_SUCCESS;
@@ -104,6 +116,9 @@ void srsran_pucch_free(srsran_pucch_t* q)
   if (q->ce) {
     free(q->ce);
   }
+  if (q->batch_corr) {
+    free(q->batch_corr);
+  }
 
   srsran_modem_table_free(&q->mod);
   bzero(q, sizeof(srsran_pucch_t));
@@ -208,6 +223,12 @@ static const uint32_t pucch_symbol_format1_cpext[4]    = {0, 1, 4, 5};
 static const uint32_t pucch_symbol_format2_3_cpnorm[5] = {0, 2, 3, 4, 6};
 static const uint32_t pucch_symbol_format2_3_cpext[5]  = {0, 1, 2, 4, 5};
 
+/* Orthogonal sequences of the format 1 DMRS, Table 5.5.2.2.1-2 of 36.211 (complex argument) */
+static const float w_dmrs_format1_cpnorm[3][3] = {{0, 0, 0},
+                                                  {0, 2 * M_PI / 3, 4 * M_PI / 3},
+                                                  {0, 4 * M_PI / 3, 2 * M_PI / 3}};
+static const float w_dmrs_format1_cpext[3][2]  = {{0, 0}, {0, M_PI}, {0, 0}};
+
 static const float w_n_oc[2][3][4] = {
     // Table 5.4.1-2 Orthogonal sequences w for N_sf=4 (complex argument)
     {{0, 0, 0, 0}, {0, M_PI, 0, M_PI}, {0, M_PI, M_PI, 0}},
@@ -871,6 +892,230 @@ int srsran_pucch_decode(srsran_pucch_t*        q,
   return ret;
 }
 
+/* Returns the correlations of every symbol of a PRB in a slot with the 12 cyclic shifts of the base sequence u. They
+ * are computed the first time the PRB is used in the batch and shared by all the resources multiplexed in it. */
+static const cf_t* batch_prb_corr(srsran_pucch_t* q, const cf_t* sf_symbols, uint32_t ns, uint32_t n_prb, uint32_t u)
+{
+  uint32_t nsymbols = SRSRAN_CP_NSYMB(q->cell.cp);
+  cf_t*    corr = &q->batch_corr[((ns % 2) * SRSRAN_MAX_PRB + n_prb) * SRSRAN_CP_NORM_NSYMB * SRSRAN_NRE];
+
+  if (q->batch_corr_u[ns % 2][n_prb] == u) {
+    return corr;
+  }
+
+  cf_t r_u[SRSRAN_NRE];
+  cf_t y[SRSRAN_NRE];
+  srsran_zc_sequence_generate_lte(u, 0, 0.0f, 1, r_u);
+
+  for (uint32_t l = 0; l < nsymbols; l++) {
+    srsran_vec_prod_conj_ccc(
+        &sf_symbols[SRSRAN_RE_IDX(q->cell.nof_prb, l + (ns % 2) * nsymbols, n_prb * SRSRAN_NRE)], r_u, y, SRSRAN_NRE);
+    for (uint32_t k = 0; k < SRSRAN_NRE; k++) {
+      corr[l * SRSRAN_NRE + k] = srsran_vec_dot_prod_ccc(y, q->batch_dft[k], SRSRAN_NRE);
+    }
+  }
+  q->batch_corr_u[ns % 2][n_prb] = u;
+
+  return corr;
+}
+
+static uint32_t batch_alpha_to_n_cs(float alpha)
+{
+  return (uint32_t)roundf(alpha * SRSRAN_NRE / (2 * M_PI)) % SRSRAN_NRE;
+}
+
+static int batch_decode_format1(srsran_pucch_t*     q,
+                                srsran_ul_sf_cfg_t* sf,
+                                srsran_pucch_cfg_t* cfg,
+                                const cf_t*         sf_symbols,
+                                srsran_pucch_res_t* res)
+{
+  uint8_t pucch_bits[SRSRAN_CQI_MAX_BITS] = {};
+
+  uint32_t sf_idx   = sf->tti % SRSRAN_NOF_SF_X_FRAME;
+  uint32_t N_rs     = srsran_refsignal_dmrs_N_rs(cfg->format, q->cell.cp);
+  uint32_t nof_data = 0;
+
+  cf_t  data_acc  = 0; // Data correlation weighted by the channel of each slot
+  float data_pow  = 0; // Data energy weighted by the channel power of each slot
+  float dmrs_pow  = 0; // Energy of the despread DMRS around the resource cyclic shift
+  float dmrs_corr = 0; // Energy of the despread DMRS in the resource cyclic shift
+  float dmrs_epre = 0; // Received energy in the DMRS symbols
+  cf_t  dmrs_ta   = 0; // Autocorrelation of the despread DMRS between adjacent subcarriers
+
+  for (uint32_t ns = SRSRAN_NOF_SLOTS_PER_SF * sf_idx; ns < SRSRAN_NOF_SLOTS_PER_SF * (sf_idx + 1); ns++) {
+    uint32_t n_prb = srsran_pucch_n_prb(&q->cell, cfg, ns);
+    if (n_prb >= q->cell.nof_prb) {
+      ERROR("Invalid PUCCH n_prb=%d", n_prb);
+      return SRSRAN_ERROR;
+    }
+
+    uint32_t f_gh = 0;
+    if (cfg->group_hopping_en) {
+      f_gh = q->f_gh[ns];
+    }
+    uint32_t    u    = (f_gh + (q->cell.id % 30)) % 30;
+    const cf_t* corr = batch_prb_corr(q, sf_symbols, ns, n_prb, u);
+
+    // Remove the DMRS orthogonal cover. Every symbol may have a different cyclic shift, so the bins are aligned with
+    // the resource cyclic shift in Z[0]
+    cf_t Z[SRSRAN_NRE] = {};
+    for (uint32_t m = 0; m < N_rs; m++) {
+      uint32_t l     = srsran_refsignal_dmrs_pucch_symbol(m, cfg->format, q->cell.cp);
+      uint32_t n_oc  = 0;
+      float    alpha = srsran_pucch_alpha_format1(q->n_cs_cell, cfg, q->cell.cp, true, ns, l, &n_oc, NULL);
+      uint32_t n_cs  = batch_alpha_to_n_cs(alpha);
+
+      float w      = SRSRAN_CP_ISNORM(q->cell.cp) ? w_dmrs_format1_cpnorm[n_oc][m] : w_dmrs_format1_cpext[n_oc][m];
+      cf_t  w_conj = cexpf(-I * w);
+      for (uint32_t j = 0; j < SRSRAN_NRE; j++) {
+        cf_t y = corr[l * SRSRAN_NRE + (n_cs + j) % SRSRAN_NRE];
+        Z[j] += y * w_conj;
+        dmrs_epre += __real__ y * __real__ y + __imag__ y * __imag__ y;
+      }
+    }
+
+    // Slot channel estimate, scaled by the number of DMRS resource elements. The adjacent bins carry the channel delay
+    // spread and the noise, the rest belong to other cyclic shifts, possibly used by other UE
+    cf_t h = Z[0];
+    for (int j = -1; j <= 1; j++) {
+      cf_t  z   = Z[(SRSRAN_NRE + j) % SRSRAN_NRE];
+      float pow = __real__ z * __real__ z + __imag__ z * __imag__ z;
+      dmrs_pow += pow;
+      dmrs_ta += pow * cexpf(I * 2 * M_PI * j / SRSRAN_NRE);
+    }
+    dmrs_corr += __real__ h * __real__ h + __imag__ h * __imag__ h;
+
+    // Remove the data orthogonal cover
+    uint32_t N_sf      = get_N_sf(cfg->format, ns % 2, sf->shortened);
+    uint32_t N_sf_widx = N_sf == 3 ? 1 : 0;
+    cf_t     x         = 0;
+    float    x_pow     = 0;
+    for (uint32_t m = 0; m < N_sf; m++) {
+      uint32_t l          = get_pucch_symbol(m, cfg->format, q->cell.cp);
+      uint32_t n_oc       = 0;
+      uint32_t n_prime_ns = 0;
+      float    alpha = srsran_pucch_alpha_format1(q->n_cs_cell, cfg, q->cell.cp, true, ns, l, &n_oc, &n_prime_ns);
+      uint32_t n_cs  = batch_alpha_to_n_cs(alpha);
+      float    S_ns  = (n_prime_ns % 2) ? M_PI / 2 : 0;
+      x += corr[l * SRSRAN_NRE + n_cs] * cexpf(-I * (w_n_oc[N_sf_widx][n_oc % 3][m] + S_ns));
+      x_pow += srsran_vec_avg_power_cf(&corr[l * SRSRAN_NRE], SRSRAN_NRE);
+    }
+    nof_data += N_sf * SRSRAN_NRE;
+
+    // Matched filter with the slot channel estimate
+    float h_pow = __real__ h * __real__ h + __imag__ h * __imag__ h;
+    data_acc += conjf(h) * x;
+    data_pow += h_pow * x_pow;
+  }
+
+  // Measurements, the DFT scales the energy by SRSRAN_NRE and the noise is measured in the two adjacent bins
+  float epre            = dmrs_epre / (SRSRAN_NRE * SRSRAN_NOF_SLOTS_PER_SF * N_rs * SRSRAN_NRE);
+  float noise           = (dmrs_pow - dmrs_corr) / (SRSRAN_NRE * SRSRAN_NOF_SLOTS_PER_SF * N_rs * 2);
+  noise                 = isnormal(noise) ? noise : FLT_MIN;
+  res->rssi_dbFs        = srsran_convert_power_to_dB(epre);
+  res->ni_dbFs          = srsran_convert_power_to_dBm(noise);
+  res->snr_db           = srsran_convert_power_to_dB(epre / noise);
+  res->dmrs_correlation = dmrs_corr / dmrs_pow;
+
+  // Estimate time alignment from the phase slope of the despread DMRS across subcarriers
+  if (cfg->meas_ta_en) {
+    float ta_err = -cargf(dmrs_ta) * M_1_PI * 0.5f;
+    if (isnormal(ta_err)) {
+      ta_err /= 15e3f;                             // Convert from normalized frequency to seconds
+      ta_err *= 1e6f;                              // Convert to micro-seconds
+      ta_err     = roundf(ta_err * 10.0f) / 10.0f; // Round to one tenth of micro-second
+      res->ta_us = ta_err;
+    } else {
+      res->ta_us = 0.0f;
+    }
+    res->ta_valid = true;
+  }
+
+  // Perform DMRS Detection, if enabled
+  if (isnormal(cfg->threshold_dmrs_detection)) {
+    if (!isnormal(res->dmrs_correlation) || res->dmrs_correlation < cfg->threshold_dmrs_detection) {
+      res->correlation = 0.0f;
+      res->detected    = false;
+      return SRSRAN_SUCCESS;
+    }
+  }
+
+  // ML decision over the modulation hypotheses, normalised as srsran_vec_corr_ccc()
+  float norm  = sqrtf(data_pow * nof_data);
+  float corr  = 0;
+  bool  found = false;
+  switch (cfg->format) {
+    case SRSRAN_PUCCH_FORMAT_1:
+      corr  = __real__ data_acc / norm;
+      found = corr >= cfg->threshold_format1;
+      break;
+    case SRSRAN_PUCCH_FORMAT_1A:
+    case SRSRAN_PUCCH_FORMAT_1B:
+      corr = -1e9;
+      for (uint32_t i = 0; i < (cfg->format == SRSRAN_PUCCH_FORMAT_1A ? 2 : 4); i++) {
+        uint8_t b[2] = {i % 2, i / 2};
+        cf_t    d    = (cfg->format == SRSRAN_PUCCH_FORMAT_1A) ? uci_encode_format1a(b[0]) : uci_encode_format1b(b);
+        float   c    = __real__(conjf(d) * data_acc) / norm;
+        if (c > corr) {
+          corr          = c;
+          pucch_bits[0] = b[0];
+          pucch_bits[1] = b[1];
+        }
+      }
+      found = corr > cfg->threshold_format1;
+      break;
+    default:
+      ERROR("PUCCH format %s not supported by the batched detector", srsran_pucch_format_text(cfg->format));
+      return SRSRAN_ERROR;
+  }
+  if (!isnormal(corr)) {
+    corr  = 0.0f;
+    found = false;
+  }
+
+  // Convert bits to UCI data
+  decode_bits(cfg, found, pucch_bits, cfg->pucch2_drs_bits, &res->uci_data);
+
+  res->correlation = corr;
+  res->detected    = found;
+  if (cfg->format != SRSRAN_PUCCH_FORMAT_1) {
+    res->uci_data.ack.valid = res->correlation > cfg->threshold_data_valid_format1a;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pucch_decode_format1_batch(srsran_pucch_t*     q,
+                                      srsran_ul_sf_cfg_t* sf,
+                                      srsran_pucch_cfg_t* cfg,
+                                      cf_t*               sf_symbols,
+                                      srsran_pucch_res_t* res,
+                                      uint32_t            nof_cfg)
+{
+  if (q == NULL || sf == NULL || sf_symbols == NULL || (nof_cfg > 0 && (cfg == NULL || res == NULL)) ||
+      q->batch_corr == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Invalidate the correlations of the previous batch
+  for (uint32_t ns = 0; ns < SRSRAN_NOF_SLOTS_PER_SF; ns++) {
+    for (uint32_t n_prb = 0; n_prb < SRSRAN_MAX_PRB; n_prb++) {
+      q->batch_corr_u[ns][n_prb] = UINT32_MAX;
+    }
+  }
+
+  for (uint32_t i = 0; i < nof_cfg; i++) {
+    res[i] = (srsran_pucch_res_t){};
+    if (batch_decode_format1(q, sf, &cfg[i], sf_symbols, &res[i]) < SRSRAN_SUCCESS) {
+      ERROR("Error decoding PUCCH rnti=0x%x, n_pucch=%d", cfg[i].rnti, cfg[i].n_pucch);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 char* srsran_pucch_format_text(srsran_pucch_format_t format)
 {
   char* ret = NULL;
@@ -43,12 +43,15 @@
 
 #define ACK_SNR_TH -1.0
 
-/* Allocate/deallocate PUSCH RBs to the resource grid
+/* Allocate/deallocate PUSCH RBs to the resource grid. When getting, the RE are written in split layout to output_re
+ * and output_im if they are not NULL.
  */
 static int pusch_cp(srsran_pusch_t*       q,
                     srsran_pusch_grant_t* grant,
                     cf_t*                 input,
                     cf_t*                 output,
+                    float*                output_re,
+                    float*                output_im,
                     bool                  is_shortened,
                     bool                  advance_input)
 {
@@ -78,7 +81,12 @@ static int pusch_cp(srsran_pusch_t*       q,
         } else {
           in_ptr = &input[idx];
         }
-        memcpy(out_ptr, in_ptr, grant->L_prb * SRSRAN_NRE * sizeof(cf_t));
+        if (output_re != NULL && output_im != NULL) {
+          uint32_t offset = out_ptr - output;
+          srsran_vec_cf_to_split(in_ptr, &output_re[offset], &output_im[offset], grant->L_prb * SRSRAN_NRE);
+        } else {
+          memcpy(out_ptr, in_ptr, grant->L_prb * SRSRAN_NRE * sizeof(cf_t));
+        }
         if (advance_input) {
           in_ptr += grant->L_prb * SRSRAN_NRE;
         } else {
@@ -96,12 +104,16 @@ static int pusch_cp(srsran_pusch_t*       q,
 
 static int pusch_put(srsran_pusch_t* q, srsran_pusch_grant_t* grant, cf_t* input, cf_t* output, bool is_shortened)
 {
-  return pusch_cp(q, grant, input, output, is_shortened, true);
+  return pusch_cp(q, grant, input, output, NULL, NULL, is_shortened, true);
 }
 
+// Gets the PUSCH RE in split layout, the real parts are stored in the first half of output and the imaginary in the
+// second half
 static int pusch_get(srsran_pusch_t* q, srsran_pusch_grant_t* grant, cf_t* input, cf_t* output, bool is_shortened)
 {
-  return pusch_cp(q, grant, input, output, is_shortened, false);
+  float* re = (float*)output;
+  float* im = re + q->max_re;
+  return pusch_cp(q, grant, input, output, re, im, is_shortened, false);
 }
 
 /** Initializes the PDCCH transmitter and receiver */
@@ -166,6 +178,10 @@ static int pusch_init(srsran_pusch_t* q, uint32_t max_prb, bool is_ue)
       goto clean;
     }
 
+    if (srsran_sequence_cache_init(&q->seq_cache, SRSRAN_SEQUENCE_CACHE_DEFAULT_NOF_ENTRIES)) {
+      goto clean;
+    }
+
     ret = SRSRAN_SUCCESS;
   }
 clean:
@@ -208,6 +224,7 @@ void srsran_pusch_free(srsran_pusch_t* q)
     srsran_evm_free(q->evm_buffer);
   }
   srsran_dft_precoding_free(&q->dft_precoding);
+  srsran_sequence_cache_free(&q->seq_cache);
 
   for (i = 0; i < SRSRAN_MOD_NITEMS; i++) {
     srsran_modem_table_free(&q->mod[i]);
@@ -305,12 +322,13 @@ int srsran_pusch_encode(srsran_pusch_t*      q,
     uint32_t nof_ri_ack_bits = (uint32_t)ret;
 
     // Run scrambling
-    srsran_sequence_pusch_apply_pack((uint8_t*)q->q,
-                                     (uint8_t*)q->q,
-                                     cfg->rnti,
-                                     2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                     q->cell.id,
-                                     cfg->grant.tb.nof_bits);
+    const uint8_t* c = srsran_sequence_pusch_cache_get(
+        &q->seq_cache, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+    if (c == NULL) {
+      ERROR("Error generating scrambling sequence");
+      return SRSRAN_ERROR;
+    }
+    srsran_sequence_bytes_apply_packed(c, (uint8_t*)q->q, (uint8_t*)q->q, cfg->grant.tb.nof_bits);
 
     // Correct UCI placeholder/repetition bits
     uint8_t* d = q->q;
@@ -388,16 +406,20 @@ int srsran_pusch_decode(srsran_pusch_t*        q,
          cfg->grant.tb.nof_bits,
          cfg->grant.tb.rv);
 
-    /* extract symbols */
+    /* extract symbols, the symbols and channel estimates are split while they are copied so that the equalizer does
+     * not need to deinterleave them */
     n = pusch_get(q, &cfg->grant, sf_symbols, q->d, sf->shortened);
     if (n != cfg->grant.nof_re) {
       ERROR("Error expecting %d symbols but got %d", cfg->grant.nof_re, n);
       return SRSRAN_ERROR;
     }
+    const float* d_re = (const float*)q->d;
+    const float* d_im = d_re + q->max_re;
 
     // Measure Energy per Resource Element
     if (cfg->meas_epre_en) {
-      out->epre_dbfs = srsran_convert_power_to_dB(srsran_vec_avg_power_cf(q->d, n));
+      float epre     = (srsran_vec_dot_prod_fff(d_re, d_re, n) + srsran_vec_dot_prod_fff(d_im, d_im, n)) / n;
+      out->epre_dbfs = srsran_convert_power_to_dB(epre);
     } else {
       out->epre_dbfs = NAN;
     }
@@ -408,9 +430,12 @@ int srsran_pusch_decode(srsran_pusch_t*        q,
       ERROR("Error expecting %d symbols but got %d", cfg->grant.nof_re, n);
       return SRSRAN_ERROR;
     }
+    const float* ce_re = (const float*)q->ce;
+    const float* ce_im = ce_re + q->max_re;
 
     // Equalization
-    srsran_predecoding_single(q->d, q->ce, q->z, NULL, cfg->grant.nof_re, 1.0f, channel->noise_estimate);
+    srsran_predecoding_single_split(
+        d_re, d_im, ce_re, ce_im, q->z, NULL, cfg->grant.nof_re, 1.0f, channel->noise_estimate);
 
     // DFT predecoding
     srsran_dft_precoding(&q->dft_precoding, q->z, q->d, cfg->grant.L_prb, cfg->grant.nof_symb);
@@ -433,18 +458,21 @@ int srsran_pusch_decode(srsran_pusch_t*        q,
     }
 
     // Descrambling
+    const uint8_t* c_bytes = srsran_sequence_pusch_cache_get(
+        &q->seq_cache, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+    if (c_bytes == NULL) {
+      ERROR("Error generating scrambling sequence");
+      return SRSRAN_ERROR;
+    }
     if (q->llr_is_8bit) {
-      srsran_sequence_pusch_apply_c(
-          q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+      srsran_sequence_bytes_apply_c(c_bytes, q->q, q->q, cfg->grant.tb.nof_bits);
     } else {
-      srsran_sequence_pusch_apply_s(
-          q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+      srsran_sequence_bytes_apply_s(c_bytes, q->q, q->q, cfg->grant.tb.nof_bits);
     }
 
-    // Generate packed sequence for UCI decoder
+    // Generate unpacked sequence for UCI decoder
     uint8_t* c = (uint8_t*)q->z; // Reuse Z
-    srsran_sequence_pusch_gen_unpack(
-        c, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+    srsran_bit_unpack_vector(c_bytes, c, cfg->grant.tb.nof_bits);
 
     // Set max number of iterations
     srsran_sch_set_max_noi(&q->ul_sch, cfg->max_nof_iterations);
@@ -75,6 +75,11 @@ int pusch_nr_init_common(srsran_pusch_nr_t* q, const srsran_pusch_nr_args_t* arg
     return SRSRAN_ERROR;
   }
 
+  if (srsran_sequence_cache_init(&q->seq_cache, SRSRAN_SEQUENCE_CACHE_DEFAULT_NOF_ENTRIES) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising scrambling sequence cache");
+    return SRSRAN_ERROR;
+  }
+
   q->g_ulsch = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
   q->g_ack   = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
   q->g_csi1  = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
@@ -246,29 +251,22 @@ void srsran_pusch_nr_free(srsran_pusch_nr_t* q)
     srsran_evm_free(q->evm_buffer);
   }
 
-  SRSRAN_MEM_ZERO(q, srsran_pusch_nr_t, 1);
-}
+  srsran_sequence_cache_free(&q->seq_cache);
 
-static inline uint32_t pusch_nr_put_rb(cf_t* dst, cf_t* src, bool* rvd_mask)
-{
-  uint32_t count = 0;
-  for (uint32_t i = 0; i < SRSRAN_NRE; i++) {
-    if (!rvd_mask[i]) {
-      dst[i] = src[count++];
-    }
-  }
-  return count;
+  SRSRAN_MEM_ZERO(q, srsran_pusch_nr_t, 1);
 }
 
-static inline uint32_t pusch_nr_get_rb(cf_t* dst, cf_t* src, bool* rvd_mask)
+/**
+ * Symbols where the same DMRS and reserved RE patterns are active share the same reserved RE mask, the returned key
+ * identifies them
+ */
+static inline uint32_t pusch_nr_symbol_key(const srsran_pusch_nr_t* q, const srsran_sch_cfg_nr_t* cfg, uint32_t l)
 {
-  uint32_t count = 0;
-  for (uint32_t i = 0; i < SRSRAN_NRE; i++) {
-    if (!rvd_mask[i]) {
-      dst[count++] = src[i];
-    }
+  uint32_t key = q->dmrs_re_pattern.symbol[l] ? 1U : 0U;
+  for (uint32_t i = 0; i < cfg->rvd_re.count; i++) {
+    key |= cfg->rvd_re.data[i].symbol[l] ? (2U << i) : 0U;
   }
-  return count;
+  return key;
 }
 
 static int srsran_pusch_nr_cp(const srsran_pusch_nr_t*     q,
@@ -280,38 +278,41 @@ static int srsran_pusch_nr_cp(const srsran_pusch_nr_t*     q,
 {
   uint32_t count = 0;
 
+  // The RE of a symbol are compiled into runs of contiguous subcarriers, which are reused by the following symbols
+  // with the same reservations
+  srsran_re_pattern_runs_t runs;
+  uint32_t                 runs_key = UINT32_MAX;
+
   for (uint32_t l = grant->S; l < grant->S + grant->L; l++) {
-    // Initialise reserved RE mask to all false
-    bool rvd_mask[SRSRAN_NRE * SRSRAN_MAX_PRB_NR] = {};
+    uint32_t key = pusch_nr_symbol_key(q, cfg, l);
+    if (key != runs_key) {
+      // Initialise reserved RE mask to all false
+      bool rvd_mask[SRSRAN_NRE * SRSRAN_MAX_PRB_NR] = {};
+
+      // Reserve DMRS
+      if (srsran_re_pattern_to_symbol_mask(&q->dmrs_re_pattern, l, rvd_mask) < SRSRAN_SUCCESS) {
+        ERROR("Error generating DMRS reserved RE mask");
+        return SRSRAN_ERROR;
+      }
 
-    // Reserve DMRS
-    if (srsran_re_pattern_to_symbol_mask(&q->dmrs_re_pattern, l, rvd_mask) < SRSRAN_SUCCESS) {
-      ERROR("Error generating DMRS reserved RE mask");
-      return SRSRAN_ERROR;
-    }
+      // Reserve RE from configuration
+      if (srsran_re_pattern_list_to_symbol_mask(&cfg->rvd_re, l, rvd_mask) < SRSRAN_SUCCESS) {
+        ERROR("Error generating reserved RE mask");
+        return SRSRAN_ERROR;
+      }
 
-    // Reserve RE from configuration
-    if (srsran_re_pattern_list_to_symbol_mask(&cfg->rvd_re, l, rvd_mask) < SRSRAN_SUCCESS) {
-      ERROR("Error generating reserved RE mask");
-      return SRSRAN_ERROR;
+      srsran_re_pattern_mask_to_runs(rvd_mask, grant->prb_idx, q->carrier.nof_prb, &runs);
+      runs_key = key;
     }
 
-    // Actual copy
-    for (uint32_t rb = 0; rb < q->carrier.nof_prb; rb++) {
-      // Skip PRB if not available in grant
-      if (!grant->prb_idx[rb]) {
-        continue;
-      }
-
-      // Calculate RE index at the begin of the symbol
-      uint32_t re_idx = (q->carrier.nof_prb * l + rb) * SRSRAN_NRE;
+    // Calculate RE index at the begin of the symbol
+    uint32_t re_idx = q->carrier.nof_prb * l * SRSRAN_NRE;
 
-      // Put or get
-      if (put) {
-        count += pusch_nr_put_rb(&sf_symbols[re_idx], &symbols[count], &rvd_mask[rb * SRSRAN_NRE]);
-      } else {
-        count += pusch_nr_get_rb(&symbols[count], &sf_symbols[re_idx], &rvd_mask[rb * SRSRAN_NRE]);
-      }
+    // Put or get
+    if (put) {
+      count += srsran_re_pattern_runs_put(&runs, &symbols[count], &sf_symbols[re_idx]);
+    } else {
+      count += srsran_re_pattern_runs_get(&runs, &sf_symbols[re_idx], &symbols[count]);
     }
   }
 
@@ -677,8 +678,13 @@ static inline int pusch_nr_encode_codeword(srsran_pusch_nr_t*           q,
   }
 
   // 7.3.1.1 Scrambling
-  uint32_t cinit = pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx);
-  srsran_sequence_apply_bit(b, q->b[tb->cw_idx], nof_bits, cinit);
+  uint32_t       cinit = pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx);
+  const uint8_t* c     = srsran_sequence_cache_get(&q->seq_cache, cinit, nof_bits);
+  if (c == NULL) {
+    ERROR("Error generating scrambling sequence");
+    return SRSRAN_ERROR;
+  }
+  srsran_sequence_bytes_apply_bit(c, b, q->b[tb->cw_idx], nof_bits);
 
   // Special Scrambling condition
   if (cfg->uci.ack.count <= 2) {
@@ -852,7 +858,13 @@ static inline int pusch_nr_decode_codeword(srsran_pusch_nr_t*         q,
   }
 
   // Descrambling
-  srsran_sequence_apply_c(llr, llr, nof_bits, pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx));
+  const uint8_t* c =
+      srsran_sequence_cache_get(&q->seq_cache, pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx), nof_bits);
+  if (c == NULL) {
+    ERROR("Error generating scrambling sequence");
+    return SRSRAN_ERROR;
+  }
+  srsran_sequence_bytes_apply_c(c, llr, llr, nof_bits);
 
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     DEBUG("b=");
@@ -190,30 +190,15 @@ srsran_mod_t srsran_ra_ul_mod_from_mcs(uint32_t mcs)
 static int srsran_ra_dl_mcs_from_tbs_idx(uint32_t tbs_idx, bool use_tbs_index_alt)
 {
   if (use_tbs_index_alt) {
-    for (int mcs = 27; mcs >= 0; mcs--) {
-      if (tbs_idx == dl_mcs_tbs_idx_table2[mcs]) {
-        return mcs;
-      }
-    }
-  } else {
-    for (int mcs = 28; mcs >= 0; mcs--) {
-      if (tbs_idx == dl_mcs_tbs_idx_table[mcs]) {
-        return mcs;
-      }
-    }
+    return (tbs_idx < 34) ? dl_tbs_idx_mcs_table2[tbs_idx] : SRSRAN_ERROR;
   }
-  return SRSRAN_ERROR;
+  return (tbs_idx < 27) ? dl_tbs_idx_mcs_table[tbs_idx] : SRSRAN_ERROR;
 }
 
 static int srsran_ra_ul_mcs_from_tbs_idx(uint32_t tbs_idx)
 {
-  // Note: go in descent order to find max mcs possible
-  for (int mcs = 28; mcs >= 0; mcs--) {
-    if (tbs_idx == ul_mcs_tbs_idx_table[mcs]) {
-      return mcs;
-    }
-  }
-  return SRSRAN_ERROR;
+  // Note: the table holds the max mcs possible
+  return (tbs_idx < 27) ? ul_tbs_idx_mcs_table[tbs_idx] : SRSRAN_ERROR;
 }
 
 int srsran_ra_mcs_from_tbs_idx(uint32_t tbs_idx, bool use_tbs_index_alt, bool is_ul)
@@ -454,14 +454,19 @@ static uint32_t ra_nr_tbs_from_n_info3(uint32_t n_info)
   uint32_t n            = (uint32_t)SRSRAN_MAX(3.0, floor(log2(n_info)) - 6.0);
   uint32_t n_info_prime = SRSRAN_MAX(ra_nr_tbs_table[0], POW2(n) * SRSRAN_FLOOR(n_info, POW2(n)));
 
-  // use Table 5.1.3.2-1 find the closest TBS that is not less than n_info_prime
-  for (uint32_t i = 0; i < RA_NR_TBS_SIZE_TABLE; i++) {
-    if (n_info_prime <= ra_nr_tbs_table[i]) {
-      return ra_nr_tbs_table[i];
+  // use Table 5.1.3.2-1 find the closest TBS that is not less than n_info_prime, the table is sorted
+  uint32_t lo = 0;
+  uint32_t hi = RA_NR_TBS_SIZE_TABLE - 1;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    if (ra_nr_tbs_table[mid] < n_info_prime) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
     }
   }
 
-  return ra_nr_tbs_table[RA_NR_TBS_SIZE_TABLE - 1];
+  return ra_nr_tbs_table[lo];
 }
 
 static uint32_t ra_nr_tbs_from_n_info4(uint32_t n_info, double R)
@@ -571,6 +576,47 @@ uint32_t ra_nr_nof_crc_bits(uint32_t tbs, double R)
   return cbsegm.C * cbsegm.L_cb + cbsegm.L_tb;
 }
 
+/**
+ * Cache of the TBS derivations. The TBS and its CRC bits only depend on the number of RE, the scaling, the rate, the
+ * modulation order and the number of layers, which repeat across the grants of every slot in the scheduler and in the
+ * PHY. It is direct mapped and every thread keeps its own, so that it does not need locking.
+ */
+#define RA_NR_TBS_CACHE_SIZE 64
+
+typedef struct {
+  bool     valid;
+  uint32_t N_re;
+  uint32_t Qm;
+  uint32_t nof_layers;
+  double   S;
+  double   R;
+  uint32_t tbs;
+  uint32_t nof_crc_bits;
+} ra_nr_tbs_cache_entry_t;
+
+static __thread ra_nr_tbs_cache_entry_t ra_nr_tbs_cache[RA_NR_TBS_CACHE_SIZE];
+
+static const ra_nr_tbs_cache_entry_t*
+ra_nr_tbs_cached(uint32_t N_re, double S, double R, uint32_t Qm, uint32_t nof_layers)
+{
+  uint32_t                 idx   = (N_re * 31U + (uint32_t)(R * 1024.0) * 7U + Qm + nof_layers) % RA_NR_TBS_CACHE_SIZE;
+  ra_nr_tbs_cache_entry_t* entry = &ra_nr_tbs_cache[idx];
+  if (entry->valid && entry->N_re == N_re && entry->Qm == Qm && entry->nof_layers == nof_layers && entry->S == S &&
+      entry->R == R) {
+    return entry;
+  }
+
+  entry->valid        = true;
+  entry->N_re         = N_re;
+  entry->Qm           = Qm;
+  entry->nof_layers   = nof_layers;
+  entry->S            = S;
+  entry->R            = R;
+  entry->tbs          = srsran_ra_nr_tbs(N_re, S, R, Qm, nof_layers);
+  entry->nof_crc_bits = ra_nr_nof_crc_bits(entry->tbs, R);
+  return entry;
+}
+
 int srsran_ra_nr_fill_tb(const srsran_sch_cfg_nr_t*   pdsch_cfg,
                          const srsran_sch_grant_nr_t* grant,
                          uint32_t                     mcs_idx,
@@ -624,19 +670,24 @@ int srsran_ra_nr_fill_tb(const srsran_sch_cfg_nr_t*   pdsch_cfg,
   uint32_t nof_layers_cw1 = grant->nof_layers / nof_cw;
   tb->N_L                 = nof_layers_cw1;
 
-  // Check DMRS and CSI-RS collision according to TS 38.211 7.4.1.5.3 Mapping to physical resources
-  // If there was a collision, the number of RE in the grant would be wrong
-  if (ra_nr_assert_csi_rs_dmrs_collision(pdsch_cfg) < SRSRAN_SUCCESS) {
-    ERROR("Error: CSI-RS and DMRS collision detected");
-    return SRSRAN_ERROR;
-  }
+  // Without reserved RE patterns there can neither be collisions nor reserved RE
+  uint32_t N_re_rvd = 0;
+  if (pdsch_cfg->rvd_re.count > 0) {
+    // Check DMRS and CSI-RS collision according to TS 38.211 7.4.1.5.3 Mapping to physical resources
+    // If there was a collision, the number of RE in the grant would be wrong
+    if (ra_nr_assert_csi_rs_dmrs_collision(pdsch_cfg) < SRSRAN_SUCCESS) {
+      ERROR("Error: CSI-RS and DMRS collision detected");
+      return SRSRAN_ERROR;
+    }
 
-  // Calculate reserved RE
-  uint32_t N_re_rvd = srsran_re_pattern_list_count(&pdsch_cfg->rvd_re, grant->S, grant->S + grant->L, grant->prb_idx);
+    // Calculate reserved RE
+    N_re_rvd = srsran_re_pattern_list_count(&pdsch_cfg->rvd_re, grant->S, grant->S + grant->L, grant->prb_idx);
+  }
 
   // Steps 2,3,4
-  tb->mcs      = mcs_idx;
-  tb->tbs      = (int)srsran_ra_nr_tbs(N_re, S, R, Qm, tb->N_L);
+  const ra_nr_tbs_cache_entry_t* tbs_entry = ra_nr_tbs_cached((uint32_t)N_re, S, R, Qm, tb->N_L);
+  tb->mcs                                  = mcs_idx;
+  tb->tbs                                  = (int)tbs_entry->tbs;
   tb->R        = R;
   tb->mod      = m;
   tb->nof_re   = (N_re - N_re_rvd) * grant->nof_layers;
@@ -646,7 +697,7 @@ int srsran_ra_nr_fill_tb(const srsran_sch_cfg_nr_t*   pdsch_cfg,
   // Calculate actual rate
   tb->R_prime = 0.0;
   if (tb->nof_re != 0) {
-    tb->R_prime = (double)(tb->tbs + ra_nr_nof_crc_bits(tb->tbs, tb->R)) / (double)tb->nof_bits;
+    tb->R_prime = (double)(tb->tbs + tbs_entry->nof_crc_bits) / (double)tb->nof_bits;
   }
 
   return SRSRAN_SUCCESS;
@@ -31,6 +31,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
+#include <time.h>
 
 #define SRSRAN_PDSCH_MIN_TDEC_ITERS 2
 #define SRSRAN_PDSCH_MAX_TDEC_ITERS 10
@@ -215,6 +216,8 @@ void srsran_sch_free(srsran_sch_t* q)
     free(q->ul_interleaver);
   }
   srsran_tdec_free(&q->decoder);
+  srsran_tdec_batch_free(&q->decoder_batch);
+  srsran_sch_set_cb_executor(q, NULL, NULL, 0);
   srsran_tcod_free(&q->encoder);
   srsran_uci_cqi_free(&q->uci_cqi);
   bzero(q, sizeof(srsran_sch_t));
@@ -234,8 +237,102 @@ float srsran_sch_last_noi(srsran_sch_t* q)
   return q->avg_iterations;
 }
 
+uint64_t srsran_sch_last_decode_time_ns(srsran_sch_t* q)
+{
+  return q->decode_time_ns;
+}
+
+static uint64_t sch_time_ns()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+int srsran_sch_enable_tdec_batch(srsran_sch_t* q, bool enable)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // The batch decoder buffers are only allocated the first time it is enabled
+  if (enable && q->decoder_batch.nof_lanes == 0) {
+    if (srsran_tdec_batch_init(&q->decoder_batch, SRSRAN_TCOD_MAX_LEN_CB) < SRSRAN_SUCCESS) {
+      q->tdec_batch_enabled = false;
+      return SRSRAN_ERROR;
+    }
+  }
+
+  q->tdec_batch_enabled = enable;
+  return SRSRAN_SUCCESS;
+}
+
+static void sch_cb_workers_free(srsran_sch_t* q)
+{
+  if (q->cb_workers) {
+    for (uint32_t i = 0; i < q->nof_cb_workers; i++) {
+      srsran_tdec_free(&q->cb_workers[i].decoder);
+      if (q->cb_workers[i].cb_data) {
+        free(q->cb_workers[i].cb_data);
+      }
+    }
+    free(q->cb_workers);
+  }
+  q->cb_workers     = NULL;
+  q->nof_cb_workers = 0;
+}
+
+int srsran_sch_set_cb_executor(srsran_sch_t*             q,
+                               srsran_sch_parallel_for_t parallel_for,
+                               void*                     executor,
+                               uint32_t                  nof_tasks)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  q->parallel_for = NULL;
+  q->executor     = NULL;
+
+  nof_tasks = SRSRAN_MIN(nof_tasks, SRSRAN_MAX_CODEBLOCKS);
+  if (parallel_for == NULL || nof_tasks < 2) {
+    sch_cb_workers_free(q);
+    return SRSRAN_SUCCESS;
+  }
+
+  // Each task needs its own decoder and CRC, the latter keeps the checksum state
+  if (q->nof_cb_workers != nof_tasks) {
+    sch_cb_workers_free(q);
+
+    q->cb_workers = calloc(nof_tasks, sizeof(srsran_sch_cb_worker_t));
+    if (q->cb_workers == NULL) {
+      return SRSRAN_ERROR;
+    }
+    q->nof_cb_workers = nof_tasks;
+
+    for (uint32_t i = 0; i < nof_tasks; i++) {
+      srsran_sch_cb_worker_t* w = &q->cb_workers[i];
+      if (srsran_tdec_init(&w->decoder, SRSRAN_TCOD_MAX_LEN_CB) || srsran_crc_init(&w->crc_tb, SRSRAN_LTE_CRC24A, 24) ||
+          srsran_crc_init(&w->crc_cb, SRSRAN_LTE_CRC24B, 24)) {
+        ERROR("Error initiating code block decoder");
+        sch_cb_workers_free(q);
+        return SRSRAN_ERROR;
+      }
+      w->cb_data = srsran_vec_u8_malloc((SRSRAN_TCOD_MAX_LEN_CB + 8) / 8);
+      if (w->cb_data == NULL) {
+        sch_cb_workers_free(q);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  q->parallel_for = parallel_for;
+  q->executor     = executor;
+  return SRSRAN_SUCCESS;
+}
+
 /* Encode a transport block according to 36.212 5.3.2
- *
+ * If cbs_encoded is set, the code blocks are already in the softbuffer and only the bit selection is done
  */
 static int encode_tb_off(srsran_sch_t*           q,
                          srsran_softbuffer_tx_t* softbuffer,
@@ -245,7 +342,8 @@ static int encode_tb_off(srsran_sch_t*           q,
                          uint32_t                nof_e_bits,
                          uint8_t*                data,
                          uint8_t*                e_bits,
-                         uint32_t                w_offset)
+                         uint32_t                w_offset,
+                         bool                    cbs_encoded)
 {
   uint32_t i;
   uint32_t cb_len = 0, rp = 0, wp = 0, rlen = 0, n_e = 0;
@@ -302,7 +400,7 @@ static int encode_tb_off(srsran_sch_t*           q,
 
       INFO("CB#%d: cb_len: %d, rlen: %d, wp: %d, rp: %d, E: %d", i, cb_len, rlen, wp, rp, n_e);
 
-      if (data) {
+      if (data && !cbs_encoded) {
         bool last_cb = false;
 
         /* Copy data to another buffer, making space for the Codeblock CRC */
@@ -331,14 +429,21 @@ static int encode_tb_off(srsran_sch_t*           q,
       DEBUG("RM cblen_idx=%d, n_e=%d, wp=%d, nof_e_bits=%d", cblen_idx, n_e, wp, nof_e_bits);
 
       /* Rate matching */
-      if (srsran_rm_turbo_tx_lut(softbuffer->buffer_b[i],
-                                 q->cb_in,
-                                 q->parity_bits,
-                                 &e_bits[(wp + w_offset) / 8],
-                                 cblen_idx,
-                                 n_e,
-                                 (wp + w_offset) % 8,
-                                 rv)) {
+      int rm_ret = cbs_encoded ? srsran_rm_turbo_tx_lut_select(softbuffer->buffer_b[i],
+                                                               &e_bits[(wp + w_offset) / 8],
+                                                               cblen_idx,
+                                                               n_e,
+                                                               (wp + w_offset) % 8,
+                                                               rv)
+                               : srsran_rm_turbo_tx_lut(softbuffer->buffer_b[i],
+                                                        q->cb_in,
+                                                        q->parity_bits,
+                                                        &e_bits[(wp + w_offset) / 8],
+                                                        cblen_idx,
+                                                        n_e,
+                                                        (wp + w_offset) % 8,
+                                                        rv);
+      if (rm_ret) {
         ERROR("Error in rate matching");
         return SRSRAN_ERROR;
       }
@@ -365,7 +470,226 @@ static int encode_tb(srsran_sch_t*           q,
                      uint8_t*                data,
                      uint8_t*                e_bits)
 {
-  return encode_tb_off(q, soft_buffer, cb_segm, Qm, rv, nof_e_bits, data, e_bits, 0);
+  return encode_tb_off(q, soft_buffer, cb_segm, Qm, rv, nof_e_bits, data, e_bits, 0, false);
+}
+
+/* Decodes nof_cb code blocks of length cb_len in a single call to the batched turbo decoder. The LLRs have been
+ * written in the softbuffer in the non sub-block format. Iterations stop when all code blocks pass the CRC. */
+static void decode_cb_batch(srsran_sch_t*           q,
+                            srsran_softbuffer_rx_t* softbuffer,
+                            srsran_cbsegm_t*        cb_segm,
+                            uint32_t*               cb_idx,
+                            uint32_t                nof_cb,
+                            uint32_t                cb_len,
+                            uint8_t*                data)
+{
+  int16_t*      input[SRSRAN_TDEC_BATCH_MAX_NOF_CB];
+  uint8_t*      output[SRSRAN_TDEC_BATCH_MAX_NOF_CB];
+  uint8_t       cb_data[SRSRAN_TDEC_BATCH_MAX_NOF_CB][SRSRAN_TCOD_MAX_LEN_CB / 8];
+  uint32_t      cb_noi[SRSRAN_TDEC_BATCH_MAX_NOF_CB] = {};
+  uint32_t      rlen                                 = cb_segm->C == 1 ? cb_len : (cb_len - 24);
+  uint32_t      len_crc                              = cb_segm->C > 1 ? cb_len : (cb_segm->tbs + 24);
+  srsran_crc_t* crc_ptr                              = cb_segm->C > 1 ? &q->crc_cb : &q->crc_tb;
+
+  for (uint32_t i = 0; i < nof_cb; i++) {
+    input[i]  = softbuffer->buffer_f[cb_idx[i]];
+    output[i] = cb_data[i];
+  }
+
+  if (srsran_tdec_batch_new_cb(&q->decoder_batch, input, nof_cb, cb_len) < SRSRAN_SUCCESS) {
+    ERROR("Error setting batched turbo decoder");
+    return;
+  }
+
+  // Run iterations and use CRC for early stopping
+  uint32_t nof_pending = nof_cb;
+  uint32_t noi         = 0;
+  do {
+    srsran_tdec_batch_iteration(&q->decoder_batch);
+    srsran_tdec_batch_decision_byte(&q->decoder_batch, output);
+    noi++;
+
+    for (uint32_t i = 0; i < nof_cb; i++) {
+      if (output[i] == NULL) {
+        continue;
+      }
+      q->avg_iterations++;
+      cb_noi[i] = noi;
+
+      // CRC is OK and ran the minimum number of iterations
+      if (!srsran_crc_checksum_byte(crc_ptr, cb_data[i], len_crc) && (noi >= SRSRAN_PDSCH_MIN_TDEC_ITERS)) {
+        softbuffer->cb_crc[cb_idx[i]] = true;
+        output[i]                     = NULL;
+        nof_pending--;
+      }
+    }
+  } while (noi < q->max_iterations && nof_pending > 0);
+
+  // Copy without the CRC bits, otherwise they would overwrite the beginning of the next code block
+  for (uint32_t i = 0; i < nof_cb; i++) {
+    memcpy(&data[cb_idx[i] * rlen / 8], cb_data[i], rlen / 8 * sizeof(uint8_t));
+
+    INFO("CB %d: cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d (batch of %d)",
+         cb_idx[i],
+         cb_len,
+         softbuffer->cb_crc[cb_idx[i]] ? "OK" : "KO",
+         rlen,
+         cb_noi[i],
+         q->max_iterations,
+         nof_cb);
+  }
+}
+
+/* Position and length of the code block cb_idx within the rate matched e_bits, according to 36.212 5.3.2.5 */
+static void cb_e_bits_position(srsran_cbsegm_t* cb_segm,
+                               uint32_t         Qm,
+                               uint32_t         nof_e_bits,
+                               uint32_t         cb_idx,
+                               uint32_t*        rp,
+                               uint32_t*        n_e2)
+{
+  uint32_t Gp    = nof_e_bits / Qm;
+  uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
+  uint32_t n_e   = Qm * (Gp / cb_segm->C);
+
+  *rp   = cb_idx * n_e;
+  *n_e2 = n_e;
+
+  if (cb_idx > cb_segm->C - gamma) {
+    *n_e2 = n_e + Qm;
+    *rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * *n_e2;
+  }
+}
+
+/* Rate matches and decodes the code block cb_idx with the given decoder, writing cb_len bits (CRC included) in
+ * cb_data. Returns the number of iterations or SRSRAN_ERROR. */
+static int decode_cb(srsran_sch_t*           q,
+                     srsran_tdec_t*          decoder,
+                     srsran_crc_t*           crc_cb,
+                     srsran_crc_t*           crc_tb,
+                     srsran_softbuffer_rx_t* softbuffer,
+                     srsran_cbsegm_t*        cb_segm,
+                     uint32_t                Qm,
+                     uint32_t                rv,
+                     uint32_t                nof_e_bits,
+                     void*                   e_bits,
+                     uint32_t                cb_idx,
+                     uint8_t*                cb_data)
+{
+  int8_t*  e_bits_b = e_bits;
+  int16_t* e_bits_s = e_bits;
+
+  uint32_t cb_len     = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+  uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
+  uint32_t rlen       = cb_segm->C == 1 ? cb_len : (cb_len - 24);
+
+  uint32_t rp, n_e2;
+  cb_e_bits_position(cb_segm, Qm, nof_e_bits, cb_idx, &rp, &n_e2);
+
+  if (q->llr_is_8bit) {
+    if (srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
+      ERROR("Error in rate matching");
+      return SRSRAN_ERROR;
+    }
+  } else {
+    if (srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
+      ERROR("Error in rate matching");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  srsran_tdec_new_cb(decoder, cb_len);
+
+  uint32_t      len_crc = cb_segm->C > 1 ? cb_len : (cb_segm->tbs + 24);
+  srsran_crc_t* crc_ptr = cb_segm->C > 1 ? crc_cb : crc_tb;
+
+  // Run iterations and use CRC for early stopping
+  bool     early_stop = false;
+  uint32_t cb_noi     = 0;
+  do {
+    if (q->llr_is_8bit) {
+      srsran_tdec_iteration_8bit(decoder, (int8_t*)softbuffer->buffer_f[cb_idx], cb_data);
+    } else {
+      srsran_tdec_iteration(decoder, softbuffer->buffer_f[cb_idx], cb_data);
+    }
+    cb_noi++;
+
+    // CRC is OK and ran the minimum number of iterations
+    if (!srsran_crc_checksum_byte(crc_ptr, cb_data, len_crc) && (cb_noi >= SRSRAN_PDSCH_MIN_TDEC_ITERS)) {
+      softbuffer->cb_crc[cb_idx] = true;
+      early_stop                 = true;
+
+      // CRC is error and exceeded maximum iterations for this CB.
+      // Early stop the whole transport block.
+    }
+
+  } while (cb_noi < q->max_iterations && !early_stop);
+
+  INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d",
+       cb_idx,
+       rp,
+       n_e2,
+       cb_len,
+       early_stop ? "OK" : "KO",
+       rlen,
+       cb_noi,
+       q->max_iterations);
+
+  return (int)cb_noi;
+}
+
+typedef struct {
+  srsran_sch_t*           q;
+  srsran_softbuffer_rx_t* softbuffer;
+  srsran_cbsegm_t*        cb_segm;
+  uint32_t                Qm;
+  uint32_t                rv;
+  uint32_t                nof_e_bits;
+  void*                   e_bits;
+  uint8_t*                data;
+  uint32_t                nof_tasks;
+  bool                    error[SRSRAN_MAX_CODEBLOCKS];
+} decode_cb_task_args_t;
+
+/* Task idx decodes the code blocks idx, idx + nof_tasks, idx + 2 * nof_tasks... with its own decoder. The decoded bits
+ * go through the worker buffer so the CRC bits do not overwrite the beginning of a code block decoded concurrently. */
+static void decode_cb_task(void* arg, uint32_t idx)
+{
+  decode_cb_task_args_t*  a = (decode_cb_task_args_t*)arg;
+  srsran_sch_t*           q = a->q;
+  srsran_sch_cb_worker_t* w = &q->cb_workers[idx];
+
+  w->nof_iterations = 0;
+  for (uint32_t cb_idx = idx; cb_idx < a->cb_segm->C; cb_idx += a->nof_tasks) {
+    uint32_t cb_len = cb_idx < a->cb_segm->C1 ? a->cb_segm->K1 : a->cb_segm->K2;
+    uint32_t rlen   = a->cb_segm->C == 1 ? cb_len : (cb_len - 24);
+
+    if (a->softbuffer->cb_crc[cb_idx]) {
+      // Copy decoded data from previous transmissions
+      memcpy(&a->data[cb_idx * rlen / 8], a->softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
+      continue;
+    }
+
+    int noi = decode_cb(q,
+                        &w->decoder,
+                        &w->crc_cb,
+                        &w->crc_tb,
+                        a->softbuffer,
+                        a->cb_segm,
+                        a->Qm,
+                        a->rv,
+                        a->nof_e_bits,
+                        a->e_bits,
+                        cb_idx,
+                        w->cb_data);
+    if (noi < SRSRAN_SUCCESS) {
+      a->error[idx] = true;
+      return;
+    }
+    w->nof_iterations += noi;
+
+    memcpy(&a->data[cb_idx * rlen / 8], w->cb_data, rlen / 8 * sizeof(uint8_t));
+  }
 }
 
 bool decode_tb_cb(srsran_sch_t*           q,
@@ -377,7 +701,6 @@ bool decode_tb_cb(srsran_sch_t*           q,
                   void*                   e_bits,
                   uint8_t*                data)
 {
-  int8_t*  e_bits_b = e_bits;
   int16_t* e_bits_s = e_bits;
 
   if (cb_segm->C > SRSRAN_MAX_CODEBLOCKS) {
@@ -387,89 +710,86 @@ bool decode_tb_cb(srsran_sch_t*           q,
 
   q->avg_iterations = 0;
 
-  for (int cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
-    /* Do not process blocks with CRC Ok */
-    if (softbuffer->cb_crc[cb_idx] == false) {
-      uint32_t cb_len     = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
-      uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
-
-      uint32_t rlen  = cb_segm->C == 1 ? cb_len : (cb_len - 24);
-      uint32_t Gp    = nof_e_bits / Qm;
-      uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
-      uint32_t n_e   = Qm * (Gp / cb_segm->C);
-
-      uint32_t rp   = cb_idx * n_e;
-      uint32_t n_e2 = n_e;
-
-      if (cb_idx > cb_segm->C - gamma) {
-        n_e2 = n_e + Qm;
-        rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
+  // Code blocks waiting for the batched decoder, all of them have the same length. The batch only pays off against
+  // the windowed decoders when at least half of the lanes are used, smaller groups are decoded one by one.
+  bool     use_batch = q->tdec_batch_enabled && !q->llr_is_8bit;
+  uint32_t batch_cb_idx[SRSRAN_TDEC_BATCH_MAX_NOF_CB];
+  uint32_t batch_nof_cb  = 0;
+  uint32_t batch_cb_len  = 0;
+  uint32_t batch_max_len = use_batch ? srsran_tdec_batch_max_nof_cb(&q->decoder_batch) : 0;
+  uint32_t batch_min_len = SRSRAN_MAX(2, batch_max_len / 2);
+
+  if (q->parallel_for != NULL && cb_segm->C > 1 && !use_batch) {
+    decode_cb_task_args_t args = {};
+    args.q                     = q;
+    args.softbuffer            = softbuffer;
+    args.cb_segm               = cb_segm;
+    args.Qm                    = Qm;
+    args.rv                    = rv;
+    args.nof_e_bits            = nof_e_bits;
+    args.e_bits                = e_bits;
+    args.data                  = data;
+    args.nof_tasks             = SRSRAN_MIN(q->nof_cb_workers, cb_segm->C);
+
+    q->parallel_for(q->executor, decode_cb_task, &args, args.nof_tasks);
+
+    for (uint32_t i = 0; i < args.nof_tasks; i++) {
+      if (args.error[i]) {
+        return false;
       }
+      q->avg_iterations += q->cb_workers[i].nof_iterations;
+    }
+  } else {
+    for (int cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
+      uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+      uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
 
-      if (q->llr_is_8bit) {
-        if (srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching");
-          return SRSRAN_ERROR;
+      /* Do not process blocks with CRC Ok */
+      if (softbuffer->cb_crc[cb_idx] == false) {
+        if (use_batch && (cb_idx < cb_segm->C1 ? cb_segm->C1 : cb_segm->C2) >= batch_min_len) {
+          uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
+          uint32_t rp, n_e2;
+          cb_e_bits_position(cb_segm, Qm, nof_e_bits, cb_idx, &rp, &n_e2);
+
+          // The batched decoder takes the input in the non sub-block format
+          if (srsran_rm_turbo_rx_lut_(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv, false)) {
+            ERROR("Error in rate matching");
+            return SRSRAN_ERROR;
+          }
+
+          if (batch_nof_cb > 0 && (batch_cb_len != cb_len || batch_nof_cb == batch_max_len)) {
+            decode_cb_batch(q, softbuffer, cb_segm, batch_cb_idx, batch_nof_cb, batch_cb_len, data);
+            batch_nof_cb = 0;
+          }
+          batch_cb_idx[batch_nof_cb++] = cb_idx;
+          batch_cb_len                 = cb_len;
+          continue;
         }
-      } else {
-        if (srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching");
+
+        int noi = decode_cb(q,
+                            &q->decoder,
+                            &q->crc_cb,
+                            &q->crc_tb,
+                            softbuffer,
+                            cb_segm,
+                            Qm,
+                            rv,
+                            nof_e_bits,
+                            e_bits,
+                            cb_idx,
+                            &data[cb_idx * rlen / 8]);
+        if (noi < SRSRAN_SUCCESS) {
           return SRSRAN_ERROR;
         }
+        q->avg_iterations += noi;
+      } else {
+        // Copy decoded data from previous transmissions
+        memcpy(&data[cb_idx * rlen / 8], softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
       }
+    }
 
-      srsran_tdec_new_cb(&q->decoder, cb_len);
-
-      // Run iterations and use CRC for early stopping
-      bool     early_stop = false;
-      uint32_t cb_noi     = 0;
-      do {
-        if (q->llr_is_8bit) {
-          srsran_tdec_iteration_8bit(&q->decoder, (int8_t*)softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
-        } else {
-          srsran_tdec_iteration(&q->decoder, softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
-        }
-        q->avg_iterations++;
-        cb_noi++;
-
-        uint32_t      len_crc;
-        srsran_crc_t* crc_ptr;
-
-        if (cb_segm->C > 1) {
-          len_crc = cb_len;
-          crc_ptr = &q->crc_cb;
-        } else {
-          len_crc = cb_segm->tbs + 24;
-          crc_ptr = &q->crc_tb;
-        }
-
-        // CRC is OK and ran the minimum number of iterations
-        if (!srsran_crc_checksum_byte(crc_ptr, &data[cb_idx * rlen / 8], len_crc) &&
-            (cb_noi >= SRSRAN_PDSCH_MIN_TDEC_ITERS)) {
-          softbuffer->cb_crc[cb_idx] = true;
-          early_stop                 = true;
-
-          // CRC is error and exceeded maximum iterations for this CB.
-          // Early stop the whole transport block.
-        }
-
-      } while (cb_noi < q->max_iterations && !early_stop);
-
-      INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d",
-           cb_idx,
-           rp,
-           n_e2,
-           cb_len,
-           early_stop ? "OK" : "KO",
-           rlen,
-           cb_noi,
-           q->max_iterations);
-
-    } else {
-      // Copy decoded data from previous transmissions
-      uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
-      uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
-      memcpy(&data[cb_idx * rlen / 8], softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
+    if (batch_nof_cb > 0) {
+      decode_cb_batch(q, softbuffer, cb_segm, batch_cb_idx, batch_nof_cb, batch_cb_len, data);
     }
   }
 
@@ -526,6 +846,8 @@ static int decode_tb(srsran_sch_t*           q,
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
+  q->decode_time_ns = 0;
+
   // Check segmentation is valid
   if (cb_segm->tbs == 0 || cb_segm->C == 0) {
     return SRSRAN_SUCCESS;
@@ -544,8 +866,23 @@ static int decode_tb(srsran_sch_t*           q,
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
+  if (softbuffer->llr_is_8bit && !q->llr_is_8bit) {
+    ERROR("Error 8-bit soft buffers can only be decoded with 8-bit LLR");
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Lazily allocated soft buffers have their CB allocated when they are reset for the transmission
+  for (uint32_t i = 0; i < cb_segm->C; i++) {
+    if (softbuffer->buffer_f[i] == NULL || softbuffer->data[i] == NULL) {
+      ERROR("Error soft buffer CB %d is not allocated", i);
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+  }
+
   // Process Codeblocks
-  bool cb_crc_ok = decode_tb_cb(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, data);
+  uint64_t t_start   = sch_time_ns();
+  bool     cb_crc_ok = decode_tb_cb(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, data);
+  q->decode_time_ns  = sch_time_ns() - t_start;
 
   // If any of the CBs CRC is KO
   if (!cb_crc_ok) {
@@ -1192,6 +1529,50 @@ int srsran_ulsch_decode(srsran_sch_t*       q,
   return ret;
 }
 
+int srsran_ulsch_pre_encode(srsran_sch_t* q, srsran_pusch_cfg_t* cfg, uint8_t* data)
+{
+  if (q == NULL || cfg == NULL || data == NULL || cfg->softbuffers.tx == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  srsran_softbuffer_tx_t* softbuffer = cfg->softbuffers.tx;
+  srsran_cbsegm_t         cb_segm;
+  if (srsran_cbsegm(&cb_segm, (uint32_t)cfg->grant.tb.tbs)) {
+    ERROR("Error computing segmentation for TBS=%d", cfg->grant.tb.tbs);
+    return SRSRAN_ERROR;
+  }
+  if (cb_segm.F) {
+    ERROR("Error filler bits are not supported. Use standard TBS");
+    return SRSRAN_ERROR;
+  }
+  if (cb_segm.C > softbuffer->max_cb) {
+    ERROR("Error number of CB to encode (%d) exceeds soft buffer size (%d CBs)", cb_segm.C, softbuffer->max_cb);
+    return SRSRAN_ERROR;
+  }
+
+  /* Same code block processing as encode_tb_off(), up to the filling of the circular buffers */
+  srsran_crc_set_init(&q->crc_tb, 0);
+  uint32_t rp = 0;
+  for (uint32_t i = 0; i < cb_segm.C; i++) {
+    uint32_t cb_len    = (i < cb_segm.C2) ? cb_segm.K2 : cb_segm.K1;
+    uint32_t cblen_idx = (i < cb_segm.C2) ? cb_segm.K2_idx : cb_segm.K1_idx;
+    uint32_t rlen      = (cb_segm.C > 1) ? cb_len - 24 : cb_len;
+    bool     last_cb   = (i == cb_segm.C - 1);
+
+    memcpy(q->cb_in, &data[rp / 8], (last_cb ? rlen - 24 : rlen) / 8);
+    srsran_tcod_encode_lut(
+        &q->encoder, &q->crc_tb, (cb_segm.C > 1) ? &q->crc_cb : NULL, q->cb_in, q->parity_bits, cblen_idx, last_cb);
+    if (srsran_rm_turbo_tx_lut_fill(softbuffer->buffer_b[i], q->cb_in, q->parity_bits, cblen_idx)) {
+      ERROR("Error in rate matching");
+      return SRSRAN_ERROR;
+    }
+    rp += rlen;
+  }
+
+  cfg->tb_pre_encoded = true;
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_ulsch_encode(srsran_sch_t*       q,
                         srsran_pusch_cfg_t* cfg,
                         uint8_t*            data,
@@ -1286,12 +1667,21 @@ int srsran_ulsch_encode(srsran_sch_t*       q,
   // Encode UL-SCH
   if (cb_segm.tbs > 0) {
     uint32_t G = nb_q / Qm - Q_prime_ri - Q_prime_cqi;
-    ret        = encode_tb_off(
-        q, cfg->softbuffers.tx, &cb_segm, Qm, cfg->grant.tb.rv, G * Qm, data, &g_bits[e_offset / 8], e_offset % 8);
+    ret        = encode_tb_off(q,
+                        cfg->softbuffers.tx,
+                        &cb_segm,
+                        Qm,
+                        cfg->grant.tb.rv,
+                        G * Qm,
+                        data,
+                        &g_bits[e_offset / 8],
+                        e_offset % 8,
+                        cfg->tb_pre_encoded);
     if (ret) {
       return ret;
     }
   }
+  cfg->tb_pre_encoded = false;
 
   // Interleave UL-SCH (and RI and CQI)
   ulsch_interleave(g_bits, Qm, nb_q / Qm, cfg->grant.nof_symb, q_bits, q->ack_ri_bits, Q_prime_ri * Qm, q->temp_g_bits);
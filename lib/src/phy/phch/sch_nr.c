@@ -356,6 +356,20 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
     return SRSRAN_ERROR;
   }
 
+  // The decoder states of the code block scheduler are created on demand for the lifting size in use
+  q->nof_interleaved_cb   = SRSRAN_MIN(args->decoder_nof_interleaved_cb, SRSRAN_SCH_NR_MAX_NOF_INTERLEAVED_CB);
+  q->decoder_avg_nof_iter = args->decoder_avg_nof_iter;
+  q->fec_offload          = args->fec_offload;
+  if (q->nof_interleaved_cb > 1) {
+    for (uint32_t i = 0; i < q->nof_interleaved_cb; i++) {
+      q->decoder_state_cb[i] = srsran_vec_u8_malloc(SRSRAN_LDPC_MAX_LEN_CB * 8);
+      if (!q->decoder_state_cb[i]) {
+        ERROR("Error: malloc");
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -381,6 +395,14 @@ void srsran_sch_nr_free(srsran_sch_nr_t* q)
     free(q->temp_cb);
   }
 
+  // The decoder states must be freed before their decoders
+  for (uint32_t i = 0; i < SRSRAN_SCH_NR_MAX_NOF_INTERLEAVED_CB; i++) {
+    srsran_ldpc_decoder_state_free(&q->decoder_state[i]);
+    if (q->decoder_state_cb[i]) {
+      free(q->decoder_state_cb[i]);
+    }
+  }
+
   for (uint16_t ls = 0; ls <= MAX_LIFTSIZE; ls++) {
     if (q->encoder_bg1[ls]) {
       srsran_ldpc_encoder_free(q->encoder_bg1[ls]);
@@ -516,8 +538,9 @@ static inline int sch_nr_encode(srsran_sch_nr_t*        q,
         q->temp_cb[i] = FILLER_BIT;
       }
 
-      // Encode code block
-      srsran_ldpc_encoder_encode(encoder, q->temp_cb, rm_buffer, cfg.Kr);
+      // Encode code block. The rate matching of any redundancy version only reads the first Ncb = min(N, Nref) bits of
+      // the circular buffer, so the parity bits past the limited buffer are not computed
+      srsran_ldpc_encoder_encode_rm(encoder, q->temp_cb, rm_buffer, cfg.Kr, cfg.Nref);
 
       if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
         DEBUG("encoded=");
@@ -551,6 +574,137 @@ static inline int sch_nr_encode(srsran_sch_nr_t*        q,
   return SRSRAN_SUCCESS;
 }
 
+/*
+ * Decodes the given code blocks with up to nof_interleaved_cb of them in flight. Every round runs one iteration on each
+ * code block in flight, which is retired as soon as its CRC matches or it reaches the maximum number of iterations and
+ * its slot is taken by the next code block. Easy code blocks leave early, so the decoding time follows the channel
+ * rather than the worst case. The optional budget bounds the total number of iterations of the transport block.
+ * Returns the number of iterations run or SRSRAN_ERROR.
+ */
+static int sch_nr_decode_scheduled(srsran_sch_nr_t*               q,
+                                   const srsran_sch_tb_t*         tb,
+                                   const srsran_sch_nr_tb_info_t* cfg,
+                                   srsran_ldpc_decoder_t*         decoder,
+                                   srsran_crc_t*                  crc,
+                                   const uint32_t*                cb_idx,
+                                   const int*                     cb_n_llr,
+                                   uint32_t                       nof_cb)
+{
+  uint32_t nof_slots = SRSRAN_MIN(q->nof_interleaved_cb, nof_cb);
+  int      slot_cb[SRSRAN_SCH_NR_MAX_NOF_INTERLEAVED_CB];
+  uint32_t cb_len = cfg->Kp - cfg->L_cb;
+
+  // The decoding states depend on the base graph and lifting size, create them again if they changed
+  for (uint32_t i = 0; i < nof_slots; i++) {
+    if (q->decoder_state[i].decoder != decoder) {
+      srsran_ldpc_decoder_state_free(&q->decoder_state[i]);
+      if (srsran_ldpc_decoder_state_init(&q->decoder_state[i], decoder) < SRSRAN_SUCCESS) {
+        ERROR("Error: initialising LDPC decoder state");
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  uint32_t budget = nof_cb * decoder->max_nof_iter;
+  if (isnormal(q->decoder_avg_nof_iter) && q->decoder_avg_nof_iter > 0) {
+    budget = SRSRAN_MIN(budget, (uint32_t)ceilf(q->decoder_avg_nof_iter * (float)nof_cb));
+  }
+
+  // Load the first code blocks
+  uint32_t next_cb    = 0;
+  uint32_t nof_active = 0;
+  for (uint32_t i = 0; i < nof_slots; i++, next_cb++) {
+    srsran_ldpc_decoder_state_start_c(
+        &q->decoder_state[i], (int8_t*)tb->softbuffer.tx->buffer_b[cb_idx[next_cb]], cb_n_llr[next_cb]);
+    slot_cb[i] = (int)next_cb;
+    nof_active++;
+  }
+
+  uint32_t nof_iter = 0;
+  while (nof_active > 0 && nof_iter < budget) {
+    for (uint32_t i = 0; i < nof_slots && nof_iter < budget; i++) {
+      if (slot_cb[i] < 0) {
+        continue;
+      }
+
+      srsran_ldpc_decoder_state_t* state = &q->decoder_state[i];
+      uint8_t*                     cb    = q->decoder_state_cb[i];
+      uint32_t                     r     = cb_idx[slot_cb[i]];
+
+      int ret = srsran_ldpc_decoder_state_iterate_crc_c(state, cb, crc);
+      if (ret < SRSRAN_SUCCESS) {
+        ERROR("Error decoding CB");
+        return SRSRAN_ERROR;
+      }
+      nof_iter++;
+
+      // Keep iterating until CRC matches or the maximum number of iterations is reached
+      if (ret == 0 && state->nof_iter < decoder->max_nof_iter) {
+        continue;
+      }
+
+      tb->softbuffer.rx->cb_crc[r] = (ret == 1);
+      SCH_INFO_RX("CB %d/%d iter=%d CRC=%s", r, cfg->C, state->nof_iter, ret == 1 ? "OK" : "KO");
+
+      if (tb->softbuffer.rx->cb_crc[r]) {
+        srsran_bit_pack_vector(cb, tb->softbuffer.rx->data[r], cb_len);
+      }
+
+      // Retire the code block and give the slot to the next one
+      if (next_cb < nof_cb) {
+        srsran_ldpc_decoder_state_start_c(
+            state, (int8_t*)tb->softbuffer.tx->buffer_b[cb_idx[next_cb]], cb_n_llr[next_cb]);
+        slot_cb[i] = (int)next_cb;
+        next_cb++;
+      } else {
+        slot_cb[i] = -1;
+        nof_active--;
+      }
+    }
+  }
+
+  if (nof_active > 0) {
+    SCH_INFO_RX("Iteration budget of %d exhausted with %d CB pending", budget, nof_active + nof_cb - next_cb);
+  }
+
+  return (int)nof_iter;
+}
+
+// Runs the given code blocks in the FEC offload and returns the sum of their iterations
+static int sch_nr_decode_offload(srsran_sch_nr_t* q, const srsran_sch_tb_t* tb, uint32_t nof_ops)
+{
+  uint32_t nof_iter_sum = 0;
+  uint32_t nof_enqueued = 0;
+  uint32_t nof_done     = 0;
+  bool     error        = false;
+
+  while (nof_done < nof_ops) {
+    // Keep the queue full, it may take fewer operations than pending
+    if (nof_enqueued < nof_ops) {
+      nof_enqueued +=
+          srsran_fec_offload_enqueue_ldpc_dec(q->fec_offload, &q->offload_op_ptr[nof_enqueued], nof_ops - nof_enqueued);
+    }
+
+    srsran_fec_offload_ldpc_dec_op_t* done[SRSRAN_SCH_NR_MAX_NOF_CB_LDPC];
+    uint32_t n = srsran_fec_offload_dequeue_ldpc_dec(q->fec_offload, done, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC);
+    for (uint32_t i = 0; i < n; i++) {
+      uint32_t r = (uint32_t)(uintptr_t)done[i]->opaque;
+      if (done[i]->status < SRSRAN_SUCCESS) {
+        // Keep draining, the remaining operations still reference the soft-buffer
+        ERROR("Error decoding CB %d in the FEC offload", r);
+        error = true;
+      }
+
+      tb->softbuffer.rx->cb_crc[r] = (done[i]->status == SRSRAN_SUCCESS && done[i]->crc_ok);
+      nof_iter_sum += done[i]->nof_iter;
+      SCH_INFO_RX("CB %d iter=%d CRC=%s", r, done[i]->nof_iter, tb->softbuffer.rx->cb_crc[r] ? "OK" : "KO");
+    }
+    nof_done += n;
+  }
+
+  return error ? SRSRAN_ERROR : (int)nof_iter_sum;
+}
+
 static int sch_nr_decode(srsran_sch_nr_t*        q,
                          const srsran_sch_cfg_t* sch_cfg,
                          const srsran_sch_tb_t*  tb,
@@ -607,6 +761,18 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
   uint32_t cb_ok = 0;
   res->crc       = false;
 
+  // Code blocks deferred to the scheduler
+  uint32_t pending_cb[SRSRAN_SCH_NR_MAX_NOF_CB_LDPC];
+  int      pending_n_llr[SRSRAN_SCH_NR_MAX_NOF_CB_LDPC];
+  uint32_t nof_pending = 0;
+
+  // Code blocks deferred to the FEC offload, with the same early stop CRC as the local decoder
+  uint32_t                 nof_offload = 0;
+  srsran_fec_offload_crc_t offload_crc = (cfg.L_tb == 16) ? SRSRAN_FEC_OFFLOAD_CRC_16 : SRSRAN_FEC_OFFLOAD_CRC_24A;
+  if (cfg.L_cb) {
+    offload_crc = SRSRAN_FEC_OFFLOAD_CRC_24B;
+  }
+
   // For each code block...
   uint32_t j = 0;
   for (uint32_t r = 0; r < cfg.C; r++) {
@@ -637,6 +803,28 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
       continue;
     }
 
+    // The offload runs the rate matching and the decoding, it only needs the rate matched LLRs
+    if (q->fec_offload != NULL) {
+      srsran_fec_offload_ldpc_dec_op_t* op = &q->offload_op[nof_offload];
+      op->bg                               = cfg.bg;
+      op->ls                               = cfg.Z;
+      op->F                                = cfg.F;
+      op->Nref                             = cfg.Nref;
+      op->rv                               = tb->rv;
+      op->mod                              = tb->mod;
+      op->E                                = E;
+      op->crc                              = offload_crc;
+      op->llr                              = input_ptr;
+      op->harq_buffer                      = rm_buffer;
+      op->output                           = tb->softbuffer.rx->data[r];
+      op->nof_bits                         = cfg.Kp - cfg.L_cb;
+      op->opaque                           = (void*)(uintptr_t)r;
+
+      q->offload_op_ptr[nof_offload++] = op;
+      input_ptr += E;
+      continue;
+    }
+
     // LDPC Rate matching
     SCH_INFO_RX("RM CB %d: E=%d; F=%d; BG=%d; Z=%d; RV=%d; Qm=%d; Nref=%d;",
                 r,
@@ -660,6 +848,15 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
       crc = &q->crc_cb;
     }
 
+    // Interleave the iterations of this code block with the others
+    if (q->nof_interleaved_cb > 1) {
+      pending_cb[nof_pending]    = r;
+      pending_n_llr[nof_pending] = n_llr;
+      nof_pending++;
+      input_ptr += E;
+      continue;
+    }
+
     // Decode. if CRC=KO, then ret=0
     int ret = srsran_ldpc_decoder_decode_crc_c(decoder, rm_buffer, q->temp_cb, n_llr, crc);
     if (ret < SRSRAN_SUCCESS) {
@@ -691,6 +888,41 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
 
     input_ptr += E;
   }
+
+  if (nof_offload > 0) {
+    int n_iter = sch_nr_decode_offload(q, tb, nof_offload);
+    if (n_iter < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    nof_iter_sum += (uint32_t)n_iter;
+
+    for (uint32_t i = 0; i < nof_offload; i++) {
+      if (tb->softbuffer.rx->cb_crc[(uintptr_t)q->offload_op[i].opaque]) {
+        cb_ok++;
+      }
+    }
+  }
+
+  if (nof_pending > 0) {
+    // Select CB or TB early stop CRC
+    srsran_crc_t* crc = (cfg.L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
+    if (cfg.L_cb) {
+      crc = &q->crc_cb;
+    }
+
+    int n_iter = sch_nr_decode_scheduled(q, tb, &cfg, decoder, crc, pending_cb, pending_n_llr, nof_pending);
+    if (n_iter < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    nof_iter_sum += (uint32_t)n_iter;
+
+    for (uint32_t i = 0; i < nof_pending; i++) {
+      if (tb->softbuffer.rx->cb_crc[pending_cb[i]]) {
+        cb_ok++;
+      }
+    }
+  }
+
   // Set average number of iterations
   res->avg_iter = (float)nof_iter_sum / (float)cfg.C;
 
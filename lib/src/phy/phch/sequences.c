@@ -113,6 +113,16 @@ void srsran_sequence_pdsch_apply_c(const int8_t* in,
   srsran_sequence_apply_c(in, out, len, sequence_pdsch_seed(rnti, q, nslot, cell_id));
 }
 
+const uint8_t* srsran_sequence_pdsch_cache_get(srsran_sequence_cache_t* cache,
+                                               uint16_t                 rnti,
+                                               int                      q,
+                                               uint32_t                 nslot,
+                                               uint32_t                 cell_id,
+                                               uint32_t                 len)
+{
+  return srsran_sequence_cache_get(cache, sequence_pdsch_seed(rnti, q, nslot, cell_id), len);
+}
+
 /**
  * 36.211 5.3.1
  */
@@ -153,6 +163,15 @@ void srsran_sequence_pusch_gen_unpack(uint8_t* out, uint16_t rnti, uint32_t nslo
   srsran_sequence_apply_bit(out, out, len, sequence_pusch_seed(rnti, nslot, cell_id));
 }
 
+const uint8_t* srsran_sequence_pusch_cache_get(srsran_sequence_cache_t* cache,
+                                               uint16_t                 rnti,
+                                               uint32_t                 nslot,
+                                               uint32_t                 cell_id,
+                                               uint32_t                 len)
+{
+  return srsran_sequence_cache_get(cache, sequence_pusch_seed(rnti, nslot, cell_id), len);
+}
+
 void srsran_sequence_pusch_apply_c(const int8_t* in,
                                    int8_t*       out,
                                    uint16_t      rnti,
@@ -34,6 +34,16 @@ static const int dl_mcs_tbs_idx_table2[28] = {0,  2,  4,  6,  8,  10, 11, 12, 13
 static const int ul_mcs_tbs_idx_table[29] = {0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 10, 11, 12, 13,
                                              14, 15, 16, 17, 18, 19, 19, 20, 21, 22, 23, 24, 25, 26};
 
+/* Inverse of the tables above, the highest MCS for each TBS index or -1 if no MCS maps to it */
+static const int dl_tbs_idx_mcs_table[27] = {0,  1,  2,  3,  4,  5,  6,  7,  8,  10, 11, 12, 13, 14,
+                                             15, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28};
+
+static const int dl_tbs_idx_mcs_table2[34] = {0,  -1, 1,  -1, 2,  -1, 3,  -1, 4,  -1, 5,  6,  7,  8,  9,  10, 11,
+                                              12, 13, 14, 15, 16, 17, 18, 19, 20, -1, 21, 22, 23, 24, 25, 26, 27};
+
+static const int ul_tbs_idx_mcs_table[27] = {0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  11, 12, 13, 14,
+                                             15, 16, 17, 18, 19, 21, 22, 23, 24, 25, 26, 27, 28};
+
 /* Transport Block Size from 3GPP TS 36.213 v12.13.0 table 7.1.7.2.1-1 */
 static const int tbs_table[SRSRAN_RA_NOF_TBS_IDX][110] = {
     /* The matrix below is automatically generated from ETSI TS 136 213 V12.13.0 (2019-03) */
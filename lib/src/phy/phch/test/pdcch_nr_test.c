@@ -68,6 +68,38 @@ static int test(srsran_pdcch_nr_t*      tx,
   return SRSRAN_SUCCESS;
 }
 
+static int test_multi(srsran_pdcch_nr_t*      tx,
+                      srsran_pdcch_nr_t*      rx,
+                      cf_t*                   grid,
+                      srsran_dmrs_pdcch_ce_t* ce,
+                      srsran_dci_msg_nr_t*    dci_msg_tx,
+                      uint32_t                nof_msg)
+{
+  srsran_pdcch_nr_res_t   res[SRSRAN_PDCCH_NR_MAX_MULTI]        = {};
+  srsran_dci_msg_nr_t     dci_msg_rx[SRSRAN_PDCCH_NR_MAX_MULTI] = {};
+  srsran_dmrs_pdcch_ce_t* ce_list[SRSRAN_PDCCH_NR_MAX_MULTI]    = {};
+
+  // Encode all the candidates in the same grid, they do not overlap
+  for (uint32_t i = 0; i < nof_msg; i++) {
+    TESTASSERT(srsran_pdcch_nr_encode(tx, &dci_msg_tx[i], grid) == SRSRAN_SUCCESS);
+    dci_msg_rx[i] = dci_msg_tx[i];
+    srsran_vec_u8_zero(dci_msg_rx[i].payload, dci_msg_rx[i].nof_bits);
+    ce_list[i] = ce;
+  }
+
+  // Decode all the candidates at once
+  TESTASSERT(srsran_pdcch_nr_decode_multi(rx, grid, ce_list, dci_msg_rx, res, nof_msg) == SRSRAN_SUCCESS);
+
+  // Assert
+  for (uint32_t i = 0; i < nof_msg; i++) {
+    TESTASSERT(res[i].evm < 0.01f);
+    TESTASSERT(res[i].crc);
+    TESTASSERT(memcmp(dci_msg_rx[i].payload, dci_msg_tx[i].payload, dci_msg_tx[i].nof_bits) == 0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 static void usage(char* prog)
 {
   printf("Usage: %s [pFIv] \n", prog);
@@ -227,6 +259,7 @@ int main(int argc, char** argv)
             continue;
           }
 
+          srsran_dci_msg_nr_t dci_msg_list[SRSRAN_PDCCH_NR_MAX_MULTI] = {};
           for (uint32_t ncce_idx = 0; ncce_idx < n; ncce_idx++) {
             // Init MSG
             srsran_dci_msg_nr_t dci_msg = {};
@@ -252,6 +285,14 @@ int main(int argc, char** argv)
               ERROR("test failed");
               goto clean_exit;
             }
+
+            dci_msg_list[ncce_idx] = dci_msg;
+          }
+
+          // Decode all the candidates of the aggregation level at once
+          if (test_multi(&pdcch_tx, &pdcch_rx, buffer, ce, dci_msg_list, (uint32_t)n) < SRSRAN_SUCCESS) {
+            ERROR("test multi failed");
+            goto clean_exit;
           }
         }
       }
@@ -261,6 +261,15 @@ static int test_case1()
         get_time_interval(t);
         t_llr_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
 
+        // Decode all the locations at once, the results must match the ones decoded one by one
+        srsran_dci_msg_t dci_multi[SRSRAN_MAX_CANDIDATES] = {};
+        for (uint32_t loc_rx = 0; loc_rx < locations_count; loc_rx++) {
+          dci_multi[loc_rx].location = locations[loc_rx];
+          dci_multi[loc_rx].format   = format;
+        }
+        TESTASSERT(srsran_pdcch_decode_msg_multi(&pdcch_rx, &dl_sf_cfg, &dci_cfg, dci_multi, locations_count) ==
+                   SRSRAN_SUCCESS);
+
         // Try decoding the PDCCH in all possible locations
         for (uint32_t loc_rx = 0; loc_rx < locations_count; loc_rx++) {
           // Skip location if:
@@ -283,6 +292,10 @@ static int test_case1()
           t_decode_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
           t_decode_count++;
 
+          TESTASSERT(dci_multi[loc_rx].rnti == dci_rx.rnti);
+          TESTASSERT(dci_multi[loc_rx].format == dci_rx.format);
+          TESTASSERT(memcmp(dci_multi[loc_rx].payload, dci_rx.payload, dci_rx.nof_bits) == 0);
+
           // Compute LLR correlation
           float corr = srsran_pdcch_msg_corr(&pdcch_rx, &dci_rx);
 
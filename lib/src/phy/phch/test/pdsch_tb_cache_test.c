@@ -0,0 +1,194 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+#include "srsran/support/srsran_test.h"
+#include <getopt.h>
+
+#define NOF_CELLS 3
+#define MAX_TB_BYTES (SRSRAN_MAX_PRB * SRSRAN_NRE * 2 * SRSRAN_CP_NORM_NSYMB * 6 / 8)
+
+static uint32_t nof_prb = 25;
+static uint32_t mcs_idx = 4;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [pm]\n", prog);
+  printf("\t-p nof_prb [Default %d]\n", nof_prb);
+  printf("\t-m mcs_idx [Default %d]\n", mcs_idx);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "pm")) != -1) {
+    switch (opt) {
+      case 'p':
+        nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'm':
+        mcs_idx = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+typedef struct {
+  srsran_cell_t          cell;
+  srsran_pdsch_t         pdsch;
+  srsran_softbuffer_tx_t softbuffer;
+  cf_t*                  sf_symbols[SRSRAN_MAX_PORTS];
+} cell_tx_t;
+
+static int cell_tx_init(cell_tx_t* q, uint32_t pci)
+{
+  q->cell                 = (srsran_cell_t){};
+  q->cell.nof_prb         = nof_prb;
+  q->cell.nof_ports       = 1;
+  q->cell.id              = pci;
+  q->cell.cp              = SRSRAN_CP_NORM;
+  q->cell.phich_length    = SRSRAN_PHICH_NORM;
+  q->cell.phich_resources = SRSRAN_PHICH_R_1;
+  q->cell.frame_type      = SRSRAN_FDD;
+
+  TESTASSERT(srsran_pdsch_init_enb(&q->pdsch, nof_prb) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_pdsch_set_cell(&q->pdsch, q->cell) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_softbuffer_tx_init(&q->softbuffer, nof_prb) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    q->sf_symbols[i] = srsran_vec_cf_malloc(SRSRAN_NOF_RE(q->cell));
+    TESTASSERT(q->sf_symbols[i] != NULL);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+static void cell_tx_free(cell_tx_t* q)
+{
+  srsran_pdsch_free(&q->pdsch);
+  srsran_softbuffer_tx_free(&q->softbuffer);
+  for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    free(q->sf_symbols[i]);
+  }
+}
+
+static int cell_tx_encode(cell_tx_t* q, uint16_t rnti, uint32_t tti, uint32_t rv, uint8_t* data)
+{
+  srsran_dl_sf_cfg_t dl_sf = {};
+  dl_sf.tti                = tti;
+  dl_sf.cfi                = 2;
+
+  srsran_dci_dl_t dci  = {};
+  dci.rnti             = rnti;
+  dci.format           = SRSRAN_DCI_FORMAT1A;
+  dci.alloc_type       = SRSRAN_RA_ALLOC_TYPE2;
+  dci.type2_alloc.riv  = srsran_ra_type2_to_riv(nof_prb / 2, 1, nof_prb);
+  dci.type2_alloc.mode = SRSRAN_RA_TYPE2_LOC;
+  dci.tb[0].mcs_idx    = mcs_idx;
+  dci.tb[0].rv         = rv;
+  dci.tb[0].cw_idx     = 0;
+  dci.tb[1].mcs_idx    = 0;
+  dci.tb[1].rv         = 1;
+
+  srsran_pdsch_cfg_t pdsch_cfg = {};
+  TESTASSERT(srsran_ra_dl_dci_to_grant(&q->cell, &dl_sf, SRSRAN_TM1, false, &dci, &pdsch_cfg.grant) ==
+             SRSRAN_SUCCESS);
+  pdsch_cfg.rnti              = rnti;
+  pdsch_cfg.softbuffers.tx[0] = &q->softbuffer;
+
+  for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    srsran_vec_cf_zero(q->sf_symbols[i], SRSRAN_NOF_RE(q->cell));
+  }
+  uint8_t* data_tb[SRSRAN_MAX_CODEWORDS] = {data, NULL};
+  TESTASSERT(srsran_pdsch_encode(&q->pdsch, &dl_sf, &pdsch_cfg, data_tb, q->sf_symbols) == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
+
+// Every cell sharing the cache transmits the same signal as if it had encoded the TB by itself
+static int test_cells_share_tb(srsran_random_t random_gen)
+{
+  cell_tx_t               ref[NOF_CELLS] = {};
+  cell_tx_t               tx[NOF_CELLS]  = {};
+  srsran_pdsch_tb_cache_t cache          = {};
+  TESTASSERT(srsran_pdsch_tb_cache_init(&cache, 2) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i < NOF_CELLS; i++) {
+    TESTASSERT(cell_tx_init(&ref[i], 1 + 7 * i) == SRSRAN_SUCCESS);
+    TESTASSERT(cell_tx_init(&tx[i], 1 + 7 * i) == SRSRAN_SUCCESS);
+    srsran_pdsch_set_tb_cache(&tx[i].pdsch, &cache);
+  }
+
+  uint8_t sib[MAX_TB_BYTES]    = {};
+  uint8_t paging[MAX_TB_BYTES] = {};
+  for (uint32_t i = 0; i < MAX_TB_BYTES; i++) {
+    sib[i]    = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 255);
+    paging[i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 255);
+  }
+
+  struct {
+    uint16_t rnti;
+    uint32_t tti;
+    uint32_t rv;
+    uint8_t* data;
+    uint64_t nof_misses; // Cache misses after the TB is sent by all the cells
+  } cases[] = {
+      {SRSRAN_SIRNTI, 5, 0, sib, 1},
+      {SRSRAN_SIRNTI, 25, 0, sib, 1},  // Same TB in another subframe is reused
+      {SRSRAN_SIRNTI, 45, 2, sib, 2},  // Other redundancy version is encoded again
+      {SRSRAN_PRNTI, 9, 0, paging, 3}, // Other content is encoded again
+      {SRSRAN_SIRNTI, 65, 0, sib, 4},  // Evicted by the two previous ones
+      {0x46, 4, 0, sib, 4},            // C-RNTI does not use the cache
+  };
+
+  for (uint32_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+    for (uint32_t i = 0; i < NOF_CELLS; i++) {
+      TESTASSERT(cell_tx_encode(&ref[i], cases[c].rnti, cases[c].tti, cases[c].rv, cases[c].data) == SRSRAN_SUCCESS);
+      TESTASSERT(cell_tx_encode(&tx[i], cases[c].rnti, cases[c].tti, cases[c].rv, cases[c].data) == SRSRAN_SUCCESS);
+      TESTASSERT(memcmp(ref[i].sf_symbols[0], tx[i].sf_symbols[0], SRSRAN_NOF_RE(ref[i].cell) * sizeof(cf_t)) == 0);
+    }
+    TESTASSERT(cache.nof_misses == cases[c].nof_misses);
+  }
+  TESTASSERT(cache.nof_hits == 5 * NOF_CELLS - cache.nof_misses);
+
+  for (uint32_t i = 0; i < NOF_CELLS; i++) {
+    cell_tx_free(&ref[i]);
+    cell_tx_free(&tx[i]);
+  }
+  srsran_pdsch_tb_cache_free(&cache);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srsran_random_t random_gen = srsran_random_init(0x1234);
+
+  int ret = test_cells_share_tb(random_gen);
+
+  srsran_random_free(random_gen);
+
+  if (ret == SRSRAN_SUCCESS) {
+    printf("Ok\n");
+  }
+  return ret;
+}
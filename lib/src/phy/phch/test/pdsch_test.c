@@ -19,6 +19,7 @@
  *
  */
 
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -55,6 +56,10 @@ static char*       input_file                   = NULL;
 static int         M                            = 1;
 static bool        enable_256qam                = false;
 static bool        use_8_bit                    = false;
+static bool        use_8_bit_softbuffer         = false;
+static bool        lazy_softbuffer              = false;
+static bool        use_tdec_batch               = false;
+static uint32_t    nof_cb_tasks                 = 0;
 
 void usage(char* prog)
 {
@@ -64,6 +69,10 @@ void usage(char* prog)
   printf("\t-M MCS2 [Default %d]\n", mcs[1]);
   printf("\t-c cell id [Default %d]\n", cell.id);
   printf("\t-b Use 8-bit LLR [Default 16-bit]\n");
+  printf("\t-S Store 8-bit soft bits in the RX soft buffers, requires -b [Default 16-bit]\n");
+  printf("\t-L Allocate the RX soft buffers on first use [Default disabled]\n");
+  printf("\t-B Use batched turbo decoder [Default disabled]\n");
+  printf("\t-P Number of parallel code block decoding tasks [Default %d]\n", nof_cb_tasks);
   printf("\t-s subframe [Default %d]\n", subframe);
   printf("\t-r rv_idx [Default %d]\n", rv_idx[0]);
   printf("\t-t rv_idx2 [Default %d]\n", rv_idx[1]);
@@ -83,7 +92,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "fmMcsbrtRFpnqawvXxj")) != -1) {
+  while ((opt = getopt(argc, argv, "fmMcsbSLBPrtRFpnqawvXxj")) != -1) {
     switch (opt) {
       case 'f':
         input_file = argv[optind];
@@ -94,6 +103,18 @@ void parse_args(int argc, char** argv)
       case 'b':
         use_8_bit = true;
         break;
+      case 'S':
+        use_8_bit_softbuffer = true;
+        break;
+      case 'L':
+        lazy_softbuffer = true;
+        break;
+      case 'B':
+        use_tdec_batch = true;
+        break;
+      case 'P':
+        nof_cb_tasks = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'M':
         mcs[1] = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
@@ -149,6 +170,45 @@ void parse_args(int argc, char** argv)
   }
 }
 
+typedef struct {
+  srsran_sch_task_t task;
+  void*             arg;
+  uint32_t          idx;
+} cb_task_t;
+
+static void* cb_task_run(void* ptr)
+{
+  cb_task_t* t = (cb_task_t*)ptr;
+  t->task(t->arg, t->idx);
+  return NULL;
+}
+
+// Runs each code block decoding task in its own thread, the calling thread runs the first one
+static void cb_parallel_for(void* executor, srsran_sch_task_t task, void* arg, uint32_t nof_tasks)
+{
+  pthread_t threads[SRSRAN_MAX_CODEBLOCKS];
+  cb_task_t tasks[SRSRAN_MAX_CODEBLOCKS];
+  bool      started[SRSRAN_MAX_CODEBLOCKS] = {};
+
+  for (uint32_t i = 1; i < nof_tasks; i++) {
+    tasks[i].task = task;
+    tasks[i].arg  = arg;
+    tasks[i].idx  = i;
+    started[i]    = pthread_create(&threads[i], NULL, cb_task_run, &tasks[i]) == 0;
+    if (!started[i]) {
+      task(arg, i);
+    }
+  }
+
+  task(arg, 0);
+
+  for (uint32_t i = 1; i < nof_tasks; i++) {
+    if (started[i]) {
+      pthread_join(threads[i], NULL);
+    }
+  }
+}
+
 static int check_softbits(srsran_pdsch_t*     pdsch_enb,
                           srsran_pdsch_t*     pdsch_ue,
                           srsran_pdsch_cfg_t* pdsch_cfg,
@@ -342,6 +402,16 @@ int main(int argc, char** argv)
   pdsch_rx.llr_is_8bit        = use_8_bit;
   pdsch_rx.dl_sch.llr_is_8bit = use_8_bit;
 
+  if (use_tdec_batch && srsran_sch_enable_tdec_batch(&pdsch_rx.dl_sch, true)) {
+    ERROR("Error enabling batched turbo decoder");
+    goto quit;
+  }
+
+  if (srsran_sch_set_cb_executor(&pdsch_rx.dl_sch, cb_parallel_for, NULL, nof_cb_tasks)) {
+    ERROR("Error setting parallel code block decoding");
+    goto quit;
+  }
+
   for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
     softbuffers_rx[i] = calloc(sizeof(srsran_softbuffer_rx_t), 1);
     if (!softbuffers_rx[i]) {
@@ -349,7 +419,12 @@ int main(int argc, char** argv)
       goto quit;
     }
 
-    if (srsran_softbuffer_rx_init(softbuffers_rx[i], cell.nof_prb)) {
+    srsran_softbuffer_rx_args_t softbuffer_args = {};
+    softbuffer_args.max_cb                      = (uint32_t)srsran_softbuffer_max_cb(cell.nof_prb);
+    softbuffer_args.max_cb_size                 = SOFTBUFFER_SIZE;
+    softbuffer_args.llr_is_8bit                 = use_8_bit_softbuffer;
+    softbuffer_args.lazy_alloc                  = lazy_softbuffer;
+    if (srsran_softbuffer_rx_init_args(softbuffers_rx[i], &softbuffer_args)) {
       ERROR("Error initiating RX soft buffer");
       goto quit;
     }
@@ -43,6 +43,7 @@ uint32_t root_seq_idx     = 0;
 uint32_t zero_corr_zone   = 1;
 uint32_t n_seqs           = 64;
 uint32_t num_ra_preambles = 0; // use default
+uint32_t nof_reps          = 1;
 
 bool freq_domain_offset_calc       = false;
 bool test_successive_cancellation  = false;
@@ -63,12 +64,13 @@ void usage(char* prog)
   printf("\t-s test_successive_cancellation  [Default false]\n");
   printf("\t-O test_offset_calculation  [Default false]\n");
   printf("\t-F freq_domain_offset_calc [Default false]\n");
+  printf("\t-R Number of detection repetitions for measuring latency [Default %d]\n", nof_reps);
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "NfrznioSsOF")) != -1) {
+  while ((opt = getopt(argc, argv, "NfrznioSsOFR")) != -1) {
     switch (opt) {
       case 'N':
         nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -103,6 +105,9 @@ void parse_args(int argc, char** argv)
       case 'F':
         freq_domain_offset_calc = true;
         break;
+      case 'R':
+        nof_reps = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -233,11 +238,21 @@ int main(int argc, char** argv)
     prach_len /= 2;
   }
   struct timeval t[3];
-  gettimeofday(&t[1], NULL);
-  srsran_prach_detect_offset(&prach, 0, &preamble_sum[prach.N_cp], prach_len, indices, t_offsets, NULL, &n_indices);
-  gettimeofday(&t[2], NULL);
-  get_time_interval(t);
-  printf("texec=%ld us\n", t[0].tv_usec);
+  uint64_t       texec_sum = 0;
+  uint64_t       texec_max = 0;
+  for (uint32_t r = 0; r < SRSRAN_MAX(nof_reps, 1); r++) {
+    gettimeofday(&t[1], NULL);
+    srsran_prach_detect_offset(&prach, 0, &preamble_sum[prach.N_cp], prach_len, indices, t_offsets, NULL, &n_indices);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    uint64_t texec = t[0].tv_sec * 1000000UL + t[0].tv_usec;
+    texec_sum += texec;
+    texec_max = SRSRAN_MAX(texec_max, texec);
+  }
+  printf("texec=%.1f us (max %" PRIu64 " us, %d detections)\n",
+         (double)texec_sum / SRSRAN_MAX(nof_reps, 1),
+         texec_max,
+         SRSRAN_MAX(nof_reps, 1));
   int err = 0;
   if (n_indices != n_seqs) {
     printf("n_indices %d n_seq %d\n", n_indices, n_seqs);
@@ -0,0 +1,493 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        pssch_pscch_bench.c
+ * Description: Measures the sidelink TM3/4 blind decoding throughput over one
+ *              of the signal_sidelink_* captures. The capture is OFDM
+ *              demodulated beforehand, then every PSCCH candidate (sub-channel
+ *              and DMRS cyclic shift) of every subframe is channel estimated
+ *              and decoded, followed by the PSSCH it schedules. Candidates are
+ *              shared by 1 to -T threads, each with its own PSCCH, PSSCH and
+ *              channel estimators. Results are reported as JSON.
+ *****************************************************************************/
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "srsran/phy/ch_estimation/chest_sl.h"
+#include "srsran/phy/common/phy_common_sl.h"
+#include "srsran/phy/dft/dft_precoding.h"
+#include "srsran/phy/dft/ofdm.h"
+#include "srsran/phy/io/filesource.h"
+#include "srsran/phy/phch/pscch.h"
+#include "srsran/phy/phch/pssch.h"
+#include "srsran/phy/phch/ra_sl.h"
+#include "srsran/phy/phch/sci.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+
+#define BENCH_MAX_THREADS 64
+#define BENCH_MAX_SUBFRAMES 128
+#define BENCH_NOF_CYCLIC_SHIFTS 4
+
+static char*            input_file_name = NULL;
+static srsran_cell_sl_t cell            = {.nof_prb = 50, .N_sl_id = 0, .tm = SRSRAN_SIDELINK_TM4, .cp = SRSRAN_CP_NORM};
+static bool             use_standard_lte_rates = false;
+static uint32_t         file_offset            = 0;
+static uint32_t         size_sub_channel       = 10;
+static uint32_t         num_sub_channel        = 5;
+static uint32_t         first_sf_idx           = 0;
+static uint32_t         nof_rounds             = 10;
+static uint32_t         max_threads            = 4;
+static char*            output_file            = NULL;
+
+static srsran_sl_comm_resource_pool_t sl_comm_resource_pool = {};
+static uint32_t                       sf_n_re               = 0;
+static uint32_t                       nof_subframes         = 0;
+static cf_t*                          subframes[BENCH_MAX_SUBFRAMES];
+
+typedef struct {
+  srsran_sci_t      sci;
+  srsran_pscch_t    pscch;
+  srsran_chest_sl_t pscch_chest;
+  srsran_pssch_t    pssch;
+  srsran_chest_sl_t pssch_chest;
+  cf_t*             equalized_sf_buffer;
+  uint8_t           tb[SRSRAN_SL_SCH_MAX_TB_LEN];
+
+  pthread_barrier_t* barrier;
+  uint32_t*          next_candidate;
+  uint32_t           nof_candidates;
+  uint32_t           nof_sci;
+  uint32_t           nof_tb;
+  uint64_t           elapsed_ns;
+} bench_worker_t;
+
+typedef struct {
+  uint32_t nof_threads;
+  uint32_t nof_candidates;
+  uint32_t nof_sci;
+  uint32_t nof_tb;
+  uint64_t elapsed_ns;
+} bench_result_t;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [deimnoprsTtfv]\n", prog);
+  printf("\t-i input_file_name\n");
+  printf("\t-o File offset samples [Default %d]\n", file_offset);
+  printf("\t-p nof_prb [Default %d]\n", cell.nof_prb);
+  printf("\t-s size_sub_channel [Default %d]\n", size_sub_channel);
+  printf("\t-n num_sub_channel [Default %d]\n", num_sub_channel);
+  printf("\t-m Subframe index of the first subframe [Default %d]\n", first_sf_idx);
+  printf("\t-e Extended CP [Default normal]\n");
+  printf("\t-t Sidelink transmission mode {3,4} [Default %d]\n", (cell.tm + 1));
+  printf("\t-d use_standard_lte_rates [Default %i]\n", use_standard_lte_rates);
+  printf("\t-r number of times the capture is decoded [Default %d]\n", nof_rounds);
+  printf("\t-T maximum number of threads, doubled from 1 [Default %d]\n", max_threads);
+  printf("\t-f JSON output file [Default stdout]\n");
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "deimnoprsTtfv")) != -1) {
+    switch (opt) {
+      case 'd':
+        use_standard_lte_rates = true;
+        break;
+      case 'o':
+        file_offset = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'e':
+        cell.cp = SRSRAN_CP_EXT;
+        break;
+      case 'i':
+        input_file_name = argv[optind];
+        break;
+      case 's':
+        size_sub_channel = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        num_sub_channel = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'm':
+        first_sf_idx = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'p':
+        cell.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_rounds = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'T':
+        max_threads = SRSRAN_MIN((uint32_t)strtol(argv[optind], NULL, 10), BENCH_MAX_THREADS);
+        break;
+      case 't':
+        if (srsran_sl_tm_to_cell_sl_tm_t(&cell, strtol(argv[optind], NULL, 10)) != SRSRAN_SUCCESS) {
+          usage(argv[0]);
+          exit(-1);
+        }
+        break;
+      case 'f':
+        output_file = argv[optind];
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (input_file_name == NULL || cell.tm < SRSRAN_SIDELINK_TM3 || SRSRAN_CP_ISEXT(cell.cp)) {
+    ERROR("An input file and TM3/4 with normal CP are required");
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+static uint64_t bench_time_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000UL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t bench_candidates_per_sf(void)
+{
+  return sl_comm_resource_pool.num_sub_channel * BENCH_NOF_CYCLIC_SHIFTS;
+}
+
+/* Reads and OFDM demodulates the whole capture, which is not part of the measurement */
+static int bench_load(void)
+{
+  srsran_filesource_t fsrc         = {};
+  srsran_ofdm_t       fft          = {};
+  uint32_t            sf_n_samples = srsran_symbol_sz(cell.nof_prb) * 15;
+  cf_t*               input_buffer = srsran_vec_cf_malloc(sf_n_samples);
+  cf_t*               sf_buffer    = srsran_vec_cf_malloc(sf_n_re);
+  int                 ret          = SRSRAN_ERROR;
+
+  if (input_buffer == NULL || sf_buffer == NULL) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+  if (srsran_filesource_init(&fsrc, input_file_name, SRSRAN_COMPLEX_FLOAT_BIN)) {
+    ERROR("Error opening file %s", input_file_name);
+    goto clean_exit;
+  }
+  if (srsran_ofdm_rx_init(&fft, cell.cp, input_buffer, sf_buffer, cell.nof_prb)) {
+    ERROR("Error creating FFT object");
+    srsran_filesource_free(&fsrc);
+    goto clean_exit;
+  }
+  srsran_ofdm_set_normalize(&fft, true);
+  srsran_ofdm_set_freq_shift(&fft, -0.5);
+
+  if (file_offset > 0) {
+    srsran_filesource_seek(&fsrc, file_offset * sizeof(cf_t));
+  }
+
+  while (nof_subframes < BENCH_MAX_SUBFRAMES && srsran_filesource_read(&fsrc, input_buffer, sf_n_samples) > 0) {
+    srsran_ofdm_rx_sf(&fft);
+    subframes[nof_subframes] = srsran_vec_cf_malloc(sf_n_re);
+    if (subframes[nof_subframes] == NULL) {
+      ERROR("Error allocating memory");
+      break;
+    }
+    srsran_vec_cf_copy(subframes[nof_subframes], sf_buffer, sf_n_re);
+    nof_subframes++;
+  }
+  ret = (nof_subframes > 0) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+
+  srsran_ofdm_rx_free(&fft);
+  srsran_filesource_free(&fsrc);
+
+clean_exit:
+  free(input_buffer);
+  free(sf_buffer);
+  return ret;
+}
+
+static int bench_worker_init(bench_worker_t* w)
+{
+  w->equalized_sf_buffer = srsran_vec_cf_malloc(sf_n_re);
+  if (w->equalized_sf_buffer == NULL) {
+    ERROR("Error allocating memory");
+    return SRSRAN_ERROR;
+  }
+  srsran_vec_cf_zero(w->equalized_sf_buffer, sf_n_re);
+
+  if (srsran_sci_init(&w->sci, &cell, &sl_comm_resource_pool) < SRSRAN_SUCCESS ||
+      srsran_pscch_init(&w->pscch, SRSRAN_MAX_PRB) != SRSRAN_SUCCESS ||
+      srsran_pscch_set_cell(&w->pscch, cell) != SRSRAN_SUCCESS ||
+      srsran_chest_sl_init(&w->pscch_chest, SRSRAN_SIDELINK_PSCCH, cell, &sl_comm_resource_pool) != SRSRAN_SUCCESS ||
+      srsran_pssch_init(&w->pssch, &cell, &sl_comm_resource_pool) != SRSRAN_SUCCESS ||
+      srsran_chest_sl_init(&w->pssch_chest, SRSRAN_SIDELINK_PSSCH, cell, &sl_comm_resource_pool) != SRSRAN_SUCCESS) {
+    ERROR("Error initializing the sidelink objects");
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+static void bench_worker_free(bench_worker_t* w)
+{
+  srsran_sci_free(&w->sci);
+  srsran_pscch_free(&w->pscch);
+  srsran_chest_sl_free(&w->pscch_chest);
+  srsran_pssch_free(&w->pssch);
+  srsran_chest_sl_free(&w->pssch_chest);
+  free(w->equalized_sf_buffer);
+}
+
+/* Decodes the PSSCH scheduled by the SCI just found in the given sub-channel, as pssch_pscch_file_test does */
+static void bench_decode_pssch(bench_worker_t* w, cf_t* sf_buffer, uint32_t sub_channel_idx, uint32_t sf_idx)
+{
+  uint32_t sub_channel_start_idx = 0;
+  uint32_t L_subCH               = 0;
+  srsran_ra_sl_type0_from_riv(w->sci.riv, sl_comm_resource_pool.num_sub_channel, &L_subCH, &sub_channel_start_idx);
+
+  // 3GPP TS 36.213 Section 14.1.1.4C
+  uint32_t pssch_prb_start_idx = (sub_channel_idx * sl_comm_resource_pool.size_sub_channel) + w->pscch.pscch_nof_prb +
+                                 sl_comm_resource_pool.start_prb_sub_channel;
+  uint32_t nof_prb_pssch = ((L_subCH + sub_channel_idx) * sl_comm_resource_pool.size_sub_channel) -
+                           pssch_prb_start_idx + sl_comm_resource_pool.start_prb_sub_channel;
+  nof_prb_pssch          = srsran_dft_precoding_get_valid_prb(nof_prb_pssch);
+
+  uint32_t N_x_id = 0;
+  for (int j = 0; j < SRSRAN_SCI_CRC_LEN; j++) {
+    N_x_id += w->pscch.sci_crc[j] * (1 << (SRSRAN_SCI_CRC_LEN - 1 - j));
+  }
+  uint32_t rv_idx = w->sci.retransmission ? 1 : 0;
+
+  srsran_chest_sl_cfg_t pssch_chest_sl_cfg = {};
+  pssch_chest_sl_cfg.N_x_id                = N_x_id;
+  pssch_chest_sl_cfg.sf_idx                = sf_idx;
+  pssch_chest_sl_cfg.prb_start_idx         = pssch_prb_start_idx;
+  pssch_chest_sl_cfg.nof_prb               = nof_prb_pssch;
+  srsran_chest_sl_set_cfg(&w->pssch_chest, pssch_chest_sl_cfg);
+  srsran_chest_sl_ls_estimate_equalize(&w->pssch_chest, sf_buffer, w->equalized_sf_buffer);
+
+  srsran_pssch_cfg_t pssch_cfg = {pssch_prb_start_idx, nof_prb_pssch, N_x_id, w->sci.mcs_idx, rv_idx, sf_idx};
+  if (srsran_pssch_set_cfg(&w->pssch, pssch_cfg) == SRSRAN_SUCCESS) {
+    if (srsran_pssch_decode(&w->pssch, w->equalized_sf_buffer, w->tb, SRSRAN_SL_SCH_MAX_TB_LEN) == SRSRAN_SUCCESS) {
+      w->nof_tb++;
+    }
+  }
+}
+
+static void bench_decode_candidate(bench_worker_t* w, uint32_t candidate)
+{
+  uint32_t per_sf          = bench_candidates_per_sf();
+  uint32_t sf              = (candidate / per_sf) % nof_subframes;
+  uint32_t sub_channel_idx = (candidate % per_sf) / BENCH_NOF_CYCLIC_SHIFTS;
+  uint32_t cyclic_shift    = (candidate % BENCH_NOF_CYCLIC_SHIFTS) * 3;
+  uint32_t sf_idx          = (first_sf_idx + sf) % 10;
+  cf_t*    sf_buffer       = subframes[sf];
+  uint8_t  sci_rx[SRSRAN_SCI_MAX_LEN] = {};
+
+  uint32_t              pscch_prb_start_idx = sl_comm_resource_pool.size_sub_channel * sub_channel_idx;
+  srsran_chest_sl_cfg_t pscch_chest_sl_cfg  = {};
+  pscch_chest_sl_cfg.cyclic_shift           = cyclic_shift;
+  pscch_chest_sl_cfg.prb_start_idx          = pscch_prb_start_idx;
+  srsran_chest_sl_set_cfg(&w->pscch_chest, pscch_chest_sl_cfg);
+  srsran_chest_sl_ls_estimate_equalize(&w->pscch_chest, sf_buffer, w->equalized_sf_buffer);
+
+  if (srsran_pscch_decode(&w->pscch, w->equalized_sf_buffer, sci_rx, pscch_prb_start_idx) == SRSRAN_SUCCESS &&
+      srsran_sci_format1_unpack(&w->sci, sci_rx) == SRSRAN_SUCCESS) {
+    w->nof_sci++;
+    bench_decode_pssch(w, sf_buffer, sub_channel_idx, sf_idx);
+  }
+}
+
+static void* bench_worker(void* arg)
+{
+  bench_worker_t* w = (bench_worker_t*)arg;
+
+  // Start all the threads at the same time
+  pthread_barrier_wait(w->barrier);
+
+  uint64_t t0 = bench_time_ns();
+  for (;;) {
+    uint32_t candidate = __atomic_fetch_add(w->next_candidate, 1, __ATOMIC_RELAXED);
+    if (candidate >= w->nof_candidates) {
+      break;
+    }
+    bench_decode_candidate(w, candidate);
+  }
+  w->elapsed_ns = bench_time_ns() - t0;
+
+  return NULL;
+}
+
+static int bench_run(uint32_t nof_threads, bench_result_t* res)
+{
+  bench_worker_t*   workers        = calloc(nof_threads, sizeof(bench_worker_t));
+  pthread_t         threads[BENCH_MAX_THREADS];
+  pthread_barrier_t barrier;
+  uint32_t          next_candidate = 0;
+  uint32_t          nof_candidates = nof_rounds * nof_subframes * bench_candidates_per_sf();
+  int               ret            = SRSRAN_SUCCESS;
+
+  if (workers == NULL) {
+    ERROR("Error allocating workers");
+    return SRSRAN_ERROR;
+  }
+  pthread_barrier_init(&barrier, NULL, nof_threads);
+
+  uint32_t nof_init = 0;
+  for (; nof_init < nof_threads && ret == SRSRAN_SUCCESS; nof_init++) {
+    workers[nof_init].barrier        = &barrier;
+    workers[nof_init].next_candidate = &next_candidate;
+    workers[nof_init].nof_candidates = nof_candidates;
+    ret                              = bench_worker_init(&workers[nof_init]);
+  }
+
+  if (ret == SRSRAN_SUCCESS) {
+    for (uint32_t i = 0; i < nof_threads; i++) {
+      if (pthread_create(&threads[i], NULL, bench_worker, &workers[i])) {
+        ERROR("Error creating thread");
+        exit(-1);
+      }
+    }
+    for (uint32_t i = 0; i < nof_threads; i++) {
+      pthread_join(threads[i], NULL);
+    }
+  }
+
+  memset(res, 0, sizeof(bench_result_t));
+  res->nof_threads    = nof_threads;
+  res->nof_candidates = nof_candidates;
+
+  // The aggregated throughput is given by the slowest thread
+  for (uint32_t i = 0; i < nof_init; i++) {
+    res->nof_sci += workers[i].nof_sci;
+    res->nof_tb += workers[i].nof_tb;
+    res->elapsed_ns = SRSRAN_MAX(res->elapsed_ns, workers[i].elapsed_ns);
+    bench_worker_free(&workers[i]);
+  }
+
+  pthread_barrier_destroy(&barrier);
+  free(workers);
+  return ret;
+}
+
+static void print_result(FILE* f, const bench_result_t* res, bool last)
+{
+  double nof_sf = (double)nof_rounds * nof_subframes;
+  fprintf(f,
+          "    {\"nof_threads\": %d, \"nof_candidates\": %d, \"nof_sci\": %d, \"nof_tb\": %d, ",
+          res->nof_threads,
+          res->nof_candidates,
+          res->nof_sci,
+          res->nof_tb);
+  fprintf(f,
+          "\"sf_per_s\": %.1f, \"us_per_sf\": %.2f, \"ns_per_candidate\": %.1f}%s\n",
+          res->elapsed_ns ? nof_sf * 1e9 / res->elapsed_ns : 0.0,
+          (double)res->elapsed_ns / 1000.0 / nof_sf,
+          res->nof_candidates ? (double)res->elapsed_ns / res->nof_candidates : 0.0,
+          last ? "" : ",");
+}
+
+int main(int argc, char** argv)
+{
+  int            ret         = SRSRAN_ERROR;
+  FILE*          f           = stdout;
+  bench_result_t results[8]  = {};
+  uint32_t       nof_results = 0;
+
+  parse_args(argc, argv);
+  srsran_use_standard_symbol_size(use_standard_lte_rates);
+
+  sf_n_re = SRSRAN_SF_LEN_RE(cell.nof_prb, cell.cp);
+  if (srsran_sl_comm_resource_pool_get_default_config(&sl_comm_resource_pool, cell) != SRSRAN_SUCCESS) {
+    ERROR("Error initializing sl_comm_resource_pool");
+    return SRSRAN_ERROR;
+  }
+  sl_comm_resource_pool.num_sub_channel  = num_sub_channel;
+  sl_comm_resource_pool.size_sub_channel = size_sub_channel;
+
+  if (bench_load() != SRSRAN_SUCCESS) {
+    ERROR("Error loading %s", input_file_name);
+    goto quit;
+  }
+
+  for (uint32_t t = 1; t <= max_threads && nof_results < 8; t *= 2) {
+    if (bench_run(t, &results[nof_results]) != SRSRAN_SUCCESS) {
+      ERROR("Error running with %d threads", t);
+      goto quit;
+    }
+    nof_results++;
+  }
+
+  if (output_file) {
+    f = fopen(output_file, "w");
+    if (f == NULL) {
+      ERROR("Error opening %s", output_file);
+      goto quit;
+    }
+  }
+
+  fprintf(f,
+          "{\n  \"nof_prb\": %d,\n  \"tm\": %d,\n  \"nof_subframes\": %d,\n  \"nof_rounds\": %d,\n",
+          cell.nof_prb,
+          cell.tm + 1,
+          nof_subframes,
+          nof_rounds);
+  fprintf(f, "  \"candidates_per_sf\": %d,\n  \"results\": [\n", bench_candidates_per_sf());
+  for (uint32_t i = 0; i < nof_results; i++) {
+    print_result(f, &results[i], i + 1 == nof_results);
+  }
+  fprintf(f, "  ]\n}\n");
+
+  if (f != stdout) {
+    fclose(f);
+  }
+
+  // Sharing the candidates among threads must not change what is decoded
+  ret = (nof_results > 0 && results[0].nof_sci > 0) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+  for (uint32_t i = 1; i < nof_results; i++) {
+    if (results[i].nof_sci != results[0].nof_sci || results[i].nof_tb != results[0].nof_tb) {
+      ERROR("%d threads decoded %d SCI and %d TB, but one thread decoded %d SCI and %d TB",
+            results[i].nof_threads,
+            results[i].nof_sci,
+            results[i].nof_tb,
+            results[0].nof_sci,
+            results[0].nof_tb);
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+quit:
+  for (uint32_t i = 0; i < nof_subframes; i++) {
+    free(subframes[i]);
+  }
+  return ret;
+}
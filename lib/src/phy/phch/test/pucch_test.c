@@ -41,6 +41,7 @@ static srsran_cell_t cell = {
 
 static uint32_t subframe      = 0;
 static bool     test_cqi_only = false;
+static bool     test_batch    = false;
 static float    snr_db        = 20.0f;
 
 static void usage(char* prog)
@@ -50,6 +51,7 @@ static void usage(char* prog)
   printf("\t-s subframe [Default %d]\n", subframe);
   printf("\t-n nof_prb [Default %d]\n", cell.nof_prb);
   printf("\t-q Test CQI encoding/decoding only [Default %s].\n", test_cqi_only ? "yes" : "no");
+  printf("\t-b Test batched format 1 detection of multiplexed UE only [Default %s].\n", test_batch ? "yes" : "no");
   printf("\t-S Signal to Noise Ratio in dB [Default %.2f].\n", snr_db);
   printf("\t-v [set verbose to debug, default none]\n");
 }
@@ -57,7 +59,7 @@ static void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "csNnqSv")) != -1) {
+  while ((opt = getopt(argc, argv, "csNnqbSv")) != -1) {
     switch (opt) {
       case 's':
         subframe = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -71,6 +73,9 @@ void parse_args(int argc, char** argv)
       case 'q':
         test_cqi_only = true;
         break;
+      case 'b':
+        test_batch = true;
+        break;
       case 'S':
         snr_db = strtof(argv[optind], NULL);
         break;
@@ -138,6 +143,117 @@ int test_uci_cqi_pucch(void)
   return ret;
 }
 
+#define TEST_BATCH_NOF_RES 8
+
+/* Multiplexes format 1, 1a and 1b UE in the same PRB, some of them silent, and checks that the batched detector finds
+ * the same as the per-UE decoder */
+static int test_pucch_batch(srsran_pucch_t*        pucch_ue,
+                            srsran_pucch_t*        pucch_enb,
+                            srsran_refsignal_ul_t* dmrs,
+                            srsran_chest_ul_t*     chest,
+                            srsran_chest_ul_res_t* chest_res,
+                            srsran_channel_awgn_t* awgn,
+                            cf_t*                  sf_symbols)
+{
+  const uint32_t     n_pucch[TEST_BATCH_NOF_RES] = {0, 7, 20, 33, 3, 12, 25, 30};
+  const bool         active[TEST_BATCH_NOF_RES]  = {true, true, true, true, false, false, false, false};
+  srsran_pucch_cfg_t cfg[TEST_BATCH_NOF_RES]     = {};
+  srsran_pucch_res_t res[TEST_BATCH_NOF_RES]     = {};
+  srsran_ul_sf_cfg_t ul_sf                       = {};
+  cf_t               pucch_dmrs[2 * SRSRAN_NRE * 3];
+  int                ret = SRSRAN_ERROR;
+
+  cf_t* sf_ue = srsran_vec_cf_malloc(SRSRAN_NOF_RE(cell));
+  if (!sf_ue) {
+    return SRSRAN_ERROR;
+  }
+
+  for (ul_sf.tti = 0; ul_sf.tti < SRSRAN_NOF_SF_X_FRAME; ul_sf.tti++) {
+    srsran_uci_value_t uci[TEST_BATCH_NOF_RES] = {};
+
+    srsran_vec_cf_zero(sf_symbols, SRSRAN_NOF_RE(cell));
+    for (uint32_t i = 0; i < TEST_BATCH_NOF_RES; i++) {
+      cfg[i].delta_pucch_shift             = 2;
+      cfg[i].N_cs                          = 0;
+      cfg[i].n_rb_2                        = 0;
+      cfg[i].format                        = (srsran_pucch_format_t)(SRSRAN_PUCCH_FORMAT_1 + i % 3);
+      cfg[i].n_pucch                       = n_pucch[i];
+      cfg[i].rnti                          = 0x46 + i;
+      cfg[i].threshold_format1             = SRSRAN_PUCCH_DEFAULT_THRESHOLD_FORMAT1;
+      cfg[i].threshold_data_valid_format1a = SRSRAN_PUCCH_DEFAULT_THRESHOLD_FORMAT1A;
+      cfg[i].threshold_dmrs_detection      = SRSRAN_PUCCH_DEFAULT_THRESHOLD_DMRS;
+      if (cfg[i].format == SRSRAN_PUCCH_FORMAT_1) {
+        cfg[i].uci_cfg.is_scheduling_request_tti = true;
+      } else {
+        cfg[i].uci_cfg.ack[0].nof_acks = cfg[i].format == SRSRAN_PUCCH_FORMAT_1A ? 1 : 2;
+      }
+      uci[i].ack.ack_value[0]   = (ul_sf.tti + i) % 2;
+      uci[i].ack.ack_value[1]   = (ul_sf.tti / 2 + i) % 2;
+      uci[i].scheduling_request = true;
+
+      if (!active[i]) {
+        continue;
+      }
+
+      // Each UE signal is added to the others
+      srsran_vec_cf_zero(sf_ue, SRSRAN_NOF_RE(cell));
+      if (srsran_pucch_encode(pucch_ue, &ul_sf, &cfg[i], &uci[i], sf_ue) ||
+          srsran_refsignal_dmrs_pucch_gen(dmrs, &ul_sf, &cfg[i], pucch_dmrs) ||
+          srsran_refsignal_dmrs_pucch_put(dmrs, &cfg[i], pucch_dmrs, sf_ue)) {
+        ERROR("Error encoding PUCCH");
+        goto clean_exit;
+      }
+      srsran_vec_sum_ccc(sf_symbols, sf_ue, sf_symbols, SRSRAN_NOF_RE(cell));
+    }
+
+    srsran_channel_awgn_run_c(awgn, sf_symbols, sf_symbols, SRSRAN_NOF_RE(cell));
+
+    if (srsran_pucch_decode_format1_batch(pucch_enb, &ul_sf, cfg, sf_symbols, res, TEST_BATCH_NOF_RES)) {
+      ERROR("Error decoding PUCCH batch");
+      goto clean_exit;
+    }
+
+    for (uint32_t i = 0; i < TEST_BATCH_NOF_RES; i++) {
+      srsran_pucch_res_t res_ue = {};
+      if (srsran_chest_ul_estimate_pucch(chest, &ul_sf, &cfg[i], sf_symbols, chest_res) ||
+          srsran_pucch_decode(pucch_enb, &ul_sf, &cfg[i], chest_res, sf_symbols, &res_ue)) {
+        ERROR("Error decoding PUCCH");
+        goto clean_exit;
+      }
+
+      INFO("tti=%d; n_pucch=%d; f=%s; batch: det=%d corr=%.2f dmrs=%.2f snr=%.1f; ue: det=%d corr=%.2f dmrs=%.2f",
+           ul_sf.tti,
+           cfg[i].n_pucch,
+           srsran_pucch_format_text_short(cfg[i].format),
+           res[i].detected,
+           res[i].correlation,
+           res[i].dmrs_correlation,
+           res[i].snr_db,
+           res_ue.detected,
+           res_ue.correlation,
+           res_ue.dmrs_correlation);
+
+      if (res[i].detected != active[i] || res_ue.detected != active[i]) {
+        ERROR("PUCCH n_pucch=%d detection mismatch", cfg[i].n_pucch);
+        goto clean_exit;
+      }
+      for (uint32_t b = 0; active[i] && b < srsran_pucch_nof_ack_format(cfg[i].format); b++) {
+        if (res[i].uci_data.ack.ack_value[b] != uci[i].ack.ack_value[b] ||
+            res_ue.uci_data.ack.ack_value[b] != uci[i].ack.ack_value[b] || !res[i].uci_data.ack.valid) {
+          ERROR("PUCCH n_pucch=%d ACK mismatch", cfg[i].n_pucch);
+          goto clean_exit;
+        }
+      }
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  free(sf_ue);
+  return ret;
+}
+
 int main(int argc, char** argv)
 {
   srsran_pucch_t        pucch_ue   = {};
@@ -207,6 +323,11 @@ int main(int argc, char** argv)
     goto quit;
   }
 
+  if (test_batch) {
+    ret = test_pucch_batch(&pucch_ue, &pucch_enb, &dmrs, &chest, &chest_res, &awgn, sf_symbols);
+    goto quit;
+  }
+
   srsran_ul_sf_cfg_t ul_sf;
   ZERO_OBJECT(ul_sf);
 
@@ -182,13 +182,14 @@ void parse_args(int argc, char** argv)
 int main(int argc, char** argv)
 {
   srsran_random_t        random_h = srsran_random_init(0);
-  srsran_chest_ul_res_t  chest_res  = {};
-  srsran_pusch_t         pusch_tx   = {};
-  srsran_pusch_t         pusch_rx   = {};
-  uint8_t*               data       = NULL;
-  uint8_t*               data_rx    = NULL;
-  cf_t*                  sf_symbols = NULL;
-  int                    ret        = -1;
+  srsran_chest_ul_res_t  chest_res      = {};
+  srsran_pusch_t         pusch_tx       = {};
+  srsran_pusch_t         pusch_rx       = {};
+  uint8_t*               data           = NULL;
+  uint8_t*               data_rx        = NULL;
+  cf_t*                  sf_symbols     = NULL;
+  cf_t*                  sf_symbols_pre = NULL;
+  int                    ret            = -1;
   struct timeval         t[3];
   srsran_pusch_cfg_t     cfg           = {};
   srsran_softbuffer_tx_t softbuffer_tx = {};
@@ -255,6 +256,12 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
+  sf_symbols_pre = srsran_vec_cf_malloc(nof_re);
+  if (!sf_symbols_pre) {
+    perror("malloc");
+    exit(-1);
+  }
+
   data = srsran_vec_u8_malloc(150000);
   if (!data) {
     perror("malloc");
@@ -310,6 +317,7 @@ int main(int argc, char** argv)
     pdata.uci          = uci_data_tx.value;
     cfg.uci_cfg        = uci_data_tx.cfg;
     cfg.softbuffers.tx = &softbuffer_tx;
+    cfg.grant.tb.rv    = 0;
 
     if (srsran_pusch_encode(&pusch_tx, &ul_sf, &cfg, &pdata, sf_symbols)) {
       ERROR("Error encoding TB");
@@ -323,6 +331,21 @@ int main(int argc, char** argv)
       }
     }
 
+    // Encoding the code blocks ahead must give the same signal
+    if (cfg.grant.tb.tbs > 0) {
+      memcpy(sf_symbols_pre, sf_symbols, sizeof(cf_t) * nof_re);
+      if (srsran_ulsch_pre_encode(&pusch_tx.ul_sch, &cfg, data) ||
+          srsran_pusch_encode(&pusch_tx, &ul_sf, &cfg, &pdata, sf_symbols_pre)) {
+        ERROR("Error encoding pre-encoded TB");
+        exit(-1);
+      }
+      if (memcmp(sf_symbols_pre, sf_symbols, sizeof(cf_t) * nof_re) != 0) {
+        ERROR("Pre-encoded TB does not match");
+        ret = SRSRAN_ERROR;
+        goto quit;
+      }
+    }
+
     srsran_pusch_res_t pusch_res = {};
     pusch_res.data               = data_rx;
     cfg.softbuffers.rx           = &softbuffer_rx;
@@ -409,6 +432,9 @@ quit:
   if (sf_symbols) {
     free(sf_symbols);
   }
+  if (sf_symbols_pre) {
+    free(sf_symbols_pre);
+  }
   if (data) {
     free(data);
   }
@@ -33,6 +33,8 @@ static uint32_t            n_prb     = 0;  // Set to 0 for steering
 static uint32_t            mcs       = 30; // Set to 30 for steering
 static uint32_t            rv        = 4;  // Set to 30 for steering
 static srsran_sch_cfg_nr_t pdsch_cfg = {};
+static uint32_t            nof_interleaved_cb = 0;
+static int                 nof_offload_workers = -1; // Set to 0 or more to decode in the CPU FEC offload
 
 static void usage(char* prog)
 {
@@ -44,13 +46,16 @@ static void usage(char* prog)
   printf("\t-T Provide MCS table (64qam, 256qam, 64qamLowSE) [Default %s]\n",
          srsran_mcs_table_to_str(pdsch_cfg.sch_cfg.mcs_table));
   printf("\t-L Provide number of layers [Default %d]\n", carrier.max_mimo_layers);
+  printf("\t-S Number of code blocks decoded iteration by iteration together [Default %d]\n", nof_interleaved_cb);
+  printf("\t-O Decode in the CPU FEC offload with the given number of workers, -1 to disable [Default %d]\n",
+         nof_offload_workers);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "PpmTLvr")) != -1) {
+  while ((opt = getopt(argc, argv, "PpmTLSOvr")) != -1) {
     switch (opt) {
       case 'P':
         carrier.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -70,6 +75,12 @@ int parse_args(int argc, char** argv)
       case 'L':
         carrier.max_mimo_layers = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'S':
+        nof_interleaved_cb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'O':
+        nof_offload_workers = (int)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -89,6 +100,8 @@ int main(int argc, char** argv)
   srsran_sch_nr_t sch_nr_rx = {};
   srsran_random_t rand_gen  = srsran_random_init(1234);
 
+  srsran_fec_offload_t fec_offload = {};
+
   uint8_t* data_tx = srsran_vec_u8_malloc(1024 * 1024);
   uint8_t* encoded = srsran_vec_u8_malloc(1024 * 1024 * 8);
   int8_t*  llr     = srsran_vec_i8_malloc(1024 * 1024 * 8);
@@ -110,6 +123,24 @@ int main(int argc, char** argv)
   args.decoder_use_flooded    = false;
   args.decoder_scaling_factor = 0.8;
   args.max_nof_iter           = 20;
+
+  args.decoder_nof_interleaved_cb = nof_interleaved_cb;
+
+  if (nof_offload_workers >= 0) {
+    srsran_fec_offload_args_t offload_args = {};
+    offload_args.backend                   = SRSRAN_FEC_OFFLOAD_CPU;
+    offload_args.queue_size                = SRSRAN_SCH_NR_MAX_NOF_CB_LDPC;
+    offload_args.nof_workers               = (uint32_t)nof_offload_workers;
+    offload_args.ldpc_decoder_type         = SRSRAN_LDPC_DECODER_C;
+    offload_args.ldpc_scaling_factor       = args.decoder_scaling_factor;
+    offload_args.ldpc_max_nof_iter         = args.max_nof_iter;
+    if (srsran_fec_offload_init(&fec_offload, &offload_args) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating FEC offload");
+      goto clean_exit;
+    }
+    args.fec_offload = &fec_offload;
+  }
+
   if (srsran_sch_nr_init_tx(&sch_nr_tx, &args) < SRSRAN_SUCCESS) {
     ERROR("Error initiating SCH NR for Tx");
     goto clean_exit;
@@ -240,6 +271,7 @@ clean_exit:
   srsran_random_free(rand_gen);
   srsran_sch_nr_free(&sch_nr_tx);
   srsran_sch_nr_free(&sch_nr_rx);
+  srsran_fec_offload_free(&fec_offload);
   if (data_tx) {
     free(data_tx);
   }
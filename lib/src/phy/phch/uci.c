@@ -36,6 +36,7 @@
 #include "srsran/phy/phch/uci.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 
 /* Table 5.2.3.3-1: Basis sequences for (20, A) code */
@@ -52,23 +53,36 @@ static uint8_t M_basis_seq_pucch[20][13] = {
     {1, 1, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0}, {1, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0},
 };
 
+// Basis sequences packed in a word, bit n is the basis sequence of the CQI bit n
+static uint16_t M_basis_seq_pucch_b[SRSRAN_UCI_CQI_CODED_PUCCH_B];
+
+// Maximum likelihood decoder of the (20, A) code, the CQI bits are decoded MSB first
+static srsran_block_rm_t cqi_pucch_rm srsran_simd_aligned;
+
+__attribute__((constructor)) static void uci_cqi_pucch_rm_init()
+{
+  for (uint32_t i = 0; i < SRSRAN_UCI_CQI_CODED_PUCCH_B; i++) {
+    M_basis_seq_pucch_b[i] = 0;
+    for (uint32_t n = 0; n < SRSRAN_UCI_MAX_CQI_LEN_PUCCH; n++) {
+      M_basis_seq_pucch_b[i] |= (uint16_t)(M_basis_seq_pucch[i][n] << n);
+    }
+  }
+  srsran_block_rm_init(
+      &cqi_pucch_rm, M_basis_seq_pucch_b, SRSRAN_UCI_CQI_CODED_PUCCH_B, SRSRAN_UCI_MAX_CQI_LEN_PUCCH, true);
+}
+
 void srsran_uci_cqi_pucch_init(srsran_uci_cqi_pucch_t* q)
 {
   uint8_t word[16];
 
   uint32_t nwords = 1 << SRSRAN_UCI_MAX_CQI_LEN_PUCCH;
   q->cqi_table    = srsran_vec_malloc(nwords * sizeof(int8_t*));
-  q->cqi_table_s  = srsran_vec_malloc(nwords * sizeof(int16_t*));
 
   for (uint32_t w = 0; w < nwords; w++) {
-    q->cqi_table[w]   = srsran_vec_malloc(SRSRAN_UCI_CQI_CODED_PUCCH_B * sizeof(int8_t));
-    q->cqi_table_s[w] = srsran_vec_malloc(SRSRAN_UCI_CQI_CODED_PUCCH_B * sizeof(int16_t));
-    uint8_t* ptr      = word;
+    q->cqi_table[w] = srsran_vec_malloc(SRSRAN_UCI_CQI_CODED_PUCCH_B * sizeof(int8_t));
+    uint8_t* ptr    = word;
     srsran_bit_unpack(w, &ptr, SRSRAN_UCI_MAX_CQI_LEN_PUCCH);
     srsran_uci_encode_cqi_pucch(word, SRSRAN_UCI_MAX_CQI_LEN_PUCCH, q->cqi_table[w]);
-    for (int j = 0; j < SRSRAN_UCI_CQI_CODED_PUCCH_B; j++) {
-      q->cqi_table_s[w][j] = (int16_t)(2 * q->cqi_table[w][j] - 1);
-    }
   }
 }
 
@@ -79,12 +93,8 @@ void srsran_uci_cqi_pucch_free(srsran_uci_cqi_pucch_t* q)
     if (q->cqi_table[w]) {
       free(q->cqi_table[w]);
     }
-    if (q->cqi_table_s[w]) {
-      free(q->cqi_table_s[w]);
-    }
   }
   free(q->cqi_table);
-  free(q->cqi_table_s);
 }
 
 /* Encode UCI CQI/PMI as described in 5.2.3.3 of 36.212
@@ -92,12 +102,12 @@ void srsran_uci_cqi_pucch_free(srsran_uci_cqi_pucch_t* q)
 int srsran_uci_encode_cqi_pucch(uint8_t* cqi_data, uint32_t cqi_len, uint8_t b_bits[SRSRAN_UCI_CQI_CODED_PUCCH_B])
 {
   if (cqi_len <= SRSRAN_UCI_MAX_CQI_LEN_PUCCH) {
+    uint32_t word = 0;
+    for (uint32_t n = 0; n < cqi_len; n++) {
+      word |= (uint32_t)(cqi_data[n] & 1U) << n;
+    }
     for (uint32_t i = 0; i < SRSRAN_UCI_CQI_CODED_PUCCH_B; i++) {
-      uint64_t x = 0;
-      for (uint32_t n = 0; n < cqi_len; n++) {
-        x += cqi_data[n] * M_basis_seq_pucch[i][n];
-      }
-      b_bits[i] = (uint8_t)(x % 2);
+      b_bits[i] = (uint8_t)(__builtin_popcount(word & M_basis_seq_pucch_b[i]) & 1U);
     }
     return SRSRAN_SUCCESS;
   } else {
@@ -130,22 +140,11 @@ int16_t srsran_uci_decode_cqi_pucch(srsran_uci_cqi_pucch_t* q,
                                     uint32_t                cqi_len)
 {
   if (q != NULL && cqi_len < SRSRAN_UCI_MAX_CQI_LEN_PUCCH && b_bits != NULL && cqi_data != NULL) {
-    uint32_t max_w    = 0;
-    int32_t  max_corr = INT32_MIN;
-    uint32_t nwords   = 1 << SRSRAN_UCI_MAX_CQI_LEN_PUCCH;
-    for (uint32_t w = 0; w < nwords; w += 1 << (SRSRAN_UCI_MAX_CQI_LEN_PUCCH - cqi_len)) {
-      // Calculate correlation with pregenerated word and select maximum
-      int32_t corr = srsran_vec_dot_prod_sss(q->cqi_table_s[w], b_bits, SRSRAN_UCI_CQI_CODED_PUCCH_B);
-      if (corr > max_corr) {
-        max_corr = corr;
-        max_w    = w;
-      }
-    }
-    // Convert word to bits again
-    uint8_t* ptr = cqi_data;
-    srsran_bit_unpack(max_w, &ptr, SRSRAN_UCI_MAX_CQI_LEN_PUCCH);
+    // Correlate with all the words at once through the fast Hadamard transform and select maximum
+    int32_t max_corr = srsran_block_rm_decode(&cqi_pucch_rm, b_bits, cqi_data, cqi_len);
+    srsran_vec_u8_zero(&cqi_data[cqi_len], SRSRAN_UCI_MAX_CQI_LEN_PUCCH - cqi_len);
 
-    INFO("Decoded CQI: w=%d, corr=%d", max_w, max_corr);
+    INFO("Decoded CQI: corr=%d", max_corr);
     return max_corr;
   } else {
     return SRSRAN_ERROR_INVALID_INPUTS;
@@ -0,0 +1,239 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <srsran/phy/utils/debug.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/utils/vector.h"
+
+/**
+ * Prototype filter length, in taps at the lowest of the input and output rates
+ */
+#define RESAMPLER_POLY_NOF_TAPS 48
+
+/**
+ * Prototype filter cut-off (-6 dB) frequency, relative to the lowest of the input and output rates
+ */
+#define RESAMPLER_POLY_CUTOFF 0.45
+
+/**
+ * Kaiser window shape parameter, sets the stop-band attenuation (about 70 dB)
+ */
+#define RESAMPLER_POLY_KAISER_BETA 7.0
+
+/**
+ * Maximum number of coefficients of the filter bank, limits the interpolation factor after reducing the ratio
+ */
+#define RESAMPLER_POLY_MAX_BANK_SZ (1U << 20U)
+
+/**
+ * Number of input samples filtered from the internal buffer at a time
+ */
+#define RESAMPLER_POLY_BLOCK_SZ 1024
+
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+  while (b != 0) {
+    uint32_t r = a % b;
+    a          = b;
+    b          = r;
+  }
+  return a;
+}
+
+// Zeroth order modified Bessel function of the first kind
+static double bessel_i0(double x)
+{
+  double sum  = 1.0;
+  double term = 1.0;
+  for (uint32_t k = 1; k < 64 && term > 1e-12 * sum; k++) {
+    term *= (x * x) / (4.0 * k * k);
+    sum += term;
+  }
+  return sum;
+}
+
+int srsran_resampler_poly_init(srsran_resampler_poly_t* q, uint32_t L, uint32_t M)
+{
+  if (q == NULL || L == 0 || M == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t g = gcd(L, M);
+  L /= g;
+  M /= g;
+
+  if (q->L == L && q->M == M) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Make sure the resampler is freed
+  srsran_resampler_poly_free(q);
+
+  // The prototype filter works at the rate L times the input rate, its length is set at the lowest rate
+  uint32_t max_lm   = SRSRAN_MAX(L, M);
+  uint32_t nof_taps = (RESAMPLER_POLY_NOF_TAPS * max_lm + L - 1) / L;
+  uint32_t len      = L * nof_taps;
+  if (len > RESAMPLER_POLY_MAX_BANK_SZ) {
+    ERROR("Resampling ratio %d/%d requires too many filter coefficients (%d)", L, M, len);
+    return SRSRAN_ERROR_OUT_OF_BOUNDS;
+  }
+
+  q->bank = srsran_vec_f_malloc(len);
+  if (q->bank == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  q->buffer = srsran_vec_cf_malloc(nof_taps - 1 + RESAMPLER_POLY_BLOCK_SZ);
+  if (q->buffer == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  q->L        = L;
+  q->M        = M;
+  q->nof_taps = nof_taps;
+
+  // Kaiser windowed sinc, stored as L branches of time reversed coefficients: branch p holds h[p + k * L]
+  double fc     = RESAMPLER_POLY_CUTOFF / (double)max_lm;
+  double center = (double)(len - 1) / 2.0;
+  double i0_b   = bessel_i0(RESAMPLER_POLY_KAISER_BETA);
+  double sum    = 0.0;
+  for (uint32_t j = 0; j < len; j++) {
+    double t = (double)j - center;
+    double h = 2.0 * fc;
+    if (isnormal(t)) {
+      h = sin(2.0 * M_PI * fc * t) / (M_PI * t);
+    }
+    double r = t / center;
+    h *= bessel_i0(RESAMPLER_POLY_KAISER_BETA * sqrt(SRSRAN_MAX(0.0, 1.0 - r * r))) / i0_b;
+
+    uint32_t p = j % L;
+    uint32_t k = j / L;
+
+    q->bank[p * nof_taps + (nof_taps - 1 - k)] = (float)h;
+    sum += h;
+  }
+
+  // Normalise for unity gain at the output rate
+  srsran_vec_sc_prod_fff(q->bank, (float)(L / sum), q->bank, len);
+
+  srsran_resampler_poly_reset_state(q);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_resampler_poly_reset_state(srsran_resampler_poly_t* q)
+{
+  if (q == NULL || q->buffer == NULL) {
+    return;
+  }
+
+  q->phase  = 0;
+  q->offset = 0;
+  srsran_vec_cf_zero(q->buffer, q->nof_taps - 1);
+}
+
+float srsran_resampler_poly_get_delay(srsran_resampler_poly_t* q)
+{
+  if (q == NULL || q->L == 0) {
+    return 0.0f;
+  }
+
+  return (float)(q->L * q->nof_taps - 1) / (2.0f * (float)q->M);
+}
+
+uint32_t srsran_resampler_poly_nof_output(srsran_resampler_poly_t* q, uint32_t nof_input)
+{
+  if (q == NULL || q->L == 0 || nof_input <= q->offset) {
+    return 0;
+  }
+
+  uint64_t span = (uint64_t)(nof_input - q->offset) * q->L - q->phase;
+  return (uint32_t)((span + q->M - 1) / q->M);
+}
+
+uint32_t srsran_resampler_poly_nof_input(srsran_resampler_poly_t* q, uint32_t nof_output)
+{
+  if (q == NULL || q->L == 0 || nof_output == 0) {
+    return 0;
+  }
+
+  return q->offset + (uint32_t)((q->phase + (uint64_t)(nof_output - 1) * q->M) / q->L) + 1;
+}
+
+uint32_t srsran_resampler_poly_run(srsran_resampler_poly_t* q, const cf_t* input, cf_t* output, uint32_t nof_input)
+{
+  if (q == NULL || q->L == 0 || output == NULL) {
+    return 0;
+  }
+
+  uint32_t hist  = q->nof_taps - 1;
+  uint32_t count = 0;
+  uint32_t n_out = 0;
+
+  while (count < nof_input) {
+    uint32_t n = SRSRAN_MIN(RESAMPLER_POLY_BLOCK_SZ, nof_input - count);
+
+    // Append the input block to the history
+    if (input) {
+      srsran_vec_cf_copy(&q->buffer[hist], &input[count], n);
+    } else {
+      srsran_vec_cf_zero(&q->buffer[hist], n);
+    }
+
+    // Each output is the dot product of one branch with the last nof_taps input samples
+    while (q->offset < n) {
+      output[n_out++] = srsran_vec_dot_prod_cfc(&q->buffer[q->offset], &q->bank[q->phase * q->nof_taps], q->nof_taps);
+
+      q->phase += q->M;
+      q->offset += q->phase / q->L;
+      q->phase %= q->L;
+    }
+    q->offset -= n;
+
+    // Save history
+    memmove(q->buffer, &q->buffer[n], hist * sizeof(cf_t));
+
+    count += n;
+  }
+
+  return n_out;
+}
+
+void srsran_resampler_poly_free(srsran_resampler_poly_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->bank) {
+    free(q->bank);
+  }
+  if (q->buffer) {
+    free(q->buffer);
+  }
+
+  memset(q, 0, sizeof(srsran_resampler_poly_t));
+}
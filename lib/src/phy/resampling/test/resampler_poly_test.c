@@ -0,0 +1,166 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#define NOF_TONES 4
+
+static uint32_t buffer_size = 1920;
+static uint32_t L           = 24;
+static uint32_t M           = 25;
+static uint32_t repetitions = 4;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [slmr]\n", prog);
+  printf("\t-s Input buffer size [Default %d]\n", buffer_size);
+  printf("\t-l Interpolation factor [Default %d]\n", L);
+  printf("\t-m Decimation factor [Default %d]\n", M);
+  printf("\t-r Number of buffers [Default %d]\n", repetitions);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "slmrv")) != -1) {
+    switch (opt) {
+      case 's':
+        buffer_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'l':
+        L = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'm':
+        M = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  struct timeval          t[3]   = {};
+  srsran_resampler_poly_t resamp = {};
+  int                     ret    = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  if (srsran_resampler_poly_init(&resamp, L, M) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising resampler %d/%d", L, M);
+    return SRSRAN_ERROR;
+  }
+
+  // Tones inside the pass-band, in cycles per input sample
+  float tones[NOF_TONES] = {};
+  for (uint32_t i = 0; i < NOF_TONES; i++) {
+    tones[i] = 0.35f * SRSRAN_MIN(1.0f, (float)L / (float)M) * (2.0f * i / (NOF_TONES - 1) - 1.0f);
+  }
+
+  uint32_t total_in  = buffer_size * repetitions;
+  uint32_t max_out   = (uint32_t)(((uint64_t)total_in * L) / M) + repetitions + 1;
+  cf_t*    src       = srsran_vec_cf_malloc(total_in);
+  cf_t*    resampled = srsran_vec_cf_malloc(max_out);
+  if (src == NULL || resampled == NULL) {
+    goto clean_exit;
+  }
+
+  for (uint32_t n = 0; n < total_in; n++) {
+    src[n] = 0;
+    for (uint32_t i = 0; i < NOF_TONES; i++) {
+      src[n] += cexpf(_Complex_I * 2.0f * (float)M_PI * tones[i] * (float)n) / NOF_TONES;
+    }
+  }
+
+  // Resample in several buffers, checking the number of samples predicted for each call
+  uint32_t nof_out = 0;
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < repetitions; r++) {
+    uint32_t expected = srsran_resampler_poly_nof_output(&resamp, buffer_size);
+    uint32_t n        = srsran_resampler_poly_run(&resamp, &src[r * buffer_size], &resampled[nof_out], buffer_size);
+    if (n != expected) {
+      ERROR("Number of output samples %d does not match the expected %d", n, expected);
+      goto clean_exit;
+    }
+    nof_out += n;
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t duration_us = (uint64_t)(t[0].tv_sec * 1000000UL + t[0].tv_usec);
+
+  uint32_t total_out = (uint32_t)(((uint64_t)total_in * resamp.L + resamp.M - 1) / resamp.M);
+  if (nof_out != total_out) {
+    ERROR("Total number of output samples %d is not %d", nof_out, total_out);
+    goto clean_exit;
+  }
+
+  // Compare with the tones sampled at the output instants, skipping the filter transient
+  float    delay = srsran_resampler_poly_get_delay(&resamp) * (float)M / (float)L;
+  uint32_t start = (uint32_t)ceilf(2.0f * srsran_resampler_poly_get_delay(&resamp));
+  double   err   = 0.0;
+  double   pwr   = 0.0;
+  for (uint32_t n = start; n < nof_out; n++) {
+    double time     = (double)n * M / L - delay;
+    cf_t   expected = 0;
+    for (uint32_t i = 0; i < NOF_TONES; i++) {
+      expected += cexp(_Complex_I * 2.0 * M_PI * tones[i] * time) / NOF_TONES;
+    }
+    err += pow(cabsf(resampled[n] - expected), 2.0);
+    pwr += pow(cabsf(expected), 2.0);
+  }
+  float nmse = (float)sqrt(err / pwr);
+
+  printf("Done %.1f Msps; L/M: %d/%d; taps: %d; NMSE: %.6f\n",
+         total_in / (double)duration_us,
+         resamp.L,
+         resamp.M,
+         resamp.nof_taps,
+         nmse);
+
+  ret = (nmse < 0.01f) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+
+clean_exit:
+  srsran_resampler_poly_free(&resamp);
+  if (src) {
+    free(src);
+  }
+  if (resampled) {
+    free(resampled);
+  }
+
+  return ret;
+}
@@ -122,6 +122,51 @@ int rf_file_handle_error(char* id, const char* text)
   return SRSRAN_ERROR;
 }
 
+uint32_t rf_file_sample_size(rf_file_format_t format)
+{
+  switch (format) {
+    case FILERF_TYPE_SC16:
+      return 2 * sizeof(int16_t);
+    case FILERF_TYPE_SC8:
+      return 2 * sizeof(int8_t);
+    case FILERF_TYPE_FC32:
+    default:
+      return sizeof(cf_t);
+  }
+}
+
+static inline bool parse_bool(char* args, const char* name, int channel)
+{
+  char tmp[RF_PARAM_LEN] = {};
+  parse_string(args, name, channel, tmp);
+  return strncmp(tmp, "true", RF_PARAM_LEN) == 0 || strncmp(tmp, "yes", RF_PARAM_LEN) == 0;
+}
+
+static int parse_format(char* args, const char* name, rf_file_format_t* format)
+{
+  char tmp[RF_PARAM_LEN] = {};
+  *format                = FILERF_TYPE_FC32;
+  if (parse_string(args, name, -1, tmp) == SRSRAN_SUCCESS) {
+    if (!strcmp(tmp, "sc16")) {
+      *format = FILERF_TYPE_SC16;
+    } else if (!strcmp(tmp, "sc8")) {
+      *format = FILERF_TYPE_SC8;
+    } else if (strcmp(tmp, "fc32") != 0) {
+      fprintf(stderr, "[file] Error: unsupported %s %s\n", name, tmp);
+      return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+static int rf_file_open_file_opts(void**         h,
+                                  FILE**         rx_files,
+                                  FILE**         tx_files,
+                                  uint32_t       nof_channels,
+                                  uint32_t       base_srate,
+                                  rf_file_opts_t rx_opts,
+                                  rf_file_opts_t tx_opts);
+
 /*
  * Public methods
  */
@@ -179,12 +224,24 @@ int rf_file_open_multi(char* args, void** h, uint32_t nof_channels)
   FILE* tx_files[SRSRAN_MAX_CHANNELS] = {NULL};
 
   if (h && nof_channels <= SRSRAN_MAX_CHANNELS) {
-    uint32_t base_srate = FILE_BASERATE_DEFAULT_HZ;
+    uint32_t       base_srate = FILE_BASERATE_DEFAULT_HZ;
+    rf_file_opts_t rx_opts    = {};
+    rf_file_opts_t tx_opts    = {};
 
     // parse args
     if (args && strlen(args)) {
       // base_srate
       parse_uint32(args, "base_srate", -1, &base_srate);
+
+      // rx_format, tx_format
+      if (parse_format(args, "rx_format", &rx_opts.sample_format) != SRSRAN_SUCCESS ||
+          parse_format(args, "tx_format", &tx_opts.sample_format) != SRSRAN_SUCCESS) {
+        goto clean_exit;
+      }
+
+      // rx_mmap, tx_async
+      rx_opts.mmap  = parse_bool(args, "rx_mmap", -1);
+      tx_opts.async = parse_bool(args, "tx_async", -1);
     } else {
       fprintf(stderr, "[file] Error: RF device args are required for file-based no-RF module\n");
       goto clean_exit;
@@ -219,7 +276,7 @@ int rf_file_open_multi(char* args, void** h, uint32_t nof_channels)
     }
 
     // defer further initialization to open_file method
-    ret = rf_file_open_file(h, rx_files, tx_files, nof_channels, base_srate);
+    ret = rf_file_open_file_opts(h, rx_files, tx_files, nof_channels, base_srate, rx_opts, tx_opts);
     if (ret != SRSRAN_SUCCESS) {
       goto clean_exit;
     }
@@ -243,6 +300,22 @@ clean_exit:
 }
 
 int rf_file_open_file(void** h, FILE** rx_files, FILE** tx_files, uint32_t nof_channels, uint32_t base_srate)
+{
+  rf_file_opts_t rx_opts = {};
+  rf_file_opts_t tx_opts = {};
+  rx_opts.sample_format  = FILERF_TYPE_FC32;
+  tx_opts.sample_format  = FILERF_TYPE_FC32;
+
+  return rf_file_open_file_opts(h, rx_files, tx_files, nof_channels, base_srate, rx_opts, tx_opts);
+}
+
+static int rf_file_open_file_opts(void**         h,
+                                  FILE**         rx_files,
+                                  FILE**         tx_files,
+                                  uint32_t       nof_channels,
+                                  uint32_t       base_srate,
+                                  rf_file_opts_t rx_opts,
+                                  rf_file_opts_t tx_opts)
 {
   int ret = SRSRAN_ERROR;
 
@@ -264,10 +337,8 @@ int rf_file_open_file(void** h, FILE** rx_files, FILE** tx_files, uint32_t nof_c
     handler->nof_channels     = nof_channels;
     strcpy(handler->id, "file\0");
 
-    rf_file_opts_t rx_opts = {};
-    rf_file_opts_t tx_opts = {};
-    tx_opts.id             = handler->id;
-    rx_opts.id             = handler->id;
+    tx_opts.id = handler->id;
+    rx_opts.id = handler->id;
 
     if (pthread_mutex_init(&handler->tx_config_mutex, NULL)) {
       fprintf(stderr, "Mutex init: %s\n", strerror(errno));
@@ -289,11 +360,6 @@ int rf_file_open_file(void** h, FILE** rx_files, FILE** tx_files, uint32_t nof_c
     // id
     // TODO: set some meaningful ID in handler->id
 
-    // rx_format, tx_format
-    // TODO: add other formats
-    rx_opts.sample_format = FILERF_TYPE_FC32;
-    tx_opts.sample_format = FILERF_TYPE_FC32;
-
     update_rates(handler, 1.92e6);
 
     // Create channels
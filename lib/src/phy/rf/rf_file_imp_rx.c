@@ -20,9 +20,37 @@
  */
 
 #include "rf_file_imp_trx.h"
+#include <errno.h>
 #include <srsran/phy/utils/vector.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static void rf_file_rx_map(rf_file_rx_t* q)
+{
+  int         fd  = fileno(q->file);
+  struct stat st  = {};
+  long        pos = ftell(q->file);
+  if (fd < 0 || pos < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= pos) {
+    rf_file_error(q->id, "[file] Warning: the rx file can not be mapped, reading it instead\n");
+    return;
+  }
+
+  void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (map == MAP_FAILED) {
+    rf_file_error(q->id, "[file] Warning: mapping the rx file failed, reading it instead. %s.\n", strerror(errno));
+    return;
+  }
+
+  // The file is replayed once from start to end, let the kernel read ahead aggressively
+  madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+  q->map          = (uint8_t*)map;
+  q->map_len      = (size_t)st.st_size;
+  q->map_offset   = (size_t)pos;
+  q->map_released = 0;
+}
 
 int rf_file_rx_open(rf_file_rx_t* q, rf_file_opts_t opts)
 {
@@ -60,6 +88,10 @@ int rf_file_rx_open(rf_file_rx_t* q, rf_file_opts_t opts)
       goto clean_exit;
     }
 
+    if (opts.mmap) {
+      rf_file_rx_map(q);
+    }
+
     q->running = true;
 
     ret = SRSRAN_SUCCESS;
@@ -71,14 +103,46 @@ clean_exit:
 
 int rf_file_rx_baseband(rf_file_rx_t* q, cf_t* buffer, uint32_t nsamples)
 {
-  uint32_t sample_sz = sizeof(cf_t);
-
-  int ret = fread(buffer, sample_sz, nsamples, q->file);
-  if (ret > 0) {
-    return ret;
+  uint32_t sample_sz = rf_file_sample_size(q->sample_format);
+  void*    src       = NULL;
+  size_t   nread     = 0;
+
+  if (q->map) {
+    // Take the samples straight from the mapping, no copy into an intermediate buffer
+    src   = q->map + q->map_offset;
+    nread = SRSRAN_MIN((size_t)nsamples, (q->map_len - q->map_offset) / sample_sz);
+    q->map_offset += nread * sample_sz;
   } else {
+    src   = (q->sample_format == FILERF_TYPE_FC32) ? (void*)buffer : q->temp_buffer_convert;
+    nread = fread(src, sample_sz, nsamples, q->file);
+  }
+
+  if (nread == 0) {
     return SRSRAN_ERROR_RX_EOF;
   }
+
+  // convert samples if necessary
+  switch (q->sample_format) {
+    case FILERF_TYPE_FC32:
+      if (src != buffer) {
+        memcpy(buffer, src, nread * sample_sz);
+      }
+      break;
+    case FILERF_TYPE_SC16:
+      srsran_vec_convert_if((int16_t*)src, INT16_MAX, (float*)buffer, 2 * nread);
+      break;
+    case FILERF_TYPE_SC8:
+      srsran_vec_convert_bf((int8_t*)src, INT8_MAX, (float*)buffer, 2 * nread);
+      break;
+  }
+
+  // Drop the replayed pages so that long recordings do not fill up the page cache
+  while (q->map && q->map_offset - q->map_released >= FILE_REPLAY_RELEASE_SIZE) {
+    madvise(q->map + q->map_released, FILE_REPLAY_RELEASE_SIZE, MADV_DONTNEED);
+    q->map_released += FILE_REPLAY_RELEASE_SIZE;
+  }
+
+  return (int)nread;
 }
 
 bool rf_file_rx_match_freq(rf_file_rx_t* q, uint32_t freq_hz)
@@ -103,5 +167,10 @@ void rf_file_rx_close(rf_file_rx_t* q)
     free(q->temp_buffer_convert);
   }
 
+  if (q->map) {
+    munmap(q->map, q->map_len);
+    q->map = NULL;
+  }
+
   // not touching q->file as we don't know if we need to close it ourselves
 }
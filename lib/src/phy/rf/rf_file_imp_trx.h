@@ -39,8 +39,12 @@
 #define FILE_ID_STRLEN 16
 #define FILE_MAX_GAIN_DB (30.0f)
 #define FILE_MIN_GAIN_DB (0.0f)
+#define FILE_RECORDER_BLOCK_SIZE (4 * 1024 * 1024) // Size of the background recorder writes, multiple of the alignment
+#define FILE_RECORDER_NOF_BLOCKS (16)
+#define FILE_RECORDER_ALIGN (4096) // Buffer, size and offset alignment required by O_DIRECT
+#define FILE_REPLAY_RELEASE_SIZE (64 * 1024 * 1024) // Replayed bytes after which the mapped pages are released
 
-typedef enum { FILERF_TYPE_FC32 = 0, FILERF_TYPE_SC16 } rf_file_format_t;
+typedef enum { FILERF_TYPE_FC32 = 0, FILERF_TYPE_SC16, FILERF_TYPE_SC8 } rf_file_format_t;
 
 typedef struct {
   char             id[FILE_ID_STRLEN];
@@ -53,6 +57,16 @@ typedef struct {
   void*            temp_buffer_convert;
   uint32_t         frequency_mhz;
   int32_t          sample_offset;
+
+  // Background recorder, the samples are queued in aligned blocks that a thread writes to the file with O_DIRECT
+  bool           async;
+  pthread_t      writer_thread;
+  pthread_cond_t cvar;
+  uint8_t*       blocks;      // FILE_RECORDER_NOF_BLOCKS blocks of FILE_RECORDER_BLOCK_SIZE bytes
+  uint32_t       block_fill;  // Bytes in the block being filled
+  uint64_t       nof_queued;  // Number of full blocks queued
+  uint64_t       nof_written; // Number of blocks written to the file
+  bool           write_error;
 } rf_file_tx_t;
 
 typedef struct {
@@ -66,6 +80,12 @@ typedef struct {
   cf_t*            temp_buffer;
   void*            temp_buffer_convert;
   uint32_t         frequency_mhz;
+
+  // Replay from a read-only mapping of the file
+  uint8_t* map;
+  size_t   map_len;
+  size_t   map_offset;
+  size_t   map_released; // Bytes at the start of the mapping already released
 } rf_file_rx_t;
 
 typedef struct {
@@ -73,11 +93,15 @@ typedef struct {
   rf_file_format_t sample_format;
   FILE*            file;
   uint32_t         frequency_mhz;
+  bool             mmap;  // Receiver only, replay from a memory mapping of the file instead of reading it
+  bool             async; // Transmitter only, record with large aligned writes from a background thread
 } rf_file_opts_t;
 
 /*
  * Common functions
  */
+SRSRAN_API uint32_t rf_file_sample_size(rf_file_format_t format);
+
 SRSRAN_API void rf_file_info(char* id, const char* format, ...);
 
 SRSRAN_API void rf_file_error(char* id, const char* format, ...);
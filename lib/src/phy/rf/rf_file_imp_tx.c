@@ -24,8 +24,145 @@
 #include <inttypes.h>
 #include <srsran/config.h>
 #include <srsran/phy/utils/vector.h>
+#include <fcntl.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+#ifndef O_DIRECT
+#define O_DIRECT 0 // Not available, the recorder uses buffered writes
+#endif
+
+static bool rf_file_tx_write_all(rf_file_tx_t* q, int fd, const uint8_t* data, size_t len)
+{
+  while (len > 0) {
+    ssize_t n = write(fd, data, len);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0 && errno == EINVAL && (fcntl(fd, F_GETFL) & O_DIRECT)) {
+      // The file system accepted the flag but not the direct write, fall back to buffered writes
+      rf_file_error(q->id, "[file] Warning: direct writes are not supported by the tx file, using buffered writes\n");
+      fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_DIRECT);
+      continue;
+    }
+    if (n <= 0) {
+      rf_file_error(q->id, "[file] Error: writing %zd bytes to the tx file. %s.\n", len, strerror(errno));
+      return false;
+    }
+    data += n;
+    len -= (size_t)n;
+  }
+  return true;
+}
+
+static void* rf_file_tx_writer(void* arg)
+{
+  rf_file_tx_t* q  = (rf_file_tx_t*)arg;
+  int           fd = fileno(q->file);
+
+  pthread_mutex_lock(&q->mutex);
+  while (true) {
+    while (q->running && q->nof_written == q->nof_queued) {
+      pthread_cond_wait(&q->cvar, &q->mutex);
+    }
+    if (q->nof_written == q->nof_queued) {
+      // Stopped and all queued blocks are written
+      break;
+    }
+
+    // The producer never touches a queued block, write it without holding the mutex
+    uint8_t* block = q->blocks + (q->nof_written % FILE_RECORDER_NOF_BLOCKS) * FILE_RECORDER_BLOCK_SIZE;
+    pthread_mutex_unlock(&q->mutex);
+    bool success = rf_file_tx_write_all(q, fd, block, FILE_RECORDER_BLOCK_SIZE);
+    pthread_mutex_lock(&q->mutex);
+
+    q->write_error |= !success;
+    q->nof_written++;
+    pthread_cond_broadcast(&q->cvar);
+  }
+  pthread_mutex_unlock(&q->mutex);
+
+  return NULL;
+}
+
+static int rf_file_tx_start_recorder(rf_file_tx_t* q)
+{
+  int fd = fileno(q->file);
+  if (fd < 0 || fflush(q->file) != 0) {
+    fprintf(stderr, "Error: the tx file can not be recorded in the background\n");
+    return SRSRAN_ERROR;
+  }
+
+  if (posix_memalign((void**)&q->blocks, FILE_RECORDER_ALIGN, FILE_RECORDER_NOF_BLOCKS * FILE_RECORDER_BLOCK_SIZE)) {
+    fprintf(stderr, "Error: allocating recorder blocks\n");
+    q->blocks = NULL;
+    return SRSRAN_ERROR;
+  }
+
+  // Bypass the page cache if the file starts at an aligned offset, recordings are written once and never read back
+  off_t pos = lseek(fd, 0, SEEK_CUR);
+  if (pos >= 0 && pos % FILE_RECORDER_ALIGN == 0) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_DIRECT);
+  }
+
+  if (pthread_cond_init(&q->cvar, NULL)) {
+    fprintf(stderr, "Error: creating condition variable\n");
+    return SRSRAN_ERROR;
+  }
+
+  if (pthread_create(&q->writer_thread, NULL, rf_file_tx_writer, q)) {
+    fprintf(stderr, "Error: creating recorder thread\n");
+    pthread_cond_destroy(&q->cvar);
+    return SRSRAN_ERROR;
+  }
+
+  q->async = true;
+  return SRSRAN_SUCCESS;
+}
+
+static void rf_file_tx_stop_recorder(rf_file_tx_t* q)
+{
+  pthread_join(q->writer_thread, NULL);
+  pthread_cond_destroy(&q->cvar);
+
+  // The tail is not a multiple of the alignment, write it through the page cache
+  if (q->block_fill > 0) {
+    int fd = fileno(q->file);
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_DIRECT);
+    uint8_t* block = q->blocks + (q->nof_queued % FILE_RECORDER_NOF_BLOCKS) * FILE_RECORDER_BLOCK_SIZE;
+    rf_file_tx_write_all(q, fd, block, q->block_fill);
+    q->block_fill = 0;
+  }
+
+  q->async = false;
+}
+
+// Copies the samples into the recorder blocks, waits for the writer when all blocks are queued. Called with the mutex
+static int rf_file_tx_queue(rf_file_tx_t* q, const uint8_t* data, uint32_t len)
+{
+  while (len > 0) {
+    uint8_t* block = q->blocks + (q->nof_queued % FILE_RECORDER_NOF_BLOCKS) * FILE_RECORDER_BLOCK_SIZE;
+    uint32_t n     = SRSRAN_MIN(len, FILE_RECORDER_BLOCK_SIZE - q->block_fill);
+    memcpy(block + q->block_fill, data, n);
+    q->block_fill += n;
+    data += n;
+    len -= n;
+
+    if (q->block_fill == FILE_RECORDER_BLOCK_SIZE) {
+      q->block_fill = 0;
+      q->nof_queued++;
+      pthread_cond_broadcast(&q->cvar);
+
+      // The next block is still being written
+      while (q->nof_queued - q->nof_written >= FILE_RECORDER_NOF_BLOCKS) {
+        pthread_cond_wait(&q->cvar, &q->mutex);
+      }
+    }
+  }
+
+  return q->write_error ? SRSRAN_ERROR : SRSRAN_SUCCESS;
+}
 
 int rf_file_tx_open(rf_file_tx_t* q, rf_file_opts_t opts)
 {
@@ -66,6 +203,11 @@ int rf_file_tx_open(rf_file_tx_t* q, rf_file_opts_t opts)
 
     q->running = true;
 
+    if (opts.async && rf_file_tx_start_recorder(q) != SRSRAN_SUCCESS) {
+      q->running = false;
+      goto clean_exit;
+    }
+
     ret = SRSRAN_SUCCESS;
   }
 
@@ -73,37 +215,50 @@ clean_exit:
   return ret;
 }
 
+// Transmits zeros if buffer is NULL
 static int _rf_file_tx_baseband(rf_file_tx_t* q, cf_t* buffer, uint32_t nsamples)
 {
-  int n = SRSRAN_ERROR;
-
-  // convert samples if necessary
-  void*    buf       = (buffer) ? buffer : q->zeros;
-  uint32_t sample_sz = sizeof(cf_t);
+  uint32_t sample_sz = rf_file_sample_size(q->sample_format);
+  uint32_t count     = 0;
+
+  // Go in chunks that fit the zeros and conversion buffers
+  while (count < nsamples) {
+    uint32_t n   = SRSRAN_MIN(nsamples - count, NBYTES2NSAMPLES(FILE_MAX_BUFFER_SIZE));
+    cf_t*    src = (buffer) ? &buffer[count] : q->zeros;
+    void*    buf = src;
+
+    // convert samples if necessary
+    if (q->sample_format == FILERF_TYPE_SC16) {
+      buf = q->temp_buffer_convert;
+      srsran_vec_convert_fi((float*)src, INT16_MAX, (int16_t*)q->temp_buffer_convert, 2 * n);
+    } else if (q->sample_format == FILERF_TYPE_SC8) {
+      buf = q->temp_buffer_convert;
+      srsran_vec_convert_fb((float*)src, INT8_MAX, (int8_t*)q->temp_buffer_convert, 2 * n);
+    }
 
-  if (q->sample_format == FILERF_TYPE_SC16) {
-    buf       = q->temp_buffer_convert;
-    sample_sz = 2 * sizeof(short);
-    srsran_vec_convert_fi((float*)buffer, INT16_MAX, (short*)q->temp_buffer_convert, 2 * nsamples);
-  }
+    if (q->async) {
+      if (rf_file_tx_queue(q, (uint8_t*)buf, n * sample_sz) != SRSRAN_SUCCESS) {
+        rf_file_error(q->id, "[file] Error: transmitter failed recording samples\n");
+        return SRSRAN_ERROR;
+      }
+    } else {
+      size_t ret = fwrite(buf, (size_t)sample_sz, (size_t)n, q->file);
+      if (ret < (size_t)n) {
+        rf_file_error(q->id,
+                      "[file] Error: transmitter expected %d bytes and sent %zd. %s.\n",
+                      n * sample_sz,
+                      ret * sample_sz,
+                      strerror(errno));
+        return SRSRAN_ERROR;
+      }
+    }
 
-  size_t ret = fwrite(buf, (size_t)sample_sz, (size_t)nsamples, q->file);
-  if (ret < (size_t)nsamples) {
-    rf_file_error(q->id,
-                  "[file] Error: transmitter expected %d bytes and sent %zd. %s.\n",
-                  NSAMPLES2NBYTES(nsamples),
-                  ret,
-                  strerror(errno));
-    n = SRSRAN_ERROR;
-    goto clean_exit;
+    // Increment sample counter
+    q->nsamples += n;
+    count += n;
   }
 
-  // Increment sample counter
-  q->nsamples += nsamples;
-  n = nsamples;
-
-clean_exit:
-  return n;
+  return (int)nsamples;
 }
 
 int rf_file_tx_align(rf_file_tx_t* q, uint64_t ts)
@@ -114,7 +269,7 @@ int rf_file_tx_align(rf_file_tx_t* q, uint64_t ts)
 
   if (nsamples > 0) {
     rf_file_info(q->id, " - Detected Tx gap of %d samples.\n", nsamples);
-    _rf_file_tx_baseband(q, q->zeros, (uint32_t)nsamples);
+    _rf_file_tx_baseband(q, NULL, (uint32_t)nsamples);
   }
 
   pthread_mutex_unlock(&q->mutex);
@@ -129,7 +284,7 @@ int rf_file_tx_baseband(rf_file_tx_t* q, cf_t* buffer, uint32_t nsamples)
   pthread_mutex_lock(&q->mutex);
 
   if (q->sample_offset > 0) {
-    _rf_file_tx_baseband(q, q->zeros, (uint32_t)q->sample_offset);
+    _rf_file_tx_baseband(q, NULL, (uint32_t)q->sample_offset);
     q->sample_offset = 0;
   } else if (q->sample_offset < 0) {
     n = SRSRAN_MIN(-q->sample_offset, nsamples);
@@ -137,6 +292,7 @@ int rf_file_tx_baseband(rf_file_tx_t* q, cf_t* buffer, uint32_t nsamples)
     nsamples -= n;
     q->sample_offset += n;
     if (nsamples == 0) {
+      pthread_mutex_unlock(&q->mutex);
       return n;
     }
   }
@@ -161,7 +317,7 @@ int rf_file_tx_zeros(rf_file_tx_t* q, uint32_t nsamples)
   pthread_mutex_lock(&q->mutex);
 
   rf_file_info(q->id, " - Tx %d Zeros.\n", nsamples);
-  _rf_file_tx_baseband(q, q->zeros, (uint32_t)nsamples);
+  _rf_file_tx_baseband(q, NULL, (uint32_t)nsamples);
 
   pthread_mutex_unlock(&q->mutex);
 
@@ -182,10 +338,21 @@ void rf_file_tx_close(rf_file_tx_t* q)
   rf_file_info(q->id, "Closing ...\n");
   pthread_mutex_lock(&q->mutex);
   q->running = false;
+  if (q->async) {
+    pthread_cond_broadcast(&q->cvar);
+  }
   pthread_mutex_unlock(&q->mutex);
 
+  if (q->async) {
+    rf_file_tx_stop_recorder(q);
+  }
+
   pthread_mutex_destroy(&q->mutex);
 
+  if (q->blocks) {
+    free(q->blocks);
+  }
+
   if (q->zeros) {
     free(q->zeros);
   }
@@ -32,6 +32,8 @@
 #define PRINT_SAMPLES 0
 #define COMPARE_BITS 0
 #define COMPARE_EPSILON (1e-6f)
+#define COMPARE_EPSILON_SC16 (1e-4f) // Quantization error of 16-bit samples
+#define COMPARE_EPSILON_SC8 (2e-2f)  // Quantization error of 8-bit samples
 #define NOF_RX_ANT 4
 #define NUM_SF (500)
 #define SF_LEN (1920)
@@ -149,7 +151,7 @@ void enb_tx_function(const char* tx_args, bool timed_tx)
   srsran_rf_close(&enb_radio);
 }
 
-int run_test(const char* rx_args, const char* tx_args, bool timed_tx)
+int run_test(const char* rx_args, const char* tx_args, bool timed_tx, float epsilon)
 {
   int ret = SRSRAN_ERROR;
 
@@ -200,7 +202,7 @@ int run_test(const char* rx_args, const char* tx_args, bool timed_tx)
                          &ue_rx_buffer[c][sf_offet + i * SF_LEN],
                          SF_LEN);
       uint32_t max_ix = srsran_vec_max_abs_ci(&ue_rx_buffer[c][sf_offet + i * SF_LEN], SF_LEN);
-      if (cabsf(ue_rx_buffer[c][sf_offet + i * SF_LEN + max_ix]) > COMPARE_EPSILON) {
+      if (cabsf(ue_rx_buffer[c][sf_offet + i * SF_LEN + max_ix]) > epsilon) {
         fprintf(stderr, "data mismatch in subframe %d\n", i);
         goto exit;
       }
@@ -290,7 +292,8 @@ int main()
 
 #if NOF_RX_ANT == 1
   // single tx, single rx with continuous transmissions (no decimation, no timed tx)
-  if (run_test("rx_file=tx_file0,base_srate=1.92e6", "tx_file=tx_file0,base_srate=1.92e6", false) != SRSRAN_SUCCESS) {
+  if (run_test("rx_file=tx_file0,base_srate=1.92e6", "tx_file=tx_file0,base_srate=1.92e6", false, COMPARE_EPSILON) !=
+      SRSRAN_SUCCESS) {
     fprintf(stderr, "Single tx, single rx test failed (no decimation, no timed tx)!\n");
     return -1;
   }
@@ -299,7 +302,8 @@ int main()
   // up to 4 trx radios with continous tx (no decimation, no timed tx)
   if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3,base_srate=1.92e6",
                "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3,base_srate=1.92e6",
-               false) != SRSRAN_SUCCESS) {
+               false,
+               COMPARE_EPSILON) != SRSRAN_SUCCESS) {
     fprintf(stderr, "Multi TRx radio test failed (no decimation, no timed tx)!\n");
     return -1;
   }
@@ -307,7 +311,8 @@ int main()
   // up to 4 trx radios with continous tx (with decimation, no timed tx)
   if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3",
                "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3",
-               false) != SRSRAN_SUCCESS) {
+               false,
+               COMPARE_EPSILON) != SRSRAN_SUCCESS) {
     fprintf(stderr, "Multi TRx radio test failed (with decimation, no timed tx)!\n");
     return -1;
   }
@@ -315,11 +320,41 @@ int main()
   // up to 4 trx radios with continous tx (with decimation, timed tx)
   if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3",
                "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3",
-               true) != SRSRAN_SUCCESS) {
+               true,
+               COMPARE_EPSILON) != SRSRAN_SUCCESS) {
     fprintf(stderr, "Two TRx radio test failed (with decimation, timed tx)!\n");
     return -1;
   }
 
+  // up to 4 trx radios recorded in the background and replayed from a mapping (timed tx)
+  if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3,base_srate=1.92e6,rx_mmap=true",
+               "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3,base_srate=1.92e6,tx_async=true",
+               true,
+               COMPARE_EPSILON) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test failed (async recording, mapped replay)!\n");
+    return -1;
+  }
+
+  // up to 4 trx radios with 16-bit samples, recorded in the background and replayed from a mapping (timed tx)
+  if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3,base_srate=1.92e6,rx_format=sc16,"
+               "rx_mmap=true",
+               "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3,base_srate=1.92e6,tx_format=sc16,"
+               "tx_async=true",
+               true,
+               COMPARE_EPSILON_SC16) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test failed (sc16 samples)!\n");
+    return -1;
+  }
+
+  // up to 4 trx radios with 8-bit samples (no decimation, no timed tx)
+  if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3,base_srate=1.92e6,rx_format=sc8",
+               "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3,base_srate=1.92e6,tx_format=sc8",
+               false,
+               COMPARE_EPSILON_SC8) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test failed (sc8 samples)!\n");
+    return -1;
+  }
+
   // clean workspace
   remove_file("rx_file0");
   remove_file("rx_file1");
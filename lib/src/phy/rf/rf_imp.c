@@ -58,21 +58,30 @@ static void* thread_gain_fcn(void* h)
 {
   srsran_rf_t* rf = (srsran_rf_t*)h;
 
+  pthread_mutex_lock(&rf->mutex);
   while (rf->thread_gain_run) {
-    pthread_mutex_lock(&rf->mutex);
     while (rf->cur_rx_gain == rf->new_rx_gain && rf->thread_gain_run) {
       pthread_cond_wait(&rf->cond, &rf->mutex);
     }
     if (rf->new_rx_gain != rf->cur_rx_gain) {
-      srsran_rf_set_rx_gain(h, rf->new_rx_gain);
-      rf->cur_rx_gain = srsran_rf_get_rx_gain(h);
-      rf->new_rx_gain = rf->cur_rx_gain;
-    }
-    if (rf->tx_gain_same_rx) {
-      srsran_rf_set_tx_gain(h, rf->cur_rx_gain + rf->tx_rx_gain_offset);
+      // The device is set without the mutex, so that srsran_rf_set_rx_gain_th() never waits for it
+      double gain = rf->new_rx_gain;
+      pthread_mutex_unlock(&rf->mutex);
+      srsran_rf_set_rx_gain(h, gain);
+      double cur_gain = srsran_rf_get_rx_gain(h);
+      if (rf->tx_gain_same_rx) {
+        srsran_rf_set_tx_gain(h, cur_gain + rf->tx_rx_gain_offset);
+      }
+      pthread_mutex_lock(&rf->mutex);
+
+      // Keep the gain requested in the meantime, if any
+      rf->cur_rx_gain = cur_gain;
+      if (rf->new_rx_gain == gain) {
+        rf->new_rx_gain = cur_gain;
+      }
     }
-    pthread_mutex_unlock(&rf->mutex);
   }
+  pthread_mutex_unlock(&rf->mutex);
   return NULL;
 }
 
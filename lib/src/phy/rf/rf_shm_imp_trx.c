@@ -0,0 +1,524 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_trx.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+void rf_shm_info(char* id, const char* format, ...)
+{
+#if SHM_VERBOSE
+  struct timeval t;
+  gettimeofday(&t, NULL);
+  va_list args;
+  va_start(args, format);
+  printf("[%s@%02ld.%06ld] ", id ? id : "shm", t.tv_sec % 10, t.tv_usec);
+  vprintf(format, args);
+  va_end(args);
+#else  /* SHM_VERBOSE */
+  // Do nothing
+#endif /* SHM_VERBOSE */
+}
+
+void rf_shm_error(char* id, const char* format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  fprintf(stderr, "[%s] ", id ? id : "shm");
+  vfprintf(stderr, format, args);
+  va_end(args);
+}
+
+/*
+ * Shared ring
+ */
+
+// The ring is shared between processes, so the futexes can not be process private
+static inline void shm_futex_wait(uint32_t* addr, uint32_t val, const struct timespec* timeout)
+{
+  syscall(SYS_futex, addr, FUTEX_WAIT, val, timeout, NULL, 0);
+}
+
+static inline void shm_futex_wake(uint32_t* addr)
+{
+  syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+static inline uint64_t shm_now_us(void)
+{
+  struct timespec now = {};
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000UL + (uint64_t)now.tv_nsec / 1000UL;
+}
+
+static inline uint32_t shm_ring_count(rf_shm_ring_t* r)
+{
+  uint64_t rd = __atomic_load_n(&r->rd_ts, __ATOMIC_SEQ_CST);
+  uint64_t wr = __atomic_load_n(&r->wr_ts, __ATOMIC_SEQ_CST);
+  return (uint32_t)(wr - rd);
+}
+
+static inline uint32_t shm_ring_available(rf_shm_ring_t* r, bool reader)
+{
+  uint32_t count = shm_ring_count(r);
+  if (reader) {
+    return count;
+  }
+  return __atomic_load_n(&r->consumer_attached, __ATOMIC_SEQ_CST) ? r->capacity - count : 0;
+}
+
+// Bumps the futex word after an update of the ring header and wakes the peer up if it is sleeping on it
+static inline void shm_ring_signal(uint32_t* seq, uint32_t* peer_waiting)
+{
+  __atomic_add_fetch(seq, 1, __ATOMIC_SEQ_CST);
+  if (__atomic_load_n(peer_waiting, __ATOMIC_SEQ_CST)) {
+    shm_futex_wake(seq);
+  }
+}
+
+// Waits until nsamples can be read (reader) or written (writer). Returns SRSRAN_ERROR_TIMEOUT after timeout_ms
+static int shm_ring_wait(rf_shm_ring_t* r, bool reader, uint32_t nsamples, uint32_t timeout_ms)
+{
+  uint32_t* seq      = reader ? &r->wr_seq : &r->rd_seq;
+  uint32_t* waiting  = reader ? &r->reader_waiting : &r->writer_waiting;
+  uint64_t  deadline = shm_now_us() + 1000UL * timeout_ms;
+
+  while (shm_ring_available(r, reader) < nsamples) {
+    // Announce the sleep before checking the counters again, so the peer either sees the flag or we see its update
+    uint32_t s = __atomic_load_n(seq, __ATOMIC_SEQ_CST);
+    __atomic_store_n(waiting, 1, __ATOMIC_SEQ_CST);
+    if (shm_ring_available(r, reader) >= nsamples) {
+      break;
+    }
+
+    uint64_t now = shm_now_us();
+    if (now >= deadline) {
+      __atomic_store_n(waiting, 0, __ATOMIC_SEQ_CST);
+      return SRSRAN_ERROR_TIMEOUT;
+    }
+    struct timespec timeout = {};
+    timeout.tv_sec          = (time_t)((deadline - now) / 1000000UL);
+    timeout.tv_nsec         = (long)(((deadline - now) % 1000000UL) * 1000UL);
+    shm_futex_wait(seq, s, &timeout);
+  }
+  __atomic_store_n(waiting, 0, __ATOMIC_SEQ_CST);
+
+  return SRSRAN_SUCCESS;
+}
+
+static uint32_t shm_ring_size(uint32_t ring_size)
+{
+  uint32_t capacity = 1;
+  while (capacity < ring_size) {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+// Maps the shared memory object, creating and initialising it if this is the first user
+static rf_shm_ring_t* shm_ring_open(char* id, const char* name, uint32_t ring_size, size_t* map_size)
+{
+  uint32_t capacity = shm_ring_size(ring_size ? ring_size : SHM_RING_DEFAULT_SIZE);
+  size_t   size     = sizeof(rf_shm_ring_t) + sizeof(cf_t) * capacity;
+
+  int fd = shm_open(name, O_RDWR | O_CREAT, 0666);
+  if (fd < 0) {
+    rf_shm_error(id, "Error: opening shared memory %s: %s\n", name, strerror(errno));
+    return NULL;
+  }
+
+  // Both peers may race here, truncating to the same size is harmless
+  struct stat st = {};
+  if (fstat(fd, &st) == 0 && (size_t)st.st_size < size) {
+    if (ftruncate(fd, (off_t)size) < 0) {
+      rf_shm_error(id, "Error: resizing shared memory %s: %s\n", name, strerror(errno));
+      close(fd);
+      return NULL;
+    }
+  }
+
+  rf_shm_ring_t* r = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (r == MAP_FAILED) {
+    rf_shm_error(id, "Error: mapping shared memory %s: %s\n", name, strerror(errno));
+    return NULL;
+  }
+
+  // The first peer claims the header by swapping the zeroed magic, the other one waits for it to be published
+  uint32_t expected = 0;
+  if (__atomic_compare_exchange_n(&r->magic, &expected, 1, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+    r->capacity = capacity;
+    __atomic_store_n(&r->wr_ts, 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&r->rd_ts, 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&r->magic, SHM_RING_MAGIC, __ATOMIC_SEQ_CST);
+  } else {
+    for (int i = 0; i < 1000 && __atomic_load_n(&r->magic, __ATOMIC_SEQ_CST) != SHM_RING_MAGIC; i++) {
+      usleep(1000);
+    }
+  }
+
+  if (__atomic_load_n(&r->magic, __ATOMIC_SEQ_CST) != SHM_RING_MAGIC || r->capacity != capacity) {
+    rf_shm_error(id,
+                 "Error: shared memory %s is in use with a different ring size (%d != %d). Remove /dev/shm%s or use "
+                 "the same ring_size on both sides.\n",
+                 name,
+                 r->capacity,
+                 capacity,
+                 name);
+    munmap(r, size);
+    return NULL;
+  }
+
+  *map_size = size;
+  return r;
+}
+
+static void shm_ring_close(rf_shm_ring_t* r, size_t map_size)
+{
+  if (r) {
+    munmap(r, map_size);
+  }
+}
+
+static void shm_ring_name(char dst[SHM_NAME_STRLEN], const char* name)
+{
+  // Accept "shm://name", "/name" and "name"
+  if (strncmp(name, "shm://", 6) == 0) {
+    name += 6;
+  }
+  snprintf(dst, SHM_NAME_STRLEN, "%s%s", name[0] == '/' ? "" : "/", name);
+}
+
+/*
+ * Transmitter
+ */
+
+int rf_shm_tx_open(rf_shm_tx_t* q, rf_shm_opts_t opts, const char* name)
+{
+  int ret = SRSRAN_ERROR;
+
+  if (q && name) {
+    bzero(q, sizeof(rf_shm_tx_t));
+
+    strncpy(q->id, opts.id, SHM_ID_STRLEN - 1);
+    q->id[SHM_ID_STRLEN - 1] = '\0';
+    shm_ring_name(q->name, name);
+    q->frequency_mhz  = opts.frequency_mhz;
+    q->trx_timeout_ms = opts.trx_timeout_ms ? opts.trx_timeout_ms : SHM_TIMEOUT_MS;
+    q->sample_offset  = opts.sample_offset;
+
+    rf_shm_info(q->id, "Opening transmitter: %s\n", q->name);
+
+    q->ring = shm_ring_open(q->id, q->name, opts.ring_size, &q->map_size);
+    if (!q->ring) {
+      goto clean_exit;
+    }
+
+    if (pthread_mutex_init(&q->mutex, NULL)) {
+      fprintf(stderr, "Error: creating mutex\n");
+      goto clean_exit;
+    }
+
+    q->running = true;
+
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  return ret;
+}
+
+static int _rf_shm_tx_baseband(rf_shm_tx_t* q, const cf_t* buffer, float gain, uint32_t nsamples)
+{
+  rf_shm_ring_t* r       = q->ring;
+  uint32_t       mask    = r->capacity - 1;
+  uint32_t       written = 0;
+
+  // Write it in chunks of at most half the ring, so the consumer can drain it while we wait
+  while (written < nsamples && q->running) {
+    uint32_t n = SRSRAN_MIN(nsamples - written, r->capacity / 2);
+
+    // Wait for the consumer, it may not have attached yet
+    int ret = shm_ring_wait(r, false, n, q->trx_timeout_ms);
+    if (ret == SRSRAN_ERROR_TIMEOUT) {
+      rf_shm_info(q->id, " - tx timeout, ring is full\n");
+      continue;
+    }
+
+    // Only this side writes wr_ts
+    uint64_t wr  = __atomic_load_n(&r->wr_ts, __ATOMIC_RELAXED);
+    uint32_t pos = (uint32_t)(wr & mask);
+    uint32_t n1  = SRSRAN_MIN(n, r->capacity - pos);
+    if (buffer) {
+      srsran_vec_sc_prod_cfc(&buffer[written], gain, &r->samples[pos], n1);
+      srsran_vec_sc_prod_cfc(&buffer[written + n1], gain, r->samples, n - n1);
+    } else {
+      srsran_vec_cf_zero(&r->samples[pos], n1);
+      srsran_vec_cf_zero(r->samples, n - n1);
+    }
+
+    __atomic_store_n(&r->wr_ts, wr + n, __ATOMIC_SEQ_CST);
+    shm_ring_signal(&r->wr_seq, &r->reader_waiting);
+    written += n;
+  }
+
+  q->nsamples += written;
+  return (int)written;
+}
+
+int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts)
+{
+  pthread_mutex_lock(&q->mutex);
+
+  int64_t nsamples = (int64_t)ts - (int64_t)q->nsamples;
+
+  if (nsamples > 0) {
+    rf_shm_info(q->id, " - Detected Tx gap of %d samples.\n", nsamples);
+    _rf_shm_tx_baseband(q, NULL, 0.0f, (uint32_t)nsamples);
+  }
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return (int)nsamples;
+}
+
+int rf_shm_tx_baseband(rf_shm_tx_t* q, const cf_t* buffer, float gain, uint32_t nsamples)
+{
+  int n;
+
+  pthread_mutex_lock(&q->mutex);
+
+  if (q->sample_offset > 0) {
+    _rf_shm_tx_baseband(q, NULL, 0.0f, (uint32_t)q->sample_offset);
+    q->sample_offset = 0;
+  } else if (q->sample_offset < 0) {
+    n = SRSRAN_MIN(-q->sample_offset, nsamples);
+    if (buffer) {
+      buffer += n;
+    }
+    nsamples -= n;
+    q->sample_offset += n;
+    if (nsamples == 0) {
+      pthread_mutex_unlock(&q->mutex);
+      return n;
+    }
+  }
+
+  n = _rf_shm_tx_baseband(q, buffer, gain, nsamples);
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return n;
+}
+
+uint64_t rf_shm_tx_get_nsamples(rf_shm_tx_t* q)
+{
+  pthread_mutex_lock(&q->mutex);
+  uint64_t ret = q->nsamples;
+  pthread_mutex_unlock(&q->mutex);
+  return ret;
+}
+
+bool rf_shm_tx_match_freq(rf_shm_tx_t* q, uint32_t freq_hz)
+{
+  bool ret = false;
+  if (q) {
+    ret = (q->frequency_mhz == 0 || q->frequency_mhz == freq_hz);
+  }
+  return ret;
+}
+
+void rf_shm_tx_close(rf_shm_tx_t* q)
+{
+  if (q->running) {
+    pthread_mutex_lock(&q->mutex);
+    q->running = false;
+    pthread_mutex_unlock(&q->mutex);
+
+    pthread_mutex_destroy(&q->mutex);
+  }
+
+  // The object is left in place so that a restarted peer finds the same ring
+  shm_ring_close(q->ring, q->map_size);
+  q->ring = NULL;
+}
+
+bool rf_shm_tx_is_running(rf_shm_tx_t* q)
+{
+  if (!q) {
+    return false;
+  }
+
+  bool ret = false;
+  if (q->running) {
+    pthread_mutex_lock(&q->mutex);
+    ret = q->running;
+    pthread_mutex_unlock(&q->mutex);
+  }
+
+  return ret;
+}
+
+/*
+ * Receiver
+ */
+
+int rf_shm_rx_open(rf_shm_rx_t* q, rf_shm_opts_t opts, const char* name)
+{
+  int ret = SRSRAN_ERROR;
+
+  if (q && name) {
+    bzero(q, sizeof(rf_shm_rx_t));
+
+    strncpy(q->id, opts.id, SHM_ID_STRLEN - 1);
+    q->id[SHM_ID_STRLEN - 1] = '\0';
+    shm_ring_name(q->name, name);
+    q->frequency_mhz      = opts.frequency_mhz;
+    q->fail_on_disconnect = opts.fail_on_disconnect;
+    q->trx_timeout_ms     = opts.trx_timeout_ms ? opts.trx_timeout_ms : SHM_TIMEOUT_MS;
+    q->log_trx_timeout    = opts.log_trx_timeout;
+    q->sample_offset      = opts.sample_offset;
+
+    rf_shm_info(q->id, "Opening receiver: %s\n", q->name);
+
+    q->ring = shm_ring_open(q->id, q->name, opts.ring_size, &q->map_size);
+    if (!q->ring) {
+      goto clean_exit;
+    }
+
+    // Attach to the stream: whatever a previous consumer left behind is dropped and a blocked producer is released
+    rf_shm_ring_t* r = q->ring;
+    __atomic_store_n(&r->rd_ts, __atomic_load_n(&r->wr_ts, __ATOMIC_SEQ_CST), __ATOMIC_SEQ_CST);
+    __atomic_store_n(&r->consumer_attached, 1, __ATOMIC_SEQ_CST);
+    shm_ring_signal(&r->rd_seq, &r->writer_waiting);
+
+    q->running = true;
+
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  return ret;
+}
+
+static int _rf_shm_rx_baseband(rf_shm_rx_t* q, cf_t* buffer, float scale, uint32_t nsamples)
+{
+  rf_shm_ring_t* r    = q->ring;
+  uint32_t       mask = r->capacity - 1;
+
+  int ret = shm_ring_wait(r, true, nsamples, q->trx_timeout_ms);
+  if (ret < SRSRAN_SUCCESS) {
+    return ret;
+  }
+
+  // Only this side writes rd_ts. The samples are scaled while they are copied out of the ring
+  uint64_t rd  = __atomic_load_n(&r->rd_ts, __ATOMIC_RELAXED);
+  uint32_t pos = (uint32_t)(rd & mask);
+  uint32_t n1  = SRSRAN_MIN(nsamples, r->capacity - pos);
+  if (buffer) {
+    srsran_vec_sc_prod_cfc(&r->samples[pos], scale, buffer, n1);
+    srsran_vec_sc_prod_cfc(r->samples, scale, &buffer[n1], nsamples - n1);
+  }
+
+  __atomic_store_n(&r->rd_ts, rd + nsamples, __ATOMIC_SEQ_CST);
+  shm_ring_signal(&r->rd_seq, &r->writer_waiting);
+
+  return (int)nsamples;
+}
+
+int rf_shm_rx_baseband(rf_shm_rx_t* q, cf_t* buffer, float scale, uint32_t nsamples)
+{
+  if (nsamples > q->ring->capacity / 2) {
+    rf_shm_error(q->id,
+                 "Error: trying to receive %d samples but the ring only holds %d. Increase ring_size.\n",
+                 nsamples,
+                 q->ring->capacity);
+    return SRSRAN_ERROR;
+  }
+
+  // If the read needs to be advanced, drop samples
+  while (q->sample_offset < 0) {
+    uint32_t n_offset = SRSRAN_MIN((uint32_t)-q->sample_offset, q->ring->capacity / 2);
+    int      n        = _rf_shm_rx_baseband(q, NULL, 0.0f, n_offset);
+    if (n < SRSRAN_SUCCESS) {
+      return n;
+    }
+    q->sample_offset += n_offset;
+  }
+
+  // If the read needs to be delayed, prepend zeros. The offset is only consumed once the read succeeded
+  uint32_t n_zeros = (q->sample_offset > 0) ? SRSRAN_MIN((uint32_t)q->sample_offset, nsamples) : 0;
+
+  int n = _rf_shm_rx_baseband(q, &buffer[n_zeros], scale, nsamples - n_zeros);
+  if (n < SRSRAN_SUCCESS) {
+    return n;
+  }
+
+  if (n_zeros > 0) {
+    srsran_vec_cf_zero(buffer, n_zeros);
+    q->sample_offset -= n_zeros;
+  }
+
+  return n + (int)n_zeros;
+}
+
+int rf_shm_rx_get_available(rf_shm_rx_t* q)
+{
+  return q->ring ? (int)shm_ring_count(q->ring) : 0;
+}
+
+bool rf_shm_rx_match_freq(rf_shm_rx_t* q, uint32_t freq_hz)
+{
+  bool ret = false;
+  if (q) {
+    ret = (q->frequency_mhz == 0 || q->frequency_mhz == freq_hz);
+  }
+  return ret;
+}
+
+void rf_shm_rx_close(rf_shm_rx_t* q)
+{
+  rf_shm_info(q->id, "Closing ...\n");
+
+  q->running = false;
+  if (q->ring) {
+    __atomic_store_n(&q->ring->consumer_attached, 0, __ATOMIC_SEQ_CST);
+  }
+  shm_ring_close(q->ring, q->map_size);
+  q->ring = NULL;
+}
+
+bool rf_shm_rx_is_running(rf_shm_rx_t* q)
+{
+  return q && q->running;
+}
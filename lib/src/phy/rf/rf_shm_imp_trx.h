@@ -0,0 +1,150 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RF_SHM_IMP_TRX_H
+#define SRSRAN_RF_SHM_IMP_TRX_H
+
+#include "srsran/config.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Definitions */
+#define SHM_VERBOSE (0)
+#define SHM_RING_MAGIC (0x4d485352) // "RSHM", set once the ring header is initialised
+#define SHM_RING_DEFAULT_SIZE (1U << 19) // Samples, about 22 ms at 23.04 MHz
+#define SHM_CACHE_LINE (64)
+#define SHM_TIMEOUT_MS (2000)
+#define SHM_BASERATE_DEFAULT_HZ (23040000)
+#define SHM_ID_STRLEN 16
+#define SHM_NAME_STRLEN 64
+#define SHM_MAX_GAIN_DB (30.0f)
+#define SHM_MIN_GAIN_DB (0.0f)
+
+/*
+ * Single-producer/single-consumer ring of base-band samples living in a POSIX shared memory object. The sample at
+ * ring position (ts & (capacity - 1)) is the one the producer transmitted at stream timestamp ts, so the two counters
+ * are the timestamps of the next sample to write and to read. Like the REQ/REP ZMQ sockets, the producer holds its
+ * samples back until a consumer is attached; attaching drops whatever a previous consumer left unread.
+ *
+ * Each counter has its own cache line and a futex word that is bumped on every update. A side only issues the
+ * wake-up system call when its peer announced it is sleeping.
+ */
+typedef struct {
+  uint32_t magic;
+  uint32_t capacity; // In samples, power of two
+  uint8_t  _pad0[SHM_CACHE_LINE - 2 * sizeof(uint32_t)];
+
+  // Producer side
+  uint64_t wr_ts;
+  uint32_t wr_seq;         // Futex word the consumer sleeps on
+  uint32_t reader_waiting; // Set by the consumer before sleeping on wr_seq
+  uint8_t  _pad1[SHM_CACHE_LINE - sizeof(uint64_t) - 2 * sizeof(uint32_t)];
+
+  // Consumer side
+  uint64_t rd_ts;
+  uint32_t rd_seq;            // Futex word the producer sleeps on
+  uint32_t writer_waiting;    // Set by the producer before sleeping on rd_seq
+  uint32_t consumer_attached; // The producer does not write until a consumer is attached
+  uint8_t  _pad2[SHM_CACHE_LINE - sizeof(uint64_t) - 3 * sizeof(uint32_t)];
+
+  cf_t samples[];
+} rf_shm_ring_t;
+
+typedef struct {
+  char            id[SHM_ID_STRLEN];
+  char            name[SHM_NAME_STRLEN];
+  rf_shm_ring_t*  ring;
+  size_t          map_size;
+  uint64_t        nsamples; // Samples transmitted since the transmitter was opened
+  bool            running;
+  uint32_t        frequency_mhz;
+  uint32_t        trx_timeout_ms;
+  int32_t         sample_offset;
+  pthread_mutex_t mutex;
+} rf_shm_tx_t;
+
+typedef struct {
+  char           id[SHM_ID_STRLEN];
+  char           name[SHM_NAME_STRLEN];
+  rf_shm_ring_t* ring;
+  size_t         map_size;
+  bool           running;
+  uint32_t       frequency_mhz;
+  bool           fail_on_disconnect;
+  uint32_t       trx_timeout_ms;
+  bool           log_trx_timeout;
+  int32_t        sample_offset;
+} rf_shm_rx_t;
+
+typedef struct {
+  const char* id;
+  uint32_t    ring_size; ///< Ring capacity in samples, rounded up to a power of two
+  uint32_t    frequency_mhz;
+  bool        fail_on_disconnect;
+  uint32_t    trx_timeout_ms;
+  bool        log_trx_timeout;
+  int32_t     sample_offset; ///< offset in samples
+} rf_shm_opts_t;
+
+/*
+ * Common functions
+ */
+SRSRAN_API void rf_shm_info(char* id, const char* format, ...);
+
+SRSRAN_API void rf_shm_error(char* id, const char* format, ...);
+
+/*
+ * Transmitter functions
+ */
+SRSRAN_API int rf_shm_tx_open(rf_shm_tx_t* q, rf_shm_opts_t opts, const char* name);
+
+SRSRAN_API int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts);
+
+// Writes nsamples of buffer scaled by gain in the ring, or zeros if buffer is NULL
+SRSRAN_API int rf_shm_tx_baseband(rf_shm_tx_t* q, const cf_t* buffer, float gain, uint32_t nsamples);
+
+SRSRAN_API uint64_t rf_shm_tx_get_nsamples(rf_shm_tx_t* q);
+
+SRSRAN_API bool rf_shm_tx_match_freq(rf_shm_tx_t* q, uint32_t freq_hz);
+
+SRSRAN_API void rf_shm_tx_close(rf_shm_tx_t* q);
+
+SRSRAN_API bool rf_shm_tx_is_running(rf_shm_tx_t* q);
+
+/*
+ * Receiver functions
+ */
+SRSRAN_API int rf_shm_rx_open(rf_shm_rx_t* q, rf_shm_opts_t opts, const char* name);
+
+// Reads nsamples from the ring into buffer scaled by scale, waiting at most trx_timeout_ms for them
+SRSRAN_API int rf_shm_rx_baseband(rf_shm_rx_t* q, cf_t* buffer, float scale, uint32_t nsamples);
+
+SRSRAN_API int rf_shm_rx_get_available(rf_shm_rx_t* q);
+
+SRSRAN_API bool rf_shm_rx_match_freq(rf_shm_rx_t* q, uint32_t freq_hz);
+
+SRSRAN_API void rf_shm_rx_close(rf_shm_rx_t* q);
+
+SRSRAN_API bool rf_shm_rx_is_running(rf_shm_rx_t* q);
+
+#endif // SRSRAN_RF_SHM_IMP_TRX_H
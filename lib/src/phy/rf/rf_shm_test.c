@@ -0,0 +1,228 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/common/timestamp.h"
+#include "srsran/phy/rf/rf.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/support/srsran_test.h"
+#include <complex.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define NOF_RX_ANT 2
+#define NUM_SF (500)
+#define SF_LEN (1920)
+#define RF_BUFFER_SIZE (SF_LEN * NUM_SF)
+#define TX_OFFSET_MS (4)
+#define COMPARE_EPSILON (1e-6f)
+
+static cf_t ue_rx_buffer[NOF_RX_ANT][RF_BUFFER_SIZE];
+static cf_t enb_tx_buffer[NOF_RX_ANT][RF_BUFFER_SIZE];
+static cf_t enb_rx_buffer[NOF_RX_ANT][SF_LEN];
+
+static srsran_rf_t ue_radio, enb_radio;
+
+static void* ue_rx_thread_function(void* args)
+{
+  char rf_args[RF_PARAM_LEN];
+  strncpy(rf_args, (char*)args, RF_PARAM_LEN - 1);
+  rf_args[RF_PARAM_LEN - 1] = 0;
+
+  printf("opening rx device with args=%s\n", rf_args);
+  if (srsran_rf_open_devname(&ue_radio, "shm", rf_args, NOF_RX_ANT)) {
+    fprintf(stderr, "Error opening rf\n");
+    exit(-1);
+  }
+
+  // receive 5 subframes at once (i.e. mimic initial rx that receives one slot)
+  uint32_t num_slots          = NUM_SF / 5;
+  uint32_t num_samps_per_slot = SF_LEN * 5;
+  uint32_t num_rxed_samps     = 0;
+  for (uint32_t i = 0; i < num_slots; ++i) {
+    void* data_ptr[SRSRAN_MAX_PORTS] = {NULL};
+    for (uint32_t c = 0; c < NOF_RX_ANT; c++) {
+      data_ptr[c] = &ue_rx_buffer[c][i * num_samps_per_slot];
+    }
+    num_rxed_samps += srsran_rf_recv_with_time_multi(&ue_radio, data_ptr, num_samps_per_slot, true, NULL, NULL);
+  }
+
+  printf("received %d samples.\n", num_rxed_samps);
+
+  srsran_rf_close(&ue_radio);
+
+  return NULL;
+}
+
+static int enb_tx_function(const char* tx_args, bool timed_tx)
+{
+  char rf_args[RF_PARAM_LEN];
+  strncpy(rf_args, tx_args, RF_PARAM_LEN - 1);
+  rf_args[RF_PARAM_LEN - 1] = 0;
+
+  printf("opening tx device with args=%s\n", rf_args);
+  if (srsran_rf_open_devname(&enb_radio, "shm", rf_args, NOF_RX_ANT)) {
+    fprintf(stderr, "Error opening rf\n");
+    return SRSRAN_ERROR;
+  }
+
+  // generate random tx data
+  for (int c = 0; c < NOF_RX_ANT; c++) {
+    for (int i = 0; i < RF_BUFFER_SIZE; i++) {
+      enb_tx_buffer[c][i] = ((float)rand() / (float)RAND_MAX) + _Complex_I * ((float)rand() / (float)RAND_MAX);
+    }
+  }
+
+  // initial transmission without ts
+  void* data_ptr[SRSRAN_MAX_PORTS] = {NULL};
+  for (int c = 0; c < NOF_RX_ANT; c++) {
+    data_ptr[c] = &enb_tx_buffer[c][0];
+  }
+  TESTASSERT(srsran_rf_send_multi(&enb_radio, (void**)data_ptr, SF_LEN, true, true, false) == SRSRAN_SUCCESS);
+  uint32_t num_txed_samples = SF_LEN;
+
+  // from here on, all transmissions are timed relative to the last rx time
+  srsran_timestamp_t rx_time, tx_time;
+  for (uint32_t i = 0; i < NUM_SF - ((timed_tx) ? TX_OFFSET_MS : 1); ++i) {
+    for (int c = 0; c < NOF_RX_ANT; c++) {
+      data_ptr[c] = enb_rx_buffer[c];
+    }
+    srsran_rf_recv_with_time_multi(&enb_radio, data_ptr, SF_LEN, true, &rx_time.full_secs, &rx_time.frac_secs);
+
+    for (int c = 0; c < NOF_RX_ANT; c++) {
+      data_ptr[c] = &enb_tx_buffer[c][num_txed_samples];
+    }
+
+    int ret;
+    if (timed_tx) {
+      // timed tx relative to receive time, the UE sees TX_OFFSET_MS - 1 zero subframes after the first one
+      srsran_timestamp_copy(&tx_time, &rx_time);
+      srsran_timestamp_add(&tx_time, 0, TX_OFFSET_MS * 1e-3);
+      ret = srsran_rf_send_timed_multi(
+          &enb_radio, (void**)data_ptr, SF_LEN, tx_time.full_secs, tx_time.frac_secs, true, true, false);
+    } else {
+      ret = srsran_rf_send_multi(&enb_radio, (void**)data_ptr, SF_LEN, true, true, false);
+    }
+    TESTASSERT(ret == SRSRAN_SUCCESS);
+
+    num_txed_samples += SF_LEN;
+  }
+
+  printf("transmitted %d samples\n", num_txed_samples);
+
+  srsran_rf_close(&enb_radio);
+  return SRSRAN_SUCCESS;
+}
+
+static int run_test(const char* rx_args, const char* tx_args, bool timed_tx)
+{
+  pthread_t rx_thread;
+  if (pthread_create(&rx_thread, NULL, ue_rx_thread_function, (void*)rx_args)) {
+    perror("pthread_create");
+    return SRSRAN_ERROR;
+  }
+
+  int ret = enb_tx_function(tx_args, timed_tx);
+
+  pthread_join(rx_thread, NULL);
+  TESTASSERT(ret == SRSRAN_SUCCESS);
+
+  // channel-wise and subframe-wise comparison of the tx'ed and rx'ed data
+  for (int c = 0; c < NOF_RX_ANT; c++) {
+    for (uint32_t i = 0; i < NUM_SF - (timed_tx ? TX_OFFSET_MS - 1 : 0); ++i) {
+      uint32_t sf_offset = (timed_tx && i >= 1) ? (TX_OFFSET_MS - 1) * SF_LEN : 0;
+      cf_t*    rx        = &ue_rx_buffer[c][sf_offset + i * SF_LEN];
+
+      srsran_vec_sub_ccc(rx, &enb_tx_buffer[c][i * SF_LEN], rx, SF_LEN);
+      uint32_t max_ix = srsran_vec_max_abs_ci(rx, SF_LEN);
+      if (cabsf(rx[max_ix]) > COMPARE_EPSILON) {
+        fprintf(stderr, "data mismatch in channel %d subframe %d\n", c, i);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  // Use names unique to this process, the shared memory objects outlive the radios
+  char dl[2][32], ul[2][32];
+  for (int c = 0; c < NOF_RX_ANT; c++) {
+    snprintf(dl[c], sizeof(dl[c]), "/srsran_shm_test_dl%d_%d", c, (int)getpid());
+    snprintf(ul[c], sizeof(ul[c]), "/srsran_shm_test_ul%d_%d", c, (int)getpid());
+  }
+
+  char ue_args[RF_PARAM_LEN], enb_args[RF_PARAM_LEN];
+
+  // continuous tx, no decimation
+  snprintf(ue_args,
+           RF_PARAM_LEN,
+           "rx_port=%s,rx_port=%s,tx_port=%s,tx_port=%s,id=ue,base_srate=1.92e6,pace=false",
+           dl[0],
+           dl[1],
+           ul[0],
+           ul[1]);
+  snprintf(enb_args,
+           RF_PARAM_LEN,
+           "rx_port=%s,rx_port=%s,tx_port=%s,tx_port=%s,id=enb,base_srate=1.92e6,pace=false",
+           ul[0],
+           ul[1],
+           dl[0],
+           dl[1]);
+  if (run_test(ue_args, enb_args, false) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test failed!\n");
+    return SRSRAN_ERROR;
+  }
+
+  // timed tx with decimation 23.04e6 <-> 1.92e6, reusing the same rings
+  snprintf(ue_args,
+           RF_PARAM_LEN,
+           "rx_port=shm://%s,rx_port=shm://%s,tx_port=%s,tx_port=%s,id=ue,base_srate=23.04e6,pace=false",
+           dl[0] + 1,
+           dl[1] + 1,
+           ul[0],
+           ul[1]);
+  snprintf(enb_args,
+           RF_PARAM_LEN,
+           "rx_port=%s,rx_port=%s,tx_port=%s,tx_port=%s,id=enb,base_srate=23.04e6,pace=false",
+           ul[0],
+           ul[1],
+           dl[0],
+           dl[1]);
+  int ret = run_test(ue_args, enb_args, true);
+
+  for (int c = 0; c < NOF_RX_ANT; c++) {
+    shm_unlink(dl[c]);
+    shm_unlink(ul[c]);
+  }
+
+  if (ret != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test with timed tx and decimation failed!\n");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
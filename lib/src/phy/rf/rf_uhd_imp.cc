@@ -22,6 +22,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
+#include <pthread.h>
 #include <string>
 #include <thread>
 #include <uhd.h>
@@ -31,6 +32,7 @@
 #include "rf_helper.h"
 #include "rf_plugin.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/ringbuffer.h"
 #include "srsran/phy/utils/vector.h"
 
 #include "rf_uhd_generic.h"
@@ -70,6 +72,19 @@ typedef enum {
   RF_UHD_IMP_TX_STATE_WAIT_EOB_ACK ///< Wait for enb-of-burst ACK
 } rf_uhd_imp_underflow_state_t;
 
+/**
+ * Rx ring state, shared by the Rx streamer thread (producer) and the receive calls (consumer). The rings can only
+ * be reset by the consumer, and only while the producer is not touching them:
+ * - RUNNING: the producer appends every received packet to the rings;
+ * - RESET_REQUEST: the producer could not keep the rings time continuous (they are full) and drops packets;
+ * - RESYNC: the consumer has emptied the rings, the producer restarts the ring timeline with the next packet.
+ */
+typedef enum {
+  RF_UHD_IMP_RX_RING_RUNNING = 0,
+  RF_UHD_IMP_RX_RING_RESET_REQUEST,
+  RF_UHD_IMP_RX_RING_RESYNC
+} rf_uhd_imp_rx_ring_state_t;
+
 /**
  * List of devices that do NOT support dynamic master-clock-rate
  */
@@ -135,6 +150,21 @@ static const uint32_t RF_UHD_IMP_MAX_RX_TRIALS = 100;
  */
 static const double RF_UHD_IMP_WAIT_EOB_ACK_TIMEOUT_S = 2.0;
 
+/**
+ * Default duration of the Rx streamer thread rings in milliseconds
+ */
+static const double RF_UHD_IMP_RX_RING_DEFAULT_MS = 20.0;
+
+/**
+ * Rx streamer thread receive timeout, it bounds the time the thread takes to stop
+ */
+static const double RF_UHD_IMP_RX_THREAD_TIMEOUT_S = 0.1;
+
+/**
+ * Rx ring read timeout for each trial, the receive call gives up after RF_UHD_IMP_MAX_RX_TRIALS
+ */
+static const int32_t RF_UHD_IMP_RX_RING_TIMEOUT_MS = 10;
+
 struct rf_uhd_handler_t {
   size_t id;
 
@@ -175,6 +205,19 @@ struct rf_uhd_handler_t {
   std::mutex              async_mutex;
   std::condition_variable async_cvar;
 #endif /* HAVE_ASYNC_THREAD */
+
+  // Rx streamer thread, it keeps calling the UHD receive and stores the samples in a ring per channel
+  bool                                                      rx_thread_enabled = false;
+  int                                                       rx_thread_cpu     = -1;
+  double                                                    rx_ring_ms        = RF_UHD_IMP_RX_RING_DEFAULT_MS;
+  std::atomic<bool>                                         rx_thread_running{false};
+  std::thread                                               rx_thread;
+  std::atomic<rf_uhd_imp_rx_ring_state_t>                   rx_ring_state = {RF_UHD_IMP_RX_RING_RESYNC};
+  std::array<srsran_ringbuffer_spsc_t, SRSRAN_MAX_CHANNELS> rx_ring       = {};
+  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>        rx_thread_buffer;
+  uhd::time_spec_t rx_ring_time        = {}; //< Time of the first sample written in the rings after a resync
+  uint64_t         rx_ring_nof_written = 0;  //< Written samples since the resync, producer only
+  uint64_t         rx_ring_nof_read    = 0;  //< Read samples since the resync, consumer only
 };
 
 // Store UHD Handler instances as shared pointer to avoid new/delete
@@ -339,6 +382,16 @@ static inline void uhd_free(rf_uhd_handler_t* handler)
   }
 #endif
 
+  if (handler->rx_thread_running) {
+    handler->rx_thread_running = false;
+    handler->rx_thread.join();
+  }
+  for (auto& r : handler->rx_ring) {
+    if (r.buffer != nullptr) {
+      srsran_ringbuffer_spsc_free(&r);
+    }
+  }
+
   // Erase element from MAP
   rf_uhd_map.erase(handler->id);
 }
@@ -508,6 +561,220 @@ bool rf_uhd_rx_wait_lo_locked(void* h)
   return is_locked;
 }
 
+/**
+ * Appends a received packet to the Rx rings, filling with zeros the samples UHD dropped since the previous packet so
+ * the ring timeline stays continuous. If the rings are full it requests the consumer to reset them.
+ */
+static void rx_thread_push(rf_uhd_handler_t* handler, const uhd::time_spec_t& time_spec, size_t nsamples)
+{
+  rf_uhd_imp_rx_ring_state_t state = handler->rx_ring_state.load(std::memory_order_acquire);
+
+  // Drop packets until the consumer has reset the rings
+  if (state == RF_UHD_IMP_RX_RING_RESET_REQUEST) {
+    return;
+  }
+
+  // The rings are empty, restart the timeline from this packet
+  if (state == RF_UHD_IMP_RX_RING_RESYNC) {
+    handler->rx_ring_time        = time_spec;
+    handler->rx_ring_nof_written = 0;
+    handler->rx_ring_state.store(RF_UHD_IMP_RX_RING_RUNNING, std::memory_order_release);
+  }
+
+  // Samples lost between the previous packet and this one, negative gaps are ignored
+  uhd::time_spec_t expected =
+      handler->rx_ring_time + uhd::time_spec_t::from_ticks((long long)handler->rx_ring_nof_written, handler->rx_rate);
+  double gap_s = (time_spec - expected).get_real_secs();
+  size_t gap   = gap_s > 0.0 ? (size_t)round(gap_s * handler->rx_rate) : 0;
+
+  // Every channel ring holds the same number of samples, checking one of them is enough
+  int nof_bytes = (int)((gap + nsamples) * sizeof(cf_t));
+  if (srsran_ringbuffer_spsc_space(&handler->rx_ring[0]) < nof_bytes) {
+    handler->rx_ring_state.store(RF_UHD_IMP_RX_RING_RESET_REQUEST, std::memory_order_release);
+    return;
+  }
+
+  for (uint32_t i = 0; i < handler->nof_rx_channels; i++) {
+    if (gap > 0) {
+      srsran_ringbuffer_spsc_write(&handler->rx_ring[i], nullptr, (int)(gap * sizeof(cf_t)));
+    }
+    srsran_ringbuffer_spsc_write(
+        &handler->rx_ring[i], handler->rx_thread_buffer[i].data(), (int)(nsamples * sizeof(cf_t)));
+  }
+  handler->rx_ring_nof_written += gap + nsamples;
+}
+
+static void rx_thread_run(rf_uhd_handler_t* handler)
+{
+  void*              buffs_ptr[SRSRAN_MAX_CHANNELS] = {};
+  uhd::rx_metadata_t md;
+  size_t             rxd_samples = 0;
+
+  if (handler->rx_thread_cpu >= 0) {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET((size_t)handler->rx_thread_cpu, &cpuset);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) != 0) {
+      ERROR("Error setting the UHD Rx thread affinity to CPU %d", handler->rx_thread_cpu);
+    }
+  }
+  uhd_set_thread_priority(uhd_default_thread_priority, true);
+
+  for (uint32_t i = 0; i < handler->nof_rx_channels; i++) {
+    buffs_ptr[i] = handler->rx_thread_buffer[i].data();
+  }
+
+  while (handler->rx_thread_running) {
+    // Receive whole packets, the ring absorbs the jitter between UHD and the PHY
+    size_t    nsamples = handler->rx_nof_samples;
+    uhd_error err = handler->uhd->receive(buffs_ptr, nsamples, md, RF_UHD_IMP_RX_THREAD_TIMEOUT_S, true, rxd_samples);
+    if (err != UHD_ERROR_NONE) {
+      log_rx_error(handler);
+      continue;
+    }
+
+    switch (md.error_code) {
+      case uhd::rx_metadata_t::ERROR_CODE_NONE:
+        break;
+      case uhd::rx_metadata_t::ERROR_CODE_TIMEOUT:
+        // Nothing received, check whether the thread has to stop
+        continue;
+      case uhd::rx_metadata_t::ERROR_CODE_OVERFLOW:
+        // The next packet time stamp tells how many samples were lost
+        log_overflow(handler);
+        continue;
+      case uhd::rx_metadata_t::ERROR_CODE_LATE_COMMAND:
+        log_late(handler, true);
+        continue;
+      default:
+        ERROR("Error %s was returned during streaming.", md.to_pp_string(true).c_str());
+        continue;
+    }
+
+    if (rxd_samples > 0) {
+      rx_thread_push(handler, md.time_spec, rxd_samples);
+    }
+  }
+}
+
+static int rf_uhd_rx_thread_start_nolock(rf_uhd_handler_t* handler)
+{
+  if (handler->rx_thread_running) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Size the rings for the current rate, with room for a few packets at least
+  size_t nof_samples = (size_t)(handler->rx_ring_ms * handler->rx_rate / 1000.0);
+  nof_samples        = SRSRAN_MAX(nof_samples, 4 * handler->rx_nof_samples);
+  int capacity       = (int)(nof_samples * sizeof(cf_t));
+  for (uint32_t i = 0; i < handler->nof_rx_channels; i++) {
+    srsran_ringbuffer_spsc_t* r = &handler->rx_ring[i];
+    if (r->buffer == nullptr) {
+      if (srsran_ringbuffer_spsc_init(r, capacity) < SRSRAN_SUCCESS) {
+        ERROR("Error initialising UHD Rx ring");
+        return SRSRAN_ERROR;
+      }
+    } else if (r->capacity != capacity) {
+      if (srsran_ringbuffer_spsc_resize(r, capacity) < SRSRAN_SUCCESS) {
+        ERROR("Error resizing UHD Rx ring");
+        return SRSRAN_ERROR;
+      }
+    } else {
+      srsran_ringbuffer_spsc_reset(r);
+    }
+    handler->rx_thread_buffer[i].resize(handler->rx_nof_samples);
+  }
+  handler->rx_ring_nof_read = 0;
+  handler->rx_ring_state    = RF_UHD_IMP_RX_RING_RESYNC;
+
+  handler->rx_thread_running = true;
+  handler->rx_thread         = std::thread(rx_thread_run, handler);
+
+  return SRSRAN_SUCCESS;
+}
+
+static void rf_uhd_rx_thread_stop_nolock(rf_uhd_handler_t* handler)
+{
+  if (not handler->rx_thread_running) {
+    return;
+  }
+
+  handler->rx_thread_running = false;
+  handler->rx_thread.join();
+}
+
+/**
+ * Reads nsamples from the Rx rings. It returns the number of read samples and the time of the first one, or
+ * SRSRAN_ERROR if the rings did not fill in RF_UHD_IMP_MAX_RX_TRIALS read timeouts.
+ */
+static int rf_uhd_rx_thread_read_nolock(rf_uhd_handler_t* handler,
+                                        void*             data[SRSRAN_MAX_PORTS],
+                                        uint32_t          nsamples,
+                                        uhd::time_spec_t& timespec)
+{
+  uint32_t rxd_samples_total = 0;
+  uint32_t trials            = 0;
+  uint32_t max_chunk         = (uint32_t)(handler->rx_ring[0].capacity / (2 * sizeof(cf_t)));
+
+  while (rxd_samples_total < nsamples) {
+    // The producer could not keep up the timeline, empty the rings, as UHD does it is signalled as an overflow
+    if (handler->rx_ring_state.load(std::memory_order_acquire) == RF_UHD_IMP_RX_RING_RESET_REQUEST) {
+      for (uint32_t i = 0; i < handler->nof_rx_channels; i++) {
+        srsran_ringbuffer_spsc_reset(&handler->rx_ring[i]);
+      }
+      handler->rx_ring_nof_read = 0;
+      handler->rx_ring_state.store(RF_UHD_IMP_RX_RING_RESYNC, std::memory_order_release);
+      log_overflow(handler);
+    }
+
+    uint32_t n       = SRSRAN_MIN(nsamples - rxd_samples_total, max_chunk);
+    bool     timeout = false;
+    for (uint32_t i = 0; i < handler->nof_rx_channels; i++) {
+      uint32_t count = n;
+      int      ret   = SRSRAN_SUCCESS;
+      if (data[i] != nullptr) {
+        cf_t* data_c = (cf_t*)data[i];
+        ret = srsran_ringbuffer_spsc_read_timed(
+            &handler->rx_ring[i], &data_c[rxd_samples_total], (int)(n * sizeof(cf_t)), RF_UHD_IMP_RX_RING_TIMEOUT_MS);
+      } else {
+        while (count > 0 and ret >= SRSRAN_SUCCESS) {
+          uint32_t m = SRSRAN_MIN(count, (uint32_t)dummy_mem.size());
+          ret        = srsran_ringbuffer_spsc_read_timed(
+              &handler->rx_ring[i], dummy_mem.data(), (int)(m * sizeof(cf_t)), RF_UHD_IMP_RX_RING_TIMEOUT_MS);
+          count -= m;
+        }
+      }
+
+      // The first channel waits for the producer, the others already hold the same samples
+      if (ret == SRSRAN_ERROR_TIMEOUT and i == 0) {
+        timeout = true;
+        break;
+      }
+      if (ret < SRSRAN_SUCCESS) {
+        ERROR("Error reading UHD Rx ring %d", i);
+        return SRSRAN_ERROR;
+      }
+
+      // The producer publishes the ring time before the samples, save it for the first block
+      if (i == 0 and rxd_samples_total == 0) {
+        timespec = handler->rx_ring_time +
+                   uhd::time_spec_t::from_ticks((long long)handler->rx_ring_nof_read, handler->rx_rate);
+      }
+      if (i == handler->nof_rx_channels - 1) {
+        rxd_samples_total += n;
+        handler->rx_ring_nof_read += n;
+      }
+    }
+
+    if (timeout and ++trials >= RF_UHD_IMP_MAX_RX_TRIALS) {
+      ERROR("Error timed out while receiving samples from UHD Rx thread.");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return (int)rxd_samples_total;
+}
+
 static inline int rf_uhd_start_rx_stream_nolock(rf_uhd_handler_t* handler)
 {
   // Check if stream was not created or started
@@ -536,6 +803,9 @@ int rf_uhd_start_rx_stream(void* h, bool now)
 
 static inline int rf_uhd_stop_rx_stream_nolock(rf_uhd_handler_t* handler)
 {
+  // The Rx thread must not receive while the stream is stopped or remade
+  rf_uhd_rx_thread_stop_nolock(handler);
+
   // Check if stream was created or stream was not started
   if (not handler->uhd->is_rx_ready() or not handler->rx_stream_enabled) {
     // Ignores command, the stream will start as soon as the Rx sampling rate is set
@@ -580,6 +850,9 @@ void rf_uhd_flush_buffer(void* h)
     i = dummy_mem.data();
   }
 
+  // The rings are discarded when the Rx thread starts again
+  rf_uhd_rx_thread_stop_nolock(handler);
+
   // Receive until time out
   uhd::rx_metadata_t md;
   do {
@@ -672,6 +945,20 @@ static int uhd_init(rf_uhd_handler_t* handler, char* args, uint32_t nof_channels
   }
 #endif
 
+  // Rx streamer thread, the spp argument sets the size of the packets it receives
+  if (device_addr.has_key("rx_thread")) {
+    std::string rx_thread      = device_addr.pop("rx_thread");
+    handler->rx_thread_enabled = (rx_thread == "1" or rx_thread == "true" or rx_thread == "yes");
+  }
+  if (device_addr.has_key("rx_thread_cpu")) {
+    handler->rx_thread_cpu = device_addr.cast("rx_thread_cpu", handler->rx_thread_cpu);
+    device_addr.pop("rx_thread_cpu");
+  }
+  if (device_addr.has_key("rx_ring_ms")) {
+    handler->rx_ring_ms = device_addr.cast("rx_ring_ms", handler->rx_ring_ms);
+    device_addr.pop("rx_ring_ms");
+  }
+
   // If device type or name not given in args, select device from found list
   if (not device_addr.has_key("type")) {
     // Find available devices
@@ -1002,6 +1289,9 @@ double rf_uhd_set_rx_srate(void* h, double freq)
     return freq;
   }
 
+  // Stop the Rx thread, also for the devices whose stream is not stopped the stream is remade
+  rf_uhd_rx_thread_stop_nolock(handler);
+
   // Stop RX streamer
   if (RF_UHD_IMP_PROHIBITED_STOP_START.count(handler->devname) == 0) {
     if (rf_uhd_stop_rx_stream_nolock(handler) != SRSRAN_SUCCESS) {
@@ -1300,6 +1590,19 @@ int rf_uhd_recv_with_time_multi(void*    h,
     }
   }
 
+  // Read from the Rx thread rings if it is enabled
+  if (handler->rx_thread_enabled) {
+    if (rf_uhd_rx_thread_start_nolock(handler) != SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    ret = rf_uhd_rx_thread_read_nolock(handler, data, nsamples, timespec);
+    if (ret >= SRSRAN_SUCCESS and secs != nullptr and frac_secs != nullptr) {
+      *secs      = timespec.get_full_secs();
+      *frac_secs = timespec.get_frac_secs();
+    }
+    return ret;
+  }
+
   // Receive stream in multiple blocks
   while (rxd_samples_total < nsamples and trials < RF_UHD_IMP_MAX_RX_TRIALS) {
     void* buffs_ptr[SRSRAN_MAX_CHANNELS] = {};
@@ -26,6 +26,7 @@
 #include <math.h>
 #include <srsran/phy/common/phy_common.h>
 #include <srsran/phy/common/timestamp.h>
+#include <srsran/phy/utils/bfp.h>
 #include <srsran/phy/utils/vector.h>
 #include <stdarg.h>
 #include <stdlib.h>
@@ -123,6 +124,26 @@ static inline int update_ts(void* h, uint64_t* ts, int nsamples, const char* dir
   return ret;
 }
 
+// Parses "fc32", "sc16" or "bfp<N>", block floating point with mantissas of N bits
+static int parse_sample_format(const char* str, rf_zmq_opts_t* opts)
+{
+  uint32_t mantissa_bits = 0;
+  char     end           = 0;
+  if (!strcmp(str, "fc32")) {
+    opts->sample_format = ZMQ_TYPE_FC32;
+  } else if (!strcmp(str, "sc16")) {
+    opts->sample_format = ZMQ_TYPE_SC16;
+  } else if (sscanf(str, "bfp%u%c", &mantissa_bits, &end) == 1 && mantissa_bits >= SRSRAN_BFP_MIN_MANTISSA_BITS &&
+             mantissa_bits <= SRSRAN_BFP_MAX_MANTISSA_BITS) {
+    opts->sample_format     = ZMQ_TYPE_BFP;
+    opts->bfp_mantissa_bits = mantissa_bits;
+  } else {
+    printf("Unsupported sample format %s\n", str);
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
 int rf_zmq_handle_error(char* id, const char* text)
 {
   int ret = SRSRAN_SUCCESS;
@@ -260,10 +281,7 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
       // rx_format
       rx_opts.sample_format = ZMQ_TYPE_FC32;
       if (parse_string(args, "rx_format", -1, tmp) == SRSRAN_SUCCESS) {
-        if (!strcmp(tmp, "sc16")) {
-          rx_opts.sample_format = ZMQ_TYPE_SC16;
-        } else {
-          printf("Unsupported sample format %s\n", tmp);
+        if (parse_sample_format(tmp, &rx_opts) != SRSRAN_SUCCESS) {
           goto clean_exit;
         }
       }
@@ -281,10 +299,7 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
       // tx_format
       tx_opts.sample_format = ZMQ_TYPE_FC32;
       if (parse_string(args, "tx_format", -1, tmp) == SRSRAN_SUCCESS) {
-        if (!strcmp(tmp, "sc16")) {
-          tx_opts.sample_format = ZMQ_TYPE_SC16;
-        } else {
-          printf("Unsupported sample format %s\n", tmp);
+        if (parse_sample_format(tmp, &tx_opts) != SRSRAN_SUCCESS) {
           goto clean_exit;
         }
       }
@@ -779,7 +794,7 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
     rf_zmq_info(handler->id,
                 " - read %d samples. %d samples available\n",
                 NBYTES2NSAMPLES(nbytes),
-                NBYTES2NSAMPLES(srsran_ringbuffer_status(&handler->receiver[0].ringbuffer)));
+                NBYTES2NSAMPLES(srsran_ringbuffer_spsc_status(&handler->receiver[0].ringbuffer)));
 
     // decimate if needed
     if (decim_factor != 1) {
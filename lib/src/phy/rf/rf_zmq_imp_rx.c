@@ -21,11 +21,42 @@
 
 #include "rf_zmq_imp_trx.h"
 #include <inttypes.h>
+#include <srsran/phy/utils/bfp.h>
 #include <srsran/phy/utils/vector.h>
 #include <stdlib.h>
 #include <string.h>
 #include <zmq.h>
 
+// Decompresses a ZMQ_TYPE_BFP message into the 16 bit samples of the ring buffer, returns their number of bytes
+static int rf_zmq_rx_decompress(rf_zmq_rx_t* q, int nbytes)
+{
+  rf_zmq_bfp_header_t header = {};
+  if (nbytes < (int)sizeof(header)) {
+    fprintf(stderr, "[zmq] Error: received %d bytes, shorter than the compression header\n", nbytes);
+    return SRSRAN_ERROR;
+  }
+  memcpy(&header, q->temp_buffer, sizeof(header));
+
+  if (header.mantissa_bits != q->bfp_mantissa_bits) {
+    fprintf(stderr,
+            "[zmq] Error: received samples compressed with %d bit mantissas, expected %d. Check tx_format/rx_format\n",
+            header.mantissa_bits,
+            q->bfp_mantissa_bits);
+    return SRSRAN_ERROR;
+  }
+
+  if (header.nof_samples > NBYTES2NSAMPLES(ZMQ_MAX_BUFFER_SIZE) ||
+      nbytes != (int)(sizeof(header) + srsran_bfp_nof_bytes(header.nof_samples, header.mantissa_bits))) {
+    fprintf(stderr, "[zmq] Error: received %d bytes for %d compressed samples\n", nbytes, header.nof_samples);
+    return SRSRAN_ERROR;
+  }
+
+  srsran_bfp_decompress(
+      (uint8_t*)q->temp_buffer + sizeof(header), q->bfp_buffer, header.nof_samples, header.mantissa_bits);
+
+  return (int)(2 * sizeof(int16_t) * header.nof_samples);
+}
+
 static void* rf_zmq_async_rx_thread(void* h)
 {
   rf_zmq_rx_t* q = (rf_zmq_rx_t*)h;
@@ -72,13 +103,23 @@ static void* rf_zmq_async_rx_thread(void* h)
       }
     }
 
+    // Decompress received data
+    void* data = q->temp_buffer;
+    if (nbytes > 0 && q->sample_format == ZMQ_TYPE_BFP) {
+      data   = q->bfp_buffer;
+      nbytes = rf_zmq_rx_decompress(q, nbytes);
+      if (nbytes < 0) {
+        return NULL;
+      }
+    }
+
     // Write received data in buffer
     if (nbytes > 0) {
       n = -1;
 
       // Try to write in ring buffer
       while (n < 0 && rf_zmq_rx_is_running(q)) {
-        n = srsran_ringbuffer_write_timed(&q->ringbuffer, q->temp_buffer, nbytes, q->trx_timeout_ms);
+        n = srsran_ringbuffer_spsc_write_timed(&q->ringbuffer, data, nbytes, q->trx_timeout_ms);
         if (n == SRSRAN_ERROR_TIMEOUT && q->log_trx_timeout) {
           fprintf(stderr, "Error: timeout writing samples to ringbuffer after %dms\n", q->trx_timeout_ms);
         }
@@ -90,7 +131,7 @@ static void* rf_zmq_async_rx_thread(void* h)
                     "   - received %d baseband samples (%d B). %d samples available.\n",
                     NBYTES2NSAMPLES(n),
                     n,
-                    NBYTES2NSAMPLES(srsran_ringbuffer_status(&q->ringbuffer)));
+                    NBYTES2NSAMPLES(srsran_ringbuffer_spsc_status(&q->ringbuffer)));
       }
     }
   }
@@ -118,6 +159,7 @@ int rf_zmq_rx_open(rf_zmq_rx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
     }
     q->socket_type        = opts.socket_type;
     q->sample_format      = opts.sample_format;
+    q->bfp_mantissa_bits  = opts.bfp_mantissa_bits;
     q->frequency_mhz      = opts.frequency_mhz;
     q->fail_on_disconnect = opts.fail_on_disconnect;
     q->sample_offset      = opts.sample_offset;
@@ -172,7 +214,7 @@ int rf_zmq_rx_open(rf_zmq_rx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
       }
     }
 
-    if (srsran_ringbuffer_init(&q->ringbuffer, ZMQ_MAX_BUFFER_SIZE)) {
+    if (srsran_ringbuffer_spsc_init(&q->ringbuffer, ZMQ_MAX_BUFFER_SIZE)) {
       fprintf(stderr, "Error: initiating ringbuffer\n");
       goto clean_exit;
     }
@@ -189,6 +231,14 @@ int rf_zmq_rx_open(rf_zmq_rx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
       goto clean_exit;
     }
 
+    if (q->sample_format == ZMQ_TYPE_BFP) {
+      q->bfp_buffer = srsran_vec_i16_malloc(2 * NBYTES2NSAMPLES(ZMQ_MAX_BUFFER_SIZE));
+      if (!q->bfp_buffer) {
+        fprintf(stderr, "Error: allocating decompression buffer\n");
+        goto clean_exit;
+      }
+    }
+
     if (pthread_mutex_init(&q->mutex, NULL)) {
       fprintf(stderr, "Error: creating mutex\n");
       goto clean_exit;
@@ -209,6 +259,7 @@ clean_exit:
 
 int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples)
 {
+  // The compressed samples are already decompressed to 16 bit by the async rx thread
   void*    dst_buffer = buffer;
   uint32_t sample_sz  = sizeof(cf_t);
   if (q->sample_format != ZMQ_TYPE_FC32) {
@@ -216,34 +267,36 @@ int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples)
     sample_sz  = 2 * sizeof(short);
   }
 
-  // If the read needs to be delayed
-  while (q->sample_offset > 0) {
-    uint32_t n_offset = SRSRAN_MIN(q->sample_offset, NBYTES2NSAMPLES(ZMQ_MAX_BUFFER_SIZE));
-    srsran_vec_zero(q->temp_buffer, n_offset);
-    int n = srsran_ringbuffer_write(&q->ringbuffer, q->temp_buffer, (int)(n_offset * sample_sz));
-    if (n < SRSRAN_SUCCESS) {
-      return n;
-    }
-    q->sample_offset -= n_offset;
+  // If the read needs to be delayed, prepend zeros to the output. They are not written in the ring buffer since the
+  // async rx thread is its only producer
+  uint32_t n_zeros = 0;
+  if (q->sample_offset > 0) {
+    n_zeros = SRSRAN_MIN((uint32_t)q->sample_offset, nsamples);
+    srsran_vec_u8_zero(dst_buffer, n_zeros * sample_sz);
+    q->sample_offset -= n_zeros;
   }
 
   // If the read needs to be advanced
   while (q->sample_offset < 0) {
     uint32_t n_offset = SRSRAN_MIN(-q->sample_offset, NBYTES2NSAMPLES(ZMQ_MAX_BUFFER_SIZE));
-    int      n =
-        srsran_ringbuffer_read_timed(&q->ringbuffer, q->temp_buffer, (int)(n_offset * sample_sz), q->trx_timeout_ms);
+    int      n        = srsran_ringbuffer_spsc_read_timed(
+        &q->ringbuffer, q->temp_buffer, (int)(n_offset * sample_sz), q->trx_timeout_ms);
     if (n < SRSRAN_SUCCESS) {
       return n;
     }
     q->sample_offset += n_offset;
   }
 
-  int n = srsran_ringbuffer_read_timed(&q->ringbuffer, dst_buffer, sample_sz * nsamples, q->trx_timeout_ms);
+  int n = srsran_ringbuffer_spsc_read_timed(&q->ringbuffer,
+                                            (uint8_t*)dst_buffer + n_zeros * sample_sz,
+                                            sample_sz * (nsamples - n_zeros),
+                                            q->trx_timeout_ms);
   if (n < 0) {
     return n;
   }
+  n += n_zeros * sample_sz;
 
-  if (q->sample_format == ZMQ_TYPE_SC16) {
+  if (q->sample_format != ZMQ_TYPE_FC32) {
     srsran_vec_convert_if(dst_buffer, INT16_MAX, (float*)buffer, 2 * nsamples);
   }
 
@@ -274,7 +327,7 @@ void rf_zmq_rx_close(rf_zmq_rx_t* q)
 
   pthread_mutex_destroy(&q->mutex);
 
-  srsran_ringbuffer_free(&q->ringbuffer);
+  srsran_ringbuffer_spsc_free(&q->ringbuffer);
 
   if (q->temp_buffer) {
     free(q->temp_buffer);
@@ -284,6 +337,10 @@ void rf_zmq_rx_close(rf_zmq_rx_t* q)
     free(q->temp_buffer_convert);
   }
 
+  if (q->bfp_buffer) {
+    free(q->bfp_buffer);
+  }
+
   if (q->sock) {
     zmq_close(q->sock);
     q->sock = NULL;
@@ -38,7 +38,13 @@
 #define ZMQ_MAX_GAIN_DB (30.0f)
 #define ZMQ_MIN_GAIN_DB (0.0f)
 
-typedef enum { ZMQ_TYPE_FC32 = 0, ZMQ_TYPE_SC16 } rf_zmq_format_t;
+typedef enum { ZMQ_TYPE_FC32 = 0, ZMQ_TYPE_SC16, ZMQ_TYPE_BFP } rf_zmq_format_t;
+
+/// Header of the ZMQ_TYPE_BFP messages, followed by the samples compressed with srsran_bfp_compress()
+typedef struct {
+  uint32_t nof_samples;
+  uint32_t mantissa_bits; ///< Checked by the receiver, both ends must be configured with the same format
+} rf_zmq_bfp_header_t;
 
 typedef struct {
   char            id[ZMQ_ID_STRLEN];
@@ -50,6 +56,8 @@ typedef struct {
   pthread_mutex_t mutex;
   cf_t*           zeros;
   void*           temp_buffer_convert;
+  uint8_t*        bfp_buffer; ///< Compressed samples, only for ZMQ_TYPE_BFP
+  uint32_t        bfp_mantissa_bits;
   uint32_t        frequency_mhz;
   int32_t         sample_offset;
 } rf_zmq_tx_t;
@@ -63,24 +71,27 @@ typedef struct {
   void* socket_monitor;
   bool  tx_connected;
 #endif
-  uint64_t            nsamples;
-  bool                running;
-  pthread_t           thread;
-  pthread_mutex_t     mutex;
-  srsran_ringbuffer_t ringbuffer;
-  cf_t*               temp_buffer;
-  void*               temp_buffer_convert;
-  uint32_t            frequency_mhz;
-  bool                fail_on_disconnect;
-  uint32_t            trx_timeout_ms;
-  bool                log_trx_timeout;
-  int32_t             sample_offset;
+  uint64_t                 nsamples;
+  bool                     running;
+  pthread_t                thread;
+  pthread_mutex_t          mutex;
+  srsran_ringbuffer_spsc_t ringbuffer; ///< Written by the async rx thread, read by rf_zmq_rx_baseband() only
+  cf_t*                    temp_buffer;
+  void*                    temp_buffer_convert;
+  int16_t*                 bfp_buffer; ///< Decompressed samples written by the async rx thread, only for ZMQ_TYPE_BFP
+  uint32_t                 bfp_mantissa_bits;
+  uint32_t                 frequency_mhz;
+  bool                     fail_on_disconnect;
+  uint32_t                 trx_timeout_ms;
+  bool                     log_trx_timeout;
+  int32_t                  sample_offset;
 } rf_zmq_rx_t;
 
 typedef struct {
   const char*     id;
   uint32_t        socket_type;
   rf_zmq_format_t sample_format;
+  uint32_t        bfp_mantissa_bits; ///< Only for ZMQ_TYPE_BFP
   uint32_t        frequency_mhz;
   bool            fail_on_disconnect;
   uint32_t        trx_timeout_ms;
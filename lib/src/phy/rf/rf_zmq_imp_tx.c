@@ -22,6 +22,7 @@
 #include "rf_zmq_imp_trx.h"
 #include <inttypes.h>
 #include <srsran/config.h>
+#include <srsran/phy/utils/bfp.h>
 #include <srsran/phy/utils/vector.h>
 #include <stdlib.h>
 #include <string.h>
@@ -45,10 +46,11 @@ int rf_zmq_tx_open(rf_zmq_tx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
       fprintf(stderr, "[zmq] Error: creating transmitter socket\n");
       goto clean_exit;
     }
-    q->socket_type   = opts.socket_type;
-    q->sample_format = opts.sample_format;
-    q->frequency_mhz = opts.frequency_mhz;
-    q->sample_offset = opts.sample_offset;
+    q->socket_type       = opts.socket_type;
+    q->sample_format     = opts.sample_format;
+    q->bfp_mantissa_bits = opts.bfp_mantissa_bits;
+    q->frequency_mhz     = opts.frequency_mhz;
+    q->sample_offset     = opts.sample_offset;
 
     rf_zmq_info(q->id, "Binding transmitter: %s\n", sock_args);
 
@@ -95,6 +97,14 @@ int rf_zmq_tx_open(rf_zmq_tx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
     }
     bzero(q->zeros, ZMQ_MAX_BUFFER_SIZE);
 
+    if (q->sample_format == ZMQ_TYPE_BFP) {
+      q->bfp_buffer = srsran_vec_u8_malloc(ZMQ_MAX_BUFFER_SIZE);
+      if (!q->bfp_buffer) {
+        fprintf(stderr, "Error: allocating compression buffer\n");
+        goto clean_exit;
+      }
+    }
+
     q->running = true;
 
     ret = SRSRAN_SUCCESS;
@@ -128,27 +138,35 @@ static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
     }
 
     // convert samples if necessary
-    void*    buf       = (buffer) ? buffer : q->zeros;
-    uint32_t sample_sz = sizeof(cf_t);
+    void*    buf    = (buffer) ? buffer : q->zeros;
+    uint32_t nbytes = NSAMPLES2NBYTES(nsamples);
 
-    if (q->sample_format == ZMQ_TYPE_SC16) {
-      buf       = q->temp_buffer_convert;
-      sample_sz = 2 * sizeof(short);
-      srsran_vec_convert_fi((float*)buffer, INT16_MAX, (short*)q->temp_buffer_convert, 2 * nsamples);
+    if (q->sample_format == ZMQ_TYPE_SC16 || q->sample_format == ZMQ_TYPE_BFP) {
+      srsran_vec_convert_fi((float*)buf, INT16_MAX, (short*)q->temp_buffer_convert, 2 * nsamples);
+      buf    = q->temp_buffer_convert;
+      nbytes = 2 * sizeof(short) * nsamples;
+    }
+
+    if (q->sample_format == ZMQ_TYPE_BFP) {
+      rf_zmq_bfp_header_t header  = {nsamples, q->bfp_mantissa_bits};
+      uint8_t*            payload = q->bfp_buffer + sizeof(header);
+      memcpy(q->bfp_buffer, &header, sizeof(header));
+      nbytes = sizeof(header) + srsran_bfp_compress(q->temp_buffer_convert, payload, nsamples, q->bfp_mantissa_bits);
+      buf    = q->bfp_buffer;
     }
 
     // Send base-band if request was received
     if (n > 0) {
-      n = zmq_send(q->sock, buf, (size_t)sample_sz * nsamples, 0);
+      n = zmq_send(q->sock, buf, (size_t)nbytes, 0);
       if (n < 0) {
         if (rf_zmq_handle_error(q->id, "tx baseband send")) {
           n = SRSRAN_ERROR;
           goto clean_exit;
         }
-      } else if (n != NSAMPLES2NBYTES(nsamples)) {
+      } else if (n != nbytes) {
         rf_zmq_error(q->id,
                      "[zmq] Error: transmitter expected %d bytes and sent %d. %s.\n",
-                     NSAMPLES2NBYTES(nsamples),
+                     nbytes,
                      n,
                      strerror(zmq_errno()));
         n = SRSRAN_ERROR;
@@ -254,6 +272,10 @@ void rf_zmq_tx_close(rf_zmq_tx_t* q)
     free(q->temp_buffer_convert);
   }
 
+  if (q->bfp_buffer) {
+    free(q->bfp_buffer);
+  }
+
   if (q->sock) {
     zmq_close(q->sock);
     q->sock = NULL;
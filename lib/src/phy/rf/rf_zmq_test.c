@@ -33,6 +33,7 @@
 #define PRINT_SAMPLES 1
 #define COMPARE_BITS 0
 #define COMPARE_EPSILON (1e-6f)
+#define COMPARE_EPSILON_BFP9 (1e-2f) // Quantization error of 9-bit block floating point samples
 #define NOF_RX_ANT 4
 #define NUM_SF (500)
 #define SF_LEN (1920)
@@ -153,7 +154,7 @@ void enb_tx_function(const char* tx_args, bool timed_tx)
   srsran_rf_close(&enb_radio);
 }
 
-int run_test(const char* rx_args, const char* tx_args, bool timed_tx)
+int run_test(const char* rx_args, const char* tx_args, bool timed_tx, float epsilon)
 {
   int ret = SRSRAN_ERROR;
 
@@ -209,7 +210,7 @@ int run_test(const char* rx_args, const char* tx_args, bool timed_tx)
                          &ue_rx_buffer[c][sf_offet + i * SF_LEN],
                          SF_LEN);
       uint32_t max_ix = srsran_vec_max_abs_ci(&ue_rx_buffer[c][sf_offet + i * SF_LEN], SF_LEN);
-      if (cabsf(ue_rx_buffer[c][sf_offet + i * SF_LEN + max_ix]) > COMPARE_EPSILON) {
+      if (cabsf(ue_rx_buffer[c][sf_offet + i * SF_LEN + max_ix]) > epsilon) {
         fprintf(stderr, "data mismatch in subframe %d\n", i);
         goto exit;
       }
@@ -273,8 +274,10 @@ int main()
 
 #if NOF_RX_ANT == 1
   // single tx, single rx with continuous transmissions (no timed tx) using IPC transport
-  if (run_test("rx_port=ipc://link1,id=ue,base_srate=1.92e6", "tx_port=ipc://link1,id=enb,base_srate=1.92e6", false) !=
-      SRSRAN_SUCCESS) {
+  if (run_test("rx_port=ipc://link1,id=ue,base_srate=1.92e6",
+               "tx_port=ipc://link1,id=enb,base_srate=1.92e6",
+               false,
+               COMPARE_EPSILON) != SRSRAN_SUCCESS) {
     fprintf(stderr, "Single tx, single rx test failed!\n");
     return -1;
   }
@@ -287,7 +290,8 @@ int main()
                "rx_port=tcp://localhost:5554,rx_port=tcp://localhost:5556,rx_port=tcp://localhost:5558,rx_port=tcp://"
                "localhost:5560,tx_port=tcp://*:5555,tx_port=tcp://*:5557,tx_port=tcp://*:5559,tx_port=tcp://"
                "*:5561,id=enb,base_srate=1.92e6",
-               false) != SRSRAN_SUCCESS) {
+               false,
+               COMPARE_EPSILON) != SRSRAN_SUCCESS) {
     fprintf(stderr, "Multi TRx radio test failed!\n");
     return -1;
   }
@@ -298,7 +302,8 @@ int main()
                "rx_port=tcp://localhost:5554,rx_port=tcp://localhost:5556,rx_port=tcp://localhost:5558,rx_port=tcp://"
                "localhost:5560,tx_port=ipc://dl0,tx_port=ipc://dl1,tx_port=ipc://dl2,tx_port=ipc://"
                "dl3,id=enb,base_srate=1.92e6",
-               true) != SRSRAN_SUCCESS) {
+               true,
+               COMPARE_EPSILON) != SRSRAN_SUCCESS) {
     fprintf(stderr, "Multi TRx radio test with timed tx failed!\n");
     return -1;
   }
@@ -310,10 +315,22 @@ int main()
                "rx_port=tcp://localhost:5554,rx_port=tcp://localhost:5556,rx_port=tcp://localhost:5558,rx_port=tcp://"
                "localhost:5560,tx_port=ipc://dl0,tx_port=ipc://dl1,tx_port=ipc://dl2,tx_port=ipc://"
                "dl3,id=enb,base_srate=23.04e6",
-               true) != SRSRAN_SUCCESS) {
+               true,
+               COMPARE_EPSILON) != SRSRAN_SUCCESS) {
     fprintf(stderr, "Multi TRx radio test with timed tx and decimation failed!\n");
     return -1;
   }
 
+  // up to 4 trx radios with continous tx (timed tx) using IPC and block floating point compression in both directions
+  if (run_test("tx_port=ipc://ul0,tx_port=ipc://ul1,tx_port=ipc://ul2,tx_port=ipc://ul3,rx_port=ipc://dl0,rx_port=ipc://"
+               "dl1,rx_port=ipc://dl2,rx_port=ipc://dl3,id=ue,base_srate=1.92e6,rx_format=bfp9,tx_format=bfp9",
+               "rx_port=ipc://ul0,rx_port=ipc://ul1,rx_port=ipc://ul2,rx_port=ipc://ul3,tx_port=ipc://dl0,tx_port=ipc://"
+               "dl1,tx_port=ipc://dl2,tx_port=ipc://dl3,id=enb,base_srate=1.92e6,rx_format=bfp9,tx_format=bfp9",
+               true,
+               COMPARE_EPSILON_BFP9) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test with block floating point compression failed!\n");
+    return -1;
+  }
+
   return SRSRAN_SUCCESS;
 }
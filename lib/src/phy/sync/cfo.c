@@ -107,6 +107,21 @@ void srsran_cfo_correct(srsran_cfo_t* h, const cf_t* input, cf_t* output, float
 #endif /* SRSRAN_CFO_USE_EXP_TABLE */
 }
 
+float srsran_cfo_correct_power(srsran_cfo_t* h, const cf_t* input, cf_t* output, float freq, float* max_pwr)
+{
+#if SRSRAN_CFO_USE_EXP_TABLE
+  if (fabs(h->last_freq - freq) > h->tol) {
+    h->last_freq = freq;
+    srsran_cexptab_gen(&h->tab, h->cur_cexp, h->last_freq, h->nsamples);
+    DEBUG("CFO generating new table for frequency %.4fe-6", freq * 1e6);
+  }
+  return srsran_vec_prod_ccc_max_avg_power(h->cur_cexp, input, output, max_pwr, h->nsamples);
+#else  /* SRSRAN_CFO_USE_EXP_TABLE */
+  srsran_vec_apply_cfo(input, freq, output, h->nsamples);
+  return srsran_vec_max_avg_power_cf(output, max_pwr, h->nsamples);
+#endif /* SRSRAN_CFO_USE_EXP_TABLE */
+}
+
 /* CFO correction which allows to specify the offset within the correction
  * table to allow phase-continuity across multi-subframe transmissions (NB-IoT)
  * Note that when correction table needs to be regenerated, the regeneration
@@ -405,6 +405,15 @@ void srsran_pss_set_ema_alpha(srsran_pss_t* q, float alpha)
   q->ema_alpha = alpha;
 }
 
+/* When the correlation window (frame_size) is shorter than the FFT size, as in tracking, the correlation is computed by
+ * default with one dot product per lag. If enabled, it is computed instead through the DFT of the
+ * frame_size + fft_size input samples, which is cheaper when frame_size * fft_size is large.
+ */
+void srsran_pss_set_short_window_fft(srsran_pss_t* q, bool enable)
+{
+  q->short_window_fft = enable;
+}
+
 float compute_peak_sidelobe(srsran_pss_t* q, uint32_t corr_peak_pos, uint32_t conv_output_len)
 {
   // Find end of peak lobe to the right
@@ -482,6 +491,16 @@ int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_val
 #else
       conv_output_len =
           srsran_conv_cc(input, q->pss_signal_time[q->N_id_2], q->conv_output, q->frame_size, q->fft_size);
+#endif
+#ifdef CONVOLUTION_FFT
+    } else if (q->short_window_fft && q->decimate <= 1) {
+      /* The convolution output from fft_size on is free of circular aliasing and its index n matches the lag
+       * n - fft_size of the dot products below
+       */
+      srsran_vec_cf_copy(q->tmp_input, input, q->frame_size + q->fft_size);
+      srsran_conv_fft_cc_run_opt(&q->conv_fft, q->tmp_input, q->pss_signal_freq_full[q->N_id_2], q->conv_output);
+      memmove(q->conv_output, &q->conv_output[q->fft_size], q->frame_size * sizeof(cf_t));
+      conv_output_len = q->frame_size;
 #endif
     } else {
       for (int i = 0; i < q->frame_size; i++) {
@@ -534,6 +553,113 @@ int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_val
   return ret;
 }
 
+/** Correlates the input with the PSS sequences of the three N_id_2 and selects the one with the highest correlation
+ * metric (the same metric srsran_pss_find_pss() stores in corr_peak_value). When the FFT-based convolution is used,
+ * the input DFT is computed once and shared by the three hypotheses.
+ *
+ * The selected N_id_2 is set in the object and stored in *N_id_2. Since the averaged correlation belongs to a single
+ * sequence, this function can not be used while the correlation averaging (srsran_pss_set_ema_alpha()) is enabled.
+ *
+ * Returns the end index of the correlation peak of the selected sequence, as srsran_pss_find_pss()
+ */
+int srsran_pss_find_pss_all(srsran_pss_t* q, const cf_t* input, uint32_t* N_id_2, float* corr_peak_value)
+{
+  if (q == NULL || input == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (q->ema_alpha < 1.0 && q->ema_alpha > 0.0) {
+    ERROR("Error finding PSS peak, correlation averaging can not be used with all N_id_2");
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t best_N_id_2 = 0;
+  float    best_metric = -1.0f;
+  int      ret         = SRSRAN_ERROR;
+
+#ifdef CONVOLUTION_FFT
+  if (q->frame_size >= q->fft_size) {
+    const cf_t* corr_input = q->tmp_input;
+    memcpy(q->tmp_input, input, (q->frame_size * q->decimate) * sizeof(cf_t));
+    if (q->decimate > 1) {
+      srsran_filt_decim_cc_execute(&(q->filter),
+                                   q->tmp_input,
+                                   q->filter.downsampled_input,
+                                   q->filter.filter_output,
+                                   (q->frame_size * q->decimate));
+      corr_input = q->filter.filter_output;
+    }
+
+    // Input DFT is common to all the sequences
+    srsran_dft_run_c(&q->conv_fft.input_plan, corr_input, q->conv_fft.input_fft);
+    uint32_t conv_output_len = q->conv_fft.output_len - 1;
+    uint32_t best_peak_pos   = 0;
+
+    for (uint32_t n = 0; n < 3; n++) {
+      srsran_vec_prod_ccc(
+          q->conv_fft.input_fft, q->pss_signal_freq_full[n], q->conv_fft.output_fft, q->conv_fft.output_len);
+      srsran_dft_run_c(&q->conv_fft.output_plan, q->conv_fft.output_fft, q->conv_output);
+      srsran_vec_abs_square_cf(q->conv_output, q->conv_output_abs, conv_output_len - 1);
+
+      // Keep the correlation of the best sequence in conv_output_avg, the other buffer is used as scratch
+      float* tmp         = q->conv_output_avg;
+      q->conv_output_avg = q->conv_output_abs;
+      q->conv_output_abs = tmp;
+
+      uint32_t peak_pos = srsran_vec_max_fi(q->conv_output_avg, conv_output_len - 1);
+#ifdef SRSRAN_PSS_RETURN_PSR
+      float metric = compute_peak_sidelobe(q, peak_pos, conv_output_len);
+#else
+      float metric = q->conv_output_avg[peak_pos];
+#endif
+      if (metric > best_metric) {
+        best_metric   = metric;
+        best_N_id_2   = n;
+        best_peak_pos = peak_pos;
+        q->peak_value = q->conv_output_avg[peak_pos];
+      } else {
+        q->conv_output_abs = q->conv_output_avg;
+        q->conv_output_avg = tmp;
+      }
+    }
+
+    if (q->decimate > 1) {
+      int decimation_correction = (q->filter.num_taps - 2);
+      best_peak_pos             = best_peak_pos - decimation_correction;
+      best_peak_pos             = best_peak_pos * q->decimate;
+    }
+    ret = (int)best_peak_pos;
+  } else
+#endif
+  {
+    float best_peak_value = 0.0f;
+    for (uint32_t n = 0; n < 3; n++) {
+      float metric = 0.0f;
+      q->N_id_2    = n;
+      int peak_pos = srsran_pss_find_pss(q, input, &metric);
+      if (peak_pos < 0) {
+        return peak_pos;
+      }
+      if (metric > best_metric) {
+        best_metric     = metric;
+        best_N_id_2     = n;
+        best_peak_value = q->peak_value;
+        ret             = peak_pos;
+      }
+    }
+    q->peak_value = best_peak_value;
+  }
+
+  q->N_id_2 = best_N_id_2;
+  if (N_id_2) {
+    *N_id_2 = best_N_id_2;
+  }
+  if (corr_peak_value) {
+    *corr_peak_value = best_metric;
+  }
+  return ret;
+}
+
 /* Computes frequency-domain channel estimation of the PSS symbol
  * input signal is in the time-domain.
  * ce is the returned frequency-domain channel estimates.
@@ -88,11 +88,21 @@ static inline void refsignal_sf_prepare_correlation(srsran_refsignal_dl_sync_t*
   srsran_dft_run_c(&q->conv_fft_cc.filter_plan, ptr_filt, ptr_filt);
 }
 
-static inline void
-refsignal_sf_correlate(srsran_refsignal_dl_sync_t* q, cf_t* ptr_in, float* peak_value, uint32_t* peak_idx, float* rms)
+static inline void refsignal_sf_correlate(srsran_refsignal_dl_sync_t* q,
+                                          cf_t*                       ptr_in,
+                                          const cf_t*                 ptr_in_fft,
+                                          float*                      peak_value,
+                                          uint32_t*                   peak_idx,
+                                          float*                      rms)
 {
-  // Correlate
-  srsran_corr_fft_cc_run_opt(&q->conv_fft_cc, ptr_in, q->conv_fft_cc.filter_fft, q->correlation);
+  // Correlate, reusing the input DFT if it is available
+  if (ptr_in_fft) {
+    srsran_vec_prod_conj_ccc(
+        ptr_in_fft, q->conv_fft_cc.filter_fft, q->conv_fft_cc.output_fft, q->conv_fft_cc.output_len);
+    srsran_dft_run_c(&q->conv_fft_cc.output_plan, q->conv_fft_cc.output_fft, q->correlation);
+  } else {
+    srsran_corr_fft_cc_run_opt(&q->conv_fft_cc, ptr_in, q->conv_fft_cc.filter_fft, q->correlation);
+  }
 
   // Find maximum, calculate RMS and peak
   uint32_t imax = srsran_vec_max_abs_ci(q->correlation, q->ifft.sf_sz);
@@ -299,6 +309,10 @@ void srsran_refsignal_dl_sync_free(srsran_refsignal_dl_sync_t* q)
       free(q->correlation);
     }
 
+    if (q->buffer_fft) {
+      free(q->buffer_fft);
+    }
+
     for (int i = 0; i < SRSRAN_NOF_SF_X_FRAME; i++) {
       if (q->sequences[i]) {
         free(q->sequences[i]);
@@ -309,7 +323,52 @@ void srsran_refsignal_dl_sync_free(srsran_refsignal_dl_sync_t* q)
   }
 }
 
-int refsignal_dl_sync_find_peak(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples)
+int srsran_refsignal_dl_sync_prepare(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  if (q == NULL || buffer == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t sf_len = q->ifft.sf_sz;
+  if (sf_len == 0) {
+    return SRSRAN_ERROR;
+  }
+
+  // Same windows as refsignal_dl_sync_find_peak()
+  uint32_t nof_windows = 0;
+  for (uint32_t n = 0; n + q->conv_fft_cc.filter_len < nsamples; n += q->conv_fft_cc.input_len) {
+    nof_windows++;
+  }
+
+  uint32_t len = nof_windows * q->conv_fft_cc.output_len;
+  if (len > q->buffer_fft_max_len) {
+    if (q->buffer_fft) {
+      free(q->buffer_fft);
+    }
+    q->buffer_fft = srsran_vec_cf_malloc(len);
+    if (q->buffer_fft == NULL) {
+      q->buffer_fft_max_len = 0;
+      q->buffer             = NULL;
+      return SRSRAN_ERROR;
+    }
+    q->buffer_fft_max_len = len;
+  }
+
+  for (uint32_t w = 0; w < nof_windows; w++) {
+    srsran_dft_run_c(&q->conv_fft_cc.input_plan,
+                     &buffer[w * q->conv_fft_cc.input_len],
+                     &q->buffer_fft[w * q->conv_fft_cc.output_len]);
+  }
+
+  q->buffer           = buffer;
+  q->buffer_nsamples  = nsamples;
+  q->buffer_fft_sf_sz = sf_len;
+
+  return SRSRAN_SUCCESS;
+}
+
+static int
+refsignal_dl_sync_find_peak_fft(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples, const cf_t* buffer_fft)
 {
   int   ret        = SRSRAN_ERROR;
   float peak_value = 0.0f;
@@ -325,12 +384,13 @@ int refsignal_dl_sync_find_peak(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uin
   refsignal_sf_prepare_correlation(q);
 
   // Correlation
-  for (uint32_t n = 0; n + q->conv_fft_cc.filter_len < nsamples; n += q->conv_fft_cc.input_len) {
+  for (uint32_t n = 0, w = 0; n + q->conv_fft_cc.filter_len < nsamples; n += q->conv_fft_cc.input_len, w++) {
     // Correlate, find maximum, calculate RMS and peak
-    uint32_t imax = 0;
-    float    peak = 0.0f;
-    float    rms  = 0.0f;
-    refsignal_sf_correlate(q, &buffer[n], &peak, &imax, &rms);
+    uint32_t    imax   = 0;
+    float       peak   = 0.0f;
+    float       rms    = 0.0f;
+    const cf_t* in_fft = buffer_fft ? &buffer_fft[w * q->conv_fft_cc.output_len] : NULL;
+    refsignal_sf_correlate(q, &buffer[n], in_fft, &peak, &imax, &rms);
 
     rms_avg += rms;
 
@@ -376,11 +436,14 @@ int refsignal_dl_sync_find_peak(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uin
   return ret;
 }
 
-int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples)
+int refsignal_dl_sync_find_peak(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  return refsignal_dl_sync_find_peak_fft(q, buffer, nsamples, NULL);
+}
+
+static int
+refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples, const cf_t* buffer_fft)
 {
-  if (q == NULL || buffer == NULL) {
-    return SRSRAN_ERROR_INVALID_INPUTS;
-  }
   uint32_t sf_len                 = q->ifft.sf_sz;
   uint32_t sf_count               = 0;
   float    rsrp_lin               = 0.0f;
@@ -396,7 +459,7 @@ int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, ui
   bool     false_alarm            = false;
 
   // Stage 1: find peak
-  int peak_idx = refsignal_dl_sync_find_peak(q, buffer, nsamples);
+  int peak_idx = refsignal_dl_sync_find_peak_fft(q, buffer, nsamples, buffer_fft);
 
   // Stage 2: Proccess subframes
   if (peak_idx >= 0) {
@@ -526,6 +589,27 @@ int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, ui
   return SRSRAN_SUCCESS;
 }
 
+int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  if (q == NULL || buffer == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  return refsignal_dl_sync_run(q, buffer, nsamples, NULL);
+}
+
+int srsran_refsignal_dl_sync_run_prepared(srsran_refsignal_dl_sync_t* q)
+{
+  if (q == NULL || q->buffer == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // The windows DFT can not be reused if the cell bandwidth has changed since it was computed
+  const cf_t* buffer_fft = (q->buffer_fft_sf_sz == q->ifft.sf_sz) ? q->buffer_fft : NULL;
+
+  return refsignal_dl_sync_run(q, q->buffer, q->buffer_nsamples, buffer_fft);
+}
+
 void srsran_refsignal_dl_sync_measure_sf(srsran_refsignal_dl_sync_t* q,
                                          cf_t*                       buffer,
                                          uint32_t                    sf_idx,
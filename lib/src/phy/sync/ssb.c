@@ -348,11 +348,10 @@ static int ssb_setup_corr(srsran_ssb_t* q)
   // Compute new correlation size
   uint32_t corr_sz = SSB_CORR_SZ(q->symbol_sz);
 
-  // Skip if the symbol size is unchanged
-  if (q->corr_sz == corr_sz) {
+  // Skip if the correlation size, the symbol size and the SSB frequency offset are unchanged
+  if (q->corr_sz == corr_sz && q->corr_symbol_sz == q->symbol_sz && q->corr_f_offset == q->f_offset) {
     return SRSRAN_SUCCESS;
   }
-  q->corr_sz = corr_sz;
 
   // Select correlation window, return error if the correlation window is smaller than a symbol
   if (corr_sz < 2 * q->symbol_sz) {
@@ -361,22 +360,32 @@ static int ssb_setup_corr(srsran_ssb_t* q)
   }
   q->corr_window = corr_sz - q->symbol_sz;
 
-  // Free correlation
-  srsran_dft_plan_free(&q->fft_corr);
-  srsran_dft_plan_free(&q->ifft_corr);
+  // Replan the correlation DFT only if its size changed
+  if (q->corr_sz != corr_sz) {
+    q->corr_sz = corr_sz;
 
-  // Prepare correlation FFT
-  if (srsran_dft_plan_guru_c(&q->fft_corr, (int)corr_sz, SRSRAN_DFT_FORWARD, q->tmp_time, q->tmp_freq, 1, 1, 1, 1, 1) <
-      SRSRAN_SUCCESS) {
-    ERROR("Error planning correlation DFT");
-    return SRSRAN_ERROR;
-  }
-  if (srsran_dft_plan_guru_c(
-          &q->ifft_corr, (int)corr_sz, SRSRAN_DFT_BACKWARD, q->tmp_corr, q->tmp_time, 1, 1, 1, 1, 1) < SRSRAN_SUCCESS) {
-    ERROR("Error planning correlation DFT");
-    return SRSRAN_ERROR;
+    // Free correlation
+    srsran_dft_plan_free(&q->fft_corr);
+    srsran_dft_plan_free(&q->ifft_corr);
+
+    // Prepare correlation FFT
+    if (srsran_dft_plan_guru_c(
+            &q->fft_corr, (int)corr_sz, SRSRAN_DFT_FORWARD, q->tmp_time, q->tmp_freq, 1, 1, 1, 1, 1) < SRSRAN_SUCCESS) {
+      ERROR("Error planning correlation DFT");
+      return SRSRAN_ERROR;
+    }
+    if (srsran_dft_plan_guru_c(
+            &q->ifft_corr, (int)corr_sz, SRSRAN_DFT_BACKWARD, q->tmp_corr, q->tmp_time, 1, 1, 1, 1, 1) <
+        SRSRAN_SUCCESS) {
+      ERROR("Error planning correlation DFT");
+      return SRSRAN_ERROR;
+    }
   }
 
+  // The PSS sequences depend on the symbol size and on the SSB position in the base-band
+  q->corr_symbol_sz = q->symbol_sz;
+  q->corr_f_offset  = q->f_offset;
+
   // Zero the time domain signal last samples
   srsran_vec_cf_zero(&q->tmp_time[q->symbol_sz], q->corr_window);
 
@@ -850,12 +859,16 @@ static void ssb_vec_prod_conj_circ_shift(const cf_t* a, const cf_t* b, cf_t* c,
   srsran_vec_prod_conj_ccc(a, b, c, n);
 }
 
-static int ssb_pss_search(srsran_ssb_t* q,
-                          const cf_t*   in,
-                          uint32_t      nof_samples,
-                          uint32_t*     found_N_id_2,
-                          uint32_t*     found_delay,
-                          float*        coarse_cfo_hz)
+/*
+ * Correlates the PSS of every candidate in res, each of them given by its SSB center frequency. As a frequency offset
+ * is a circular shift in the correlation frequency domain, the input is converted to frequency domain once per
+ * correlation window and it is shared by all the candidates.
+ */
+static int ssb_pss_search_multi(srsran_ssb_t*         q,
+                                const cf_t*           in,
+                                uint32_t              nof_samples,
+                                srsran_ssb_pss_res_t* res,
+                                uint32_t              nof_res)
 {
   // verify it is initialised
   if (q->corr_sz == 0) {
@@ -871,11 +884,13 @@ static int ssb_pss_search(srsran_ssb_t* q,
   // Calculate the coarse shift increment for half of the subcarrier spacing
   int shift_coarse_inc = shift_range / 2;
 
-  // Correlation best sequence
-  float    best_corr   = 0;
-  uint32_t best_delay  = 0;
-  uint32_t best_N_id_2 = 0;
-  int      best_shift  = 0;
+  // Reset the correlation results
+  for (uint32_t i = 0; i < nof_res; i++) {
+    res[i].N_id_2        = 0;
+    res[i].t_offset      = 0;
+    res[i].corr          = 0.0f;
+    res[i].coarse_cfo_hz = 0.0f;
+  }
 
   // Delay in correlation window
   uint32_t t_offset = 0;
@@ -899,35 +914,42 @@ static int ssb_pss_search(srsran_ssb_t* q,
     // Convert to frequency domain
     srsran_dft_run_guru_c(&q->fft_corr);
 
-    // Try each N_id_2 sequence
-    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2_NR; N_id_2++) {
-      // Steer coarse frequency offset
-      for (int shift = -shift_range; shift <= shift_range; shift += shift_coarse_inc) {
-        // Actual correlation in frequency domain
-        ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[N_id_2], q->tmp_corr, q->corr_sz, shift);
-
-        // Convert to time domain
-        srsran_dft_run_guru_c(&q->ifft_corr);
-
-        // Find maximum
-        uint32_t peak_idx = srsran_vec_max_abs_ci(q->tmp_time, q->corr_window);
-
-        // Average power, take total power of the frequency domain signal after filtering, skip correlation window if
-        // value is invalid (0.0, nan or inf)
-        float avg_pwr_corr = srsran_vec_avg_power_cf(q->tmp_corr, q->corr_sz);
-        if (!isnormal(avg_pwr_corr)) {
-          continue;
-        }
-
-        // Normalise correlation
-        float corr = SRSRAN_CSQABS(q->tmp_time[peak_idx]) / avg_pwr_corr / sqrtf(SRSRAN_PSS_NR_LEN);
-
-        // Update if the correlation is better than the current best
-        if (best_corr < corr) {
-          best_corr   = corr;
-          best_delay  = peak_idx + t_offset;
-          best_N_id_2 = N_id_2;
-          best_shift  = shift;
+    // Try each SSB candidate frequency
+    for (uint32_t i = 0; i < nof_res; i++) {
+      // Shift that moves the configured PSS sequences to the candidate frequency, its rounding error is part of the CFO
+      double base_offset_hz = res[i].ssb_freq_hz - q->cfg.ssb_freq_hz;
+      int    base_shift     = -(int)round(base_offset_hz / coarse_cfo_ref_hz);
+
+      // Try each N_id_2 sequence
+      for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2_NR; N_id_2++) {
+        // Steer coarse frequency offset
+        for (int shift = -shift_range; shift <= shift_range; shift += shift_coarse_inc) {
+          // Actual correlation in frequency domain
+          ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[N_id_2], q->tmp_corr, q->corr_sz, base_shift + shift);
+
+          // Convert to time domain
+          srsran_dft_run_guru_c(&q->ifft_corr);
+
+          // Find maximum
+          uint32_t peak_idx = srsran_vec_max_abs_ci(q->tmp_time, q->corr_window);
+
+          // Average power, take total power of the frequency domain signal after filtering, skip correlation window
+          // if value is invalid (0.0, nan or inf)
+          float avg_pwr_corr = srsran_vec_avg_power_cf(q->tmp_corr, q->corr_sz);
+          if (!isnormal(avg_pwr_corr)) {
+            continue;
+          }
+
+          // Normalise correlation
+          float corr = SRSRAN_CSQABS(q->tmp_time[peak_idx]) / avg_pwr_corr / sqrtf(SRSRAN_PSS_NR_LEN);
+
+          // Update if the correlation is better than the current best
+          if (res[i].corr < corr) {
+            res[i].corr          = corr;
+            res[i].t_offset      = peak_idx + t_offset;
+            res[i].N_id_2        = N_id_2;
+            res[i].coarse_cfo_hz = (float)(-(base_shift + shift) * coarse_cfo_ref_hz - base_offset_hz);
+          }
         }
       }
     }
@@ -936,21 +958,24 @@ static int ssb_pss_search(srsran_ssb_t* q,
     t_offset += q->corr_window;
   }
 
-  // From the best sequence correlate in frequency domain
-  {
+  // From the best sequence of each candidate correlate in frequency domain
+  for (uint32_t i = 0; i < nof_res; i++) {
+    double base_offset_hz = res[i].ssb_freq_hz - q->cfg.ssb_freq_hz;
+    int    base_shift     = -(int)round(base_offset_hz / coarse_cfo_ref_hz);
+
     // Reset best correlation
-    best_corr = 0.0f;
+    float best_corr = 0.0f;
 
     // Number of samples taken in this iteration
     uint32_t n = q->corr_sz;
 
     // Detect if the correlation input exceeds the input length, take the maximum amount of samples
-    if (best_delay + q->corr_sz > nof_samples) {
-      n = nof_samples - best_delay;
+    if (res[i].t_offset + q->corr_sz > nof_samples) {
+      n = nof_samples - res[i].t_offset;
     }
 
     // Copy the amount of samples
-    srsran_vec_cf_copy(q->tmp_time, &in[best_delay], n);
+    srsran_vec_cf_copy(q->tmp_time, &in[res[i].t_offset], n);
 
     // Append zeros if there is space left
     if (n < q->corr_sz) {
@@ -962,23 +987,78 @@ static int ssb_pss_search(srsran_ssb_t* q,
 
     for (int shift = -shift_range; shift <= shift_range; shift++) {
       // Actual correlation in frequency domain
-      ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[best_N_id_2], q->tmp_corr, q->corr_sz, shift);
+      ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[res[i].N_id_2], q->tmp_corr, q->corr_sz, base_shift + shift);
 
       // Calculate correlation assuming the peak is in the first sample
       float corr = SRSRAN_CSQABS(srsran_vec_acc_cc(q->tmp_corr, q->corr_sz));
 
       // Update if the correlation is better than the current best
       if (best_corr < corr) {
-        best_corr  = corr;
-        best_shift = shift;
+        best_corr            = corr;
+        res[i].coarse_cfo_hz = (float)(-(base_shift + shift) * coarse_cfo_ref_hz - base_offset_hz);
       }
     }
   }
 
+  return SRSRAN_SUCCESS;
+}
+
+static int ssb_pss_search(srsran_ssb_t* q,
+                          const cf_t*   in,
+                          uint32_t      nof_samples,
+                          uint32_t*     found_N_id_2,
+                          uint32_t*     found_delay,
+                          float*        coarse_cfo_hz)
+{
+  // Search only the configured SSB center frequency
+  srsran_ssb_pss_res_t res = {};
+  res.ssb_freq_hz          = q->cfg.ssb_freq_hz;
+  if (ssb_pss_search_multi(q, in, nof_samples, &res, 1) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   // Save findings
-  *found_delay   = best_delay;
-  *found_N_id_2  = best_N_id_2;
-  *coarse_cfo_hz = -(float)best_shift * coarse_cfo_ref_hz;
+  *found_delay   = res.t_offset;
+  *found_N_id_2  = res.N_id_2;
+  *coarse_cfo_hz = res.coarse_cfo_hz;
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_ssb_pss_search_multi(srsran_ssb_t*         q,
+                                const cf_t*           in,
+                                uint32_t              nof_samples,
+                                srsran_ssb_pss_res_t* res,
+                                uint32_t              nof_res)
+{
+  // Verify inputs
+  if (q == NULL || in == NULL || res == NULL || !isnormal(q->scs_hz)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!q->args.enable_search) {
+    ERROR("SSB is not configured for search");
+    return SRSRAN_ERROR;
+  }
+
+  // Make sure every candidate SSB fits in the base-band
+  double max_offset_hz = (q->cfg.srate_hz - SRSRAN_SSB_BW_SUBC * q->scs_hz) / 2.0;
+  for (uint32_t i = 0; i < nof_res; i++) {
+    if (fabs(res[i].ssb_freq_hz - q->cfg.center_freq_hz) > max_offset_hz) {
+      ERROR("SSB candidate %.3f MHz is outside the base-band", res[i].ssb_freq_hz / 1e6);
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+  }
+
+  if (ssb_pss_search_multi(q, in, nof_samples, res, nof_res) < SRSRAN_SUCCESS) {
+    ERROR("Error searching for N_id_2");
+    return SRSRAN_ERROR;
+  }
+
+  // Remove CP offset, as srsran_ssb_search() does
+  for (uint32_t i = 0; i < nof_res; i++) {
+    res[i].t_offset = (res[i].t_offset >= q->cp_sz) ? res[i].t_offset - q->cp_sz : 0;
+  }
 
   return SRSRAN_SUCCESS;
 }
@@ -300,6 +300,11 @@ int srsran_sync_set_N_id_2(srsran_sync_t* q, uint32_t N_id_2)
   }
 }
 
+void srsran_sync_set_N_id_2_search(srsran_sync_t* q, bool enable)
+{
+  q->N_id_2_search = enable;
+}
+
 static void generate_freq_sss(srsran_sync_t* q, uint32_t N_id_1)
 {
   float sf[2][SRSRAN_SSS_LEN];
@@ -393,6 +398,14 @@ void srsran_sync_set_pss_filt_enable(srsran_sync_t* q, bool enable)
   q->pss_filtering_enabled = enable;
 }
 
+void srsran_sync_set_pss_short_window_fft(srsran_sync_t* q, bool enable)
+{
+  srsran_pss_set_short_window_fft(&q->pss, enable);
+  for (int i = 0; i < 2; i++) {
+    srsran_pss_set_short_window_fft(&q->pss_i[i], enable);
+  }
+}
+
 void srsran_sync_set_cfo_cp_enable(srsran_sync_t* q, bool enable, uint32_t nof_symbols)
 {
   q->cfo_cp_enable   = enable;
@@ -636,7 +649,7 @@ srsran_sync_find(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, uint
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
-  if (input != NULL && srsran_N_id_2_isvalid(q->N_id_2) && fft_size_isvalid(q->fft_size)) {
+  if (input != NULL && (srsran_N_id_2_isvalid(q->N_id_2) || q->N_id_2_search) && fft_size_isvalid(q->fft_size)) {
     q->sss_detected = false;
 
     if (peak_position) {
@@ -645,6 +658,15 @@ srsran_sync_find(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, uint
 
     const cf_t* input_ptr = input;
 
+    /* The integer CFO stage correlates a single PSS sequence, so the N_id_2 is selected first on the input signal
+     */
+    if (q->N_id_2_search && q->cfo_i_enable) {
+      if (srsran_pss_find_pss_all(&q->pss, &input_ptr[find_offset], &q->N_id_2, NULL) < 0) {
+        ERROR("Error finding N_id_2");
+        return SRSRAN_ERROR;
+      }
+    }
+
     /* First CFO estimation stage is integer.
      * Finds max PSS correlation for shifted +1/0/-1 integer versions.
      * This should only used once N_id_2 is set
@@ -685,7 +707,14 @@ srsran_sync_find(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, uint
 
     /* Find maximum of PSS correlation. If Integer CFO is enabled, correlation is already done
      */
-    if (!q->cfo_i_enable) {
+    if (!q->cfo_i_enable && q->N_id_2_search) {
+      peak_pos = srsran_pss_find_pss_all(
+          &q->pss, &input_ptr[find_offset], &q->N_id_2, q->threshold > 0 ? &q->peak_value : NULL);
+      if (peak_pos < 0) {
+        ERROR("Error calling finding PSS sequence at : %d  ", peak_pos);
+        return SRSRAN_ERROR;
+      }
+    } else if (!q->cfo_i_enable) {
       srsran_pss_set_N_id_2(&q->pss, q->N_id_2);
       peak_pos = srsran_pss_find_pss(&q->pss, &input_ptr[find_offset], q->threshold > 0 ? &q->peak_value : NULL);
       if (peak_pos < 0) {
@@ -835,7 +864,7 @@ srsran_sync_find(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, uint
           q->threshold,
           15 * (srsran_sync_get_cfo(q)));
 
-  } else if (!srsran_N_id_2_isvalid(q->N_id_2)) {
+  } else if (!srsran_N_id_2_isvalid(q->N_id_2) && !q->N_id_2_search) {
     ERROR("Must call srsran_sync_set_N_id_2() first!");
   }
 
@@ -0,0 +1,272 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/sync/ssb.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <getopt.h>
+#include <stdlib.h>
+
+#define SSB_SEARCH_MULTI_TEST_PCI_STRIDE 37
+#define SSB_SEARCH_MULTI_TEST_RASTER_HZ 1.2e6
+#define SSB_SEARCH_MULTI_TEST_MAX_CAND 16
+
+// NR parameters
+static uint32_t                    carrier_nof_prb = 52;
+static srsran_subcarrier_spacing_t carrier_scs     = srsran_subcarrier_spacing_30kHz;
+static double                      carrier_freq_hz = 3.5e9;
+static srsran_subcarrier_spacing_t ssb_scs         = srsran_subcarrier_spacing_30kHz;
+static srsran_ssb_pattern_t        ssb_pattern     = SRSRAN_SSB_PATTERN_C;
+
+// Channel parameters
+static cf_t    wideband_gain = 1.0f + 0.5 * I;
+static int32_t delay_n       = 7;
+static float   cfo_hz        = 1000.0f;
+static float   n0_dB         = -10.0f;
+
+// Test context
+static srsran_random_t       random_gen = NULL;
+static srsran_channel_awgn_t awgn       = {};
+static double                srate_hz   = 0.0f; // Base-band sampling rate
+static uint32_t              hf_len     = 0;    // Half-frame length
+static cf_t*                 buffer     = NULL; // Base-band buffer
+
+// SSB candidate center frequencies in the base-band
+static srsran_ssb_pss_res_t cand[SSB_SEARCH_MULTI_TEST_MAX_CAND] = {};
+static uint32_t             nof_cand                             = 0;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [v]\n", prog);
+  printf("\t-s SSB subcarrier spacing [default, %s kHz]\n", srsran_subcarrier_spacing_to_str(ssb_scs));
+  printf("\t-S cell/carrier subcarrier spacing [default, %s kHz]\n", srsran_subcarrier_spacing_to_str(carrier_scs));
+  printf("\t-P SSB pattern [default, %s]\n", srsran_ssb_pattern_to_str(ssb_pattern));
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "sSPv")) != -1) {
+    switch (opt) {
+      case 's':
+        ssb_scs = srsran_subcarrier_spacing_from_str(argv[optind]);
+        if (ssb_scs == srsran_subcarrier_spacing_invalid) {
+          ERROR("Invalid SSB subcarrier spacing %s\n", argv[optind]);
+          exit(-1);
+        }
+        break;
+      case 'S':
+        carrier_scs = srsran_subcarrier_spacing_from_str(argv[optind]);
+        if (carrier_scs == srsran_subcarrier_spacing_invalid) {
+          ERROR("Invalid Cell/Carrier subcarrier spacing %s\n", argv[optind]);
+          exit(-1);
+        }
+        break;
+      case 'P':
+        ssb_pattern = srsran_ssb_pattern_fom_str(argv[optind]);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static void run_channel()
+{
+  // Delay
+  for (uint32_t i = 0; i < hf_len; i++) {
+    buffer[i] = buffer[(i + delay_n) % hf_len];
+  }
+
+  // CFO
+  srsran_vec_apply_cfo(buffer, -cfo_hz / srate_hz, buffer, hf_len);
+
+  // AWGN
+  srsran_channel_awgn_run_c(&awgn, buffer, buffer, hf_len);
+
+  // Wideband gain
+  srsran_vec_sc_prod_ccc(buffer, wideband_gain, buffer, hf_len);
+}
+
+static void gen_pbch_msg(srsran_pbch_msg_nr_t* pbch_msg, uint32_t ssb_idx)
+{
+  // Default all to zero
+  SRSRAN_MEM_ZERO(pbch_msg, srsran_pbch_msg_nr_t, 1);
+
+  // Generate payload
+  srsran_random_bit_vector(random_gen, pbch_msg->payload, SRSRAN_PBCH_MSG_NR_SZ);
+
+  pbch_msg->ssb_idx = ssb_idx;
+  pbch_msg->crc     = true;
+}
+
+static int set_ssb_freq(srsran_ssb_t* ssb, double ssb_freq_hz)
+{
+  srsran_ssb_cfg_t ssb_cfg = {};
+  ssb_cfg.srate_hz         = srate_hz;
+  ssb_cfg.center_freq_hz   = carrier_freq_hz;
+  ssb_cfg.ssb_freq_hz      = ssb_freq_hz;
+  ssb_cfg.scs              = ssb_scs;
+  ssb_cfg.pattern          = ssb_pattern;
+
+  return srsran_ssb_set_cfg(ssb, &ssb_cfg);
+}
+
+static void init_candidates()
+{
+  // Every raster point whose SSB fits in the base-band
+  double ssb_bw_hz     = SRSRAN_SSB_BW_SUBC * SRSRAN_SUBC_SPACING_NR(ssb_scs);
+  double max_offset_hz = (srate_hz - ssb_bw_hz) / 2.0;
+  int    max_k         = (int)floor(max_offset_hz / SSB_SEARCH_MULTI_TEST_RASTER_HZ);
+  for (int k = -max_k; k <= max_k && nof_cand < SSB_SEARCH_MULTI_TEST_MAX_CAND; k++) {
+    cand[nof_cand++].ssb_freq_hz = carrier_freq_hz + k * SSB_SEARCH_MULTI_TEST_RASTER_HZ;
+  }
+}
+
+static int test_case(srsran_ssb_t* ssb_tx, srsran_ssb_t* ssb_rx)
+{
+  uint64_t t_search_usec = 0;
+  uint32_t count         = 0;
+
+  for (uint32_t i = 0; i < nof_cand; i++) {
+    for (uint32_t pci = i; pci < SRSRAN_NOF_NID_NR; pci += SSB_SEARCH_MULTI_TEST_PCI_STRIDE * nof_cand, count++) {
+      struct timeval t[3] = {};
+
+      // Transmit the SSB at the selected candidate frequency
+      TESTASSERT(set_ssb_freq(ssb_tx, cand[i].ssb_freq_hz) == SRSRAN_SUCCESS);
+      srsran_pbch_msg_nr_t pbch_msg_tx = {};
+      gen_pbch_msg(&pbch_msg_tx, pci % ssb_tx->Lmax);
+      srsran_vec_cf_zero(buffer, hf_len);
+      TESTASSERT(srsran_ssb_add(ssb_tx, pci, &pbch_msg_tx, buffer, buffer) == SRSRAN_SUCCESS);
+      run_channel();
+
+      // Correlate all the candidates with the receiver SSB centered in the base-band
+      TESTASSERT(set_ssb_freq(ssb_rx, carrier_freq_hz) == SRSRAN_SUCCESS);
+      gettimeofday(&t[1], NULL);
+      TESTASSERT(srsran_ssb_pss_search_multi(ssb_rx, buffer, hf_len, cand, nof_cand) == SRSRAN_SUCCESS);
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      t_search_usec += t[0].tv_usec + t[0].tv_sec * 1000000UL;
+
+      // The transmitted candidate must be the strongest and carry the right PSS
+      uint32_t best = 0;
+      for (uint32_t j = 1; j < nof_cand; j++) {
+        if (cand[j].corr > cand[best].corr) {
+          best = j;
+        }
+      }
+      INFO("test_case - pci=%d freq=%.3f MHz found=%.3f MHz corr=%.2f cfo=%+.1f Hz",
+           pci,
+           cand[i].ssb_freq_hz / 1e6,
+           cand[best].ssb_freq_hz / 1e6,
+           cand[best].corr,
+           cand[best].coarse_cfo_hz);
+      TESTASSERT(best == i);
+      TESTASSERT(cand[best].N_id_2 == SRSRAN_NID_2_NR(pci));
+      TESTASSERT(fabs(cand[best].coarse_cfo_hz + cfo_hz) <= ssb_rx->cfg.srate_hz / ssb_rx->corr_sz);
+
+      // Decode the PBCH at the found frequency
+      TESTASSERT(set_ssb_freq(ssb_rx, cand[best].ssb_freq_hz) == SRSRAN_SUCCESS);
+      srsran_ssb_search_res_t res = {};
+      TESTASSERT(srsran_ssb_search(ssb_rx, buffer, hf_len, &res) == SRSRAN_SUCCESS);
+      TESTASSERT(res.pbch_msg.crc);
+      TESTASSERT(res.N_id == pci);
+      TESTASSERT(memcmp(&res.pbch_msg, &pbch_msg_tx, sizeof(srsran_pbch_msg_nr_t)) == 0);
+    }
+  }
+
+  if (!count) {
+    ERROR("Error in test case: undefined division");
+    return SRSRAN_ERROR;
+  }
+
+  INFO("test_case - %d candidates; %.1f usec/search;", nof_cand, (double)t_search_usec / (double)(count));
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+  parse_args(argc, argv);
+
+  random_gen = srsran_random_init(1234);
+  srate_hz   = (double)SRSRAN_SUBC_SPACING_NR(carrier_scs) * srsran_min_symbol_sz_rb(carrier_nof_prb);
+  hf_len     = (uint32_t)ceil(srate_hz * (5.0 / 1000.0));
+  buffer     = srsran_vec_cf_malloc(hf_len);
+  init_candidates();
+
+  srsran_ssb_t      ssb_tx   = {};
+  srsran_ssb_t      ssb_rx   = {};
+  srsran_ssb_args_t ssb_args = {};
+  ssb_args.enable_encode     = true;
+  ssb_args.enable_decode     = true;
+  ssb_args.enable_search     = true;
+
+  if (buffer == NULL) {
+    ERROR("Malloc");
+    goto clean_exit;
+  }
+
+  if (srsran_channel_awgn_init(&awgn, 0x0) < SRSRAN_SUCCESS) {
+    ERROR("AWGN");
+    goto clean_exit;
+  }
+
+  if (srsran_channel_awgn_set_n0(&awgn, n0_dB) < SRSRAN_SUCCESS) {
+    ERROR("AWGN");
+    goto clean_exit;
+  }
+
+  if (srsran_ssb_init(&ssb_tx, &ssb_args) < SRSRAN_SUCCESS || srsran_ssb_init(&ssb_rx, &ssb_args) < SRSRAN_SUCCESS) {
+    ERROR("Init");
+    goto clean_exit;
+  }
+
+  if (test_case(&ssb_tx, &ssb_rx) != SRSRAN_SUCCESS) {
+    ERROR("test case failed");
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(random_gen);
+  srsran_ssb_free(&ssb_tx);
+  srsran_ssb_free(&ssb_rx);
+
+  srsran_channel_awgn_free(&awgn);
+
+  if (buffer) {
+    free(buffer);
+  }
+
+  return ret;
+}
@@ -34,23 +34,28 @@
 int         cell_id = -1, offset = 0;
 srsran_cp_t cp      = SRSRAN_CP_NORM;
 uint32_t    nof_prb = 6;
+bool        search_N_id_2 = false;
+uint32_t    track_window  = 0;
 
 #define FLEN SRSRAN_SF_LEN(fft_size)
 
 void usage(char* prog)
 {
-  printf("Usage: %s [cpoev]\n", prog);
+  printf("Usage: %s [cpoestv]\n", prog);
   printf("\t-c cell_id [Default check for all]\n");
   printf("\t-p nof_prb [Default %d]\n", nof_prb);
   printf("\t-o offset [Default %d]\n", offset);
   printf("\t-e extended CP [Default normal]\n");
+  printf("\t-s search the N_id_2 instead of setting it [Default %s]\n", search_N_id_2 ? "yes" : "no");
+  printf("\t-t track window, searches the PSS through the DFT around its expected position [Default %d]\n",
+         track_window);
   printf("\t-v srsran_verbose\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "cpoev")) != -1) {
+  while ((opt = getopt(argc, argv, "cpoestv")) != -1) {
     switch (opt) {
       case 'c':
         cell_id = (int)strtol(argv[optind], NULL, 10);
@@ -64,6 +69,12 @@ void parse_args(int argc, char** argv)
       case 'e':
         cp = SRSRAN_CP_EXT;
         break;
+      case 's':
+        search_N_id_2 = true;
+        break;
+      case 't':
+        track_window = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -112,7 +123,7 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
-  if (srsran_sync_init(&syncobj, FLEN, FLEN, fft_size)) {
+  if (srsran_sync_init(&syncobj, FLEN, track_window ? track_window : FLEN, fft_size)) {
     ERROR("Error initiating PSS/SSS");
     return -1;
   }
@@ -122,6 +133,17 @@ int main(int argc, char** argv)
   /* Set a very high threshold to make sure the correlation is ok */
   srsran_sync_set_threshold(&syncobj, 5.0);
   srsran_sync_set_sss_algorithm(&syncobj, SSS_PARTIAL_3);
+  if (search_N_id_2) {
+    srsran_sync_set_em_alpha(&syncobj, 1);
+    srsran_sync_set_N_id_2_search(&syncobj, true);
+  }
+  srsran_sync_set_pss_short_window_fft(&syncobj, track_window > 0);
+
+  // The tracking window is centered on the expected PSS peak
+  uint32_t find_offset = 0;
+  if (track_window) {
+    find_offset = offset + FLEN / 2 - fft_size - track_window / 2;
+  }
 
   if (cell_id == -1) {
     cid     = 0;
@@ -137,7 +159,9 @@ int main(int argc, char** argv)
     srsran_pss_generate(pss_signal, N_id_2);
     srsran_sss_generate(sss_signal0, sss_signal5, cid);
 
-    srsran_sync_set_N_id_2(&syncobj, N_id_2);
+    if (!search_N_id_2) {
+      srsran_sync_set_N_id_2(&syncobj, N_id_2);
+    }
 
     // SF1 is SF5
     for (sf_idx = 0; sf_idx < 2; sf_idx++) {
@@ -155,10 +179,13 @@ int main(int argc, char** argv)
       }
       srsran_vec_cf_zero(fft_buffer, offset);
 
-      if (srsran_sync_find(&syncobj, fft_buffer, 0, &find_idx) < 0) {
+      srsran_sync_find_ret_t find_ret = srsran_sync_find(&syncobj, fft_buffer, find_offset, &find_idx);
+      if (find_ret < 0) {
         ERROR("Error running srsran_sync_find");
         exit(-1);
       }
+      // The peak position is relative to the start of the search
+      find_idx += find_offset;
       find_sf = srsran_sync_get_sf_idx(&syncobj);
       printf("cell_id: %d find: %d, offset: %d, ns=%d find_ns=%d\n", cid, find_idx, offset, sf_idx, find_sf);
       if (find_idx != offset + FLEN / 2) {
@@ -169,6 +196,10 @@ int main(int argc, char** argv)
         printf("ns != find_ns\n");
         exit(-1);
       }
+      if (find_ret == SRSRAN_SYNC_FOUND && srsran_sync_get_cell_id(&syncobj) != cid) {
+        printf("cell_id != find_cell_id: %d != %d\n", cid, srsran_sync_get_cell_id(&syncobj));
+        exit(-1);
+      }
       if (srsran_sync_get_cp(&syncobj) != cp) {
         printf("Detected CP should be %s\n", SRSRAN_CP_ISNORM(cp) ? "Normal" : "Extended");
         exit(-1);
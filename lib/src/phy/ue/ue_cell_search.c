@@ -194,7 +194,10 @@ void srsran_set_detect_cp(srsran_ue_cellsearch_t* q, bool enable)
 }
 
 /* Decide the most likely cell based on the mode */
-static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, srsran_ue_cellsearch_result_t* found_cell)
+static void get_cell(srsran_ue_cellsearch_t*              q,
+                     const srsran_ue_cellsearch_result_t* candidates,
+                     uint32_t                             nof_detected_frames,
+                     srsran_ue_cellsearch_result_t*       found_cell)
 {
   uint32_t i, j;
 
@@ -205,7 +208,7 @@ static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, sr
   for (i = 0; i < nof_detected_frames; i++) {
     uint32_t cnt = 1;
     for (j = i + 1; j < nof_detected_frames; j++) {
-      if (q->candidates[j].cell_id == q->candidates[i].cell_id && !q->mode_counted[j]) {
+      if (candidates[j].cell_id == candidates[i].cell_id && !q->mode_counted[j]) {
         q->mode_counted[j] = 1;
         cnt++;
       }
@@ -219,22 +222,22 @@ static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, sr
       mode_pos  = i;
     }
   }
-  found_cell->cell_id = q->candidates[mode_pos].cell_id;
+  found_cell->cell_id = candidates[mode_pos].cell_id;
   /* Now in all these cell IDs, find most frequent CP and duplex mode */
   uint32_t nof_normal = 0;
   uint32_t nof_fdd    = 0;
   found_cell->peak    = 0;
   for (i = 0; i < nof_detected_frames; i++) {
-    if (q->candidates[i].cell_id == found_cell->cell_id) {
-      if (SRSRAN_CP_ISNORM(q->candidates[i].cp)) {
+    if (candidates[i].cell_id == found_cell->cell_id) {
+      if (SRSRAN_CP_ISNORM(candidates[i].cp)) {
         nof_normal++;
       }
-      if (q->candidates[i].frame_type == SRSRAN_FDD) {
+      if (candidates[i].frame_type == SRSRAN_FDD) {
         nof_fdd++;
       }
     }
     // average absolute peak value
-    found_cell->peak += q->candidates[i].peak;
+    found_cell->peak += candidates[i].peak;
   }
   found_cell->peak /= nof_detected_frames;
 
@@ -251,10 +254,10 @@ static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, sr
   found_cell->mode = (float)q->mode_ntimes[mode_pos] / nof_detected_frames;
 
   // PSR is already averaged so take the last value
-  found_cell->psr = q->candidates[nof_detected_frames - 1].psr;
+  found_cell->psr = candidates[nof_detected_frames - 1].psr;
 
   // CFO is also already averaged
-  found_cell->cfo = q->candidates[nof_detected_frames - 1].cfo;
+  found_cell->cfo = candidates[nof_detected_frames - 1].cfo;
 }
 
 /** Finds up to 3 cells, one per each N_id_2=0,1,2 and stores ID and CP in the structure pointed by found_cell.
@@ -288,6 +291,63 @@ int srsran_ue_cellsearch_scan(srsran_ue_cellsearch_t*       q,
   return nof_detected_cells;
 }
 
+/* Receives up to max_frames frames in find state and stores the detected cells in q->candidates.
+ * Returns the number of frames where a cell was detected or a negative number if error
+ */
+static int scan_frames(srsran_ue_cellsearch_t* q)
+{
+  int      ret                 = SRSRAN_SUCCESS;
+  uint32_t nof_detected_frames = 0;
+  uint32_t nof_scanned_frames  = 0;
+
+  bzero(q->candidates, sizeof(srsran_ue_cellsearch_result_t) * q->max_frames);
+  bzero(q->mode_ntimes, sizeof(uint32_t) * q->max_frames);
+  bzero(q->mode_counted, sizeof(uint8_t) * q->max_frames);
+
+  srsran_ue_sync_reset(&q->ue_sync);
+  srsran_ue_sync_cfo_reset(&q->ue_sync, 0.0f);
+  srsran_ue_sync_set_nof_find_frames(&q->ue_sync, q->max_frames);
+
+  do {
+    ret = srsran_ue_sync_zerocopy(&q->ue_sync, q->sf_buffer, CELL_SEARCH_BUFFER_MAX_SAMPLES);
+    if (ret < 0) {
+      ERROR("Error calling srsran_ue_sync_work()");
+      return -1;
+    } else if (ret == 1) {
+      /* This means a peak was found in find state */
+      ret = srsran_sync_get_cell_id(&q->ue_sync.sfind);
+      if (ret >= 0) {
+        /* Save cell id, cp and peak */
+        q->candidates[nof_detected_frames].cell_id    = (uint32_t)ret;
+        q->candidates[nof_detected_frames].cp         = srsran_sync_get_cp(&q->ue_sync.sfind);
+        q->candidates[nof_detected_frames].peak       = q->ue_sync.sfind.pss.peak_value;
+        q->candidates[nof_detected_frames].psr        = srsran_sync_get_peak_value(&q->ue_sync.sfind);
+        q->candidates[nof_detected_frames].cfo        = 15000 * srsran_sync_get_cfo(&q->ue_sync.sfind);
+        q->candidates[nof_detected_frames].frame_type = srsran_ue_sync_get_frame_type(&q->ue_sync);
+        INFO("CELL SEARCH: [%d/%d/%d]: Found peak PSR=%.3f, Cell_id: %d CP: %s, CFO=%.1f KHz",
+             nof_detected_frames,
+             nof_scanned_frames,
+             q->nof_valid_frames,
+             q->candidates[nof_detected_frames].psr,
+             q->candidates[nof_detected_frames].cell_id,
+             srsran_cp_string(q->candidates[nof_detected_frames].cp),
+             q->candidates[nof_detected_frames].cfo / 1000);
+
+        nof_detected_frames++;
+      }
+    } else if (ret == 0) {
+      /* This means a peak is not yet found and ue_sync is in find state
+       * Do nothing, just wait and increase nof_scanned_frames counter.
+       */
+    }
+
+    nof_scanned_frames++;
+
+  } while (nof_scanned_frames < q->max_frames && nof_detected_frames < q->nof_valid_frames);
+
+  return (int)nof_detected_frames;
+}
+
 /** Finds a cell for a given N_id_2 and stores ID and CP in the structure pointed by found_cell.
  * Returns 1 if the cell is found, 0 if not or -1 on error
  */
@@ -295,65 +355,22 @@ int srsran_ue_cellsearch_scan_N_id_2(srsran_ue_cellsearch_t*        q,
                                      uint32_t                       N_id_2,
                                      srsran_ue_cellsearch_result_t* found_cell)
 {
-  int      ret                 = SRSRAN_ERROR_INVALID_INPUTS;
-  uint32_t nof_detected_frames = 0;
-  uint32_t nof_scanned_frames  = 0;
+  int ret = SRSRAN_ERROR_INVALID_INPUTS;
 
   if (q != NULL) {
-    ret = SRSRAN_SUCCESS;
-
-    bzero(q->candidates, sizeof(srsran_ue_cellsearch_result_t) * q->max_frames);
-    bzero(q->mode_ntimes, sizeof(uint32_t) * q->max_frames);
-    bzero(q->mode_counted, sizeof(uint8_t) * q->max_frames);
-
     srsran_ue_sync_set_N_id_2(&q->ue_sync, N_id_2);
-    srsran_ue_sync_reset(&q->ue_sync);
-    srsran_ue_sync_cfo_reset(&q->ue_sync, 0.0f);
-    srsran_ue_sync_set_nof_find_frames(&q->ue_sync, q->max_frames);
-
-    do {
-      ret = srsran_ue_sync_zerocopy(&q->ue_sync, q->sf_buffer, CELL_SEARCH_BUFFER_MAX_SAMPLES);
-      if (ret < 0) {
-        ERROR("Error calling srsran_ue_sync_work()");
-        return -1;
-      } else if (ret == 1) {
-        /* This means a peak was found in find state */
-        ret = srsran_sync_get_cell_id(&q->ue_sync.sfind);
-        if (ret >= 0) {
-          /* Save cell id, cp and peak */
-          q->candidates[nof_detected_frames].cell_id    = (uint32_t)ret;
-          q->candidates[nof_detected_frames].cp         = srsran_sync_get_cp(&q->ue_sync.sfind);
-          q->candidates[nof_detected_frames].peak       = q->ue_sync.sfind.pss.peak_value;
-          q->candidates[nof_detected_frames].psr        = srsran_sync_get_peak_value(&q->ue_sync.sfind);
-          q->candidates[nof_detected_frames].cfo        = 15000 * srsran_sync_get_cfo(&q->ue_sync.sfind);
-          q->candidates[nof_detected_frames].frame_type = srsran_ue_sync_get_frame_type(&q->ue_sync);
-          INFO("CELL SEARCH: [%d/%d/%d]: Found peak PSR=%.3f, Cell_id: %d CP: %s, CFO=%.1f KHz",
-               nof_detected_frames,
-               nof_scanned_frames,
-               q->nof_valid_frames,
-               q->candidates[nof_detected_frames].psr,
-               q->candidates[nof_detected_frames].cell_id,
-               srsran_cp_string(q->candidates[nof_detected_frames].cp),
-               q->candidates[nof_detected_frames].cfo / 1000);
-
-          nof_detected_frames++;
-        }
-      } else if (ret == 0) {
-        /* This means a peak is not yet found and ue_sync is in find state
-         * Do nothing, just wait and increase nof_scanned_frames counter.
-         */
-      }
-
-      nof_scanned_frames++;
 
-    } while (nof_scanned_frames < q->max_frames && nof_detected_frames < q->nof_valid_frames);
+    ret = scan_frames(q);
+    if (ret < 0) {
+      return ret;
+    }
 
     /* In either case, check if the mean PSR is above the minimum threshold */
-    if (nof_detected_frames > 0) {
-      ret = 1; // A cell has been found.
+    if (ret > 0) {
       if (found_cell) {
-        get_cell(q, nof_detected_frames, found_cell);
+        get_cell(q, q->candidates, (uint32_t)ret, found_cell);
       }
+      ret = 1; // A cell has been found.
     } else {
       ret = 0; // A cell was not found.
     }
@@ -361,3 +378,57 @@ int srsran_ue_cellsearch_scan_N_id_2(srsran_ue_cellsearch_t*        q,
 
   return ret;
 }
+
+/** Same as srsran_ue_cellsearch_scan() but the three N_id_2 are searched on the same frames: each received frame is
+ * correlated once with the three PSS sequences and the SSS is detected for the most likely one. The scan takes a
+ * third of the frames, but only the strongest cell of each frame is detected.
+ * Returns the number of found cells or a negative number if error
+ */
+int srsran_ue_cellsearch_scan_all(srsran_ue_cellsearch_t*       q,
+                                  srsran_ue_cellsearch_result_t found_cells[3],
+                                  uint32_t*                     max_N_id_2)
+{
+  if (q == NULL || found_cells == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  INFO("CELL SEARCH: Starting scan for all N_id_2");
+  srsran_sync_set_N_id_2_search(&q->ue_sync.sfind, true);
+  int nof_detected_frames = scan_frames(q);
+  srsran_sync_set_N_id_2_search(&q->ue_sync.sfind, false);
+  if (nof_detected_frames < 0) {
+    ERROR("Error searching cell");
+    return nof_detected_frames;
+  }
+
+  // Group the candidates by N_id_2, keeping their order
+  uint32_t group_start[SRSRAN_NOF_NID_2 + 1] = {};
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    uint32_t n = group_start[N_id_2];
+    for (uint32_t i = n; i < (uint32_t)nof_detected_frames; i++) {
+      if (q->candidates[i].cell_id % SRSRAN_NOF_NID_2 == N_id_2) {
+        srsran_ue_cellsearch_result_t tmp = q->candidates[i];
+        memmove(&q->candidates[n + 1], &q->candidates[n], sizeof(srsran_ue_cellsearch_result_t) * (i - n));
+        q->candidates[n++] = tmp;
+      }
+    }
+    group_start[N_id_2 + 1] = n;
+  }
+
+  uint32_t nof_detected_cells = 0;
+  float    max_peak_value     = -1.0;
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    uint32_t nof_frames = group_start[N_id_2 + 1] - group_start[N_id_2];
+    bzero(&found_cells[N_id_2], sizeof(srsran_ue_cellsearch_result_t));
+    if (nof_frames == 0) {
+      continue;
+    }
+    get_cell(q, &q->candidates[group_start[N_id_2]], nof_frames, &found_cells[N_id_2]);
+    nof_detected_cells++;
+    if (max_N_id_2 && found_cells[N_id_2].peak > max_peak_value) {
+      max_peak_value = found_cells[N_id_2].peak;
+      *max_N_id_2    = N_id_2;
+    }
+  }
+  return nof_detected_cells;
+}
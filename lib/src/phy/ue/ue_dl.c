@@ -260,11 +260,25 @@ void srsran_ue_dl_set_non_mbsfn_region(srsran_ue_dl_t* q, uint8_t non_mbsfn_regi
   srsran_ofdm_set_non_mbsfn_region(&q->fft_mbsfn, non_mbsfn_region_length);
 }
 
+void srsran_ue_dl_set_rx_cfo(srsran_ue_dl_t* q, float cfo_hz)
+{
+  // Same normalisation as the UE sync correction, the CFO is negated and normalised by the sampling rate
+  for (int i = 0; i < q->nof_rx_antennas; i++) {
+    srsran_ofdm_set_rx_cfo(&q->fft[i], -cfo_hz / (15000.0f * (float)q->fft[i].cfg.symbol_sz));
+  }
+  srsran_ofdm_set_rx_cfo(&q->fft_mbsfn, -cfo_hz / (15000.0f * (float)q->fft_mbsfn.cfg.symbol_sz));
+}
+
 void srsran_ue_dl_set_mi_auto(srsran_ue_dl_t* q)
 {
   q->mi_auto = true;
 }
 
+void srsran_ue_dl_reset_pdcch_stats(srsran_ue_dl_t* q)
+{
+  SRSRAN_MEM_ZERO(&q->pdcch_stats, srsran_ue_dl_pdcch_stats_t, 1);
+}
+
 void srsran_ue_dl_set_mi_manual(srsran_ue_dl_t* q, uint32_t mi_idx)
 {
   q->mi_auto         = false;
@@ -312,7 +326,10 @@ static void set_mi_value(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl
   }
 }
 
-static int estimate_pdcch_pcfich(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl_cfg_t* cfg)
+static int estimate_pdcch_pcfich(srsran_ue_dl_t*        q,
+                                 srsran_dl_sf_cfg_t*    sf,
+                                 srsran_ue_dl_cfg_t*    cfg,
+                                 srsran_chest_dl_cfg_t* chest_cfg)
 {
   if (q) {
     float cfi_corr = 0;
@@ -320,7 +337,7 @@ static int estimate_pdcch_pcfich(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsr
     set_mi_value(q, sf, cfg);
 
     /* Get channel estimates for each port */
-    srsran_chest_dl_estimate_cfg(&q->chest, sf, &cfg->chest_cfg, q->sf_symbols, &q->chest_res);
+    srsran_chest_dl_estimate_cfg(&q->chest, sf, chest_cfg, q->sf_symbols, &q->chest_res);
 
     /* First decode PCFICH and obtain CFI */
     if (srsran_pcfich_decode(&q->pcfich, sf, &q->chest_res, q->sf_symbols, &cfi_corr) < 0) {
@@ -357,12 +374,65 @@ int srsran_ue_dl_decode_fft_estimate(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf,
         srsran_ofdm_rx_sf(&q->fft[j]);
       }
     }
-    return estimate_pdcch_pcfich(q, sf, cfg);
+    q->ctrl_region_only = false;
+    return estimate_pdcch_pcfich(q, sf, cfg, &cfg->chest_cfg);
   } else {
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 }
 
+int srsran_ue_dl_decode_fft_estimate_ctrl(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl_cfg_t* cfg)
+{
+  if (q == NULL || sf == NULL || cfg == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // The CFO estimate and the RI/PMI selection need the CRS of the whole subframe
+  bool cfo_sf = cfg->chest_cfg.cfo_estimate_enable && ((1U << (sf->tti % 10)) & cfg->chest_cfg.cfo_estimate_sf_mask);
+  bool ri_pmi = cfg->cfg.tm == SRSRAN_TM3 || cfg->cfg.tm == SRSRAN_TM4;
+  if (sf->sf_type == SRSRAN_SF_MBSFN || cfo_sf || ri_pmi) {
+    return srsran_ue_dl_decode_fft_estimate(q, sf, cfg);
+  }
+
+  /* Run FFT for the control region symbols only */
+  for (int j = 0; j < q->nof_rx_antennas; j++) {
+    if (srsran_ofdm_rx_sf_symbols(&q->fft[j], 0, SRSRAN_CHEST_DL_CTRL_NOF_SYMBOLS(q->cell.cp)) < SRSRAN_SUCCESS) {
+      ERROR("Error demodulating the control region");
+      return SRSRAN_ERROR;
+    }
+  }
+  q->ctrl_region_only = true;
+
+  srsran_chest_dl_cfg_t chest_cfg = cfg->chest_cfg;
+  chest_cfg.ctrl_region_only      = true;
+  return estimate_pdcch_pcfich(q, sf, cfg, &chest_cfg);
+}
+
+int srsran_ue_dl_decode_fft_estimate_data(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl_cfg_t* cfg)
+{
+  if (q == NULL || sf == NULL || cfg == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!q->ctrl_region_only) {
+    return SRSRAN_SUCCESS;
+  }
+
+  /* Run FFT for the symbols after the control region */
+  uint32_t first_symbol = SRSRAN_CHEST_DL_CTRL_NOF_SYMBOLS(q->cell.cp);
+  uint32_t nof_symbols  = SRSRAN_CP_NSYMB(q->cell.cp) * SRSRAN_NOF_SLOTS_PER_SF - first_symbol;
+  for (int j = 0; j < q->nof_rx_antennas; j++) {
+    if (srsran_ofdm_rx_sf_symbols(&q->fft[j], first_symbol, nof_symbols) < SRSRAN_SUCCESS) {
+      ERROR("Error demodulating the data region");
+      return SRSRAN_ERROR;
+    }
+  }
+  q->ctrl_region_only = false;
+
+  /* Get channel estimates of the whole subframe, the control region ones are replaced too */
+  return srsran_chest_dl_estimate_cfg(&q->chest, sf, &cfg->chest_cfg, q->sf_symbols, &q->chest_res);
+}
+
 int srsran_ue_dl_decode_fft_estimate_noguru(srsran_ue_dl_t*     q,
                                             srsran_dl_sf_cfg_t* sf,
                                             srsran_ue_dl_cfg_t* cfg,
@@ -377,7 +447,8 @@ int srsran_ue_dl_decode_fft_estimate_noguru(srsran_ue_dl_t*     q,
         srsran_ofdm_rx_sf_ng(&q->fft[j], input[j], q->sf_symbols[j]);
       }
     }
-    return estimate_pdcch_pcfich(q, sf, cfg);
+    q->ctrl_region_only = false;
+    return estimate_pdcch_pcfich(q, sf, cfg, &cfg->chest_cfg);
   } else {
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
@@ -413,17 +484,75 @@ static bool dci_location_is_allocated(srsran_ue_dl_t* q, srsran_dci_location_t n
   return false;
 }
 
+/* Computes the order in which the search space locations are decoded. If the pre-screening is enabled, the locations
+ * are sorted from the highest LLR energy to the lowest one and the ones below prescreen_ratio times the highest energy
+ * are discarded. Returns the number of locations to decode */
+static uint32_t dci_prescreen_locations(srsran_ue_dl_t*     q,
+                                        srsran_dl_sf_cfg_t* sf,
+                                        dci_blind_search_t* search_space,
+                                        float               prescreen_ratio,
+                                        uint32_t            order[SRSRAN_MAX_CANDIDATES])
+{
+  uint32_t nof_locations = SRSRAN_MIN(search_space->nof_locations, SRSRAN_MAX_CANDIDATES);
+  float    energy[SRSRAN_MAX_CANDIDATES];
+  float    max_energy = 0.0f;
+
+  if (!isnormal(prescreen_ratio) || prescreen_ratio < 0.0f) {
+    for (uint32_t l = 0; l < nof_locations; l++) {
+      order[l] = l;
+    }
+    return nof_locations;
+  }
+
+  for (uint32_t l = 0; l < nof_locations; l++) {
+    energy[l]  = srsran_pdcch_candidate_energy(&q->pdcch, sf, &search_space->loc[l]);
+    max_energy = SRSRAN_MAX(max_energy, energy[l]);
+  }
+
+  uint32_t count = 0;
+  for (uint32_t l = 0; l < nof_locations; l++) {
+    // Invalid locations are kept, the decoder reports them
+    if (energy[l] >= 0.0f && energy[l] < prescreen_ratio * max_energy) {
+      INFO("Skipping location L=%d, ncce=%d. Energy %.2f below %.2f",
+           search_space->loc[l].L,
+           search_space->loc[l].ncce,
+           energy[l],
+           prescreen_ratio * max_energy);
+      q->pdcch_stats.nof_skipped += search_space->nof_formats;
+      continue;
+    }
+
+    // Insert keeping the order of the search space for equal energies
+    uint32_t i = count;
+    while (i > 0 && energy[order[i - 1]] < energy[l]) {
+      order[i] = order[i - 1];
+      i--;
+    }
+    order[i] = l;
+    count++;
+  }
+
+  return count;
+}
+
 static int dci_blind_search(srsran_ue_dl_t*     q,
                             srsran_dl_sf_cfg_t* sf,
                             uint16_t            rnti,
                             dci_blind_search_t* search_space,
                             srsran_dci_cfg_t*   dci_cfg,
                             srsran_dci_msg_t    dci_msg[SRSRAN_MAX_DCI_MSG],
-                            bool                search_in_common)
+                            bool                search_in_common,
+                            float               prescreen_ratio)
 {
   uint32_t nof_dci = 0;
   if (rnti) {
-    for (int l = 0; l < search_space->nof_locations; l++) {
+    uint32_t order[SRSRAN_MAX_CANDIDATES];
+    uint32_t nof_locations = dci_prescreen_locations(q, sf, search_space, prescreen_ratio, order);
+
+    q->pdcch_stats.nof_candidates += search_space->nof_locations * search_space->nof_formats;
+
+    for (uint32_t i = 0; i < nof_locations; i++) {
+      uint32_t l = order[i];
       if (nof_dci >= SRSRAN_MAX_DCI_MSG) {
         ERROR("Can't store more DCIs in buffer");
         return nof_dci;
@@ -444,6 +573,7 @@ static int dci_blind_search(srsran_ue_dl_t*     q,
         dci_msg[nof_dci].location = search_space->loc[l];
         dci_msg[nof_dci].format   = search_space->formats[f];
         dci_msg[nof_dci].rnti     = 0;
+        q->pdcch_stats.nof_decoded++;
         if (srsran_pdcch_decode_msg(&q->pdcch, sf, dci_cfg, &dci_msg[nof_dci])) {
           ERROR("Error decoding DCI msg");
           return SRSRAN_ERROR;
@@ -562,7 +692,8 @@ static int find_dci_ss(srsran_ue_dl_t*            q,
        is_ue ? "ue" : "common",
        dci_cfg.multiple_csi_request_enabled);
 
-  return dci_blind_search(q, sf, rnti, &search_space, &dci_cfg, dci_msg, cfg->cfg.dci_common_ss);
+  return dci_blind_search(
+      q, sf, rnti, &search_space, &dci_cfg, dci_msg, cfg->cfg.dci_common_ss, cfg->pdcch_prescreen_ratio);
 }
 
 /*
@@ -702,6 +833,10 @@ int srsran_ue_dl_decode_pdsch(srsran_ue_dl_t*     q,
                               srsran_pdsch_cfg_t* pdsch_cfg,
                               srsran_pdsch_res_t  data[SRSRAN_MAX_CODEWORDS])
 {
+  if (q->ctrl_region_only) {
+    ERROR("Decoding PDSCH but only the control region is demodulated");
+    return SRSRAN_ERROR;
+  }
   return srsran_pdsch_decode(&q->pdsch, sf, pdsch_cfg, &q->chest_res, q->sf_symbols, data);
 }
 
@@ -732,6 +732,8 @@ int srsran_nbiot_ue_dl_decode_npdsch(srsran_nbiot_ue_dl_t* q,
 
 /** Handles subframe reception of a NPDSCH which doesn't carry the BCCH
  *  - In this NPDSCH config, up to four repetitons are transmitted one after another
+ *  - The soft-bits of every cycle of repetitions are combined as they arrive and decoding is attempted early,
+ *    the grant is released as soon as the CRC passes
  */
 int srsran_nbiot_ue_dl_decode_npdsch_no_bcch(srsran_nbiot_ue_dl_t* q, uint8_t* data, uint32_t tti, uint16_t rnti)
 {
@@ -752,8 +754,9 @@ int srsran_nbiot_ue_dl_decode_npdsch_no_bcch(srsran_nbiot_ue_dl_t* q, uint8_t* d
        q->npdsch_cfg.num_sf + 1,
        q->npdsch_cfg.grant.nof_sf * q->npdsch_cfg.grant.nof_rep);
 
-  if (q->npdsch_cfg.num_sf % q->npdsch_cfg.grant.nof_rep == 0) {
-    // copy data and ce symbols for first repetition of each subframe
+  int m = SRSRAN_MIN(q->npdsch_cfg.grant.nof_rep, 4);
+  if (q->npdsch_cfg.rep_idx % m == 0) {
+    // copy data and ce symbols for first repetition of each subframe within this cycle
     srsran_vec_cf_copy(&q->sf_buffer[q->npdsch_cfg.sf_idx * q->nof_re], q->sf_symbols, q->nof_re);
     for (int i = 0; i < q->cell.nof_ports; i++) {
       srsran_vec_cf_copy(&q->ce_buffer[i][q->npdsch_cfg.sf_idx * q->nof_re], q->ce[i], q->nof_re);
@@ -775,7 +778,7 @@ int srsran_nbiot_ue_dl_decode_npdsch_no_bcch(srsran_nbiot_ue_dl_t* q, uint8_t* d
   // srsran_nbiot_ue_dl_save_signal(q, input, sfn, sf_idx);
 
   q->npdsch_cfg.rep_idx++;
-  int m = SRSRAN_MIN(q->npdsch_cfg.grant.nof_rep, 4);
+  bool cycle_done = false;
   if (q->npdsch_cfg.rep_idx % m == 0) {
     // average accumulated samples
     srsran_vec_sc_prod_ccc(&q->sf_buffer[q->npdsch_cfg.sf_idx * q->nof_re],
@@ -792,40 +795,78 @@ int srsran_nbiot_ue_dl_decode_npdsch_no_bcch(srsran_nbiot_ue_dl_t* q, uint8_t* d
     q->npdsch_cfg.sf_idx++;
     if (q->npdsch_cfg.sf_idx == q->npdsch_cfg.grant.nof_sf) {
       q->npdsch_cfg.sf_idx = 0;
+      cycle_done           = true;
     } else {
       q->npdsch_cfg.rep_idx -= m;
     }
   }
 
-  if (q->npdsch_cfg.num_sf == q->npdsch_cfg.grant.nof_sf * q->npdsch_cfg.grant.nof_rep) {
-    // try to decode NPDSCH
-    INFO("%d.%d: Trying to decode NPDSCH with %d subframe(s).", tti / 10, tti % 10, q->npdsch_cfg.grant.nof_sf);
-    if (srsran_nbiot_ue_dl_decode_rnti_packet(q,
-                                              &q->npdsch_cfg.grant,
-                                              data,
-                                              tti / 10,
-                                              tti % 10,
-                                              rnti,
-                                              q->sf_buffer,
-                                              q->ce_buffer,
-                                              q->npdsch_cfg.rep_idx) != SRSRAN_SUCCESS) {
-      // decoding failed
-      INFO("%d.%d: Error decoding NPDSCH with %d repetitions.", tti / 10, tti % 10, q->npdsch_cfg.rep_idx);
-      q->pkt_errors++;
-      q->has_dl_grant = false;
-      ret             = SRSRAN_ERROR;
-    } else {
-      srsran_nbiot_ue_dl_tb_decoded(q, data);
-      ret = SRSRAN_SUCCESS;
-    }
-  } else {
+  if (!cycle_done) {
     DEBUG("%d.%d: Waiting for %d more subframes.",
           tti / 10,
           tti % 10,
           q->npdsch_cfg.grant.nof_sf * q->npdsch_cfg.grant.nof_rep - q->npdsch_cfg.num_sf);
-    ret = SRSRAN_NBIOT_EXPECT_MORE_SF;
+    return SRSRAN_NBIOT_EXPECT_MORE_SF;
   }
-  return ret;
+
+  // all subframes of m repetitions have been received, soft-combine them with the previous cycles
+  uint32_t nof_cycles = q->npdsch_cfg.rep_idx / m;
+  uint32_t nof_llr    = q->npdsch_cfg.grant.nof_sf * q->npdsch_cfg.nbits.nof_bits;
+  float    noise_est  = srsran_chest_dl_nbiot_get_noise_estimate(&q->chest);
+  if (srsran_npdsch_extract_llr_rnti(
+          &q->npdsch, &q->npdsch_cfg, q->sf_buffer, q->ce_buffer, noise_est, rnti, tti / 10) != SRSRAN_SUCCESS) {
+    ERROR("Error extracting NPDSCH soft-bits");
+    q->pkt_errors++;
+    q->has_dl_grant = false;
+    return SRSRAN_ERROR;
+  }
+  if (nof_cycles == 1) {
+    srsran_vec_f_copy(q->llr, q->npdsch.llr, nof_llr);
+  } else {
+    srsran_vec_sum_fff(q->llr, q->npdsch.llr, q->llr, nof_llr);
+  }
+
+  // Attempt an early decode each time the number of combined repetitions doubles (i.e. every 3 dB of combining
+  // gain) and after the last one, so coverage-enhanced grants with thousands of repetitions only run a handful of
+  // Viterbi decodes but still stop receiving as soon as the CRC passes
+  bool last_cycle = (q->npdsch_cfg.rep_idx >= q->npdsch_cfg.grant.nof_rep);
+  if (!last_cycle && (nof_cycles & (nof_cycles - 1)) != 0) {
+    DEBUG("%d.%d: Combined %d repetitions, waiting for %d more subframes.",
+          tti / 10,
+          tti % 10,
+          q->npdsch_cfg.rep_idx,
+          q->npdsch_cfg.grant.nof_sf * q->npdsch_cfg.grant.nof_rep - q->npdsch_cfg.num_sf);
+    return SRSRAN_NBIOT_EXPECT_MORE_SF;
+  }
+
+  // try to decode NPDSCH
+  INFO("%d.%d: Trying to decode NPDSCH with %d subframe(s) after %d repetitions.",
+       tti / 10,
+       tti % 10,
+       q->npdsch_cfg.grant.nof_sf,
+       q->npdsch_cfg.rep_idx);
+  if (srsran_npdsch_rm_and_decode(&q->npdsch, &q->npdsch_cfg, q->llr, data) == SRSRAN_SUCCESS) {
+    if (!last_cycle) {
+      INFO("%d.%d: NPDSCH decoded early, skipping the remaining %d repetitions.",
+           tti / 10,
+           tti % 10,
+           q->npdsch_cfg.grant.nof_rep - q->npdsch_cfg.rep_idx);
+    }
+    // de-activates the grant, the remaining repetitions are not received
+    srsran_nbiot_ue_dl_tb_decoded(q, data);
+    return SRSRAN_SUCCESS;
+  }
+
+  if (last_cycle) {
+    // decoding failed
+    INFO("%d.%d: Error decoding NPDSCH with %d repetitions.", tti / 10, tti % 10, q->npdsch_cfg.rep_idx);
+    q->pkt_errors++;
+    q->has_dl_grant = false;
+    return SRSRAN_ERROR;
+  }
+
+  DEBUG("%d.%d: Couldn't decode NPDSCH, waiting for next repetition", tti / 10, tti % 10);
+  return SRSRAN_NBIOT_EXPECT_MORE_SF;
 }
 
 /** Handles subframe reception of a NPDSCH carrying the BCCH
@@ -111,10 +111,12 @@ int srsran_ue_dl_nr_init(srsran_ue_dl_nr_t* q, cf_t* input[SRSRAN_MAX_PORTS], co
     return SRSRAN_ERROR;
   }
 
-  q->pdcch_ce = SRSRAN_MEM_ALLOC(srsran_dmrs_pdcch_ce_t, 1);
-  if (q->pdcch_ce == NULL) {
-    ERROR("Error alloc");
-    return SRSRAN_ERROR;
+  for (uint32_t i = 0; i < SRSRAN_PDCCH_NR_MAX_MULTI; i++) {
+    q->pdcch_ce[i] = SRSRAN_MEM_ALLOC(srsran_dmrs_pdcch_ce_t, 1);
+    if (q->pdcch_ce[i] == NULL) {
+      ERROR("Error alloc");
+      return SRSRAN_ERROR;
+    }
   }
 
   return SRSRAN_SUCCESS;
@@ -143,8 +145,10 @@ void srsran_ue_dl_nr_free(srsran_ue_dl_nr_t* q)
   }
   srsran_pdcch_nr_free(&q->pdcch);
 
-  if (q->pdcch_ce) {
-    free(q->pdcch_ce);
+  for (uint32_t i = 0; i < SRSRAN_PDCCH_NR_MAX_MULTI; i++) {
+    if (q->pdcch_ce[i]) {
+      free(q->pdcch_ce[i]);
+    }
   }
 
   SRSRAN_MEM_ZERO(q, srsran_ue_dl_nr_t, 1);
@@ -236,10 +240,15 @@ void srsran_ue_dl_nr_estimate_fft(srsran_ue_dl_nr_t* q, const srsran_slot_cfg_t*
   }
 }
 
-static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
-                                  srsran_dci_msg_nr_t*   dci_msg,
-                                  srsran_pdcch_nr_res_t* pdcch_res,
-                                  uint32_t               coreset_id)
+/**
+ * @brief Measures the DMRS of a PDCCH candidate and, if it passes the thresholds, extracts its channel estimates
+ * @return 1 if the candidate shall be decoded, 0 if it was discarded or SRSRAN_ERROR code otherwise
+ */
+static int ue_dl_nr_prescreen_dci_ncce(srsran_ue_dl_nr_t*             q,
+                                       const srsran_dci_msg_nr_t*     dci_msg,
+                                       uint32_t                       coreset_id,
+                                       srsran_dmrs_pdcch_ce_t*        ce,
+                                       srsran_ue_dl_nr_pdcch_info_t** info)
 {
   // Select debug information
   srsran_ue_dl_nr_pdcch_info_t* pdcch_info = NULL;
@@ -291,31 +300,14 @@ static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
   }
 
   // Extract PDCCH channel estimates
-  if (srsran_dmrs_pdcch_get_ce(&q->dmrs_pdcch[coreset_id], &location, q->pdcch_ce) < SRSRAN_SUCCESS) {
+  if (srsran_dmrs_pdcch_get_ce(&q->dmrs_pdcch[coreset_id], &location, ce) < SRSRAN_SUCCESS) {
     ERROR("Error extracting PDCCH DMRS");
     return SRSRAN_ERROR;
   }
 
-  // Decode PDCCH
-  if (srsran_pdcch_nr_decode(&q->pdcch, q->sf_symbols[0], q->pdcch_ce, dci_msg, pdcch_res) < SRSRAN_SUCCESS) {
-    ERROR("Error decoding PDCCH");
-    return SRSRAN_ERROR;
-  }
-
-#if 0
-  static uint32_t num_pdcch = 0;
-  char            tmpstr[64];
-  snprintf(tmpstr, 64, "pdcch_symbols%d.dat", num_pdcch);
-  printf("save %d syms to %s\n", q->pdcch.M / 4, tmpstr);
-  srsran_vec_save_file(tmpstr, q->pdcch.symbols, q->pdcch.M / 4 * sizeof(cf_t));
-  // srsran_vec_fprint_c(stdout, q->pdcch.symbols, q->pdcch.M/4);
-  num_pdcch++;
-#endif
-
-  // Save information
-  pdcch_info->result = *pdcch_res;
+  *info = pdcch_info;
 
-  return SRSRAN_SUCCESS;
+  return 1;
 }
 
 static bool find_dci_msg(srsran_dci_msg_nr_t* dci_msg, uint32_t nof_dci_msg, srsran_dci_msg_nr_t* match)
@@ -400,8 +392,12 @@ static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
         return SRSRAN_ERROR;
       }
 
-      // Iterate over the candidates
-      for (int ncce_idx = 0; ncce_idx < nof_candidates && q->dl_dci_msg_count < SRSRAN_MAX_DCI_MSG_NR; ncce_idx++) {
+      // Measure the candidates and select the ones to decode
+      srsran_dci_msg_nr_t           dci_msg_list[SRSRAN_PDCCH_NR_MAX_MULTI]    = {};
+      srsran_pdcch_nr_res_t         res_list[SRSRAN_PDCCH_NR_MAX_MULTI]        = {};
+      srsran_ue_dl_nr_pdcch_info_t* pdcch_info_list[SRSRAN_PDCCH_NR_MAX_MULTI] = {};
+      uint32_t                      nof_dci_msg_list                           = 0;
+      for (int ncce_idx = 0; ncce_idx < nof_candidates; ncce_idx++) {
         // Build DCI context
         srsran_dci_ctx_t ctx = {};
         ctx.location.L       = L;
@@ -414,15 +410,37 @@ static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
         ctx.format           = dci_format;
 
         // Build DCI message
-        srsran_dci_msg_nr_t dci_msg = {};
-        dci_msg.ctx                 = ctx;
-        dci_msg.nof_bits            = (uint32_t)dci_nof_bits;
-
-        // Find and decode PDCCH transmission in the given ncce
-        srsran_pdcch_nr_res_t res = {};
-        if (ue_dl_nr_find_dci_ncce(q, &dci_msg, &res, coreset_id) < SRSRAN_SUCCESS) {
+        srsran_dci_msg_nr_t* dci_msg = &dci_msg_list[nof_dci_msg_list];
+        dci_msg->ctx                 = ctx;
+        dci_msg->nof_bits            = (uint32_t)dci_nof_bits;
+
+        // Measure the PDCCH transmission in the given ncce
+        int ret = ue_dl_nr_prescreen_dci_ncce(
+            q, dci_msg, coreset_id, q->pdcch_ce[nof_dci_msg_list], &pdcch_info_list[nof_dci_msg_list]);
+        if (ret < SRSRAN_SUCCESS) {
           return SRSRAN_ERROR;
         }
+        if (ret > 0) {
+          nof_dci_msg_list++;
+        }
+      }
+
+      // Decode all the selected candidates at once, they share the aggregation level and the payload size
+      if (srsran_pdcch_nr_decode_multi(
+              &q->pdcch, q->sf_symbols[0], q->pdcch_ce, dci_msg_list, res_list, nof_dci_msg_list) < SRSRAN_SUCCESS) {
+        ERROR("Error decoding PDCCH");
+        return SRSRAN_ERROR;
+      }
+
+      // Save information
+      for (uint32_t i = 0; i < nof_dci_msg_list; i++) {
+        pdcch_info_list[i]->result = res_list[i];
+      }
+
+      // Iterate over the decoded candidates
+      for (uint32_t i = 0; i < nof_dci_msg_list && q->dl_dci_msg_count < SRSRAN_MAX_DCI_MSG_NR; i++) {
+        srsran_dci_msg_nr_t   dci_msg = dci_msg_list[i];
+        srsran_pdcch_nr_res_t res     = res_list[i];
 
         // If the CRC was not match, move to next candidate
         if (!res.crc) {
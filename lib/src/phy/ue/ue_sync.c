@@ -37,6 +37,7 @@
 
 #define TRACK_MAX_LOST 10
 #define TRACK_FRAME_SIZE 32
+#define TRACK_MIN_FRAME_SIZE 8
 #define FIND_NOF_AVG_FRAMES 4
 
 #define PSS_OFFSET                                                                                                     \
@@ -326,6 +327,19 @@ void srsran_ue_sync_free(srsran_ue_sync_t* q)
   bzero(q, sizeof(srsran_ue_sync_t));
 }
 
+/* Tracking window for the current cell, the default one or the one reduced with srsran_ue_sync_set_track_window().
+ * The PSS correlation main lobe spans about fft_size/32 samples, the window must hold it and part of the side-lobes.
+ */
+static uint32_t track_frame_size(srsran_ue_sync_t* q)
+{
+  uint32_t max_size = SRSRAN_MAX(TRACK_FRAME_SIZE, SRSRAN_CP_LEN_NORM(1, q->fft_size));
+  if (q->track_window == 0) {
+    return max_size;
+  }
+  uint32_t min_size = SRSRAN_MAX(TRACK_MIN_FRAME_SIZE, q->fft_size / 16);
+  return SRSRAN_MIN(max_size, SRSRAN_MAX(min_size, q->track_window));
+}
+
 int srsran_ue_sync_set_cell(srsran_ue_sync_t* q, srsran_cell_t cell)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
@@ -366,10 +380,7 @@ int srsran_ue_sync_set_cell(srsran_ue_sync_t* q, srsran_cell_t cell)
           return SRSRAN_ERROR;
         }
       } else {
-        if (srsran_sync_resize(&q->strack,
-                               q->frame_len,
-                               SRSRAN_MAX(TRACK_FRAME_SIZE, SRSRAN_CP_LEN_NORM(1, q->fft_size)),
-                               q->fft_size)) {
+        if (srsran_sync_resize(&q->strack, q->frame_len, track_frame_size(q), q->fft_size)) {
           ERROR("Error setting cell sync track");
           return SRSRAN_ERROR;
         }
@@ -509,6 +520,17 @@ float srsran_ue_sync_get_cfo(srsran_ue_sync_t* q)
   return 15000 * q->cfo_current_value;
 }
 
+void srsran_ue_sync_set_cfo_correct_defer(srsran_ue_sync_t* q, bool enable)
+{
+  q->cfo_correct_defer_track = enable;
+  q->cfo_sf_value            = 0.0f;
+}
+
+float srsran_ue_sync_get_sf_cfo(srsran_ue_sync_t* q)
+{
+  return 15000 * q->cfo_sf_value;
+}
+
 void srsran_ue_sync_cp_en(srsran_ue_sync_t* q, bool enabled)
 {
   srsran_sync_cp_en(&q->strack, enabled);
@@ -559,6 +581,22 @@ void srsran_ue_sync_set_N_id_2(srsran_ue_sync_t* q, uint32_t N_id_2)
   }
 }
 
+int srsran_ue_sync_set_track_window(srsran_ue_sync_t* q, uint32_t nof_samples, bool fft)
+{
+  q->track_window = nof_samples;
+  srsran_sync_set_pss_short_window_fft(&q->strack, fft);
+
+  // Apply it right away if tracking a known cell, restoring the tracking PSS settings reset by the resize
+  if (q->mode == SYNC_MODE_PSS && q->cell.id < 1000 && q->fft_size != 0) {
+    if (srsran_sync_resize(&q->strack, q->frame_len, track_frame_size(q), q->fft_size)) {
+      ERROR("Error setting sync track window");
+      return SRSRAN_ERROR;
+    }
+    srsran_sync_set_em_alpha(&q->strack, 0.0);
+  }
+  return SRSRAN_SUCCESS;
+}
+
 void srsran_ue_sync_set_agc_period(srsran_ue_sync_t* q, uint32_t period)
 {
   q->agc_period = period;
@@ -638,10 +676,15 @@ static int track_peak_ok(srsran_ue_sync_t* q, uint32_t track_idx)
 
   /* Adjust current CFO estimation with PSS
    * Since sync track has enabled only PSS-based correlation, get_cfo() returns that value only, already filtered.
+   * If the correction is deferred, the tracked PSS was not corrected and the residual excludes the pending CFO.
    */
-  DEBUG("TRACK: cfo_current=%f, cfo_strack=%f", 15000 * q->cfo_current_value, 15000 * srsran_sync_get_cfo(&q->strack));
-  if (15000 * fabsf(srsran_sync_get_cfo(&q->strack)) > q->cfo_pss_min) {
-    q->cfo_current_value += srsran_sync_get_cfo(&q->strack) * q->cfo_loop_bw_pss;
+  float cfo_residual = srsran_sync_get_cfo(&q->strack);
+  if (q->cfo_correct_defer_track) {
+    cfo_residual -= q->cfo_sf_value;
+  }
+  DEBUG("TRACK: cfo_current=%f, cfo_strack=%f", 15000 * q->cfo_current_value, 15000 * cfo_residual);
+  if (15000 * fabsf(cfo_residual) > q->cfo_pss_min) {
+    q->cfo_current_value += cfo_residual * q->cfo_loop_bw_pss;
     q->pss_stable_cnt = 0;
     q->pss_is_stable  = false;
   } else {
@@ -729,6 +772,14 @@ static int receive_samples(srsran_ue_sync_t* q, cf_t* input_buffer[SRSRAN_MAX_CH
   return SRSRAN_SUCCESS;
 }
 
+// Returns true if the AGC runs in the current tracked subframe, one of the subframes carrying the PSS every period
+static bool ue_sync_agc_sf(srsran_ue_sync_t* q)
+{
+  bool pss_sf = (q->sfind.frame_type == SRSRAN_FDD && (q->sf_idx == 0 || q->sf_idx == 5)) ||
+                (q->sfind.frame_type == SRSRAN_TDD && (q->sf_idx == 1 || q->sf_idx == 6));
+  return q->do_agc && pss_sf && (q->agc_period == 0 || (q->frame_total_cnt % q->agc_period) == 0);
+}
+
 /* Returns 1 if the subframe is synchronized in time, 0 otherwise */
 int srsran_ue_sync_zerocopy(srsran_ue_sync_t* q,
                             cf_t*             input_buffer[SRSRAN_MAX_CHANNELS],
@@ -776,6 +827,7 @@ int srsran_ue_sync_zerocopy(srsran_ue_sync_t* q,
       switch (q->state) {
         case SF_FIND:
           // Correct CFO before PSS/SSS find using the sync object corrector (initialized for 1 ms)
+          q->cfo_sf_value = 0.0f;
           if (q->cfo_correct_enable_find) {
             for (int i = 0; i < q->nof_rx_antennas; i++) {
               if (input_buffer[i]) {
@@ -807,10 +859,26 @@ int srsran_ue_sync_zerocopy(srsran_ue_sync_t* q,
             q->frame_number = (q->frame_number + 1) % 1024;
           }
 
-          // Correct CFO before PSS/SSS tracking using the sync object corrector (initialized for 1 ms)
-          if (q->cfo_correct_enable_track) {
+          // Correct CFO before PSS/SSS tracking using the sync object corrector (initialized for 1 ms), unless it is
+          // deferred to the OFDM demodulator
+          q->cfo_sf_value  = 0.0f;
+          q->agc_pwr_valid = false;
+          if (q->cfo_correct_enable_track && q->cfo_correct_defer_track) {
+            q->cfo_sf_value = q->cfo_current_value;
+          } else if (q->cfo_correct_enable_track) {
             for (int i = 0; i < q->nof_rx_antennas; i++) {
-              if (input_buffer[i]) {
+              if (input_buffer[i] == NULL) {
+                continue;
+              }
+              // The AGC power of the first antenna is measured while correcting it, saving a pass over the samples
+              if (i == 0 && q->mode == SYNC_MODE_PSS && ue_sync_agc_sf(q)) {
+                q->agc_avg_pwr   = srsran_cfo_correct_power(&q->strack.cfo_corr_frame,
+                                                          input_buffer[i],
+                                                          input_buffer[i],
+                                                          -q->cfo_current_value / q->fft_size,
+                                                          &q->agc_max_pwr);
+                q->agc_pwr_valid = true;
+              } else {
                 srsran_cfo_correct(
                     &q->strack.cfo_corr_frame, input_buffer[i], input_buffer[i], -q->cfo_current_value / q->fft_size);
               }
@@ -876,7 +944,9 @@ int srsran_ue_sync_run_track_pss_mode(srsran_ue_sync_t* q, cf_t* input_buffer[SR
   if ((q->sfind.frame_type == SRSRAN_FDD && (q->sf_idx == 0 || q->sf_idx == 5)) ||
       (q->sfind.frame_type == SRSRAN_TDD && (q->sf_idx == 1 || q->sf_idx == 6))) {
     // Process AGC every period
-    if (q->do_agc && (q->agc_period == 0 || (q->agc_period && (q->frame_total_cnt % q->agc_period) == 0))) {
+    if (q->agc_pwr_valid) {
+      srsran_agc_process_power(&q->agc, q->agc_avg_pwr, q->agc_max_pwr);
+    } else if (ue_sync_agc_sf(q)) {
       srsran_agc_process(&q->agc, input_buffer[0], q->sf_len);
     }
 
@@ -0,0 +1,182 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/bfp.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+#include <stdbool.h>
+#include <string.h>
+
+#define BFP_BLOCK_NOF_VALUES (2 * SRSRAN_BFP_BLOCK_LEN)
+
+static inline bool bfp_valid_mantissa_bits(uint32_t mantissa_bits)
+{
+  return mantissa_bits >= SRSRAN_BFP_MIN_MANTISSA_BITS && mantissa_bits <= SRSRAN_BFP_MAX_MANTISSA_BITS;
+}
+
+static inline uint32_t bfp_block_nof_bytes(uint32_t mantissa_bits)
+{
+  // Exponent byte followed by 24 mantissas, always a whole number of bytes
+  return 1 + (BFP_BLOCK_NOF_VALUES * mantissa_bits) / 8;
+}
+
+uint32_t srsran_bfp_nof_bytes(uint32_t nof_samples, uint32_t mantissa_bits)
+{
+  return SRSRAN_CEIL(nof_samples, SRSRAN_BFP_BLOCK_LEN) * bfp_block_nof_bytes(mantissa_bits);
+}
+
+// Shifts the block right by the smallest exponent that fits all the values in mantissa_bits, returns the exponent
+static inline uint32_t bfp_block_shift(const int16_t* x, int16_t* mantissas, uint32_t mantissa_bits)
+{
+  // OR of the magnitudes (one's complement for negative values), its bit length is the one of the largest value
+  uint32_t mag = 0;
+#ifdef LV_HAVE_SSE
+  __m128i acc = _mm_setzero_si128();
+  for (uint32_t i = 0; i < BFP_BLOCK_NOF_VALUES; i += 8) {
+    __m128i v = _mm_loadu_si128((__m128i*)&x[i]);
+    acc       = _mm_or_si128(acc, _mm_xor_si128(v, _mm_srai_epi16(v, 15)));
+  }
+  acc = _mm_or_si128(acc, _mm_srli_si128(acc, 8));
+  acc = _mm_or_si128(acc, _mm_srli_si128(acc, 4));
+  acc = _mm_or_si128(acc, _mm_srli_si128(acc, 2));
+  mag = (uint32_t)_mm_extract_epi16(acc, 0);
+#else  /* LV_HAVE_SSE */
+  for (uint32_t i = 0; i < BFP_BLOCK_NOF_VALUES; i++) {
+    mag |= (uint16_t)(x[i] ^ (x[i] >> 15));
+  }
+#endif /* LV_HAVE_SSE */
+
+  // Bits of the largest magnitude plus the sign bit
+  uint32_t nof_bits = (mag ? 32 - __builtin_clz(mag) : 0) + 1;
+  uint32_t exponent = (nof_bits > mantissa_bits) ? nof_bits - mantissa_bits : 0;
+
+#ifdef LV_HAVE_SSE
+  __m128i count = _mm_cvtsi32_si128((int)exponent);
+  for (uint32_t i = 0; i < BFP_BLOCK_NOF_VALUES; i += 8) {
+    __m128i v = _mm_loadu_si128((__m128i*)&x[i]);
+    _mm_storeu_si128((__m128i*)&mantissas[i], _mm_sra_epi16(v, count));
+  }
+#else  /* LV_HAVE_SSE */
+  for (uint32_t i = 0; i < BFP_BLOCK_NOF_VALUES; i++) {
+    mantissas[i] = (int16_t)(x[i] >> exponent);
+  }
+#endif /* LV_HAVE_SSE */
+
+  return exponent;
+}
+
+static inline void bfp_block_pack(const int16_t* mantissas, uint8_t* y, uint32_t mantissa_bits)
+{
+  uint32_t mask     = (1U << mantissa_bits) - 1;
+  uint64_t acc      = 0;
+  uint32_t acc_bits = 0;
+  for (uint32_t i = 0; i < BFP_BLOCK_NOF_VALUES; i++) {
+    acc = (acc << mantissa_bits) | ((uint32_t)mantissas[i] & mask);
+    acc_bits += mantissa_bits;
+    while (acc_bits >= 8) {
+      acc_bits -= 8;
+      *(y++) = (uint8_t)(acc >> acc_bits);
+    }
+  }
+}
+
+static inline void bfp_block_unpack(const uint8_t* x, int16_t* y, uint32_t exponent, uint32_t mantissa_bits)
+{
+  uint64_t acc      = 0;
+  uint32_t acc_bits = 0;
+  for (uint32_t i = 0; i < BFP_BLOCK_NOF_VALUES; i++) {
+    while (acc_bits < mantissa_bits) {
+      acc = (acc << 8) | *(x++);
+      acc_bits += 8;
+    }
+    acc_bits -= mantissa_bits;
+
+    // Sign extend the mantissa
+    int32_t m = (int32_t)((uint32_t)(acc >> acc_bits) << (32 - mantissa_bits)) >> (32 - mantissa_bits);
+    y[i]      = (int16_t)m;
+  }
+
+#ifdef LV_HAVE_SSE
+  __m128i count = _mm_cvtsi32_si128((int)exponent);
+  for (uint32_t i = 0; i < BFP_BLOCK_NOF_VALUES; i += 8) {
+    __m128i v = _mm_loadu_si128((__m128i*)&y[i]);
+    _mm_storeu_si128((__m128i*)&y[i], _mm_sll_epi16(v, count));
+  }
+#else  /* LV_HAVE_SSE */
+  for (uint32_t i = 0; i < BFP_BLOCK_NOF_VALUES; i++) {
+    y[i] = (int16_t)((uint16_t)y[i] << exponent);
+  }
+#endif /* LV_HAVE_SSE */
+}
+
+int srsran_bfp_compress(const int16_t* x, uint8_t* y, uint32_t nof_samples, uint32_t mantissa_bits)
+{
+  if (x == NULL || y == NULL || !bfp_valid_mantissa_bits(mantissa_bits)) {
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t block_nof_bytes = bfp_block_nof_bytes(mantissa_bits);
+  int16_t  mantissas[BFP_BLOCK_NOF_VALUES];
+  int16_t  padded[BFP_BLOCK_NOF_VALUES];
+  uint8_t* ptr = y;
+
+  for (uint32_t i = 0; i < nof_samples; i += SRSRAN_BFP_BLOCK_LEN) {
+    const int16_t* block = &x[2 * i];
+
+    // Pad the last block with zeros
+    uint32_t len = SRSRAN_MIN(SRSRAN_BFP_BLOCK_LEN, nof_samples - i);
+    if (len < SRSRAN_BFP_BLOCK_LEN) {
+      memset(padded, 0, sizeof(padded));
+      memcpy(padded, block, 2 * len * sizeof(int16_t));
+      block = padded;
+    }
+
+    ptr[0] = (uint8_t)bfp_block_shift(block, mantissas, mantissa_bits);
+    bfp_block_pack(mantissas, &ptr[1], mantissa_bits);
+    ptr += block_nof_bytes;
+  }
+
+  return (int)(ptr - y);
+}
+
+int srsran_bfp_decompress(const uint8_t* x, int16_t* y, uint32_t nof_samples, uint32_t mantissa_bits)
+{
+  if (x == NULL || y == NULL || !bfp_valid_mantissa_bits(mantissa_bits)) {
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t       block_nof_bytes = bfp_block_nof_bytes(mantissa_bits);
+  int16_t        padded[BFP_BLOCK_NOF_VALUES];
+  const uint8_t* ptr = x;
+
+  for (uint32_t i = 0; i < nof_samples; i += SRSRAN_BFP_BLOCK_LEN) {
+    uint32_t len = SRSRAN_MIN(SRSRAN_BFP_BLOCK_LEN, nof_samples - i);
+    if (len < SRSRAN_BFP_BLOCK_LEN) {
+      bfp_block_unpack(&ptr[1], padded, ptr[0] & 0xfU, mantissa_bits);
+      memcpy(&y[2 * i], padded, 2 * len * sizeof(int16_t));
+    } else {
+      bfp_block_unpack(&ptr[1], &y[2 * i], ptr[0] & 0xfU, mantissa_bits);
+    }
+    ptr += block_nof_bytes;
+  }
+
+  return (int)(ptr - x);
+}
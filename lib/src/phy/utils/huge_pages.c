@@ -0,0 +1,335 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/huge_pages.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif
+
+// Every block starts with a header, the user memory follows it aligned as srsran_vec_malloc()
+#define HUGE_ALIGN (SRSRAN_SIMD_BIT_ALIGN > 64 ? SRSRAN_SIMD_BIT_ALIGN : 64)
+#define HUGE_MAGIC 0x48756765U
+
+// Blocks up to 4 kB are rounded to HUGE_ALIGN, blocks up to 1 MB to 4 kB, larger blocks get their own mapping
+#define HUGE_SMALL_MAX 4096
+#define HUGE_LARGE_MAX (1024 * 1024)
+#define HUGE_NOF_SMALL_CLASSES (HUGE_SMALL_MAX / HUGE_ALIGN)
+#define HUGE_NOF_CLASSES (HUGE_NOF_SMALL_CLASSES + HUGE_LARGE_MAX / HUGE_SMALL_MAX - 1)
+#define HUGE_DEDICATED_CLASS UINT32_MAX
+
+typedef struct {
+  uint32_t magic;
+  uint32_t cls;
+  size_t   map_len; // length of the mapping of a dedicated block
+} huge_header_t;
+
+typedef struct {
+  uintptr_t base;
+  size_t    len;
+} huge_region_t;
+
+static pthread_mutex_t     huge_mutex = PTHREAD_MUTEX_INITIALIZER;
+static srsran_huge_pages_t huge_mode  = SRSRAN_HUGE_PAGES_NONE;
+
+// Mappings sorted by address, to tell the blocks of this allocator from the ones of malloc()
+static huge_region_t* regions         = NULL;
+static uint32_t       nof_regions     = 0;
+static uint32_t       max_nof_regions = 0;
+
+// Free blocks of each class, linked through their first bytes
+static void* free_lists[HUGE_NOF_CLASSES] = {};
+
+// Huge page the classes are currently carved from
+static uint8_t* chunk_ptr  = NULL;
+static size_t   chunk_left = 0;
+
+static srsran_huge_pages_stats_t huge_stats = {};
+
+static size_t page_size(srsran_huge_pages_t mode)
+{
+  return mode == SRSRAN_HUGE_PAGES_1GB ? (1UL << 30U) : (2UL << 20U);
+}
+
+static uint32_t size_to_class(size_t block_size)
+{
+  if (block_size <= HUGE_SMALL_MAX) {
+    return (uint32_t)((block_size + HUGE_ALIGN - 1) / HUGE_ALIGN - 1);
+  }
+  return (uint32_t)(HUGE_NOF_SMALL_CLASSES + (block_size + HUGE_SMALL_MAX - 1) / HUGE_SMALL_MAX - 2);
+}
+
+static size_t class_to_size(uint32_t cls)
+{
+  if (cls < HUGE_NOF_SMALL_CLASSES) {
+    return (size_t)(cls + 1) * HUGE_ALIGN;
+  }
+  return (size_t)(cls - HUGE_NOF_SMALL_CLASSES + 2) * HUGE_SMALL_MAX;
+}
+
+// Returns the index of the first region that starts after addr
+static uint32_t region_upper_bound(uintptr_t addr)
+{
+  uint32_t lo = 0, hi = nof_regions;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    if (regions[mid].base <= addr) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+static bool region_add(uintptr_t base, size_t len)
+{
+  if (nof_regions == max_nof_regions) {
+    uint32_t       new_max     = max_nof_regions == 0 ? 64 : 2 * max_nof_regions;
+    huge_region_t* new_regions = realloc(regions, new_max * sizeof(huge_region_t));
+    if (new_regions == NULL) {
+      return false;
+    }
+    regions         = new_regions;
+    max_nof_regions = new_max;
+  }
+  uint32_t idx = region_upper_bound(base);
+  memmove(&regions[idx + 1], &regions[idx], (nof_regions - idx) * sizeof(huge_region_t));
+  regions[idx].base = base;
+  regions[idx].len  = len;
+  nof_regions++;
+  return true;
+}
+
+static void region_remove(uintptr_t base)
+{
+  uint32_t idx = region_upper_bound(base);
+  if (idx > 0 && regions[idx - 1].base == base) {
+    memmove(&regions[idx - 1], &regions[idx], (nof_regions - idx) * sizeof(huge_region_t));
+    nof_regions--;
+  }
+}
+
+static bool region_contains(uintptr_t addr)
+{
+  uint32_t idx = region_upper_bound(addr);
+  return idx > 0 && addr < regions[idx - 1].base + regions[idx - 1].len;
+}
+
+// Maps len bytes, a multiple of the huge page size, from the reserved huge pages or from regular pages
+static void* map_pages(size_t len)
+{
+  // The reserved pages are populated right away, they are not available to other processes anyway
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE;
+  flags |= huge_mode == SRSRAN_HUGE_PAGES_1GB ? MAP_HUGE_1GB : MAP_HUGE_2MB;
+  void* ptr = mmap(NULL, len, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (ptr != MAP_FAILED) {
+    huge_stats.hugetlb_bytes += len;
+  } else {
+    // No reserved page left, let the kernel back the memory with transparent huge pages when it can
+    ptr = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+      return NULL;
+    }
+    madvise(ptr, len, MADV_HUGEPAGE);
+    huge_stats.thp_bytes += len;
+  }
+  if (!region_add((uintptr_t)ptr, len)) {
+    munmap(ptr, len);
+    return NULL;
+  }
+  return ptr;
+}
+
+static void* alloc_block(size_t block_size)
+{
+  huge_header_t* h = NULL;
+
+  if (block_size > HUGE_LARGE_MAX) {
+    size_t psize   = page_size(huge_mode);
+    size_t map_len = (block_size + psize - 1) / psize * psize;
+    h              = map_pages(map_len);
+    if (h == NULL) {
+      return NULL;
+    }
+    h->cls     = HUGE_DEDICATED_CLASS;
+    h->map_len = map_len;
+    huge_stats.used_bytes += map_len;
+  } else {
+    uint32_t cls = size_to_class(block_size);
+    size_t   sz  = class_to_size(cls);
+    if (free_lists[cls] != NULL) {
+      h = free_lists[cls];
+      memcpy(&free_lists[cls], h, sizeof(void*));
+    } else {
+      if (chunk_left < sz) {
+        // The end of the previous huge page is left unused
+        size_t psize = page_size(huge_mode);
+        chunk_ptr    = map_pages(psize);
+        if (chunk_ptr == NULL) {
+          chunk_left = 0;
+          return NULL;
+        }
+        chunk_left = psize;
+      }
+      h = (huge_header_t*)chunk_ptr;
+      chunk_ptr += sz;
+      chunk_left -= sz;
+    }
+    h->cls     = cls;
+    h->map_len = 0;
+    huge_stats.used_bytes += sz;
+  }
+  h->magic = HUGE_MAGIC;
+  return (uint8_t*)h + HUGE_ALIGN;
+}
+
+void srsran_huge_pages_set_mode(srsran_huge_pages_t mode)
+{
+  pthread_mutex_lock(&huge_mutex);
+  if (mode != huge_mode) {
+    // The current huge page has the old size, start a new one
+    chunk_ptr  = NULL;
+    chunk_left = 0;
+  }
+  huge_mode = mode;
+  pthread_mutex_unlock(&huge_mutex);
+}
+
+srsran_huge_pages_t srsran_huge_pages_get_mode(void)
+{
+  pthread_mutex_lock(&huge_mutex);
+  srsran_huge_pages_t mode = huge_mode;
+  pthread_mutex_unlock(&huge_mutex);
+  return mode;
+}
+
+int srsran_huge_pages_from_string(const char* str, srsran_huge_pages_t* mode)
+{
+  if (str == NULL || mode == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  if (strcmp(str, "none") == 0 || strlen(str) == 0) {
+    *mode = SRSRAN_HUGE_PAGES_NONE;
+  } else if (strcmp(str, "2M") == 0) {
+    *mode = SRSRAN_HUGE_PAGES_2MB;
+  } else if (strcmp(str, "1G") == 0) {
+    *mode = SRSRAN_HUGE_PAGES_1GB;
+  } else {
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+const char* srsran_huge_pages_to_string(srsran_huge_pages_t mode)
+{
+  switch (mode) {
+    case SRSRAN_HUGE_PAGES_2MB:
+      return "2M";
+    case SRSRAN_HUGE_PAGES_1GB:
+      return "1G";
+    default:
+      return "none";
+  }
+}
+
+int srsran_huge_pages_nof_free(srsran_huge_pages_t mode)
+{
+  const char* path = mode == SRSRAN_HUGE_PAGES_1GB ? "/sys/kernel/mm/hugepages/hugepages-1048576kB/free_hugepages"
+                                                   : "/sys/kernel/mm/hugepages/hugepages-2048kB/free_hugepages";
+  FILE*       f    = fopen(path, "r");
+  if (f == NULL) {
+    return -1;
+  }
+  int nof_free = -1;
+  if (fscanf(f, "%d", &nof_free) != 1) {
+    nof_free = -1;
+  }
+  fclose(f);
+  return nof_free;
+}
+
+void* srsran_huge_malloc(size_t size)
+{
+  pthread_mutex_lock(&huge_mutex);
+  void* ptr = NULL;
+  if (huge_mode == SRSRAN_HUGE_PAGES_NONE) {
+    pthread_mutex_unlock(&huge_mutex);
+    return size <= UINT32_MAX ? srsran_vec_malloc((uint32_t)size) : NULL;
+  }
+  ptr = alloc_block(size + HUGE_ALIGN);
+  pthread_mutex_unlock(&huge_mutex);
+  return ptr;
+}
+
+void srsran_huge_free(void* ptr)
+{
+  if (ptr == NULL) {
+    return;
+  }
+  pthread_mutex_lock(&huge_mutex);
+  if (!region_contains((uintptr_t)ptr)) {
+    pthread_mutex_unlock(&huge_mutex);
+    free(ptr);
+    return;
+  }
+
+  huge_header_t* h = (huge_header_t*)((uint8_t*)ptr - HUGE_ALIGN);
+  if (h->magic != HUGE_MAGIC) {
+    ERROR("Invalid huge page block %p", ptr);
+  } else if (h->cls == HUGE_DEDICATED_CLASS) {
+    size_t map_len = h->map_len;
+    huge_stats.used_bytes -= map_len;
+    region_remove((uintptr_t)h);
+    munmap(h, map_len);
+  } else {
+    uint32_t cls = h->cls;
+    huge_stats.used_bytes -= class_to_size(cls);
+    memcpy(h, &free_lists[cls], sizeof(void*));
+    free_lists[cls] = h;
+  }
+  pthread_mutex_unlock(&huge_mutex);
+}
+
+void srsran_huge_pages_get_stats(srsran_huge_pages_stats_t* stats)
+{
+  if (stats == NULL) {
+    return;
+  }
+  pthread_mutex_lock(&huge_mutex);
+  *stats = huge_stats;
+  pthread_mutex_unlock(&huge_mutex);
+}
@@ -293,7 +293,7 @@ uint32_t srsran_re_pattern_list_count(const srsran_re_pattern_list_t* list,
                                       const bool                      prb_mask[SRSRAN_MAX_PRB_NR])
 {
   uint32_t count = 0;
-  if (list == NULL || prb_mask == NULL) {
+  if (list == NULL || prb_mask == NULL || list->count == 0) {
     return 0;
   }
 
@@ -326,4 +326,56 @@ uint32_t srsran_re_pattern_list_count(const srsran_re_pattern_list_t* list,
   }
 
   return count;
-}
\ No newline at end of file
+}
+
+void srsran_re_pattern_mask_to_runs(const bool*               mask,
+                                    const bool                prb_mask[SRSRAN_MAX_PRB_NR],
+                                    uint32_t                  nof_prb,
+                                    srsran_re_pattern_runs_t* runs)
+{
+  runs->count  = 0;
+  runs->nof_re = 0;
+
+  uint32_t k_end = UINT32_MAX; // End of the last run, a RE starting there extends it
+  for (uint32_t rb = 0; rb < SRSRAN_MIN(nof_prb, SRSRAN_MAX_PRB_NR); rb++) {
+    // Skip PRB if not available in grant
+    if (!prb_mask[rb]) {
+      continue;
+    }
+
+    for (uint32_t k = rb * SRSRAN_NRE; k < (rb + 1) * SRSRAN_NRE; k++) {
+      if (mask[k]) {
+        continue;
+      }
+      runs->nof_re++;
+      if (k == k_end) {
+        runs->len[runs->count - 1]++;
+      } else {
+        runs->k_begin[runs->count] = (uint16_t)k;
+        runs->len[runs->count]     = 1;
+        runs->count++;
+      }
+      k_end = k + 1;
+    }
+  }
+}
+
+uint32_t srsran_re_pattern_runs_put(const srsran_re_pattern_runs_t* runs, const cf_t* symbols, cf_t* sf_symbol)
+{
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < runs->count; i++) {
+    srsran_vec_cf_copy(&sf_symbol[runs->k_begin[i]], &symbols[count], runs->len[i]);
+    count += runs->len[i];
+  }
+  return count;
+}
+
+uint32_t srsran_re_pattern_runs_get(const srsran_re_pattern_runs_t* runs, const cf_t* sf_symbol, cf_t* symbols)
+{
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < runs->count; i++) {
+    srsran_vec_cf_copy(&symbols[count], &sf_symbol[runs->k_begin[i]], runs->len[i]);
+    count += runs->len[i];
+  }
+  return count;
+}
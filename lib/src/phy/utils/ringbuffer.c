@@ -353,3 +353,259 @@ int srsran_ringbuffer_read_block(srsran_ringbuffer_t* q, void** p, int nof_bytes
   pthread_mutex_unlock(&q->mutex);
   return ret;
 }
+
+/*
+ * Lock-free single-producer/single-consumer ring buffer
+ */
+
+// Number of polls of the other side's counter before falling back to the condition variable
+#define SPSC_SPIN_COUNT 128
+
+static inline void spsc_cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#endif
+}
+
+static inline bool spsc_is_active(srsran_ringbuffer_spsc_t* q)
+{
+  return __atomic_load_n(&q->active, __ATOMIC_SEQ_CST);
+}
+
+static inline int spsc_count(srsran_ringbuffer_spsc_t* q)
+{
+  uint64_t rd = __atomic_load_n(&q->rd_count, __ATOMIC_SEQ_CST);
+  uint64_t wr = __atomic_load_n(&q->wr_count, __ATOMIC_SEQ_CST);
+  return (int)(wr - rd);
+}
+
+static inline int spsc_available(srsran_ringbuffer_spsc_t* q, bool reader)
+{
+  int count = spsc_count(q);
+  return reader ? count : q->capacity - count;
+}
+
+// Wakes up the other side if it went to sleep. The seq_cst store of the counter that precedes this call pairs with
+// the seq_cst store of the waiting flag in spsc_wait(), so one of the two sides always sees the other one.
+static inline void spsc_notify(srsran_ringbuffer_spsc_t* q, bool* waiting, pthread_cond_t* cvar)
+{
+  if (__atomic_load_n(waiting, __ATOMIC_SEQ_CST)) {
+    pthread_mutex_lock(&q->mutex);
+    pthread_cond_broadcast(cvar);
+    pthread_mutex_unlock(&q->mutex);
+  }
+}
+
+// Waits until nof_bytes can be read (reader) or written (writer), or the buffer is stopped
+static int spsc_wait(srsran_ringbuffer_spsc_t* q, bool reader, int nof_bytes, int32_t timeout_ms)
+{
+  bool*           waiting = reader ? &q->reader_waiting : &q->writer_waiting;
+  pthread_cond_t* cvar    = reader ? &q->write_cvar : &q->read_cvar;
+  struct timespec towait  = {};
+  int             ret     = SRSRAN_SUCCESS;
+
+  // The other side is usually in the middle of a transfer, poll for a while before sleeping
+  for (int i = 0; i < SPSC_SPIN_COUNT; i++) {
+    if (spsc_available(q, reader) >= nof_bytes || !spsc_is_active(q)) {
+      return SRSRAN_SUCCESS;
+    }
+    spsc_cpu_relax();
+  }
+
+  if (timeout_ms > 0) {
+    struct timespec now = {};
+    timespec_get(&now, TIME_UTC);
+    long nsec      = now.tv_nsec + (timeout_ms % 1000L) * 1000000L;
+    towait.tv_sec  = now.tv_sec + timeout_ms / 1000L + nsec / 1000000000L;
+    towait.tv_nsec = nsec % 1000000000L;
+  }
+
+  pthread_mutex_lock(&q->mutex);
+  __atomic_store_n(waiting, true, __ATOMIC_SEQ_CST);
+  while (spsc_available(q, reader) < nof_bytes && spsc_is_active(q) && ret == SRSRAN_SUCCESS) {
+    if (timeout_ms > 0) {
+      ret = pthread_cond_timedwait(cvar, &q->mutex, &towait);
+    } else {
+      ret = pthread_cond_wait(cvar, &q->mutex);
+    }
+  }
+  __atomic_store_n(waiting, false, __ATOMIC_SEQ_CST);
+  pthread_mutex_unlock(&q->mutex);
+
+  if (ret == ETIMEDOUT) {
+    return SRSRAN_ERROR_TIMEOUT;
+  } else if (ret != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error: waiting on SPSC ring buffer returned %d (%s)\n", ret, strerror(ret));
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_ringbuffer_spsc_init(srsran_ringbuffer_spsc_t* q, int capacity)
+{
+  q->buffer = srsran_vec_malloc(capacity);
+  if (!q->buffer) {
+    return SRSRAN_ERROR;
+  }
+  q->capacity       = capacity;
+  q->writer_waiting = false;
+  q->reader_waiting = false;
+  pthread_mutex_init(&q->mutex, NULL);
+  pthread_cond_init(&q->write_cvar, NULL);
+  pthread_cond_init(&q->read_cvar, NULL);
+  srsran_ringbuffer_spsc_reset(q);
+  __atomic_store_n(&q->active, true, __ATOMIC_SEQ_CST);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_ringbuffer_spsc_free(srsran_ringbuffer_spsc_t* q)
+{
+  if (q) {
+    srsran_ringbuffer_spsc_stop(q);
+    if (q->buffer) {
+      free(q->buffer);
+      q->buffer = NULL;
+    }
+    pthread_mutex_destroy(&q->mutex);
+    pthread_cond_destroy(&q->write_cvar);
+    pthread_cond_destroy(&q->read_cvar);
+  }
+}
+
+void srsran_ringbuffer_spsc_reset(srsran_ringbuffer_spsc_t* q)
+{
+  __atomic_store_n(&q->wr_count, 0, __ATOMIC_SEQ_CST);
+  __atomic_store_n(&q->rd_count, 0, __ATOMIC_SEQ_CST);
+}
+
+int srsran_ringbuffer_spsc_resize(srsran_ringbuffer_spsc_t* q, int capacity)
+{
+  if (q->buffer) {
+    free(q->buffer);
+    q->buffer = NULL;
+  }
+  srsran_ringbuffer_spsc_reset(q);
+  q->buffer = srsran_vec_malloc(capacity);
+  if (!q->buffer) {
+    return SRSRAN_ERROR;
+  }
+  q->capacity = capacity;
+  __atomic_store_n(&q->active, true, __ATOMIC_SEQ_CST);
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_ringbuffer_spsc_status(srsran_ringbuffer_spsc_t* q)
+{
+  return spsc_count(q);
+}
+
+int srsran_ringbuffer_spsc_space(srsran_ringbuffer_spsc_t* q)
+{
+  return q->capacity - spsc_count(q);
+}
+
+int srsran_ringbuffer_spsc_write(srsran_ringbuffer_spsc_t* q, void* ptr, int nof_bytes)
+{
+  return srsran_ringbuffer_spsc_write_timed(q, ptr, nof_bytes, 0);
+}
+
+int srsran_ringbuffer_spsc_write_block(srsran_ringbuffer_spsc_t* q, void* ptr, int nof_bytes)
+{
+  return srsran_ringbuffer_spsc_write_timed(q, ptr, nof_bytes, -1);
+}
+
+int srsran_ringbuffer_spsc_write_timed(srsran_ringbuffer_spsc_t* q, void* p, int nof_bytes, int32_t timeout_ms)
+{
+  uint8_t* ptr     = (uint8_t*)p;
+  int      w_bytes = nof_bytes;
+
+  if (q == NULL || q->buffer == NULL || nof_bytes < 0) {
+    ERROR("Invalid inputs");
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Wait to have enough space in the buffer
+  if (spsc_available(q, false) < nof_bytes) {
+    if (timeout_ms == 0) {
+      w_bytes = spsc_available(q, false);
+      ERROR("Buffer overrun: lost %d bytes", nof_bytes - w_bytes);
+    } else {
+      int ret = spsc_wait(q, false, nof_bytes, timeout_ms);
+      if (ret < SRSRAN_SUCCESS) {
+        return ret;
+      }
+    }
+  }
+  if (!spsc_is_active(q)) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Only this thread writes wr_count
+  uint64_t wr  = __atomic_load_n(&q->wr_count, __ATOMIC_RELAXED);
+  int      wpm = (int)(wr % (uint64_t)q->capacity);
+  int      x   = SRSRAN_MIN(w_bytes, q->capacity - wpm);
+  if (ptr != NULL) {
+    memcpy(&q->buffer[wpm], ptr, x);
+    memcpy(q->buffer, &ptr[x], w_bytes - x);
+  } else {
+    memset(&q->buffer[wpm], 0, x);
+    memset(q->buffer, 0, w_bytes - x);
+  }
+
+  // Publish the data and wake up the consumer if it is sleeping
+  __atomic_store_n(&q->wr_count, wr + w_bytes, __ATOMIC_SEQ_CST);
+  spsc_notify(q, &q->reader_waiting, &q->write_cvar);
+
+  return w_bytes;
+}
+
+int srsran_ringbuffer_spsc_read(srsran_ringbuffer_spsc_t* q, void* ptr, int nof_bytes)
+{
+  return srsran_ringbuffer_spsc_read_timed(q, ptr, nof_bytes, -1);
+}
+
+int srsran_ringbuffer_spsc_read_timed(srsran_ringbuffer_spsc_t* q, void* p, int nof_bytes, int32_t timeout_ms)
+{
+  uint8_t* ptr = (uint8_t*)p;
+
+  if (q == NULL || q->buffer == NULL || ptr == NULL || nof_bytes < 0 || nof_bytes > q->capacity) {
+    ERROR("Invalid inputs");
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Wait for having enough samples
+  if (spsc_available(q, true) < nof_bytes) {
+    int ret = spsc_wait(q, true, nof_bytes, timeout_ms);
+    if (ret < SRSRAN_SUCCESS) {
+      return ret;
+    }
+  }
+  if (!spsc_is_active(q)) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Only this thread writes rd_count
+  uint64_t rd  = __atomic_load_n(&q->rd_count, __ATOMIC_RELAXED);
+  int      rpm = (int)(rd % (uint64_t)q->capacity);
+  int      x   = SRSRAN_MIN(nof_bytes, q->capacity - rpm);
+  memcpy(ptr, &q->buffer[rpm], x);
+  memcpy(&ptr[x], q->buffer, nof_bytes - x);
+
+  // Release the space and wake up the producer if it is sleeping
+  __atomic_store_n(&q->rd_count, rd + nof_bytes, __ATOMIC_SEQ_CST);
+  spsc_notify(q, &q->writer_waiting, &q->read_cvar);
+
+  return nof_bytes;
+}
+
+void srsran_ringbuffer_spsc_stop(srsran_ringbuffer_spsc_t* q)
+{
+  pthread_mutex_lock(&q->mutex);
+  __atomic_store_n(&q->active, false, __ATOMIC_SEQ_CST);
+  pthread_cond_broadcast(&q->write_cvar);
+  pthread_cond_broadcast(&q->read_cvar);
+  pthread_mutex_unlock(&q->mutex);
+}
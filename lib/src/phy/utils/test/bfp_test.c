@@ -0,0 +1,89 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/bfp.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/support/srsran_test.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_NOF_SAMPLES (SRSRAN_BFP_BLOCK_LEN * 100 + 5)
+
+static int16_t x[2 * MAX_NOF_SAMPLES];
+static int16_t z[2 * MAX_NOF_SAMPLES];
+static uint8_t y[SRSRAN_CEIL(MAX_NOF_SAMPLES, SRSRAN_BFP_BLOCK_LEN) * (1 + 3 * SRSRAN_BFP_MAX_MANTISSA_BITS)];
+
+// Fills the samples with a different amplitude per block, including the full scale ones
+static void generate(uint32_t nof_samples)
+{
+  for (uint32_t i = 0; i < 2 * nof_samples; i++) {
+    uint32_t block     = i / (2 * SRSRAN_BFP_BLOCK_LEN);
+    int32_t  amplitude = 1 << (block % 16);
+    int32_t  v         = (rand() % (2 * amplitude)) - amplitude;
+    x[i]               = (int16_t)SRSRAN_MAX(INT16_MIN, SRSRAN_MIN(INT16_MAX, v));
+  }
+  x[0] = INT16_MIN;
+  x[1] = INT16_MAX;
+}
+
+static int test_bfp(uint32_t nof_samples, uint32_t mantissa_bits)
+{
+  generate(nof_samples);
+
+  uint32_t nof_bytes       = srsran_bfp_nof_bytes(nof_samples, mantissa_bits);
+  uint32_t block_nof_bytes = srsran_bfp_nof_bytes(SRSRAN_BFP_BLOCK_LEN, mantissa_bits);
+  TESTASSERT(srsran_bfp_compress(x, y, nof_samples, mantissa_bits) == (int)nof_bytes);
+  TESTASSERT(srsran_bfp_decompress(y, z, nof_samples, mantissa_bits) == (int)nof_bytes);
+
+  for (uint32_t i = 0; i < 2 * nof_samples; i++) {
+    // The error is below the step of the exponent of the block
+    uint8_t exponent = y[(i / (2 * SRSRAN_BFP_BLOCK_LEN)) * block_nof_bytes];
+    int32_t err      = (int32_t)x[i] - (int32_t)z[i];
+    TESTASSERT(exponent <= 16 - mantissa_bits);
+    TESTASSERT(err >= 0 && err < (1 << exponent));
+  }
+
+  // 16 bit mantissas are lossless
+  if (mantissa_bits == 16) {
+    TESTASSERT(memcmp(x, z, 2 * nof_samples * sizeof(int16_t)) == 0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srand(0);
+
+  TESTASSERT(srsran_bfp_nof_bytes(SRSRAN_BFP_BLOCK_LEN, 9) == 28);
+  TESTASSERT(srsran_bfp_nof_bytes(SRSRAN_BFP_BLOCK_LEN + 1, 9) == 56);
+  TESTASSERT(srsran_bfp_compress(x, y, SRSRAN_BFP_BLOCK_LEN, SRSRAN_BFP_MIN_MANTISSA_BITS - 1) == SRSRAN_ERROR);
+  TESTASSERT(srsran_bfp_decompress(y, z, SRSRAN_BFP_BLOCK_LEN, SRSRAN_BFP_MAX_MANTISSA_BITS + 1) == SRSRAN_ERROR);
+
+  for (uint32_t bits = SRSRAN_BFP_MIN_MANTISSA_BITS; bits <= SRSRAN_BFP_MAX_MANTISSA_BITS; bits++) {
+    TESTASSERT(test_bfp(MAX_NOF_SAMPLES, bits) == SRSRAN_SUCCESS);
+    TESTASSERT(test_bfp(SRSRAN_BFP_BLOCK_LEN, bits) == SRSRAN_SUCCESS);
+    TESTASSERT(test_bfp(1, bits) == SRSRAN_SUCCESS);
+  }
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
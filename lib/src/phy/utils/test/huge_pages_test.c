@@ -0,0 +1,123 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/huge_pages.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/support/srsran_test.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define NOF_BLOCKS 64
+
+static int test_strings()
+{
+  srsran_huge_pages_t mode = SRSRAN_HUGE_PAGES_NONE;
+  TESTASSERT(srsran_huge_pages_from_string("2M", &mode) == SRSRAN_SUCCESS);
+  TESTASSERT(mode == SRSRAN_HUGE_PAGES_2MB);
+  TESTASSERT(srsran_huge_pages_from_string("1G", &mode) == SRSRAN_SUCCESS);
+  TESTASSERT(mode == SRSRAN_HUGE_PAGES_1GB);
+  TESTASSERT(srsran_huge_pages_from_string("none", &mode) == SRSRAN_SUCCESS);
+  TESTASSERT(mode == SRSRAN_HUGE_PAGES_NONE);
+  TESTASSERT(srsran_huge_pages_from_string("4k", &mode) == SRSRAN_ERROR);
+  TESTASSERT(strcmp(srsran_huge_pages_to_string(SRSRAN_HUGE_PAGES_2MB), "2M") == 0);
+  return SRSRAN_SUCCESS;
+}
+
+static int test_alloc(srsran_huge_pages_t mode)
+{
+  srsran_huge_pages_set_mode(mode);
+
+  // Sizes of all the classes, and of dedicated mappings
+  const size_t sizes[] = {1, 100, 1000, 4000, 5000, 70000, 1024 * 1024 - 64, 3 * 1024 * 1024 + 5};
+  const size_t nof_sizes = sizeof(sizes) / sizeof(sizes[0]);
+
+  uint8_t* ptrs[NOF_BLOCKS] = {};
+  for (uint32_t i = 0; i < NOF_BLOCKS; i++) {
+    size_t sz = sizes[i % nof_sizes];
+    ptrs[i]   = srsran_huge_malloc(sz);
+    TESTASSERT(ptrs[i] != NULL);
+    TESTASSERT(SRSRAN_IS_ALIGNED(ptrs[i]));
+    memset(ptrs[i], (int)i, sz);
+  }
+
+  // The blocks do not overlap
+  for (uint32_t i = 0; i < NOF_BLOCKS; i++) {
+    size_t sz = sizes[i % nof_sizes];
+    TESTASSERT(ptrs[i][0] == (uint8_t)i && ptrs[i][sz - 1] == (uint8_t)i);
+  }
+
+  srsran_huge_pages_stats_t stats = {};
+  srsran_huge_pages_get_stats(&stats);
+  if (mode != SRSRAN_HUGE_PAGES_NONE) {
+    TESTASSERT(stats.used_bytes > 0);
+    TESTASSERT(stats.hugetlb_bytes + stats.thp_bytes >= stats.used_bytes);
+  }
+
+  for (uint32_t i = 0; i < NOF_BLOCKS; i++) {
+    srsran_huge_free(ptrs[i]);
+  }
+  srsran_huge_pages_get_stats(&stats);
+  TESTASSERT(stats.used_bytes == 0);
+
+  // Freed blocks are recycled, the blocks with their own mapping are left out as they are mapped again
+  uint64_t mapped = stats.hugetlb_bytes + stats.thp_bytes;
+  for (uint32_t i = 0; i < NOF_BLOCKS; i++) {
+    ptrs[i] = NULL;
+    if (i % nof_sizes != nof_sizes - 1) {
+      ptrs[i] = srsran_huge_malloc(sizes[i % nof_sizes]);
+      TESTASSERT(ptrs[i] != NULL);
+    }
+  }
+  for (uint32_t i = 0; i < NOF_BLOCKS; i++) {
+    srsran_huge_free(ptrs[i]);
+  }
+  srsran_huge_pages_get_stats(&stats);
+  TESTASSERT(stats.hugetlb_bytes + stats.thp_bytes == mapped);
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_free_malloc()
+{
+  srsran_huge_pages_set_mode(SRSRAN_HUGE_PAGES_2MB);
+
+  // Memory from malloc is released with free
+  void* ptr = malloc(100);
+  TESTASSERT(ptr != NULL);
+  srsran_huge_free(ptr);
+  srsran_huge_free(NULL);
+
+  srsran_huge_pages_set_mode(SRSRAN_HUGE_PAGES_NONE);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  printf("Free 2M huge pages: %d\n", srsran_huge_pages_nof_free(SRSRAN_HUGE_PAGES_2MB));
+
+  TESTASSERT(test_strings() == SRSRAN_SUCCESS);
+  TESTASSERT(test_alloc(SRSRAN_HUGE_PAGES_NONE) == SRSRAN_SUCCESS);
+  TESTASSERT(test_alloc(SRSRAN_HUGE_PAGES_2MB) == SRSRAN_SUCCESS);
+  TESTASSERT(test_free_malloc() == SRSRAN_SUCCESS);
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
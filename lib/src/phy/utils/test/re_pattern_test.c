@@ -65,5 +65,43 @@ int main(int argc, char** argv)
     }
   }
 
+  // Assert the runs map the same RE as the mask, for a fragmented PRB allocation
+  bool prb_mask[SRSRAN_MAX_PRB_NR] = {};
+  for (uint32_t rb = 0; rb < SRSRAN_MAX_PRB_NR; rb++) {
+    prb_mask[rb] = (rb % 3 != 1);
+  }
+  for (uint32_t l = 0; l < SRSRAN_NSYMB_PER_SLOT_NR; l++) {
+    bool mask[SRSRAN_NRE * SRSRAN_MAX_PRB_NR] = {};
+    TESTASSERT(srsran_re_pattern_list_to_symbol_mask(&pattern_list, l, mask) == SRSRAN_SUCCESS);
+
+    srsran_re_pattern_runs_t runs;
+    srsran_re_pattern_mask_to_runs(mask, prb_mask, SRSRAN_MAX_PRB_NR, &runs);
+
+    static cf_t symbols[SRSRAN_NRE * SRSRAN_MAX_PRB_NR];
+    static cf_t sf_symbol[SRSRAN_NRE * SRSRAN_MAX_PRB_NR];
+    static cf_t rx_symbols[SRSRAN_NRE * SRSRAN_MAX_PRB_NR];
+    for (uint32_t i = 0; i < SRSRAN_NRE * SRSRAN_MAX_PRB_NR; i++) {
+      symbols[i]   = (float)i;
+      sf_symbol[i] = -1.0f;
+    }
+    TESTASSERT(srsran_re_pattern_runs_put(&runs, symbols, sf_symbol) == runs.nof_re);
+
+    uint32_t count = 0;
+    for (uint32_t k = 0; k < SRSRAN_NRE * SRSRAN_MAX_PRB_NR; k++) {
+      if (prb_mask[k / SRSRAN_NRE] && !mask[k]) {
+        TESTASSERT(sf_symbol[k] == symbols[count]);
+        count++;
+      } else {
+        TESTASSERT(sf_symbol[k] == -1.0f);
+      }
+    }
+    TESTASSERT(count == runs.nof_re);
+
+    TESTASSERT(srsran_re_pattern_runs_get(&runs, sf_symbol, rx_symbols) == runs.nof_re);
+    for (uint32_t i = 0; i < runs.nof_re; i++) {
+      TESTASSERT(rx_symbols[i] == symbols[i]);
+    }
+  }
+
   return SRSRAN_SUCCESS;
 }
\ No newline at end of file
@@ -151,6 +151,99 @@ int threaded_blocking_test(struct thread_args_t* args)
   return SRSRAN_SUCCESS;
 }
 
+int test_spsc_normal_read_write(srsran_ringbuffer_spsc_t* q, uint8_t* in, uint8_t* out, int len)
+{
+  // Wrap around the end of the buffer several times
+  for (int k = 0; k < 3; k++) {
+    TESTASSERT(srsran_ringbuffer_spsc_write(q, in, len / 2) == len / 2);
+    TESTASSERT(srsran_ringbuffer_spsc_write(q, &in[len / 2], len / 2) == len / 2);
+    TESTASSERT(srsran_ringbuffer_spsc_status(q) == len);
+    TESTASSERT(srsran_ringbuffer_spsc_space(q) == 0);
+
+    for (int i = 0; i < 4; i++) {
+      TESTASSERT(srsran_ringbuffer_spsc_read(q, &out[(len / 4) * i], len / 4) == len / 4);
+    }
+    TESTASSERT(!memcmp(in, out, len));
+
+    // Shift the read and write positions
+    TESTASSERT(srsran_ringbuffer_spsc_write(q, NULL, len / 3) == len / 3);
+    TESTASSERT(srsran_ringbuffer_spsc_read(q, out, len / 3) == len / 3);
+  }
+
+  // Overflow truncates the write
+  TESTASSERT(srsran_ringbuffer_spsc_write(q, in, len / 2) == len / 2);
+  TESTASSERT(srsran_ringbuffer_spsc_write(q, &in[len / 2], len / 2 + 2) == len / 2);
+
+  // A read of more than the available bytes times out
+  srsran_ringbuffer_spsc_reset(q);
+  TESTASSERT(srsran_ringbuffer_spsc_write(q, in, len / 2) == len / 2);
+  TESTASSERT(srsran_ringbuffer_spsc_read_timed(q, out, len / 2 + 1, 10) == SRSRAN_ERROR_TIMEOUT);
+  TESTASSERT(srsran_ringbuffer_spsc_read_timed(q, out, len / 2, 10) == len / 2);
+
+  return SRSRAN_SUCCESS;
+}
+
+struct spsc_thread_args_t {
+  srsran_ringbuffer_spsc_t* buf;
+  int                       chunk;
+  int                       nof_chunks;
+  int                       res;
+};
+
+void* spsc_write_thread(void* args_)
+{
+  struct spsc_thread_args_t* args  = (struct spsc_thread_args_t*)args_;
+  uint8_t                    chunk[args->chunk];
+  uint8_t                    value = 0;
+  for (int i = 0; i < args->nof_chunks; i++) {
+    for (int j = 0; j < args->chunk; j++) {
+      chunk[j] = value++;
+    }
+    if (srsran_ringbuffer_spsc_write_block(args->buf, chunk, args->chunk) != args->chunk) {
+      args->res = SRSRAN_ERROR;
+    }
+  }
+  return NULL;
+}
+
+// Streams nof_chunks through the buffer with the reader and writer racing each other, checks the byte sequence
+int threaded_spsc_test(srsran_ringbuffer_spsc_t* q, int chunk, int nof_chunks)
+{
+  struct spsc_thread_args_t args = {q, chunk, nof_chunks, SRSRAN_SUCCESS};
+  uint8_t                   out[chunk];
+  uint8_t                   value = 0;
+
+  pthread_t thread;
+  if (pthread_create(&thread, NULL, spsc_write_thread, &args)) {
+    fprintf(stderr, "Error creating thread\n");
+    return SRSRAN_ERROR;
+  }
+
+  int ret = SRSRAN_SUCCESS;
+  for (int i = 0; i < nof_chunks && ret == SRSRAN_SUCCESS; i++) {
+    if (srsran_ringbuffer_spsc_read_timed(q, out, chunk, 1000) != chunk) {
+      ret = SRSRAN_ERROR;
+    }
+    for (int j = 0; j < chunk && ret == SRSRAN_SUCCESS; j++) {
+      if (out[j] != value++) {
+        ret = SRSRAN_ERROR;
+      }
+    }
+  }
+
+  // Unblock the writer if the reader bailed out
+  srsran_ringbuffer_spsc_stop(q);
+
+  if (pthread_join(thread, NULL)) {
+    fprintf(stderr, "Error joining thread\n");
+    return SRSRAN_ERROR;
+  }
+
+  TESTASSERT(ret == SRSRAN_SUCCESS);
+  TESTASSERT(args.res == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   int ret = SRSRAN_SUCCESS;
@@ -192,6 +285,21 @@ int main(int argc, char** argv)
   }
   srsran_ringbuffer_stop(&ring_buf);
   srsran_ringbuffer_free(&ring_buf);
+
+  srsran_ringbuffer_spsc_t spsc_buf;
+  srsran_ringbuffer_spsc_init(&spsc_buf, N);
+  if (test_spsc_normal_read_write(&spsc_buf, in, out, N) < 0) {
+    printf("SPSC read write test failed\n");
+    ret = SRSRAN_ERROR;
+  }
+
+  // Chunks that do not divide the capacity, so the transfers wrap at every position
+  srsran_ringbuffer_spsc_resize(&spsc_buf, N);
+  if (threaded_spsc_test(&spsc_buf, 7, 100000) < 0) {
+    printf("Error in multithreaded SPSC ringbuffer test\n");
+    ret = SRSRAN_ERROR;
+  }
+  srsran_ringbuffer_spsc_free(&spsc_buf);
   free(in);
   free(out);
   printf("Done\n");
@@ -21,6 +21,7 @@
 
 #include "srsran/srsran.h"
 #include <srsran/phy/utils/random.h>
+#include <srsran/phy/utils/vector_simd.h>
 
 bool zf_solver   = false;
 bool mmse_solver = false;
@@ -423,6 +424,26 @@ TEST(
     free(y);
     free(z);)
 
+TEST(
+    srsran_vec_prod_sc_ccc, MALLOC(cf_t, x); MALLOC(cf_t, y); MALLOC(cf_t, z); cf_t h = RANDOM_CF();
+
+    cf_t gold;
+    for (int i = 0; i < block_size; i++) {
+      x[i] = RANDOM_CF();
+      y[i] = RANDOM_CF();
+    }
+
+    TEST_CALL(srsran_vec_prod_sc_ccc(x, y, h, z, block_size))
+
+        for (int i = 0; i < block_size; i++) {
+          gold = x[i] * y[i] * h;
+          mse += cabsf(gold - z[i]);
+        }
+
+    free(x);
+    free(y);
+    free(z);)
+
 TEST(
     srsran_vec_sc_prod_ccc, MALLOC(cf_t, x); MALLOC(cf_t, z); cf_t y = RANDOM_CF();
 
@@ -439,6 +460,24 @@ TEST(
     free(x);
     free(z);)
 
+TEST(
+    srsran_vec_cf_to_split, MALLOC(cf_t, x); MALLOC(float, re); MALLOC(float, im); MALLOC(cf_t, z);
+
+    for (int i = 0; i < block_size; i++) { x[i] = RANDOM_CF(); }
+
+    TEST_CALL(srsran_vec_cf_to_split(x, re, im, block_size))
+
+        srsran_vec_split_to_cf(re, im, z, block_size);
+    for (int i = 0; i < block_size; i++) {
+      mse += fabsf(re[i] - crealf(x[i])) + fabsf(im[i] - cimagf(x[i]));
+      mse += cabsf(z[i] - x[i]);
+    }
+
+    free(x);
+    free(re);
+    free(im);
+    free(z);)
+
 TEST(
     srsran_vec_convert_fi, MALLOC(float, x); MALLOC(short, z); float scale = 1000.0f;
 
@@ -845,6 +884,34 @@ TEST(
     free(z);
     srsran_cfo_free(&srsran_cfo);)
 
+TEST(
+    srsran_cfo_correct_power, srsran_cfo_t srsran_cfo; bzero(&srsran_cfo, sizeof(srsran_cfo)); MALLOC(cf_t, x);
+    MALLOC(cf_t, z);
+
+    const float cfo     = 0.1f;
+    float       avg_pwr = 0.0f;
+    float       max_pwr = 0.0f;
+    cf_t        gold;
+    for (int i = 0; i < block_size; i++) { x[i] = RANDOM_CF(); }
+
+    // The rotation keeps the power, the reference is measured on the input
+    float gold_max = 0.0f;
+    float gold_avg = srsran_vec_max_avg_power_cf(x, &gold_max, block_size);
+
+    srsran_cfo_init(&srsran_cfo, block_size);
+
+    TEST_CALL(avg_pwr = srsran_cfo_correct_power(&srsran_cfo, x, z, cfo, &max_pwr))
+
+        for (int i = 0; i < block_size; i++) {
+          gold = x[i] * cexpf(_Complex_I * 2.0f * (float)M_PI * i * cfo);
+          mse += cabsf(gold - z[i]) / cabsf(gold);
+        } mse /= block_size;
+    mse += fabsf(gold_avg - avg_pwr) / gold_avg + fabsf(gold_max - max_pwr) / gold_max;
+
+    free(x);
+    free(z);
+    srsran_cfo_free(&srsran_cfo);)
+
 // This test compares the clipping method used for the CFR module in its default configuration to the original CFR
 // algorithm. The original algorithm can still be used by defining CFR_PEAK_EXTRACTION in the CFR module.
 TEST(
@@ -951,6 +1018,10 @@ int main(int argc, char** argv)
         test_srsran_vec_dot_prod_conj_ccc(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
 
+    passed[func_count][size_count] =
+        test_srsran_vec_cf_to_split(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
     passed[func_count][size_count] =
         test_srsran_vec_convert_fi(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
@@ -983,6 +1054,10 @@ int main(int argc, char** argv)
         test_srsran_vec_prod_conj_ccc(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
 
+    passed[func_count][size_count] =
+        test_srsran_vec_prod_sc_ccc(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
     passed[func_count][size_count] =
         test_srsran_vec_sc_prod_ccc(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
@@ -1055,6 +1130,10 @@ int main(int argc, char** argv)
         test_srsran_cfo_correct_change(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
 
+    passed[func_count][size_count] =
+        test_srsran_cfo_correct_power(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
     passed[func_count][size_count] =
         test_srsran_vec_gen_clip_env(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
@@ -1076,7 +1155,7 @@ int main(int argc, char** argv)
     pclose(p);
   }
 
-  printf("\n");
+  printf("\nSIMD kernels: %s\n", srsran_vec_simd_isa());
   printf("%32s |", "Subroutine/MSps");
   if (f)
     fprintf(f, "Subroutine/MSps Vs Vector size\t");
@@ -134,6 +134,14 @@ void srsran_vec_convert_fb(const float* x, const float scale, int8_t* z, const u
   srsran_vec_convert_fb_simd(x, z, scale, len);
 }
 
+void srsran_vec_convert_bf(const int8_t* x, const float scale, float* z, const uint32_t len)
+{
+  const float gain = 1.0f / scale;
+  for (uint32_t i = 0; i < len; i++) {
+    z[i] = ((float)x[i]) * gain;
+  }
+}
+
 void srsran_vec_lut_sss(const short* x, const unsigned short* lut, short* y, const uint32_t len)
 {
   srsran_vec_lut_sss_simd(x, lut, y, len);
@@ -512,6 +520,11 @@ void srsran_vec_prod_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t l
   srsran_vec_prod_ccc_simd(x, y, z, len);
 }
 
+void srsran_vec_prod_sc_ccc(const cf_t* x, const cf_t* y, const cf_t h, cf_t* z, const uint32_t len)
+{
+  srsran_vec_prod_sc_ccc_simd(x, y, h, z, len);
+}
+
 void srsran_vec_prod_ccc_split(const float*   x_re,
                                const float*   x_im,
                                const float*   y_re,
@@ -557,12 +570,7 @@ cf_t srsran_vec_dot_prod_ccc(const cf_t* x, const cf_t* y, const uint32_t len)
 // Convolution filter and in SSS search
 cf_t srsran_vec_dot_prod_cfc(const cf_t* x, const float* y, const uint32_t len)
 {
-  uint32_t i;
-  cf_t     res = 0;
-  for (i = 0; i < len; i++) {
-    res += x[i] * y[i];
-  }
-  return res;
+  return srsran_vec_dot_prod_cfc_simd(x, y, len);
 }
 
 // SYNC
@@ -842,6 +850,16 @@ void srsran_vec_interleave(const cf_t* x, const cf_t* y, cf_t* z, const int len)
   srsran_vec_interleave_simd(x, y, z, len);
 }
 
+void srsran_vec_cf_to_split(const cf_t* x, float* re, float* im, const uint32_t len)
+{
+  srsran_vec_cf_to_split_simd(x, re, im, len);
+}
+
+void srsran_vec_split_to_cf(const float* re, const float* im, cf_t* z, const uint32_t len)
+{
+  srsran_vec_split_to_cf_simd(re, im, z, len);
+}
+
 void srsran_vec_interleave_add(const cf_t* x, const cf_t* y, cf_t* z, const int len)
 {
   srsran_vec_interleave_add_simd(x, y, z, len);
@@ -870,11 +888,38 @@ void srsran_vec_gen_clip_env(const float* x_abs, const float thres, const float
   }
 }
 
+void srsran_vec_gen_clip_peak(const cf_t* x, const float thres, cf_t* peak, const int len)
+{
+  srsran_vec_gen_clip_peak_simd(x, thres, peak, len);
+}
+
+float srsran_vec_max_avg_power_cf(const cf_t* x, float* max_pwr, const uint32_t len)
+{
+  if (!len) {
+    if (max_pwr) {
+      *max_pwr = 0;
+    }
+    return 0;
+  }
+  return srsran_vec_max_acc_power_cf_simd(x, max_pwr, len) / len;
+}
+
+float srsran_vec_prod_ccc_max_avg_power(const cf_t* x, const cf_t* y, cf_t* z, float* max_pwr, const uint32_t len)
+{
+  if (!len) {
+    if (max_pwr) {
+      *max_pwr = 0;
+    }
+    return 0;
+  }
+  return srsran_vec_prod_ccc_max_acc_power_simd(x, y, z, max_pwr, len) / len;
+}
+
 float srsran_vec_papr_c(const cf_t* in, const int len)
 {
-  uint32_t max  = srsran_vec_max_abs_ci(in, len);
-  float    peak = SRSRAN_CSQABS(in[max]);
-  return peak / srsran_vec_avg_power_cf(in, len);
+  float peak = 0.0f;
+  float avg  = srsran_vec_max_avg_power_cf(in, &peak, len);
+  return peak / avg;
 }
 
 float srsran_vec_acpr_c(const cf_t* x_f, const uint32_t win_pos_len, const uint32_t win_neg_len, const uint32_t len)
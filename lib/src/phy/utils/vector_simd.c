@@ -27,6 +27,13 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef SRSRAN_SIMD_DISPATCH
+#ifndef SRSRAN_SIMD_ISA_SUFFIX
+#define SRSRAN_SIMD_ISA_SUFFIX _base
+#endif /* SRSRAN_SIMD_ISA_SUFFIX */
+#include "vector_simd_dispatch.h"
+#endif /* SRSRAN_SIMD_DISPATCH */
+
 #include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector_simd.h"
 
@@ -796,6 +803,51 @@ cf_t srsran_vec_dot_prod_ccc_simd(const cf_t* x, const cf_t* y, const int len)
   return result;
 }
 
+cf_t srsran_vec_dot_prod_cfc_simd(const cf_t* x, const float* y, const int len)
+{
+  int  i      = 0;
+  cf_t result = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  if (len >= SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t simd_result = srsran_simd_cf_zero();
+    if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(y)) {
+      for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+        simd_cf_t xVal = srsran_simd_cfi_load(&x[i]);
+        simd_f_t  yVal = srsran_simd_f_load(&y[i]);
+
+        simd_result = srsran_simd_cf_add(srsran_simd_cf_mul(xVal, yVal), simd_result);
+      }
+    } else {
+      for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+        simd_cf_t xVal = srsran_simd_cfi_loadu(&x[i]);
+        simd_f_t  yVal = srsran_simd_f_loadu(&y[i]);
+
+        simd_result = srsran_simd_cf_add(srsran_simd_cf_mul(xVal, yVal), simd_result);
+      }
+    }
+
+    __attribute__((aligned(64))) float simd_dotProdVector[SRSRAN_SIMD_CF_SIZE];
+    simd_f_t                           acc_re = srsran_simd_cf_re(simd_result);
+    simd_f_t                           acc_im = srsran_simd_cf_im(simd_result);
+
+    simd_f_t acc = srsran_simd_f_hadd(acc_re, acc_im);
+    for (int j = 2; j < SRSRAN_SIMD_F_SIZE; j *= 2) {
+      acc = srsran_simd_f_hadd(acc, acc);
+    }
+    srsran_simd_f_store(simd_dotProdVector, acc);
+    __real__ result = simd_dotProdVector[0];
+    __imag__ result = simd_dotProdVector[1];
+  }
+#endif
+
+  for (; i < len; i++) {
+    result += (x[i] * y[i]);
+  }
+
+  return result;
+}
+
 #ifdef ENABLE_C16
 c16_t srsran_vec_dot_prod_ccc_c16i_simd(const c16_t* x, const c16_t* y, const int len)
 {
@@ -963,6 +1015,107 @@ void srsran_vec_prod_ccc_simd(const cf_t* x, const cf_t* y, cf_t* z, const int l
   }
 }
 
+float srsran_vec_prod_ccc_max_acc_power_simd(const cf_t* x, const cf_t* y, cf_t* z, float* max_pwr, const int len)
+{
+  int   i   = 0;
+  float max = 0.0f;
+  float acc = 0.0f;
+
+#if SRSRAN_SIMD_CF_SIZE
+  if (len >= SRSRAN_SIMD_CF_SIZE) {
+    simd_f_t simd_max = srsran_simd_f_zero();
+    simd_f_t simd_acc = srsran_simd_f_zero();
+    if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(y) && SRSRAN_IS_ALIGNED(z)) {
+      for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+        simd_cf_t a = srsran_simd_cfi_load(&x[i]);
+        simd_cf_t b = srsran_simd_cfi_load(&y[i]);
+
+        simd_cf_t r = srsran_simd_cf_prod(a, b);
+
+        srsran_simd_cfi_store(&z[i], r);
+
+        simd_f_t re  = srsran_simd_cf_re(r);
+        simd_f_t im  = srsran_simd_cf_im(r);
+        simd_f_t pwr = srsran_simd_f_add(srsran_simd_f_mul(re, re), srsran_simd_f_mul(im, im));
+
+        simd_max = srsran_simd_f_select(simd_max, pwr, srsran_simd_f_max(pwr, simd_max));
+        simd_acc = srsran_simd_f_add(simd_acc, pwr);
+      }
+    } else {
+      for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+        simd_cf_t a = srsran_simd_cfi_loadu(&x[i]);
+        simd_cf_t b = srsran_simd_cfi_loadu(&y[i]);
+
+        simd_cf_t r = srsran_simd_cf_prod(a, b);
+
+        srsran_simd_cfi_storeu(&z[i], r);
+
+        simd_f_t re  = srsran_simd_cf_re(r);
+        simd_f_t im  = srsran_simd_cf_im(r);
+        simd_f_t pwr = srsran_simd_f_add(srsran_simd_f_mul(re, re), srsran_simd_f_mul(im, im));
+
+        simd_max = srsran_simd_f_select(simd_max, pwr, srsran_simd_f_max(pwr, simd_max));
+        simd_acc = srsran_simd_f_add(simd_acc, pwr);
+      }
+    }
+
+    srsran_simd_aligned float max_buffer[SRSRAN_SIMD_F_SIZE];
+    srsran_simd_aligned float acc_buffer[SRSRAN_SIMD_F_SIZE];
+    srsran_simd_f_store(max_buffer, simd_max);
+    srsran_simd_f_store(acc_buffer, simd_acc);
+    for (int k = 0; k < SRSRAN_SIMD_F_SIZE; k++) {
+      max = (max_buffer[k] > max) ? max_buffer[k] : max;
+      acc += acc_buffer[k];
+    }
+  }
+#endif
+
+  for (; i < len; i++) {
+    z[i]      = x[i] * y[i];
+    float pwr = __real__(z[i]) * __real__(z[i]) + __imag__(z[i]) * __imag__(z[i]);
+    max       = (pwr > max) ? pwr : max;
+    acc += pwr;
+  }
+
+  if (max_pwr) {
+    *max_pwr = max;
+  }
+  return acc;
+}
+
+void srsran_vec_prod_sc_ccc_simd(const cf_t* x, const cf_t* y, const cf_t h, cf_t* z, const int len)
+{
+  int i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  const simd_cf_t s = srsran_simd_cf_set1(h);
+
+  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(y) && SRSRAN_IS_ALIGNED(z)) {
+    for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t a = srsran_simd_cfi_load(&x[i]);
+      simd_cf_t b = srsran_simd_cfi_load(&y[i]);
+
+      simd_cf_t r = srsran_simd_cf_prod(srsran_simd_cf_prod(a, b), s);
+
+      srsran_simd_cfi_store(&z[i], r);
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t a = srsran_simd_cfi_loadu(&x[i]);
+      simd_cf_t b = srsran_simd_cfi_loadu(&y[i]);
+
+      simd_cf_t r = srsran_simd_cf_prod(srsran_simd_cf_prod(a, b), s);
+
+      srsran_simd_cfi_storeu(&z[i], r);
+    }
+  }
+#endif
+
+  for (; i < len; i++) {
+    z[i] = x[i] * y[i] * h;
+  }
+}
+
 void srsran_vec_prod_ccc_split_simd(const float* a_re,
                                     const float* a_im,
                                     const float* b_re,
@@ -1338,6 +1491,99 @@ void srsran_vec_abs_square_cf_simd(const cf_t* x, float* z, const int len)
   }
 }
 
+float srsran_vec_max_acc_power_cf_simd(const cf_t* x, float* max_pwr, const int len)
+{
+  int   i   = 0;
+  float max = 0.0f;
+  float acc = 0.0f;
+
+#if SRSRAN_SIMD_F_SIZE
+  if (len >= SRSRAN_SIMD_F_SIZE) {
+    simd_f_t simd_max = srsran_simd_f_zero();
+    simd_f_t simd_acc = srsran_simd_f_zero();
+    if (SRSRAN_IS_ALIGNED(x)) {
+      for (; i < len - SRSRAN_SIMD_F_SIZE + 1; i += SRSRAN_SIMD_F_SIZE) {
+        simd_f_t x1 = srsran_simd_f_load((float*)&x[i]);
+        simd_f_t x2 = srsran_simd_f_load((float*)&x[i + SRSRAN_SIMD_F_SIZE / 2]);
+
+        simd_f_t pwr = srsran_simd_f_hadd(srsran_simd_f_mul(x1, x1), srsran_simd_f_mul(x2, x2));
+
+        simd_max = srsran_simd_f_select(simd_max, pwr, srsran_simd_f_max(pwr, simd_max));
+        simd_acc = srsran_simd_f_add(simd_acc, pwr);
+      }
+    } else {
+      for (; i < len - SRSRAN_SIMD_F_SIZE + 1; i += SRSRAN_SIMD_F_SIZE) {
+        simd_f_t x1 = srsran_simd_f_loadu((float*)&x[i]);
+        simd_f_t x2 = srsran_simd_f_loadu((float*)&x[i + SRSRAN_SIMD_F_SIZE / 2]);
+
+        simd_f_t pwr = srsran_simd_f_hadd(srsran_simd_f_mul(x1, x1), srsran_simd_f_mul(x2, x2));
+
+        simd_max = srsran_simd_f_select(simd_max, pwr, srsran_simd_f_max(pwr, simd_max));
+        simd_acc = srsran_simd_f_add(simd_acc, pwr);
+      }
+    }
+
+    srsran_simd_aligned float max_buffer[SRSRAN_SIMD_F_SIZE];
+    srsran_simd_aligned float acc_buffer[SRSRAN_SIMD_F_SIZE];
+    srsran_simd_f_store(max_buffer, simd_max);
+    srsran_simd_f_store(acc_buffer, simd_acc);
+    for (int k = 0; k < SRSRAN_SIMD_F_SIZE; k++) {
+      max = (max_buffer[k] > max) ? max_buffer[k] : max;
+      acc += acc_buffer[k];
+    }
+  }
+#endif
+
+  for (; i < len; i++) {
+    float pwr = __real__(x[i]) * __real__(x[i]) + __imag__(x[i]) * __imag__(x[i]);
+    max       = (pwr > max) ? pwr : max;
+    acc += pwr;
+  }
+
+  if (max_pwr) {
+    *max_pwr = max;
+  }
+  return acc;
+}
+
+void srsran_vec_gen_clip_peak_simd(const cf_t* x, const float thres, cf_t* z, const int len)
+{
+  int i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  const simd_f_t thres_v  = srsran_simd_f_set1(thres);
+  const simd_f_t thres2_v = srsran_simd_f_set1(thres * thres);
+  const simd_f_t one_v    = srsran_simd_f_set1(1.0f);
+  const simd_f_t two_v    = srsran_simd_f_set1(2.0f);
+  const simd_f_t zero_v   = srsran_simd_f_zero();
+
+  for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t a  = srsran_simd_cfi_loadu(&x[i]);
+    simd_f_t  re = srsran_simd_cf_re(a);
+    simd_f_t  im = srsran_simd_cf_im(a);
+
+    simd_f_t   pwr   = srsran_simd_f_add(srsran_simd_f_mul(re, re), srsran_simd_f_mul(im, im));
+    simd_sel_t above = srsran_simd_f_max(pwr, thres2_v);
+
+    // 1 / |x| with one Newton-Raphson step on top of the approximated reciprocal
+    simd_f_t abs = srsran_simd_f_sqrt(pwr);
+    simd_f_t rcp = srsran_simd_f_rcp(abs);
+    rcp          = srsran_simd_f_mul(rcp, srsran_simd_f_sub(two_v, srsran_simd_f_mul(abs, rcp)));
+
+    // The samples below the threshold are discarded, which also masks the reciprocal of zero
+    simd_f_t factor = srsran_simd_f_sub(one_v, srsran_simd_f_mul(thres_v, rcp));
+    factor          = srsran_simd_f_select(zero_v, factor, above);
+
+    srsran_simd_cfi_storeu(&z[i], srsran_simd_cf_mul(a, factor));
+  }
+#endif
+
+  for (; i < len; i++) {
+    float abs = cabsf(x[i]);
+    z[i]      = (abs > thres) ? x[i] * (1.0f - thres / abs) : 0.0f;
+  }
+}
+
 void srsran_vec_sc_prod_cfc_simd(const cf_t* x, const float h, cf_t* z, const int len)
 {
   int i = 0;
@@ -1585,6 +1831,50 @@ uint32_t srsran_vec_max_ci_simd(const cf_t* x, const int len)
   return max_index;
 }
 
+void srsran_vec_cf_to_split_simd(const cf_t* x, float* re, float* im, const int len)
+{
+  int i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  if (SRSRAN_IS_ALIGNED(re) && SRSRAN_IS_ALIGNED(im)) {
+    for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+      srsran_simd_cf_store(&re[i], &im[i], srsran_simd_cfi_loadu_ordered(&x[i]));
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+      srsran_simd_cf_storeu(&re[i], &im[i], srsran_simd_cfi_loadu_ordered(&x[i]));
+    }
+  }
+#endif
+
+  for (; i < len; i++) {
+    re[i] = __real__ x[i];
+    im[i] = __imag__ x[i];
+  }
+}
+
+void srsran_vec_split_to_cf_simd(const float* re, const float* im, cf_t* z, const int len)
+{
+  int i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  if (SRSRAN_IS_ALIGNED(re) && SRSRAN_IS_ALIGNED(im)) {
+    for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+      srsran_simd_cfi_storeu_ordered(&z[i], srsran_simd_cf_load(&re[i], &im[i]));
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+      srsran_simd_cfi_storeu_ordered(&z[i], srsran_simd_cf_loadu(&re[i], &im[i]));
+    }
+  }
+#endif
+
+  for (; i < len; i++) {
+    __real__ z[i] = re[i];
+    __imag__ z[i] = im[i];
+  }
+}
+
 void srsran_vec_interleave_simd(const cf_t* x, const cf_t* y, cf_t* z, const int len)
 {
   uint32_t i = 0, k = 0;
@@ -0,0 +1,99 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/vector_simd.h"
+
+#include "vector_simd_dispatch.h"
+
+#ifdef SRSRAN_SIMD_DISPATCH
+
+/*
+ * vector_simd.c is compiled for the baseline ISA of the build and, in vector_simd_avx2.c and vector_simd_avx512.c, for
+ * AVX2 and AVX512. The public kernel names are GNU indirect functions: the dynamic loader runs the resolvers once, when
+ * the library is loaded, and binds every kernel to the widest build the CPU supports. There is no indirection left in
+ * the calls afterwards.
+ */
+
+typedef enum { SIMD_ISA_BASE = 0, SIMD_ISA_AVX2, SIMD_ISA_AVX512 } simd_isa_t;
+
+/* The resolvers run before the relocations are processed, only compiler builtins can be used here */
+static simd_isa_t simd_isa_detect()
+{
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512cd") && __builtin_cpu_supports("avx512bw") &&
+      __builtin_cpu_supports("avx512dq")) {
+    return SIMD_ISA_AVX512;
+  }
+
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return SIMD_ISA_AVX2;
+  }
+
+  return SIMD_ISA_BASE;
+}
+
+#define SIMD_DISPATCH(NAME)                                                                                            \
+  extern __typeof__(NAME) NAME##_base, NAME##_avx2, NAME##_avx512;                                                     \
+  static __typeof__(NAME)* NAME##_resolve()                                                                            \
+  {                                                                                                                    \
+    switch (simd_isa_detect()) {                                                                                       \
+      case SIMD_ISA_AVX512:                                                                                            \
+        return NAME##_avx512;                                                                                          \
+      case SIMD_ISA_AVX2:                                                                                              \
+        return NAME##_avx2;                                                                                            \
+      default:                                                                                                         \
+        return NAME##_base;                                                                                            \
+    }                                                                                                                  \
+  }                                                                                                                    \
+  __typeof__(NAME) NAME __attribute__((ifunc(#NAME "_resolve")));
+
+SRSRAN_VEC_SIMD_FUNCTIONS(SIMD_DISPATCH)
+
+#endif /* SRSRAN_SIMD_DISPATCH */
+
+const char* srsran_vec_simd_isa()
+{
+#ifdef SRSRAN_SIMD_DISPATCH
+  switch (simd_isa_detect()) {
+    case SIMD_ISA_AVX512:
+      return "avx512";
+    case SIMD_ISA_AVX2:
+      return "avx2";
+    default:
+      break;
+  }
+#endif /* SRSRAN_SIMD_DISPATCH */
+
+#if defined(LV_HAVE_AVX512)
+  return "avx512";
+#elif defined(LV_HAVE_AVX2)
+  return "avx2";
+#elif defined(LV_HAVE_AVX)
+  return "avx";
+#elif defined(LV_HAVE_SSE)
+  return "sse";
+#elif defined(HAVE_NEON)
+  return "neon";
+#else
+  return "generic";
+#endif
+}
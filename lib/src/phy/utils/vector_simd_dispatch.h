@@ -0,0 +1,154 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         vector_simd_dispatch.h
+ *
+ *  Description:  Private helpers for the run-time selection of the SIMD vector
+ *                kernels (ENABLE_SIMD_DISPATCH). vector_simd.c is compiled once
+ *                per ISA, every build renames the kernels with its own suffix
+ *                and vector_simd_dispatch.c binds the public names to the best
+ *                build the CPU supports.
+ *
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_VECTOR_SIMD_DISPATCH_H
+#define SRSRAN_VECTOR_SIMD_DISPATCH_H
+
+#ifdef ENABLE_C16
+#define SRSRAN_VEC_SIMD_C16_FUNCTIONS(F) F(srsran_vec_prod_ccc_c16_simd) F(srsran_vec_dot_prod_ccc_c16i_simd)
+#else /* ENABLE_C16 */
+#define SRSRAN_VEC_SIMD_C16_FUNCTIONS(F)
+#endif /* ENABLE_C16 */
+
+/* List of the kernels exported by vector_simd.c */
+#define SRSRAN_VEC_SIMD_FUNCTIONS(F)                                                                                   \
+  F(srsran_vec_xor_bbb_simd)                                                                                           \
+  F(srsran_vec_sum_sss_simd)                                                                                           \
+  F(srsran_vec_sub_sss_simd)                                                                                           \
+  F(srsran_vec_sub_bbb_simd)                                                                                           \
+  F(srsran_vec_acc_ff_simd)                                                                                            \
+  F(srsran_vec_acc_cc_simd)                                                                                            \
+  F(srsran_vec_add_fff_simd)                                                                                           \
+  F(srsran_vec_sub_fff_simd)                                                                                           \
+  F(srsran_vec_sc_sum_fff_simd)                                                                                        \
+  F(srsran_vec_sc_prod_cfc_simd)                                                                                       \
+  F(srsran_vec_sc_prod_fcc_simd)                                                                                       \
+  F(srsran_vec_sc_prod_fff_simd)                                                                                       \
+  F(srsran_vec_sc_prod_ccc_simd)                                                                                       \
+  F(srsran_vec_sc_prod_ccc_simd2)                                                                                      \
+  F(srsran_vec_prod_ccc_split_simd)                                                                                    \
+  F(srsran_vec_prod_sss_simd)                                                                                          \
+  F(srsran_vec_neg_sss_simd)                                                                                           \
+  F(srsran_vec_neg_bbb_simd)                                                                                           \
+  F(srsran_vec_prod_cfc_simd)                                                                                          \
+  F(srsran_vec_prod_fff_simd)                                                                                          \
+  F(srsran_vec_prod_ccc_simd)                                                                                          \
+  F(srsran_vec_prod_conj_ccc_simd)                                                                                     \
+  F(srsran_vec_prod_sc_ccc_simd)                                                                                       \
+  F(srsran_vec_div_ccc_simd)                                                                                           \
+  F(srsran_vec_div_cfc_simd)                                                                                           \
+  F(srsran_vec_div_fff_simd)                                                                                           \
+  F(srsran_vec_dot_prod_conj_ccc_simd)                                                                                 \
+  F(srsran_vec_dot_prod_ccc_simd)                                                                                      \
+  F(srsran_vec_dot_prod_sss_simd)                                                                                      \
+  F(srsran_vec_abs_cf_simd)                                                                                            \
+  F(srsran_vec_abs_square_cf_simd)                                                                                     \
+  F(srsran_vec_max_acc_power_cf_simd)                                                                                  \
+  F(srsran_vec_gen_clip_peak_simd)                                                                                     \
+  F(srsran_vec_lut_sss_simd)                                                                                           \
+  F(srsran_vec_lut_bbb_simd)                                                                                           \
+  F(srsran_vec_convert_if_simd)                                                                                        \
+  F(srsran_vec_convert_fi_simd)                                                                                        \
+  F(srsran_vec_convert_conj_cs_simd)                                                                                   \
+  F(srsran_vec_convert_fb_simd)                                                                                        \
+  F(srsran_vec_interleave_simd)                                                                                        \
+  F(srsran_vec_interleave_add_simd)                                                                                    \
+  F(srsran_vec_cf_to_split_simd)                                                                                       \
+  F(srsran_vec_split_to_cf_simd)                                                                                       \
+  F(srsran_vec_gen_sine_simd)                                                                                          \
+  F(srsran_vec_apply_cfo_simd)                                                                                         \
+  F(srsran_vec_estimate_frequency_simd)                                                                                \
+  F(srsran_vec_max_fi_simd)                                                                                            \
+  F(srsran_vec_max_abs_fi_simd)                                                                                        \
+  F(srsran_vec_max_ci_simd)                                                                                            \
+  SRSRAN_VEC_SIMD_C16_FUNCTIONS(F)
+
+#define SRSRAN_SIMD_ISA_NAME__(NAME, SUFFIX) NAME##SUFFIX
+#define SRSRAN_SIMD_ISA_NAME_(NAME, SUFFIX) SRSRAN_SIMD_ISA_NAME__(NAME, SUFFIX)
+#define SRSRAN_SIMD_ISA_NAME(NAME) SRSRAN_SIMD_ISA_NAME_(NAME, SRSRAN_SIMD_ISA_SUFFIX)
+
+#ifdef SRSRAN_SIMD_ISA_SUFFIX
+#define srsran_vec_xor_bbb_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_xor_bbb_simd)
+#define srsran_vec_sum_sss_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_sum_sss_simd)
+#define srsran_vec_sub_sss_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_sub_sss_simd)
+#define srsran_vec_sub_bbb_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_sub_bbb_simd)
+#define srsran_vec_acc_ff_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_acc_ff_simd)
+#define srsran_vec_acc_cc_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_acc_cc_simd)
+#define srsran_vec_add_fff_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_add_fff_simd)
+#define srsran_vec_sub_fff_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_sub_fff_simd)
+#define srsran_vec_sc_sum_fff_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_sc_sum_fff_simd)
+#define srsran_vec_sc_prod_cfc_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_sc_prod_cfc_simd)
+#define srsran_vec_sc_prod_fcc_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_sc_prod_fcc_simd)
+#define srsran_vec_sc_prod_fff_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_sc_prod_fff_simd)
+#define srsran_vec_sc_prod_ccc_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_sc_prod_ccc_simd)
+#define srsran_vec_sc_prod_ccc_simd2 SRSRAN_SIMD_ISA_NAME(srsran_vec_sc_prod_ccc_simd2)
+#define srsran_vec_prod_ccc_split_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_prod_ccc_split_simd)
+#define srsran_vec_prod_ccc_c16_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_prod_ccc_c16_simd)
+#define srsran_vec_prod_sss_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_prod_sss_simd)
+#define srsran_vec_neg_sss_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_neg_sss_simd)
+#define srsran_vec_neg_bbb_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_neg_bbb_simd)
+#define srsran_vec_prod_cfc_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_prod_cfc_simd)
+#define srsran_vec_prod_fff_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_prod_fff_simd)
+#define srsran_vec_prod_ccc_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_prod_ccc_simd)
+#define srsran_vec_prod_conj_ccc_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_prod_conj_ccc_simd)
+#define srsran_vec_prod_sc_ccc_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_prod_sc_ccc_simd)
+#define srsran_vec_div_ccc_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_div_ccc_simd)
+#define srsran_vec_div_cfc_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_div_cfc_simd)
+#define srsran_vec_div_fff_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_div_fff_simd)
+#define srsran_vec_dot_prod_conj_ccc_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_dot_prod_conj_ccc_simd)
+#define srsran_vec_dot_prod_ccc_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_dot_prod_ccc_simd)
+#define srsran_vec_dot_prod_ccc_c16i_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_dot_prod_ccc_c16i_simd)
+#define srsran_vec_dot_prod_sss_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_dot_prod_sss_simd)
+#define srsran_vec_abs_cf_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_abs_cf_simd)
+#define srsran_vec_abs_square_cf_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_abs_square_cf_simd)
+#define srsran_vec_max_acc_power_cf_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_max_acc_power_cf_simd)
+#define srsran_vec_gen_clip_peak_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_gen_clip_peak_simd)
+#define srsran_vec_lut_sss_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_lut_sss_simd)
+#define srsran_vec_lut_bbb_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_lut_bbb_simd)
+#define srsran_vec_convert_if_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_convert_if_simd)
+#define srsran_vec_convert_fi_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_convert_fi_simd)
+#define srsran_vec_convert_conj_cs_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_convert_conj_cs_simd)
+#define srsran_vec_convert_fb_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_convert_fb_simd)
+#define srsran_vec_interleave_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_interleave_simd)
+#define srsran_vec_interleave_add_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_interleave_add_simd)
+#define srsran_vec_cf_to_split_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_cf_to_split_simd)
+#define srsran_vec_split_to_cf_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_split_to_cf_simd)
+#define srsran_vec_gen_sine_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_gen_sine_simd)
+#define srsran_vec_apply_cfo_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_apply_cfo_simd)
+#define srsran_vec_estimate_frequency_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_estimate_frequency_simd)
+#define srsran_vec_max_fi_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_max_fi_simd)
+#define srsran_vec_max_abs_fi_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_max_abs_fi_simd)
+#define srsran_vec_max_ci_simd SRSRAN_SIMD_ISA_NAME(srsran_vec_max_ci_simd)
+#endif // SRSRAN_SIMD_ISA_SUFFIX
+
+#endif // SRSRAN_VECTOR_SIMD_DISPATCH_H
@@ -47,6 +47,14 @@ radio::~radio()
   for (srsran_resampler_fft_t& q : decimators) {
     srsran_resampler_fft_free(&q);
   }
+
+  for (srsran_resampler_poly_t& q : tx_resamplers) {
+    srsran_resampler_poly_free(&q);
+  }
+
+  for (srsran_resampler_poly_t& q : rx_resamplers) {
+    srsran_resampler_poly_free(&q);
+  }
 }
 
 int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
@@ -107,6 +115,10 @@ int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
   rf_devices.resize(device_args_list.size());
   rf_info.resize(device_args_list.size());
   rx_offset_n.resize(device_args_list.size());
+  dev_timing.clear();
+  for (uint32_t i = 0; i < device_args_list.size(); i++) {
+    dev_timing.emplace_back(new dev_timing_t);
+  }
 
   tx_channel_mapping.set_config(nof_channels_x_dev, nof_antennas);
   rx_channel_mapping.set_config(nof_channels_x_dev, nof_antennas);
@@ -295,25 +307,32 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
 
   // Extract decimation ratio. As the decimation may take some time to set a new ratio, deactivate the decimation and
   // keep receiving samples to avoid stalling the RX stream
-  uint32_t ratio = 1; // No decimation by default
+  uint32_t ratio    = 1; // No decimation by default
+  bool     resample = false;
   if (decimator_busy) {
     lock.unlock();
+  } else if (rx_resamplers[0].L != 0) {
+    resample = true;
   } else if (decimators[0].ratio > 1) {
     ratio = decimators[0].ratio;
   }
 
-  // Calculate number of samples, considering the decimation ratio
+  // Calculate number of samples, considering the decimation ratio. The polyphase resampler keeps track of the fractional
+  // phase, so it provides the exact number of samples needed for the requested output
   uint32_t nof_samples = buffer.get_nof_samples() * ratio;
+  if (resample) {
+    nof_samples = srsran_resampler_poly_nof_input(&rx_resamplers[0], buffer.get_nof_samples());
+  }
 
   // Check decimation buffer protection
-  if (ratio > 1 && nof_samples > rx_buffer[0].size()) {
+  if ((ratio > 1 || resample) && nof_samples > rx_buffer[0].size()) {
     // This is a corner case that could happen during sample rate change transitions, as it does not have a negative
     // impact, log it as info.
     fmt::memory_buffer buff;
     fmt::format_to(buff,
                    "Rx number of samples ({}/{}) exceeds buffer size ({})",
                    buffer.get_nof_samples(),
-                   buffer.get_nof_samples() * ratio,
+                   nof_samples,
                    rx_buffer[0].size());
     logger.info("%s", to_c_str(buff));
 
@@ -327,7 +346,7 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
   // If the interpolator have been set, interpolate
   for (uint32_t ch = 0; ch < nof_channels; ch++) {
     // Use rx buffer if decimator is required
-    buffer_rx.set(ch, ratio > 1 ? rx_buffer[ch].data() : buffer.get(ch));
+    buffer_rx.set(ch, (ratio > 1 || resample) ? rx_buffer[ch].data() : buffer.get(ch));
   }
 
   if (not radio_is_streaming) {
@@ -357,6 +376,15 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
     }
   }
 
+  // Perform rational resampling
+  if (resample) {
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      if (buffer.get(ch) and buffer_rx.get(ch)) {
+        srsran_resampler_poly_run(&rx_resamplers[ch], buffer_rx.get(ch), buffer.get(ch), buffer_rx.get_nof_samples());
+      }
+    }
+  }
+
   return ret;
 }
 
@@ -397,8 +425,12 @@ bool radio::rx_dev(const uint32_t& device_idx, const rf_buffer_interface& buffer
   // Subtract number of offset samples
   rx_offset_n.at(device_idx) = nof_samples_offset - ((int)nof_samples - (int)buffer.get_nof_samples());
 
-  int ret =
+  auto rx_start = std::chrono::steady_clock::now();
+  int  ret =
       srsran_rf_recv_with_time_multi(&rf_devices[device_idx], radio_buffers, nof_samples, true, full_secs, frac_secs);
+  if (ret > 0) {
+    record_rx_timing(device_idx, std::chrono::steady_clock::now() - rx_start, rxd_time, nof_samples);
+  }
 
   // If the number of received samples filled the buffer, there is nothing else to do
   if (buffer.get_nof_samples() <= nof_samples) {
@@ -442,8 +474,26 @@ bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_tim
     nof_samples = tx_buffer[0].size() / ratio;
   }
 
-  // If the interpolator have been set, interpolate
-  if (interpolators[0].ratio > 1) {
+  // If the rational resampler has been set, resample. The number of output samples depends on the resampler phase
+  if (tx_resamplers[0].L != 0) {
+    // Limit number of samples to transmit
+    if (srsran_resampler_poly_nof_output(&tx_resamplers[0], nof_samples) > tx_buffer[0].size()) {
+      logger.info("Tx number of samples (%d) exceeds buffer size (%zd)", nof_samples, tx_buffer[0].size());
+      nof_samples = (uint32_t)(((uint64_t)(tx_buffer[0].size() - 1) * tx_resamplers[0].M) / tx_resamplers[0].L);
+    }
+
+    uint32_t nof_resampled = 0;
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      nof_resampled = srsran_resampler_poly_run(&tx_resamplers[ch], buffer.get(ch), tx_buffer[ch].data(), nof_samples);
+
+      // Set the buffer pointer
+      buffer.set(ch, tx_buffer[ch].data());
+    }
+
+    // Set buffer size after applying the resampling
+    buffer.set_nof_samples(nof_resampled);
+  } else if (interpolators[0].ratio > 1) {
+    // If the interpolator have been set, interpolate
     for (uint32_t ch = 0; ch < nof_channels; ch++) {
       // Perform actual interpolation
       srsran_resampler_fft_run(&interpolators[ch], buffer.get(ch), tx_buffer[ch].data(), nof_samples);
@@ -543,6 +593,8 @@ bool radio::tx_dev(const uint32_t& device_idx, rf_buffer_interface& buffer, cons
     srsran_timestamp_add(&tx_time, 0, tx_adv_sec);
   }
 
+  record_tx_timing(device_idx, tx_time);
+
   // Calculates transmission time overlap with previous transmission
   srsran_timestamp_t ts_overlap = end_of_burst_time[device_idx];
   srsran_timestamp_sub(&ts_overlap, tx_time.full_secs, tx_time.frac_secs);
@@ -746,17 +798,22 @@ void radio::set_rx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_rx_srate % (uint32_t)srate) == 0,
-                  "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
-                  cur_rx_srate / 1e6,
-                  srate / 1e6,
-                  cur_rx_srate / srate);
-
-    // Update decimators
-    uint32_t ratio = (uint32_t)ceil(cur_rx_srate / srate);
-    for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+    // Update decimators if the ratio is integer, otherwise use the polyphase resamplers
+    uint32_t fix_srate = (uint32_t)round(cur_rx_srate);
+    uint32_t new_srate = (uint32_t)round(srate);
+    if (fix_srate % new_srate == 0) {
+      uint32_t ratio = fix_srate / new_srate;
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_poly_free(&rx_resamplers[ch]);
+        srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+      }
+    } else {
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_free(&decimators[ch]);
+        if (srsran_resampler_poly_init(&rx_resamplers[ch], new_srate, fix_srate) < SRSRAN_SUCCESS) {
+          logger.error("Error initialising Rx resampler %.2f MHz / %.2f MHz", cur_rx_srate / 1e6, srate / 1e6);
+        }
+      }
     }
 
     decimator_busy = false;
@@ -1002,17 +1059,22 @@ void radio::set_tx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_tx_srate % (uint32_t)srate) == 0,
-                  "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
-                  cur_rx_srate / 1e6,
-                  srate / 1e6,
-                  cur_rx_srate / srate);
-
-    // Update interpolators
-    uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
-    for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+    // Update interpolators if the ratio is integer, otherwise use the polyphase resamplers
+    uint32_t fix_srate = (uint32_t)round(cur_tx_srate);
+    uint32_t new_srate = (uint32_t)round(srate);
+    if (fix_srate % new_srate == 0) {
+      uint32_t ratio = fix_srate / new_srate;
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_poly_free(&tx_resamplers[ch]);
+        srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+      }
+    } else {
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_free(&interpolators[ch]);
+        if (srsran_resampler_poly_init(&tx_resamplers[ch], new_srate, fix_srate) < SRSRAN_SUCCESS) {
+          logger.error("Error initialising Tx resampler %.2f MHz / %.2f MHz", cur_tx_srate / 1e6, srate / 1e6);
+        }
+      }
     }
   } else {
     for (srsran_rf_t& rf_device : rf_devices) {
@@ -1039,12 +1101,78 @@ srsran_rf_info_t* radio::get_info()
 
 bool radio::get_metrics(rf_metrics_t* metrics)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  *metrics   = rf_metrics;
-  rf_metrics = {};
+  {
+    std::lock_guard<std::mutex> lock(metrics_mutex);
+    *metrics   = rf_metrics;
+    rf_metrics = {};
+  }
+
+  metrics->dev.resize(dev_timing.size());
+  for (uint32_t i = 0; i < dev_timing.size(); i++) {
+    metrics->dev[i].tx_lead     = dev_timing[i]->tx_lead.get_metrics_and_reset();
+    metrics->dev[i].rx_latency  = dev_timing[i]->rx_latency.get_metrics_and_reset();
+    metrics->dev[i].rx_backlog  = dev_timing[i]->rx_backlog.get_metrics_and_reset();
+    metrics->dev[i].nof_tx_late = dev_timing[i]->nof_tx_late.exchange(0, std::memory_order_relaxed);
+  }
   return true;
 }
 
+static int64_t timestamp_to_ns(const srsran_timestamp_t& ts)
+{
+  return static_cast<int64_t>(ts.full_secs) * 1000000000 + static_cast<int64_t>(ts.frac_secs * 1e9);
+}
+
+static int64_t steady_now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void radio::record_rx_timing(uint32_t                  device_idx,
+                             std::chrono::nanoseconds  call_duration,
+                             const srsran_timestamp_t* rxd_time,
+                             uint32_t                  nof_samples)
+{
+  dev_timing_t& t = *dev_timing[device_idx];
+  t.rx_latency(call_duration);
+  if (rxd_time == nullptr or cur_rx_srate <= 0) {
+    return;
+  }
+
+  // The samples queued in the driver grow when the RX calls advance the device time faster than the wall clock. A call
+  // that waited for most of its samples found the queue empty
+  int64_t rx_dur_ns  = static_cast<int64_t>(nof_samples * 1e9 / cur_rx_srate);
+  int64_t rx_end_ns  = timestamp_to_ns(*rxd_time) + rx_dur_ns;
+  int64_t rx_wall_ns = steady_now_ns();
+  if (t.last_rx_wall_ns != 0) {
+    t.backlog_ns += (rx_end_ns - t.last_rx_end_ns) - (rx_wall_ns - t.last_rx_wall_ns);
+  }
+  if (t.backlog_ns < 0 or t.backlog_ns > 1000000000 or call_duration.count() >= rx_dur_ns / 2) {
+    // Also restart the estimation on timestamp discontinuities, e.g. after a sampling rate change
+    t.backlog_ns = 0;
+  }
+  t.last_rx_end_ns  = rx_end_ns;
+  t.last_rx_wall_ns = rx_wall_ns;
+  t.rx_backlog(std::chrono::nanoseconds(t.backlog_ns));
+
+  t.clock_offset_ns.store(rx_end_ns + t.backlog_ns - rx_wall_ns, std::memory_order_relaxed);
+  t.clock_valid.store(true, std::memory_order_release);
+}
+
+void radio::record_tx_timing(uint32_t device_idx, const srsran_timestamp_t& tx_time)
+{
+  dev_timing_t& t = *dev_timing[device_idx];
+  if (not t.clock_valid.load(std::memory_order_acquire)) {
+    return;
+  }
+  int64_t lead_ns = timestamp_to_ns(tx_time) - (steady_now_ns() + t.clock_offset_ns.load(std::memory_order_relaxed));
+  if (lead_ns < 0) {
+    t.nof_tx_late.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  t.tx_lead(std::chrono::nanoseconds(lead_ns));
+}
+
 void radio::handle_rf_msg(srsran_rf_error_t error)
 {
   if (!is_initialized) {
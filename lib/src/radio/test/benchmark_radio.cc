@@ -19,8 +19,10 @@
  *
  */
 
+#include <cinttypes>
 #include <pthread.h>
 #include <sys/mman.h>
+#include <sys/resource.h>
 #include <unistd.h>
 
 #ifdef __cplusplus
@@ -34,6 +36,7 @@ extern "C" {
 //#undef I // Fix complex.h #define I nastiness when using C++
 #endif
 
+#include "srsran/common/time_prof.h"
 #include "srsran/common/tsan_options.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/radio/radio.h"
@@ -49,9 +52,10 @@ static std::string file_pattern = "radio%d.dat";
 static double      freq         = 2630e6;
 static uint32_t    nof_radios   = 1;
 static uint32_t    nof_ports    = 1;
+static uint32_t    nof_carriers = 1;
 static double      srate        = 1.92e6; /* Hz */
 static double      duration     = 0.01;   /* in seconds, 10 ms by default */
-static cf_t*       buffers[SRSRAN_MAX_RADIOS][SRSRAN_MAX_PORTS];
+static cf_t*       buffers[SRSRAN_MAX_RADIOS][SRSRAN_MAX_CHANNELS];
 static bool        tx_enable       = false;
 static bool        sim_rate_change = false;
 static bool        measure_delay   = false;
@@ -61,6 +65,13 @@ static float       rf_gain         = -1.0;
 
 static pthread_t radio_thread;
 
+/* Duration of the calls into each radio, from the benchmark point of view */
+struct radio_call_stats_t {
+  srsran::tprof_histogram rx_now{"rx_now"};
+  srsran::tprof_histogram tx{"tx"};
+};
+static radio_call_stats_t call_stats[SRSRAN_MAX_RADIOS];
+
 #ifdef ENABLE_GUI
 #include "srsgui/srsgui.h"
 #include <semaphore.h>
@@ -79,7 +90,7 @@ static bool fft_plot_enable = false;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [foabcderpstvhmFxw]\n", prog);
+  printf("Usage: %s [foabcderpkstvhmFxw]\n", prog);
   printf("\t-f Carrier frequency in Hz [Default %f]\n", freq);
   printf("\t-g RF gain [Default AGC]\n");
   printf("\t-a Arguments for first radio [Default %s]\n", radios_args[0].c_str());
@@ -88,6 +99,7 @@ void usage(char* prog)
   printf("\t-d Radio device [Default %s]\n", radio_device);
   printf("\t-r number of radios 1-%d [Default %d]\n", SRSRAN_MAX_RADIOS, nof_radios);
   printf("\t-p number of ports 1-%d [Default %d]\n", SRSRAN_MAX_PORTS, nof_ports);
+  printf("\t-k number of carriers per radio 1-%d [Default %d]\n", SRSRAN_MAX_CARRIERS, nof_carriers);
   printf("\t-s sampling rate [Default %.0f]\n", srate);
   printf("\t-t duration in seconds [Default %.3f]\n", duration);
   printf("\t-m measure delay [Default %s]\n", (measure_delay) ? "enabled" : "disabled");
@@ -103,7 +115,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "foabcderpsStvhmFxywg")) != -1) {
+  while ((opt = getopt(argc, argv, "foabcderpksStvhmFxywg")) != -1) {
     switch (opt) {
       case 'f':
         freq = strtof(argv[optind], NULL);
@@ -134,6 +146,9 @@ void parse_args(int argc, char** argv)
       case 'p':
         nof_ports = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'k':
+        nof_carriers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 's':
         srate = strtof(argv[optind], NULL);
         break;
@@ -277,6 +292,27 @@ private:
 
 static int ret = SRSRAN_ERROR;
 
+static double rusage_cpu_seconds(const struct rusage& ru)
+{
+  return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+
+static void print_call_stats(uint32_t radio_idx, const srsran::tprof_histogram_metrics_t& m)
+{
+  if (m.count == 0) {
+    return;
+  }
+  printf("Radio %d %-6s %8" PRIu64 " calls: avg %7.1f us, p50 %7.1f us, p99 %7.1f us, p99.9 %7.1f us, max %7.1f us\n",
+         radio_idx,
+         m.name.c_str(),
+         m.count,
+         m.avg_us,
+         m.p50_us,
+         m.p99_us,
+         m.p999_us,
+         m.max_us);
+}
+
 static void* radio_thread_run(void* arg)
 {
   radio*                 radio_h[SRSRAN_MAX_RADIOS] = {nullptr};
@@ -288,6 +324,7 @@ static void* radio_thread_run(void* arg)
   srsran_agc_t           agc[SRSRAN_MAX_RADIOS] = {};
   phy_dummy              phy;
   srsran::rf_metrics_t   rf_metrics = {};
+  uint32_t               nof_late = 0, nof_overflows = 0, nof_underflows = 0;
 
   rf_buffer_t rf_buffers[SRSRAN_MAX_RADIOS] = {};
 
@@ -296,10 +333,25 @@ static void* radio_thread_run(void* arg)
 
   double current_rate = srate;
 
+  /* Sustained throughput and CPU usage of the streaming loop */
+  uint32_t                              nof_channels   = nof_ports * nof_carriers;
+  uint64_t                              stream_samples = 0; /* received samples of each channel */
+  double                                stream_time    = 0; /* in seconds, duration of the received samples */
+  std::chrono::steady_clock::time_point stream_start   = {};
+  struct rusage                         ru_start = {}, ru_end = {};
+
   uint64_t nof_samples = (uint64_t)(duration * srate);
   uint32_t frame_size  = (uint32_t)(srate / 1000.0); /* 1 ms at srate */
   uint32_t nof_frames  = (uint32_t)ceil(nof_samples / frame_size);
 
+  if (nof_channels > SRSRAN_MAX_CHANNELS) {
+    ERROR("Error: %d ports x %d carriers exceeds the maximum number of channels (%d)",
+          nof_ports,
+          nof_carriers,
+          SRSRAN_MAX_CHANNELS);
+    goto clean_exit;
+  }
+
   /* Instanciate and allocate memory */
   printf("Instantiating objects and allocating memory...\n");
   for (uint32_t r = 0; r < nof_radios; r++) {
@@ -309,16 +361,16 @@ static void* radio_thread_run(void* arg)
       goto clean_exit;
     }
 
-    for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
-      buffers[r][p] = NULL;
+    for (uint32_t ch = 0; ch < SRSRAN_MAX_CHANNELS; ch++) {
+      buffers[r][ch] = NULL;
     }
   }
 
   for (uint32_t r = 0; r < nof_radios; r++) {
-    for (uint32_t p = 0; p < nof_ports; p++) {
-      buffers[r][p] = srsran_vec_cf_malloc(frame_size);
-      if (!buffers[r][p]) {
-        ERROR("Error: Allocating buffer (%d,%d)", r, p);
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      buffers[r][ch] = srsran_vec_cf_malloc(frame_size);
+      if (!buffers[r][ch]) {
+        ERROR("Error: Allocating buffer (%d,%d)", r, ch);
         goto clean_exit;
       }
     }
@@ -344,7 +396,7 @@ static void* radio_thread_run(void* arg)
   for (uint32_t r = 0; r < nof_radios; r++) {
     rf_args_t radio_args    = {};
     radio_args.nof_antennas = nof_ports;
-    radio_args.nof_carriers = 1;
+    radio_args.nof_carriers = nof_carriers;
     radio_args.device_args  = radios_args[r].empty() ? "auto" : radios_args[r];
     radio_args.rx_gain      = agc_enable ? -1 : rf_gain;
     radio_args.tx_gain      = agc_enable ? -1 : rf_gain;
@@ -355,7 +407,13 @@ static void* radio_thread_run(void* arg)
       goto clean_exit;
     }
 
-    radio_h[r]->set_rx_freq(0, freq);
+    // Carriers are 20 MHz apart, the channels of a carrier are mapped once its frequency is set
+    for (uint32_t c = 0; c < nof_carriers; c++) {
+      radio_h[r]->set_rx_freq(c, freq + c * 20e6);
+      if (tx_enable) {
+        radio_h[r]->set_tx_freq(c, freq + c * 20e6);
+      }
+    }
 
     // enable and init agc
     if (agc_enable) {
@@ -412,11 +470,14 @@ static void* radio_thread_run(void* arg)
       "Start capturing %d sub-frames of %d samples (approx. %ds) ...\n", nof_frames, frame_size, (nof_frames / 1000));
 
   for (int i = 0; i < SRSRAN_MAX_RADIOS; i++) {
-    for (int j = 0; j < SRSRAN_MAX_PORTS; j++) {
+    for (int j = 0; j < SRSRAN_MAX_CHANNELS; j++) {
       rf_buffers[i].set(j, buffers[i][j]);
     }
   }
 
+  getrusage(RUSAGE_SELF, &ru_start);
+  stream_start = std::chrono::steady_clock::now();
+
   for (uint32_t i = 0; i < nof_frames; i++) {
     if (sim_rate_change) {
       if (i % 1000 == 0) {
@@ -442,8 +503,12 @@ static void* radio_thread_run(void* arg)
     // receive each radio
     for (uint32_t r = 0; r < nof_radios; r++) {
       rf_buffers[r].set_nof_samples(frame_size);
+      auto call_start = std::chrono::steady_clock::now();
       radio_h[r]->rx_now(rf_buffers[r], ts_rx[r]);
+      call_stats[r].rx_now(std::chrono::steady_clock::now() - call_start);
     }
+    stream_samples += frame_size;
+    stream_time += frame_size / current_rate;
 
     // run agc
     if (agc_enable) {
@@ -458,14 +523,16 @@ static void* radio_thread_run(void* arg)
         ts_tx.copy(ts_rx[r]);
         ts_tx.add(0.004);
         rf_buffers[r].set_nof_samples(frame_size);
+        auto call_start = std::chrono::steady_clock::now();
         radio_h[r]->tx(rf_buffers[r], ts_tx);
+        call_stats[r].tx(std::chrono::steady_clock::now() - call_start);
       }
     }
 
     /* Store baseband in file */
     if (capture) {
       for (uint32_t r = 0; r < nof_radios; r++) {
-        srsran_filesink_write_multi(&filesink[r], (void**)buffers[r], frame_size, nof_ports);
+        srsran_filesink_write_multi(&filesink[r], (void**)buffers[r], frame_size, nof_channels);
       }
     }
 
@@ -544,15 +611,45 @@ static void* radio_thread_run(void* arg)
     nof_samples -= frame_size;
   }
 
-  radio_h[0]->get_metrics(&rf_metrics);
+  getrusage(RUSAGE_SELF, &ru_end);
+  {
+    double wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - stream_start).count();
+    double cpu_time  = rusage_cpu_seconds(ru_end) - rusage_cpu_seconds(ru_start);
+    printf("Streamed %.3f s of samples in %.3f s (%.2fx real time), %.2f Msps over %d radios x %d channels\n",
+           stream_time,
+           wall_time,
+           stream_time / wall_time,
+           (double)(stream_samples * nof_radios * nof_channels) / wall_time / 1e6,
+           nof_radios,
+           nof_channels);
+    printf("CPU time %.3f s, %.1f%% of one core\n", cpu_time, 100.0 * cpu_time / wall_time);
+  }
+
+  for (uint32_t r = 0; r < nof_radios; r++) {
+    radio_h[r]->get_metrics(&rf_metrics);
+    nof_late += rf_metrics.rf_l;
+    nof_overflows += rf_metrics.rf_o;
+    nof_underflows += rf_metrics.rf_u;
+
+    print_call_stats(r, call_stats[r].rx_now.get_metrics_and_reset());
+    print_call_stats(r, call_stats[r].tx.get_metrics_and_reset());
+    for (uint32_t d = 0; d < rf_metrics.dev.size(); d++) {
+      printf("Radio %d device %d: driver rx avg %.1f us, p50 %.1f us, p99.9 %.1f us\n",
+             r,
+             d,
+             rf_metrics.dev[d].rx_latency.avg_us,
+             rf_metrics.dev[d].rx_latency.p50_us,
+             rf_metrics.dev[d].rx_latency.p999_us);
+    }
+  }
 
   printf("Finished streaming with %d gaps, %d late timestamps, %d overflows, %d underflow...\n",
          nof_gaps,
-         rf_metrics.rf_l,
-         rf_metrics.rf_o,
-         rf_metrics.rf_u);
+         nof_late,
+         nof_overflows,
+         nof_underflows);
 
-  if (nof_gaps == 0 && rf_metrics.rf_l == 0 && rf_metrics.rf_o == 0 && rf_metrics.rf_u == 0) {
+  if (nof_gaps == 0 && nof_late == 0 && nof_overflows == 0 && nof_underflows == 0) {
     ret = SRSRAN_SUCCESS;
   }
 
@@ -573,9 +670,9 @@ clean_exit:
   }
 
   for (uint32_t r = 0; r < nof_radios; r++) {
-    for (uint32_t p = 0; p < nof_ports; p++) {
-      if (buffers[r][p]) {
-        free(buffers[r][p]);
+    for (uint32_t ch = 0; ch < SRSRAN_MAX_CHANNELS; ch++) {
+      if (buffers[r][ch]) {
+        free(buffers[r][ch]);
       }
     }
 
@@ -21,6 +21,7 @@
 
 #include "srsran/rlc/bearer_mem_pool.h"
 #include "srsran/adt/pool/batch_mem_pool.h"
+#include "srsran/common/numa_placement.h"
 #include "srsran/rlc/rlc_am_lte.h"
 #include "srsran/rlc/rlc_am_nr.h"
 #include "srsran/rlc/rlc_tm.h"
@@ -31,12 +32,25 @@ namespace srsran {
 
 srsran::background_mem_pool* get_bearer_pool()
 {
+  // The first batches are allocated once the pool is bound to its NUMA node
   static background_mem_pool pool(
       4,
       std::max(std::max(std::max(std::max(sizeof(rlc_am), sizeof(rlc_am)), sizeof(rlc_um_lte)), sizeof(rlc_um_nr)),
                sizeof(rlc_tm)),
       8,
-      8);
+      0,
+      "rlc_bearer_pool");
+  static bool initialized = []() {
+    if (numa_placement::get().get_node(numa_pool_t::bearers) >= 0) {
+      pool.set_batch_callback(
+          [](void* batch, size_t size) { numa_placement::get().bind(numa_pool_t::bearers, batch, size); });
+    }
+    while (pool.cache_size() < 8) {
+      pool.allocate_batch();
+    }
+    return true;
+  }();
+  (void)initialized;
   return &pool;
 }
 
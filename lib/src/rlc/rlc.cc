@@ -25,6 +25,7 @@
 #include "srsran/rlc/rlc_tm.h"
 #include "srsran/rlc/rlc_um_lte.h"
 #include "srsran/rlc/rlc_um_nr.h"
+#include "srsran/srslog/event_trace.h"
 
 namespace srsran {
 
@@ -183,6 +184,7 @@ void rlc::empty_queue()
 
 void rlc::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu)
 {
+  trace_hot_scope_arg("rlc", "write_sdu", lcid);
   // TODO: rework build PDU logic to allow large SDUs (without concatenation)
   if (sdu->N_bytes > RLC_MAX_SDU_SIZE) {
     logger.warning("Dropping too long SDU of size %d B (Max. size %d B).", sdu->N_bytes, RLC_MAX_SDU_SIZE);
@@ -286,6 +288,7 @@ uint32_t rlc::get_total_mch_buffer_state(uint32_t lcid)
 
 uint32_t rlc::read_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
+  trace_hot_scope_arg("rlc", "read_pdu", lcid);
   uint32_t ret = 0;
 
   rwlock_read_guard lock(rwlock);
@@ -321,6 +324,7 @@ uint32_t rlc::read_pdu_mch(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 // Write PDU methods are called from Stack thread context, no need to acquire the lock
 void rlc::write_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
+  trace_hot_scope_arg("rlc", "write_pdu", lcid);
   if (valid_lcid(lcid)) {
     rlc_array.at(lcid)->write_pdu_s(payload, nof_bytes);
     update_bsr(lcid);
@@ -229,8 +229,6 @@ void rlc_am::set_bsr_callback(bsr_callback_t callback)
  *******************************************************/
 int rlc_am::rlc_am_base_tx::write_sdu(unique_byte_buffer_t sdu)
 {
-  std::lock_guard<std::mutex> lock(mutex);
-
   if (!tx_enabled) {
     return SRSRAN_ERROR;
   }
@@ -243,27 +241,28 @@ int rlc_am::rlc_am_base_tx::write_sdu(unique_byte_buffer_t sdu)
   // Get SDU info
   uint32_t sdu_pdcp_sn = sdu->md.pdcp_sn;
 
-  // Store SDU
-  uint8_t*                                 msg_ptr   = sdu->msg;
-  uint32_t                                 nof_bytes = sdu->N_bytes;
-  srsran::error_type<unique_byte_buffer_t> ret       = tx_sdu_queue.try_write(std::move(sdu));
-  if (ret) {
-    RlcHexInfo(msg_ptr,
-               nof_bytes,
-               "Tx SDU (%d B, PDCP_SN=%ld tx_sdu_queue_len=%d)",
-               nof_bytes,
-               sdu_pdcp_sn,
-               tx_sdu_queue.size());
-  } else {
-    // in case of fail, the try_write returns back the sdu
-    RlcHexWarning(ret.error()->msg,
-                  ret.error()->N_bytes,
+  // The queue is lock-free and this is its only writer, so the SDU is logged before it becomes visible to read_pdu()
+  if (tx_sdu_queue.is_full()) {
+    RlcHexWarning(sdu->msg,
+                  sdu->N_bytes,
                   "[Dropped SDU] Tx SDU (%d B, PDCP_SN=%ld, tx_sdu_queue_len=%d)",
-                  ret.error()->N_bytes,
+                  sdu->N_bytes,
                   sdu_pdcp_sn,
                   tx_sdu_queue.size());
     return SRSRAN_ERROR;
   }
+  RlcHexInfo(sdu->msg,
+             sdu->N_bytes,
+             "Tx SDU (%d B, PDCP_SN=%ld tx_sdu_queue_len=%d)",
+             sdu->N_bytes,
+             sdu_pdcp_sn,
+             tx_sdu_queue.size() + 1);
+
+  // Store SDU
+  srsran::error_type<unique_byte_buffer_t> ret = tx_sdu_queue.try_write(std::move(sdu));
+  if (not ret) {
+    return SRSRAN_ERROR;
+  }
 
   return SRSRAN_SUCCESS;
 }
@@ -277,7 +276,6 @@ void rlc_am::rlc_am_base_tx::discard_sdu(uint32_t discard_sn)
   }
   bool discarded = tx_sdu_queue.apply_first([&discard_sn, this](unique_byte_buffer_t& sdu) {
     if (sdu != nullptr && sdu->md.pdcp_sn == discard_sn) {
-      tx_sdu_queue.queue.pop_func(sdu);
       sdu = nullptr;
       return true;
     }
@@ -30,6 +30,7 @@
 #define TX_MOD_BASE(x) (((x)-vt_a) % 1024)
 #define LCID (parent->lcid)
 #define MAX_SDUS_PER_PDU (128)
+#define MAX_PDU_PAYLOAD_LEN (SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET)
 
 namespace srsran {
 
@@ -360,7 +361,7 @@ void rlc_am_lte_tx::retransmit_pdu(uint32_t sn)
   rlc_amd_retx_lte_t& retx = retx_queue.push();
   retx.is_segment          = false;
   retx.so_start            = 0;
-  retx.so_end              = pdu.buf->N_bytes;
+  retx.so_end              = pdu.buf.length();
   retx.sn                  = pdu.rlc_sn;
 }
 
@@ -491,7 +492,7 @@ int rlc_am_lte_tx::build_retx_pdu(uint8_t* payload, uint32_t nof_bytes)
 
   // Set poll bit
   pdu_without_poll++;
-  byte_without_poll += (tx_window[retx.sn].buf->N_bytes + rlc_am_packed_length(&new_header));
+  byte_without_poll += (tx_window[retx.sn].buf.length() + rlc_am_packed_length(&new_header));
   RlcInfo("pdu_without_poll: %d", pdu_without_poll);
   RlcInfo("byte_without_poll: %d", byte_without_poll);
   if (poll_required()) {
@@ -508,32 +509,32 @@ int rlc_am_lte_tx::build_retx_pdu(uint8_t* payload, uint32_t nof_bytes)
 
   uint8_t* ptr = payload;
   rlc_am_write_data_pdu_header(&new_header, &ptr);
-  memcpy(ptr, tx_window[retx.sn].buf->msg, tx_window[retx.sn].buf->N_bytes);
+  tx_window[retx.sn].buf.copy_to(ptr);
 
   retx_queue.pop();
 
   RlcHexInfo(payload,
-             tx_window[retx.sn].buf->N_bytes,
+             tx_window[retx.sn].buf.length(),
              "Tx PDU SN=%d (%d B) (attempt %d/%d)",
              retx.sn,
-             tx_window[retx.sn].buf->N_bytes,
+             tx_window[retx.sn].buf.length(),
              tx_window[retx.sn].retx_count + 1,
              cfg.max_retx_thresh);
   log_rlc_amd_pdu_header_to_string(logger.debug, rb_name, "Tx PDU - %s", new_header);
 
   debug_state();
-  return (ptr - payload) + tx_window[retx.sn].buf->N_bytes;
+  return (ptr - payload) + tx_window[retx.sn].buf.length();
 }
 
 int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_retx_lte_t retx)
 {
-  if (tx_window[retx.sn].buf == NULL) {
+  if (tx_window[retx.sn].buf.empty()) {
     RlcError("In build_segment: retx.sn=%d has null buffer", retx.sn);
     return 0;
   }
   if (!retx.is_segment) {
     retx.so_start = 0;
-    retx.so_end   = tx_window[retx.sn].buf->N_bytes;
+    retx.so_end   = tx_window[retx.sn].buf.length();
   }
 
   // Construct new header
@@ -541,7 +542,7 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
   rlc_amd_pdu_header_t old_header = tx_window[retx.sn].header;
 
   pdu_without_poll++;
-  byte_without_poll += (tx_window[retx.sn].buf->N_bytes + rlc_am_packed_length(&new_header));
+  byte_without_poll += (tx_window[retx.sn].buf.length() + rlc_am_packed_length(&new_header));
   RlcInfo("pdu_without_poll: %d, byte_without_poll: %d", pdu_without_poll, byte_without_poll);
 
   new_header.dc   = RLC_DC_FIELD_DATA_PDU;
@@ -641,7 +642,7 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
   srsran_expect(head_len + (retx.so_end - retx.so_start) <= nof_bytes, "The provided buffer was overflown.");
 
   // Update retx_queue
-  if (tx_window[retx.sn].buf->N_bytes == retx.so_end) {
+  if (tx_window[retx.sn].buf.length() == retx.so_end) {
     retx_queue.pop();
     new_header.lsf = 1;
     if (rlc_am_end_aligned(old_header.fi)) {
@@ -669,9 +670,7 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
   // Write header and pdu
   uint8_t* ptr = payload;
   rlc_am_write_data_pdu_header(&new_header, &ptr);
-  uint8_t* data = &tx_window[retx.sn].buf->msg[retx.so_start];
-  uint32_t len  = retx.so_end - retx.so_start;
-  memcpy(ptr, data, len);
+  uint32_t len = tx_window[retx.sn].buf.copy_to(ptr, retx.so_start, retx.so_end - retx.so_start);
 
   debug_state();
   int pdu_len = (ptr - payload) + len;
@@ -696,6 +695,19 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
   return pdu_len;
 }
 
+void rlc_am_lte_tx::append_sdu_segment(rlc_amd_tx_pdu_lte& tx_pdu, uint32_t nof_bytes)
+{
+  // The SDU segments are referenced by the PDU, only the last slice collects the copies of the segments that do not fit
+  if (tx_pdu.buf.nof_slices() + 1 < tx_pdu.buf.max_slices()) {
+    tx_pdu.buf.append(byte_buffer_slice(tx_sdu, tx_sdu->msg, nof_bytes));
+  } else {
+    bool copied = tx_pdu.buf.append_copy(tx_sdu->msg, nof_bytes);
+    srsran_assert(copied, "The copy buffer of the PDU must be reserved in advance");
+  }
+  tx_sdu->N_bytes -= nof_bytes;
+  tx_sdu->msg += nof_bytes;
+}
+
 int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   if (tx_sdu == NULL && tx_sdu_queue.is_empty()) {
@@ -716,23 +728,6 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
     return 0;
   }
 
-  unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-  if (pdu == NULL) {
-#ifdef RLC_AM_BUFFER_DEBUG
-    srsran::console("Fatal Error: Could not allocate PDU in build_data_pdu()\n");
-    srsran::console("tx_window size: %zd PDUs\n", tx_window.size());
-    srsran::console("vt_a = %d, vt_ms = %d, vt_s = %d, poll_sn = %d\n", vt_a, vt_ms, vt_s, poll_sn);
-    srsran::console("retx_queue size: %zd PDUs\n", retx_queue.size());
-    std::map<uint32_t, rlc_amd_tx_pdu>::iterator txit;
-    for (txit = tx_window.begin(); txit != tx_window.end(); txit++) {
-      srsran::console("tx_window - SN=%d\n", txit->first);
-    }
-    exit(-1);
-#else
-    RlcError("Fatal Error: Couldn't allocate PDU in build_data_pdu().");
-    return 0;
-#endif
-  }
   rlc_amd_pdu_header_t header = {};
   header.dc                   = RLC_DC_FIELD_DATA_PDU;
   header.fi                   = RLC_FI_FIELD_START_AND_END_ALIGNED;
@@ -750,20 +745,15 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
   uint32_t head_len  = rlc_am_packed_length(&header);
   uint32_t to_move   = 0;
   uint32_t last_li   = 0;
-  uint32_t pdu_space = SRSRAN_MIN(nof_bytes, pdu->get_tailroom());
-  uint8_t* pdu_ptr   = pdu->msg;
+  uint32_t pdu_space = SRSRAN_MIN(nof_bytes, MAX_PDU_PAYLOAD_LEN);
 
   RlcDebug("Building PDU - pdu_space: %d, head_len: %d ", pdu_space, head_len);
 
   // Check for SDU segment
   if (tx_sdu != nullptr) {
     to_move = ((pdu_space - head_len) >= tx_sdu->N_bytes) ? tx_sdu->N_bytes : pdu_space - head_len;
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
+    append_sdu_segment(tx_pdu, to_move);
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
     if (undelivered_sdu_info_queue.has_pdcp_sn(tx_sdu->md.pdcp_sn)) {
       pdcp_pdu_info_lte& pdcp_pdu = undelivered_sdu_info_queue[tx_sdu->md.pdcp_sn];
       segment_pool.make_segment(tx_pdu, pdcp_pdu);
@@ -780,7 +770,7 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
       tx_sdu.reset();
     }
     if (pdu_space > to_move) {
-      pdu_space -= SRSRAN_MIN(to_move, pdu->get_tailroom());
+      pdu_space -= to_move;
     } else {
       pdu_space = 0;
     }
@@ -797,12 +787,17 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
   while (pdu_space > head_len && tx_sdu_queue.get_n_sdus() > 0 && header.N_li < MAX_SDUS_PER_PDU) {
     if (not segment_pool.has_segments()) {
       RlcInfo("Can't build a PDU segment - No segment resources available");
-      if (pdu_ptr != pdu->msg) {
+      if (not tx_pdu.buf.empty()) {
         break; // continue with the segments created up to this point
       }
       tx_window.remove_pdu(tx_pdu.rlc_sn);
       return 0;
     }
+    if (tx_pdu.buf.nof_slices() + 1 >= tx_pdu.buf.max_slices() and not tx_pdu.buf.reserve_copy(pdu_space)) {
+      // the remaining SDUs are copied into the last slice of the PDU
+      RlcError("Can't build a PDU segment - Couldn't allocate buffer");
+      break; // continue with the segments created up to this point
+    }
     if (last_li > 0) {
       header.li[header.N_li] = last_li;
       header.N_li++;
@@ -837,12 +832,8 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
     pdcp_pdu_info_lte& pdcp_pdu = undelivered_sdu_info_queue[tx_sdu->md.pdcp_sn];
 
     to_move = ((pdu_space - head_len) >= tx_sdu->N_bytes) ? tx_sdu->N_bytes : pdu_space - head_len;
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
+    append_sdu_segment(tx_pdu, to_move);
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
     segment_pool.make_segment(tx_pdu, pdcp_pdu);
     if (tx_sdu->N_bytes == 0) {
       pdcp_pdu.fully_txed = true;
@@ -862,7 +853,7 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
   }
 
   // Make sure, at least one SDU (segment) has been added until this point
-  if (pdu->N_bytes == 0) {
+  if (tx_pdu.buf.empty()) {
     RlcError("Generated empty RLC PDU.");
   }
 
@@ -872,7 +863,7 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 
   // Set Poll bit
   pdu_without_poll++;
-  byte_without_poll += (pdu->N_bytes + head_len);
+  byte_without_poll += (tx_pdu.buf.length() + head_len);
   RlcDebug("pdu_without_poll: %d", pdu_without_poll);
   RlcDebug("byte_without_poll: %d", byte_without_poll);
   if (poll_required()) {
@@ -889,15 +880,12 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
   // Update Tx window
   vt_s = (vt_s + 1) % MOD;
 
-  // Write final header and TX
-  tx_pdu.buf                      = std::move(pdu);
-  tx_pdu.header                   = header;
-  const byte_buffer_t* buffer_ptr = tx_pdu.buf.get();
+  // Write final header and gather the SDU segments into the TX buffer
+  tx_pdu.header = header;
 
   uint8_t* ptr = payload;
   rlc_am_write_data_pdu_header(&header, &ptr);
-  memcpy(ptr, buffer_ptr->msg, buffer_ptr->N_bytes);
-  int total_len = (ptr - payload) + buffer_ptr->N_bytes;
+  int total_len = (ptr - payload) + tx_pdu.buf.copy_to(ptr);
   RlcHexInfo(payload, total_len, "Tx PDU SN=%d (%d B)", header.sn, total_len);
   log_rlc_amd_pdu_header_to_string(logger.debug, rb_name, "%s", header);
   debug_state();
@@ -970,24 +958,24 @@ void rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
             retx.sn         = i;
             retx.is_segment = false;
             retx.so_start   = 0;
-            retx.so_end     = pdu.buf->N_bytes;
+            retx.so_end     = pdu.buf.length();
 
             if (status.nacks[j].has_so) {
               // sanity check
-              if (status.nacks[j].so_start >= pdu.buf->N_bytes) {
+              if (status.nacks[j].so_start >= pdu.buf.length()) {
                 // print error but try to send original PDU again
-                RlcInfo("SO_start is larger than original PDU (%d >= %d)", status.nacks[j].so_start, pdu.buf->N_bytes);
+                RlcInfo("SO_start is larger than original PDU (%d >= %d)", status.nacks[j].so_start, pdu.buf.length());
                 status.nacks[j].so_start = 0;
               }
 
               // check for special SO_end value
               if (status.nacks[j].so_end == 0x7FFF) {
-                status.nacks[j].so_end = pdu.buf->N_bytes;
+                status.nacks[j].so_end = pdu.buf.length();
               } else {
                 retx.so_end = status.nacks[j].so_end + 1;
               }
 
-              if (status.nacks[j].so_start < pdu.buf->N_bytes && status.nacks[j].so_end <= pdu.buf->N_bytes) {
+              if (status.nacks[j].so_start < pdu.buf.length() && status.nacks[j].so_end <= pdu.buf.length()) {
                 retx.is_segment = true;
                 retx.so_start   = status.nacks[j].so_start;
               } else {
@@ -995,7 +983,7 @@ void rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
                            i,
                            status.nacks[j].so_start,
                            status.nacks[j].so_end,
-                           pdu.buf->N_bytes);
+                           pdu.buf.length());
               }
             }
           } else {
@@ -1093,8 +1081,8 @@ int rlc_am_lte_tx::required_buffer_size(const rlc_amd_retx_lte_t& retx)
 {
   if (!retx.is_segment) {
     if (tx_window.has_sn(retx.sn)) {
-      if (tx_window[retx.sn].buf) {
-        return rlc_am_packed_length(&tx_window[retx.sn].header) + tx_window[retx.sn].buf->N_bytes;
+      if (not tx_window[retx.sn].buf.empty()) {
+        return rlc_am_packed_length(&tx_window[retx.sn].header) + tx_window[retx.sn].buf.length();
       } else {
         RlcWarning("retx.sn=%d has null ptr in required_buffer_size()", retx.sn);
         return -1;
@@ -1154,7 +1142,7 @@ int rlc_am_lte_tx::required_buffer_size(const rlc_amd_retx_lte_t& retx)
     lower += old_header.li[i];
   }
 
-  //  if(tx_window[retx.sn].buf->N_bytes != retx.so_end) {
+  //  if(tx_window[retx.sn].buf.length() != retx.so_end) {
   //    if(new_header.N_li > 0)
   //      new_header.N_li--; // No li for last segment
   //  }
@@ -1291,55 +1279,42 @@ void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, r
     return;
   }
 
-  // Write to rx window
-  rlc_amd_rx_pdu& pdu = rx_window.add_pdu(header.sn);
-  pdu.buf             = srsran::make_byte_buffer();
-  if (pdu.buf == NULL) {
+  if (header.sn == vr_r) {
+    // In-sequence PDU, its SDUs are reassembled straight from the MAC PDU
+    vr_ms = (header.sn + 1) % MOD;
+    update_rx_state(header);
+    reassemble_in_sequence_pdu(payload, nof_bytes, header);
+  } else {
+    // Write to rx window
+    rlc_amd_rx_pdu& pdu = rx_window.add_pdu(header.sn);
+    pdu.buf             = srsran::make_byte_buffer();
+    if (pdu.buf == NULL) {
 #ifdef RLC_AM_BUFFER_DEBUG
-    srsran::console("Fatal Error: Couldn't allocate PDU in handle_data_pdu().\n");
-    exit(-1);
+      srsran::console("Fatal Error: Couldn't allocate PDU in handle_data_pdu().\n");
+      exit(-1);
 #else
-    RlcError("Fatal Error: Couldn't allocate PDU in handle_data_pdu().");
-    rx_window.remove_pdu(header.sn);
-    return;
+      RlcError("Fatal Error: Couldn't allocate PDU in handle_data_pdu().");
+      rx_window.remove_pdu(header.sn);
+      return;
 #endif
-  }
-  pdu.buf->set_timestamp();
-
-  // check available space for payload
-  if (nof_bytes > pdu.buf->get_tailroom()) {
-    RlcError("Discarding SN=%d of size %d B (available space %d B)", header.sn, nof_bytes, pdu.buf->get_tailroom());
-    return;
-  }
-  memcpy(pdu.buf->msg, payload, nof_bytes);
-  pdu.buf->N_bytes = nof_bytes;
-  pdu.header       = header;
-
-  // Update vr_h
-  if (RX_MOD_BASE(header.sn) >= RX_MOD_BASE(vr_h)) {
-    vr_h = (header.sn + 1) % MOD;
-  }
+    }
+    pdu.buf->set_timestamp();
 
-  // Update vr_ms
-  while (rx_window.has_sn(vr_ms)) {
-    vr_ms = (vr_ms + 1) % MOD;
-  }
+    // check available space for payload
+    if (nof_bytes > pdu.buf->get_tailroom()) {
+      RlcError("Discarding SN=%d of size %d B (available space %d B)", header.sn, nof_bytes, pdu.buf->get_tailroom());
+      return;
+    }
+    memcpy(pdu.buf->msg, payload, nof_bytes);
+    pdu.buf->N_bytes = nof_bytes;
+    pdu.header       = header;
 
-  // Check poll bit
-  if (header.p) {
-    RlcInfo("Status packet requested through polling bit");
-    poll_received = true;
+    update_rx_state(header);
 
-    // 36.322 v10 Section 5.2.3
-    if (RX_MOD_BASE(header.sn) < RX_MOD_BASE(vr_ms) || RX_MOD_BASE(header.sn) >= RX_MOD_BASE(vr_mr)) {
-      do_status = true;
-    }
-    // else delay for reordering timer
+    // Reassemble and deliver SDUs
+    reassemble_rx_sdus();
   }
 
-  // Reassemble and deliver SDUs
-  reassemble_rx_sdus();
-
   // Update reordering variables and timers (36.322 v10.0.0 Section 5.1.3.2.3)
   if (reordering_timer.is_valid()) {
     if (reordering_timer.is_running()) {
@@ -1369,8 +1344,6 @@ void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, r
 
 void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header)
 {
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-
   RlcHexInfo(payload,
              nof_bytes,
              "Rx data PDU segment of SN=%d (%d B), SO=%d, N_li=%d",
@@ -1412,8 +1385,7 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
   segment.header       = header;
 
   // Check if we already have a segment from the same PDU
-  it = rx_segments.find(header.sn);
-  if (rx_segments.end() != it) {
+  if (rx_segments.has_sn(header.sn)) {
     if (header.p) {
       RlcInfo("Status packet requested through polling bit");
       do_status = true;
@@ -1421,15 +1393,14 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
 
     // Add segment to PDU list and check for complete
     // NOTE: MAY MOVE. Preference would be to capture by value, and then move; but header is stack allocated
-    if (add_segment_and_check(&it->second, &segment)) {
-      rx_segments.erase(it);
+    // The segments may have been erased already if the reassembled PDU moved the rx window
+    if (add_segment_and_check(&rx_segments[header.sn], &segment) && rx_segments.has_sn(header.sn)) {
+      rx_segments.remove_pdu(header.sn);
     }
 
   } else {
-    // Create new PDU segment list and write to rx_segments
-    rlc_amd_rx_pdu_segments_t pdu;
-    pdu.segments.push_back(std::move(segment));
-    rx_segments[header.sn] = std::move(pdu);
+    // Create new PDU segment list in rx_segments
+    rx_segments.add_pdu(header.sn).segments.push_back(std::move(segment));
 
     // Update vr_h
     if (RX_MOD_BASE(header.sn) >= RX_MOD_BASE(vr_h)) {
@@ -1456,7 +1427,67 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
 
 void rlc_am_lte_rx::reassemble_rx_sdus()
 {
-  uint32_t len = 0;
+  if (not alloc_rx_sdu()) {
+    return;
+  }
+
+  // Iterate through rx_window, assembling and delivering SDUs
+  while (rx_window.has_sn(vr_r)) {
+    rlc_amd_rx_pdu& pdu = rx_window[vr_r];
+    if (not reassemble_pdu(pdu.buf->msg, pdu.buf->N_bytes, pdu.header, pdu.buf->get_timestamp())) {
+      return;
+    }
+    advance_rx_window();
+  }
+}
+
+/// Updates vr_h and vr_ms after the reception of a complete PDU and checks its poll bit
+void rlc_am_lte_rx::update_rx_state(const rlc_amd_pdu_header_t& header)
+{
+  // Update vr_h
+  if (RX_MOD_BASE(header.sn) >= RX_MOD_BASE(vr_h)) {
+    vr_h = (header.sn + 1) % MOD;
+  }
+
+  // Update vr_ms
+  while (rx_window.has_sn(vr_ms)) {
+    vr_ms = (vr_ms + 1) % MOD;
+  }
+
+  // Check poll bit
+  if (header.p) {
+    RlcInfo("Status packet requested through polling bit");
+    poll_received = true;
+
+    // 36.322 v10 Section 5.2.3
+    if (RX_MOD_BASE(header.sn) < RX_MOD_BASE(vr_ms) || RX_MOD_BASE(header.sn) >= RX_MOD_BASE(vr_mr)) {
+      do_status = true;
+    }
+    // else delay for reordering timer
+  }
+}
+
+/**
+ * Delivers the SDUs of a PDU received with SN=vr_r straight from the MAC PDU, without storing it in the rx window.
+ * The MAC PDU buffer stays valid until write_pdu() returns, so this saves the copy of the payload for every PDU
+ * received in sequence.
+ */
+void rlc_am_lte_rx::reassemble_in_sequence_pdu(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header)
+{
+  if (not alloc_rx_sdu()) {
+    return;
+  }
+  if (not reassemble_pdu(payload, nof_bytes, header, std::chrono::high_resolution_clock::now())) {
+    return;
+  }
+  advance_rx_window();
+
+  // Deliver the PDUs that were waiting for this one
+  reassemble_rx_sdus();
+}
+
+bool rlc_am_lte_rx::alloc_rx_sdu()
+{
   if (rx_sdu == NULL) {
     rx_sdu = srsran::make_byte_buffer();
     if (rx_sdu == NULL) {
@@ -1465,144 +1496,129 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
       exit(-1);
 #else
       RlcError("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (1)");
-      return;
+      return false;
 #endif
     }
   }
+  return true;
+}
 
-  // Iterate through rx_window, assembling and delivering SDUs
-  while (rx_window.has_sn(vr_r)) {
-    // Handle any SDU segments
-    for (uint32_t i = 0; i < rx_window[vr_r].header.N_li; i++) {
-      len = rx_window[vr_r].header.li[i];
-
-      RlcHexDebug(rx_window[vr_r].buf->msg,
-                  len,
-                  "Handling segment %d/%d of length %d B of SN=%d",
-                  i + 1,
-                  rx_window[vr_r].header.N_li,
-                  len,
-                  vr_r);
-
-      // sanity check to avoid zero-size SDUs
-      if (len == 0) {
-        break;
-      }
+/**
+ * Appends the segments of the PDU with SN=vr_r to rx_sdu and delivers the completed SDUs. msg and nof_bytes are
+ * advanced past the delivered segments.
+ *
+ * @return false if no buffer was available for the next SDU, in which case the rx window must not be moved
+ */
+bool rlc_am_lte_rx::reassemble_pdu(uint8_t*&                                      msg,
+                                   uint32_t&                                      nof_bytes,
+                                   const rlc_amd_pdu_header_t&                    header,
+                                   std::chrono::high_resolution_clock::time_point rx_time)
+{
+  uint32_t len = 0;
 
-      if (rx_sdu->get_tailroom() >= len) {
-        if ((rx_window[vr_r].buf->msg - rx_window[vr_r].buf->buffer) + len < SRSRAN_MAX_BUFFER_SIZE_BYTES) {
-          if (rx_window[vr_r].buf->N_bytes < len) {
-            RlcError("Dropping corrupted SN=%d", vr_r);
-            rx_sdu.reset();
-            goto exit;
-          }
-          // store timestamp of the first segment when starting to assemble SDUs
-          if (rx_sdu->N_bytes == 0) {
-            rx_sdu->set_timestamp(rx_window[vr_r].buf->get_timestamp());
-          }
-          memcpy(&rx_sdu->msg[rx_sdu->N_bytes], rx_window[vr_r].buf->msg, len);
-          rx_sdu->N_bytes += len;
-
-          rx_window[vr_r].buf->msg += len;
-          rx_window[vr_r].buf->N_bytes -= len;
-
-          RlcHexInfo(rx_sdu->msg, rx_sdu->N_bytes, "Rx SDU (%d B)", rx_sdu->N_bytes);
-          sdu_rx_latency_ms.push(std::chrono::duration_cast<std::chrono::milliseconds>(
-                                     std::chrono::high_resolution_clock::now() - rx_sdu->get_timestamp())
-                                     .count());
-          parent->pdcp->write_pdu(parent->lcid, std::move(rx_sdu));
-          {
-            std::lock_guard<std::mutex> lock(parent->metrics_mutex);
-            parent->metrics.num_rx_sdus++;
-          }
+  // Handle any SDU segments
+  for (uint32_t i = 0; i < header.N_li; i++) {
+    len = header.li[i];
 
-          rx_sdu = srsran::make_byte_buffer();
-          if (rx_sdu == nullptr) {
-#ifdef RLC_AM_BUFFER_DEBUG
-            srsran::console("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (2)\n");
-            exit(-1);
-#else
-            RlcError("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (2)");
-            return;
-#endif
-          }
-        } else {
-          int buf_len = rx_window[vr_r].buf->msg - rx_window[vr_r].buf->buffer;
-          RlcError("Cannot read %d bytes from rx_window. vr_r=%d, msg-buffer=%d B", len, vr_r, buf_len);
-          rx_sdu.reset();
-          goto exit;
-        }
-      } else {
-        RlcError("Cannot fit RLC PDU in SDU buffer, dropping both.");
-        rx_sdu.reset();
-        goto exit;
-      }
+    RlcHexDebug(msg, len, "Handling segment %d/%d of length %d B of SN=%d", i + 1, header.N_li, len, vr_r);
+
+    // sanity check to avoid zero-size SDUs
+    if (len == 0) {
+      break;
     }
 
-    // Handle last segment
-    len = rx_window[vr_r].buf->N_bytes;
-    RlcHexDebug(rx_window[vr_r].buf->msg, len, "Handling last segment of length %d B of SN=%d", len, vr_r);
     if (rx_sdu->get_tailroom() >= len) {
+      if (nof_bytes < len) {
+        RlcError("Dropping corrupted SN=%d", vr_r);
+        rx_sdu.reset();
+        return true;
+      }
       // store timestamp of the first segment when starting to assemble SDUs
       if (rx_sdu->N_bytes == 0) {
-        rx_sdu->set_timestamp(rx_window[vr_r].buf->get_timestamp());
+        rx_sdu->set_timestamp(rx_time);
+      }
+      memcpy(&rx_sdu->msg[rx_sdu->N_bytes], msg, len);
+      rx_sdu->N_bytes += len;
+
+      msg += len;
+      nof_bytes -= len;
+
+      deliver_rx_sdu();
+      if (not alloc_rx_sdu()) {
+        return false;
       }
-      memcpy(&rx_sdu->msg[rx_sdu->N_bytes], rx_window[vr_r].buf->msg, len);
-      rx_sdu->N_bytes += rx_window[vr_r].buf->N_bytes;
     } else {
-      printf("Cannot fit RLC PDU in SDU buffer (tailroom=%d, len=%d), dropping both. Erasing SN=%d.\n",
-             rx_sdu->get_tailroom(),
-             len,
-             vr_r);
+      RlcError("Cannot fit RLC PDU in SDU buffer, dropping both.");
       rx_sdu.reset();
-      goto exit;
-    }
-
-    if (rlc_am_end_aligned(rx_window[vr_r].header.fi)) {
-      RlcHexInfo(rx_sdu->msg, rx_sdu->N_bytes, "Rx SDU (%d B)", rx_sdu->N_bytes);
-      sdu_rx_latency_ms.push(std::chrono::duration_cast<std::chrono::milliseconds>(
-                                 std::chrono::high_resolution_clock::now() - rx_sdu->get_timestamp())
-                                 .count());
-      parent->pdcp->write_pdu(parent->lcid, std::move(rx_sdu));
-      {
-        std::lock_guard<std::mutex> lock(parent->metrics_mutex);
-        parent->metrics.num_rx_sdus++;
-      }
+      return true;
+    }
+  }
 
-      rx_sdu = srsran::make_byte_buffer();
-      if (rx_sdu == NULL) {
-#ifdef RLC_AM_BUFFER_DEBUG
-        srsran::console("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (3)\n");
-        exit(-1);
-#else
-        RlcError("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (3)");
-        return;
-#endif
-      }
+  // Handle last segment
+  len = nof_bytes;
+  RlcHexDebug(msg, len, "Handling last segment of length %d B of SN=%d", len, vr_r);
+  if (rx_sdu->get_tailroom() >= len) {
+    // store timestamp of the first segment when starting to assemble SDUs
+    if (rx_sdu->N_bytes == 0) {
+      rx_sdu->set_timestamp(rx_time);
+    }
+    memcpy(&rx_sdu->msg[rx_sdu->N_bytes], msg, len);
+    rx_sdu->N_bytes += len;
+  } else {
+    printf("Cannot fit RLC PDU in SDU buffer (tailroom=%d, len=%d), dropping both. Erasing SN=%d.\n",
+           rx_sdu->get_tailroom(),
+           len,
+           vr_r);
+    rx_sdu.reset();
+    return true;
+  }
+
+  if (rlc_am_end_aligned(header.fi)) {
+    deliver_rx_sdu();
+    if (not alloc_rx_sdu()) {
+      return false;
     }
+  }
+  return true;
+}
 
-  exit:
-    // Move the rx_window
-    RlcDebug("Erasing SN=%d.", vr_r);
-    // also erase any segments of this SN
-    std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-    it = rx_segments.find(vr_r);
-    if (rx_segments.end() != it) {
-      RlcDebug("Erasing segments of SN=%d", vr_r);
-      std::list<rlc_amd_rx_pdu>::iterator segit;
-      for (segit = it->second.segments.begin(); segit != it->second.segments.end(); ++segit) {
-        RlcDebug(" Erasing segment of SN=%d SO=%d Len=%d N_li=%d",
-                 segit->header.sn,
-                 segit->header.so,
-                 segit->buf->N_bytes,
-                 segit->header.N_li);
-      }
-      it->second.segments.clear();
+void rlc_am_lte_rx::deliver_rx_sdu()
+{
+  RlcHexInfo(rx_sdu->msg, rx_sdu->N_bytes, "Rx SDU (%d B)", rx_sdu->N_bytes);
+  sdu_rx_latency_ms.push(std::chrono::duration_cast<std::chrono::milliseconds>(
+                             std::chrono::high_resolution_clock::now() - rx_sdu->get_timestamp())
+                             .count());
+  uint32_t nof_sdu_bytes = rx_sdu->N_bytes;
+  parent->pdcp->write_pdu(parent->lcid, std::move(rx_sdu));
+  {
+    std::lock_guard<std::mutex> lock(parent->metrics_mutex);
+    parent->metrics.num_rx_sdus++;
+    parent->metrics.num_rx_sdu_bytes += nof_sdu_bytes;
+  }
+}
+
+void rlc_am_lte_rx::advance_rx_window()
+{
+  // Move the rx_window
+  RlcDebug("Erasing SN=%d.", vr_r);
+  // also erase any segments of this SN
+  if (rx_segments.has_sn(vr_r)) {
+    RlcDebug("Erasing segments of SN=%d", vr_r);
+    std::list<rlc_amd_rx_pdu>::iterator segit;
+    for (segit = rx_segments[vr_r].segments.begin(); segit != rx_segments[vr_r].segments.end(); ++segit) {
+      RlcDebug(" Erasing segment of SN=%d SO=%d Len=%d N_li=%d",
+               segit->header.sn,
+               segit->header.so,
+               segit->buf->N_bytes,
+               segit->header.N_li);
     }
+    rx_segments.remove_pdu(vr_r);
+  }
+  if (rx_window.has_sn(vr_r)) {
     rx_window.remove_pdu(vr_r);
-    vr_r  = (vr_r + 1) % MOD;
-    vr_mr = (vr_mr + 1) % MOD;
   }
+  vr_r  = (vr_r + 1) % MOD;
+  vr_mr = (vr_mr + 1) % MOD;
 }
 
 void rlc_am_lte_rx::reset_status()
@@ -1733,12 +1749,14 @@ int rlc_am_lte_rx::get_status_pdu_length()
 
 void rlc_am_lte_rx::print_rx_segments()
 {
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-  std::stringstream                                       ss;
+  std::stringstream ss;
   ss << "rx_segments:" << std::endl;
-  for (it = rx_segments.begin(); it != rx_segments.end(); it++) {
+  for (uint32_t sn = vr_r; RX_MOD_BASE(sn) < RX_MOD_BASE(vr_mr); sn = (sn + 1) % MOD) {
+    if (not rx_segments.has_sn(sn)) {
+      continue;
+    }
     std::list<rlc_amd_rx_pdu>::iterator segit;
-    for (segit = it->second.segments.begin(); segit != it->second.segments.end(); segit++) {
+    for (segit = rx_segments[sn].segments.begin(); segit != rx_segments[sn].segments.end(); segit++) {
       ss << "    SN=" << segit->header.sn << " SO:" << segit->header.so << " N:" << segit->buf->N_bytes
          << " N_li: " << segit->header.N_li << std::endl;
     }
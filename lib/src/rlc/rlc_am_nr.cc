@@ -27,7 +27,6 @@
 #include "srsran/rlc/rlc_am_nr_packing.h"
 #include "srsran/srslog/event_trace.h"
 #include <iostream>
-#include <set>
 
 namespace srsran {
 
@@ -553,6 +552,7 @@ rlc_am_nr_tx::build_retx_pdu_without_segmentation(const rlc_amd_retx_nr_t retx,
 
   // Update RETX queue. This must be done before calculating
   // the polling bit, to make sure the poll bit is calculated correctly
+  tx_pdu.nof_queued_retx--;
   retx_queue.pop();
 
   // Write header to payload
@@ -847,7 +847,10 @@ void rlc_am_nr_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
   for (uint32_t sn = st.tx_next_ack; tx_mod_base_nr(sn) < tx_mod_base_nr(stop_sn); sn = (sn + 1) % mod_nr) {
     if (tx_window->has_sn(sn)) {
       notify_info_vec.push_back((*tx_window)[sn].pdcp_sn);
-      retx_queue.remove_sn(sn); // remove any pending retx for that SN
+      // remove any pending retx for that SN
+      for (uint32_t i = 0; i < (*tx_window)[sn].nof_queued_retx; i++) {
+        retx_queue.remove_sn(sn);
+      }
       tx_window->remove_pdu(sn);
       st.tx_next_ack = (sn + 1) % mod_nr;
     } else {
@@ -858,35 +861,34 @@ void rlc_am_nr_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
   RlcDebug("Processed status report ACKs. ACK_SN=%d. Tx_Next_Ack=%d", status.ack_sn, st.tx_next_ack);
 
   // Process N_nacks
-  std::set<uint32_t> retx_sn_set; // Set of PDU SNs added for retransmission (no duplicates)
+  retx_sn_list.clear(); // PDU SNs added for retransmission (no duplicates)
   for (uint32_t nack_idx = 0; nack_idx < status.nacks.size(); nack_idx++) {
-    if (status.nacks[nack_idx].has_nack_range) {
-      for (uint32_t range_sn = status.nacks[nack_idx].nack_sn;
-           range_sn < status.nacks[nack_idx].nack_sn + status.nacks[nack_idx].nack_range;
-           range_sn++) {
+    const rlc_status_nack_t& range_nack = status.nacks[nack_idx];
+    if (range_nack.has_nack_range) {
+      for (uint32_t range_idx = 0; range_idx < range_nack.nack_range; range_idx++) {
         rlc_status_nack_t nack = {};
-        nack.nack_sn           = range_sn;
-        if (status.nacks[nack_idx].has_so) {
+        nack.nack_sn           = (range_nack.nack_sn + range_idx) % mod_nr;
+        if (range_nack.has_so) {
           // Apply so_start to first range item
-          if (range_sn == status.nacks[nack_idx].nack_sn) {
-            nack.so_start = status.nacks[nack_idx].so_start;
+          if (range_idx == 0) {
+            nack.so_start = range_nack.so_start;
           }
           // Apply so_end to last range item
-          if (range_sn == (status.nacks[nack_idx].nack_sn + status.nacks[nack_idx].nack_range - 1)) {
-            nack.so_end = status.nacks[nack_idx].so_end;
+          if (range_idx == range_nack.nack_range - 1U) {
+            nack.so_end = range_nack.so_end;
           }
           // Enable has_so only if the offsets do not span the whole SDU
           nack.has_so = (nack.so_start != 0) || (nack.so_end != rlc_status_nack_t::so_end_of_sdu);
         }
-        handle_nack(nack, retx_sn_set);
+        handle_nack(nack, retx_sn_list);
       }
     } else {
-      handle_nack(status.nacks[nack_idx], retx_sn_set);
+      handle_nack(range_nack, retx_sn_list);
     }
   }
 
   // Process retx_count and inform upper layers if needed
-  for (uint32_t retx_sn : retx_sn_set) {
+  for (uint32_t retx_sn : retx_sn_list) {
     auto& pdu = (*tx_window)[retx_sn];
     // Increment retx_count
     if (pdu.retx_count == RETX_COUNT_NOT_STARTED) {
@@ -908,7 +910,15 @@ void rlc_am_nr_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
   notify_info_vec.clear();
 }
 
-void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>& retx_sn_set)
+/// Adds the SN to the list unless it was the last one added, the NACKs of an SDU are consecutive in a status PDU
+static void add_retx_sn(std::vector<uint32_t>& retx_sn_list, uint32_t sn)
+{
+  if (retx_sn_list.empty() or retx_sn_list.back() != sn) {
+    retx_sn_list.push_back(sn);
+  }
+}
+
+void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::vector<uint32_t>& retx_sn_list)
 {
   if (tx_mod_base_nr(st.tx_next_ack) <= tx_mod_base_nr(nack.nack_sn) &&
       tx_mod_base_nr(nack.nack_sn) <= tx_mod_base_nr(st.tx_next)) {
@@ -925,14 +935,15 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
         bool segment_found = false;
         for (const rlc_amd_tx_pdu_nr::pdu_segment& segm : pdu.segment_list) {
           if (segm.so >= nack.so_start && segm.so <= nack.so_end) {
-            if (not retx_queue.has_sn(nack.nack_sn, segm.so)) {
+            if (pdu.nof_queued_retx == 0 or not retx_queue.has_sn(nack.nack_sn, segm.so)) {
               rlc_amd_retx_nr_t& retx = retx_queue.push();
+              pdu.nof_queued_retx++;
               retx.sn                 = nack.nack_sn;
               retx.is_segment         = true;
               retx.so_start           = segm.so;
               retx.current_so         = segm.so;
               retx.segment_length     = segm.payload_len;
-              retx_sn_set.insert(nack.nack_sn);
+              add_retx_sn(retx_sn_list, nack.nack_sn);
               RlcInfo("Scheduled RETX of SDU segment SN=%d, so_start=%d, segment_length=%d",
                       retx.sn,
                       retx.so_start,
@@ -958,22 +969,24 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
       } else {
         // NACK'ing full SDU.
         // add to retx queue if it's not already there
-        if (not retx_queue.has_sn(nack.nack_sn)) {
+        if (pdu.nof_queued_retx == 0) {
           // Have we segmented the SDU already?
           if ((*tx_window)[nack.nack_sn].segment_list.empty()) {
             rlc_amd_retx_nr_t& retx = retx_queue.push();
+            pdu.nof_queued_retx++;
             retx.sn                 = nack.nack_sn;
             retx.is_segment         = false;
             retx.so_start           = 0;
             retx.current_so         = 0;
             retx.segment_length     = pdu.sdu_buf->N_bytes;
-            retx_sn_set.insert(nack.nack_sn);
+            add_retx_sn(retx_sn_list, nack.nack_sn);
             RlcInfo("Scheduled RETX of SDU SN=%d", retx.sn);
           } else {
             RlcInfo("Scheduled RETX of SDU SN=%d", nack.nack_sn);
-            retx_sn_set.insert(nack.nack_sn);
+            add_retx_sn(retx_sn_list, nack.nack_sn);
             for (auto segm : (*tx_window)[nack.nack_sn].segment_list) {
               rlc_amd_retx_nr_t& retx = retx_queue.push();
+              pdu.nof_queued_retx++;
               retx.sn                 = nack.nack_sn;
               retx.is_segment         = true;
               retx.so_start           = segm.so;
@@ -1275,7 +1288,8 @@ void rlc_am_nr_tx::timer_expired(uint32_t timeout_id)
       // or first SDU segment of the first RLC SDU
       // that has not been acked
       rlc_amd_retx_nr_t& retx = retx_queue.push();
-      retx.sn                 = st.tx_next_ack;
+      (*tx_window)[st.tx_next_ack].nof_queued_retx++;
+      retx.sn = st.tx_next_ack;
       if ((*tx_window)[st.tx_next_ack].segment_list.empty()) {
         // Full SDU
         retx.is_segment     = false;
@@ -1406,6 +1420,9 @@ bool rlc_am_nr_rx::configure(const rlc_config_t& cfg_)
       RlcError("attempt to configure unsupported rx_sn_field_length %s", to_string(cfg.rx_sn_field_length));
       return false;
   }
+  rx_sdu_complete = std::unique_ptr<bounded_bitset<am_window_size(rlc_am_nr_sn_size_t::size18bits)> >(
+      new bounded_bitset<am_window_size(rlc_am_nr_sn_size_t::size18bits)>(rx_window_size()));
+  status_pdu_len_valid = false;
 
   RlcDebug("RLC AM NR configured rx entity.");
 
@@ -1430,6 +1447,8 @@ void rlc_am_nr_rx::stop()
 
   // Drop all messages in RX window
   rx_window->clear();
+  rx_sdu_complete->reset();
+  status_pdu_len_valid = false;
 }
 
 void rlc_am_nr_rx::reestablish()
@@ -1440,6 +1459,7 @@ void rlc_am_nr_rx::reestablish()
 void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   std::lock_guard<std::mutex> lock(mutex);
+  status_pdu_len_valid = false;
 
   // Get AMD PDU Header
   rlc_am_nr_pdu_header_t header  = {};
@@ -1475,24 +1495,15 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 
   // Section 5.2.3.2.2, discard segments with overlapping bytes
   if (rx_window->has_sn(header.sn) && header.si != rlc_nr_si_field_t::full_sdu) {
-    for (const auto& segm : (*rx_window)[header.sn].segments) {
-      uint32_t segm_last_byte = segm.header.so + segm.buf->N_bytes - 1;
-      uint32_t pdu_last_byte  = header.so + nof_bytes - hdr_len - 1;
-      if ((header.so >= segm.header.so && header.so <= segm_last_byte) ||
-          (pdu_last_byte >= segm.header.so && pdu_last_byte <= segm_last_byte)) {
-        RlcInfo("Got SDU segment with duplicate bytes. Discarding.");
-        RlcInfo("Discarded SDU segment. SN=%d, SO=%d, last_byte=%d, payload=%d",
-                header.sn,
-                header.so,
-                header.so + (nof_bytes - hdr_len),
-                (nof_bytes - hdr_len));
-        RlcInfo("Overlaping with SDU segment with SN=%d, SO=%d, last_byte=%d, payload=%d",
-                header.sn,
-                segm.header.so,
-                segm_last_byte,
-                segm.buf->N_bytes);
-        return;
-      }
+    const rlc_amd_rx_sdu_nr_t::segment_list_t& segments = (*rx_window)[header.sn].segments;
+    if (segments.overlaps({header.so, header.so + (nof_bytes - hdr_len)})) {
+      RlcInfo("Got SDU segment with duplicate bytes. Discarding.");
+      RlcInfo("Discarded SDU segment. SN=%d, SO=%d, last_byte=%d, payload=%d",
+              header.sn,
+              header.so,
+              header.so + (nof_bytes - hdr_len),
+              (nof_bytes - hdr_len));
+      return;
     }
   }
 
@@ -1524,6 +1535,8 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
    * - if all bytes of the RLC SDU with SN = x are received:
    */
   if (rx_window->has_sn(header.sn) && (*rx_window)[header.sn].fully_received) {
+    rx_sdu_complete->set(header.sn % rx_window_size());
+
     /*
      * - reassemble the RLC SDU from AMD PDU(s) with SN = x, remove RLC headers when doing so and deliver
      *   the reassembled RLC SDU to upper layer;
@@ -1536,20 +1549,9 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
      * all bytes have been received.
      */
     if (rx_mod_base_nr(header.sn) == rx_mod_base_nr(st.rx_highest_status)) {
-      uint32_t sn_upd = 0;
-      for (sn_upd = (st.rx_highest_status + 1) % mod_nr; rx_mod_base_nr(sn_upd) < rx_mod_base_nr(st.rx_next_highest);
-           sn_upd = (sn_upd + 1) % mod_nr) {
-        if (rx_window->has_sn(sn_upd)) {
-          if (not(*rx_window)[sn_upd].fully_received) {
-            break; // first SDU not fully received
-          }
-        } else {
-          break; // first SDU not fully received
-        }
-      }
       // Update to the SN of the first SDU with missing bytes.
       // If it not exists, update to the end of the rx_window.
-      st.rx_highest_status = sn_upd;
+      st.rx_highest_status = find_first_missing_sn((st.rx_highest_status + 1) % mod_nr, st.rx_next_highest);
     }
     /*
      * - if x = RX_Next:
@@ -1568,6 +1570,7 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
           // RX_Next serves as the lower edge of the receiving window
           // As such, we remove any SDU from the window if we update this value
           rx_window->remove_pdu(sn_upd);
+          rx_sdu_complete->reset(sn_upd % rx_window_size());
         } else {
           break; // first SDU not fully received
         }
@@ -1682,35 +1685,20 @@ int rlc_am_nr_rx::handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header,
   // Add a new SDU to the RX window if necessary
   rlc_amd_rx_sdu_nr_t& rx_sdu = rx_window->has_sn(header.sn) ? (*rx_window)[header.sn] : rx_window->add_pdu(header.sn);
 
-  // Create PDU segment info, to be stored later
-  rlc_amd_rx_pdu_nr pdu_segment = {};
-  pdu_segment.header            = header;
-  pdu_segment.buf               = srsran::make_byte_buffer();
-  if (pdu_segment.buf == nullptr) {
-    RlcError("fatal error. Couldn't allocate PDU in %s.", __FUNCTION__);
+  // Store SDU segment in place. Duplicate bytes have already been discarded
+  if (not insert_received_segment(rx_sdu, header.so, payload + hdr_len, nof_bytes - hdr_len)) {
     return SRSRAN_ERROR;
   }
-  memcpy(pdu_segment.buf->msg, payload + hdr_len, nof_bytes - hdr_len); // Don't copy header
-  pdu_segment.buf->N_bytes = nof_bytes - hdr_len;
-
-  // Store SDU segment. Sort by SO and check for duplicate bytes.
-  insert_received_segment(std::move(pdu_segment), rx_sdu.segments);
+  if (header.si == rlc_nr_si_field_t::last_segment) {
+    rx_sdu.last_segment_received = true;
+    rx_sdu.sdu_len               = header.so + nof_bytes - hdr_len;
+  }
 
   // Check weather all segments have been received
   update_segment_inventory(rx_sdu);
   if (rx_sdu.fully_received) {
     RlcInfo("Fully received segmented SDU. SN=%d.", header.sn);
-    rx_sdu.buf = srsran::make_byte_buffer();
-    if (rx_sdu.buf == nullptr) {
-      RlcError("fatal error. Couldn't allocate PDU in %s.", __FUNCTION__);
-      rx_window->remove_pdu(header.sn);
-      return SRSRAN_ERROR;
-    }
-    // Assemble SDU from segments
-    for (const auto& it : rx_sdu.segments) {
-      memcpy(&rx_sdu.buf->msg[rx_sdu.buf->N_bytes], it.buf->msg, it.buf->N_bytes);
-      rx_sdu.buf->N_bytes += it.buf->N_bytes;
-    }
+    rx_sdu.buf->N_bytes = rx_sdu.sdu_len;
   }
   return SRSRAN_SUCCESS;
 }
@@ -1726,90 +1714,9 @@ uint32_t rlc_am_nr_rx::get_status_pdu(rlc_am_nr_status_pdu_t* status, uint32_t m
   }
 
   status->reset();
-
-  /*
-   * - for the RLC SDUs with SN such that RX_Next <= SN < RX_Highest_Status that has not been completely
-   *   received yet, in increasing SN order of RLC SDUs and increasing byte segment order within RLC SDUs,
-   *   starting with SN = RX_Next up to the point where the resulting STATUS PDU still fits to the total size of RLC
-   *   PDU(s) indicated by lower layer:
-   */
-  RlcDebug("Generating status PDU");
-  for (uint32_t i = st.rx_next; rx_mod_base_nr(i) < rx_mod_base_nr(st.rx_highest_status); i = (i + 1) % mod_nr) {
-    if ((rx_window->has_sn(i) && (*rx_window)[i].fully_received)) {
-      RlcDebug("SDU SN=%d is fully received", i);
-    } else {
-      if (not rx_window->has_sn(i)) {
-        // No segment received, NACK the whole SDU
-        RlcDebug("Adding NACK for full SDU. NACK SN=%d", i);
-        rlc_status_nack_t nack;
-        nack.nack_sn = i;
-        nack.has_so  = false;
-        status->push_nack(nack);
-      } else if (not(*rx_window)[i].fully_received) {
-        // Some segments were received, but not all.
-        // NACK non consecutive missing bytes
-        RlcDebug("Adding NACKs for segmented SDU. NACK SN=%d", i);
-        uint32_t last_so         = 0;
-        bool     last_segment_rx = false;
-        for (auto segm = (*rx_window)[i].segments.begin(); segm != (*rx_window)[i].segments.end(); segm++) {
-          if (segm->header.so != last_so) {
-            // Some bytes were not received
-            rlc_status_nack_t nack;
-            nack.nack_sn  = i;
-            nack.has_so   = true;
-            nack.so_start = last_so;
-            nack.so_end   = segm->header.so - 1; // set to last missing byte
-            status->push_nack(nack);
-            if (nack.so_start > nack.so_end) {
-              // Print segment list
-              for (auto segm_it = (*rx_window)[i].segments.begin(); segm_it != (*rx_window)[i].segments.end();
-                   segm_it++) {
-                RlcError("Segment: segm.header.so=%d, segm.buf.N_bytes=%d", segm_it->header.so, segm_it->buf->N_bytes);
-              }
-              RlcError("Error: SO_start=%d > SO_end=%d. NACK_SN=%d. SO_start=%d, SO_end=%d, seg.so=%d",
-                       nack.so_start,
-                       nack.so_end,
-                       nack.nack_sn,
-                       nack.so_start,
-                       nack.so_end,
-                       segm->header.so);
-              srsran_assert(nack.so_start <= nack.so_end,
-                            "Error: SO_start=%d > SO_end=%d. NACK_SN=%d",
-                            nack.so_start,
-                            nack.so_end,
-                            nack.nack_sn);
-            } else {
-              RlcDebug("First/middle segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d",
-                       nack.nack_sn,
-                       nack.so_start,
-                       nack.so_end);
-            }
-          }
-          if (segm->header.si == rlc_nr_si_field_t::last_segment) {
-            last_segment_rx = true;
-          }
-          last_so = segm->header.so + segm->buf->N_bytes;
-        } // Segment loop
-        if (not last_segment_rx) {
-          rlc_status_nack_t nack;
-          nack.nack_sn  = i;
-          nack.has_so   = true;
-          nack.so_start = last_so;
-          nack.so_end   = rlc_status_nack_t::so_end_of_sdu;
-          status->push_nack(nack);
-          RlcDebug(
-              "Final segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d", nack.nack_sn, nack.so_start, nack.so_end);
-          srsran_assert(nack.so_start <= nack.so_end, "Error: SO_start > SO_end. NACK_SN=%d", nack.nack_sn);
-        }
-      }
-    }
-  } // NACK loop
-
-  /*
-   * - set the ACK_SN to the SN of the next not received RLC SDU which is not
-   * indicated as missing in the resulting STATUS PDU.
-   */
-  status->ack_sn = st.rx_highest_status;
+  build_status_pdu(status);
+  status_pdu_len       = status->packed_size;
+  status_pdu_len_valid = true;
 
   // trim PDU if necessary
   if (status->packed_size > max_len) {
@@ -1836,11 +1743,115 @@ uint32_t rlc_am_nr_rx::get_status_pdu(rlc_am_nr_status_pdu_t* status, uint32_t m
 
 uint32_t rlc_am_nr_rx::get_status_pdu_length()
 {
-  rlc_am_nr_status_pdu_t tmp_status(cfg.rx_sn_field_length);
-  get_status_pdu(&tmp_status, UINT32_MAX);
-  return tmp_status.get_packed_size();
+  std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+  if (not lock.owns_lock()) {
+    return rlc_am_nr_status_pdu_sizeof_header_ack_sn;
+  }
+
+  // The status PDU only changes with the RX state, build it again only if needed
+  if (not status_pdu_len_valid) {
+    rlc_am_nr_status_pdu_t tmp_status(cfg.rx_sn_field_length);
+    build_status_pdu(&tmp_status);
+    status_pdu_len       = tmp_status.get_packed_size();
+    status_pdu_len_valid = true;
+  }
+  return status_pdu_len;
 }
 
+/**
+ * Builds the untrimmed status PDU of the current RX state.
+ *
+ * Only the SNs that have not been fully received are visited, so the cost depends on the number of missing SDUs
+ * and not on the size of the RX window.
+ */
+void rlc_am_nr_rx::build_status_pdu(rlc_am_nr_status_pdu_t* status) const
+{
+  /*
+   * - for the RLC SDUs with SN such that RX_Next <= SN < RX_Highest_Status that has not been completely
+   *   received yet, in increasing SN order of RLC SDUs and increasing byte segment order within RLC SDUs,
+   *   starting with SN = RX_Next up to the point where the resulting STATUS PDU still fits to the total size of RLC
+   *   PDU(s) indicated by lower layer:
+   */
+  RlcDebug("Generating status PDU");
+  uint32_t i = find_first_missing_sn(st.rx_next, st.rx_highest_status);
+  for (; i != st.rx_highest_status; i = find_first_missing_sn((i + 1) % mod_nr, st.rx_highest_status)) {
+    if (not rx_window->has_sn(i)) {
+      // No segment received, NACK the whole SDU
+      RlcDebug("Adding NACK for full SDU. NACK SN=%d", i);
+      rlc_status_nack_t nack;
+      nack.nack_sn = i;
+      nack.has_so  = false;
+      status->push_nack(nack);
+      continue;
+    }
+
+    // Some segments were received, but not all.
+    // NACK non consecutive missing bytes
+    RlcDebug("Adding NACKs for segmented SDU. NACK SN=%d", i);
+    uint32_t last_so = 0;
+    for (const interval<uint32_t>& segm : (*rx_window)[i].segments) {
+      if (segm.start() != last_so) {
+        // Some bytes were not received
+        rlc_status_nack_t nack;
+        nack.nack_sn  = i;
+        nack.has_so   = true;
+        nack.so_start = last_so;
+        nack.so_end   = segm.start() - 1; // set to last missing byte
+        status->push_nack(nack);
+        RlcDebug("First/middle segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d",
+                 nack.nack_sn,
+                 nack.so_start,
+                 nack.so_end);
+      }
+      last_so = segm.stop();
+    } // Segment loop
+    if (not(*rx_window)[i].last_segment_received) {
+      rlc_status_nack_t nack;
+      nack.nack_sn  = i;
+      nack.has_so   = true;
+      nack.so_start = last_so;
+      nack.so_end   = rlc_status_nack_t::so_end_of_sdu;
+      status->push_nack(nack);
+      RlcDebug("Final segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d", nack.nack_sn, nack.so_start, nack.so_end);
+    }
+  } // NACK loop
+
+  /*
+   * - set the ACK_SN to the SN of the next not received RLC SDU which is not
+   * indicated as missing in the resulting STATUS PDU.
+   */
+  status->ack_sn = st.rx_highest_status;
+
+}
+
+/**
+ * Returns the first SN in [start_sn, end_sn) for which not all bytes have been received, or end_sn if there is none.
+ * If start_sn is not before end_sn, start_sn is returned.
+ */
+uint32_t rlc_am_nr_rx::find_first_missing_sn(uint32_t start_sn, uint32_t end_sn) const
+{
+  if (rx_mod_base_nr(start_sn) >= rx_mod_base_nr(end_sn)) {
+    return start_sn;
+  }
+  uint32_t nof_sn = rx_mod_base_nr(end_sn) - rx_mod_base_nr(start_sn);
+
+  // The SNs are searched in the bitset up to its end and then from its start, if they wrap around
+  uint32_t start_pos   = start_sn % rx_window_size();
+  uint32_t nof_sn_head = std::min(nof_sn, rx_window_size() - start_pos);
+  int      pos         = rx_sdu_complete->find_lowest(start_pos, start_pos + nof_sn_head, false);
+  if (pos >= 0) {
+    return (start_sn + (pos - start_pos)) % mod_nr;
+  }
+  if (nof_sn_head < nof_sn) {
+    pos = rx_sdu_complete->find_lowest(0, nof_sn - nof_sn_head, false);
+    if (pos >= 0) {
+      return (start_sn + nof_sn_head + pos) % mod_nr;
+    }
+  }
+  return end_sn;
+}
+
+
 bool rlc_am_nr_rx::get_do_status()
 {
   if (cfg.t_status_prohibit != 0) {
@@ -1873,14 +1884,8 @@ void rlc_am_nr_rx::timer_expired(uint32_t timeout_id)
      *   - start t-Reassembly;
      *   - set RX_Next_Status_Trigger to RX_Next_Highest.
      */
-    uint32_t sn_upd = {};
-    for (sn_upd = st.rx_next_status_trigger; rx_mod_base_nr(sn_upd) < rx_mod_base_nr(st.rx_next_highest);
-         sn_upd = (sn_upd + 1) % mod_nr) {
-      if (not rx_window->has_sn(sn_upd) || (rx_window->has_sn(sn_upd) && not(*rx_window)[sn_upd].fully_received)) {
-        break;
-      }
-    }
-    st.rx_highest_status = sn_upd;
+    st.rx_highest_status  = find_first_missing_sn(st.rx_next_status_trigger, st.rx_next_highest);
+    status_pdu_len_valid = false;
     if (not valid_ack_sn(st.rx_highest_status)) {
       RlcError("Rx_Highest_Status not inside RX window");
       debug_state();
@@ -1925,10 +1930,32 @@ void rlc_am_nr_rx::write_to_upper_layers(uint32_t lcid, unique_byte_buffer_t sdu
 /*
  * Segment Helpers
  */
-void rlc_am_nr_rx::insert_received_segment(rlc_amd_rx_pdu_nr                                   segment,
-                                           std::set<rlc_amd_rx_pdu_nr, rlc_amd_rx_pdu_nr_cmp>& segment_list) const
+bool rlc_am_nr_rx::insert_received_segment(rlc_amd_rx_sdu_nr_t& rx_sdu,
+                                           uint32_t             so,
+                                           const uint8_t*       data,
+                                           uint32_t             len) const
 {
-  segment_list.insert(std::move(segment));
+  if (rx_sdu.buf == nullptr) {
+    rx_sdu.buf = srsran::make_byte_buffer();
+    if (rx_sdu.buf == nullptr) {
+      RlcError("fatal error. Couldn't allocate PDU in %s.", __FUNCTION__);
+      return false;
+    }
+  }
+  if (so + len > rx_sdu.buf->get_tailroom()) {
+    RlcError("discarding segment SN=%d, SO=%d of size %d B (available space %d B)",
+             rx_sdu.rlc_sn,
+             so,
+             len,
+             rx_sdu.buf->get_tailroom());
+    return false;
+  }
+  if (not rx_sdu.segments.insert({so, so + len})) {
+    RlcInfo("Too many gaps in SDU SN=%d. Discarding segment SO=%d", rx_sdu.rlc_sn, so);
+    return false;
+  }
+  memcpy(rx_sdu.buf->msg + so, data, len);
+  return true;
 }
 
 void rlc_am_nr_rx::update_segment_inventory(rlc_amd_rx_sdu_nr_t& rx_sdu) const
@@ -1939,26 +1966,10 @@ void rlc_am_nr_rx::update_segment_inventory(rlc_amd_rx_sdu_nr_t& rx_sdu) const
     return;
   }
 
-  // Check for gaps and if all segments have been received
-  uint32_t next_byte = 0;
-  for (const auto& it : rx_sdu.segments) {
-    if (it.header.so != next_byte) {
-      // Found gap: set flags and return
-      rx_sdu.has_gap        = true;
-      rx_sdu.fully_received = false;
-      return;
-    }
-    if (it.header.si == rlc_nr_si_field_t::last_segment) {
-      // Reached last segment without any gaps: set flags and return
-      rx_sdu.has_gap        = false;
-      rx_sdu.fully_received = true;
-      return;
-    }
-    next_byte += it.buf->N_bytes;
-  }
-  // No gaps, but last segment not yet received
-  rx_sdu.has_gap        = false;
-  rx_sdu.fully_received = false;
+  // Received bytes form a single range from the start of the SDU unless there are gaps
+  const interval<uint32_t>& first = rx_sdu.segments.front();
+  rx_sdu.has_gap                  = rx_sdu.segments.size() > 1 or first.start() != 0;
+  rx_sdu.fully_received = not rx_sdu.has_gap and rx_sdu.last_segment_received and first.stop() == rx_sdu.sdu_len;
 }
 
 /*
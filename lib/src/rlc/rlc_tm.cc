@@ -50,11 +50,12 @@ bool rlc_tm::configure(const rlc_config_t& cnfg)
 
 void rlc_tm::empty_queue()
 {
+  std::lock_guard<std::mutex> lock(read_mutex);
+
   // Drop all messages in TX queue
   unique_byte_buffer_t buf;
   while (ul_queue.try_read(&buf)) {
   }
-  ul_queue.reset();
 }
 
 void rlc_tm::reestablish()
@@ -86,14 +87,17 @@ void rlc_tm::write_sdu(unique_byte_buffer_t sdu)
     return;
   }
   if (sdu != nullptr) {
-    uint8_t*                                 msg_ptr   = sdu->msg;
-    uint32_t                                 nof_bytes = sdu->N_bytes;
-    srsran::error_type<unique_byte_buffer_t> ret       = ul_queue.try_write(std::move(sdu));
-    if (ret) {
-      RlcHexInfo(msg_ptr, nof_bytes, "Tx SDU, queue size=%d, bytes=%d", ul_queue.size(), ul_queue.size_bytes());
+    // The queue is lock-free and this is its only writer, so the SDU is logged before it becomes visible to read_pdu()
+    if (not ul_queue.is_full()) {
+      RlcHexInfo(sdu->msg,
+                 sdu->N_bytes,
+                 "Tx SDU, queue size=%d, bytes=%d",
+                 ul_queue.size() + 1,
+                 ul_queue.size_bytes() + sdu->N_bytes);
+      ul_queue.try_write(std::move(sdu));
     } else {
-      RlcHexWarning(ret.error()->msg,
-                    ret.error()->N_bytes,
+      RlcHexWarning(sdu->msg,
+                    sdu->N_bytes,
                     "[Dropped SDU] Tx SDU, queue size=%d, bytes=%d",
                     ul_queue.size(),
                     ul_queue.size_bytes());
@@ -155,6 +159,8 @@ void rlc_tm::reset_metrics()
 
 uint32_t rlc_tm::read_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
+  std::lock_guard<std::mutex> lock(read_mutex);
+
   uint32_t pdu_size = ul_queue.size_tail_bytes();
   if (pdu_size > nof_bytes) {
     RlcInfo("Tx PDU size larger than MAC opportunity (%d > %d)", pdu_size, nof_bytes);
@@ -176,11 +182,6 @@ uint32_t rlc_tm::read_pdu(uint8_t* payload, uint32_t nof_bytes)
     metrics.num_tx_pdu_bytes += pdu_size;
     return pdu_size;
   }
-
-  if (ul_queue.size_bytes() > 0) {
-    RlcWarning("Corrupted queue: empty but size_bytes > 0. Resetting queue");
-    ul_queue.reset();
-  }
   return 0;
 }
 
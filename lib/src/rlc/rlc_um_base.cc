@@ -260,11 +260,12 @@ void rlc_um_base::rlc_um_base_tx::empty_queue()
 
   // deallocate SDU that is currently processed
   tx_sdu.reset();
+  tx_sdu_bytes = 0;
 }
 
 bool rlc_um_base::rlc_um_base_tx::has_data()
 {
-  return (tx_sdu != nullptr || !tx_sdu_queue.is_empty());
+  return (tx_sdu_bytes != 0 || tx_sdu_queue.get_n_sdus() != 0);
 }
 
 void rlc_um_base::rlc_um_base_tx::set_bsr_callback(bsr_callback_t callback)
@@ -285,18 +286,19 @@ void rlc_um_base::rlc_um_base_tx::write_sdu(unique_byte_buffer_t sdu)
 int rlc_um_base::rlc_um_base_tx::try_write_sdu(unique_byte_buffer_t sdu)
 {
   if (sdu) {
-    uint8_t*                                 msg_ptr   = sdu->msg;
-    uint32_t                                 nof_bytes = sdu->N_bytes;
-    srsran::error_type<unique_byte_buffer_t> ret       = tx_sdu_queue.try_write(std::move(sdu));
-    if (ret) {
-      RlcHexInfo(msg_ptr, nof_bytes, "Tx SDU (%d B, tx_sdu_queue_len=%d)", nof_bytes, tx_sdu_queue.size());
-      return SRSRAN_SUCCESS;
+    // The queue is lock-free and this is its only writer, so the SDU is logged before it becomes visible to read_pdu()
+    if (not tx_sdu_queue.is_full()) {
+      RlcHexInfo(sdu->msg, sdu->N_bytes, "Tx SDU (%d B, tx_sdu_queue_len=%d)", sdu->N_bytes, tx_sdu_queue.size() + 1);
+      srsran::error_type<unique_byte_buffer_t> ret = tx_sdu_queue.try_write(std::move(sdu));
+      if (ret) {
+        return SRSRAN_SUCCESS;
+      }
     } else {
-      RlcHexWarning(ret.error()->msg,
-                    ret.error()->N_bytes,
+      RlcHexWarning(sdu->msg,
+                    sdu->N_bytes,
                     "[Dropped SDU] %s Tx SDU (%d B, tx_sdu_queue_len=%d)",
                     rb_name.c_str(),
-                    ret.error()->N_bytes,
+                    sdu->N_bytes,
                     tx_sdu_queue.size());
     }
   } else {
@@ -311,8 +313,8 @@ void rlc_um_base::rlc_um_base_tx::discard_sdu(uint32_t discard_sn)
 
   bool discarded = tx_sdu_queue.apply_first([&discard_sn, this](unique_byte_buffer_t& sdu) {
     if (sdu != nullptr && sdu->md.pdcp_sn == discard_sn) {
-      tx_sdu_queue.queue.pop_func(sdu);
       sdu = nullptr;
+      return true;
     }
     return false;
   });
@@ -328,23 +330,13 @@ bool rlc_um_base::rlc_um_base_tx::sdu_queue_is_full()
 
 uint32_t rlc_um_base::rlc_um_base_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
-  unique_byte_buffer_t pdu;
-  {
-    std::lock_guard<std::mutex> lock(mutex);
-    RlcDebug("MAC opportunity - %d bytes", nof_bytes);
-
-    if (tx_sdu == nullptr && tx_sdu_queue.is_empty()) {
-      RlcInfo("No data available to be sent");
-      return 0;
-    }
+  RlcDebug("MAC opportunity - %d bytes", nof_bytes);
 
-    pdu = make_byte_buffer();
-    if (!pdu || pdu->N_bytes != 0) {
-      RlcError("Failed to allocate PDU buffer");
-      return 0;
-    }
+  if (tx_sdu_bytes == 0 && tx_sdu_queue.get_n_sdus() == 0) {
+    RlcInfo("No data available to be sent");
+    return 0;
   }
-  return build_data_pdu(std::move(pdu), payload, nof_bytes);
+  return build_data_pdu_impl(payload, nof_bytes);
 }
 
 } // namespace srsran
@@ -79,14 +79,13 @@ rlc_um_lte::rlc_um_lte_tx::rlc_um_lte_tx(rlc_um_base* parent_) : rlc_um_base_tx(
 
 uint32_t rlc_um_lte::rlc_um_lte_tx::get_buffer_state()
 {
-  std::lock_guard<std::mutex> lock(mutex);
-
   // Bytes needed for tx SDUs
-  uint32_t n_sdus  = tx_sdu_queue.size();
-  uint32_t n_bytes = tx_sdu_queue.size_bytes();
-  if (tx_sdu) {
+  uint32_t n_sdus         = tx_sdu_queue.get_n_sdus();
+  uint32_t n_bytes        = tx_sdu_queue.size_bytes();
+  uint32_t n_bytes_tx_sdu = tx_sdu_bytes;
+  if (n_bytes_tx_sdu > 0) {
     n_sdus++;
-    n_bytes += tx_sdu->N_bytes;
+    n_bytes += n_bytes_tx_sdu;
   }
 
   // Room needed for header extensions? (integer rounding)
@@ -121,7 +120,7 @@ bool rlc_um_lte::rlc_um_lte_tx::configure(const rlc_config_t& cnfg_, std::string
   return true;
 }
 
-uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes)
+uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu_impl(uint8_t* payload, uint32_t nof_bytes)
 {
   std::lock_guard<std::mutex> lock(mutex);
   rlc_umd_pdu_header_t        header = {};
@@ -130,47 +129,31 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
   header.N_li    = 0;
   header.sn_size = cfg.um.tx_sn_field_length;
 
-  uint32_t to_move = 0;
-  uint32_t last_li = 0;
-  uint8_t* pdu_ptr = pdu->msg;
-
-  int head_len  = rlc_um_packed_length(&header);
-  int pdu_space = SRSRAN_MIN(nof_bytes, pdu->get_tailroom());
+  uint32_t to_move   = 0;
+  uint32_t last_li   = 0;
+  uint32_t head_len  = rlc_um_packed_length(&header);
+  uint32_t pdu_space = nof_bytes;
 
   if (pdu_space <= head_len + 1) {
     RlcInfo("Cannot build a PDU - %d bytes available, %d bytes required for header", nof_bytes, head_len);
     return 0;
   }
 
-  // Check for SDU segment
+  // The header length depends on the number of SDUs in the PDU. Select the SDU segments first, so that the header and
+  // the segments can then be written straight into the MAC payload, without packing the PDU in a separate buffer
+  uint32_t first_seg_len = 0;
   if (tx_sdu) {
     uint32_t space = pdu_space - head_len;
-    to_move        = space >= tx_sdu->N_bytes ? tx_sdu->N_bytes : space;
-    RlcDebug("adding remainder of SDU segment - %d bytes of %d remaining", to_move, tx_sdu->N_bytes);
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
-    last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (tx_sdu->N_bytes == 0) {
-#ifdef ENABLE_TIMESTAMP
-      auto latency_us = tx_sdu->get_latency_us().count();
-      mean_pdu_latency_us.push(latency_us);
-      RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
-               (uint64_t)latency_us,
-               (long)mean_pdu_latency_us.value());
-#else
-      RlcDebug("%s Complete SDU scheduled for tx.", rb_name.c_str());
-#endif
-      tx_sdu.reset();
-    }
-    pdu_space -= SRSRAN_MIN(to_move, pdu->get_tailroom());
+    first_seg_len  = SRSRAN_MIN(space, tx_sdu->N_bytes);
+    RlcDebug("adding remainder of SDU segment - %d bytes of %d remaining", first_seg_len, tx_sdu->N_bytes);
+    last_li = first_seg_len;
+    pdu_space -= first_seg_len;
     header.fi |= RLC_FI_FIELD_NOT_START_ALIGNED; // First byte does not correspond to first byte of SDU
   }
 
   // Pull SDUs from queue
-  while (pdu_space > head_len + 1 && tx_sdu_queue.size() > 0) {
+  pdu_sdus.clear();
+  while (pdu_space > head_len + 1 && tx_sdu_queue.get_n_sdus() > 0 && header.N_li < RLC_AM_WINDOW_SIZE) {
     RlcDebug("pdu_space=%d, head_len=%d", pdu_space, head_len);
     if (last_li > 0) {
       header.li[header.N_li++] = last_li;
@@ -182,31 +165,21 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
       header.N_li--;
       break;
     }
-    tx_sdu  = tx_sdu_queue.read();
-    to_move = (space >= tx_sdu->N_bytes) ? tx_sdu->N_bytes : space;
-    RlcDebug("adding new SDU segment - %d bytes of %d remaining", to_move, tx_sdu->N_bytes);
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
+    // Skip the SDUs discarded by PDCP, a valid one is queued behind them
+    unique_byte_buffer_t sdu;
+    do {
+      sdu = tx_sdu_queue.read();
+    } while (sdu == nullptr);
+    pdu_sdus.push_back(std::move(sdu));
+    to_move = SRSRAN_MIN(space, pdu_sdus.back()->N_bytes);
+    RlcDebug("adding new SDU segment - %d bytes of %d remaining", to_move, pdu_sdus.back()->N_bytes);
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (tx_sdu->N_bytes == 0) {
-#ifdef ENABLE_TIMESTAMP
-      auto latency_us = tx_sdu->get_latency_us().count();
-      mean_pdu_latency_us.push(latency_us);
-      RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
-               (uint64_t)latency_us,
-               (long)mean_pdu_latency_us.value());
-#else
-      RlcDebug("Complete SDU scheduled for tx.");
-#endif
-      tx_sdu.reset();
-    }
     pdu_space -= to_move;
   }
 
-  if (tx_sdu) {
+  // Only the last SDU of the PDU may be segmented
+  uint32_t last_sdu_len = pdu_sdus.empty() ? (tx_sdu ? tx_sdu->N_bytes : 0) : pdu_sdus.back()->N_bytes;
+  if (last_li < last_sdu_len) {
     header.fi |= RLC_FI_FIELD_NOT_END_ALIGNED; // Last byte does not correspond to last byte of SDU
   }
 
@@ -214,15 +187,45 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
   header.sn = vt_us;
   vt_us     = (vt_us + 1) % cfg.um.tx_mod;
 
-  // Add header and TX
-  rlc_um_write_data_pdu_header(&header, pdu.get());
-  memcpy(payload, pdu->msg, pdu->N_bytes);
+  // Add header and SDU segments
+  uint8_t* pdu_ptr = payload;
+  rlc_um_write_data_pdu_header(&header, &pdu_ptr);
+  if (tx_sdu) {
+    copy_sdu_segment(&pdu_ptr, first_seg_len);
+  }
+  for (uint32_t i = 0; i < pdu_sdus.size(); ++i) {
+    tx_sdu = std::move(pdu_sdus[i]);
+    copy_sdu_segment(&pdu_ptr, (i + 1 == pdu_sdus.size()) ? last_li : tx_sdu->N_bytes);
+  }
+  pdu_sdus.clear();
 
-  RlcHexInfo(payload, pdu->N_bytes, "Tx PDU SN=%d (%d B)", header.sn, pdu->N_bytes);
+  uint32_t pdu_len = pdu_ptr - payload;
+  RlcHexInfo(payload, pdu_len, "Tx PDU SN=%d (%d B)", header.sn, pdu_len);
 
   debug_state();
 
-  return pdu->N_bytes;
+  return pdu_len;
+}
+
+void rlc_um_lte::rlc_um_lte_tx::copy_sdu_segment(uint8_t** pdu_ptr, uint32_t nof_bytes)
+{
+  memcpy(*pdu_ptr, tx_sdu->msg, nof_bytes);
+  *pdu_ptr += nof_bytes;
+  tx_sdu->N_bytes -= nof_bytes;
+  tx_sdu->msg += nof_bytes;
+  if (tx_sdu->N_bytes == 0) {
+#ifdef ENABLE_TIMESTAMP
+    auto latency_us = tx_sdu->get_latency_us().count();
+    mean_pdu_latency_us.push(latency_us);
+    RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
+             (uint64_t)latency_us,
+             (long)mean_pdu_latency_us.value());
+#else
+    RlcDebug("Complete SDU scheduled for tx.");
+#endif
+    tx_sdu.reset();
+  }
+  tx_sdu_bytes = tx_sdu != nullptr ? tx_sdu->N_bytes : 0;
 }
 
 void rlc_um_lte::rlc_um_lte_tx::debug_state()
@@ -761,12 +764,19 @@ void rlc_um_read_data_pdu_header(uint8_t*              payload,
 
 void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* pdu)
 {
-  uint32_t i;
-  uint8_t  ext = (header->N_li > 0) ? 1 : 0;
   // Make room for the header
   uint32_t len = rlc_um_packed_length(header);
   pdu->msg -= len;
   uint8_t* ptr = pdu->msg;
+  rlc_um_write_data_pdu_header(header, &ptr);
+  pdu->N_bytes += len;
+}
+
+void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, uint8_t** payload)
+{
+  uint32_t i;
+  uint8_t  ext = (header->N_li > 0) ? 1 : 0;
+  uint8_t* ptr = *payload;
 
   // Fixed part
   if (header->sn_size == rlc_umd_sn_size_t::size5bits) {
@@ -806,7 +816,7 @@ void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* p
   if (header->N_li % 2 == 1)
     ptr++;
 
-  pdu->N_bytes += ptr - pdu->msg;
+  *payload = ptr;
 }
 
 uint32_t rlc_um_packed_length(rlc_umd_pdu_header_t* header)
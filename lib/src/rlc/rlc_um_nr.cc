@@ -87,14 +87,13 @@ rlc_um_nr::rlc_um_nr_tx::rlc_um_nr_tx(rlc_um_base* parent_) : rlc_um_base_tx(par
 
 uint32_t rlc_um_nr::rlc_um_nr_tx::get_buffer_state()
 {
-  std::lock_guard<std::mutex> lock(mutex);
-
   // Bytes needed for tx SDUs
-  uint32_t n_sdus  = tx_sdu_queue.get_n_sdus();
-  uint32_t n_bytes = tx_sdu_queue.size_bytes();
-  if (tx_sdu) {
+  uint32_t n_sdus         = tx_sdu_queue.get_n_sdus();
+  uint32_t n_bytes        = tx_sdu_queue.size_bytes();
+  uint32_t n_bytes_tx_sdu = tx_sdu_bytes;
+  if (n_bytes_tx_sdu > 0) {
     n_sdus++;
-    n_bytes += tx_sdu->N_bytes;
+    n_bytes += n_bytes_tx_sdu;
   }
 
   // Room needed for header extensions? (integer rounding)
@@ -136,7 +135,7 @@ bool rlc_um_nr::rlc_um_nr_tx::configure(const rlc_config_t& cnfg_, std::string r
   return true;
 }
 
-uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes)
+uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu_impl(uint8_t* payload, uint32_t nof_bytes)
 {
   // Sanity check (we need at least 2B for a SDU)
   if (nof_bytes < 2) {
@@ -144,6 +143,12 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
     return 0;
   }
 
+  unique_byte_buffer_t pdu = make_byte_buffer();
+  if (!pdu || pdu->N_bytes != 0) {
+    RlcError("Failed to allocate PDU buffer");
+    return 0;
+  }
+
   std::lock_guard<std::mutex> lock(mutex);
   rlc_um_nr_pdu_header_t      header = {};
   header.si                          = rlc_nr_si_field_t::full_sdu;
@@ -154,15 +159,15 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
 
   // Select segmentation information and header size
   if (tx_sdu == nullptr) {
-    // Read a new SDU
-    do {
-      tx_sdu = tx_sdu_queue.read();
-    } while (tx_sdu == nullptr && tx_sdu_queue.size() != 0);
+    // Read a new SDU, skipping the discarded ones. Do not block, the queue may have been emptied meanwhile
+    while (tx_sdu_queue.try_read(&tx_sdu) && tx_sdu == nullptr) {
+    }
     if (tx_sdu == nullptr) {
       RlcDebug("Cannot build any PDU, tx_sdu_queue has no non-null SDU.");
       return 0;
     }
-    next_so = 0;
+    tx_sdu_bytes = tx_sdu->N_bytes;
+    next_so      = 0;
 
     // Check for full SDU case
     if (tx_sdu->N_bytes <= pdu_space - head_len_full) {
@@ -206,6 +211,7 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
   if (tx_sdu->N_bytes == 0) {
     tx_sdu.reset();
   }
+  tx_sdu_bytes = tx_sdu != nullptr ? tx_sdu->N_bytes : 0;
 
   // advance SO offset
   next_so += to_move;
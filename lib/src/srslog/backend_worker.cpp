@@ -73,6 +73,9 @@ void backend_worker::create_worker(backend_priority priority)
   assert(!running_flag && "Only one worker thread should be created");
 
   std::thread t([this, priority]() {
+    // Name the thread so that it can be told apart from the one that started it, e.g. when placing it on a CPU.
+    std::string name = (index == 0) ? "SRSLOG" : fmt::format("SRSLOG{}", index);
+    ::pthread_setname_np(::pthread_self(), name.c_str());
     running_flag = true;
     set_thread_priority(priority);
     do_work();
@@ -36,8 +36,12 @@ namespace srslog {
 class backend_worker
 {
 public:
-  backend_worker(detail::work_queue<detail::log_entry>& queue, detail::dyn_arg_store_pool& arg_pool) :
-    queue(queue), arg_pool(arg_pool), running_flag(false)
+  /// The index tells apart the threads of the different workers, the worker 0 thread is named SRSLOG and the others
+  /// SRSLOG<index>.
+  backend_worker(detail::work_queue<detail::log_entry>& queue,
+                 detail::dyn_arg_store_pool&            arg_pool,
+                 unsigned                               index = 0) :
+    queue(queue), arg_pool(arg_pool), index(index), running_flag(false)
   {}
 
   backend_worker(const backend_worker&) = delete;
@@ -113,6 +117,7 @@ private:
 private:
   detail::work_queue<detail::log_entry>& queue;
   detail::dyn_arg_store_pool&            arg_pool;
+  const unsigned                         index;
   detail::shared_variable<bool>          running_flag;
   error_handler      err_handler = [](const std::string& error) { fmt::print(stderr, "srsLog error - {}\n", error); };
   std::once_flag     start_once_flag;
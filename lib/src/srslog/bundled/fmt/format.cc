@@ -6,7 +6,7 @@
 // For the license information refer to format.h.
 
 #include "fmt/format-inl.h"
-#include <mutex>
+#include "srsran/adt/mpmc_queue.h"
 
 FMT_BEGIN_NAMESPACE
 namespace detail {
@@ -25,44 +25,6 @@ int format_float(char* buf, std::size_t size, const char* format, int precision,
                        : snprintf_ptr(buf, size, format, precision, value);
 }
 
-namespace {
-
-/// This special mutex has priority inheritance to improve latency.
-class pi_mutex
-{
-public:
-  pi_mutex(const pi_mutex&) = delete;
-  pi_mutex& operator=(const pi_mutex&) = delete;
-
-  pi_mutex()
-  {
-    ::pthread_mutexattr_t mutex_attr;
-    ::pthread_mutexattr_init(&mutex_attr);
-    ::pthread_mutexattr_setprotocol(&mutex_attr, PTHREAD_PRIO_INHERIT);
-    ::pthread_mutex_init(&m, &mutex_attr);
-  }
-
-  ~pi_mutex() { ::pthread_mutex_destroy(&m); }
-
-  /// Mutex lock.
-  void lock() { ::pthread_mutex_lock(&m); }
-
-  /// Mutex unlock.
-  void unlock() { ::pthread_mutex_unlock(&m); }
-
-  /// Mutex try lock. Returns true if the lock was obtained, false otherwise.
-  bool try_lock() { return (::pthread_mutex_trylock(&m) == 0); }
-
-  /// Accessor to the raw mutex structure.
-  pthread_mutex_t*       raw() { return &m; }
-  const pthread_mutex_t* raw() const { return &m; }
-
-private:
-  pthread_mutex_t m;
-};
-
-}
-
 #define NODE_POOL_SIZE (10000u)
 static constexpr uint8_t memory_heap_tag = 0xAA;
 class dyn_node_pool
@@ -71,11 +33,10 @@ class dyn_node_pool
   using type = std::array<uint8_t, dynamic_arg_list::max_pool_node_size + 1>;
 
 public:
-  dyn_node_pool() {
+  dyn_node_pool() : free_list(NODE_POOL_SIZE) {
     pool.resize(NODE_POOL_SIZE);
-    free_list.reserve(NODE_POOL_SIZE);
     for (auto& elem : pool) {
-      free_list.push_back(elem.data());
+      free_list.try_push(elem.data());
     }
   }
 
@@ -87,17 +48,14 @@ public:
   void* alloc(std::size_t sz) {
     assert(sz <= dynamic_arg_list::max_pool_node_size && "Object is too large to fit in the pool");
 
-    std::lock_guard<pi_mutex> lock(m);
-    if (free_list.empty()) {
+    uint8_t* p = nullptr;
+    if (!free_list.try_pop(p)) {
       // Tag that this allocation was performed by the heap.
-      auto *p = new type;
-      (*p)[0] = memory_heap_tag;
-      return p->data() + 1;
+      auto *h = new type;
+      (*h)[0] = memory_heap_tag;
+      return h->data() + 1;
     }
 
-    auto* p = free_list.back();
-    free_list.pop_back();
-
     // Tag that this allocation was performed by the pool.
     p[0] = 0;
     return p + 1;
@@ -115,14 +73,13 @@ public:
       return;
     }
 
-    std::lock_guard<pi_mutex> lock(m);
-    free_list.push_back(base_ptr);
+    free_list.try_push(base_ptr);
   }
 
 private:
   std::vector<type> pool;
-  std::vector<uint8_t *> free_list;
-  mutable pi_mutex m;
+  /// Lock-free, so that the threads that generate log entries never block on the pool.
+  srsran::mpmc_queue<uint8_t*> free_list;
 };
 
 static dyn_node_pool node_pool;
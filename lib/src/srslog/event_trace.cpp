@@ -22,7 +22,15 @@
 #include "srsran/srslog/event_trace.h"
 #include "sinks/buffered_file_sink.h"
 #include "srsran/srslog/srslog.h"
+#include <algorithm>
+#include <cstdio>
 #include <ctime>
+#include <memory>
+#include <mutex>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
 
 #undef trace_duration_begin
 #undef trace_duration_end
@@ -136,3 +144,173 @@ srslog::detail::scoped_complete_event::~scoped_complete_event()
 
   (*tracer)("%s %s, %u", category, name, (unsigned)diff.count());
 }
+
+/// Hot path event as stored in the per thread buffers.
+struct hot_event {
+  const char* category;
+  const char* name;
+  uint64_t    start;
+  uint64_t    end;
+  int64_t     arg;
+};
+
+/// Ring buffer with the hot path events of a thread.
+struct hot_thread_buffer {
+  std::vector<hot_event> events;
+  /// Number of events written so far, including the overwritten ones.
+  std::atomic<uint64_t> count{0};
+  long                  tid            = 0;
+  char                  thread_name[16] = {};
+};
+
+/// Global state of the hot path tracer.
+struct hot_tracer_state {
+  std::mutex                                      mutex;
+  std::vector<std::unique_ptr<hot_thread_buffer>> buffers;
+  std::string                                     filename;
+  std::size_t                                     events_per_thread = 0;
+  uint64_t                                        ticks_start       = 0;
+  std::chrono::steady_clock::time_point           time_start;
+};
+
+static hot_tracer_state& hot_tracer()
+{
+  static hot_tracer_state state;
+  return state;
+}
+
+/// Buffer of the calling thread, allocated on its first hot path event.
+static thread_local hot_thread_buffer* thread_hot_buffer = nullptr;
+
+std::atomic<bool> srslog::detail::hot_trace_enabled{false};
+
+bool srslog::event_trace_hot_init(const std::string& filename, std::size_t events_per_thread)
+{
+  hot_tracer_state&           t = hot_tracer();
+  std::lock_guard<std::mutex> lock(t.mutex);
+  if (t.events_per_thread != 0 || events_per_thread == 0) {
+    return false;
+  }
+
+  // Keep the capacity a power of two so that the write position is a mask.
+  std::size_t capacity = 1;
+  while (capacity < events_per_thread) {
+    capacity <<= 1U;
+  }
+  t.events_per_thread = capacity;
+  t.filename          = filename;
+  t.time_start        = std::chrono::steady_clock::now();
+  t.ticks_start       = detail::hot_trace_now();
+  detail::hot_trace_enabled.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+/// Creates the buffer of the calling thread.
+static hot_thread_buffer* register_hot_thread()
+{
+  hot_tracer_state&           t = hot_tracer();
+  std::lock_guard<std::mutex> lock(t.mutex);
+  if (t.events_per_thread == 0) {
+    return nullptr;
+  }
+
+  std::unique_ptr<hot_thread_buffer> b(new hot_thread_buffer);
+  b->events.resize(t.events_per_thread);
+  b->tid = ::syscall(SYS_gettid);
+  ::pthread_getname_np(::pthread_self(), b->thread_name, sizeof(b->thread_name));
+  t.buffers.push_back(std::move(b));
+  return t.buffers.back().get();
+}
+
+void srslog::detail::hot_trace_record(const char* category,
+                                      const char* name,
+                                      uint64_t    start,
+                                      uint64_t    end,
+                                      int64_t     arg)
+{
+  hot_thread_buffer* b = thread_hot_buffer;
+  if (!b) {
+    b = thread_hot_buffer = register_hot_thread();
+    if (!b) {
+      return;
+    }
+  }
+
+  uint64_t n                            = b->count.load(std::memory_order_relaxed);
+  b->events[n & (b->events.size() - 1)] = {category, name, start, end, arg};
+  b->count.store(n + 1, std::memory_order_release);
+}
+
+/// Writes str as a JSON string.
+static void write_json_string(std::FILE* f, const char* str)
+{
+  std::fputc('"', f);
+  for (; *str; ++str) {
+    if (*str == '"' || *str == '\\') {
+      std::fputc('\\', f);
+    }
+    std::fputc(*str, f);
+  }
+  std::fputc('"', f);
+}
+
+bool srslog::event_trace_hot_export()
+{
+  hot_tracer_state&           t = hot_tracer();
+  std::lock_guard<std::mutex> lock(t.mutex);
+  if (t.events_per_thread == 0) {
+    return false;
+  }
+  detail::hot_trace_enabled.store(false, std::memory_order_relaxed);
+
+  // Measure the tick rate over the whole tracing session, making it long enough for a precise value.
+  static constexpr std::chrono::milliseconds min_calibration_time(10);
+  auto elapsed = std::chrono::steady_clock::now() - t.time_start;
+  if (elapsed < min_calibration_time) {
+    std::this_thread::sleep_for(min_calibration_time - elapsed);
+  }
+  uint64_t ticks_end    = detail::hot_trace_now();
+  auto     time_end     = std::chrono::steady_clock::now();
+  double   elapsed_us   = std::chrono::duration<double, std::micro>(time_end - t.time_start).count();
+  double   ticks_per_us = (ticks_end - t.ticks_start) / elapsed_us;
+
+  std::FILE* f = std::fopen(t.filename.c_str(), "w");
+  if (!f) {
+    return false;
+  }
+
+  pid_t pid = ::getpid();
+  std::fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  std::fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"srsRAN\"}}", pid);
+  for (const auto& b : t.buffers) {
+    std::fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%ld,\"args\":{\"name\":", pid, b->tid);
+    write_json_string(f, b->thread_name);
+    std::fprintf(f, "}}");
+
+    uint64_t count = b->count.load(std::memory_order_acquire);
+    uint64_t first = count - std::min<uint64_t>(count, b->events.size());
+    for (uint64_t i = first; i != count; ++i) {
+      const hot_event& e = b->events[i & (b->events.size() - 1)];
+      if (e.start < t.ticks_start) {
+        continue;
+      }
+      std::fprintf(f, ",\n{\"name\":");
+      write_json_string(f, e.name);
+      std::fprintf(f, ",\"cat\":");
+      write_json_string(f, e.category);
+      std::fprintf(f,
+                   ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%ld",
+                   (e.start - t.ticks_start) / ticks_per_us,
+                   (e.end - e.start) / ticks_per_us,
+                   pid,
+                   b->tid);
+      if (e.arg != detail::hot_trace_no_arg) {
+        std::fprintf(f, ",\"args\":{\"arg\":%lld}", (long long)e.arg);
+      }
+      std::fprintf(f, "}");
+    }
+  }
+  std::fprintf(f, "\n]}\n");
+
+  return std::fclose(f) == 0;
+}
@@ -0,0 +1,495 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "binary_formatter.h"
+#include "srsran/srslog/detail/log_entry_metadata.h"
+#include <cstring>
+
+using namespace srslog;
+
+/// Appends the raw bytes of a value to the buffer.
+template <typename T>
+static void put(fmt::memory_buffer& buffer, const T& v)
+{
+  const char* p = reinterpret_cast<const char*>(&v);
+  buffer.append(p, p + sizeof(T));
+}
+
+/// Appends a length prefixed string to the buffer.
+static void put_string(fmt::memory_buffer& buffer, fmt::string_view str)
+{
+  put(buffer, static_cast<uint32_t>(str.size()));
+  buffer.append(str.data(), str.data() + str.size());
+}
+
+namespace {
+
+/// Writes the type tag and raw value of each visited argument.
+class arg_encoder
+{
+public:
+  arg_encoder(const fmt::basic_format_arg<fmt::printf_context>& arg, fmt::memory_buffer& buffer) :
+    arg(arg), buffer(buffer)
+  {}
+
+  void operator()(int v) { put_int(v); }
+  void operator()(long long v) { put_int(v); }
+  void operator()(unsigned v) { put_uint(v); }
+  void operator()(unsigned long long v) { put_uint(v); }
+  void operator()(bool v)
+  {
+    put(buffer, binary_log::arg_type::bool_t);
+    put(buffer, static_cast<uint8_t>(v));
+  }
+  void operator()(char v)
+  {
+    put(buffer, binary_log::arg_type::char_t);
+    put(buffer, v);
+  }
+  void operator()(float v)
+  {
+    put(buffer, binary_log::arg_type::float_t);
+    put(buffer, v);
+  }
+  void operator()(double v)
+  {
+    put(buffer, binary_log::arg_type::double_t);
+    put(buffer, v);
+  }
+  void operator()(long double v)
+  {
+    put(buffer, binary_log::arg_type::long_double);
+    put(buffer, v);
+  }
+  void operator()(const char* v)
+  {
+    put(buffer, binary_log::arg_type::string);
+    put_string(buffer, v ? fmt::string_view(v) : fmt::string_view("(null)"));
+  }
+  void operator()(fmt::string_view v)
+  {
+    put(buffer, binary_log::arg_type::string);
+    put_string(buffer, v);
+  }
+  void operator()(const void* v)
+  {
+    put(buffer, binary_log::arg_type::pointer);
+    put(buffer, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(v)));
+  }
+  void operator()(fmt::basic_format_arg<fmt::printf_context>::handle)
+  {
+    // User types have no raw representation, render them now.
+    fmt::basic_format_args<fmt::printf_context> args(&arg, 1);
+    std::string                                 str;
+    try {
+      str = fmt::vsprintf(fmt::string_view("%s"), args);
+    } catch (...) {
+      str = "(invalid argument)";
+    }
+    put(buffer, binary_log::arg_type::string);
+    put_string(buffer, str);
+  }
+  /// Remaining types (monostate, 128 bit integers).
+  template <typename T>
+  void operator()(const T&)
+  {
+    put(buffer, binary_log::arg_type::none);
+  }
+
+private:
+  void put_int(int64_t v)
+  {
+    put(buffer, binary_log::arg_type::int_t);
+    put(buffer, v);
+  }
+  void put_uint(uint64_t v)
+  {
+    put(buffer, binary_log::arg_type::uint_t);
+    put(buffer, v);
+  }
+
+private:
+  const fmt::basic_format_arg<fmt::printf_context>& arg;
+  fmt::memory_buffer&                               buffer;
+};
+
+} // namespace
+
+std::unique_ptr<log_formatter> binary_formatter::clone() const
+{
+  // Each copy writes into its own stream, so it starts without definitions.
+  return std::unique_ptr<log_formatter>(new binary_formatter);
+}
+
+uint32_t binary_formatter::get_fmt_id(const char* fmtstring, fmt::memory_buffer& buffer)
+{
+  uint32_t id;
+  auto     it = fmt_ids.find(fmtstring);
+  if (it == fmt_ids.end()) {
+    id = fmt_defs.size();
+    fmt_defs.emplace_back(fmtstring);
+    fmt_ids.emplace(fmtstring, id);
+  } else {
+    id = it->second;
+    if (fmt_defs[id] == fmtstring) {
+      return id;
+    }
+    // The address now holds a different string (not a literal), the decoder applies definitions in order so the id
+    // can be redefined.
+    fmt_defs[id] = fmtstring;
+  }
+
+  put(buffer, binary_log::record::fmt_def);
+  put(buffer, id);
+  put_string(buffer, fmt_defs[id]);
+  return id;
+}
+
+uint32_t binary_formatter::get_name_id(const std::string& name, fmt::memory_buffer& buffer)
+{
+  auto it = name_ids.find(name);
+  if (it != name_ids.end()) {
+    return it->second;
+  }
+
+  uint32_t id = name_ids.size();
+  name_ids.emplace(name, id);
+
+  put(buffer, binary_log::record::name_def);
+  put(buffer, id);
+  put_string(buffer, name);
+  return id;
+}
+
+void binary_formatter::write_header(fmt::memory_buffer& buffer)
+{
+  if (header_written) {
+    return;
+  }
+  buffer.append(binary_log::magic, binary_log::magic + sizeof(binary_log::magic) - 1);
+  put(buffer, binary_log::check_word);
+  header_written = true;
+}
+
+void binary_formatter::format(detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer)
+{
+  write_header(buffer);
+
+  // Definitions go before the entry that uses them.
+  uint32_t name_id = get_name_id(metadata.log_name, buffer);
+  uint32_t fmt_id  = metadata.fmtstring ? get_fmt_id(metadata.fmtstring, buffer) : binary_log::no_fmt;
+
+  put(buffer, binary_log::record::entry);
+  put(buffer,
+      static_cast<int64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(metadata.tp.time_since_epoch()).count()));
+  put(buffer, name_id);
+  put(buffer, metadata.log_tag);
+  put(buffer, static_cast<uint8_t>(metadata.context.enabled));
+  put(buffer, metadata.context.value);
+  put(buffer, fmt_id);
+
+  if (metadata.fmtstring && metadata.store) {
+    fmt::basic_format_args<fmt::printf_context> args(*metadata.store);
+    unsigned                                    nof_args = std::min(args.max_size(), int(UINT8_MAX));
+    put(buffer, static_cast<uint8_t>(nof_args));
+    for (unsigned i = 0; i != nof_args; ++i) {
+      auto arg = args.get(i);
+      fmt::visit_format_arg(arg_encoder(arg, buffer), arg);
+    }
+  } else {
+    put(buffer, uint8_t(0));
+  }
+
+  put(buffer, static_cast<uint32_t>(metadata.hex_dump.size()));
+  buffer.append(metadata.hex_dump.data(), metadata.hex_dump.data() + metadata.hex_dump.size());
+}
+
+void binary_formatter::format_context_begin(const detail::log_entry_metadata& md,
+                                            fmt::string_view                  ctx_name,
+                                            unsigned                          size,
+                                            fmt::memory_buffer&               buffer)
+{
+  ctx_text.clear();
+  text.format_context_begin(md, ctx_name, size, ctx_text);
+}
+
+void binary_formatter::format_context_end(const detail::log_entry_metadata& md,
+                                          fmt::string_view                  ctx_name,
+                                          fmt::memory_buffer&               buffer)
+{
+  text.format_context_end(md, ctx_name, ctx_text);
+
+  write_header(buffer);
+  put(buffer, binary_log::record::text);
+  put_string(buffer, fmt::string_view(ctx_text.data(), ctx_text.size()));
+}
+
+namespace {
+
+/// Reads values from a byte range, failing once the range is exhausted.
+class byte_reader
+{
+public:
+  byte_reader(const uint8_t*& p, const uint8_t* end) : p(p), end(end) {}
+
+  template <typename T>
+  bool get(T& v)
+  {
+    if (size_t(end - p) < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&v, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+  }
+
+  bool get_bytes(const uint8_t*& data, size_t len)
+  {
+    if (size_t(end - p) < len) {
+      return false;
+    }
+    data = p;
+    p += len;
+    return true;
+  }
+
+  bool get_string(std::string& str)
+  {
+    uint32_t       len;
+    const uint8_t* data;
+    if (!get(len) || !get_bytes(data, len)) {
+      return false;
+    }
+    str.assign(reinterpret_cast<const char*>(data), len);
+    return true;
+  }
+
+private:
+  const uint8_t*& p;
+  const uint8_t*  end;
+};
+
+} // namespace
+
+bool binary_log_decoder::decode_args(const uint8_t*& p, const uint8_t* end, unsigned nof_args)
+{
+  byte_reader rd(p, end);
+  for (unsigned i = 0; i != nof_args; ++i) {
+    binary_log::arg_type type;
+    if (!rd.get(type)) {
+      return false;
+    }
+    switch (type) {
+      case binary_log::arg_type::none:
+        store.push_back(fmt::string_view());
+        break;
+      case binary_log::arg_type::int_t: {
+        int64_t v;
+        if (!rd.get(v)) {
+          return false;
+        }
+        store.push_back(static_cast<long long>(v));
+        break;
+      }
+      case binary_log::arg_type::uint_t: {
+        uint64_t v;
+        if (!rd.get(v)) {
+          return false;
+        }
+        store.push_back(static_cast<unsigned long long>(v));
+        break;
+      }
+      case binary_log::arg_type::bool_t: {
+        uint8_t v;
+        if (!rd.get(v)) {
+          return false;
+        }
+        store.push_back(v != 0);
+        break;
+      }
+      case binary_log::arg_type::char_t: {
+        char v;
+        if (!rd.get(v)) {
+          return false;
+        }
+        store.push_back(v);
+        break;
+      }
+      case binary_log::arg_type::float_t: {
+        float v;
+        if (!rd.get(v)) {
+          return false;
+        }
+        store.push_back(v);
+        break;
+      }
+      case binary_log::arg_type::double_t: {
+        double v;
+        if (!rd.get(v)) {
+          return false;
+        }
+        store.push_back(v);
+        break;
+      }
+      case binary_log::arg_type::long_double: {
+        long double v;
+        if (!rd.get(v)) {
+          return false;
+        }
+        store.push_back(v);
+        break;
+      }
+      case binary_log::arg_type::string: {
+        std::string v;
+        if (!rd.get_string(v)) {
+          return false;
+        }
+        store.push_back(std::move(v));
+        break;
+      }
+      case binary_log::arg_type::pointer: {
+        uint64_t v;
+        if (!rd.get(v)) {
+          return false;
+        }
+        store.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(v)));
+        break;
+      }
+      default:
+        error = fmt::format("unknown argument type 0x{:02x}", static_cast<unsigned>(type));
+        return false;
+    }
+  }
+  return true;
+}
+
+bool binary_log_decoder::decode_entry(const uint8_t*& p, const uint8_t* end, fmt::memory_buffer& out)
+{
+  byte_reader rd(p, end);
+  int64_t     ns;
+  uint32_t    name_id, ctx_value, fmt_id, hex_len;
+  char        tag;
+  uint8_t     ctx_enabled, nof_args;
+  if (!rd.get(ns) || !rd.get(name_id) || !rd.get(tag) || !rd.get(ctx_enabled) || !rd.get(ctx_value) ||
+      !rd.get(fmt_id) || !rd.get(nof_args)) {
+    return false;
+  }
+
+  auto name_it = name_defs.find(name_id);
+  if (name_it == name_defs.end()) {
+    error = fmt::format("undefined channel name id {}", name_id);
+    return false;
+  }
+  const char* fmtstring = nullptr;
+  if (fmt_id != binary_log::no_fmt) {
+    auto fmt_it = fmt_defs.find(fmt_id);
+    if (fmt_it == fmt_defs.end()) {
+      error = fmt::format("undefined format string id {}", fmt_id);
+      return false;
+    }
+    fmtstring = fmt_it->second.c_str();
+  }
+
+  store.clear();
+  const uint8_t* hex_data;
+  if (!decode_args(p, end, nof_args) || !rd.get(hex_len) || !rd.get_bytes(hex_data, hex_len)) {
+    return false;
+  }
+
+  std::chrono::high_resolution_clock::time_point tp(
+      std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::nanoseconds(ns)));
+  text.format({tp,
+               {ctx_value, ctx_enabled != 0},
+               fmtstring,
+               fmtstring ? &store : nullptr,
+               name_it->second,
+               tag,
+               std::vector<uint8_t>(hex_data, hex_data + hex_len)},
+              out);
+  return true;
+}
+
+size_t binary_log_decoder::decode(const uint8_t* data, size_t len, fmt::memory_buffer& out)
+{
+  const size_t   magic_len = sizeof(binary_log::magic) - 1;
+  const uint8_t* p         = data;
+  const uint8_t* end       = data + len;
+  error.clear();
+
+  if (len >= magic_len && std::memcmp(data, binary_log::magic, magic_len) == 0) {
+    p += magic_len;
+    uint32_t check;
+    if (!byte_reader(p, end).get(check)) {
+      error = "truncated header";
+      return 0;
+    }
+    if (check != binary_log::check_word) {
+      error = "log written with a different byte order";
+      return 0;
+    }
+  }
+
+  while (p != end) {
+    // Records are consumed as a whole, so that on failure the returned length points to the start of the record.
+    const uint8_t*     record_start = p;
+    byte_reader        rd(p, end);
+    binary_log::record type;
+    rd.get(type);
+
+    bool ok = false;
+    switch (type) {
+      case binary_log::record::fmt_def:
+      case binary_log::record::name_def: {
+        uint32_t    id;
+        std::string str;
+        ok = rd.get(id) && rd.get_string(str);
+        if (ok) {
+          (type == binary_log::record::fmt_def ? fmt_defs : name_defs)[id] = std::move(str);
+        }
+        break;
+      }
+      case binary_log::record::entry:
+        ok = decode_entry(p, end, out);
+        break;
+      case binary_log::record::text: {
+        std::string str;
+        ok = rd.get_string(str);
+        if (ok) {
+          out.append(str.data(), str.data() + str.size());
+        }
+        break;
+      }
+      default:
+        error = fmt::format("unknown record type 0x{:02x}", static_cast<unsigned>(type));
+        break;
+    }
+
+    if (!ok) {
+      if (error.empty()) {
+        error = "truncated record";
+      }
+      return record_start - data;
+    }
+  }
+
+  return len;
+}
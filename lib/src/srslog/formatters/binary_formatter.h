@@ -0,0 +1,174 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLOG_BINARY_FORMATTER_H
+#define SRSLOG_BINARY_FORMATTER_H
+
+#include "text_formatter.h"
+#include "srsran/srslog/bundled/fmt/printf.h"
+#include <unordered_map>
+
+namespace srslog {
+
+/// Layout of the binary log stream. The stream starts with a header followed by a sequence of records, each one starting
+/// with a one byte tag. Values are stored in the byte order of the host that wrote them, the header carries a check word
+/// so that the decoder can reject streams written with a different byte order.
+namespace binary_log {
+
+/// Stream header: magic string followed by the 32 bit check word.
+constexpr char     magic[]    = "SRSLOGB1";
+constexpr uint32_t check_word = 0x01020304;
+
+/// Record tags.
+enum class record : uint8_t {
+  fmt_def  = 'F', ///< Format string definition: u32 id, u32 length, chars.
+  name_def = 'N', ///< Channel name definition: u32 id, u32 length, chars.
+  entry    = 'E', ///< Log entry: i64 ns since epoch, u32 name id, char tag, u8 ctx enabled, u32 ctx value,
+                  ///< u32 format id, u8 number of args, args, u32 hex dump length, hex dump bytes.
+  text     = 'T'  ///< Entry rendered as text by the writer, used for contexts: u32 length, chars.
+};
+
+/// Argument type tags, each one followed by its raw value.
+enum class arg_type : uint8_t {
+  none        = 'n', ///< No payload.
+  int_t       = 'i', ///< i64.
+  uint_t      = 'u', ///< u64.
+  bool_t      = 'b', ///< u8.
+  char_t      = 'c', ///< char.
+  float_t     = 'f', ///< float.
+  double_t    = 'd', ///< double.
+  long_double = 'D', ///< long double.
+  string      = 's', ///< u32 length, chars.
+  pointer     = 'p'  ///< u64.
+};
+
+/// Format id used by entries without a format string.
+constexpr uint32_t no_fmt = UINT32_MAX;
+
+} // namespace binary_log
+
+/// Binary formatter implementation class.
+/// Instead of rendering the message, this formatter stores an id of the format string together with the raw value of
+/// each argument, so the cost in the backend thread is a copy of the arguments rather than a printf call. Format
+/// strings and channel names are written once, the first time they are seen, as definition records. Arguments of user
+/// types, which cannot be stored raw, are rendered to a string. Contexts are rare and are stored as text. The output is
+/// turned into the plain text layout offline with binary_log_decoder (see the srslog_decode tool).
+/// NOTE: the definitions are only written once per formatter, so the files of a rotated log have to be decoded together
+/// in order.
+class binary_formatter : public log_formatter
+{
+public:
+  std::unique_ptr<log_formatter> clone() const override;
+
+  void format(detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer) override;
+
+private:
+  /// Writes the stream header before the first record.
+  void write_header(fmt::memory_buffer& buffer);
+
+  /// Returns the id of the format string, writing its definition into the buffer when it is new.
+  uint32_t get_fmt_id(const char* fmtstring, fmt::memory_buffer& buffer);
+
+  /// Returns the id of the channel name, writing its definition into the buffer when it is new.
+  uint32_t get_name_id(const std::string& name, fmt::memory_buffer& buffer);
+
+  void format_context_begin(const detail::log_entry_metadata& md,
+                            fmt::string_view                  ctx_name,
+                            unsigned                          size,
+                            fmt::memory_buffer&               buffer) override;
+
+  void format_context_end(const detail::log_entry_metadata& md,
+                          fmt::string_view                  ctx_name,
+                          fmt::memory_buffer&               buffer) override;
+
+  void format_metric_set_begin(fmt::string_view    set_name,
+                               unsigned            size,
+                               unsigned            level,
+                               fmt::memory_buffer& buffer) override
+  {
+    text.format_metric_set_begin(set_name, size, level, ctx_text);
+  }
+
+  void format_metric_set_end(fmt::string_view set_name, unsigned level, fmt::memory_buffer& buffer) override
+  {
+    text.format_metric_set_end(set_name, level, ctx_text);
+  }
+
+  void format_list_begin(fmt::string_view list_name, unsigned size, unsigned level, fmt::memory_buffer& buffer) override
+  {
+    text.format_list_begin(list_name, size, level, ctx_text);
+  }
+
+  void format_list_end(fmt::string_view list_name, unsigned level, fmt::memory_buffer& buffer) override
+  {
+    text.format_list_end(list_name, level, ctx_text);
+  }
+
+  void format_metric(fmt::string_view    metric_name,
+                     fmt::string_view    metric_value,
+                     fmt::string_view    metric_units,
+                     metric_kind         kind,
+                     unsigned            level,
+                     fmt::memory_buffer& buffer) override
+  {
+    text.format_metric(metric_name, metric_value, metric_units, kind, level, ctx_text);
+  }
+
+private:
+  bool header_written = false;
+  /// Format string ids indexed by the string address, the text is kept to detect addresses that get reused by a
+  /// different string (e.g. the buffer of a std::string).
+  std::unordered_map<const char*, uint32_t> fmt_ids;
+  std::vector<std::string>                  fmt_defs;
+  std::unordered_map<std::string, uint32_t> name_ids;
+  /// Contexts are rendered by a text formatter into this buffer.
+  text_formatter     text;
+  fmt::memory_buffer ctx_text;
+};
+
+/// Renders a binary log stream into the plain text layout of text_formatter. The definitions seen are kept between calls
+/// so that consecutive files of a rotated log can be decoded with the same object.
+class binary_log_decoder
+{
+public:
+  /// Decodes the records in the input bytes, appending the text to the output buffer. A stream header is accepted at the
+  /// start of the input. Returns the number of bytes consumed, which is less than len when the input ends in a partial
+  /// or invalid record. Check get_error() in that case.
+  size_t decode(const uint8_t* data, size_t len, fmt::memory_buffer& out);
+
+  /// Returns a description of the last decoding error, empty if there was none.
+  const std::string& get_error() const { return error; }
+
+private:
+  bool decode_entry(const uint8_t*& p, const uint8_t* end, fmt::memory_buffer& out);
+  bool decode_args(const uint8_t*& p, const uint8_t* end, unsigned nof_args);
+
+private:
+  std::unordered_map<uint32_t, std::string>         fmt_defs;
+  std::unordered_map<uint32_t, std::string>         name_defs;
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+  text_formatter                                    text;
+  std::string                                       error;
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_BINARY_FORMATTER_H
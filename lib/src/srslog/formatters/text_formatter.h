@@ -29,6 +29,9 @@ namespace srslog {
 /// Plain text formatter implementation class.
 class text_formatter : public log_formatter
 {
+  /// Renders contexts through the callbacks of this class.
+  friend class binary_formatter;
+
 public:
   text_formatter() { scope_stack.reserve(16); }
 
@@ -24,46 +24,193 @@
 
 #include "backend_worker.h"
 #include "srsran/srslog/detail/log_backend.h"
+#include "srsran/srslog/sink.h"
+#include <array>
+#include <cstdlib>
+#include <new>
 
 namespace srslog {
 
-/// This class implements the log backend interface. It internally manages a
-/// worker thread to process incoming log entries.
+/// This class implements the log backend interface. It internally manages one
+/// or more worker threads to process incoming log entries. Each worker has its
+/// own queue and writes into its own subset of the sinks, which are given to
+/// the workers in turns when they receive their first entry.
 /// NOTE: Thread safe class.
 class log_backend_impl : public detail::log_backend
 {
+  /// Queue and thread of a backend worker.
+  struct worker_shard {
+    worker_shard(detail::dyn_arg_store_pool& arg_pool, unsigned index) : worker(queue, arg_pool, index) {}
+
+    /// The queue positions are cache line aligned, which the C++14 operator new does not honour.
+    static void* operator new(size_t sz)
+    {
+      void* p = nullptr;
+      if (::posix_memalign(&p, alignof(worker_shard), sz) != 0) {
+        throw std::bad_alloc();
+      }
+      return p;
+    }
+    static void operator delete(void* p) { ::free(p); }
+
+    detail::work_queue<detail::log_entry> queue;
+    backend_worker                        worker;
+  };
+
 public:
-  log_backend_impl() = default;
+  log_backend_impl() { shards[0].reset(new worker_shard(arg_pool, 0)); }
 
   log_backend_impl(const log_backend_impl& other) = delete;
   log_backend_impl& operator=(const log_backend_impl& other) = delete;
 
-  void start(backend_priority priority = backend_priority::normal) override { worker.start(priority); }
+  ~log_backend_impl() override { stop(); }
+
+  void start(backend_priority priority = backend_priority::normal) override
+  {
+    for (unsigned i = 0, e = get_nof_workers(); i != e; ++i) {
+      shards[i]->worker.start(priority);
+    }
+  }
 
   bool push(detail::log_entry&& entry) override
   {
+    if (entry.flush_cmd) {
+      return push_flush_cmd(std::move(entry));
+    }
+
     auto* arg_store = entry.metadata.store;
-    if (!queue.push(std::move(entry))) {
+    if (!shards[get_worker_index(*entry.s)]->queue.push(std::move(entry))) {
       arg_pool.dealloc(arg_store);
+      nof_queue_full_drops.fetch_add(1, std::memory_order_relaxed);
       return false;
     }
     return true;
   }
 
-  fmt::dynamic_format_arg_store<fmt::printf_context>* alloc_arg_store() override { return arg_pool.alloc(); }
+  fmt::dynamic_format_arg_store<fmt::printf_context>* alloc_arg_store() override
+  {
+    auto* store = arg_pool.alloc();
+    if (!store) {
+      nof_no_arg_store_drops.fetch_add(1, std::memory_order_relaxed);
+    }
+    return store;
+  }
+
+  bool is_running() const override { return shards[0]->worker.is_running(); }
+
+  /// Installs the specified error handler into the backend workers.
+  void set_error_handler(error_handler err_handler)
+  {
+    for (unsigned i = 0, e = get_nof_workers(); i != e; ++i) {
+      shards[i]->worker.set_error_handler(err_handler);
+    }
+    user_err_handler     = std::move(err_handler);
+    has_user_err_handler = true;
+  }
+
+  /// Sets the number of worker threads, up to SRSLOG_MAX_BACKEND_WORKERS. The
+  /// number of workers can only grow, and calls to this method when the
+  /// backend is running will get ignored.
+  /// NOTE: Not thread safe, it should be called before generating log entries.
+  void set_nof_workers(unsigned nof_workers)
+  {
+    if (is_running()) {
+      return;
+    }
+
+    nof_workers = std::min<unsigned>(nof_workers, SRSLOG_MAX_BACKEND_WORKERS);
+    for (unsigned i = get_nof_workers(); i < nof_workers; ++i) {
+      shards[i].reset(new worker_shard(arg_pool, i));
+      if (has_user_err_handler) {
+        shards[i]->worker.set_error_handler(user_err_handler);
+      }
+      nof_shards.store(i + 1, std::memory_order_release);
+    }
+  }
+
+  /// Returns the number of worker threads.
+  unsigned get_nof_workers() const { return nof_shards.load(std::memory_order_acquire); }
+
+  /// Returns the counters of the log entries discarded so far.
+  backend_drop_stats get_drop_stats() const
+  {
+    backend_drop_stats stats;
+    stats.queue_full   = nof_queue_full_drops.load(std::memory_order_relaxed);
+    stats.no_arg_store = nof_no_arg_store_drops.load(std::memory_order_relaxed);
+    return stats;
+  }
 
-  bool is_running() const override { return worker.is_running(); }
+  /// Stops the backend worker threads.
+  void stop()
+  {
+    for (unsigned i = 0, e = get_nof_workers(); i != e; ++i) {
+      shards[i]->worker.stop();
+    }
+  }
 
-  /// Installs the specified error handler into the backend worker.
-  void set_error_handler(error_handler err_handler) { worker.set_error_handler(std::move(err_handler)); }
+private:
+  /// Returns the index of the worker that writes into the input sink, assigning one when the sink has none yet.
+  unsigned get_worker_index(sink& s)
+  {
+    std::atomic<int>& worker_index = s.backend_worker_index();
+    int               index        = worker_index.load(std::memory_order_relaxed);
+    if (index < 0) {
+      int expected = -1;
+      index        = next_worker_index.fetch_add(1, std::memory_order_relaxed) % get_nof_workers();
+      if (!worker_index.compare_exchange_strong(expected, index, std::memory_order_relaxed)) {
+        // Another thread assigned the sink first.
+        index = expected;
+      }
+    }
+    return index;
+  }
 
-  /// Stops the backend worker thread.
-  void stop() { worker.stop(); }
+  /// Hands the flush of each sink to the worker that writes into it, and
+  /// notifies the caller once all the workers are done.
+  bool push_flush_cmd(detail::log_entry&& entry)
+  {
+    unsigned                        nof_workers = get_nof_workers();
+    std::vector<std::vector<sink*>> worker_sinks(nof_workers);
+    for (sink* s : entry.flush_cmd->sinks) {
+      worker_sinks[get_worker_index(*s)].push_back(s);
+    }
+
+    std::vector<std::unique_ptr<detail::shared_variable<bool> > > completion_flags;
+    for (unsigned i = 0; i != nof_workers; ++i) {
+      if (worker_sinks[i].empty() || !shards[i]->worker.is_running()) {
+        continue;
+      }
+      completion_flags.emplace_back(new detail::shared_variable<bool>(false));
+
+      detail::log_entry cmd;
+      cmd.metadata.store = nullptr;
+      cmd.flush_cmd      = std::unique_ptr<detail::flush_backend_cmd>(
+          new detail::flush_backend_cmd{*completion_flags.back(), std::move(worker_sinks[i])});
+
+      // Make sure the flush command gets into the queue, otherwise we will be stuck waiting forever.
+      while (!shards[i]->queue.push(std::move(cmd))) {
+      }
+    }
+
+    for (const auto& flag : completion_flags) {
+      while (!*flag) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      }
+    }
+    entry.flush_cmd->completion_flag = true;
+
+    return true;
+  }
 
 private:
-  detail::work_queue<detail::log_entry> queue;
-  detail::dyn_arg_store_pool            arg_pool;
-  backend_worker                        worker{queue, arg_pool};
+  detail::dyn_arg_store_pool                                           arg_pool;
+  std::array<std::unique_ptr<worker_shard>, SRSLOG_MAX_BACKEND_WORKERS> shards;
+  std::atomic<unsigned>                                                nof_shards{1};
+  std::atomic<unsigned>                                                next_worker_index{0};
+  std::atomic<uint64_t>                                                nof_queue_full_drops{0};
+  std::atomic<uint64_t>                                                nof_no_arg_store_drops{0};
+  error_handler                                                        user_err_handler;
+  bool                                                                 has_user_err_handler = false;
 };
 
 } // namespace srslog
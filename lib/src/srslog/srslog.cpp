@@ -20,6 +20,7 @@
  */
 
 #include "srsran/srslog/srslog.h"
+#include "formatters/binary_formatter.h"
 #include "formatters/json_formatter.h"
 #include "sinks/file_sink.h"
 #include "sinks/syslog_sink.h"
@@ -105,6 +106,11 @@ std::unique_ptr<log_formatter> srslog::create_json_formatter()
   return std::unique_ptr<log_formatter>(new json_formatter);
 }
 
+std::unique_ptr<log_formatter> srslog::create_binary_formatter()
+{
+  return std::unique_ptr<log_formatter>(new binary_formatter);
+}
+
 ///
 /// Sink management function implementations.
 ///
@@ -258,6 +264,16 @@ void srslog::set_error_handler(error_handler handler)
   srslog_instance::get().set_error_handler(std::move(handler));
 }
 
+void srslog::set_backend_workers(unsigned nof_workers)
+{
+  srslog_instance::get().set_backend_workers(nof_workers);
+}
+
+backend_drop_stats srslog::get_backend_drop_stats()
+{
+  return srslog_instance::get().get_backend_drop_stats();
+}
+
 ///
 /// Logger management function implementations.
 ///
@@ -88,6 +88,12 @@ public:
   /// Installs the specified error handler into the backend.
   void set_error_handler(error_handler callback) { backend.set_error_handler(std::move(callback)); }
 
+  /// Sets the number of backend worker threads.
+  void set_backend_workers(unsigned nof_workers) { backend.set_nof_workers(nof_workers); }
+
+  /// Returns the counters of log entries discarded by the backend.
+  backend_drop_stats get_backend_drop_stats() const { return backend.get_drop_stats(); }
+
   /// Set the specified sink as the default one.
   void set_default_sink(sink& s) { default_sink = &s; }
 
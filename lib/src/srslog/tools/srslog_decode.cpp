@@ -0,0 +1,60 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/// Renders the binary logs written by the srslog binary formatter into the plain text layout.
+/// Usage: srslog_decode <file> [<file> ...]
+/// Files of a rotated log have to be passed in the order they were written.
+
+#include "../formatters/binary_formatter.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+using namespace srslog;
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    fmt::print(stderr, "Usage: {} <file> [<file> ...]\n", argv[0]);
+    return 1;
+  }
+
+  binary_log_decoder decoder;
+  fmt::memory_buffer out;
+  for (int i = 1; i != argc; ++i) {
+    std::ifstream file(argv[i], std::ios::binary);
+    if (!file) {
+      fmt::print(stderr, "Unable to open file \"{}\"\n", argv[i]);
+      return 1;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    out.clear();
+    size_t nof_bytes = decoder.decode(data.data(), data.size(), out);
+    std::fwrite(out.data(), 1, out.size(), stdout);
+    if (nof_bytes != data.size()) {
+      fmt::print(stderr, "{}: {} at offset {}\n", argv[i], decoder.get_error(), nof_bytes);
+      return 1;
+    }
+  }
+
+  return 0;
+}
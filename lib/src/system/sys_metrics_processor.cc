@@ -20,8 +20,12 @@
  */
 
 #include "srsran/system/sys_metrics_processor.h"
+#include <dirent.h>
 #include <fstream>
+#include <linux/perf_event.h>
 #include <sstream>
+#include <string.h>
+#include <sys/syscall.h>
 #include <sys/sysinfo.h>
 #include <unistd.h>
 
@@ -35,6 +39,31 @@ sys_metrics_processor::sys_metrics_processor(srslog::basic_logger& logger) : log
   if (cpu_count > metrics_max_supported_cpu) {
     logger.warning("Number of cpu is greater than supported. CPU metrics will be disabled.");
   }
+
+  // Count the NUMA nodes, the memory per node is only reported when there are several of them
+  DIR* dir = opendir("/sys/devices/system/node");
+  if (dir != nullptr) {
+    struct dirent* entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+      if (std::string(entry->d_name).compare(0, 4, "node") == 0 && isdigit(entry->d_name[4])) {
+        numa_node_count++;
+      }
+    }
+    closedir(dir);
+  }
+  if (numa_node_count > metrics_max_supported_numa_nodes) {
+    logger.warning("Number of NUMA nodes is greater than supported. NUMA metrics will be disabled.");
+    numa_node_count = 0;
+  } else if (numa_node_count < 2) {
+    numa_node_count = 0;
+  }
+}
+
+sys_metrics_processor::~sys_metrics_processor()
+{
+  for (auto& t : thread_counters) {
+    close_thread_counters(t.second);
+  }
 }
 
 sys_metrics_processor::proc_stats_info::proc_stats_info()
@@ -88,6 +117,7 @@ sys_metrics_t sys_metrics_processor::get_metrics()
 
   // Get the memory metrics.
   calculate_mem_usage(metrics);
+  calculate_numa_mem_usage(metrics);
 
   // Calculate cpu metrics.
   calculate_cpu_metrics(metrics, measure_interval_ms / 1000.f);
@@ -97,6 +127,10 @@ sys_metrics_t sys_metrics_processor::get_metrics()
   metrics.thread_count      = current_query.num_threads;
   metrics.process_cpu_usage = calculate_cpu_usage(current_query, measure_interval_ms / 1000.f);
 
+  if (thread_counters_enabled) {
+    calculate_thread_metrics(metrics);
+  }
+
   // Update the last values.
   last_query_time = current_time;
   last_query      = std::move(current_query);
@@ -269,3 +303,191 @@ void sys_metrics_processor::calculate_mem_usage(sys_metrics_t& metrics) const
   // Now calculate the memory usage in percentage.
   calculate_percentage_memory(metrics);
 }
+
+void sys_metrics_processor::calculate_numa_mem_usage(sys_metrics_t& metrics) const
+{
+  if (numa_node_count == 0) {
+    return;
+  }
+
+  std::ifstream file("/proc/self/numa_maps");
+  if (!file) {
+    return;
+  }
+
+  // Each mapping lists its resident pages per node as N<node>=<pages>, and its page size
+  std::array<uint64_t, metrics_max_supported_numa_nodes> node_kB = {};
+  std::string                                            line;
+  while (std::getline(file, line)) {
+    std::istringstream                                     reader(line);
+    std::string                                            token;
+    uint64_t                                               page_kB = 4;
+    std::array<uint64_t, metrics_max_supported_numa_nodes> pages   = {};
+    while (reader >> token) {
+      size_t eq = token.find('=');
+      if (eq == std::string::npos) {
+        continue;
+      }
+      if (token.compare(0, eq, "kernelpagesize_kB") == 0) {
+        page_kB = std::strtoull(token.c_str() + eq + 1, nullptr, 10);
+      } else if (token[0] == 'N' && eq > 1 && isdigit(token[1])) {
+        uint32_t node = std::strtoul(token.c_str() + 1, nullptr, 10);
+        if (node < numa_node_count) {
+          pages[node] += std::strtoull(token.c_str() + eq + 1, nullptr, 10);
+        }
+      }
+    }
+    for (uint32_t i = 0; i < numa_node_count; ++i) {
+      node_kB[i] += pages[i] * page_kB;
+    }
+  }
+
+  metrics.numa_node_count = numa_node_count;
+  for (uint32_t i = 0; i < numa_node_count; ++i) {
+    metrics.numa_node_mem_kB[i] = node_kB[i];
+  }
+}
+
+/// Opens a counter of the given thread, returns -1 on error.
+static int open_perf_counter(uint32_t tid, uint32_t type, uint64_t config)
+{
+  struct perf_event_attr attr = {};
+  attr.size                   = sizeof(attr);
+  attr.type                   = type;
+  attr.config                 = config;
+  attr.read_format            = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  attr.exclude_hv             = 1;
+
+  int fd = syscall(__NR_perf_event_open, &attr, tid, -1, -1, PERF_FLAG_FD_CLOEXEC);
+  if (fd < 0 and errno == EACCES) {
+    // With kernel.perf_event_paranoid >= 2 only the user space part of the thread can be counted
+    attr.exclude_kernel = 1;
+    fd                  = syscall(__NR_perf_event_open, &attr, tid, -1, -1, PERF_FLAG_FD_CLOEXEC);
+  }
+  return fd;
+}
+
+/// Reads a counter, scaled up when the PMU was multiplexed between more events than it has counters.
+static uint64_t read_perf_counter(int fd)
+{
+  uint64_t values[3] = {};
+  if (read(fd, values, sizeof(values)) != sizeof(values) or values[2] == 0) {
+    return 0;
+  }
+  if (values[2] == values[1]) {
+    return values[0];
+  }
+  return static_cast<uint64_t>(static_cast<double>(values[0]) * values[1] / values[2]);
+}
+
+bool sys_metrics_processor::open_thread_counters(uint32_t tid, thread_counters_t& counters)
+{
+  counters.fds[cycles]           = open_perf_counter(tid, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+  counters.fds[instructions]     = open_perf_counter(tid, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  counters.fds[llc_misses]       = open_perf_counter(tid, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+  counters.fds[context_switches] = open_perf_counter(tid, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES);
+
+  for (int fd : counters.fds) {
+    if (fd >= 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void sys_metrics_processor::close_thread_counters(thread_counters_t& counters)
+{
+  for (int& fd : counters.fds) {
+    if (fd >= 0) {
+      close(fd);
+      fd = -1;
+    }
+  }
+}
+
+bool sys_metrics_processor::enable_thread_counters()
+{
+  // Probe the counters on the calling thread
+  thread_counters_t probe;
+  bool              available = open_thread_counters(syscall(SYS_gettid), probe);
+  close_thread_counters(probe);
+  if (not available) {
+    logger.warning("Thread counters are not available: %s", strerror(errno));
+    return false;
+  }
+  if (probe.fds[cycles] < 0) {
+    logger.info("Hardware thread counters are not available, only the context switches will be counted.");
+  }
+
+  thread_counters_enabled = true;
+  return true;
+}
+
+void sys_metrics_processor::calculate_thread_metrics(sys_metrics_t& metrics)
+{
+  DIR* dir = opendir("/proc/self/task");
+  if (dir == nullptr) {
+    return;
+  }
+
+  for (auto& t : thread_counters) {
+    t.second.seen = false;
+  }
+
+  struct dirent* entry = nullptr;
+  while ((entry = readdir(dir)) != nullptr) {
+    if (not isdigit(entry->d_name[0])) {
+      continue;
+    }
+    uint32_t tid = std::strtoul(entry->d_name, nullptr, 10);
+
+    auto it = thread_counters.find(tid);
+    if (it == thread_counters.end()) {
+      thread_counters_t counters;
+      if (not open_thread_counters(tid, counters)) {
+        continue;
+      }
+      std::ifstream comm("/proc/self/task/" + std::string(entry->d_name) + "/comm");
+      std::getline(comm, counters.name);
+      it = thread_counters.emplace(tid, std::move(counters)).first;
+    }
+    it->second.seen = true;
+  }
+  closedir(dir);
+
+  for (auto it = thread_counters.begin(); it != thread_counters.end();) {
+    thread_counters_t& counters = it->second;
+    if (not counters.seen) {
+      // The thread has exited
+      close_thread_counters(counters);
+      it = thread_counters.erase(it);
+      continue;
+    }
+
+    std::array<uint64_t, nof_thread_counters> values = {};
+    for (uint32_t i = 0; i != nof_thread_counters; ++i) {
+      if (counters.fds[i] >= 0) {
+        values[i] = read_perf_counter(counters.fds[i]);
+      }
+    }
+
+    // The threads attached in this measurement are reported from the next one, once they were counted a full period
+    if (counters.primed) {
+      std::array<uint64_t, nof_thread_counters> delta = {};
+      for (uint32_t i = 0; i != nof_thread_counters; ++i) {
+        delta[i] = values[i] - std::min(values[i], counters.last[i]);
+      }
+      sys_thread_metrics_t m;
+      m.name             = counters.name;
+      m.tid              = it->first;
+      m.cycles           = delta[cycles];
+      m.instructions     = delta[instructions];
+      m.llc_misses       = delta[llc_misses];
+      m.context_switches = delta[context_switches];
+      metrics.threads.push_back(std::move(m));
+    }
+    counters.last   = values;
+    counters.primed = true;
+    ++it;
+  }
+}
@@ -278,6 +278,54 @@ void test_bitset_find()
   }
 }
 
+template <bool reversed>
+void test_bitset_count_range()
+{
+  {
+    srsran::bounded_bitset<25, reversed> bitset(6);
+
+    // 0b000000
+    TESTASSERT(bitset.count(0, 6) == 0);
+    TESTASSERT(not bitset.any(0, 6));
+
+    // 0b100101
+    bitset.set(0);
+    bitset.set(2);
+    bitset.set(5);
+    TESTASSERT(bitset.count(0, 6) == 3);
+    TESTASSERT(bitset.count(1, 5) == 1);
+    TESTASSERT(bitset.count(3, 5) == 0);
+    TESTASSERT(bitset.count(3, 3) == 0);
+    TESTASSERT(bitset.any(1, 3));
+    TESTASSERT(not bitset.any(3, 5));
+    TESTASSERT(bitset.any(3, 6));
+  }
+  {
+    srsran::bounded_bitset<200, reversed> bitset(150);
+
+    bitset.fill(60, 130);
+    TESTASSERT(bitset.count(0, bitset.size()) == bitset.count());
+    TESTASSERT(bitset.count(0, 60) == 0);
+    TESTASSERT(bitset.count(0, 61) == 1);
+    TESTASSERT(bitset.count(63, 65) == 2);
+    TESTASSERT(bitset.count(50, 140) == 70);
+    TESTASSERT(bitset.count(129, 150) == 1);
+    TESTASSERT(not bitset.any(0, 60));
+    TESTASSERT(not bitset.any(130, 150));
+    TESTASSERT(bitset.any(127, 150));
+    for (size_t i = 0; i < bitset.size(); ++i) {
+      for (size_t j = i; j <= bitset.size(); j += 7) {
+        size_t nof_set = 0;
+        for (size_t k = i; k < j; ++k) {
+          nof_set += bitset.test(k) ? 1 : 0;
+        }
+        TESTASSERT(bitset.count(i, j) == nof_set);
+        TESTASSERT(bitset.any(i, j) == (nof_set > 0));
+      }
+    }
+  }
+}
+
 int main()
 {
   test_bit_operations();
@@ -289,6 +337,8 @@ int main()
   TESTASSERT(test_bitset_resize() == SRSRAN_SUCCESS);
   test_bitset_find<false>();
   test_bitset_find<true>();
+  test_bitset_count_range<false>();
+  test_bitset_count_range<true>();
   printf("Success\n");
   return 0;
 }
@@ -0,0 +1,200 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/dense_id_table.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <map>
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+namespace srsran {
+
+void test_dense_id_table()
+{
+  dense_id_table<std::string, 24, 4> table;
+  TESTASSERT(table.empty() and table.size() == 0 and table.begin() == table.end());
+  TESTASSERT(table.find(0) == nullptr and table.find(1) == nullptr and not table.erase(1));
+
+  // TEST: IDs start at 1 and encode the slot index
+  uint32_t id1 = table.insert("obj1");
+  uint32_t id2 = table.insert("obj2");
+  TESTASSERT(id1 == 1 and id2 == 2);
+  TESTASSERT(table.size() == 2 and *table.find(id1) == "obj1" and *table.find(id2) == "obj2");
+  TESTASSERT(table.find(3) == nullptr and table.find(id1 + 16) == nullptr);
+
+  // TEST: the ID of an erased object does not match the object that reuses its slot
+  TESTASSERT(table.erase(id1) and not table.erase(id1) and table.find(id1) == nullptr);
+  uint32_t id3 = table.insert("obj3");
+  TESTASSERT(id3 == id1 + 16 and *table.find(id3) == "obj3" and table.find(id1) == nullptr);
+  uint32_t id4 = table.insert("obj4");
+  TESTASSERT(id4 == 3 and *table.find(id4) == "obj4");
+
+  // TEST: iteration
+  size_t count = 0;
+  for (auto it = table.begin(); it != table.end(); ++it) {
+    TESTASSERT(*table.find(it.id()) == *it);
+    count++;
+  }
+  TESTASSERT(count == 3);
+
+  // TEST: the table is full with 2^SlotBits - 1 objects
+  while (not table.full()) {
+    TESTASSERT(table.insert("obj") != decltype(table)::invalid_id);
+  }
+  TESTASSERT(table.size() == 15 and table.insert("obj") == decltype(table)::invalid_id);
+
+  table.clear();
+  TESTASSERT(table.empty() and table.begin() == table.end() and table.find(id2) == nullptr);
+}
+
+/// The generation wraps around without producing the ID 0 or IDs that exceed IdBits
+void test_dense_id_table_wrap_around()
+{
+  dense_id_table<int, 8, 4> table;
+  uint32_t                  id = table.insert(0);
+  for (uint32_t i = 0; i < 64; ++i) {
+    TESTASSERT(table.erase(id));
+    id = table.insert(i);
+    TESTASSERT(id != 0 and id < 256 and (id & 0xf) == 1 and *table.find(id) == (int)i);
+  }
+}
+
+/// Random insertions and erasures checked against std::map
+void test_dense_id_table_random()
+{
+  std::mt19937                     rgen(0);
+  dense_id_table<uint32_t, 32, 10> table;
+  std::map<uint32_t, uint32_t>     refmap;
+  std::vector<uint32_t>            erased;
+
+  for (uint32_t i = 0; i < 100000; ++i) {
+    if (not refmap.empty() and (table.full() or rgen() % 2 == 0)) {
+      auto it = refmap.begin();
+      std::advance(it, rgen() % refmap.size());
+      TESTASSERT(table.erase(it->first));
+      erased.push_back(it->first);
+      refmap.erase(it);
+    } else {
+      uint32_t id = table.insert(i);
+      TESTASSERT(id != 0 and refmap.emplace(id, i).second);
+    }
+    TESTASSERT(table.size() == refmap.size());
+    if (i % 1000 == 0) {
+      for (const auto& obj : refmap) {
+        TESTASSERT(table.contains(obj.first) and *table.find(obj.first) == obj.second);
+      }
+      for (uint32_t id : erased) {
+        TESTASSERT(refmap.count(id) == 1 or table.find(id) == nullptr);
+      }
+      erased.clear();
+    }
+  }
+}
+
+struct bench_ue_ctx {
+  uint32_t enb_ue_s1ap_id = 0;
+  uint16_t rnti           = 0;
+  uint8_t  payload[512]   = {};
+};
+
+/// Resolves the UE context of nof_msgs UE-associated messages among nof_ues contexts, with a UE release and attach
+/// every 16 messages. Returns the time elapsed
+template <typename Table, typename InsertFn, typename FindFn>
+std::chrono::microseconds ue_lookup_run(Table& table, uint32_t nof_ues, uint32_t nof_msgs, InsertFn insert, FindFn find)
+{
+  std::mt19937          rgen(0);
+  std::vector<uint32_t> ids(nof_ues);
+  size_t                nof_found = 0;
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    ids[i] = insert(table, i);
+  }
+
+  auto tp = std::chrono::high_resolution_clock::now();
+  for (uint32_t i = 0; i < nof_msgs; ++i) {
+    uint32_t      idx = rgen() % nof_ues;
+    bench_ue_ctx* ctx = find(table, ids[idx]);
+    nof_found += ctx != nullptr and ctx->enb_ue_s1ap_id == ids[idx];
+    if (i % 16 == 0) {
+      table.erase(ids[idx]);
+      ids[idx] = insert(table, idx);
+    }
+  }
+  auto t = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - tp);
+  TESTASSERT(nof_found == nof_msgs);
+  return t;
+}
+
+void ue_lookup_benchmark(uint32_t nof_ues)
+{
+  const uint32_t nof_msgs = 2000000;
+
+  using dense_table = dense_id_table<std::unique_ptr<bench_ue_ctx>, 24, 14>;
+  dense_table               dense;
+  std::chrono::microseconds t_dense = ue_lookup_run(
+      dense,
+      nof_ues,
+      nof_msgs,
+      [](dense_table& t, uint32_t idx) {
+        uint32_t id                   = t.insert(std::unique_ptr<bench_ue_ctx>(new bench_ue_ctx));
+        (*t.find(id))->enb_ue_s1ap_id = id;
+        return id;
+      },
+      [](dense_table& t, uint32_t id) {
+        std::unique_ptr<bench_ue_ctx>* ctx = t.find(id);
+        return ctx != nullptr ? ctx->get() : nullptr;
+      });
+
+  using hash_table  = std::unordered_map<uint32_t, std::unique_ptr<bench_ue_ctx> >;
+  uint32_t                  next_id = 1;
+  hash_table                hmap;
+  std::chrono::microseconds t_hash = ue_lookup_run(
+      hmap,
+      nof_ues,
+      nof_msgs,
+      [&next_id](hash_table& t, uint32_t idx) {
+        std::unique_ptr<bench_ue_ctx> ctx(new bench_ue_ctx);
+        ctx->enb_ue_s1ap_id = next_id++;
+        return t.emplace(ctx->enb_ue_s1ap_id, std::move(ctx)).first->first;
+      },
+      [](hash_table& t, uint32_t id) {
+        auto it = t.find(id);
+        return it != t.end() ? it->second.get() : nullptr;
+      });
+
+  fmt::print("UE lookup benchmark, {} UEs: std::unordered_map={:.1f} Mmsg/s, dense_id_table={:.1f} Mmsg/s\n",
+             nof_ues,
+             nof_msgs / (double)std::max(t_hash.count(), (long)1),
+             nof_msgs / (double)std::max(t_dense.count(), (long)1));
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  srsran::test_dense_id_table();
+  srsran::test_dense_id_table_wrap_around();
+  srsran::test_dense_id_table_random();
+  srsran::ue_lookup_benchmark(argc > 1 ? std::stoul(argv[1]) : 10000);
+  printf("Success\n");
+  return 0;
+}
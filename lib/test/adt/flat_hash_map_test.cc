@@ -0,0 +1,256 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/flat_hash_map.h"
+#include "srsran/adt/pool/mem_pool.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <map>
+#include <random>
+#include <set>
+
+namespace srsran {
+
+void test_flat_hash_map()
+{
+  flat_hash_map<uint32_t, std::string> mymap;
+  TESTASSERT(mymap.size() == 0 and mymap.empty() and mymap.capacity() == 0);
+  TESTASSERT(mymap.begin() == mymap.end());
+  TESTASSERT(not mymap.contains(0) and mymap.find(0) == mymap.end() and mymap.erase(0) == 0);
+
+  TESTASSERT(mymap.emplace(0, "obj0").second);
+  TESTASSERT(mymap.contains(0) and mymap.find(0)->second == "obj0");
+  TESTASSERT(mymap.size() == 1 and not mymap.empty());
+  TESTASSERT(mymap.begin() != mymap.end());
+
+  // TEST: duplicate keys are not inserted
+  auto ret = mymap.emplace(0, "obj1");
+  TESTASSERT(not ret.second and ret.first->second == "obj0");
+  TESTASSERT(mymap.insert(std::make_pair(1u, std::string("obj1"))).second);
+  mymap[2] = "obj2";
+  TESTASSERT(mymap.size() == 3 and mymap[1] == "obj1" and mymap.count(2) == 1);
+
+  // TEST: iteration
+  std::set<uint32_t> keys;
+  for (std::pair<uint32_t, std::string>& obj : mymap) {
+    TESTASSERT(obj.second == "obj" + std::to_string(obj.first));
+    keys.insert(obj.first);
+  }
+  TESTASSERT(keys.size() == 3);
+  const flat_hash_map<uint32_t, std::string>& cmap = mymap;
+  TESTASSERT(std::distance(cmap.begin(), cmap.end()) == 3);
+
+  // TEST: copy and move
+  flat_hash_map<uint32_t, std::string> mymap2(mymap);
+  TESTASSERT(mymap2.size() == 3 and mymap2[2] == "obj2");
+  flat_hash_map<uint32_t, std::string> mymap3(std::move(mymap2));
+  TESTASSERT(mymap3.size() == 3 and mymap2.empty() and not mymap2.contains(2));
+  mymap2 = mymap3;
+  TESTASSERT(mymap2.size() == 3 and mymap2.find(1)->second == "obj1");
+
+  TESTASSERT(mymap.erase(0) == 1 and mymap.erase(0) == 0);
+  TESTASSERT(not mymap.contains(0) and mymap.contains(1) and mymap.contains(2));
+  mymap.clear();
+  TESTASSERT(mymap.empty() and mymap.begin() == mymap.end() and not mymap.contains(1));
+}
+
+struct C {
+  C() { count++; }
+  explicit C(int v_) : v(v_) { count++; }
+  ~C() { count--; }
+  C(C&& other) : v(other.v) { count++; }
+  C(const C&) = delete;
+  C& operator=(C&&) = default;
+
+  int           v = 0;
+  static size_t count;
+};
+size_t C::count = 0;
+
+void test_flat_hash_map_dtor()
+{
+  {
+    flat_hash_map<int32_t, C> mymap;
+    for (int32_t i = -100; i < 100; ++i) {
+      mymap.emplace(i, i);
+    }
+    TESTASSERT(C::count == 200);
+    for (int32_t i = -100; i < 100; i += 2) {
+      TESTASSERT(mymap.erase(i) == 1);
+    }
+    TESTASSERT(C::count == 100);
+    flat_hash_map<int32_t, C> mymap2(std::move(mymap));
+    TESTASSERT(C::count == 100 and mymap2.find(-99)->second.v == -99);
+  }
+  TESTASSERT(C::count == 0);
+}
+
+/// Random insertions and erasures checked against std::map, with keys in a small range to force collisions
+void test_flat_hash_map_random()
+{
+  std::mt19937                       rgen(0);
+  std::uniform_int_distribution<int> key_dist(0, 2000);
+  flat_hash_map<uint64_t, uint64_t>  mymap;
+  std::map<uint64_t, uint64_t>       refmap;
+
+  for (uint32_t i = 0; i < 200000; ++i) {
+    uint64_t key = key_dist(rgen) * 1024;
+    if (rgen() % 3 == 0) {
+      TESTASSERT(mymap.erase(key) == refmap.erase(key));
+    } else {
+      TESTASSERT(mymap.emplace(key, i).second == refmap.emplace(key, i).second);
+    }
+    TESTASSERT(mymap.size() == refmap.size());
+    if (i % 1000 == 0) {
+      for (const auto& obj : refmap) {
+        TESTASSERT(mymap.contains(obj.first) and mymap.find(obj.first)->second == obj.second);
+      }
+      size_t count = 0;
+      for (const auto& obj : mymap) {
+        TESTASSERT(refmap.count(obj.first) == 1);
+        count++;
+      }
+      TESTASSERT(count == refmap.size());
+    }
+  }
+}
+
+void test_flat_hash_set()
+{
+  flat_hash_set<uint32_t> myset;
+  TESTASSERT(myset.empty() and myset.begin() == myset.end());
+  TESTASSERT(myset.insert(5).second and not myset.insert(5).second);
+  TESTASSERT(myset.insert(7).second and myset.size() == 2);
+  TESTASSERT(myset.contains(5) and *myset.find(7) == 7 and myset.find(6) == myset.end());
+
+  uint32_t sum = 0;
+  for (uint32_t v : myset) {
+    sum += v;
+  }
+  TESTASSERT(sum == 12);
+
+  TESTASSERT(myset.erase(5) == 1 and not myset.contains(5) and myset.size() == 1);
+  myset.clear();
+  TESTASSERT(myset.empty());
+}
+
+/// UE context of the MME attach benchmark, the allocation is done by the Pool type
+template <typename Pool>
+struct bench_ue_ctx {
+  uint64_t imsi           = 0;
+  uint32_t mme_ue_s1ap_id = 0;
+  uint32_t m_tmsi         = 0;
+  uint8_t  payload[2048]  = {};
+
+  static Pool* pool;
+  void*        operator new(size_t sz) { return pool->allocate_node(sz); }
+  void         operator delete(void* p) { pool->deallocate_node(p); }
+};
+template <typename Pool>
+Pool* bench_ue_ctx<Pool>::pool = nullptr;
+
+struct malloc_pool {
+  void* allocate_node(size_t sz) { return ::operator new(sz); }
+  void  deallocate_node(void* p) { ::operator delete(p); }
+};
+
+/// Attaches and detaches nof_ues UEs with the MME UE context tables (IMSI, MME UE S1AP Id, M-TMSI, eNB UE set),
+/// looking up the context of each UE as often as the attach procedure does. Returns the time elapsed
+template <typename Ctx, typename Map64, typename Map32, typename TmsiMap, typename UeSet>
+std::chrono::microseconds mme_attach_run(uint32_t nof_ues, uint32_t nof_rounds)
+{
+  Map64   imsi_to_ctx;
+  Map32   s1ap_id_to_ctx;
+  TmsiMap tmsi_to_imsi;
+  UeSet   enb_ues;
+  size_t  nof_found = 0;
+
+  auto tp = std::chrono::high_resolution_clock::now();
+  for (uint32_t r = 0; r < nof_rounds; ++r) {
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      Ctx* ctx            = new Ctx;
+      ctx->imsi           = 1010123456789ULL + i * 7919ULL;
+      ctx->mme_ue_s1ap_id = r * nof_ues + i + 1;
+      ctx->m_tmsi         = (r * nof_ues + i) * 2654435761U;
+      imsi_to_ctx.emplace(ctx->imsi, ctx);
+      s1ap_id_to_ctx.emplace(ctx->mme_ue_s1ap_id, ctx);
+      tmsi_to_imsi.emplace(ctx->m_tmsi, ctx->imsi);
+      enb_ues.insert(ctx->mme_ue_s1ap_id);
+      // Authentication, security mode, ESM info, ICS and attach complete procedures
+      for (uint32_t n = 0; n < 8; ++n) {
+        nof_found += s1ap_id_to_ctx.count(ctx->mme_ue_s1ap_id) + imsi_to_ctx.count(ctx->imsi);
+      }
+    }
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      uint64_t imsi = 1010123456789ULL + i * 7919ULL;
+      Ctx*     ctx  = imsi_to_ctx.find(imsi)->second;
+      enb_ues.erase(ctx->mme_ue_s1ap_id);
+      s1ap_id_to_ctx.erase(ctx->mme_ue_s1ap_id);
+      tmsi_to_imsi.erase(ctx->m_tmsi);
+      imsi_to_ctx.erase(imsi);
+      delete ctx;
+    }
+  }
+  auto t = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - tp);
+  TESTASSERT(nof_found == 16 * (size_t)nof_ues * nof_rounds);
+  TESTASSERT(imsi_to_ctx.empty() and s1ap_id_to_ctx.empty() and tmsi_to_imsi.empty() and enb_ues.empty());
+  return t;
+}
+
+void mme_attach_benchmark(uint32_t nof_ues, uint32_t nof_rounds)
+{
+  using std_ctx  = bench_ue_ctx<malloc_pool>;
+  using pool_ctx = bench_ue_ctx<big_obj_pool<bench_ue_ctx<void>, true> >;
+  malloc_pool                            heap;
+  big_obj_pool<bench_ue_ctx<void>, true> pool;
+  std_ctx::pool  = &heap;
+  pool_ctx::pool = &pool;
+
+  std::chrono::microseconds t_std = mme_attach_run<std_ctx,
+                                                   std::map<uint64_t, std_ctx*>,
+                                                   std::map<uint32_t, std_ctx*>,
+                                                   std::map<uint32_t, uint64_t>,
+                                                   std::set<uint32_t> >(nof_ues, nof_rounds);
+  std::chrono::microseconds t_flat = mme_attach_run<pool_ctx,
+                                                    flat_hash_map<uint64_t, pool_ctx*>,
+                                                    flat_hash_map<uint32_t, pool_ctx*>,
+                                                    flat_hash_map<uint32_t, uint64_t>,
+                                                    flat_hash_set<uint32_t> >(nof_ues, nof_rounds);
+
+  double nof_attaches = (double)nof_ues * nof_rounds;
+  fmt::print("MME attach benchmark, {} UEs: std::map={:.0f} attach/s, flat_hash_map={:.0f} attach/s\n",
+             nof_ues,
+             nof_attaches * 1e6 / std::max(t_std.count(), (long)1),
+             nof_attaches * 1e6 / std::max(t_flat.count(), (long)1));
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  srsran::test_flat_hash_map();
+  srsran::test_flat_hash_map_dtor();
+  srsran::test_flat_hash_map_random();
+  srsran::test_flat_hash_set();
+  srsran::mme_attach_benchmark(argc > 1 ? std::stoul(argv[1]) : 10000, 4);
+  printf("Success\n");
+  return 0;
+}
@@ -91,6 +91,46 @@ int test_interval_expand()
   return SRSRAN_SUCCESS;
 }
 
+int test_interval_set()
+{
+  srsran::bounded_interval_set<uint32_t, 3> set;
+  TESTASSERT(set.empty());
+
+  TESTASSERT(set.insert({10, 20}));
+  TESTASSERT(set.insert({30, 40}));
+  TESTASSERT(set.insert({0, 5}));
+  TESTASSERT(set.size() == 3);
+  TESTASSERT(set.front() == srsran::interval<uint32_t>(0, 5));
+  TESTASSERT(set.back() == srsran::interval<uint32_t>(30, 40));
+
+  // no room for a fourth disjoint interval
+  TESTASSERT(not set.insert({50, 60}));
+  TESTASSERT(set.size() == 3);
+
+  // overlaps
+  TESTASSERT(set.overlaps({4, 6}));
+  TESTASSERT(set.overlaps({15, 16}));
+  TESTASSERT(set.overlaps({19, 31}));
+  TESTASSERT(not set.overlaps({5, 10}));
+  TESTASSERT(not set.overlaps({20, 30}));
+  TESTASSERT(not set.overlaps({40, 100}));
+
+  // adjacent intervals are merged
+  TESTASSERT(set.insert({5, 10}));
+  TESTASSERT(set.size() == 2);
+  TESTASSERT(set.front() == srsran::interval<uint32_t>(0, 20));
+
+  // an interval covering several of them merges them all
+  TESTASSERT(set.insert({50, 60}));
+  TESTASSERT(set.insert({15, 55}));
+  TESTASSERT(set.size() == 1);
+  TESTASSERT(set.front() == srsran::interval<uint32_t>(0, 60));
+
+  set.clear();
+  TESTASSERT(set.empty());
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   TESTASSERT(test_interval_init() == SRSRAN_SUCCESS);
@@ -98,5 +138,6 @@ int main()
   TESTASSERT(test_interval_contains() == SRSRAN_SUCCESS);
   TESTASSERT(test_interval_intersect() == SRSRAN_SUCCESS);
   TESTASSERT(test_interval_expand() == SRSRAN_SUCCESS);
+  TESTASSERT(test_interval_set() == SRSRAN_SUCCESS);
   return 0;
 }
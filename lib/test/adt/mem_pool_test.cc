@@ -22,6 +22,8 @@
 #include "srsran/adt/pool/fixed_size_pool.h"
 #include "srsran/adt/pool/mem_pool.h"
 #include "srsran/adt/pool/obj_pool.h"
+#include "srsran/adt/pool/pool_registry.h"
+#include "srsran/common/buffer_pool.h"
 #include "srsran/common/test_common.h"
 
 class C
@@ -149,6 +151,46 @@ void test_fixedsize_pool()
   }
   fixed_pool->print_all_buffers();
   TESTASSERT(C::default_ctor_counter == C::dtor_counter);
+
+  // TEST: the thread local cache counts hits and misses
+  {
+    BigObj::pool_t::cache_metrics_t before = fixed_pool->get_local_cache_metrics();
+    std::unique_ptr<BigObj>         obj(new (std::nothrow) BigObj());
+    TESTASSERT(obj != nullptr);
+    BigObj::pool_t::cache_metrics_t after = fixed_pool->get_local_cache_metrics();
+    TESTASSERT(after.nof_hits + after.nof_misses == before.nof_hits + before.nof_misses + 1);
+    TESTASSERT(after.nof_failures == before.nof_failures);
+  }
+
+  // TEST: several threads allocate and deallocate concurrently without losing blocks
+  {
+    const size_t             nof_threads = 4;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nof_threads; ++i) {
+      threads.emplace_back([pool_size]() {
+        std::vector<std::unique_ptr<BigObj> > objs;
+        for (size_t n = 0; n < pool_size * 16; ++n) {
+          if (objs.size() < pool_size / 8 and n % 3 != 0) {
+            objs.emplace_back(new (std::nothrow) BigObj());
+            TESTASSERT(objs.back() != nullptr);
+          } else if (not objs.empty()) {
+            objs.pop_back();
+          }
+        }
+      });
+    }
+    for (std::thread& t : threads) {
+      t.join();
+    }
+    // all blocks must be available again
+    std::vector<std::unique_ptr<BigObj> > vec(pool_size);
+    for (size_t i = 0; i < pool_size; ++i) {
+      vec[i].reset(new (std::nothrow) BigObj());
+      TESTASSERT(vec[i].get() != nullptr);
+    }
+  }
+  fixed_pool->print_all_buffers();
+  TESTASSERT(C::default_ctor_counter == C::dtor_counter);
 }
 
 struct D : public C {
@@ -181,6 +223,69 @@ void test_background_pool()
   TESTASSERT(C::dtor_counter == C::default_ctor_counter);
 }
 
+static bool find_pool_metrics(const char* name, srsran::pool_metrics_t& m)
+{
+  std::vector<srsran::pool_metrics_t> metrics;
+  srsran::pool_registry::get().get_metrics(metrics);
+  for (const srsran::pool_metrics_t& pm : metrics) {
+    if (pm.name == name) {
+      m = pm;
+      return true;
+    }
+  }
+  return false;
+}
+
+void test_pool_registry()
+{
+  auto&                  logger = srslog::fetch_basic_logger("POOL");
+  srsran::pool_metrics_t m;
+  size_t                 nof_leaks = srsran::pool_registry::get().log_leaks(logger);
+  {
+    srsran::background_mem_pool pool(4, 64, 2, -1, "test_background_pool");
+    TESTASSERT(find_pool_metrics("test_background_pool", m));
+    TESTASSERT(m.nof_blocks == 4 and m.nof_used == 0 and m.nof_allocs == 0 and m.block_size == 64);
+
+    std::vector<void*> nodes;
+    for (size_t i = 0; i < 3; ++i) {
+      nodes.push_back(pool.allocate_node(16));
+    }
+    pool.deallocate_node(nodes.back());
+    nodes.pop_back();
+    TESTASSERT(find_pool_metrics("test_background_pool", m));
+    TESTASSERT(m.nof_used == 2 and m.high_water_mark == 3 and m.nof_allocs == 3 and m.nof_failures == 0);
+    TESTASSERT(std::abs(m.fragmentation - 0.75) < 0.01);
+    // the first allocation is always sampled
+    TESTASSERT(m.alloc_latency_max_us > 0 and m.alloc_latency_avg_us <= m.alloc_latency_max_us);
+
+    // blocks that were not returned are reported as leaks
+    TESTASSERT(srsran::pool_registry::get().log_leaks(logger) == nof_leaks + 1);
+    for (void* node : nodes) {
+      pool.deallocate_node(node);
+    }
+    TESTASSERT(srsran::pool_registry::get().log_leaks(logger) == nof_leaks);
+  }
+  // destroyed pools leave the registry
+  TESTASSERT(not find_pool_metrics("test_background_pool", m));
+
+  {
+    struct buffer_t {
+      uint8_t data[128];
+    };
+    srsran::buffer_pool<buffer_t> pool(2, "test_buffer_pool");
+    buffer_t*                     b1 = pool.allocate();
+    buffer_t*                     b2 = pool.allocate();
+    TESTASSERT(b1 != nullptr and b2 != nullptr and pool.allocate() == nullptr);
+    TESTASSERT(find_pool_metrics("test_buffer_pool", m));
+    TESTASSERT(m.nof_blocks == 2 and m.nof_used == 2 and m.nof_allocs == 3 and m.nof_failures == 1);
+    TESTASSERT(m.fragmentation == 0);
+    pool.deallocate(b1);
+    pool.deallocate(b2);
+    TESTASSERT(find_pool_metrics("test_buffer_pool", m));
+    TESTASSERT(m.nof_used == 0 and m.high_water_mark == 2);
+  }
+}
+
 int main(int argc, char** argv)
 {
   srsran::test_init(argc, argv);
@@ -188,6 +293,7 @@ int main(int argc, char** argv)
   test_nontrivial_obj_pool();
   test_fixedsize_pool();
   test_background_pool();
+  test_pool_registry();
 
   printf("Success\n");
   return 0;
@@ -0,0 +1,193 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/mpmc_queue.h"
+#include "srsran/common/block_queue.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+#include <getopt.h>
+#include <thread>
+#include <vector>
+
+/*
+ * Producer/consumer benchmark of the queues shared between threads: block_queue (pthread mutex and std::queue),
+ * dyn_blocking_queue (std::mutex and ring) and the lock-free mpmc_queue. It measures the latency from the push of an
+ * element to its blocking pop by a sleeping consumer, and the throughput of several producers and consumers.
+ */
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+uint32_t nof_values    = 200000;
+uint32_t nof_producers = 2;
+uint32_t queue_size    = 256;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [np]\n", prog);
+  printf("\t-n number of values pushed by each producer [Default %d]\n", nof_values);
+  printf("\t-p number of producers and of consumers of the throughput test [Default %d]\n", nof_producers);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:p:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_values = (uint32_t)strtol(optarg, nullptr, 10);
+        break;
+      case 'p':
+        nof_producers = (uint32_t)strtol(optarg, nullptr, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// Adapters of the push/pop APIs of each queue, the value 0 stops a consumer
+struct block_queue_adapter {
+  srsran::block_queue<uint64_t> q{(int)queue_size};
+  void                          push(uint64_t v) { q.push(v); }
+  uint64_t                      pop() { return q.wait_pop(); }
+};
+
+struct dyn_blocking_queue_adapter {
+  srsran::dyn_blocking_queue<uint64_t> q{queue_size};
+  void                                 push(uint64_t v) { q.push_blocking(v); }
+  uint64_t                             pop() { return q.pop_blocking(); }
+};
+
+struct mpmc_queue_adapter {
+  srsran::mpmc_queue<uint64_t> q{queue_size};
+  void                         push(uint64_t v) { q.push_blocking(v); }
+  uint64_t                     pop() { return q.pop_blocking(); }
+};
+
+uint64_t now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count();
+}
+
+/// One producer pushes its timestamp every few microseconds, the consumer records how long it took to pop it
+template <typename Queue>
+void run_latency(const char* name)
+{
+  Queue                 queue;
+  uint32_t              nof_samples = std::max(nof_values / 20, 1U);
+  std::vector<uint64_t> latency;
+  latency.reserve(nof_samples);
+
+  std::thread consumer([&queue, &latency]() {
+    for (uint64_t ts = queue.pop(); ts != 0; ts = queue.pop()) {
+      latency.push_back(now_ns() - ts);
+    }
+  });
+  for (uint32_t i = 0; i < nof_samples; ++i) {
+    // Leave the consumer time to go to sleep
+    uint64_t t_next = now_ns() + 20000;
+    while (now_ns() < t_next) {
+    }
+    queue.push(now_ns());
+  }
+  queue.push(0);
+  consumer.join();
+
+  std::sort(latency.begin(), latency.end());
+  double avg = 0;
+  for (uint64_t l : latency) {
+    avg += l;
+  }
+  avg /= latency.size();
+  printf("%-20s latency: avg=%6.2f us, p50=%6.2f us, p99=%7.2f us, max=%8.2f us\n",
+         name,
+         avg / 1000.0,
+         latency[latency.size() / 2] / 1000.0,
+         latency[latency.size() * 99 / 100] / 1000.0,
+         latency.back() / 1000.0);
+}
+
+/// nof_producers threads push nof_values each, while as many consumers pop them
+template <typename Queue>
+void run_throughput(const char* name)
+{
+  Queue                    queue;
+  std::atomic<uint64_t>    sum{0};
+  std::vector<std::thread> threads;
+
+  auto t_start = clock_type::now();
+  for (uint32_t c = 0; c < nof_producers; ++c) {
+    threads.emplace_back([&queue, &sum]() {
+      uint64_t local_sum = 0;
+      for (uint64_t v = queue.pop(); v != 0; v = queue.pop()) {
+        local_sum += v;
+      }
+      sum += local_sum;
+    });
+  }
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < nof_producers; ++p) {
+    producers.emplace_back([&queue]() {
+      for (uint32_t i = 1; i <= nof_values; ++i) {
+        queue.push(i);
+      }
+    });
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  for (uint32_t c = 0; c < nof_producers; ++c) {
+    queue.push(0);
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  double secs = std::chrono::duration<double>(clock_type::now() - t_start).count();
+
+  uint64_t expected = (uint64_t)nof_producers * nof_values * (nof_values + 1) / 2;
+  TESTASSERT(sum == expected);
+  printf("%-20s throughput: %6.2f Mvalues/s with %d producers and %d consumers\n",
+         name,
+         nof_producers * nof_values / secs / 1e6,
+         nof_producers,
+         nof_producers);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  run_latency<block_queue_adapter>("block_queue");
+  run_latency<dyn_blocking_queue_adapter>("dyn_blocking_queue");
+  run_latency<mpmc_queue_adapter>("mpmc_queue");
+
+  run_throughput<block_queue_adapter>("block_queue");
+  run_throughput<dyn_blocking_queue_adapter>("dyn_blocking_queue");
+  run_throughput<mpmc_queue_adapter>("mpmc_queue");
+
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,156 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/mpmc_queue.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+#include <vector>
+
+namespace srsran {
+
+int test_mpmc_queue_api()
+{
+  mpmc_queue<std::unique_ptr<int> > queue(5);
+  TESTASSERT(queue.max_size() == 5);
+  TESTASSERT(queue.empty() and not queue.full());
+
+  for (int i = 0; i < 5; ++i) {
+    TESTASSERT(queue.try_push(std::unique_ptr<int>(new int(i))).has_value());
+  }
+  TESTASSERT(queue.full() and queue.size() == 5);
+
+  // A rejected element is given back to the caller
+  srsran::error_type<std::unique_ptr<int> > ret = queue.try_push(std::unique_ptr<int>(new int(5)));
+  TESTASSERT(ret.is_error() and *ret.error() == 5);
+
+  std::unique_ptr<int> val;
+  for (int i = 0; i < 5; ++i) {
+    TESTASSERT(queue.try_pop(val) and *val == i);
+    // The ring wraps around
+    TESTASSERT(queue.try_push(std::unique_ptr<int>(new int(10 + i))).has_value());
+  }
+  for (int i = 0; i < 5; ++i) {
+    TESTASSERT(queue.try_pop(val) and *val == 10 + i);
+  }
+  TESTASSERT(not queue.try_pop(val));
+
+  // Timed pop of an empty queue
+  auto t0 = std::chrono::steady_clock::now();
+  TESTASSERT(not queue.pop_wait_until(val, t0 + std::chrono::milliseconds(10)));
+  TESTASSERT(std::chrono::steady_clock::now() - t0 >= std::chrono::milliseconds(10));
+
+  // Elements left in the queue are destroyed with it
+  TESTASSERT(queue.try_push(std::unique_ptr<int>(new int(1))).has_value());
+  return SRSRAN_SUCCESS;
+}
+
+int test_mpmc_queue_stop()
+{
+  // A consumer blocked in an empty queue is released
+  mpmc_queue<int> empty_queue(2);
+  std::thread     consumer([&empty_queue]() {
+    bool success = true;
+    empty_queue.pop_blocking(&success);
+    TESTASSERT(not success);
+  });
+
+  // A producer blocked in a full queue is released
+  mpmc_queue<int> full_queue(2);
+  TESTASSERT(full_queue.try_push(1) and full_queue.try_push(2));
+  std::thread producer([&full_queue]() { TESTASSERT(not full_queue.push_blocking(3)); });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  empty_queue.stop();
+  full_queue.stop();
+  consumer.join();
+  producer.join();
+  TESTASSERT(full_queue.is_stopped() and full_queue.empty());
+  TESTASSERT(not full_queue.try_push(4));
+  return SRSRAN_SUCCESS;
+}
+
+/// Producers and consumers exchanging values through a small queue, with blocking and non-blocking calls
+int test_mpmc_queue_concurrent()
+{
+  const uint32_t nof_producers = 4, nof_consumers = 4, nof_values = 50000;
+
+  mpmc_queue<uint32_t>               queue(16);
+  std::vector<std::atomic<uint32_t> > received(nof_producers * nof_values);
+  for (auto& r : received) {
+    r = 0;
+  }
+  std::atomic<uint32_t> nof_popped{0};
+
+  std::vector<std::thread> threads;
+  for (uint32_t p = 0; p < nof_producers; ++p) {
+    threads.emplace_back([&queue, p]() {
+      for (uint32_t i = 0; i < nof_values; ++i) {
+        uint32_t val = p * nof_values + i;
+        if (i % 2 == 0) {
+          queue.push_blocking(val);
+        } else {
+          while (not queue.try_push(val)) {
+            std::this_thread::yield();
+          }
+        }
+      }
+    });
+  }
+  for (uint32_t c = 0; c < nof_consumers; ++c) {
+    threads.emplace_back([&]() {
+      std::vector<int64_t> last(nof_producers, -1);
+      uint32_t             val;
+      while (nof_popped.load() < nof_producers * nof_values) {
+        if (not queue.pop_wait_until(val, std::chrono::steady_clock::now() + std::chrono::milliseconds(1))) {
+          continue;
+        }
+        nof_popped++;
+        received[val]++;
+        // The values of a producer are seen in order by each consumer
+        uint32_t p = val / nof_values;
+        TESTASSERT((int64_t)(val % nof_values) > last[p]);
+        last[p] = val % nof_values;
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  for (auto& r : received) {
+    TESTASSERT(r == 1);
+  }
+  TESTASSERT(queue.empty());
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  srsran::test_init(argc, argv);
+
+  TESTASSERT(srsran::test_mpmc_queue_api() == SRSRAN_SUCCESS);
+  TESTASSERT(srsran::test_mpmc_queue_stop() == SRSRAN_SUCCESS);
+  TESTASSERT(srsran::test_mpmc_queue_concurrent() == SRSRAN_SUCCESS);
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,149 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/rcu_circular_map.h"
+#include "srsran/common/test_common.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace srsran {
+
+struct obj_t {
+  explicit obj_t(uint32_t id_) : id(id_) { count++; }
+  ~obj_t()
+  {
+    alive.store(false, std::memory_order_relaxed);
+    count--;
+  }
+  uint32_t                id;
+  std::atomic<bool>       alive{true};
+  static std::atomic<int> count;
+};
+std::atomic<int> obj_t::count{0};
+
+using test_map_t = rcu_circular_map<uint32_t, std::unique_ptr<obj_t>, 16>;
+
+void test_rcu_map()
+{
+  {
+    test_map_t map;
+    TESTASSERT(map.empty() and not map.full() and map.capacity() == 16);
+
+    TESTASSERT(map.insert(1, std::unique_ptr<obj_t>(new obj_t(1))));
+    TESTASSERT(map.insert(2, std::unique_ptr<obj_t>(new obj_t(2))));
+    TESTASSERT(map.size() == 2 and obj_t::count == 2);
+
+    // Same position as key 1
+    std::unique_ptr<obj_t> obj17(new obj_t(17));
+    TESTASSERT(not map.has_space(17));
+    TESTASSERT(not map.insert(17, std::move(obj17)));
+    TESTASSERT(obj17 != nullptr and map.size() == 2);
+
+    {
+      test_map_t::read_guard lock(map);
+      TESTASSERT(map.find(1) != nullptr and map.find(1)->id == 1);
+      TESTASSERT(map.contains(2) and not map.contains(17) and not map.contains(3));
+
+      uint32_t sum = 0;
+      map.for_each([&sum](uint32_t key, obj_t& obj) {
+        TESTASSERT(key == obj.id);
+        sum += key;
+      });
+      TESTASSERT(sum == 3);
+    }
+
+    TESTASSERT(not map.erase(17));
+    TESTASSERT(map.erase(1));
+    TESTASSERT(not map.erase(1));
+    TESTASSERT(map.size() == 1 and obj_t::count == 2);
+    TESTASSERT(map.insert(17, std::move(obj17)));
+    {
+      test_map_t::read_guard lock(map);
+      TESTASSERT(not map.contains(1) and map.find(17)->id == 17);
+    }
+
+    map.clear();
+    TESTASSERT(map.empty() and obj_t::count == 0);
+    TESTASSERT(map.insert(3, std::unique_ptr<obj_t>(new obj_t(3))));
+  }
+  // The map destructor releases the remaining objects
+  TESTASSERT(obj_t::count == 0);
+}
+
+void test_rcu_map_concurrent_readers()
+{
+  const uint32_t    nof_readers = 4, nof_keys = 8, nof_writes = 2000;
+  test_map_t        map;
+  std::atomic<bool> running{true};
+  std::atomic<int>  nof_errors{0};
+
+  std::vector<std::thread> readers;
+  for (uint32_t i = 0; i < nof_readers; ++i) {
+    readers.emplace_back([&map, &running, &nof_errors, nof_keys]() {
+      while (running.load(std::memory_order_relaxed)) {
+        test_map_t::read_guard lock(map);
+        for (uint32_t key = 0; key < nof_keys; ++key) {
+          obj_t* obj = map.find(key);
+          if (obj != nullptr and (obj->id != key or not obj->alive.load(std::memory_order_relaxed))) {
+            nof_errors++;
+          }
+        }
+        map.for_each([&nof_errors](uint32_t key, obj_t& obj) {
+          if (not obj.alive.load(std::memory_order_relaxed)) {
+            nof_errors++;
+          }
+        });
+      }
+    });
+  }
+
+  for (uint32_t i = 0; i < nof_writes; ++i) {
+    uint32_t key = i % nof_keys;
+    if (not map.erase(key)) {
+      TESTASSERT(map.insert(key, std::unique_ptr<obj_t>(new obj_t(key))));
+    }
+  }
+  running = false;
+  for (auto& t : readers) {
+    t.join();
+  }
+
+  TESTASSERT(nof_errors == 0);
+  map.clear();
+  TESTASSERT(obj_t::count == 0);
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_rcu_map();
+  srsran::test_rcu_map_concurrent_readers();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
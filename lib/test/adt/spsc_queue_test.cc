@@ -0,0 +1,108 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/spsc_queue.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+
+namespace srsran {
+
+int test_spsc_queue_api()
+{
+  // The capacity is rounded up to a power of 2
+  spsc_queue<std::unique_ptr<int> > queue(3);
+  TESTASSERT(queue.max_size() == 4);
+  TESTASSERT(queue.empty() and not queue.full());
+
+  for (int i = 0; i < 4; ++i) {
+    TESTASSERT(queue.try_push(std::unique_ptr<int>(new int(i))).has_value());
+  }
+  TESTASSERT(queue.full() and queue.size() == 4);
+
+  // A rejected element is given back to the caller
+  srsran::error_type<std::unique_ptr<int> > ret = queue.try_push(std::unique_ptr<int>(new int(4)));
+  TESTASSERT(ret.is_error() and *ret.error() == 4);
+
+  std::unique_ptr<int> val;
+  for (int i = 0; i < 4; ++i) {
+    TESTASSERT(queue.try_pop(val) and *val == i);
+    // The ring wraps around
+    TESTASSERT(queue.try_push(std::unique_ptr<int>(new int(10 + i))).has_value());
+  }
+
+  // Batches are limited by the number of available elements and by the given maximum
+  int next = 10;
+  TESTASSERT(queue.pop_batch([&next](std::unique_ptr<int>&& v) { TESTASSERT(*v == next++); }, 3) == 3);
+  TESTASSERT(queue.pop_batch([&next](std::unique_ptr<int>&& v) { TESTASSERT(*v == next++); }) == 1);
+  TESTASSERT(queue.pop_batch([](std::unique_ptr<int>&&) {}) == 0);
+  TESTASSERT(queue.empty() and not queue.try_pop(val));
+
+  // Elements left in the queue are destroyed with it
+  TESTASSERT(queue.try_push(std::unique_ptr<int>(new int(1))).has_value());
+  return SRSRAN_SUCCESS;
+}
+
+/// One producer and one consumer exchanging values through a small queue, with single and batched pops
+int test_spsc_queue_concurrent()
+{
+  const uint32_t nof_values = 200000;
+
+  spsc_queue<uint32_t> queue(16);
+  std::thread          producer([&queue]() {
+    for (uint32_t i = 0; i < nof_values; ++i) {
+      while (queue.try_push(uint32_t{i}).is_error()) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint32_t expected = 0;
+  while (expected < nof_values) {
+    uint32_t val;
+    if (expected % 2 == 0) {
+      if (queue.try_pop(val)) {
+        TESTASSERT(val == expected);
+        expected++;
+      }
+    } else {
+      queue.pop_batch([&expected](uint32_t&& v) {
+        TESTASSERT(v == expected);
+        expected++;
+      });
+    }
+  }
+  producer.join();
+
+  TESTASSERT(queue.empty());
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  srsran::test_init(argc, argv);
+
+  TESTASSERT(srsran::test_spsc_queue_api() == SRSRAN_SUCCESS);
+  TESTASSERT(srsran::test_spsc_queue_concurrent() == SRSRAN_SUCCESS);
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
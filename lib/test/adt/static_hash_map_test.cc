@@ -0,0 +1,181 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/static_hash_map.h"
+#include "srsran/common/test_common.h"
+#include <map>
+#include <memory>
+#include <random>
+
+namespace srsran {
+
+void test_static_hash_map_basic()
+{
+  static_hash_map<uint16_t, std::string, 16> mymap;
+  TESTASSERT(mymap.size() == 0 and mymap.empty() and not mymap.full());
+  TESTASSERT(mymap.begin() == mymap.end());
+
+  TESTASSERT(not mymap.contains(70));
+  TESTASSERT(mymap.insert(70, "obj70"));
+  TESTASSERT(mymap.contains(70) and mymap[70] == "obj70");
+  TESTASSERT(not mymap.insert(70, "other"));
+  TESTASSERT(mymap[70] == "obj70");
+  TESTASSERT(not mymap.has_space(70) and mymap.has_space(71));
+
+  // TEST: keys that collide in a static_circular_map of the same size
+  for (uint16_t i = 1; i < 16; ++i) {
+    TESTASSERT(mymap.insert(70 + 16 * i, "obj" + std::to_string(70 + 16 * i)));
+  }
+  TESTASSERT(mymap.full() and not mymap.insert(1, "obj1"));
+  TESTASSERT(not mymap.has_space(1));
+  for (uint16_t i = 0; i < 16; ++i) {
+    TESTASSERT(mymap.find(70 + 16 * i) != mymap.end());
+    TESTASSERT(mymap.find(70 + 16 * i)->second == "obj" + std::to_string(70 + 16 * i));
+  }
+
+  // TEST: iteration follows the insertion order, when there were no erasures
+  uint16_t key = 70;
+  for (std::pair<uint16_t, std::string>& obj : mymap) {
+    TESTASSERT(obj.first == key);
+    key += 16;
+  }
+  const auto& cmap = mymap;
+  size_t      n    = 0;
+  for (const std::pair<uint16_t, std::string>& obj : cmap) {
+    TESTASSERT(cmap[obj.first] == obj.second);
+    n++;
+  }
+  TESTASSERT(n == 16);
+
+  // TEST: erasure while iterating
+  for (auto it = mymap.begin(); it != mymap.end();) {
+    if ((it->first / 16) % 2 == 0) {
+      it = mymap.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  TESTASSERT(mymap.size() == 8);
+  for (auto& obj : mymap) {
+    TESTASSERT((obj.first / 16) % 2 == 1);
+  }
+  TESTASSERT(not mymap.erase(70) and mymap.erase(86) and mymap.size() == 7);
+
+  mymap.overwrite(118, std::string("new118"));
+  TESTASSERT(mymap[118] == "new118" and mymap.size() == 7);
+
+  mymap.clear();
+  TESTASSERT(mymap.empty() and mymap.begin() == mymap.end() and not mymap.contains(118));
+}
+
+void test_static_hash_map_random()
+{
+  static_hash_map<uint32_t, uint32_t, 64> mymap;
+  std::map<uint32_t, uint32_t>            ref;
+  std::map<uint32_t, const uint32_t*>     addrs;
+  std::mt19937                            rgen(1);
+
+  for (uint32_t i = 0; i < 100000; ++i) {
+    // use a small key range, so that the erasures hit often
+    uint32_t key = rgen() % 128;
+    if (i % 1000 < 500) {
+      // RNTI-like range
+      key += 0x46;
+    } else {
+      // sparse keys
+      key *= 4096;
+    }
+    if (rgen() % 2 == 0) {
+      bool ret = mymap.insert(key, i);
+      TESTASSERT(ret == (ref.size() < 64 and ref.count(key) == 0));
+      if (ret) {
+        ref[key]   = i;
+        addrs[key] = &mymap[key];
+      }
+    } else {
+      TESTASSERT(mymap.erase(key) == (ref.erase(key) > 0));
+      addrs.erase(key);
+    }
+
+    TESTASSERT(mymap.size() == ref.size());
+    if (i % 64 == 0) {
+      for (auto& p : ref) {
+        TESTASSERT(mymap.contains(p.first) and mymap[p.first] == p.second);
+        // the objects do not move
+        TESTASSERT(&mymap[p.first] == addrs[p.first]);
+      }
+      size_t n = 0;
+      for (auto& p : mymap) {
+        TESTASSERT(ref.at(p.first) == p.second);
+        n++;
+      }
+      TESTASSERT(n == ref.size());
+    }
+  }
+}
+
+void test_static_hash_map_move()
+{
+  static_hash_map<uint16_t, std::unique_ptr<int>, 8> mymap;
+  for (int i = 0; i < 8; ++i) {
+    auto ret = mymap.insert(0x46 + i * 8, std::unique_ptr<int>(new int(i)));
+    TESTASSERT(ret.has_value());
+    TESTASSERT(*ret.value()->second == i);
+  }
+  auto ret = mymap.insert(0x100, std::unique_ptr<int>(new int(8)));
+  TESTASSERT(not ret.has_value() and *ret.error() == 8);
+
+  static_hash_map<uint16_t, std::unique_ptr<int>, 8> mymap2(std::move(mymap));
+  TESTASSERT(mymap.empty() and mymap2.size() == 8);
+  TESTASSERT(*mymap2[0x46 + 3 * 8] == 3);
+  mymap = std::move(mymap2);
+  TESTASSERT(mymap2.empty() and mymap.size() == 8);
+  for (int i = 0; i < 8; ++i) {
+    TESTASSERT(*mymap[0x46 + i * 8] == i);
+  }
+
+  static_hash_map<uint16_t, std::string, 4> strmap;
+  strmap.insert(1, "1");
+  strmap.insert(5, "5");
+  static_hash_map<uint16_t, std::string, 4> strmap2(strmap);
+  TESTASSERT(strmap2.size() == 2 and strmap2[5] == "5" and strmap[5] == "5");
+  strmap2.erase(1);
+  strmap2.insert(9, "9");
+  strmap = strmap2;
+  TESTASSERT(strmap.size() == 2 and not strmap.contains(1) and strmap[9] == "9");
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_static_hash_map_basic();
+  srsran::test_static_hash_map_random();
+  srsran::test_static_hash_map_move();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
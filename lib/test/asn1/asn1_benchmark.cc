@@ -0,0 +1,184 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/asn1/ngap.h"
+#include "srsran/asn1/rrc/dl_dcch_msg.h"
+#include "srsran/asn1/s1ap.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <getopt.h>
+#include <vector>
+
+using namespace asn1;
+
+/*
+ * Encode/decode benchmark of the PER codec, with messages exercising the different bit_ref paths: RRC packs mostly
+ * unaligned bit fields, while S1AP and NGAP are aligned and dominated by length determinants and octet strings.
+ */
+
+namespace {
+
+uint32_t nof_repetitions = 100000;
+
+// RRCConnectionReconfiguration with a full radio resource configuration, measurement config and NAS PDUs
+const uint8_t rrc_conn_recfg_msg[] = {
+    0x20, 0x16, 0x95, 0xa8, 0x00, 0x00, 0x05, 0x14, 0x3a, 0x00, 0x02, 0x90, 0x08, 0x78, 0xb0, 0x00, 0x00, 0x46, 0x62,
+    0x5a, 0x03, 0x59, 0x38, 0x00, 0x00, 0x00, 0x00, 0x08, 0x3a, 0x10, 0x0a, 0x48, 0xaa, 0x1a, 0x27, 0x80, 0x28, 0x00,
+    0x02, 0xa7, 0x82, 0x80, 0x00, 0x02, 0xa7, 0x83, 0x00, 0x00, 0x02, 0xa7, 0x84, 0x00, 0x00, 0x00, 0x01, 0xc2, 0x90,
+    0x0e, 0x08, 0x08, 0x48, 0xe0, 0x43, 0x4b, 0x73, 0xa3, 0x2b, 0x93, 0x73, 0x2b, 0xa0, 0x33, 0x6b, 0x73, 0x19, 0x81,
+    0x81, 0xb0, 0x33, 0x6b, 0x1b, 0x19, 0xa1, 0xa9, 0x80, 0x23, 0x3b, 0x83, 0x93, 0x98, 0x28, 0x08, 0xc8, 0x00, 0x53,
+    0x32, 0xf0, 0x37, 0xf7, 0xf7, 0xd7, 0xd7, 0xf7, 0xf2, 0xf8, 0x30, 0x27, 0xa1, 0x20, 0x27, 0xa1, 0x22, 0x80, 0x5f,
+    0xb2, 0xa7, 0x83, 0x04, 0x00, 0x00, 0x0f, 0x38, 0x90, 0x0f, 0x78, 0xb9, 0x62, 0xca, 0x4f, 0x53, 0x80, 0xdf, 0xb9,
+    0xc0, 0x32, 0x70, 0x02, 0xea, 0x03, 0xa0, 0x3b, 0x17, 0x93, 0x40, 0x0f, 0x40, 0x01, 0x08, 0x00, 0xd9, 0x80, 0x90,
+    0x16, 0xcd, 0xa8, 0x14, 0x1a, 0x00, 0x20, 0xc8, 0x28, 0x70, 0x00, 0xb0, 0x01, 0xef, 0xb0, 0x00, 0x24, 0xa0, 0x82,
+    0x12, 0x02, 0x05, 0x02, 0x4a, 0x04, 0xe3, 0xf0, 0xd0, 0x00, 0x00};
+
+// S1AP InitialContextSetupRequest with one E-RAB and an Attach Accept NAS PDU
+const uint8_t s1ap_init_ctxt_setup_msg[] = {
+    0x00, 0x09, 0x00, 0x80, 0xc6, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x02, 0x00, 0x64, 0x00, 0x08, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x42, 0x00, 0x0a, 0x18, 0x3b, 0x9a, 0xca, 0x00, 0x60, 0x3b, 0x9a, 0xca, 0x00, 0x00, 0x18, 0x00, 0x78,
+    0x00, 0x00, 0x34, 0x00, 0x73, 0x45, 0x00, 0x09, 0x3c, 0x0f, 0x80, 0x0a, 0x00, 0x21, 0xf0, 0xb7, 0x36, 0x1c, 0x56,
+    0x64, 0x27, 0x3e, 0x5b, 0x04, 0xb7, 0x02, 0x07, 0x42, 0x02, 0x3e, 0x06, 0x00, 0x09, 0xf1, 0x07, 0x00, 0x07, 0x00,
+    0x37, 0x52, 0x66, 0xc1, 0x01, 0x09, 0x1b, 0x07, 0x74, 0x65, 0x73, 0x74, 0x31, 0x32, 0x33, 0x06, 0x6d, 0x6e, 0x63,
+    0x30, 0x37, 0x30, 0x06, 0x6d, 0x63, 0x63, 0x39, 0x30, 0x31, 0x04, 0x67, 0x70, 0x72, 0x73, 0x05, 0x01, 0xc0, 0xa8,
+    0x03, 0x02, 0x27, 0x0e, 0x80, 0x80, 0x21, 0x0a, 0x03, 0x00, 0x00, 0x0a, 0x81, 0x06, 0x08, 0x08, 0x08, 0x08, 0x50,
+    0x0b, 0xf6, 0x09, 0xf1, 0x07, 0x80, 0x01, 0x01, 0xf6, 0x7e, 0x72, 0x69, 0x13, 0x09, 0xf1, 0x07, 0x00, 0x01, 0x23,
+    0x05, 0xf4, 0xf6, 0x7e, 0x72, 0x69, 0x00, 0x6b, 0x00, 0x05, 0x18, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x49, 0x00, 0x20,
+    0x45, 0x25, 0xe4, 0x9a, 0x77, 0xc8, 0xd5, 0xcf, 0x26, 0x33, 0x63, 0xeb, 0x5b, 0xb9, 0xc3, 0x43, 0x9b, 0x9e, 0xb3,
+    0x86, 0x1f, 0xa8, 0xa7, 0xcf, 0x43, 0x54, 0x07, 0xae, 0x42, 0x2b, 0x63, 0xb9};
+
+// NGAP PDUSessionResourceSetupRequest with one PDU session and a PDU Session Establishment Accept NAS PDU
+const uint8_t ngap_pdu_session_res_setup_msg[] = {
+    0x00, 0x1d, 0x00, 0x6c, 0x00, 0x00, 0x04, 0x00, 0x0a, 0x00, 0x02, 0x00, 0x01, 0x00, 0x55, 0x00, 0x02, 0x00, 0x01,
+    0x00, 0x26, 0x00, 0x2e, 0x2d, 0x7e, 0x00, 0x68, 0x01, 0x00, 0x25, 0x2e, 0x01, 0x00, 0xc2, 0x11, 0x00, 0x06, 0x01,
+    0x00, 0x03, 0x30, 0x01, 0x01, 0x06, 0x06, 0x03, 0xe8, 0x06, 0x03, 0xe8, 0x29, 0x05, 0x01, 0xc0, 0xa8, 0x0c, 0x7b,
+    0x25, 0x08, 0x07, 0x64, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x12, 0x01, 0x00, 0x4a, 0x00, 0x27, 0x00, 0x00, 0x01,
+    0x00, 0x00, 0x21, 0x00, 0x00, 0x03, 0x00, 0x8b, 0x00, 0x0a, 0x01, 0xf0, 0xc0, 0xa8, 0x11, 0xd2, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x86, 0x00, 0x01, 0x10, 0x00, 0x88, 0x00, 0x07, 0x00, 0x01, 0x00, 0x00, 0x09, 0x00, 0x00};
+
+void usage(char* prog)
+{
+  printf("Usage: %s [n]\n", prog);
+  printf("\t-n number of encode/decode repetitions per message [Default %d]\n", nof_repetitions);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_repetitions = (uint32_t)strtol(argv[optind], nullptr, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/// Decodes and re-encodes msg nof_repetitions times, checking that every encoding matches the first one. The decoding
+/// and destruction of the message is also measured with the dynamic fields allocated from the heap and from an arena
+template <typename PDU>
+int run_benchmark(const char* name, const uint8_t* msg, uint32_t msg_len)
+{
+  std::vector<uint8_t> buffer(msg_len + 64), ref_buffer(msg_len + 64);
+  PDU                  pdu;
+  uint64_t             decode_ns = 0, encode_ns = 0, heap_ns = 0, arena_ns = 0;
+  decode_arena         arena;
+  size_t               arena_bytes = 0;
+
+  // The reference encoding may differ from msg in the padding of non-canonical fields
+  cbit_ref ref_bref(msg, msg_len);
+  bit_ref  ref_bref2(ref_buffer.data(), ref_buffer.size());
+  TESTASSERT(pdu.unpack(ref_bref) == SRSASN_SUCCESS);
+  TESTASSERT(pdu.pack(ref_bref2) == SRSASN_SUCCESS);
+  int ref_len = ref_bref2.distance_bytes();
+
+  for (uint32_t i = 0; i < nof_repetitions; ++i) {
+    cbit_ref bref(msg, msg_len);
+    auto     tfree = std::chrono::steady_clock::now();
+    pdu            = PDU{};
+    auto t0        = std::chrono::steady_clock::now();
+    TESTASSERT(pdu.unpack(bref) == SRSASN_SUCCESS);
+    auto t1 = std::chrono::steady_clock::now();
+    TESTASSERT(bref.distance_bytes() == (int)msg_len);
+    heap_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - tfree).count();
+
+    bit_ref bref2(buffer.data(), buffer.size());
+    auto    t2 = std::chrono::steady_clock::now();
+    TESTASSERT(pdu.pack(bref2) == SRSASN_SUCCESS);
+    auto t3 = std::chrono::steady_clock::now();
+    TESTASSERT(bref2.distance_bytes() == ref_len);
+    TESTASSERT(memcmp(buffer.data(), ref_buffer.data(), ref_len) == 0);
+
+    // Decode into an arena, the PDU is destroyed and the arena reset before the next message
+    auto t4 = std::chrono::steady_clock::now();
+    {
+      PDU      arena_pdu;
+      cbit_ref bref3(msg, msg_len);
+      TESTASSERT(unpack_in_arena(arena_pdu, bref3, arena) == SRSASN_SUCCESS);
+      arena_bytes = arena.nof_bytes_allocated();
+    }
+    arena.reset();
+    auto t5 = std::chrono::steady_clock::now();
+
+    decode_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    encode_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(t3 - t2).count();
+    arena_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(t5 - t4).count();
+  }
+
+  printf("%-40s %4d bytes: decode %8.1f ns, encode %8.1f ns (%.1f/%.1f Mbps)\n",
+         name,
+         msg_len,
+         (double)decode_ns / nof_repetitions,
+         (double)encode_ns / nof_repetitions,
+         8.0 * msg_len * nof_repetitions / (decode_ns / 1e3),
+         8.0 * msg_len * nof_repetitions / (encode_ns / 1e3));
+  printf("%-40s %4zd bytes: decode and free %8.1f ns in arena, %8.1f ns in heap\n",
+         "",
+         arena_bytes,
+         (double)arena_ns / nof_repetitions,
+         (double)heap_ns / nof_repetitions);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::init();
+
+  TESTASSERT(run_benchmark<rrc::dl_dcch_msg_s>(
+                 "RRCConnectionReconfiguration", rrc_conn_recfg_msg, sizeof(rrc_conn_recfg_msg)) == SRSRAN_SUCCESS);
+  TESTASSERT(run_benchmark<s1ap::s1ap_pdu_c>("S1AP InitialContextSetupRequest",
+                                             s1ap_init_ctxt_setup_msg,
+                                             sizeof(s1ap_init_ctxt_setup_msg)) == SRSRAN_SUCCESS);
+  TESTASSERT(run_benchmark<ngap::ngap_pdu_c>("NGAP PDUSessionResourceSetupRequest",
+                                             ngap_pdu_session_res_setup_msg,
+                                             sizeof(ngap_pdu_session_res_setup_msg)) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  return SRSRAN_SUCCESS;
+}
@@ -527,6 +527,76 @@ int test_copy_ptr()
   return 0;
 }
 
+int test_decode_arena()
+{
+  typedef dyn_array<uint32_t> TestType;
+
+  static_decode_arena<256> arena(512);
+  auto                     in_storage = [&arena](const void* p) {
+    return p >= (const void*)&arena and p < (const void*)(&arena + 1);
+  };
+
+  {
+    dyn_array<uint32_t>                vec;
+    ext_array<uint16_t>                ext_vec;
+    copy_ptr<TestType>                 cptr;
+    std::unique_ptr<dyn_array<double>> vec_chunk;
+    {
+      arena_scope scope(arena);
+      TESTASSERT(arena_scope::active() == &arena);
+      vec.resize(10);
+      ext_vec.resize(40);
+      cptr.set_present();
+      cptr->resize(4);
+      (*cptr)[3] = 3;
+      for (uint32_t i = 0; i < vec.size(); ++i) {
+        vec[i] = i;
+      }
+      // does not fit in the arena storage, so it is allocated from a heap chunk of the arena
+      vec_chunk.reset(new dyn_array<double>(100));
+    }
+    TESTASSERT(arena_scope::active() == nullptr);
+    TESTASSERT(in_storage(vec.data()));
+    TESTASSERT(in_storage(ext_vec.data()));
+    TESTASSERT(in_storage(cptr.get()));
+    TESTASSERT(in_storage(cptr->data()));
+    TESTASSERT(not in_storage(vec_chunk->data()));
+    TESTASSERT(arena.nof_heap_chunks() == 1);
+    TESTASSERT(arena.nof_bytes_allocated() >=
+               10 * sizeof(uint32_t) + 45 * sizeof(uint16_t) + sizeof(TestType) + 100 * sizeof(double));
+
+    // Copies outside of the scope, and fields grown outside of it, are allocated from the heap
+    dyn_array<uint32_t> vec2  = vec;
+    copy_ptr<TestType>  cptr2 = cptr;
+    TESTASSERT(not in_storage(vec2.data()) and vec2 == vec);
+    TESTASSERT(not in_storage(cptr2.get()) and *cptr2 == *cptr);
+    size_t nof_bytes = arena.nof_bytes_allocated();
+    vec.resize(20);
+    TESTASSERT(not in_storage(vec.data()) and vec[9] == 9);
+    TESTASSERT(arena.nof_bytes_allocated() == nof_bytes);
+
+    // the released object is owned by the caller
+    TestType* released = cptr.release();
+    TESTASSERT(not in_storage(released) and (*released)[3] == 3);
+    delete released;
+  }
+
+  // The memory is reused after a reset
+  arena.reset();
+  TESTASSERT(arena.nof_bytes_allocated() == 0);
+  {
+    arena_scope         scope(arena);
+    dyn_array<uint8_t>  vec(100);
+    dyn_array<double>   vec2(100);
+    TESTASSERT(in_storage(vec.data()));
+    TESTASSERT(arena.nof_heap_chunks() == 1);
+    dyn_array<uint32_t> vec3(256);
+    TESTASSERT(arena.nof_heap_chunks() == 2);
+  }
+
+  return 0;
+}
+
 class EnumTest
 {
 public:
@@ -694,6 +764,7 @@ int main()
   TESTASSERT(test_bitstring() == 0);
   TESTASSERT(test_seq_of() == 0);
   TESTASSERT(test_copy_ptr() == 0);
+  TESTASSERT(test_decode_arena() == 0);
   TESTASSERT(test_enum() == 0);
   TESTASSERT(test_big_integers() == 0);
   test_varlength_field_pack();
@@ -20,6 +20,7 @@
  */
 
 #include "srsran/asn1/ngap.h"
+#include "srsran/asn1/ngap_utils.h"
 #include "srsran/common/test_common.h"
 
 using namespace asn1;
@@ -258,6 +259,34 @@ int test_dl_nas_transport2()
   return 0;
 }
 
+int test_peek_pdu()
+{
+  uint8_t ngap_msg[] = {0x00, 0x04, 0x40, 0x42, 0x00, 0x00, 0x03, 0x00, 0x0a, 0x00, 0x06, 0x80, 0x03, 0x03,
+                        0xcf, 0x37, 0xd0, 0x00, 0x55, 0x00, 0x02, 0x00, 0x01, 0x00, 0x26, 0x00, 0x2b, 0x2a,
+                        0x7e, 0x00, 0x56, 0x00, 0x02, 0x00, 0x00, 0x21, 0xbc, 0x8d, 0xe5, 0x61, 0xf5, 0xb4,
+                        0xa7, 0x05, 0x8f, 0xdb, 0xe2, 0x3b, 0x4e, 0x21, 0xda, 0x45, 0x20, 0x10, 0x5a, 0xb8,
+                        0xd1, 0xdb, 0x13, 0x76, 0x80, 0x00, 0x1b, 0x1a, 0x8d, 0x3c, 0x98, 0x4c, 0x01, 0x06};
+
+  ngap_pdu_peek_t peek;
+  TESTASSERT(peek_ngap_pdu(peek, ngap_msg, sizeof(ngap_msg)) == SRSASN_SUCCESS);
+  TESTASSERT(peek.pdu_type == ngap_pdu_c::types_opts::init_msg);
+  TESTASSERT(peek.proc_code == ASN1_NGAP_ID_DL_NAS_TRANSPORT);
+  TESTASSERT(peek.nof_ies == 3);
+  TESTASSERT(peek.amf_ue_ngap_id_present);
+  TESTASSERT_EQ(12948813776, peek.amf_ue_ngap_id);
+  TESTASSERT(peek.ran_ue_ngap_id_present and peek.ran_ue_ngap_id == 1);
+
+  const protocol_ie_ref_t* ie = peek.find_ie(ASN1_NGAP_ID_NAS_PDU);
+  TESTASSERT(ie != nullptr);
+  unbounded_octstring<true> nas_pdu;
+  TESTASSERT(unpack_ie_value(nas_pdu, *ie) == SRSASN_SUCCESS);
+  TESTASSERT(nas_pdu.size() == 42);
+  TESTASSERT(nas_pdu[0] == 0x7e);
+
+  TESTASSERT(peek_ngap_pdu(peek, ngap_msg, sizeof(ngap_msg) - 1) != SRSASN_SUCCESS);
+  return 0;
+}
+
 int test_ul_ran_status_transfer()
 {
   uint8_t ngap_msg[] = {0x00, 0x2e, 0x40, 0x3c, 0x00, 0x00, 0x04, 0x00, 0x0a, 0x00, 0x02, 0x00, 0x01, 0x00, 0x55, 0x00,
@@ -389,6 +418,7 @@ int main()
   test_init_ue_msg();
   test_dl_nas_transport();
   test_dl_nas_transport2();
+  test_peek_pdu();
   test_ul_ran_status_transfer();
   test_ue_context_release();
   test_ue_context_release_complete();
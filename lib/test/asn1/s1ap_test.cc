@@ -20,6 +20,7 @@
  */
 
 #include "srsran/asn1/s1ap.h"
+#include "srsran/asn1/s1ap_utils.h"
 #include "srsran/common/test_common.h"
 #include <arpa/inet.h>
 #include <sys/socket.h>
@@ -119,6 +120,35 @@ int test_ue_ctxt_release_req()
   return SRSRAN_SUCCESS;
 }
 
+int test_peek_pdu()
+{
+  uint8_t s1ap_msg[] = {0x00, 0x12, 0x40, 0x15, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x02, 0x00, 0x01,
+                        0x00, 0x08, 0x00, 0x02, 0x00, 0x01, 0x00, 0x02, 0x40, 0x02, 0x02, 0x80};
+
+  s1ap_pdu_peek_t peek;
+  TESTASSERT(peek_s1ap_pdu(peek, s1ap_msg, sizeof(s1ap_msg)) == SRSASN_SUCCESS);
+  TESTASSERT(peek.pdu_type == s1ap_pdu_c::types_opts::init_msg);
+  TESTASSERT(peek.proc_code == ASN1_S1AP_ID_UE_CONTEXT_RELEASE_REQUEST);
+  TESTASSERT(peek.nof_ies == 3);
+  TESTASSERT(peek.mme_ue_s1ap_id_present and peek.mme_ue_s1ap_id == 1);
+  TESTASSERT(peek.enb_ue_s1ap_id_present and peek.enb_ue_s1ap_id == 1);
+
+  // The deferred IEs decode to the same values as in the full unpack
+  const protocol_ie_ref_t* ie = peek.find_ie(ASN1_S1AP_ID_CAUSE);
+  TESTASSERT(ie != nullptr);
+  cause_c cause;
+  TESTASSERT(unpack_ie_value(cause, *ie) == SRSASN_SUCCESS);
+  TESTASSERT(cause.type().value == cause_c::types_opts::radio_network);
+  TESTASSERT(cause.radio_network().value == cause_radio_network_opts::user_inactivity);
+  TESTASSERT(peek.find_ie(ASN1_S1AP_ID_NAS_PDU) == nullptr);
+
+  // Truncated PDUs are rejected
+  TESTASSERT(peek_s1ap_pdu(peek, s1ap_msg, sizeof(s1ap_msg) - 1) != SRSASN_SUCCESS);
+  TESTASSERT(peek_s1ap_pdu(peek, s1ap_msg, 3) != SRSASN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
+
 template <typename T, typename U>
 bool is_same_type(U& u)
 {
@@ -389,6 +419,7 @@ int main()
   TESTASSERT(test_s1setup_request() == 0);
   TESTASSERT(test_init_ctxt_setup_req() == 0);
   TESTASSERT(test_ue_ctxt_release_req() == 0);
+  TESTASSERT(test_peek_pdu() == 0);
   TESTASSERT(test_proc_id_consistency(*spy) == 0);
   TESTASSERT(test_ho_request() == 0);
   TESTASSERT(test_enb_status_transfer() == 0);
@@ -0,0 +1,126 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/byte_buffer_chain.h"
+#include "srsran/common/test_common.h"
+
+using namespace srsran;
+
+shared_byte_buffer_t make_test_buffer(uint32_t len, uint8_t first_val)
+{
+  shared_byte_buffer_t buf = make_byte_buffer();
+  TESTASSERT(buf != nullptr);
+  for (uint32_t i = 0; i < len; ++i) {
+    buf->msg[i] = first_val + i;
+  }
+  buf->N_bytes = len;
+  return buf;
+}
+
+int test_slices_keep_buffer_alive()
+{
+  byte_buffer_chain<4> chain;
+  {
+    shared_byte_buffer_t sdu = make_test_buffer(100, 0);
+    chain.append(byte_buffer_slice(sdu, sdu->msg, 40));
+    sdu->msg += 40;
+    sdu->N_bytes -= 40;
+    chain.append(byte_buffer_slice(sdu, sdu->msg, 60));
+    TESTASSERT(sdu.use_count() == 3);
+  }
+  TESTASSERT(chain.nof_slices() == 2);
+  TESTASSERT(chain.length() == 100);
+
+  std::array<uint8_t, 100> out = {};
+  TESTASSERT(chain.copy_to(out.data()) == 100);
+  for (uint32_t i = 0; i < out.size(); ++i) {
+    TESTASSERT(out[i] == i);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_partial_copy()
+{
+  byte_buffer_chain<4> chain;
+  shared_byte_buffer_t a = make_test_buffer(10, 0);
+  shared_byte_buffer_t b = make_test_buffer(20, 10);
+  chain.append(byte_buffer_slice(a, a->msg, a->N_bytes));
+  chain.append(byte_buffer_slice(b, b->msg, b->N_bytes));
+
+  // range spanning both slices
+  std::array<uint8_t, 30> out = {};
+  TESTASSERT(chain.copy_to(out.data(), 5, 10) == 10);
+  for (uint32_t i = 0; i < 10; ++i) {
+    TESTASSERT(out[i] == 5 + i);
+  }
+  // range past the end of the chain
+  TESTASSERT(chain.copy_to(out.data(), 25, 10) == 5);
+  TESTASSERT(out[0] == 25 and out[4] == 29);
+  return SRSRAN_SUCCESS;
+}
+
+int test_copies_fill_last_slice()
+{
+  byte_buffer_chain<2>     chain;
+  shared_byte_buffer_t     a = make_test_buffer(8, 0);
+  std::array<uint8_t, 200> src;
+  for (uint32_t i = 0; i < src.size(); ++i) {
+    src[i] = 8 + i;
+  }
+
+  chain.append(byte_buffer_slice(a, a->msg, a->N_bytes));
+  TESTASSERT(chain.reserve_copy(100));
+  TESTASSERT(chain.full());
+  TESTASSERT(chain.append_copy(src.data(), 100));
+  TESTASSERT(chain.append_copy(src.data() + 100, 100));
+  TESTASSERT(chain.nof_slices() == 2);
+  TESTASSERT(chain.length() == 208);
+
+  // no room left for another referenced slice
+  shared_byte_buffer_t b = make_test_buffer(8, 0);
+  byte_buffer_chain<2> chain2;
+  chain2.append(byte_buffer_slice(b, b->msg, 4));
+  chain2.append(byte_buffer_slice(b, b->msg + 4, 4));
+  TESTASSERT(not chain2.append_copy(src.data(), 1));
+
+  std::array<uint8_t, 208> out = {};
+  TESTASSERT(chain.copy_to(out.data()) == out.size());
+  for (uint32_t i = 0; i < out.size(); ++i) {
+    TESTASSERT(out[i] == (uint8_t)i);
+  }
+
+  // a moved chain keeps the slices
+  byte_buffer_chain<2> moved(std::move(chain));
+  TESTASSERT(chain.empty() and chain.nof_slices() == 0);
+  TESTASSERT(moved.length() == 208);
+  moved.clear();
+  TESTASSERT(moved.empty() and a.use_count() == 1);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_slices_keep_buffer_alive() == SRSRAN_SUCCESS);
+  TESTASSERT(test_partial_copy() == SRSRAN_SUCCESS);
+  TESTASSERT(test_copies_fill_last_slice() == SRSRAN_SUCCESS);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
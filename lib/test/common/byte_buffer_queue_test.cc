@@ -80,7 +80,67 @@ int test_concurrent_writeread()
   return result;
 }
 
+int test_capacity_and_discard()
+{
+  byte_buffer_queue q(4);
+
+  for (uint32_t i = 0; i < 4; i++) {
+    unique_byte_buffer_t b = srsran::make_byte_buffer();
+    b->N_bytes             = 10 + i;
+    b->md.pdcp_sn          = i;
+    if (not q.try_write(std::move(b))) {
+      printf("Failed to write SDU %d\n", i);
+      return -1;
+    }
+  }
+
+  // The queue is full, the SDU is handed back
+  unique_byte_buffer_t b = srsran::make_byte_buffer();
+  b->N_bytes             = 100;
+  srsran::error_type<unique_byte_buffer_t> ret = q.try_write(std::move(b));
+  if (ret or ret.error() == nullptr or ret.error()->N_bytes != 100 or not q.is_full()) {
+    printf("Write to full queue did not fail\n");
+    return -1;
+  }
+  if (q.size() != 4 or q.get_n_sdus() != 4 or q.size_bytes() != 46 or q.size_tail_bytes() != 10) {
+    printf("Wrong queue state after writes\n");
+    return -1;
+  }
+
+  // Discard the SDU with PDCP SN 1, its slot stays in the queue as nullptr
+  bool discarded = q.apply_first([](unique_byte_buffer_t& sdu) {
+    if (sdu != nullptr && sdu->md.pdcp_sn == 1) {
+      sdu = nullptr;
+      return true;
+    }
+    return false;
+  });
+  if (not discarded or q.size() != 4 or q.get_n_sdus() != 3 or q.size_bytes() != 35) {
+    printf("Wrong queue state after discard\n");
+    return -1;
+  }
+
+  uint32_t expected_sn[] = {0, 1, 2, 3};
+  for (uint32_t i = 0; i < 4; i++) {
+    b = q.read();
+    if ((i == 1) != (b == nullptr) or (b != nullptr and b->md.pdcp_sn != expected_sn[i])) {
+      printf("Wrong SDU read at position %d\n", i);
+      return -1;
+    }
+  }
+  if (not q.is_empty() or q.try_read(&b) or q.get_n_sdus() != 0 or q.size_bytes() != 0) {
+    printf("Queue not empty after reads\n");
+    return -1;
+  }
+
+  printf("Passed\n");
+  return 0;
+}
+
 int main()
 {
+  if (test_capacity_and_discard() != 0) {
+    return -1;
+  }
   return test_concurrent_writeread();
 }
@@ -0,0 +1,161 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/mac_pcap.h"
+#include "srsran/common/test_common.h"
+#include <unistd.h>
+
+using namespace srsran;
+
+static const char* pcap_filename = "mac_pcap_test.pcap";
+
+// EUTRA MAC PDU with SDUs of LCID 1 and 2 followed by padding
+static std::array<uint8_t, 32> tv = {0x21, 0x08, 0x22, 0x80, 0x0a, 0x1f, 0x01, 0x01, 0x01, 0x01, 0x01,
+                                     0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+                                     0x02, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+// EUTRA MAC PDU with a single SDU of LCID 3
+static std::array<uint8_t, 8> tv_lcid3 = {0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03};
+
+struct record_t {
+  uint32_t incl_len;
+  uint32_t orig_len;
+};
+
+/// Returns the length of the records written to the PCAP file, and removes it
+static std::vector<record_t> read_records()
+{
+  std::vector<record_t> records;
+  FILE*                 f = fopen(pcap_filename, "r");
+  TESTASSERT(f != nullptr);
+  pcap_hdr_t file_header;
+  TESTASSERT(fread(&file_header, sizeof(file_header), 1, f) == 1);
+  pcaprec_hdr_t rec_header;
+  while (fread(&rec_header, sizeof(rec_header), 1, f) == 1) {
+    records.push_back({rec_header.incl_len, rec_header.orig_len});
+    TESTASSERT(fseek(f, rec_header.incl_len, SEEK_CUR) == 0);
+  }
+  fclose(f);
+  unlink(pcap_filename);
+  return records;
+}
+
+void test_no_filter()
+{
+  mac_pcap pcap;
+  TESTASSERT(pcap.open(pcap_filename) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i != 10; ++i) {
+    pcap.write_dl_crnti(tv.data(), tv.size(), 0x46, true, i, 0);
+  }
+  pcap.close();
+
+  std::vector<record_t> records = read_records();
+  TESTASSERT(records.size() == 10);
+  TESTASSERT(records[0].incl_len == records[0].orig_len);
+  TESTASSERT(records[0].incl_len > tv.size());
+}
+
+void test_rnti_filter()
+{
+  mac_pcap_filter_t filter;
+  filter.rntis = {0x46, 0x48};
+  mac_pcap pcap;
+  pcap.set_filter(filter);
+  TESTASSERT(pcap.open(pcap_filename) == SRSRAN_SUCCESS);
+  for (uint16_t rnti = 0x46; rnti != 0x4a; ++rnti) {
+    pcap.write_dl_crnti(tv.data(), tv.size(), rnti, true, 0, 0);
+    pcap.write_ul_crnti(tv.data(), tv.size(), rnti, 0, 0, 0);
+  }
+  pcap.close();
+
+  TESTASSERT(read_records().size() == 4);
+}
+
+void test_lcid_filter()
+{
+  mac_pcap_filter_t filter;
+  filter.lcids = {2};
+  mac_pcap pcap;
+  pcap.set_filter(filter);
+  TESTASSERT(pcap.open(pcap_filename) == SRSRAN_SUCCESS);
+  pcap.write_dl_crnti(tv.data(), tv.size(), 0x46, true, 0, 0);
+  pcap.write_dl_crnti(tv_lcid3.data(), tv_lcid3.size(), 0x46, true, 0, 0);
+  pcap.close();
+
+  std::vector<record_t> records = read_records();
+  TESTASSERT(records.size() == 1);
+  TESTASSERT(records[0].orig_len > tv.size());
+
+  // The padding subheader follows the F/L fields of both SDUs
+  filter.lcids = {31};
+  pcap.set_filter(filter);
+  TESTASSERT(pcap.open(pcap_filename) == SRSRAN_SUCCESS);
+  pcap.write_dl_crnti(tv.data(), tv.size(), 0x46, true, 0, 0);
+  pcap.write_dl_crnti(tv_lcid3.data(), tv_lcid3.size(), 0x46, true, 0, 0);
+  pcap.close();
+  TESTASSERT(read_records().size() == 1);
+}
+
+void test_crc_and_sampling()
+{
+  mac_pcap_filter_t filter;
+  filter.crc_fail_only = true;
+  filter.sample_rate   = 4;
+  mac_pcap pcap;
+  pcap.set_filter(filter);
+  TESTASSERT(pcap.open(pcap_filename) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i != 100; ++i) {
+    pcap.write_dl_crnti(tv.data(), tv.size(), 0x46, false, 0, 0);
+    pcap.write_dl_crnti(tv.data(), tv.size(), 0x46, true, 0, 0);
+  }
+  pcap.close();
+
+  TESTASSERT(read_records().size() == 25);
+}
+
+void test_truncation()
+{
+  mac_pcap_filter_t filter;
+  filter.snap_len = 6;
+  mac_pcap pcap;
+  pcap.set_filter(filter);
+  TESTASSERT(pcap.open(pcap_filename) == SRSRAN_SUCCESS);
+  pcap.write_dl_crnti(tv.data(), tv.size(), 0x46, true, 0, 0);
+  pcap.write_dl_crnti(tv_lcid3.data(), tv_lcid3.size(), 0x46, true, 0, 0);
+  pcap.close();
+
+  // Only the first bytes are captured, the record keeps the original length
+  std::vector<record_t> records = read_records();
+  TESTASSERT(records.size() == 2);
+  TESTASSERT(records[0].orig_len - records[0].incl_len == tv.size() - 6);
+  TESTASSERT(records[1].orig_len - records[1].incl_len == tv_lcid3.size() - 6);
+}
+
+int main()
+{
+  srslog::init();
+  test_no_filter();
+  test_rnti_filter();
+  test_lcid_filter();
+  test_crc_and_sampling();
+  test_truncation();
+  return 0;
+}
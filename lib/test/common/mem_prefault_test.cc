@@ -0,0 +1,109 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/pool/pool_registry.h"
+#include "srsran/common/mem_prefault.h"
+#include "srsran/common/test_common.h"
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace srsran;
+
+static size_t page_size()
+{
+  return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+/// Returns the number of resident pages of a mapping
+static size_t nof_resident_pages(void* ptr, size_t len)
+{
+  std::vector<unsigned char> vec((len + page_size() - 1) / page_size());
+  if (mincore(ptr, len, vec.data()) != 0) {
+    return 0;
+  }
+  size_t count = 0;
+  for (unsigned char v : vec) {
+    count += v & 1U;
+  }
+  return count;
+}
+
+int test_prefault_mapping()
+{
+  const size_t nof_pages = 64;
+  size_t       len       = nof_pages * page_size();
+  void*        ptr       = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  TESTASSERT(ptr != MAP_FAILED);
+  uint8_t* bytes = static_cast<uint8_t*>(ptr);
+  TESTASSERT(nof_resident_pages(ptr, len) == 0);
+
+  // The contents of the pages already written are kept
+  bytes[0]             = 0x5a;
+  bytes[page_size()]   = 0xa5;
+  bytes[len - 1]       = 0x11;
+  size_t nof_populated = mem_prefault(bytes + 10, len - 20);
+  TESTASSERT(nof_populated == len);
+  TESTASSERT(nof_resident_pages(ptr, len) == nof_pages);
+  TESTASSERT(bytes[0] == 0x5a and bytes[page_size()] == 0xa5 and bytes[len - 1] == 0x11);
+  TESTASSERT(bytes[2 * page_size()] == 0);
+
+  TESTASSERT(mem_prefault(nullptr, len) == 0);
+  TESTASSERT(mem_prefault(ptr, 0) == 0);
+
+  munmap(ptr, len);
+  return SRSRAN_SUCCESS;
+}
+
+int test_pool_registry_prefault()
+{
+  const size_t len = 16 * page_size();
+  void*        ptr = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  TESTASSERT(ptr != MAP_FAILED);
+  {
+    pool_stats stats("test_prefault_pool", page_size(), 16);
+    stats.set_memory(ptr, len);
+    TESTASSERT(pool_registry::get().prefault() >= len);
+    TESTASSERT(nof_resident_pages(ptr, len) == 16);
+  }
+  munmap(ptr, len);
+  return SRSRAN_SUCCESS;
+}
+
+int test_reserve_heap()
+{
+  TESTASSERT(mem_reserve_heap(0) == 0);
+  TESTASSERT(mem_reserve_heap(8 * 1024 * 1024) == 8 * 1024 * 1024);
+
+  // Large blocks are now served from the reserved heap
+  std::vector<uint8_t> buffer(4 * 1024 * 1024, 1);
+  TESTASSERT(buffer.back() == 1);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_prefault_mapping() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pool_registry_prefault() == SRSRAN_SUCCESS);
+  TESTASSERT(test_reserve_heap() == SRSRAN_SUCCESS);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
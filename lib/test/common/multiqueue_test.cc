@@ -23,6 +23,7 @@
 #include "srsran/common/multiqueue.h"
 #include "srsran/common/test_common.h"
 #include "srsran/common/thread_pool.h"
+#include <array>
 #include <iostream>
 #include <map>
 #include <random>
@@ -306,6 +307,59 @@ int test_multiqueue_threading4()
   return 0;
 }
 
+int test_multiqueue_threading5()
+{
+  std::cout << "\n===== TEST multiqueue threading test 5: start =====\n";
+  // Description: several producers push concurrently into the same port and into their own ports, with a small
+  //              capacity so that they block. Every item is popped once, and in order for each producer and port
+
+  int                             capacity = 16, nof_producers = 4, nof_pushes = 20000;
+  multiqueue_handler<int>         multiqueue(capacity);
+  auto                            shared_q = multiqueue.add_queue();
+  std::vector<queue_handle<int> > own_q;
+  for (int p = 0; p < nof_producers; ++p) {
+    own_q.push_back(multiqueue.add_queue());
+  }
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < nof_producers; ++p) {
+    producers.emplace_back([&shared_q, &own_q, p, nof_pushes]() {
+      for (int i = 0; i < nof_pushes; ++i) {
+        // the producer id goes in the lower bits
+        if (i % 2 == 0) {
+          shared_q.push(i * 8 + p);
+        } else {
+          own_q[p].push(i * 8 + p);
+        }
+      }
+    });
+  }
+
+  // last item popped of each producer, for the shared and own ports
+  std::vector<std::array<int, 2> > last(nof_producers, {-2, -1});
+  int                              number = 0;
+  for (int n = 0; n < nof_producers * nof_pushes; ++n) {
+    TESTASSERT(multiqueue.wait_pop(&number));
+    int p = number % 8, i = number / 8;
+    TESTASSERT(p < nof_producers and i == last[p][i % 2] + 2);
+    last[p][i % 2] = i;
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  TESTASSERT(not multiqueue.try_pop(&number));
+  for (int p = 0; p < nof_producers; ++p) {
+    TESTASSERT(last[p][0] == nof_pushes - 2 and last[p][1] == nof_pushes - 1);
+  }
+
+  multiqueue.stop();
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+
+  return 0;
+}
+
 int test_task_thread_pool()
 {
   std::cout << "\n====== TEST task thread pool test 1: start ======\n";
@@ -410,6 +464,113 @@ int test_task_thread_pool3()
   return 0;
 }
 
+int test_task_thread_pool_parallel_for()
+{
+  std::cout << "\n====== TEST task thread pool parallel for: start ======\n";
+  // Description: every index is run exactly once and parallel_for only returns when all of them have finished
+
+  uint32_t nof_workers = 4, nof_tasks = 8, nof_runs = 1000;
+
+  task_thread_pool thread_pool(nof_workers);
+
+  std::vector<std::atomic<uint32_t> > count(nof_tasks);
+  auto task = [](void* arg, uint32_t idx) {
+    std::this_thread::sleep_for(std::chrono::microseconds{10});
+    (*static_cast<std::vector<std::atomic<uint32_t> >*>(arg))[idx]++;
+  };
+
+  for (uint32_t run = 0; run < nof_runs; ++run) {
+    thread_pool.parallel_for(nof_tasks, task, &count);
+    for (uint32_t i = 0; i < nof_tasks; ++i) {
+      TESTASSERT(count[i] == run + 1);
+    }
+  }
+
+  // A stopped pool runs every index in the calling thread
+  thread_pool.stop();
+  thread_pool.parallel_for(nof_tasks, task, &count);
+  for (uint32_t i = 0; i < nof_tasks; ++i) {
+    TESTASSERT(count[i] == nof_runs + 1);
+  }
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+  return 0;
+}
+
+int test_task_thread_pool_priorities()
+{
+  std::cout << "\n====== TEST task thread pool priorities: start ======\n";
+  // Description: the high priority tasks are run before the normal priority ones pushed earlier
+
+  using task_priority = task_thread_pool::task_priority;
+  std::vector<int> order;
+
+  task_thread_pool thread_pool(1, true);
+  for (int i = 0; i < 4; ++i) {
+    thread_pool.push_task([&order, i]() { order.push_back(i); }, task_priority::normal);
+  }
+  for (int i = 4; i < 8; ++i) {
+    thread_pool.push_task([&order, i]() { order.push_back(i); }, task_priority::high);
+  }
+  TESTASSERT(thread_pool.nof_pending_tasks() == 8);
+  thread_pool.start();
+  while (thread_pool.nof_pending_tasks() > 0) {
+    usleep(100);
+  }
+  thread_pool.stop();
+
+  std::vector<int> expected = {4, 5, 6, 7, 0, 1, 2, 3};
+  TESTASSERT(order == expected);
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+  return 0;
+}
+
+int test_task_thread_pool_stealing()
+{
+  std::cout << "\n====== TEST task thread pool work stealing: start ======\n";
+  // Description: the tasks pushed by a worker go to its own queue, and are stolen by the idle workers
+
+  uint32_t              nof_workers = 16, nof_tasks = 4000;
+  std::atomic<uint32_t> count{0};
+
+  task_thread_pool thread_pool(nof_workers);
+
+  thread_pool.push_task([&thread_pool, &count, nof_tasks]() {
+    for (uint32_t i = 0; i < nof_tasks; ++i) {
+      thread_pool.push_task([&count]() {
+        std::this_thread::sleep_for(std::chrono::microseconds{10});
+        count++;
+      });
+    }
+  });
+  while (count != nof_tasks) {
+    usleep(100);
+  }
+
+  task_thread_pool::metrics_t metrics;
+  thread_pool.get_metrics(metrics);
+  TESTASSERT(metrics.workers.size() == nof_workers);
+  TESTASSERT(metrics.nof_pending_tasks == 0);
+  TESTASSERT(metrics.max_pending_tasks > 0);
+  uint64_t nof_run = 0, nof_steals = 0;
+  for (auto& w : metrics.workers) {
+    nof_run += w.nof_tasks;
+    nof_steals += w.nof_steals;
+  }
+  std::cout << "tasks=" << nof_run << " steals=" << nof_steals << " max_pending=" << metrics.max_pending_tasks << "\n";
+  TESTASSERT(nof_steals > 0);
+  TESTASSERT(nof_run <= nof_tasks + 1);
+
+  thread_pool.stop();
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+  return 0;
+}
+
 struct C {
   std::unique_ptr<int> val{new int{5}};
 };
@@ -492,6 +653,67 @@ int test_inplace_task()
   return 0;
 }
 
+int test_task_spill_pool()
+{
+  std::cout << "\n======= TEST task spill pool: start =======\n";
+  // Description: the tasks that do not fit the small buffer reuse the pooled memory of the destroyed tasks, also when
+  //              they are created and destroyed in different threads
+
+  D                           d;
+  int                         v         = 0;
+  uint32_t                    nof_tasks = 100;
+  detail::callback_pool_stats stats0    = get_move_callback_stats();
+
+  std::vector<move_callback<void()> > tasks;
+  for (uint32_t i = 0; i < nof_tasks; ++i) {
+    tasks.emplace_back([&v, d]() { v += d.big_val[0]; });
+    TESTASSERT(not tasks.back().is_in_small_buffer());
+  }
+  tasks.clear();
+  detail::callback_pool_stats stats1 = get_move_callback_stats();
+  TESTASSERT(stats1.nof_spills == stats0.nof_spills + nof_tasks);
+
+  // The second round is served by the pool
+  for (uint32_t i = 0; i < nof_tasks; ++i) {
+    tasks.emplace_back([&v, d]() { v += d.big_val[0]; });
+  }
+  tasks.clear();
+  detail::callback_pool_stats stats2 = get_move_callback_stats();
+  TESTASSERT(stats2.nof_spills == stats1.nof_spills + nof_tasks);
+  TESTASSERT(stats2.nof_heap_allocs == stats1.nof_heap_allocs);
+
+  // Tasks created in a producer thread and destroyed by the consumer
+  multiqueue_handler<move_callback<void()> > multiqueue;
+  auto                                       qid       = multiqueue.add_queue();
+  auto                                       run_round = [&]() {
+    std::thread t([&]() {
+      for (uint32_t i = 0; i < 10 * nof_tasks; ++i) {
+        qid.push(move_callback<void()>{[&v, d]() { v += d.big_val[0]; }});
+      }
+    });
+    move_callback<void()> task;
+    for (uint32_t i = 0; i < 10 * nof_tasks; ++i) {
+      TESTASSERT(multiqueue.wait_pop(&task));
+      task();
+      task = {};
+    }
+    t.join();
+  };
+  run_round();
+  detail::callback_pool_stats stats3 = get_move_callback_stats();
+  run_round();
+  detail::callback_pool_stats stats4 = get_move_callback_stats();
+  std::cout << "heap allocations: first round=" << stats3.nof_heap_allocs - stats2.nof_heap_allocs
+            << ", second round=" << stats4.nof_heap_allocs - stats3.nof_heap_allocs << "\n";
+  TESTASSERT(stats4.nof_heap_allocs - stats3.nof_heap_allocs < stats3.nof_heap_allocs - stats2.nof_heap_allocs);
+  // only the tasks of the two rounds were called
+  TESTASSERT(v == 2 * 10 * (int)nof_tasks * d.big_val[0]);
+
+  std::cout << "outcome: Success\n";
+  std::cout << "========================================\n";
+  return 0;
+}
+
 int main()
 {
   TESTASSERT(test_multiqueue() == 0);
@@ -499,10 +721,15 @@ int main()
   TESTASSERT(test_multiqueue_threading2() == 0);
   TESTASSERT(test_multiqueue_threading3() == 0);
   TESTASSERT(test_multiqueue_threading4() == 0);
+  TESTASSERT(test_multiqueue_threading5() == 0);
 
   TESTASSERT(test_task_thread_pool() == 0);
   TESTASSERT(test_task_thread_pool2() == 0);
   TESTASSERT(test_task_thread_pool3() == 0);
+  TESTASSERT(test_task_thread_pool_parallel_for() == 0);
+  TESTASSERT(test_task_thread_pool_priorities() == 0);
+  TESTASSERT(test_task_thread_pool_stealing() == 0);
 
   TESTASSERT(test_inplace_task() == 0);
+  TESTASSERT(test_task_spill_pool() == 0);
 }
@@ -22,8 +22,10 @@
 #include "srsran/common/network_utils.h"
 #include "srsran/common/task_scheduler.h"
 #include "srsran/common/test_common.h"
+#include "srsran/common/xdp_socket.h"
 #include <atomic>
 #include <iostream>
+#include <poll.h>
 
 struct rx_thread_tester {
   srsran::task_scheduler    task_sched;
@@ -130,6 +132,185 @@ int test_socket_handler()
   return 0;
 }
 
+int test_udp_sdu_handler()
+{
+  auto& logger = srslog::fetch_basic_logger("S1AP", false);
+  using namespace srsran::net_utils;
+
+  srsran::unique_socket rx_socket, tx_socket;
+  TESTASSERT(rx_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(rx_socket.bind_addr("127.0.0.1", 36413));
+  TESTASSERT(tx_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(tx_socket.bind_addr("127.0.0.1", 36414));
+
+  std::vector<std::vector<uint8_t>> rx_pdus;
+  auto pdu_handler = [&rx_pdus](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
+    TESTASSERT(get_port(from) == 36414);
+    rx_pdus.emplace_back(pdu->msg, pdu->msg + pdu->N_bytes);
+  };
+  srsran::task_scheduler                      task_sched;
+  srsran::task_queue_handle                   task_queue = task_sched.make_task_queue();
+  srsran::socket_manager_itf::recv_callback_t handler    = srsran::make_sdu_handler(logger, task_queue, pdu_handler);
+
+  // Send more datagrams than the handler reads at once
+  const size_t nof_pdus   = 40;
+  sockaddr_in  rx_addr_in = rx_socket.get_addr_in();
+  for (size_t i = 0; i < nof_pdus; ++i) {
+    std::vector<uint8_t> buf(i + 1, i);
+    TESTASSERT(sendto(tx_socket.fd(), buf.data(), buf.size(), 0, (sockaddr*)&rx_addr_in, sizeof(rx_addr_in)) ==
+               (ssize_t)buf.size());
+  }
+
+  // The datagrams are read in batches and delivered in order
+  while (rx_pdus.size() < nof_pdus) {
+    size_t nof_rx = rx_pdus.size();
+    TESTASSERT(handler(rx_socket.fd()));
+    task_sched.run_pending_tasks();
+    TESTASSERT(rx_pdus.size() > nof_rx);
+  }
+  TESTASSERT(rx_pdus.size() == nof_pdus);
+  for (size_t i = 0; i < nof_pdus; ++i) {
+    TESTASSERT(rx_pdus[i] == std::vector<uint8_t>(i + 1, i));
+  }
+
+  // Nothing left to read
+  TESTASSERT(handler(rx_socket.fd()));
+  task_sched.run_pending_tasks();
+  TESTASSERT(rx_pdus.size() == nof_pdus);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_xdp_sdu_handler()
+{
+  auto& logger = srslog::fetch_basic_logger("S1AP", false);
+  using namespace srsran::net_utils;
+
+  srsran::xdp_udp_socket xdp_socket(logger);
+  if (not xdp_socket.open("lo", 0, "127.0.0.1", 36415)) {
+    // AF_XDP needs CAP_NET_ADMIN and CAP_BPF
+    logger.info("Skipping the AF_XDP test");
+    return SRSRAN_SUCCESS;
+  }
+
+  srsran::unique_socket kernel_socket, tx_socket;
+  TESTASSERT(kernel_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(kernel_socket.bind_addr("127.0.0.1", 36416));
+  TESTASSERT(tx_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(tx_socket.bind_addr("127.0.0.1", 36414));
+
+  std::vector<std::vector<uint8_t>> rx_pdus;
+  auto pdu_handler = [&rx_pdus](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
+    TESTASSERT(get_port(from) == 36414);
+    TESTASSERT(from.sin_addr.s_addr == htonl(INADDR_LOOPBACK));
+    rx_pdus.emplace_back(pdu->msg, pdu->msg + pdu->N_bytes);
+  };
+  srsran::task_scheduler                      task_sched;
+  srsran::task_queue_handle                   task_queue = task_sched.make_task_queue();
+  srsran::socket_manager_itf::recv_callback_t handler =
+      srsran::make_xdp_sdu_handler(logger, task_queue, xdp_socket, pdu_handler);
+
+  // Datagrams sent to the port of the AF_XDP socket are received through it
+  const size_t nof_pdus = 40;
+  sockaddr_in  xdp_addr = {}, kernel_addr = kernel_socket.get_addr_in();
+  TESTASSERT(set_sockaddr(&xdp_addr, "127.0.0.1", 36415));
+  for (size_t i = 0; i < nof_pdus; ++i) {
+    std::vector<uint8_t> buf(i + 1, i);
+    TESTASSERT(sendto(tx_socket.fd(), buf.data(), buf.size(), 0, (sockaddr*)&xdp_addr, sizeof(xdp_addr)) ==
+               (ssize_t)buf.size());
+  }
+  while (rx_pdus.size() < nof_pdus) {
+    pollfd pfd = {xdp_socket.fd(), POLLIN, 0};
+    TESTASSERT(poll(&pfd, 1, 1000) == 1);
+    TESTASSERT(handler(xdp_socket.fd()));
+    task_sched.run_pending_tasks();
+  }
+  TESTASSERT(rx_pdus.size() == nof_pdus);
+  for (size_t i = 0; i < nof_pdus; ++i) {
+    TESTASSERT(rx_pdus[i] == std::vector<uint8_t>(i + 1, i));
+  }
+
+  // Other ports are left to the kernel
+  uint8_t buf[4] = {1, 2, 3, 4};
+  TESTASSERT(sendto(tx_socket.fd(), buf, sizeof(buf), 0, (sockaddr*)&kernel_addr, sizeof(kernel_addr)) == 4);
+  pollfd pfd = {kernel_socket.fd(), POLLIN, 0};
+  TESTASSERT(poll(&pfd, 1, 1000) == 1);
+  TESTASSERT(recv(kernel_socket.fd(), buf, sizeof(buf), 0) == 4);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_socket_manager_backend(srsran::socket_manager::backend_t backend)
+{
+  auto& logger = srslog::fetch_basic_logger("S1AP", false);
+  using namespace srsran::net_utils;
+
+  srsran::socket_manager sockhandler(backend);
+  if (backend == srsran::socket_manager::backend_t::io_uring and sockhandler.get_backend() != backend) {
+    // io_uring not available, the select backend is already tested
+    return SRSRAN_SUCCESS;
+  }
+
+  const int             nof_sockets = 3;
+  srsran::unique_socket rx_sockets[nof_sockets], tx_socket;
+  TESTASSERT(tx_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(tx_socket.bind_addr("127.0.0.1", 36420));
+
+  std::atomic<int> counters[nof_sockets] = {};
+  rx_thread_tester rx_tester;
+  for (int i = 0; i < nof_sockets; ++i) {
+    TESTASSERT(rx_sockets[i].open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+    TESTASSERT(rx_sockets[i].bind_addr("127.0.0.1", 36421 + i));
+    auto pdu_handler = [&counters, i](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) { counters[i]++; };
+    TESTASSERT(sockhandler.add_socket_handler(rx_sockets[i].fd(),
+                                              srsran::make_sdu_handler(logger, rx_tester.task_queue, pdu_handler)));
+  }
+
+  auto send_to = [&tx_socket](const srsran::unique_socket& rx_socket, int nof_pdus) {
+    uint8_t     buf[16]    = {};
+    sockaddr_in rx_addr_in = rx_socket.get_addr_in();
+    for (int n = 0; n < nof_pdus; ++n) {
+      TESTASSERT(sendto(tx_socket.fd(), buf, sizeof(buf), 0, (sockaddr*)&rx_addr_in, sizeof(rx_addr_in)) > 0);
+    }
+  };
+  auto wait_for = [&counters](int idx, int value) {
+    for (uint32_t time_elapsed = 0; counters[idx] != value; time_elapsed += 100) {
+      TESTASSERT(time_elapsed < 3000000);
+      usleep(100);
+    }
+  };
+
+  // All the sockets are served, and they keep being served after they are read
+  for (int round = 1; round <= 3; ++round) {
+    for (int i = 0; i < nof_sockets; ++i) {
+      send_to(rx_sockets[i], 50);
+    }
+    for (int i = 0; i < nof_sockets; ++i) {
+      wait_for(i, 50 * round);
+    }
+  }
+
+  // A removed socket is not served anymore, the other ones are
+  TESTASSERT(sockhandler.remove_socket(rx_sockets[0].fd()));
+  send_to(rx_sockets[0], 10);
+  send_to(rx_sockets[1], 10);
+  wait_for(1, 160);
+  usleep(10000);
+  TESTASSERT(counters[0] == 150);
+
+  // The fd can be registered again
+  TESTASSERT(sockhandler.add_socket_handler(
+      rx_sockets[0].fd(),
+      srsran::make_sdu_handler(
+          logger, rx_tester.task_queue, [&counters](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
+            counters[0]++;
+          })));
+  wait_for(0, 160);
+
+  sockhandler.stop();
+  return SRSRAN_SUCCESS;
+}
+
 int test_sctp_bind_error()
 {
   srsran::unique_socket sock;
@@ -158,6 +339,10 @@ int main()
 
   TESTASSERT(test_socket_handler() == 0);
   TESTASSERT(test_sctp_bind_error() == 0);
+  TESTASSERT(test_udp_sdu_handler() == 0);
+  TESTASSERT(test_socket_manager_backend(srsran::socket_manager::backend_t::select) == 0);
+  TESTASSERT(test_socket_manager_backend(srsran::socket_manager::backend_t::io_uring) == 0);
+  TESTASSERT(test_xdp_sdu_handler() == 0);
 
   return 0;
 }
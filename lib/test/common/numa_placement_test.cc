@@ -0,0 +1,84 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/numa_placement.h"
+#include "srsran/common/test_common.h"
+#include <vector>
+
+using namespace srsran;
+
+int test_profile_parsing()
+{
+  numa_placement& numa = numa_placement::get();
+  std::string     err;
+
+  // Empty profile, placement disabled
+  TESTASSERT(numa.configure("", err));
+  TESTASSERT(not numa.is_enabled());
+  TESTASSERT(numa.get_node(numa_pool_t::bearers) < 0);
+
+  // Malformed rules are rejected and leave the previous profile untouched
+  TESTASSERT(not numa.configure("bearers", err));
+  TESTASSERT(not err.empty());
+  TESTASSERT(not numa.configure("unknown=0", err));
+  TESTASSERT(not numa.configure("bearers=abc", err));
+  TESTASSERT(not numa.configure("bearers=100000", err));
+  TESTASSERT(not numa.is_enabled());
+
+  // Valid profile, node 0 always exists
+  TESTASSERT(numa.configure(" bearers=0 ; harq=0", err));
+  TESTASSERT(numa.is_enabled());
+  TESTASSERT(numa.get_node(numa_pool_t::bearers) == 0);
+  TESTASSERT(numa.get_node(numa_pool_t::buffers) < 0);
+  TESTASSERT(numa.get_node(numa_pool_t::harq) == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_bind()
+{
+  numa_placement& numa = numa_placement::get();
+  std::string     err;
+  TESTASSERT(numa.configure("buffers=0", err));
+
+  // Binding an unbound pool is refused
+  std::vector<uint8_t> mem(1024 * 1024);
+  TESTASSERT(not numa.bind(numa_pool_t::bearers, mem.data(), mem.size()));
+
+  // The memory already touched is moved, the thread policy does not affect the allocations out of its scope
+  TESTASSERT(numa.bind(numa_pool_t::buffers, mem.data(), mem.size()));
+  {
+    numa_placement::scoped_policy policy(numa_pool_t::buffers);
+    std::vector<uint8_t>          mem2(1024 * 1024, 1);
+  }
+  TESTASSERT(numa.to_string().find("buffers") != std::string::npos);
+
+  TESTASSERT(numa.configure("", err));
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_profile_parsing() == SRSRAN_SUCCESS);
+  TESTASSERT(test_bind() == SRSRAN_SUCCESS);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
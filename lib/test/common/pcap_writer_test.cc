@@ -0,0 +1,154 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "srsran/common/pcap_writer.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+#include <unistd.h>
+
+using namespace srsran;
+
+/// Reads back a PCAP file and returns the number of records, checking that each one carries the expected payload
+static uint32_t read_pcap_file(const std::string& name, uint32_t dlt, uint32_t pdu_len)
+{
+  FILE* f = fopen(name.c_str(), "r");
+  TESTASSERT(f != nullptr);
+
+  pcap_hdr_t file_header;
+  TESTASSERT(fread(&file_header, sizeof(file_header), 1, f) == 1);
+  TESTASSERT(file_header.magic_number == 0xa1b2c3d4);
+  TESTASSERT(file_header.network == dlt);
+
+  uint32_t             nof_records = 0;
+  pcaprec_hdr_t        rec_header;
+  std::vector<uint8_t> rec(pdu_len);
+  while (fread(&rec_header, sizeof(rec_header), 1, f) == 1) {
+    TESTASSERT(rec_header.incl_len == pdu_len + 2);
+    TESTASSERT(rec_header.orig_len == pdu_len + 2);
+    uint8_t hdr[2];
+    TESTASSERT(fread(hdr, sizeof(hdr), 1, f) == 1);
+    TESTASSERT(hdr[0] == 0xde and hdr[1] == 0xad);
+    TESTASSERT(fread(rec.data(), rec.size(), 1, f) == 1);
+    for (uint32_t i = 0; i != pdu_len; ++i) {
+      TESTASSERT(rec[i] == (uint8_t)i);
+    }
+    nof_records++;
+  }
+  fclose(f);
+  return nof_records;
+}
+
+void test_write_from_several_threads()
+{
+  const uint32_t       nof_threads = 4, nof_pdus = 1000, pdu_len = 100;
+  const uint8_t        hdr[2] = {0xde, 0xad};
+  std::vector<uint8_t> pdu(pdu_len);
+  for (uint32_t i = 0; i != pdu_len; ++i) {
+    pdu[i] = i;
+  }
+
+  pcap_writer writer("PCAP_TEST");
+  TESTASSERT(writer.open("pcap_writer_test.pcap", UDP_DLT));
+  TESTASSERT(writer.is_open());
+
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t != nof_threads; ++t) {
+    threads.emplace_back([&]() {
+      for (uint32_t i = 0; i != nof_pdus; ++i) {
+        TESTASSERT(writer.write(hdr, sizeof(hdr), pdu.data(), pdu.size()));
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  writer.close();
+  TESTASSERT(not writer.is_open());
+  TESTASSERT(writer.get_nof_dropped() == 0);
+
+  // Writes after close are refused
+  TESTASSERT(not writer.write(hdr, sizeof(hdr), pdu.data(), pdu.size()));
+
+  TESTASSERT(read_pcap_file("pcap_writer_test.pcap", UDP_DLT, pdu_len) == nof_threads * nof_pdus);
+  unlink("pcap_writer_test.pcap");
+}
+
+void test_rotation_by_size()
+{
+  const uint32_t       pdu_len = 1000;
+  const uint8_t        hdr[2]  = {0xde, 0xad};
+  std::vector<uint8_t> pdu(pdu_len);
+  for (uint32_t i = 0; i != pdu_len; ++i) {
+    pdu[i] = i;
+  }
+
+  pcap_writer_args_t args;
+  args.max_file_size_mb = 1;
+  pcap_writer writer("PCAP_TEST");
+  TESTASSERT(writer.open("pcap_writer_rot_test.pcap", NAS_LTE_DLT, args));
+
+  // Write 4 MB slowly enough for the writer thread to rotate between batches
+  uint32_t nof_written = 0;
+  for (uint32_t i = 0; i != 4 * 1024; ++i) {
+    nof_written += writer.write(hdr, sizeof(hdr), pdu.data(), pdu.size()) ? 1 : 0;
+    if (i % 256 == 255) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+  }
+  writer.close();
+  TESTASSERT(nof_written == 4 * 1024);
+  TESTASSERT(writer.get_nof_files() >= 3);
+
+  // No record is lost or split across files
+  uint32_t    nof_read = read_pcap_file("pcap_writer_rot_test.pcap", NAS_LTE_DLT, pdu_len);
+  std::string name     = "pcap_writer_rot_test.pcap";
+  unlink(name.c_str());
+  for (uint32_t idx = 1; idx != writer.get_nof_files(); ++idx) {
+    name = "pcap_writer_rot_test_" + std::to_string(idx) + ".pcap";
+    nof_read += read_pcap_file(name, NAS_LTE_DLT, pdu_len);
+    unlink(name.c_str());
+  }
+  TESTASSERT(nof_read == nof_written);
+}
+
+void test_ring_full()
+{
+  const uint8_t        hdr[2] = {0xde, 0xad};
+  std::vector<uint8_t> pdu(2048);
+
+  pcap_writer_args_t args;
+  args.ring_size_kb = 1;
+  pcap_writer writer("PCAP_TEST");
+  TESTASSERT(writer.open("pcap_writer_drop_test.pcap", UDP_DLT, args));
+
+  // A record larger than the ring is dropped instead of blocking the caller
+  TESTASSERT(not writer.write(hdr, sizeof(hdr), pdu.data(), pdu.size()));
+  TESTASSERT(writer.get_nof_dropped() == 1);
+  writer.close();
+  unlink("pcap_writer_drop_test.pcap");
+}
+
+int main()
+{
+  test_write_from_several_threads();
+  test_rotation_by_size();
+  test_ring_full();
+  return 0;
+}
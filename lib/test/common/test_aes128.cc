@@ -0,0 +1,229 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "srsran/common/aes128.h"
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+#include "srsran/srsran.h"
+
+/*
+ * Tests of the AES-128 key schedule cached per key and of the 128-EEA2/128-EIA2 and Milenage functions that use it,
+ * checked against the test vectors and against the functions that expand the key in every call
+ */
+
+#define MAX_MSG_LEN 1600
+
+static void fill_random(uint8_t* data, uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i++) {
+    data[i] = (uint8_t)rand();
+  }
+}
+
+// FIPS 197 Appendix C.1
+int test_fips197()
+{
+  uint8_t key[16] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+  uint8_t pt[16]  = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+  uint8_t ct[16]  = {0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a};
+  uint8_t out[16];
+
+  aes128_key_t aes_key;
+  aes128_set_key(&aes_key, key);
+  aes128_encrypt_blocks(&aes_key, pt, out, 1);
+  TESTASSERT(memcmp(out, ct, sizeof(ct)) == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+// 33.401 V13.1.0 Annex C.2, 128-EIA2 Test Set 1
+int test_eia2_set_1()
+{
+  uint8_t  key[]     = {0xd3, 0xc5, 0xd5, 0x92, 0x32, 0x7f, 0xb1, 0x1c, 0x40, 0x35, 0xc6, 0x68, 0x0a, 0xf8, 0xc6, 0xd1};
+  uint32_t count     = 0x398a59b4;
+  uint8_t  bearer    = 0x1a;
+  uint8_t  direction = 1;
+  uint8_t  msg[]     = {0x48, 0x45, 0x83, 0xd5, 0xaf, 0xe0, 0x82, 0xae};
+  uint8_t  mt[]      = {0xb9, 0x37, 0x87, 0xe6};
+  uint8_t  mac[4];
+
+  aes128_key_t aes_key;
+  aes128_set_key(&aes_key, key);
+  TESTASSERT(srsran::security_128_eia2(&aes_key, count, bearer, direction, msg, sizeof(msg), mac) == SRSRAN_SUCCESS);
+  TESTASSERT(memcmp(mac, mt, sizeof(mt)) == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_eia2_random()
+{
+  uint8_t key[16];
+  uint8_t msg[MAX_MSG_LEN];
+  uint8_t mac[4];
+  uint8_t mac_ref[4];
+
+  for (uint32_t msg_len = 0; msg_len < 300; msg_len++) {
+    uint32_t count     = (uint32_t)rand();
+    uint8_t  bearer    = rand() % 32;
+    uint8_t  direction = rand() % 2;
+    fill_random(key, sizeof(key));
+    fill_random(msg, msg_len);
+
+    aes128_key_t aes_key;
+    aes128_set_key(&aes_key, key);
+    srsran::security_128_eia2(key, count, bearer, direction, msg, msg_len, mac_ref);
+    srsran::security_128_eia2(&aes_key, count, bearer, direction, msg, msg_len, mac);
+    TESTASSERT(memcmp(mac, mac_ref, sizeof(mac)) == 0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_eea2_random()
+{
+  uint8_t key[16];
+  uint8_t msg[MAX_MSG_LEN];
+  uint8_t ct[MAX_MSG_LEN];
+  uint8_t ct_ref[MAX_MSG_LEN];
+
+  for (uint32_t i = 0; i < 200; i++) {
+    uint32_t msg_len   = rand() % MAX_MSG_LEN;
+    uint32_t count     = (uint32_t)rand();
+    uint8_t  bearer    = rand() % 32;
+    uint8_t  direction = rand() % 2;
+    fill_random(key, sizeof(key));
+    fill_random(msg, msg_len);
+
+    aes128_key_t aes_key;
+    aes128_set_key(&aes_key, key);
+    srsran::security_128_eea2(key, count, bearer, direction, msg, msg_len, ct_ref);
+    srsran::security_128_eea2(&aes_key, count, bearer, direction, msg, msg_len, ct);
+    TESTASSERT(memcmp(ct, ct_ref, msg_len) == 0);
+
+    // In place deciphering
+    srsran::security_128_eea2(&aes_key, count, bearer, direction, ct, msg_len, ct);
+    TESTASSERT(memcmp(ct, msg, msg_len) == 0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_eea2_batch()
+{
+  const uint32_t nof_pdus = 100;
+  uint8_t        key[16];
+  uint8_t        bearer    = 3;
+  uint8_t        direction = 1;
+
+  fill_random(key, sizeof(key));
+  aes128_key_t aes_key;
+  aes128_set_key(&aes_key, key);
+
+  std::vector<std::vector<uint8_t> >         msg(nof_pdus), ct(nof_pdus);
+  std::vector<srsran::security_cipher_pdu_t> pdus(nof_pdus);
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    // Mix of short and long PDUs, including empty ones
+    uint32_t msg_len = (i % 4 == 0) ? rand() % MAX_MSG_LEN : rand() % 64;
+    msg[i].resize(msg_len);
+    fill_random(msg[i].data(), msg_len);
+    ct[i]           = msg[i];
+    pdus[i].msg     = ct[i].data();
+    pdus[i].msg_len = msg_len;
+    pdus[i].count   = 1000 + i;
+    pdus[i].msg_out = ct[i].data();
+  }
+
+  TESTASSERT(srsran::security_128_eea2_batch(&aes_key, bearer, direction, pdus.data(), nof_pdus) == SRSRAN_SUCCESS);
+
+  uint8_t ct_ref[MAX_MSG_LEN];
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    srsran::security_128_eea2(key, pdus[i].count, bearer, direction, msg[i].data(), msg[i].size(), ct_ref);
+    TESTASSERT(memcmp(ct[i].data(), ct_ref, msg[i].size()) == 0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+// TS 35.208 Section 4.3 Test Set 1, checked in every position of a batch and against the single vector functions
+int test_milenage_batch()
+{
+  uint8_t k[16]    = {0x46, 0x5b, 0x5c, 0xe8, 0xb1, 0x99, 0xb4, 0x9f, 0xaa, 0x5f, 0x0a, 0x2e, 0xe2, 0x38, 0xa6, 0xbc};
+  uint8_t rand[16] = {0x23, 0x55, 0x3c, 0xbe, 0x96, 0x37, 0xa8, 0x9d, 0x21, 0x8a, 0xe6, 0x4d, 0xae, 0x47, 0xbf, 0x35};
+  uint8_t sqn[6]   = {0xff, 0x9b, 0xb4, 0xd0, 0xb6, 0x07};
+  uint8_t amf[2]   = {0xb9, 0xb9};
+  uint8_t opc[16]  = {0xcd, 0x63, 0xcb, 0x71, 0x95, 0x4a, 0x9f, 0x4e, 0x48, 0xa5, 0x99, 0x4e, 0x37, 0xa0, 0x2b, 0xaf};
+  uint8_t mac_a[8] = {0x4a, 0x9f, 0xfa, 0xc3, 0x54, 0xdf, 0xaf, 0xb3};
+  uint8_t res[8]   = {0xa5, 0x42, 0x11, 0xd5, 0xe3, 0xba, 0x50, 0xbf};
+  uint8_t ck[16]   = {0xb4, 0x0b, 0xa9, 0xa3, 0xc5, 0x8b, 0x2a, 0x05, 0xbb, 0xf0, 0xd9, 0x87, 0xb2, 0x1b, 0xf8, 0xcb};
+  uint8_t ik[16]   = {0xf7, 0x69, 0xbc, 0xd7, 0x51, 0x04, 0x46, 0x04, 0x12, 0x76, 0x72, 0x71, 0x1c, 0x6d, 0x34, 0x41};
+  uint8_t ak[6]    = {0xaa, 0x68, 0x9c, 0x64, 0x83, 0x70};
+
+  // More vectors than a chunk, so the last chunk is partial
+  const uint32_t                                 nof_vectors = 11;
+  std::vector<srsran::security_milenage_vector_t> vectors(nof_vectors);
+  for (uint32_t v = 0; v < nof_vectors; v++) {
+    fill_random(vectors[v].rand, sizeof(vectors[v].rand));
+    fill_random(vectors[v].sqn, sizeof(vectors[v].sqn));
+  }
+  memcpy(vectors[4].rand, rand, sizeof(rand));
+  memcpy(vectors[4].sqn, sqn, sizeof(sqn));
+  TESTASSERT(srsran::security_milenage_batch(k, opc, amf, vectors.data(), nof_vectors) == SRSRAN_SUCCESS);
+
+  TESTASSERT(memcmp(vectors[4].mac_a, mac_a, sizeof(mac_a)) == 0);
+  TESTASSERT(memcmp(vectors[4].res, res, sizeof(res)) == 0);
+  TESTASSERT(memcmp(vectors[4].ck, ck, sizeof(ck)) == 0);
+  TESTASSERT(memcmp(vectors[4].ik, ik, sizeof(ik)) == 0);
+  TESTASSERT(memcmp(vectors[4].ak, ak, sizeof(ak)) == 0);
+
+  for (uint32_t v = 0; v < nof_vectors; v++) {
+    srsran::security_milenage_vector_t ref;
+    srsran::security_milenage_f1(k, opc, vectors[v].rand, vectors[v].sqn, amf, ref.mac_a);
+    srsran::security_milenage_f2345(k, opc, vectors[v].rand, ref.res, ref.ck, ref.ik, ref.ak);
+    TESTASSERT(memcmp(vectors[v].mac_a, ref.mac_a, sizeof(ref.mac_a)) == 0);
+    TESTASSERT(memcmp(vectors[v].res, ref.res, sizeof(ref.res)) == 0);
+    TESTASSERT(memcmp(vectors[v].ck, ref.ck, sizeof(ref.ck)) == 0);
+    TESTASSERT(memcmp(vectors[v].ik, ref.ik, sizeof(ref.ik)) == 0);
+    TESTASSERT(memcmp(vectors[v].ak, ref.ak, sizeof(ref.ak)) == 0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char* argv[])
+{
+  srand(0);
+
+  printf("AES-128 hardware acceleration: %s\n", aes128_is_accelerated() ? "yes" : "no");
+
+  TESTASSERT(test_fips197() == SRSRAN_SUCCESS);
+  TESTASSERT(test_eia2_set_1() == SRSRAN_SUCCESS);
+  TESTASSERT(test_eia2_random() == SRSRAN_SUCCESS);
+  TESTASSERT(test_eea2_random() == SRSRAN_SUCCESS);
+  TESTASSERT(test_eea2_batch() == SRSRAN_SUCCESS);
+  TESTASSERT(test_milenage_batch() == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,145 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "srsran/common/s3g.h"
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+#include "srsran/common/zuc.h"
+#include "srsran/srsran.h"
+
+/*
+ * Tests of the 128-EEA1 and 128-EEA3 batches, which generate the SNOW 3G and ZUC keystreams of several PDUs together,
+ * checked against the functions that cipher one PDU at a time
+ */
+
+#define MAX_MSG_LEN 1600
+
+typedef uint8_t (*eea_func_t)(uint8_t*, uint32_t, uint8_t, uint8_t, uint8_t*, uint32_t, uint8_t*);
+typedef uint8_t (*eea_batch_func_t)(const uint8_t*, uint8_t, uint8_t, srsran::security_cipher_pdu_t*, uint32_t);
+
+static void fill_random(uint8_t* data, uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i++) {
+    data[i] = (uint8_t)rand();
+  }
+}
+
+// Batches of any size, PDUs of different lengths (including empty ones) and ciphering in place
+int test_batch(eea_func_t eea, eea_batch_func_t eea_batch, uint32_t nof_pdus)
+{
+  uint8_t key[16];
+  fill_random(key, sizeof(key));
+  uint8_t bearer    = rand() & 0x1f;
+  uint8_t direction = rand() & 0x1;
+
+  std::vector<std::vector<uint8_t> > msg(nof_pdus), out(nof_pdus), expected(nof_pdus);
+  std::vector<srsran::security_cipher_pdu_t> pdus(nof_pdus);
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    uint32_t len = (i % 5 == 4) ? 0 : rand() % MAX_MSG_LEN;
+    msg[i].resize(len);
+    expected[i].resize(len);
+    fill_random(msg[i].data(), len);
+    out[i] = msg[i];
+
+    uint32_t count = rand();
+    if (len > 0) {
+      TESTASSERT(eea(key, count, bearer, direction, msg[i].data(), len, expected[i].data()) == SRSRAN_SUCCESS);
+    }
+
+    pdus[i].msg     = out[i].data();
+    pdus[i].msg_len = len;
+    pdus[i].count   = count;
+    pdus[i].msg_out = out[i].data();
+  }
+
+  TESTASSERT(eea_batch(key, bearer, direction, pdus.data(), nof_pdus) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    TESTASSERT(out[i] == expected[i]);
+  }
+
+  // Deciphering gives back the plain text
+  TESTASSERT(eea_batch(key, bearer, direction, pdus.data(), nof_pdus) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    TESTASSERT(out[i] == msg[i]);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+// Keystream generated in several calls
+int test_lanes_split()
+{
+  uint32_t k[S3G_MAX_LANES][4];
+  uint32_t iv[S3G_MAX_LANES][4];
+  uint8_t  zk[ZUC_MAX_LANES][16];
+  uint8_t  ziv[ZUC_MAX_LANES][16];
+  fill_random((uint8_t*)k, sizeof(k));
+  fill_random((uint8_t*)iv, sizeof(iv));
+  fill_random((uint8_t*)zk, sizeof(zk));
+  fill_random((uint8_t*)ziv, sizeof(ziv));
+
+  uint32_t ks[40 * S3G_MAX_LANES];
+  uint32_t ks_split[40 * S3G_MAX_LANES];
+
+  S3G_LANES_STATE s3g;
+  s3g_lanes_initialize(&s3g, k, iv, S3G_MAX_LANES);
+  s3g_lanes_generate_keystream(&s3g, 40, ks);
+  s3g_lanes_initialize(&s3g, k, iv, S3G_MAX_LANES);
+  s3g_lanes_generate_keystream(&s3g, 13, ks_split);
+  s3g_lanes_generate_keystream(&s3g, 27, &ks_split[13 * S3G_MAX_LANES]);
+  TESTASSERT(memcmp(ks, ks_split, sizeof(ks)) == 0);
+
+  const u8* zk_ptr[ZUC_MAX_LANES];
+  const u8* ziv_ptr[ZUC_MAX_LANES];
+  for (uint32_t l = 0; l < ZUC_MAX_LANES; l++) {
+    zk_ptr[l]  = zk[l];
+    ziv_ptr[l] = ziv[l];
+  }
+  zuc_lanes_state_t zuc;
+  zuc_lanes_initialize(&zuc, zk_ptr, ziv_ptr, ZUC_MAX_LANES);
+  zuc_lanes_generate_keystream(&zuc, 40, ks);
+  zuc_lanes_initialize(&zuc, zk_ptr, ziv_ptr, ZUC_MAX_LANES);
+  zuc_lanes_generate_keystream(&zuc, 13, ks_split);
+  zuc_lanes_generate_keystream(&zuc, 27, &ks_split[13 * ZUC_MAX_LANES]);
+  TESTASSERT(memcmp(ks, ks_split, sizeof(ks)) == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char* argv[])
+{
+  srand(0);
+
+  uint32_t batch_sizes[] = {0, 1, 7, 8, 9, 17, 64};
+  for (uint32_t nof_pdus : batch_sizes) {
+    TESTASSERT(test_batch(srsran::security_128_eea1, srsran::security_128_eea1_batch, nof_pdus) == SRSRAN_SUCCESS);
+    TESTASSERT(test_batch(srsran::security_128_eea3, srsran::security_128_eea3_batch, nof_pdus) == SRSRAN_SUCCESS);
+  }
+  TESTASSERT(test_lanes_split() == SRSRAN_SUCCESS);
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
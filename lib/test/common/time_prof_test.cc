@@ -0,0 +1,119 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "srsran/common/test_common.h"
+#include "srsran/common/time_prof.h"
+#include <cmath>
+#include <thread>
+
+using namespace srsran;
+using std::chrono::nanoseconds;
+
+void test_histogram_buckets()
+{
+  // Small values have one bucket each
+  for (uint64_t ns = 0; ns != tprof_histogram::nof_sub_buckets; ++ns) {
+    TESTASSERT(tprof_histogram::bucket_index(ns) == ns);
+    TESTASSERT(tprof_histogram::bucket_value(ns) == ns);
+  }
+
+  // The buckets are contiguous and the error of their value stays below 1/nof_sub_buckets
+  uint32_t prev_idx = tprof_histogram::bucket_index(7);
+  for (uint64_t ns = 8; ns < 100000; ++ns) {
+    uint32_t idx = tprof_histogram::bucket_index(ns);
+    TESTASSERT(idx == prev_idx or idx == prev_idx + 1);
+    uint64_t val = tprof_histogram::bucket_value(idx);
+    TESTASSERT((val > ns ? val - ns : ns - val) * tprof_histogram::nof_sub_buckets <= ns);
+    prev_idx = idx;
+  }
+
+  // The largest values fit in the table
+  TESTASSERT(tprof_histogram::bucket_index(UINT64_MAX) == tprof_histogram::nof_buckets - 1);
+}
+
+void test_histogram_percentiles()
+{
+  tprof_histogram hist("test");
+
+  // 990 samples of 10 us, 9 of 100 us and one of 1 ms
+  for (uint32_t i = 0; i != 990; ++i) {
+    hist(nanoseconds(10000));
+  }
+  for (uint32_t i = 0; i != 9; ++i) {
+    hist(nanoseconds(100000));
+  }
+  hist(nanoseconds(1000000));
+
+  tprof_histogram_metrics_t m = hist.get_metrics_and_reset();
+  TESTASSERT(m.name == "test");
+  TESTASSERT(m.count == 1000);
+  TESTASSERT(std::abs(m.avg_us - 11.8) < 0.01);
+  TESTASSERT(std::abs(m.p50_us - 10) < 10 / 8.0);
+  TESTASSERT(std::abs(m.p99_us - 10) < 10 / 8.0);
+  TESTASSERT(std::abs(m.p999_us - 100) < 100 / 8.0);
+  TESTASSERT(m.max_us == 1000);
+
+  // The histogram restarts after reading it
+  m = hist.get_metrics_and_reset();
+  TESTASSERT(m.count == 0);
+  TESTASSERT(m.max_us == 0);
+}
+
+void test_stage_histograms()
+{
+  std::vector<tprof_histogram_metrics_t> metrics;
+  get_stage_metrics(metrics);
+  TESTASSERT(metrics.size() == static_cast<size_t>(tti_stage::nof_stages));
+
+  // Measure the stages from several threads
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t != 4; ++t) {
+    threads.emplace_back([]() {
+      for (uint32_t i = 0; i != 100; ++i) {
+        scoped_stage_prof prof(tti_stage::pusch);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  {
+    scoped_stage_prof prof(tti_stage::sched);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  metrics.clear();
+  get_stage_metrics(metrics);
+  TESTASSERT(metrics.size() == static_cast<size_t>(tti_stage::nof_stages));
+  TESTASSERT(metrics[static_cast<size_t>(tti_stage::pusch)].name == "pusch");
+  TESTASSERT(metrics[static_cast<size_t>(tti_stage::pusch)].count == 400);
+  TESTASSERT(metrics[static_cast<size_t>(tti_stage::sched)].count == 1);
+  TESTASSERT(metrics[static_cast<size_t>(tti_stage::sched)].max_us >= 1000);
+  TESTASSERT(metrics[static_cast<size_t>(tti_stage::ofdm)].count == 0);
+}
+
+int main()
+{
+  srslog::init();
+  test_histogram_buckets();
+  test_histogram_percentiles();
+  test_stage_histograms();
+  return 0;
+}
@@ -21,6 +21,7 @@
 
 #include "srsran/common/timers.h"
 #include "srsran/support/srsran_test.h"
+#include <chrono>
 #include <iostream>
 #include <random>
 #include <srsran/common/tti_sync_cv.h>
@@ -448,6 +449,127 @@ void timers_test7()
   TESTASSERT(timers.nof_running_timers() == 1 and timers.nof_timers() == 3);
 }
 
+/**
+ * Description: Random starts, restarts and stops of timers with durations that span all the wheel levels are checked
+ * against the expected expiry time of each timer
+ */
+void timers_test8()
+{
+  timer_handler                           timers;
+  const uint32_t                          nof_timers = 64, nof_steps = 300000;
+  std::mt19937                            mt19937(8);
+  std::uniform_int_distribution<uint32_t> timer_dist(0, nof_timers - 1);
+  std::uniform_int_distribution<uint32_t> dur_dist(1, 100000);
+  std::uniform_int_distribution<uint32_t> event_dist(0, 99);
+
+  std::vector<unique_timer> utimers;
+  std::vector<uint32_t>     expected(nof_timers, 0); ///< expiry time of each timer, 0 if not running
+  uint32_t                  now = 0, nof_expired = 0;
+  for (uint32_t i = 0; i < nof_timers; ++i) {
+    utimers.push_back(timers.get_unique_timer());
+    utimers[i].set(dur_dist(mt19937), [&expected, &now, &nof_expired](uint32_t tid) {
+      TESTASSERT(expected[tid] == now);
+      expected[tid] = 0;
+      nof_expired++;
+    });
+  }
+
+  for (; now < nof_steps;) {
+    uint32_t      i = timer_dist(mt19937);
+    uint32_t      e = event_dist(mt19937);
+    unique_timer& t = utimers[i];
+    if (e < 20) {
+      // restart, which may extend or start the timer
+      t.run();
+      expected[i] = now + t.duration();
+    } else if (e < 30) {
+      // new duration, which may shorten a running timer
+      t.set(e < 25 ? dur_dist(mt19937) % 300 + 1 : dur_dist(mt19937));
+      if (t.is_running()) {
+        expected[i] = now + t.duration();
+      }
+    } else if (e < 35) {
+      t.stop();
+      expected[i] = 0;
+    }
+    TESTASSERT(t.is_running() == (expected[i] != 0));
+
+    now++;
+    timers.step_all();
+    uint32_t nof_running = 0;
+    for (uint32_t j = 0; j < nof_timers; ++j) {
+      nof_running += expected[j] != 0 ? 1 : 0;
+    }
+    TESTASSERT(timers.nof_running_timers() == nof_running);
+  }
+  TESTASSERT(nof_expired > 0);
+}
+
+/**
+ * Description: Benchmark with 1M timers, with the durations and restart rates of the RLC, PDCP and RRC timers
+ */
+void timers_benchmark()
+{
+  using clock_t                 = std::chrono::steady_clock;
+  const uint32_t nof_timers     = 1000000;
+  const uint32_t nof_steps      = 1000;
+  const uint32_t nof_ops_per_ms = 5000;
+
+  // t-StatusProhibit, t-Reordering, t-PollRetransmit; discardTimer; T300/T301/T310; UE inactivity
+  const std::vector<uint32_t> rlc_durations  = {10, 35, 45};
+  const std::vector<uint32_t> pdcp_durations = {50, 100, 150, 300, 500, 750, 1500};
+  const std::vector<uint32_t> rrc_durations  = {1000, 2000, 5000};
+  const std::vector<uint32_t> ue_durations   = {30000, 60000};
+
+  timer_handler                           timers(nof_timers);
+  std::mt19937                            mt19937(10);
+  std::uniform_int_distribution<uint32_t> timer_dist(0, nof_timers - 1);
+  std::uniform_int_distribution<uint32_t> event_dist(0, 99);
+  uint32_t                                nof_expired = 0;
+
+  auto pick = [&mt19937](const std::vector<uint32_t>& v) { return v[mt19937() % v.size()]; };
+
+  std::vector<unique_timer> utimers;
+  utimers.reserve(nof_timers);
+  auto tp = clock_t::now();
+  for (uint32_t i = 0; i < nof_timers; ++i) {
+    uint32_t c   = event_dist(mt19937);
+    uint32_t dur = c < 40 ? pick(rlc_durations) : c < 70 ? pick(pdcp_durations) : c < 90 ? pick(rrc_durations)
+                                                                                        : pick(ue_durations);
+    utimers.push_back(timers.get_unique_timer());
+    utimers.back().set(dur, [&nof_expired](uint32_t tid) { nof_expired++; });
+    utimers.back().run();
+  }
+  auto start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - tp).count();
+
+  uint64_t ops_ns = 0, step_ns = 0;
+  for (uint32_t n = 0; n < nof_steps; ++n) {
+    tp = clock_t::now();
+    for (uint32_t k = 0; k < nof_ops_per_ms; ++k) {
+      unique_timer& t = utimers[timer_dist(mt19937)];
+      if (event_dist(mt19937) < 80) {
+        t.run();
+      } else {
+        t.stop();
+      }
+    }
+    auto tp2 = clock_t::now();
+    timers.step_all();
+    ops_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - tp).count();
+    step_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - tp2).count();
+  }
+  TESTASSERT(nof_expired > 0);
+
+  fmt::print("Benchmark with {} timers: sizeof(timer_handler)={} B, start={:.1f} ns/timer, run/stop={:.1f} ns/op, "
+             "step_all={:.1f} us/step, {} expirations\n",
+             nof_timers,
+             sizeof(timer_handler),
+             start_ns / (double)nof_timers,
+             ops_ns / (double)(nof_steps * nof_ops_per_ms),
+             step_ns / 1000.0 / nof_steps,
+             nof_expired);
+}
+
 int main()
 {
   timers_test1();
@@ -457,6 +579,8 @@ int main()
   timers_test5();
   timers_test6();
   timers_test7();
+  timers_test8();
+  timers_benchmark();
   printf("Success\n");
   return 0;
 }
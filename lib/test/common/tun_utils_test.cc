@@ -0,0 +1,209 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/tun_utils.h"
+#include <netinet/in.h>
+
+using namespace srsran;
+
+// Flags and GSO types of the virtio_net_hdr
+const uint8_t vnet_f_needs_csum = 1;
+const uint8_t vnet_gso_tcpv4    = 1;
+const uint8_t vnet_gso_udp      = 3;
+const uint8_t vnet_gso_tcpv6    = 4;
+
+uint32_t be16(const uint8_t* p)
+{
+  return (p[0] << 8) | p[1];
+}
+
+// Reference checksum, over the big endian 16-bit words of data
+uint32_t ref_sum(const uint8_t* data, uint32_t len)
+{
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < len; i += 2) {
+    sum += (data[i] << 8) | (i + 1 < len ? data[i + 1] : 0);
+  }
+  return sum;
+}
+
+uint16_t ref_fold(uint32_t sum)
+{
+  while (sum >> 16) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+  return sum;
+}
+
+// Returns true if the IP (for IPv4) and TCP checksums of the packet are correct
+bool checksums_ok(const byte_buffer_t& pkt)
+{
+  const uint8_t* ip     = pkt.msg;
+  bool           ipv4   = (ip[0] >> 4) == 4;
+  uint32_t       ip_len = ipv4 ? (ip[0] & 0xf) * 4 : 40;
+  uint32_t       l4_len = pkt.N_bytes - ip_len;
+  uint32_t       sum    = ipv4 ? ref_sum(&ip[12], 8) : ref_sum(&ip[8], 32);
+  sum += IPPROTO_TCP + l4_len + ref_sum(&ip[ip_len], l4_len);
+  if (ipv4 and ref_fold(ref_sum(ip, ip_len)) != 0xffff) {
+    return false;
+  }
+  return ref_fold(sum) == 0xffff;
+}
+
+// Builds a GSO packet from the kernel, the TCP checksum holds the sum of the pseudo-header
+std::vector<uint8_t> make_gso_frame(bool ipv4, uint32_t payload_len, uint16_t mss)
+{
+  uint32_t             ip_len = ipv4 ? 20 : 40;
+  uint32_t             hdr    = ip_len + 32; // TCP header with 12 bytes of options
+  std::vector<uint8_t> frame(tun_vnet_hdr_size + hdr + payload_len);
+
+  // virtio_net_hdr, in host byte order
+  uint16_t vnet[5] = {0, (uint16_t)hdr, mss, (uint16_t)ip_len, 16};
+  memcpy(frame.data(), vnet, sizeof(vnet));
+  frame[0] = vnet_f_needs_csum;
+  frame[1] = ipv4 ? vnet_gso_tcpv4 : vnet_gso_tcpv6;
+
+  uint8_t* ip = &frame[tun_vnet_hdr_size];
+  if (ipv4) {
+    ip[0] = 0x45;
+    ip[4] = 0x12; // id 0x1234
+    ip[5] = 0x34;
+    ip[8] = 64;
+    ip[9] = IPPROTO_TCP;
+    uint8_t addrs[8] = {10, 45, 0, 1, 172, 16, 0, 2};
+    memcpy(&ip[12], addrs, 8);
+  } else {
+    ip[0] = 0x60;
+    ip[6] = IPPROTO_TCP;
+    ip[7] = 64;
+    for (uint32_t i = 0; i < 32; ++i) {
+      ip[8 + i] = i * 7;
+    }
+  }
+  uint8_t* tcp = ip + ip_len;
+  tcp[0]       = 0x13; // ports
+  tcp[2]       = 0x88;
+  tcp[4]       = 0xff; // seq 0xfffffff0, it wraps around within the packet
+  tcp[5]       = 0xff;
+  tcp[6]       = 0xff;
+  tcp[7]       = 0xf0;
+  tcp[12]      = 8 << 4;
+  tcp[13]      = 0x80 | 0x10 | 0x08 | 0x01; // CWR, ACK, PSH, FIN
+  for (uint32_t i = 0; i < payload_len; ++i) {
+    tcp[32 + i] = i * 13 + 5;
+  }
+  uint32_t sum = ipv4 ? ref_sum(&ip[12], 8) : ref_sum(&ip[8], 32);
+  uint16_t ps  = ref_fold(sum + IPPROTO_TCP + 32 + payload_len);
+  tcp[16]      = ps >> 8;
+  tcp[17]      = ps & 0xff;
+  return frame;
+}
+
+int test_gso_split(bool ipv4)
+{
+  const uint32_t       payload_len = 4000;
+  const uint16_t       mss         = 1400;
+  std::vector<uint8_t> frame       = make_gso_frame(ipv4, payload_len, mss);
+  const uint8_t*       orig        = &frame[tun_vnet_hdr_size];
+  uint32_t             ip_len      = ipv4 ? 20 : 40;
+
+  std::vector<unique_byte_buffer_t> pkts;
+  TESTASSERT(tun_vnet_split(frame.data(), frame.size(), pkts) == 3);
+  TESTASSERT(pkts.size() == 3);
+
+  uint32_t offset = 0;
+  for (uint32_t i = 0; i < pkts.size(); ++i) {
+    const uint8_t* ip      = pkts[i]->msg;
+    const uint8_t* tcp     = ip + ip_len;
+    uint32_t       seg_len = std::min<uint32_t>(mss, payload_len - offset);
+    TESTASSERT(pkts[i]->N_bytes == ip_len + 32 + seg_len);
+    if (ipv4) {
+      TESTASSERT(be16(&ip[2]) == pkts[i]->N_bytes);
+      TESTASSERT(be16(&ip[4]) == 0x1234 + i);
+    } else {
+      TESTASSERT(be16(&ip[4]) == 32 + seg_len);
+    }
+    uint32_t seq = (tcp[4] << 24) | (tcp[5] << 16) | (tcp[6] << 8) | tcp[7];
+    TESTASSERT(seq == 0xfffffff0 + offset);
+    // FIN and PSH only in the last segment, CWR only in the first one
+    TESTASSERT(tcp[13] == ((i == 0 ? 0x80 : 0) | 0x10 | (i == 2 ? 0x09 : 0)));
+    TESTASSERT(memcmp(&tcp[20], &orig[ip_len + 20], 12) == 0);
+    TESTASSERT(memcmp(&tcp[32], &orig[ip_len + 32 + offset], seg_len) == 0);
+    TESTASSERT(checksums_ok(*pkts[i]));
+    offset += seg_len;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_csum_only()
+{
+  // A single segment with the checksum left to the reader
+  std::vector<uint8_t> frame    = make_gso_frame(true, 101, 1400);
+  frame[tun_vnet_hdr_size + 3]  = 20 + 32 + 101;
+  uint16_t ip_csum              = ~ref_fold(ref_sum(&frame[tun_vnet_hdr_size], 20));
+  frame[tun_vnet_hdr_size + 10] = ip_csum >> 8;
+  frame[tun_vnet_hdr_size + 11] = ip_csum & 0xff;
+  frame[1]                      = 0;
+
+  std::vector<unique_byte_buffer_t> pkts;
+  TESTASSERT(tun_vnet_split(frame.data(), frame.size(), pkts) == 1);
+  TESTASSERT(pkts[0]->N_bytes == frame.size() - tun_vnet_hdr_size);
+  TESTASSERT(checksums_ok(*pkts[0]));
+
+  // Checksum already complete, the packet is copied as is
+  frame[0] = 0;
+  pkts.clear();
+  TESTASSERT(tun_vnet_split(frame.data(), frame.size(), pkts) == 1);
+  TESTASSERT(memcmp(pkts[0]->msg, &frame[tun_vnet_hdr_size], pkts[0]->N_bytes) == 0);
+  return SRSRAN_SUCCESS;
+}
+
+int test_malformed()
+{
+  std::vector<unique_byte_buffer_t> pkts;
+  std::vector<uint8_t>              frame = make_gso_frame(true, 3000, 1400);
+
+  // Truncated virtio_net_hdr
+  TESTASSERT(tun_vnet_split(frame.data(), tun_vnet_hdr_size - 1, pkts) < 0);
+  // UDP segmentation is not enabled
+  std::vector<uint8_t> udp = frame;
+  udp[1]                   = vnet_gso_udp;
+  TESTASSERT(tun_vnet_split(udp.data(), udp.size(), pkts) < 0);
+  // Headers longer than the packet
+  TESTASSERT(tun_vnet_split(frame.data(), tun_vnet_hdr_size + 40, pkts) < 0);
+  // No MSS
+  std::vector<uint8_t> no_mss = frame;
+  no_mss[4] = no_mss[5] = 0;
+  TESTASSERT(tun_vnet_split(no_mss.data(), no_mss.size(), pkts) < 0);
+  TESTASSERT(pkts.empty());
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_gso_split(true) == SRSRAN_SUCCESS);
+  TESTASSERT(test_gso_split(false) == SRSRAN_SUCCESS);
+  TESTASSERT(test_csum_only() == SRSRAN_SUCCESS);
+  TESTASSERT(test_malformed() == SRSRAN_SUCCESS);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,158 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "pdcp_lte_test.h"
+#include <chrono>
+#include <thread>
+
+/*
+ * Test of the DRB PDUs ciphered in a crypto pool, which must reach RLC in COUNT order and equal to the PDUs ciphered in
+ * the stack thread
+ */
+
+// Keeps all the PDUs written to RLC
+class rlc_tx_order_dummy : public srsue::rlc_interface_pdcp
+{
+public:
+  void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu) override { pdus.push_back(std::move(sdu)); }
+  void discard_sdu(uint32_t lcid, uint32_t discard_sn) override {}
+  bool rb_is_um(uint32_t lcid) override { return false; }
+  bool sdu_queue_is_full(uint32_t lcid) override { return false; }
+  bool is_suspended(uint32_t lcid) override { return false; }
+
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+};
+
+int test_tx_crypto_pool(srsran::CIPHERING_ALGORITHM_ID_ENUM cipher_algo,
+                        srsran::task_thread_pool&           crypto_pool,
+                        srslog::basic_logger&               logger)
+{
+  const uint32_t nof_sdus = 64;
+
+  srsran::pdcp_config_t cfg = {1,
+                               srsran::PDCP_RB_IS_DRB,
+                               srsran::SECURITY_DIRECTION_UPLINK,
+                               srsran::SECURITY_DIRECTION_DOWNLINK,
+                               srsran::PDCP_SN_LEN_12,
+                               srsran::pdcp_t_reordering_t::ms500,
+                               srsran::pdcp_discard_timer_t::infinity,
+                               false,
+                               srsran::srsran_rat_t::lte};
+
+  srsran::as_security_config_t sec_cfg_pool = sec_cfg;
+  sec_cfg_pool.cipher_algo                  = cipher_algo;
+
+  rlc_tx_order_dummy      rlc;
+  rrc_dummy               rrc(logger);
+  gw_dummy                gw(logger);
+  srsue::stack_test_dummy stack;
+  srsran::pdcp_entity_lte pdcp(&rlc, &rrc, &gw, &stack.task_sched, logger, 0);
+  pdcp.configure(cfg);
+  pdcp.config_security(sec_cfg_pool);
+  pdcp.enable_integrity(srsran::DIRECTION_TXRX);
+  pdcp.enable_encryption(srsran::DIRECTION_TXRX);
+  pdcp.set_crypto_pool(&crypto_pool);
+
+  // SDUs of different sizes, so that they take different times to cipher
+  std::vector<srsran::unique_byte_buffer_t> expected_pdus;
+  for (uint32_t i = 0; i < nof_sdus; i++) {
+    srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    TESTASSERT(sdu != nullptr);
+    for (uint32_t j = 0; j < 1 + (i * 97) % 1500; j++) {
+      sdu->msg[j] = (uint8_t)(i + j);
+    }
+    sdu->N_bytes = 1 + (i * 97) % 1500;
+    expected_pdus.push_back(
+        gen_expected_pdu(sdu, i, srsran::PDCP_SN_LEN_12, srsran::PDCP_RB_IS_DRB, sec_cfg_pool, logger));
+    pdcp.write_sdu(std::move(sdu));
+  }
+
+  // The ciphered PDUs are handed back to the stack thread
+  auto t_start = std::chrono::steady_clock::now();
+  while (rlc.pdus.size() < nof_sdus && std::chrono::steady_clock::now() - t_start < std::chrono::seconds(5)) {
+    stack.run_pending_tasks();
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  TESTASSERT(rlc.pdus.size() == nof_sdus);
+
+  for (uint32_t i = 0; i < nof_sdus; i++) {
+    TESTASSERT(rlc.pdus[i]->N_bytes == expected_pdus[i]->N_bytes);
+    TESTASSERT(memcmp(rlc.pdus[i]->msg, expected_pdus[i]->msg, expected_pdus[i]->N_bytes) == 0);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+// The PDUs ciphered after the entity is removed are dropped
+int test_tx_crypto_pool_entity_removed(srsran::task_thread_pool& crypto_pool, srslog::basic_logger& logger)
+{
+  srsran::pdcp_config_t cfg = {1,
+                               srsran::PDCP_RB_IS_DRB,
+                               srsran::SECURITY_DIRECTION_UPLINK,
+                               srsran::SECURITY_DIRECTION_DOWNLINK,
+                               srsran::PDCP_SN_LEN_12,
+                               srsran::pdcp_t_reordering_t::ms500,
+                               srsran::pdcp_discard_timer_t::infinity,
+                               false,
+                               srsran::srsran_rat_t::lte};
+
+  rlc_tx_order_dummy      rlc;
+  rrc_dummy               rrc(logger);
+  gw_dummy                gw(logger);
+  srsue::stack_test_dummy stack;
+  {
+    srsran::pdcp_entity_lte pdcp(&rlc, &rrc, &gw, &stack.task_sched, logger, 0);
+    pdcp.configure(cfg);
+    pdcp.config_security(sec_cfg);
+    pdcp.enable_encryption(srsran::DIRECTION_TXRX);
+    pdcp.set_crypto_pool(&crypto_pool);
+    for (uint32_t i = 0; i < 16; i++) {
+      srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+      TESTASSERT(sdu != nullptr);
+      sdu->append_bytes(sdu1, sizeof(sdu1));
+      pdcp.write_sdu(std::move(sdu));
+    }
+  }
+
+  // Wait for the workers to finish, then run the notifications
+  while (crypto_pool.nof_pending_tasks() > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  stack.run_pending_tasks();
+  TESTASSERT(rlc.pdus.empty());
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("PDCP", false);
+  logger.set_level(srslog::basic_levels::none);
+
+  srsran::task_thread_pool crypto_pool(4);
+
+  TESTASSERT(test_tx_crypto_pool(srsran::CIPHERING_ALGORITHM_ID_128_EEA1, crypto_pool, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_tx_crypto_pool(srsran::CIPHERING_ALGORITHM_ID_128_EEA2, crypto_pool, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_tx_crypto_pool(srsran::CIPHERING_ALGORITHM_ID_128_EEA3, crypto_pool, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_tx_crypto_pool_entity_removed(crypto_pool, logger) == SRSRAN_SUCCESS);
+
+  crypto_pool.stop();
+  return SRSRAN_SUCCESS;
+}
@@ -124,6 +124,70 @@ int test_tx_sdu_discard(const srsran::pdcp_lte_state_t& init_state,
   pdcp->notify_delivery(sns_notified); // PDCP should not find PDU to notify.
   return 0;
 }
+
+/*
+ * Test discard timer expiry of SDUs written in different TTIs, with some SDUs delivered out of order
+ */
+int test_tx_sdu_discard_order(const srsran::pdcp_lte_state_t& init_state,
+                              srsran::pdcp_discard_timer_t    discard_timeout,
+                              srslog::basic_logger&           logger)
+{
+  srsran::pdcp_config_t cfg = {1,
+                               srsran::PDCP_RB_IS_DRB,
+                               srsran::SECURITY_DIRECTION_UPLINK,
+                               srsran::SECURITY_DIRECTION_DOWNLINK,
+                               srsran::PDCP_SN_LEN_12,
+                               srsran::pdcp_t_reordering_t::ms500,
+                               discard_timeout,
+                               false,
+                               srsran::srsran_rat_t::lte};
+
+  pdcp_lte_test_helper     pdcp_hlp(cfg, sec_cfg, logger);
+  srsran::pdcp_entity_lte* pdcp  = &pdcp_hlp.pdcp;
+  rlc_dummy*               rlc   = &pdcp_hlp.rlc;
+  srsue::stack_test_dummy* stack = &pdcp_hlp.stack;
+
+  pdcp_hlp.set_pdcp_initial_state(init_state);
+
+  // Write two SDUs per TTI for 10 TTIs
+  const uint32_t nof_ttis = 10;
+  for (uint32_t i = 0; i < nof_ttis; ++i) {
+    for (uint32_t j = 0; j < 2; ++j) {
+      srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+      TESTASSERT(sdu != nullptr);
+      sdu->append_bytes(sdu1, sizeof(sdu1));
+      pdcp->write_sdu(std::move(sdu));
+    }
+    stack->run_tti();
+  }
+  TESTASSERT(pdcp->nof_discard_timers() == 2 * nof_ttis);
+
+  // Deliver the first SDU, one SDU in the middle and both SDUs of the last TTI
+  srsran::pdcp_sn_vector_t sns_notified;
+  sns_notified.push_back(0);
+  sns_notified.push_back(9);
+  sns_notified.push_back(18);
+  sns_notified.push_back(19);
+  pdcp->notify_delivery(sns_notified);
+  TESTASSERT(pdcp->nof_discard_timers() == 2 * nof_ttis - 4);
+
+  // The SDUs written in TTI i are discarded in TTI i + discard_timeout, a single timer is used for all of them
+  uint32_t discard_ms    = static_cast<uint32_t>(cfg.discard_timer);
+  uint32_t nof_discarded = 0;
+  for (uint32_t tti = nof_ttis; tti < discard_ms + nof_ttis; ++tti) {
+    TESTASSERT(stack->task_sched.get_timer_handler()->nof_running_timers() <= 1);
+    stack->run_tti();
+    if (tti + 1 >= discard_ms and tti + 1 < discard_ms + nof_ttis - 1) {
+      uint32_t write_tti = tti + 1 - discard_ms;
+      nof_discarded += (write_tti == 0 or write_tti == 4) ? 1 : 2;
+    }
+    TESTASSERT(rlc->discard_count == nof_discarded);
+  }
+  TESTASSERT(nof_discarded == 2 * nof_ttis - 4);
+  TESTASSERT(pdcp->nof_discard_timers() == 0);
+  TESTASSERT(stack->task_sched.get_timer_handler()->nof_running_timers() == 0);
+  return 0;
+}
 /*
  * TX Test: PDCP Entity with SN LEN = 12 and 18.
  * PDCP entity configured with EIA2 and EEA2
@@ -141,6 +205,12 @@ int test_tx_discard_all(srslog::basic_logger& logger)
    * Test TX PDU discard.
    */
   TESTASSERT(test_tx_sdu_discard(normal_init_state, srsran::pdcp_discard_timer_t::ms50, logger) == 0);
+
+  /*
+   * TX Test 3: PDCP Entity with SN LEN = 12
+   * Test TX PDU discard order.
+   */
+  TESTASSERT(test_tx_sdu_discard_order(normal_init_state, srsran::pdcp_discard_timer_t::ms50, logger) == 0);
   return 0;
 }
 
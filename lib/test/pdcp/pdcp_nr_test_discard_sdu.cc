@@ -19,6 +19,7 @@
  *
  */
 #include "pdcp_nr_test.h"
+#include <chrono>
 #include <numeric>
 
 /*
@@ -79,6 +80,76 @@ int test_tx_sdu_discard(const pdcp_initial_state&    init_state,
   return 0;
 }
 
+/*
+ * Throughput test: several SDUs are written every TTI and the RLC notifies the delivery of all of them one TTI later,
+ * except for one out of every 10, which have to be discarded after the discard timer. All the SDUs share one timer.
+ */
+int test_tx_discard_throughput(srslog::basic_logger& logger)
+{
+  const uint32_t nof_ttis = 1000, sdus_per_tti = 100, discard_ms = 50;
+
+  srsran::pdcp_config_t cfg = {1,
+                               srsran::PDCP_RB_IS_DRB,
+                               srsran::SECURITY_DIRECTION_UPLINK,
+                               srsran::SECURITY_DIRECTION_DOWNLINK,
+                               srsran::PDCP_SN_LEN_18,
+                               srsran::pdcp_t_reordering_t::ms500,
+                               srsran::pdcp_discard_timer_t::ms50,
+                               false,
+                               srsran::srsran_rat_t::nr};
+
+  pdcp_nr_test_helper      pdcp_hlp(cfg, sec_cfg, logger);
+  srsran::pdcp_entity_nr*  pdcp  = &pdcp_hlp.pdcp;
+  rlc_dummy*               rlc   = &pdcp_hlp.rlc;
+  srsue::stack_test_dummy* stack = &pdcp_hlp.stack;
+
+  // Per packet logging would dominate the measurement
+  logger.set_level(srslog::basic_levels::warning);
+
+  uint32_t tx_count = 0, nof_undelivered = 0;
+  auto     t_start  = std::chrono::steady_clock::now();
+  for (uint32_t tti = 0; tti < nof_ttis + discard_ms; ++tti) {
+    // Delivery of the SDUs of the previous TTI, in reverse order
+    srsran::pdcp_sn_vector_t delivered_sns;
+    for (uint32_t i = 0; i < sdus_per_tti and tti > 0 and tti <= nof_ttis; ++i) {
+      uint32_t count = tx_count - 1 - i;
+      if (count % 10 != 0) {
+        delivered_sns.push_back(count);
+      }
+    }
+    pdcp->notify_delivery(delivered_sns);
+
+    for (uint32_t i = 0; i < sdus_per_tti and tti < nof_ttis; ++i) {
+      srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+      sdu->append_bytes(sdu1, sizeof(sdu1));
+      pdcp->write_sdu(std::move(sdu));
+      nof_undelivered += (tx_count % 10 == 0) ? 1 : 0;
+      tx_count++;
+    }
+
+    // The discard timer expires for the SDUs written discard_ms TTIs ago
+    uint32_t nof_discarded = tti >= discard_ms ? std::min(tti - discard_ms + 1, nof_ttis) * sdus_per_tti / 10 : 0;
+    TESTASSERT_EQ(rlc->discard_count, nof_discarded);
+    uint32_t nof_pending   = nof_undelivered - nof_discarded + (tti < nof_ttis ? sdus_per_tti * 9 / 10 : 0);
+    TESTASSERT_EQ(pdcp->nof_discard_timers(), nof_pending);
+    TESTASSERT(stack->task_sched.get_timer_handler()->nof_running_timers() <= 1);
+    stack->run_tti();
+  }
+  auto t_end = std::chrono::steady_clock::now();
+  logger.set_level(srslog::basic_levels::debug);
+
+  TESTASSERT_EQ(rlc->discard_count, nof_ttis * sdus_per_tti / 10);
+  TESTASSERT_EQ(pdcp->nof_discard_timers(), 0);
+
+  double elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(t_end - t_start).count();
+  fprintf(stdout,
+          "TX %d SDUs with discard timer in %.0f us (%.0f SDUs/s)\n",
+          tx_count,
+          elapsed_us,
+          elapsed_us > 0 ? tx_count * 1e6 / elapsed_us : 0);
+  return SRSRAN_SUCCESS;
+}
+
 /*
  * TX Test: PDCP Entity with SN LEN = 12 and 18.
  * PDCP entity configured with EIA2 and EEA2
@@ -96,6 +167,12 @@ int test_tx_discard_all(srslog::basic_logger& logger)
    * Test TX PDU discard.
    */
   // TESTASSERT(test_tx_sdu_discard(normal_init_state, srsran::pdcp_discard_timer_t::ms50, true, logger) == 0);
+
+  /*
+   * TX Test 3: PDCP Entity with SN LEN = 18
+   * Test the throughput of the TX with the discard timer, with most SDUs delivered out of order.
+   */
+  TESTASSERT(test_tx_discard_throughput(logger) == 0);
   return 0;
 }
 
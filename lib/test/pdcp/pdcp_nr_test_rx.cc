@@ -19,6 +19,7 @@
  *
  */
 #include "pdcp_nr_test.h"
+#include <chrono>
 #include <numeric>
 
 /*
@@ -77,6 +78,60 @@ public:
   }
 };
 
+/*
+ * Throughput test: the PDUs generated by a TX entity are received with every pair of COUNTs swapped, so each
+ * PDU with an odd COUNT waits in the reordering queue.
+ */
+int test_rx_throughput(uint8_t pdcp_sn_len, uint32_t n_sdus, srslog::basic_logger& logger)
+{
+  pdcp_nr_test_helper pdcp_hlp_tx({1,
+                                   srsran::PDCP_RB_IS_DRB,
+                                   srsran::SECURITY_DIRECTION_UPLINK,
+                                   srsran::SECURITY_DIRECTION_DOWNLINK,
+                                   pdcp_sn_len,
+                                   srsran::pdcp_t_reordering_t::ms500,
+                                   srsran::pdcp_discard_timer_t::infinity,
+                                   false,
+                                   srsran::srsran_rat_t::nr},
+                                  sec_cfg,
+                                  logger);
+  test_rx_helper      rx_helper(pdcp_sn_len, logger);
+
+  // Per packet logging would dominate the measurement
+  logger.set_level(srslog::basic_levels::warning);
+
+  srsran::unique_byte_buffer_t pdus[2];
+  auto                         t_start = std::chrono::steady_clock::now();
+  for (uint32_t count = 0; count < n_sdus; count += 2) {
+    for (srsran::unique_byte_buffer_t& pdu : pdus) {
+      srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+      sdu->append_bytes(sdu1, sizeof(sdu1));
+      pdcp_hlp_tx.pdcp.write_sdu(std::move(sdu));
+      pdu = srsran::make_byte_buffer();
+      pdcp_hlp_tx.rlc.get_last_sdu(pdu);
+    }
+    rx_helper.pdcp_rx.write_pdu(std::move(pdus[1]));
+    TESTASSERT(rx_helper.pdcp_rx.is_reordering_timer_running());
+    rx_helper.pdcp_rx.write_pdu(std::move(pdus[0]));
+    TESTASSERT(not rx_helper.pdcp_rx.is_reordering_timer_running());
+  }
+  auto t_end = std::chrono::steady_clock::now();
+  logger.set_level(srslog::basic_levels::debug);
+
+  TESTASSERT_EQ(rx_helper.gw_rx.rx_count, n_sdus);
+  TESTASSERT_EQ(rx_helper.pdcp_rx.get_rx_deliv(), n_sdus);
+  TESTASSERT_EQ(rx_helper.pdcp_rx.get_rx_next(), n_sdus);
+
+  double elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(t_end - t_start).count();
+  fprintf(stdout,
+          "RX %d SDUs with %d bit SN in %.0f us (%.0f SDUs/s, TX and RX)\n",
+          n_sdus,
+          pdcp_sn_len,
+          elapsed_us,
+          elapsed_us > 0 ? n_sdus * 1e6 / elapsed_us : 0);
+  return SRSRAN_SUCCESS;
+}
+
 /*
  * RX Test: PDCP Entity with SN LEN = 12 and 18.
  * PDCP entity configured with EIA2 and EEA2
@@ -270,6 +325,16 @@ int test_rx_all(srslog::basic_logger& logger)
     test8_pdus.push_back(std::move(event_pdu2));
     TESTASSERT(rx_helper.test_rx(std::move(test8_pdus), test8_init_state, 1, tst_sdu1) == 0);
   }
+
+  /*
+   * RX Test 9: PDCP Entity with SN LEN = 12 and 18
+   * Test the throughput of the reception of pairs of out-of-order packets.
+   */
+  {
+    srsran::test_delimit_logger delimiter("RX throughput, 12 and 18 bit SN");
+    TESTASSERT(test_rx_throughput(srsran::PDCP_SN_LEN_12, 4 * 4096, logger) == SRSRAN_SUCCESS);
+    TESTASSERT(test_rx_throughput(srsran::PDCP_SN_LEN_18, 4 * 4096, logger) == SRSRAN_SUCCESS);
+  }
   return 0;
 }
 
@@ -0,0 +1,697 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        phy_benchmark.c
+ * Description: Runs the eNb DL -> UE DL and UE UL -> eNb UL chains for a matrix
+ *              of bandwidths, MCS and antenna configurations and reports the
+ *              throughput and the time spent in every processing stage of the
+ *              receiver as JSON, so the results can be compared across commits
+ *              and CPUs.
+ *****************************************************************************/
+
+#include <srsran/phy/utils/random.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "srsran/srsran.h"
+
+#define MAX_DATABUFFER_SIZE (6144 * 16 * 3 / 8)
+
+/* Receiver stages. In the UL there is no control channel, so the ctrl stage is always zero. The CRC stage is the TB CRC
+ * computed again over the decoded payload, the decoder already checks it as part of the FEC stage. */
+typedef enum {
+  STAGE_OFDM = 0,
+  STAGE_CHEST,
+  STAGE_CTRL,
+  STAGE_DEMOD,
+  STAGE_FEC,
+  STAGE_CRC,
+  STAGE_NOF
+} bench_stage_t;
+
+static const char* stage_names[STAGE_NOF] = {"ofdm", "chest", "ctrl", "demod", "fec", "crc"};
+
+typedef struct {
+  const char* link;
+  uint32_t    nof_prb;
+  uint32_t    mcs;
+  uint32_t    tm;
+  uint32_t    nof_tx_ports;
+  uint32_t    nof_rx_ant;
+  uint32_t    nof_tb;
+  uint32_t    nof_errors;
+  uint64_t    tx_bits;
+  uint64_t    rx_bits;
+  uint64_t    tx_ns;
+  uint64_t    rx_ns;
+  uint64_t    stage_ns[STAGE_NOF];
+} bench_result_t;
+
+static const uint32_t default_prb[] = {6, 15, 25, 50, 75, 100};
+static const uint32_t default_mcs[] = {0, 9, 17, 24};
+static const uint32_t default_tm[]  = {SRSRAN_TM1, SRSRAN_TM2, SRSRAN_TM4};
+
+static int      nof_prb        = -1;
+static int      mcs            = -1;
+static int      tm             = -1;
+static uint32_t nof_subframes  = 100;
+static bool     run_dl         = true;
+static bool     run_ul         = true;
+static char*    output_file    = NULL;
+static uint16_t rnti           = 0x1234;
+static uint32_t cfi            = 1;
+static uint32_t max_iterations = 10;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [pmtndulo]\n", prog);
+  printf("\t-p cell.nof_prb [Default 6, 15, 25, 50, 75 and 100]\n");
+  printf("\t-m mcs [Default 0, 9, 17 and 24]\n");
+  printf("\t-t DL transmission mode: 1,2,3,4 [Default 1, 2 and 4]\n");
+  printf("\t-n number of subframes for every configuration [Default %d]\n", nof_subframes);
+  printf("\t-d run the DL chain only\n");
+  printf("\t-u run the UL chain only\n");
+  printf("\t-o JSON output file [Default stdout]\n");
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "pmtnduov")) != -1) {
+    switch (opt) {
+      case 'p':
+        nof_prb = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'm':
+        mcs = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        tm = (int)strtol(argv[optind], NULL, 10) - 1;
+        break;
+      case 'n':
+        nof_subframes = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'd':
+        run_ul = false;
+        break;
+      case 'u':
+        run_dl = false;
+        break;
+      case 'o':
+        output_file = argv[optind];
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static uint64_t bench_time_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000UL + (uint64_t)ts.tv_nsec;
+}
+
+/* Subframes 0 and 5 carry the synchronization signals and the PBCH, which leave too few resource elements for the
+ * highest MCS with small bandwidths. They are skipped so that every configuration runs at its nominal rate. */
+static uint32_t bench_tti(uint32_t sf_count)
+{
+  static const uint32_t sf_idx[8] = {1, 2, 3, 4, 6, 7, 8, 9};
+  return (sf_count / 8) * 10 + sf_idx[sf_count % 8];
+}
+
+static int bench_dl(srsran_random_t random, uint32_t prb, uint32_t tm_, uint32_t mcs_, bench_result_t* res)
+{
+  int                     ret                              = SRSRAN_ERROR;
+  srsran_enb_dl_t*        enb_dl                           = calloc(1, sizeof(srsran_enb_dl_t));
+  srsran_ue_dl_t*         ue_dl                            = calloc(1, sizeof(srsran_ue_dl_t));
+  cf_t*                   signal_buffer[SRSRAN_MAX_PORTS]  = {};
+  srsran_softbuffer_tx_t  softbuffer_tx[SRSRAN_MAX_TB]     = {};
+  srsran_softbuffer_rx_t  softbuffer_rx[SRSRAN_MAX_TB]     = {};
+  srsran_softbuffer_tx_t* softbuffer_tx_ptr[SRSRAN_MAX_TB] = {};
+  uint8_t*                data_tx[SRSRAN_MAX_TB]           = {};
+  uint8_t*                data_rx[SRSRAN_MAX_TB]           = {};
+  srsran_crc_t            crc_tb                           = {};
+
+  srsran_cell_t cell   = {};
+  cell.nof_prb         = prb;
+  cell.nof_ports       = (tm_ == SRSRAN_TM1) ? 1 : 2;
+  cell.id              = 1;
+  cell.cp              = SRSRAN_CP_NORM;
+  cell.phich_resources = SRSRAN_PHICH_R_1;
+  cell.phich_length    = SRSRAN_PHICH_NORM;
+  cell.frame_type      = SRSRAN_FDD;
+
+  res->link         = "dl";
+  res->nof_prb      = prb;
+  res->mcs          = mcs_;
+  res->tm           = tm_ + 1;
+  res->nof_tx_ports = cell.nof_ports;
+  res->nof_rx_ant   = cell.nof_ports;
+
+  if (enb_dl == NULL || ue_dl == NULL) {
+    ERROR("Error allocating eNb/UE DL");
+    goto quit;
+  }
+
+  for (uint32_t i = 0; i < cell.nof_ports; i++) {
+    signal_buffer[i] = srsran_vec_cf_malloc(SRSRAN_SF_LEN_PRB(cell.nof_prb));
+    if (!signal_buffer[i]) {
+      ERROR("Error allocating buffer");
+      goto quit;
+    }
+  }
+
+  for (uint32_t i = 0; i < SRSRAN_MAX_TB; i++) {
+    if (srsran_softbuffer_tx_init(&softbuffer_tx[i], cell.nof_prb) ||
+        srsran_softbuffer_rx_init(&softbuffer_rx[i], cell.nof_prb)) {
+      ERROR("Error initiating softbuffers");
+      goto quit;
+    }
+    softbuffer_tx_ptr[i] = &softbuffer_tx[i];
+
+    data_tx[i] = srsran_vec_u8_malloc(MAX_DATABUFFER_SIZE);
+    data_rx[i] = srsran_vec_u8_malloc(MAX_DATABUFFER_SIZE);
+    if (!data_tx[i] || !data_rx[i]) {
+      ERROR("Error allocating data buffers");
+      goto quit;
+    }
+  }
+
+  if (srsran_crc_init(&crc_tb, SRSRAN_LTE_CRC24A, 24)) {
+    ERROR("Error initiating CRC");
+    goto quit;
+  }
+
+  if (srsran_enb_dl_init(enb_dl, signal_buffer, cell.nof_prb) || srsran_enb_dl_set_cell(enb_dl, cell)) {
+    ERROR("Error initiating eNb downlink");
+    goto quit;
+  }
+
+  if (srsran_ue_dl_init(ue_dl, signal_buffer, cell.nof_prb, cell.nof_ports) || srsran_ue_dl_set_cell(ue_dl, cell)) {
+    ERROR("Error initiating UE downlink");
+    goto quit;
+  }
+
+  // PDCCH candidates of every subframe
+  uint32_t              nof_locations[SRSRAN_NOF_SF_X_FRAME];
+  srsran_dci_location_t dci_locations[SRSRAN_NOF_SF_X_FRAME][SRSRAN_MAX_CANDIDATES_UE];
+  for (uint32_t i = 0; i < SRSRAN_NOF_SF_X_FRAME; i++) {
+    srsran_dl_sf_cfg_t sf_cfg_dl = {};
+    sf_cfg_dl.tti                = i;
+    sf_cfg_dl.cfi                = cfi;
+    sf_cfg_dl.sf_type            = SRSRAN_SF_NORM;
+
+    nof_locations[i] =
+        srsran_pdcch_ue_locations(&enb_dl->pdcch, &sf_cfg_dl, dci_locations[i], SRSRAN_MAX_CANDIDATES_UE, rnti);
+  }
+
+  // DCI allocating the whole bandwidth
+  srsran_dci_cfg_t dci_cfg    = {};
+  srsran_dci_dl_t  dci        = {};
+  dci.rnti                    = rnti;
+  dci.alloc_type              = SRSRAN_RA_ALLOC_TYPE0;
+  dci.type0_alloc.rbg_bitmask = 0xffffffff;
+  dci.tb[1].rv                = 1;
+  if (tm_ < SRSRAN_TM3) {
+    dci.format        = SRSRAN_DCI_FORMAT1;
+    dci.tb[0].mcs_idx = mcs_;
+  } else {
+    dci.format = (tm_ == SRSRAN_TM3) ? SRSRAN_DCI_FORMAT2A : SRSRAN_DCI_FORMAT2;
+    for (uint32_t i = 0; i < SRSRAN_MAX_TB; i++) {
+      dci.tb[i].mcs_idx = mcs_;
+      dci.tb[i].rv      = 0;
+      dci.tb[i].cw_idx  = i;
+    }
+  }
+
+  srsran_ue_dl_cfg_t ue_dl_cfg           = {};
+  ue_dl_cfg.cfg.tm                       = (srsran_tm_t)tm_;
+  ue_dl_cfg.cfg.dci                      = dci_cfg;
+  ue_dl_cfg.cfg.pdsch.decoder_type       = SRSRAN_MIMO_DECODER_MMSE;
+  ue_dl_cfg.cfg.pdsch.max_nof_iterations = max_iterations;
+  ue_dl_cfg.cfg.pdsch.power_scale        = true;
+  ue_dl_cfg.cfg.pdsch.p_b                = (tm_ > SRSRAN_TM1) ? 1 : 0;
+  ue_dl_cfg.chest_cfg.filter_coef[0]     = 4;
+  ue_dl_cfg.chest_cfg.filter_coef[1]     = 1;
+  ue_dl_cfg.chest_cfg.filter_type        = SRSRAN_CHEST_FILTER_GAUSS;
+  ue_dl_cfg.chest_cfg.noise_alg          = SRSRAN_NOISE_ALG_REFS;
+  ue_dl_cfg.chest_cfg.estimator_alg      = SRSRAN_ESTIMATOR_ALG_AVERAGE;
+  for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+    ue_dl_cfg.cfg.pdsch.softbuffers.rx[i] = &softbuffer_rx[i];
+  }
+
+  for (uint32_t sf_count = 0; sf_count < nof_subframes; sf_count++) {
+    uint32_t tti = bench_tti(sf_count);
+
+    for (uint32_t i = 0; i < SRSRAN_MAX_TB; i++) {
+      srsran_random_byte_vector(random, data_tx[i], MAX_DATABUFFER_SIZE);
+    }
+
+    /*
+     * Run eNb
+     */
+    srsran_dl_sf_cfg_t sf_cfg_dl = {};
+    sf_cfg_dl.tti                = tti % SRSRAN_NOF_SF_X_FRAME;
+    sf_cfg_dl.cfi                = cfi;
+    sf_cfg_dl.sf_type            = SRSRAN_SF_NORM;
+    dci.location                 = dci_locations[sf_cfg_dl.tti][sf_count % nof_locations[sf_cfg_dl.tti]];
+
+    srsran_pdsch_cfg_t pdsch_cfg = {};
+    for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+      pdsch_cfg.softbuffers.tx[i] = softbuffer_tx_ptr[i];
+    }
+    pdsch_cfg.rnti        = rnti;
+    pdsch_cfg.power_scale = true;
+    pdsch_cfg.p_b         = (tm_ > SRSRAN_TM1) ? 1 : 0;
+
+    uint64_t t_start = bench_time_ns();
+    srsran_enb_dl_put_base(enb_dl, &sf_cfg_dl);
+    if (srsran_enb_dl_put_pdcch_dl(enb_dl, &dci_cfg, &dci) ||
+        srsran_ra_dl_dci_to_grant(&cell, &sf_cfg_dl, (srsran_tm_t)tm_, false, &dci, &pdsch_cfg.grant) ||
+        srsran_enb_dl_put_pdsch(enb_dl, &pdsch_cfg, data_tx) < SRSRAN_SUCCESS) {
+      ERROR("Error encoding PDCCH/PDSCH tti=%d", tti);
+      goto quit;
+    }
+    srsran_enb_dl_gen_signal(enb_dl);
+    res->tx_ns += bench_time_ns() - t_start;
+
+    // MIMO perfect crossed channel
+    if (cell.nof_ports > 1) {
+      for (uint32_t i = 0; i < SRSRAN_SF_LEN_PRB(cell.nof_prb); i++) {
+        cf_t x0             = signal_buffer[0][i];
+        cf_t x1             = signal_buffer[1][i];
+        signal_buffer[0][i] = x0 + x1;
+        signal_buffer[1][i] = x0 - x1;
+      }
+    }
+
+    /*
+     * Run UE, the steps of srsran_ue_dl_decode_fft_estimate() are run one by one to time them
+     */
+    srsran_dci_dl_t    dci_dl[SRSRAN_MAX_DCI_MSG]      = {};
+    srsran_pdsch_res_t pdsch_res[SRSRAN_MAX_CODEWORDS] = {};
+    for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+      pdsch_res[i].payload = data_rx[i];
+      srsran_softbuffer_rx_reset(&softbuffer_rx[i]);
+    }
+    float cfi_corr = 0.0f;
+
+    uint64_t t[5];
+    t[0] = bench_time_ns();
+    for (uint32_t i = 0; i < ue_dl->nof_rx_antennas; i++) {
+      srsran_ofdm_rx_sf(&ue_dl->fft[i]);
+    }
+    t[1] = bench_time_ns();
+    srsran_chest_dl_estimate_cfg(&ue_dl->chest, &sf_cfg_dl, &ue_dl_cfg.chest_cfg, ue_dl->sf_symbols, &ue_dl->chest_res);
+    t[2] = bench_time_ns();
+    if (srsran_pcfich_decode(&ue_dl->pcfich, &sf_cfg_dl, &ue_dl->chest_res, ue_dl->sf_symbols, &cfi_corr) < 0 ||
+        srsran_pdcch_extract_llr(&ue_dl->pdcch, &sf_cfg_dl, &ue_dl->chest_res, ue_dl->sf_symbols)) {
+      ERROR("Error decoding PCFICH/PDCCH tti=%d", tti);
+      goto quit;
+    }
+    if (srsran_ue_dl_find_dl_dci(ue_dl, &sf_cfg_dl, &ue_dl_cfg, rnti, dci_dl) < 1 ||
+        srsran_ra_dl_dci_to_grant(&cell, &sf_cfg_dl, (srsran_tm_t)tm_, false, &dci_dl[0], &ue_dl_cfg.cfg.pdsch.grant)) {
+      ERROR("Failed to find the DCI in tti=%d", tti);
+      goto quit;
+    }
+    ue_dl_cfg.cfg.pdsch.rnti = dci_dl[0].rnti;
+    t[3]                     = bench_time_ns();
+    if (srsran_ue_dl_decode_pdsch(ue_dl, &sf_cfg_dl, &ue_dl_cfg.cfg.pdsch, pdsch_res)) {
+      ERROR("Error decoding PDSCH tti=%d", tti);
+      goto quit;
+    }
+    t[4] = bench_time_ns();
+
+    uint64_t fec_ns = 0;
+    for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+      fec_ns += pdsch_res[i].fec_time_ns;
+    }
+    res->stage_ns[STAGE_OFDM] += t[1] - t[0];
+    res->stage_ns[STAGE_CHEST] += t[2] - t[1];
+    res->stage_ns[STAGE_CTRL] += t[3] - t[2];
+    res->stage_ns[STAGE_DEMOD] += t[4] - t[3] - SRSRAN_MIN(fec_ns, t[4] - t[3]);
+    res->stage_ns[STAGE_FEC] += fec_ns;
+    res->rx_ns += t[4] - t[0];
+
+    for (uint32_t i = 0; i < SRSRAN_MAX_TB; i++) {
+      srsran_ra_tb_t* tb = &ue_dl_cfg.cfg.pdsch.grant.tb[i];
+      if (!tb->enabled) {
+        continue;
+      }
+
+      uint64_t t_crc = bench_time_ns();
+      srsran_crc_checksum_byte(&crc_tb, data_rx[i], tb->tbs);
+      res->stage_ns[STAGE_CRC] += bench_time_ns() - t_crc;
+
+      res->nof_tb++;
+      res->tx_bits += tb->tbs;
+      if (pdsch_res[i].crc && memcmp(data_tx[i], data_rx[i], tb->tbs / 8) == 0) {
+        res->rx_bits += tb->tbs;
+      } else {
+        res->nof_errors++;
+      }
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+quit:
+  if (enb_dl) {
+    srsran_enb_dl_free(enb_dl);
+    free(enb_dl);
+  }
+  if (ue_dl) {
+    srsran_ue_dl_free(ue_dl);
+    free(ue_dl);
+  }
+  for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    if (signal_buffer[i]) {
+      free(signal_buffer[i]);
+    }
+  }
+  for (uint32_t i = 0; i < SRSRAN_MAX_TB; i++) {
+    srsran_softbuffer_tx_free(&softbuffer_tx[i]);
+    srsran_softbuffer_rx_free(&softbuffer_rx[i]);
+    if (data_tx[i]) {
+      free(data_tx[i]);
+    }
+    if (data_rx[i]) {
+      free(data_rx[i]);
+    }
+  }
+  return ret;
+}
+
+static int bench_ul(srsran_random_t random, uint32_t prb, uint32_t mcs_, bench_result_t* res)
+{
+  int                               ret           = SRSRAN_ERROR;
+  cf_t*                             buffer        = NULL;
+  uint8_t*                          data_tx       = NULL;
+  uint8_t*                          data_rx       = NULL;
+  srsran_ue_ul_t                    ue_ul         = {};
+  srsran_enb_ul_t                   enb_ul        = {};
+  srsran_softbuffer_tx_t            softbuffer_tx = {};
+  srsran_softbuffer_rx_t            softbuffer_rx = {};
+  srsran_refsignal_dmrs_pusch_cfg_t dmrs_cfg      = {};
+  srsran_crc_t                      crc_tb        = {};
+
+  srsran_cell_t cell   = {};
+  cell.nof_prb         = prb;
+  cell.nof_ports       = 1;
+  cell.id              = 1;
+  cell.cp              = SRSRAN_CP_NORM;
+  cell.phich_resources = SRSRAN_PHICH_R_1;
+  cell.phich_length    = SRSRAN_PHICH_NORM;
+  cell.frame_type      = SRSRAN_FDD;
+
+  res->link         = "ul";
+  res->nof_prb      = prb;
+  res->mcs          = mcs_;
+  res->nof_tx_ports = 1;
+  res->nof_rx_ant   = 1;
+
+  buffer  = srsran_vec_cf_malloc(SRSRAN_SF_LEN_PRB(cell.nof_prb));
+  data_tx = srsran_vec_u8_malloc(MAX_DATABUFFER_SIZE);
+  data_rx = srsran_vec_u8_malloc(MAX_DATABUFFER_SIZE);
+  if (!buffer || !data_tx || !data_rx) {
+    ERROR("Error allocating buffers");
+    goto quit;
+  }
+
+  if (srsran_softbuffer_tx_init(&softbuffer_tx, cell.nof_prb) ||
+      srsran_softbuffer_rx_init(&softbuffer_rx, cell.nof_prb)) {
+    ERROR("Error initiating softbuffers");
+    goto quit;
+  }
+
+  if (srsran_crc_init(&crc_tb, SRSRAN_LTE_CRC24A, 24)) {
+    ERROR("Error initiating CRC");
+    goto quit;
+  }
+
+  if (srsran_ue_ul_init(&ue_ul, buffer, cell.nof_prb) || srsran_ue_ul_set_cell(&ue_ul, cell)) {
+    ERROR("Error initiating UE uplink");
+    goto quit;
+  }
+
+  if (srsran_enb_ul_init(&enb_ul, buffer, cell.nof_prb) || srsran_enb_ul_set_cell(&enb_ul, cell, &dmrs_cfg, NULL)) {
+    ERROR("Error initiating eNb uplink");
+    goto quit;
+  }
+
+  // Grant of the largest number of PRB the DFT precoding supports, without hopping
+  srsran_ul_sf_cfg_t         ul_sf       = {};
+  srsran_pusch_hopping_cfg_t hopping_cfg = {};
+  srsran_dci_ul_t            dci         = {};
+  srsran_ue_ul_cfg_t         ue_ul_cfg   = {};
+  dci.rnti                               = rnti;
+  dci.freq_hop_fl                        = SRSRAN_RA_PUSCH_HOP_DISABLED;
+  dci.type2_alloc.riv                    = srsran_ra_type2_to_riv(srsran_dft_precoding_get_valid_prb(prb), 0, prb);
+  dci.tb.mcs_idx                         = mcs_;
+  if (srsran_ra_ul_dci_to_grant(&cell, &ul_sf, &hopping_cfg, &dci, &ue_ul_cfg.ul_cfg.pusch.grant)) {
+    ERROR("Error computing the UL grant");
+    goto quit;
+  }
+  ue_ul_cfg.ul_cfg.pusch.grant.n_prb_tilde[0] = ue_ul_cfg.ul_cfg.pusch.grant.n_prb[0];
+  ue_ul_cfg.ul_cfg.pusch.grant.n_prb_tilde[1] = ue_ul_cfg.ul_cfg.pusch.grant.n_prb[1];
+  ue_ul_cfg.ul_cfg.pusch.rnti                 = rnti;
+  ue_ul_cfg.ul_cfg.pusch.enable_64qam         = true;
+  ue_ul_cfg.ul_cfg.pusch.softbuffers.tx       = &softbuffer_tx;
+  ue_ul_cfg.ul_cfg.dmrs                       = dmrs_cfg;
+  ue_ul_cfg.grant_available                   = true;
+
+  srsran_pusch_cfg_t pusch_cfg = ue_ul_cfg.ul_cfg.pusch;
+  pusch_cfg.softbuffers.rx     = &softbuffer_rx;
+  pusch_cfg.max_nof_iterations = max_iterations;
+
+  for (uint32_t sf_count = 0; sf_count < nof_subframes; sf_count++) {
+    ul_sf.tti = bench_tti(sf_count);
+
+    srsran_random_byte_vector(random, data_tx, MAX_DATABUFFER_SIZE);
+
+    /*
+     * Run UE
+     */
+    srsran_pusch_data_t pusch_data = {};
+    pusch_data.ptr                 = data_tx;
+
+    uint64_t t_start = bench_time_ns();
+    if (srsran_ue_ul_encode(&ue_ul, &ul_sf, &ue_ul_cfg, &pusch_data) < SRSRAN_SUCCESS) {
+      ERROR("Error encoding PUSCH tti=%d", ul_sf.tti);
+      goto quit;
+    }
+    res->tx_ns += bench_time_ns() - t_start;
+
+    /*
+     * Run eNb, the steps of srsran_enb_ul_get_pusch() are run one by one to time them
+     */
+    srsran_pusch_res_t pusch_res = {};
+    pusch_res.data               = data_rx;
+    srsran_softbuffer_rx_reset(&softbuffer_rx);
+
+    uint64_t t[4];
+    t[0] = bench_time_ns();
+    srsran_enb_ul_fft(&enb_ul);
+    t[1] = bench_time_ns();
+    srsran_chest_ul_estimate_pusch(&enb_ul.chest, &ul_sf, &pusch_cfg, enb_ul.sf_symbols, &enb_ul.chest_res);
+    t[2] = bench_time_ns();
+    if (srsran_pusch_decode(&enb_ul.pusch, &ul_sf, &pusch_cfg, &enb_ul.chest_res, enb_ul.sf_symbols, &pusch_res) <
+        SRSRAN_SUCCESS) {
+      ERROR("Error decoding PUSCH tti=%d", ul_sf.tti);
+      goto quit;
+    }
+    t[3] = bench_time_ns();
+
+    uint64_t fec_ns = srsran_sch_last_decode_time_ns(&enb_ul.pusch.ul_sch);
+    res->stage_ns[STAGE_OFDM] += t[1] - t[0];
+    res->stage_ns[STAGE_CHEST] += t[2] - t[1];
+    res->stage_ns[STAGE_DEMOD] += t[3] - t[2] - SRSRAN_MIN(fec_ns, t[3] - t[2]);
+    res->stage_ns[STAGE_FEC] += fec_ns;
+    res->rx_ns += t[3] - t[0];
+
+    uint32_t tbs   = pusch_cfg.grant.tb.tbs;
+    uint64_t t_crc = bench_time_ns();
+    srsran_crc_checksum_byte(&crc_tb, data_rx, tbs);
+    res->stage_ns[STAGE_CRC] += bench_time_ns() - t_crc;
+
+    res->nof_tb++;
+    res->tx_bits += tbs;
+    if (pusch_res.crc && memcmp(data_tx, data_rx, tbs / 8) == 0) {
+      res->rx_bits += tbs;
+    } else {
+      res->nof_errors++;
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+quit:
+  srsran_ue_ul_free(&ue_ul);
+  srsran_enb_ul_free(&enb_ul);
+  srsran_softbuffer_tx_free(&softbuffer_tx);
+  srsran_softbuffer_rx_free(&softbuffer_rx);
+  if (buffer) {
+    free(buffer);
+  }
+  if (data_tx) {
+    free(data_tx);
+  }
+  if (data_rx) {
+    free(data_rx);
+  }
+  return ret;
+}
+
+/* Times are given in microseconds per subframe and the throughput in Mbps processed by the receiver */
+static void print_result(FILE* f, const bench_result_t* res, bool last)
+{
+  double nof_sf = (double)nof_subframes;
+
+  fprintf(f, "    {\"link\": \"%s\", \"nof_prb\": %d, \"mcs\": %d, ", res->link, res->nof_prb, res->mcs);
+  if (res->tm) {
+    fprintf(f, "\"tm\": %d, ", res->tm);
+  }
+  fprintf(f, "\"nof_tx_ports\": %d, \"nof_rx_ant\": %d, ", res->nof_tx_ports, res->nof_rx_ant);
+  fprintf(f,
+          "\"nof_tb\": %d, \"bler\": %.4f, \"granted_mbps\": %.2f, ",
+          res->nof_tb,
+          res->nof_tb ? (double)res->nof_errors / res->nof_tb : 0.0,
+          (double)res->tx_bits / nof_sf / 1000.0);
+  fprintf(f,
+          "\"tx_mbps\": %.2f, \"rx_mbps\": %.2f, \"tx_us\": %.2f, \"rx_us\": %.2f, \"stages_us\": {",
+          res->tx_ns ? (double)res->tx_bits * 1000.0 / res->tx_ns : 0.0,
+          res->rx_ns ? (double)res->rx_bits * 1000.0 / res->rx_ns : 0.0,
+          (double)res->tx_ns / nof_sf / 1000.0,
+          (double)res->rx_ns / nof_sf / 1000.0);
+  for (uint32_t i = 0; i < STAGE_NOF; i++) {
+    fprintf(f,
+            "\"%s\": %.2f%s",
+            stage_names[i],
+            (double)res->stage_ns[i] / nof_sf / 1000.0,
+            (i + 1 < STAGE_NOF) ? ", " : "");
+  }
+  fprintf(f, "}}%s\n", last ? "" : ",");
+}
+
+int main(int argc, char** argv)
+{
+  int             ret    = SRSRAN_ERROR;
+  srsran_random_t random = srsran_random_init(0);
+  FILE*           f      = stdout;
+
+  parse_args(argc, argv);
+
+  uint32_t prb_list[6];
+  uint32_t mcs_list[4];
+  uint32_t tm_list[3];
+  uint32_t nof_prbs = 1, nof_mcs = 1, nof_tms = 1;
+
+  if (nof_prb > 0) {
+    prb_list[0] = (uint32_t)nof_prb;
+  } else {
+    nof_prbs = sizeof(default_prb) / sizeof(default_prb[0]);
+    memcpy(prb_list, default_prb, sizeof(default_prb));
+  }
+  if (mcs >= 0) {
+    mcs_list[0] = (uint32_t)mcs;
+  } else {
+    nof_mcs = sizeof(default_mcs) / sizeof(default_mcs[0]);
+    memcpy(mcs_list, default_mcs, sizeof(default_mcs));
+  }
+  if (tm >= 0) {
+    tm_list[0] = (uint32_t)tm;
+  } else {
+    nof_tms = sizeof(default_tm) / sizeof(default_tm[0]);
+    memcpy(tm_list, default_tm, sizeof(default_tm));
+  }
+
+  uint32_t        nof_results = nof_prbs * nof_mcs * (run_dl ? nof_tms : 0) + nof_prbs * nof_mcs * (run_ul ? 1 : 0);
+  bench_result_t* results     = calloc(nof_results, sizeof(bench_result_t));
+  uint32_t        n           = 0;
+  if (results == NULL) {
+    ERROR("Error allocating results");
+    goto quit;
+  }
+
+  for (uint32_t p = 0; p < nof_prbs; p++) {
+    for (uint32_t m = 0; m < nof_mcs; m++) {
+      for (uint32_t i = 0; run_dl && i < nof_tms; i++) {
+        if (bench_dl(random, prb_list[p], tm_list[i], mcs_list[m], &results[n++])) {
+          goto quit;
+        }
+      }
+      if (run_ul && bench_ul(random, prb_list[p], mcs_list[m], &results[n++])) {
+        goto quit;
+      }
+    }
+  }
+
+  if (output_file) {
+    f = fopen(output_file, "w");
+    if (f == NULL) {
+      ERROR("Error opening %s", output_file);
+      goto quit;
+    }
+  }
+
+  fprintf(f, "{\n  \"nof_subframes\": %d,\n  \"results\": [\n", nof_subframes);
+  for (uint32_t i = 0; i < nof_results; i++) {
+    print_result(f, &results[i], i + 1 == nof_results);
+  }
+  fprintf(f, "  ]\n}\n");
+
+  if (f != stdout) {
+    fclose(f);
+  }
+
+  // The measurements are only meaningful if everything was decoded
+  ret = SRSRAN_SUCCESS;
+  for (uint32_t i = 0; i < nof_results; i++) {
+    if (results[i].nof_errors) {
+      ERROR("%s nof_prb=%d mcs=%d tm=%d failed %d of %d transport blocks",
+            results[i].link,
+            results[i].nof_prb,
+            results[i].mcs,
+            results[i].tm,
+            results[i].nof_errors,
+            results[i].nof_tb);
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+quit:
+  if (results) {
+    free(results);
+  }
+  srsran_random_free(random);
+  return ret;
+}
@@ -182,8 +182,12 @@ static int work_gnb_dl(srsran_gnb_dl_t*       gnb_dl,
     return SRSRAN_ERROR;
   }
 
-  // Put PDSCH transmission
-  if (srsran_gnb_dl_pdsch_put(gnb_dl, slot, &pdsch_cfg, data_tx) < SRSRAN_SUCCESS) {
+  // Put PDSCH transmission, alternating the encoders
+  if (srsran_gnb_dl_pdsch_put_dmrs(gnb_dl, slot, &pdsch_cfg) < SRSRAN_SUCCESS) {
+    ERROR("Error putting PDSCH DMRS");
+    return SRSRAN_ERROR;
+  }
+  if (srsran_gnb_dl_pdsch_encode(gnb_dl, slot->idx % gnb_dl->nof_pdsch_enc, &pdsch_cfg, data_tx) < SRSRAN_SUCCESS) {
     ERROR("Error putting PDSCH");
     return SRSRAN_ERROR;
   }
@@ -263,6 +267,7 @@ int main(int argc, char** argv)
   gnb_dl_args.pdsch.sch.disable_simd = false;
   gnb_dl_args.pdcch.disable_simd     = false;
   gnb_dl_args.nof_max_prb            = carrier.nof_prb;
+  gnb_dl_args.nof_pdsch_encoders     = 2;
   gnb_dl_args.srate_hz               = SRSRAN_SUBC_SPACING_NR(carrier.scs) * srsran_min_symbol_sz_rb(carrier.nof_prb);
 
   srsran_pdcch_cfg_nr_t pdcch_cfg = {};
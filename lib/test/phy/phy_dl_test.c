@@ -19,6 +19,7 @@
  *
  */
 
+#include <inttypes.h>
 #include <srsran/phy/utils/random.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -45,6 +46,7 @@ static uint32_t mcs                     = 20;
 static int      cross_carrier_indicator = -1;
 static bool     enable_256qam           = false;
 static float    snr_db                  = NAN; // SNR in dB
+static float    pdcch_prescreen_ratio   = 0.0f;
 
 void usage(char* prog)
 {
@@ -58,6 +60,7 @@ void usage(char* prog)
   printf("\t-t Transmission mode: 1,2,3,4 [Default %d]\n", transmission_mode + 1);
   printf("\t-m mcs [Default %d]\n", mcs);
   printf("\t-S SNR in dB [Default %+.2f]\n", snr_db);
+  printf("\t-P PDCCH candidate pre-screening energy ratio, 0 disables it [Default %.2f]\n", pdcch_prescreen_ratio);
   printf("\tAdvanced parameters:\n");
   if (cross_carrier_indicator >= 0) {
     printf("\t\t-a carrier-indicator [Default %d]\n", cross_carrier_indicator);
@@ -96,7 +99,7 @@ void parse_args(int argc, char** argv)
     nof_rx_ant     = 2;
   }
 
-  while ((opt = getopt(argc, argv, "cfapndvqstmES")) != -1) {
+  while ((opt = getopt(argc, argv, "cfapndvqstmESP")) != -1) {
     switch (opt) {
       case 't':
         transmission_mode = (uint32_t)strtol(argv[optind], NULL, 10) - 1;
@@ -126,6 +129,9 @@ void parse_args(int argc, char** argv)
       case 'S':
         snr_db = strtof(argv[optind], NULL);
         break;
+      case 'P':
+        pdcch_prescreen_ratio = strtof(argv[optind], NULL);
+        break;
       case 'E':
         cell.cp = ((uint32_t)strtol(argv[optind], NULL, 10)) ? SRSRAN_CP_EXT : SRSRAN_CP_NORM;
         break;
@@ -592,6 +598,7 @@ int main(int argc, char** argv)
     srsran_dci_dl_t    dci_dl[SRSRAN_MAX_DCI_MSG] = {};
 
     ue_dl_cfg.cfg.tm                       = transmission_mode;
+    ue_dl_cfg.pdcch_prescreen_ratio        = pdcch_prescreen_ratio;
     ue_dl_cfg.cfg.pdsch.p_a                = 0.0;
     ue_dl_cfg.cfg.pdsch.power_scale        = false;
     ue_dl_cfg.cfg.pdsch.decoder_type       = SRSRAN_MIMO_DECODER_MMSE;
@@ -671,6 +678,11 @@ int main(int argc, char** argv)
 
   printf("BLER: %5.1f%%\n", (float)count_failures / (float)count_tbs * 100.0f);
 
+  printf("PDCCH candidates: %" PRIu64 "; decoded: %" PRIu64 "; skipped by pre-screening: %" PRIu64 "\n",
+         ue_dl->pdcch_stats.nof_candidates,
+         ue_dl->pdcch_stats.nof_decoded,
+         ue_dl->pdcch_stats.nof_skipped);
+
   if (isnormal(snr_db)) {
     printf("SNR Real: %+.2f; estimated: %+.2f\n", snr_db, snr_db_avg / nof_subframes);
   }
@@ -47,14 +47,15 @@ static int test_pucch_ca(srsran_ack_nack_feedback_mode_t ack_nack_feedback_mode,
       SRSRAN_FDD,
   };
 
-  cf_t*                             buffer         = NULL;
-  srsran_refsignal_dmrs_pusch_cfg_t dmrs_pusch_cfg = {}; // Use default
-  srsran_ue_ul_t                    ue_ul          = {};
-  srsran_ue_ul_cfg_t                ue_ul_cfg      = {};
-  srsran_enb_ul_t                   enb_ul         = {};
-  srsran_ul_sf_cfg_t                ul_sf          = {};
-  srsran_pucch_res_t                pucch_res      = {};
-  srsran_pusch_data_t               pusch_data     = {};
+  cf_t*                             buffer          = NULL;
+  srsran_refsignal_dmrs_pusch_cfg_t dmrs_pusch_cfg  = {}; // Use default
+  srsran_ue_ul_t                    ue_ul           = {};
+  srsran_ue_ul_cfg_t                ue_ul_cfg       = {};
+  srsran_enb_ul_t                   enb_ul          = {};
+  srsran_ul_sf_cfg_t                ul_sf           = {};
+  srsran_pucch_res_t                pucch_res       = {};
+  srsran_pucch_res_t                pucch_res_batch = {};
+  srsran_pusch_data_t               pusch_data      = {};
 
   // Basic default args
   pucch_cfg.delta_pucch_shift      = 1;                      // 1, 2, 3
@@ -111,11 +112,21 @@ static int test_pucch_ca(srsran_ack_nack_feedback_mode_t ack_nack_feedback_mode,
     // Process UL signal
     srsran_enb_ul_fft(&enb_ul);
 
+    srsran_pucch_cfg_t pucch_cfg_batch = pucch_cfg;
     TESTASSERT(!srsran_enb_ul_get_pucch(&enb_ul, &ul_sf, &pucch_cfg, &pucch_res));
 
     TESTASSERT(pucch_res.detected);
     TESTASSERT(pucch_res.uci_data.ack.valid);
 
+    // The batched detection shall decode the same
+    TESTASSERT(!srsran_enb_ul_get_pucch_batch(&enb_ul, &ul_sf, &pucch_cfg_batch, &pucch_res_batch, 1));
+    TESTASSERT(pucch_res_batch.detected);
+    TESTASSERT(pucch_res_batch.uci_data.ack.valid);
+    TESTASSERT(pucch_cfg_batch.format == pucch_cfg.format);
+    TESTASSERT(memcmp(pucch_res_batch.uci_data.ack.ack_value,
+                      pucch_res.uci_data.ack.ack_value,
+                      sizeof(pucch_res.uci_data.ack.ack_value)) == 0);
+
     // Check results
     for (int i = 0, k = 0; i < nof_carriers; i++) {
       for (int j = 0; j < nof_tb[i]; j++, k++) {
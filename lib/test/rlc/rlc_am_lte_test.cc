@@ -331,6 +331,83 @@ int segment_test(bool in_seq_rx)
   return SRSRAN_SUCCESS;
 }
 
+// PDUs are written from a scratch buffer that is overwritten after each write_pdu(), as done with the MAC PDU buffers
+int in_sequence_rx_test()
+{
+  rlc_am_tester         tester(true, nullptr);
+  srsran::timer_handler timers(8);
+  int                   len = 0;
+
+  rlc_am rlc1(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+  rlc_am rlc2(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_2"), 1, &tester, &tester, &timers);
+
+  if (not rlc1.configure(rlc_config_t::default_rlc_am_config())) {
+    return -1;
+  }
+
+  if (not rlc2.configure(rlc_config_t::default_rlc_am_config())) {
+    return -1;
+  }
+
+  // Push 5 SDUs into RLC1
+  for (int i = 0; i < NBUFS; i++) {
+    unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    for (int j = 0; j < 10; j++) {
+      sdu->msg[j] = i * 10 + j;
+    }
+    sdu->N_bytes    = 10;
+    sdu->md.pdcp_sn = i;
+    rlc1.write_sdu(std::move(sdu));
+  }
+
+  // Read PDUs from RLC1, the SDUs are segmented and concatenated across PDUs
+  byte_buffer_t pdu_bufs[20];
+  int           n_pdus = 0;
+  while (rlc1.get_buffer_state() > 0) {
+    len                        = rlc1.read_pdu(pdu_bufs[n_pdus].msg, 7);
+    pdu_bufs[n_pdus++].N_bytes = len;
+  }
+  TESTASSERT(n_pdus > 4);
+
+  // Deliver SN=0, SN=2, SN=1 and then the rest in order
+  std::vector<int> order = {0, 2, 1};
+  for (int i = 3; i < n_pdus; i++) {
+    order.push_back(i);
+  }
+  byte_buffer_t scratch;
+  for (int sn : order) {
+    memcpy(scratch.msg, pdu_bufs[sn].msg, pdu_bufs[sn].N_bytes);
+    rlc2.write_pdu(scratch.msg, pdu_bufs[sn].N_bytes);
+    memset(scratch.msg, 0xff, pdu_bufs[sn].N_bytes);
+  }
+
+  TESTASSERT(tester.sdus.size() == NBUFS);
+  for (uint32_t i = 0; i < tester.sdus.size(); i++) {
+    TESTASSERT(tester.sdus[i]->N_bytes == 10);
+    for (int j = 0; j < 10; j++) {
+      TESTASSERT(tester.sdus[i]->msg[j] == i * 10 + j);
+    }
+  }
+
+  // Read status PDU from RLC2, all the PDUs have been received
+  byte_buffer_t status_buf;
+  len                = rlc2.read_pdu(status_buf.msg, 10);
+  status_buf.N_bytes = len;
+
+  rlc_status_pdu_t status_check = {};
+  rlc_am_read_status_pdu(status_buf.msg, status_buf.N_bytes, &status_check);
+  TESTASSERT(status_check.ack_sn == (uint32_t)n_pdus);
+  TESTASSERT(status_check.N_nack == 0);
+
+  // Write status PDU to RLC1
+  rlc1.write_pdu(status_buf.msg, status_buf.N_bytes);
+
+  // Check statistics
+  TESTASSERT(rx_is_tx(rlc1.get_metrics(), rlc2.get_metrics()));
+
+  return SRSRAN_SUCCESS;
+}
+
 int retx_test()
 {
   rlc_am_tester tester(true, nullptr);
@@ -4127,6 +4204,11 @@ int main(int argc, char** argv)
     exit(-1);
   };
 
+  if (in_sequence_rx_test()) {
+    printf("in_sequence_rx_test failed\n");
+    exit(-1);
+  };
+
   if (retx_test()) {
     printf("retx_test failed\n");
     exit(-1);
@@ -3435,6 +3435,102 @@ int full_rx_window_t_reassembly_expiry(rlc_am_nr_sn_size_t sn_size)
   return SRSRAN_SUCCESS;
 }
 
+// Lose scattered PDUs of a long burst that wraps around the SN space and check the NACKs of the status PDU, and that
+// they are all scheduled for retransmission, including a NACK range that wraps around
+int sparse_lost_pdus_status_test(rlc_am_nr_sn_size_t sn_size)
+{
+  rlc_am_tester tester(false, nullptr);
+  timer_handler timers(8);
+
+  auto&               test_logger = srslog::fetch_basic_logger("TESTER  ");
+  test_delimit_logger delimiter("Sparse lost PDUs status test ({} bit SN)", to_number(sn_size));
+  rlc_am              rlc1(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+  rlc_am              rlc2(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_AM_2"), 1, &tester, &tester, &timers);
+
+  rlc_am_nr_tx* tx1 = dynamic_cast<rlc_am_nr_tx*>(rlc1.get_tx());
+  rlc_am_nr_rx* rx2 = dynamic_cast<rlc_am_nr_rx*>(rlc2.get_rx());
+
+  auto cfg              = rlc_config_t::default_rlc_am_nr_config(to_number(sn_size));
+  cfg.am_nr.t_poll_retx = -1;
+  if (not rlc1.configure(cfg)) {
+    return -1;
+  }
+  if (not rlc2.configure(cfg)) {
+    return -1;
+  }
+  uint32_t mod_nr = cardinality(cfg.am_nr.tx_sn_field_length);
+
+  // Start 100 SNs before the SN space wraps around
+  constexpr uint32_t nof_sdus = 300;
+  uint32_t           start_sn = mod_nr - 100;
+
+  rlc_am_nr_tx_state_t tx_st = {};
+  tx_st.tx_next_ack          = start_sn;
+  tx_st.tx_next              = start_sn;
+  tx_st.poll_sn              = start_sn;
+  tx1->set_tx_state(tx_st);
+
+  rlc_am_nr_rx_state_t rx_st   = {};
+  rx_st.rx_next                = start_sn;
+  rx_st.rx_next_status_trigger = start_sn;
+  rx_st.rx_highest_status      = start_sn;
+  rx_st.rx_next_highest        = start_sn;
+  rx2->set_rx_state(rx_st);
+
+  // Lose every 7th PDU and the ones with the last and first SN of the SN space
+  constexpr uint32_t    payload_size = 3; // Give the SDU the size of 3 bytes
+  uint32_t              header_size  = sn_size == rlc_am_nr_sn_size_t::size12bits ? 2 : 3;
+  std::vector<uint32_t> lost_sns;
+  for (uint32_t i = 0; i < nof_sdus; ++i) {
+    unique_byte_buffer_t sdu_buf = srsran::make_byte_buffer();
+    sdu_buf->msg[0]              = i;            // Write the index into the buffer
+    sdu_buf->N_bytes             = payload_size; // Give each buffer a size of 3 bytes
+    sdu_buf->md.pdcp_sn          = i;            // PDCP SN for notifications
+    rlc1.write_sdu(std::move(sdu_buf));
+
+    unique_byte_buffer_t pdu_buf = srsran::make_byte_buffer();
+    pdu_buf->N_bytes             = rlc1.read_pdu(pdu_buf->msg, 100);
+
+    uint32_t sn = (start_sn + i) % mod_nr;
+    if (i % 7 == 0 || sn == mod_nr - 1 || sn == 0) {
+      lost_sns.push_back(sn);
+    } else {
+      rlc2.write_pdu(pdu_buf->msg, pdu_buf->N_bytes);
+    }
+  }
+  // The last PDU is received, so all lost SNs are before RX_Next_Highest
+  TESTASSERT_EQ((start_sn + nof_sdus) % mod_nr, rx2->get_rx_state().rx_next_highest);
+
+  // Step timers until t-Reassembly expires twice, the second time it was started with RX_Next_Highest
+  for (int cnt = 0; cnt < 70; cnt++) {
+    timers.step_all();
+  }
+  TESTASSERT_EQ((start_sn + nof_sdus) % mod_nr, rx2->get_rx_state().rx_highest_status);
+
+  // Read status PDU and check that exactly the lost SNs are NACKed
+  unique_byte_buffer_t status_buf = srsran::make_byte_buffer();
+  status_buf->N_bytes             = rlc2.read_pdu(status_buf->msg, 1000);
+  rlc_am_nr_status_pdu_t status_check(sn_size);
+  rlc_am_nr_read_status_pdu(status_buf.get(), sn_size, &status_check);
+  TESTASSERT_EQ((start_sn + nof_sdus) % mod_nr, status_check.ack_sn);
+  std::vector<uint32_t> nacked_sns;
+  for (const rlc_status_nack_t& nack : status_check.nacks) {
+    TESTASSERT_EQ(false, nack.has_so);
+    uint32_t range = nack.has_nack_range ? nack.nack_range : 1;
+    for (uint32_t k = 0; k < range; k++) {
+      nacked_sns.push_back((nack.nack_sn + k) % mod_nr);
+    }
+  }
+  TESTASSERT(nacked_sns == lost_sns);
+
+  // Deliver status PDU to RLC1, all lost SDUs are scheduled for retransmission
+  rlc1.write_pdu(status_buf->msg, status_buf->N_bytes);
+  TESTASSERT_EQ(lost_sns.size(), tx1->get_retx_queue_size());
+  TESTASSERT_EQ(lost_sns.size() * (header_size + payload_size), rlc1.get_buffer_state());
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   // Setup the log message spy to intercept error and warning log entries from RLC
@@ -3487,6 +3583,7 @@ int main()
     TESTASSERT(rx_nack_range_with_so_ending_with_full_sdu_test(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(out_of_order_status(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(lost_status_and_advanced_rx_window(sn_size) == SRSRAN_SUCCESS);
+    TESTASSERT(sparse_lost_pdus_status_test(sn_size) == SRSRAN_SUCCESS);
   }
   TESTASSERT(full_rx_window_t_reassembly_expiry(rlc_am_nr_sn_size_t::size12bits) == SRSRAN_SUCCESS);
   return SRSRAN_SUCCESS;
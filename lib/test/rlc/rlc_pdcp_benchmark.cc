@@ -0,0 +1,356 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/task_scheduler.h"
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/ue_gw_interfaces.h"
+#include "srsran/interfaces/ue_rrc_interfaces.h"
+#include "srsran/rlc/rlc.h"
+#include "srsran/upper/pdcp.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <getopt.h>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+ * User plane benchmark of a PDCP and RLC transmitter connected to a PDCP and RLC receiver, in a single thread. Each TTI
+ * the transmitter is given a grant of grant_size bytes, the PDUs are dropped with probability loss_rate and the
+ * status PDUs of AM are returned in the same TTI. The SDUs carry their index in the first 4 bytes, which is used to
+ * measure the latency from the PDCP write_sdu() to the delivery to the GW.
+ */
+
+// Heap allocations of the whole process, the byte buffers come from their own pool and are not counted
+static std::atomic<uint64_t> nof_heap_allocs{0};
+
+void* operator new(size_t sz)
+{
+  nof_heap_allocs.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = malloc(sz > 0 ? sz : 1);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+  free(ptr);
+}
+
+void operator delete(void* ptr, size_t sz) noexcept
+{
+  free(ptr);
+}
+
+namespace {
+
+std::string rat            = "lte";
+std::string mode           = "am";
+uint32_t    sdu_size       = 1400;
+uint32_t    nof_sdus       = 100000;
+float       loss_rate      = 0.0f;
+uint32_t    grant_size     = 12000;
+bool        ciphering      = false;
+float       min_throughput = 0.0f;
+
+const uint32_t lcid          = 3;
+const uint32_t min_grant     = 16;  ///< the MAC does not give a bearer grants that barely fit the RLC header
+const uint32_t max_idle_ttis = 500; ///< TTIs without deliveries after the last SDU before the benchmark stops
+
+void usage(char* prog)
+{
+  printf("Usage: %s [rmsnlgct]\n", prog);
+  printf("\t-r RAT, lte or nr [Default %s]\n", rat.c_str());
+  printf("\t-m RLC mode, am or um [Default %s]\n", mode.c_str());
+  printf("\t-s SDU size in bytes [Default %d]\n", sdu_size);
+  printf("\t-n number of SDUs [Default %d]\n", nof_sdus);
+  printf("\t-l PDU loss rate [Default %.2f]\n", loss_rate);
+  printf("\t-g grant size in bytes per TTI [Default %d]\n", grant_size);
+  printf("\t-c enable the PDCP ciphering (EEA2)\n");
+  printf("\t-t fails if the throughput is below this value in Mbps [Default %.1f]\n", min_throughput);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "rmsnlgct")) != -1) {
+    switch (opt) {
+      case 'r':
+        rat = argv[optind];
+        break;
+      case 'm':
+        mode = argv[optind];
+        break;
+      case 's':
+        sdu_size = (uint32_t)strtol(argv[optind], nullptr, 10);
+        break;
+      case 'n':
+        nof_sdus = (uint32_t)strtol(argv[optind], nullptr, 10);
+        break;
+      case 'l':
+        loss_rate = strtof(argv[optind], nullptr);
+        break;
+      case 'g':
+        grant_size = (uint32_t)strtol(argv[optind], nullptr, 10);
+        break;
+      case 'c':
+        ciphering = true;
+        break;
+      case 't':
+        min_throughput = strtof(argv[optind], nullptr);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int64_t now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+class rrc_dummy : public srsue::rrc_interface_pdcp, public srsue::rrc_interface_rlc
+{
+public:
+  void        write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu) override {}
+  void        write_pdu_bcch_bch(srsran::unique_byte_buffer_t pdu) override {}
+  void        write_pdu_bcch_dlsch(srsran::unique_byte_buffer_t pdu) override {}
+  void        write_pdu_pcch(srsran::unique_byte_buffer_t pdu) override {}
+  void        write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t pdu) override {}
+  void        notify_pdcp_integrity_error(uint32_t lcid) override {}
+  const char* get_rb_name(uint32_t lcid) override { return "DRB1"; }
+  void        max_retx_attempted() override {}
+  void        protocol_failure() override {}
+};
+
+/// Receives the SDUs and records the latency of the first delivery of each of them
+class gw_dummy : public srsue::gw_interface_pdcp
+{
+public:
+  explicit gw_dummy(std::vector<int64_t>& tx_time_ns_) : tx_time_ns(tx_time_ns_) { latency_ns.reserve(nof_sdus); }
+
+  void write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu) override
+  {
+    if (pdu->N_bytes < 4) {
+      return;
+    }
+    uint32_t idx;
+    memcpy(&idx, pdu->msg, sizeof(idx));
+    if (idx >= tx_time_ns.size() or tx_time_ns[idx] < 0) {
+      return;
+    }
+    last_rx_ns = now_ns();
+    latency_ns.push_back(last_rx_ns - tx_time_ns[idx]);
+    tx_time_ns[idx] = -1;
+    rx_bytes += pdu->N_bytes;
+  }
+  void write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t pdu) override {}
+
+  std::vector<int64_t>& tx_time_ns;
+  std::vector<int64_t>  latency_ns;
+  uint64_t              rx_bytes   = 0;
+  int64_t               last_rx_ns = 0;
+};
+
+/// PDCP and RLC entities of one end of the link
+struct ue_side_t {
+  ue_side_t(srsran::task_scheduler& task_sched, const char* pdcp_name, const char* rlc_name, gw_dummy& gw) :
+    pdcp(&task_sched, pdcp_name), rlc(rlc_name)
+  {
+    pdcp.init(&rlc, &rrc, &gw);
+    rlc.init(&pdcp, &rrc, task_sched.get_timer_handler(), 0);
+  }
+
+  rrc_dummy    rrc;
+  srsran::pdcp pdcp;
+  srsran::rlc  rlc;
+};
+
+void config_side(ue_side_t& side, bool is_tx)
+{
+  bool                 is_nr = rat == "nr";
+  srsran::rlc_config_t rlc_cfg;
+  if (mode == "am") {
+    rlc_cfg = is_nr ? srsran::rlc_config_t::default_rlc_am_nr_config(18) : srsran::rlc_config_t::default_rlc_am_config();
+  } else {
+    rlc_cfg = is_nr ? srsran::rlc_config_t::default_rlc_um_nr_config(12) : srsran::rlc_config_t::default_rlc_um_config();
+  }
+  TESTASSERT(side.rlc.add_bearer(lcid, rlc_cfg) == SRSRAN_SUCCESS);
+
+  srsran::pdcp_config_t pdcp_cfg = {1,
+                                    srsran::PDCP_RB_IS_DRB,
+                                    is_tx ? srsran::SECURITY_DIRECTION_DOWNLINK : srsran::SECURITY_DIRECTION_UPLINK,
+                                    is_tx ? srsran::SECURITY_DIRECTION_UPLINK : srsran::SECURITY_DIRECTION_DOWNLINK,
+                                    is_nr ? srsran::PDCP_SN_LEN_18 : srsran::PDCP_SN_LEN_12,
+                                    srsran::pdcp_t_reordering_t::ms100,
+                                    srsran::pdcp_discard_timer_t::infinity,
+                                    false,
+                                    is_nr ? srsran::srsran_rat_t::nr : srsran::srsran_rat_t::lte};
+  TESTASSERT(side.pdcp.add_bearer(lcid, pdcp_cfg) == SRSRAN_SUCCESS);
+
+  if (ciphering) {
+    srsran::as_security_config_t sec_cfg = {};
+    for (uint32_t i = 0; i < sec_cfg.k_up_enc.size(); i++) {
+      sec_cfg.k_up_enc[i] = (uint8_t)i;
+    }
+    sec_cfg.cipher_algo = srsran::CIPHERING_ALGORITHM_ID_128_EEA2;
+    sec_cfg.integ_algo  = srsran::INTEGRITY_ALGORITHM_ID_EIA0;
+    side.pdcp.config_security(lcid, sec_cfg);
+    side.pdcp.enable_encryption(lcid, srsran::DIRECTION_TXRX);
+  }
+}
+
+/// Moves the PDUs of one TTI from tx to rx, dropping them with probability loss_rate
+void run_link(srsran::rlc&                           tx,
+              srsran::rlc&                           rx,
+              uint32_t                               nof_bytes,
+              std::vector<uint8_t>&                  buffer,
+              std::mt19937&                          rand_gen,
+              std::uniform_real_distribution<float>& dist)
+{
+  while (nof_bytes >= min_grant and tx.get_buffer_state(lcid) > 0) {
+    uint32_t len = tx.read_pdu(lcid, buffer.data(), nof_bytes);
+    if (len == 0) {
+      break;
+    }
+    nof_bytes -= std::min(len, nof_bytes);
+    if (dist(rand_gen) >= loss_rate) {
+      rx.write_pdu(lcid, buffer.data(), len);
+    }
+  }
+}
+
+int run_benchmark()
+{
+  srsran::task_scheduler task_sched;
+  std::vector<int64_t>   tx_time_ns(nof_sdus, 0);
+  gw_dummy               gw_rx(tx_time_ns);
+  gw_dummy               gw_tx(tx_time_ns);
+  ue_side_t              tx_side(task_sched, "PDCP_TX", "RLC_TX", gw_tx);
+  ue_side_t              rx_side(task_sched, "PDCP_RX", "RLC_RX", gw_rx);
+  config_side(tx_side, true);
+  config_side(rx_side, false);
+
+  std::vector<uint8_t>                  dl_buffer(grant_size), ul_buffer(grant_size);
+  std::mt19937                          rand_gen(1234);
+  std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+  uint32_t nof_tx_sdus  = 0;
+  uint32_t nof_ttis     = 0;
+  uint32_t idle_ttis    = 0;
+  uint64_t allocs_start = nof_heap_allocs.load(std::memory_order_relaxed);
+  int64_t  t_start      = now_ns();
+  while (idle_ttis < max_idle_ttis and gw_rx.latency_ns.size() < nof_sdus) {
+    // Offer about one grant of new SDUs per TTI
+    for (uint32_t bytes = 0; bytes < grant_size and nof_tx_sdus < nof_sdus and not tx_side.rlc.sdu_queue_is_full(lcid);
+         bytes += sdu_size) {
+      srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+      TESTASSERT(sdu != nullptr);
+      memcpy(sdu->msg, &nof_tx_sdus, sizeof(nof_tx_sdus));
+      sdu->N_bytes            = sdu_size;
+      tx_time_ns[nof_tx_sdus] = now_ns();
+      tx_side.pdcp.write_sdu(lcid, std::move(sdu));
+      nof_tx_sdus++;
+    }
+
+    size_t nof_rx_sdus = gw_rx.latency_ns.size();
+    run_link(tx_side.rlc, rx_side.rlc, grant_size, dl_buffer, rand_gen, dist);
+    run_link(rx_side.rlc, tx_side.rlc, grant_size, ul_buffer, rand_gen, dist);
+    if (nof_tx_sdus == nof_sdus and gw_rx.latency_ns.size() == nof_rx_sdus) {
+      idle_ttis++;
+    } else {
+      idle_ttis = 0;
+    }
+
+    task_sched.tic();
+    task_sched.run_pending_tasks();
+    nof_ttis++;
+  }
+  uint64_t nof_allocs = nof_heap_allocs.load(std::memory_order_relaxed) - allocs_start;
+  // The TTIs waiting for the timers after the last delivery are not counted
+  int64_t elapsed_ns = std::max(gw_rx.last_rx_ns - t_start, (int64_t)1);
+
+  std::vector<int64_t>& latency = gw_rx.latency_ns;
+  int64_t               p99_ns  = 0;
+  if (not latency.empty()) {
+    auto p99 = latency.begin() + (latency.size() * 99) / 100;
+    std::nth_element(latency.begin(), p99, latency.end());
+    p99_ns = *p99;
+  }
+  double mbps = 8.0 * gw_rx.rx_bytes / (elapsed_ns / 1e3);
+
+  printf("%s %s, SDU %d bytes, loss %.3f%s: %d/%d SDUs in %d TTIs, %.1f Mbps, %.0f SDUs/s, %.2f allocs/SDU, p99 "
+         "latency %.1f us\n",
+         rat.c_str(),
+         mode.c_str(),
+         sdu_size,
+         loss_rate,
+         ciphering ? ", ciphered" : "",
+         (uint32_t)latency.size(),
+         nof_tx_sdus,
+         nof_ttis,
+         mbps,
+         latency.size() / (elapsed_ns / 1e9),
+         (double)nof_allocs / std::max(nof_tx_sdus, 1U),
+         p99_ns / 1e3);
+
+  // AM shall deliver every SDU, UM only those that were not lost
+  if (mode == "am" and latency.size() != nof_sdus) {
+    fprintf(stderr, "Only %zd of %d SDUs were delivered in AM\n", latency.size(), nof_sdus);
+    return SRSRAN_ERROR;
+  }
+  if (mbps < min_throughput) {
+    fprintf(stderr, "Throughput %.1f Mbps is below %.1f Mbps\n", mbps, min_throughput);
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  if (sdu_size < 4 or sdu_size > SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET or (rat != "lte" and rat != "nr") or
+      (mode != "am" and mode != "um")) {
+    usage(argv[0]);
+    return SRSRAN_ERROR;
+  }
+
+  srslog::init();
+  for (const char* name : {"PDCP_TX", "PDCP_RX", "RLC_TX", "RLC_RX"}) {
+    srslog::fetch_basic_logger(name, false).set_level(srslog::basic_levels::error);
+  }
+
+  TESTASSERT(run_benchmark() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  return SRSRAN_SUCCESS;
+}
@@ -369,19 +369,21 @@ void stress_test(stress_test_args_t args)
   srsran::rlc_metrics_t metrics = {};
   rlc1.get_metrics(metrics, 1);
 
-  printf("RLC1 received %" PRIu64 " SDUs in %ds (%.2f/s), Tx=%" PRIu64 " B, Rx=%" PRIu64 " B\n",
+  printf("RLC1 received %" PRIu64 " SDUs in %ds (%.2f/s, %.2f Mbit/s), Tx=%" PRIu64 " B, Rx=%" PRIu64 " B\n",
          tester1.get_nof_rx_pdus(),
          args.test_duration_sec,
          static_cast<double>(tester1.get_nof_rx_pdus() / args.test_duration_sec),
+         metrics.bearer[lcid].num_rx_sdu_bytes * 8 / (1e6 * args.test_duration_sec),
          metrics.bearer[lcid].num_tx_pdu_bytes,
          metrics.bearer[lcid].num_rx_pdu_bytes);
   rlc_bearer_metrics_print(metrics.bearer[lcid]);
 
   rlc2.get_metrics(metrics, 1);
-  printf("RLC2 received %" PRIu64 " SDUs in %ds (%.2f/s), Tx=%" PRIu64 " B, Rx=%" PRIu64 " B\n",
+  printf("RLC2 received %" PRIu64 " SDUs in %ds (%.2f/s, %.2f Mbit/s), Tx=%" PRIu64 " B, Rx=%" PRIu64 " B\n",
          tester2.get_nof_rx_pdus(),
          args.test_duration_sec,
          static_cast<double>(tester2.get_nof_rx_pdus() / args.test_duration_sec),
+         metrics.bearer[lcid].num_rx_sdu_bytes * 8 / (1e6 * args.test_duration_sec),
          metrics.bearer[lcid].num_tx_pdu_bytes,
          metrics.bearer[lcid].num_rx_pdu_bytes);
   rlc_bearer_metrics_print(metrics.bearer[lcid]);
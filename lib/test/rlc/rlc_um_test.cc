@@ -113,6 +113,42 @@ int meas_obj_test()
   return 0;
 }
 
+int discard_test()
+{
+  rlc_um_lte_test_context1 ctxt;
+
+  // Push 5 SDUs into RLC1
+  unique_byte_buffer_t sdu_bufs[NBUFS];
+  for (int i = 0; i < NBUFS; i++) {
+    sdu_bufs[i]             = srsran::make_byte_buffer();
+    sdu_bufs[i]->msg[0]     = i; // Write the index into the buffer
+    sdu_bufs[i]->N_bytes    = 1; // Give each buffer a size of 1 byte
+    sdu_bufs[i]->md.pdcp_sn = i;
+    ctxt.rlc1.write_sdu(std::move(sdu_bufs[i]));
+  }
+
+  // Discard the second SDU, it is no longer accounted in the buffer state
+  ctxt.rlc1.discard_sdu(1);
+  TESTASSERT(12 == ctxt.rlc1.get_buffer_state());
+
+  // Read all SDUs in a single PDU
+  byte_buffer_t pdu_buf;
+  pdu_buf.N_bytes = ctxt.rlc1.read_pdu(pdu_buf.msg, 100);
+  TESTASSERT(pdu_buf.N_bytes > 0);
+  TESTASSERT(0 == ctxt.rlc1.get_buffer_state());
+
+  ctxt.rlc2.write_pdu(pdu_buf.msg, pdu_buf.N_bytes);
+
+  TESTASSERT(NBUFS - 1 == ctxt.tester.get_num_sdus());
+  uint8_t expected[] = {0, 2, 3, 4};
+  for (uint32_t i = 0; i < ctxt.tester.sdus.size(); i++) {
+    TESTASSERT(ctxt.tester.sdus.at(i)->N_bytes == 1);
+    TESTASSERT(*(ctxt.tester.sdus[i]->msg) == expected[i]);
+  }
+
+  return 0;
+}
+
 int loss_test()
 {
   rlc_um_lte_test_context1 ctxt;
@@ -445,6 +481,10 @@ int main(int argc, char** argv)
     return -1;
   }
 
+  if (discard_test()) {
+    return -1;
+  }
+
   if (basic_mbsfn_test()) {
     return -1;
   }
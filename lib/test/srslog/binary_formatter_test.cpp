@@ -0,0 +1,249 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "src/srslog/formatters/binary_formatter.h"
+#include "srsran/srslog/detail/log_entry_metadata.h"
+#include "testing_helpers.h"
+#include <numeric>
+
+using namespace srslog;
+
+using store_t = fmt::dynamic_format_arg_store<fmt::printf_context>;
+
+/// Helper to build a log entry.
+static detail::log_entry_metadata build_log_entry_metadata(store_t* store, const char* fmtstring = "Text %d")
+{
+  // Create a time point 50000us from epoch.
+  using tp_ty = std::chrono::time_point<std::chrono::high_resolution_clock>;
+  tp_ty tp(std::chrono::microseconds(50000));
+
+  if (store) {
+    store->push_back(88);
+  }
+
+  return {tp, {10, true}, fmtstring, store, "ABC", 'Z'};
+}
+
+/// Returns the text that the binary stream decodes into.
+static std::string decode(const fmt::memory_buffer& buffer)
+{
+  binary_log_decoder decoder;
+  fmt::memory_buffer out;
+  size_t             nof_bytes = decoder.decode(reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size(), out);
+  if (nof_bytes != buffer.size()) {
+    return "decoding error: " + decoder.get_error();
+  }
+  return fmt::to_string(out);
+}
+
+static bool when_log_entry_is_decoded_then_text_matches_text_formatter()
+{
+  fmt::memory_buffer binary;
+  store_t            bin_store;
+  binary_formatter{}.format(build_log_entry_metadata(&bin_store), binary);
+
+  fmt::memory_buffer text;
+  store_t            text_store;
+  text_formatter{}.format(build_log_entry_metadata(&text_store), text);
+
+  ASSERT_EQ(decode(binary), fmt::to_string(text));
+  ASSERT_EQ(decode(binary), "1970-01-01T00:00:00.050000 [ABC    ] [Z] [   10] Text 88\n");
+
+  return true;
+}
+
+static bool when_arguments_of_all_types_are_passed_then_they_are_decoded()
+{
+  const char* fmtstring = "%d %u %lld %llu %c %s %.2f %.3f %Lf %s %s %p %%";
+  auto        fill      = [](store_t& store) {
+    store.push_back(-5);
+    store.push_back(7U);
+    store.push_back(-1234567890123LL);
+    store.push_back(1234567890123ULL);
+    store.push_back('x');
+    store.push_back(true);
+    store.push_back(1.5f);
+    store.push_back(-2.25);
+    store.push_back(3.5L);
+    store.push_back("literal");
+    store.push_back(std::string("string"));
+    store.push_back(reinterpret_cast<const void*>(0x1234));
+  };
+
+  fmt::memory_buffer binary;
+  store_t            bin_store;
+  auto               bin_entry = build_log_entry_metadata(nullptr, fmtstring);
+  bin_entry.store              = &bin_store;
+  fill(bin_store);
+  binary_formatter{}.format(std::move(bin_entry), binary);
+
+  fmt::memory_buffer text;
+  store_t            text_store;
+  auto               text_entry = build_log_entry_metadata(nullptr, fmtstring);
+  text_entry.store              = &text_store;
+  fill(text_store);
+  text_formatter{}.format(std::move(text_entry), text);
+
+  ASSERT_EQ(decode(binary), fmt::to_string(text));
+
+  return true;
+}
+
+static bool when_log_entry_has_no_name_tag_or_context_then_they_are_not_decoded()
+{
+  store_t store;
+  auto    entry         = build_log_entry_metadata(&store);
+  entry.log_name        = "";
+  entry.log_tag         = '\0';
+  entry.context.enabled = false;
+  entry.hex_dump.resize(20);
+  std::iota(entry.hex_dump.begin(), entry.hex_dump.end(), 0);
+
+  fmt::memory_buffer binary;
+  binary_formatter{}.format(std::move(entry), binary);
+  std::string expected = "1970-01-01T00:00:00.050000 Text 88\n"
+                         "    0000: 00 01 02 03 04 05 06 07 08 09 0a 0b 0c 0d 0e 0f\n"
+                         "    0010: 10 11 12 13\n";
+
+  ASSERT_EQ(decode(binary), expected);
+
+  return true;
+}
+
+static bool when_format_string_is_repeated_then_it_is_defined_once()
+{
+  binary_formatter   formatter;
+  fmt::memory_buffer binary;
+
+  store_t store1;
+  formatter.format(build_log_entry_metadata(&store1), binary);
+  size_t first_size = binary.size();
+  store_t store2;
+  formatter.format(build_log_entry_metadata(&store2), binary);
+  size_t second_size = binary.size() - first_size;
+
+  // The second entry carries neither the header nor the definitions.
+  ASSERT_EQ(second_size < first_size - std::strlen("Text %d") - std::strlen("ABC"), true);
+
+  // A different string at the same address is defined again.
+  char   dyn_fmt[] = "Text %d";
+  store_t store3;
+  formatter.format(build_log_entry_metadata(&store3, dyn_fmt), binary);
+  dyn_fmt[0] = 'N';
+  store_t store4;
+  formatter.format(build_log_entry_metadata(&store4, dyn_fmt), binary);
+
+  std::string line = "1970-01-01T00:00:00.050000 [ABC    ] [Z] [   10] Text 88\n";
+  ASSERT_EQ(decode(binary), line + line + line + "1970-01-01T00:00:00.050000 [ABC    ] [Z] [   10] Next 88\n");
+
+  return true;
+}
+
+static bool when_stream_is_split_then_decoder_keeps_definitions()
+{
+  binary_formatter   formatter;
+  fmt::memory_buffer file1, file2;
+  store_t            store1, store2;
+  formatter.format(build_log_entry_metadata(&store1), file1);
+  formatter.format(build_log_entry_metadata(&store2), file2);
+
+  binary_log_decoder decoder;
+  fmt::memory_buffer out;
+  ASSERT_EQ(decoder.decode(reinterpret_cast<const uint8_t*>(file1.data()), file1.size(), out), file1.size());
+  ASSERT_EQ(decoder.decode(reinterpret_cast<const uint8_t*>(file2.data()), file2.size(), out), file2.size());
+
+  std::string line = "1970-01-01T00:00:00.050000 [ABC    ] [Z] [   10] Text 88\n";
+  ASSERT_EQ(fmt::to_string(out), line + line);
+
+  // The second part alone lacks the definitions.
+  binary_log_decoder other;
+  out.clear();
+  ASSERT_EQ(other.decode(reinterpret_cast<const uint8_t*>(file2.data()), file2.size(), out), size_t(0));
+  ASSERT_EQ(other.get_error().empty(), false);
+
+  return true;
+}
+
+static bool when_stream_is_truncated_then_complete_records_are_decoded()
+{
+  binary_formatter   formatter;
+  fmt::memory_buffer binary;
+  store_t            store1, store2;
+  formatter.format(build_log_entry_metadata(&store1), binary);
+  size_t first_size = binary.size();
+  formatter.format(build_log_entry_metadata(&store2), binary);
+
+  binary_log_decoder decoder;
+  fmt::memory_buffer out;
+  ASSERT_EQ(decoder.decode(reinterpret_cast<const uint8_t*>(binary.data()), binary.size() - 1, out), first_size);
+  ASSERT_EQ(fmt::to_string(out), "1970-01-01T00:00:00.050000 [ABC    ] [Z] [   10] Text 88\n");
+
+  return true;
+}
+
+namespace {
+DECLARE_METRIC("SNR", snr_t, float, "dB");
+DECLARE_METRIC("PWR", pwr_t, int, "dBm");
+DECLARE_METRIC_SET("RF", rf_set, snr_t, pwr_t);
+DECLARE_METRIC_LIST("Antennas", antenna_list_t, std::vector<rf_set>);
+using ctx_t = srslog::build_context_type<antenna_list_t>;
+} // namespace
+
+static bool when_context_is_passed_then_it_is_decoded_as_text()
+{
+  ctx_t ctx("Context");
+  ctx.get<antenna_list_t>().emplace_back();
+  ctx.at<antenna_list_t>(0).write<snr_t>(5.1);
+  ctx.at<antenna_list_t>(0).write<pwr_t>(-11);
+
+  fmt::memory_buffer binary;
+  binary_formatter   formatter;
+  auto               entry = build_log_entry_metadata(nullptr);
+  entry.fmtstring          = nullptr;
+  formatter.format_ctx(ctx, std::move(entry), binary);
+  store_t store;
+  formatter.format_ctx(ctx, build_log_entry_metadata(&store), binary);
+
+  fmt::memory_buffer text;
+  text_formatter     txt_formatter;
+  entry           = build_log_entry_metadata(nullptr);
+  entry.fmtstring = nullptr;
+  txt_formatter.format_ctx(ctx, std::move(entry), text);
+  store_t text_store;
+  txt_formatter.format_ctx(ctx, build_log_entry_metadata(&text_store), text);
+
+  ASSERT_EQ(decode(binary), fmt::to_string(text));
+
+  return true;
+}
+
+int main()
+{
+  TEST_FUNCTION(when_log_entry_is_decoded_then_text_matches_text_formatter);
+  TEST_FUNCTION(when_arguments_of_all_types_are_passed_then_they_are_decoded);
+  TEST_FUNCTION(when_log_entry_has_no_name_tag_or_context_then_they_are_not_decoded);
+  TEST_FUNCTION(when_format_string_is_repeated_then_it_is_defined_once);
+  TEST_FUNCTION(when_stream_is_split_then_decoder_keeps_definitions);
+  TEST_FUNCTION(when_stream_is_truncated_then_complete_records_are_decoded);
+  TEST_FUNCTION(when_context_is_passed_then_it_is_decoded_as_text);
+
+  return 0;
+}
@@ -21,8 +21,10 @@
 
 #include "srsran/srslog/event_trace.h"
 #include "srsran/srslog/log_channel.h"
+#include "file_test_utils.h"
 #include "test_dummies.h"
 #include "testing_helpers.h"
+#include <sstream>
 #include <thread>
 
 using namespace srslog;
@@ -99,6 +101,70 @@ static bool when_tracing_with_above_threshold_complete_event_then_one_event_is_g
   return true;
 }
 
+static bool when_hot_tracer_is_not_initialized_then_export_fails()
+{
+  {
+    trace_hot_scope("a", "b");
+  }
+  ASSERT_EQ(event_trace_hot_export(), false);
+
+  return true;
+}
+
+/// Returns the number of times that str appears in text.
+static unsigned count_occurrences(const std::string& text, const std::string& str)
+{
+  unsigned count = 0;
+  for (auto pos = text.find(str); pos != std::string::npos; pos = text.find(str, pos + str.size())) {
+    ++count;
+  }
+  return count;
+}
+
+static bool when_hot_tracer_is_exported_then_last_events_of_each_thread_are_written()
+{
+  static constexpr char filename[] = "hot_trace_test.json";
+  file_test_utils::scoped_file_deleter deleter(filename);
+
+  ASSERT_EQ(event_trace_hot_init(filename, 4), true);
+  ASSERT_EQ(event_trace_hot_init(filename, 4), false);
+
+  {
+    trace_hot_scope_arg("cat", "main_scope", 42);
+  }
+
+  // This thread overflows its buffer, only the last 4 events are kept.
+  std::thread t([]() {
+    ::pthread_setname_np(::pthread_self(), "HOT_THREAD");
+    for (unsigned i = 0; i != 6; ++i) {
+      trace_hot_scope("cat", "thread_scope");
+    }
+  });
+  t.join();
+
+  ASSERT_EQ(event_trace_hot_export(), true);
+
+  // Events after the export are not recorded.
+  {
+    trace_hot_scope("cat", "late_scope");
+  }
+
+  std::ifstream     file(filename);
+  std::stringstream ss;
+  ss << file.rdbuf();
+  std::string json = ss.str();
+
+  ASSERT_EQ(json.compare(0, 1, "{"), 0);
+  ASSERT_EQ(count_occurrences(json, "\"ph\":\"X\""), 5);
+  ASSERT_EQ(count_occurrences(json, "\"name\":\"main_scope\""), 1);
+  ASSERT_EQ(count_occurrences(json, "\"name\":\"thread_scope\""), 4);
+  ASSERT_EQ(count_occurrences(json, "\"args\":{\"arg\":42}"), 1);
+  ASSERT_EQ(count_occurrences(json, "\"name\":\"HOT_THREAD\""), 1);
+  ASSERT_EQ(count_occurrences(json, "late_scope"), 0);
+
+  return true;
+}
+
 int main()
 {
   test_dummies::sink_dummy s;
@@ -115,6 +181,8 @@ int main()
   TEST_FUNCTION(when_tracing_with_under_threshold_complete_event_then_no_event_is_generated, backend);
   backend.reset();
   TEST_FUNCTION(when_tracing_with_above_threshold_complete_event_then_one_event_is_generated, backend);
+  TEST_FUNCTION(when_hot_tracer_is_not_initialized_then_export_fails);
+  TEST_FUNCTION(when_hot_tracer_is_exported_then_last_events_of_each_thread_are_written);
 
   return 0;
 }
@@ -22,6 +22,7 @@
 #include "src/srslog/log_backend_impl.h"
 #include "test_dummies.h"
 #include "testing_helpers.h"
+#include <set>
 
 using namespace srslog;
 
@@ -233,6 +234,101 @@ static bool when_empty_handler_is_used_then_backend_does_not_crash()
   return true;
 }
 
+namespace {
+
+/// Sink that records the threads that write into it.
+class sink_thread_spy : public sink
+{
+public:
+  sink_thread_spy() : sink(std::unique_ptr<log_formatter>(new test_dummies::log_formatter_dummy)) {}
+
+  detail::error_string write(detail::memory_buffer buffer) override
+  {
+    ++count;
+    threads.insert(std::this_thread::get_id());
+    return {};
+  }
+
+  detail::error_string flush() override
+  {
+    ++flush_count;
+    threads.insert(std::this_thread::get_id());
+    return {};
+  }
+
+  unsigned                  count       = 0;
+  unsigned                  flush_count = 0;
+  std::set<std::thread::id> threads;
+};
+
+} // namespace
+
+static bool when_backend_has_several_workers_then_each_sink_is_written_by_one_thread()
+{
+  sink_thread_spy sinks[5];
+
+  log_backend_impl backend;
+  backend.set_nof_workers(3);
+  ASSERT_EQ(backend.get_nof_workers(), 3);
+  backend.start();
+
+  for (unsigned i = 0; i != 100; ++i) {
+    for (auto& s : sinks) {
+      backend.push(build_log_entry(&s, backend.alloc_arg_store()));
+    }
+  }
+
+  // Each worker flushes its own sinks.
+  detail::shared_variable<bool> completion_flag(false);
+  std::vector<sink*>            sink_ptrs;
+  for (auto& s : sinks) {
+    sink_ptrs.push_back(&s);
+  }
+  detail::log_entry cmd;
+  cmd.metadata.store = nullptr;
+  cmd.flush_cmd =
+      std::unique_ptr<detail::flush_backend_cmd>(new detail::flush_backend_cmd{completion_flag, std::move(sink_ptrs)});
+  backend.push(std::move(cmd));
+  ASSERT_EQ(completion_flag, true);
+
+  std::set<std::thread::id> all_threads;
+  for (auto& s : sinks) {
+    ASSERT_EQ(s.count, 100);
+    ASSERT_EQ(s.flush_count, 1);
+    ASSERT_EQ(s.threads.size(), 1);
+    all_threads.insert(*s.threads.begin());
+  }
+  ASSERT_EQ(all_threads.size(), 3);
+
+  backend.stop();
+
+  return true;
+}
+
+static bool when_backend_is_full_then_drops_are_counted()
+{
+  sink_spy         spy;
+  log_backend_impl backend;
+
+  // The backend is not started, so nothing is popped from the queue.
+  for (unsigned i = 0; i != SRSLOG_QUEUE_CAPACITY; ++i) {
+    ASSERT_EQ(backend.push(build_log_entry(&spy, nullptr)), true);
+  }
+  ASSERT_EQ(backend.push(build_log_entry(&spy, nullptr)), false);
+  ASSERT_EQ(backend.get_drop_stats().queue_full, 1);
+
+  std::vector<fmt::dynamic_format_arg_store<fmt::printf_context>*> stores;
+  for (unsigned i = 0; i != SRSLOG_QUEUE_CAPACITY; ++i) {
+    stores.push_back(backend.alloc_arg_store());
+    ASSERT_NE(stores.back(), nullptr);
+  }
+  ASSERT_EQ(backend.alloc_arg_store(), nullptr);
+  ASSERT_EQ(backend.get_drop_stats().no_arg_store, 1);
+  ASSERT_EQ(backend.get_drop_stats().queue_full, 1);
+
+  return true;
+}
+
 int main()
 {
   TEST_FUNCTION(when_backend_is_started_then_is_started_returns_true);
@@ -243,6 +339,8 @@ int main()
   TEST_FUNCTION(when_sink_write_fails_then_error_handler_is_invoked);
   TEST_FUNCTION(when_handler_is_set_after_start_then_handler_is_not_used);
   TEST_FUNCTION(when_empty_handler_is_used_then_backend_does_not_crash);
+  TEST_FUNCTION(when_backend_has_several_workers_then_each_sink_is_written_by_one_thread);
+  TEST_FUNCTION(when_backend_is_full_then_drops_are_counted);
 
   return 0;
 }
@@ -27,6 +27,7 @@
 *******************************************************************************/
 
 #include "srsran/adt/circular_map.h"
+#include "srsran/adt/static_hash_map.h"
 #include "srsran/common/common_lte.h"
 #include <stdint.h>
 
@@ -35,7 +36,10 @@ namespace srsenb {
 #define SRSENB_RRC_MAX_N_PLMN_IDENTITIES 6
 
 #define SRSENB_N_SRB 3
+// Max number of UEs handled by the eNB/gNB stack. It can be raised at build time, e.g. -DMAX_UES=2048
+#ifndef SRSENB_MAX_UES
 #define SRSENB_MAX_UES 64
+#endif
 const uint32_t MAX_ERAB_ID   = 15;
 const uint32_t MAX_NOF_ERABS = 16;
 
@@ -62,9 +66,9 @@ constexpr lte_drb lte_lcid_to_drb(uint32_t lcid)
 #define SRSENB_MAX_BUFFER_SIZE_BYTES 12756
 #define SRSENB_BUFFER_HEADER_OFFSET 1024
 
-/// Typedef of circular map container which key corresponding to rnti value and that can be used across layers
+/// Typedef of the map container with rnti keys that can be used across layers, any set of SRSENB_MAX_UES RNTIs fits
 template <typename UEObject>
-using rnti_map_t = srsran::static_circular_map<uint16_t, UEObject, SRSENB_MAX_UES>;
+using rnti_map_t = srsran::static_hash_map<uint16_t, UEObject, SRSENB_MAX_UES>;
 
 } // namespace srsenb
 
@@ -28,6 +28,7 @@
 #ifndef SRSENB_ENB_H
 #define SRSENB_ENB_H
 
+#include <mutex>
 #include <pthread.h>
 #include <stdarg.h>
 #include <string>
@@ -86,6 +87,8 @@ struct log_args_t {
   int         all_hex_limit;
   int         file_max_size;
   std::string filename;
+  bool        binary;
+  uint32_t    backend_workers;
 };
 
 struct gui_args_t {
@@ -97,6 +100,14 @@ struct general_args_t {
   float       metrics_period_secs;
   bool        metrics_csv_enable;
   std::string metrics_csv_filename;
+  std::string metrics_http_bind_addr;
+  uint16_t    metrics_http_port;
+  std::string control_bind_addr;
+  uint16_t    control_port;
+  std::string metrics_udp_addr;
+  uint16_t    metrics_udp_port;
+  uint32_t    metrics_keyframe_period;
+  bool        metrics_thread_counters;
   bool        report_json_enable;
   std::string report_json_filename;
   bool        report_json_asn1_oct;
@@ -106,12 +117,24 @@ struct general_args_t {
   bool        tracing_enable;
   std::size_t tracing_buffcapacity;
   std::string tracing_filename;
+  bool        tracing_hot_enable;
+  std::size_t tracing_hot_events;
+  std::string tracing_hot_filename;
   std::string eia_pref_list;
   std::string eea_pref_list;
   uint32_t    max_mac_dl_kos;
   uint32_t    max_mac_ul_kos;
   uint32_t    gtpu_indirect_tunnel_timeout;
   uint32_t    rlf_release_timer_ms;
+  std::string thread_profile;
+  std::string numa_mem_profile;
+  std::string huge_pages;
+  bool        mem_lock;
+  uint32_t    mem_reserve_heap_mb;
+  bool        mem_prefault;
+  std::string socket_backend;
+  std::string instance_confs;
+  uint32_t    shared_phy_threads;
 };
 
 struct all_args_t {
@@ -129,6 +152,13 @@ struct all_args_t {
 
 struct rrc_cfg_t;
 
+/// Resources shared by all the eNB instances hosted in the same process. The byte buffer pool, the log backend and the
+/// FFT plans are process wide already
+struct enb_shared_resources_t {
+  /// PHY threads for processing the carriers and decoding the PUSCH in parallel, each instance creates its own if null
+  std::shared_ptr<srsran::task_thread_pool> phy_task_pool;
+};
+
 /*******************************************************************************
   Main eNB class
 *******************************************************************************/
@@ -140,7 +170,7 @@ public:
 
   virtual ~enb();
 
-  int init(const all_args_t& args_);
+  int init(const all_args_t& args_, const enb_shared_resources_t& shared = {});
 
   void stop();
 
@@ -160,6 +190,8 @@ public:
 
   void toggle_padding() override;
 
+  bool cmd_set_tunables(const std::string& settings) override;
+
   void tti_clock() override;
 
 private:
@@ -172,6 +204,7 @@ private:
 
   all_args_t        args    = {};
   std::atomic<bool> started = {false};
+  std::mutex        tunables_mutex;
 
   phy_cfg_t    phy_cfg    = {};
   rrc_cfg_t    rrc_cfg    = {};
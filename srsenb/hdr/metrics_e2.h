@@ -30,11 +30,9 @@
 #include "srsran/interfaces/e2_metrics_interface.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include <pthread.h>
-#include <queue>
 #include <stdint.h>
 #include <string>
 
-#define METRICS_BUFFER_SIZE 20
 namespace srsenb {
 
 class metrics_e2 : public srsran::metrics_listener<enb_metrics_t>, public e2_interface_metrics
@@ -49,10 +47,9 @@ public:
   bool unregister_e2sm(e2sm* sm) override;
 
 private:
-  std::atomic<bool>         do_print = {false};
-  std::queue<enb_metrics_t> metrics_queue;
-  enb_metrics_interface*    enb = nullptr;
-  std::vector<e2sm*>        e2sm_vec;
+  std::atomic<bool>      do_print = {false};
+  enb_metrics_interface* enb      = nullptr;
+  std::vector<e2sm*>     e2sm_vec;
 };
 
 } // namespace srsenb
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        metrics_openmetrics.h
+ * Description: Metrics class exporting the metrics in the Prometheus text
+ *              exposition format over HTTP and as binary deltas over UDP.
+ *****************************************************************************/
+
+#ifndef SRSENB_METRICS_OPENMETRICS_H
+#define SRSENB_METRICS_OPENMETRICS_H
+
+#include "srsran/common/network_utils.h"
+#include "srsran/common/threads.h"
+#include "srsran/interfaces/enb_metrics_interface.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace srsenb {
+
+struct metrics_openmetrics_args_t {
+  std::string http_bind_addr = "127.0.0.1";
+  uint16_t    http_port      = 0; ///< 0 disables the HTTP endpoint
+  std::string udp_addr;           ///< empty disables the UDP push
+  uint16_t    udp_port        = 0;
+  uint32_t    keyframe_period = 10; ///< all the series are sent every keyframe_period pushes
+};
+
+/**
+ * Exports the eNB metrics for high frequency collection. Each metrics period the series are flattened once into a
+ * snapshot, which is then:
+ *  - served over HTTP at /metrics in the Prometheus text exposition format. At /metrics/delta only the series that
+ *    changed since the previous request to that path are returned, for a single poller;
+ *  - pushed over UDP as binary deltas, only the series that changed since the previous push are sent.
+ *
+ * Each UDP datagram holds a header followed by records, in host byte order:
+ *   header:     magic "SRSM" (u32), version (u8), flags (u8, bit 0 set for keyframes), nof_records (u16), seq (u32),
+ *               timestamp in ms since the UNIX epoch (u64)
+ *   definition: type 1 (u8), id (u32), length (u16) and series name with its labels, e.g. srsenb_ue_dl_cqi{rnti="70"}
+ *   value:      type 0 (u8), id (u32), value (f64)
+ *   removal:    type 2 (u8), id (u32)
+ * The definition of a series precedes its first value. Keyframes repeat the definitions and values of all the series,
+ * so that a receiver can join or recover from lost datagrams.
+ */
+class metrics_openmetrics : public srsran::metrics_listener<enb_metrics_t>, protected srsran::thread
+{
+public:
+  static constexpr uint32_t udp_magic   = 0x4d535253; // "SRSM"
+  static constexpr uint8_t  udp_version = 1;
+
+  enum class record_type : uint8_t { value = 0, definition = 1, removal = 2 };
+
+  explicit metrics_openmetrics(const metrics_openmetrics_args_t& args_);
+  ~metrics_openmetrics();
+
+  /// Opens the HTTP and UDP sockets and starts the HTTP thread
+  bool init();
+  void set_metrics(const enb_metrics_t& m, const uint32_t period_usec) override;
+  void stop() override;
+
+  /// Returns the exposition of the last snapshot, or of the series changed since the previous delta call
+  std::string get_exposition(bool delta);
+
+private:
+  struct sample_t {
+    std::string key; ///< metric name with its labels
+    double      value;
+  };
+  struct family_t {
+    const char*           name;
+    const char*           help;
+    std::vector<sample_t> samples;
+  };
+  using snapshot_t = std::vector<family_t>;
+
+  struct series_state_t {
+    uint32_t id;
+    double   value;
+    bool     seen;
+  };
+
+  static snapshot_t  make_snapshot(const enb_metrics_t& m);
+  static std::string render(const snapshot_t& snapshot, std::unordered_map<std::string, double>* last_values);
+  void               push_deltas(const snapshot_t& snapshot);
+  void               run_thread() override;
+  void               serve_client(int fd);
+
+  metrics_openmetrics_args_t args;
+  srslog::basic_logger&      logger;
+
+  // Last snapshot, shared with the HTTP thread
+  std::mutex                              snapshot_mutex;
+  std::shared_ptr<const snapshot_t>       snapshot;
+  std::shared_ptr<const std::string>      exposition;
+  std::unordered_map<std::string, double> last_scraped;
+
+  // HTTP endpoint
+  srsran::unique_socket http_socket;
+  std::atomic<bool>     running{false};
+
+  // UDP push, only used from the metrics thread
+  srsran::unique_socket                           udp_socket;
+  sockaddr_in                                     udp_dest = {};
+  std::unordered_map<std::string, series_state_t> pushed_series;
+  uint32_t                                        next_series_id = 0;
+  uint32_t                                        push_seq       = 0;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_METRICS_OPENMETRICS_H
@@ -27,6 +27,7 @@
 #ifndef SRSENB_PHY_BASE_H
 #define SRSENB_PHY_BASE_H
 
+#include "srsenb/hdr/phy/phy_interfaces.h"
 #include "srsenb/hdr/phy/phy_metrics.h"
 #include <vector>
 
@@ -46,9 +47,13 @@ public:
 
   virtual void get_metrics(std::vector<phy_metrics_t>& m) = 0;
 
+  virtual void get_timing_metrics(phy_timing_metrics_t& m) = 0;
+
   virtual void cmd_cell_gain(uint32_t cell_idx, float gain_db) = 0;
 
   virtual void cmd_cell_measure() = 0;
+
+  virtual void set_tunables(const phy_tunables_t& tunables) = 0;
 };
 
 } // namespace srsenb
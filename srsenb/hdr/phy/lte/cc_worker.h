@@ -43,6 +43,9 @@ public:
   cf_t* get_buffer_rx(uint32_t antenna_idx);
   cf_t* get_buffer_tx(uint32_t antenna_idx);
   void  set_tti(uint32_t tti);
+  void  set_load_shedding(bool enable) { shed_load = enable; }
+  void  set_tunables(const phy_tunables_t& t) { tunables = t; }
+  void  set_tb_cache(srsran_pdsch_tb_cache_t* cache) { srsran_enb_dl_set_tb_cache(&enb_dl, cache); }
 
   int      add_rnti(uint16_t rnti);
   void     rem_rnti(uint16_t rnti);
@@ -55,11 +58,23 @@ public:
   int  read_pucch_d(cf_t* pusch_d);
   void start_plot();
 
+  /// PMCH of the MBSFN area in the current subframe, encoded once and mapped to the grid of every carrier
+  struct pmch_tx_t {
+    srsran_pmch_cfg_t cfg     = {};
+    const cf_t*       symbols = nullptr;
+  };
+
   void work_ul(const srsran_ul_sf_cfg_t& ul_sf, stack_interface_phy_lte::ul_sched_t& ul_grants);
   void work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                stack_interface_phy_lte::dl_sched_t& dl_grants,
                stack_interface_phy_lte::ul_sched_t& ul_grants,
-               srsran_mbsfn_cfg_t*                  mbsfn_cfg);
+               const pmch_tx_t*                     pmch);
+
+  /// Encodes the MCH transport block for this carrier's bandwidth, the symbols stay valid until the next call
+  int encode_pmch(const srsran_dl_sf_cfg_t&                  dl_sf_cfg,
+                  stack_interface_phy_lte::dl_sched_grant_t* grant,
+                  srsran_mbsfn_cfg_t*                        mbsfn_cfg,
+                  pmch_tx_t&                                 pmch);
 
   uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
 
@@ -68,15 +83,27 @@ private:
   constexpr static float PUCCH_RL_CORR_TH   = 0.15f;
 
   int  encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
-  int  encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant, srsran_mbsfn_cfg_t* mbsfn_cfg);
-  bool decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
-                         srsran_ul_cfg_t&                           ul_cfg,
-                         srsran_pusch_res_t&                        pusch_res);
-  void decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch);
+  int  put_pmch(const pmch_tx_t& pmch);
+  /// State of the PUSCH reception of one grant between its setup, its decoding and its reporting to the MAC
+  struct pusch_job_t {
+    stack_interface_phy_lte::ul_sched_grant_t* ul_grant     = nullptr;
+    srsran_ul_cfg_t                            ul_cfg       = {};
+    srsran_pusch_res_t                         pusch_res    = {};
+    srsran_chest_ul_res_t                      chest_res    = {};
+    bool                                       uci_required = false;
+    bool                                       decoded      = false;
+  };
+
+  bool        setup_pusch_rnti(pusch_job_t& job);
+  void        decode_pusch_rnti(srsran_enb_ul_t* decoder, pusch_job_t& job);
+  void        report_pusch_rnti(pusch_job_t& job);
+  static void decode_pusch_lane(void* arg, uint32_t lane);
+  void        decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch);
   int  encode_phich(stack_interface_phy_lte::ul_sched_ack_t* acks, uint32_t nof_acks);
   int  encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
   int  encode_pdcch_ul(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_grants);
   int  decode_pucch();
+  void report_ul_feedback();
 
   /* Common objects */
   srslog::basic_logger& logger;
@@ -86,10 +113,33 @@ private:
   cf_t*    signal_buffer_rx[SRSRAN_MAX_PORTS] = {};
   cf_t*    signal_buffer_tx[SRSRAN_MAX_PORTS] = {};
   uint32_t tti_rx = 0, tti_tx_dl = 0, tti_tx_ul = 0;
+  bool     shed_load = false;
+
+  phy_tunables_t tunables = {};
 
   srsran_enb_dl_t enb_dl = {};
   srsran_enb_ul_t enb_ul = {};
 
+  // Additional PUSCH decoders for the threads of the PUSCH decoder pool, they decode from the grid of enb_ul
+  std::vector<srsran_enb_ul_t> pusch_decoders;
+  std::vector<pusch_job_t>     pusch_jobs;
+  uint32_t                     nof_pusch_jobs = 0;
+
+  // UL feedback and received PUSCH PDUs of the TTI, given to the MAC once all the UL channels are decoded
+  struct pusch_pdu_t {
+    uint16_t rnti;
+    uint32_t nof_bytes;
+    bool     crc;
+    uint32_t nof_prb;
+  };
+  stack_interface_phy_lte::ul_feedback_list_t ul_feedback;
+  std::vector<pusch_pdu_t>                    pusch_pdus;
+
+  // PUCCH configurations and results of the users with UCI in the TTI, detected in a single batch
+  std::vector<uint16_t>           pucch_rnti;
+  std::vector<srsran_pucch_cfg_t> pucch_cfg;
+  std::vector<srsran_pucch_res_t> pucch_res;
+
   srsran_dl_sf_cfg_t dl_sf = {};
   srsran_ul_sf_cfg_t ul_sf = {};
 
@@ -61,6 +61,9 @@ public:
 private:
   void work_imp() final;
 
+  /// Runs job(arg, cc) for every carrier, in the carrier worker pool if there is one, and waits for all of them
+  void run_cc_jobs(void (*job)(void* arg, uint32_t cc), void* arg);
+
   /* Common objects */
   srslog::basic_logger& logger;
   phy_common*           phy       = nullptr;
@@ -73,6 +76,9 @@ private:
   srsran::phy_common_interface::worker_context_t context = {};
 
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
+
+  // Rate matched SI and paging transport blocks, shared by the carriers of this worker
+  srsran_pdsch_tb_cache_t bcast_tb_cache = {};
 };
 
 } // namespace lte
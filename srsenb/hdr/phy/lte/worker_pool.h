@@ -33,6 +33,12 @@ class worker_pool
   srsran::thread_pool                      pool;
   std::vector<std::unique_ptr<sf_worker> > workers;
 
+  struct init_arg_t {
+    worker_pool* pool;
+    phy_common*  common;
+  };
+  static void init_job(void* arg, uint32_t idx);
+
 public:
   sf_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
   uint32_t   get_nof_workers() { return (uint32_t)workers.size(); }
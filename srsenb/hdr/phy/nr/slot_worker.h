@@ -27,6 +27,7 @@
 #include "srsran/interfaces/phy_common_interface.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
+#include <atomic>
 
 namespace srsenb {
 namespace nr {
@@ -67,7 +68,11 @@ public:
     srsran_subcarrier_spacing_t scs              = srsran_subcarrier_spacing_15kHz;
     uint32_t                    pusch_max_its    = 10;
     float                       pusch_min_snr_dB = -10.0f;
+    bool                        pusch_wiener     = false;
+    int32_t                     ldpc_workers     = -1; ///< LDPC decoding threads of the FEC offload, -1 to disable
     double                      srate_hz         = 0.0;
+    srsran::task_thread_pool*   ul_pool          = nullptr; ///< Processes the UL alongside the DL, if not null
+    uint32_t                    nof_pdsch_enc    = 1;       ///< PDSCH encoded in parallel by ul_pool, 1 for serial
   };
 
   slot_worker(srsran::phy_common_interface& common_,
@@ -106,6 +111,22 @@ private:
    */
   bool work_dl();
 
+  /**
+   * @brief Encodes a PDSCH of the DL scheduling result with the given gNb DL encoder and logs it
+   * @return True if no error occurs, false otherwise
+   */
+  bool encode_pdsch(uint32_t enc_idx, const stack_interface_phy_nr::pdsch_t& pdsch);
+
+  /**
+   * @brief Encodes the PDSCH of the slot that are not taken yet with the encoder enc_idx, used as parallel_for task
+   */
+  static void run_pdsch_encoder(void* arg, uint32_t enc_idx);
+
+  /**
+   * @brief Runs the UL (stage_idx = 1) or the DL (stage_idx = 0) processing of the slot, used as parallel_for task
+   */
+  static void run_stage(void* arg, uint32_t stage_idx);
+
   srsran::phy_common_interface& common;
   stack_interface_phy_nr&       stack;
   srslog::basic_logger&         logger;
@@ -120,6 +141,13 @@ private:
   srsran_pdcch_cfg_nr_t                          pdcch_cfg   = {};
   srsran_gnb_dl_t                                gnb_dl      = {};
   srsran_gnb_ul_t                                gnb_ul      = {};
+  srsran_fec_offload_t                           fec_offload = {};
+  srsran::task_thread_pool*                      ul_pool     = nullptr;
+  bool                                           ul_ok       = false;
+  bool                                           dl_ok       = false;
+  const stack_interface_phy_nr::dl_sched_t*      dl_sched    = nullptr; ///< Slot DL result, while its PDSCH are encoded
+  std::atomic<uint32_t>                          pdsch_next  = {0};     ///< Next PDSCH to encode
+  std::atomic<bool>                              pdsch_ok    = {true};
   std::vector<cf_t*>                             tx_buffer; ///< Baseband transmit buffers
   std::vector<cf_t*>                             rx_buffer; ///< Baseband receive buffers
   std::mutex mutex; ///< Protect concurrent access from workers (and main process that inits the class)
@@ -91,6 +91,7 @@ private:
   stack_interface_phy_nr&                    stack;
   srslog::sink&                              log_sink;
   srsran::thread_pool                        pool;
+  std::unique_ptr<srsran::task_thread_pool>  ul_pool; ///< Shared by the workers for UL, DL and PDSCH in parallel
   std::vector<std::unique_ptr<slot_worker> > workers;
   prach_worker_pool                          prach;
   uint32_t                                   current_tti = 0; ///< Current TTI, read and write from same thread
@@ -103,10 +104,14 @@ public:
   struct args_t {
     double                 srate_hz          = 0.0;
     uint32_t               nof_phy_threads   = 3;
+    uint32_t               min_phy_threads   = 0;
+    uint32_t               nof_ul_threads    = 0;
     uint32_t               nof_prach_workers = 0;
     uint32_t               prio              = 52;
     uint32_t               pusch_max_its     = 10;
     float                  pusch_min_snr_dB  = -10;
+    bool                   pusch_wiener      = false;
+    int32_t                ldpc_workers      = -1;
     srsran::phy_log_args_t log               = {};
   };
   slot_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
@@ -57,6 +57,13 @@ public:
             enb_time_interface*          enb_);
   void stop() override;
 
+  /// Uses the given pool, shared with other eNB instances, for processing the carriers and decoding the PUSCH in
+  /// parallel instead of creating them. It has to be set before init(), the pool is not stopped by this PHY
+  void set_shared_task_pool(std::shared_ptr<srsran::task_thread_pool> pool) { shared_task_pool = std::move(pool); }
+
+  /// Creates a pool of nof_threads with the priority of the PHY workers, to be shared by several eNB instances
+  static std::shared_ptr<srsran::task_thread_pool> create_shared_task_pool(uint32_t nof_threads);
+
   std::string get_type() override { return "lte"; };
 
   /* MAC->PHY interface */
@@ -73,9 +80,11 @@ public:
   void complete_config(uint16_t rnti) override;
 
   void get_metrics(std::vector<phy_metrics_t>& metrics) override;
+  void get_timing_metrics(phy_timing_metrics_t& m) override;
 
   void cmd_cell_gain(uint32_t cell_id, float gain_db) override;
   void cmd_cell_measure() override;
+  void set_tunables(const phy_tunables_t& tunables) override;
 
   void radio_overflow() override{};
   void radio_failure() override{};
@@ -85,8 +94,9 @@ public:
   int set_common_cfg(const common_cfg_t& common_cfg) override;
 
 private:
-  srsran::phy_cfg_mbsfn_t mbsfn_config = {};
-  uint32_t                nof_workers  = 0;
+  srsran::phy_cfg_mbsfn_t                   mbsfn_config = {};
+  uint32_t                                  nof_workers  = 0;
+  std::shared_ptr<srsran::task_thread_pool> shared_task_pool;
 
   const static int MAX_WORKERS = 4;
 
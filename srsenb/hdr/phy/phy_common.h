@@ -23,6 +23,7 @@
 #define SRSENB_PHCH_COMMON_H
 
 #include "phy_interfaces.h"
+#include "srsenb/hdr/phy/phy_metrics.h"
 #include "srsenb/hdr/phy/phy_ue_db.h"
 #include "srsran/common/gen_mch_tables.h"
 #include "srsran/common/interfaces_common.h"
@@ -68,9 +69,39 @@ public:
    */
   void worker_end(const worker_context_t& w_ctx, const bool& tx_enable, srsran::rf_buffer_t& buffer) override;
 
+  /**
+   * Sets the time at which the last received subframe ends, which is the reference for measuring the slack of the
+   * transmissions
+   */
+  void set_rx_end_time(const srsran_timestamp_t& rx_end_time);
+
+  /**
+   * Returns true if the TTI about to be processed follows a late one and has to shed load. Each call counts as one TTI
+   */
+  bool get_load_shedding();
+
+  /**
+   * Tunables changed while running. The workers read them once per subframe, so the change applies from a subframe
+   * boundary
+   */
+  void           set_tunables(const phy_tunables_t& t) { tunables = t; }
+  phy_tunables_t get_tunables() const { return tunables; }
+
+  /**
+   * Returns the timing metrics since the previous call
+   */
+  void get_timing_metrics(phy_timing_metrics_t& m);
+
   // Common objects
   phy_args_t params = {};
 
+  // Threads shared by the workers for processing the carriers of a subframe in parallel, null if disabled. The pools
+  // may also be shared with the other eNB instances hosted in the process
+  std::shared_ptr<srsran::task_thread_pool> cc_worker_pool;
+
+  // Threads shared by the carrier workers for decoding the PUSCH of several users in parallel, null if disabled
+  std::shared_ptr<srsran::task_thread_pool> pusch_decoder_pool;
+
   uint32_t get_nof_carriers_lte() { return static_cast<uint32_t>(cell_list_lte.size()); }
   uint32_t get_nof_carriers_nr() { return static_cast<uint32_t>(cell_list_nr.size()); }
   uint32_t get_nof_carriers() { return static_cast<uint32_t>(cell_list_lte.size() + cell_list_nr.size()); }
@@ -321,6 +352,15 @@ private:
   srsran::rf_buffer_t     tx_buffer        = {};
   bool                    is_mch_subframe(srsran_mbsfn_cfg_t* cfg, uint32_t phy_tti);
   bool                    is_mcch_subframe(srsran_mbsfn_cfg_t* cfg, uint32_t phy_tti);
+
+  // Processing slack, measured in microseconds of radio time
+  std::atomic<uint64_t> rx_end_us      = {0};
+  std::atomic<uint32_t> shed_nof_tti   = {0};
+
+  std::atomic<phy_tunables_t> tunables = {};
+  std::mutex            timing_mutex   = {};
+  phy_timing_metrics_t  timing_metrics = {};
+  void                  update_slack(const srsran_timestamp_t& tx_time);
 };
 
 } // namespace srsenb
@@ -55,6 +55,12 @@ struct cfr_args_t {
   float             ema_alpha        = 1.0f / (float)SRSRAN_CP_NORM_NSYMB;
 };
 
+/// Subset of the PHY args that can be changed while running
+struct phy_tunables_t {
+  uint32_t pusch_max_its  = 10;
+  bool     use_cedron_alg = false;
+};
+
 struct phy_args_t {
   std::string            type;
   srsran::phy_log_args_t log;
@@ -62,10 +68,14 @@ struct phy_args_t {
   float                   rx_gain_offset      = 62;
   float                   max_prach_offset_us = 10;
   uint32_t                pusch_max_its       = 10;
+  uint32_t                late_pusch_max_its  = 0;
   uint32_t                nr_pusch_max_its    = 10;
+  bool                    nr_pusch_wiener     = false;
+  int32_t                 nr_ldpc_workers     = -1;
   bool                    pusch_8bit_decoder  = false;
   float                   tx_amplitude        = 1.0f;
   uint32_t                nof_phy_threads     = 1;
+  uint32_t                min_phy_threads     = 0;
   std::string             equalizer_mode      = "mmse";
   float                   estimator_fil_w     = 1.0f;
   bool                    pusch_meas_epre     = true;
@@ -74,6 +84,13 @@ struct phy_args_t {
   bool                    pucch_meas_ta       = true;
   bool                    use_cedron_alg      = false;
   uint32_t                nof_prach_threads   = 1;
+  bool                    prach_shared_pool   = false;
+  uint32_t                prach_cpu_mask      = 255;
+  uint32_t                rx_prefetch_sf      = 0;
+  uint32_t                nof_cc_threads      = 0;
+  uint32_t                nof_pusch_threads   = 0;
+  uint32_t                nof_nr_ul_threads   = 0;
+  uint32_t                nof_init_threads    = 1;
   bool                    extended_cp         = false;
   srsran::channel::args_t dl_channel_args;
   srsran::channel::args_t ul_channel_args;
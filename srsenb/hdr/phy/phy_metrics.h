@@ -53,6 +53,17 @@ struct phy_metrics_t {
   ul_metrics_t ul;
 };
 
+// PHY processing timing, the slack of a TTI is the time left until its transmission when the workers are done with it
+
+struct phy_timing_metrics_t {
+  static const uint32_t nof_bins = 5; ///< Slack below 0, 0-500 us, 500-1000 us, 1000-2000 us and from 2000 us
+  uint32_t              nof_tti;
+  uint32_t              nof_late;
+  uint32_t              nof_shed_tti;
+  uint32_t              slack_hist[nof_bins];
+  float                 min_slack_us;
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_PHY_METRICS_H
@@ -23,9 +23,12 @@
 #define SRSENB_PHY_UE_DB_H_
 
 #include "phy_interfaces.h"
+#include "srsenb/hdr/common/common_enb.h"
+#include "srsran/adt/rcu_circular_map.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_phy_interfaces.h"
-#include <map>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <srsran/adt/circular_array.h>
 
@@ -81,37 +84,62 @@ private:
   } cell_state_t;
 
   /**
-   * Cell information for the UE database
+   * Cell configuration of the UE, part of the UE configuration snapshot
    */
   struct cell_info_t {
-    cell_state_t state      = cell_state_none; ///< Configuration state
-    uint32_t     enb_cc_idx = 0;               ///< Corresponding eNb cell/carrier index
-    uint8_t      last_ri    = 0;               ///< Last reported rank indicator
+    cell_state_t      state                   = cell_state_none; ///< Configuration state
+    uint32_t          enb_cc_idx              = 0;               ///< Corresponding eNb cell/carrier index
+    bool              stash_use_tbs_index_alt = false;
+    srsran::phy_cfg_t phy_cfg; ///< Configuration, it has a default constructor
+  };
+
+  /**
+   * UE configuration snapshot. A published snapshot is never modified, the stack updates publish a modified copy
+   */
+  struct ue_cfg_t {
+    bool                                         stashed_multiple_csi_request_enabled = false;
+    std::array<cell_info_t, SRSRAN_MAX_CARRIERS> cell_info = {}; ///< Cell information, indexed by ue_cc_idx
+  };
+
+  /**
+   * Cell state of the UE updated by the workers every TTI
+   */
+  struct cell_tti_state_t {
+    uint8_t last_ri = 0; ///< Last reported rank indicator
     srsran::circular_array<srsran_ra_tb_t, SRSRAN_MAX_HARQ_PROC> last_tb =
         {}; ///< Stores last PUSCH Resource allocation
-    bool                                    stash_use_tbs_index_alt = false;
-    srsran::phy_cfg_t                       phy_cfg;            ///< Configuration, it has a default constructor
-    srsran::circular_array<bool, TTIMOD_SZ> is_grant_available; ///< Indicates whether there is an available grant
+    srsran::circular_array<bool, TTIMOD_SZ> is_grant_available = {}; ///< Indicates whether there is an available grant
   };
 
   /**
-   * UE object stored in the PHY common database
+   * UE object stored in the PHY common database. The workers read the configuration without locking, the TTI state is
+   * protected by a mutex per UE, so that workers only contend when they process the same UE
    */
   struct common_ue {
-    bool                                                  stashed_multiple_csi_request_enabled = false;
+    std::atomic<const ue_cfg_t*> cfg{nullptr}; ///< Current configuration snapshot, never null once inserted
+    std::mutex                   mutex;        ///< Protects the TTI state below
     srsran::circular_array<srsran_pdsch_ack_t, TTIMOD_SZ> pdsch_ack = {}; ///< Pending acknowledgements for this Cell
-    std::array<cell_info_t, SRSRAN_MAX_CARRIERS>          cell_info = {}; ///< Cell information, indexed by ue_cell_idx
+    std::array<cell_tti_state_t, SRSRAN_MAX_CARRIERS>     cell_state = {}; ///< Cell TTI state, indexed by ue_cc_idx
+
+    ~common_ue() { delete cfg.load(std::memory_order_relaxed); }
   };
 
   /**
-   * UE database indexed by RNTI
+   * UE database indexed by RNTI, with the same capacity and indexing as the MAC UE database so that any RNTI accepted
+   * by MAC fits. Lookups are lock-free and must be done inside a read guard
+   */
+  using ue_db_t = srsran::rcu_circular_map<uint16_t, std::unique_ptr<common_ue>, SRSENB_MAX_UES>;
+  ue_db_t ue_db;
+
+  /**
+   * Read-copy-update domain of the configuration snapshots, the previous snapshot is deleted once no worker reads it
    */
-  std::map<uint16_t, common_ue> ue_db;
+  srsran::rcu_domain cfg_rcu;
 
   /**
-   * Concurrency protection mutex, allowed modifications from const methods.
+   * Serializes the UE additions, removals and configuration updates from the stack
    */
-  mutable std::mutex mutex;
+  std::mutex mutex;
 
   /**
    * Stack interface
@@ -129,20 +157,38 @@ private:
   const phy_cell_cfg_list_t* cell_cfg_list = nullptr;
 
   /**
-   * Internal RNTI addition, it is not thread safe protected
+   * Gets the current configuration snapshot of a UE, it remains valid while the caller holds a cfg_rcu read guard
+   *
+   * @param ue UE object (requires a ue_db read guard)
+   * @return the configuration snapshot
+   */
+  static const ue_cfg_t& _get_cfg(const common_ue& ue) { return *ue.cfg.load(std::memory_order_acquire); }
+
+  /**
+   * Internal RNTI addition with the default configuration, it requires holding the mutex
    *
    * @param rnti identifier of the UE
-   * @return SRSRAN_SUCCESS if the RNTI is not duplicated and is added successfully, SRSRAN_ERROR code if it exists
+   * @return the new UE object, nullptr if the RNTI position in the database is taken
    */
-  inline int _add_rnti(uint16_t rnti);
+  inline common_ue* _add_rnti(uint16_t rnti);
 
   /**
-   * Internal pending ACK clear for a given RNTI and TTI, it is not thread safe protected
+   * Publishes a new configuration snapshot of a UE and deletes the previous one once no worker reads it, it requires
+   * holding the mutex
+   *
+   * @param ue UE object
+   * @param cfg new configuration
+   */
+  void _publish_config(common_ue& ue, const ue_cfg_t& cfg);
+
+  /**
+   * Internal pending ACK clear for a given UE and TTI, it requires holding the UE mutex
    *
    * @param tti is the given TTI (requires assertion prior to call)
-   * @param rnti identifier of the UE (requires assertion prior to call)
+   * @param ue UE object
+   * @param cfg UE configuration snapshot
    */
-  inline void _clear_tti_pending_rnti(uint32_t tti, uint16_t rnti);
+  static inline void _clear_tti_pending_rnti(uint32_t tti, common_ue& ue, const ue_cfg_t& cfg);
 
   /**
    * Helper method to set the constant attributes of a given RNTI after the configuration is set, it does not modify
@@ -154,14 +200,14 @@ private:
   inline void _set_common_config_rnti(uint16_t rnti, srsran::phy_cfg_t& phy_cfg) const;
 
   /**
-   * Gets the SCell index for a given RNTI and a eNb cell/carrier. It returns the SCell index (0 if PCell) if the cc_idx
+   * Gets the SCell index for a given UE and a eNb cell/carrier. It returns the SCell index (0 if PCell) if the cc_idx
    * is found among the configured cells/carriers. Otherwise, it returns SRSRAN_MAX_CARRIERS.
    *
-   * @param rnti identifier of the UE (requires assertion prior to call)
+   * @param cfg UE configuration snapshot
    * @param enb_cc_idx the eNb cell/carrier index to look for in the RNTI.
    * @return the SCell index as described above.
    */
-  inline uint32_t _get_ue_cc_idx(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline uint32_t _get_ue_cc_idx(const ue_cfg_t& cfg, uint32_t enb_cc_idx);
 
   /**
    * Gets the eNb Cell/Carrier index in which the UCI shall be carried. This corresponds to the serving cell with lowest
@@ -170,49 +216,43 @@ private:
    * If no grant is available in the indicated TTI, it returns the number of the eNb Cells/Carriers.
    *
    * @param tti The UL processing TTI
-   * @param rnti Temporal UE ID
+   * @param ue UE object (requires holding the UE mutex)
+   * @param cfg UE configuration snapshot
    * @return the eNb Cell/Carrier with lowest serving cell index that has an UL grant
    */
-  uint32_t _get_uci_enb_cc_idx(uint32_t tti, uint16_t rnti) const;
-
-  /**
-   * Checks if a given RNTI exists in the database
-   * @param rnti provides UE identifier
-   * @return SRSRAN_SUCCESS if the indicated RNTI exists, otherwise it returns SRSRAN_ERROR
-   */
-  inline int _assert_rnti(uint16_t rnti) const;
+  uint32_t _get_uci_enb_cc_idx(uint32_t tti, const common_ue& ue, const ue_cfg_t& cfg) const;
 
   /**
-   * Checks if an RNTI is configured to use an specified eNb cell/carrier as PCell or SCell
-   * @param rnti provides UE identifier
+   * Checks if a UE is configured to use an specified eNb cell/carrier as PCell or SCell
+   * @param cfg UE configuration snapshot
    * @param enb_cc_idx provides eNb cell/carrier
-   * @return SRSRAN_SUCCESS if the indicated RNTI exists, otherwise it returns SRSRAN_ERROR
+   * @return SRSRAN_SUCCESS if the indicated eNb cell/carrier is configured, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline int _assert_enb_cc(const ue_cfg_t& cfg, uint32_t enb_cc_idx);
 
   /**
-   * Checks if an RNTI uses a given eNb cell/carrier as PCell
-   * @param rnti provides UE identifier
+   * Checks if a UE uses a given eNb cell/carrier as PCell
+   * @param cfg UE configuration snapshot
    * @param enb_cc_idx provides eNb cell/carrier index
    * @return SRSRAN_SUCCESS if the indicated eNb cell/carrier of the RNTI is a PCell, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_enb_pcell(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline int _assert_enb_pcell(const ue_cfg_t& cfg, uint32_t enb_cc_idx);
 
   /**
-   * Checks if an RNTI is configured to use an specified UE cell/carrier as PCell or SCell
-   * @param rnti provides UE identifier
+   * Checks if a UE is configured to use an specified UE cell/carrier as PCell or SCell
+   * @param cfg UE configuration snapshot
    * @param ue_cc_idx UE cell/carrier index that is asserted
    * @return SRSRAN_SUCCESS if the indicated cell/carrier index is valid, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const;
+  static inline int _assert_ue_cc(const ue_cfg_t& cfg, uint32_t ue_cc_idx);
 
   /**
-   * Checks if an RNTI is configured to use an specified eNb cell/carrier as PCell or SCell and it is active
-   * @param rnti provides UE identifier
+   * Checks if a UE is configured to use an specified eNb cell/carrier as PCell or SCell and it is active
+   * @param cfg UE configuration snapshot
    * @param enb_cc_idx UE cell/carrier index that is asserted
    * @return SRSRAN_SUCCESS if the indicated eNb cell/carrier is active, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_active_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline int _assert_active_enb_cc(const ue_cfg_t& cfg, uint32_t enb_cc_idx);
 
   /**
    * Internal eNb stack assertion
@@ -239,12 +279,15 @@ private:
   /**
    * Count number of configured secondary serving cells
    *
-   * @param rnti provides UE identifier
+   * @param cfg UE configuration snapshot
    * @return The number of configured secondary cells
    */
-  inline uint32_t _count_nof_configured_scell(uint16_t rnti);
+  static inline uint32_t _count_nof_configured_scell(const ue_cfg_t& cfg);
 
 public:
+  using ul_feedback_t      = stack_interface_phy_lte::ul_feedback_t;
+  using ul_feedback_list_t = stack_interface_phy_lte::ul_feedback_list_t;
+
   /**
    * Initialises the UE database with the stack and cell list
    * @param stack_ptr points to the stack (read/write)
@@ -379,18 +422,21 @@ public:
                    srsran_uci_cfg_t& uci_cfg);
 
   /**
-   * Sends the decoded Uplink Control Information by PUCCH or PUSCH to MAC
+   * Appends the decoded Uplink Control Information by PUCCH or PUSCH to the UL feedback of the TTI, which is given to
+   * MAC in a single call once all the UL channels of the TTI are decoded
    * @param tti the current TTI
    * @param rnti is the UE identifier
    * @param uci_cfg is the UCI configuration
    * @param uci_value is the UCI received value
+   * @param feedback is the UL feedback list of the TTI
    * @return SRSRAN_SUCCESS if provided RNTI exists in the given cell, SRSRAN_ERROR code otherwise
    */
   int send_uci_data(uint32_t                  tti,
                     uint16_t                  rnti,
                     uint32_t                  enb_cc_idx,
                     const srsran_uci_cfg_t&   uci_cfg,
-                    const srsran_uci_value_t& uci_value);
+                    const srsran_uci_value_t& uci_value,
+                    ul_feedback_list_t&       feedback);
 
   static void send_cqi_data(uint32_t                       tti,
                             uint16_t                       rnti,
@@ -399,7 +445,7 @@ public:
                             const srsran_cqi_value_t&      cqi_value,
                             const srsran_cqi_report_cfg_t& cqi_report_cfg,
                             const srsran_cell_t&           cell,
-                            stack_interface_phy_lte*       stack);
+                            ul_feedback_list_t&            feedback);
 
   /**
    * Set the latest UL Transport Block resource allocation for a given RNTI, eNb cell/carrier and UL HARQ process
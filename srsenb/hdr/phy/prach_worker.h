@@ -22,12 +22,14 @@
 #ifndef SRSENB_PRACH_WORKER_H
 #define SRSENB_PRACH_WORKER_H
 
-#include "srsran/common/block_queue.h"
+#include "srsran/adt/mpmc_queue.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/common/threads.h"
 #include "srsran/interfaces/enb_phy_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include <atomic>
+#include <mutex>
 
 // Setting ENABLE_PRACH_GUI to non zero enables a GUI showing signal received in the PRACH window.
 #define ENABLE_PRACH_GUI 0
@@ -44,7 +46,11 @@ class prach_worker : srsran::thread
 {
 public:
   prach_worker(uint32_t cc_idx_, srslog::basic_logger& logger) :
-    buffer_pool(8), thread("PRACH_WORKER"), logger(logger), running(false)
+    buffer_pool(8, "prach_buffer_pool"),
+    pending_buffers(16),
+    thread("PRACH_WORKER"),
+    logger(logger),
+    running(false)
   {
     cc_idx = cc_idx_;
   }
@@ -53,7 +59,8 @@ public:
             const srsran_prach_cfg_t& prach_cfg_,
             stack_interface_phy_lte*  mac,
             int                       priority,
-            uint32_t                  nof_workers);
+            uint32_t                  nof_workers,
+            srsran::task_thread_pool* shared_pool_ = nullptr);
   int  new_tti(uint32_t tti, cf_t* buffer);
   void set_max_prach_offset_us(float delay_us);
   void stop();
@@ -91,8 +98,8 @@ private:
     char debug_name[SRSRAN_BUFFER_POOL_LOG_NAME_LEN];
 #endif /* SRSRAN_BUFFER_POOL_LOG_ENABLED */
   };
-  srsran::buffer_pool<sf_buffer>  buffer_pool;
-  srsran::block_queue<sf_buffer*> pending_buffers;
+  srsran::buffer_pool<sf_buffer> buffer_pool;
+  srsran::mpmc_queue<sf_buffer*> pending_buffers;
 
   srslog::basic_logger&    logger;
   sf_buffer*               current_buffer      = nullptr;
@@ -104,19 +111,37 @@ private:
   uint32_t                 sf_cnt      = 0;
   uint32_t                 nof_workers = 0;
 
+  // When set, the buffers are processed by the threads shared with the other carriers instead of a thread of our own.
+  // The mutex keeps the threads of the pool from using the PRACH detector of this carrier concurrently.
+  srsran::task_thread_pool* shared_pool = nullptr;
+  std::mutex                detect_mutex;
+
   void run_thread() final;
   int  run_tti(sf_buffer* b);
+  void run_shared_tti(sf_buffer* b);
 };
 
 class prach_worker_pool
 {
 private:
   std::vector<std::unique_ptr<prach_worker> > prach_vec;
+  std::unique_ptr<srsran::task_thread_pool>   shared_pool;
 
 public:
   prach_worker_pool()  = default;
   ~prach_worker_pool() = default;
 
+  /// Makes the carriers initialised from now on share a pool of nof_threads threads, pinned to the CPUs in cpu_mask
+  /// (255 for no pinning), instead of running one thread each. Any idle thread picks up the next pending PRACH buffer,
+  /// whatever its carrier is, so the latency does not grow with the number of carriers as long as there are threads.
+  void init_shared_pool(uint32_t nof_threads, int priority, uint32_t cpu_mask)
+  {
+    if (nof_threads > 0 && shared_pool == nullptr) {
+      shared_pool = std::unique_ptr<srsran::task_thread_pool>(
+          new srsran::task_thread_pool(nof_threads, false, priority, cpu_mask));
+    }
+  }
+
   void init(uint32_t                  cc_idx,
             const srsran_cell_t&      cell_,
             const srsran_prach_cfg_t& prach_cfg_,
@@ -130,7 +155,7 @@ public:
       prach_vec.push_back(std::unique_ptr<prach_worker>(new prach_worker(prach_vec.size(), logger)));
     }
 
-    prach_vec[cc_idx]->init(cell_, prach_cfg_, mac, priority, nof_workers_x_cc);
+    prach_vec[cc_idx]->init(cell_, prach_cfg_, mac, priority, nof_workers_x_cc, shared_pool.get());
   }
 
   void set_max_prach_offset_us(float delay_us)
@@ -142,6 +167,10 @@ public:
 
   void stop()
   {
+    // Join the shared threads before the workers release their PRACH detectors
+    if (shared_pool != nullptr) {
+      shared_pool->stop();
+    }
     for (auto& prach : prach_vec) {
       prach->stop();
     }
@@ -26,11 +26,13 @@
 #include "prach_worker.h"
 #include "srsenb/hdr/phy/lte/worker_pool.h"
 #include "srsenb/hdr/phy/nr/worker_pool.h"
+#include "srsran/adt/mpmc_queue.h"
 #include "srsran/config.h"
 #include "srsran/interfaces/enb_time_interface.h"
 #include "srsran/phy/channel/channel.h"
 #include "srsran/radio/radio.h"
 #include <atomic>
+#include <memory>
 
 namespace srsenb {
 
@@ -48,7 +50,33 @@ public:
   void stop();
 
 private:
+  /// Subframe received from the radio straight into the buffers of its workers, waiting to be dispatched
+  struct rx_sf_t {
+    uint32_t               tti        = 0;
+    lte::sf_worker*        lte_worker = nullptr;
+    nr::slot_worker*       nr_worker  = nullptr;
+    srsran::rf_buffer_t    buffer     = {};
+    srsran::rf_timestamp_t timestamp  = {};
+    bool                   valid      = false; ///< Cleared once the radio thread has stopped
+  };
+
+  /// Radio thread of the pipelined mode. It acquires the workers and receives into their buffers ahead of the
+  /// dispatching, with up to rx_prefetch_sf subframes in flight, so the radio is not held back by the dispatching.
+  class rx_thread_t final : public srsran::thread
+  {
+  public:
+    explicit rx_thread_t(txrx* parent_) : thread("TXRX_RX"), parent(parent_) {}
+
+  private:
+    void  run_thread() override { parent->run_rx_thread(); }
+    txrx* parent;
+  };
+
   void run_thread() override;
+  void run_rx_thread();
+  void configure_radio();
+  bool receive_sf(uint32_t tti_rx, rx_sf_t& sf);
+  void dispatch_sf(rx_sf_t& sf);
 
   enb_time_interface*          enb     = nullptr;
   srsran::radio_interface_phy* radio_h = nullptr;
@@ -60,7 +88,15 @@ private:
   srsran::channel_ptr          ul_channel  = nullptr;
 
   // Main system TTI counter
-  uint32_t tti = 0;
+  uint32_t tti  = 0;
+  uint32_t prio = 0;
+
+  // Pipelined reception, only used if rx_prefetch_sf is not zero. rx_sf_pool holds rx_prefetch_sf + 2 subframes: the
+  // queued ones, the one being received and the one being dispatched
+  uint32_t                      rx_prefetch_sf = 0;
+  std::unique_ptr<rx_sf_t[]>    rx_sf_pool;
+  srsran::mpmc_queue<rx_sf_t*>  rx_sf_queue;
+  std::unique_ptr<rx_thread_t>  rx_thread;
 
   std::atomic<bool> running;
 };
@@ -22,6 +22,8 @@
 #ifndef SRSRAN_ENB_STACK_BASE_H
 #define SRSRAN_ENB_STACK_BASE_H
 
+#include "srsran/common/mac_pcap_base.h"
+#include "srsran/common/pcap_writer.h"
 #include "srsran/interfaces/enb_interfaces.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_s1ap_interfaces.h"
@@ -69,18 +71,27 @@ typedef struct {
 } stack_log_args_t;
 
 typedef struct {
-  uint32_t         sync_queue_size; // Max allowed difference between PHY and Stack clocks (in TTI)
-  uint32_t         gtpu_indirect_tunnel_timeout_msec;
-  mac_args_t       mac;
-  s1ap_args_t      s1ap;
-  pcap_args_t      mac_pcap;
-  pcap_net_args_t  mac_pcap_net;
-  pcap_args_t      s1ap_pcap;
-  stack_log_args_t log;
-  embms_args_t     embms;
+  uint32_t                   sync_queue_size; // Max allowed difference between PHY and Stack clocks (in TTI)
+  uint32_t                   gtpu_indirect_tunnel_timeout_msec;
+  std::string                gtpu_xdp_ifname;
+  uint32_t                   gtpu_xdp_queue_id;
+  uint32_t                   nof_pdcp_crypto_threads; // Threads ciphering the PDCP DRB PDUs, 0 ciphers them in the
+                                                      // stack thread
+  uint32_t                   nof_rrc_ue_threads;      // Threads decoding the UL RRC messages in parallel across UEs,
+                                                      // 0 for none
+  mac_args_t                 mac;
+  s1ap_args_t                s1ap;
+  pcap_args_t                mac_pcap;
+  pcap_net_args_t            mac_pcap_net;
+  pcap_args_t                s1ap_pcap;
+  srsran::pcap_writer_args_t pcap_writer;
+  srsran::mac_pcap_filter_t  mac_pcap_filter;
+  stack_log_args_t           log;
+  embms_args_t               embms;
 } stack_args_t;
 
 struct stack_metrics_t;
+class mac_kpi_sampler;
 
 class enb_stack_base
 {
@@ -92,8 +103,12 @@ public:
   virtual void stop() = 0;
 
   virtual void toggle_padding() = 0;
+  /// Changes the scheduler tunables of a running stack, from the next TTI
+  virtual int set_sched_tunables(const sched_interface::sched_tunables_t& tunables) = 0;
   // eNB metrics interface
   virtual bool get_metrics(stack_metrics_t* metrics) = 0;
+  // Per-TTI MAC KPI samples, or nullptr if the stack does not provide them
+  virtual const mac_kpi_sampler* get_kpi_sampler() = 0;
 
   virtual void tti_clock() = 0;
 };
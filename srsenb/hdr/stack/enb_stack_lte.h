@@ -30,10 +30,12 @@
 #include "mac/mac.h"
 #include "rrc/rrc.h"
 #include "s1ap/s1ap.h"
+#include "srsran/adt/mpmc_queue.h"
 #include "srsran/common/task_scheduler.h"
 #include "upper/gtpu.h"
 #include "upper/pdcp.h"
 #include "upper/rlc.h"
+#include "x2_pdu_channel.h"
 
 #include "enb_stack_base.h"
 #include "srsran/common/bearer_manager.h"
@@ -57,8 +59,9 @@ public:
   // eNB stack base interface
   int  init(const stack_args_t& args_, const rrc_cfg_t& rrc_cfg_, phy_interface_stack_lte* phy_, x2_interface* x2_);
   void stop() final;
-  std::string get_type() final;
-  bool        get_metrics(stack_metrics_t* metrics) final;
+  std::string            get_type() final;
+  bool                   get_metrics(stack_metrics_t* metrics) final;
+  const mac_kpi_sampler* get_kpi_sampler() final { return &mac.get_kpi_sampler(); }
 
   /* PHY-MAC interface */
   int  sr_detected(uint32_t tti, uint16_t rnti) final { return mac.sr_detected(tti, rnti); }
@@ -95,6 +98,7 @@ public:
   {
     return mac.crc_info(tti, rnti, enb_cc_idx, nof_bytes, crc_res);
   }
+  int ul_feedback_info(uint32_t tti, ul_feedback_list_t& feedback) final { return mac.ul_feedback_info(tti, feedback); }
   int push_pdu(uint32_t tti,
                uint16_t rnti,
                uint32_t enb_cc_idx,
@@ -115,6 +119,10 @@ public:
     mac.set_sched_dl_tti_mask(tti_mask, nof_sfs);
   }
   void toggle_padding() override { mac.toggle_padding(); }
+  int  set_sched_tunables(const sched_interface::sched_tunables_t& tunables) override
+  {
+    return mac.set_sched_tunables(tunables);
+  }
   void tti_clock() override;
 
   // rrc_eutra_interface_rrc_nr
@@ -174,6 +182,7 @@ private:
   // task handling
   srsran::task_scheduler    task_sched;
   srsran::task_queue_handle enb_task_queue, sync_task_queue, metrics_task_queue, x2_task_queue;
+  x2_pdu_channel            x2_ul_channel; ///< UL PDUs of the split bearers, written by the NR stack
 
   // bearer management
   enb_bearer_manager                 bearers; // helper to manage mapping between EPS and radio bearers
@@ -186,13 +195,17 @@ private:
   srsenb::gtpu gtpu;
   srsenb::s1ap s1ap;
 
+  // workers ciphering the DRB PDUs of PDCP, if enabled
+  std::unique_ptr<srsran::task_thread_pool> pdcp_crypto_pool;
+  std::unique_ptr<srsran::task_thread_pool> rrc_ue_pool;
+
   // RAT-specific interfaces
   phy_interface_stack_lte* phy = nullptr;
 
   // state
   std::atomic<bool> started{false};
 
-  srsran::dyn_blocking_queue<stack_metrics_t> pending_stack_metrics;
+  srsran::mpmc_queue<stack_metrics_t> pending_stack_metrics;
 };
 
 } // namespace srsenb
@@ -0,0 +1,156 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_MAC_KPI_SAMPLER_H
+#define SRSENB_MAC_KPI_SAMPLER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace srsenb {
+
+/// MAC KPIs of one TTI, or summed over several TTIs, for all the carriers
+struct mac_kpi_sample_t {
+  enum field_t {
+    dl_nof_prb,    ///< PRBs allocated to PDSCH
+    ul_nof_prb,    ///< PRBs allocated to PUSCH
+    dl_bytes,      ///< bytes of the acknowledged DL TBs
+    ul_bytes,      ///< bytes of the UL TBs received without CRC error
+    dl_nof_tb,     ///< DL TBs with HARQ feedback
+    dl_nof_nack,   ///< DL TBs not acknowledged
+    ul_nof_tb,     ///< UL TBs decoded
+    ul_nof_crc_ko, ///< UL TBs with CRC error
+    dl_cqi_sum,    ///< sum of the wideband CQIs reported
+    dl_nof_cqi,    ///< number of wideband CQIs reported
+    nof_fields
+  };
+
+  std::array<uint32_t, nof_fields> values = {};
+
+  uint32_t  operator[](field_t f) const { return values[f]; }
+  uint32_t& operator[](field_t f) { return values[f]; }
+};
+
+/**
+ * Per-TTI sampling of the MAC KPIs.
+ * The MAC events, which happen in the PHY worker threads, are accumulated with relaxed atomic additions, and once per
+ * TTI the accumulated values are moved to a ring with the samples of the last TTIs. The slots of the ring are guarded
+ * by a sequence number (seqlock), so the readers, e.g. the E2 report services, copy the samples without blocking the
+ * MAC, and discard the ones overwritten while they were being read.
+ */
+class mac_kpi_sampler
+{
+public:
+  /// Number of TTIs kept in the ring, i.e. the longest window that can be read
+  static const uint32_t nof_samples = 1024;
+
+  void add_dl_grant(uint32_t nof_prb) { add(mac_kpi_sample_t::dl_nof_prb, nof_prb); }
+  void add_ul_grant(uint32_t nof_prb) { add(mac_kpi_sample_t::ul_nof_prb, nof_prb); }
+  void add_dl_harq_feedback(bool ack, int nof_bytes)
+  {
+    add(mac_kpi_sample_t::dl_nof_tb, 1);
+    if (ack) {
+      add(mac_kpi_sample_t::dl_bytes, nof_bytes > 0 ? nof_bytes : 0);
+    } else {
+      add(mac_kpi_sample_t::dl_nof_nack, 1);
+    }
+  }
+  void add_ul_crc(bool crc, uint32_t nof_bytes)
+  {
+    add(mac_kpi_sample_t::ul_nof_tb, 1);
+    if (crc) {
+      add(mac_kpi_sample_t::ul_bytes, nof_bytes);
+    } else {
+      add(mac_kpi_sample_t::ul_nof_crc_ko, 1);
+    }
+  }
+  void add_dl_cqi(uint32_t cqi)
+  {
+    add(mac_kpi_sample_t::dl_cqi_sum, cqi);
+    add(mac_kpi_sample_t::dl_nof_cqi, 1);
+  }
+
+  /// Stores the values accumulated since the previous call as the sample of a new TTI. Called once per TTI
+  void push_sample()
+  {
+    uint64_t t    = head.load(std::memory_order_relaxed);
+    slot_t&  slot = ring[t % nof_samples];
+    slot.seq.store(2 * t + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (uint32_t i = 0; i < mac_kpi_sample_t::nof_fields; ++i) {
+      slot.values[i].store(acc[i].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    slot.seq.store(2 * t + 2, std::memory_order_release);
+    head.store(t + 1, std::memory_order_release);
+  }
+
+  /**
+   * Adds to "sum" the samples stored after the one pointed by "cursor", at most the last nof_samples, and advances
+   * the cursor past them. Every reader keeps its own cursor, which starts at 0 or at the returned value of skip().
+   * @return number of samples added
+   */
+  uint32_t read_samples(uint64_t& cursor, mac_kpi_sample_t& sum) const
+  {
+    uint64_t h = head.load(std::memory_order_acquire);
+    if (h - cursor > nof_samples) {
+      cursor = h - nof_samples;
+    }
+    uint32_t count = 0;
+    for (; cursor < h; ++cursor) {
+      const slot_t&    slot = ring[cursor % nof_samples];
+      mac_kpi_sample_t sample;
+      uint64_t         seq = slot.seq.load(std::memory_order_acquire);
+      for (uint32_t i = 0; i < mac_kpi_sample_t::nof_fields; ++i) {
+        sample.values[i] = slot.values[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (seq != 2 * cursor + 2 or slot.seq.load(std::memory_order_relaxed) != seq) {
+        // overwritten by a newer TTI
+        continue;
+      }
+      for (uint32_t i = 0; i < mac_kpi_sample_t::nof_fields; ++i) {
+        sum.values[i] += sample.values[i];
+      }
+      count++;
+    }
+    return count;
+  }
+
+  /// Cursor that skips the samples stored so far
+  uint64_t skip() const { return head.load(std::memory_order_acquire); }
+
+private:
+  struct slot_t {
+    std::atomic<uint64_t>                                          seq{0};
+    std::array<std::atomic<uint32_t>, mac_kpi_sample_t::nof_fields> values{};
+  };
+
+  void add(mac_kpi_sample_t::field_t f, uint32_t value) { acc[f].fetch_add(value, std::memory_order_relaxed); }
+
+  std::array<std::atomic<uint32_t>, mac_kpi_sample_t::nof_fields> acc{};
+  std::atomic<uint64_t>                                           head{0};
+  std::array<slot_t, nof_samples>                                 ring;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_MAC_KPI_SAMPLER_H
@@ -25,9 +25,11 @@
 #include "sched.h"
 #include "sched_interface.h"
 #include "srsenb/hdr/common/rnti_pool.h"
+#include "srsenb/hdr/stack/mac/common/mac_kpi_sampler.h"
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_rr.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/pool/batch_mem_pool.h"
+#include "srsran/adt/rcu_circular_map.h"
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/mac_pcap_net.h"
 #include "srsran/common/task_scheduler.h"
@@ -70,6 +72,7 @@ public:
   int ta_info(uint32_t tti, uint16_t rnti, float ta_us) override;
   int ack_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack) override;
   int crc_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t nof_bytes, bool crc_res) override;
+  int ul_feedback_info(uint32_t tti, ul_feedback_list_t& feedback) override;
   int push_pdu(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t nof_bytes, bool crc_res, uint32_t ul_nof_prbs)
       override;
 
@@ -82,6 +85,9 @@ public:
   }
   void build_mch_sched(uint32_t tbs);
 
+  /* Called by the stack every TTI, computes the scheduling decisions ahead of the PHY when lookahead is enabled */
+  void tti_clock();
+
   /******** Interface from RRC (RRC -> MAC) ****************/
   /* Provides cell configuration including SIB periodicity, etc. */
   int cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg) override;
@@ -103,11 +109,18 @@ public:
   uint16_t reserve_new_crnti(const sched_interface::ue_cfg_t& ue_cfg) override;
 
   void get_metrics(mac_metrics_t& metrics);
+  /// Per-TTI samples of the MAC KPIs, read e.g. by the E2 agent with a finer granularity than the metrics
+  const mac_kpi_sampler& get_kpi_sampler() const { return kpi_sampler; }
 
   void toggle_padding();
 
   void add_padding();
 
+  int set_sched_tunables(const sched_interface::sched_tunables_t& tunables)
+  {
+    return scheduler.set_tunables(tunables);
+  }
+
   void write_mcch(const srsran::sib2_mbms_t* sib2_,
                   const srsran::sib13_t*     sib13_,
                   const srsran::mcch_msg_t*  mcch_,
@@ -115,7 +128,7 @@ public:
                   const uint8_t              mcch_payload_length) override;
 
 private:
-  bool     check_ue_active(uint16_t rnti);
+  ue*      find_active_ue(uint16_t rnti);
   uint16_t allocate_ue(uint32_t enb_cc_idx);
   bool     is_valid_rnti_unprotected(uint16_t rnti);
 
@@ -131,8 +144,7 @@ private:
 
   srslog::basic_logger& logger;
 
-  // We use a rwlock in MAC to allow multiple workers to access MAC simultaneously. No conflicts will happen since
-  // access for different TTIs
+  // Protects the cell and eMBMS configurations. The UE database is accessed without locks (see ue_db)
   pthread_rwlock_t rwlock = {};
 
   // Interaction with PHY
@@ -155,10 +167,12 @@ private:
 
   sched_interface::dl_pdu_mch_t mch = {};
 
-  /* Map of active UEs */
-  static const uint16_t            FIRST_RNTI = 0x46;
-  rnti_map_t<unique_rnti_ptr<ue> > ue_db;
-  std::atomic<uint16_t>            ue_counter{0};
+  /* Map of active UEs. The PHY workers look up and iterate the UEs inside a ue_db_t::read_guard, which is wait-free.
+   * UEs are added and removed by the stack thread, and a removal waits for the readers of the UE to finish */
+  using ue_db_t = srsran::rcu_circular_map<uint16_t, unique_rnti_ptr<ue>, SRSENB_MAX_UES>;
+  static const uint16_t FIRST_RNTI = 0x46;
+  ue_db_t               ue_db;
+  std::atomic<uint16_t> ue_counter{0};
 
   uint8_t* assemble_rar(sched_interface::dl_sched_rar_grant_t* grants,
                         uint32_t                               enb_cc_idx,
@@ -200,6 +214,8 @@ private:
   // Number of rach preambles detected for a cc.
   std::vector<uint32_t> detected_rachs;
 
+  mac_kpi_sampler kpi_sampler;
+
   // PDCCH order
   std::vector<sched_interface::dl_sched_po_info_t> pending_po_prachs = {};
 
@@ -24,12 +24,17 @@
 
 #include "sched_grid.h"
 #include "sched_interface.h"
+#include "sched_trace.h"
 #include "sched_ue.h"
 #include "srsenb/hdr/common/common_enb.h"
 #include <atomic>
 #include <map>
 #include <mutex>
 
+namespace srsran {
+class task_thread_pool;
+}
+
 namespace srsenb {
 
 class rrc_interface_mac;
@@ -76,12 +81,16 @@ public:
   int ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr) final;
   int ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb) final;
   int ul_snr_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code) final;
+  int ul_feedback_info(uint32_t tti, ul_feedback_list_t& feedback) final;
 
   int dl_sched(uint32_t tti, uint32_t enb_cc_idx, dl_sched_res_t& sched_result) final;
   int ul_sched(uint32_t tti, uint32_t enb_cc_idx, ul_sched_res_t& sched_result) final;
 
   int set_pdcch_order(uint32_t enb_cc_idx, dl_sched_po_info_t pdcch_order_info) final;
 
+  /// Called every TTI by the stack. If lookahead is enabled, computes the decisions of the next TTIs ahead of the PHY
+  void precompute_ttis();
+
   /* Custom functions
    */
   void                                 set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs) final;
@@ -90,11 +99,18 @@ public:
   int                                  ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes) final;
   int                                  metrics_read(uint16_t rnti, mac_ue_metrics_t& metrics);
 
+  /// Validates the tunables and applies them at the start of the next TTI scheduled, without a restart
+  int set_tunables(const sched_tunables_t& tunables);
+
   class carrier_sched;
 
 protected:
   void new_tti(srsran::tti_point tti_rx);
+  void new_tti_parallel(srsran::tti_point tti_rx);
+  void apply_tunables();
   bool is_generated(srsran::tti_point, uint32_t enb_cc_idx) const;
+  void cancel_ul_retx(srsran::tti_point tti_rx, uint32_t enb_cc_idx, sched_ue& ue);
+  void trace_ul_feedback(uint32_t tti, const ul_feedback_t& fb);
   // Helper methods
   template <typename Func>
   int ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name = nullptr, bool log_fail = true);
@@ -112,7 +128,20 @@ protected:
   // Storage of past scheduling results
   sched_result_ringbuffer sched_results;
 
+  // workers used to schedule the carriers in parallel, if enabled
+  std::unique_ptr<srsran::task_thread_pool> cc_workers;
+  std::vector<uint32_t>                     pending_ccs;
+
+  // recording of the scheduler inputs, if enabled
+  std::unique_ptr<sched_trace_writer> trace;
+
+  // tunables waiting for the next TTI boundary
+  sched_tunables_t pending_tunables;
+  bool             tunables_pending          = false;
+  uint32_t         init_max_nof_ctrl_symbols = 3;
+
   srsran::tti_point last_tti;
+  srsran::tti_point last_phy_tti; ///< Last TTI whose decision was requested by the PHY
   std::mutex        sched_mutex;
   bool              configured;
 };
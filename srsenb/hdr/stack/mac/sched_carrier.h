@@ -43,11 +43,22 @@ public:
   ~carrier_sched();
   void                   reset();
   void                   carrier_cfg(const sched_cell_params_t& sched_params_);
+  void                   set_sched_policy();
   void                   set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs);
   const cc_sched_result& generate_tti_result(srsran::tti_point tti_rx);
   int                    dl_rach_info(dl_sched_rar_info_t rar_info);
   int                    pdcch_order_info(dl_sched_po_info_t pdcch_order_info);
 
+  // Steps of generate_tti_result. Used by sched to run the allocation of several carriers in parallel
+  //! Refresh the UE subframe state and set up the grids. Must run serially for all the carriers
+  void start_tti(srsran::tti_point tti_rx);
+  //! Allocate the PHICH, control and user data of the UEs in the given subset
+  void alloc_tti(srsran::tti_point tti_rx, sf_sched::ue_subset_t subset);
+  //! Allocate the users of the given subset. Returns true if a UE with several carriers got an allocation
+  bool alloc_users(srsran::tti_point tti_rx, sf_sched::ue_subset_t subset);
+  //! Select the DCI positions and store the scheduling results
+  const cc_sched_result& finish_tti(srsran::tti_point tti_rx);
+
   // getters
   const ra_sched* get_ra_sched() const { return ra_sched_ptr.get(); }
   //! Get a subframe result for a given tti
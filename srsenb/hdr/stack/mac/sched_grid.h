@@ -176,11 +176,14 @@ public:
     uint32_t n_prb = 0;
     uint32_t mcs   = 0;
   };
+  //! Set of UEs accepted by the data allocation methods. Used to schedule the carriers in parallel
+  enum class ue_subset_t { all, single_cc, multi_cc };
 
   // Control/Configuration Methods
   sf_sched();
   void init(const sched_cell_params_t& cell_params_);
   void new_tti(srsran::tti_point tti_rx_, sf_sched_result* cc_results);
+  void set_ue_subset(ue_subset_t subset) { ue_subset = subset; }
 
   // DL alloc methods
   alloc_result alloc_sib(uint32_t aggr_lvl, uint32_t sib_idx, uint32_t sib_ntx, rbg_interval rbgs);
@@ -218,6 +221,8 @@ public:
   bool                       is_ul_alloc(uint16_t rnti) const;
   uint32_t                   get_enb_cc_idx() const { return cc_cfg->enb_cc_idx; }
   const sched_cell_params_t* get_cc_cfg() const { return cc_cfg; }
+  ue_subset_t                get_ue_subset() const { return ue_subset; }
+  bool                       is_in_ue_subset(const sched_ue& user) const;
 
 private:
   void set_dl_data_sched_result(const sf_cch_allocator::alloc_result_t& dci_result,
@@ -243,7 +248,8 @@ private:
   uint32_t                                                           last_msg3_prb = 0, max_msg3_prb = 0;
 
   // Next TTI state
-  tti_point tti_rx;
+  tti_point   tti_rx;
+  ue_subset_t ue_subset = ue_subset_t::all;
 };
 
 } // namespace srsenb
@@ -80,6 +80,19 @@ public:
     int         init_dl_cqi               = 5;
     float       max_sib_coderate          = 0.8;
     int         pdcch_cqi_offset          = 0;
+    uint32_t    nof_cc_threads            = 0; ///< Extra threads to schedule the carriers in parallel (0 = serial)
+    std::string trace_filename;                ///< If not empty, file where the scheduler inputs are recorded
+    uint32_t    lookahead_ttis            = 0; ///< TTIs the decisions are precomputed ahead of the PHY (0 = disabled)
+  };
+
+  /// Subset of sched_args_t that can be changed while the scheduler is running
+  struct sched_tunables_t {
+    std::string sched_policy         = "time_pf";
+    std::string sched_policy_args    = "2";
+    int         pdsch_max_mcs        = 28;
+    int         pusch_max_mcs        = 28;
+    uint32_t    min_nof_ctrl_symbols = 1;
+    uint32_t    max_nof_ctrl_symbols = 3;
   };
 
   struct cell_cfg_t {
@@ -263,6 +276,18 @@ public:
     srsran::bounded_vector<ul_sched_phich_t, MAX_PHICH_LIST> phich;
   };
 
+  /// One UL feedback report of a UE decoded by the PHY. All the reports of a TTI are delivered in a single batch
+  struct ul_feedback_t {
+    enum type_t { sr, dl_ack, ul_crc, dl_ri, dl_pmi, dl_cqi, dl_sb_cqi, ul_snr, ta } type;
+    uint16_t rnti;
+    uint32_t enb_cc_idx;
+    uint32_t param; ///< TB index (dl_ack), subband index (dl_sb_cqi), TB size in bytes (ul_crc) or channel (ul_snr)
+    uint32_t value; ///< 1 for ACK or CRC OK (dl_ack, ul_crc), or the reported RI, PMI or CQI
+    float    meas;  ///< SNR in dB (ul_snr) or time alignment in us (ta)
+    int      ret;   ///< Result of processing the report. Set to the TB size by the scheduler for dl_ack
+  };
+  using ul_feedback_list_t = std::vector<ul_feedback_t>;
+
   /******************* Scheduler Control ****************************/
 
   /* Provides cell configuration including SIB periodicity, etc. */
@@ -319,6 +344,15 @@ public:
   virtual int ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb)                                           = 0;
   virtual int ul_snr_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code) = 0;
 
+  /**
+   * Process all the UL feedback reports decoded in a TTI, in order, with a single access to the UE database
+   *
+   * @param tti TTI of the reports
+   * @param feedback list of reports, whose ret field is written by the scheduler
+   * @return error code
+   */
+  virtual int ul_feedback_info(uint32_t tti, ul_feedback_list_t& feedback) = 0;
+
   /* Run Scheduler for this tti */
   virtual int dl_sched(uint32_t tti, uint32_t enb_cc_idx, dl_sched_res_t& sched_result) = 0;
   virtual int ul_sched(uint32_t tti, uint32_t enb_cc_idx, ul_sched_res_t& sched_result) = 0;
@@ -34,6 +34,10 @@ class sf_cch_allocator
 {
 public:
   const static uint32_t MAX_CFI = 3;
+  /// Maximum number of DFS node visits spent in backtracking per DCI allocation attempt
+  const static uint32_t MAX_DFS_NODE_VISITS = 256;
+  /// Number of previously found DCI position combinations kept for reuse in later TTIs
+  const static uint32_t DFS_MEMO_SIZE = 8;
   struct tree_node {
     int8_t                pucch_n_prb = -1; ///< this PUCCH resource identifier
     uint16_t              rnti        = SRSRAN_INVALID_RNTI;
@@ -44,7 +48,10 @@ public:
     pdcch_mask_t total_mask, current_mask;
     prbmask_t    total_pucch_mask;
   };
-  using alloc_result_t = srsran::bounded_vector<const tree_node*, 16>;
+  /// Maximum number of DCIs in a subframe, given by the maximum number of allocations of each type
+  const static uint32_t MAX_DCIS = 2 * sched_interface::MAX_DATA_LIST + sched_interface::MAX_RAR_LIST +
+                                   sched_interface::MAX_BC_LIST + sched_interface::MAX_PO_LIST;
+  using alloc_result_t = srsran::bounded_vector<const tree_node*, MAX_DCIS>;
 
   sf_cch_allocator() : logger(srslog::fetch_basic_logger("MAC")) {}
 
@@ -77,11 +84,25 @@ private:
     alloc_type_t alloc_type;
     sched_ue*    user;
   };
+  /// Combination of CFI and DCI positions that was found for a given sequence of DCI records
+  struct dfs_memo_entry {
+    uint32_t                             cfix = 0;
+    srsran::bounded_vector<uint32_t, 16> record_keys;
+    srsran::bounded_vector<uint32_t, 16> dci_pos_idxs;
+  };
   const cce_cfi_position_table* get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uint32_t cfix) const;
 
   // PDCCH allocation algorithm
   bool alloc_dfs_node(const alloc_record& record, uint32_t start_child_idx);
   bool get_next_dfs();
+  bool alloc_greedy(const alloc_record& record, uint32_t start_cfix);
+
+  // Reuse of DFS solutions across TTIs
+  static uint32_t record_key(const alloc_record& record);
+  dfs_memo_entry& get_memo_entry(const alloc_record& record);
+  bool            alloc_from_memo(const alloc_record& record);
+  void            save_memo(const alloc_record& record);
+  bool            alloc_record_list(const alloc_record& record, const uint32_t* start_dci_idxs);
 
   // consts
   const sched_cell_params_t* cc_cfg = nullptr;
@@ -94,6 +115,10 @@ private:
   uint32_t                  current_max_cfix = 0;
   std::vector<tree_node>    last_dci_dfs, temp_dci_dfs;
   std::vector<alloc_record> dci_record_list; ///< Keeps a record of all the PDCCH allocations done so far
+  uint32_t                  nof_dfs_visits = 0;
+
+  // Since each sf_sched has its own PDCCH allocator, the memo entries are reused for the same sf_idx
+  std::array<dfs_memo_entry, DFS_MEMO_SIZE> dfs_memo;
 };
 
 // Helper methods
@@ -0,0 +1,151 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_TRACE_H
+#define SRSRAN_SCHED_TRACE_H
+
+#include "sched_interface.h"
+#include "srsran/common/tti_point.h"
+#include <cstdio>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace srsenb {
+
+class sched;
+
+/// Calls to the scheduler that are stored in a scheduler trace
+enum class sched_trace_event_t : uint8_t {
+  sched_args,
+  cell_cfg,
+  reset,
+  ue_cfg,
+  ue_rem,
+  phy_cfg,
+  bearer_cfg,
+  bearer_rem,
+  dl_rlc_buffer,
+  dl_mac_buffer,
+  dl_ack,
+  dl_rach,
+  dl_ri,
+  dl_pmi,
+  dl_cqi,
+  dl_sb_cqi,
+  ul_crc,
+  ul_sr,
+  ul_bsr,
+  ul_phr,
+  ul_snr,
+  ul_buffer_add,
+  pdcch_order,
+  dl_tti_mask,
+  dl_sched,
+  ul_sched,
+  nof_events
+};
+const char* to_string(sched_trace_event_t ev);
+
+/**
+ * Records the inputs of the scheduler to a binary file, so that they can be replayed by sched_trace_reader.
+ * Each event is stored as a 1 byte type, a 2 byte payload length and the payload. The structs are stored in the
+ * host representation, so a trace can only be replayed by a build of the same version and architecture.
+ * Writes are buffered and flushed to the file once the buffer is full.
+ */
+class sched_trace_writer
+{
+public:
+  sched_trace_writer() = default;
+  ~sched_trace_writer();
+  sched_trace_writer(const sched_trace_writer&) = delete;
+  sched_trace_writer& operator=(const sched_trace_writer&) = delete;
+
+  bool open(const std::string& filename);
+  void close();
+
+  void write_sched_args(const sched_interface::sched_args_t& args);
+  void write_cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg);
+  void write_ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg);
+  void write_dl_tti_mask(const uint8_t* tti_mask, uint32_t nof_sfs);
+
+  /// Records an event whose arguments are all trivially copyable
+  template <typename... Args>
+  void write_event(sched_trace_event_t ev, const Args&... args)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t                      start   = begin_event(ev);
+    int                         dummy[] = {0, (pack(args), 0)...};
+    (void)dummy;
+    end_event(start);
+  }
+
+private:
+  template <typename T>
+  void pack(const T& v)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be packed");
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(&v);
+    buffer.insert(buffer.end(), ptr, ptr + sizeof(T));
+  }
+  void   pack(const std::string& s);
+  size_t begin_event(sched_trace_event_t ev);
+  void   end_event(size_t start);
+  void   flush();
+
+  std::mutex           mutex;
+  FILE*                fp = nullptr;
+  std::vector<uint8_t> buffer;
+};
+
+/// Loads a trace generated by sched_trace_writer and replays its events, in order, into a scheduler
+class sched_trace_reader
+{
+public:
+  /// Loads the trace file and reads the scheduler arguments it was recorded with
+  bool open(const std::string& filename, sched_interface::sched_args_t& args);
+  void rewind();
+
+  /**
+   * Applies the next event of the trace to the scheduler
+   * @param sched_obj scheduler, initiated with the arguments returned by open()
+   * @param ev type of the event applied
+   * @param tti_rx for dl_sched and ul_sched events, the TTI whose decision was requested
+   * @return false if the end of the trace was reached or the trace is corrupted
+   */
+  bool replay_next(sched& sched_obj, sched_trace_event_t& ev, srsran::tti_point& tti_rx);
+
+  size_t                                 nof_events() const { return event_offsets.size(); }
+  const sched_interface::dl_sched_res_t& last_dl_result() const { return dl_result; }
+  const sched_interface::ul_sched_res_t& last_ul_result() const { return ul_result; }
+
+private:
+  std::vector<uint8_t> data;
+  std::vector<size_t>  event_offsets;
+  size_t               next_event = 0;
+
+  sched_interface::dl_sched_res_t dl_result;
+  sched_interface::ul_sched_res_t ul_result;
+};
+
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_TRACE_H
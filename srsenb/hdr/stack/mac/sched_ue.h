@@ -56,6 +56,7 @@ public:
 
   void phy_config_enabled(tti_point tti_rx, bool enabled);
   void set_cfg(const ue_cfg_t& cfg);
+  void update_max_mcs();
 
   void set_bearer_cfg(uint32_t lc_id, const mac_lc_ch_cfg_t& cfg);
   void rem_bearer(uint32_t lc_id);
@@ -97,6 +98,7 @@ public:
   srsran::interval<uint32_t> get_requested_dl_bytes(uint32_t enb_cc_idx);
   rbg_interval               get_required_dl_rbgs(uint32_t enb_cc_idx);
   uint32_t                   get_pending_dl_rlc_data() const;
+  bool                       has_pending_dl_txs() const { return lch_handler.has_pending_dl_txs(); }
   uint32_t                   get_expected_dl_bitrate(uint32_t enb_cc_idx, int nof_rbgs = -1) const;
 
   uint32_t get_pending_ul_data_total(tti_point tti_tx_ul, int this_enb_cc_idx);
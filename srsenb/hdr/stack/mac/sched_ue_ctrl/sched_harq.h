@@ -91,10 +91,13 @@ public:
   int       get_tbs(uint32_t tb_idx) const;
   uint32_t  get_n_cce() const;
   void      reset_pending_data();
+  /// Extra TTIs to wait for the HARQ-ACK before considering a retx, for decisions computed ahead of the PHY
+  void set_ack_delay(uint32_t nof_ttis) { ack_delay = nof_ttis; }
 
 private:
   rbgmask_t rbgmask;
   uint32_t  n_cce;
+  uint32_t  ack_delay = 0;
 };
 
 class ul_harq_proc : public harq_proc
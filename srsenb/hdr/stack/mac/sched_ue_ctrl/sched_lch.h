@@ -24,6 +24,7 @@
 
 #include "srsenb/hdr/stack/mac/common/base_ue_buffer_manager.h"
 #include "srsenb/hdr/stack/mac/sched_interface.h"
+#include "srsran/adt/bounded_bitset.h"
 #include "srsran/adt/pool/cached_alloc.h"
 #include "srsran/mac/pdu.h"
 #include "srsran/srslog/srslog.h"
@@ -35,12 +36,15 @@ class lch_ue_manager : private base_ue_buffer_manager<false>
   using base_type = base_ue_buffer_manager<false>;
 
 public:
-  explicit lch_ue_manager(uint16_t rnti) : base_ue_buffer_manager(rnti, srslog::fetch_basic_logger("MAC")) {}
+  explicit lch_ue_manager(uint16_t rnti) : base_ue_buffer_manager(rnti, srslog::fetch_basic_logger("MAC"))
+  {
+    update_prio_order();
+  }
   void set_cfg(const sched_interface::ue_cfg_t& cfg_);
+  void config_lcid(uint32_t lcid, const mac_lc_ch_cfg_t& bearer_cfg);
   void new_tti();
 
   // Inherited methods from ue_buffer_manager base class
-  using base_type::config_lcid;
   using base_type::get_bsr;
   using base_type::get_bsr_state;
   using base_type::get_dl_prio_tx;
@@ -58,6 +62,7 @@ public:
   int alloc_rlc_pdu(sched_interface::dl_sched_pdu_t* lcid, int rem_bytes);
 
   bool has_pending_dl_txs() const;
+  int  get_dl_tx_total() const;
   int  get_dl_tx_total_with_overhead(uint32_t lcid) const;
   int  get_dl_tx_with_overhead(uint32_t lcid) const;
   int  get_dl_prio_tx_with_overhead(uint32_t lcid) const;
@@ -70,10 +75,21 @@ public:
   srsran::deque<ce_cmd> pending_ces;
 
 private:
-  int alloc_prio_tx_bytes(uint8_t lcid, int rem_bytes);
-  int alloc_tx_bytes(uint8_t lcid, int rem_bytes);
+  using lcid_mask_t = srsran::bounded_bitset<MAX_NOF_LCIDS>;
+
+  int  alloc_prio_tx_bytes(uint8_t lcid, int rem_bytes);
+  int  alloc_tx_bytes(uint8_t lcid, int rem_bytes);
+  void update_prio_order();
+  void update_lcid_state(uint32_t lcid);
 
   size_t prio_idx = 0;
+
+  // State updated on every buffer, bucket or bearer change, so that the allocation only visits the LCIDs with data,
+  // in priority order, and the bucket refill only the LCIDs whose bucket is not full
+  std::array<uint8_t, MAX_NOF_LCIDS> lcids_by_prio = {};           ///< LCIDs sorted by priority, then by LCID
+  std::array<uint8_t, MAX_NOF_LCIDS> prio_rank     = {};           ///< Position of each LCID in lcids_by_prio
+  lcid_mask_t                        pending_ranks{MAX_NOF_LCIDS}; ///< Ranks of the LCIDs with pending DL data
+  lcid_mask_t                        refill_lcids{MAX_NOF_LCIDS};  ///< LCIDs with finite PBR and a non full bucket
 };
 
 /**
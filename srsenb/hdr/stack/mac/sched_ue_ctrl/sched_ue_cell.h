@@ -38,6 +38,8 @@ struct sched_ue_cell {
 
   sched_ue_cell(uint16_t rnti_, const sched_cell_params_t& cell_cfg_, tti_point current_tti);
   void set_ue_cfg(const sched_interface::ue_cfg_t& ue_cfg_);
+  /// Recomputes the MCS limits from the scheduler args and the UE capabilities
+  void update_max_mcs();
   void new_tti(tti_point tti_rx);
   void clear_feedback();
   void finish_tti(tti_point tti_rx);
@@ -25,14 +25,13 @@
 #include "sched_base.h"
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsran/adt/circular_map.h"
-#include <queue>
+#include <array>
+#include <vector>
 
 namespace srsenb {
 
 class sched_time_pf final : public sched_base
 {
-  using ue_cit_t = sched_ue_list::const_iterator;
-
 public:
   sched_time_pf(const sched_cell_params_t& cell_params_, const sched_interface::sched_args_t& sched_args);
   void sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched) override;
@@ -44,52 +43,73 @@ private:
   const sched_cell_params_t* cc_cfg         = nullptr;
   float                      fairness_coeff = 1;
 
-  srsran::tti_point current_tti_rx;
-
-  struct ue_ctxt {
-    ue_ctxt(uint16_t rnti_, float fairness_coeff_) : rnti(rnti_), fairness_coeff(fairness_coeff_) {}
-    float    dl_avg_rate() const { return dl_nof_samples == 0 ? 0 : dl_avg_rate_; }
-    float    ul_avg_rate() const { return ul_nof_samples == 0 ? 0 : ul_avg_rate_; }
-    uint32_t dl_count() const { return dl_nof_samples; }
-    uint32_t ul_count() const { return ul_nof_samples; }
-    void     new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched);
-    void     save_dl_alloc(uint32_t alloc_bytes, float alpha);
-    void     save_ul_alloc(uint32_t alloc_bytes, float alpha);
-
-    const uint16_t rnti;
-    const float    fairness_coeff;
-
-    int                 ue_cc_idx  = 0;
-    float               dl_prio    = 0;
-    float               ul_prio    = 0;
-    const dl_harq_proc* dl_retx_h  = nullptr;
-    const dl_harq_proc* dl_newtx_h = nullptr;
-    const ul_harq_proc* ul_h       = nullptr;
-
-  private:
-    float    dl_avg_rate_   = 0;
-    float    ul_avg_rate_   = 0;
-    uint32_t dl_nof_samples = 0;
-    uint32_t ul_nof_samples = 0;
+  srsran::tti_point     current_tti_rx;
+  sf_sched::ue_subset_t current_ue_subset = sf_sched::ue_subset_t::all;
+
+  //! Coefficient of the exponential average of the allocated rates
+  static constexpr float rate_avg_alpha = 0.01;
+
+  template <typename T>
+  using ue_array = std::array<T, SRSENB_MAX_UES>;
+
+  /**
+   * State of the UEs, with one array per field, indexed by a dense UE index. The per-TTI passes and the priority
+   * queues only touch the few fields they need, stored contiguously for all UEs. When a UE is removed, the last UE
+   * takes its index, so that the UEs always occupy the indexes [0, nof_ues)
+   */
+  struct ue_state_list {
+    uint32_t           nof_ues = 0;
+    ue_array<uint16_t> rnti;
+
+    // Updated every TTI
+    ue_array<float>               dl_prio;
+    ue_array<float>               ul_prio;
+    ue_array<bool>                dl_retx;
+    ue_array<bool>                ul_retx;
+    ue_array<const dl_harq_proc*> dl_retx_h;
+    ue_array<const dl_harq_proc*> dl_newtx_h;
+    ue_array<const ul_harq_proc*> ul_h;
+
+    // Averages of the allocated rates, in bytes per TTI
+    ue_array<float>    dl_avg_rate;
+    ue_array<float>    ul_avg_rate;
+    ue_array<uint32_t> dl_nof_samples;
+    ue_array<uint32_t> ul_nof_samples;
+
+    // TTIs in which the UE had nothing to transmit. They count as zero rate samples, and are only added to the
+    // averages once the UE becomes active, so that idle UEs skip the priority computation and the queues
+    ue_array<uint32_t> dl_idle_samples;
+    ue_array<uint32_t> ul_idle_samples;
+
+    uint32_t add(uint16_t rnti_);
+    void     move(uint32_t from, uint32_t to);
   };
 
-  rnti_map_t<ue_ctxt> ue_history_db;
+  ue_state_list        ues;
+  rnti_map_t<uint32_t> ue_index_db;
+
+  void        rem_ue(uint32_t ue_idx);
+  void        new_ue_tti(uint32_t ue_idx, sched_ue& ue, sf_sched* tti_sched);
+  float       dl_avg_rate(uint32_t ue_idx) const;
+  float       ul_avg_rate(uint32_t ue_idx) const;
+  static void add_zero_samples(float& avg_rate, uint32_t& nof_samples, uint32_t nof_zeros, float alpha);
+  static void save_alloc(float& avg_rate, uint32_t& nof_samples, uint32_t alloc_bytes, float alpha);
 
   struct ue_dl_prio_compare {
-    bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
+    const ue_state_list* ues;
+    bool                 operator()(uint32_t lhs, uint32_t rhs) const;
   };
   struct ue_ul_prio_compare {
-    bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
+    const ue_state_list* ues;
+    bool                 operator()(uint32_t lhs, uint32_t rhs) const;
   };
 
-  using ue_dl_queue_t = std::priority_queue<ue_ctxt*, std::vector<ue_ctxt*>, ue_dl_prio_compare>;
-  using ue_ul_queue_t = std::priority_queue<ue_ctxt*, std::vector<ue_ctxt*>, ue_ul_prio_compare>;
-
-  ue_dl_queue_t dl_queue;
-  ue_ul_queue_t ul_queue;
+  // Max-heaps of the indexes of the active UEs, built once per TTI
+  std::vector<uint32_t> dl_queue;
+  std::vector<uint32_t> ul_queue;
 
-  uint32_t try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
-  uint32_t try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
+  uint32_t try_dl_alloc(uint32_t ue_idx, sched_ue& ue, sf_sched* tti_sched);
+  uint32_t try_ul_alloc(uint32_t ue_idx, sched_ue& ue, sf_sched* tti_sched);
 };
 
 } // namespace srsenb
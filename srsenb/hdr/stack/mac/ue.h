@@ -27,7 +27,7 @@
 #include "srsran/adt/circular_array.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/pool/pool_interface.h"
-#include "srsran/common/block_queue.h"
+#include "srsran/adt/mpmc_queue.h"
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/mac_pcap_net.h"
 #include "srsran/common/tti_point.h"
@@ -57,7 +57,10 @@ struct ue_cc_softbuffers {
   cc_softbuffer_tx_list_t softbuffer_tx_list;
   cc_softbuffer_rx_list_t softbuffer_rx_list;
 
-  ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_);
+  ue_cc_softbuffers(uint32_t                           nof_prb,
+                    uint32_t                           nof_tx_harq_proc_,
+                    uint32_t                           nof_rx_harq_proc_,
+                    const srsran_softbuffer_rx_args_t& rx_args = {});
   ue_cc_softbuffers(ue_cc_softbuffers&&) noexcept = default;
   ~ue_cc_softbuffers();
   void clear();
@@ -216,8 +219,8 @@ private:
 
   srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool = nullptr;
 
-  srsran::block_queue<uint32_t> pending_ta_commands;
-  ta                            ta_fsm;
+  srsran::mpmc_queue<uint32_t> pending_ta_commands{16};
+  ta                           ta_fsm;
 
   // For UL there are multiple buffers per PID and are managed by pdu_queue
   srsran::sch_pdu mac_msg_dl, mac_msg_ul;
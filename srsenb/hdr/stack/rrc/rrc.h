@@ -25,9 +25,11 @@
 #include "rrc_bearer_cfg.h"
 #include "rrc_cell_cfg.h"
 #include "rrc_metrics.h"
+#include "ue_rr_cfg.h"
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/mpmc_queue.h"
 #include "srsran/common/bearer_manager.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
@@ -42,6 +44,10 @@
 #include "srsran/srslog/srslog.h"
 #include <map>
 
+namespace srsran {
+class task_thread_pool;
+}
+
 namespace srsenb {
 
 class s1ap_interface_rrc;
@@ -70,14 +76,15 @@ public:
                s1ap_interface_rrc*    s1ap,
                gtpu_interface_rrc*    gtpu);
 
-  int32_t init(const rrc_cfg_t&       cfg_,
-               phy_interface_rrc_lte* phy,
-               mac_interface_rrc*     mac,
-               rlc_interface_rrc*     rlc,
-               pdcp_interface_rrc*    pdcp,
-               s1ap_interface_rrc*    s1ap,
-               gtpu_interface_rrc*    gtpu,
-               rrc_nr_interface_rrc*  rrc_nr);
+  int32_t init(const rrc_cfg_t&          cfg_,
+               phy_interface_rrc_lte*    phy,
+               mac_interface_rrc*        mac,
+               rlc_interface_rrc*        rlc,
+               pdcp_interface_rrc*       pdcp,
+               s1ap_interface_rrc*       s1ap,
+               gtpu_interface_rrc*       gtpu,
+               rrc_nr_interface_rrc*     rrc_nr,
+               srsran::task_thread_pool* ue_task_pool_ = nullptr);
 
   void stop();
   void get_metrics(rrc_metrics_t& m);
@@ -189,6 +196,7 @@ private:
   std::unique_ptr<freq_res_common_list>    cell_res_list;
   std::map<uint16_t, unique_rnti_ptr<ue> > users; // NOTE: has to have fixed addr
   std::unique_ptr<paging_manager>          pending_paging;
+  rrc_conn_setup_template                  conn_setup_template;
 
   void     process_release_complete(uint16_t rnti);
   void     rem_user(uint16_t rnti);
@@ -199,6 +207,13 @@ private:
   void config_mac();
   void parse_ul_dcch(ue& ue, uint32_t lcid, srsran::unique_byte_buffer_t pdu);
   void parse_ul_ccch(ue& ue, srsran::unique_byte_buffer_t pdu);
+  void handle_ul_ccch(ue& ue, asn1::rrc::ul_ccch_msg_s& ul_ccch_msg, srsran::unique_byte_buffer_t pdu);
+  bool decode_ul_ccch(uint16_t rnti, const srsran::byte_buffer_t& pdu, asn1::rrc::ul_ccch_msg_s& ul_ccch_msg);
+  bool decode_ul_dcch(uint16_t                     rnti,
+                      uint32_t                     lcid,
+                      const srsran::byte_buffer_t& pdu,
+                      asn1::rrc::ul_dcch_msg_s&    ul_dcch_msg,
+                      asn1::decode_arena&          arena);
   void send_rrc_connection_reject(uint16_t rnti);
 
   const static int mcch_payload_len                      = 3000;
@@ -210,6 +225,21 @@ private:
     uint32_t                     arg;
     srsran::unique_byte_buffer_t pdu;
   };
+  /// UL-CCCH/UL-DCCH message popped from the rx_pdu_queue, decoded by the UE task pool
+  struct ul_rx_msg_t {
+    bool                            decoded = false;
+    asn1::static_decode_arena<2048> arena; ///< Dynamic fields of the decoded message, must outlive it
+    asn1::rrc::ul_ccch_msg_s        ul_ccch_msg;
+    asn1::rrc::ul_dcch_msg_s        ul_dcch_msg;
+  };
+  struct rx_item_t {
+    rrc_pdu                      p;
+    std::unique_ptr<ul_rx_msg_t> msg; ///< Set for the UL messages of known UEs
+  };
+  void handle_rrc_pdu(rrc_pdu& p, ul_rx_msg_t* msg);
+  void decode_rx_batch();
+  void decode_rx_shard(uint32_t shard_idx);
+
   void log_rx_pdu_fail(uint16_t rnti, uint32_t lcid, srsran::const_byte_span pdu, const char* cause);
   void
   log_rxtx_pdu_impl(direction_t dir, uint16_t rnti, uint32_t lcid, srsran::const_byte_span pdu, const char* msg_type);
@@ -224,7 +254,13 @@ private:
   const static uint32_t LCID_PROT_FAIL  = 0xffff0008;
 
   bool                                running = false;
-  srsran::dyn_blocking_queue<rrc_pdu> rx_pdu_queue;
+  srsran::mpmc_queue<rrc_pdu> rx_pdu_queue;
+
+  // The UL messages popped in a tti_clock are decoded in parallel across UEs, in order for each UE, and are then
+  // handled in order in the stack thread. nullptr decodes and handles each message in turn in the stack thread
+  srsran::task_thread_pool* ue_task_pool = nullptr;
+  std::vector<rx_item_t>    rx_batch;
+  uint32_t                  nof_rx_shards = 0;
 
   asn1::rrc::mcch_msg_s  mcch;
   bool                   enable_mbms     = false;
@@ -50,6 +50,9 @@ public:
         pcch.pcch_msg.msg.set_c1().paging().paging_record_list_present = true;
       }
     }
+    for (uint32_t ueid = 0; ueid < nof_ue_id_idx; ++ueid) {
+      paging_occasions[ueid] = compute_paging_occasion(ueid);
+    }
   }
 
   /// add new IMSI paging record
@@ -78,6 +81,7 @@ private:
     tti_point                    tti_tx_dl;
     asn1::rrc::pcch_msg_s        pcch_msg;
     srsran::unique_byte_buffer_t pdu;
+    uint32_t                     nof_bits = 0; ///< length of the encoded PCCH message, without the padding
 
     bool is_tx() const { return tti_tx_dl.is_valid(); }
     bool empty() const { return pdu == nullptr; }
@@ -86,11 +90,24 @@ private:
       tti_tx_dl = tti_point();
       pcch_msg.msg.c1().paging().paging_record_list.clear();
       pdu.reset();
+      nof_bits = 0;
     }
   };
   const static size_t nof_paging_subframes = 4;
+  /// Bit position of the number of paging records (minus one, 4 bits) in the encoded PCCH message, which follows the
+  /// PCCH-MessageType and c1 CHOICEs and the presence flags of Paging
+  const static uint32_t paging_record_count_bit_pos = 5;
+
+  /// Paging Frame and Paging Occasion of a UE identity index, which only depend on the paging configuration
+  struct paging_occasion_t {
+    int16_t  sf_key        = -1; ///< index of the PO subframe in sf_pending_pcch, or -1 if the PO is N/A
+    uint16_t sfn_cycle_idx = 0;  ///< index of the PF in the paging cycle
+  };
+  /// Number of UE identity index values (UE_ID = IMSI mod 1024)
+  const static uint32_t nof_ue_id_idx = 1024;
 
-  bool add_paging_record(uint32_t ueid, const asn1::rrc::paging_record_s& paging_record);
+  bool              add_paging_record(uint32_t ueid, const asn1::rrc::paging_record_s& paging_record);
+  paging_occasion_t compute_paging_occasion(uint32_t ueid) const;
 
   static int get_sf_idx_key(uint32_t sf_idx)
   {
@@ -116,6 +133,8 @@ private:
   uint32_t              Ns;
   srslog::basic_logger& logger;
 
+  std::array<paging_occasion_t, nof_ue_id_idx> paging_occasions;
+
   struct subframe_info {
     mutable std::mutex        mutex;
     srsran::deque<pcch_info*> transmitted_pcch;
@@ -148,26 +167,34 @@ bool paging_manager::add_tmsi_paging(uint32_t ueid, uint8_t mmec, srsran::const_
 }
 
 /// \remark See TS 36.304, Section 7
-bool paging_manager::add_paging_record(uint32_t ueid, const asn1::rrc::paging_record_s& paging_record)
+paging_manager::paging_occasion_t paging_manager::compute_paging_occasion(uint32_t ueid) const
 {
   constexpr static const int sf_pattern[4][4] = {{9, 4, -1, 0}, {-1, 9, -1, 4}, {-1, -1, -1, 5}, {-1, -1, -1, 9}};
 
-  ueid         = ((uint32_t)ueid) % 1024;
-  uint32_t i_s = (ueid / N) % Ns;
+  paging_occasion_t po;
+  uint32_t          i_s    = (ueid / N) % Ns;
+  int               sf_idx = sf_pattern[i_s % 4][(Ns - 1) % 4];
+  if (sf_idx >= 0) {
+    po.sf_key        = static_cast<int16_t>(get_sf_idx_key(sf_idx));
+    po.sfn_cycle_idx = static_cast<uint16_t>((T / N) * (ueid % N));
+  }
+  return po;
+}
 
-  int sf_idx = sf_pattern[i_s % 4][(Ns - 1) % 4];
-  if (sf_idx < 0) {
-    logger.error("SF pattern is N/A for Ns=%d, i_s=%d, imsi_decimal=%d", Ns, i_s, ueid);
+bool paging_manager::add_paging_record(uint32_t ueid, const asn1::rrc::paging_record_s& paging_record)
+{
+  ueid                        = ((uint32_t)ueid) % nof_ue_id_idx;
+  const paging_occasion_t& po = paging_occasions[ueid];
+  if (po.sf_key < 0) {
+    logger.error("SF pattern is N/A for Ns=%d, i_s=%d, imsi_decimal=%d", Ns, (ueid / N) % Ns, ueid);
     return false;
   }
-  size_t sf_key = static_cast<size_t>(get_sf_idx_key(sf_idx));
 
-  subframe_info&              locked_sf = sf_pending_pcch[sf_key];
+  subframe_info&              locked_sf = sf_pending_pcch[static_cast<size_t>(po.sf_key)];
   std::lock_guard<std::mutex> lock(locked_sf.mutex);
 
-  size_t     sfn_cycle_idx = ((size_t)T / (size_t)N) * (size_t)(ueid % N);
-  pcch_info& pending_pcch  = locked_sf.pending_paging[sfn_cycle_idx];
-  auto&      record_list   = pending_pcch.pcch_msg.msg.c1().paging().paging_record_list;
+  pcch_info& pending_pcch = locked_sf.pending_paging[po.sfn_cycle_idx];
+  auto&      record_list  = pending_pcch.pcch_msg.msg.c1().paging().paging_record_list;
 
   if (record_list.size() >= ASN1_RRC_MAX_PAGE_REC) {
     logger.warning("Failed to add new paging record for ueid=%d. Cause: no paging record space left.", ueid);
@@ -188,12 +215,31 @@ bool paging_manager::add_paging_record(uint32_t ueid, const asn1::rrc::paging_re
 
   record_list.push_back(paging_record);
 
-  asn1::bit_ref bref(pending_pcch.pdu->msg, pending_pcch.pdu->get_tailroom());
-  if (pending_pcch.pcch_msg.pack(bref) == asn1::SRSASN_ERROR_ENCODE_FAIL) {
+  // The PCCH message is packed with its first paging record. The next records are appended to the encoded message,
+  // whose number of records is patched, so that paging storms do not pack the whole message for every record
+  asn1::bit_ref     bref(pending_pcch.pdu->msg, pending_pcch.pdu->N_bytes + pending_pcch.pdu->get_tailroom());
+  asn1::SRSASN_CODE ret;
+  if (record_list.size() == 1) {
+    ret = pending_pcch.pcch_msg.msg.pack(bref);
+  } else {
+    ret = bref.advance_bits(pending_pcch.nof_bits);
+    if (ret == asn1::SRSASN_SUCCESS) {
+      ret = paging_record.pack(bref);
+    }
+    uint32_t count = record_list.size() - 1;
+    for (uint32_t i = 0, pos = paging_record_count_bit_pos; i < 4; ++i, ++pos) {
+      uint8_t& octet = pending_pcch.pdu->msg[pos / 8];
+      uint8_t  mask  = 0x80u >> (pos % 8);
+      octet          = ((count >> (3 - i)) & 1u) ? (octet | mask) : (octet & ~mask);
+    }
+  }
+  if (ret != asn1::SRSASN_SUCCESS) {
     logger.error("Failed to pack PCCH message");
     pending_pcch.clear();
     return false;
   }
+  pending_pcch.nof_bits = (uint32_t)bref.distance();
+  bref.align_bytes_zero();
   pending_pcch.pdu->N_bytes = (uint32_t)bref.distance_bytes();
 
   return true;
@@ -95,6 +95,7 @@ public:
   void send_ue_info_req();
 
   void parse_ul_dcch(uint32_t lcid, srsran::unique_byte_buffer_t pdu);
+  void handle_ul_dcch(uint32_t lcid, asn1::rrc::ul_dcch_msg_s& ul_dcch_msg, srsran::unique_byte_buffer_t pdu);
 
   /// List of generated RRC events.
   enum class rrc_event_type {
@@ -152,7 +153,9 @@ public:
    * Sends the CCCH message to the underlying layer and optionally encodes it as an octet string if a valid string
    * pointer is passed.
    */
-  void send_dl_ccch(asn1::rrc::dl_ccch_msg_s* dl_ccch_msg, std::string* octet_str = nullptr);
+  void send_dl_ccch(asn1::rrc::dl_ccch_msg_s*    dl_ccch_msg,
+                    std::string*                 octet_str = nullptr,
+                    srsran::unique_byte_buffer_t pdu       = nullptr);
 
   /**
    * Sends the DCCH message to the underlying layer and optionally encodes it as an octet string if a valid string
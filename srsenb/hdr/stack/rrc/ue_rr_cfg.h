@@ -44,6 +44,7 @@
 #define SRSENB_UE_RR_CFG_H
 
 #include "srsran/asn1/rrc.h"
+#include "srsran/common/byte_buffer.h"
 #include "srsran/interfaces/rrc_interface_types.h"
 
 namespace srsenb {
@@ -58,6 +59,38 @@ int fill_rr_cfg_ded_setup(asn1::rrc::rr_cfg_ded_s& rr_cfg,
                           const rrc_cfg_t&         enb_cfg,
                           const ue_cell_ded_list&  ue_cell_list);
 
+/**
+ * RRCConnectionSetup packed once and reused for the following UEs. The messages filled with fill_rr_cfg_ded_setup()
+ * for the same eNB configuration only differ in the RRC transaction ID and the SR and periodic CQI resources, which
+ * are patched in the packed template. The positions of these fields are found by packing the first message with
+ * different values for each of them
+ */
+class rrc_conn_setup_template
+{
+public:
+  /// Packs the RRCConnectionSetup msg into pdu. Returns false if msg cannot be packed from the template
+  bool pack(const asn1::rrc::dl_ccch_msg_s& msg, srsran::byte_buffer_t& pdu);
+
+private:
+  enum field_id { transaction_id, sr_pucch_res_idx, sr_cfg_idx, cqi_pucch_res_idx, cqi_pmi_cfg_idx, nof_fields };
+  struct field_t {
+    bool     present  = false;
+    uint32_t bit_pos  = 0;
+    uint32_t nof_bits = 0;
+  };
+  enum class state_t { empty, ready, unavailable };
+
+  /// Gets the field f of an RRCConnectionSetup, returns false if it is absent
+  static bool get_field(const asn1::rrc::dl_ccch_msg_s& msg, field_id f, uint32_t& value);
+  /// Sets the field f, which must be present, of an RRCConnectionSetup
+  static void set_field(asn1::rrc::dl_ccch_msg_s& msg, field_id f, uint32_t value);
+  bool        init(const asn1::rrc::dl_ccch_msg_s& msg);
+
+  state_t                         state = state_t::empty;
+  std::vector<uint8_t>            packed_msg;
+  std::array<field_t, nof_fields> fields;
+};
+
 /// Apply Reconf updates and update current state
 int apply_reconf_updates(asn1::rrc::rrc_conn_recfg_r8_ies_s&  recfg_r8,
                          ue_var_cfg_t&                        current_ue_cfg,
@@ -26,6 +26,8 @@
 
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsran/adt/circular_map.h"
+#include "srsran/adt/dense_id_table.h"
+#include "srsran/adt/flat_hash_map.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/s1ap_pcap.h"
@@ -36,6 +38,7 @@
 #include "s1ap_metrics.h"
 #include "srsran/adt/optional.h"
 #include "srsran/asn1/s1ap.h"
+#include "srsran/asn1/s1ap_utils.h"
 #include "srsran/common/network_utils.h"
 #include "srsran/common/stack_procedure.h"
 #include "srsran/common/task_scheduler.h"
@@ -141,7 +144,6 @@ private:
   struct sockaddr_in    mme_addr            = {}; // MME address
   bool                  mme_connected       = false;
   bool                  running             = false;
-  uint32_t              next_enb_ue_s1ap_id = 1; // Next ENB-side UE identifier
   uint16_t              next_ue_stream_id   = 1; // Next UE SCTP stream identifier
   srsran::unique_timer  mme_connect_timer, s1setup_timeout;
 
@@ -164,10 +166,12 @@ private:
   bool handle_successfuloutcome(const asn1::s1ap::successful_outcome_s& msg);
   bool handle_unsuccessfuloutcome(const asn1::s1ap::unsuccessful_outcome_s& msg);
   bool handle_paging(const asn1::s1ap::paging_s& msg);
+  bool handle_paging(const asn1::s1ap::s1ap_pdu_peek_t& msg);
 
   bool handle_s1setupresponse(const asn1::s1ap::s1_setup_resp_s& msg);
 
   bool handle_dlnastransport(const asn1::s1ap::dl_nas_transport_s& msg);
+  bool handle_dlnastransport(const asn1::s1ap::s1ap_pdu_peek_t& msg);
   bool handle_initialctxtsetuprequest(const asn1::s1ap::init_context_setup_request_s& msg);
   bool handle_uectxtreleasecommand(const asn1::s1ap::ue_context_release_cmd_s& msg);
   bool handle_s1setupfailure(const asn1::s1ap::s1_setup_fail_s& msg);
@@ -307,19 +311,25 @@ private:
     srsran::proc_t<ho_prep_proc_t> ho_prep_proc;
   };
 
+  /// UE contexts indexed by ENB_UE_S1AP_ID, which encodes the slot of the context, with O(1) RNTI and MME_UE_S1AP_ID
+  /// lookups. The RNTI and MME_UE_S1AP_ID of a stored context must be changed through set_rnti and set_mme_id.
   class user_list
   {
   public:
     using value_type     = std::unique_ptr<ue>;
-    using iterator       = std::unordered_map<uint32_t, value_type>::iterator;
-    using const_iterator = std::unordered_map<uint32_t, value_type>::const_iterator;
-    using pair_type      = std::unordered_map<uint32_t, value_type>::value_type;
+    using table_type     = srsran::dense_id_table<value_type, 24, 14>;
+    using iterator       = table_type::iterator;
+    using const_iterator = table_type::const_iterator;
+
+    user_list() : rnti_to_enb_id(1u << 16, table_type::invalid_id) {}
 
     ue*            find_ue_rnti(uint16_t rnti);
     ue*            find_ue_enbid(uint32_t enbid);
     ue*            find_ue_mmeid(uint32_t mmeid);
     ue*            add_user(value_type user);
     void           erase(ue* ue_ptr);
+    bool           set_rnti(ue* ue_ptr, uint16_t rnti);
+    bool           set_mme_id(ue* ue_ptr, uint32_t mmeid);
     iterator       begin() { return users.begin(); }
     iterator       end() { return users.end(); }
     const_iterator cbegin() const { return users.begin(); }
@@ -327,7 +337,9 @@ private:
     size_t         size() const { return users.size(); }
 
   private:
-    std::unordered_map<uint32_t, std::unique_ptr<ue> > users; // maps ENB_S1AP_ID to user
+    table_type                                users;          // maps ENB_S1AP_ID to user
+    std::vector<uint32_t>                     rnti_to_enb_id; // maps RNTI to ENB_S1AP_ID
+    srsran::flat_hash_map<uint32_t, uint32_t> mme_to_enb_id;  // maps MME_S1AP_ID to ENB_S1AP_ID
   };
   user_list users;
 
@@ -21,28 +21,27 @@
 
 #include <map>
 #include <string.h>
-#include <unordered_map>
 
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsran/adt/bounded_vector.h"
+#include "srsran/adt/circular_buffer.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/network_utils.h"
 #include "srsran/common/task_scheduler.h"
 #include "srsran/common/threads.h"
+#include "srsran/common/xdp_socket.h"
 #include "srsran/interfaces/enb_gtpu_interfaces.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/srslog/srslog.h"
+#include "srsran/upper/gtpu.h"
 
 #include <netinet/in.h>
+#include <sys/socket.h>
 
 #ifndef SRSENB_GTPU_H
 #define SRSENB_GTPU_H
 
-namespace srsran {
-struct gtpu_header_t;
-}
-
 namespace srsenb {
 
 class pdcp_interface_gtpu;
@@ -51,14 +50,21 @@ class gtpu_tunnel_manager
 {
   // Buffer used to store SDUs while PDCP is still getting configured during handover.
   // Note: The buffer cannot be too large, otherwise it risks depleting the byte buffer pool.
+  // The SDUs are kept sorted by PDCP SN in a ring, so that they can be flushed from the head in batches.
   const static size_t BUFFER_SIZE = 512;
-  using buffered_sdu_list = srsran::bounded_vector<std::pair<uint32_t, srsran::unique_byte_buffer_t>, BUFFER_SIZE>;
+  using buffered_sdu_t            = std::pair<uint32_t, srsran::unique_byte_buffer_t>;
+  using buffered_sdu_list         = srsran::static_circular_buffer<buffered_sdu_t, BUFFER_SIZE>;
+
+  // Maximum number of buffered SDUs written to PDCP per stack tick, once the tunnel is activated
+  const static size_t REPLAY_BATCH_SIZE = 64;
 
   static const uint32_t undefined_pdcp_sn = std::numeric_limits<uint32_t>::max();
 
 public:
   // A UE should have <= 3 DRBs active, and each DRB should have two tunnels active at the same time at most
   const static size_t MAX_TUNNELS_PER_UE = 10;
+  // UDP port of the tunnel endpoints
+  const static int GTPU_PORT = 2152;
 
   enum class tunnel_state { pdcp_active, buffering, forward_to, forwarded_from, inactive };
 
@@ -69,10 +75,15 @@ public:
     uint32_t teid_out      = 0;
     uint32_t spgw_addr     = 0;
 
+    // Precomputed destination and G-PDU header of the Tx PDUs
+    struct sockaddr_in             spgw_sockaddr = {};
+    srsran::gtpu_header_template_t tx_header;
+
     tunnel_state                                    state = tunnel_state::pdcp_active;
     srsran::unique_timer                            rx_timer;
     srsran::byte_buffer_pool_ptr<buffered_sdu_list> buffer;
-    tunnel*                                         fwd_tunnel = nullptr; ///< forward Rx SDUs to this TEID
+    bool                                            replay_pending = false;   ///< buffered SDUs being flushed to PDCP
+    tunnel*                                         fwd_tunnel     = nullptr; ///< forward Rx SDUs to this TEID
     srsran::move_callback<void()>                   on_removal;
 
     tunnel()                             = default;
@@ -129,6 +140,8 @@ private:
   using tunnel_list_t  = srsran::static_id_obj_pool<uint32_t, tunnel, SRSENB_MAX_UES * MAX_TUNNELS_PER_UE>;
   using tunnel_ctxt_it = typename tunnel_list_t::iterator;
 
+  void replay_buffered_sdus(uint32_t teid);
+
   // Used to differentiate whether GTPU is used in NR or LTE context.
   srsran::srsran_rat_t ran_type;
 
@@ -137,8 +150,8 @@ private:
   pdcp_interface_gtpu*      pdcp      = nullptr;
   srslog::basic_logger&     logger;
 
-  std::unordered_map<uint16_t, ue_bearer_tunnel_list> ue_teidin_db;
-  tunnel_list_t                                       tunnels;
+  rnti_map_t<ue_bearer_tunnel_list> ue_teidin_db;
+  tunnel_list_t                     tunnels;
 };
 
 using gtpu_tunnel_state = gtpu_tunnel_manager::tunnel_state;
@@ -176,7 +189,7 @@ public:
   void handle_gtpu_m1u_rx_packet(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr);
 
 private:
-  static const int GTPU_PORT = 2152;
+  static const int GTPU_PORT = gtpu_tunnel_manager::GTPU_PORT;
 
   void rem_tunnel(uint32_t teidin);
 
@@ -228,7 +241,21 @@ private:
   // Socket file descriptor
   int fd = -1;
 
+  // AF_XDP socket receiving the S1-U datagrams of one Rx queue, if enabled
+  std::unique_ptr<srsran::xdp_udp_socket> xdp_socket;
+
+  // G-PDUs sent with a single sendmmsg call at the end of the current stack task, or when the batch is full
+  static const size_t MAX_TX_BATCH_SIZE = 32;
+  struct tx_batch_t {
+    std::array<srsran::unique_byte_buffer_t, MAX_TX_BATCH_SIZE> pdus;
+    std::array<struct sockaddr_in, MAX_TX_BATCH_SIZE>           addrs = {};
+    std::array<struct iovec, MAX_TX_BATCH_SIZE>                 iovs  = {};
+    std::array<struct mmsghdr, MAX_TX_BATCH_SIZE>               msgs  = {};
+    size_t                                                      size  = 0;
+  } tx_batch;
+
   void send_pdu_to_tunnel(const gtpu_tunnel& tx_tun, srsran::unique_byte_buffer_t pdu, int pdcp_sn = -1);
+  void flush_tx_batch();
 
   void echo_response(in_addr_t addr, in_port_t port, uint16_t seq);
   void error_indication(in_addr_t addr, in_port_t port, uint32_t err_teid);
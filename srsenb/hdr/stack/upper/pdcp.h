@@ -43,7 +43,10 @@ class pdcp : public pdcp_interface_rlc, public pdcp_interface_gtpu, public pdcp_
 public:
   pdcp(srsran::task_sched_handle task_sched_, srslog::basic_logger& logger);
   virtual ~pdcp() {}
-  void init(rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interface_pdcp* gtpu_);
+  void init(rlc_interface_pdcp*       rlc_,
+            rrc_interface_pdcp*       rrc_,
+            gtpu_interface_pdcp*      gtpu_,
+            srsran::task_thread_pool* crypto_pool_ = nullptr);
   void stop();
 
   // pdcp_interface_rlc
@@ -132,6 +135,7 @@ private:
   gtpu_interface_pdcp*      gtpu = nullptr;
   srsran::task_sched_handle task_sched;
   srslog::basic_logger&     logger;
+  srsran::task_thread_pool* crypto_pool = nullptr; ///< Ciphers the DRB PDUs, nullptr to cipher in the stack thread
 };
 
 } // namespace srsenb
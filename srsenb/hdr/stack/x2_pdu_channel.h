@@ -0,0 +1,89 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_X2_PDU_CHANNEL_H
+#define SRSENB_X2_PDU_CHANNEL_H
+
+#include "srsran/adt/spsc_queue.h"
+#include "srsran/common/byte_buffer.h"
+#include "srsran/srslog/srslog.h"
+#include <atomic>
+
+namespace srsenb {
+
+/**
+ * User plane channel of the X2 adapter from the stack thread of one RAT to the stack thread of the other, used for the
+ * PDUs of the EN-DC split bearers. The PDUs are passed through a lock-free SPSC ring, and the consumer stack is only
+ * woken up, with a task in its queue, when the ring was drained since the last wake-up. So the PDUs written while the
+ * consumer is busy are all handled by a single task. The control plane calls keep using the stack task queues.
+ */
+class x2_pdu_channel
+{
+public:
+  static const size_t DEFAULT_CAPACITY = 4096;
+
+  explicit x2_pdu_channel(size_t capacity = DEFAULT_CAPACITY) :
+    queue(capacity), logger(srslog::fetch_basic_logger("X2"))
+  {}
+
+  /**
+   * Writes a PDU into the channel, called from the producer stack thread
+   *
+   * @return true if the consumer stack has to be woken up to drain the channel
+   */
+  bool push(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu, int pdcp_sn = -1)
+  {
+    if (queue.try_push(pdu_t{rnti, lcid, pdcp_sn, std::move(pdu)}).is_error()) {
+      logger.warning("X2 user plane channel is full. Discarding PDU for rnti=0x%x, lcid=%d", rnti, lcid);
+      return false;
+    }
+    // A concurrent drain either sees the new PDU or clears the flag before it is set again here
+    return not drain_pending.exchange(true, std::memory_order_acq_rel);
+  }
+
+  /**
+   * Calls func(rnti, lcid, pdu, pdcp_sn) for all the PDUs in the channel, called from the consumer stack thread
+   *
+   * @return number of PDUs handled
+   */
+  template <typename F>
+  size_t drain(const F& func)
+  {
+    drain_pending.exchange(false, std::memory_order_acq_rel);
+    return queue.pop_batch([&func](pdu_t&& item) { func(item.rnti, item.lcid, std::move(item.pdu), item.pdcp_sn); });
+  }
+
+private:
+  struct pdu_t {
+    uint16_t                     rnti;
+    uint32_t                     lcid;
+    int                          pdcp_sn;
+    srsran::unique_byte_buffer_t pdu;
+  };
+
+  srsran::spsc_queue<pdu_t> queue;
+  std::atomic<bool>         drain_pending{false};
+  srslog::basic_logger&     logger;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_X2_PDU_CHANNEL_H
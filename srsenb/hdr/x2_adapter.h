@@ -30,7 +30,10 @@
  * for E-UTRAN-NR Dual Connectivity Procedures, i.e. SgNB-*
  *
  * It furthermore provide an interface for the GTPU adapter to
- * write DL PDUs, which it then forwards to the NR PDCP.
+ * write DL PDUs, which it then forwards to the NR PDCP. The user
+ * plane PDUs of the split bearers cross to the other stack thread
+ * through a lock-free x2_pdu_channel, while the control plane calls
+ * are pushed to the task queue of the receiving stack.
  *
  * It also provides a method to allow the eNB to foward timing
  * signal, i.e. TTI tics, to the NR stack.
@@ -37,7 +37,7 @@ const static size_t UE_MEM_BLOCK_SIZE = 1024 + sizeof(ue) + sizeof(rrc::ue) + si
 srsran::circular_stack_pool<SRSENB_MAX_UES>* get_rnti_pool()
 {
   static std::unique_ptr<srsran::circular_stack_pool<SRSENB_MAX_UES> > pool(
-      new srsran::circular_stack_pool<SRSENB_MAX_UES>(8, UE_MEM_BLOCK_SIZE, 4));
+      new srsran::circular_stack_pool<SRSENB_MAX_UES>(8, UE_MEM_BLOCK_SIZE, 4, -1, "rnti_pool"));
   return pool.get();
 }
 
@@ -27,7 +27,10 @@
 #include "srsran/build_info.h"
 #include "srsran/common/enb_events.h"
 #include "srsran/radio/radio_null.h"
+#include <chrono>
 #include <iostream>
+#include <sstream>
+#include <thread>
 
 namespace srsenb {
 
@@ -44,7 +47,7 @@ enb::~enb()
   nr_stack.reset();
 }
 
-int enb::init(const all_args_t& args_)
+int enb::init(const all_args_t& args_, const enb_shared_resources_t& shared)
 {
   int ret = SRSRAN_SUCCESS;
 
@@ -58,6 +61,10 @@ int enb::init(const all_args_t& args_)
     return SRSRAN_ERROR;
   }
 
+  if (args_.general.metrics_thread_counters and not sys_proc.enable_thread_counters()) {
+    srsran::console("Warning: per thread counters are not available, see the ENB log.\n");
+  }
+
   srsran::byte_buffer_pool::get_instance()->enable_logger(true);
 
   // Create layers
@@ -98,6 +105,21 @@ int enb::init(const all_args_t& args_)
     srsran::console("Error creating PHY instance.\n");
     return SRSRAN_ERROR;
   }
+  tmp_phy->set_shared_task_pool(shared.phy_task_pool);
+
+  // The radio does not depend on the stacks, so the RF device can be opened while they are initialised
+  bool parallel_radio = args.phy.nof_init_threads > 1;
+  auto t_start        = std::chrono::steady_clock::now();
+  auto t_radio        = t_start;
+  int  radio_ret      = SRSRAN_SUCCESS;
+  auto init_radio     = [&]() {
+    radio_ret = tmp_radio->init(args.rf, tmp_phy.get());
+    t_radio   = std::chrono::steady_clock::now();
+  };
+  std::thread radio_thread;
+  if (parallel_radio) {
+    radio_thread = std::thread(init_radio);
+  }
 
   // initialize layers, if they exist
   if (tmp_eutra_stack) {
@@ -114,19 +136,39 @@ int enb::init(const all_args_t& args_)
     }
   }
 
+  auto t_stack = std::chrono::steady_clock::now();
+
   // Init Radio
-  if (tmp_radio->init(args.rf, tmp_phy.get())) {
+  if (parallel_radio) {
+    radio_thread.join();
+  } else {
+    init_radio();
+  }
+  if (radio_ret) {
     srsran::console("Error initializing radio.\n");
     return SRSRAN_ERROR;
   }
 
   // Only Init PHY if radio could be initialized
+  auto t_phy = std::chrono::steady_clock::now();
   if (ret == SRSRAN_SUCCESS) {
     if (tmp_phy->init(args.phy, phy_cfg, tmp_radio.get(), tmp_eutra_stack.get(), *tmp_nr_stack, this)) {
       srsran::console("Error initializing PHY.\n");
       ret = SRSRAN_ERROR;
     }
   }
+  auto t_end = std::chrono::steady_clock::now();
+
+  // The radio time is measured from the start, as it overlaps with the stacks when initialised in parallel
+  auto elapsed_ms = [](std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+  };
+  srsran::console("Startup: stack=%.1f ms, radio=%.1f ms%s, PHY=%.1f ms, total=%.1f ms\n",
+                  elapsed_ms(t_start, t_stack),
+                  elapsed_ms(parallel_radio ? t_start : t_stack, t_radio),
+                  parallel_radio ? " (parallel)" : "",
+                  elapsed_ms(t_phy, t_end),
+                  elapsed_ms(t_start, t_end));
 
   if (tmp_eutra_stack) {
     eutra_stack = std::move(tmp_eutra_stack);
@@ -205,8 +247,10 @@ void enb::start_plot()
 
 bool enb::enable_e2_agent(srsenb::e2_interface_metrics* e2_metrics)
 {
-  std::unique_ptr<srsenb::e2_agent> tmp_e2_agent = std::unique_ptr<srsenb::e2_agent>(
-      new srsenb::e2_agent(srslog::fetch_basic_logger("E2_AGENT", log_sink, false), e2_metrics));
+  const mac_kpi_sampler* kpi_sampler = eutra_stack ? eutra_stack->get_kpi_sampler() : nullptr;
+
+  std::unique_ptr<srsenb::e2_agent> tmp_e2_agent = std::unique_ptr<srsenb::e2_agent>(new srsenb::e2_agent(
+      srslog::fetch_basic_logger("E2_AGENT", log_sink, false), e2_metrics, kpi_sampler));
   if (tmp_e2_agent == nullptr) {
     srsran::console("Error creating e2_agent instance.\n");
     return SRSRAN_ERROR;
@@ -231,6 +275,7 @@ bool enb::get_metrics(enb_metrics_t* m)
   }
   radio->get_metrics(&m->rf);
   phy->get_metrics(m->phy);
+  phy->get_timing_metrics(m->phy_timing);
   if (eutra_stack) {
     eutra_stack->get_metrics(&m->stack);
   }
@@ -239,6 +284,8 @@ bool enb::get_metrics(enb_metrics_t* m)
   }
   m->running = true;
   m->sys     = sys_proc.get_metrics();
+  srsran::pool_registry::get().get_metrics(m->pools);
+  srsran::get_stage_metrics(m->stages);
   return true;
 }
 
@@ -282,6 +329,125 @@ void enb::toggle_padding()
   }
 }
 
+static bool parse_tunable(const std::string& value, int& out)
+{
+  char* end = nullptr;
+  long  v   = strtol(value.c_str(), &end, 10);
+  if (value.empty() or *end != '\0') {
+    return false;
+  }
+  out = (int)v;
+  return true;
+}
+
+static bool parse_tunable(const std::string& value, uint32_t& out)
+{
+  int v = 0;
+  if (not parse_tunable(value, v) or v < 0) {
+    return false;
+  }
+  out = (uint32_t)v;
+  return true;
+}
+
+static bool parse_tunable(const std::string& value, bool& out)
+{
+  if (value == "true" or value == "1") {
+    out = true;
+  } else if (value == "false" or value == "0") {
+    out = false;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool enb::cmd_set_tunables(const std::string& settings)
+{
+  if (!started) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(tunables_mutex);
+
+  // Start from the current values, only the given ones change
+  sched_interface::sched_args_t&    sched_args = args.stack.mac.sched;
+  sched_interface::sched_tunables_t sched_tunables;
+  sched_tunables.sched_policy         = sched_args.sched_policy;
+  sched_tunables.sched_policy_args    = sched_args.sched_policy_args;
+  sched_tunables.pdsch_max_mcs        = sched_args.pdsch_max_mcs;
+  sched_tunables.pusch_max_mcs        = sched_args.pusch_max_mcs;
+  sched_tunables.min_nof_ctrl_symbols = sched_args.min_nof_ctrl_symbols;
+  sched_tunables.max_nof_ctrl_symbols = sched_args.max_nof_ctrl_symbols;
+  phy_tunables_t phy_tunables         = {args.phy.pusch_max_its, args.phy.use_cedron_alg};
+  bool           sched_changed        = false;
+  bool           phy_changed          = false;
+
+  std::istringstream iss(settings);
+  std::string        item;
+  while (iss >> item) {
+    size_t pos = item.find('=');
+    if (pos == std::string::npos) {
+      srsran::console("Invalid tunable %s, expected name=value\n", item.c_str());
+      return false;
+    }
+    std::string name  = item.substr(0, pos);
+    std::string value = item.substr(pos + 1);
+    bool        valid = true;
+    if (name == "scheduler.policy") {
+      sched_tunables.sched_policy = value;
+      sched_changed               = true;
+    } else if (name == "scheduler.policy_args") {
+      sched_tunables.sched_policy_args = value;
+      sched_changed                    = true;
+    } else if (name == "scheduler.pdsch_max_mcs") {
+      valid         = parse_tunable(value, sched_tunables.pdsch_max_mcs);
+      sched_changed = true;
+    } else if (name == "scheduler.pusch_max_mcs") {
+      valid         = parse_tunable(value, sched_tunables.pusch_max_mcs);
+      sched_changed = true;
+    } else if (name == "scheduler.min_nof_ctrl_symbols") {
+      valid         = parse_tunable(value, sched_tunables.min_nof_ctrl_symbols);
+      sched_changed = true;
+    } else if (name == "scheduler.max_nof_ctrl_symbols") {
+      valid         = parse_tunable(value, sched_tunables.max_nof_ctrl_symbols);
+      sched_changed = true;
+    } else if (name == "expert.pusch_max_its") {
+      valid       = parse_tunable(value, phy_tunables.pusch_max_its) and phy_tunables.pusch_max_its > 0;
+      phy_changed = true;
+    } else if (name == "expert.use_cedron_f_est_alg") {
+      valid       = parse_tunable(value, phy_tunables.use_cedron_alg);
+      phy_changed = true;
+    } else {
+      valid = false;
+    }
+    if (not valid) {
+      srsran::console("Invalid tunable %s\n", item.c_str());
+      return false;
+    }
+  }
+
+  // The scheduler validates its values, nothing is applied if it rejects them
+  if (sched_changed) {
+    if (eutra_stack == nullptr or eutra_stack->set_sched_tunables(sched_tunables) != SRSRAN_SUCCESS) {
+      srsran::console("The scheduler rejected the tunables, see the MAC log\n");
+      return false;
+    }
+    sched_args.sched_policy         = sched_tunables.sched_policy;
+    sched_args.sched_policy_args    = sched_tunables.sched_policy_args;
+    sched_args.pdsch_max_mcs        = sched_tunables.pdsch_max_mcs;
+    sched_args.pusch_max_mcs        = sched_tunables.pusch_max_mcs;
+    sched_args.min_nof_ctrl_symbols = sched_tunables.min_nof_ctrl_symbols;
+    sched_args.max_nof_ctrl_symbols = sched_tunables.max_nof_ctrl_symbols;
+  }
+  if (phy_changed and phy != nullptr) {
+    phy->set_tunables(phy_tunables);
+    args.phy.pusch_max_its  = phy_tunables.pusch_max_its;
+    args.phy.use_cedron_alg = phy_tunables.use_cedron_alg;
+  }
+  enb_log.info("Set tunables: %s", settings.c_str());
+  return true;
+}
+
 void enb::tti_clock()
 {
   if (!started) {
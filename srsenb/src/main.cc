@@ -26,10 +26,17 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include "srsran/adt/pool/pool_registry.h"
+#include "srsran/common/buffer_pool.h"
 #include "srsran/common/common_helper.h"
 #include "srsran/common/config_file.h"
 #include "srsran/common/crash_handler.h"
+#include "srsran/common/mem_prefault.h"
+#include "srsran/common/network_utils.h"
+#include "srsran/common/numa_placement.h"
+#include "srsran/common/thread_placement.h"
 #include "srsran/common/tsan_options.h"
+#include "srsran/phy/utils/huge_pages.h"
 #include "srsran/srslog/event_trace.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/support/emergency_handlers.h"
@@ -46,6 +53,7 @@
 #include "srsenb/hdr/metrics_csv.h"
 #include "srsenb/hdr/metrics_e2.h"
 #include "srsenb/hdr/metrics_json.h"
+#include "srsenb/hdr/metrics_openmetrics.h"
 #include "srsenb/hdr/metrics_stdout.h"
 #include "srsran/common/enb_events.h"
 
@@ -67,6 +75,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   string mnc;
   string enb_id;
   string cfr_mode;
+  string pcap_filter_rntis;
+  string pcap_filter_lcids;
   bool   use_standard_lte_rates = false;
 
   // Command line only options
@@ -141,6 +151,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     ("log.filename",      bpo::value<string>(&args->log.filename)->default_value("/tmp/ue.log"),"Log filename")
     ("log.file_max_size", bpo::value<int>(&args->log.file_max_size)->default_value(-1), "Maximum file size (in kilobytes). When passed, multiple files are created. Default -1 (single file)")
+    ("log.binary",        bpo::value<bool>(&args->log.binary)->default_value(false), "Write the log file in binary form, to be rendered offline with srslog_decode")
+    ("log.backend_workers", bpo::value<uint32_t>(&args->log.backend_workers)->default_value(1), "Number of log backend threads, each sink is written by one of them")
 
     /* PCAP */
     ("pcap.enable",    bpo::value<bool>(&args->stack.mac_pcap.enable)->default_value(false),         "Enable MAC packet captures for wireshark")
@@ -155,6 +167,15 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("pcap.bind_port", bpo::value<uint16_t>(&args->stack.mac_pcap_net.bind_port)->default_value(5687),        "Bind port for MAC network trace")
     ("pcap.client_ip", bpo::value<string>(&args->stack.mac_pcap_net.client_ip)->default_value("127.0.0.1"),     "Client IP address for MAC network trace")
     ("pcap.client_port", bpo::value<uint16_t>(&args->stack.mac_pcap_net.client_port)->default_value(5847),    "Enable MAC network captures")
+    ("pcap.ring_size_kb",      bpo::value<uint32_t>(&args->stack.pcap_writer.ring_size_kb)->default_value(4096),   "Size of the record ring of each PCAP file in kB")
+    ("pcap.max_file_size_mb",  bpo::value<uint32_t>(&args->stack.pcap_writer.max_file_size_mb)->default_value(0),  "Rotate the PCAP files when they reach this size in MB (0 for no limit)")
+    ("pcap.rotation_period_s", bpo::value<uint32_t>(&args->stack.pcap_writer.rotation_period_s)->default_value(0), "Rotate the PCAP files after this many seconds (0 for no limit)")
+    ("pcap.compress",          bpo::value<bool>(&args->stack.pcap_writer.compress)->default_value(false),          "Compress the PCAP files with gzip")
+    ("pcap.filter_rntis",         bpo::value<string>(&pcap_filter_rntis)->default_value(""),                               "Comma separated list of the RNTIs captured in the MAC PCAP (all if empty)")
+    ("pcap.filter_lcids",         bpo::value<string>(&pcap_filter_lcids)->default_value(""),                               "Comma separated list of the LCIDs captured in the MAC PCAP (all if empty)")
+    ("pcap.filter_crc_fail_only", bpo::value<bool>(&args->stack.mac_pcap_filter.crc_fail_only)->default_value(false),     "Capture only the MAC PDUs that failed the CRC")
+    ("pcap.sample_rate",          bpo::value<uint32_t>(&args->stack.mac_pcap_filter.sample_rate)->default_value(1),      "Capture one out of sample_rate MAC PDUs passing the filters")
+    ("pcap.snap_len",             bpo::value<uint32_t>(&args->stack.mac_pcap_filter.snap_len)->default_value(0),         "Truncate the captured MAC PDUs to this many bytes (0 to capture them whole)")
 
     /* Scheduling section */
     ("scheduler.policy", bpo::value<string>(&args->stack.mac.sched.sched_policy)->default_value("time_pf"), "DL and UL data scheduling policy (E.g. time_rr, time_pf)")
@@ -181,6 +202,9 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("scheduler.init_dl_cqi", bpo::value<int>(&args->stack.mac.sched.init_dl_cqi)->default_value(5), "DL CQI value used before any CQI report is available to the eNB")
     ("scheduler.max_sib_coderate", bpo::value<float>(&args->stack.mac.sched.max_sib_coderate)->default_value(0.8), "Upper bound on SIB and RAR grants coderate")
     ("scheduler.pdcch_cqi_offset", bpo::value<int>(&args->stack.mac.sched.pdcch_cqi_offset)->default_value(0), "CQI offset in derivation of PDCCH aggregation level")
+    ("scheduler.nof_cc_threads", bpo::value<uint32_t>(&args->stack.mac.sched.nof_cc_threads)->default_value(0), "Extra threads used to schedule the LTE carriers in parallel (0 schedules them serially)")
+    ("scheduler.trace_filename", bpo::value<string>(&args->stack.mac.sched.trace_filename)->default_value(""), "File where the scheduler inputs are recorded for replay with sched_replay (empty disables the recording)")
+    ("scheduler.lookahead_ttis", bpo::value<uint32_t>(&args->stack.mac.sched.lookahead_ttis)->default_value(0), "TTIs the scheduling decisions are computed ahead of the PHY, up to 2 (0 disables the lookahead)")
 
     /*Slicing conifguration*/
     ("slicing.enable_eMBB", bpo::value<bool>(&args->nr_stack.ngap.nssai[0].active)->default_value(true), "Enables enhanced mobile broadband (eMBB) slice in the gNodeB")
@@ -250,12 +274,29 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.metrics_period_secs", bpo::value<float>(&args->general.metrics_period_secs)->default_value(1.0), "Periodicity for metrics in seconds.")
     ("expert.metrics_csv_enable",  bpo::value<bool>(&args->general.metrics_csv_enable)->default_value(false), "Write metrics to CSV file.")
     ("expert.metrics_csv_filename", bpo::value<string>(&args->general.metrics_csv_filename)->default_value("/tmp/enb_metrics.csv"), "Metrics CSV filename.")
+    ("expert.metrics_http_bind_addr", bpo::value<string>(&args->general.metrics_http_bind_addr)->default_value("127.0.0.1"), "Address the Prometheus metrics endpoint listens on.")
+    ("expert.metrics_http_port", bpo::value<uint16_t>(&args->general.metrics_http_port)->default_value(0), "Port of the Prometheus metrics endpoint, 0 disables it.")
+    ("expert.control_bind_addr", bpo::value<string>(&args->general.control_bind_addr)->default_value("127.0.0.1"), "Address the UDP control socket listens on.")
+    ("expert.control_port", bpo::value<uint16_t>(&args->general.control_port)->default_value(0), "Port of the UDP control socket accepting the console commands, e.g. set to change tunables at runtime. 0 disables it.")
+    ("expert.metrics_udp_addr", bpo::value<string>(&args->general.metrics_udp_addr)->default_value(""), "Address the binary metrics deltas are pushed to, empty disables the push.")
+    ("expert.metrics_udp_port", bpo::value<uint16_t>(&args->general.metrics_udp_port)->default_value(9300), "Port the binary metrics deltas are pushed to.")
+    ("expert.metrics_keyframe_period", bpo::value<uint32_t>(&args->general.metrics_keyframe_period)->default_value(10), "Number of metrics periods between pushes of all the series.")
+    ("expert.metrics_thread_counters", bpo::value<bool>(&args->general.metrics_thread_counters)->default_value(false), "Count the cycles, instructions, LLC misses and context switches of each thread with perf_event.")
     ("expert.pusch_max_its", bpo::value<uint32_t>(&args->phy.pusch_max_its)->default_value(8), "Maximum number of turbo decoder iterations for LTE.")
+    ("expert.late_pusch_max_its", bpo::value<uint32_t>(&args->phy.late_pusch_max_its)->default_value(0), "Maximum number of turbo decoder iterations for LTE in the TTIs following a late transmission, 0 disables the load shedding.")
     ("expert.pusch_8bit_decoder", bpo::value<bool>(&args->phy.pusch_8bit_decoder)->default_value(false), "Use 8-bit for LLR representation and turbo decoder trellis computation (Experimental).")
     ("expert.pusch_meas_evm", bpo::value<bool>(&args->phy.pusch_meas_evm)->default_value(false), "Enable/Disable PUSCH EVM measure.")
     ("expert.tx_amplitude", bpo::value<float>(&args->phy.tx_amplitude)->default_value(0.6), "Transmit amplitude factor.")
     ("expert.nof_phy_threads", bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3), "Number of PHY threads.")
-    ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier. Only 1 or 0 is supported.")
+    ("expert.min_phy_threads", bpo::value<uint32_t>(&args->phy.min_phy_threads)->default_value(0), "Minimum number of active PHY threads, the others are parked while the processing meets its deadline. 0 keeps all the PHY threads active.")
+    ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier, or in total with prach_shared_pool. Only 1 or 0 is supported per carrier.")
+    ("expert.prach_shared_pool", bpo::value<bool>(&args->phy.prach_shared_pool)->default_value(false), "Process the PRACH of all the carriers in a shared pool of nof_prach_threads threads.")
+    ("expert.prach_cpu_mask", bpo::value<uint32_t>(&args->phy.prach_cpu_mask)->default_value(255), "CPU mask for the threads of the shared PRACH pool, 255 disables the pinning.")
+    ("expert.nof_cc_threads", bpo::value<uint32_t>(&args->phy.nof_cc_threads)->default_value(0), "Number of threads shared by the PHY workers for processing the carriers of a subframe in parallel, 0 processes them serially.")
+    ("expert.nof_pusch_threads", bpo::value<uint32_t>(&args->phy.nof_pusch_threads)->default_value(0), "Number of threads shared by the PHY workers for decoding the PUSCH of several users of a subframe in parallel, 0 decodes them serially.")
+    ("expert.nof_nr_ul_threads", bpo::value<uint32_t>(&args->phy.nof_nr_ul_threads)->default_value(0), "Number of threads shared by the NR PHY workers for processing the UL of a slot while the worker processes its DL, 0 processes them serially.")
+    ("expert.nof_init_threads", bpo::value<uint32_t>(&args->phy.nof_init_threads)->default_value(4), "Number of threads initialising the PHY workers at startup, while the radio is opened in parallel with the stack initialisation. 0 or 1 initialises everything serially.")
+    ("expert.rx_prefetch_sf", bpo::value<uint32_t>(&args->phy.rx_prefetch_sf)->default_value(0), "Number of subframes received ahead of their dispatching to the PHY workers, 0 receives and dispatches serially.")
     ("expert.max_prach_offset_us", bpo::value<float>(&args->phy.max_prach_offset_us)->default_value(30), "Maximum allowed RACH offset (in us).")
     ("expert.equalizer_mode", bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"), "Equalizer mode.")
     ("expert.estimator_fil_w", bpo::value<float>(&args->phy.estimator_fil_w)->default_value(0.1), "Chooses the coefficients for the 3-tap channel estimator centered filter.")
@@ -268,16 +309,33 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.tracing_enable",  bpo::value<bool>(&args->general.tracing_enable)->default_value(false), "Events tracing.")
     ("expert.tracing_filename", bpo::value<string>(&args->general.tracing_filename)->default_value("/tmp/enb_tracing.log"), "Tracing events filename.")
     ("expert.tracing_buffcapacity", bpo::value<std::size_t>(&args->general.tracing_buffcapacity)->default_value(1000000), "Tracing buffer capcity.")
+    ("expert.tracing_hot_enable",  bpo::value<bool>(&args->general.tracing_hot_enable)->default_value(false), "Hot path tracing of the PHY and stack pipelines, exported in Chrome trace JSON format at exit.")
+    ("expert.tracing_hot_filename", bpo::value<string>(&args->general.tracing_hot_filename)->default_value("/tmp/enb_trace.json"), "Hot path tracing JSON filename.")
+    ("expert.tracing_hot_events", bpo::value<std::size_t>(&args->general.tracing_hot_events)->default_value(65536), "Number of most recent hot path events kept per thread.")
     ("expert.stdout_ts_enable", bpo::value<bool>(&stdout_ts_enable)->default_value(false), "Prints once per second the timestamp into stdout.")
     ("expert.rrc_inactivity_timer", bpo::value<uint32_t>(&args->general.rrc_inactivity_timer)->default_value(30000), "Inactivity timer in ms.")
     ("expert.print_buffer_state", bpo::value<bool>(&args->general.print_buffer_state)->default_value(false), "Prints on the console the buffer state every 10 seconds.")
     ("expert.eea_pref_list", bpo::value<string>(&args->general.eea_pref_list)->default_value("EEA0, EEA2, EEA1"), "Ordered preference list for the selection of encryption algorithm (EEA) (default: EEA0, EEA2, EEA1).")
     ("expert.eia_pref_list", bpo::value<string>(&args->general.eia_pref_list)->default_value("EIA2, EIA1, EIA0"), "Ordered preference list for the selection of integrity algorithm (EIA) (default: EIA2, EIA1, EIA0).")
     ("expert.nof_prealloc_ues", bpo::value<uint32_t>(&args->stack.mac.nof_prealloc_ues)->default_value(8), "Number of UE resources to preallocate during eNB initialization.")
+    ("expert.lazy_ul_softbuffers", bpo::value<bool>(&args->stack.mac.ul_softbuffer_lazy_alloc)->default_value(false), "Allocate the UL softbuffers on their first use and free them with the UE.")
     ("expert.lcid_padding", bpo::value<int>(&args->stack.mac.lcid_padding)->default_value(3), "LCID on which to put MAC padding")
     ("expert.max_mac_dl_kos", bpo::value<uint32_t>(&args->general.max_mac_dl_kos)->default_value(100), "Maximum number of consecutive KOs in DL before triggering the UE's release (default 100).")
     ("expert.max_mac_ul_kos", bpo::value<uint32_t>(&args->general.max_mac_ul_kos)->default_value(100), "Maximum number of consecutive KOs in UL before triggering the UE's release (default 100).")
     ("expert.gtpu_tunnel_timeout", bpo::value<uint32_t>(&args->stack.gtpu_indirect_tunnel_timeout_msec)->default_value(0), "Maximum time that GTPU takes to release indirect forwarding tunnel since the last received GTPU PDU (0 for infinity).")
+    ("expert.gtpu_xdp_ifname", bpo::value<string>(&args->stack.gtpu_xdp_ifname)->default_value(""), "Network interface on which the S1-U datagrams of one Rx queue are received through an AF_XDP socket, bypassing the kernel network stack. Empty disables it.")
+    ("expert.gtpu_xdp_queue", bpo::value<uint32_t>(&args->stack.gtpu_xdp_queue_id)->default_value(0), "Rx queue of the interface received through the AF_XDP socket.")
+    ("expert.nof_pdcp_crypto_threads", bpo::value<uint32_t>(&args->stack.nof_pdcp_crypto_threads)->default_value(0), "Number of threads ciphering the PDCP DRB PDUs, 0 ciphers them in the stack thread.")
+    ("expert.nof_rrc_ue_threads", bpo::value<uint32_t>(&args->stack.nof_rrc_ue_threads)->default_value(0), "Number of threads decoding the UL RRC messages of different UEs in parallel with the stack thread, 0 decodes them in the stack thread.")
+    ("expert.thread_profile", bpo::value<string>(&args->general.thread_profile)->default_value(""), "Thread placement profile, NAME=CPUS[:POLICY[:PRIORITY]] rules separated by ';'. Empty keeps the placement of each component.")
+    ("expert.numa_mem_profile", bpo::value<string>(&args->general.numa_mem_profile)->default_value(""), "NUMA placement of the memory pools, POOL=NODE rules separated by ';' with POOL bearers, buffers or harq and NODE a node index or auto. Empty keeps the kernel placement.")
+    ("expert.huge_pages", bpo::value<string>(&args->general.huge_pages)->default_value("none"), "Page size of the PHY buffers, softbuffers and byte buffer pool, none, 2M or 1G. Falls back to transparent huge pages when no reserved page is left.")
+    ("expert.mem_lock", bpo::value<bool>(&args->general.mem_lock)->default_value(true), "Lock the memory of the process with mlockall, so that it is never swapped out.")
+    ("expert.mem_reserve_heap_mb", bpo::value<uint32_t>(&args->general.mem_reserve_heap_mb)->default_value(0), "Heap faulted in before the PHY and the stack allocate their buffers, in MB. The heap is then never returned to the kernel. 0 disables it.")
+    ("expert.mem_prefault", bpo::value<bool>(&args->general.mem_prefault)->default_value(true), "Fault in the memory of the pools once the eNB is initialized, so that their first use under traffic does not page fault.")
+    ("expert.socket_backend", bpo::value<string>(&args->general.socket_backend)->default_value("select"), "Mechanism the GTP-U and S1AP Rx sockets thread uses to wait for data, select or io_uring. io_uring falls back to select if it is not available.")
+    ("expert.instance_confs", bpo::value<string>(&args->general.instance_confs)->default_value(""), "Configuration files of additional eNB instances hosted in this process, separated by ','. Each instance has its own eNB ID, S1 link and radio, the process wide options (logging, memory, threads, metrics and console) are taken from this file.")
+    ("expert.shared_phy_threads", bpo::value<uint32_t>(&args->general.shared_phy_threads)->default_value(0), "Number of threads of a PHY pool shared by all the hosted eNB instances for processing the carriers and decoding the PUSCH in parallel, it replaces nof_cc_threads and nof_pusch_threads. 0 keeps the pools of each instance.")
     ("expert.rlf_release_timer_ms", bpo::value<uint32_t>(&args->general.rlf_release_timer_ms)->default_value(4000), "Time taken by eNB to release UE context after it detects an RLF.")
     ("expert.extended_cp", bpo::value<bool>(&args->phy.extended_cp)->default_value(false), "Use extended cyclic prefix")
     ("expert.ts1_reloc_prep_timeout", bpo::value<uint32_t>(&args->stack.s1ap.ts1_reloc_prep_timeout)->default_value(10000), "S1AP TS 36.413 TS1RelocPrep Expiry Timeout value in milliseconds.")
@@ -303,7 +361,12 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     // NR section
     ("scheduler.nr_pdsch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_dl_mcs)->default_value(28), "Fixed NR DL MCS (-1 for dynamic).")
     ("scheduler.nr_pusch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_ul_mcs)->default_value(28), "Fixed NR UL MCS (-1 for dynamic).")
+    ("scheduler.nr_policy", bpo::value<string>(&args->nr_stack.mac.sched_cfg.sched_policy)->default_value("time_rr"), "NR DL and UL data scheduling policy (E.g. time_rr, time_pf)")
+    ("scheduler.nr_policy_args", bpo::value<string>(&args->nr_stack.mac.sched_cfg.sched_policy_args)->default_value("1"), "NR scheduler policy-specific arguments")
+    ("scheduler.nr_nof_cand_threads", bpo::value<uint32_t>(&args->nr_stack.mac.sched_cfg.nof_cand_threads)->default_value(0), "Threads, including the scheduling one, deriving the NR UE grant candidates of a slot in parallel (0 or 1 for serial).")
     ("expert.nr_pusch_max_its", bpo::value<uint32_t>(&args->phy.nr_pusch_max_its)->default_value(10),     "Maximum number of LDPC iterations for NR.")
+    ("expert.nr_ldpc_workers", bpo::value<int32_t>(&args->phy.nr_ldpc_workers)->default_value(-1), "Number of threads of each NR PHY worker decoding the PUSCH LDPC code blocks in parallel, -1 decodes them in the PHY worker.")
+    ("expert.nr_pusch_wiener", bpo::value<bool>(&args->phy.nr_pusch_wiener)->default_value(false), "Interpolate the NR PUSCH DMRS channel estimates with Wiener filters selected by the measured SNR and delay spread.")
   ;
 
   // Positional options - config file location
@@ -391,10 +454,18 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     }
   }
 
+  // Check scheduler lookahead. The DL retxs are delayed by the lookahead, so deeper pipelines are not allowed
+  if (args->stack.mac.sched.lookahead_ttis > 2) {
+    fprintf(stderr,
+            "lookahead_ttis = %d. Value is not supported, only 0, 1 or 2 are allowed\n",
+            args->stack.mac.sched.lookahead_ttis);
+    exit(1);
+  }
+
   // Check PRACH workers
-  if (args->phy.nof_prach_threads > 1) {
+  if (args->phy.nof_prach_threads > 1 && not args->phy.prach_shared_pool) {
     fprintf(stderr,
-            "nof_prach_workers = %d. Value is not supported, only 0 or 1 are allowed\n",
+            "nof_prach_workers = %d. Value is not supported, only 0 or 1 are allowed without prach_shared_pool\n",
             args->phy.nof_prach_threads);
     exit(1);
   }
@@ -412,6 +483,22 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     exit(1);
   }
 
+  // Convert the MAC PCAP filter lists, the values can be given in hex (e.g. 0x46)
+  try {
+    std::vector<std::string> list;
+    srsran::string_parse_list(pcap_filter_rntis, ',', list);
+    for (const std::string& rnti : list) {
+      args->stack.mac_pcap_filter.rntis.push_back(std::stoul(rnti, nullptr, 0));
+    }
+    srsran::string_parse_list(pcap_filter_lcids, ',', list);
+    for (const std::string& lcid : list) {
+      args->stack.mac_pcap_filter.lcids.push_back(std::stoul(lcid, nullptr, 0));
+    }
+  } catch (...) {
+    cout << "Error parsing pcap.filter_rntis or pcap.filter_lcids." << endl;
+    exit(1);
+  }
+
   // parse the CFR mode string
   args->phy.cfr_args.mode = srsran_cfr_str2mode(cfr_mode.c_str());
   if (args->phy.cfr_args.mode == SRSRAN_CFR_THR_INVALID) {
@@ -503,7 +590,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 static bool do_metrics = false;
 static bool do_padding = false;
 
-static void execute_cmd(metrics_stdout* metrics, srsenb::enb_command_interface* control, const string& cmd_line)
+/// Returns false if the command was not valid or failed
+static bool execute_cmd(metrics_stdout* metrics, srsenb::enb_command_interface* control, const string& cmd_line)
 {
   vector<string> cmd;
   srsran::string_parse_list(cmd_line, ' ', cmd);
@@ -521,11 +609,11 @@ static void execute_cmd(metrics_stdout* metrics, srsenb::enb_command_interface*
   } else if (cmd[0] == "sleep") {
     if (cmd.size() != 2) {
       cout << "Usage: " << cmd[0] << " [number of seconds]" << endl;
-      return;
+      return false;
     }
     int nseconds = srsran::string_cast<int>(cmd[1]);
     if (nseconds <= 0) {
-      return;
+      return false;
     }
     std::this_thread::sleep_for(std::chrono::seconds(nseconds));
   } else if (cmd[0] == "p") {
@@ -541,7 +629,7 @@ static void execute_cmd(metrics_stdout* metrics, srsenb::enb_command_interface*
   } else if (cmd[0] == "cell_gain") {
     if (cmd.size() != 3) {
       cout << "Usage: " << cmd[0] << " [cell identifier] [gain in dB]" << endl;
-      return;
+      return false;
     }
 
     // Parse command arguments
@@ -553,10 +641,25 @@ static void execute_cmd(metrics_stdout* metrics, srsenb::enb_command_interface*
   } else if (cmd[0] == "flush") {
     if (cmd.size() != 1) {
       cout << "Usage: " << cmd[0] << endl;
-      return;
+      return false;
     }
     srslog::flush();
     cout << "Flushed log file buffers" << endl;
+  } else if (cmd[0] == "set") {
+    if (cmd.size() < 2) {
+      cout << "Usage: " << cmd[0] << " [name=value] ..." << endl;
+      return false;
+    }
+
+    // Apply all the values together
+    string settings;
+    for (size_t i = 1; i < cmd.size(); ++i) {
+      settings += cmd[i] + " ";
+    }
+    if (not control->cmd_set_tunables(settings)) {
+      return false;
+    }
+    cout << "Tunables set" << endl;
   } else {
     cout << "Available commands: " << endl;
     cout << "          t: starts console trace" << endl;
@@ -566,8 +669,11 @@ static void execute_cmd(metrics_stdout* metrics, srsenb::enb_command_interface*
     cout << "      sleep: pauses the commmand line operation for a given time in seconds" << endl;
     cout << "          p: starts MAC padding" << endl;
     cout << "      flush: flushes the buffers for the log file" << endl;
+    cout << "        set: changes tunables without a restart, e.g. set scheduler.pdsch_max_mcs=20" << endl;
     cout << endl;
+    return false;
   }
+  return true;
 }
 
 static void* input_loop(metrics_stdout* metrics, srsenb::enb_command_interface* control)
@@ -595,6 +701,38 @@ static void* input_loop(metrics_stdout* metrics, srsenb::enb_command_interface*
   return nullptr;
 }
 
+/// Executes the commands received as UDP datagrams, with the same syntax as the console, and replies OK or ERROR
+static void* control_loop(metrics_stdout* metrics, srsenb::enb_command_interface* control, srsran::unique_socket* sock)
+{
+  struct pollfd pfd = {sock->fd(), POLLIN, 0};
+  char          buf[1024];
+  while (running) {
+    if (poll(&pfd, 1, 1000) != 1) {
+      continue;
+    }
+    sockaddr_in from     = {};
+    socklen_t   from_len = sizeof(from);
+    ssize_t     n        = recvfrom(sock->fd(), buf, sizeof(buf) - 1, 0, (sockaddr*)&from, &from_len);
+    if (n <= 0) {
+      continue;
+    }
+    buf[n] = '\0';
+
+    string input_line(buf);
+    input_line.erase(input_line.find_last_not_of("\r\n") + 1);
+    list<string> cmd_list;
+    srsran::string_parse_list(input_line, ';', cmd_list);
+    bool success = not cmd_list.empty();
+    for (const string& cmd : cmd_list) {
+      success = not cmd.empty() and execute_cmd(metrics, control, cmd) and success;
+    }
+
+    const char* reply = success ? "OK\n" : "ERROR\n";
+    sendto(sock->fd(), reply, strlen(reply), 0, (sockaddr*)&from, from_len);
+  }
+  return nullptr;
+}
+
 /// Adjusts the input value in args from kbytes to bytes.
 static size_t fixup_log_file_maxsize(int x)
 {
@@ -616,6 +754,102 @@ static void signal_handler()
   running = false;
 }
 
+static bool configure_thread_placement(const std::string& profile)
+{
+  std::string              err;
+  std::vector<std::string> warnings;
+  if (not srsran::thread_placement::get().configure(profile, err, &warnings)) {
+    srsran::console_stderr("Error: invalid thread profile, %s\n", err.c_str());
+    return false;
+  }
+  for (const std::string& warning : warnings) {
+    srsran::console("Warning: thread profile, %s\n", warning.c_str());
+  }
+  if (srsran::thread_placement::get().is_enabled()) {
+    srsran::console("Thread profile:\n%s", srsran::thread_placement::get().to_string().c_str());
+  }
+  return true;
+}
+
+static bool configure_socket_backend(const std::string& backend_str)
+{
+  srsran::socket_manager::backend_t backend;
+  if (not srsran::from_string(backend_str, backend)) {
+    srsran::console_stderr("Error: invalid socket backend %s, expected select or io_uring\n", backend_str.c_str());
+    return false;
+  }
+  srsran::set_rx_io_backend(backend);
+  return true;
+}
+
+static bool configure_huge_pages(const std::string& mode_str)
+{
+  srsran_huge_pages_t mode = SRSRAN_HUGE_PAGES_NONE;
+  if (srsran_huge_pages_from_string(mode_str.c_str(), &mode) < SRSRAN_SUCCESS) {
+    srsran::console_stderr("Error: invalid huge pages %s, expected none, 2M or 1G\n", mode_str.c_str());
+    return false;
+  }
+  srsran_huge_pages_set_mode(mode);
+  if (mode != SRSRAN_HUGE_PAGES_NONE) {
+    int nof_free = srsran_huge_pages_nof_free(mode);
+    if (nof_free <= 0) {
+      srsran::console("Warning: no free %s huge page reserved, using transparent huge pages\n", mode_str.c_str());
+    } else {
+      srsran::console("Using %s huge pages, %d free\n", mode_str.c_str(), nof_free);
+    }
+  }
+  return true;
+}
+
+/// Locks the memory and reserves the heap before the eNB allocates its buffers. Returns the time spent, in ms
+static double prepare_memory(const all_args_t& args)
+{
+  auto        t_start = std::chrono::steady_clock::now();
+  std::string err;
+  if (args.general.mem_lock and not srsran::mem_lock_all(err)) {
+    srsran::console("Failed to `mlockall`: %s\n", err.c_str());
+  }
+  size_t heap_bytes = srsran::mem_reserve_heap(size_t(args.general.mem_reserve_heap_mb) << 20U);
+  if (heap_bytes < (size_t(args.general.mem_reserve_heap_mb) << 20U)) {
+    srsran::console("Failed to reserve %d MB of heap\n", args.general.mem_reserve_heap_mb);
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t_start).count();
+}
+
+/// Faults in the memory of the pools created by the eNB initialization and reports the time spent at startup
+static void prefault_memory(const all_args_t& args, double prepare_ms)
+{
+  auto   t_start    = std::chrono::steady_clock::now();
+  size_t pool_bytes = 0;
+  if (args.general.mem_prefault) {
+    pool_bytes = srsran::pool_registry::get().prefault();
+  }
+  double prefault_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t_start).count();
+  if (args.general.mem_lock or args.general.mem_reserve_heap_mb > 0 or args.general.mem_prefault) {
+    srsran::console("Memory prefault: lock=%s, heap=%d MB, pools=%.1f MB, %.1f ms\n",
+                    args.general.mem_lock ? "yes" : "no",
+                    args.general.mem_reserve_heap_mb,
+                    pool_bytes / (1024.0 * 1024.0),
+                    prepare_ms + prefault_ms);
+  }
+}
+
+static bool configure_numa_placement(const std::string& profile)
+{
+  std::string err;
+  if (not srsran::numa_placement::get().configure(profile, err)) {
+    srsran::console_stderr("Error: invalid NUMA memory profile, %s\n", err.c_str());
+    return false;
+  }
+  if (srsran::numa_placement::get().is_enabled()) {
+    // The byte buffer pool is allocated on its first use, bind it before the stack starts using it
+    srsran::byte_buffer_pool* pool = srsran::byte_buffer_pool::get_instance();
+    srsran::numa_placement::get().bind(srsran::numa_pool_t::buffers, pool->get_memory(), pool->get_memory_size());
+    srsran::console("NUMA memory profile:\n%s", srsran::numa_placement::get().to_string().c_str());
+  }
+  return true;
+}
+
 int main(int argc, char* argv[])
 {
   srsran_register_signal_handler(signal_handler);
@@ -630,11 +864,31 @@ int main(int argc, char* argv[])
   srsran_debug_handle_crash(argc, argv);
   parse_args(&args, argc, argv);
 
-  // Setup the default log sink.
+  // The profile has to be in place before the first thread is created
+  if (not configure_thread_placement(args.general.thread_profile)) {
+    return SRSRAN_ERROR;
+  }
+  // The byte buffer pool is created by the NUMA placement, select the page size first
+  if (not configure_huge_pages(args.general.huge_pages)) {
+    return SRSRAN_ERROR;
+  }
+  if (not configure_numa_placement(args.general.numa_mem_profile)) {
+    return SRSRAN_ERROR;
+  }
+  if (not configure_socket_backend(args.general.socket_backend)) {
+    return SRSRAN_ERROR;
+  }
+
+  // Setup the log backend threads and the default log sink.
+  srslog::set_backend_workers(args.log.backend_workers);
   srslog::set_default_sink(
       (args.log.filename == "stdout")
           ? srslog::fetch_stdout_sink()
-          : srslog::fetch_file_sink(args.log.filename, fixup_log_file_maxsize(args.log.file_max_size)));
+          : srslog::fetch_file_sink(args.log.filename,
+                                    fixup_log_file_maxsize(args.log.file_max_size),
+                                    false,
+                                    args.log.binary ? srslog::create_binary_formatter()
+                                                    : srslog::get_default_log_formatter()));
 
   // Alarms log channel creation.
   srslog::sink&        alarm_sink     = srslog::fetch_file_sink(args.general.alarms_filename, 0, true);
@@ -647,6 +901,11 @@ int main(int argc, char* argv[])
       return SRSRAN_ERROR;
     }
   }
+  if (args.general.tracing_hot_enable) {
+    if (!srslog::event_trace_hot_init(args.general.tracing_hot_filename, args.general.tracing_hot_events)) {
+      return SRSRAN_ERROR;
+    }
+  }
 #endif
 
   // Start the log backend.
@@ -672,17 +931,45 @@ int main(int argc, char* argv[])
     event_logger::configure(json_channel, format);
   }
 
-  if (mlockall((uint32_t)MCL_CURRENT | (uint32_t)MCL_FUTURE) == -1) {
-    srsran::console("Failed to `mlockall`: {}", errno);
+  double prepare_ms = prepare_memory(args);
+
+  // The PHY threads can be shared by all the eNB instances, so that the idle cells lend them to the busy ones
+  srsenb::enb_shared_resources_t shared = {};
+  if (args.general.shared_phy_threads > 0) {
+    shared.phy_task_pool = srsenb::phy::create_shared_task_pool(args.general.shared_phy_threads);
   }
 
   // Create eNB
   unique_ptr<srsenb::enb> enb{new srsenb::enb(srslog::get_default_sink())};
-  if (enb->init(args) != SRSRAN_SUCCESS) {
+  if (enb->init(args, shared) != SRSRAN_SUCCESS) {
     enb->stop();
     return SRSRAN_ERROR;
   }
 
+  // Additional eNB instances, each one parsed from its own configuration file
+  std::vector<std::string>             instance_confs;
+  std::vector<unique_ptr<srsenb::enb>> instances;
+  srsran::string_parse_list(args.general.instance_confs, ',', instance_confs);
+  for (std::string& conf : instance_confs) {
+    all_args_t instance_args   = {};
+    char*      instance_argv[] = {argv[0], &conf[0]};
+    parse_args(&instance_args, 2, instance_argv);
+
+    instances.emplace_back(new srsenb::enb(srslog::get_default_sink()));
+    if (instances.back()->init(instance_args, shared) != SRSRAN_SUCCESS) {
+      srsran::console("Error initializing the eNB instance of %s\n", conf.c_str());
+      for (unique_ptr<srsenb::enb>& instance : instances) {
+        instance->stop();
+      }
+      enb->stop();
+      return SRSRAN_ERROR;
+    }
+  }
+  if (not instances.empty()) {
+    srsran::console("Hosting %zd eNB instances\n", instances.size() + 1);
+  }
+  prefault_memory(args, prepare_ms);
+
   // Set metrics
   metricshub.init(enb.get(), args.general.metrics_period_secs);
   metricshub.add_listener(&metrics_screen);
@@ -697,6 +984,20 @@ int main(int argc, char* argv[])
   if (args.general.report_json_enable) {
     metricshub.add_listener(&json_metrics);
   }
+  srsenb::metrics_openmetrics_args_t openmetrics_args;
+  openmetrics_args.http_bind_addr  = args.general.metrics_http_bind_addr;
+  openmetrics_args.http_port       = args.general.metrics_http_port;
+  openmetrics_args.udp_addr        = args.general.metrics_udp_addr;
+  openmetrics_args.udp_port        = args.general.metrics_udp_port;
+  openmetrics_args.keyframe_period = args.general.metrics_keyframe_period;
+  srsenb::metrics_openmetrics openmetrics(openmetrics_args);
+  if (args.general.metrics_http_port != 0 or not args.general.metrics_udp_addr.empty()) {
+    if (openmetrics.init()) {
+      metricshub.add_listener(&openmetrics);
+    } else {
+      srsran::console("Failed to start the metrics exporter\n");
+    }
+  }
   srsenb::metrics_e2 e2_metrics(enb.get());
   if (args.e2_agent.enable) {
     metricshub.add_listener(&e2_metrics);
@@ -705,6 +1006,30 @@ int main(int argc, char* argv[])
   // create input thread
   std::thread input(&input_loop, &metrics_screen, (enb_command_interface*)enb.get());
 
+  // create the control socket thread, if enabled
+  srsran::unique_socket control_socket;
+  std::thread           control;
+  if (args.general.control_port != 0) {
+    if (control_socket.open_socket(srsran::net_utils::addr_family::ipv4,
+                                   srsran::net_utils::socket_type::datagram,
+                                   srsran::net_utils::protocol_type::UDP) and
+        control_socket.bind_addr(args.general.control_bind_addr.c_str(), args.general.control_port)) {
+      srsran::console("Listening for commands on %s:%d/udp\n",
+                      args.general.control_bind_addr.c_str(),
+                      args.general.control_port);
+      control = std::thread(&control_loop, &metrics_screen, (enb_command_interface*)enb.get(), &control_socket);
+    } else {
+      srsran::console("Failed to open the control socket on %s:%d\n",
+                      args.general.control_bind_addr.c_str(),
+                      args.general.control_port);
+    }
+  }
+
+  // Place the threads that were not created through srsran::thread, such as the log backend and this one
+  if (srsran::thread_placement::get().is_enabled()) {
+    srsran::console("Thread profile applied to %d threads\n", srsran::thread_placement::get().apply_all());
+  }
+
   if (running) {
     if (args.gui.enable) {
       enb->start_plot();
@@ -738,8 +1063,35 @@ int main(int argc, char* argv[])
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
   }
   input.join();
+  if (control.joinable()) {
+    control.join();
+  }
   metricshub.stop();
+  for (unique_ptr<srsenb::enb>& instance : instances) {
+    instance->stop();
+  }
   enb->stop();
+  if (shared.phy_task_pool != nullptr) {
+    shared.phy_task_pool->stop();
+  }
+#ifdef ENABLE_SRSLOG_EVENT_TRACE
+  if (args.general.tracing_hot_enable) {
+    if (srslog::event_trace_hot_export()) {
+      cout << "Hot path trace written to " << args.general.tracing_hot_filename << endl;
+    } else {
+      cout << "Error writing the hot path trace to " << args.general.tracing_hot_filename << endl;
+    }
+  }
+#endif
+  // Release the UE contexts, so that the blocks left in the pools can be reported
+  instances.clear();
+  enb.reset();
+  srsran::pool_registry::get().log_leaks(srslog::fetch_basic_logger("POOL"));
+  srslog::backend_drop_stats log_drops = srslog::get_backend_drop_stats();
+  if (log_drops.queue_full > 0 or log_drops.no_arg_store > 0) {
+    cout << "Log entries dropped: " << log_drops.queue_full << " (queue full), " << log_drops.no_arg_store
+         << " (no argument store)" << endl;
+  }
   cout << "---  exiting  ---" << endl;
 
   return SRSRAN_SUCCESS;
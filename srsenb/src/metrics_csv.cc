@@ -68,6 +68,16 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
         file << ";cpu_" << std::to_string(i);
       }
 
+      // Add the NUMA nodes
+      for (uint32_t i = 0, e = metrics.sys.numa_node_count; i != e; ++i) {
+        file << ";numa" << std::to_string(i) << "_mem_kB";
+      }
+
+      // Add the processing time of the TTI stages
+      for (const srsran::tprof_histogram_metrics_t& s : metrics.stages) {
+        file << ";" << s.name << "_p50_us;" << s.name << "_p99_us;" << s.name << "_max_us";
+      }
+
       // Add the new line.
       file << "\n";
     }
@@ -113,6 +123,17 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
       file << float_to_string(m.cpu_load[i], 2, (i != last_cpu_index));
     }
 
+    // Write the resident memory of each NUMA node.
+    for (uint32_t i = 0, e = m.numa_node_count; i != e; ++i) {
+      file << ";" << std::to_string(m.numa_node_mem_kB[i]);
+    }
+
+    // Write the processing time of the TTI stages.
+    for (const srsran::tprof_histogram_metrics_t& s : metrics.stages) {
+      file << ";" << float_to_string(s.p50_us, 2) << float_to_string(s.p99_us, 2)
+           << float_to_string(s.max_us, 2, false);
+    }
+
     file << "\n";
 
     n_reports++;
@@ -26,14 +26,7 @@ using namespace srsenb;
 
 void metrics_e2::set_metrics(const enb_metrics_t& m, const uint32_t period_usec)
 {
-  if (metrics_queue.size() > METRICS_BUFFER_SIZE) {
-    metrics_queue.pop();
-    metrics_queue.push(m);
-  } else {
-    metrics_queue.push(m);
-  }
-
-  // send new enb metrics to all registered SMs
+  // send new enb metrics to all registered SMs, which update their measurements in place
   for (auto sm_ : e2sm_vec) {
     sm_->receive_e2_metrics_callback(m);
   }
@@ -57,12 +50,6 @@ bool metrics_e2::unregister_e2sm(e2sm* sm)
 
 bool metrics_e2::pull_metrics(enb_metrics_t* m)
 {
-  if (enb != nullptr) {
-    if (!metrics_queue.empty()) {
-      *m = metrics_queue.front();
-      metrics_queue.pop();
-      return true;
-    }
-  }
+  // the metrics are not buffered, they are pushed to the registered SMs as they are reported
   return false;
 }
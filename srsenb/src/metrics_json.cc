@@ -95,13 +95,58 @@ DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
 DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
 DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
 
+/// Memory pool container metrics.
+DECLARE_METRIC("pool_name", metric_pool_name, std::string, "");
+DECLARE_METRIC("block_size", metric_pool_block_size, uint64_t, "bytes");
+DECLARE_METRIC("nof_blocks", metric_pool_nof_blocks, uint64_t, "");
+DECLARE_METRIC("nof_used", metric_pool_nof_used, uint64_t, "");
+DECLARE_METRIC("high_water_mark", metric_pool_high_water_mark, uint64_t, "");
+DECLARE_METRIC("nof_allocs", metric_pool_nof_allocs, uint64_t, "");
+DECLARE_METRIC("nof_failures", metric_pool_nof_failures, uint64_t, "");
+DECLARE_METRIC("alloc_latency_avg", metric_pool_latency_avg, float, "us");
+DECLARE_METRIC("alloc_latency_max", metric_pool_latency_max, float, "us");
+DECLARE_METRIC("fragmentation", metric_pool_fragmentation, float, "");
+DECLARE_METRIC_SET("pool_container",
+                   mset_pool_container,
+                   metric_pool_name,
+                   metric_pool_block_size,
+                   metric_pool_nof_blocks,
+                   metric_pool_nof_used,
+                   metric_pool_high_water_mark,
+                   metric_pool_nof_allocs,
+                   metric_pool_nof_failures,
+                   metric_pool_latency_avg,
+                   metric_pool_latency_max,
+                   metric_pool_fragmentation);
+
+/// Processing stage container metrics.
+DECLARE_METRIC("stage_name", metric_stage_name, std::string, "");
+DECLARE_METRIC("count", metric_stage_count, uint64_t, "");
+DECLARE_METRIC("avg", metric_stage_avg, float, "us");
+DECLARE_METRIC("p50", metric_stage_p50, float, "us");
+DECLARE_METRIC("p99", metric_stage_p99, float, "us");
+DECLARE_METRIC("p99_9", metric_stage_p999, float, "us");
+DECLARE_METRIC("max", metric_stage_max, float, "us");
+DECLARE_METRIC_SET("stage_container",
+                   mset_stage_container,
+                   metric_stage_name,
+                   metric_stage_count,
+                   metric_stage_avg,
+                   metric_stage_p50,
+                   metric_stage_p99,
+                   metric_stage_p999,
+                   metric_stage_max);
+
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
 DECLARE_METRIC_LIST("cell_list", mlist_cell, std::vector<mset_cell_container>);
+DECLARE_METRIC_LIST("pool_list", mlist_pool, std::vector<mset_pool_container>);
+DECLARE_METRIC_LIST("stage_list", mlist_stage, std::vector<mset_stage_container>);
 
 /// Metrics context.
-using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell>;
+using metric_context_t =
+    srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell, mlist_pool, mlist_stage>;
 
 } // namespace
 
@@ -238,6 +283,37 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     }
   }
 
+  // For each memory pool...
+  auto& pool_list = ctx.get<mlist_pool>();
+  for (const srsran::pool_metrics_t& pm : m.pools) {
+    pool_list.emplace_back();
+    auto& pool = pool_list.back();
+    pool.write<metric_pool_name>(pm.name);
+    pool.write<metric_pool_block_size>(pm.block_size);
+    pool.write<metric_pool_nof_blocks>(pm.nof_blocks);
+    pool.write<metric_pool_nof_used>(pm.nof_used);
+    pool.write<metric_pool_high_water_mark>(pm.high_water_mark);
+    pool.write<metric_pool_nof_allocs>(pm.nof_allocs);
+    pool.write<metric_pool_nof_failures>(pm.nof_failures);
+    pool.write<metric_pool_latency_avg>(pm.alloc_latency_avg_us);
+    pool.write<metric_pool_latency_max>(pm.alloc_latency_max_us);
+    pool.write<metric_pool_fragmentation>(pm.fragmentation);
+  }
+
+  // For each TTI processing stage...
+  auto& stage_list = ctx.get<mlist_stage>();
+  for (const srsran::tprof_histogram_metrics_t& sm : m.stages) {
+    stage_list.emplace_back();
+    auto& stage = stage_list.back();
+    stage.write<metric_stage_name>(sm.name);
+    stage.write<metric_stage_count>(sm.count);
+    stage.write<metric_stage_avg>(sm.avg_us);
+    stage.write<metric_stage_p50>(sm.p50_us);
+    stage.write<metric_stage_p99>(sm.p99_us);
+    stage.write<metric_stage_p999>(sm.p999_us);
+    stage.write<metric_stage_max>(sm.max_us);
+  }
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
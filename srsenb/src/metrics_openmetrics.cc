@@ -0,0 +1,494 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/metrics_openmetrics.h"
+#include <chrono>
+#include <cmath>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+
+using namespace srsenb;
+
+constexpr uint32_t metrics_openmetrics::udp_magic;
+constexpr uint8_t  metrics_openmetrics::udp_version;
+
+namespace {
+
+/// Size of the datagrams of the UDP push, below the usual Ethernet MTU
+const size_t max_datagram_size = 1400;
+/// Size of the datagram header: magic, version, flags, nof_records, seq and timestamp
+const size_t datagram_header_size = 4 + 1 + 1 + 2 + 4 + 8;
+
+/// Index of each family in the snapshot, in the order they are exposed
+enum family_idx {
+  cell_nof_rach,
+  ue_dl_cqi,
+  ue_dl_mcs,
+  ue_dl_bitrate,
+  ue_dl_bler,
+  ue_ul_snr,
+  ue_ul_mcs,
+  ue_ul_bitrate,
+  ue_ul_bler,
+  ue_ul_phr,
+  ue_ul_bsr,
+  bearer_dl_total_bytes,
+  bearer_ul_total_bytes,
+  bearer_dl_buffered_bytes,
+  bearer_ul_buffered_bytes,
+  pool_nof_used,
+  pool_high_water_mark,
+  pool_nof_failures,
+  stage_count,
+  stage_p50,
+  stage_p99,
+  stage_max,
+  thread_cycles,
+  thread_instructions,
+  thread_llc_misses,
+  thread_context_switches,
+  rf_tx_lead_p50,
+  rf_tx_lead_p99,
+  rf_nof_tx_late,
+  rf_rx_latency_p99,
+  rf_rx_latency_max,
+  rf_rx_backlog_p50,
+  rf_rx_backlog_max,
+  nof_families
+};
+
+const char* family_names[nof_families][2] = {
+    {"srsenb_cell_nof_rach", "Number of RACH attempts in the period"},
+    {"srsenb_ue_dl_cqi", "DL CQI reported by the UE"},
+    {"srsenb_ue_dl_mcs", "Average DL MCS"},
+    {"srsenb_ue_dl_bitrate", "DL bitrate in bit/s"},
+    {"srsenb_ue_dl_bler", "DL BLER in percent"},
+    {"srsenb_ue_ul_snr", "PUSCH SINR in dB"},
+    {"srsenb_ue_ul_mcs", "Average UL MCS"},
+    {"srsenb_ue_ul_bitrate", "UL bitrate in bit/s"},
+    {"srsenb_ue_ul_bler", "UL BLER in percent"},
+    {"srsenb_ue_ul_phr", "Power headroom reported by the UE in dB"},
+    {"srsenb_ue_ul_bsr", "UL buffer reported by the UE in bytes"},
+    {"srsenb_bearer_dl_total_bytes", "DL bytes acknowledged by the UE"},
+    {"srsenb_bearer_ul_total_bytes", "UL bytes received from the UE"},
+    {"srsenb_bearer_dl_buffered_bytes", "DL bytes buffered in PDCP"},
+    {"srsenb_bearer_ul_buffered_bytes", "UL bytes buffered in RLC"},
+    {"srsenb_pool_nof_used", "Blocks in use in the memory pool"},
+    {"srsenb_pool_high_water_mark", "Maximum number of blocks in use in the memory pool"},
+    {"srsenb_pool_nof_failures", "Failed allocations of the memory pool in the period"},
+    {"srsenb_stage_count", "Number of runs of the TTI processing stage in the period"},
+    {"srsenb_stage_p50_us", "Median processing time of the TTI stage in us"},
+    {"srsenb_stage_p99_us", "99th percentile of the processing time of the TTI stage in us"},
+    {"srsenb_stage_max_us", "Maximum processing time of the TTI stage in us"},
+    {"srsenb_thread_cycles", "CPU cycles of the thread in the period"},
+    {"srsenb_thread_instructions", "Instructions retired by the thread in the period"},
+    {"srsenb_thread_llc_misses", "Last level cache misses of the thread in the period"},
+    {"srsenb_thread_context_switches", "Context switches of the thread in the period"},
+    {"srsenb_rf_tx_lead_p50_us", "Median time from the TX call to the transmission of its samples in us"},
+    {"srsenb_rf_tx_lead_p99_us", "99th percentile of the time from the TX call to the transmission in us"},
+    {"srsenb_rf_nof_tx_late", "TX calls whose timestamp had already passed in the period"},
+    {"srsenb_rf_rx_latency_p99_us", "99th percentile of the duration of the RX calls in us"},
+    {"srsenb_rf_rx_latency_max_us", "Maximum duration of the RX calls in us"},
+    {"srsenb_rf_rx_backlog_p50_us", "Median of the samples queued in the RF driver, in us"},
+    {"srsenb_rf_rx_backlog_max_us", "Maximum of the samples queued in the RF driver, in us"}};
+
+/// Appends the value in the exposition format, integers are written without exponent
+void append_value(std::string& out, double value)
+{
+  char buf[32];
+  if (value == std::floor(value) and std::fabs(value) < 1e15) {
+    snprintf(buf, sizeof(buf), "%.0f", value);
+  } else {
+    snprintf(buf, sizeof(buf), "%.6g", value);
+  }
+  out += buf;
+}
+
+template <typename T>
+void append_raw(std::vector<uint8_t>& out, T value)
+{
+  const uint8_t* ptr = reinterpret_cast<const uint8_t*>(&value);
+  out.insert(out.end(), ptr, ptr + sizeof(T));
+}
+
+uint64_t get_time_stamp_ms()
+{
+  auto tp = std::chrono::system_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(tp).count();
+}
+
+} // namespace
+
+metrics_openmetrics::metrics_openmetrics(const metrics_openmetrics_args_t& args_) :
+  thread("METRICS_HTTP"), args(args_), logger(srslog::fetch_basic_logger("METRICS"))
+{}
+
+metrics_openmetrics::~metrics_openmetrics()
+{
+  stop();
+}
+
+bool metrics_openmetrics::init()
+{
+  if (args.http_port != 0) {
+    if (not http_socket.open_socket(srsran::net_utils::addr_family::ipv4,
+                                    srsran::net_utils::socket_type::stream,
+                                    srsran::net_utils::protocol_type::TCP) or
+        not http_socket.reuse_addr() or not http_socket.bind_addr(args.http_bind_addr.c_str(), args.http_port) or
+        not http_socket.start_listen()) {
+      logger.error("Couldn't listen for metrics scrapes on %s:%d", args.http_bind_addr.c_str(), args.http_port);
+      http_socket.close();
+      return false;
+    }
+    running = true;
+    thread::start();
+  }
+
+  if (not args.udp_addr.empty()) {
+    if (not udp_socket.open_socket(srsran::net_utils::addr_family::ipv4,
+                                   srsran::net_utils::socket_type::datagram,
+                                   srsran::net_utils::protocol_type::UDP) or
+        not srsran::net_utils::set_sockaddr(&udp_dest, args.udp_addr.c_str(), args.udp_port)) {
+      logger.error("Couldn't open the metrics UDP push to %s:%d", args.udp_addr.c_str(), args.udp_port);
+      udp_socket.close();
+      return false;
+    }
+  }
+  return true;
+}
+
+void metrics_openmetrics::stop()
+{
+  if (running.exchange(false)) {
+    wait_thread_finish();
+  }
+  if (http_socket.is_open()) {
+    http_socket.close();
+  }
+  if (udp_socket.is_open()) {
+    udp_socket.close();
+  }
+}
+
+void metrics_openmetrics::set_metrics(const enb_metrics_t& m, const uint32_t period_usec)
+{
+  std::shared_ptr<const snapshot_t> new_snapshot = std::make_shared<const snapshot_t>(make_snapshot(m));
+  {
+    // The exposition is rendered on the first scrape of the snapshot
+    std::lock_guard<std::mutex> lock(snapshot_mutex);
+    snapshot = new_snapshot;
+    exposition.reset();
+  }
+
+  if (udp_socket.is_open()) {
+    push_deltas(*new_snapshot);
+  }
+}
+
+metrics_openmetrics::snapshot_t metrics_openmetrics::make_snapshot(const enb_metrics_t& m)
+{
+  snapshot_t s(nof_families);
+  for (uint32_t i = 0; i != nof_families; ++i) {
+    s[i].name = family_names[i][0];
+    s[i].help = family_names[i][1];
+  }
+  auto add = [&s](family_idx idx, const std::string& labels, double value) {
+    if (not std::isnan(value)) {
+      s[idx].samples.push_back({std::string(s[idx].name) + "{" + labels + "}", value});
+    }
+  };
+
+  for (uint32_t cc = 0; cc != m.stack.mac.cc_info.size(); ++cc) {
+    add(cell_nof_rach, "cc=\"" + std::to_string(cc) + "\"", m.stack.mac.cc_info[cc].cc_rach_counter);
+  }
+
+  for (uint32_t i = 0; i != m.stack.rrc.ues.size(); ++i) {
+    if (i >= m.phy.size() or i >= m.stack.mac.ues.size() or i >= m.stack.rlc.ues.size() or
+        i >= m.stack.pdcp.ues.size()) {
+      continue;
+    }
+    const mac_ue_metrics_t& mac = m.stack.mac.ues[i];
+    std::string labels = "cc=\"" + std::to_string(mac.cc_idx) + "\",rnti=\"" + std::to_string(mac.rnti) + "\"";
+
+    add(ue_dl_cqi, labels, mac.dl_cqi);
+    add(ue_dl_mcs, labels, m.phy[i].dl.mcs);
+    if (mac.nof_tti > 0) {
+      add(ue_dl_bitrate, labels, mac.tx_brate / (mac.nof_tti * 0.001));
+      add(ue_ul_bitrate, labels, mac.rx_brate / (mac.nof_tti * 0.001));
+    }
+    if (mac.tx_pkts > 0) {
+      add(ue_dl_bler, labels, 100.0 * mac.tx_errors / mac.tx_pkts);
+    }
+    if (mac.rx_pkts > 0) {
+      add(ue_ul_bler, labels, 100.0 * mac.rx_errors / mac.rx_pkts);
+    }
+    add(ue_ul_snr, labels, m.phy[i].ul.pusch_sinr);
+    add(ue_ul_mcs, labels, m.phy[i].ul.mcs);
+    add(ue_ul_phr, labels, mac.phr);
+    add(ue_ul_bsr, labels, mac.ul_buffer);
+
+    for (const auto& drb : m.stack.rrc.ues[i].drb_qci_map) {
+      if (drb.first >= SRSRAN_N_RADIO_BEARERS) {
+        continue;
+      }
+      std::string bearer_labels = labels + ",bearer_id=\"" + std::to_string(drb.first) + "\",qci=\"" +
+                                  std::to_string(drb.second) + "\"";
+      const auto& rlc_bearer    = m.stack.rlc.ues[i].bearer[drb.first];
+      const auto& pdcp_bearer   = m.stack.pdcp.ues[i].bearer[drb.first];
+      add(bearer_dl_total_bytes, bearer_labels, pdcp_bearer.num_tx_acked_bytes);
+      add(bearer_ul_total_bytes, bearer_labels, pdcp_bearer.num_rx_pdu_bytes);
+      add(bearer_dl_buffered_bytes, bearer_labels, pdcp_bearer.num_tx_buffered_pdus_bytes);
+      add(bearer_ul_buffered_bytes, bearer_labels, rlc_bearer.rx_buffered_bytes);
+    }
+  }
+
+  for (const srsran::pool_metrics_t& pm : m.pools) {
+    std::string labels = "pool=\"" + pm.name + "\"";
+    add(pool_nof_used, labels, pm.nof_used);
+    add(pool_high_water_mark, labels, pm.high_water_mark);
+    add(pool_nof_failures, labels, pm.nof_failures);
+  }
+
+  for (const srsran::tprof_histogram_metrics_t& sm : m.stages) {
+    std::string labels = "stage=\"" + sm.name + "\"";
+    add(stage_count, labels, sm.count);
+    add(stage_p50, labels, sm.p50_us);
+    add(stage_p99, labels, sm.p99_us);
+    add(stage_max, labels, sm.max_us);
+  }
+
+  for (uint32_t dev = 0; dev != m.rf.dev.size(); ++dev) {
+    const srsran::rf_dev_timing_metrics_t& rm     = m.rf.dev[dev];
+    std::string                            labels = "dev=\"" + std::to_string(dev) + "\"";
+    add(rf_tx_lead_p50, labels, rm.tx_lead.p50_us);
+    add(rf_tx_lead_p99, labels, rm.tx_lead.p99_us);
+    add(rf_nof_tx_late, labels, rm.nof_tx_late);
+    add(rf_rx_latency_p99, labels, rm.rx_latency.p99_us);
+    add(rf_rx_latency_max, labels, rm.rx_latency.max_us);
+    add(rf_rx_backlog_p50, labels, rm.rx_backlog.p50_us);
+    add(rf_rx_backlog_max, labels, rm.rx_backlog.max_us);
+  }
+
+  for (const srsran::sys_thread_metrics_t& tm : m.sys.threads) {
+    std::string labels = "thread=\"" + tm.name + "\",tid=\"" + std::to_string(tm.tid) + "\"";
+    add(thread_cycles, labels, tm.cycles);
+    add(thread_instructions, labels, tm.instructions);
+    add(thread_llc_misses, labels, tm.llc_misses);
+    add(thread_context_switches, labels, tm.context_switches);
+  }
+  return s;
+}
+
+std::string metrics_openmetrics::render(const snapshot_t&                       snapshot,
+                                        std::unordered_map<std::string, double>* last_values)
+{
+  std::unordered_map<std::string, double> values;
+  std::string                             out;
+  for (const family_t& family : snapshot) {
+    bool header_written = false;
+    for (const sample_t& sample : family.samples) {
+      if (last_values != nullptr) {
+        values.emplace(sample.key, sample.value);
+        auto it = last_values->find(sample.key);
+        if (it != last_values->end() and it->second == sample.value) {
+          continue;
+        }
+      }
+      if (not header_written) {
+        out += "# HELP ";
+        out += family.name;
+        out += ' ';
+        out += family.help;
+        out += "\n# TYPE ";
+        out += family.name;
+        out += " gauge\n";
+        header_written = true;
+      }
+      out += sample.key;
+      out += ' ';
+      append_value(out, sample.value);
+      out += '\n';
+    }
+  }
+  if (last_values != nullptr) {
+    *last_values = std::move(values);
+  }
+  return out;
+}
+
+std::string metrics_openmetrics::get_exposition(bool delta)
+{
+  std::lock_guard<std::mutex> lock(snapshot_mutex);
+  if (snapshot == nullptr) {
+    return {};
+  }
+  if (delta) {
+    return render(*snapshot, &last_scraped);
+  }
+  if (exposition == nullptr) {
+    exposition = std::make_shared<const std::string>(render(*snapshot, nullptr));
+  }
+  return *exposition;
+}
+
+void metrics_openmetrics::push_deltas(const snapshot_t& s)
+{
+  bool     keyframe    = args.keyframe_period <= 1 or push_seq % args.keyframe_period == 0;
+  uint64_t timestamp   = get_time_stamp_ms();
+  uint16_t nof_records = 0;
+
+  std::vector<uint8_t> dgram;
+  dgram.reserve(max_datagram_size);
+  auto start_datagram = [&]() {
+    dgram.clear();
+    append_raw(dgram, udp_magic);
+    append_raw(dgram, udp_version);
+    append_raw(dgram, uint8_t(keyframe ? 1 : 0));
+    append_raw(dgram, uint16_t(0));
+    append_raw(dgram, push_seq);
+    append_raw(dgram, timestamp);
+    nof_records = 0;
+  };
+  auto send_datagram = [&]() {
+    memcpy(&dgram[6], &nof_records, sizeof(nof_records));
+    if (sendto(udp_socket.fd(), dgram.data(), dgram.size(), 0, (const sockaddr*)&udp_dest, sizeof(udp_dest)) < 0) {
+      logger.warning("Couldn't push the metrics: %s", strerror(errno));
+    }
+  };
+  auto reserve = [&](size_t len) {
+    if (dgram.size() + len > max_datagram_size) {
+      send_datagram();
+      start_datagram();
+    }
+    nof_records++;
+  };
+  auto add_definition = [&](uint32_t id, const std::string& key) {
+    uint16_t len = std::min<size_t>(key.size(), max_datagram_size - datagram_header_size - 7);
+    reserve(1 + 4 + 2 + len);
+    append_raw(dgram, uint8_t(record_type::definition));
+    append_raw(dgram, id);
+    append_raw(dgram, len);
+    dgram.insert(dgram.end(), key.begin(), key.begin() + len);
+  };
+  auto add_value = [&](uint32_t id, double value) {
+    reserve(1 + 4 + 8);
+    append_raw(dgram, uint8_t(record_type::value));
+    append_raw(dgram, id);
+    append_raw(dgram, value);
+  };
+
+  start_datagram();
+  for (auto& series : pushed_series) {
+    series.second.seen = false;
+  }
+  for (const family_t& family : s) {
+    for (const sample_t& sample : family.samples) {
+      auto it = pushed_series.find(sample.key);
+      if (it == pushed_series.end()) {
+        it = pushed_series.emplace(sample.key, series_state_t{next_series_id++, sample.value, true}).first;
+        add_definition(it->second.id, sample.key);
+        add_value(it->second.id, sample.value);
+        continue;
+      }
+      it->second.seen = true;
+      if (keyframe) {
+        add_definition(it->second.id, sample.key);
+        add_value(it->second.id, sample.value);
+      } else if (it->second.value != sample.value) {
+        add_value(it->second.id, sample.value);
+      }
+      it->second.value = sample.value;
+    }
+  }
+
+  // Series that disappeared, e.g. of released UEs
+  for (auto it = pushed_series.begin(); it != pushed_series.end();) {
+    if (it->second.seen) {
+      ++it;
+      continue;
+    }
+    reserve(1 + 4);
+    append_raw(dgram, uint8_t(record_type::removal));
+    append_raw(dgram, it->second.id);
+    it = pushed_series.erase(it);
+  }
+
+  send_datagram();
+  push_seq++;
+}
+
+void metrics_openmetrics::run_thread()
+{
+  while (running) {
+    pollfd pfd = {http_socket.fd(), POLLIN, 0};
+    if (poll(&pfd, 1, 100) <= 0 or (pfd.revents & POLLIN) == 0) {
+      continue;
+    }
+    int fd = accept(http_socket.fd(), nullptr, nullptr);
+    if (fd < 0) {
+      continue;
+    }
+    serve_client(fd);
+    ::close(fd);
+  }
+}
+
+void metrics_openmetrics::serve_client(int fd)
+{
+  // Scrapers send small requests, only the request line is parsed
+  timeval timeout = {1, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  char    request[2048];
+  ssize_t len = 0;
+  while (len < (ssize_t)sizeof(request) - 1) {
+    ssize_t n = recv(fd, request + len, sizeof(request) - 1 - len, 0);
+    if (n <= 0) {
+      break;
+    }
+    len += n;
+    request[len] = '\0';
+    if (strstr(request, "\r\n\r\n") != nullptr) {
+      break;
+    }
+  }
+  request[std::max<ssize_t>(len, 0)] = '\0';
+
+  std::string status = "200 OK";
+  std::string body;
+  if (strncmp(request, "GET /metrics/delta ", strlen("GET /metrics/delta ")) == 0) {
+    body = get_exposition(true);
+  } else if (strncmp(request, "GET /metrics ", strlen("GET /metrics ")) == 0) {
+    body = get_exposition(false);
+  } else {
+    status = "404 Not Found";
+  }
+
+  std::string response = "HTTP/1.1 " + status + "\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+                         std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+  for (size_t sent = 0; sent < response.size();) {
+    ssize_t n = send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+    if (n <= 0) {
+      break;
+    }
+    sent += n;
+  }
+}
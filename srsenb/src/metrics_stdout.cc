@@ -188,6 +188,14 @@ void metrics_stdout::set_metrics(const enb_metrics_t& metrics, const uint32_t pe
     fmt::print("RF status: O={}, U={}, L={}\n", metrics.rf.rf_o, metrics.rf.rf_u, metrics.rf.rf_l);
   }
 
+  if (metrics.phy_timing.nof_late > 0) {
+    fmt::print("PHY timing: late={}/{}, shed={}, min_slack={:.0f} us\n",
+               metrics.phy_timing.nof_late,
+               metrics.phy_timing.nof_tti,
+               metrics.phy_timing.nof_shed_tti,
+               metrics.phy_timing.min_slack_us);
+  }
+
   if (metrics.stack.rrc.ues.size() == 0 && metrics.nr_stack.mac.ues.size() == 0) {
     return;
   }
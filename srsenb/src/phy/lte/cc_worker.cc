@@ -22,6 +22,8 @@
 #include <iomanip>
 
 #include "srsran/common/threads.h"
+#include "srsran/common/time_prof.h"
+#include "srsran/srslog/event_trace.h"
 #include "srsran/srsran.h"
 
 #include "srsenb/hdr/phy/lte/cc_worker.h"
@@ -66,14 +68,13 @@ cc_worker::~cc_worker()
   srsran_softbuffer_tx_free(&temp_mbsfn_softbuffer);
   srsran_enb_dl_free(&enb_dl);
   srsran_enb_ul_free(&enb_ul);
+  for (srsran_enb_ul_t& decoder : pusch_decoders) {
+    srsran_enb_ul_free(&decoder);
+  }
 
   for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
-    if (signal_buffer_rx[p]) {
-      free(signal_buffer_rx[p]);
-    }
-    if (signal_buffer_tx[p]) {
-      free(signal_buffer_tx[p]);
-    }
+    srsran_huge_free(signal_buffer_rx[p]);
+    srsran_huge_free(signal_buffer_tx[p]);
   }
 
   // Delete all users
@@ -97,13 +98,13 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
 
   // Init cell here
   for (uint32_t p = 0; p < phy->get_nof_ports(cc_idx); p++) {
-    signal_buffer_rx[p] = srsran_vec_cf_malloc(2 * sf_len);
+    signal_buffer_rx[p] = (cf_t*)srsran_huge_malloc(sizeof(cf_t) * 2 * sf_len);
     if (!signal_buffer_rx[p]) {
       ERROR("Error allocating memory");
       return;
     }
     srsran_vec_cf_zero(signal_buffer_rx[p], 2 * sf_len);
-    signal_buffer_tx[p] = srsran_vec_cf_malloc(2 * sf_len);
+    signal_buffer_tx[p] = (cf_t*)srsran_huge_malloc(sizeof(cf_t) * 2 * sf_len);
     if (!signal_buffer_tx[p]) {
       ERROR("Error allocating memory");
       return;
@@ -132,6 +133,22 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     return;
   }
 
+  // One decoder per thread of the PUSCH decoder pool, the calling thread uses enb_ul
+  if (phy->pusch_decoder_pool != nullptr) {
+    pusch_decoders.resize(phy->pusch_decoder_pool->nof_workers());
+    for (srsran_enb_ul_t& decoder : pusch_decoders) {
+      if (srsran_enb_ul_init(&decoder, signal_buffer_rx[0], nof_prb)) {
+        ERROR("Error initiating PUSCH decoder");
+        return;
+      }
+      if (srsran_enb_ul_set_cell(&decoder, cell, &phy->dmrs_pusch_cfg, nullptr)) {
+        ERROR("Error initiating PUSCH decoder");
+        return;
+      }
+    }
+  }
+  pusch_jobs.resize(stack_interface_phy_lte::MAX_GRANTS);
+
   /* Setup SI-RNTI in PHY */
   add_rnti(SRSRAN_SIRNTI);
 
@@ -155,6 +172,10 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
   if (phy->params.pusch_8bit_decoder) {
     enb_ul.pusch.llr_is_8bit        = true;
     enb_ul.pusch.ul_sch.llr_is_8bit = true;
+    for (srsran_enb_ul_t& decoder : pusch_decoders) {
+      decoder.pusch.llr_is_8bit        = true;
+      decoder.pusch.ul_sch.llr_is_8bit = true;
+    }
   }
   initiated = true;
 
@@ -214,25 +235,45 @@ uint32_t cc_worker::get_nof_rnti()
 
 void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy_lte::ul_sched_t& ul_grants)
 {
+  trace_hot_scope_arg("phy", "cc_worker_ul", ul_sf_cfg.tti);
   std::lock_guard<std::mutex> lock(mutex);
   ul_sf = ul_sf_cfg;
   logger.set_context(ul_sf.tti);
 
   // Process UL signal
-  srsran_enb_ul_fft(&enb_ul);
+  {
+    srsran::scoped_stage_prof prof(srsran::tti_stage::ofdm);
+    srsran_enb_ul_fft(&enb_ul);
+  }
 
   // Decode pending UL grants for the tti they were scheduled
   decode_pusch(ul_grants.pusch, ul_grants.nof_grants);
 
   // Decode remaining PUCCH ACKs not associated with PUSCH transmission and SR signals
   decode_pucch();
+
+  report_ul_feedback();
+}
+
+void cc_worker::report_ul_feedback()
+{
+  // All the feedback of the TTI is given in a single call, before the PUSCH PDUs as required by the MAC
+  if (not ul_feedback.empty()) {
+    phy->stack->ul_feedback_info(tti_rx, ul_feedback);
+    ul_feedback.clear();
+  }
+  for (const pusch_pdu_t& pdu : pusch_pdus) {
+    phy->stack->push_pdu(tti_rx, pdu.rnti, cc_idx, pdu.nof_bytes, pdu.crc, pdu.nof_prb);
+  }
+  pusch_pdus.clear();
 }
 
 void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                         stack_interface_phy_lte::dl_sched_t& dl_grants,
                         stack_interface_phy_lte::ul_sched_t& ul_grants,
-                        srsran_mbsfn_cfg_t*                  mbsfn_cfg)
+                        const pmch_tx_t*                     pmch)
 {
+  trace_hot_scope_arg("phy", "cc_worker_dl", dl_sf_cfg.tti);
   std::lock_guard<std::mutex> lock(mutex);
   dl_sf = dl_sf_cfg;
 
@@ -243,10 +284,8 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
   if (dl_sf_cfg.sf_type == SRSRAN_SF_NORM) {
     encode_pdcch_dl(dl_grants.pdsch, dl_grants.nof_grants);
     encode_pdsch(dl_grants.pdsch, dl_grants.nof_grants);
-  } else {
-    if (mbsfn_cfg->enable) {
-      encode_pmch(dl_grants.pdsch, mbsfn_cfg);
-    }
+  } else if (pmch != nullptr) {
+    put_pmch(*pmch);
   }
 
   // Put UL grants to resource grid.
@@ -256,7 +295,10 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
   encode_phich(ul_grants.phich, ul_grants.nof_phich);
 
   // Generate signal and transmit
-  srsran_enb_dl_gen_signal(&enb_dl);
+  {
+    srsran::scoped_stage_prof prof(srsran::tti_stage::ofdm);
+    srsran_enb_dl_gen_signal(&enb_dl);
+  }
 
   // Scale if cell gain is set
   float cell_gain_db = phy->get_cell_gain(cc_idx);
@@ -283,11 +325,11 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
   }
 }
 
-bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
-                                  srsran_ul_cfg_t&                           ul_cfg,
-                                  srsran_pusch_res_t&                        pusch_res)
+bool cc_worker::setup_pusch_rnti(pusch_job_t& job)
 {
-  uint16_t rnti = ul_grant.dci.rnti;
+  stack_interface_phy_lte::ul_sched_grant_t& ul_grant = *job.ul_grant;
+  srsran_ul_cfg_t&                           ul_cfg   = job.ul_cfg;
+  uint16_t                                   rnti     = ul_grant.dci.rnti;
 
   // Invalid RNTI
   if (rnti == SRSRAN_INVALID_RNTI) {
@@ -306,8 +348,17 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
     return false;
   }
 
+  ul_cfg.pusch.max_nof_iterations = tunables.pusch_max_its;
+  ul_cfg.pusch.use_cedron_alg     = tunables.use_cedron_alg;
+  ul_cfg.pucch.use_cedron_alg     = tunables.use_cedron_alg;
+
+  // Limit the turbo decoder iterations while recovering from a late TTI
+  if (shed_load) {
+    ul_cfg.pusch.max_nof_iterations = SRSRAN_MIN(ul_cfg.pusch.max_nof_iterations, phy->params.late_pusch_max_its);
+  }
+
   // Fill UCI configuration
-  bool uci_required =
+  job.uci_required =
       phy->ue_db.fill_uci_cfg(tti_rx, cc_idx, rnti, ul_grant.dci.cqi_request, true, ul_cfg.pusch.uci_cfg);
 
   // Compute UL grant
@@ -338,84 +389,160 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
     Error("Error setting last UL TB for RNTI %x, CC %d, PID %d", rnti, cc_idx, ul_grant.pid);
   }
 
-  // Run PUSCH decoder
   ul_cfg.pusch.softbuffers.rx = ul_grant.softbuffer_rx;
-  pusch_res.data              = ul_grant.data;
-  if (pusch_res.data) {
-    if (srsran_enb_ul_get_pusch(&enb_ul, &ul_sf, &ul_cfg.pusch, &pusch_res)) {
-      Error("Decoding PUSCH for RNTI %x", rnti);
-      return false;
+  job.pusch_res.data          = ul_grant.data;
+  return true;
+}
+
+void cc_worker::decode_pusch_rnti(srsran_enb_ul_t* decoder, pusch_job_t& job)
+{
+  // Run PUSCH decoder, it only reads the resource grid and the state of the grant
+  job.decoded = true;
+  if (job.pusch_res.data) {
+    srsran_ul_sf_cfg_t sf = ul_sf;
+    {
+      srsran::scoped_stage_prof prof(srsran::tti_stage::chest);
+      srsran_chest_ul_estimate_pusch(&decoder->chest, &sf, &job.ul_cfg.pusch, enb_ul.sf_symbols, &decoder->chest_res);
+    }
+    srsran::tprof_measure meas;
+    meas.start();
+    if (srsran_pusch_decode(
+            &decoder->pusch, &sf, &job.ul_cfg.pusch, &decoder->chest_res, enb_ul.sf_symbols, &job.pusch_res)) {
+      Error("Decoding PUSCH for RNTI %x", job.ul_grant->dci.rnti);
+      job.decoded = false;
+    }
+    srsran::get_stage_histogram(srsran::tti_stage::pusch)(meas.stop());
+    uint64_t fec_ns = srsran_sch_last_decode_time_ns(&decoder->pusch.ul_sch);
+    if (fec_ns > 0) {
+      srsran::get_stage_histogram(srsran::tti_stage::fec)(std::chrono::nanoseconds(fec_ns));
     }
   }
+  job.chest_res = decoder->chest_res;
+}
+
+void cc_worker::report_pusch_rnti(pusch_job_t& job)
+{
+  stack_interface_phy_lte::ul_sched_grant_t& ul_grant  = *job.ul_grant;
+  srsran_ul_cfg_t&                           ul_cfg    = job.ul_cfg;
+  srsran_pusch_res_t&                        pusch_res = job.pusch_res;
+  uint16_t                                   rnti      = ul_grant.dci.rnti;
+
   // Save PHICH scheduling for this user. Each user can have just 1 PUSCH dci per TTI
-  ue_db[rnti]->phich_grant.n_prb_lowest = grant.n_prb_tilde[0];
+  ue_db[rnti]->phich_grant.n_prb_lowest = ul_cfg.pusch.grant.n_prb_tilde[0];
   ue_db[rnti]->phich_grant.n_dmrs       = ul_grant.dci.n_dmrs;
 
-  float snr_db = enb_ul.chest_res.snr_db;
+  float snr_db = job.chest_res.snr_db;
 
   // Notify MAC of RL status
   if (snr_db >= PUSCH_RL_SNR_DB_TH) {
     // Notify MAC UL channel quality
-    phy->stack->snr_info(ul_sf.tti, rnti, cc_idx, snr_db, mac_interface_phy_lte::PUSCH);
+    ul_feedback.push_back(
+        {stack_interface_phy_lte::ul_feedback_t::ul_snr, rnti, cc_idx, mac_interface_phy_lte::PUSCH, 0, snr_db, 0});
 
     // Notify MAC of Time Alignment only if it enabled and valid measurement, ignore value otherwise
-    if (ul_cfg.pusch.meas_ta_en and not std::isnan(enb_ul.chest_res.ta_us) and not std::isinf(enb_ul.chest_res.ta_us)) {
-      phy->stack->ta_info(ul_sf.tti, rnti, enb_ul.chest_res.ta_us);
+    if (ul_cfg.pusch.meas_ta_en and not std::isnan(job.chest_res.ta_us) and not std::isinf(job.chest_res.ta_us)) {
+      ul_feedback.push_back({stack_interface_phy_lte::ul_feedback_t::ta, rnti, cc_idx, 0, 0, job.chest_res.ta_us, 0});
     }
   }
 
   // Send UCI data to MAC
-  if (uci_required) {
-    phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pusch.uci_cfg, pusch_res.uci);
+  if (job.uci_required) {
+    phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pusch.uci_cfg, pusch_res.uci, ul_feedback);
   }
 
   // Save statistics only if data was provided
   if (ul_grant.data != nullptr) {
     // Save metrics stats
     ue_db[rnti]->metrics_ul(ul_grant.dci.tb.mcs_idx,
-                            enb_ul.chest_res.epre_dBfs - phy->params.rx_gain_offset,
-                            enb_ul.chest_res.snr_db,
+                            job.chest_res.epre_dBfs - phy->params.rx_gain_offset,
+                            job.chest_res.snr_db,
                             pusch_res.avg_iterations_block);
   }
-  return true;
+
+  // Notify MAC new received data and HARQ Indication value
+  if (ul_grant.data != nullptr) {
+    // Inform MAC about the CRC result
+    uint32_t nof_bytes = ul_cfg.pusch.grant.tb.tbs / 8;
+    ul_feedback.push_back(
+        {stack_interface_phy_lte::ul_feedback_t::ul_crc, rnti, cc_idx, nof_bytes, (uint32_t)pusch_res.crc, 0, 0});
+    // Push PDU buffer
+    pusch_pdus.push_back({rnti, nof_bytes, pusch_res.crc, ul_cfg.pusch.grant.L_prb});
+    // Logging
+    if (logger.info.enabled()) {
+      char str[512];
+      srsran_pusch_rx_info(&ul_cfg.pusch, &pusch_res, &job.chest_res, str, sizeof(str));
+      logger.info("PUSCH: cc=%d, %s", cc_idx, str);
+    }
+  }
+}
+
+void cc_worker::decode_pusch_lane(void* arg, uint32_t lane)
+{
+  auto*            w         = static_cast<cc_worker*>(arg);
+  uint32_t         nof_lanes = (uint32_t)w->pusch_decoders.size() + 1;
+  srsran_enb_ul_t* decoder   = (lane == 0) ? &w->enb_ul : &w->pusch_decoders[lane - 1];
+
+  // Each lane decodes every nof_lanes-th grant with its own channel estimator and PUSCH decoder
+  for (uint32_t i = lane; i < w->nof_pusch_jobs; i += nof_lanes) {
+    w->decode_pusch_rnti(decoder, w->pusch_jobs[i]);
+  }
 }
 
 void cc_worker::decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch)
 {
-  // Iterate over all the grants, all the grants need to report MAC the CRC status
+  nof_pusch = SRSRAN_MIN(nof_pusch, (uint32_t)pusch_jobs.size());
+
+  // Without decoder pool, each grant is decoded and reported before handling the next one
+  if (pusch_decoders.empty()) {
+    for (uint32_t i = 0; i < nof_pusch; i++) {
+      pusch_job_t& job = pusch_jobs[0];
+      job              = {};
+      job.ul_grant     = &grants[i];
+      if (!setup_pusch_rnti(job)) {
+        return;
+      }
+      decode_pusch_rnti(&enb_ul, job);
+      if (!job.decoded) {
+        return;
+      }
+      report_pusch_rnti(job);
+    }
+    return;
+  }
+
+  // Prepare the grants serially, as the UE database is shared with the other workers
+  nof_pusch_jobs = 0;
   for (uint32_t i = 0; i < nof_pusch; i++) {
-    // Get grant itself and RNTI
-    stack_interface_phy_lte::ul_sched_grant_t& ul_grant = grants[i];
-    uint16_t                                   rnti     = ul_grant.dci.rnti;
+    pusch_job_t& job = pusch_jobs[nof_pusch_jobs];
+    job              = {};
+    job.ul_grant     = &grants[i];
+    if (!setup_pusch_rnti(job)) {
+      break;
+    }
+    nof_pusch_jobs++;
+  }
 
-    srsran_pusch_res_t pusch_res = {};
-    srsran_ul_cfg_t    ul_cfg    = {};
+  // Decode the users in parallel, the calling thread takes part in the decoding
+  uint32_t nof_lanes = SRSRAN_MIN(nof_pusch_jobs, (uint32_t)pusch_decoders.size() + 1);
+  if (nof_lanes > 1) {
+    phy->pusch_decoder_pool->parallel_for(nof_lanes, decode_pusch_lane, this);
+  } else if (nof_lanes == 1) {
+    decode_pusch_lane(this, 0);
+  }
 
-    // Decodes PUSCH for the given grant
-    if (!decode_pusch_rnti(ul_grant, ul_cfg, pusch_res)) {
+  // Report the results to the MAC in the order of the grants, all the grants need to report MAC the CRC status
+  for (uint32_t i = 0; i < nof_pusch_jobs; i++) {
+    if (!pusch_jobs[i].decoded) {
       return;
     }
-
-    // Notify MAC new received data and HARQ Indication value
-    if (ul_grant.data != nullptr) {
-      // Inform MAC about the CRC result
-      phy->stack->crc_info(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc);
-      // Push PDU buffer
-      phy->stack->push_pdu(
-          tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc, ul_cfg.pusch.grant.L_prb);
-      // Logging
-      if (logger.info.enabled()) {
-        char str[512];
-        srsran_pusch_rx_info(&ul_cfg.pusch, &pusch_res, &enb_ul.chest_res, str, sizeof(str));
-        logger.info("PUSCH: cc=%d, %s", cc_idx, str);
-      }
-    }
+    report_pusch_rnti(pusch_jobs[i]);
   }
 }
 
 int cc_worker::decode_pucch()
 {
-  srsran_pucch_res_t pucch_res = {};
+  pucch_rnti.clear();
+  pucch_cfg.clear();
 
   for (auto& iter : ue_db) {
     uint16_t rnti = iter.first;
@@ -428,6 +555,7 @@ int cc_worker::decode_pucch()
         Error("Error retrieving last UL configuration for RNTI %x, CC %d", rnti, cc_idx);
         continue;
       }
+      ul_cfg.pucch.use_cedron_alg = tunables.use_cedron_alg;
 
       // Check if user needs to receive PUCCH
       int ret = phy->ue_db.fill_uci_cfg(tti_rx, cc_idx, rnti, false, false, ul_cfg.pucch.uci_cfg);
@@ -438,37 +566,56 @@ int cc_worker::decode_pucch()
 
       // If ret is more than success, UCI is present
       if (ret > SRSRAN_SUCCESS) {
-        // Decode PUCCH
-        if (srsran_enb_ul_get_pucch(&enb_ul, &ul_sf, &ul_cfg.pucch, &pucch_res)) {
-          Error("Error getting PUCCH");
-          continue;
-        }
+        pucch_rnti.push_back(rnti);
+        pucch_cfg.push_back(ul_cfg.pucch);
+      }
+    }
+  }
 
-        // Send UCI data to MAC
-        if (phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pucch.uci_cfg, pucch_res.uci_data) < SRSRAN_SUCCESS) {
-          Error("Error sending UCI data for RNTI %x, CC %d", rnti, cc_idx);
-          continue;
-        }
+  if (pucch_cfg.empty()) {
+    return 0;
+  }
 
-        if (pucch_res.detected and pucch_res.ta_valid) {
-          phy->stack->ta_info(tti_rx, rnti, pucch_res.ta_us);
-          phy->stack->snr_info(tti_rx, rnti, cc_idx, pucch_res.snr_db, mac_interface_phy_lte::PUCCH);
-        }
+  // Decode the PUCCH of all users at once, the resources sharing a PRB are correlated together
+  pucch_res.resize(pucch_cfg.size());
+  if (srsran_enb_ul_get_pucch_batch(&enb_ul, &ul_sf, pucch_cfg.data(), pucch_res.data(), pucch_cfg.size())) {
+    Error("Error getting PUCCH");
+    return 0;
+  }
 
-        // Logging
-        if (logger.info.enabled()) {
-          char str[512];
-          srsran_pucch_rx_info(&ul_cfg.pucch, &pucch_res, str, sizeof(str));
-          logger.info("PUCCH: cc=%d; %s", cc_idx, str);
-        }
+  for (uint32_t i = 0; i < pucch_cfg.size(); i++) {
+    uint16_t rnti = pucch_rnti[i];
 
-        // Save metrics
-        if (pucch_res.detected) {
-          ue_db[rnti]->metrics_ul_pucch(pucch_res.rssi_dbFs - phy->params.rx_gain_offset,
-                                        pucch_res.ni_dbFs - -phy->params.rx_gain_offset,
-                                        pucch_res.snr_db);
-        }
-      }
+    // Send UCI data to MAC
+    if (phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, pucch_cfg[i].uci_cfg, pucch_res[i].uci_data, ul_feedback) <
+        SRSRAN_SUCCESS) {
+      Error("Error sending UCI data for RNTI %x, CC %d", rnti, cc_idx);
+      continue;
+    }
+
+    if (pucch_res[i].detected and pucch_res[i].ta_valid) {
+      ul_feedback.push_back({stack_interface_phy_lte::ul_feedback_t::ta, rnti, cc_idx, 0, 0, pucch_res[i].ta_us, 0});
+      ul_feedback.push_back({stack_interface_phy_lte::ul_feedback_t::ul_snr,
+                             rnti,
+                             cc_idx,
+                             mac_interface_phy_lte::PUCCH,
+                             0,
+                             pucch_res[i].snr_db,
+                             0});
+    }
+
+    // Logging
+    if (logger.info.enabled()) {
+      char str[512];
+      srsran_pucch_rx_info(&pucch_cfg[i], &pucch_res[i], str, sizeof(str));
+      logger.info("PUCCH: cc=%d; %s", cc_idx, str);
+    }
+
+    // Save metrics
+    if (pucch_res[i].detected) {
+      ue_db[rnti]->metrics_ul_pucch(pucch_res[i].rssi_dbFs - phy->params.rx_gain_offset,
+                                    pucch_res[i].ni_dbFs - -phy->params.rx_gain_offset,
+                                    pucch_res[i].snr_db);
     }
   }
   return 0;
@@ -493,6 +640,7 @@ int cc_worker::encode_phich(stack_interface_phy_lte::ul_sched_ack_t* acks, uint3
 
 int cc_worker::encode_pdcch_ul(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_grants)
 {
+  srsran::scoped_stage_prof prof(srsran::tti_stage::pdcch);
   for (uint32_t i = 0; i < nof_grants; i++) {
     if (grants[i].needs_pdcch) {
       srsran_dci_cfg_t dci_cfg = {};
@@ -528,6 +676,7 @@ int cc_worker::encode_pdcch_ul(stack_interface_phy_lte::ul_sched_grant_t* grants
 
 int cc_worker::encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants)
 {
+  srsran::scoped_stage_prof prof(srsran::tti_stage::pdcch);
   for (uint32_t i = 0; i < nof_grants; i++) {
     uint16_t rnti = grants[i].dci.rnti;
     if (rnti) {
@@ -563,38 +712,64 @@ int cc_worker::encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants
   return 0;
 }
 
-int cc_worker::encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant, srsran_mbsfn_cfg_t* mbsfn_cfg)
+int cc_worker::encode_pmch(const srsran_dl_sf_cfg_t&                  dl_sf_cfg,
+                           stack_interface_phy_lte::dl_sched_grant_t* grant,
+                           srsran_mbsfn_cfg_t*                        mbsfn_cfg,
+                           pmch_tx_t&                                 pmch)
 {
-  srsran_pmch_cfg_t pmch_cfg;
-  ZERO_OBJECT(pmch_cfg);
-  srsran_configure_pmch(&pmch_cfg, &enb_dl.cell, mbsfn_cfg);
-  srsran_ra_dl_compute_nof_re(&enb_dl.cell, &dl_sf, &pmch_cfg.pdsch_cfg.grant);
+  std::lock_guard<std::mutex> lock(mutex);
+
+  srsran_dl_sf_cfg_t pmch_sf = dl_sf_cfg;
+  pmch.cfg                   = {};
+  srsran_configure_pmch(&pmch.cfg, &enb_dl.cell, mbsfn_cfg);
+  srsran_ra_dl_compute_nof_re(&enb_dl.cell, &pmch_sf, &pmch.cfg.pdsch_cfg.grant);
 
   // Set soft buffer
-  pmch_cfg.pdsch_cfg.softbuffers.tx[0] = &temp_mbsfn_softbuffer;
+  pmch.cfg.pdsch_cfg.softbuffers.tx[0] = &temp_mbsfn_softbuffer;
 
   // Encode PMCH
-  if (srsran_enb_dl_put_pmch(&enb_dl, &pmch_cfg, grant->data[0])) {
-    Error("Error putting PMCH");
+  pmch.symbols = srsran_enb_dl_encode_pmch(&enb_dl, &pmch_sf, &pmch.cfg, grant->data[0]);
+  if (pmch.symbols == nullptr) {
+    Error("Error encoding PMCH");
     return SRSRAN_ERROR;
   }
 
   // Logging
   if (logger.info.enabled()) {
     char str[512];
-    srsran_pdsch_tx_info(&pmch_cfg.pdsch_cfg, str, 512);
+    srsran_pdsch_tx_info(&pmch.cfg.pdsch_cfg, str, 512);
     logger.info("PMCH: %s", str);
   }
+  return SRSRAN_SUCCESS;
+}
+
+int cc_worker::put_pmch(const pmch_tx_t& pmch)
+{
+  // The encoded symbols can only be reused by the carriers with the same PMCH grant
+  srsran_pmch_cfg_t pmch_cfg = pmch.cfg;
+  srsran_ra_dl_compute_nof_re(&enb_dl.cell, &dl_sf, &pmch_cfg.pdsch_cfg.grant);
+  if (pmch_cfg.pdsch_cfg.grant.nof_prb != enb_dl.cell.nof_prb ||
+      pmch_cfg.pdsch_cfg.grant.nof_re != pmch.cfg.pdsch_cfg.grant.nof_re) {
+    Warning("PMCH: cc=%d does not match the bandwidth of the MBSFN area, skipping", cc_idx);
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_enb_dl_put_pmch_symbols(&enb_dl, &pmch_cfg, pmch.symbols)) {
+    Error("Error putting PMCH");
+    return SRSRAN_ERROR;
+  }
 
   // Save metrics stats
   if (ue_db.count(SRSRAN_MRNTI)) {
-    ue_db[SRSRAN_MRNTI]->metrics_dl(mbsfn_cfg->mbsfn_mcs);
+    ue_db[SRSRAN_MRNTI]->metrics_dl(pmch_cfg.pdsch_cfg.grant.tb[0].mcs_idx);
   }
   return SRSRAN_SUCCESS;
 }
 
 int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants)
 {
+  srsran::scoped_stage_prof prof(srsran::tti_stage::pdsch);
+
   /* Scales the Resources Elements affected by the power allocation (p_b) */
   // srsran_enb_dl_prepare_power_allocation(&enb_dl);
   for (uint32_t i = 0; i < nof_grants; i++) {
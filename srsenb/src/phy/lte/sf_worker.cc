@@ -20,6 +20,7 @@
  */
 
 #include "srsran/common/threads.h"
+#include "srsran/srslog/event_trace.h"
 #include "srsran/srsran.h"
 
 #include "srsenb/hdr/phy/lte/sf_worker.h"
@@ -72,10 +73,62 @@ namespace lte {
 FILE* f;
 #endif
 
+/// Inputs shared by the per-carrier jobs of one TTI, each job only touches the grants of its own carrier
+struct cc_jobs_t {
+  std::vector<std::unique_ptr<cc_worker> >* cc_workers;
+  const srsran_ul_sf_cfg_t*                 ul_sf;
+  const srsran_dl_sf_cfg_t*                 dl_sf;
+  stack_interface_phy_lte::ul_sched_list_t* ul_grants;
+  stack_interface_phy_lte::dl_sched_list_t* dl_grants;
+  stack_interface_phy_lte::ul_sched_list_t* ul_grants_tx;
+  const cc_worker::pmch_tx_t*               pmch;
+};
+
+static void cc_job_ul(void* arg, uint32_t cc)
+{
+  auto* jobs = static_cast<cc_jobs_t*>(arg);
+  (*jobs->cc_workers)[cc]->work_ul(*jobs->ul_sf, (*jobs->ul_grants)[cc]);
+}
+
+static srsran_dl_sf_cfg_t get_dl_sf_cc(const srsran_dl_sf_cfg_t& dl_sf, uint32_t cfi)
+{
+  // Select CFI and make sure it is in the right range
+  srsran_dl_sf_cfg_t dl_sf_cc = dl_sf;
+  dl_sf_cc.cfi                = SRSRAN_MAX(cfi, 1);
+  dl_sf_cc.cfi                = SRSRAN_MIN(dl_sf_cc.cfi, 3);
+  return dl_sf_cc;
+}
+
+static void cc_job_dl(void* arg, uint32_t cc)
+{
+  auto*              jobs  = static_cast<cc_jobs_t*>(arg);
+  srsran_dl_sf_cfg_t dl_sf = get_dl_sf_cc(*jobs->dl_sf, (*jobs->dl_grants)[cc].cfi);
+
+  (*jobs->cc_workers)[cc]->work_dl(dl_sf, (*jobs->dl_grants)[cc], (*jobs->ul_grants_tx)[cc], jobs->pmch);
+}
+
+void sf_worker::run_cc_jobs(void (*job)(void* arg, uint32_t cc), void* arg)
+{
+  // With carrier aggregation the carriers are processed by the shared pool, the MAC scheduling between the UL and
+  // the DL keeps them as two separate stages
+  if (phy->cc_worker_pool != nullptr && cc_workers.size() > 1) {
+    phy->cc_worker_pool->parallel_for((uint32_t)cc_workers.size(), job, arg);
+    return;
+  }
+  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+    job(arg, cc);
+  }
+}
+
 void sf_worker::init(phy_common* phy_)
 {
   phy = phy_;
 
+  if (srsran_pdsch_tb_cache_init(&bcast_tb_cache, SRSRAN_PDSCH_TB_CACHE_DEFAULT_NOF_ENTRIES)) {
+    ERROR("Error initiating broadcast transport block cache");
+    exit(-1);
+  }
+
   // Initialise each component carrier workers
   for (uint32_t i = 0; i < phy->get_nof_carriers_lte(); i++) {
     // Create pointer
@@ -83,6 +136,7 @@ void sf_worker::init(phy_common* phy_)
 
     // Initialise
     q->init(phy, i);
+    q->set_tb_cache(&bcast_tb_cache);
 
     // Create unique pointer
     cc_workers.push_back(std::unique_ptr<cc_worker>(q));
@@ -149,6 +203,7 @@ uint32_t sf_worker::get_nof_rnti()
 
 void sf_worker::work_imp()
 {
+  trace_hot_scope_arg("phy", "sf_worker", tti_rx);
   std::lock_guard<std::mutex> lock(work_mutex);
 
   srsran_ul_sf_cfg_t ul_sf = {};
@@ -188,11 +243,26 @@ void sf_worker::work_imp()
     Info("Failed setting UL grants. Some grant's RNTI does not exist.");
   }
 
-  // Process UL
-  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
-    cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
+  // Shed load if one of the previous TTIs was late
+  bool           shed_load = phy->get_load_shedding();
+  phy_tunables_t tunables  = phy->get_tunables();
+  for (auto& w : cc_workers) {
+    w->set_load_shedding(shed_load);
+    w->set_tunables(tunables);
   }
 
+  cc_jobs_t jobs    = {};
+  jobs.cc_workers   = &cc_workers;
+  jobs.ul_sf        = &ul_sf;
+  jobs.dl_sf        = &dl_sf;
+  jobs.ul_grants    = &ul_grants;
+  jobs.dl_grants    = &dl_grants;
+  jobs.ul_grants_tx = &ul_grants_tx;
+  jobs.pmch         = nullptr;
+
+  // Process UL
+  run_cc_jobs(cc_job_ul, &jobs);
+
   // Get DL scheduling for the TX TTI from MAC
   if (sf_type == SRSRAN_SF_NORM) {
     if (stack->get_dl_sched(tti_tx_dl, dl_grants) < 0) {
@@ -221,18 +291,24 @@ void sf_worker::work_imp()
   dl_sf.sf_type          = sf_type;
   dl_sf.non_mbsfn_region = mbsfn_cfg.non_mbsfn_region_length;
 
+  // All the cells share the MBSFN area and the MCH scheduling, so the PMCH is encoded once for the first carrier and
+  // mapped to the grid of every carrier
+  cc_worker::pmch_tx_t pmch = {};
+  if (sf_type == SRSRAN_SF_MBSFN && mbsfn_cfg.enable) {
+    for (uint32_t cc = 1; cc < cc_workers.size(); cc++) {
+      dl_grants[cc].cfi = dl_grants[0].cfi;
+    }
+    srsran_dl_sf_cfg_t pmch_sf = get_dl_sf_cc(dl_sf, dl_grants[0].cfi);
+    if (cc_workers[0]->encode_pmch(pmch_sf, dl_grants[0].pdsch, &mbsfn_cfg, pmch) == SRSRAN_SUCCESS) {
+      jobs.pmch = &pmch;
+    }
+  }
+
   // Prepare for receive ACK for DL grants in t_tx_dl+4
   phy->ue_db.clear_tti_pending_ack(tti_tx_ul);
 
   // Process DL
-  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
-    // Select CFI and make sure it is in the right range
-    dl_sf.cfi = dl_grants[cc].cfi;
-    dl_sf.cfi = SRSRAN_MAX(dl_sf.cfi, 1);
-    dl_sf.cfi = SRSRAN_MIN(dl_sf.cfi, 3);
-
-    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
-  }
+  run_cc_jobs(cc_job_dl, &jobs);
 
   // Save grants
   phy->set_ul_grants(tti_tx_ul, ul_grants_tx);
@@ -343,6 +419,7 @@ int sf_worker::read_pucch_d(uint32_t cc_idx, cf_t* pdsch_d)
 sf_worker::~sf_worker()
 {
   srsran_softbuffer_tx_free(&temp_mbsfn_softbuffer);
+  srsran_pdsch_tb_cache_free(&bcast_tb_cache);
 }
 
 } // namespace lte
@@ -25,19 +25,44 @@ namespace lte {
 
 worker_pool::worker_pool(uint32_t max_workers) : pool(max_workers) {}
 
+void worker_pool::init_job(void* arg, uint32_t idx)
+{
+  auto* init_arg = (init_arg_t*)arg;
+  init_arg->pool->workers[idx]->init(init_arg->common);
+}
+
 bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink& log_sink, int prio)
 {
-  // Add workers to workers pool and start threads.
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("PHY{}", i), log_sink);
     log.set_level(log_level);
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
-    auto w = std::unique_ptr<lte::sf_worker>(new sf_worker(log));
-    w->init(common);
-    pool.init_worker(i, w.get(), prio);
-    workers.push_back(std::move(w));
+    workers.push_back(std::unique_ptr<lte::sf_worker>(new sf_worker(log)));
+  }
+
+  // The carriers of every worker are initialised independently, which can be done in parallel
+  init_arg_t init_arg = {this, common};
+  if (args.nof_init_threads > 1 && workers.size() > 1) {
+    srsran::task_thread_pool init_pool(std::min(args.nof_init_threads, (uint32_t)workers.size()) - 1);
+    init_pool.parallel_for(workers.size(), init_job, &init_arg);
+    init_pool.stop();
+  } else {
+    for (uint32_t i = 0; i < workers.size(); i++) {
+      init_job(&init_arg, i);
+    }
+  }
+
+  // Add workers to workers pool and start threads.
+  for (uint32_t i = 0; i < workers.size(); i++) {
+    pool.init_worker(i, workers[i].get(), prio);
+  }
+
+  // Park the workers that are not needed for meeting the deadline, a subframe is transmitted TX_ENB_DELAY subframes
+  // after its reception and the radio needs the last one of them
+  if (args.min_phy_threads > 0 && args.min_phy_threads < args.nof_phy_threads) {
+    pool.set_adaptive(args.min_phy_threads, 1000, (TX_ENB_DELAY - 1) * 1000);
   }
 
   return true;
@@ -22,6 +22,7 @@
 #include "srsenb/hdr/phy/nr/slot_worker.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
+#include "srsran/phy/utils/huge_pages.h"
 
 //#define DEBUG_WRITE_FILE
 
@@ -52,11 +53,12 @@ bool slot_worker::init(const args_t& args)
   // Copy common configurations
   cell_index = args.cell_index;
   rf_port    = args.rf_port;
+  ul_pool    = args.ul_pool;
 
   // Allocate Tx buffers
   tx_buffer.resize(args.nof_tx_ports);
   for (uint32_t i = 0; i < args.nof_tx_ports; i++) {
-    tx_buffer[i] = srsran_vec_cf_malloc(sf_len);
+    tx_buffer[i] = (cf_t*)srsran_huge_malloc(sizeof(cf_t) * sf_len);
     if (tx_buffer[i] == nullptr) {
       logger.error("Error allocating Tx buffer");
       return false;
@@ -66,7 +68,7 @@ bool slot_worker::init(const args_t& args)
   // Allocate Rx buffers
   rx_buffer.resize(args.nof_rx_ports);
   for (uint32_t i = 0; i < args.nof_rx_ports; i++) {
-    rx_buffer[i] = srsran_vec_cf_malloc(sf_len);
+    rx_buffer[i] = (cf_t*)srsran_huge_malloc(sizeof(cf_t) * sf_len);
     if (rx_buffer[i] == nullptr) {
       logger.error("Error allocating Rx buffer");
       return false;
@@ -81,6 +83,7 @@ bool slot_worker::init(const args_t& args)
   dl_args.nof_tx_antennas      = args.nof_tx_ports;
   dl_args.nof_max_prb          = args.nof_max_prb;
   dl_args.srate_hz             = args.srate_hz;
+  dl_args.nof_pdsch_encoders   = ul_pool != nullptr ? args.nof_pdsch_enc : 1;
 
   // Initialise DL
   if (srsran_gnb_dl_init(&gnb_dl, tx_buffer.data(), &dl_args) < SRSRAN_SUCCESS) {
@@ -97,6 +100,29 @@ bool slot_worker::init(const args_t& args)
   ul_args.pusch.max_prb          = args.nof_max_prb;
   ul_args.nof_max_prb            = args.nof_max_prb;
   ul_args.pusch_min_snr_dB       = args.pusch_min_snr_dB;
+  ul_args.pusch_wiener           = args.pusch_wiener;
+
+  // Hand the PUSCH code blocks to a pool of LDPC threads, so that the code blocks of a wideband grant are decoded in
+  // parallel. An accelerator backend plugs in the same way
+  if (args.ldpc_workers >= 0) {
+    srsran_fec_offload_args_t offload_args = {};
+    offload_args.backend                   = SRSRAN_FEC_OFFLOAD_CPU;
+    offload_args.queue_size                = SRSRAN_SCH_NR_MAX_NOF_CB_LDPC;
+    offload_args.nof_workers               = (uint32_t)args.ldpc_workers;
+    offload_args.ldpc_decoder_type         = SRSRAN_LDPC_DECODER_C;
+#ifdef LV_HAVE_AVX512
+    offload_args.ldpc_decoder_type = SRSRAN_LDPC_DECODER_C_AVX512;
+#elif defined(LV_HAVE_AVX2)
+    offload_args.ldpc_decoder_type = SRSRAN_LDPC_DECODER_C_AVX2;
+#endif
+    offload_args.ldpc_scaling_factor = 0.8f;
+    offload_args.ldpc_max_nof_iter   = args.pusch_max_its;
+    if (srsran_fec_offload_init(&fec_offload, &offload_args) < SRSRAN_SUCCESS) {
+      logger.error("Error initialising the LDPC offload");
+      return false;
+    }
+    ul_args.pusch.sch.fec_offload = &fec_offload;
+  }
 
   // Initialise UL
   if (srsran_gnb_ul_init(&gnb_ul, rx_buffer[0], &ul_args) < SRSRAN_SUCCESS) {
@@ -116,19 +142,16 @@ bool slot_worker::init(const args_t& args)
 slot_worker::~slot_worker()
 {
   for (auto& b : tx_buffer) {
-    if (b) {
-      free(b);
-      b = nullptr;
-    }
+    srsran_huge_free(b);
+    b = nullptr;
   }
   for (auto& b : rx_buffer) {
-    if (b) {
-      free(b);
-      b = nullptr;
-    }
+    srsran_huge_free(b);
+    b = nullptr;
   }
   srsran_gnb_dl_free(&gnb_dl);
   srsran_gnb_ul_free(&gnb_ul);
+  srsran_fec_offload_free(&fec_offload);
 }
 
 cf_t* slot_worker::get_buffer_rx(uint32_t antenna_idx)
@@ -348,33 +371,30 @@ bool slot_worker::work_dl()
     }
   }
 
-  // Encode PDSCH
+  // Put the PDSCH DMRS, which share the DMRS sequence cache
   for (const stack_interface_phy_nr::pdsch_t& pdsch : dl_sched_ptr->pdsch) {
-    // convert MAC to PHY buffer data structures
-    uint8_t* data[SRSRAN_MAX_TB] = {};
-    for (uint32_t i = 0; i < SRSRAN_MAX_TB; ++i) {
-      if (pdsch.data[i] != nullptr) {
-        data[i] = pdsch.data[i]->msg;
-      }
+    if (srsran_gnb_dl_pdsch_put_dmrs(&gnb_dl, &dl_slot_cfg, &pdsch.sch) < SRSRAN_SUCCESS) {
+      logger.error("PDSCH: Error putting DMRS");
+      return false;
     }
+  }
 
-    // Put PDSCH message
-    if (srsran_gnb_dl_pdsch_put(&gnb_dl, &dl_slot_cfg, &pdsch.sch, data) < SRSRAN_SUCCESS) {
-      logger.error("PDSCH: Error putting DL message");
+  // Encode PDSCH. The grants of a slot do not overlap, so several encoders map their PDSCH into the grid at the same
+  // time, each one taking the next PDSCH until all of them are encoded
+  uint32_t nof_pdsch_enc = std::min(gnb_dl.nof_pdsch_enc, (uint32_t)dl_sched_ptr->pdsch.size());
+  if (ul_pool != nullptr and nof_pdsch_enc > 1) {
+    dl_sched   = dl_sched_ptr;
+    pdsch_next = 0;
+    pdsch_ok   = true;
+    ul_pool->parallel_for(nof_pdsch_enc, run_pdsch_encoder, this);
+    dl_sched = nullptr;
+    if (not pdsch_ok) {
       return false;
     }
-
-    // Log PDSCH information
-    if (logger.info.enabled()) {
-      std::array<char, 512> str = {};
-      srsran_gnb_dl_pdsch_info(&gnb_dl, &pdsch.sch, str.data(), (uint32_t)str.size());
-
-      if (logger.debug.enabled()) {
-        std::array<char, 1024> str_extra = {};
-        srsran_sch_cfg_nr_info(&pdsch.sch, str_extra.data(), (uint32_t)str_extra.size());
-        logger.info("PDSCH: cc=%d %s tti_tx=%d\n%s", cell_index, str.data(), dl_slot_cfg.idx, str_extra.data());
-      } else {
-        logger.info("PDSCH: cc=%d %s tti_tx=%d", cell_index, str.data(), dl_slot_cfg.idx);
+  } else {
+    for (const stack_interface_phy_nr::pdsch_t& pdsch : dl_sched_ptr->pdsch) {
+      if (not encode_pdsch(0, pdsch)) {
+        return false;
       }
     }
   }
@@ -401,6 +421,59 @@ bool slot_worker::work_dl()
   return true;
 }
 
+bool slot_worker::encode_pdsch(uint32_t enc_idx, const stack_interface_phy_nr::pdsch_t& pdsch)
+{
+  // convert MAC to PHY buffer data structures
+  uint8_t* data[SRSRAN_MAX_TB] = {};
+  for (uint32_t i = 0; i < SRSRAN_MAX_TB; ++i) {
+    if (pdsch.data[i] != nullptr) {
+      data[i] = pdsch.data[i]->msg;
+    }
+  }
+
+  // Put PDSCH message
+  if (srsran_gnb_dl_pdsch_encode(&gnb_dl, enc_idx, &pdsch.sch, data) < SRSRAN_SUCCESS) {
+    logger.error("PDSCH: Error putting DL message");
+    return false;
+  }
+
+  // Log PDSCH information
+  if (logger.info.enabled()) {
+    std::array<char, 512> str = {};
+    srsran_gnb_dl_pdsch_enc_info(&gnb_dl, enc_idx, &pdsch.sch, str.data(), (uint32_t)str.size());
+
+    if (logger.debug.enabled()) {
+      std::array<char, 1024> str_extra = {};
+      srsran_sch_cfg_nr_info(&pdsch.sch, str_extra.data(), (uint32_t)str_extra.size());
+      logger.info("PDSCH: cc=%d %s tti_tx=%d\n%s", cell_index, str.data(), dl_slot_cfg.idx, str_extra.data());
+    } else {
+      logger.info("PDSCH: cc=%d %s tti_tx=%d", cell_index, str.data(), dl_slot_cfg.idx);
+    }
+  }
+
+  return true;
+}
+
+void slot_worker::run_pdsch_encoder(void* arg, uint32_t enc_idx)
+{
+  slot_worker* w = static_cast<slot_worker*>(arg);
+  for (uint32_t i = w->pdsch_next++; i < w->dl_sched->pdsch.size(); i = w->pdsch_next++) {
+    if (not w->encode_pdsch(enc_idx, w->dl_sched->pdsch[i])) {
+      w->pdsch_ok = false;
+    }
+  }
+}
+
+void slot_worker::run_stage(void* arg, uint32_t stage_idx)
+{
+  slot_worker* w = static_cast<slot_worker*>(arg);
+  if (stage_idx == 0) {
+    w->dl_ok = w->work_dl();
+  } else {
+    w->ul_ok = w->work_ul();
+  }
+}
+
 void slot_worker::work_imp()
 {
   // Inform Scheduler about new slot
@@ -414,17 +487,26 @@ void slot_worker::work_imp()
     tx_rf_buffer.set(rf_port, a, nof_ant, tx_buffer[a]);
   }
 
-  // Process uplink
-  if (not work_ul()) {
-    // Wait and release synchronization
-    sync.wait(this);
-    sync.release();
-    common.worker_end(context, false, tx_rf_buffer);
-    return;
+  if (ul_pool != nullptr) {
+    // The DL of the slot does not depend on its UL, so they are processed at the same time. This thread takes the DL,
+    // which waits for the scheduling of the previous slots, and a thread of the shared pool the FFT and UL channels
+    ul_pool->parallel_for(2, run_stage, this);
+  } else {
+    // Process uplink
+    ul_ok = work_ul();
+    if (not ul_ok) {
+      // Wait and release synchronization
+      sync.wait(this);
+      sync.release();
+      common.worker_end(context, false, tx_rf_buffer);
+      return;
+    }
+
+    // Process downlink
+    dl_ok = work_dl();
   }
 
-  // Process downlink
-  if (not work_dl()) {
+  if (not ul_ok or not dl_ok) {
     common.worker_end(context, false, tx_rf_buffer);
     return;
   }
@@ -53,6 +53,12 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   logger.set_level(log_level);
 
+  // The workers can share a pool that processes the UL of their slots while they process the DL, and that encodes the
+  // PDSCH of a slot in parallel
+  if (args.nof_ul_threads > 0) {
+    ul_pool.reset(new srsran::task_thread_pool(args.nof_ul_threads, false, args.prio));
+  }
+
   // Add workers to workers pool and start threads
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("{}PHY{}-NR", args.log.id_preamble, i), log_sink);
@@ -73,12 +79,22 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
     w_args.srate_hz                = srate_hz;
     w_args.pusch_max_its           = args.pusch_max_its;
     w_args.pusch_min_snr_dB        = args.pusch_min_snr_dB;
+    w_args.pusch_wiener            = args.pusch_wiener;
+    w_args.ldpc_workers            = args.ldpc_workers;
+    w_args.ul_pool                 = ul_pool.get();
+    w_args.nof_pdsch_enc           = args.nof_ul_threads + 1; // The pool threads and the worker encode the PDSCH
 
     if (not w->init(w_args)) {
       return false;
     }
   }
 
+  // Park the workers that are not needed for meeting the deadline of TX_ENB_DELAY slots minus the radio one
+  if (args.min_phy_threads > 0 && args.min_phy_threads < args.nof_phy_threads) {
+    uint32_t slot_us = 1000U >> (uint32_t)cell_list[0].carrier.scs;
+    pool.set_adaptive(args.min_phy_threads, slot_us, (TX_ENB_DELAY - 1) * slot_us);
+  }
+
   return true;
 }
 
@@ -113,6 +129,9 @@ slot_worker* worker_pool::wait_worker_id(uint32_t id)
 void worker_pool::stop()
 {
   pool.stop();
+  if (ul_pool != nullptr) {
+    ul_pool->stop();
+  }
   prach.stop();
 }
 
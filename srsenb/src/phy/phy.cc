@@ -23,6 +23,7 @@
 #include "srsran/common/band_helper.h"
 #include "srsran/common/phy_cfg_nr_default.h"
 #include "srsran/common/threads.h"
+#include <chrono>
 #include <pthread.h>
 #include <sstream>
 #include <string.h>
@@ -172,6 +173,7 @@ int phy::init_lte(const phy_args_t&            args,
   nof_workers = cfg.phy_cell_cfg.empty() ? 0 : args.nof_phy_threads;
 
   workers_common.params = args;
+  workers_common.set_tunables({args.pusch_max_its, args.use_cedron_alg});
 
   workers_common.init(cfg.phy_cell_cfg, cfg.phy_cell_cfg_nr, radio, stack_lte_);
   if (cfg.cfr_config.cfr_enable) {
@@ -180,10 +182,34 @@ int phy::init_lte(const phy_args_t&            args,
 
   parse_common_config(cfg);
 
+  // With carrier aggregation, the workers can share a pool for processing the carriers of a subframe in parallel
+  if (shared_task_pool != nullptr) {
+    if (cfg.phy_cell_cfg.size() > 1) {
+      workers_common.cc_worker_pool = shared_task_pool;
+    }
+  } else if (args.nof_cc_threads > 0 && cfg.phy_cell_cfg.size() > 1) {
+    workers_common.cc_worker_pool.reset(new srsran::task_thread_pool(args.nof_cc_threads, false, WORKERS_THREAD_PRIO));
+  }
+
+  // The carrier workers can share a pool for decoding the PUSCH of the users of a subframe in parallel
+  if (shared_task_pool != nullptr) {
+    workers_common.pusch_decoder_pool = shared_task_pool;
+  } else if (args.nof_pusch_threads > 0) {
+    workers_common.pusch_decoder_pool.reset(
+        new srsran::task_thread_pool(args.nof_pusch_threads, false, WORKERS_THREAD_PRIO));
+  }
+
   // Add workers to workers pool and start threads
+  auto t_workers = std::chrono::steady_clock::now();
   if (not cfg.phy_cell_cfg.empty()) {
     lte_workers.init(args, &workers_common, log_sink, WORKERS_THREAD_PRIO);
   }
+  auto t_prach = std::chrono::steady_clock::now();
+
+  // Share the PRACH threads between all the carriers if requested
+  if (args.prach_shared_pool) {
+    prach.init_shared_pool(args.nof_prach_threads, PRACH_WORKER_THREAD_PRIO, args.prach_cpu_mask);
+  }
 
   // For each carrier, initialise PRACH worker
   for (uint32_t cc = 0; cc < cfg.phy_cell_cfg.size(); cc++) {
@@ -198,15 +224,35 @@ int phy::init_lte(const phy_args_t&            args,
   }
   prach.set_max_prach_offset_us(args.max_prach_offset_us);
 
+  auto t_end = std::chrono::steady_clock::now();
+  phy_log.info("Initialised %d workers of %zd carriers with %d threads in %.1f ms, PRACH workers in %.1f ms",
+               nof_workers,
+               cfg.phy_cell_cfg.size(),
+               std::max(args.nof_init_threads, 1U),
+               std::chrono::duration<double, std::milli>(t_prach - t_workers).count(),
+               std::chrono::duration<double, std::milli>(t_end - t_prach).count());
+
   return SRSRAN_SUCCESS;
 }
 
+std::shared_ptr<srsran::task_thread_pool> phy::create_shared_task_pool(uint32_t nof_threads)
+{
+  return std::make_shared<srsran::task_thread_pool>(nof_threads, false, WORKERS_THREAD_PRIO);
+}
+
 void phy::stop()
 {
   if (initialized) {
     tx_rx.stop();
     workers_common.stop();
     lte_workers.stop();
+    // A pool shared with other eNB instances is stopped by its owner
+    if (workers_common.cc_worker_pool != nullptr && workers_common.cc_worker_pool != shared_task_pool) {
+      workers_common.cc_worker_pool->stop();
+    }
+    if (workers_common.pusch_decoder_pool != nullptr && workers_common.pusch_decoder_pool != shared_task_pool) {
+      workers_common.pusch_decoder_pool->stop();
+    }
     if (nr_workers != nullptr) {
       nr_workers->stop();
     }
@@ -247,6 +293,11 @@ void phy::set_activation_deactivation_scell(uint16_t rnti, const std::array<bool
   }
 }
 
+void phy::get_timing_metrics(phy_timing_metrics_t& m)
+{
+  workers_common.get_timing_metrics(m);
+}
+
 void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
 {
   std::vector<phy_metrics_t> metrics_tmp;
@@ -297,6 +348,14 @@ void phy::cmd_cell_measure()
   workers_common.set_cell_measure_trigger();
 }
 
+void phy::set_tunables(const phy_tunables_t& tunables)
+{
+  Info("set_tunables: pusch_max_its=%d, use_cedron_alg=%s",
+       tunables.pusch_max_its,
+       tunables.use_cedron_alg ? "true" : "false");
+  workers_common.set_tunables(tunables);
+}
+
 /***** RRC->PHY interface **********/
 
 void phy::set_config(uint16_t rnti, const phy_rrc_cfg_list_t& phy_cfg_list)
@@ -373,9 +432,13 @@ int phy::init_nr(const phy_args_t& args, const phy_cfg_t& cfg, stack_interface_p
 
   nr::worker_pool::args_t worker_args = {};
   worker_args.nof_phy_threads         = args.nof_phy_threads;
+  worker_args.min_phy_threads         = args.min_phy_threads;
+  worker_args.nof_ul_threads          = args.nof_nr_ul_threads;
   worker_args.log.phy_level           = args.log.phy_level;
   worker_args.log.phy_hex_limit       = args.log.phy_hex_limit;
   worker_args.pusch_max_its           = args.nr_pusch_max_its;
+  worker_args.pusch_wiener            = args.nr_pusch_wiener;
+  worker_args.ldpc_workers            = args.nr_ldpc_workers;
 
   if (not nr_workers->init(worker_args, cfg.phy_cell_cfg_nr)) {
     return SRSRAN_ERROR;
@@ -152,6 +152,9 @@ void phy_common::worker_end(const worker_context_t& w_ctx, const bool& tx_enable
   // Add current time alignment
   srsran::rf_timestamp_t tx_time = w_ctx.tx_time; // get transmit time from the last worker
 
+  // Measure how early the subframe is handed to the radio, before the channel emulator adds its own processing
+  update_slack(tx_time.get(0));
+
   // Run DL channel emulator if created
   if (dl_channel) {
     dl_channel->run(tx_buffer.to_cf_t(), tx_buffer.to_cf_t(), tx_buffer.get_nof_samples(), tx_time.get(0));
@@ -170,6 +173,67 @@ void phy_common::worker_end(const worker_context_t& w_ctx, const bool& tx_enable
   semaphore.release();
 }
 
+void phy_common::set_rx_end_time(const srsran_timestamp_t& rx_end_time)
+{
+  rx_end_us = srsran_timestamp_uint64(&rx_end_time, 1e6);
+}
+
+void phy_common::update_slack(const srsran_timestamp_t& tx_time)
+{
+  uint64_t rx_us = rx_end_us;
+  if (rx_us == 0) {
+    return;
+  }
+  float slack_us = (float)((int64_t)srsran_timestamp_uint64(&tx_time, 1e6) - (int64_t)rx_us);
+
+  std::lock_guard<std::mutex> lock(timing_mutex);
+  if (timing_metrics.nof_tti == 0 || slack_us < timing_metrics.min_slack_us) {
+    timing_metrics.min_slack_us = slack_us;
+  }
+  timing_metrics.nof_tti++;
+
+  uint32_t bin = 0;
+  if (slack_us >= 2000.0f) {
+    bin = 4;
+  } else if (slack_us >= 1000.0f) {
+    bin = 3;
+  } else if (slack_us >= 500.0f) {
+    bin = 2;
+  } else if (slack_us >= 0.0f) {
+    bin = 1;
+  }
+  timing_metrics.slack_hist[bin]++;
+
+  if (slack_us < 0.0f) {
+    timing_metrics.nof_late++;
+
+    // The subframes in flight are already late or about to be, shed load for a whole HARQ round trip
+    if (params.late_pusch_max_its > 0) {
+      shed_nof_tti = SRSRAN_FDD_NOF_HARQ;
+    }
+  }
+}
+
+bool phy_common::get_load_shedding()
+{
+  uint32_t nof_tti = shed_nof_tti;
+  while (nof_tti > 0) {
+    if (shed_nof_tti.compare_exchange_weak(nof_tti, nof_tti - 1)) {
+      std::lock_guard<std::mutex> lock(timing_mutex);
+      timing_metrics.nof_shed_tti++;
+      return true;
+    }
+  }
+  return false;
+}
+
+void phy_common::get_timing_metrics(phy_timing_metrics_t& m)
+{
+  std::lock_guard<std::mutex> lock(timing_mutex);
+  m              = timing_metrics;
+  timing_metrics = {};
+}
+
 void phy_common::set_mch_period_stop(uint32_t stop)
 {
   std::lock_guard<std::mutex> lock(mtch_mutex);
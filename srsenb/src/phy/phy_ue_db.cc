@@ -32,44 +32,50 @@ void phy_ue_db::init(stack_interface_phy_lte*   stack_ptr,
   cell_cfg_list = &cell_cfg_list_;
 }
 
-inline int phy_ue_db::_add_rnti(uint16_t rnti)
+inline phy_ue_db::common_ue* phy_ue_db::_add_rnti(uint16_t rnti)
 {
-  // Private function not mutexed
-
-  // Assert RNTI does NOT exist
-  if (ue_db.count(rnti)) {
-    return SRSRAN_ERROR;
-  }
-
-  // Create new UE by accesing it
-  ue_db[rnti].cell_info[0] = {};
-
-  // Get UE
-  common_ue& ue = ue_db[rnti];
+  // Private function, requires holding the mutex
 
   // Load default values to PCell
-  ue.cell_info[0].phy_cfg.set_defaults();
+  ue_cfg_t* cfg = new ue_cfg_t;
+  cfg->cell_info[0].phy_cfg.set_defaults();
 
   // Set constant configuration fields
-  _set_common_config_rnti(rnti, ue.cell_info[0].phy_cfg);
+  _set_common_config_rnti(rnti, cfg->cell_info[0].phy_cfg);
 
   // Configure as PCell
-  ue.cell_info[0].state = cell_state_primary;
+  cfg->cell_info[0].state = cell_state_primary;
+
+  std::unique_ptr<common_ue> ue(new common_ue);
+  ue->cfg.store(cfg, std::memory_order_relaxed);
 
   // Iterate all pending ACK
   for (uint32_t tti = 0; tti < TTIMOD_SZ; tti++) {
-    _clear_tti_pending_rnti(tti, rnti);
+    _clear_tti_pending_rnti(tti, *ue, *cfg);
   }
 
-  return SRSRAN_SUCCESS;
+  // Insert the UE, it is visible to the workers from now on
+  common_ue* ue_ptr = ue.get();
+  if (not ue_db.insert(rnti, std::move(ue))) {
+    return nullptr;
+  }
+
+  return ue_ptr;
 }
 
-inline void phy_ue_db::_clear_tti_pending_rnti(uint32_t tti, uint16_t rnti)
+void phy_ue_db::_publish_config(common_ue& ue, const ue_cfg_t& cfg)
 {
-  // Private function not mutexed, no need to assert RNTI or TTI
+  // Private function, requires holding the mutex
 
-  // Get UE
-  common_ue& ue = ue_db[rnti];
+  // The workers that loaded the previous snapshot keep using it until they leave their read-side critical section
+  const ue_cfg_t* old_cfg = ue.cfg.exchange(new ue_cfg_t(cfg), std::memory_order_acq_rel);
+  cfg_rcu.synchronize();
+  delete old_cfg;
+}
+
+inline void phy_ue_db::_clear_tti_pending_rnti(uint32_t tti, common_ue& ue, const ue_cfg_t& cfg)
+{
+  // Private function, requires holding the UE mutex, no need to assert TTI
 
   srsran_pdsch_ack_t& pdsch_ack = ue.pdsch_ack[tti];
 
@@ -77,17 +83,17 @@ inline void phy_ue_db::_clear_tti_pending_rnti(uint32_t tti, uint16_t rnti)
   pdsch_ack = {};
 
   uint32_t nof_active_cc = 0;
-  for (auto& cell_info : ue.cell_info) {
+  for (auto& cell_info : cfg.cell_info) {
     if (cell_info.state == cell_state_primary or cell_info.state == cell_state_secondary_active) {
       nof_active_cc++;
     }
   }
 
   // Copy essentials. It is assumed the PUCCH parameters are the same for all carriers
-  pdsch_ack.transmission_mode      = ue.cell_info[0].phy_cfg.dl_cfg.tm;
+  pdsch_ack.transmission_mode      = cfg.cell_info[0].phy_cfg.dl_cfg.tm;
   pdsch_ack.nof_cc                 = nof_active_cc;
-  pdsch_ack.ack_nack_feedback_mode = ue.cell_info[0].phy_cfg.ul_cfg.pucch.ack_nack_feedback_mode;
-  pdsch_ack.simul_cqi_ack          = ue.cell_info[0].phy_cfg.ul_cfg.pucch.simul_cqi_ack;
+  pdsch_ack.ack_nack_feedback_mode = cfg.cell_info[0].phy_cfg.ul_cfg.pucch.ack_nack_feedback_mode;
+  pdsch_ack.simul_cqi_ack          = cfg.cell_info[0].phy_cfg.ul_cfg.pucch.simul_cqi_ack;
 }
 
 inline void phy_ue_db::_set_common_config_rnti(uint16_t rnti, srsran::phy_cfg_t& phy_cfg) const
@@ -111,13 +117,12 @@ inline void phy_ue_db::_set_common_config_rnti(uint16_t rnti, srsran::phy_cfg_t&
   phy_cfg.ul_cfg.pucch.use_cedron_alg                = phy_args->use_cedron_alg;
 }
 
-inline uint32_t phy_ue_db::_get_ue_cc_idx(uint16_t rnti, uint32_t enb_cc_idx) const
+inline uint32_t phy_ue_db::_get_ue_cc_idx(const ue_cfg_t& cfg, uint32_t enb_cc_idx)
 {
-  uint32_t         ue_cc_idx = 0;
-  const common_ue& ue        = ue_db.at(rnti);
+  uint32_t ue_cc_idx = 0;
 
   for (; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
-    const cell_info_t& scell_info = ue.cell_info[ue_cc_idx];
+    const cell_info_t& scell_info = cfg.cell_info[ue_cc_idx];
     if (scell_info.enb_cc_idx == enb_cc_idx and
         (scell_info.state == cell_state_primary or scell_info.state == cell_state_secondary_active)) {
       return ue_cc_idx;
@@ -127,36 +132,23 @@ inline uint32_t phy_ue_db::_get_ue_cc_idx(uint16_t rnti, uint32_t enb_cc_idx) co
   return ue_cc_idx;
 }
 
-uint32_t phy_ue_db::_get_uci_enb_cc_idx(uint32_t tti, uint16_t rnti) const
+uint32_t phy_ue_db::_get_uci_enb_cc_idx(uint32_t tti, const common_ue& ue, const ue_cfg_t& cfg) const
 {
   // Find the lowest index available PUSCH grant
-  for (const cell_info_t& cell_info : ue_db.at(rnti).cell_info) {
-    if (cell_info.is_grant_available[tti]) {
-      return cell_info.enb_cc_idx;
+  for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
+    if (ue.cell_state[ue_cc_idx].is_grant_available[tti]) {
+      return cfg.cell_info[ue_cc_idx].enb_cc_idx;
     }
   }
 
   return (uint32_t)cell_cfg_list->size();
 }
 
-inline int phy_ue_db::_assert_rnti(uint16_t rnti) const
-{
-  if (not ue_db.count(rnti)) {
-    return SRSRAN_ERROR;
-  }
-
-  return SRSRAN_SUCCESS;
-}
 
-inline int phy_ue_db::_assert_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const
+inline int phy_ue_db::_assert_enb_cc(const ue_cfg_t& cfg, uint32_t enb_cc_idx)
 {
-  // Assert RNTI exist
-  if (_assert_rnti(rnti) != SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
-  }
-
   // Check Component Carrier is part of UE SCell map
-  if (_get_ue_cc_idx(rnti, enb_cc_idx) == SRSRAN_MAX_CARRIERS) {
+  if (_get_ue_cc_idx(cfg, enb_cc_idx) == SRSRAN_MAX_CARRIERS) {
     return SRSRAN_ERROR;
   }
 
@@ -165,17 +157,21 @@ inline int phy_ue_db::_assert_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const
 
 bool phy_ue_db::ue_has_cell(uint16_t rnti, uint32_t enb_cc_idx) const
 {
-  return _assert_enb_cc(rnti, enb_cc_idx) == SRSRAN_SUCCESS;
+  ue_db_t::read_guard            ue_lock(ue_db);
+  srsran::rcu_domain::read_guard cfg_lock(cfg_rcu);
+
+  const common_ue* ue = ue_db.find(rnti);
+  return ue != nullptr and _assert_enb_cc(_get_cfg(*ue), enb_cc_idx) == SRSRAN_SUCCESS;
 }
 
-inline int phy_ue_db::_assert_enb_pcell(uint16_t rnti, uint32_t enb_cc_idx) const
+inline int phy_ue_db::_assert_enb_pcell(const ue_cfg_t& cfg, uint32_t enb_cc_idx)
 {
-  if (_assert_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  if (_assert_enb_cc(cfg, enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Check cell is PCell
-  const cell_info_t& cell_info = ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)];
+  const cell_info_t& cell_info = cfg.cell_info[_get_ue_cc_idx(cfg, enb_cc_idx)];
   if (cell_info.state != cell_state_primary) {
     return SRSRAN_ERROR;
   }
@@ -183,18 +179,14 @@ inline int phy_ue_db::_assert_enb_pcell(uint16_t rnti, uint32_t enb_cc_idx) cons
   return SRSRAN_SUCCESS;
 }
 
-inline int phy_ue_db::_assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const
+inline int phy_ue_db::_assert_ue_cc(const ue_cfg_t& cfg, uint32_t ue_cc_idx)
 {
-  if (_assert_rnti(rnti) != SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
-  }
-
   // Check the cell index is in range
   if (ue_cc_idx >= SRSRAN_MAX_CARRIERS) {
     return SRSRAN_ERROR;
   }
 
-  const cell_info_t& cell_info = ue_db.at(rnti).cell_info.at(ue_cc_idx);
+  const cell_info_t& cell_info = cfg.cell_info.at(ue_cc_idx);
   if (cell_info.state == cell_state_none) {
     return SRSRAN_ERROR;
   }
@@ -202,14 +194,14 @@ inline int phy_ue_db::_assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const
   return SRSRAN_SUCCESS;
 }
 
-inline int phy_ue_db::_assert_active_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const
+inline int phy_ue_db::_assert_active_enb_cc(const ue_cfg_t& cfg, uint32_t enb_cc_idx)
 {
-  if (_assert_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  if (_assert_enb_cc(cfg, enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Check SCell is active, ignore PCell state
-  const cell_info_t& cell_info = ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)];
+  const cell_info_t& cell_info = cfg.cell_info[_get_ue_cc_idx(cfg, enb_cc_idx)];
   if (cell_info.state != cell_state_primary and cell_info.state != cell_state_secondary_active) {
     return SRSRAN_ERROR;
   }
@@ -250,24 +242,31 @@ inline int phy_ue_db::_get_rnti_config(uint16_t rnti, uint32_t enb_cc_idx, srsra
   }
 
   // Make sure the C-RNTI exists and the cell/carrier is configured
-  if (_assert_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* ue = ue_db.find(rnti);
+  if (ue == nullptr) {
+    return SRSRAN_ERROR;
+  }
+  const ue_cfg_t& cfg = _get_cfg(*ue);
+  if (_assert_enb_cc(cfg, enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Write the current configuration
-  uint32_t ue_cc_idx = _get_ue_cc_idx(rnti, enb_cc_idx);
-  phy_cfg            = ue_db.at(rnti).cell_info.at(ue_cc_idx).phy_cfg;
+  uint32_t ue_cc_idx = _get_ue_cc_idx(cfg, enb_cc_idx);
+  phy_cfg            = cfg.cell_info.at(ue_cc_idx).phy_cfg;
   return SRSRAN_SUCCESS;
 }
 
 void phy_ue_db::clear_tti_pending_ack(uint32_t tti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  ue_db_t::read_guard            ue_lock(ue_db);
+  srsran::rcu_domain::read_guard cfg_lock(cfg_rcu);
 
   // Iterate all UEs
-  for (auto& iter : ue_db) {
-    _clear_tti_pending_rnti(TTIMOD(tti), iter.first);
-  }
+  ue_db.for_each([tti](uint16_t rnti, common_ue& ue) {
+    std::lock_guard<std::mutex> lock(ue.mutex);
+    _clear_tti_pending_rnti(TTIMOD(tti), ue, _get_cfg(ue));
+  });
 }
 
 void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_cfg_list_t& phy_cfg_list)
@@ -275,12 +274,17 @@ void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_
   std::lock_guard<std::mutex> lock(mutex);
 
   // Create new user if did not exist
-  if (ue_db.count(rnti) == 0) {
-    _add_rnti(rnti);
+  common_ue* ue_ptr = ue_db.find(rnti);
+  if (ue_ptr == nullptr) {
+    ue_ptr = _add_rnti(rnti);
+  }
+  if (ue_ptr == nullptr) {
+    srslog::fetch_basic_logger("PHY").error("Error adding rnti=0x%x, the UE database position is taken", rnti);
+    return;
   }
 
-  // Get UE by reference
-  common_ue& ue = ue_db[rnti];
+  // Modify a copy of the current configuration, the workers keep using the current one until the copy is published
+  ue_cfg_t ue = _get_cfg(*ue_ptr);
 
   // During a reconfiguration, all parameters in phy_cfg_t shall be applied immediately except:
   // - Multiple CSI request field in DCI (phy_cfg_t.dl_cfg.dci.multiple_csi_request_enabled)
@@ -291,7 +295,7 @@ void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_
   // and the reception of the reconfigurationComplete, the values before the reconfiguration shall be used
 
   // Store the current values for CSI and extended TBS in temporary variables
-  ue.stashed_multiple_csi_request_enabled = (_count_nof_configured_scell(rnti) > 0);
+  ue.stashed_multiple_csi_request_enabled = (_count_nof_configured_scell(ue) > 0);
   for (uint32_t i = 0; i < SRSRAN_MAX_CARRIERS; i++) {
     ue.cell_info[i].stash_use_tbs_index_alt = ue.cell_info[i].phy_cfg.dl_cfg.pdsch.use_tbs_index_alt;
   }
@@ -342,29 +346,30 @@ void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_
 
   // Enable/Disable extended CSI field in DCI according to 3GPP 36.212 R10 5.3.3.1.1 Format 0
   for (uint32_t ue_cc_idx = 0; ue_cc_idx < nof_cc; ue_cc_idx++) {
-    ue.cell_info[ue_cc_idx].phy_cfg.dl_cfg.dci.multiple_csi_request_enabled = (_count_nof_configured_scell(rnti) > 0);
+    ue.cell_info[ue_cc_idx].phy_cfg.dl_cfg.dci.multiple_csi_request_enabled = (_count_nof_configured_scell(ue) > 0);
   }
+
+  _publish_config(*ue_ptr, ue);
 }
 
 int phy_ue_db::rem_rnti(uint16_t rnti)
 {
   std::lock_guard<std::mutex> lock(mutex);
 
-  if (ue_db.count(rnti) == 0) {
+  // It waits for the workers accessing the UE, its configuration snapshot is deleted along with it
+  if (not ue_db.erase(rnti)) {
     return SRSRAN_ERROR;
   }
 
-  ue_db.erase(rnti);
-
   return SRSRAN_SUCCESS;
 }
 
-uint32_t phy_ue_db::_count_nof_configured_scell(uint16_t rnti)
+uint32_t phy_ue_db::_count_nof_configured_scell(const ue_cfg_t& cfg)
 {
   uint32_t nof_configured_scell = 0;
   for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
-    if (ue_db[rnti].cell_info[ue_cc_idx].state == cell_state_t::cell_state_secondary_inactive ||
-        ue_db[rnti].cell_info[ue_cc_idx].state == cell_state_t::cell_state_secondary_active) {
+    if (cfg.cell_info[ue_cc_idx].state == cell_state_t::cell_state_secondary_inactive ||
+        cfg.cell_info[ue_cc_idx].state == cell_state_t::cell_state_secondary_active) {
       nof_configured_scell++;
     }
   }
@@ -376,20 +381,23 @@ int phy_ue_db::complete_config(uint16_t rnti)
   std::lock_guard<std::mutex> lock(mutex);
 
   // Makes sure the RNTI exists
-  if (_assert_rnti(rnti) != SRSRAN_SUCCESS) {
+  common_ue* ue_ptr = ue_db.find(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
+  ue_cfg_t ue = _get_cfg(*ue_ptr);
 
   // Once the reconfiguration is complete, the temporary parameters become the new ones
 
   // Update temporary multiple CSI DCI field with the new value
-  ue_db[rnti].stashed_multiple_csi_request_enabled = (_count_nof_configured_scell(rnti) > 0);
+  ue.stashed_multiple_csi_request_enabled = (_count_nof_configured_scell(ue) > 0);
   // Update temporary alternate TBS value with the new one
   for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
-    ue_db[rnti].cell_info[ue_cc_idx].stash_use_tbs_index_alt =
-        ue_db[rnti].cell_info[ue_cc_idx].phy_cfg.dl_cfg.pdsch.use_tbs_index_alt;
+    ue.cell_info[ue_cc_idx].stash_use_tbs_index_alt = ue.cell_info[ue_cc_idx].phy_cfg.dl_cfg.pdsch.use_tbs_index_alt;
   }
 
+  _publish_config(*ue_ptr, ue);
+
   return SRSRAN_SUCCESS;
 }
 
@@ -398,11 +406,13 @@ int phy_ue_db::activate_deactivate_scell(uint16_t rnti, uint32_t ue_cc_idx, bool
   std::lock_guard<std::mutex> lock(mutex);
 
   // Assert RNTI and SCell are valid
-  if (_assert_ue_cc(rnti, ue_cc_idx) != SRSRAN_SUCCESS) {
+  common_ue* ue_ptr = ue_db.find(rnti);
+  if (ue_ptr == nullptr or _assert_ue_cc(_get_cfg(*ue_ptr), ue_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_SUCCESS;
   }
 
-  cell_info_t& cell_info = ue_db[rnti].cell_info[ue_cc_idx];
+  ue_cfg_t     ue        = _get_cfg(*ue_ptr);
+  cell_info_t& cell_info = ue.cell_info[ue_cc_idx];
 
   // If scell is default only complain
   if (activate and cell_info.state == cell_state_none) {
@@ -412,19 +422,25 @@ int phy_ue_db::activate_deactivate_scell(uint16_t rnti, uint32_t ue_cc_idx, bool
   // Set scell state
   cell_info.state = (activate) ? cell_state_secondary_active : cell_state_secondary_inactive;
 
+  _publish_config(*ue_ptr, ue);
+
   return SRSRAN_SUCCESS;
 }
 
 bool phy_ue_db::is_pcell(uint16_t rnti, uint32_t enb_cc_idx) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  return _assert_enb_pcell(rnti, enb_cc_idx) == SRSRAN_SUCCESS;
+  ue_db_t::read_guard            ue_lock(ue_db);
+  srsran::rcu_domain::read_guard cfg_lock(cfg_rcu);
+
+  const common_ue* ue = ue_db.find(rnti);
+  return ue != nullptr and _assert_enb_pcell(_get_cfg(*ue), enb_cc_idx) == SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::get_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dl_cfg_t& dl_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  ue_db_t::read_guard            ue_lock(ue_db);
+  srsran::rcu_domain::read_guard cfg_lock(cfg_rcu);
+  srsran::phy_cfg_t              phy_cfg = {};
 
   if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
@@ -433,10 +449,12 @@ int phy_ue_db::get_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dl_cfg_t
 
   // The DL configuration must overwrite the use_tbs_index_alt value (for 256QAM) with the temporary value
   // in case we are in the middle of a reconfiguration
-  if (ue_db.count(rnti) && SRSRAN_RNTI_ISUSER(rnti)) {
-    uint32_t ue_cc_idx = _get_ue_cc_idx(rnti, enb_cc_idx);
+  const common_ue* ue = ue_db.find(rnti);
+  if (ue != nullptr && SRSRAN_RNTI_ISUSER(rnti)) {
+    const ue_cfg_t& cfg       = _get_cfg(*ue);
+    uint32_t        ue_cc_idx = _get_ue_cc_idx(cfg, enb_cc_idx);
     if (ue_cc_idx == 0) {
-      dl_cfg.pdsch.use_tbs_index_alt = ue_db.at(rnti).cell_info[ue_cc_idx].stash_use_tbs_index_alt;
+      dl_cfg.pdsch.use_tbs_index_alt = cfg.cell_info[ue_cc_idx].stash_use_tbs_index_alt;
     }
   }
   return SRSRAN_SUCCESS;
@@ -444,8 +462,9 @@ int phy_ue_db::get_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dl_cfg_t
 
 int phy_ue_db::get_dci_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_cfg_t& dci_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  ue_db_t::read_guard            ue_lock(ue_db);
+  srsran::rcu_domain::read_guard cfg_lock(cfg_rcu);
+  srsran::phy_cfg_t              phy_cfg = {};
 
   if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
@@ -454,10 +473,12 @@ int phy_ue_db::get_dci_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_
 
   // The DCI configuration used for DL grants must overwrite the multiple_csi_request_enabled value with the
   // temporary value in case we are in the middle of a reconfiguration
-  if (ue_db.count(rnti) && SRSRAN_RNTI_ISUSER(rnti)) {
-    uint32_t ue_cc_idx = _get_ue_cc_idx(rnti, enb_cc_idx);
+  const common_ue* ue = ue_db.find(rnti);
+  if (ue != nullptr && SRSRAN_RNTI_ISUSER(rnti)) {
+    const ue_cfg_t& cfg       = _get_cfg(*ue);
+    uint32_t        ue_cc_idx = _get_ue_cc_idx(cfg, enb_cc_idx);
     if (ue_cc_idx == 0) {
-      dci_cfg.multiple_csi_request_enabled = ue_db.at(rnti).stashed_multiple_csi_request_enabled;
+      dci_cfg.multiple_csi_request_enabled = cfg.stashed_multiple_csi_request_enabled;
     }
   }
   return SRSRAN_SUCCESS;
@@ -465,8 +486,9 @@ int phy_ue_db::get_dci_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_
 
 int phy_ue_db::get_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_ul_cfg_t& ul_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  ue_db_t::read_guard            ue_lock(ue_db);
+  srsran::rcu_domain::read_guard cfg_lock(cfg_rcu);
+  srsran::phy_cfg_t              phy_cfg = {};
 
   if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
@@ -478,8 +500,9 @@ int phy_ue_db::get_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_ul_cfg_t
 
 int phy_ue_db::get_dci_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_cfg_t& dci_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  ue_db_t::read_guard            ue_lock(ue_db);
+  srsran::rcu_domain::read_guard cfg_lock(cfg_rcu);
+  srsran::phy_cfg_t              phy_cfg = {};
 
   if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
@@ -491,15 +514,18 @@ int phy_ue_db::get_dci_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_
 
 bool phy_ue_db::set_ack_pending(uint32_t tti, uint32_t enb_cc_idx, const srsran_dci_dl_t& dci)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  ue_db_t::read_guard            ue_lock(ue_db);
+  srsran::rcu_domain::read_guard cfg_lock(cfg_rcu);
 
   // Assert rnti and cell exits and it is active
-  if (_assert_active_enb_cc(dci.rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  common_ue* ue_ptr = ue_db.find(dci.rnti);
+  if (ue_ptr == nullptr or _assert_active_enb_cc(_get_cfg(*ue_ptr), enb_cc_idx) != SRSRAN_SUCCESS) {
     return false;
   }
 
-  common_ue& ue        = ue_db.at(dci.rnti);
-  uint32_t   ue_cc_idx = _get_ue_cc_idx(dci.rnti, enb_cc_idx);
+  common_ue&                  ue        = *ue_ptr;
+  uint32_t                    ue_cc_idx = _get_ue_cc_idx(_get_cfg(ue), enb_cc_idx);
+  std::lock_guard<std::mutex> lock(ue.mutex);
 
   srsran_pdsch_ack_cc_t& pdsch_ack_cc = ue.pdsch_ack[tti].cc[ue_cc_idx];
   pdsch_ack_cc.M                      = 1; ///< Hardcoded for FDD
@@ -532,7 +558,8 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
                             bool              is_pusch_available,
                             srsran_uci_cfg_t& uci_cfg)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  ue_db_t::read_guard            ue_lock(ue_db);
+  srsran::rcu_domain::read_guard cfg_lock(cfg_rcu);
 
   // Reset UCI CFG, avoid returning carrying cached information
   uci_cfg = {};
@@ -543,12 +570,17 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
   }
 
   // Assert eNb Cell/Carrier for the given RNTI
-  if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  common_ue* ue_ptr = ue_db.find(rnti);
+  if (ue_ptr == nullptr or _assert_active_enb_cc(_get_cfg(*ue_ptr), enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
+  common_ue&                  ue  = *ue_ptr;
+  const ue_cfg_t&             cfg = _get_cfg(ue);
+  std::lock_guard<std::mutex> lock(ue.mutex);
+
   // Get the eNb cell/carrier index with lowest serving cell index (ue_cc_idx) that has an available grant.
-  uint32_t uci_enb_cc_id         = _get_uci_enb_cc_idx(tti, rnti);
+  uint32_t uci_enb_cc_id         = _get_uci_enb_cc_idx(tti, ue, cfg);
   bool     pusch_grant_available = (uci_enb_cc_id < (uint32_t)cell_cfg_list->size());
 
   // There is a PUSCH grant available for the provided RNTI in at least one serving cell and this call is for PUCCH
@@ -562,15 +594,14 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
   }
 
   // No PUSCH grant for this TTI and cell and no enb_cc_idx is not the PCell
-  if (not pusch_grant_available and _get_ue_cc_idx(rnti, enb_cc_idx) != 0) {
+  if (not pusch_grant_available and _get_ue_cc_idx(cfg, enb_cc_idx) != 0) {
     return SRSRAN_SUCCESS;
   }
 
-  common_ue&               ue           = ue_db.at(rnti);
-  const srsran::phy_cfg_t& pcell_cfg    = ue.cell_info[0].phy_cfg;
+  const srsran::phy_cfg_t& pcell_cfg    = cfg.cell_info[0].phy_cfg;
   bool                     uci_required = false;
 
-  const cell_info_t&   pcell_info = ue.cell_info[0];
+  const cell_info_t&   pcell_info = cfg.cell_info[0];
   const srsran_cell_t& pcell      = cell_cfg_list->at(pcell_info.enb_cc_idx).cell;
 
   // Check if SR opportunity (will only be used in PUCCH)
@@ -580,7 +611,7 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
   // Get pending CQI reports for this TTI, stops at first CC reporting
   bool periodic_cqi_required = false;
   for (uint32_t cell_idx = 0; cell_idx < SRSRAN_MAX_CARRIERS and not periodic_cqi_required; cell_idx++) {
-    const cell_info_t&     cell_info = ue.cell_info[cell_idx];
+    const cell_info_t&     cell_info = cfg.cell_info[cell_idx];
     const srsran_dl_cfg_t& dl_cfg    = cell_info.phy_cfg.dl_cfg;
 
     // According 3GPP 36.213 R10 section 7.2 UE procedure for reporting Channel State Information (CSI)
@@ -589,7 +620,8 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
       const srsran_cell_t& cell = cell_cfg_list->at(cell_info.enb_cc_idx).cell;
 
       // Check if CQI report is required
-      periodic_cqi_required = srsran_enb_dl_gen_cqi_periodic(&cell, &dl_cfg, tti, cell_info.last_ri, &uci_cfg.cqi);
+      periodic_cqi_required =
+          srsran_enb_dl_gen_cqi_periodic(&cell, &dl_cfg, tti, ue.cell_state[cell_idx].last_ri, &uci_cfg.cqi);
 
       // Save SCell index for using it after
       uci_cfg.cqi.scell_index = cell_idx;
@@ -602,7 +634,7 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
     // Aperiodic only supported for PCell
     const srsran_dl_cfg_t& dl_cfg = pcell_info.phy_cfg.dl_cfg;
 
-    uci_required = srsran_enb_dl_gen_cqi_aperiodic(&pcell, &dl_cfg, pcell_info.last_ri, &uci_cfg.cqi);
+    uci_required = srsran_enb_dl_gen_cqi_aperiodic(&pcell, &dl_cfg, ue.cell_state[0].last_ri, &uci_cfg.cqi);
   }
 
   // Get pending ACKs from PDSCH
@@ -617,41 +649,45 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
   return uci_required ? 1 : SRSRAN_SUCCESS;
 }
 
-void phy_ue_db::send_cqi_data(uint32_t                      tti,
-                             uint16_t                       rnti,
-                             uint32_t                       cqi_cc_idx,
-                             const srsran_cqi_cfg_t&        cqi_cfg,
-                             const srsran_cqi_value_t&      cqi_value,
-                             const srsran_cqi_report_cfg_t& cqi_report_cfg,
-                             const srsran_cell_t&           cell,
-                             stack_interface_phy_lte*       stack)
+void phy_ue_db::send_cqi_data(uint32_t                       tti,
+                              uint16_t                       rnti,
+                              uint32_t                       cqi_cc_idx,
+                              const srsran_cqi_cfg_t&        cqi_cfg,
+                              const srsran_cqi_value_t&      cqi_value,
+                              const srsran_cqi_report_cfg_t& cqi_report_cfg,
+                              const srsran_cell_t&           cell,
+                              ul_feedback_list_t&            feedback)
 {
-  uint8_t  stack_value = 0;
+  uint8_t stack_value = 0;
   switch (cqi_cfg.type) {
     case SRSRAN_CQI_TYPE_WIDEBAND:
       stack_value = cqi_value.wideband.wideband_cqi;
-      stack->cqi_info(tti, rnti, cqi_cc_idx, stack_value);
+      feedback.push_back({ul_feedback_t::dl_cqi, rnti, cqi_cc_idx, 0, stack_value, 0, 0});
       break;
     case SRSRAN_CQI_TYPE_SUBBAND_UE:
       stack_value = cqi_value.subband_ue.subband_cqi;
-      stack->sb_cqi_info(tti,
-                         rnti,
-                         cqi_cc_idx,
-                         srsran_cqi_get_sb_idx(tti, cqi_value.subband_ue.subband_label, &cqi_report_cfg, &cell),
-                         stack_value);
+      feedback.push_back({ul_feedback_t::dl_sb_cqi,
+                          rnti,
+                          cqi_cc_idx,
+                          srsran_cqi_get_sb_idx(tti, cqi_value.subband_ue.subband_label, &cqi_report_cfg, &cell),
+                          stack_value,
+                          0,
+                          0});
       break;
     case SRSRAN_CQI_TYPE_SUBBAND_HL:
       stack_value = cqi_value.subband_hl.wideband_cqi_cw0;
       // Todo: change interface
-      stack->cqi_info(tti, rnti, cqi_cc_idx, stack_value);
+      feedback.push_back({ul_feedback_t::dl_cqi, rnti, cqi_cc_idx, 0, stack_value, 0, 0});
       break;
     case SRSRAN_CQI_TYPE_SUBBAND_UE_DIFF:
       stack_value = cqi_value.subband_ue_diff.wideband_cqi;
-      stack->sb_cqi_info(tti,
-                         rnti,
-                         cqi_cc_idx,
-                         cqi_value.subband_ue_diff.position_subband,
-                         stack_value + cqi_value.subband_ue_diff.subband_diff_cqi);
+      feedback.push_back({ul_feedback_t::dl_sb_cqi,
+                          rnti,
+                          cqi_cc_idx,
+                          cqi_value.subband_ue_diff.position_subband,
+                          (uint32_t)(stack_value + cqi_value.subband_ue_diff.subband_diff_cqi),
+                          0,
+                          0});
       break;
   }
 }
@@ -660,31 +696,31 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
                              uint16_t                  rnti,
                              uint32_t                  enb_cc_idx,
                              const srsran_uci_cfg_t&   uci_cfg,
-                             const srsran_uci_value_t& uci_value)
+                             const srsran_uci_value_t& uci_value,
+                             ul_feedback_list_t&       feedback)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  ue_db_t::read_guard            ue_lock(ue_db);
+  srsran::rcu_domain::read_guard cfg_lock(cfg_rcu);
 
   // Assert UE RNTI database entry and eNb cell/carrier must be active
-  if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
-  }
-
-  // Assert Stack
-  if (_assert_stack() != SRSRAN_SUCCESS) {
+  common_ue* ue_ptr = ue_db.find(rnti);
+  if (ue_ptr == nullptr or _assert_active_enb_cc(_get_cfg(*ue_ptr), enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Notify SR
   if (uci_cfg.is_scheduling_request_tti && uci_value.scheduling_request) {
-    stack->sr_detected(tti, rnti);
+    feedback.push_back({ul_feedback_t::sr, rnti, 0, 0, 0, 0, 0});
   }
 
   // Get UE
-  common_ue& ue = ue_db.at(rnti);
+  common_ue&                  ue  = *ue_ptr;
+  const ue_cfg_t&             cfg = _get_cfg(ue);
+  std::lock_guard<std::mutex> lock(ue.mutex);
 
   // Get ACK info
-  srsran_pdsch_ack_t& pdsch_ack = ue.pdsch_ack[tti];
-  const srsran_cell_t& cell      = cell_cfg_list->at(ue.cell_info[0].enb_cc_idx).cell;
+  srsran_pdsch_ack_t&  pdsch_ack = ue.pdsch_ack[tti];
+  const srsran_cell_t& cell      = cell_cfg_list->at(cfg.cell_info[0].enb_cc_idx).cell;
   srsran_enb_dl_get_ack(&cell, &uci_cfg, &uci_value, &pdsch_ack);
 
   // Iterate over the ACK information
@@ -694,7 +730,13 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
       if (pdsch_ack_cc.m[m].present) {
         for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
           if (pdsch_ack_cc.m[m].value[tb] != 2) {
-            stack->ack_info(tti, rnti, ue.cell_info[ue_cc_idx].enb_cc_idx, tb, pdsch_ack_cc.m[m].value[tb] == 1);
+            feedback.push_back({ul_feedback_t::dl_ack,
+                                rnti,
+                                cfg.cell_info[ue_cc_idx].enb_cc_idx,
+                                tb,
+                                (uint32_t)(pdsch_ack_cc.m[m].value[tb] == 1),
+                                0,
+                                0});
           }
         }
       }
@@ -702,19 +744,19 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
   }
 
   // Assert the SCell exists and it is active
-  if (_assert_ue_cc(rnti, uci_cfg.cqi.scell_index) != SRSRAN_SUCCESS) {
+  if (_assert_ue_cc(cfg, uci_cfg.cqi.scell_index) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Get CQI carrier index
-  cell_info_t& cqi_scell_info = ue_db.at(rnti).cell_info[uci_cfg.cqi.scell_index];
-  uint32_t     cqi_cc_idx     = cqi_scell_info.enb_cc_idx;
+  uint32_t cqi_cc_idx = cfg.cell_info[uci_cfg.cqi.scell_index].enb_cc_idx;
 
   // Notify CQI only if CRC is valid
   if (uci_value.cqi.data_crc) {
     // Channel quality indicator itself
     if (uci_cfg.cqi.data_enable) {
-      send_cqi_data(tti, rnti, cqi_cc_idx, uci_cfg.cqi, uci_value.cqi, ue.cell_info[0].phy_cfg.dl_cfg.cqi_report, cell, stack);
+      send_cqi_data(
+          tti, rnti, cqi_cc_idx, uci_cfg.cqi, uci_value.cqi, cfg.cell_info[0].phy_cfg.dl_cfg.cqi_report, cell, feedback);
     }
 
     // Precoding Matrix indicator (TM4)
@@ -731,14 +773,14 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
           ERROR("CQI type=%d not implemented for PMI", uci_cfg.cqi.type);
           break;
       }
-      stack->pmi_info(tti, rnti, cqi_cc_idx, pmi_value);
+      feedback.push_back({ul_feedback_t::dl_pmi, rnti, cqi_cc_idx, 0, pmi_value, 0, 0});
     }
   }
 
   // Rank indicator (TM3 and TM4)
   if (uci_cfg.cqi.ri_len) {
-    stack->ri_info(tti, rnti, cqi_cc_idx, uci_value.ri);
-    cqi_scell_info.last_ri = uci_value.ri;
+    feedback.push_back({ul_feedback_t::dl_ri, rnti, cqi_cc_idx, 0, uci_value.ri, 0, 0});
+    ue.cell_state[uci_cfg.cqi.scell_index].last_ri = uci_value.ri;
   }
 
   return SRSRAN_SUCCESS;
@@ -746,45 +788,53 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
 
 int phy_ue_db::set_last_ul_tb(uint16_t rnti, uint32_t enb_cc_idx, uint32_t pid, srsran_ra_tb_t tb)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  ue_db_t::read_guard            ue_lock(ue_db);
+  srsran::rcu_domain::read_guard cfg_lock(cfg_rcu);
 
   // Assert UE DB entry
-  if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  common_ue* ue = ue_db.find(rnti);
+  if (ue == nullptr or _assert_active_enb_cc(_get_cfg(*ue), enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Save resource allocation
-  ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].last_tb[pid] = tb;
+  std::lock_guard<std::mutex> lock(ue->mutex);
+  ue->cell_state[_get_ue_cc_idx(_get_cfg(*ue), enb_cc_idx)].last_tb[pid] = tb;
 
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::get_last_ul_tb(uint16_t rnti, uint32_t enb_cc_idx, uint32_t pid, srsran_ra_tb_t& ra_tb) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  ue_db_t::read_guard            ue_lock(ue_db);
+  srsran::rcu_domain::read_guard cfg_lock(cfg_rcu);
 
   // Assert UE DB entry
-  if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  common_ue* ue = ue_db.find(rnti);
+  if (ue == nullptr or _assert_active_enb_cc(_get_cfg(*ue), enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // writes the latest stored UL transmission grant
-  ra_tb = ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].last_tb[pid];
+  std::lock_guard<std::mutex> lock(ue->mutex);
+  ra_tb = ue->cell_state[_get_ue_cc_idx(_get_cfg(*ue), enb_cc_idx)].last_tb[pid];
 
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::set_ul_grant_available(uint32_t tti, const stack_interface_phy_lte::ul_sched_list_t& ul_sched_list)
 {
-  int                         ret = SRSRAN_SUCCESS;
-  std::lock_guard<std::mutex> lock(mutex);
+  int                            ret = SRSRAN_SUCCESS;
+  ue_db_t::read_guard            ue_lock(ue_db);
+  srsran::rcu_domain::read_guard cfg_lock(cfg_rcu);
 
   // Reset all available grants flags for the given TTI
-  for (auto& ue : ue_db) {
-    for (cell_info_t& cell_info : ue.second.cell_info) {
-      cell_info.is_grant_available[tti] = false;
+  ue_db.for_each([tti](uint16_t rnti, common_ue& ue) {
+    std::lock_guard<std::mutex> lock(ue.mutex);
+    for (cell_tti_state_t& cell_state : ue.cell_state) {
+      cell_state.is_grant_available[tti] = false;
     }
-  }
+  });
 
   // For each eNb Cell/Carrier grant set a flag to the corresponding RNTI
   for (uint32_t enb_cc_idx = 0; enb_cc_idx < (uint32_t)ul_sched_list.size(); enb_cc_idx++) {
@@ -793,13 +843,15 @@ int phy_ue_db::set_ul_grant_available(uint32_t tti, const stack_interface_phy_lt
       const stack_interface_phy_lte::ul_sched_grant_t& ul_sched_grant = ul_sched.pusch[i];
       uint16_t                                         rnti           = ul_sched_grant.dci.rnti;
       // Check that eNb Cell/Carrier is active for the given RNTI
-      if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+      common_ue* ue = ue_db.find(rnti);
+      if (ue == nullptr or _assert_active_enb_cc(_get_cfg(*ue), enb_cc_idx) != SRSRAN_SUCCESS) {
         ret = SRSRAN_ERROR;
         srslog::fetch_basic_logger("PHY").info("Error setting grant for rnti=0x%x, cc=%d", rnti, enb_cc_idx);
         continue;
       }
       // Rise Grant available flag
-      ue_db[rnti].cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].is_grant_available[tti] = true;
+      std::lock_guard<std::mutex> lock(ue->mutex);
+      ue->cell_state[_get_ue_cc_idx(_get_cfg(*ue), enb_cc_idx)].is_grant_available[tti] = true;
     }
   }
 
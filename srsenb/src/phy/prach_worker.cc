@@ -29,12 +29,14 @@ int prach_worker::init(const srsran_cell_t&      cell_,
                        const srsran_prach_cfg_t& prach_cfg_,
                        stack_interface_phy_lte*  stack_,
                        int                       priority,
-                       uint32_t                  nof_workers_)
+                       uint32_t                  nof_workers_,
+                       srsran::task_thread_pool* shared_pool_)
 {
   stack       = stack_;
   prach_cfg   = prach_cfg_;
   cell        = cell_;
   nof_workers = nof_workers_;
+  shared_pool = shared_pool_;
 
   max_prach_offset_us = 50;
 
@@ -51,7 +53,7 @@ int prach_worker::init(const srsran_cell_t&      cell_,
 
   nof_sf = (uint32_t)ceilf(prach.T_tot * 1000);
 
-  if (nof_workers > 0) {
+  if (nof_workers > 0 && shared_pool == nullptr) {
     start(priority);
   }
 
@@ -80,11 +82,10 @@ int prach_worker::init(const srsran_cell_t&      cell_,
 
 void prach_worker::stop()
 {
-  running      = false;
-  sf_buffer* s = nullptr;
-  pending_buffers.push(s);
-
-  if (nof_workers > 0) {
+  running = false;
+  if (shared_pool == nullptr && nof_workers > 0) {
+    sf_buffer* s = nullptr;
+    pending_buffers.push_blocking(s);
     wait_thread_finish();
   }
 
@@ -126,12 +127,15 @@ int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx)
     sf_cnt++;
     if (sf_cnt == nof_sf) {
       sf_cnt = 0;
-      if (nof_workers == 0) {
+      if (shared_pool != nullptr) {
+        sf_buffer* b = current_buffer;
+        shared_pool->push_task([this, b]() { run_shared_tti(b); }, srsran::task_thread_pool::task_priority::high);
+      } else if (nof_workers == 0) {
         run_tti(current_buffer);
         current_buffer->reset();
         buffer_pool.deallocate(current_buffer);
       } else {
-        pending_buffers.push(current_buffer);
+        pending_buffers.push_blocking(current_buffer);
       }
     }
   }
@@ -184,11 +188,21 @@ int prach_worker::run_tti(sf_buffer* b)
   return 0;
 }
 
+void prach_worker::run_shared_tti(sf_buffer* b)
+{
+  {
+    std::lock_guard<std::mutex> lock(detect_mutex);
+    run_tti(b);
+  }
+  b->reset();
+  buffer_pool.deallocate(b);
+}
+
 void prach_worker::run_thread()
 {
   running = true;
   while (running) {
-    sf_buffer* b = pending_buffers.wait_pop();
+    sf_buffer* b = pending_buffers.pop_blocking();
     if (running && b) {
       int ret = run_tti(b);
       b->reset();
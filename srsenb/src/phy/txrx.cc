@@ -24,6 +24,7 @@
 #include "srsenb/hdr/phy/txrx.h"
 #include "srsran/common/band_helper.h"
 #include "srsran/common/threads.h"
+#include "srsran/srslog/event_trace.h"
 #include "srsran/srsran.h"
 
 #define Error(fmt, ...)                                                                                                \
@@ -60,15 +61,23 @@ bool txrx::init(enb_time_interface*          enb_,
   lte_workers = lte_workers_;
   worker_com  = worker_com_;
   prach       = prach_;
+  prio        = prio_;
   running     = true;
 
+  // Set up the pipelined reception
+  rx_prefetch_sf = worker_com->params.rx_prefetch_sf;
+  if (rx_prefetch_sf > 0) {
+    rx_sf_pool = std::unique_ptr<rx_sf_t[]>(new rx_sf_t[rx_prefetch_sf + 2]);
+    rx_sf_queue.set_size(rx_prefetch_sf);
+  }
+
   // Instantiate UL channel emulator
   if (worker_com->params.ul_channel_args.enable) {
     ul_channel = srsran::channel_ptr(
         new srsran::channel(worker_com->params.ul_channel_args, worker_com->get_nof_rf_channels(), logger));
   }
 
-  start(prio_);
+  start(prio);
   return true;
 }
 
@@ -86,12 +95,8 @@ void txrx::stop()
   }
 }
 
-void txrx::run_thread()
+void txrx::configure_radio()
 {
-  srsran::rf_buffer_t    buffer    = {};
-  srsran::rf_timestamp_t timestamp = {};
-  uint32_t               sf_len    = SRSRAN_SF_LEN_PRB(worker_com->get_nof_prb(0));
-
   float samp_rate = srsran_sampling_freq_hz(worker_com->get_nof_prb(0));
 
   srsran::srsran_band_helper band_helper;
@@ -130,115 +135,188 @@ void txrx::run_thread()
   if (ul_channel) {
     ul_channel->set_srate(static_cast<uint32_t>(samp_rate));
   }
+}
 
-  logger.info("Starting RX/TX thread nof_prb=%d, sf_len=%d", worker_com->get_nof_prb(0), sf_len);
-
-  // Set TTI so that first TX is at tti=0
-  tti = TTI_SUB(0, FDD_HARQ_DELAY_UL_MS + 1);
-
-  // Main loop
-  while (running) {
-    tti = TTI_ADD(tti, 1);
-    logger.set_context(tti);
-
-    lte::sf_worker* lte_worker = nullptr;
-    if (worker_com->get_nof_carriers_lte() > 0) {
-      lte_worker = lte_workers->wait_worker(tti);
-      if (lte_worker == nullptr) {
-        // wait_worker() only returns NULL if it's being closed. Quit now to avoid unnecessary loops here
-        running = false;
-        continue;
-      }
+bool txrx::receive_sf(uint32_t tti_rx, rx_sf_t& sf)
+{
+  trace_hot_scope_arg("txrx", "receive_sf", tti_rx);
+  uint32_t sf_len = SRSRAN_SF_LEN_PRB(worker_com->get_nof_prb(0));
+
+  sf.tti        = tti_rx;
+  sf.lte_worker = nullptr;
+  sf.nr_worker  = nullptr;
+  sf.valid      = false;
+
+  if (worker_com->get_nof_carriers_lte() > 0) {
+    sf.lte_worker = lte_workers->wait_worker(tti_rx);
+    if (sf.lte_worker == nullptr) {
+      // wait_worker() only returns NULL if it's being closed. Quit now to avoid unnecessary loops here
+      return false;
     }
+  }
 
-    nr::slot_worker* nr_worker = nullptr;
-    if (nr_workers != nullptr and worker_com->get_nof_carriers_nr() > 0) {
-      nr_worker = nr_workers->wait_worker(tti);
-      if (nr_worker == nullptr) {
-        running = false;
-        continue;
-      }
+  if (nr_workers != nullptr and worker_com->get_nof_carriers_nr() > 0) {
+    sf.nr_worker = nr_workers->wait_worker(tti_rx);
+    if (sf.nr_worker == nullptr) {
+      return false;
     }
+  }
 
-    // Multiple cell buffer mapping
-    {
-      uint32_t cc = 0;
-      for (uint32_t cc_lte = 0; cc_lte < worker_com->get_nof_carriers_lte(); cc_lte++, cc++) {
-        uint32_t rf_port = worker_com->get_rf_port(cc);
+  // Multiple cell buffer mapping
+  {
+    uint32_t cc = 0;
+    for (uint32_t cc_lte = 0; cc_lte < worker_com->get_nof_carriers_lte(); cc_lte++, cc++) {
+      uint32_t rf_port = worker_com->get_rf_port(cc);
 
-        for (uint32_t p = 0; p < worker_com->get_nof_ports(cc); p++) {
-          // WARNING: The number of ports for all cells must be the same
-          buffer.set(rf_port, p, worker_com->get_nof_ports(0), lte_worker->get_buffer_rx(cc_lte, p));
-        }
+      for (uint32_t p = 0; p < worker_com->get_nof_ports(cc); p++) {
+        // WARNING: The number of ports for all cells must be the same
+        sf.buffer.set(rf_port, p, worker_com->get_nof_ports(0), sf.lte_worker->get_buffer_rx(cc_lte, p));
       }
-      for (uint32_t cc_nr = 0; cc_nr < worker_com->get_nof_carriers_nr(); cc_nr++, cc++) {
-        uint32_t rf_port = worker_com->get_rf_port(cc);
-
-        for (uint32_t p = 0; p < worker_com->get_nof_ports(cc); p++) {
-          // WARNING:
-          // - The number of ports for all cells must be the same
-          // - Only one NR cell is currently supported
-          if (nr_worker != nullptr) {
-            buffer.set(rf_port, p, worker_com->get_nof_ports(0), nr_worker->get_buffer_rx(p));
-          }
+    }
+    for (uint32_t cc_nr = 0; cc_nr < worker_com->get_nof_carriers_nr(); cc_nr++, cc++) {
+      uint32_t rf_port = worker_com->get_rf_port(cc);
+
+      for (uint32_t p = 0; p < worker_com->get_nof_ports(cc); p++) {
+        // WARNING:
+        // - The number of ports for all cells must be the same
+        // - Only one NR cell is currently supported
+        if (sf.nr_worker != nullptr) {
+          sf.buffer.set(rf_port, p, worker_com->get_nof_ports(0), sf.nr_worker->get_buffer_rx(p));
         }
       }
     }
+  }
 
-    buffer.set_nof_samples(sf_len);
-    radio_h->rx_now(buffer, timestamp);
+  sf.buffer.set_nof_samples(sf_len);
+  radio_h->rx_now(sf.buffer, sf.timestamp);
 
-    if (ul_channel) {
-      ul_channel->run(buffer.to_cf_t(), buffer.to_cf_t(), sf_len, timestamp.get(0));
-    }
+  if (ul_channel) {
+    ul_channel->run(sf.buffer.to_cf_t(), sf.buffer.to_cf_t(), sf_len, sf.timestamp.get(0));
+  }
 
-    // Compute TX time: Any transmission happens in TTI+4 thus advance 4 ms the reception time
-    timestamp.add(FDD_HARQ_DELAY_UL_MS * 1e-3);
+  // The subframe is fully received 1 ms after its start, this is the reference for the slack of the workers
+  srsran_timestamp_t rx_end_time = sf.timestamp.get(0);
+  srsran_timestamp_add(&rx_end_time, 0, 1e-3);
+  worker_com->set_rx_end_time(rx_end_time);
 
-    Debug("Setting TTI=%d, tx_time=%ld:%f to worker %d",
-          tti,
-          timestamp.get(0).full_secs,
-          timestamp.get(0).frac_secs,
-          lte_worker ? lte_worker->get_id() : 0);
+  // Compute TX time: Any transmission happens in TTI+4 thus advance 4 ms the reception time
+  sf.timestamp.add(FDD_HARQ_DELAY_UL_MS * 1e-3);
 
-    // Trigger prach worker execution
-    for (uint32_t cc = 0; cc < worker_com->get_nof_carriers_lte(); cc++) {
-      prach->new_tti(cc, tti, buffer.get(worker_com->get_rf_port(cc), 0, worker_com->get_nof_ports(0)));
-    }
+  sf.valid = true;
+  return true;
+}
+
+void txrx::dispatch_sf(rx_sf_t& sf)
+{
+  trace_hot_scope_arg("txrx", "dispatch_sf", sf.tti);
+  logger.set_context(sf.tti);
+
+  Debug("Setting TTI=%d, tx_time=%ld:%f to worker %d",
+        sf.tti,
+        sf.timestamp.get(0).full_secs,
+        sf.timestamp.get(0).frac_secs,
+        sf.lte_worker ? sf.lte_worker->get_id() : 0);
+
+  // Trigger prach worker execution
+  for (uint32_t cc = 0; cc < worker_com->get_nof_carriers_lte(); cc++) {
+    prach->new_tti(cc, sf.tti, sf.buffer.get(worker_com->get_rf_port(cc), 0, worker_com->get_nof_ports(0)));
+  }
+
+  // Set NR worker context and start
+  if (sf.nr_worker != nullptr) {
+    srsran::phy_common_interface::worker_context_t context;
+    context.sf_idx     = sf.tti;
+    context.worker_ptr = sf.nr_worker;
+    context.last       = (sf.lte_worker == nullptr); // Set last if standalone
+    context.tx_time.copy(sf.timestamp);
+
+    sf.nr_worker->set_context(context);
+
+    // Start NR worker processing
+    worker_com->semaphore.push(sf.nr_worker);
+    nr_workers->start_worker(sf.nr_worker);
+  }
+
+  // Set LTE worker context and start
+  if (sf.lte_worker != nullptr) {
+    srsran::phy_common_interface::worker_context_t context;
+    context.sf_idx     = sf.tti;
+    context.worker_ptr = sf.lte_worker;
+    context.last       = true;
+    context.tx_time.copy(sf.timestamp);
 
-    // Set NR worker context and start
-    if (nr_worker != nullptr) {
-      srsran::phy_common_interface::worker_context_t context;
-      context.sf_idx     = tti;
-      context.worker_ptr = nr_worker;
-      context.last       = (lte_worker == nullptr); // Set last if standalone
-      context.tx_time.copy(timestamp);
+    sf.lte_worker->set_context(context);
 
-      nr_worker->set_context(context);
+    // Start LTE worker processing
+    worker_com->semaphore.push(sf.lte_worker);
+    lte_workers->start_worker(sf.lte_worker);
+  }
 
-      // Start NR worker processing
-      worker_com->semaphore.push(nr_worker);
-      nr_workers->start_worker(nr_worker);
+  // Advance in time
+  enb->tti_clock();
+}
+
+void txrx::run_rx_thread()
+{
+  uint32_t rx_tti = tti;
+  uint32_t idx    = 0;
+  while (running) {
+    rx_tti      = TTI_ADD(rx_tti, 1);
+    rx_sf_t* sf = &rx_sf_pool[idx];
+    if (not receive_sf(rx_tti, *sf)) {
+      running = false;
+      break;
     }
+    rx_sf_queue.push_blocking(sf);
+    idx = (idx + 1) % (rx_prefetch_sf + 2);
+  }
 
-    // Set LTE worker context and start
-    if (lte_worker != nullptr) {
-      srsran::phy_common_interface::worker_context_t context;
-      context.sf_idx     = tti;
-      context.worker_ptr = lte_worker;
-      context.last       = true;
-      context.tx_time.copy(timestamp);
+  // Let the dispatching know that nothing else is coming
+  rx_sf_t* sf = &rx_sf_pool[idx];
+  sf->valid   = false;
+  rx_sf_queue.push_blocking(sf);
+}
 
-      lte_worker->set_context(context);
+void txrx::run_thread()
+{
+  configure_radio();
 
-      // Start LTE worker processing
-      worker_com->semaphore.push(lte_worker);
-      lte_workers->start_worker(lte_worker);
+  logger.info("Starting RX/TX thread nof_prb=%d, sf_len=%d, rx_prefetch_sf=%d",
+              worker_com->get_nof_prb(0),
+              SRSRAN_SF_LEN_PRB(worker_com->get_nof_prb(0)),
+              rx_prefetch_sf);
+
+  // Set TTI so that first TX is at tti=0
+  tti = TTI_SUB(0, FDD_HARQ_DELAY_UL_MS + 1);
+
+  if (rx_prefetch_sf == 0) {
+    // Main loop, receive and dispatch one subframe at a time
+    rx_sf_t sf;
+    while (running) {
+      tti = TTI_ADD(tti, 1);
+      logger.set_context(tti);
+      if (not receive_sf(tti, sf)) {
+        running = false;
+        continue;
+      }
+      dispatch_sf(sf);
     }
+    return;
+  }
 
-    // Advance in time
-    enb->tti_clock();
+  // Pipelined loop, the radio thread receives ahead while this one dispatches. After stopping, every subframe the
+  // radio thread has received is still dispatched so that no worker is left reserved
+  rx_thread = std::unique_ptr<rx_thread_t>(new rx_thread_t(this));
+  rx_thread->start(prio);
+  while (true) {
+    rx_sf_t* sf = rx_sf_queue.pop_blocking();
+    if (sf == nullptr or not sf->valid) {
+      break;
+    }
+    tti = sf->tti;
+    dispatch_sf(*sf);
   }
+  rx_thread->wait_thread_finish();
 }
 
 } // namespace srsenb
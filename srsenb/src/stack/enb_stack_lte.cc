@@ -100,11 +100,13 @@ int enb_stack_lte::init(const stack_args_t&      args_,
 
   // Set up pcap and trace
   if (args.mac_pcap.enable) {
-    mac_pcap.open(args.mac_pcap.filename);
+    mac_pcap.set_filter(args.mac_pcap_filter);
+    mac_pcap.open(args.mac_pcap.filename, 0, args.pcap_writer);
     mac.start_pcap(&mac_pcap);
   }
 
   if (args.mac_pcap_net.enable) {
+    mac_pcap_net.set_filter(args.mac_pcap_filter);
     mac_pcap_net.open(args.mac_pcap_net.client_ip,
                       args.mac_pcap_net.bind_ip,
                       args.mac_pcap_net.client_port,
@@ -113,7 +115,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
   }
 
   if (args.s1ap_pcap.enable) {
-    s1ap_pcap.open(args.s1ap_pcap.filename.c_str());
+    s1ap_pcap.open(args.s1ap_pcap.filename.c_str(), args.pcap_writer);
     s1ap.start_pcap(&s1ap_pcap);
   }
 
@@ -134,8 +136,14 @@ int enb_stack_lte::init(const stack_args_t&      args_,
     return SRSRAN_ERROR;
   }
   rlc.init(&pdcp, &rrc, &mac, task_sched.get_timer_handler());
-  pdcp.init(&rlc, &rrc, gtpu_adapter.get());
-  if (rrc.init(rrc_cfg, phy, &mac, &rlc, &pdcp, &s1ap, &gtpu, x2_) != SRSRAN_SUCCESS) {
+  if (args.nof_pdcp_crypto_threads > 0) {
+    pdcp_crypto_pool.reset(new srsran::task_thread_pool(args.nof_pdcp_crypto_threads));
+  }
+  pdcp.init(&rlc, &rrc, gtpu_adapter.get(), pdcp_crypto_pool.get());
+  if (args.nof_rrc_ue_threads > 0) {
+    rrc_ue_pool.reset(new srsran::task_thread_pool(args.nof_rrc_ue_threads));
+  }
+  if (rrc.init(rrc_cfg, phy, &mac, &rlc, &pdcp, &s1ap, &gtpu, x2_, rrc_ue_pool.get()) != SRSRAN_SUCCESS) {
     stack_logger.error("Couldn't initialize RRC");
     return SRSRAN_ERROR;
   }
@@ -151,6 +159,8 @@ int enb_stack_lte::init(const stack_args_t&      args_,
   gtpu_args.mme_addr                     = args.s1ap.mme_addr;
   gtpu_args.gtp_bind_addr                = args.s1ap.gtp_bind_addr;
   gtpu_args.indirect_tunnel_timeout_msec = args.gtpu_indirect_tunnel_timeout_msec;
+  gtpu_args.xdp_ifname                   = args.gtpu_xdp_ifname;
+  gtpu_args.xdp_queue_id                 = args.gtpu_xdp_queue_id;
   if (gtpu.init(gtpu_args, gtpu_adapter.get()) != SRSRAN_SUCCESS) {
     stack_logger.error("Couldn't initialize GTPU");
     return SRSRAN_ERROR;
@@ -173,6 +183,7 @@ void enb_stack_lte::tti_clock_impl()
 {
   task_sched.tic();
   rrc.tti_clock();
+  mac.tti_clock();
 }
 
 void enb_stack_lte::stop()
@@ -192,7 +203,13 @@ void enb_stack_lte::stop_impl()
   mac.stop();
   rlc.stop();
   pdcp.stop();
+  if (pdcp_crypto_pool != nullptr) {
+    pdcp_crypto_pool->stop();
+  }
   rrc.stop();
+  if (rrc_ue_pool != nullptr) {
+    rrc_ue_pool->stop();
+  }
 
   if (args.mac_pcap.enable) {
     mac_pcap.close();
@@ -246,11 +263,14 @@ void enb_stack_lte::run_thread()
 
 void enb_stack_lte::write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu)
 {
-  // call GTPU adapter to map to EPS bearer
-  auto task = [this, rnti, lcid](srsran::unique_byte_buffer_t& pdu) {
-    gtpu_adapter->write_pdu(rnti, lcid, std::move(pdu));
-  };
-  x2_task_queue.push(std::bind(task, std::move(pdu)));
+  if (x2_ul_channel.push(rnti, lcid, std::move(pdu))) {
+    x2_task_queue.push([this]() {
+      // call GTPU adapter to map to EPS bearer
+      x2_ul_channel.drain([this](uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu, int) {
+        gtpu_adapter->write_pdu(rnti, lcid, std::move(pdu));
+      });
+    });
+  }
 }
 
 } // namespace srsenb
@@ -19,6 +19,7 @@
  *
  */
 
+#include <algorithm>
 #include <pthread.h>
 #include <string.h>
 
@@ -80,9 +81,12 @@ bool mac::init(const mac_args_t&        args_,
   }
 
   // Initiate common pool of softbuffers
-  uint32_t nof_prb          = args.nof_prb;
-  auto     init_softbuffers = [nof_prb](void* ptr) {
-    new (ptr) ue_cc_softbuffers(nof_prb, SRSRAN_FDD_NOF_HARQ, SRSRAN_FDD_NOF_HARQ);
+  uint32_t                    nof_prb = args.nof_prb;
+  srsran_softbuffer_rx_args_t rx_args = {};
+  rx_args.llr_is_8bit                 = args.ul_softbuffer_8bit;
+  rx_args.lazy_alloc                  = args.ul_softbuffer_lazy_alloc;
+  auto init_softbuffers               = [nof_prb, rx_args](void* ptr) {
+    new (ptr) ue_cc_softbuffers(nof_prb, SRSRAN_FDD_NOF_HARQ, SRSRAN_FDD_NOF_HARQ, rx_args);
   };
   auto recycle_softbuffers = [](ue_cc_softbuffers& softbuffers) { softbuffers.clear(); };
   softbuffer_pool.reset(new srsran::background_obj_pool<ue_cc_softbuffers>(
@@ -113,22 +117,18 @@ void mac::stop()
 
 void mac::start_pcap(srsran::mac_pcap* pcap_)
 {
-  srsran::rwlock_read_guard lock(rwlock);
+  ue_db_t::read_guard lock(ue_db);
   pcap = pcap_;
   // Set pcap in all UEs for UL messages
-  for (auto& u : ue_db) {
-    u.second->start_pcap(pcap);
-  }
+  ue_db.for_each([this](uint16_t rnti, ue& u) { u.start_pcap(pcap); });
 }
 
 void mac::start_pcap_net(srsran::mac_pcap_net* pcap_net_)
 {
-  srsran::rwlock_read_guard lock(rwlock);
+  ue_db_t::read_guard lock(ue_db);
   pcap_net = pcap_net_;
   // Set pcap in all UEs for UL messages
-  for (auto& u : ue_db) {
-    u.second->start_pcap_net(pcap_net);
-  }
+  ue_db.for_each([this](uint16_t rnti, ue& u) { u.start_pcap_net(pcap_net); });
 }
 
 /********************************************************
@@ -139,10 +139,10 @@ void mac::start_pcap_net(srsran::mac_pcap_net* pcap_net_)
 
 int mac::rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t retx_queue)
 {
-  int                       ret = -1;
-  if (check_ue_active(rnti)) {
+  int                 ret = -1;
+  ue_db_t::read_guard lock(ue_db);
+  if (find_active_ue(rnti) != nullptr) {
     if (rnti != SRSRAN_MRNTI) {
-      srsran::rwlock_read_guard lock(rwlock);
       ret = scheduler.dl_rlc_buffer_state(rnti, lc_id, tx_queue, retx_queue);
     } else {
       task_sched.defer_callback(0, [this, tx_queue, lc_id]() {
@@ -161,14 +161,14 @@ int mac::rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint
 
 int mac::bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, mac_lc_ch_cfg_t* cfg)
 {
-  srsran::rwlock_read_guard lock(rwlock);
-  return check_ue_active(rnti) ? scheduler.bearer_ue_cfg(rnti, lc_id, *cfg) : -1;
+  ue_db_t::read_guard lock(ue_db);
+  return find_active_ue(rnti) != nullptr ? scheduler.bearer_ue_cfg(rnti, lc_id, *cfg) : -1;
 }
 
 int mac::bearer_ue_rem(uint16_t rnti, uint32_t lc_id)
 {
-  srsran::rwlock_read_guard lock(rwlock);
-  return check_ue_active(rnti) ? scheduler.bearer_ue_rem(rnti, lc_id) : -1;
+  ue_db_t::read_guard lock(ue_db);
+  return find_active_ue(rnti) != nullptr ? scheduler.bearer_ue_rem(rnti, lc_id) : -1;
 }
 
 void mac::phy_config_enabled(uint16_t rnti, bool enabled)
@@ -179,11 +179,11 @@ void mac::phy_config_enabled(uint16_t rnti, bool enabled)
 // Update UE configuration
 int mac::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t* cfg)
 {
-  srsran::rwlock_read_guard lock(rwlock);
-  if (not check_ue_active(rnti)) {
+  ue_db_t::read_guard lock(ue_db);
+  ue*                 ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
-  ue* ue_ptr = ue_db[rnti].get();
 
   // Start TA FSM in UE entity
   ue_ptr->start_ta();
@@ -205,13 +205,12 @@ int mac::ue_rem(uint16_t rnti)
 {
   // Remove UE from the perspective of L2/L3
   {
-    srsran::rwlock_read_guard lock(rwlock);
-    if (check_ue_active(rnti)) {
-      ue_db[rnti]->set_active(false);
-    } else {
-      logger.error("User rnti=0x%x not found", rnti);
+    ue_db_t::read_guard lock(ue_db);
+    ue*                 ue_ptr = find_active_ue(rnti);
+    if (ue_ptr == nullptr) {
       return SRSRAN_ERROR;
     }
+    ue_ptr->set_active(false);
   }
   scheduler.ue_rem(rnti);
 
@@ -219,7 +218,6 @@ int mac::ue_rem(uint16_t rnti)
   // Note: Let any pending retx ACK to arrive, so that PHY recognizes rnti
   task_sched.defer_callback(FDD_HARQ_DELAY_DL_MS + FDD_HARQ_DELAY_UL_MS, [this, rnti]() {
     phy_h->rem_rnti(rnti);
-    srsran::rwlock_write_guard lock(rwlock);
     ue_db.erase(rnti);
     logger.info("User rnti=0x%x removed from MAC/PHY", rnti);
   });
@@ -229,7 +227,6 @@ int mac::ue_rem(uint16_t rnti)
 // Called after Msg3
 int mac::ue_set_crnti(uint16_t temp_crnti, uint16_t crnti, const sched_interface::ue_cfg_t& cfg)
 {
-  srsran::rwlock_read_guard lock(rwlock);
   if (temp_crnti == crnti) {
     // Schedule ConRes Msg4
     scheduler.dl_mac_buffer_state(crnti, (uint32_t)srsran::dl_sch_lcid::CON_RES_ID);
@@ -247,18 +244,19 @@ int mac::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg_)
 void mac::get_metrics(mac_metrics_t& metrics)
 {
   srsran::rwlock_read_guard lock(rwlock);
+  ue_db_t::read_guard       ue_lock(ue_db);
   metrics.ues.reserve(ue_db.size());
-  for (auto& u : ue_db) {
-    if (not scheduler.ue_exists(u.first)) {
-      continue;
+  ue_db.for_each([this, &metrics](uint16_t rnti, ue& u) {
+    if (not scheduler.ue_exists(rnti)) {
+      return;
     }
     metrics.ues.emplace_back();
     auto& ue_metrics = metrics.ues.back();
 
-    u.second->metrics_read(&ue_metrics);
-    scheduler.metrics_read(u.first, ue_metrics);
+    u.metrics_read(&ue_metrics);
+    scheduler.metrics_read(rnti, ue_metrics);
     ue_metrics.pci = (ue_metrics.cc_idx < cell_config.size()) ? cell_config[ue_metrics.cc_idx].cell.id : 0;
-  }
+  });
   metrics.cc_info.resize(detected_rachs.size());
   for (unsigned cc = 0, e = detected_rachs.size(); cc != e; ++cc) {
     metrics.cc_info[cc].cc_rach_counter = detected_rachs[cc];
@@ -266,6 +264,16 @@ void mac::get_metrics(mac_metrics_t& metrics)
   }
 }
 
+void mac::tti_clock()
+{
+  if (started) {
+    kpi_sampler.push_sample();
+  }
+  if (args.sched.lookahead_ttis > 0) {
+    scheduler.precompute_ttis();
+  }
+}
+
 void mac::toggle_padding()
 {
   do_padding = !do_padding;
@@ -273,13 +281,11 @@ void mac::toggle_padding()
 
 void mac::add_padding()
 {
-  srsran::rwlock_read_guard lock(rwlock);
-  for (auto it = ue_db.begin(); it != ue_db.end(); ++it) {
-    uint16_t cur_rnti = it->first;
-    auto     ue       = it;
-    scheduler.dl_rlc_buffer_state(ue->first, args.lcid_padding, 20e6, 0);
-    ue->second->trigger_padding(args.lcid_padding);
-  }
+  ue_db_t::read_guard lock(ue_db);
+  ue_db.for_each([this](uint16_t rnti, ue& u) {
+    scheduler.dl_rlc_buffer_state(rnti, args.lcid_padding, 20e6, 0);
+    u.trigger_padding(args.lcid_padding);
+  });
 }
 
 /********************************************************
@@ -291,14 +297,15 @@ void mac::add_padding()
 int mac::ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
 {
   logger.set_context(tti_rx);
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  ue_db_t::read_guard lock(ue_db);
+  ue*                 ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
   int nof_bytes = scheduler.dl_ack_info(tti_rx, rnti, enb_cc_idx, tb_idx, ack);
-  ue_db[rnti]->metrics_tx(ack, nof_bytes);
+  ue_ptr->metrics_tx(ack, nof_bytes);
+  kpi_sampler.add_dl_harq_feedback(ack, nof_bytes);
 
   rrc_h->set_radiolink_dl_state(rnti, ack);
 
@@ -308,14 +315,15 @@ int mac::ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
 int mac::crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t nof_bytes, bool crc)
 {
   logger.set_context(tti_rx);
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  ue_db_t::read_guard lock(ue_db);
+  ue*                 ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
-  ue_db[rnti]->set_tti(tti_rx);
-  ue_db[rnti]->metrics_rx(crc, nof_bytes);
+  ue_ptr->set_tti(tti_rx);
+  ue_ptr->metrics_rx(crc, nof_bytes);
+  kpi_sampler.add_ul_crc(crc, nof_bytes);
 
   rrc_h->set_radiolink_ul_state(rnti, crc);
 
@@ -323,6 +331,71 @@ int mac::crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
   return scheduler.ul_crc_info(tti_rx, rnti, enb_cc_idx, crc);
 }
 
+int mac::ul_feedback_info(uint32_t tti_rx, ul_feedback_list_t& feedback)
+{
+  logger.set_context(tti_rx);
+  ue_db_t::read_guard lock(ue_db);
+
+  // The reports of UEs that are not active are discarded, as done by the individual callbacks
+  feedback.erase(std::remove_if(feedback.begin(),
+                                feedback.end(),
+                                [this](const ul_feedback_t& fb) { return find_active_ue(fb.rnti) == nullptr; }),
+                 feedback.end());
+  if (feedback.empty()) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // All the reports are given to the scheduler with a single lock of its UE database
+  scheduler.ul_feedback_info(tti_rx, feedback);
+
+  ue* ue_ptr = nullptr;
+  for (const ul_feedback_t& fb : feedback) {
+    if (ue_ptr == nullptr or ue_ptr->get_rnti() != fb.rnti) {
+      ue_ptr = find_active_ue(fb.rnti);
+      if (ue_ptr == nullptr) {
+        continue;
+      }
+    }
+    switch (fb.type) {
+      case ul_feedback_t::dl_ack:
+        ue_ptr->metrics_tx(fb.value > 0, fb.ret);
+        kpi_sampler.add_dl_harq_feedback(fb.value > 0, fb.ret);
+        rrc_h->set_radiolink_dl_state(fb.rnti, fb.value > 0);
+        break;
+      case ul_feedback_t::ul_crc:
+        ue_ptr->set_tti(tti_rx);
+        ue_ptr->metrics_rx(fb.value > 0, fb.param);
+        kpi_sampler.add_ul_crc(fb.value > 0, fb.param);
+        rrc_h->set_radiolink_ul_state(fb.rnti, fb.value > 0);
+        break;
+      case ul_feedback_t::dl_ri:
+        ue_ptr->metrics_dl_ri(fb.value);
+        break;
+      case ul_feedback_t::dl_pmi:
+        ue_ptr->metrics_dl_pmi(fb.value);
+        break;
+      case ul_feedback_t::dl_cqi:
+        ue_ptr->metrics_dl_cqi(fb.value);
+        kpi_sampler.add_dl_cqi(fb.value);
+        break;
+      case ul_feedback_t::ul_snr:
+        rrc_h->set_radiolink_ul_state(fb.rnti, fb.meas >= args.rlf_min_ul_snr_estim);
+        break;
+      case ul_feedback_t::ta: {
+        uint32_t nof_ta_count = ue_ptr->set_ta_us(fb.meas);
+        if (nof_ta_count > 0) {
+          scheduler.dl_mac_buffer_state(fb.rnti, (uint32_t)srsran::dl_sch_lcid::TA_CMD, nof_ta_count);
+        }
+        break;
+      }
+      case ul_feedback_t::sr:
+      case ul_feedback_t::dl_sb_cqi:
+        break;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
 int mac::push_pdu(uint32_t tti_rx,
                   uint16_t rnti,
                   uint32_t enb_cc_idx,
@@ -330,13 +403,13 @@ int mac::push_pdu(uint32_t tti_rx,
                   bool     crc,
                   uint32_t ul_nof_prbs)
 {
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  ue_db_t::read_guard lock(ue_db);
+  ue*                 ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
-  srsran::unique_byte_buffer_t pdu = ue_db[rnti]->release_pdu(tti_rx, enb_cc_idx);
+  srsran::unique_byte_buffer_t pdu = ue_ptr->release_pdu(tti_rx, enb_cc_idx);
   if (pdu == nullptr) {
     logger.warning("Could not find MAC UL PDU for rnti=0x%x, cc=%d, tti=%d", rnti, enb_cc_idx, tti_rx);
     return SRSRAN_ERROR;
@@ -352,9 +425,10 @@ int mac::push_pdu(uint32_t tti_rx,
                   nof_bytes,
                   (int)pdu->size());
     auto process_pdu_task = [this, rnti, enb_cc_idx, ul_nof_prbs](srsran::unique_byte_buffer_t& pdu) {
-      srsran::rwlock_read_guard lock(rwlock);
-      if (check_ue_active(rnti)) {
-        ue_db[rnti]->process_pdu(std::move(pdu), enb_cc_idx, ul_nof_prbs);
+      ue_db_t::read_guard lock(ue_db);
+      ue*                 ue_ptr = find_active_ue(rnti);
+      if (ue_ptr != nullptr) {
+        ue_ptr->process_pdu(std::move(pdu), enb_cc_idx, ul_nof_prbs);
       } else {
         logger.debug("Discarding PDU rnti=0x%x", rnti);
       }
@@ -369,14 +443,14 @@ int mac::push_pdu(uint32_t tti_rx,
 int mac::ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value)
 {
   logger.set_context(tti);
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  ue_db_t::read_guard lock(ue_db);
+  ue*                 ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
   scheduler.dl_ri_info(tti, rnti, enb_cc_idx, ri_value);
-  ue_db[rnti]->metrics_dl_ri(ri_value);
+  ue_ptr->metrics_dl_ri(ri_value);
 
   return SRSRAN_SUCCESS;
 }
@@ -384,14 +458,14 @@ int mac::ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_v
 int mac::pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi_value)
 {
   logger.set_context(tti);
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  ue_db_t::read_guard lock(ue_db);
+  ue*                 ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
   scheduler.dl_pmi_info(tti, rnti, enb_cc_idx, pmi_value);
-  ue_db[rnti]->metrics_dl_pmi(pmi_value);
+  ue_ptr->metrics_dl_pmi(pmi_value);
 
   return SRSRAN_SUCCESS;
 }
@@ -399,14 +473,15 @@ int mac::pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi
 int mac::cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value)
 {
   logger.set_context(tti);
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  ue_db_t::read_guard lock(ue_db);
+  ue*                 ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
   scheduler.dl_cqi_info(tti, rnti, enb_cc_idx, cqi_value);
-  ue_db[rnti]->metrics_dl_cqi(cqi_value);
+  ue_ptr->metrics_dl_cqi(cqi_value);
+  kpi_sampler.add_dl_cqi(cqi_value);
 
   return SRSRAN_SUCCESS;
 }
@@ -414,9 +489,9 @@ int mac::cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi
 int mac::sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value)
 {
   logger.set_context(tti);
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  ue_db_t::read_guard lock(ue_db);
+  ue*                 ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
@@ -427,9 +502,9 @@ int mac::sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
 int mac::snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, float snr, ul_channel_t ch)
 {
   logger.set_context(tti_rx);
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  ue_db_t::read_guard lock(ue_db);
+  ue*                 ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
@@ -440,13 +515,13 @@ int mac::snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, float snr
 
 int mac::ta_info(uint32_t tti, uint16_t rnti, float ta_us)
 {
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  ue_db_t::read_guard lock(ue_db);
+  ue*                 ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
-  uint32_t nof_ta_count = ue_db[rnti]->set_ta_us(ta_us);
+  uint32_t nof_ta_count = ue_ptr->set_ta_us(ta_us);
   if (nof_ta_count > 0) {
     return scheduler.dl_mac_buffer_state(rnti, (uint32_t)srsran::dl_sch_lcid::TA_CMD, nof_ta_count);
   }
@@ -456,9 +531,9 @@ int mac::ta_info(uint32_t tti, uint16_t rnti, float ta_us)
 int mac::sr_detected(uint32_t tti, uint16_t rnti)
 {
   logger.set_context(tti);
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  ue_db_t::read_guard lock(ue_db);
+  ue*                 ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
@@ -503,14 +578,14 @@ uint16_t mac::allocate_ue(uint32_t enb_cc_idx)
     unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
         rnti, rnti, enb_cc_idx, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
 
-    // Add UE to rnti map
+    // Add UE to rnti map. The write lock avoids racing with the eNB shutdown
     srsran::rwlock_write_guard rw_lock(rwlock);
     if (not is_valid_rnti_unprotected(rnti)) {
       continue;
     }
-    auto ret = ue_db.insert(rnti, std::move(ue_ptr));
-    if (ret.has_value()) {
-      inserted_ue = ret.value()->second.get();
+    ue* new_ue = ue_ptr.get();
+    if (ue_db.insert(rnti, std::move(ue_ptr))) {
+      inserted_ue = new_ue;
     } else {
       logger.info("Failed to allocate rnti=0x%x. Attempting a different rnti.", rnti);
     }
@@ -648,7 +723,8 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
     add_padding();
   }
 
-  srsran::rwlock_read_guard lock(rwlock);
+  // Note: cell_config is only written by the RRC initialization, before the PHY workers start
+  ue_db_t::read_guard lock(ue_db);
 
   for (uint32_t enb_cc_idx = 0; enb_cc_idx < cell_config.size(); enb_cc_idx++) {
     // Run scheduler with current info
@@ -666,15 +742,16 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
       uint32_t tb_count = 0;
 
       // Get UE
-      uint16_t rnti = sched_result.data[i].dci.rnti;
+      uint16_t rnti   = sched_result.data[i].dci.rnti;
+      ue*      ue_ptr = ue_db.find(rnti);
 
-      if (ue_db.contains(rnti)) {
+      if (ue_ptr != nullptr) {
         // Copy dci info
         dl_sched_res->pdsch[n].dci = sched_result.data[i].dci;
 
         for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
           dl_sched_res->pdsch[n].softbuffer_tx[tb] =
-              ue_db[rnti]->get_tx_softbuffer(enb_cc_idx, sched_result.data[i].dci.pid, tb);
+              ue_ptr->get_tx_softbuffer(enb_cc_idx, sched_result.data[i].dci.pid, tb);
 
           // If the Rx soft-buffer is not given, abort transmission
           if (dl_sched_res->pdsch[n].softbuffer_tx[tb] == nullptr) {
@@ -683,12 +760,12 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
 
           if (sched_result.data[i].nof_pdu_elems[tb] > 0) {
             /* Get PDU if it's a new transmission */
-            dl_sched_res->pdsch[n].data[tb] = ue_db[rnti]->generate_pdu(enb_cc_idx,
-                                                                        sched_result.data[i].dci.pid,
-                                                                        tb,
-                                                                        sched_result.data[i].pdu[tb],
-                                                                        sched_result.data[i].nof_pdu_elems[tb],
-                                                                        sched_result.data[i].tbs[tb]);
+            dl_sched_res->pdsch[n].data[tb] = ue_ptr->generate_pdu(enb_cc_idx,
+                                                                   sched_result.data[i].dci.pid,
+                                                                   tb,
+                                                                   sched_result.data[i].pdu[tb],
+                                                                   sched_result.data[i].nof_pdu_elems[tb],
+                                                                   sched_result.data[i].tbs[tb]);
 
             if (!dl_sched_res->pdsch[n].data[tb]) {
               logger.error("Error! PDU was not generated (rnti=0x%04x, tb=%d)", rnti, tb);
@@ -809,14 +886,23 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
 
     dl_sched_res->nof_grants = n;
 
+    // PRBs allocated in the carrier
+    uint32_t nof_prb = 0;
+    for (uint32_t i = 0; i < dl_sched_res->nof_grants; i++) {
+      srsran_pdsch_grant_t grant = {};
+      if (srsran_ra_dl_grant_to_grant_prb_allocation(
+              &dl_sched_res->pdsch[i].dci, &grant, cell_config[enb_cc_idx].cell.nof_prb) == SRSRAN_SUCCESS) {
+        nof_prb += grant.nof_prb;
+      }
+    }
+    kpi_sampler.add_dl_grant(nof_prb);
+
     // Number of CCH symbols
     dl_sched_res->cfi = sched_result.cfi;
   }
 
   // Count number of TTIs for all active users
-  for (auto& u : ue_db) {
-    u.second->metrics_cnt();
-  }
+  ue_db.for_each([](uint16_t rnti, ue& u) { u.metrics_cnt(); });
 
   return SRSRAN_SUCCESS;
 }
@@ -857,7 +943,12 @@ void mac::build_mch_sched(uint32_t tbs)
 int mac::get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res_list)
 {
   srsran::rwlock_read_guard lock(rwlock);
+  ue_db_t::read_guard       ue_lock(ue_db);
+  ue*                       mch_ue       = ue_db.find(SRSRAN_MRNTI);
   dl_sched_t*               dl_sched_res = &dl_sched_res_list[0];
+  if (mch_ue == nullptr) {
+    return SRSRAN_ERROR;
+  }
   logger.set_context(tti);
   srsran_ra_tb_t mcs      = {};
   srsran_ra_tb_t mcs_data = {};
@@ -884,9 +975,9 @@ int mac::get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res
     dl_sched_res->pdsch[0].dci.rnti    = SRSRAN_MRNTI;
 
     // we use TTI % HARQ to make sure we use different buffers for consecutive TTIs to avoid races between PHY workers
-    ue_db[SRSRAN_MRNTI]->metrics_tx(true, mcs.tbs);
+    mch_ue->metrics_tx(true, mcs.tbs);
     dl_sched_res->pdsch[0].data[0] =
-        ue_db[SRSRAN_MRNTI]->generate_mch_pdu(tti % SRSRAN_FDD_NOF_HARQ, mch, mch.num_mtch_sched + 1, mcs.tbs / 8);
+        mch_ue->generate_mch_pdu(tti % SRSRAN_FDD_NOF_HARQ, mch, mch.num_mtch_sched + 1, mcs.tbs / 8);
   } else {
     uint32_t current_lcid = 1;
     uint32_t mtch_index   = 0;
@@ -903,15 +994,15 @@ int mac::get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res
       int requested_bytes = (mcs_data.tbs / 8 > (int)mch.mtch_sched[mtch_index].lcid_buffer_size)
                                 ? (mch.mtch_sched[mtch_index].lcid_buffer_size)
                                 : ((mcs_data.tbs / 8) - 2);
-      int bytes_received = ue_db[SRSRAN_MRNTI]->read_pdu(current_lcid, mtch_payload_buffer, requested_bytes);
+      int bytes_received = mch_ue->read_pdu(current_lcid, mtch_payload_buffer, requested_bytes);
       mch.pdu[0].lcid    = current_lcid;
       mch.pdu[0].nbytes  = bytes_received;
       mch.mtch_sched[0].mtch_payload  = mtch_payload_buffer;
       dl_sched_res->pdsch[0].dci.rnti = SRSRAN_MRNTI;
       if (bytes_received) {
-        ue_db[SRSRAN_MRNTI]->metrics_tx(true, mcs.tbs);
+        mch_ue->metrics_tx(true, mcs.tbs);
         dl_sched_res->pdsch[0].data[0] =
-            ue_db[SRSRAN_MRNTI]->generate_mch_pdu(tti % SRSRAN_FDD_NOF_HARQ, mch, 1, mcs_data.tbs / 8);
+            mch_ue->generate_mch_pdu(tti % SRSRAN_FDD_NOF_HARQ, mch, 1, mcs_data.tbs / 8);
       }
     } else {
       dl_sched_res->pdsch[0].dci.rnti = 0;
@@ -921,9 +1012,7 @@ int mac::get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res
   }
 
   // Count number of TTIs for all active users
-  for (auto& u : ue_db) {
-    u.second->metrics_cnt();
-  }
+  ue_db.for_each([](uint16_t rnti, ue& u) { u.metrics_cnt(); });
   return SRSRAN_SUCCESS;
 }
 
@@ -972,12 +1061,10 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
 
   logger.set_context(TTI_SUB(tti_tx_ul, FDD_HARQ_DELAY_UL_MS + FDD_HARQ_DELAY_DL_MS));
 
-  srsran::rwlock_read_guard lock(rwlock);
+  ue_db_t::read_guard lock(ue_db);
 
   // Execute UE FSMs (e.g. TA)
-  for (auto& ue : ue_db) {
-    ue.second->tic();
-  }
+  ue_db.for_each([](uint16_t rnti, ue& u) { u.tic(); });
 
   for (uint32_t enb_cc_idx = 0; enb_cc_idx < cell_config.size(); enb_cc_idx++) {
     ul_sched_t* phy_ul_sched_res = &ul_sched_res_list[enb_cc_idx];
@@ -995,15 +1082,16 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
     for (uint32_t i = 0; i < sched_result.pusch.size(); i++) {
       if (sched_result.pusch[i].tbs > 0) {
         // Get UE
-        uint16_t rnti = sched_result.pusch[i].dci.rnti;
+        uint16_t rnti   = sched_result.pusch[i].dci.rnti;
+        ue*      ue_ptr = ue_db.find(rnti);
 
-        if (ue_db.contains(rnti)) {
+        if (ue_ptr != nullptr) {
           // Copy grant info
           phy_ul_sched_res->pusch[n].current_tx_nb = sched_result.pusch[i].current_tx_nb;
           phy_ul_sched_res->pusch[n].pid           = TTI_RX(tti_tx_ul) % SRSRAN_FDD_NOF_HARQ;
           phy_ul_sched_res->pusch[n].needs_pdcch   = sched_result.pusch[i].needs_pdcch;
           phy_ul_sched_res->pusch[n].dci           = sched_result.pusch[i].dci;
-          phy_ul_sched_res->pusch[n].softbuffer_rx = ue_db[rnti]->get_rx_softbuffer(enb_cc_idx, tti_tx_ul);
+          phy_ul_sched_res->pusch[n].softbuffer_rx = ue_ptr->get_rx_softbuffer(enb_cc_idx, tti_tx_ul);
 
           // If the Rx soft-buffer is not given, abort reception
           if (phy_ul_sched_res->pusch[n].softbuffer_rx == nullptr) {
@@ -1015,7 +1103,7 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
             srsran_softbuffer_rx_reset_tbs(phy_ul_sched_res->pusch[n].softbuffer_rx, sched_result.pusch[i].tbs * 8);
           }
           phy_ul_sched_res->pusch[n].data =
-              ue_db[rnti]->request_buffer(tti_tx_ul, enb_cc_idx, sched_result.pusch[i].tbs);
+              ue_ptr->request_buffer(tti_tx_ul, enb_cc_idx, sched_result.pusch[i].tbs);
           if (phy_ul_sched_res->pusch[n].data) {
             phy_ul_sched_res->nof_grants++;
           } else {
@@ -1036,11 +1124,19 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
       phy_ul_sched_res->phich[i].rnti = sched_result.phich[i].rnti;
     }
     phy_ul_sched_res->nof_phich = sched_result.phich.size();
+
+    // PRBs allocated in the carrier
+    uint32_t nof_prb = 0;
+    for (uint32_t i = 0; i < phy_ul_sched_res->nof_grants; i++) {
+      uint32_t L_prb = 0, RB_start = 0, cell_nof_prb = cell_config[enb_cc_idx].cell.nof_prb;
+      srsran_ra_type2_from_riv(
+          phy_ul_sched_res->pusch[i].dci.type2_alloc.riv, &L_prb, &RB_start, cell_nof_prb, cell_nof_prb);
+      nof_prb += L_prb;
+    }
+    kpi_sampler.add_ul_grant(nof_prb);
   }
   // clear old buffers from all users
-  for (auto& u : ue_db) {
-    u.second->clear_old_buffers(tti_tx_ul);
-  }
+  ue_db.for_each([tti_tx_ul](uint16_t rnti, ue& u) { u.clear_old_buffers(tti_tx_ul); });
   return SRSRAN_SUCCESS;
 }
 
@@ -1064,20 +1160,20 @@ void mac::write_mcch(const srsran::sib2_mbms_t* sib2_,
   unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
       SRSRAN_MRNTI, SRSRAN_MRNTI, 0, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
 
-  auto ret = ue_db.insert(SRSRAN_MRNTI, std::move(ue_ptr));
-  if (!ret) {
+  if (not ue_db.insert(SRSRAN_MRNTI, std::move(ue_ptr))) {
     logger.info("Failed to allocate rnti=0x%x.for eMBMS", SRSRAN_MRNTI);
   }
 }
 
-// Internal helper function, caller must hold UE DB rwlock
-bool mac::check_ue_active(uint16_t rnti)
+// Internal helper function, caller must hold a UE DB read_guard
+ue* mac::find_active_ue(uint16_t rnti)
 {
-  if (not ue_db.contains(rnti)) {
+  ue* ue_ptr = ue_db.find(rnti);
+  if (ue_ptr == nullptr) {
     logger.error("User rnti=0x%x not found", rnti);
-    return false;
+    return nullptr;
   }
-  return ue_db[rnti]->is_active();
+  return ue_ptr->is_active() ? ue_ptr : nullptr;
 }
 
 } // namespace srsenb
@@ -25,6 +25,10 @@
 #include "srsenb/hdr/stack/mac/sched.h"
 #include "srsenb/hdr/stack/mac/sched_carrier.h"
 #include "srsenb/hdr/stack/mac/sched_helpers.h"
+#include "srsran/common/standard_streams.h"
+#include "srsran/common/thread_pool.h"
+#include "srsran/common/time_prof.h"
+#include "srsran/srslog/event_trace.h"
 #include "srsran/srslog/srslog.h"
 
 #define Console(fmt, ...) srsran::console(fmt, ##__VA_ARGS__)
@@ -46,18 +50,36 @@ sched::~sched() {}
 
 void sched::init(rrc_interface_mac* rrc_, const sched_args_t& sched_cfg_)
 {
-  rrc       = rrc_;
-  sched_cfg = sched_cfg_;
+  rrc                       = rrc_;
+  sched_cfg                 = sched_cfg_;
+  init_max_nof_ctrl_symbols = sched_cfg.max_nof_ctrl_symbols;
 
   // Initialize first carrier scheduler
   carrier_schedulers.emplace_back(new carrier_sched{rrc, &ue_db, 0, &sched_results});
 
+  if (sched_cfg.nof_cc_threads > 0 and cc_workers == nullptr) {
+    cc_workers.reset(new srsran::task_thread_pool(sched_cfg.nof_cc_threads));
+  }
+
+  if (not sched_cfg.trace_filename.empty() and trace == nullptr) {
+    trace.reset(new sched_trace_writer{});
+    if (trace->open(sched_cfg.trace_filename)) {
+      Console("Recording scheduler trace to %s\n", sched_cfg.trace_filename.c_str());
+      trace->write_sched_args(sched_cfg);
+    } else {
+      trace.reset();
+    }
+  }
+
   reset();
 }
 
 int sched::reset()
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::reset);
+  }
   for (std::unique_ptr<carrier_sched>& c : carrier_schedulers) {
     c->reset();
   }
@@ -69,6 +91,9 @@ int sched::reset()
 int sched::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write_cell_cfg(cell_cfg);
+  }
   // Setup derived config params
   sched_cell_params.resize(cell_cfg.size());
   for (uint32_t cc_idx = 0; cc_idx < cell_cfg.size(); ++cc_idx) {
@@ -95,6 +120,87 @@ int sched::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg)
   return 0;
 }
 
+int sched::set_tunables(const sched_tunables_t& tunables)
+{
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (not configured) {
+    Error("SCHED: Tunables can only be set after the cells are configured");
+    return SRSRAN_ERROR;
+  }
+  if (tunables.sched_policy != "time_rr" and tunables.sched_policy != "time_pf") {
+    Error("SCHED: Invalid scheduling policy %s", tunables.sched_policy.c_str());
+    return SRSRAN_ERROR;
+  }
+  if (tunables.sched_policy == "time_pf" and not tunables.sched_policy_args.empty()) {
+    char* end = nullptr;
+    strtof(tunables.sched_policy_args.c_str(), &end);
+    if (end == tunables.sched_policy_args.c_str() or *end != '\0') {
+      Error("SCHED: Invalid scheduling policy args %s", tunables.sched_policy_args.c_str());
+      return SRSRAN_ERROR;
+    }
+  }
+  if (tunables.pdsch_max_mcs < -1 or tunables.pdsch_max_mcs > 28 or tunables.pusch_max_mcs < -1 or
+      tunables.pusch_max_mcs > 28) {
+    Error("SCHED: Invalid max MCS pdsch=%d, pusch=%d", tunables.pdsch_max_mcs, tunables.pusch_max_mcs);
+    return SRSRAN_ERROR;
+  }
+  // The PUCCH resources of the HARQ-ACKs are reserved for the number of control symbols set at startup
+  if (tunables.min_nof_ctrl_symbols < 1 or tunables.min_nof_ctrl_symbols > tunables.max_nof_ctrl_symbols or
+      tunables.max_nof_ctrl_symbols > init_max_nof_ctrl_symbols) {
+    Error("SCHED: Invalid number of control symbols [%d, %d], the maximum is %d",
+          tunables.min_nof_ctrl_symbols,
+          tunables.max_nof_ctrl_symbols,
+          init_max_nof_ctrl_symbols);
+    return SRSRAN_ERROR;
+  }
+  for (const sched_cell_params_t& cc_params : sched_cell_params) {
+    if (cc_params.common_locations[tunables.max_nof_ctrl_symbols - 1][2].empty()) {
+      Error("SCHED: cfi=%d is not valid for broadcast in cc=%d", tunables.max_nof_ctrl_symbols, cc_params.enb_cc_idx);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  pending_tunables = tunables;
+  tunables_pending = true;
+  return SRSRAN_SUCCESS;
+}
+
+/// Applies the pending tunables. Called at a TTI boundary, with the scheduler locked
+void sched::apply_tunables()
+{
+  bool policy_changed = pending_tunables.sched_policy != sched_cfg.sched_policy or
+                        pending_tunables.sched_policy_args != sched_cfg.sched_policy_args;
+  bool mcs_changed    = pending_tunables.pdsch_max_mcs != sched_cfg.pdsch_max_mcs or
+                        pending_tunables.pusch_max_mcs != sched_cfg.pusch_max_mcs;
+
+  sched_cfg.sched_policy         = pending_tunables.sched_policy;
+  sched_cfg.sched_policy_args    = pending_tunables.sched_policy_args;
+  sched_cfg.pdsch_max_mcs        = pending_tunables.pdsch_max_mcs;
+  sched_cfg.pusch_max_mcs        = pending_tunables.pusch_max_mcs;
+  sched_cfg.min_nof_ctrl_symbols = pending_tunables.min_nof_ctrl_symbols;
+  sched_cfg.max_nof_ctrl_symbols = pending_tunables.max_nof_ctrl_symbols;
+  tunables_pending               = false;
+
+  if (policy_changed) {
+    for (std::unique_ptr<carrier_sched>& c : carrier_schedulers) {
+      c->set_sched_policy();
+    }
+  }
+  if (mcs_changed) {
+    for (auto& u : ue_db) {
+      u.second->update_max_mcs();
+    }
+  }
+  srslog::fetch_basic_logger("MAC").info(
+      "SCHED: Set tunables policy=%s, policy_args=%s, pdsch_max_mcs=%d, pusch_max_mcs=%d, nof_ctrl_symbols=[%d, %d]",
+      sched_cfg.sched_policy.c_str(),
+      sched_cfg.sched_policy_args.c_str(),
+      sched_cfg.pdsch_max_mcs,
+      sched_cfg.pusch_max_mcs,
+      sched_cfg.min_nof_ctrl_symbols,
+      sched_cfg.max_nof_ctrl_symbols);
+}
+
 /*******************************************************
  *
  * FAPI-like main sched interface. Wrappers to UE object
@@ -103,6 +209,9 @@ int sched::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg)
 
 int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
 {
+  if (trace != nullptr) {
+    trace->write_ue_cfg(rnti, ue_cfg);
+  }
   {
     // config existing user
     std::lock_guard<std::mutex> lock(sched_mutex);
@@ -123,6 +232,9 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
 int sched::ue_rem(uint16_t rnti)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::ue_rem, rnti);
+  }
   if (ue_db.contains(rnti)) {
     ue_db.erase(rnti);
   } else {
@@ -140,6 +252,9 @@ bool sched::ue_exists(uint16_t rnti)
 
 void sched::phy_config_enabled(uint16_t rnti, bool enabled)
 {
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::phy_cfg, rnti, enabled);
+  }
   // TODO: Check if correct use of last_tti
   ue_db_access_locked(
       rnti, [this, enabled](sched_ue& ue) { ue.phy_config_enabled(last_tti, enabled); }, __PRETTY_FUNCTION__);
@@ -147,11 +262,17 @@ void sched::phy_config_enabled(uint16_t rnti, bool enabled)
 
 int sched::bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, const mac_lc_ch_cfg_t& cfg_)
 {
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::bearer_cfg, rnti, lc_id, cfg_);
+  }
   return ue_db_access_locked(rnti, [lc_id, cfg_](sched_ue& ue) { ue.set_bearer_cfg(lc_id, cfg_); });
 }
 
 int sched::bearer_ue_rem(uint16_t rnti, uint32_t lc_id)
 {
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::bearer_rem, rnti, lc_id);
+  }
   return ue_db_access_locked(rnti, [lc_id](sched_ue& ue) { ue.rem_bearer(lc_id); });
 }
 
@@ -176,16 +297,25 @@ uint32_t sched::get_ul_buffer(uint16_t rnti)
 
 int sched::dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t prio_tx_queue)
 {
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::dl_rlc_buffer, rnti, lc_id, tx_queue, prio_tx_queue);
+  }
   return ue_db_access_locked(rnti, [&](sched_ue& ue) { ue.dl_buffer_state(lc_id, tx_queue, prio_tx_queue); });
 }
 
 int sched::dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds)
 {
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::dl_mac_buffer, rnti, ce_code, nof_cmds);
+  }
   return ue_db_access_locked(rnti, [ce_code, nof_cmds](sched_ue& ue) { ue.mac_buffer_state(ce_code, nof_cmds); });
 }
 
 int sched::dl_ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
 {
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::dl_ack, tti_rx, rnti, enb_cc_idx, tb_idx, ack);
+  }
   int ret = -1;
   ue_db_access_locked(
       rnti,
@@ -196,30 +326,50 @@ int sched::dl_ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint
 
 int sched::ul_crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, bool crc)
 {
-  return ue_db_access_locked(
-      rnti, [tti_rx, enb_cc_idx, crc](sched_ue& ue) { ue.set_ul_crc(tti_point{tti_rx}, enb_cc_idx, crc); });
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::ul_crc, tti_rx, rnti, enb_cc_idx, crc);
+  }
+  return ue_db_access_locked(rnti, [this, tti_rx, enb_cc_idx, crc](sched_ue& ue) {
+    ue.set_ul_crc(tti_point{tti_rx}, enb_cc_idx, crc);
+    if (crc and is_generated(tti_point{tti_rx}, enb_cc_idx)) {
+      // The decision of this TTI was precomputed before the CRC was known, assuming a NACK
+      cancel_ul_retx(tti_point{tti_rx}, enb_cc_idx, ue);
+    }
+  });
 }
 
 int sched::dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value)
 {
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::dl_ri, tti, rnti, enb_cc_idx, ri_value);
+  }
   return ue_db_access_locked(
       rnti, [tti, enb_cc_idx, ri_value](sched_ue& ue) { ue.set_dl_ri(tti_point{tti}, enb_cc_idx, ri_value); });
 }
 
 int sched::dl_pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi_value)
 {
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::dl_pmi, tti, rnti, enb_cc_idx, pmi_value);
+  }
   return ue_db_access_locked(
       rnti, [tti, enb_cc_idx, pmi_value](sched_ue& ue) { ue.set_dl_pmi(tti_point{tti}, enb_cc_idx, pmi_value); });
 }
 
 int sched::dl_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value)
 {
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::dl_cqi, tti, rnti, enb_cc_idx, cqi_value);
+  }
   return ue_db_access_locked(
       rnti, [tti, enb_cc_idx, cqi_value](sched_ue& ue) { ue.set_dl_cqi(tti_point{tti}, enb_cc_idx, cqi_value); });
 }
 
 int sched::dl_sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value)
 {
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::dl_sb_cqi, tti, rnti, enb_cc_idx, sb_idx, cqi_value);
+  }
   return ue_db_access_locked(rnti, [tti, enb_cc_idx, cqi_value, sb_idx](sched_ue& ue) {
     ue.set_dl_sb_cqi(tti_point{tti}, enb_cc_idx, sb_idx, cqi_value);
   });
@@ -228,33 +378,141 @@ int sched::dl_sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint
 int sched::dl_rach_info(uint32_t enb_cc_idx, dl_sched_rar_info_t rar_info)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::dl_rach, enb_cc_idx, rar_info);
+  }
   return carrier_schedulers[enb_cc_idx]->dl_rach_info(rar_info);
 }
 
 int sched::ul_snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code)
 {
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::ul_snr, tti_rx, rnti, enb_cc_idx, snr, ul_ch_code);
+  }
   return ue_db_access_locked(rnti,
                              [&](sched_ue& ue) { ue.set_ul_snr(tti_point{tti_rx}, enb_cc_idx, snr, ul_ch_code); });
 }
 
+int sched::ul_feedback_info(uint32_t tti, ul_feedback_list_t& feedback)
+{
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  tti_point                   tti_rx{tti};
+  sched_ue*                   ue = nullptr;
+  for (ul_feedback_t& fb : feedback) {
+    if (trace != nullptr) {
+      trace_ul_feedback(tti, fb);
+    }
+    // Consecutive reports usually belong to the same UE
+    if (ue == nullptr or ue->get_rnti() != fb.rnti) {
+      auto it = ue_db.find(fb.rnti);
+      ue      = (it != ue_db.end()) ? it->second.get() : nullptr;
+    }
+    if (ue == nullptr) {
+      Error("SCHED: User rnti=0x%x not found. Failed to process UL feedback.", fb.rnti);
+      fb.ret = SRSRAN_ERROR;
+      continue;
+    }
+
+    fb.ret = SRSRAN_SUCCESS;
+    switch (fb.type) {
+      case ul_feedback_t::sr:
+        ue->set_sr();
+        break;
+      case ul_feedback_t::dl_ack:
+        fb.ret = ue->set_ack_info(tti_rx, fb.enb_cc_idx, fb.param, fb.value > 0);
+        break;
+      case ul_feedback_t::ul_crc:
+        ue->set_ul_crc(tti_rx, fb.enb_cc_idx, fb.value > 0);
+        if (fb.value > 0 and is_generated(tti_rx, fb.enb_cc_idx)) {
+          cancel_ul_retx(tti_rx, fb.enb_cc_idx, *ue);
+        }
+        break;
+      case ul_feedback_t::dl_ri:
+        ue->set_dl_ri(tti_rx, fb.enb_cc_idx, fb.value);
+        break;
+      case ul_feedback_t::dl_pmi:
+        ue->set_dl_pmi(tti_rx, fb.enb_cc_idx, fb.value);
+        break;
+      case ul_feedback_t::dl_cqi:
+        ue->set_dl_cqi(tti_rx, fb.enb_cc_idx, fb.value);
+        break;
+      case ul_feedback_t::dl_sb_cqi:
+        ue->set_dl_sb_cqi(tti_rx, fb.enb_cc_idx, fb.param, fb.value);
+        break;
+      case ul_feedback_t::ul_snr:
+        ue->set_ul_snr(tti_rx, fb.enb_cc_idx, fb.meas, fb.param);
+        break;
+      case ul_feedback_t::ta:
+        // Handled by the MAC, which schedules the TA commands
+        break;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+void sched::trace_ul_feedback(uint32_t tti, const ul_feedback_t& fb)
+{
+  // Recorded as the equivalent individual calls, so that the replay does not depend on how the reports were batched
+  switch (fb.type) {
+    case ul_feedback_t::sr:
+      trace->write_event(sched_trace_event_t::ul_sr, tti, fb.rnti);
+      break;
+    case ul_feedback_t::dl_ack:
+      trace->write_event(sched_trace_event_t::dl_ack, tti, fb.rnti, fb.enb_cc_idx, fb.param, fb.value > 0);
+      break;
+    case ul_feedback_t::ul_crc:
+      trace->write_event(sched_trace_event_t::ul_crc, tti, fb.rnti, fb.enb_cc_idx, fb.value > 0);
+      break;
+    case ul_feedback_t::dl_ri:
+      trace->write_event(sched_trace_event_t::dl_ri, tti, fb.rnti, fb.enb_cc_idx, fb.value);
+      break;
+    case ul_feedback_t::dl_pmi:
+      trace->write_event(sched_trace_event_t::dl_pmi, tti, fb.rnti, fb.enb_cc_idx, fb.value);
+      break;
+    case ul_feedback_t::dl_cqi:
+      trace->write_event(sched_trace_event_t::dl_cqi, tti, fb.rnti, fb.enb_cc_idx, fb.value);
+      break;
+    case ul_feedback_t::dl_sb_cqi:
+      trace->write_event(sched_trace_event_t::dl_sb_cqi, tti, fb.rnti, fb.enb_cc_idx, fb.param, fb.value);
+      break;
+    case ul_feedback_t::ul_snr:
+      trace->write_event(sched_trace_event_t::ul_snr, tti, fb.rnti, fb.enb_cc_idx, fb.meas, fb.param);
+      break;
+    case ul_feedback_t::ta:
+      break;
+  }
+}
+
 int sched::ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)
 {
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::ul_bsr, rnti, lcg_id, bsr);
+  }
   return ue_db_access_locked(rnti, [lcg_id, bsr](sched_ue& ue) { ue.ul_buffer_state(lcg_id, bsr); });
 }
 
 int sched::ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes)
 {
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::ul_buffer_add, rnti, lcid, bytes);
+  }
   return ue_db_access_locked(rnti, [lcid, bytes](sched_ue& ue) { ue.ul_buffer_add(lcid, bytes); });
 }
 
 int sched::ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb)
 {
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::ul_phr, rnti, phr, ul_nof_prb);
+  }
   return ue_db_access_locked(
       rnti, [phr, ul_nof_prb](sched_ue& ue) { ue.ul_phr(phr, ul_nof_prb); }, __PRETTY_FUNCTION__);
 }
 
 int sched::ul_sr_info(uint32_t tti, uint16_t rnti)
 {
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::ul_sr, tti, rnti);
+  }
   return ue_db_access_locked(
       rnti, [](sched_ue& ue) { ue.set_sr(); }, __PRETTY_FUNCTION__);
 }
@@ -262,6 +520,9 @@ int sched::ul_sr_info(uint32_t tti, uint16_t rnti)
 void sched::set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write_dl_tti_mask(tti_mask, nof_sfs);
+  }
   carrier_schedulers[0]->set_dl_tti_mask(tti_mask, nof_sfs);
 }
 
@@ -304,6 +565,9 @@ std::array<int, SRSRAN_MAX_CARRIERS> sched::get_enb_ue_activ_cc_map(uint16_t rnt
 int sched::set_pdcch_order(uint32_t enb_cc_idx, dl_sched_po_info_t pdcch_order_info)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::pdcch_order, enb_cc_idx, pdcch_order_info);
+  }
   return carrier_schedulers[enb_cc_idx]->pdcch_order_info(pdcch_order_info);
 }
 
@@ -316,7 +580,12 @@ int sched::set_pdcch_order(uint32_t enb_cc_idx, dl_sched_po_info_t pdcch_order_i
 // Downlink Scheduler API
 int sched::dl_sched(uint32_t tti_tx_dl, uint32_t enb_cc_idx, sched_interface::dl_sched_res_t& sched_result)
 {
+  trace_hot_scope_arg("mac", "dl_sched", tti_tx_dl);
+  srsran::scoped_stage_prof   prof(srsran::tti_stage::sched);
   std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::dl_sched, tti_tx_dl, enb_cc_idx);
+  }
   if (not configured) {
     return 0;
   }
@@ -325,6 +594,7 @@ int sched::dl_sched(uint32_t tti_tx_dl, uint32_t enb_cc_idx, sched_interface::dl
   }
 
   tti_point tti_rx = tti_point{tti_tx_dl} - TX_ENB_DELAY;
+  last_phy_tti     = last_phy_tti.is_valid() ? std::max(last_phy_tti, tti_rx) : tti_rx;
   new_tti(tti_rx);
 
   // copy result
@@ -336,7 +606,12 @@ int sched::dl_sched(uint32_t tti_tx_dl, uint32_t enb_cc_idx, sched_interface::dl
 // Uplink Scheduler API
 int sched::ul_sched(uint32_t tti, uint32_t enb_cc_idx, srsenb::sched_interface::ul_sched_res_t& sched_result)
 {
+  trace_hot_scope_arg("mac", "ul_sched", tti);
+  srsran::scoped_stage_prof   prof(srsran::tti_stage::sched);
   std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write_event(sched_trace_event_t::ul_sched, tti, enb_cc_idx);
+  }
   if (not configured) {
     return 0;
   }
@@ -346,6 +621,7 @@ int sched::ul_sched(uint32_t tti, uint32_t enb_cc_idx, srsenb::sched_interface::
 
   // Compute scheduling Result for tti_rx
   tti_point tti_rx = tti_point{tti} - TX_ENB_DELAY - FDD_HARQ_DELAY_DL_MS;
+  last_phy_tti     = last_phy_tti.is_valid() ? std::max(last_phy_tti, tti_rx) : tti_rx;
   new_tti(tti_rx);
 
   // copy result
@@ -359,8 +635,18 @@ int sched::ul_sched(uint32_t tti, uint32_t enb_cc_idx, srsenb::sched_interface::
 ///       configurations (e.g. different set of activated SCells) in different CC decisions
 void sched::new_tti(tti_point tti_rx)
 {
+  trace_hot_scope_arg("mac", "new_tti", tti_rx.to_uint());
   last_tti = std::max(last_tti, tti_rx);
 
+  if (tunables_pending) {
+    apply_tunables();
+  }
+
+  if (cc_workers != nullptr and carrier_schedulers.size() > 1) {
+    new_tti_parallel(tti_rx);
+    return;
+  }
+
   // Generate sched results for all CCs, if not yet generated
   for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
     if (not is_generated(tti_rx, cc_idx)) {
@@ -370,6 +656,113 @@ void sched::new_tti(tti_point tti_rx)
   }
 }
 
+/// Generate the scheduling decision of the CCs in parallel, in three phases:
+/// - each CC allocates the control channels and the UEs that are only configured in that CC. These UEs' state is
+///   only touched by their CC, so the CCs run in parallel
+/// - the UEs with several configured CCs are then allocated in each CC, serially, as their buffers, UCI and PUCCH
+///   decisions are shared between CCs
+/// - each CC selects its DCI positions and stores its results. This runs in parallel, unless a UE with several CCs
+///   was allocated, as the UCI placement of such UE depends on the results of its other CCs
+void sched::new_tti_parallel(tti_point tti_rx)
+{
+  pending_ccs.clear();
+  for (uint32_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+    if (not is_generated(tti_rx, cc_idx)) {
+      pending_ccs.push_back(cc_idx);
+    }
+  }
+  if (pending_ccs.empty()) {
+    return;
+  }
+
+  for (uint32_t cc_idx : pending_ccs) {
+    carrier_schedulers[cc_idx]->start_tti(tti_rx);
+  }
+
+  struct job_t {
+    sched*    parent;
+    tti_point tti_rx;
+  } job{this, tti_rx};
+  cc_workers->parallel_for(
+      pending_ccs.size(),
+      [](void* arg, uint32_t idx) {
+        job_t* j = static_cast<job_t*>(arg);
+        j->parent->carrier_schedulers[j->parent->pending_ccs[idx]]->alloc_tti(j->tti_rx,
+                                                                              sf_sched::ue_subset_t::single_cc);
+      },
+      &job);
+
+  bool multi_cc_allocs = false;
+  for (uint32_t cc_idx : pending_ccs) {
+    multi_cc_allocs |= carrier_schedulers[cc_idx]->alloc_users(tti_rx, sf_sched::ue_subset_t::multi_cc);
+  }
+
+  if (multi_cc_allocs) {
+    for (uint32_t cc_idx : pending_ccs) {
+      carrier_schedulers[cc_idx]->finish_tti(tti_rx);
+    }
+    return;
+  }
+  cc_workers->parallel_for(
+      pending_ccs.size(),
+      [](void* arg, uint32_t idx) {
+        job_t* j = static_cast<job_t*>(arg);
+        j->parent->carrier_schedulers[j->parent->pending_ccs[idx]]->finish_tti(j->tti_rx);
+      },
+      &job);
+}
+
+void sched::precompute_ttis()
+{
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (not configured or sched_cfg.lookahead_ttis == 0 or not last_phy_tti.is_valid()) {
+    return;
+  }
+  // The decisions are generated in order, up to lookahead_ttis after the last one requested by the PHY
+  tti_point target_tti = last_phy_tti + sched_cfg.lookahead_ttis;
+  while (last_tti < target_tti) {
+    new_tti(last_tti + 1);
+  }
+}
+
+/// Late correction of a decision precomputed before the PUSCH CRC was received. The HARQ was assumed to be NACKed,
+/// so its retx grant is removed and the PHICH is turned into an ACK. The PRBs of the retx are left unused
+void sched::cancel_ul_retx(tti_point tti_rx, uint32_t enb_cc_idx, sched_ue& ue)
+{
+  using phich_t = sched_interface::ul_sched_phich_t;
+
+  sched_ue_cell* ue_cc = ue.find_ue_carrier(enb_cc_idx);
+  if (ue_cc == nullptr) {
+    return;
+  }
+  ul_harq_proc* h = ue_cc->harq_ent.get_ul_harq(to_tx_ul(tti_rx));
+  if (not h->is_empty() or not h->has_pending_phich() or h->is_msg3()) {
+    // No retx was allocated for this HARQ. Msg3 retxs are kept, as they may share PRBs with the PUCCH
+    return;
+  }
+  // The PHICH of the cancelled retx is never going to be sent
+  prb_interval retx_alloc = h->get_alloc();
+  h->pop_pending_phich();
+
+  cc_sched_result*                 cc_res = sched_results.get_cc(tti_rx, enb_cc_idx);
+  sched_interface::ul_sched_res_t& ul_res = cc_res->ul_sched_result;
+  uint16_t                         rnti   = ue.get_rnti();
+  auto pusch_it = std::find_if(ul_res.pusch.begin(),
+                               ul_res.pusch.end(),
+                               [rnti](const sched_interface::ul_sched_data_t& p) { return p.dci.rnti == rnti; });
+  if (pusch_it != ul_res.pusch.end()) {
+    ul_res.pusch.erase(pusch_it);
+    cc_res->ul_mask.fill(retx_alloc.start(), retx_alloc.stop(), false);
+  }
+  auto phich_it =
+      std::find_if(ul_res.phich.begin(), ul_res.phich.end(), [rnti](const phich_t& p) { return p.rnti == rnti; });
+  if (phich_it != ul_res.phich.end()) {
+    phich_it->phich = phich_t::ACK;
+  }
+  srslog::fetch_basic_logger("MAC").info(
+      "SCHED: rnti=0x%x, cancelled precomputed UL retx of pid=%d, tti_rx=%d", rnti, h->get_id(), tti_rx.to_uint());
+}
+
 /// Check if TTI result is generated
 bool sched::is_generated(srsran::tti_point tti_rx, uint32_t enb_cc_idx) const
 {
@@ -374,13 +374,7 @@ void sched::carrier_sched::carrier_cfg(const sched_cell_params_t& cell_params_)
   ra_sched_ptr.reset(new ra_sched{*cc_cfg, *ue_db});
 
   // Setup data scheduling algorithms
-  if (cell_params_.sched_cfg->sched_policy == "time_rr") {
-    sched_algo.reset(new sched_time_rr{*cc_cfg, *cell_params_.sched_cfg});
-    logger.info("Using time-domain RR scheduling policy for cc=%d", cc_cfg->enb_cc_idx);
-  } else {
-    sched_algo.reset(new sched_time_pf{*cc_cfg, *cell_params_.sched_cfg});
-    logger.info("Using time-domain PF scheduling policy for cc=%d", cc_cfg->enb_cc_idx);
-  }
+  set_sched_policy();
 
   // Initiate the tti_scheduler for each TTI
   for (sf_sched& tti_sched : sf_scheds) {
@@ -388,6 +382,19 @@ void sched::carrier_sched::carrier_cfg(const sched_cell_params_t& cell_params_)
   }
 }
 
+/// (Re)creates the data scheduling algorithm from the current scheduler args. The state of the previous policy
+/// (e.g. the PF averages) is lost
+void sched::carrier_sched::set_sched_policy()
+{
+  if (cc_cfg->sched_cfg->sched_policy == "time_rr") {
+    sched_algo.reset(new sched_time_rr{*cc_cfg, *cc_cfg->sched_cfg});
+    logger.info("Using time-domain RR scheduling policy for cc=%d", cc_cfg->enb_cc_idx);
+  } else {
+    sched_algo.reset(new sched_time_pf{*cc_cfg, *cc_cfg->sched_cfg});
+    logger.info("Using time-domain PF scheduling policy for cc=%d", cc_cfg->enb_cc_idx);
+  }
+}
+
 void sched::carrier_sched::set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs)
 {
   sf_dl_mask.assign(tti_mask, tti_mask + nof_sfs);
@@ -395,17 +402,32 @@ void sched::carrier_sched::set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs)
 
 const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_rx)
 {
-  sf_sched*        tti_sched = get_sf_sched(tti_rx);
-  sf_sched_result* sf_result = prev_sched_results->get_sf(tti_rx);
-  cc_sched_result* cc_result = sf_result->get_cc(enb_cc_idx);
+  start_tti(tti_rx);
+  alloc_tti(tti_rx, sf_sched::ue_subset_t::all);
+  return finish_tti(tti_rx);
+}
 
-  bool dl_active = sf_dl_mask[tti_sched->get_tti_tx_dl().to_uint() % sf_dl_mask.size()] == 0;
+void sched::carrier_sched::start_tti(tti_point tti_rx)
+{
+  sf_sched* tti_sched = get_sf_sched(tti_rx);
 
   /* Refresh UE internal buffers and subframe vars */
   for (auto& user : *ue_db) {
     user.second->new_subframe(tti_rx, enb_cc_idx);
   }
 
+  /* Set up the Msg3 grid, as it may be shared with the scheduling of another TTI */
+  if (sf_dl_mask[tti_sched->get_tti_tx_dl().to_uint() % sf_dl_mask.size()] == 0) {
+    get_sf_sched(tti_rx + MSG3_DELAY_MS);
+  }
+}
+
+void sched::carrier_sched::alloc_tti(tti_point tti_rx, sf_sched::ue_subset_t subset)
+{
+  sf_sched* tti_sched = get_sf_sched(tti_rx);
+
+  bool dl_active = sf_dl_mask[tti_sched->get_tti_tx_dl().to_uint() % sf_dl_mask.size()] == 0;
+
   /* Schedule PHICH */
   for (auto& ue_pair : *ue_db) {
     if (tti_sched->alloc_phich(ue_pair.second.get()) == alloc_result::no_grant_space) {
@@ -429,6 +451,14 @@ const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_r
     pdcch_order_sched(tti_sched);
   }
 
+  alloc_users(tti_rx, subset);
+}
+
+bool sched::carrier_sched::alloc_users(tti_point tti_rx, sf_sched::ue_subset_t subset)
+{
+  sf_sched* tti_sched = get_sf_sched(tti_rx);
+  tti_sched->set_ue_subset(subset);
+
   /* Prioritize PDCCH scheduling for DL and UL data in a RoundRobin fashion */
   if ((tti_rx.to_uint() % 2) == 0) {
     alloc_ul_users(tti_sched);
@@ -441,6 +471,22 @@ const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_r
     alloc_ul_users(tti_sched);
   }
 
+  for (auto& ue_pair : *ue_db) {
+    uint16_t rnti = ue_pair.first;
+    if (ue_pair.second->nof_carriers_configured() > 1 and
+        (tti_sched->is_dl_alloc(rnti) or tti_sched->is_ul_alloc(rnti))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+const cc_sched_result& sched::carrier_sched::finish_tti(tti_point tti_rx)
+{
+  sf_sched*        tti_sched = get_sf_sched(tti_rx);
+  sf_sched_result* sf_result = prev_sched_results->get_sf(tti_rx);
+  cc_sched_result* cc_result = sf_result->get_cc(enb_cc_idx);
+
   /* Select the winner DCI allocation combination, store all the scheduling results */
   tti_sched->generate_sched_results(*ue_db);
 
@@ -281,20 +281,23 @@ alloc_result sf_grid_t::reserve_ul_prbs(const prbmask_t& prbmask, bool strict)
 bool sf_grid_t::find_ul_alloc(uint32_t L, prb_interval* alloc) const
 {
   *alloc = {};
-  for (uint32_t n = 0; n < ul_mask.size() && alloc->length() < L; n++) {
-    if (not ul_mask.test(n) && alloc->length() == 0) {
-      alloc->displace_to(n);
+  if (L == 0) {
+    return false;
+  }
+  for (uint32_t n = 0; n < ul_mask.size();) {
+    int start = ul_mask.find_lowest(n, ul_mask.size(), false);
+    if (start < 0) {
+      break;
     }
-    if (not ul_mask.test(n)) {
-      alloc->resize_by(1);
-    } else if (alloc->length() > 0) {
+    uint32_t max_stop = std::min((uint32_t)ul_mask.size(), start + L);
+    int      stop     = ul_mask.find_lowest(start + 1, max_stop, true);
+    if (stop >= 0 and stop < 3) {
       // avoid edges
-      if (n < 3) {
-        *alloc = {};
-      } else {
-        break;
-      }
+      n = stop;
+      continue;
     }
+    *alloc = {(uint32_t)start, stop < 0 ? max_stop : (uint32_t)stop};
+    break;
   }
   if (alloc->length() == 0) {
     return false;
@@ -332,6 +335,7 @@ void sf_sched::new_tti(tti_point tti_rx_, sf_sched_result* cc_results_)
   tti_rx = tti_rx_;
   tti_alloc.new_tti(tti_rx_);
   cc_results = cc_results_;
+  ue_subset  = ue_subset_t::all;
 
   // setup first prb to be used for msg3 alloc. Account for potential PRACH alloc
   last_msg3_prb            = tti_alloc.get_pucch_width();
@@ -352,6 +356,19 @@ bool sf_sched::is_ul_alloc(uint16_t rnti) const
       ul_data_allocs.begin(), ul_data_allocs.end(), [rnti](const ul_alloc_t& u) { return u.rnti == rnti; });
 }
 
+bool sf_sched::is_in_ue_subset(const sched_ue& user) const
+{
+  switch (ue_subset) {
+    case ue_subset_t::single_cc:
+      return user.nof_carriers_configured() <= 1;
+    case ue_subset_t::multi_cc:
+      return user.nof_carriers_configured() > 1;
+    default:
+      break;
+  }
+  return true;
+}
+
 alloc_result sf_sched::alloc_sib(uint32_t aggr_lvl, uint32_t sib_idx, uint32_t sib_ntx, rbg_interval rbgs)
 {
   if (bc_allocs.full()) {
@@ -511,6 +528,10 @@ alloc_result sf_sched::alloc_dl_user(sched_ue* user, const rbgmask_t& user_mask,
     return alloc_result::no_rnti_opportunity;
   }
 
+  if (not is_in_ue_subset(*user)) {
+    return alloc_result::no_rnti_opportunity;
+  }
+
   auto* cc = user->find_ue_carrier(cc_cfg->enb_cc_idx);
   if (cc == nullptr or cc->cc_state() != cc_st::active) {
     return alloc_result::no_rnti_opportunity;
@@ -538,7 +559,9 @@ alloc_result sf_sched::alloc_dl_user(sched_ue* user, const rbgmask_t& user_mask,
     }
   }
 
-  bool has_pusch_grant = is_ul_alloc(user->get_rnti()) or cc_results->is_ul_alloc(user->get_rnti());
+  // NOTE: Only UEs with several carriers can have UL grants in the results of other carriers
+  bool has_pusch_grant = is_ul_alloc(user->get_rnti()) or
+                         (user->nof_carriers_configured() > 1 and cc_results->is_ul_alloc(user->get_rnti()));
 
   // Check if there is space in the PUCCH for HARQ ACKs
   const sched_interface::ue_cfg_t& ue_cfg    = user->get_ue_cfg();
@@ -628,6 +651,10 @@ sf_sched::alloc_ul(sched_ue* user, prb_interval alloc, ul_alloc_t::type_t alloc_
 
 alloc_result sf_sched::alloc_ul_user(sched_ue* user, prb_interval alloc)
 {
+  if (not is_in_ue_subset(*user)) {
+    return alloc_result::no_rnti_opportunity;
+  }
+
   // check whether adaptive/non-adaptive retx/newtx
   ul_alloc_t::type_t alloc_type;
   ul_harq_proc*      h        = user->get_ul_harq(get_tti_tx_ul(), cc_cfg->enb_cc_idx);
@@ -822,12 +849,15 @@ uci_pusch_t is_uci_included(const sf_sched*        sf_sched,
   }
 
   for (uint32_t enbccidx = 0; enbccidx < other_cc_results.enb_cc_list.size(); ++enbccidx) {
+    auto p = user->get_active_cell_index(enbccidx);
+    if (not p.first) {
+      continue;
+    }
     for (uint32_t j = 0; j < other_cc_results.enb_cc_list[enbccidx].ul_sched_result.pusch.size(); ++j) {
       // Checks all the UL grants already allocated for the given rnti
       if (other_cc_results.enb_cc_list[enbccidx].ul_sched_result.pusch[j].dci.rnti == user->get_rnti()) {
-        auto p = user->get_active_cell_index(enbccidx);
         // If the UE CC Idx is the lowest so far
-        if (p.first and p.second < ue_cc_idx) {
+        if (p.second < ue_cc_idx) {
           ue_cc_idx      = p.second;
           sel_enb_cc_idx = enbccidx;
         }
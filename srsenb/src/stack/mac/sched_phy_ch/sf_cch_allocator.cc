@@ -99,34 +99,55 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
     }
   }
 
-  // Try to allocate grant. If it fails, attempt the same grant, but using a different permutation of past grant DCI
-  // positions
-  do {
-    bool success = alloc_dfs_node(record, 0);
-    if (success) {
-      // DCI record allocation successful
-      dci_record_list.push_back(record);
-
-      if (is_dl_ctrl_alloc(alloc_type)) {
-        // Dynamic CFI not yet supported for DL control allocations, as coderate can be exceeded
-        current_max_cfix = current_cfix;
+  // Try to allocate grant on top of the current DCI positions
+  nof_dfs_visits = 0;
+  bool success   = alloc_dfs_node(record, 0);
+  if (not success) {
+    temp_dci_dfs = last_dci_dfs;
+
+    // Attempt the combination of DCI positions found the last time the same DCI records were allocated
+    uint32_t search_cfix = current_cfix;
+    success              = alloc_from_memo(record);
+    if (not success) {
+      // Attempt the same grant, but using a different permutation of past grant DCI positions
+      last_dci_dfs = temp_dci_dfs;
+      current_cfix = search_cfix;
+      while (not success and get_next_dfs()) {
+        success = alloc_dfs_node(record, 0);
+      }
+      if (not success and nof_dfs_visits >= MAX_DFS_NODE_VISITS) {
+        // DFS budget exhausted. Fallback to a greedy allocation of all DCI records for the remaining CFIs
+        success = alloc_greedy(record, search_cfix);
+      }
+      if (success) {
+        save_memo(record);
       }
-      return true;
-    }
-    if (temp_dci_dfs.empty()) {
-      temp_dci_dfs = last_dci_dfs;
     }
-  } while (get_next_dfs());
+  }
 
-  // Revert steps to initial state, before dci record allocation was attempted
-  last_dci_dfs.swap(temp_dci_dfs);
-  current_cfix = start_cfix;
-  return false;
+  if (not success) {
+    // Revert steps to initial state, before dci record allocation was attempted
+    last_dci_dfs.swap(temp_dci_dfs);
+    current_cfix = start_cfix;
+    return false;
+  }
+
+  // DCI record allocation successful
+  dci_record_list.push_back(record);
+  if (is_dl_ctrl_alloc(alloc_type)) {
+    // Dynamic CFI not yet supported for DL control allocations, as coderate can be exceeded
+    current_max_cfix = current_cfix;
+  }
+  return true;
 }
 
 bool sf_cch_allocator::get_next_dfs()
 {
   do {
+    if (nof_dfs_visits >= MAX_DFS_NODE_VISITS) {
+      // Bound the time spent in the search
+      return false;
+    }
     uint32_t start_child_idx = 0;
     if (last_dci_dfs.empty()) {
       // If we reach root, increase CFI
@@ -149,6 +170,83 @@ bool sf_cch_allocator::get_next_dfs()
   return true;
 }
 
+bool sf_cch_allocator::alloc_greedy(const alloc_record& record, uint32_t start_cfix)
+{
+  for (current_cfix = start_cfix; current_cfix <= current_max_cfix; ++current_cfix) {
+    last_dci_dfs.clear();
+    if (alloc_record_list(record, nullptr)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool sf_cch_allocator::alloc_record_list(const alloc_record& record, const uint32_t* start_dci_idxs)
+{
+  for (uint32_t i = 0; i <= dci_record_list.size(); ++i) {
+    const alloc_record& rec = i < dci_record_list.size() ? dci_record_list[i] : record;
+    if (not alloc_dfs_node(rec, start_dci_idxs != nullptr ? start_dci_idxs[i] : 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint32_t sf_cch_allocator::record_key(const alloc_record& record)
+{
+  uint32_t rnti = record.user != nullptr ? record.user->get_rnti() : SRSRAN_INVALID_RNTI;
+  return (rnti << 8U) | ((uint32_t)record.alloc_type << 3U) | (record.aggr_idx << 1U) | (record.pusch_uci ? 1U : 0U);
+}
+
+sf_cch_allocator::dfs_memo_entry& sf_cch_allocator::get_memo_entry(const alloc_record& record)
+{
+  uint32_t h = record_key(record);
+  for (const alloc_record& rec : dci_record_list) {
+    h = h * 31U + record_key(rec);
+  }
+  return dfs_memo[h % DFS_MEMO_SIZE];
+}
+
+bool sf_cch_allocator::alloc_from_memo(const alloc_record& record)
+{
+  const dfs_memo_entry& entry = get_memo_entry(record);
+  if (entry.record_keys.size() != dci_record_list.size() + 1 or entry.cfix < current_cfix or
+      entry.cfix > current_max_cfix) {
+    return false;
+  }
+  for (uint32_t i = 0; i < dci_record_list.size(); ++i) {
+    if (entry.record_keys[i] != record_key(dci_record_list[i])) {
+      return false;
+    }
+  }
+  if (entry.record_keys.back() != record_key(record)) {
+    return false;
+  }
+
+  // The PUCCH SR collisions and PUCCH region may differ from the TTI in which the solution was found, so the
+  // DCI positions are re-validated
+  current_cfix = entry.cfix;
+  last_dci_dfs.clear();
+  return alloc_record_list(record, entry.dci_pos_idxs.data());
+}
+
+void sf_cch_allocator::save_memo(const alloc_record& record)
+{
+  dfs_memo_entry& entry = get_memo_entry(record);
+  if (dci_record_list.size() >= entry.record_keys.capacity()) {
+    return;
+  }
+  entry.cfix            = current_cfix;
+  entry.record_keys.clear();
+  entry.dci_pos_idxs.clear();
+  for (uint32_t i = 0; i < dci_record_list.size(); ++i) {
+    entry.record_keys.push_back(record_key(dci_record_list[i]));
+    entry.dci_pos_idxs.push_back(last_dci_dfs[i].dci_pos_idx);
+  }
+  entry.record_keys.push_back(record_key(record));
+  entry.dci_pos_idxs.push_back(last_dci_dfs.back().dci_pos_idx);
+}
+
 bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start_dci_idx)
 {
   // Get DCI Location Table
@@ -161,6 +259,7 @@ bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start
     return false;
   }
 
+  nof_dfs_visits++;
   tree_node node;
   node.dci_pos_idx = start_dci_idx;
   node.dci_pos.L   = record.aggr_idx;
@@ -0,0 +1,564 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/sched_trace.h"
+#include "srsenb/hdr/stack/mac/sched.h"
+#include "srsran/srslog/srslog.h"
+#include <cstring>
+
+namespace srsenb {
+
+namespace {
+
+const char     trace_magic[8]    = {'S', 'R', 'S', 'S', 'C', 'H', 'E', 'D'};
+const uint32_t trace_version     = 2;
+const size_t   trace_flush_bytes = 1U << 20U;
+
+/// Identifies the memory representation of the structs that are stored in the trace
+struct trace_header_t {
+  char     magic[8];
+  uint32_t version;
+  uint32_t ue_cc_cfg_size;
+  uint32_t pucch_cfg_size;
+  uint32_t cell_size;
+};
+
+trace_header_t make_trace_header()
+{
+  trace_header_t h;
+  memcpy(h.magic, trace_magic, sizeof(trace_magic));
+  h.version        = trace_version;
+  h.ue_cc_cfg_size = sizeof(sched_interface::ue_cfg_t::cc_cfg_t);
+  h.pucch_cfg_size = sizeof(srsran_pucch_cfg_t);
+  h.cell_size      = sizeof(srsran_cell_t);
+  return h;
+}
+
+struct trace_encoder {
+  std::vector<uint8_t>& buffer;
+
+  template <typename T>
+  void operator()(const T& v)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be packed");
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(&v);
+    buffer.insert(buffer.end(), ptr, ptr + sizeof(T));
+  }
+  void operator()(const std::string& s)
+  {
+    (*this)((uint16_t)s.size());
+    buffer.insert(buffer.end(), s.begin(), s.end());
+  }
+  template <typename T>
+  void operator()(const std::vector<T>& vec)
+  {
+    (*this)((uint16_t)vec.size());
+    for (const T& v : vec) {
+      (*this)(v);
+    }
+  }
+};
+
+struct trace_decoder {
+  const uint8_t* ptr;
+  const uint8_t* end;
+  bool           ok = true;
+
+  template <typename T>
+  void operator()(T& v)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be unpacked");
+    if (not ok or (size_t)(end - ptr) < sizeof(T)) {
+      ok = false;
+      return;
+    }
+    memcpy(&v, ptr, sizeof(T));
+    ptr += sizeof(T);
+  }
+  void operator()(std::string& s)
+  {
+    uint16_t len = 0;
+    (*this)(len);
+    if (not ok or (size_t)(end - ptr) < len) {
+      ok = false;
+      return;
+    }
+    s.assign(reinterpret_cast<const char*>(ptr), len);
+    ptr += len;
+  }
+  template <typename T>
+  void operator()(std::vector<T>& vec)
+  {
+    uint16_t len = 0;
+    (*this)(len);
+    vec.resize(ok ? len : 0);
+    for (T& v : vec) {
+      (*this)(v);
+    }
+  }
+};
+
+template <typename... Args>
+bool unpack(trace_decoder& dec, Args&... args)
+{
+  int dummy[] = {0, (dec(args), 0)...};
+  (void)dummy;
+  return dec.ok;
+}
+
+// The same field visitors are used to encode and decode the configuration structs
+
+template <typename Codec, typename SchedArgs>
+void visit_sched_args(Codec& c, SchedArgs& a)
+{
+  c(a.sched_policy);
+  c(a.sched_policy_args);
+  c(a.pdsch_mcs);
+  c(a.pdsch_max_mcs);
+  c(a.pusch_mcs);
+  c(a.pusch_max_mcs);
+  c(a.min_nof_ctrl_symbols);
+  c(a.max_nof_ctrl_symbols);
+  c(a.min_aggr_level);
+  c(a.max_aggr_level);
+  c(a.adaptive_aggr_level);
+  c(a.pucch_mux_enabled);
+  c(a.pucch_harq_max_rb);
+  c(a.target_bler);
+  c(a.max_delta_dl_cqi);
+  c(a.max_delta_ul_snr);
+  c(a.adaptive_dl_mcs_step_size);
+  c(a.adaptive_ul_mcs_step_size);
+  c(a.min_tpc_tti_interval);
+  c(a.ul_snr_avg_alpha);
+  c(a.init_ul_snr_value);
+  c(a.init_dl_cqi);
+  c(a.max_sib_coderate);
+  c(a.pdcch_cqi_offset);
+  c(a.nof_cc_threads);
+  c(a.lookahead_ttis);
+}
+
+template <typename Codec, typename CellCfg>
+void visit_cell_cfg(Codec& c, CellCfg& a)
+{
+  c(a.cell);
+  c(a.sibs);
+  c(a.si_window_ms);
+  c(a.target_pucch_ul_sinr);
+  c(a.pusch_hopping_cfg);
+  c(a.target_pusch_ul_sinr);
+  c(a.min_phr_thres);
+  c(a.enable_phr_handling);
+  c(a.enable_64qam);
+  c(a.prach_config);
+  c(a.prach_nof_preambles);
+  c(a.prach_freq_offset);
+  c(a.prach_rar_window);
+  c(a.prach_contention_resolution_timer);
+  c(a.maxharq_msg3tx);
+  c(a.n1pucch_an);
+  c(a.delta_pucch_shift);
+  c(a.nrb_pucch);
+  c(a.nrb_cqi);
+  c(a.ncs_an);
+  c(a.srs_subframe_config);
+  c(a.srs_subframe_offset);
+  c(a.srs_bw_config);
+  c(a.scell_list);
+}
+
+template <typename Codec, typename UeCfg>
+void visit_ue_cfg(Codec& c, UeCfg& a)
+{
+  c(a.maxharq_tx);
+  c(a.continuous_pusch);
+  c(a.uci_offset);
+  c(a.pucch_cfg);
+  c(a.ue_bearers);
+  c(a.supported_cc_list);
+  c(a.dl_ant_info);
+  c(a.use_tbs_index_alt);
+  c(a.measgap_period);
+  c(a.measgap_offset);
+  c(a.support_ul64qam);
+}
+
+} // namespace
+
+const char* to_string(sched_trace_event_t ev)
+{
+  static const char* names[] = {"sched_args", "cell_cfg", "reset", "ue_cfg", "ue_rem", "phy_cfg", "bearer_cfg",
+                                "bearer_rem", "dl_rlc_buffer", "dl_mac_buffer", "dl_ack", "dl_rach", "dl_ri", "dl_pmi",
+                                "dl_cqi", "dl_sb_cqi", "ul_crc", "ul_sr", "ul_bsr", "ul_phr", "ul_snr", "ul_buffer_add",
+                                "pdcch_order", "dl_tti_mask", "dl_sched", "ul_sched"};
+  static_assert(sizeof(names) / sizeof(names[0]) == (size_t)sched_trace_event_t::nof_events, "Missing event names");
+  return ev < sched_trace_event_t::nof_events ? names[(size_t)ev] : "invalid";
+}
+
+/*******************************************************
+ *                  Trace Writer
+ *******************************************************/
+
+sched_trace_writer::~sched_trace_writer()
+{
+  close();
+}
+
+bool sched_trace_writer::open(const std::string& filename)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  fp = fopen(filename.c_str(), "wb");
+  if (fp == nullptr) {
+    srslog::fetch_basic_logger("MAC").error("SCHED: Couldn't open scheduler trace file %s", filename.c_str());
+    return false;
+  }
+  buffer.reserve(trace_flush_bytes + UINT16_MAX);
+  trace_encoder enc{buffer};
+  enc(make_trace_header());
+  return true;
+}
+
+void sched_trace_writer::close()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (fp != nullptr) {
+    flush();
+    fclose(fp);
+    fp = nullptr;
+  }
+}
+
+void sched_trace_writer::flush()
+{
+  if (fp != nullptr and not buffer.empty()) {
+    fwrite(buffer.data(), 1, buffer.size(), fp);
+  }
+  buffer.clear();
+}
+
+void sched_trace_writer::pack(const std::string& s)
+{
+  trace_encoder enc{buffer};
+  enc(s);
+}
+
+size_t sched_trace_writer::begin_event(sched_trace_event_t ev)
+{
+  size_t start = buffer.size();
+  pack(ev);
+  pack((uint16_t)0);
+  return start;
+}
+
+void sched_trace_writer::end_event(size_t start)
+{
+  size_t payload_len = buffer.size() - start - sizeof(uint8_t) - sizeof(uint16_t);
+  if (payload_len > UINT16_MAX) {
+    srslog::fetch_basic_logger("MAC").error("SCHED: Dropping %s event of the scheduler trace with %zd bytes",
+                                            to_string((sched_trace_event_t)buffer[start]),
+                                            payload_len);
+    buffer.resize(start);
+    return;
+  }
+  uint16_t len = payload_len;
+  memcpy(&buffer[start + 1], &len, sizeof(len));
+  if (buffer.size() >= trace_flush_bytes) {
+    flush();
+  }
+}
+
+void sched_trace_writer::write_sched_args(const sched_interface::sched_args_t& args)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  size_t                      start = begin_event(sched_trace_event_t::sched_args);
+  trace_encoder               enc{buffer};
+  visit_sched_args(enc, args);
+  end_event(start);
+}
+
+void sched_trace_writer::write_cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  size_t                      start = begin_event(sched_trace_event_t::cell_cfg);
+  trace_encoder               enc{buffer};
+  enc((uint16_t)cell_cfg.size());
+  for (const auto& c : cell_cfg) {
+    visit_cell_cfg(enc, c);
+  }
+  end_event(start);
+}
+
+void sched_trace_writer::write_ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  size_t                      start = begin_event(sched_trace_event_t::ue_cfg);
+  trace_encoder               enc{buffer};
+  enc(rnti);
+  visit_ue_cfg(enc, ue_cfg);
+  end_event(start);
+}
+
+void sched_trace_writer::write_dl_tti_mask(const uint8_t* tti_mask, uint32_t nof_sfs)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  size_t                      start = begin_event(sched_trace_event_t::dl_tti_mask);
+  pack(nof_sfs);
+  buffer.insert(buffer.end(), tti_mask, tti_mask + nof_sfs);
+  end_event(start);
+}
+
+/*******************************************************
+ *                  Trace Reader
+ *******************************************************/
+
+bool sched_trace_reader::open(const std::string& filename, sched_interface::sched_args_t& args)
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("MAC");
+
+  data.clear();
+  event_offsets.clear();
+  next_event = 0;
+
+  FILE* fp = fopen(filename.c_str(), "rb");
+  if (fp == nullptr) {
+    logger.error("SCHED: Couldn't open scheduler trace file %s", filename.c_str());
+    return false;
+  }
+  uint8_t buf[4096];
+  size_t  n;
+  while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+    data.insert(data.end(), buf, buf + n);
+  }
+  fclose(fp);
+
+  trace_header_t header   = {};
+  trace_header_t expected = make_trace_header();
+  trace_decoder  dec{data.data(), data.data() + data.size()};
+  if (not unpack(dec, header) or memcmp(&header, &expected, sizeof(header)) != 0) {
+    logger.error("SCHED: %s is not a scheduler trace of this build", filename.c_str());
+    return false;
+  }
+
+  // Index the events
+  while (dec.ptr < dec.end) {
+    size_t              offset = dec.ptr - data.data();
+    sched_trace_event_t ev;
+    uint16_t            len = 0;
+    if (not unpack(dec, ev, len) or (size_t)(dec.end - dec.ptr) < len) {
+      logger.warning("SCHED: Scheduler trace %s is truncated after %zd events", filename.c_str(), nof_events());
+      break;
+    }
+    event_offsets.push_back(offset);
+    dec.ptr += len;
+  }
+
+  // The first event holds the scheduler arguments
+  if (event_offsets.empty() or data[event_offsets[0]] != (uint8_t)sched_trace_event_t::sched_args) {
+    logger.error("SCHED: Scheduler trace %s does not start with the scheduler arguments", filename.c_str());
+    return false;
+  }
+  dec.ptr = data.data() + event_offsets[0] + sizeof(uint8_t) + sizeof(uint16_t);
+  visit_sched_args(dec, args);
+  next_event = 1;
+  return dec.ok;
+}
+
+void sched_trace_reader::rewind()
+{
+  next_event = 1;
+}
+
+bool sched_trace_reader::replay_next(sched& sched_obj, sched_trace_event_t& ev, srsran::tti_point& tti_rx)
+{
+  if (next_event >= event_offsets.size()) {
+    return false;
+  }
+  const uint8_t* ptr = data.data() + event_offsets[next_event];
+  const uint8_t* end = next_event + 1 < event_offsets.size() ? data.data() + event_offsets[next_event + 1]
+                                                              : data.data() + data.size();
+  next_event++;
+  trace_decoder dec{ptr, end};
+  uint16_t      len;
+  unpack(dec, ev, len);
+
+  uint32_t tti = 0, cc = 0, lcid = 0, val = 0, val2 = 0;
+  uint16_t rnti = SRSRAN_INVALID_RNTI;
+  bool     flag = false;
+  switch (ev) {
+    case sched_trace_event_t::sched_args:
+      break;
+    case sched_trace_event_t::cell_cfg: {
+      std::vector<sched_interface::cell_cfg_t> cell_cfg;
+      uint16_t                                 nof_cells = 0;
+      if (unpack(dec, nof_cells)) {
+        cell_cfg.resize(nof_cells);
+        for (auto& c : cell_cfg) {
+          visit_cell_cfg(dec, c);
+        }
+      }
+      if (dec.ok) {
+        sched_obj.cell_cfg(cell_cfg);
+      }
+    } break;
+    case sched_trace_event_t::reset:
+      sched_obj.reset();
+      break;
+    case sched_trace_event_t::ue_cfg: {
+      sched_interface::ue_cfg_t ue_cfg;
+      if (unpack(dec, rnti)) {
+        visit_ue_cfg(dec, ue_cfg);
+      }
+      if (dec.ok) {
+        sched_obj.ue_cfg(rnti, ue_cfg);
+      }
+    } break;
+    case sched_trace_event_t::ue_rem:
+      if (unpack(dec, rnti)) {
+        sched_obj.ue_rem(rnti);
+      }
+      break;
+    case sched_trace_event_t::phy_cfg:
+      if (unpack(dec, rnti, flag)) {
+        sched_obj.phy_config_enabled(rnti, flag);
+      }
+      break;
+    case sched_trace_event_t::bearer_cfg: {
+      mac_lc_ch_cfg_t cfg;
+      if (unpack(dec, rnti, lcid, cfg)) {
+        sched_obj.bearer_ue_cfg(rnti, lcid, cfg);
+      }
+    } break;
+    case sched_trace_event_t::bearer_rem:
+      if (unpack(dec, rnti, lcid)) {
+        sched_obj.bearer_ue_rem(rnti, lcid);
+      }
+      break;
+    case sched_trace_event_t::dl_rlc_buffer:
+      if (unpack(dec, rnti, lcid, val, val2)) {
+        sched_obj.dl_rlc_buffer_state(rnti, lcid, val, val2);
+      }
+      break;
+    case sched_trace_event_t::dl_mac_buffer:
+      if (unpack(dec, rnti, val, val2)) {
+        sched_obj.dl_mac_buffer_state(rnti, val, val2);
+      }
+      break;
+    case sched_trace_event_t::dl_ack:
+      if (unpack(dec, tti, rnti, cc, val, flag)) {
+        sched_obj.dl_ack_info(tti, rnti, cc, val, flag);
+      }
+      break;
+    case sched_trace_event_t::dl_rach: {
+      sched_interface::dl_sched_rar_info_t rar_info;
+      if (unpack(dec, cc, rar_info)) {
+        sched_obj.dl_rach_info(cc, rar_info);
+      }
+    } break;
+    case sched_trace_event_t::dl_ri:
+      if (unpack(dec, tti, rnti, cc, val)) {
+        sched_obj.dl_ri_info(tti, rnti, cc, val);
+      }
+      break;
+    case sched_trace_event_t::dl_pmi:
+      if (unpack(dec, tti, rnti, cc, val)) {
+        sched_obj.dl_pmi_info(tti, rnti, cc, val);
+      }
+      break;
+    case sched_trace_event_t::dl_cqi:
+      if (unpack(dec, tti, rnti, cc, val)) {
+        sched_obj.dl_cqi_info(tti, rnti, cc, val);
+      }
+      break;
+    case sched_trace_event_t::dl_sb_cqi:
+      if (unpack(dec, tti, rnti, cc, val, val2)) {
+        sched_obj.dl_sb_cqi_info(tti, rnti, cc, val, val2);
+      }
+      break;
+    case sched_trace_event_t::ul_crc:
+      if (unpack(dec, tti, rnti, cc, flag)) {
+        sched_obj.ul_crc_info(tti, rnti, cc, flag);
+      }
+      break;
+    case sched_trace_event_t::ul_sr:
+      if (unpack(dec, tti, rnti)) {
+        sched_obj.ul_sr_info(tti, rnti);
+      }
+      break;
+    case sched_trace_event_t::ul_bsr:
+      if (unpack(dec, rnti, val, val2)) {
+        sched_obj.ul_bsr(rnti, val, val2);
+      }
+      break;
+    case sched_trace_event_t::ul_phr: {
+      int phr = 0;
+      if (unpack(dec, rnti, phr, val)) {
+        sched_obj.ul_phr(rnti, phr, val);
+      }
+    } break;
+    case sched_trace_event_t::ul_snr: {
+      float snr = 0;
+      if (unpack(dec, tti, rnti, cc, snr, val)) {
+        sched_obj.ul_snr_info(tti, rnti, cc, snr, val);
+      }
+    } break;
+    case sched_trace_event_t::ul_buffer_add:
+      if (unpack(dec, rnti, lcid, val)) {
+        sched_obj.ul_buffer_add(rnti, lcid, val);
+      }
+      break;
+    case sched_trace_event_t::pdcch_order: {
+      sched_interface::dl_sched_po_info_t po_info;
+      if (unpack(dec, cc, po_info)) {
+        sched_obj.set_pdcch_order(cc, po_info);
+      }
+    } break;
+    case sched_trace_event_t::dl_tti_mask:
+      if (unpack(dec, val) and (size_t)(dec.end - dec.ptr) >= val) {
+        std::vector<uint8_t> tti_mask(dec.ptr, dec.ptr + val);
+        sched_obj.set_dl_tti_mask(tti_mask.data(), val);
+      } else {
+        dec.ok = false;
+      }
+      break;
+    case sched_trace_event_t::dl_sched:
+      if (unpack(dec, tti, cc)) {
+        tti_rx = srsran::tti_point{tti} - TX_ENB_DELAY;
+        sched_obj.dl_sched(tti, cc, dl_result);
+      }
+      break;
+    case sched_trace_event_t::ul_sched:
+      if (unpack(dec, tti, cc)) {
+        tti_rx = srsran::tti_point{tti} - TX_ENB_DELAY - FDD_HARQ_DELAY_DL_MS;
+        sched_obj.ul_sched(tti, cc, ul_result);
+      }
+      break;
+    default:
+      dec.ok = false;
+      break;
+  }
+  if (not dec.ok) {
+    srslog::fetch_basic_logger("MAC").error("SCHED: Corrupted %s event in the scheduler trace", to_string(ev));
+  }
+  return dec.ok;
+}
+
+} // namespace srsenb
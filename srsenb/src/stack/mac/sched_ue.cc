@@ -96,6 +96,16 @@ void sched_ue::set_cfg(const ue_cfg_t& cfg_)
   check_ue_cfg_correctness(cfg);
 }
 
+/// Called when the MCS limits of the scheduler args change
+void sched_ue::update_max_mcs()
+{
+  for (auto& c : cells) {
+    if (c.configured()) {
+      c.update_max_mcs();
+    }
+  }
+}
+
 void sched_ue::new_subframe(tti_point tti_rx, uint32_t enb_cc_idx)
 {
   if (current_tti != tti_rx) {
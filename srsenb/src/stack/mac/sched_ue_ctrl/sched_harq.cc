@@ -211,7 +211,7 @@ rbgmask_t dl_harq_proc::get_rbgmask() const
 
 bool dl_harq_proc::has_pending_retx(uint32_t tb_idx, tti_point tti_tx_dl) const
 {
-  return (tti_tx_dl >= to_tx_dl_ack(tti)) and has_pending_retx_common(tb_idx);
+  return (tti_tx_dl >= to_tx_dl_ack(tti) + ack_delay) and has_pending_retx_common(tb_idx);
 }
 
 bool dl_harq_proc::has_pending_retx(tti_point tti_tx_dl) const
@@ -67,17 +67,49 @@ uint32_t get_ul_mac_sdu_size_with_overhead(uint32_t rlc_pdu_bytes)
 void lch_ue_manager::set_cfg(const sched_interface::ue_cfg_t& cfg)
 {
   config_lcids(cfg.ue_bearers);
+  update_prio_order();
+}
+
+void lch_ue_manager::config_lcid(uint32_t lcid, const mac_lc_ch_cfg_t& bearer_cfg)
+{
+  base_type::config_lcid(lcid, bearer_cfg);
+  update_prio_order();
+}
+
+/// Sorts the LCIDs by priority. The order only changes with the bearer configuration
+void lch_ue_manager::update_prio_order()
+{
+  for (uint32_t lcid = 0; is_lcid_valid(lcid); ++lcid) {
+    lcids_by_prio[lcid] = lcid;
+  }
+  std::stable_sort(lcids_by_prio.begin(), lcids_by_prio.end(), [this](uint8_t lhs, uint8_t rhs) {
+    return channels[lhs].cfg.priority < channels[rhs].cfg.priority;
+  });
+  pending_ranks.reset();
+  for (uint32_t rank = 0; rank < MAX_NOF_LCIDS; ++rank) {
+    prio_rank[lcids_by_prio[rank]] = rank;
+  }
+  for (uint32_t lcid = 0; is_lcid_valid(lcid); ++lcid) {
+    update_lcid_state(lcid);
+  }
+}
+
+void lch_ue_manager::update_lcid_state(uint32_t lcid)
+{
+  const logical_channel& ch = channels[lcid];
+  pending_ranks.set(prio_rank[lcid], get_dl_tx_total(lcid) > 0);
+  refill_lcids.set(lcid, is_bearer_active(lcid) and ch.cfg.pbr != pbr_infinity and ch.Bj < ch.bucket_size);
 }
 
 void lch_ue_manager::new_tti()
 {
   prio_idx++;
-  for (uint32_t lcid = 0; lcid < sched_interface::MAX_LC; ++lcid) {
-    if (is_bearer_active(lcid)) {
-      if (channels[lcid].cfg.pbr != pbr_infinity) {
-        channels[lcid].Bj =
-            std::min(channels[lcid].Bj + (int)(channels[lcid].cfg.pbr * tti_duration_ms), channels[lcid].bucket_size);
-      }
+  for (int lcid = refill_lcids.find_lowest(0, MAX_NOF_LCIDS); lcid >= 0;
+       lcid     = refill_lcids.find_lowest(lcid + 1, MAX_NOF_LCIDS)) {
+    logical_channel& ch = channels[lcid];
+    ch.Bj               = std::min(ch.Bj + (int)(ch.cfg.pbr * tti_duration_ms), ch.bucket_size);
+    if (ch.Bj >= ch.bucket_size) {
+      refill_lcids.reset(lcid);
     }
   }
 }
@@ -85,6 +117,7 @@ void lch_ue_manager::new_tti()
 void lch_ue_manager::dl_buffer_state(uint8_t lcid, uint32_t tx_queue, uint32_t prio_tx_queue)
 {
   if (base_type::dl_buffer_state(lcid, tx_queue, prio_tx_queue) == SRSRAN_SUCCESS) {
+    update_lcid_state(lcid);
     logger.debug("SCHED: rnti=0x%x DL lcid=%d buffer_state=%d,%d", rnti, lcid, tx_queue, prio_tx_queue);
   }
 }
@@ -121,50 +154,37 @@ void lch_ue_manager::ul_buffer_add(uint8_t lcid, uint32_t bytes)
 
 int lch_ue_manager::get_max_prio_lcid() const
 {
-  int min_prio_val = std::numeric_limits<int>::max(), prio_lcid = -1;
+  // The LCIDs with pending data are visited in priority order, so the first match has the highest priority
+  int first_rank = pending_ranks.find_lowest(0, MAX_NOF_LCIDS);
+  if (first_rank < 0) {
+    return -1;
+  }
 
   // Prioritized Txs first (e.g. Retxs, status PDUs)
-  for (uint32_t lcid = 0; is_lcid_valid(lcid); ++lcid) {
-    if (get_dl_prio_tx(lcid) > 0 and channels[lcid].cfg.priority < min_prio_val) {
-      min_prio_val = channels[lcid].cfg.priority;
-      prio_lcid    = lcid;
+  for (int rank = first_rank; rank >= 0; rank = pending_ranks.find_lowest(rank + 1, MAX_NOF_LCIDS)) {
+    if (get_dl_prio_tx(lcids_by_prio[rank]) > 0) {
+      return lcids_by_prio[rank];
     }
   }
-  if (prio_lcid >= 0) {
-    return prio_lcid;
-  }
 
   // Select lcid with new txs using Bj
-  for (uint32_t lcid = 0; is_lcid_valid(lcid); ++lcid) {
-    if (get_dl_tx(lcid) > 0 and channels[lcid].Bj > 0 and channels[lcid].cfg.priority < min_prio_val) {
-      min_prio_val = channels[lcid].cfg.priority;
-      prio_lcid    = lcid;
+  for (int rank = first_rank; rank >= 0; rank = pending_ranks.find_lowest(rank + 1, MAX_NOF_LCIDS)) {
+    uint32_t lcid = lcids_by_prio[rank];
+    if (get_dl_tx(lcid) > 0 and channels[lcid].Bj > 0) {
+      return lcid;
     }
   }
-  if (prio_lcid >= 0) {
-    return prio_lcid;
-  }
 
   // Disregard Bj
   size_t                              nof_lcids    = 0;
   std::array<uint32_t, MAX_NOF_LCIDS> chosen_lcids = {};
-  for (uint32_t lcid = 0; is_lcid_valid(lcid); ++lcid) {
-    if (get_dl_tx_total(lcid) > 0) {
-      if (channels[lcid].cfg.priority < min_prio_val) {
-        min_prio_val    = channels[lcid].cfg.priority;
-        chosen_lcids[0] = lcid;
-        nof_lcids       = 1;
-      } else if (channels[lcid].cfg.priority == min_prio_val) {
-        chosen_lcids[nof_lcids++] = lcid;
-      }
-    }
+  int                                 min_prio_val = channels[lcids_by_prio[first_rank]].cfg.priority;
+  for (int rank = first_rank; rank >= 0 and channels[lcids_by_prio[rank]].cfg.priority == min_prio_val;
+       rank     = pending_ranks.find_lowest(rank + 1, MAX_NOF_LCIDS)) {
+    chosen_lcids[nof_lcids++] = lcids_by_prio[rank];
   }
   // logical chanels with equal priority should be served equally
-  if (nof_lcids > 0) {
-    prio_lcid = chosen_lcids[prio_idx % nof_lcids];
-  }
-
-  return prio_lcid;
+  return chosen_lcids[prio_idx % nof_lcids];
 }
 
 /// Allocates first available RLC PDU
@@ -186,7 +206,7 @@ int lch_ue_manager::alloc_rlc_pdu(sched_interface::dl_sched_pdu_t* rlc_pdu, int
 
   // If it is last PDU of the TBS, allocate all leftover bytes
   int leftover_bytes = rem_bytes - alloc_bytes;
-  if (leftover_bytes > 0 and (leftover_bytes <= MAC_MIN_ALLOC_SIZE or get_dl_tx_total() == 0)) {
+  if (leftover_bytes > 0 and (leftover_bytes <= MAC_MIN_ALLOC_SIZE or pending_ranks.none())) {
     alloc_bytes += leftover_bytes;
   }
 
@@ -206,6 +226,7 @@ int lch_ue_manager::alloc_prio_tx_bytes(uint8_t lcid, int rem_bytes)
   int rem_bytes_no_header = rem_bytes - rlc_overhead;
   int alloc               = std::min(rem_bytes_no_header, get_dl_prio_tx(lcid));
   channels[lcid].buf_prio_tx -= alloc;
+  update_lcid_state(lcid);
   return alloc + (alloc > 0 ? rlc_overhead : 0);
 }
 
@@ -222,20 +243,23 @@ int lch_ue_manager::alloc_tx_bytes(uint8_t lcid, int rem_bytes)
     // Update Bj
     channels[lcid].Bj -= alloc;
   }
+  update_lcid_state(lcid);
   return alloc + (alloc > 0 ? rlc_overhead : 0);
 }
 
 bool lch_ue_manager::has_pending_dl_txs() const
 {
-  if (not pending_ces.empty()) {
-    return true;
-  }
-  for (uint32_t lcid = 0; is_lcid_valid(lcid); ++lcid) {
-    if (get_dl_tx_total(lcid) > 0) {
-      return true;
-    }
+  return not pending_ces.empty() or pending_ranks.any();
+}
+
+int lch_ue_manager::get_dl_tx_total() const
+{
+  int sum = 0;
+  for (int rank = pending_ranks.find_lowest(0, MAX_NOF_LCIDS); rank >= 0;
+       rank     = pending_ranks.find_lowest(rank + 1, MAX_NOF_LCIDS)) {
+    sum += get_dl_tx_total(lcids_by_prio[rank]);
   }
-  return false;
+  return sum;
 }
 
 int lch_ue_manager::get_dl_tx_total_with_overhead(uint32_t lcid) const
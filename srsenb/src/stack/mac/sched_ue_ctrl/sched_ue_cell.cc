@@ -66,12 +66,16 @@ sched_ue_cell::sched_ue_cell(uint16_t rnti_, const sched_cell_params_t& cell_cfg
   ul_delta_dec      = (1 - target_bler) * ul_delta_inc / target_bler;
   max_cqi_coeff     = cell_cfg->sched_cfg->max_delta_dl_cqi;
   max_snr_coeff     = cell_cfg->sched_cfg->max_delta_ul_snr;
+
+  // The HARQ-ACKs of the TTIs precomputed ahead of the PHY arrive after the decision. Wait for them, instead of
+  // retransmitting HARQs that may have been ACKed
+  for (dl_harq_proc& h : harq_ent.dl_harq_procs()) {
+    h.set_ack_delay(cell_cfg->sched_cfg->lookahead_ttis);
+  }
 }
 
 void sched_ue_cell::set_ue_cfg(const sched_interface::ue_cfg_t& ue_cfg_)
 {
-  static const std::array<uint32_t, 3> max_64qam_mcs{20, 24, 28};
-
   cfg_tti            = current_tti;
   ue_cfg             = &ue_cfg_;
   int prev_ue_cc_idx = ue_cc_idx;
@@ -86,15 +90,7 @@ void sched_ue_cell::set_ue_cfg(const sched_interface::ue_cfg_t& ue_cfg_)
     return;
   }
 
-  // set max mcs
-  max_mcs_ul = cell_cfg->sched_cfg->pusch_max_mcs >= 0 ? cell_cfg->sched_cfg->pusch_max_mcs : 28U;
-  if (cell_cfg->cfg.enable_64qam) {
-    max_mcs_ul = std::min(max_mcs_ul, max_64qam_mcs[(size_t)ue_cfg->support_ul64qam]);
-  }
-  max_mcs_dl = cell_cfg->sched_cfg->pdsch_max_mcs >= 0 ? std::min(cell_cfg->sched_cfg->pdsch_max_mcs, 28) : 28U;
-  if (ue_cfg->use_tbs_index_alt) {
-    max_mcs_dl = std::min(max_mcs_dl, 27U);
-  }
+  update_max_mcs();
 
   if (ue_cc_idx >= 0) {
     const auto& cc = ue_cfg_.supported_cc_list[ue_cc_idx];
@@ -144,6 +140,23 @@ void sched_ue_cell::set_ue_cfg(const sched_interface::ue_cfg_t& ue_cfg_)
   }
 }
 
+void sched_ue_cell::update_max_mcs()
+{
+  static const std::array<uint32_t, 3> max_64qam_mcs{20, 24, 28};
+
+  if (ue_cfg == nullptr) {
+    return;
+  }
+  max_mcs_ul = cell_cfg->sched_cfg->pusch_max_mcs >= 0 ? cell_cfg->sched_cfg->pusch_max_mcs : 28U;
+  if (cell_cfg->cfg.enable_64qam) {
+    max_mcs_ul = std::min(max_mcs_ul, max_64qam_mcs[(size_t)ue_cfg->support_ul64qam]);
+  }
+  max_mcs_dl = cell_cfg->sched_cfg->pdsch_max_mcs >= 0 ? std::min(cell_cfg->sched_cfg->pdsch_max_mcs, 28) : 28U;
+  if (ue_cfg->use_tbs_index_alt) {
+    max_mcs_dl = std::min(max_mcs_dl, 27U);
+  }
+}
+
 void sched_ue_cell::new_tti(tti_point tti_rx)
 {
   if (not configured()) {
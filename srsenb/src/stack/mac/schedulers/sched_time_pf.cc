@@ -20,7 +20,7 @@
  */
 
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_pf.h"
-#include <vector>
+#include <algorithm>
 
 namespace srsenb {
 
@@ -33,52 +33,47 @@ sched_time_pf::sched_time_pf(const sched_cell_params_t& cell_params_, const sche
     fairness_coeff = std::stof(sched_args.sched_policy_args);
   }
 
-  std::vector<ue_ctxt*> dl_storage;
-  dl_storage.reserve(SRSENB_MAX_UES);
-  dl_queue = ue_dl_queue_t(ue_dl_prio_compare{}, std::move(dl_storage));
-
-  std::vector<ue_ctxt*> ul_storage;
-  ul_storage.reserve(SRSENB_MAX_UES);
-  ul_queue = ue_ul_queue_t(ue_ul_prio_compare{}, std::move(ul_storage));
+  dl_queue.reserve(SRSENB_MAX_UES);
+  ul_queue.reserve(SRSENB_MAX_UES);
 }
 
 void sched_time_pf::new_tti(sched_ue_list& ue_db, sf_sched* tti_sched)
 {
-  while (not dl_queue.empty()) {
-    dl_queue.pop();
-  }
-  while (not ul_queue.empty()) {
-    ul_queue.pop();
-  }
-  current_tti_rx = tti_point{tti_sched->get_tti_rx()};
+  dl_queue.clear();
+  ul_queue.clear();
+  current_tti_rx    = tti_point{tti_sched->get_tti_rx()};
+  current_ue_subset = tti_sched->get_ue_subset();
   // remove deleted users from history
-  for (auto it = ue_history_db.begin(); it != ue_history_db.end();) {
-    if (not ue_db.contains(it->first)) {
-      it = ue_history_db.erase(it);
+  for (uint32_t i = 0; i < ues.nof_ues;) {
+    if (not ue_db.contains(ues.rnti[i])) {
+      rem_ue(i);
     } else {
-      ++it;
+      ++i;
     }
   }
   // add new users to history db, and update priority queues
   for (auto& u : ue_db) {
-    auto it = ue_history_db.find(u.first);
-    if (it == ue_history_db.end()) {
-      it = ue_history_db.insert(u.first, ue_ctxt{u.first, fairness_coeff}).value();
+    if (not tti_sched->is_in_ue_subset(*u.second)) {
+      // UE is scheduled in another pass of this TTI
+      continue;
     }
-    it->second.new_tti(*cc_cfg, *u.second, tti_sched);
-    if (it->second.dl_newtx_h != nullptr or it->second.dl_retx_h != nullptr) {
-      dl_queue.push(&it->second);
+    auto     it     = ue_index_db.find(u.first);
+    uint32_t ue_idx = 0;
+    if (it == ue_index_db.end()) {
+      ue_idx = ues.add(u.first);
+      ue_index_db.insert(u.first, ue_idx);
+    } else {
+      ue_idx = it->second;
+    }
+    new_ue_tti(ue_idx, *u.second, tti_sched);
+    if (ues.dl_newtx_h[ue_idx] != nullptr or ues.dl_retx_h[ue_idx] != nullptr) {
+      dl_queue.push_back(ue_idx);
     }
-    if (it->second.ul_h != nullptr) {
-      // Allocate only if UL carrier is enabled
-      for (auto& i : u.second->get_ue_cfg().supported_cc_list) {
-        if (i.enb_cc_idx == cc_cfg->enb_cc_idx and not i.ul_disabled) {
-          ul_queue.push(&it->second);
-          break;
-        }
-      }
+    if (ues.ul_h[ue_idx] != nullptr) {
+      ul_queue.push_back(ue_idx);
     }
   }
+  std::make_heap(dl_queue.begin(), dl_queue.end(), ue_dl_prio_compare{&ues});
 }
 
 /*****************************************************************
@@ -88,31 +83,35 @@ void sched_time_pf::new_tti(sched_ue_list& ue_db, sf_sched* tti_sched)
 void sched_time_pf::sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched)
 {
   srsran::tti_point tti_rx{tti_sched->get_tti_rx()};
-  if (current_tti_rx != tti_rx) {
+  if (current_tti_rx != tti_rx or current_ue_subset != tti_sched->get_ue_subset()) {
     new_tti(ue_db, tti_sched);
   }
 
   while (not dl_queue.empty()) {
-    ue_ctxt& ue = *dl_queue.top();
-    ue.save_dl_alloc(try_dl_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
-    dl_queue.pop();
+    std::pop_heap(dl_queue.begin(), dl_queue.end(), ue_dl_prio_compare{&ues});
+    uint32_t ue_idx = dl_queue.back();
+    dl_queue.pop_back();
+    uint32_t alloc_bytes = try_dl_alloc(ue_idx, *ue_db[ues.rnti[ue_idx]], tti_sched);
+    save_alloc(ues.dl_avg_rate[ue_idx], ues.dl_nof_samples[ue_idx], alloc_bytes, rate_avg_alpha);
   }
 }
 
-uint32_t sched_time_pf::try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched)
+uint32_t sched_time_pf::try_dl_alloc(uint32_t ue_idx, sched_ue& ue, sf_sched* tti_sched)
 {
-  alloc_result code = alloc_result::other_cause;
-  if (ue_ctxt.dl_retx_h != nullptr) {
-    code = try_dl_retx_alloc(*tti_sched, ue, *ue_ctxt.dl_retx_h);
+  alloc_result        code       = alloc_result::other_cause;
+  const dl_harq_proc* dl_retx_h  = ues.dl_retx_h[ue_idx];
+  const dl_harq_proc* dl_newtx_h = ues.dl_newtx_h[ue_idx];
+  if (dl_retx_h != nullptr) {
+    code = try_dl_retx_alloc(*tti_sched, ue, *dl_retx_h);
     if (code == alloc_result::success) {
-      return ue_ctxt.dl_retx_h->get_tbs(0) + ue_ctxt.dl_retx_h->get_tbs(1);
+      return dl_retx_h->get_tbs(0) + dl_retx_h->get_tbs(1);
     }
   }
 
   // There is space in PDCCH and an available DL HARQ
-  if (code != alloc_result::no_cch_space and ue_ctxt.dl_newtx_h != nullptr) {
+  if (code != alloc_result::no_cch_space and dl_newtx_h != nullptr) {
     rbgmask_t alloc_mask;
-    code = try_dl_newtx_alloc_greedy(*tti_sched, ue, *ue_ctxt.dl_newtx_h, &alloc_mask);
+    code = try_dl_newtx_alloc_greedy(*tti_sched, ue, *dl_newtx_h, &alloc_mask);
     if (code == alloc_result::success) {
       return ue.get_expected_dl_bitrate(cc_cfg->enb_cc_idx, alloc_mask.count()) * tti_duration_ms / 8;
     }
@@ -127,33 +126,42 @@ uint32_t sched_time_pf::try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* t
 void sched_time_pf::sched_ul_users(sched_ue_list& ue_db, sf_sched* tti_sched)
 {
   srsran::tti_point tti_rx{tti_sched->get_tti_rx()};
-  if (current_tti_rx != tti_rx) {
+  if (current_tti_rx != tti_rx or current_ue_subset != tti_sched->get_ue_subset()) {
     new_tti(ue_db, tti_sched);
   }
 
+  // The retx state is read once into the UE state, which the priority comparisons then access contiguously
+  for (uint32_t ue_idx : ul_queue) {
+    ues.ul_retx[ue_idx] = ues.ul_h[ue_idx]->has_pending_retx();
+  }
+  std::make_heap(ul_queue.begin(), ul_queue.end(), ue_ul_prio_compare{&ues});
+
   while (not ul_queue.empty()) {
-    ue_ctxt& ue = *ul_queue.top();
-    ue.save_ul_alloc(try_ul_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
-    ul_queue.pop();
+    std::pop_heap(ul_queue.begin(), ul_queue.end(), ue_ul_prio_compare{&ues});
+    uint32_t ue_idx = ul_queue.back();
+    ul_queue.pop_back();
+    uint32_t alloc_bytes = try_ul_alloc(ue_idx, *ue_db[ues.rnti[ue_idx]], tti_sched);
+    save_alloc(ues.ul_avg_rate[ue_idx], ues.ul_nof_samples[ue_idx], alloc_bytes, rate_avg_alpha);
   }
 }
 
-uint32_t sched_time_pf::try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched)
+uint32_t sched_time_pf::try_ul_alloc(uint32_t ue_idx, sched_ue& ue, sf_sched* tti_sched)
 {
-  if (ue_ctxt.ul_h == nullptr) {
+  const ul_harq_proc* ul_h = ues.ul_h[ue_idx];
+  if (ul_h == nullptr) {
     // In case the UL HARQ could not be allocated (e.g. meas gap occurrence)
     return 0;
   }
-  if (tti_sched->is_ul_alloc(ue_ctxt.rnti)) {
+  if (tti_sched->is_ul_alloc(ues.rnti[ue_idx])) {
     // NOTE: An UL grant could have been previously allocated for UCI
-    return ue_ctxt.ul_h->get_pending_data();
+    return ul_h->get_pending_data();
   }
 
   alloc_result code;
   uint32_t     estim_tbs_bytes = 0;
-  if (ue_ctxt.ul_h->has_pending_retx()) {
-    code            = try_ul_retx_alloc(*tti_sched, ue, *ue_ctxt.ul_h);
-    estim_tbs_bytes = code == alloc_result::success ? ue_ctxt.ul_h->get_pending_data() : 0;
+  if (ul_h->has_pending_retx()) {
+    code            = try_ul_retx_alloc(*tti_sched, ue, *ul_h);
+    estim_tbs_bytes = code == alloc_result::success ? ul_h->get_pending_data() : 0;
   } else {
     // Note: h->is_empty check is required, in case CA allocated a small UL grant for UCI
     uint32_t pending_data = ue.get_pending_ul_new_data(tti_sched->get_tti_tx_ul(), cc_cfg->enb_cc_idx);
@@ -178,14 +186,68 @@ uint32_t sched_time_pf::try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* t
  *                          UE history
  *****************************************************************/
 
-void sched_time_pf::ue_ctxt::new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched)
+uint32_t sched_time_pf::ue_state_list::add(uint16_t rnti_)
+{
+  uint32_t ue_idx        = nof_ues++;
+  rnti[ue_idx]           = rnti_;
+  dl_avg_rate[ue_idx]    = 0;
+  ul_avg_rate[ue_idx]    = 0;
+  dl_nof_samples[ue_idx] = 0;
+  ul_nof_samples[ue_idx] = 0;
+  dl_idle_samples[ue_idx] = 0;
+  ul_idle_samples[ue_idx] = 0;
+  return ue_idx;
+}
+
+void sched_time_pf::ue_state_list::move(uint32_t from, uint32_t to)
+{
+  rnti[to]            = rnti[from];
+  dl_prio[to]         = dl_prio[from];
+  ul_prio[to]         = ul_prio[from];
+  dl_retx[to]         = dl_retx[from];
+  ul_retx[to]         = ul_retx[from];
+  dl_retx_h[to]       = dl_retx_h[from];
+  dl_newtx_h[to]      = dl_newtx_h[from];
+  ul_h[to]            = ul_h[from];
+  dl_avg_rate[to]     = dl_avg_rate[from];
+  ul_avg_rate[to]     = ul_avg_rate[from];
+  dl_nof_samples[to]  = dl_nof_samples[from];
+  ul_nof_samples[to]  = ul_nof_samples[from];
+  dl_idle_samples[to] = dl_idle_samples[from];
+  ul_idle_samples[to] = ul_idle_samples[from];
+}
+
+void sched_time_pf::rem_ue(uint32_t ue_idx)
+{
+  ue_index_db.erase(ues.rnti[ue_idx]);
+  uint32_t last_idx = --ues.nof_ues;
+  if (ue_idx != last_idx) {
+    ues.move(last_idx, ue_idx);
+    ue_index_db[ues.rnti[ue_idx]] = ue_idx;
+  }
+}
+
+float sched_time_pf::dl_avg_rate(uint32_t ue_idx) const
+{
+  return ues.dl_nof_samples[ue_idx] == 0 ? 0 : ues.dl_avg_rate[ue_idx];
+}
+
+float sched_time_pf::ul_avg_rate(uint32_t ue_idx) const
 {
-  dl_retx_h  = nullptr;
-  dl_newtx_h = nullptr;
-  ul_h       = nullptr;
-  dl_prio    = 0;
-  ue_cc_idx  = ue.enb_to_ue_cc_idx(cell.enb_cc_idx);
-  if (ue_cc_idx < 0) {
+  return ues.ul_nof_samples[ue_idx] == 0 ? 0 : ues.ul_avg_rate[ue_idx];
+}
+
+void sched_time_pf::new_ue_tti(uint32_t ue_idx, sched_ue& ue, sf_sched* tti_sched)
+{
+  const dl_harq_proc*& dl_retx_h  = ues.dl_retx_h[ue_idx];
+  const dl_harq_proc*& dl_newtx_h = ues.dl_newtx_h[ue_idx];
+  const ul_harq_proc*& ul_h       = ues.ul_h[ue_idx];
+  dl_retx_h                       = nullptr;
+  dl_newtx_h                      = nullptr;
+  ul_h                            = nullptr;
+  ues.dl_prio[ue_idx]             = 0;
+  ues.dl_retx[ue_idx]             = false;
+  if (ue.enb_to_ue_cc_idx(cc_cfg->enb_cc_idx) < 0) {
     // not active
     return;
   }
@@ -193,59 +255,88 @@ void sched_time_pf::ue_ctxt::new_tti(const sched_cell_params_t& cell, sched_ue&
   // Calculate DL priority
   dl_retx_h  = get_dl_retx_harq(ue, tti_sched);
   dl_newtx_h = get_dl_newtx_harq(ue, tti_sched);
+  if (dl_retx_h == nullptr and dl_newtx_h != nullptr and not ue.has_pending_dl_txs()) {
+    // Idle in DL. It would get a zero rate sample
+    dl_newtx_h = nullptr;
+    ues.dl_idle_samples[ue_idx]++;
+  }
   if (dl_retx_h != nullptr or dl_newtx_h != nullptr) {
+    add_zero_samples(ues.dl_avg_rate[ue_idx], ues.dl_nof_samples[ue_idx], ues.dl_idle_samples[ue_idx], rate_avg_alpha);
+    ues.dl_idle_samples[ue_idx] = 0;
+    ues.dl_retx[ue_idx]         = dl_retx_h != nullptr;
     // calculate DL PF priority
-    float r = ue.get_expected_dl_bitrate(cell.enb_cc_idx) / 8;
-    float R = dl_avg_rate();
-    dl_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+    float r             = ue.get_expected_dl_bitrate(cc_cfg->enb_cc_idx) / 8;
+    float R             = dl_avg_rate(ue_idx);
+    ues.dl_prio[ue_idx] = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+  }
+
+  // Allocate UL only if the UL carrier is enabled
+  for (auto& i : ue.get_ue_cfg().supported_cc_list) {
+    if (i.enb_cc_idx == cc_cfg->enb_cc_idx and i.ul_disabled) {
+      return;
+    }
   }
 
   // Calculate UL priority
   ul_h = get_ul_retx_harq(ue, tti_sched);
   if (ul_h == nullptr) {
     ul_h = get_ul_newtx_harq(ue, tti_sched);
+    if (ul_h != nullptr and ue.get_pending_ul_data_total(tti_sched->get_tti_tx_ul(), cc_cfg->enb_cc_idx) == 0) {
+      // Idle in UL. It would get a zero rate sample
+      ul_h = nullptr;
+      ues.ul_idle_samples[ue_idx]++;
+    }
   }
   if (ul_h != nullptr) {
-    float r = ue.get_expected_ul_bitrate(cell.enb_cc_idx) / 8;
-    float R = ul_avg_rate();
-    ul_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+    add_zero_samples(ues.ul_avg_rate[ue_idx], ues.ul_nof_samples[ue_idx], ues.ul_idle_samples[ue_idx], rate_avg_alpha);
+    ues.ul_idle_samples[ue_idx] = 0;
+    float r                     = ue.get_expected_ul_bitrate(cc_cfg->enb_cc_idx) / 8;
+    float R                     = ul_avg_rate(ue_idx);
+    ues.ul_prio[ue_idx] = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
   }
 }
 
-void sched_time_pf::ue_ctxt::save_dl_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
+/// Equivalent to calling save_alloc with zero bytes "nof_zeros" times
+void sched_time_pf::add_zero_samples(float& avg_rate, uint32_t& nof_samples, uint32_t nof_zeros, float alpha)
 {
-  if (dl_nof_samples < 1 / exp_avg_alpha) {
-    // fast start
-    dl_avg_rate_ = dl_avg_rate_ + (alloc_bytes - dl_avg_rate_) / (dl_nof_samples + 1);
-  } else {
-    dl_avg_rate_ = (1 - exp_avg_alpha) * dl_avg_rate_ + (exp_avg_alpha)*alloc_bytes;
+  if (nof_zeros == 0) {
+    return;
+  }
+  // fast start. Each zero sample scales the average by n / (n + 1)
+  uint32_t fast_start_len = static_cast<uint32_t>(std::ceil(1 / alpha));
+  if (nof_samples < fast_start_len) {
+    uint32_t n = std::min(nof_zeros, fast_start_len - nof_samples);
+    avg_rate   = avg_rate * nof_samples / (nof_samples + n);
+    nof_samples += n;
+    nof_zeros -= n;
+  }
+  if (nof_zeros > 0) {
+    avg_rate *= std::pow(1 - alpha, nof_zeros);
+    nof_samples += nof_zeros;
   }
-  dl_nof_samples++;
 }
 
-void sched_time_pf::ue_ctxt::save_ul_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
+void sched_time_pf::save_alloc(float& avg_rate, uint32_t& nof_samples, uint32_t alloc_bytes, float exp_avg_alpha)
 {
-  if (ul_nof_samples < 1 / exp_avg_alpha) {
+  if (nof_samples < 1 / exp_avg_alpha) {
     // fast start
-    ul_avg_rate_ = ul_avg_rate_ + (alloc_bytes - ul_avg_rate_) / (ul_nof_samples + 1);
+    avg_rate = avg_rate + (alloc_bytes - avg_rate) / (nof_samples + 1);
   } else {
-    ul_avg_rate_ = (1 - exp_avg_alpha) * ul_avg_rate_ + (exp_avg_alpha)*alloc_bytes;
+    avg_rate = (1 - exp_avg_alpha) * avg_rate + (exp_avg_alpha)*alloc_bytes;
   }
-  ul_nof_samples++;
+  nof_samples++;
 }
 
-bool sched_time_pf::ue_dl_prio_compare::operator()(const sched_time_pf::ue_ctxt* lhs,
-                                                   const sched_time_pf::ue_ctxt* rhs) const
+bool sched_time_pf::ue_dl_prio_compare::operator()(uint32_t lhs, uint32_t rhs) const
 {
-  bool is_retx1 = lhs->dl_retx_h != nullptr, is_retx2 = rhs->dl_retx_h != nullptr;
-  return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and lhs->dl_prio < rhs->dl_prio);
+  bool is_retx1 = ues->dl_retx[lhs], is_retx2 = ues->dl_retx[rhs];
+  return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and ues->dl_prio[lhs] < ues->dl_prio[rhs]);
 }
 
-bool sched_time_pf::ue_ul_prio_compare::operator()(const sched_time_pf::ue_ctxt* lhs,
-                                                   const sched_time_pf::ue_ctxt* rhs) const
+bool sched_time_pf::ue_ul_prio_compare::operator()(uint32_t lhs, uint32_t rhs) const
 {
-  bool is_retx1 = lhs->ul_h->has_pending_retx(), is_retx2 = rhs->ul_h->has_pending_retx();
-  return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and lhs->ul_prio < rhs->ul_prio);
+  bool is_retx1 = ues->ul_retx[lhs], is_retx2 = ues->ul_retx[rhs];
+  return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and ues->ul_prio[lhs] < ues->ul_prio[rhs]);
 }
 
 } // namespace srsenb
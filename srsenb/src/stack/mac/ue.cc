@@ -25,20 +25,31 @@
 #include <string.h>
 
 #include "srsenb/hdr/stack/mac/ue.h"
+#include "srsran/common/numa_placement.h"
 #include "srsran/common/string_helpers.h"
+#include "srsran/common/time_prof.h"
 #include "srsran/interfaces/enb_phy_interfaces.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/enb_rrc_interface_mac.h"
 
 namespace srsenb {
 
-ue_cc_softbuffers::ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_) :
+ue_cc_softbuffers::ue_cc_softbuffers(uint32_t                           nof_prb,
+                                     uint32_t                           nof_tx_harq_proc_,
+                                     uint32_t                           nof_rx_harq_proc_,
+                                     const srsran_softbuffer_rx_args_t& rx_args) :
   nof_tx_harq_proc(nof_tx_harq_proc_), nof_rx_harq_proc(nof_rx_harq_proc_)
 {
-  // Create and init Rx buffers
+  // Place the softbuffers on the node of the PHY workers, which encode and decode them
+  srsran::numa_placement::scoped_policy numa_policy(srsran::numa_pool_t::harq);
+
+  // Create and init Rx buffers, dimensioned for the cell bandwidth
+  srsran_softbuffer_rx_args_t args = rx_args;
+  args.max_cb                      = (uint32_t)srsran_softbuffer_max_cb(nof_prb);
+  args.max_cb_size                 = SOFTBUFFER_SIZE;
   softbuffer_rx_list.resize(nof_rx_harq_proc);
   for (srsran_softbuffer_rx_t& buffer : softbuffer_rx_list) {
-    srsran_softbuffer_rx_init(&buffer, nof_prb);
+    srsran_softbuffer_rx_init_args(&buffer, &args);
   }
 
   // Create and init Tx buffers
@@ -64,6 +75,8 @@ ue_cc_softbuffers::~ue_cc_softbuffers()
 void ue_cc_softbuffers::clear()
 {
   for (auto& buffer : softbuffer_rx_list) {
+    // Lazily allocated buffers release their memory until they are used again
+    srsran_softbuffer_rx_free_cb(&buffer);
     srsran_softbuffer_rx_reset(&buffer);
   }
   for (auto& buffer : softbuffer_tx_list) {
@@ -503,7 +516,7 @@ void ue::allocate_ce(srsran::sch_pdu* pdu, uint32_t lcid)
     case srsran::dl_sch_lcid::TA_CMD:
       if (pdu->new_subh()) {
         uint32_t ta_cmd = 31;
-        pending_ta_commands.try_pop(&ta_cmd);
+        pending_ta_commands.try_pop(ta_cmd);
         if (!pdu->get()->set_ta_cmd(ta_cmd)) {
           logger.error("CE:    Setting TA CMD CE");
         }
@@ -551,6 +564,8 @@ uint8_t* ue::generate_pdu(uint32_t                              enb_cc_idx,
                           uint32_t                              nof_pdu_elems,
                           uint32_t                              grant_size)
 {
+  srsran::scoped_stage_prof prof(srsran::tti_stage::mac_pdu);
+
   std::lock_guard<std::mutex> lock(mutex);
   uint8_t*                    ret = nullptr;
   if (enb_cc_idx < SRSRAN_MAX_CARRIERS && harq_pid < SRSRAN_FDD_NOF_HARQ && tb_idx < SRSRAN_MAX_TB) {
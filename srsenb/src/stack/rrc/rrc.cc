@@ -32,6 +32,7 @@
 #include "srsran/common/enb_events.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/string_helpers.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_pdcp_interfaces.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
@@ -60,22 +61,24 @@ int32_t rrc::init(const rrc_cfg_t&       cfg_,
   return init(cfg_, phy_, mac_, rlc_, pdcp_, s1ap_, gtpu_, nullptr);
 }
 
-int32_t rrc::init(const rrc_cfg_t&       cfg_,
-                  phy_interface_rrc_lte* phy_,
-                  mac_interface_rrc*     mac_,
-                  rlc_interface_rrc*     rlc_,
-                  pdcp_interface_rrc*    pdcp_,
-                  s1ap_interface_rrc*    s1ap_,
-                  gtpu_interface_rrc*    gtpu_,
-                  rrc_nr_interface_rrc*  rrc_nr_)
+int32_t rrc::init(const rrc_cfg_t&          cfg_,
+                  phy_interface_rrc_lte*    phy_,
+                  mac_interface_rrc*        mac_,
+                  rlc_interface_rrc*        rlc_,
+                  pdcp_interface_rrc*       pdcp_,
+                  s1ap_interface_rrc*       s1ap_,
+                  gtpu_interface_rrc*       gtpu_,
+                  rrc_nr_interface_rrc*     rrc_nr_,
+                  srsran::task_thread_pool* ue_task_pool_)
 {
-  phy    = phy_;
-  mac    = mac_;
-  rlc    = rlc_;
-  pdcp   = pdcp_;
-  gtpu   = gtpu_;
-  s1ap   = s1ap_;
-  rrc_nr = rrc_nr_;
+  phy          = phy_;
+  mac          = mac_;
+  rlc          = rlc_;
+  pdcp         = pdcp_;
+  gtpu         = gtpu_;
+  s1ap         = s1ap_;
+  rrc_nr       = rrc_nr_;
+  ue_task_pool = ue_task_pool_;
 
   cfg = cfg_;
 
@@ -646,18 +649,50 @@ void rrc::parse_ul_ccch(ue& ue, srsran::unique_byte_buffer_t pdu)
 {
   srsran_assert(pdu != nullptr, "handle_ul_ccch called for empty message");
 
-  ul_ccch_msg_s  ul_ccch_msg;
-  asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
+  ul_ccch_msg_s ul_ccch_msg;
+  if (decode_ul_ccch(ue.rnti, *pdu, ul_ccch_msg)) {
+    handle_ul_ccch(ue, ul_ccch_msg, std::move(pdu));
+  }
+}
+
+/// Unpacks and logs an UL-CCCH message. It does not access the RRC state, so it can run outside the stack thread
+bool rrc::decode_ul_ccch(uint16_t rnti, const srsran::byte_buffer_t& pdu, ul_ccch_msg_s& ul_ccch_msg)
+{
+  asn1::cbit_ref bref(pdu.msg, pdu.N_bytes);
   if (ul_ccch_msg.unpack(bref) != asn1::SRSASN_SUCCESS or
       ul_ccch_msg.msg.type().value != ul_ccch_msg_type_c::types_opts::c1) {
-    log_rx_pdu_fail(ue.rnti, srb_to_lcid(lte_srb::srb0), *pdu, "Failed to unpack UL-CCCH message");
-    return;
+    log_rx_pdu_fail(rnti, srb_to_lcid(lte_srb::srb0), pdu, "Failed to unpack UL-CCCH message");
+    return false;
   }
 
   // Log Rx message
   log_rrc_message(
-      Rx, ue.rnti, srsran::srb_to_lcid(lte_srb::srb0), *pdu, ul_ccch_msg, ul_ccch_msg.msg.c1().type().to_string());
+      Rx, rnti, srsran::srb_to_lcid(lte_srb::srb0), pdu, ul_ccch_msg, ul_ccch_msg.msg.c1().type().to_string());
+  return true;
+}
 
+/// Unpacks and logs an UL-DCCH message, with its dynamic fields allocated from arena. It does not access the RRC
+/// state, so it can run outside the stack thread
+bool rrc::decode_ul_dcch(uint16_t                     rnti,
+                         uint32_t                     lcid,
+                         const srsran::byte_buffer_t& pdu,
+                         ul_dcch_msg_s&               ul_dcch_msg,
+                         asn1::decode_arena&          arena)
+{
+  asn1::cbit_ref bref(pdu.msg, pdu.N_bytes);
+  if (asn1::unpack_in_arena(ul_dcch_msg, bref, arena) != asn1::SRSASN_SUCCESS or
+      ul_dcch_msg.msg.type().value != ul_dcch_msg_type_c::types_opts::c1) {
+    log_rx_pdu_fail(rnti, lcid, pdu, "Failed to unpack UL-DCCH message");
+    return false;
+  }
+
+  // Log Rx message
+  log_rrc_message(Rx, rnti, lcid, pdu, ul_dcch_msg, ul_dcch_msg.msg.c1().type().to_string());
+  return true;
+}
+
+void rrc::handle_ul_ccch(ue& ue, ul_ccch_msg_s& ul_ccch_msg, srsran::unique_byte_buffer_t pdu)
+{
   switch (ul_ccch_msg.msg.c1().type().value) {
     case ul_ccch_msg_type_c::c1_c_::types::rrc_conn_request:
       ue.save_ul_message(std::move(pdu));
@@ -1029,58 +1064,118 @@ int rrc::pack_mcch()
 
 void rrc::tti_clock()
 {
+  if (ue_task_pool != nullptr) {
+    decode_rx_batch();
+    for (rx_item_t& item : rx_batch) {
+      handle_rrc_pdu(item.p, item.msg.get());
+    }
+    rx_batch.clear();
+    return;
+  }
+
   // pop cmds from queue
   rrc_pdu p;
   while (rx_pdu_queue.try_pop(p)) {
-    // check if user exists
-    auto user_it = users.find(p.rnti);
-    if (user_it == users.end()) {
-      if (p.pdu != nullptr) {
-        log_rx_pdu_fail(p.rnti, p.lcid, *p.pdu, "unknown rnti");
-      } else {
-        logger.warning("Ignoring rnti=0x%x command %d arg %d. Cause: unknown rnti", p.rnti, p.lcid, p.arg);
-      }
+    handle_rrc_pdu(p, nullptr);
+  }
+}
+
+/// Pops the pending commands, and decodes the UL messages of the known UEs in the UE task pool. The messages of each
+/// UE are decoded in order by the same shard, and the different shards run in parallel
+void rrc::decode_rx_batch()
+{
+  rx_item_t item;
+  uint32_t  nof_msgs = 0;
+  while (rx_pdu_queue.try_pop(item.p)) {
+    if (item.p.pdu != nullptr and item.p.lcid <= srb_to_lcid(lte_srb::srb2) and users.count(item.p.rnti) > 0) {
+      item.msg.reset(new ul_rx_msg_t);
+      nof_msgs++;
+    }
+    rx_batch.push_back(std::move(item));
+  }
+  if (nof_msgs == 0) {
+    return;
+  }
+
+  nof_rx_shards = std::min(nof_msgs, (uint32_t)ue_task_pool->nof_workers() + 1);
+  ue_task_pool->parallel_for(
+      nof_rx_shards, [](void* arg, uint32_t idx) { static_cast<rrc*>(arg)->decode_rx_shard(idx); }, this);
+}
+
+void rrc::decode_rx_shard(uint32_t shard_idx)
+{
+  for (rx_item_t& item : rx_batch) {
+    if (item.msg == nullptr or item.p.rnti % nof_rx_shards != shard_idx) {
       continue;
     }
-    ue& ue = *user_it->second;
+    ul_rx_msg_t& msg = *item.msg;
+    if (item.p.lcid == srb_to_lcid(lte_srb::srb0)) {
+      msg.decoded = decode_ul_ccch(item.p.rnti, *item.p.pdu, msg.ul_ccch_msg);
+    } else {
+      msg.decoded = decode_ul_dcch(item.p.rnti, item.p.lcid, *item.p.pdu, msg.ul_dcch_msg, msg.arena);
+    }
+  }
+}
+
+/// Handles a command of the rx_pdu_queue, msg is the UL message decoded in the UE task pool or nullptr
+void rrc::handle_rrc_pdu(rrc_pdu& p, ul_rx_msg_t* msg)
+{
+  // check if user exists
+  auto user_it = users.find(p.rnti);
+  if (user_it == users.end()) {
+    if (p.pdu != nullptr) {
+      log_rx_pdu_fail(p.rnti, p.lcid, *p.pdu, "unknown rnti");
+    } else {
+      logger.warning("Ignoring rnti=0x%x command %d arg %d. Cause: unknown rnti", p.rnti, p.lcid, p.arg);
+    }
+    return;
+  }
+  ue& ue = *user_it->second;
 
-    // handle queue cmd
-    switch (p.lcid) {
-      case srb_to_lcid(lte_srb::srb0):
+  // handle queue cmd
+  switch (p.lcid) {
+    case srb_to_lcid(lte_srb::srb0):
+      if (msg == nullptr) {
         parse_ul_ccch(ue, std::move(p.pdu));
-        break;
-      case srb_to_lcid(lte_srb::srb1):
-      case srb_to_lcid(lte_srb::srb2):
+      } else if (msg->decoded) {
+        handle_ul_ccch(ue, msg->ul_ccch_msg, std::move(p.pdu));
+      }
+      break;
+    case srb_to_lcid(lte_srb::srb1):
+    case srb_to_lcid(lte_srb::srb2):
+      if (msg == nullptr) {
         parse_ul_dcch(ue, p.lcid, std::move(p.pdu));
-        break;
-      case LCID_REM_USER:
-        rem_user(p.rnti);
-        break;
-      case LCID_REL_USER:
-        process_release_complete(p.rnti);
-        break;
-      case LCID_ACT_USER:
-        user_it->second->set_activity();
-        break;
-      case LCID_RADLINK_DL:
-        user_it->second->set_radiolink_dl_state(p.arg);
-        break;
-      case LCID_RADLINK_UL:
-        user_it->second->set_radiolink_ul_state(p.arg);
-        break;
-      case LCID_RLC_RTX:
-        user_it->second->max_rlc_retx_reached();
-        break;
-      case LCID_PROT_FAIL:
-        user_it->second->protocol_failure();
-        break;
-      case LCID_EXIT:
-        logger.info("Exiting thread");
-        break;
-      default:
-        logger.error("Rx PDU with invalid bearer id: %d", p.lcid);
-        break;
-    }
+      } else if (msg->decoded) {
+        ue.handle_ul_dcch(p.lcid, msg->ul_dcch_msg, std::move(p.pdu));
+      }
+      break;
+    case LCID_REM_USER:
+      rem_user(p.rnti);
+      break;
+    case LCID_REL_USER:
+      process_release_complete(p.rnti);
+      break;
+    case LCID_ACT_USER:
+      user_it->second->set_activity();
+      break;
+    case LCID_RADLINK_DL:
+      user_it->second->set_radiolink_dl_state(p.arg);
+      break;
+    case LCID_RADLINK_UL:
+      user_it->second->set_radiolink_ul_state(p.arg);
+      break;
+    case LCID_RLC_RTX:
+      user_it->second->max_rlc_retx_reached();
+      break;
+    case LCID_PROT_FAIL:
+      user_it->second->protocol_failure();
+      break;
+    case LCID_EXIT:
+      logger.info("Exiting thread");
+      break;
+    default:
+      logger.error("Rx PDU with invalid bearer id: %d", p.lcid);
+      break;
   }
 }
 
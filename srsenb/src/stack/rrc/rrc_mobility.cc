@@ -781,9 +781,10 @@ void rrc::ue::rrc_mobility::handle_ho_requested(idle_st& s, const ho_req_rx_ev&
   fwd_tunnels.clear();
 
   /* TS 36.331 10.2.2. - Decode HandoverPreparationInformation */
-  asn1::cbit_ref            bref{rrc_container.data(), rrc_container.size()};
-  asn1::rrc::ho_prep_info_s hoprep;
-  if (hoprep.unpack(bref) != asn1::SRSASN_SUCCESS) {
+  asn1::static_decode_arena<4096> hoprep_arena;
+  asn1::cbit_ref                  bref{rrc_container.data(), rrc_container.size()};
+  asn1::rrc::ho_prep_info_s       hoprep;
+  if (asn1::unpack_in_arena(hoprep, bref, hoprep_arena) != asn1::SRSASN_SUCCESS) {
     rrc_enb->logger.error("Failed to decode HandoverPreparationinformation in S1AP SourceENBToTargetENBContainer");
     cause.set_protocol().value = asn1::s1ap::cause_protocol_opts::transfer_syntax_error;
     trigger(ho_failure_ev{cause});
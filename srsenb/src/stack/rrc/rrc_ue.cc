@@ -331,17 +331,16 @@ bool rrc::ue::is_idle()
 
 void rrc::ue::parse_ul_dcch(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
 {
-  ul_dcch_msg_s  ul_dcch_msg;
-  asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
-  if (ul_dcch_msg.unpack(bref) != asn1::SRSASN_SUCCESS or
-      ul_dcch_msg.msg.type().value != ul_dcch_msg_type_c::types_opts::c1) {
-    parent->log_rx_pdu_fail(rnti, lcid, *pdu, "Failed to unpack UL-DCCH message");
-    return;
+  // The dynamic fields of the message are decoded into an arena on the stack, which outlives ul_dcch_msg
+  asn1::static_decode_arena<2048> rx_arena;
+  ul_dcch_msg_s                   ul_dcch_msg;
+  if (parent->decode_ul_dcch(rnti, lcid, *pdu, ul_dcch_msg, rx_arena)) {
+    handle_ul_dcch(lcid, ul_dcch_msg, std::move(pdu));
   }
+}
 
-  // Log Rx message
-  parent->log_rrc_message(Rx, rnti, lcid, *pdu, ul_dcch_msg, ul_dcch_msg.msg.c1().type().to_string());
-
+void rrc::ue::handle_ul_dcch(uint32_t lcid, ul_dcch_msg_s& ul_dcch_msg, srsran::unique_byte_buffer_t pdu)
+{
   srsran::unique_byte_buffer_t original_pdu = std::move(pdu);
   pdu                                       = srsran::make_byte_buffer();
   if (pdu == nullptr) {
@@ -520,8 +519,13 @@ void rrc::ue::send_connection_setup()
   // Configure PHY layer
   apply_setup_phy_config_dedicated(rr_cfg.phys_cfg_ded); // It assumes SCell has not been set before
 
+  // The RRCConnectionSetup is packed by patching the SR/CQI resources in the message packed for the first UE
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  if (pdu != nullptr and not parent->conn_setup_template.pack(dl_ccch_msg, *pdu)) {
+    pdu.reset();
+  }
   std::string octet_str;
-  send_dl_ccch(&dl_ccch_msg, &octet_str);
+  send_dl_ccch(&dl_ccch_msg, &octet_str, std::move(pdu));
 
   // Log event.
   asn1::json_writer json_writer;
@@ -1326,31 +1330,33 @@ void rrc::ue::update_scells()
 
 /********************** HELPERS ***************************/
 
-void rrc::ue::send_dl_ccch(dl_ccch_msg_s* dl_ccch_msg, std::string* octet_str)
+void rrc::ue::send_dl_ccch(dl_ccch_msg_s* dl_ccch_msg, std::string* octet_str, srsran::unique_byte_buffer_t pdu)
 {
-  // Allocate a new PDU buffer, pack the message and send to PDCP
-  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-  if (pdu) {
+  // Allocate a new PDU buffer and pack the message, unless pdu already holds the packed message, and send to RLC
+  if (pdu == nullptr) {
+    pdu = srsran::make_byte_buffer();
+    if (pdu == nullptr) {
+      parent->logger.error("Allocating pdu");
+      return;
+    }
     asn1::bit_ref bref(pdu->msg, pdu->get_tailroom());
     if (dl_ccch_msg->pack(bref) != asn1::SRSASN_SUCCESS) {
       parent->logger.error(pdu->msg, pdu->N_bytes, "Failed to pack DL-CCCH-Msg:");
       return;
     }
     pdu->N_bytes = (uint32_t)bref.distance_bytes();
+  }
 
-    // Log Tx message
-    parent->log_rrc_message(
-        Tx, rnti, srb_to_lcid(lte_srb::srb0), *pdu, *dl_ccch_msg, dl_ccch_msg->msg.c1().type().to_string());
-
-    // Encode the pdu as an octet string if the user passed a valid pointer.
-    if (octet_str) {
-      *octet_str = asn1::octstring_to_string(pdu->msg, pdu->N_bytes);
-    }
+  // Log Tx message
+  parent->log_rrc_message(
+      Tx, rnti, srb_to_lcid(lte_srb::srb0), *pdu, *dl_ccch_msg, dl_ccch_msg->msg.c1().type().to_string());
 
-    parent->rlc->write_sdu(rnti, srb_to_lcid(lte_srb::srb0), std::move(pdu));
-  } else {
-    parent->logger.error("Allocating pdu");
+  // Encode the pdu as an octet string if the user passed a valid pointer.
+  if (octet_str) {
+    *octet_str = asn1::octstring_to_string(pdu->msg, pdu->N_bytes);
   }
+
+  parent->rlc->write_sdu(rnti, srb_to_lcid(lte_srb::srb0), std::move(pdu));
 }
 
 bool rrc::ue::send_dl_dcch(const dl_dcch_msg_s* dl_dcch_msg, srsran::unique_byte_buffer_t pdu, std::string* octet_str)
@@ -626,4 +626,167 @@ int apply_reconf_updates(asn1::rrc::rrc_conn_recfg_r8_ies_s&  recfg_r8,
   return SRSRAN_SUCCESS;
 }
 
+/***********************************
+ *   RRCConnectionSetup template
+ **********************************/
+
+/// Upper bounds of the patched fields of the RRCConnectionSetup, whose lower bounds are 0
+static const uint32_t setup_field_ub[] = {3, 2047, 157, 1185, 1023};
+
+static bool is_rrc_conn_setup_r8(const dl_ccch_msg_s& msg)
+{
+  return msg.msg.type().value == dl_ccch_msg_type_c::types_opts::c1 and
+         msg.msg.c1().type().value == dl_ccch_msg_type_c::c1_c_::types_opts::rrc_conn_setup and
+         msg.msg.c1().rrc_conn_setup().crit_exts.type().value == c1_or_crit_ext_opts::c1 and
+         msg.msg.c1().rrc_conn_setup().crit_exts.c1().type().value ==
+             rrc_conn_setup_s::crit_exts_c_::c1_c_::types_opts::rrc_conn_setup_r8;
+}
+
+bool rrc_conn_setup_template::get_field(const dl_ccch_msg_s& msg, field_id f, uint32_t& value)
+{
+  const rrc_conn_setup_s& setup   = msg.msg.c1().rrc_conn_setup();
+  const phys_cfg_ded_s&   phy_cfg = setup.crit_exts.c1().rrc_conn_setup_r8().rr_cfg_ded.phys_cfg_ded;
+  bool                    sr_present =
+      setup.crit_exts.c1().rrc_conn_setup_r8().rr_cfg_ded.phys_cfg_ded_present and
+      phy_cfg.sched_request_cfg_present and phy_cfg.sched_request_cfg.type().value == setup_opts::setup;
+  bool cqi_present = setup.crit_exts.c1().rrc_conn_setup_r8().rr_cfg_ded.phys_cfg_ded_present and
+                     phy_cfg.cqi_report_cfg_present and phy_cfg.cqi_report_cfg.cqi_report_periodic_present and
+                     phy_cfg.cqi_report_cfg.cqi_report_periodic.type().value == setup_opts::setup;
+  switch (f) {
+    case transaction_id:
+      value = setup.rrc_transaction_id;
+      return true;
+    case sr_pucch_res_idx:
+      value = sr_present ? phy_cfg.sched_request_cfg.setup().sr_pucch_res_idx : 0;
+      return sr_present;
+    case sr_cfg_idx:
+      value = sr_present ? phy_cfg.sched_request_cfg.setup().sr_cfg_idx : 0;
+      return sr_present;
+    case cqi_pucch_res_idx:
+      value = cqi_present ? phy_cfg.cqi_report_cfg.cqi_report_periodic.setup().cqi_pucch_res_idx : 0;
+      return cqi_present;
+    case cqi_pmi_cfg_idx:
+      value = cqi_present ? phy_cfg.cqi_report_cfg.cqi_report_periodic.setup().cqi_pmi_cfg_idx : 0;
+      return cqi_present;
+    default:
+      break;
+  }
+  return false;
+}
+
+void rrc_conn_setup_template::set_field(dl_ccch_msg_s& msg, field_id f, uint32_t value)
+{
+  rrc_conn_setup_s& setup   = msg.msg.c1().rrc_conn_setup();
+  phys_cfg_ded_s&   phy_cfg = setup.crit_exts.c1().rrc_conn_setup_r8().rr_cfg_ded.phys_cfg_ded;
+  switch (f) {
+    case transaction_id:
+      setup.rrc_transaction_id = value;
+      break;
+    case sr_pucch_res_idx:
+      phy_cfg.sched_request_cfg.setup().sr_pucch_res_idx = value;
+      break;
+    case sr_cfg_idx:
+      phy_cfg.sched_request_cfg.setup().sr_cfg_idx = value;
+      break;
+    case cqi_pucch_res_idx:
+      phy_cfg.cqi_report_cfg.cqi_report_periodic.setup().cqi_pucch_res_idx = value;
+      break;
+    case cqi_pmi_cfg_idx:
+      phy_cfg.cqi_report_cfg.cqi_report_periodic.setup().cqi_pmi_cfg_idx = value;
+      break;
+    default:
+      break;
+  }
+}
+
+static bool pack_dl_ccch_msg(const dl_ccch_msg_s& msg, std::vector<uint8_t>& buffer)
+{
+  buffer.resize(SRSRAN_MAX_BUFFER_SIZE_BYTES);
+  asn1::bit_ref bref(buffer.data(), buffer.size());
+  if (msg.pack(bref) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  buffer.resize(bref.distance_bytes());
+  return true;
+}
+
+bool rrc_conn_setup_template::init(const dl_ccch_msg_s& msg)
+{
+  // Template with all the fields set to 0
+  dl_ccch_msg_s probe_msg = msg;
+  for (uint32_t f = 0; f < nof_fields; ++f) {
+    uint32_t value;
+    fields[f].present = get_field(msg, (field_id)f, value);
+    if (fields[f].present) {
+      set_field(probe_msg, (field_id)f, 0);
+    }
+  }
+  if (not pack_dl_ccch_msg(probe_msg, packed_msg)) {
+    return false;
+  }
+
+  // Each field is found at the only bit that changes when its most significant bit is set
+  std::vector<uint8_t> probe;
+  for (uint32_t f = 0; f < nof_fields; ++f) {
+    if (not fields[f].present) {
+      continue;
+    }
+    fields[f].nof_bits = 0;
+    while ((setup_field_ub[f] >> fields[f].nof_bits) > 0) {
+      fields[f].nof_bits++;
+    }
+    set_field(probe_msg, (field_id)f, 1u << (fields[f].nof_bits - 1));
+    bool packed = pack_dl_ccch_msg(probe_msg, probe);
+    set_field(probe_msg, (field_id)f, 0);
+    if (not packed or probe.size() != packed_msg.size()) {
+      return false;
+    }
+    uint32_t nof_diff_bits = 0;
+    for (uint32_t i = 0; i < probe.size(); ++i) {
+      uint8_t diff = probe[i] ^ packed_msg[i];
+      if (diff != 0) {
+        nof_diff_bits += __builtin_popcount(diff);
+        fields[f].bit_pos = 8 * i + __builtin_clz(diff) - 24;
+      }
+    }
+    if (nof_diff_bits != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool rrc_conn_setup_template::pack(const dl_ccch_msg_s& msg, srsran::byte_buffer_t& pdu)
+{
+  if (not is_rrc_conn_setup_r8(msg)) {
+    return false;
+  }
+  if (state == state_t::empty) {
+    state = init(msg) ? state_t::ready : state_t::unavailable;
+    if (state == state_t::unavailable) {
+      srslog::fetch_basic_logger("RRC").warning("Couldn't create the RRCConnectionSetup template");
+    }
+  }
+  if (state != state_t::ready or packed_msg.size() > pdu.get_tailroom()) {
+    return false;
+  }
+
+  std::array<uint32_t, nof_fields> values;
+  for (uint32_t f = 0; f < nof_fields; ++f) {
+    if (get_field(msg, (field_id)f, values[f]) != fields[f].present) {
+      return false;
+    }
+  }
+  std::copy(packed_msg.begin(), packed_msg.end(), pdu.msg);
+  pdu.N_bytes = packed_msg.size();
+  for (uint32_t f = 0; f < nof_fields; ++f) {
+    for (uint32_t i = 0, pos = fields[f].bit_pos; fields[f].present and i < fields[f].nof_bits; ++i, ++pos) {
+      if ((values[f] >> (fields[f].nof_bits - 1 - i)) & 1u) {
+        pdu.msg[pos / 8] |= 0x80u >> (pos % 8);
+      }
+    }
+  }
+  return true;
+}
+
 } // namespace srsenb
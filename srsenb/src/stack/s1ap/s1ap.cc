@@ -484,7 +484,7 @@ void s1ap::user_mod(uint16_t old_rnti, uint16_t new_rnti)
     logger.error("New rnti already exists, aborting.");
     return;
   }
-  users.find_ue_rnti(old_rnti)->ctxt.rnti = new_rnti;
+  users.set_rnti(users.find_ue_rnti(old_rnti), new_rnti);
 }
 
 void s1ap::ue_ctxt_setup_complete(uint16_t rnti)
@@ -649,11 +649,11 @@ bool s1ap::handle_mme_rx_msg(srsran::unique_byte_buffer_t pdu,
       rx_socket_handler->remove_socket(mme_socket.get_socket());
       mme_socket.close();
       while (users.size() != 0) {
-        std::unordered_map<uint32_t, std::unique_ptr<ue> >::iterator it   = users.begin();
-        uint16_t                                                     rnti = it->second->ctxt.rnti;
+        ue*      u    = users.begin()->get();
+        uint16_t rnti = u->ctxt.rnti;
         rrc->release_erabs(rnti);
         rrc->release_ue(rnti);
-        users.erase(it->second.get());
+        users.erase(u);
       }
     }
   } else if (pdu->N_bytes == 0) {
@@ -686,10 +686,29 @@ bool s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu)
     pcap->write_s1ap(pdu->msg, pdu->N_bytes);
   }
 
-  s1ap_pdu_c     rx_pdu;
-  asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
+  // DL NAS Transports only need the UE IDs and the NAS-PDU, and Pagings the UE identity index and paging identity,
+  // which are decoded without unpacking the whole PDU (e.g. the TAI list of Pagings)
+  asn1::s1ap::s1ap_pdu_peek_t peek;
+  if (asn1::s1ap::peek_s1ap_pdu(peek, pdu->msg, pdu->N_bytes) == asn1::SRSASN_SUCCESS and
+      peek.pdu_type == s1ap_pdu_c::types_opts::init_msg) {
+    if (peek.proc_code == ASN1_S1AP_ID_DL_NAS_TRANSPORT and peek.enb_ue_s1ap_id_present and
+        peek.mme_ue_s1ap_id_present and peek.find_ie(ASN1_S1AP_ID_NAS_PDU) != nullptr) {
+      logger.info(pdu->msg, pdu->N_bytes, "Rx S1AP SDU - DownlinkNASTransport");
+      return handle_dlnastransport(peek);
+    }
+    if (peek.proc_code == ASN1_S1AP_ID_PAGING and peek.find_ie(ASN1_S1AP_ID_UE_ID_IDX_VALUE) != nullptr and
+        peek.find_ie(ASN1_S1AP_ID_UE_PAGING_ID) != nullptr) {
+      logger.info(pdu->msg, pdu->N_bytes, "Rx S1AP SDU - Paging");
+      return handle_paging(peek);
+    }
+  }
+
+  // The dynamic fields of the PDU are decoded into an arena on the stack, which outlives rx_pdu
+  asn1::static_decode_arena<2048> rx_arena;
+  s1ap_pdu_c                      rx_pdu;
+  asn1::cbit_ref                  bref(pdu->msg, pdu->N_bytes);
 
-  if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+  if (asn1::unpack_in_arena(rx_pdu, bref, rx_arena) != asn1::SRSASN_SUCCESS) {
     logger.error(pdu->msg, pdu->N_bytes, "Failed to unpack received PDU");
     cause_c cause;
     cause.set_protocol().value = cause_protocol_opts::transfer_syntax_error;
@@ -815,6 +834,45 @@ bool s1ap::handle_dlnastransport(const dl_nas_transport_s& msg)
   return true;
 }
 
+bool s1ap::handle_dlnastransport(const asn1::s1ap::s1ap_pdu_peek_t& msg)
+{
+  if (msg.msg_ext) {
+    logger.warning("Not handling S1AP message extension");
+  }
+  ue* u = handle_s1apmsg_ue_id(msg.enb_ue_s1ap_id, msg.mme_ue_s1ap_id);
+  if (u == nullptr) {
+    return false;
+  }
+
+  if (msg.find_ie(ASN1_S1AP_ID_HO_RESTRICT_LIST) != nullptr) {
+    logger.warning("Not handling HandoverRestrictionList");
+  }
+  if (msg.find_ie(ASN1_S1AP_ID_SUBSCRIBER_PROFILE_IDFOR_RFP) != nullptr) {
+    logger.warning("Not handling SubscriberProfileIDforRFP");
+  }
+
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  if (pdu == nullptr) {
+    logger.error("Fatal Error: Couldn't allocate buffer in s1ap::run_thread().");
+    return false;
+  }
+  // The NAS-PDU octet string is unpacked straight into the buffer passed to RRC
+  const asn1::protocol_ie_ref_t* ie = msg.find_ie(ASN1_S1AP_ID_NAS_PDU);
+  asn1::cbit_ref                 bref(ie->data, ie->len);
+  uint32_t                       nas_len;
+  if (asn1::unpack_length(nas_len, bref, true) != asn1::SRSASN_SUCCESS or nas_len > pdu->get_tailroom() or
+      bref.unpack_bytes(pdu->msg, nas_len) != asn1::SRSASN_SUCCESS) {
+    logger.error("Failed to unpack NAS-PDU of DownlinkNASTransport");
+    cause_c cause;
+    cause.set_protocol().value = cause_protocol_opts::transfer_syntax_error;
+    send_error_indication(cause, msg.enb_ue_s1ap_id, msg.mme_ue_s1ap_id);
+    return false;
+  }
+  pdu->N_bytes = nas_len;
+  rrc->write_dl_info(u->ctxt.rnti, std::move(pdu));
+  return true;
+}
+
 bool s1ap::handle_initialctxtsetuprequest(const init_context_setup_request_s& msg)
 {
   WarnUnsupportFeature(msg.ext, "message extension");
@@ -915,6 +973,21 @@ bool s1ap::handle_paging(const asn1::s1ap::paging_s& msg)
   return true;
 }
 
+bool s1ap::handle_paging(const asn1::s1ap::s1ap_pdu_peek_t& msg)
+{
+  WarnUnsupportFeature(msg.msg_ext, "S1AP message extension");
+
+  asn1::fixed_bitstring<10, false, true> ue_id_idx_value;
+  ue_paging_id_c                         ue_paging_id;
+  if (asn1::unpack_ie_value(ue_id_idx_value, *msg.find_ie(ASN1_S1AP_ID_UE_ID_IDX_VALUE)) != asn1::SRSASN_SUCCESS or
+      asn1::unpack_ie_value(ue_paging_id, *msg.find_ie(ASN1_S1AP_ID_UE_PAGING_ID)) != asn1::SRSASN_SUCCESS) {
+    logger.error("Failed to unpack Paging");
+    return false;
+  }
+  rrc->add_paging_id(ue_id_idx_value.to_number(), ue_paging_id);
+  return true;
+}
+
 bool s1ap::handle_erabsetuprequest(const erab_setup_request_s& msg)
 {
   WarnUnsupportFeature(msg.ext, "S1AP message extension");
@@ -1296,7 +1369,10 @@ bool s1ap::send_ho_req_ack(const asn1::s1ap::ho_request_s&                msg,
     logger.error("The MME-S1AP-UE-ID=%ld is not valid", msg->mme_ue_s1ap_id.value.value);
     return false;
   }
-  ue_ptr->ctxt.rnti       = rnti;
+  if (not users.set_rnti(ue_ptr, rnti)) {
+    logger.error("The rnti=0x%x is already in use", rnti);
+    return false;
+  }
   ue_ptr->ctxt.enb_cc_idx = enb_cc_idx;
 
   container->mme_ue_s1ap_id.value = msg->mme_ue_s1ap_id.value.value;
@@ -1930,27 +2006,23 @@ s1ap::ue* s1ap::user_list::find_ue_rnti(uint16_t rnti)
   if (rnti == SRSRAN_INVALID_RNTI) {
     return nullptr;
   }
-  auto it = std::find_if(
-      users.begin(), users.end(), [rnti](const user_list::pair_type& v) { return v.second->ctxt.rnti == rnti; });
-  return it != users.end() ? it->second.get() : nullptr;
+  return find_ue_enbid(rnti_to_enb_id[rnti]);
 }
 
 s1ap::ue* s1ap::user_list::find_ue_enbid(uint32_t enbid)
 {
-  auto it = users.find(enbid);
-  return (it != users.end()) ? it->second.get() : nullptr;
+  value_type* u = users.find(enbid);
+  return u != nullptr ? u->get() : nullptr;
 }
 
 s1ap::ue* s1ap::user_list::find_ue_mmeid(uint32_t mmeid)
 {
-  auto it = std::find_if(users.begin(), users.end(), [mmeid](const user_list::pair_type& v) {
-    return v.second->ctxt.mme_ue_s1ap_id == mmeid;
-  });
-  return it != users.end() ? it->second.get() : nullptr;
+  auto it = mme_to_enb_id.find(mmeid);
+  return it != mme_to_enb_id.end() ? find_ue_enbid(it->second) : nullptr;
 }
 
 /**
- * @brief Adds a user to the user list, avoiding any rnti, enb_s1ap_id, mme_s1ap_id duplication
+ * @brief Adds a user to the user list, avoiding any rnti, mme_s1ap_id duplication, and allocates its enb_s1ap_id
  * @param %user to be inserted
  * @return ptr of inserted %user. If failure, returns nullptr
  */
@@ -1962,27 +2034,73 @@ s1ap::ue* s1ap::user_list::add_user(std::unique_ptr<s1ap::ue> user)
     logger.error("The user to be added with rnti=0x%x already exists", user->ctxt.rnti);
     return nullptr;
   }
-  if (find_ue_enbid(user->ctxt.enb_ue_s1ap_id) != nullptr) {
-    logger.error("The user to be added with enb id=%d already exists", user->ctxt.enb_ue_s1ap_id);
-    return nullptr;
-  }
   if (user->ctxt.mme_ue_s1ap_id.has_value() and find_ue_mmeid(user->ctxt.mme_ue_s1ap_id.value()) != nullptr) {
     logger.error("The user to be added with mme id=%d already exists", user->ctxt.mme_ue_s1ap_id.value());
     return nullptr;
   }
-  auto p = users.insert(std::make_pair(user->ctxt.enb_ue_s1ap_id, std::move(user)));
-  return p.second ? p.first->second.get() : nullptr;
+  ue*      u     = user.get();
+  uint16_t rnti  = u->ctxt.rnti;
+  uint32_t enbid = users.insert(std::move(user));
+  if (enbid == table_type::invalid_id) {
+    logger.error("The user with rnti=0x%x can't be added. Cause: no free ENB UE S1AP IDs", rnti);
+    return nullptr;
+  }
+  u->ctxt.enb_ue_s1ap_id = enbid;
+  if (u->ctxt.rnti != SRSRAN_INVALID_RNTI) {
+    rnti_to_enb_id[u->ctxt.rnti] = enbid;
+  }
+  if (u->ctxt.mme_ue_s1ap_id.has_value()) {
+    mme_to_enb_id.emplace(u->ctxt.mme_ue_s1ap_id.value(), enbid);
+  }
+  return u;
 }
 
 void s1ap::user_list::erase(ue* ue_ptr)
 {
   static srslog::basic_logger& logger = srslog::fetch_basic_logger("S1AP");
-  auto                         it     = users.find(ue_ptr->ctxt.enb_ue_s1ap_id);
-  if (it == users.end()) {
+  if (find_ue_enbid(ue_ptr->ctxt.enb_ue_s1ap_id) != ue_ptr) {
     logger.error("User to be erased does not exist");
     return;
   }
-  users.erase(it);
+  if (ue_ptr->ctxt.rnti != SRSRAN_INVALID_RNTI) {
+    rnti_to_enb_id[ue_ptr->ctxt.rnti] = table_type::invalid_id;
+  }
+  if (ue_ptr->ctxt.mme_ue_s1ap_id.has_value()) {
+    mme_to_enb_id.erase(ue_ptr->ctxt.mme_ue_s1ap_id.value());
+  }
+  users.erase(ue_ptr->ctxt.enb_ue_s1ap_id);
+}
+
+/// Updates the RNTI of a stored user, and returns false if the RNTI is already used by another user
+bool s1ap::user_list::set_rnti(ue* ue_ptr, uint16_t rnti)
+{
+  ue* other = find_ue_rnti(rnti);
+  if (other != nullptr) {
+    return other == ue_ptr;
+  }
+  if (ue_ptr->ctxt.rnti != SRSRAN_INVALID_RNTI) {
+    rnti_to_enb_id[ue_ptr->ctxt.rnti] = table_type::invalid_id;
+  }
+  ue_ptr->ctxt.rnti = rnti;
+  if (rnti != SRSRAN_INVALID_RNTI) {
+    rnti_to_enb_id[rnti] = ue_ptr->ctxt.enb_ue_s1ap_id;
+  }
+  return true;
+}
+
+/// Updates the MME_UE_S1AP_ID of a stored user, and returns false if it is already used by another user
+bool s1ap::user_list::set_mme_id(ue* ue_ptr, uint32_t mmeid)
+{
+  ue* other = find_ue_mmeid(mmeid);
+  if (other != nullptr) {
+    return other == ue_ptr;
+  }
+  if (ue_ptr->ctxt.mme_ue_s1ap_id.has_value()) {
+    mme_to_enb_id.erase(ue_ptr->ctxt.mme_ue_s1ap_id.value());
+  }
+  ue_ptr->ctxt.mme_ue_s1ap_id = mmeid;
+  mme_to_enb_id.emplace(mmeid, ue_ptr->ctxt.enb_ue_s1ap_id);
+  return true;
 }
 
 /*******************************************************************************
@@ -2076,7 +2194,7 @@ s1ap::ue* s1ap::handle_s1apmsg_ue_id(uint32_t enb_id, uint32_t mme_id)
     user_mme_ptr = users.find_ue_mmeid(mme_id);
     if (not user_ptr->ctxt.mme_ue_s1ap_id.has_value() and user_mme_ptr == nullptr) {
       // First "returned message", no inconsistency found (see 36.413, Section 10.6)
-      user_ptr->ctxt.mme_ue_s1ap_id = mme_id;
+      users.set_mme_id(user_ptr, mme_id);
       return user_ptr;
     }
 
@@ -2147,7 +2265,6 @@ void s1ap::start_pcap(srsran::s1ap_pcap* pcap_)
 
 s1ap::ue::ue(s1ap* s1ap_ptr_) : s1ap_ptr(s1ap_ptr_), ho_prep_proc(this), logger(s1ap_ptr->logger)
 {
-  ctxt.enb_ue_s1ap_id = s1ap_ptr->next_enb_ue_s1ap_id++;
   gettimeofday(&ctxt.init_timestamp, nullptr);
 
   stream_id = s1ap_ptr->next_ue_stream_id;
@@ -64,7 +64,7 @@ const gtpu_tunnel_manager::tunnel* gtpu_tunnel_manager::find_tunnel(uint32_t tei
 gtpu_tunnel_manager::ue_bearer_tunnel_list* gtpu_tunnel_manager::find_rnti_tunnels(uint16_t rnti)
 {
   auto it = ue_teidin_db.find(rnti);
-  return it != ue_teidin_db.end() ? &ue_teidin_db[rnti] : nullptr;
+  return it != ue_teidin_db.end() ? &it->second : nullptr;
 }
 
 srsran::span<gtpu_tunnel_manager::bearer_teid_pair>
@@ -111,9 +111,13 @@ gtpu_tunnel_manager::add_tunnel(uint16_t rnti, uint32_t eps_bearer_id, uint32_t
   tun->teid_out      = teidout;
   tun->spgw_addr     = spgw_addr;
 
-  if (ue_teidin_db.find(rnti) == ue_teidin_db.end()) {
-    auto ret = ue_teidin_db.emplace(rnti, ue_bearer_tunnel_list());
-    if (!ret.second) {
+  tun->spgw_sockaddr.sin_family      = AF_INET;
+  tun->spgw_sockaddr.sin_addr.s_addr = htonl(spgw_addr);
+  tun->spgw_sockaddr.sin_port        = htons(GTPU_PORT);
+  srsran::gtpu_set_header_template(tun->tx_header, teidout);
+
+  if (not ue_teidin_db.contains(rnti)) {
+    if (not ue_teidin_db.insert(rnti, ue_bearer_tunnel_list())) {
       logger.error("Failed to allocate rnti=0x%x", rnti);
       return nullptr;
     }
@@ -152,7 +156,7 @@ bool gtpu_tunnel_manager::update_rnti(uint16_t old_rnti, uint16_t new_rnti)
   logger.info("Modifying bearer rnti. Old rnti: 0x%x, new rnti: 0x%x", old_rnti, new_rnti);
 
   // create new RNTI and update TEIDs of old rnti to reflect new rnti
-  if (new_rnti_ptr == nullptr and not ue_teidin_db.insert({new_rnti, ue_bearer_tunnel_list()}).second) {
+  if (new_rnti_ptr == nullptr and not ue_teidin_db.insert(new_rnti, ue_bearer_tunnel_list())) {
     logger.error("Failure to create new rnti=0x%x", new_rnti);
     return false;
   }
@@ -225,7 +229,7 @@ bool gtpu_tunnel_manager::remove_rnti(uint16_t rnti)
 void gtpu_tunnel_manager::activate_tunnel(uint32_t teid)
 {
   tunnel& tun = tunnels[teid];
-  if (tun.state == tunnel_state::pdcp_active) {
+  if (tun.state == tunnel_state::pdcp_active or tun.replay_pending) {
     // nothing happens
     return;
   }
@@ -234,18 +238,39 @@ void gtpu_tunnel_manager::activate_tunnel(uint32_t teid)
               tun.rnti,
               tun.teid_in,
               tun.buffer->size());
-  // Forward buffered SDUs to lower layers and delete buffer
-  auto lower_sn = [](const std::pair<uint32_t, srsran::unique_byte_buffer_t>& lhs,
-                     const std::pair<uint32_t, srsran::unique_byte_buffer_t>& rhs) { return lhs.first < rhs.first; };
-  std::stable_sort(tun.buffer->begin(), tun.buffer->end(), lower_sn);
+  tun.replay_pending = true;
+  replay_buffered_sdus(teid);
+}
+
+void gtpu_tunnel_manager::replay_buffered_sdus(uint32_t teid)
+{
+  tunnel& tun = tunnels[teid];
 
-  for (auto& sdu_pair : *tun.buffer) {
-    uint32_t pdcp_sn = sdu_pair.first;
+  // Forward buffered SDUs to lower layers in SN order. SDUs received meanwhile keep being buffered, so that they are
+  // not written to PDCP ahead of the ones still in the buffer
+  for (size_t i = 0; i < REPLAY_BATCH_SIZE and not tun.buffer->empty(); ++i) {
+    buffered_sdu_t& sdu_pair = tun.buffer->top();
+    uint32_t        pdcp_sn  = sdu_pair.first;
     pdcp->write_sdu(
         tun.rnti, tun.eps_bearer_id, std::move(sdu_pair.second), pdcp_sn == undefined_pdcp_sn ? -1 : pdcp_sn);
+    tun.buffer->pop();
+  }
+
+  if (not tun.buffer->empty()) {
+    // Resume in the next tick, so that a large buffer does not stall the stack thread
+    logger.debug("GTPU tunnel " TEID_IN_FMT " has %zd SDUs left to flush", teid, tun.buffer->size());
+    task_sched.defer_callback(1, [this, teid]() {
+      if (tunnels.contains(teid) and tunnels[teid].replay_pending) {
+        replay_buffered_sdus(teid);
+      }
+    });
+    return;
   }
+
+  // Delete buffer
   tun.buffer.reset();
-  tun.state = tunnel_state::pdcp_active;
+  tun.replay_pending = false;
+  tun.state          = tunnel_state::pdcp_active;
 }
 
 void gtpu_tunnel_manager::suspend_tunnel(uint32_t teid)
@@ -276,7 +301,8 @@ void gtpu_tunnel_manager::deactivate_tunnel(uint32_t teid)
     }
   }
 
-  tun.state = tunnel_state::inactive;
+  tun.replay_pending = false;
+  tun.state          = tunnel_state::inactive;
 }
 
 void gtpu_tunnel_manager::set_tunnel_priority(uint32_t before_teid, uint32_t after_teid)
@@ -326,7 +352,12 @@ void gtpu_tunnel_manager::buffer_pdcp_sdu(uint32_t teid, uint32_t pdcp_sn, srsra
 
   srsran_assert(rx_tun.state == tunnel_state::buffering, "Buffering of PDCP SDUs only enabled when PDCP is not active");
   if (not rx_tun.buffer->full()) {
-    rx_tun.buffer->push_back(std::make_pair(pdcp_sn, std::move(sdu)));
+    // Insertion sort from the tail, forwarded SDUs usually arrive in order
+    buffered_sdu_list& buffer = *rx_tun.buffer;
+    buffer.push(std::make_pair(pdcp_sn, std::move(sdu)));
+    for (size_t i = buffer.size() - 1; i > 0 and buffer[i - 1].first > buffer[i].first; --i) {
+      std::swap(buffer[i - 1], buffer[i]);
+    }
   } else {
     fmt::memory_buffer str_buffer;
     if (pdcp_sn != undefined_pdcp_sn) {
@@ -432,6 +463,19 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
   };
   rx_socket_handler->add_socket_handler(fd, srsran::make_sdu_handler(logger, gtpu_queue, rx_callback));
 
+  // The datagrams of the XDP queue bypass the kernel socket, which still receives the other queues and transmits
+  if (not args.xdp_ifname.empty()) {
+    xdp_socket.reset(new srsran::xdp_udp_socket(logger));
+    if (xdp_socket->open(args.xdp_ifname.c_str(), args.xdp_queue_id, gtp_bind_addr.c_str(), GTPU_PORT)) {
+      rx_socket_handler->add_socket_handler(
+          xdp_socket->fd(), srsran::make_xdp_sdu_handler(logger, gtpu_queue, *xdp_socket, rx_callback));
+    } else {
+      srsran::console("Failed to open the GTP-U AF_XDP socket on %s, using the kernel UDP socket only\n",
+                      args.xdp_ifname.c_str());
+      xdp_socket.reset();
+    }
+  }
+
   // Start MCH socket if enabled
   if (args.embms_enable) {
     if (not m1u.init(args.embms_m1u_multiaddr, args.embms_m1u_if_addr)) {
@@ -443,6 +487,11 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
 
 void gtpu::stop()
 {
+  flush_tx_batch();
+  if (xdp_socket != nullptr) {
+    rx_socket_handler->remove_socket(xdp_socket->fd());
+    xdp_socket.reset();
+  }
   if (fd > 0) {
     close(fd);
     fd = -1;
@@ -471,34 +520,49 @@ void gtpu::send_pdu_to_tunnel(const gtpu_tunnel& tx_tun, srsran::unique_byte_buf
     return;
   }
 
-  gtpu_header_t header;
-  header.flags        = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
-  header.message_type = GTPU_MSG_DATA_PDU;
-  header.length       = pdu->N_bytes;
-  header.teid         = tx_tun.teid_out;
-
-  if (pdcp_sn >= 0) {
-    header.flags |= GTPU_FLAGS_EXTENDED_HDR;
-    header.next_ext_hdr_type = GTPU_EXT_HEADER_PDCP_PDU_NUMBER;
-    header.ext_buffer.resize(4u);
-    header.ext_buffer[0] = 0x01u;
-    header.ext_buffer[1] = (pdcp_sn >> 8u) & 0xffu;
-    header.ext_buffer[2] = pdcp_sn & 0xffu;
-    header.ext_buffer[3] = 0;
+  // The header is copied from the template of the tunnel, only the length and the PDCP SN are written
+  if (!gtpu_write_header(tx_tun.tx_header, pdu.get(), pdcp_sn)) {
+    logger.error("Error writing GTP-U Header. No room in PDU for header");
+    return;
   }
 
-  struct sockaddr_in servaddr;
-  servaddr.sin_family      = AF_INET;
-  servaddr.sin_addr.s_addr = htonl(tx_tun.spgw_addr);
-  servaddr.sin_port        = htons(GTPU_PORT);
+  // Add the PDU to the Tx batch. The destination is copied, as the tunnel may be removed before the batch is sent
+  size_t idx = tx_batch.size++;
 
-  if (!gtpu_write_header(&header, pdu.get(), logger)) {
-    logger.error("Error writing GTP-U Header. Flags 0x%x, Message Type 0x%x", header.flags, header.message_type);
-    return;
+  tx_batch.addrs[idx]                    = tx_tun.spgw_sockaddr;
+  tx_batch.iovs[idx].iov_base            = pdu->msg;
+  tx_batch.iovs[idx].iov_len             = pdu->N_bytes;
+  tx_batch.msgs[idx].msg_hdr             = {};
+  tx_batch.msgs[idx].msg_hdr.msg_name    = &tx_batch.addrs[idx];
+  tx_batch.msgs[idx].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+  tx_batch.msgs[idx].msg_hdr.msg_iov     = &tx_batch.iovs[idx];
+  tx_batch.msgs[idx].msg_hdr.msg_iovlen  = 1;
+  tx_batch.pdus[idx]                     = std::move(pdu);
+
+  if (tx_batch.size == MAX_TX_BATCH_SIZE) {
+    flush_tx_batch();
+  } else if (tx_batch.size == 1) {
+    // Send the batch once the current task, which may write more PDUs, is done
+    task_sched.defer_task([this]() { flush_tx_batch(); });
   }
-  if (sendto(fd, pdu->msg, pdu->N_bytes, MSG_EOR, (struct sockaddr*)&servaddr, sizeof(struct sockaddr_in)) < 0) {
-    perror("sendto");
+}
+
+void gtpu::flush_tx_batch()
+{
+  size_t nof_sent = 0;
+  while (nof_sent < tx_batch.size and fd >= 0) {
+    int ret = sendmmsg(fd, &tx_batch.msgs[nof_sent], tx_batch.size - nof_sent, MSG_EOR);
+    if (ret < 0) {
+      // Drop the PDU that could not be sent and carry on with the rest
+      perror("sendmmsg");
+      ret = 1;
+    }
+    nof_sent += ret;
+  }
+  for (size_t i = 0; i < tx_batch.size; ++i) {
+    tx_batch.pdus[i].reset();
   }
+  tx_batch.size = 0;
 }
 
 srsran::expected<uint32_t> gtpu::add_bearer(uint16_t            rnti,
@@ -840,6 +904,9 @@ bool gtpu::send_end_marker(uint32_t teidin)
 
   gtpu_write_header(&header, pdu.get(), logger);
 
+  // The End Marker must not overtake the G-PDUs of the tunnel
+  flush_tx_batch();
+
   struct sockaddr_in servaddr = {};
   servaddr.sin_family         = AF_INET;
   servaddr.sin_addr.s_addr    = htonl(tx_tun->spgw_addr);
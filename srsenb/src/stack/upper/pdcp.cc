@@ -31,11 +31,15 @@ pdcp::pdcp(srsran::task_sched_handle task_sched_, srslog::basic_logger& logger_)
   task_sched(task_sched_), logger(logger_)
 {}
 
-void pdcp::init(rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interface_pdcp* gtpu_)
+void pdcp::init(rlc_interface_pdcp*       rlc_,
+                rrc_interface_pdcp*       rrc_,
+                gtpu_interface_pdcp*      gtpu_,
+                srsran::task_thread_pool* crypto_pool_)
 {
-  rlc  = rlc_;
-  rrc  = rrc_;
-  gtpu = gtpu_;
+  rlc         = rlc_;
+  rrc         = rrc_;
+  gtpu        = gtpu_;
+  crypto_pool = crypto_pool_;
 }
 
 void pdcp::stop()
@@ -51,6 +55,7 @@ void pdcp::add_user(uint16_t rnti)
   if (users.count(rnti) == 0) {
     unique_rnti_ptr<srsran::pdcp> obj = make_rnti_obj<srsran::pdcp>(rnti, task_sched, logger.id().c_str());
     obj->init(&users[rnti].rlc_itf, &users[rnti].rrc_itf, &users[rnti].gtpu_itf);
+    obj->set_crypto_pool(crypto_pool);
     users[rnti].rlc_itf.rnti  = rnti;
     users[rnti].gtpu_itf.rnti = rnti;
     users[rnti].rrc_itf.rnti  = rnti;
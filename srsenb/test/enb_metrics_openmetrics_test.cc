@@ -0,0 +1,216 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/metrics_openmetrics.h"
+#include "srsran/common/test_common.h"
+#include <arpa/inet.h>
+#include <string.h>
+#include <unistd.h>
+
+using namespace srsenb;
+
+namespace {
+
+const uint16_t test_http_port = 32811;
+const uint16_t test_udp_port  = 32812;
+
+enb_metrics_t make_metrics(uint16_t rnti, float dl_cqi)
+{
+  enb_metrics_t m = {};
+  m.stack.mac.cc_info.resize(1);
+  m.stack.mac.cc_info[0].cc_rach_counter = 3;
+  m.stack.rrc.ues.resize(1);
+  m.stack.mac.ues.resize(1);
+  m.stack.rlc.ues.resize(1);
+  m.stack.pdcp.ues.resize(1);
+  m.phy.resize(1);
+  m.stack.mac.ues[0]          = {};
+  m.stack.mac.ues[0].rnti     = rnti;
+  m.stack.mac.ues[0].dl_cqi   = dl_cqi;
+  m.stack.mac.ues[0].nof_tti  = 1000;
+  m.stack.mac.ues[0].tx_brate = 1000;
+  m.stack.mac.ues[0].tx_pkts  = 10;
+  m.stack.rrc.ues[0].drb_qci_map.emplace_back(3, 9);
+  m.stack.pdcp.ues[0].bearer[3].num_tx_acked_bytes = 12345;
+  return m;
+}
+
+std::string http_get(const char* path)
+{
+  int         fd   = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr = {};
+  addr.sin_family  = AF_INET;
+  addr.sin_port    = htons(test_http_port);
+  inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+  if (connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+    close(fd);
+    return {};
+  }
+  std::string request = std::string("GET ") + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  send(fd, request.data(), request.size(), 0);
+  std::string response;
+  char        buf[1024];
+  ssize_t     n;
+  while ((n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+    response.append(buf, n);
+  }
+  close(fd);
+  return response;
+}
+
+struct datagram_t {
+  bool     keyframe;
+  uint32_t seq;
+  uint32_t nof_definitions = 0;
+  uint32_t nof_values      = 0;
+  uint32_t nof_removals    = 0;
+};
+
+datagram_t recv_datagram(int fd)
+{
+  uint8_t buf[2048];
+  ssize_t n = recv(fd, buf, sizeof(buf), 0);
+  TESTASSERT(n >= 20);
+  uint32_t magic;
+  memcpy(&magic, buf, sizeof(magic));
+  TESTASSERT(magic == metrics_openmetrics::udp_magic);
+  TESTASSERT(buf[4] == metrics_openmetrics::udp_version);
+
+  datagram_t d;
+  uint16_t   nof_records;
+  d.keyframe = buf[5] & 1;
+  memcpy(&nof_records, &buf[6], sizeof(nof_records));
+  memcpy(&d.seq, &buf[8], sizeof(d.seq));
+  ssize_t pos = 20;
+  for (uint16_t i = 0; i != nof_records; ++i) {
+    TESTASSERT(pos + 5 <= n);
+    auto type = (metrics_openmetrics::record_type)buf[pos];
+    pos += 5;
+    switch (type) {
+      case metrics_openmetrics::record_type::value:
+        d.nof_values++;
+        pos += 8;
+        break;
+      case metrics_openmetrics::record_type::definition:
+        uint16_t len;
+        memcpy(&len, &buf[pos], sizeof(len));
+        d.nof_definitions++;
+        pos += 2 + len;
+        break;
+      case metrics_openmetrics::record_type::removal:
+        d.nof_removals++;
+        break;
+    }
+  }
+  TESTASSERT(pos == n);
+  return d;
+}
+
+int test_http_scrape()
+{
+  metrics_openmetrics_args_t args;
+  args.http_port = test_http_port;
+  metrics_openmetrics exporter(args);
+  TESTASSERT(exporter.init());
+
+  exporter.set_metrics(make_metrics(0x46, 12), 1000);
+  std::string response = http_get("/metrics");
+  TESTASSERT(response.find("HTTP/1.1 200 OK") == 0);
+  TESTASSERT(response.find("# TYPE srsenb_ue_dl_cqi gauge\n") != std::string::npos);
+  TESTASSERT(response.find("srsenb_ue_dl_cqi{cc=\"0\",rnti=\"70\"} 12\n") != std::string::npos);
+  TESTASSERT(response.find("srsenb_ue_dl_bitrate{cc=\"0\",rnti=\"70\"} 1000\n") != std::string::npos);
+  TESTASSERT(response.find("srsenb_bearer_dl_total_bytes{cc=\"0\",rnti=\"70\",bearer_id=\"3\",qci=\"9\"} 12345\n") !=
+             std::string::npos);
+  TESTASSERT(response.find("srsenb_cell_nof_rach{cc=\"0\"} 3\n") != std::string::npos);
+
+  // the first delta scrape returns all the series, the next ones only those that changed
+  TESTASSERT(http_get("/metrics/delta").find("srsenb_ue_dl_cqi") != std::string::npos);
+  exporter.set_metrics(make_metrics(0x46, 12.5), 1000);
+  response = http_get("/metrics/delta");
+  TESTASSERT(response.find("srsenb_ue_dl_cqi{cc=\"0\",rnti=\"70\"} 12.5\n") != std::string::npos);
+  TESTASSERT(response.find("srsenb_cell_nof_rach") == std::string::npos);
+
+  TESTASSERT(http_get("/other").find("HTTP/1.1 404 Not Found") == 0);
+  exporter.stop();
+  return SRSRAN_SUCCESS;
+}
+
+int test_udp_push()
+{
+  int         rx_fd   = socket(AF_INET, SOCK_DGRAM, 0);
+  sockaddr_in rx_addr = {};
+  rx_addr.sin_family  = AF_INET;
+  rx_addr.sin_port    = htons(test_udp_port);
+  inet_pton(AF_INET, "127.0.0.1", &rx_addr.sin_addr);
+  TESTASSERT(bind(rx_fd, (sockaddr*)&rx_addr, sizeof(rx_addr)) == 0);
+  timeval timeout = {1, 0};
+  setsockopt(rx_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  metrics_openmetrics_args_t args;
+  args.udp_addr        = "127.0.0.1";
+  args.udp_port        = test_udp_port;
+  args.keyframe_period = 3;
+  metrics_openmetrics exporter(args);
+  TESTASSERT(exporter.init());
+
+  // keyframe with all the series
+  exporter.set_metrics(make_metrics(0x46, 12), 1000);
+  datagram_t d = recv_datagram(rx_fd);
+  TESTASSERT(d.keyframe and d.seq == 0);
+  TESTASSERT(d.nof_definitions > 0 and d.nof_definitions == d.nof_values);
+  uint32_t nof_series = d.nof_definitions;
+
+  // only the changed value
+  exporter.set_metrics(make_metrics(0x46, 13), 1000);
+  d = recv_datagram(rx_fd);
+  TESTASSERT(not d.keyframe and d.seq == 1);
+  TESTASSERT(d.nof_definitions == 0 and d.nof_values == 1 and d.nof_removals == 0);
+
+  // the series of the released UE are removed and those of the new one defined
+  exporter.set_metrics(make_metrics(0x47, 13), 1000);
+  d = recv_datagram(rx_fd);
+  TESTASSERT(not d.keyframe);
+  TESTASSERT(d.nof_definitions == nof_series - 1 and d.nof_removals == nof_series - 1);
+
+  // keyframe
+  exporter.set_metrics(make_metrics(0x47, 13), 1000);
+  d = recv_datagram(rx_fd);
+  TESTASSERT(d.keyframe and d.seq == 3);
+  TESTASSERT(d.nof_definitions == nof_series and d.nof_values == nof_series);
+
+  exporter.stop();
+  close(rx_fd);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_http_scrape() == SRSRAN_SUCCESS);
+  TESTASSERT(test_udp_push() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/common/mac_kpi_sampler.h"
+#include "srsran/common/test_common.h"
+#include <memory>
+#include <thread>
+
+using namespace srsenb;
+using kpi = mac_kpi_sample_t;
+
+/// The samples read are the values accumulated in each TTI, and every reader reads them once
+void test_kpi_sampler_read()
+{
+  std::unique_ptr<mac_kpi_sampler> sampler(new mac_kpi_sampler());
+  uint64_t                         cursor = 0;
+  mac_kpi_sample_t                 sum;
+  TESTASSERT_EQ(0, sampler->read_samples(cursor, sum));
+
+  for (uint32_t tti = 0; tti < 10; ++tti) {
+    sampler->add_dl_grant(10);
+    sampler->add_ul_grant(5);
+    sampler->add_dl_harq_feedback(true, 100);
+    sampler->add_dl_harq_feedback(false, 0);
+    sampler->add_ul_crc(tti % 2 == 0, 50);
+    sampler->add_dl_cqi(tti);
+    sampler->push_sample();
+  }
+  uint64_t late_cursor = sampler->skip();
+  TESTASSERT_EQ(10, sampler->read_samples(cursor, sum));
+  TESTASSERT_EQ(100, sum[kpi::dl_nof_prb]);
+  TESTASSERT_EQ(50, sum[kpi::ul_nof_prb]);
+  TESTASSERT_EQ(1000, sum[kpi::dl_bytes]);
+  TESTASSERT_EQ(20, sum[kpi::dl_nof_tb]);
+  TESTASSERT_EQ(10, sum[kpi::dl_nof_nack]);
+  TESTASSERT_EQ(250, sum[kpi::ul_bytes]);
+  TESTASSERT_EQ(5, sum[kpi::ul_nof_crc_ko]);
+  TESTASSERT_EQ(45, sum[kpi::dl_cqi_sum]);
+  TESTASSERT_EQ(10, sum[kpi::dl_nof_cqi]);
+
+  // No new samples for this reader, and none for a reader that started after them
+  TESTASSERT_EQ(0, sampler->read_samples(cursor, sum));
+  TESTASSERT_EQ(0, sampler->read_samples(late_cursor, sum));
+
+  // A reader that falls behind only gets the samples still in the ring
+  for (uint32_t tti = 0; tti < 2 * mac_kpi_sampler::nof_samples; ++tti) {
+    sampler->add_dl_grant(1);
+    sampler->push_sample();
+  }
+  sum = {};
+  TESTASSERT_EQ(mac_kpi_sampler::nof_samples, sampler->read_samples(cursor, sum));
+  TESTASSERT_EQ(mac_kpi_sampler::nof_samples, sum[kpi::dl_nof_prb]);
+}
+
+/// The readers never get a sample that is being overwritten, while the MAC threads keep adding values
+void test_kpi_sampler_concurrent()
+{
+  std::unique_ptr<mac_kpi_sampler> sampler(new mac_kpi_sampler());
+  const uint32_t                   nof_ttis = 100000;
+  std::atomic<bool>                running{true};
+
+  // Every TTI adds the same value to the DL and UL PRB fields, so any sample read has both fields equal
+  std::thread writer([&]() {
+    for (uint32_t tti = 0; tti < nof_ttis; ++tti) {
+      sampler->add_dl_grant(tti);
+      sampler->add_ul_grant(tti);
+      sampler->push_sample();
+    }
+    running = false;
+  });
+
+  uint64_t cursor = 0, nof_read = 0;
+  while (running) {
+    mac_kpi_sample_t sum;
+    nof_read += sampler->read_samples(cursor, sum);
+    TESTASSERT_EQ(sum[kpi::dl_nof_prb], sum[kpi::ul_nof_prb]);
+  }
+  writer.join();
+  mac_kpi_sample_t sum;
+  nof_read += sampler->read_samples(cursor, sum);
+  TESTASSERT(nof_read > 0 and nof_read <= nof_ttis);
+  TESTASSERT_EQ(nof_ttis, cursor);
+}
+
+int main()
+{
+  test_kpi_sampler_read();
+  test_kpi_sampler_concurrent();
+  return SRSRAN_SUCCESS;
+}
@@ -84,7 +84,9 @@ sim_sched_args generate_default_sim_args(uint32_t nof_prb, uint32_t nof_ccs)
 }
 
 struct test_scell_activation_params {
-  uint32_t pcell_idx = 0;
+  uint32_t pcell_idx      = 0;
+  uint32_t nof_cc_threads = 0;
+  uint32_t lookahead_ttis = 0;
 };
 
 int test_scell_activation(uint32_t sim_number, test_scell_activation_params params)
@@ -112,7 +114,13 @@ int test_scell_activation(uint32_t sim_number, test_scell_activation_params para
 
   /* Setup simulation arguments struct */
   sim_sched_args sim_args = generate_default_sim_args(nof_prb, nof_ccs);
-  sim_args.start_tti      = start_tti;
+  sim_args.start_tti                 = start_tti;
+  sim_args.sched_args.nof_cc_threads = params.nof_cc_threads;
+  sim_args.sched_args.lookahead_ttis = params.lookahead_ttis;
+  for (auto& cell : sim_args.cell_cfg) {
+    // The RAR window TTIs already precomputed when the PRACH is detected are lost
+    cell.prach_rar_window += params.lookahead_ttis;
+  }
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list.resize(1);
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list[0].active                                = true;
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list[0].enb_cc_idx                            = cc_idxs[0];
@@ -183,9 +191,10 @@ int test_scell_activation(uint32_t sim_number, test_scell_activation_params para
     TESTASSERT(activ_list[i] >= 0);
   }
 
-  // TEST: When a DL newtx takes place, it should also encode the CE
+  // TEST: When a DL newtx takes place, it should also encode the CE. The TTIs precomputed before the reconfiguration
+  // are skipped
   for (uint32_t i = 0; i < 100; ++i) {
-    if (not tester.tti_info.dl_sched_result[params.pcell_idx].data.empty()) {
+    if (i >= params.lookahead_ttis and not tester.tti_info.dl_sched_result[params.pcell_idx].data.empty()) {
       // DL data was allocated
       if (tester.tti_info.dl_sched_result[params.pcell_idx].data[0].nof_pdu_elems[0] > 0) {
         // it is a new DL tx
@@ -282,6 +291,26 @@ int main()
     TESTASSERT(test_scell_activation(n * 2 + 1, p) == SRSRAN_SUCCESS);
   }
 
+  // Same scenarios, with the carriers scheduled in parallel
+  for (uint32_t n = 0; n < N_runs; ++n) {
+    printf("[TESTER] Parallel CC sim run number: %u\n", n);
+
+    test_scell_activation_params p = {};
+    p.pcell_idx                    = n % 2;
+    p.nof_cc_threads               = 1;
+    TESTASSERT(test_scell_activation(N_runs * 2 + n, p) == SRSRAN_SUCCESS);
+  }
+
+  // Same scenarios, with the decisions computed ahead of the PHY
+  for (uint32_t n = 0; n < N_runs; ++n) {
+    printf("[TESTER] Lookahead sim run number: %u\n", n);
+
+    test_scell_activation_params p = {};
+    p.pcell_idx                    = n % 2;
+    p.lookahead_ttis               = 1 + n % 2;
+    TESTASSERT(test_scell_activation(N_runs * 3 + n, p) == SRSRAN_SUCCESS);
+  }
+
   srslog::flush();
 
   return 0;
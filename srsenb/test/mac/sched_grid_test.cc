@@ -251,6 +251,59 @@ int test_6prbs()
   return SRSRAN_SUCCESS;
 }
 
+int test_pdcch_many_ues()
+{
+  uint32_t nof_prb = 25, aggr_idx = 1, nof_ues = 16;
+
+  std::vector<sched_cell_params_t> cell_params(1);
+  sched_interface::ue_cfg_t        ue_cfg   = generate_default_ue_cfg();
+  sched_interface::cell_cfg_t      cell_cfg = generate_default_cell_cfg(nof_prb);
+  sched_interface::sched_args_t    sched_args{};
+  TESTASSERT(cell_params[0].set_cfg(0, cell_cfg, sched_args));
+
+  std::vector<std::unique_ptr<sched_ue> > ues;
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    ues.emplace_back(new sched_ue{(uint16_t)(0x46 + i), cell_params, ue_cfg});
+  }
+
+  sf_cch_allocator pdcch;
+  pdcch.init(cell_params[PCell_IDX]);
+
+  std::vector<uint32_t> first_ncces;
+  uint32_t              first_cfi = 0;
+  for (uint32_t tti = 0; tti < 5 * TTIMOD_SZ; tti += TTIMOD_SZ) {
+    pdcch.new_tti(tti_point{tti});
+    uint32_t nof_cces_alloc = 0;
+    for (auto& u : ues) {
+      if (pdcch.alloc_dci(alloc_type_t::DL_DATA, aggr_idx, u.get(), false)) {
+        nof_cces_alloc += (1U << aggr_idx);
+      }
+    }
+    TESTASSERT(pdcch.nof_allocs() > 0);
+
+    // TEST: No collisions between the PDCCH allocations
+    sf_cch_allocator::alloc_result_t dci_result;
+    pdcch_mask_t                     result_pdcch_mask;
+    pdcch.get_allocs(&dci_result, &result_pdcch_mask);
+    TESTASSERT(dci_result.size() == pdcch.nof_allocs());
+    TESTASSERT(result_pdcch_mask.count() == nof_cces_alloc);
+
+    // TEST: The same set of allocations leads to the same result for the same sf_idx
+    std::vector<uint32_t> ncces;
+    for (const auto* node : dci_result) {
+      ncces.push_back(node->dci_pos.ncce);
+    }
+    if (first_ncces.empty()) {
+      first_ncces = ncces;
+      first_cfi   = pdcch.get_cfi();
+    }
+    TESTASSERT(ncces == first_ncces);
+    TESTASSERT(pdcch.get_cfi() == first_cfi);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   srsenb::set_randseed(seed);
@@ -265,6 +318,7 @@ int main()
   TESTASSERT(test_pdcch_one_ue() == SRSRAN_SUCCESS);
   TESTASSERT(test_pdcch_ue_and_sibs() == SRSRAN_SUCCESS);
   TESTASSERT(test_6prbs() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pdcch_many_ues() == SRSRAN_SUCCESS);
 
   srslog::flush();
 
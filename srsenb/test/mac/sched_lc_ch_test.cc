@@ -197,6 +197,49 @@ int test_lc_ch_pbr_finite()
   return SRSRAN_SUCCESS;
 }
 
+int test_lc_ch_reconfig()
+{
+  srsenb::lch_ue_manager lch_handler{0x46};
+
+  srsenb::sched_interface::ue_cfg_t ue_cfg                  = generate_default_ue_cfg();
+  ue_cfg                                                    = generate_setup_ue_cfg(ue_cfg);
+  ue_cfg.ue_bearers[drb_to_lcid((lte_drb::drb1))]           = {};
+  ue_cfg.ue_bearers[drb_to_lcid((lte_drb::drb1))].direction = mac_lc_ch_cfg_t::BOTH;
+  ue_cfg.ue_bearers[drb_to_lcid((lte_drb::drb1))].priority  = 5;
+  ue_cfg.ue_bearers[drb_to_lcid((lte_drb::drb2))]           = {};
+  ue_cfg.ue_bearers[drb_to_lcid((lte_drb::drb2))].direction = mac_lc_ch_cfg_t::BOTH;
+  ue_cfg.ue_bearers[drb_to_lcid((lte_drb::drb2))].priority  = 3;
+
+  lch_handler.set_cfg(ue_cfg);
+  lch_handler.new_tti();
+  TESTASSERT(not lch_handler.has_pending_dl_txs());
+  TESTASSERT(lch_handler.get_max_prio_lcid() < 0);
+
+  lch_handler.dl_buffer_state(drb_to_lcid(lte_drb::drb1), 1000, 0);
+  lch_handler.dl_buffer_state(drb_to_lcid(lte_drb::drb2), 1000, 0);
+  TESTASSERT(lch_handler.get_dl_tx_total() == 2000);
+  TESTASSERT(lch_handler.get_max_prio_lcid() == drb_to_lcid(lte_drb::drb2));
+
+  // TEST1 - The priority order follows a bearer reconfiguration, without new buffer reports
+  mac_lc_ch_cfg_t drb1_cfg = ue_cfg.ue_bearers[drb_to_lcid(lte_drb::drb1)];
+  drb1_cfg.priority        = 1;
+  lch_handler.config_lcid(drb_to_lcid(lte_drb::drb1), drb1_cfg);
+  TESTASSERT(lch_handler.get_max_prio_lcid() == drb_to_lcid(lte_drb::drb1));
+
+  // TEST2 - The data of a released bearer is not allocated
+  lch_handler.config_lcid(drb_to_lcid(lte_drb::drb1), mac_lc_ch_cfg_t{});
+  TESTASSERT(lch_handler.get_dl_tx_total() == 1000);
+  TESTASSERT(lch_handler.get_max_prio_lcid() == drb_to_lcid(lte_drb::drb2));
+
+  // TEST3 - Nothing is pending once the remaining bearer is emptied
+  TESTASSERT(test_newtx_until_empty(lch_handler, drb_to_lcid(lte_drb::drb2), 500) == 1000);
+  TESTASSERT(not lch_handler.has_pending_dl_txs());
+  TESTASSERT(lch_handler.get_dl_tx_total() == 0);
+  TESTASSERT(lch_handler.get_max_prio_lcid() < 0);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   srsenb::set_randseed(seed);
@@ -210,6 +253,7 @@ int main()
 
   TESTASSERT(test_lc_ch_pbr_infinity() == SRSRAN_SUCCESS);
   TESTASSERT(test_lc_ch_pbr_finite() == SRSRAN_SUCCESS);
+  TESTASSERT(test_lc_ch_reconfig() == SRSRAN_SUCCESS);
 
   srslog::flush();
 
@@ -0,0 +1,150 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Replays a scheduler trace, recorded by an eNB with the scheduler.trace_filename option, into the scheduler and
+ * reports the distribution of the time spent computing the decision of each TTI.
+ *
+ * Usage: sched_replay <trace file> [nof_repetitions] [sched_policy]
+ */
+
+#include "sched_test_common.h"
+#include "srsenb/hdr/stack/mac/sched.h"
+#include "srsenb/hdr/stack/mac/sched_trace.h"
+#include <algorithm>
+#include <chrono>
+
+namespace srsenb {
+
+struct replay_stats {
+  std::vector<uint64_t> tti_latencies_ns;
+  std::vector<uint32_t> event_count = std::vector<uint32_t>((size_t)sched_trace_event_t::nof_events, 0);
+};
+
+/// Replays the trace once, adding the latency of the decision of each TTI to the stats
+int replay_trace(sched_trace_reader& reader, const sched_interface::sched_args_t& args, replay_stats& stats)
+{
+  sched     sched_obj;
+  rrc_dummy rrc{};
+  sched_obj.init(&rrc, args);
+  reader.rewind();
+
+  tti_point           current_tti;
+  uint64_t            current_tti_ns = 0;
+  sched_trace_event_t ev;
+  tti_point           tti_rx;
+  while (true) {
+    auto tp    = std::chrono::steady_clock::now();
+    bool valid = reader.replay_next(sched_obj, ev, tti_rx);
+    auto tdur  = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp);
+    if (not valid) {
+      break;
+    }
+    stats.event_count[(size_t)ev]++;
+    if (ev != sched_trace_event_t::dl_sched and ev != sched_trace_event_t::ul_sched) {
+      continue;
+    }
+    // The DL and UL decisions of all carriers of a TTI are accounted together
+    if (tti_rx != current_tti) {
+      if (current_tti.is_valid()) {
+        stats.tti_latencies_ns.push_back(current_tti_ns);
+      }
+      current_tti    = tti_rx;
+      current_tti_ns = 0;
+    }
+    current_tti_ns += tdur.count();
+  }
+  if (current_tti.is_valid()) {
+    stats.tti_latencies_ns.push_back(current_tti_ns);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+void print_stats(replay_stats& stats)
+{
+  printf("Replayed events:\n");
+  for (uint32_t i = 0; i < stats.event_count.size(); ++i) {
+    if (stats.event_count[i] > 0) {
+      printf("  %-14s %u\n", to_string((sched_trace_event_t)i), stats.event_count[i]);
+    }
+  }
+
+  std::vector<uint64_t>& lat = stats.tti_latencies_ns;
+  if (lat.empty()) {
+    printf("No TTI decisions found in the trace\n");
+    return;
+  }
+  std::sort(lat.begin(), lat.end());
+  double mean = 0;
+  for (uint64_t v : lat) {
+    mean += v;
+  }
+  mean /= lat.size();
+  auto percentile = [&lat](double q) { return lat[std::min((size_t)(q * lat.size()), lat.size() - 1)] / 1000.0; };
+  printf("TTI decision latency over %zd TTIs (usec): mean=%.1f, p50=%.1f, p90=%.1f, p99=%.1f, p99.9=%.1f, max=%.1f\n",
+         lat.size(),
+         mean / 1000.0,
+         percentile(0.5),
+         percentile(0.9),
+         percentile(0.99),
+         percentile(0.999),
+         lat.back() / 1000.0);
+}
+
+} // namespace srsenb
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    printf("Usage: %s <trace file> [nof_repetitions] [sched_policy]\n", argv[0]);
+    return SRSRAN_ERROR;
+  }
+  uint32_t nof_reps = argc > 2 ? strtoul(argv[2], nullptr, 10) : 1;
+
+  auto& mac_log = srslog::fetch_basic_logger("MAC");
+  mac_log.set_level(srslog::basic_levels::error);
+  srslog::init();
+
+  srsenb::sched_trace_reader            reader;
+  srsenb::sched_interface::sched_args_t args;
+  if (not reader.open(argv[1], args)) {
+    srslog::flush();
+    return SRSRAN_ERROR;
+  }
+  if (argc > 3) {
+    // Allows comparing different scheduling policies for the same traffic
+    args.sched_policy = argv[3];
+  }
+  printf("Replaying %zd events of %s %u times with policy %s\n",
+         reader.nof_events(),
+         argv[1],
+         nof_reps,
+         args.sched_policy.c_str());
+
+  srsenb::replay_stats stats;
+  for (uint32_t i = 0; i < nof_reps; ++i) {
+    srsenb::replay_trace(reader, args, stats);
+  }
+  srsenb::print_stats(stats);
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
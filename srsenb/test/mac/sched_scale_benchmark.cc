@@ -0,0 +1,354 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Measures how the scheduler scales with the number of connected UEs. For each combination of number of UEs, number
+ * of carriers and traffic pattern, the UEs attach via RACH, spread in round-robin across independent carriers, and the
+ * time spent in dl_sched() + ul_sched() of all carriers of a TTI is recorded. The memory per UE is the heap growth of
+ * a fresh scheduler once all the UEs are configured.
+ *
+ * Usage: sched_scale_benchmark [nof_ttis] [max_nof_ues]
+ *
+ * UE counts above SRSENB_MAX_UES are skipped. Build with e.g. -DMAX_UES=2048 to benchmark them.
+ */
+
+#include "sched_test_common.h"
+#include "srsenb/hdr/stack/mac/sched.h"
+#include <algorithm>
+#include <chrono>
+#include <malloc.h>
+
+namespace srsenb {
+
+/// Bytes in use by the heap of this process
+static size_t heap_bytes_in_use()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  return mallinfo2().uordblks;
+#elif defined(__GLIBC__)
+  return mallinfo().uordblks;
+#else
+  return 0;
+#endif
+}
+
+/// Every "period" TTIs, each UE gets new DL and UL data. The TTI of arrival is shifted by the RNTI
+struct traffic_pattern {
+  const char* name;
+  uint32_t    period;
+  uint32_t    dl_bytes;
+  uint32_t    ul_bytes;
+};
+static const traffic_pattern traffic_patterns[] = {{"full_buffer", 1, 100000, 100000},
+                                                   {"voip", 20, 40, 40},
+                                                   {"bursty", 100, 15000, 5000}};
+
+struct run_params {
+  uint32_t               nof_ues;
+  uint32_t               nof_cells;
+  const traffic_pattern* traffic;
+  uint32_t               nof_ttis;
+};
+
+struct run_data {
+  run_params params;
+  double     mean_usec;
+  double     p50_usec, p90_usec, p99_usec, p999_usec, max_usec;
+  double     dl_mbps, ul_mbps;
+  size_t     base_bytes;
+  size_t     bytes_per_ue;
+};
+
+const uint32_t nof_prbs             = 100;
+const uint32_t ues_per_prach        = 4;
+const uint32_t max_attach_tti       = 20000;
+const uint32_t max_ul_pending_bytes = 1000000;
+
+std::vector<sched_interface::cell_cfg_t> generate_cell_list(uint32_t nof_cells)
+{
+  std::vector<sched_interface::cell_cfg_t> cell_list;
+  for (uint32_t i = 0; i < nof_cells; ++i) {
+    cell_list.push_back(generate_default_cell_cfg(nof_prbs));
+    cell_list.back().cell.id = i + 1;
+    // One PRACH occasion per frame
+    cell_list.back().prach_config = 3;
+  }
+  return cell_list;
+}
+
+sched_interface::ue_cfg_t generate_ue_cfg(uint32_t pcell_idx)
+{
+  sched_interface::ue_cfg_t ue_cfg       = generate_default_ue_cfg();
+  ue_cfg.supported_cc_list[0].enb_cc_idx = pcell_idx;
+  return ue_cfg;
+}
+
+class sched_tester : public sched_sim_base
+{
+public:
+  explicit sched_tester(sched*                                          sched_obj_,
+                        const sched_interface::sched_args_t&            sched_args,
+                        const std::vector<sched_interface::cell_cfg_t>& cell_cfg_list,
+                        const traffic_pattern&                          traffic_) :
+    sched_sim_base(sched_obj_, sched_args, cell_cfg_list),
+    sched_ptr(sched_obj_),
+    traffic(traffic_),
+    dl_result(cell_cfg_list.size()),
+    ul_result(cell_cfg_list.size())
+  {}
+
+  sched*                 sched_ptr;
+  const traffic_pattern& traffic;
+  bool                   record_stats = false;
+
+  std::vector<sched_interface::dl_sched_res_t> dl_result;
+  std::vector<sched_interface::ul_sched_res_t> ul_result;
+
+  std::vector<uint64_t>        tti_latencies_ns;
+  uint64_t                     dl_bytes = 0, ul_bytes = 0;
+  std::map<uint16_t, uint32_t> ul_pending_bytes;
+
+  int advance_tti()
+  {
+    tti_point tti_rx = get_tti_rx().is_valid() ? get_tti_rx() + 1 : tti_point(0);
+    new_tti(tti_rx);
+
+    // The decisions of all carriers of a TTI are accounted together
+    uint64_t tti_ns = 0;
+    for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
+      auto tp = std::chrono::steady_clock::now();
+      TESTASSERT(sched_ptr->dl_sched(to_tx_dl(tti_rx).to_uint(), cc, dl_result[cc]) == SRSRAN_SUCCESS);
+      TESTASSERT(sched_ptr->ul_sched(to_tx_ul(tti_rx).to_uint(), cc, ul_result[cc]) == SRSRAN_SUCCESS);
+      tti_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp).count();
+    }
+
+    sf_output_res_t sf_out{get_cell_params(), tti_rx, ul_result, dl_result};
+    update(sf_out);
+
+    // The UE reports its remaining UL buffer with each new PUSCH transmission
+    for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
+      for (const auto& pusch : ul_result[cc].pusch) {
+        auto it = ul_pending_bytes.find(pusch.dci.rnti);
+        if (pusch.current_tx_nb == 0 and it != ul_pending_bytes.end()) {
+          it->second -= std::min(it->second, pusch.tbs);
+          sched_ptr->ul_bsr(pusch.dci.rnti, 1, it->second);
+        }
+      }
+    }
+
+    if (record_stats) {
+      tti_latencies_ns.push_back(tti_ns);
+      for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
+        for (const auto& data : dl_result[cc].data) {
+          dl_bytes += data.tbs[0] + data.tbs[1];
+        }
+        for (const auto& pusch : ul_result[cc].pusch) {
+          ul_bytes += pusch.tbs;
+        }
+      }
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  void set_external_tti_events(const sim_ue_ctxt_t& ue_ctxt, ue_tti_events& pending_events) override
+  {
+    if (not ue_ctxt.conres_rx) {
+      return;
+    }
+    if ((get_tti_rx().to_uint() + ue_ctxt.rnti) % traffic.period == 0) {
+      uint32_t& ul_pending = ul_pending_bytes[ue_ctxt.rnti];
+      ul_pending           = std::min(ul_pending + traffic.ul_bytes, max_ul_pending_bytes);
+      sched_ptr->ul_bsr(ue_ctxt.rnti, 1, ul_pending);
+      sched_ptr->dl_rlc_buffer_state(ue_ctxt.rnti, drb_to_lcid(lte_drb::drb1), traffic.dl_bytes, 0);
+    }
+    if (get_tti_rx().to_uint() % 5 == 0) {
+      for (auto& cc : pending_events.cc_list) {
+        cc.dl_cqi = 15;
+        cc.ul_snr = 40;
+      }
+    }
+  }
+
+  bool all_ues_attached() const
+  {
+    sim_enb_ctxt_t enb_ctxt = get_enb_ctxt();
+    return std::all_of(enb_ctxt.ue_db.begin(),
+                       enb_ctxt.ue_db.end(),
+                       [](const std::pair<const uint16_t, const sim_ue_ctxt_t*>& p) { return p.second->conres_rx; });
+  }
+};
+
+/// Heap growth of a scheduler without simulator when "nof_ues" UEs are configured
+void measure_memory(const run_params& params, run_data& result)
+{
+  sched_interface::sched_args_t sched_args = {};
+  rrc_dummy                     rrc{};
+
+  size_t                 heap_start = heap_bytes_in_use();
+  std::unique_ptr<sched> sched_obj(new sched());
+  sched_obj->init(&rrc, sched_args);
+  sched_obj->cell_cfg(generate_cell_list(params.nof_cells));
+  size_t heap_cells = heap_bytes_in_use();
+
+  for (uint32_t i = 0; i < params.nof_ues; ++i) {
+    sched_obj->ue_cfg(0x46 + i, generate_ue_cfg(i % params.nof_cells));
+  }
+  size_t heap_ues = heap_bytes_in_use();
+
+  result.base_bytes   = heap_cells - heap_start;
+  result.bytes_per_ue = heap_ues > heap_cells ? (heap_ues - heap_cells) / params.nof_ues : 0;
+}
+
+int run_benchmark_scenario(const run_params& params, std::vector<run_data>& run_results)
+{
+  std::vector<sched_interface::cell_cfg_t> cell_list  = generate_cell_list(params.nof_cells);
+  sched_interface::sched_args_t            sched_args = {};
+
+  sched     sched_obj;
+  rrc_dummy rrc{};
+  sched_obj.init(&rrc, sched_args);
+  sched_tester tester(&sched_obj, sched_args, cell_list, *params.traffic);
+
+  // Attach UEs, a few per PRACH occasion of each carrier
+  uint32_t ue_idx = 0;
+  while (ue_idx < params.nof_ues) {
+    while (not srsran_prach_tti_opportunity_config_fdd(cell_list[0].prach_config, tester.get_tti_rx().to_uint(), -1)) {
+      TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+    }
+    for (uint32_t i = 0; i < ues_per_prach * params.nof_cells and ue_idx < params.nof_ues; ++i, ++ue_idx) {
+      uint32_t preamble_idx = 16 + i / params.nof_cells;
+      TESTASSERT(tester.add_user(0x46 + ue_idx, generate_ue_cfg(ue_idx % params.nof_cells), preamble_idx) ==
+                 SRSRAN_SUCCESS);
+    }
+    TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+  }
+  for (uint32_t count = 0; not tester.all_ues_attached(); ++count) {
+    CONDERROR(count >= max_attach_tti, "Not all UEs completed the RACH procedure");
+    TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+  }
+
+  // Run benchmark
+  tester.record_stats = true;
+  tester.tti_latencies_ns.reserve(params.nof_ttis);
+  for (uint32_t count = 0; count < params.nof_ttis; ++count) {
+    TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+  }
+
+  std::vector<uint64_t>& lat = tester.tti_latencies_ns;
+  std::sort(lat.begin(), lat.end());
+  double mean = 0;
+  for (uint64_t v : lat) {
+    mean += v;
+  }
+  auto percentile = [&lat](double q) { return lat[std::min((size_t)(q * lat.size()), lat.size() - 1)] / 1000.0; };
+
+  run_data r  = {};
+  r.params    = params;
+  r.mean_usec = mean / lat.size() / 1000.0;
+  r.p50_usec  = percentile(0.5);
+  r.p90_usec  = percentile(0.9);
+  r.p99_usec  = percentile(0.99);
+  r.p999_usec = percentile(0.999);
+  r.max_usec  = lat.back() / 1000.0;
+  r.dl_mbps   = tester.dl_bytes * 8.0 / params.nof_ttis / 1000.0;
+  r.ul_mbps   = tester.ul_bytes * 8.0 / params.nof_ttis / 1000.0;
+  measure_memory(params, r);
+  run_results.push_back(r);
+
+  return SRSRAN_SUCCESS;
+}
+
+void print_benchmark_results(const std::vector<run_data>& run_results)
+{
+  srslog::flush();
+  fmt::print("TTI decision latency of all carriers in usec, heap memory of the scheduler and of each UE\n");
+  fmt::print("run    Nue  Ncell      traffic    DL/UL [Mbps]     mean      p50      p90      p99    p99.9      max  "
+             "base [KB]   UE [B]\n");
+  fmt::print("------------------------------------------------------------------------------------------------------"
+             "------------------\n");
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    const run_data& r = run_results[i];
+    fmt::print("{:>3d}{:>7d}{:>7d}{:>13}{:>9.1f}/{:>6.1f}{:>9.1f}{:>9.1f}{:>9.1f}{:>9.1f}{:>9.1f}{:>9.1f}"
+               "{:>11d}{:>9d}\n",
+               i,
+               r.params.nof_ues,
+               r.params.nof_cells,
+               r.params.traffic->name,
+               r.dl_mbps,
+               r.ul_mbps,
+               r.mean_usec,
+               r.p50_usec,
+               r.p90_usec,
+               r.p99_usec,
+               r.p999_usec,
+               r.max_usec,
+               r.base_bytes / 1024,
+               r.bytes_per_ue);
+  }
+}
+
+int run_all(uint32_t nof_ttis, uint32_t max_nof_ues)
+{
+  std::vector<uint32_t> nof_ues_list   = {10, 50, 100, 500, 1000, 2000};
+  std::vector<uint32_t> nof_cells_list = {1, 2, 4};
+  srslog::basic_logger& mac_logger     = srslog::fetch_basic_logger("MAC");
+
+  std::vector<run_data> run_results;
+  for (uint32_t nof_ues : nof_ues_list) {
+    if (nof_ues > max_nof_ues) {
+      continue;
+    }
+    if (nof_ues > SRSENB_MAX_UES) {
+      fmt::print("Skipping runs with {} UEs, as SRSENB_MAX_UES={}\n", nof_ues, SRSENB_MAX_UES);
+      continue;
+    }
+    for (uint32_t nof_cells : nof_cells_list) {
+      for (const traffic_pattern& traffic : traffic_patterns) {
+        run_params params = {nof_ues, nof_cells, &traffic, nof_ttis};
+        mac_logger.info("\n### New run: nof_ues=%d, nof_cells=%d, traffic=%s ###\n", nof_ues, nof_cells, traffic.name);
+        TESTASSERT(run_benchmark_scenario(params, run_results) == SRSRAN_SUCCESS);
+      }
+    }
+  }
+
+  print_benchmark_results(run_results);
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main(int argc, char* argv[])
+{
+  uint32_t nof_ttis    = argc > 1 ? strtoul(argv[1], nullptr, 10) : 10000;
+  uint32_t max_nof_ues = argc > 2 ? strtoul(argv[2], nullptr, 10) : std::numeric_limits<uint32_t>::max();
+
+  auto& mac_log = srslog::fetch_basic_logger("MAC");
+  mac_log.set_level(srslog::basic_levels::error);
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::error);
+  srslog::init();
+
+  TESTASSERT(srsenb::run_all(nof_ttis, max_nof_ues) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
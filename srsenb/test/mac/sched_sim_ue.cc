@@ -355,6 +355,11 @@ int sched_sim_base::set_default_tti_events(const sim_ue_ctxt_t& ue_ctxt, ue_tti_
 
 int sched_sim_base::apply_tti_events(sim_ue_ctxt_t& ue_ctxt, const ue_tti_events& events)
 {
+  using ul_feedback_t = sched_interface::ul_feedback_t;
+  // In odd TTIs, the feedback is given to the scheduler in a single batch, as done by the PHY
+  bool                                batch_feedback = events.tti_rx.to_uint() % 2 == 1;
+  sched_interface::ul_feedback_list_t feedback;
+
   for (uint32_t enb_cc_idx = 0; enb_cc_idx < events.cc_list.size(); ++enb_cc_idx) {
     const auto& cc_feedback = events.cc_list[enb_cc_idx];
     if (not cc_feedback.configured) {
@@ -372,8 +377,16 @@ int sched_sim_base::apply_tti_events(sim_ue_ctxt_t& ue_ctxt, const ue_tti_events
       }
 
       // update scheduler
-      if (sched_ptr->dl_ack_info(
-              events.tti_rx.to_uint(), ue_ctxt.rnti, enb_cc_idx, cc_feedback.tb, cc_feedback.dl_ack) < 0) {
+      if (batch_feedback) {
+        feedback.push_back({ul_feedback_t::dl_ack,
+                            ue_ctxt.rnti,
+                            enb_cc_idx,
+                            (uint32_t)cc_feedback.tb,
+                            (uint32_t)cc_feedback.dl_ack,
+                            0,
+                            0});
+      } else if (sched_ptr->dl_ack_info(
+                     events.tti_rx.to_uint(), ue_ctxt.rnti, enb_cc_idx, cc_feedback.tb, cc_feedback.dl_ack) < 0) {
         logger.error("The ACKed DL Harq pid=%d does not exist.", cc_feedback.dl_pid);
         error_counter++;
       }
@@ -395,18 +408,39 @@ int sched_sim_base::apply_tti_events(sim_ue_ctxt_t& ue_ctxt, const ue_tti_events
       }
 
       // update scheduler
-      if (sched_ptr->ul_crc_info(events.tti_rx.to_uint(), ue_ctxt.rnti, enb_cc_idx, cc_feedback.ul_ack) < 0) {
+      if (batch_feedback) {
+        feedback.push_back({ul_feedback_t::ul_crc, ue_ctxt.rnti, enb_cc_idx, 0, (uint32_t)cc_feedback.ul_ack, 0, 0});
+      } else if (sched_ptr->ul_crc_info(events.tti_rx.to_uint(), ue_ctxt.rnti, enb_cc_idx, cc_feedback.ul_ack) < 0) {
         logger.error("The ACKed UL Harq pid=%d does not exist.", cc_feedback.ul_pid);
         error_counter++;
       }
     }
 
     if (cc_feedback.dl_cqi >= 0) {
-      sched_ptr->dl_cqi_info(events.tti_rx.to_uint(), ue_ctxt.rnti, enb_cc_idx, cc_feedback.dl_cqi);
+      if (batch_feedback) {
+        feedback.push_back({ul_feedback_t::dl_cqi, ue_ctxt.rnti, enb_cc_idx, 0, (uint32_t)cc_feedback.dl_cqi, 0, 0});
+      } else {
+        sched_ptr->dl_cqi_info(events.tti_rx.to_uint(), ue_ctxt.rnti, enb_cc_idx, cc_feedback.dl_cqi);
+      }
     }
 
     if (cc_feedback.ul_snr >= 0) {
-      sched_ptr->ul_snr_info(events.tti_rx.to_uint(), ue_ctxt.rnti, enb_cc_idx, cc_feedback.ul_snr, 0);
+      if (batch_feedback) {
+        feedback.push_back({ul_feedback_t::ul_snr, ue_ctxt.rnti, enb_cc_idx, 0, 0, (float)cc_feedback.ul_snr, 0});
+      } else {
+        sched_ptr->ul_snr_info(events.tti_rx.to_uint(), ue_ctxt.rnti, enb_cc_idx, cc_feedback.ul_snr, 0);
+      }
+    }
+  }
+
+  if (not feedback.empty()) {
+    TESTASSERT(sched_ptr->ul_feedback_info(events.tti_rx.to_uint(), feedback) == SRSRAN_SUCCESS);
+    for (const ul_feedback_t& fb : feedback) {
+      if ((fb.type == ul_feedback_t::dl_ack or fb.type == ul_feedback_t::ul_crc) and fb.ret < 0) {
+        const char* dir = (fb.type == ul_feedback_t::dl_ack) ? "DL" : "UL";
+        logger.error("The ACKed %s Harq of rnti=0x%x, cc=%d does not exist.", dir, fb.rnti, fb.enb_cc_idx);
+        error_counter++;
+      }
     }
   }
 
@@ -277,6 +277,9 @@ int common_sched_tester::run_tti(const tti_ev& tti_events)
   }
 
   TESTASSERT(process_results() == SRSRAN_SUCCESS);
+
+  // Compute the next TTIs ahead of time, as the stack does when lookahead is enabled
+  precompute_ttis();
   tti_count++;
   return SRSRAN_SUCCESS;
 }
@@ -0,0 +1,193 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_test_common.h"
+#include "srsenb/hdr/stack/mac/sched.h"
+#include "srsenb/hdr/stack/mac/sched_trace.h"
+#include "srsran/common/test_common.h"
+#include <cstdio>
+
+namespace srsenb {
+
+const char* trace_filename = "sched_trace_test.trace";
+
+/// Summary of a DL or UL scheduling result, used to compare the recorded and the replayed runs
+using sched_summary_t = std::vector<uint32_t>;
+
+sched_summary_t summarize(const sched_interface::dl_sched_res_t& res)
+{
+  sched_summary_t s{res.cfi, (uint32_t)res.rar.size(), (uint32_t)res.bc.size()};
+  for (const auto& data : res.data) {
+    s.push_back(data.dci.rnti);
+    s.push_back(data.tbs[0]);
+    s.push_back(data.tbs[1]);
+    s.push_back(data.dci.location.ncce);
+    s.push_back(data.dci.tb[0].mcs_idx);
+  }
+  return s;
+}
+
+sched_summary_t summarize(const sched_interface::ul_sched_res_t& res)
+{
+  sched_summary_t s{(uint32_t)res.phich.size()};
+  for (const auto& pusch : res.pusch) {
+    s.push_back(pusch.dci.rnti);
+    s.push_back(pusch.tbs);
+    s.push_back(pusch.dci.type2_alloc.riv);
+    s.push_back(pusch.dci.tb.mcs_idx);
+  }
+  return s;
+}
+
+class trace_sched_tester : public sched_sim_base
+{
+public:
+  trace_sched_tester(sched*                                          sched_obj_,
+                     const sched_interface::sched_args_t&            sched_args,
+                     const std::vector<sched_interface::cell_cfg_t>& cell_cfg_list) :
+    sched_sim_base(sched_obj_, sched_args, cell_cfg_list), sched_ptr(sched_obj_)
+  {}
+
+  int advance_tti()
+  {
+    tti_point tti_rx = get_tti_rx().is_valid() ? get_tti_rx() + 1 : tti_point(0);
+    new_tti(tti_rx);
+
+    std::vector<sched_interface::dl_sched_res_t> dl_res(get_cell_params().size());
+    std::vector<sched_interface::ul_sched_res_t> ul_res(get_cell_params().size());
+    for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
+      TESTASSERT(sched_ptr->dl_sched(to_tx_dl(tti_rx).to_uint(), cc, dl_res[cc]) == SRSRAN_SUCCESS);
+      TESTASSERT(sched_ptr->ul_sched(to_tx_ul(tti_rx).to_uint(), cc, ul_res[cc]) == SRSRAN_SUCCESS);
+      dl_results.push_back(summarize(dl_res[cc]));
+      ul_results.push_back(summarize(ul_res[cc]));
+    }
+
+    sf_output_res_t sf_out{get_cell_params(), tti_rx, ul_res, dl_res};
+    update(sf_out);
+    return SRSRAN_SUCCESS;
+  }
+
+  void set_external_tti_events(const sim_ue_ctxt_t& ue_ctxt, ue_tti_events& pending_events) override
+  {
+    if (ue_ctxt.conres_rx) {
+      // Traffic that varies with the TTI and the UE
+      uint32_t load = (get_tti_rx().to_uint() * ue_ctxt.rnti) % 5000;
+      sched_ptr->ul_bsr(ue_ctxt.rnti, 1, load);
+      sched_ptr->dl_rlc_buffer_state(ue_ctxt.rnti, 3, 2 * load, 0);
+      if (get_tti_rx().to_uint() % 5 == 0) {
+        for (auto& cc : pending_events.cc_list) {
+          cc.dl_cqi = 5 + load % 11;
+          cc.ul_snr = 10 + load % 30;
+        }
+      }
+    }
+  }
+
+  sched*                       sched_ptr;
+  std::vector<sched_summary_t> dl_results, ul_results;
+};
+
+/// Records a simulated run of the scheduler and checks that its replay generates the same scheduling decisions
+int test_sched_trace_replay()
+{
+  std::vector<sched_interface::cell_cfg_t> cell_list(1, generate_default_cell_cfg(25));
+  sched_interface::ue_cfg_t                ue_cfg_default = generate_default_ue_cfg();
+  sched_interface::sched_args_t            sched_args     = {};
+  sched_args.trace_filename                               = trace_filename;
+
+  std::vector<sched_summary_t> dl_results, ul_results;
+  {
+    sched     sched_obj;
+    rrc_dummy rrc{};
+    sched_obj.init(&rrc, sched_args);
+    trace_sched_tester tester(&sched_obj, sched_args, cell_list);
+
+    for (uint32_t ue_idx = 0; ue_idx < 4; ++ue_idx) {
+      while (not srsran_prach_tti_opportunity_config_fdd(
+          tester.get_cell_params()[0].cfg.prach_config, tester.get_tti_rx().to_uint(), -1)) {
+        TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+      }
+      TESTASSERT(tester.add_user(0x46 + ue_idx, ue_cfg_default, 16 + ue_idx) == SRSRAN_SUCCESS);
+      TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+    }
+    for (uint32_t count = 0; count < 1000; ++count) {
+      TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+    }
+    TESTASSERT(tester.rem_user(0x46) == SRSRAN_SUCCESS);
+    for (uint32_t count = 0; count < 20; ++count) {
+      TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+    }
+    dl_results = tester.dl_results;
+    ul_results = tester.ul_results;
+  }
+
+  // TEST: The trace stores the scheduler arguments
+  sched_trace_reader            reader;
+  sched_interface::sched_args_t replay_args;
+  TESTASSERT(reader.open(trace_filename, replay_args));
+  TESTASSERT(replay_args.sched_policy == sched_args.sched_policy);
+  TESTASSERT(replay_args.trace_filename.empty());
+  TESTASSERT(reader.nof_events() > dl_results.size() + ul_results.size());
+
+  // TEST: The replay generates the same decisions. The second run checks the trace rewind
+  for (uint32_t run = 0; run < 2; ++run) {
+    sched     sched_obj;
+    rrc_dummy rrc{};
+    sched_obj.init(&rrc, replay_args);
+    reader.rewind();
+
+    size_t              dl_count = 0, ul_count = 0;
+    sched_trace_event_t ev;
+    tti_point           tti_rx;
+    while (reader.replay_next(sched_obj, ev, tti_rx)) {
+      if (ev == sched_trace_event_t::dl_sched) {
+        TESTASSERT(dl_count < dl_results.size());
+        TESTASSERT(summarize(reader.last_dl_result()) == dl_results[dl_count++]);
+      } else if (ev == sched_trace_event_t::ul_sched) {
+        TESTASSERT(ul_count < ul_results.size());
+        TESTASSERT(summarize(reader.last_ul_result()) == ul_results[ul_count++]);
+      }
+    }
+    TESTASSERT(dl_count == dl_results.size() and ul_count == ul_results.size());
+  }
+
+  remove(trace_filename);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main()
+{
+  auto& mac_log = srslog::fetch_basic_logger("MAC");
+  mac_log.set_level(srslog::basic_levels::warning);
+  auto& test_log = srslog::fetch_basic_logger("TEST", false);
+  test_log.set_level(srslog::basic_levels::warning);
+
+  // Start the log backend.
+  srslog::init();
+
+  TESTASSERT(srsenb::test_sched_trace_replay() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return 0;
+}
@@ -135,6 +135,39 @@ void test_interferer_subband_cqi_scenario()
   TESTASSERT(grant_mask == test_mask);
 }
 
+/**
+ * Test scenario where the MCS limits of the scheduler args change while the UE is configured, as done by the
+ * scheduler when the tunables are set at runtime.
+ * - The new limits apply without reconfiguring the UE, the UE capabilities still limit the MCS.
+ */
+void test_max_mcs_update()
+{
+  sched_interface::cell_cfg_t cell_cfg    = generate_default_cell_cfg(50);
+  cell_cfg.enable_64qam                   = false;
+  sched_interface::sched_args_t sched_cfg = {};
+  sched_cell_params_t           cell_params;
+  cell_params.set_cfg(0, cell_cfg, sched_cfg);
+  sched_interface::ue_cfg_t ue_cfg = generate_default_ue_cfg();
+  ue_cfg.use_tbs_index_alt         = false;
+
+  sched_ue_cell ue_cc(0x46, cell_params, tti_point(0));
+  ue_cc.set_ue_cfg(ue_cfg);
+  TESTASSERT(ue_cc.max_mcs_dl == 28);
+  TESTASSERT(ue_cc.max_mcs_ul == 28);
+
+  sched_cfg.pdsch_max_mcs = 10;
+  sched_cfg.pusch_max_mcs = 12;
+  ue_cc.update_max_mcs();
+  TESTASSERT(ue_cc.max_mcs_dl == 10);
+  TESTASSERT(ue_cc.max_mcs_ul == 12);
+
+  // -1 removes the limit
+  sched_cfg.pdsch_max_mcs  = -1;
+  ue_cfg.use_tbs_index_alt = true;
+  ue_cc.update_max_mcs();
+  TESTASSERT(ue_cc.max_mcs_dl == 27);
+}
+
 int main()
 {
   srsenb::set_randseed(seed);
@@ -148,6 +181,7 @@ int main()
 
   test_neg_phr_scenario();
   test_interferer_subband_cqi_scenario();
+  test_max_mcs_update();
 
   srslog::flush();
 
@@ -24,7 +24,9 @@
 #include "srsenb/test/common/dummy_classes.h"
 #include "srsran/asn1/rrc_utils.h"
 #include "srsran/common/test_common.h"
+#include "srsran/common/thread_pool.h"
 #include "test_helpers.h"
+#include <chrono>
 #include <iostream>
 
 using namespace asn1::rrc;
@@ -567,6 +569,66 @@ int test_intraenb_mobility(srsran::log_sink_spy& spy, test_event test_params)
   return SRSRAN_SUCCESS;
 }
 
+/// Intra-eNB handover storm, all the UEs send a MeasReport in the same TTI. Returns the time taken to handle them,
+/// with the UL messages decoded in the stack thread if ue_pool is nullptr, or in parallel across UEs otherwise
+int run_ho_storm(uint32_t nof_ues, srsran::task_thread_pool* ue_pool, std::chrono::microseconds& t)
+{
+  intraenb_mobility_tester tester{test_event::success};
+  TESTASSERT(tester.generate_rrc_cfg() == SRSRAN_SUCCESS);
+  TESTASSERT(tester.rrc.init(tester.cfg,
+                             &tester.phy,
+                             &tester.mac,
+                             &tester.rlc,
+                             &tester.pdcp,
+                             &tester.s1ap,
+                             &tester.gtpu,
+                             nullptr,
+                             ue_pool) == SRSRAN_SUCCESS);
+  tester.logger.set_level(srslog::basic_levels::none);
+
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    uint16_t                  rnti = tester.rnti + i;
+    sched_interface::ue_cfg_t ue_cfg{};
+    ue_cfg.supported_cc_list.resize(1);
+    ue_cfg.supported_cc_list[0].enb_cc_idx = 0;
+    ue_cfg.supported_cc_list[0].active     = true;
+    tester.rrc.add_user(rnti, ue_cfg);
+    test_helpers::bring_rrc_to_reconf_state(tester.rrc, *tester.task_sched.get_timer_handler(), rnti);
+  }
+
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    srsran::unique_byte_buffer_t pdu;
+    uint8_t                      meas_report[] = {0x08, 0x10, 0x38, 0x74, 0x00, 0x09, 0xBC, 0x80}; // PCI == 2
+    copy_msg_to_buffer(pdu, meas_report);
+    tester.rrc.write_pdu(tester.rnti + i, 1, std::move(pdu));
+  }
+  auto tp = std::chrono::high_resolution_clock::now();
+  tester.tic();
+  t = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - tp);
+
+  // All the UEs were sent the HandoverCommand
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    auto& ue_cfg = tester.mac.ue_db[tester.rnti + i];
+    TESTASSERT(ue_cfg.ue_bearers[srb_to_lcid(lte_srb::srb1)].direction == srsenb::mac_lc_ch_cfg_t::DL);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_ho_storm(uint32_t nof_ues)
+{
+  printf("\n===== TEST: test_ho_storm() with %u UEs =====\n", nof_ues);
+  srsran::task_thread_pool  ue_pool(3);
+  std::chrono::microseconds t_stack, t_pool;
+  TESTASSERT(run_ho_storm(nof_ues, nullptr, t_stack) == SRSRAN_SUCCESS);
+  TESTASSERT(run_ho_storm(nof_ues, &ue_pool, t_pool) == SRSRAN_SUCCESS);
+  printf("HO storm: stack thread=%ld usec, stack thread + %zu UE threads=%ld usec\n",
+         (long)t_stack.count(),
+         ue_pool.nof_workers(),
+         (long)t_pool.count());
+  ue_pool.stop();
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   // Setup the log spy to intercept error and warning log entries.
@@ -610,6 +672,9 @@ int main(int argc, char** argv)
   TESTASSERT(test_intraenb_mobility(*spy, test_event::duplicate_crnti_ce) == 0);
   TESTASSERT(test_intraenb_mobility(*spy, test_event::success) == 0);
 
+  // Handover storm
+  TESTASSERT(test_ho_storm(32) == 0);
+
   srslog::flush();
 
   printf("\nSuccess\n");
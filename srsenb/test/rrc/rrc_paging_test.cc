@@ -21,6 +21,7 @@
 
 #include "srsenb/hdr/stack/rrc/rrc_paging.h"
 #include "srsran/common/test_common.h"
+#include <chrono>
 
 using namespace srsenb;
 
@@ -51,7 +52,114 @@ void test_paging()
   }
 }
 
-int main()
+/// The PCCH PDU built by appending the paging records matches the packing of the whole PCCH message
+void test_paging_pdu_append()
+{
+  unsigned       paging_cycle = 32;
+  paging_manager pcch_manager{paging_cycle, 1};
+
+  // UE IDs with the same paging occasion, with IMSI and S-TMSI records of different lengths
+  uint8_t  imsi[]   = {0, 0, 1, 0, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1, 2, 3, 4, 5, 6};
+  uint8_t  m_tmsi[] = {0x64, 0x04, 0x00, 0x02};
+  unsigned ue_id    = 4780;
+  for (unsigned i = 0; i < ASN1_RRC_MAX_PAGE_REC; ++i) {
+    if (i % 3 == 0) {
+      TESTASSERT(pcch_manager.add_imsi_paging(ue_id + i * 1024, srsran::const_byte_span{imsi, 6 + i}));
+    } else {
+      TESTASSERT(pcch_manager.add_tmsi_paging(ue_id + i * 1024, i, m_tmsi));
+    }
+  }
+  TESTASSERT(not pcch_manager.add_tmsi_paging(ue_id, 1, m_tmsi));
+
+  // Paging frame of the UE IDs (N == T) and paging occasion for i_s == 0
+  tti_point t{10 * ((ue_id % 1024) % paging_cycle) + 9};
+  TESTASSERT(pcch_manager.pending_pcch_bytes(t) > 0);
+  bool read = pcch_manager.read_pdu_pcch(t, [](srsran::const_byte_span pdu, const asn1::rrc::pcch_msg_s& msg, bool) {
+    TESTASSERT_EQ(ASN1_RRC_MAX_PAGE_REC, msg.msg.c1().paging().paging_record_list.size());
+    uint8_t       buf[256];
+    asn1::bit_ref bref(buf, sizeof(buf));
+    TESTASSERT(msg.pack(bref) == asn1::SRSASN_SUCCESS);
+    TESTASSERT_EQ((size_t)bref.distance_bytes(), pdu.size());
+    TESTASSERT(std::equal(pdu.begin(), pdu.end(), buf));
+    return true;
+  });
+  TESTASSERT(read);
+}
+
+/// Every UE identity index is paged in its Paging Frame and Paging Occasion, for different nB
+void test_paging_occasions(unsigned paging_cycle, float nb)
+{
+  paging_manager pcch_manager{paging_cycle, nb};
+
+  // \remark: See TS 36.304, section 7.1 and 7.2.
+  const unsigned po_sf_idx[3][4] = {{9}, {4, 9}, {0, 4, 5, 9}};
+  unsigned       N               = std::min(paging_cycle, (unsigned)(nb * paging_cycle));
+  unsigned       Ns              = std::max(1, (int)nb);
+
+  // The M-TMSI of the paging records carries the UE identity index
+  for (unsigned ue_id = 0; ue_id < 1024; ++ue_id) {
+    uint8_t m_tmsi[] = {0, 0, (uint8_t)(ue_id >> 8u), (uint8_t)ue_id};
+    TESTASSERT(pcch_manager.add_tmsi_paging(ue_id, 1, m_tmsi));
+  }
+
+  unsigned  nof_records = 0;
+  tti_point t{0};
+  for (unsigned count = 0; count < 10 * paging_cycle; ++count, ++t) {
+    if (pcch_manager.pending_pcch_bytes(t) == 0) {
+      continue;
+    }
+    pcch_manager.read_pdu_pcch(t, [&](srsran::const_byte_span, const asn1::rrc::pcch_msg_s& msg, bool) {
+      for (const asn1::rrc::paging_record_s& rec : msg.msg.c1().paging().paging_record_list) {
+        unsigned ue_id = rec.ue_id.s_tmsi().m_tmsi.to_number();
+        TESTASSERT_EQ((paging_cycle / N) * (ue_id % N), t.sfn() % paging_cycle);
+        TESTASSERT_EQ(po_sf_idx[Ns / 2][(ue_id / N) % Ns], t.sf_idx());
+        nof_records++;
+      }
+      return true;
+    });
+  }
+  TESTASSERT_EQ(1024, nof_records);
+}
+
+/// Measures the rate at which paging records are added and their PCCH messages read
+void test_paging_throughput(unsigned nof_cycles)
+{
+  unsigned       paging_cycle = 128;
+  paging_manager pcch_manager{paging_cycle, 1};
+  uint8_t        m_tmsi[] = {0x64, 0x04, 0x00, 0x02};
+
+  unsigned nof_records = 0;
+  auto     tic         = std::chrono::steady_clock::now();
+  for (unsigned cycle = 0; cycle < nof_cycles; ++cycle) {
+    for (unsigned ue_id = 0; ue_id < 1024 * ASN1_RRC_MAX_PAGE_REC / 8; ++ue_id) {
+      nof_records += pcch_manager.add_tmsi_paging(ue_id, ue_id % 256, m_tmsi) ? 1 : 0;
+    }
+    // Transmit the whole paging cycle, which clears the PCCH messages
+    tti_point t{10 * paging_cycle * cycle};
+    for (unsigned count = 0; count < 10 * paging_cycle + 10; ++count, ++t) {
+      if (pcch_manager.pending_pcch_bytes(t) > 0) {
+        pcch_manager.read_pdu_pcch(t, [](srsran::const_byte_span, const asn1::rrc::pcch_msg_s&, bool) { return true; });
+      }
+    }
+  }
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tic).count();
+  fmt::print("Paging throughput: {} records in {} us, {:.1f} records/ms\n",
+             nof_records,
+             us,
+             nof_records * 1000.0 / std::max<int64_t>(us, 1));
+  TESTASSERT(nof_records > 0);
+}
+
+int main(int argc, char** argv)
 {
   test_paging();
+  test_paging_pdu_append();
+  test_paging_occasions(128, 1);
+  test_paging_occasions(32, 2);
+  test_paging_occasions(64, 4);
+  test_paging_occasions(256, 0.5);
+  // Throughput mode: rrc_paging_test <nof paging cycles>
+  if (argc > 1) {
+    test_paging_throughput(std::strtoul(argv[1], nullptr, 10));
+  }
 }
\ No newline at end of file
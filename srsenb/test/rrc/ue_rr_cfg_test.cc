@@ -0,0 +1,113 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/rrc/ue_rr_cfg.h"
+#include "srsran/common/test_common.h"
+#include <random>
+
+using namespace asn1::rrc;
+
+static std::mt19937 rand_gen(0);
+
+dl_ccch_msg_s make_conn_setup(bool cqi_periodic)
+{
+  dl_ccch_msg_s            msg;
+  rrc_conn_setup_s&        setup  = msg.msg.set_c1().set_rrc_conn_setup();
+  rrc_conn_setup_r8_ies_s& r8     = setup.crit_exts.set_c1().set_rrc_conn_setup_r8();
+  rr_cfg_ded_s&            rr_cfg = r8.rr_cfg_ded;
+
+  rr_cfg.srb_to_add_mod_list_present = true;
+  rr_cfg.srb_to_add_mod_list.resize(1);
+  rr_cfg.srb_to_add_mod_list[0].srb_id            = 1;
+  rr_cfg.srb_to_add_mod_list[0].lc_ch_cfg_present = true;
+  rr_cfg.srb_to_add_mod_list[0].lc_ch_cfg.set_default_value();
+  rr_cfg.srb_to_add_mod_list[0].rlc_cfg_present = true;
+  rr_cfg.srb_to_add_mod_list[0].rlc_cfg.set_default_value();
+  rr_cfg.mac_main_cfg_present = true;
+  rr_cfg.mac_main_cfg.set_explicit_value().time_align_timer_ded.value = time_align_timer_opts::infinity;
+
+  rr_cfg.phys_cfg_ded_present       = true;
+  phys_cfg_ded_s& phy_cfg           = rr_cfg.phys_cfg_ded;
+  phy_cfg.sched_request_cfg_present = true;
+  phy_cfg.sched_request_cfg.set_setup().dsr_trans_max.value = sched_request_cfg_c::setup_s_::dsr_trans_max_opts::n64;
+  phy_cfg.cqi_report_cfg_present                            = true;
+  if (cqi_periodic) {
+    phy_cfg.cqi_report_cfg.cqi_report_periodic_present = true;
+    auto& cqi = phy_cfg.cqi_report_cfg.cqi_report_periodic.set_setup();
+    cqi.cqi_format_ind_periodic.set_wideband_cqi();
+    cqi.simul_ack_nack_and_cqi = true;
+  } else {
+    phy_cfg.cqi_report_cfg.cqi_report_mode_aperiodic_present = true;
+    phy_cfg.cqi_report_cfg.cqi_report_mode_aperiodic.value   = cqi_report_mode_aperiodic_opts::rm30;
+  }
+  return msg;
+}
+
+void randomize_ue_fields(dl_ccch_msg_s& msg)
+{
+  rrc_conn_setup_s& setup   = msg.msg.c1().rrc_conn_setup();
+  phys_cfg_ded_s&   phy_cfg = setup.crit_exts.c1().rrc_conn_setup_r8().rr_cfg_ded.phys_cfg_ded;
+
+  setup.rrc_transaction_id                           = rand_gen() % 4;
+  phy_cfg.sched_request_cfg.setup().sr_pucch_res_idx = rand_gen() % 2048;
+  phy_cfg.sched_request_cfg.setup().sr_cfg_idx       = rand_gen() % 158;
+  if (phy_cfg.cqi_report_cfg.cqi_report_periodic_present) {
+    phy_cfg.cqi_report_cfg.cqi_report_periodic.setup().cqi_pucch_res_idx = rand_gen() % 1186;
+    phy_cfg.cqi_report_cfg.cqi_report_periodic.setup().cqi_pmi_cfg_idx   = rand_gen() % 1024;
+  }
+}
+
+/// The RRCConnectionSetups packed from the template are equal to the packed messages
+void test_conn_setup_template(bool cqi_periodic)
+{
+  srsenb::rrc_conn_setup_template tmpl;
+  dl_ccch_msg_s                   msg = make_conn_setup(cqi_periodic);
+  for (uint32_t i = 0; i < 1000; ++i) {
+    randomize_ue_fields(msg);
+
+    srsran::byte_buffer_t pdu;
+    TESTASSERT(tmpl.pack(msg, pdu));
+
+    uint8_t       buffer[256];
+    asn1::bit_ref bref(buffer, sizeof(buffer));
+    TESTASSERT(msg.pack(bref) == asn1::SRSASN_SUCCESS);
+    TESTASSERT_EQ((uint32_t)bref.distance_bytes(), pdu.N_bytes);
+    TESTASSERT(std::equal(pdu.begin(), pdu.end(), buffer));
+  }
+
+  // Messages with a different structure are not packed from the template
+  dl_ccch_msg_s         other = make_conn_setup(not cqi_periodic);
+  srsran::byte_buffer_t pdu;
+  TESTASSERT(not tmpl.pack(other, pdu));
+  other.msg.set_c1().set_rrc_conn_reject();
+  TESTASSERT(not tmpl.pack(other, pdu));
+}
+
+int main()
+{
+  srslog::init();
+
+  test_conn_setup_template(true);
+  test_conn_setup_template(false);
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
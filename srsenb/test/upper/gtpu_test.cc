@@ -44,6 +44,7 @@ public:
     last_pdcp_sn       = pdcp_sn;
     last_rnti          = rnti;
     last_eps_bearer_id = eps_bearer_id;
+    sn_history.push_back(pdcp_sn);
   }
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t eps_bearer_id) override
   {
@@ -60,6 +61,7 @@ public:
     last_pdcp_sn       = -1;
     last_eps_bearer_id = 0;
     last_rnti          = SRSRAN_INVALID_RNTI;
+    sn_history.clear();
   }
 
   std::map<uint32_t, srsran::unique_byte_buffer_t> buffered_pdus;
@@ -67,6 +69,7 @@ public:
   int                                              last_pdcp_sn       = -1;
   uint16_t                                         last_rnti          = SRSRAN_INVALID_RNTI;
   uint32_t                                         last_eps_bearer_id = 0;
+  std::vector<int>                                 sn_history;
 };
 
 struct dummy_socket_manager : public srsran::socket_manager_itf {
@@ -157,6 +160,56 @@ srsran::unique_byte_buffer_t read_socket(int fd)
   return pdu;
 }
 
+void test_gtpu_header_template()
+{
+  auto&                          logger = srslog::fetch_basic_logger("GTPU");
+  srsran::gtpu_header_template_t hdr_template;
+  srsran::gtpu_set_header_template(hdr_template, 0x12345678);
+
+  for (int pdcp_sn : {-1, 0, 0x1234, 0xffff}) {
+    std::array<uint8_t, 100> payload;
+    std::iota(payload.begin(), payload.end(), 0);
+
+    // Reference header
+    srsran::unique_byte_buffer_t ref_pdu = srsran::make_byte_buffer();
+    ref_pdu->append_bytes(payload.data(), payload.size());
+    srsran::gtpu_header_t header = {};
+    header.flags                 = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
+    header.message_type          = GTPU_MSG_DATA_PDU;
+    header.length                = ref_pdu->N_bytes;
+    header.teid                  = 0x12345678;
+    if (pdcp_sn >= 0) {
+      header.flags |= GTPU_FLAGS_EXTENDED_HDR;
+      header.next_ext_hdr_type = GTPU_EXT_HEADER_PDCP_PDU_NUMBER;
+      header.ext_buffer        = {0x01u, (uint8_t)(pdcp_sn >> 8u), (uint8_t)pdcp_sn, 0};
+    }
+    TESTASSERT(gtpu_write_header(&header, ref_pdu.get(), logger));
+
+    // Header written from the template
+    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+    pdu->append_bytes(payload.data(), payload.size());
+    TESTASSERT(gtpu_write_header(hdr_template, pdu.get(), pdcp_sn));
+    TESTASSERT(pdu->N_bytes == ref_pdu->N_bytes);
+    TESTASSERT(memcmp(pdu->msg, ref_pdu->msg, pdu->N_bytes) == 0);
+
+    // The template PDU is parsed back
+    srsran::gtpu_header_t rx_header;
+    TESTASSERT(gtpu_read_header(pdu.get(), &rx_header, logger));
+    TESTASSERT(rx_header.teid == 0x12345678);
+    TESTASSERT(pdu->N_bytes == payload.size());
+    if (pdcp_sn >= 0) {
+      TESTASSERT(rx_header.ext_buffer.size() == 4);
+      TESTASSERT(((rx_header.ext_buffer[1] << 8u) | rx_header.ext_buffer[2]) == pdcp_sn);
+    }
+  }
+
+  // Not enough headroom
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  pdu->msg -= pdu->get_headroom() - GTPU_BASE_HEADER_LEN;
+  TESTASSERT(not gtpu_write_header(hdr_template, pdu.get(), 5));
+  TESTASSERT(gtpu_write_header(hdr_template, pdu.get(), -1));
+}
+
 void test_gtpu_tunnel_manager()
 {
   const char*        sgw_addr_str = "127.0.0.1";
@@ -215,6 +268,47 @@ void test_gtpu_tunnel_manager()
   TESTASSERT(after_tun->state == gtpu_tunnel_manager::tunnel_state::pdcp_active);
 }
 
+void test_gtpu_buffer_replay()
+{
+  const char*        sgw_addr_str = "127.0.0.1";
+  struct sockaddr_in sgw_sockaddr = {};
+  srsran::net_utils::set_sockaddr(&sgw_sockaddr, sgw_addr_str, GTPU_PORT);
+  uint32_t               sgw_addr           = ntohl(sgw_sockaddr.sin_addr.s_addr);
+  const uint32_t         drb1_eps_bearer_id = 5;
+  const uint32_t         nof_sdus           = 300;
+  srsran::task_scheduler task_sched;
+  gtpu_args_t            gtpu_args = {};
+  pdcp_tester            pdcp;
+
+  gtpu_tunnel_manager tunnels(&task_sched, srslog::fetch_basic_logger("GTPU"), srsran::srsran_rat_t::lte);
+  tunnels.init(gtpu_args, &pdcp);
+
+  const gtpu_tunnel* before_tun = tunnels.add_tunnel(0x46, drb1_eps_bearer_id, 7, sgw_addr);
+  const gtpu_tunnel* after_tun  = tunnels.add_tunnel(0x46, drb1_eps_bearer_id, 8, sgw_addr);
+  TESTASSERT(before_tun != nullptr and after_tun != nullptr);
+  uint32_t after_teid = after_tun->teid_in;
+  tunnels.set_tunnel_priority(before_tun->teid_in, after_teid);
+
+  // SDUs forwarded out of order are buffered sorted by PDCP SN
+  for (uint32_t i = 0; i < nof_sdus; ++i) {
+    tunnels.buffer_pdcp_sdu(after_teid, i ^ 1U, srsran::make_byte_buffer());
+  }
+
+  // The buffer is flushed over several ticks, and the SDUs received meanwhile are written after the buffered ones
+  tunnels.remove_tunnel(before_tun->teid_in);
+  TESTASSERT(not pdcp.sn_history.empty() and pdcp.sn_history.size() < nof_sdus);
+  TESTASSERT(after_tun->state == gtpu_tunnel_manager::tunnel_state::buffering);
+  tunnels.buffer_pdcp_sdu(after_teid, nof_sdus, srsran::make_byte_buffer());
+  for (uint32_t i = 0; i < nof_sdus and after_tun->state != gtpu_tunnel_manager::tunnel_state::pdcp_active; ++i) {
+    task_sched.tic();
+  }
+  TESTASSERT(after_tun->state == gtpu_tunnel_manager::tunnel_state::pdcp_active);
+  TESTASSERT(pdcp.sn_history.size() == nof_sdus + 1);
+  for (uint32_t i = 0; i < pdcp.sn_history.size(); ++i) {
+    TESTASSERT(pdcp.sn_history[i] == (int)i);
+  }
+}
+
 enum class tunnel_test_event { success, wait_end_marker_timeout, ue_removal_no_marker, reest_senb };
 
 int test_gtpu_direct_tunneling(tunnel_test_event event)
@@ -254,6 +348,11 @@ int test_gtpu_direct_tunneling(tunnel_test_event event)
   senb_gtpu.init(gtpu_args, &senb_pdcp);
   gtpu_args.gtp_bind_addr = tenb_addr_str;
   tenb_gtpu.init(gtpu_args, &tenb_pdcp);
+  // The G-PDUs are sent at the end of the current stack task
+  auto read_tx_pdu = [&task_sched](int fd) {
+    task_sched.run_pending_tasks();
+    return read_socket(fd);
+  };
   uint32_t addr_in1;
   uint32_t addr_in2;
   // create tunnels MME-SeNB and MME-TeNB
@@ -285,9 +384,9 @@ int test_gtpu_direct_tunneling(tunnel_test_event event)
   srsran::span<uint8_t> pdu_view{};
 
   // TEST: GTPU buffers incoming PDCP buffered SNs until the TEID is explicitly activated
-  tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(tenb_rx_sockets.s1u_fd), senb_sockaddr);
+  tenb_gtpu.handle_gtpu_s1u_rx_packet(read_tx_pdu(tenb_rx_sockets.s1u_fd), senb_sockaddr);
   TESTASSERT(tenb_pdcp.last_sdu == nullptr);
-  tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(tenb_rx_sockets.s1u_fd), senb_sockaddr);
+  tenb_gtpu.handle_gtpu_s1u_rx_packet(read_tx_pdu(tenb_rx_sockets.s1u_fd), senb_sockaddr);
   TESTASSERT(tenb_pdcp.last_sdu == nullptr);
   tenb_gtpu.set_tunnel_status(dl_tenb_teid_in, true);
   pdu_view = srsran::make_span(tenb_pdcp.last_sdu);
@@ -298,7 +397,7 @@ int test_gtpu_direct_tunneling(tunnel_test_event event)
 
   // TEST: verify that PDCP buffered SNs have been forwarded through SeNB->TeNB tunnel
   for (size_t sn = 8; sn < 10; ++sn) {
-    tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(tenb_rx_sockets.s1u_fd), senb_sockaddr);
+    tenb_gtpu.handle_gtpu_s1u_rx_packet(read_tx_pdu(tenb_rx_sockets.s1u_fd), senb_sockaddr);
     pdu_view = srsran::make_span(tenb_pdcp.last_sdu);
     TESTASSERT(std::count(pdu_view.begin() + PDU_HEADER_SIZE, pdu_view.end(), sn) == 10);
     TESTASSERT(tenb_pdcp.last_rnti == rnti2);
@@ -311,7 +410,7 @@ int test_gtpu_direct_tunneling(tunnel_test_event event)
   pdu = encode_gtpu_packet(data_vec, senb_teid_in, sgw_sockaddr, senb_sockaddr);
   encoded_data.assign(pdu->msg + 8u, pdu->msg + pdu->N_bytes);
   senb_gtpu.handle_gtpu_s1u_rx_packet(std::move(pdu), sgw_sockaddr);
-  tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(tenb_rx_sockets.s1u_fd), senb_sockaddr);
+  tenb_gtpu.handle_gtpu_s1u_rx_packet(read_tx_pdu(tenb_rx_sockets.s1u_fd), senb_sockaddr);
   pdu_view = srsran::make_span(tenb_pdcp.last_sdu);
   TESTASSERT(pdu_view.size() == encoded_data.size() and
              std::equal(pdu_view.begin(), pdu_view.end(), encoded_data.begin()));
@@ -333,7 +432,7 @@ int test_gtpu_direct_tunneling(tunnel_test_event event)
   pdu = encode_gtpu_packet(data_vec, senb_teid_in, sgw_sockaddr, senb_sockaddr);
   encoded_data.assign(pdu->msg + 8u, pdu->msg + pdu->N_bytes);
   senb_gtpu.handle_gtpu_s1u_rx_packet(std::move(pdu), sgw_sockaddr);
-  tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(tenb_rx_sockets.s1u_fd), senb_sockaddr);
+  tenb_gtpu.handle_gtpu_s1u_rx_packet(read_tx_pdu(tenb_rx_sockets.s1u_fd), senb_sockaddr);
   TESTASSERT(tenb_pdcp.last_sdu->N_bytes == encoded_data.size() and
              memcmp(tenb_pdcp.last_sdu->msg, encoded_data.data(), encoded_data.size()) == 0);
   tenb_pdcp.clear();
@@ -348,7 +447,7 @@ int test_gtpu_direct_tunneling(tunnel_test_event event)
     // TEST: EndMarker may even reach SeNB, but the SeNB receives in tandem the UEContextReleaseCommand and closes
     //       the user tunnels before the chance to send an EndMarker
     senb_gtpu.rem_user(0x46);
-    tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(tenb_rx_sockets.s1u_fd), senb_sockaddr);
+    tenb_gtpu.handle_gtpu_s1u_rx_packet(read_tx_pdu(tenb_rx_sockets.s1u_fd), senb_sockaddr);
   } else if (event == tunnel_test_event::reest_senb) {
     // TEST: UE may start a Reestablishment to the SeNB. In such case, the rnti will be updated, the forwarding tunnel
     //       taken down, and the previous main tunnel reestablished
@@ -367,7 +466,7 @@ int test_gtpu_direct_tunneling(tunnel_test_event event)
     // TEST: EndMarker is forwarded via MME->SeNB->TeNB, and TeNB buffered PDUs are flushed
     pdu = encode_end_marker(senb_teid_in);
     senb_gtpu.handle_gtpu_s1u_rx_packet(std::move(pdu), sgw_sockaddr);
-    tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(tenb_rx_sockets.s1u_fd), senb_sockaddr);
+    tenb_gtpu.handle_gtpu_s1u_rx_packet(read_tx_pdu(tenb_rx_sockets.s1u_fd), senb_sockaddr);
   }
   srsran::span<uint8_t> encoded_data2{tenb_pdcp.last_sdu->msg + 20u, tenb_pdcp.last_sdu->msg + 30u};
   TESTASSERT(std::all_of(encoded_data2.begin(), encoded_data2.end(), [N_pdus](uint8_t b) { return b == N_pdus - 1; }));
@@ -394,7 +493,9 @@ int main(int argc, char** argv)
   // Start the log backend.
   srsran::test_init(argc, argv);
 
+  srsenb::test_gtpu_header_template();
   srsenb::test_gtpu_tunnel_manager();
+  srsenb::test_gtpu_buffer_replay();
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::success) == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::wait_end_marker_timeout) == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::ue_removal_no_marker) == SRSRAN_SUCCESS);
@@ -28,6 +28,8 @@
 #ifndef SRSEPC_HSS_H
 #define SRSEPC_HSS_H
 
+#include "srsepc/hdr/hss/hss_db_store.h"
+#include "srsran/adt/flat_hash_map.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/epc_interfaces.h"
@@ -35,43 +37,25 @@
 #include <cstddef>
 
 #include <map>
+#include <mutex>
 
 #define LTE_FDD_ENB_IND_HE_N_BITS 5
 #define LTE_FDD_ENB_IND_HE_MASK 0x1FUL
 #define LTE_FDD_ENB_IND_HE_MAX_VALUE 31
 #define LTE_FDD_ENB_SEQ_HE_MAX_VALUE 0x07FFFFFFFFFFUL
 
+#define HSS_MAX_AUTH_VECTORS 8
+
 namespace srsepc {
 
 struct hss_args_t {
   std::string db_file;
+  std::string db_store;         // Binary database imported from db_file, empty to keep the subscribers in memory only
+  uint32_t    nof_auth_vectors; // Milenage vectors computed per request, the ones not used are kept for the next ones
   uint16_t    mcc;
   uint16_t    mnc;
 };
 
-enum hss_auth_algo { HSS_ALGO_XOR, HSS_ALGO_MILENAGE };
-
-struct hss_ue_ctx_t {
-  // Members
-  std::string        name;
-  uint64_t           imsi;
-  enum hss_auth_algo algo;
-  uint8_t            key[16];
-  bool               op_configured;
-  uint8_t            op[16];
-  uint8_t            opc[16];
-  uint8_t            amf[2];
-  uint8_t            sqn[6];
-  uint16_t           qci;
-  uint8_t            last_rand[16];
-  std::string        static_ip_addr;
-
-  // Helper getters/setters
-  void set_sqn(const uint8_t* sqn_);
-  void set_last_rand(const uint8_t* rand_);
-  void get_last_rand(uint8_t* rand_);
-};
-
 class hss : public hss_interface_nas
 {
 public:
@@ -92,7 +76,25 @@ private:
   virtual ~hss();
   static hss* m_instance;
 
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> > m_imsi_to_ue_ctx;
+  hss_db_store m_db;
+
+  // Milenage authentication vectors computed ahead of demand, ordered by SQN
+  struct auth_vector_t {
+    uint8_t rand[16];
+    uint8_t xres[8];
+    uint8_t autn[16];
+    uint8_t k_asme[32];
+  };
+  struct auth_vectors_t {
+    uint32_t      nof_vectors;
+    uint32_t      next;
+    auth_vector_t vectors[HSS_MAX_AUTH_VECTORS];
+  };
+  uint32_t                                        m_nof_auth_vectors = 1;
+  std::mutex                                      m_auth_vectors_mutex;
+  srsran::flat_hash_map<uint64_t, auth_vectors_t> m_auth_vectors;
+
+  bool pop_auth_vector(uint64_t imsi, auth_vector_t* av);
 
   void gen_rand(uint8_t rand_[16]);
 
@@ -110,7 +112,8 @@ private:
   void increment_sqn(uint8_t* sqn, uint8_t* next_sqn);
 
   bool          set_auth_algo(std::string auth_algo);
-  bool          read_db_file(std::string db_file);
+  bool          load_db(const hss_args_t* hss_args);
+  bool          read_db_file(std::string db_file, std::vector<hss_ue_ctx_t>& ues);
   bool          write_db_file(std::string db_file);
   hss_ue_ctx_t* get_ue_ctx(uint64_t imsi);
 
@@ -127,19 +130,5 @@ private:
   std::map<std::string, uint64_t> m_ip_to_imsi;
 };
 
-inline void hss_ue_ctx_t::set_sqn(const uint8_t* sqn_)
-{
-  memcpy(sqn, sqn_, 6);
-}
-
-inline void hss_ue_ctx_t::set_last_rand(const uint8_t* last_rand_)
-{
-  memcpy(last_rand, last_rand_, 16);
-}
-
-inline void hss_ue_ctx_t::get_last_rand(uint8_t* last_rand_)
-{
-  memcpy(last_rand_, last_rand, 16);
-}
 } // namespace srsepc
 #endif // SRSEPC_HSS_H
@@ -0,0 +1,127 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        hss_db_store.h
+ * Description: Binary subscriber database of the HSS. The subscriber records
+ *              and an IMSI hash index are memory-mapped from a file, so that
+ *              the startup does not depend on the number of subscribers and
+ *              the SQN updates are written back in place.
+ *****************************************************************************/
+
+#ifndef SRSEPC_HSS_DB_STORE_H
+#define SRSEPC_HSS_DB_STORE_H
+
+#include "srsran/srslog/srslog.h"
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#define HSS_DB_NAME_LEN 64
+
+namespace srsepc {
+
+struct hss_db_header_t;
+
+enum hss_auth_algo : uint8_t { HSS_ALGO_XOR, HSS_ALGO_MILENAGE };
+
+// Subscriber record, stored as is in the database file
+struct hss_ue_ctx_t {
+  // Members
+  char               name[HSS_DB_NAME_LEN];
+  uint64_t           imsi;
+  uint8_t            key[16];
+  uint8_t            op[16];
+  uint8_t            opc[16];
+  uint8_t            last_rand[16];
+  uint8_t            amf[2];
+  uint8_t            sqn[6];
+  uint16_t           qci;
+  enum hss_auth_algo algo;
+  bool               op_configured;
+  uint32_t           static_ip_addr; // In network byte order, 0 for a dynamic IP
+
+  // Helper getters/setters
+  void set_sqn(const uint8_t* sqn_);
+  void set_last_rand(const uint8_t* rand_);
+  void get_last_rand(uint8_t* rand_);
+};
+
+class hss_db_store
+{
+public:
+  hss_db_store() = default;
+  ~hss_db_store() { close(); }
+  hss_db_store(const hss_db_store&) = delete;
+  hss_db_store& operator=(const hss_db_store&) = delete;
+
+  // Maps an existing database file. Returns false if it does not exist or is not valid
+  bool open(const std::string& filename);
+  // Builds the database from the records, replacing the file atomically. The database is kept in memory only if the
+  // filename is empty. Duplicated IMSIs are dropped
+  bool create(const std::string& filename, const std::vector<hss_ue_ctx_t>& ues);
+  // Flushes the record updates to the file
+  void sync();
+  void close();
+
+  bool     is_open() const { return m_header != nullptr; }
+  bool     is_persistent() const { return m_fd >= 0; }
+  uint32_t size() const;
+  uint32_t nof_static_ips() const;
+
+  hss_ue_ctx_t* find(uint64_t imsi);
+  hss_ue_ctx_t* begin() { return m_records; }
+  hss_ue_ctx_t* end() { return m_records + size(); }
+
+private:
+  bool     map(size_t len, int fd);
+  uint32_t get_index_pos(uint64_t imsi) const;
+
+  int              m_fd       = -1;
+  void*            m_map      = nullptr;
+  size_t           m_map_len  = 0;
+  hss_db_header_t* m_header   = nullptr;
+  hss_ue_ctx_t*    m_records  = nullptr;
+  uint32_t*        m_index    = nullptr; // Record position + 1, 0 for an empty slot
+  uint32_t         m_idx_mask = 0;
+  uint32_t         m_idx_bits = 0;
+
+  srslog::basic_logger& m_logger = srslog::fetch_basic_logger("HSS");
+};
+
+inline void hss_ue_ctx_t::set_sqn(const uint8_t* sqn_)
+{
+  memcpy(sqn, sqn_, 6);
+}
+
+inline void hss_ue_ctx_t::set_last_rand(const uint8_t* last_rand_)
+{
+  memcpy(last_rand, last_rand_, 16);
+}
+
+inline void hss_ue_ctx_t::get_last_rand(uint8_t* last_rand_)
+{
+  memcpy(last_rand_, last_rand, 16);
+}
+
+} // namespace srsepc
+#endif // SRSEPC_HSS_DB_STORE_H
@@ -33,12 +33,23 @@
 #include "srsran/common/threads.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
+#include "srsran/upper/gtpu.h"
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <sys/socket.h>
+#include <vector>
 
 namespace srsepc {
 
 const uint16_t GTPU_RX_PORT = 2152;
 
+// Maximum number of SGi-mb packets read and forwarded at once
+#define MBMS_GW_MAX_BATCH_SIZE 32
+// Maximum number of M1-U destinations each packet is replicated to
+#define MBMS_GW_MAX_M1U_DESTS 16
+
 typedef struct {
   std::string name;
   std::string sgi_mb_if_name;
@@ -47,8 +58,18 @@ typedef struct {
   std::string m1u_multi_addr;
   std::string m1u_multi_if;
   int         m1u_multi_ttl;
+  uint32_t    metrics_period; // Period of the packet rate logs, in seconds. 0 to disable them
 } mbms_gw_args_t;
 
+typedef struct {
+  uint64_t rx_pkts;
+  uint64_t rx_bytes;
+  uint64_t dropped_pkts;
+  uint64_t tx_pkts;
+  uint64_t tx_bytes;
+  uint64_t tx_errors;
+} mbms_gw_metrics_t;
+
 struct pseudo_hdr {
   uint32_t src_addr;
   uint32_t dst_addr;
@@ -65,6 +86,7 @@ public:
   int             init(mbms_gw_args_t* args);
   void            stop();
   void            run_thread();
+  void            get_metrics(mbms_gw_metrics_t& metrics);
 
 private:
   /* Methods */
@@ -74,8 +96,10 @@ private:
 
   int      init_sgi_mb_if(mbms_gw_args_t* args);
   int      init_m1_u(mbms_gw_args_t* args);
-  void     handle_sgi_md_pdu(srsran::byte_buffer_t* msg);
+  uint32_t read_sgi_mb_batch();
+  void     handle_sgi_mb_batch(uint32_t nof_pkts);
   uint16_t in_cksum(uint16_t* iphdr, int count);
+  void     log_metrics();
 
   /* Members */
   bool                  m_running;
@@ -84,9 +108,28 @@ private:
   bool m_sgi_mb_up;
   int  m_sgi_mb_if;
 
-  bool               m_m1u_up;
-  int                m_m1u;
-  struct sockaddr_in m_m1u_multi_addr;
+  bool                            m_m1u_up;
+  int                             m_m1u;
+  std::vector<struct sockaddr_in> m_m1u_dests;
+  srsran::gtpu_header_template_t  m_gtpu_hdr; // Precomputed G-PDU header, only the length changes
+
+  // Packets of a batch, each one is sent once to every M1-U destination from the same buffer
+  std::array<srsran::unique_byte_buffer_t, MBMS_GW_MAX_BATCH_SIZE>           m_rx_pdus;
+  std::array<struct iovec, MBMS_GW_MAX_BATCH_SIZE>                           m_tx_iovs = {};
+  std::array<struct mmsghdr, MBMS_GW_MAX_BATCH_SIZE * MBMS_GW_MAX_M1U_DESTS> m_tx_msgs = {};
+
+  // Metrics, updated by the MBMS-GW thread
+  struct {
+    std::atomic<uint64_t> rx_pkts{0};
+    std::atomic<uint64_t> rx_bytes{0};
+    std::atomic<uint64_t> dropped_pkts{0};
+    std::atomic<uint64_t> tx_pkts{0};
+    std::atomic<uint64_t> tx_bytes{0};
+    std::atomic<uint64_t> tx_errors{0};
+  } m_metrics;
+  uint32_t                              m_metrics_period = 0;
+  mbms_gw_metrics_t                     m_last_metrics   = {};
+  std::chrono::steady_clock::time_point m_last_metrics_tp;
 };
 
 } // namespace srsepc
@@ -33,6 +33,7 @@
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/threads.h"
 #include <cstddef>
+#include <mutex>
 
 namespace srsepc {
 
@@ -74,8 +75,10 @@ private:
   bool   m_running;
   fd_set m_set;
 
-  // Timer map
+  // Timer map, NAS timers are added and removed by the S1AP/NAS workers
+  std::mutex               m_timers_mutex;
   std::vector<mme_timer_t> timers;
+  int                      m_timers_event_fd = -1; // Wakes up the select() when a timer is added
 
   // Timer Methods
   void handle_timer_expire(int timer_fd);
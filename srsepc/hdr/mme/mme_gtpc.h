@@ -24,6 +24,7 @@
 #include "nas.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
+#include <mutex>
 #include <sys/socket.h>
 #include <sys/un.h>
 
@@ -46,7 +47,7 @@ public:
 
   bool init();
   bool send_s11_pdu(const srsran::gtpc_pdu& pdu);
-  void handle_s11_pdu(srsran::byte_buffer_t* msg);
+  void handle_s11_pdu(srsran::unique_byte_buffer_t msg);
 
   virtual bool send_create_session_request(uint64_t imsi);
   bool         handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu);
@@ -66,6 +67,8 @@ private:
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("MME GTPC");
   s1ap*                 m_s1ap;
 
+  // Protects the GTP-C contexts, which are accessed by all the S1AP/NAS workers
+  std::mutex                          m_mutex;
   uint32_t                            m_next_ctrl_teid;
   std::map<uint32_t, uint64_t>        m_mme_ctr_teid_to_imsi;
   std::map<uint64_t, struct gtpc_ctx> m_imsi_to_gtpc_ctx;
@@ -74,6 +77,7 @@ private:
   struct sockaddr_un m_mme_addr, m_spgw_addr;
 
   bool     init_s11();
+  void     handle_gtpc_pdu(srsran::gtpc_pdu* pdu);
   uint32_t get_new_ctrl_teid();
 };
 
@@ -258,6 +258,10 @@ public:
   bool start_timer(enum nas_timer_type type);
   bool expire_timer(enum nas_timer_type type);
 
+  /* UE contexts are allocated from a memory pool, as UEs attach and detach continuously */
+  void* operator new(size_t sz);
+  void  operator delete(void* p);
+
   /* UE Context */
   emm_ctx_t m_emm_ctx                   = {};
   ecm_ctx_t m_ecm_ctx                   = {};
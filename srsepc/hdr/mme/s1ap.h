@@ -29,16 +29,20 @@
 #include "s1ap_nas_transport.h"
 #include "s1ap_paging.h"
 #include "srsepc/hdr/hss/hss.h"
+#include "srsran/adt/flat_hash_map.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/asn1/liblte_mme.h"
 #include "srsran/asn1/s1ap.h"
+#include "srsran/asn1/s1ap_utils.h"
 #include "srsran/common/common.h"
 #include "srsran/common/s1ap_pcap.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include <arpa/inet.h>
 #include <map>
+#include <mutex>
 #include <netinet/sctp.h>
 #include <set>
 #include <strings.h>
@@ -50,11 +54,16 @@ namespace srsepc {
 
 const uint16_t S1MME_PORT = 36412;
 
+// Size of the arena storage of each received PDU, larger PDUs continue in heap chunks
+const size_t S1AP_RX_ARENA_SIZE = 2048;
+
 using s1ap_pdu_t = asn1::s1ap::s1ap_pdu_c;
 
 class s1ap : public s1ap_interface_nas, public s1ap_interface_gtpc, public s1ap_interface_mme
 {
 public:
+  using worker_task_t = srsran::move_callback<void(), srsran::default_move_callback_buffer_size, true>;
+
   static s1ap* get_instance();
   static void  cleanup();
 
@@ -68,6 +77,7 @@ public:
 
   bool s1ap_tx_pdu(const s1ap_pdu_t& pdu, struct sctp_sndrcvinfo* enb_sri);
   void handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri);
+  void handle_s1ap_pdu(const s1ap_pdu_t& rx_pdu, struct sctp_sndrcvinfo* enb_sri);
   void handle_initiating_message(const asn1::s1ap::init_msg_s& msg, struct sctp_sndrcvinfo* enb_sri);
   void handle_successful_outcome(const asn1::s1ap::successful_outcome_s& msg);
 
@@ -96,6 +106,10 @@ public:
   uint32_t         allocate_m_tmsi(uint64_t imsi);
   virtual uint64_t find_imsi_from_m_tmsi(uint32_t m_tmsi);
 
+  // Runs a task of the UE in the worker the UE is assigned to, in order with the other tasks of the UE. Without
+  // workers, the task is run right away
+  void push_ue_task(uint64_t imsi, worker_task_t task);
+
   s1ap_args_t           m_s1ap_args;
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("S1AP");
 
@@ -105,8 +119,11 @@ public:
   s1ap_erab_mngmt_proc* m_s1ap_erab_mngmt_proc;
   s1ap_paging*          m_s1ap_paging;
 
-  std::map<uint32_t, uint64_t>   m_tmsi_to_imsi;
-  std::map<uint16_t, enb_ctx_t*> m_active_enbs;
+  srsran::flat_hash_map<uint32_t, uint64_t> m_tmsi_to_imsi;
+  std::map<uint16_t, enb_ctx_t*>            m_active_enbs;
+
+  // Protects the eNB and UE context tables, which are accessed by all the workers
+  std::mutex m_ctx_mutex;
 
   // Interfaces
   virtual bool send_initial_context_setup_request(uint64_t imsi, uint16_t erab_to_setup);
@@ -136,23 +153,47 @@ private:
 
   uint32_t m_plmn;
 
-  hss_interface_nas*                     m_hss;
-  int                                    m_s1mme;
-  std::map<int32_t, uint16_t>            m_sctp_to_enb_id;
-  std::map<int32_t, std::set<uint32_t> > m_enb_assoc_to_ue_ids;
+  hss_interface_nas*                                             m_hss;
+  int                                                            m_s1mme;
+  std::map<int32_t, uint16_t>                                    m_sctp_to_enb_id;
+  srsran::flat_hash_map<int32_t, srsran::flat_hash_set<uint32_t> > m_enb_assoc_to_ue_ids;
 
-  std::map<uint64_t, nas*> m_imsi_to_nas_ctx;
-  std::map<uint32_t, nas*> m_mme_ue_s1ap_id_to_nas_ctx;
+  srsran::flat_hash_map<uint64_t, nas*> m_imsi_to_nas_ctx;
+  srsran::flat_hash_map<uint32_t, nas*> m_mme_ue_s1ap_id_to_nas_ctx;
 
-  uint32_t m_next_mme_ue_s1ap_id;
   uint32_t m_next_m_tmsi;
 
+  // S1AP/NAS workers. The UEs are assigned to a worker by IMSI. The MME-UE-S1AP-IDs allocated by a worker are equal
+  // to its index modulo the number of workers, so the messages of an S1 connection are processed in the worker that
+  // set it up, which is found by peeking at the MME-UE-S1AP-ID and decodes them. The dynamic fields of the received
+  // PDUs are decoded into an arena stored along with them
+  struct rx_pdu_t {
+    asn1::static_decode_arena<S1AP_RX_ARENA_SIZE> arena;
+    s1ap_pdu_t                                    pdu;
+    struct sctp_sndrcvinfo                        enb_sri;
+  };
+  struct rx_buf_t {
+    srsran::byte_buffer_t  buf;
+    struct sctp_sndrcvinfo enb_sri;
+  };
+  std::vector<std::unique_ptr<srsran::task_worker> > m_workers;
+  std::vector<uint32_t>                              m_next_mme_ue_s1ap_id; // One per worker, only used by the worker
+
+  int      get_rx_pdu_worker(const asn1::s1ap::s1ap_pdu_peek_t& peek);
+  int      get_rx_pdu_worker(const s1ap_pdu_t& rx_pdu, int32_t enb_assoc);
+  void     decode_and_handle_s1ap_pdu(rx_buf_t& rx);
+  uint64_t find_imsi_from_initial_ue_msg(const asn1::s1ap::init_ue_msg_s& init_ue);
+  uint32_t get_imsi_worker(uint64_t imsi) const { return imsi % m_workers.size(); }
+  uint32_t get_mme_ue_s1ap_id_worker(uint32_t mme_ue_s1ap_id) const { return mme_ue_s1ap_id % m_workers.size(); }
+  void     release_ue_ecm_ctx_in_lost_enb(uint32_t mme_ue_s1ap_id);
+
   // GTP-C Interface
   mme_gtpc* m_mme_gtpc;
 
   // PCAP
   bool              m_pcap_enable;
   srsran::s1ap_pcap m_pcap;
+  std::mutex        m_pcap_mutex;
 };
 
 inline uint32_t s1ap::get_plmn()
@@ -53,6 +53,7 @@ typedef struct {
   srsran::INTEGRITY_ALGORITHM_ID_ENUM integrity_algo;
   bool                                request_imeisv;
   uint16_t                            lac;
+  uint32_t                            nof_workers; // S1AP/NAS worker threads, 0 processes in the MME thread
 } s1ap_args_t;
 
 typedef struct {
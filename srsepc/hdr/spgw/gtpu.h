@@ -28,8 +28,13 @@
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
+#include <array>
 #include <cstddef>
+#include <memory>
+#include <mutex>
 #include <queue>
+#include <unordered_map>
+#include <vector>
 
 namespace srsepc {
 
@@ -40,14 +45,18 @@ public:
   virtual ~gtpu();
   int  init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc);
   void stop();
+  void stop_up_workers();
 
-  int init_sgi(spgw_args_t* args);
-  int init_s1u(spgw_args_t* args);
-  int get_sgi();
-  int get_s1u();
+  int  init_sgi(spgw_args_t* args);
+  int  init_s1u(spgw_args_t* args);
+  int  get_sgi();
+  int  get_s1u();
+  bool has_up_workers() const { return not m_up_workers.empty(); }
+
+  // Read the packets pending in the TUN queue / S1-U socket of a user plane queue, in batches
+  void handle_sgi_packets(uint32_t queue_idx);
+  void handle_s1u_packets(uint32_t queue_idx);
 
-  void handle_sgi_pdu(srsran::unique_byte_buffer_t msg);
-  void handle_s1u_pdu(srsran::byte_buffer_t* msg);
   void send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg);
 
   virtual in_addr_t get_s1u_addr();
@@ -62,28 +71,60 @@ public:
   gtpc_interface_gtpu* m_gtpc;
 
   bool m_sgi_up;
-  int  m_sgi;
+  bool m_s1u_up;
+  bool m_sgi_vnet_hdr = false;
 
-  bool        m_s1u_up;
-  int         m_s1u;
   sockaddr_in m_s1u_addr;
 
-  std::map<in_addr_t, srsran::gtp_fteid_t> m_ip_to_usr_teid; // Map IP to User-plane TEID for downlink traffic
-  std::map<in_addr_t, uint32_t>            m_ip_to_ctr_teid; // IP to control TEID map. Important to check if
-                                                             // UE is attached without an active user-plane
-                                                             // for downlink notifications.
+  static const uint32_t max_batch_size = 32;
+
+  // TUN queue and S1-U socket of a user plane thread, the first one is also used by the SP-GW thread
+  struct up_queue_t {
+    int                                                      sgi = -1;
+    int                                                      s1u = -1;
+    std::array<srsran::unique_byte_buffer_t, max_batch_size> s1u_pdus;
+    std::vector<uint8_t>                                     sgi_frame; // SGi packet read with its virtio_net_hdr
+    std::vector<srsran::unique_byte_buffer_t>                sgi_pkts;  // IP packets the SGi packet is split into
+  };
+  std::vector<up_queue_t> m_up_queues;
+
+  class up_worker;
+  std::vector<std::unique_ptr<up_worker>> m_up_workers;
+
+  // Tunnels of the UEs, sharded by UE IP in the same way as the downlink packets are spread across the TUN queues
+  struct tunnel_shard_t {
+    std::mutex                                         mutex;
+    std::unordered_map<in_addr_t, srsran::gtp_fteid_t> ip_to_usr_teid; // Map IP to User-plane TEID for downlink traffic
+    std::unordered_map<in_addr_t, uint32_t>            ip_to_ctr_teid; // IP to control TEID map. Important to check if
+                                                                       // UE is attached without an active user-plane
+                                                                       // for downlink notifications.
+  };
+  std::vector<std::unique_ptr<tunnel_shard_t>> m_tunnel_shards;
+  tunnel_shard_t& get_tunnel_shard(in_addr_t ue_ipv4);
+
+  // G-PDUs sent with a single sendmmsg call
+  struct s1u_tx_batch_t {
+    std::array<srsran::unique_byte_buffer_t, max_batch_size> pdus;
+    std::array<sockaddr_in, max_batch_size>                  addrs = {};
+    size_t                                                   size  = 0;
+  };
+  bool handle_sgi_frame(up_queue_t& queue, s1u_tx_batch_t& tx_batch);
+  void handle_sgi_pdu(srsran::unique_byte_buffer_t msg, s1u_tx_batch_t& tx_batch);
+  void handle_s1u_pdu(srsran::byte_buffer_t* msg, int sgi);
+  bool write_s1u_header(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg, sockaddr_in* enb_addr);
+  void send_s1u_batch(int s1u, s1u_tx_batch_t& tx_batch);
 
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("GTPU");
 };
 
 inline int spgw::gtpu::get_sgi()
 {
-  return m_sgi;
+  return m_up_queues[0].sgi;
 }
 
 inline int spgw::gtpu::get_s1u()
 {
-  return m_s1u;
+  return m_up_queues[0].s1u;
 }
 
 inline in_addr_t spgw::gtpu::get_s1u_addr()
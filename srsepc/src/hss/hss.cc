@@ -27,6 +27,7 @@
 #include <sstream>
 #include <stdlib.h> /* srand, rand */
 #include <string>
+#include <sys/stat.h>
 #include <time.h>
 
 namespace srsepc {
@@ -69,7 +70,7 @@ int hss::init(hss_args_t* hss_args)
   srand(time(NULL));
 
   /*Read user information from DB*/
-  if (read_db_file(hss_args->db_file) == false) {
+  if (load_db(hss_args) == false) {
     srsran::console("Error reading user database file %s\n", hss_args->db_file.c_str());
     return -1;
   }
@@ -77,6 +78,8 @@ int hss::init(hss_args_t* hss_args)
   mcc = hss_args->mcc;
   mnc = hss_args->mnc;
 
+  m_nof_auth_vectors = std::min(std::max(hss_args->nof_auth_vectors, 1U), (uint32_t)HSS_MAX_AUTH_VECTORS);
+
   db_file = hss_args->db_file;
 
   m_logger.info("HSS Initialized. DB file %s, MCC: %d, MNC: %d", hss_args->db_file.c_str(), mcc, mnc);
@@ -86,11 +89,63 @@ int hss::init(hss_args_t* hss_args)
 
 void hss::stop()
 {
-  write_db_file(db_file);
+  if (m_db.is_persistent()) {
+    // The SQNs have been updated in place
+    m_db.sync();
+  } else {
+    write_db_file(db_file);
+  }
   return;
 }
 
-bool hss::read_db_file(std::string db_filename)
+bool hss::load_db(const hss_args_t* hss_args)
+{
+  // The store is used as is unless the .csv has been modified after it was last written
+  struct stat csv_st;
+  struct stat store_st;
+  if (!hss_args->db_store.empty() && stat(hss_args->db_store.c_str(), &store_st) == 0 &&
+      (stat(hss_args->db_file.c_str(), &csv_st) < 0 || csv_st.st_mtime <= store_st.st_mtime) &&
+      m_db.open(hss_args->db_store)) {
+    m_logger.info("Opened DB store: %s, %d users", hss_args->db_store.c_str(), m_db.size());
+    if (m_db.nof_static_ips() > 0) {
+      char ip_str[INET_ADDRSTRLEN];
+      for (const hss_ue_ctx_t& ue_ctx : m_db) {
+        if (ue_ctx.static_ip_addr != 0) {
+          inet_ntop(AF_INET, &ue_ctx.static_ip_addr, ip_str, sizeof(ip_str));
+          m_ip_to_imsi.insert(std::make_pair(std::string(ip_str), ue_ctx.imsi));
+        }
+      }
+    }
+    return true;
+  }
+
+  std::vector<hss_ue_ctx_t> ues;
+  if (!read_db_file(hss_args->db_file, ues)) {
+    return false;
+  }
+  if (!hss_args->db_store.empty()) {
+    // Keep the SQNs of the previous store, they are more recent than the ones of the .csv
+    hss_db_store prev_db;
+    if (prev_db.open(hss_args->db_store)) {
+      for (hss_ue_ctx_t& ue_ctx : ues) {
+        hss_ue_ctx_t* prev_ue_ctx = prev_db.find(ue_ctx.imsi);
+        if (prev_ue_ctx != nullptr) {
+          ue_ctx.set_sqn(prev_ue_ctx->sqn);
+        }
+      }
+    }
+  }
+  if (!m_db.create(hss_args->db_store, ues)) {
+    return false;
+  }
+  if (m_db.is_persistent()) {
+    m_logger.info("Created DB store: %s, %d users", hss_args->db_store.c_str(), m_db.size());
+    srsran::console("HSS DB store %s created from %s\n", hss_args->db_store.c_str(), hss_args->db_file.c_str());
+  }
+  return true;
+}
+
+bool hss::read_db_file(std::string db_filename, std::vector<hss_ue_ctx_t>& ues)
 {
   std::ifstream m_db_file;
 
@@ -114,8 +169,13 @@ bool hss::read_db_file(std::string db_filename)
         srsran::console("See 'srsepc/user_db.csv.example' for an example.\n\n");
         return false;
       }
-      std::unique_ptr<hss_ue_ctx_t> ue_ctx = std::unique_ptr<hss_ue_ctx_t>(new hss_ue_ctx_t);
-      ue_ctx->name                         = split[0];
+      ues.emplace_back();
+      hss_ue_ctx_t* ue_ctx = &ues.back();
+      memset(ue_ctx, 0, sizeof(hss_ue_ctx_t));
+      if (split[0].size() >= HSS_DB_NAME_LEN) {
+        m_logger.warning("UE name %s too long, truncating it to %d characters", split[0].c_str(), HSS_DB_NAME_LEN - 1);
+      }
+      strncpy(ue_ctx->name, split[0].c_str(), HSS_DB_NAME_LEN - 1);
       if (split[1] == std::string("xor")) {
         ue_ctx->algo = HSS_ALGO_XOR;
       } else if (split[1] == std::string("mil")) {
@@ -152,13 +212,13 @@ bool hss::read_db_file(std::string db_filename)
       m_logger.debug("Default Bearer QCI: %d", ue_ctx->qci);
 
       if (split[9] == std::string("dynamic")) {
-        ue_ctx->static_ip_addr = "0.0.0.0";
+        ue_ctx->static_ip_addr = 0;
       } else {
-        char buf[128] = {0};
-        if (inet_pton(AF_INET, split[9].c_str(), buf)) {
+        struct in_addr addr = {};
+        if (inet_pton(AF_INET, split[9].c_str(), &addr)) {
           if (m_ip_to_imsi.insert(std::make_pair(split[9], ue_ctx->imsi)).second) {
-            ue_ctx->static_ip_addr = split[9];
-            m_logger.info("static ip addr %s", ue_ctx->static_ip_addr.c_str());
+            ue_ctx->static_ip_addr = addr.s_addr;
+            m_logger.info("static ip addr %s", split[9].c_str());
           } else {
             m_logger.info("duplicate static ip addr %s", split[9].c_str());
             return false;
@@ -168,7 +228,6 @@ bool hss::read_db_file(std::string db_filename)
           return false;
         }
       }
-      m_imsi_to_ue_ctx.insert(std::make_pair(ue_ctx->imsi, std::move(ue_ctx)));
     }
   }
 
@@ -216,37 +275,37 @@ bool hss::write_db_file(std::string db_filename)
             << "#                                                                                           \n"
             << "# Note: Lines starting by '#' are ignored and will be overwritten                           \n";
 
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator it = m_imsi_to_ue_ctx.begin();
-  while (it != m_imsi_to_ue_ctx.end()) {
-    m_db_file << it->second->name;
+  char ip_str[INET_ADDRSTRLEN];
+  for (hss_ue_ctx_t& ue_ctx : m_db) {
+    m_db_file << ue_ctx.name;
     m_db_file << ",";
-    m_db_file << (it->second->algo == HSS_ALGO_XOR ? "xor" : "mil");
+    m_db_file << (ue_ctx.algo == HSS_ALGO_XOR ? "xor" : "mil");
     m_db_file << ",";
-    m_db_file << std::setfill('0') << std::setw(15) << it->second->imsi;
+    m_db_file << std::setfill('0') << std::setw(15) << ue_ctx.imsi;
     m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->key, 16);
+    m_db_file << srsran::hex_string(ue_ctx.key, 16);
     m_db_file << ",";
-    if (it->second->op_configured) {
+    if (ue_ctx.op_configured) {
       m_db_file << "op,";
-      m_db_file << srsran::hex_string(it->second->op, 16);
+      m_db_file << srsran::hex_string(ue_ctx.op, 16);
     } else {
       m_db_file << "opc,";
-      m_db_file << srsran::hex_string(it->second->opc, 16);
+      m_db_file << srsran::hex_string(ue_ctx.opc, 16);
     }
     m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->amf, 2);
+    m_db_file << srsran::hex_string(ue_ctx.amf, 2);
     m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->sqn, 6);
+    m_db_file << srsran::hex_string(ue_ctx.sqn, 6);
     m_db_file << ",";
-    m_db_file << it->second->qci;
-    if (it->second->static_ip_addr != "0.0.0.0") {
+    m_db_file << ue_ctx.qci;
+    if (ue_ctx.static_ip_addr != 0) {
+      inet_ntop(AF_INET, &ue_ctx.static_ip_addr, ip_str, sizeof(ip_str));
       m_db_file << ",";
-      m_db_file << it->second->static_ip_addr;
+      m_db_file << ip_str;
     } else {
       m_db_file << ",dynamic";
     }
     m_db_file << std::endl;
-    it++;
   }
   if (m_db_file.is_open()) {
     m_db_file.close();
@@ -268,12 +327,13 @@ bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, ui
   switch (ue_ctx->algo) {
     case HSS_ALGO_XOR:
       gen_auth_info_answer_xor(ue_ctx, k_asme, autn, rand, xres);
+      increment_ue_sqn(ue_ctx);
       break;
     case HSS_ALGO_MILENAGE:
+      // The SQN is incremented for every vector computed
       gen_auth_info_answer_milenage(ue_ctx, k_asme, autn, rand, xres);
       break;
   }
-  increment_ue_sqn(ue_ctx);
   return true;
 }
 
@@ -283,55 +343,62 @@ void hss::gen_auth_info_answer_milenage(hss_ue_ctx_t* ue_ctx,
                                         uint8_t*      rand,
                                         uint8_t*      xres)
 {
-  // Get K, AMF, OPC and SQN
-  uint8_t* k   = ue_ctx->key;
-  uint8_t* amf = ue_ctx->amf;
-  uint8_t* opc = ue_ctx->opc;
-  uint8_t* sqn = ue_ctx->sqn;
-
-  // Temp variables
-  uint8_t ck[16];
-  uint8_t ik[16];
-  uint8_t ak[6];
-  uint8_t mac[8];
-
-  gen_rand(rand);
-
-  srsran::security_milenage_f2345(k, opc, rand, xres, ck, ik, ak);
-
-  m_logger.debug(k, 16, "User Key : ");
-  m_logger.debug(opc, 16, "User OPc : ");
-  m_logger.debug(rand, 16, "User Rand : ");
-  m_logger.debug(xres, 8, "User XRES: ");
-  m_logger.debug(ck, 16, "User CK: ");
-  m_logger.debug(ik, 16, "User IK: ");
-  m_logger.debug(ak, 6, "User AK: ");
-
-  srsran::security_milenage_f1(k, opc, rand, sqn, amf, mac);
+  // Use a vector computed by a previous request, if any
+  auth_vector_t av;
+  if (pop_auth_vector(ue_ctx->imsi, &av)) {
+    m_logger.debug("Using precomputed authentication vector -- IMSI: %015" PRIu64 "", ue_ctx->imsi);
+  } else {
+    // Compute a batch of vectors with consecutive SQNs, the key is expanded once and their AES blocks are encrypted
+    // together. The first one is used now and the rest are kept for the next requests
+    srsran::security_milenage_vector_t vectors[HSS_MAX_AUTH_VECTORS];
+    for (uint32_t v = 0; v < m_nof_auth_vectors; v++) {
+      gen_rand(vectors[v].rand);
+      memcpy(vectors[v].sqn, ue_ctx->sqn, 6);
+      increment_ue_sqn(ue_ctx);
+    }
+    srsran::security_milenage_batch(ue_ctx->key, ue_ctx->opc, ue_ctx->amf, vectors, m_nof_auth_vectors);
 
-  m_logger.debug(sqn, 6, "User SQN : ");
-  m_logger.debug(mac, 8, "User MAC : ");
+    auth_vectors_t avs = {};
+    for (uint32_t v = 0; v < m_nof_auth_vectors; v++) {
+      const srsran::security_milenage_vector_t& vec = vectors[v];
+      auth_vector_t&                            out = v == 0 ? av : avs.vectors[avs.nof_vectors++];
 
-  uint8_t ak_xor_sqn[6];
-  for (int i = 0; i < 6; i++) {
-    ak_xor_sqn[i] = sqn[i] ^ ak[i];
+      // Generate AUTN (autn = sqn ^ ak |+| amf |+| mac)
+      for (int i = 0; i < 6; i++) {
+        out.autn[i] = vec.sqn[i] ^ vec.ak[i];
+      }
+      for (int i = 0; i < 2; i++) {
+        out.autn[6 + i] = ue_ctx->amf[i];
+      }
+      for (int i = 0; i < 8; i++) {
+        out.autn[8 + i] = vec.mac_a[i];
+      }
+      // Generate K_asme, with SQN ^ AK from the AUTN
+      srsran::security_generate_k_asme(vec.ck, vec.ik, out.autn, mcc, mnc, out.k_asme);
+      memcpy(out.rand, vec.rand, 16);
+      memcpy(out.xres, vec.res, 8);
+
+      m_logger.debug(vec.rand, 16, "User Rand : ");
+      m_logger.debug(vec.sqn, 6, "User SQN : ");
+      m_logger.debug(vec.res, 8, "User XRES: ");
+      m_logger.debug(vec.ck, 16, "User CK: ");
+      m_logger.debug(vec.ik, 16, "User IK: ");
+      m_logger.debug(vec.ak, 6, "User AK: ");
+      m_logger.debug(vec.mac_a, 8, "User MAC : ");
+    }
+    if (avs.nof_vectors > 0) {
+      std::lock_guard<std::mutex> lock(m_auth_vectors_mutex);
+      m_auth_vectors[ue_ctx->imsi] = avs;
+    }
   }
-  // Generate K_asme
-  srsran::security_generate_k_asme(ck, ik, ak_xor_sqn, mcc, mnc, k_asme);
+
+  memcpy(rand, av.rand, 16);
+  memcpy(xres, av.xres, 8);
+  memcpy(autn, av.autn, 16);
+  memcpy(k_asme, av.k_asme, 32);
 
   m_logger.debug("User MCC : %x  MNC : %x ", mcc, mnc);
   m_logger.debug(k_asme, 32, "User k_asme : ");
-
-  // Generate AUTN (autn = sqn ^ ak |+| amf |+| mac)
-  for (int i = 0; i < 6; i++) {
-    autn[i] = sqn[i] ^ ak[i];
-  }
-  for (int i = 0; i < 2; i++) {
-    autn[6 + i] = amf[i];
-  }
-  for (int i = 0; i < 8; i++) {
-    autn[8 + i] = mac[i];
-  }
   m_logger.debug(autn, 16, "User AUTN: ");
 
   // Set last RAND
@@ -339,6 +406,21 @@ void hss::gen_auth_info_answer_milenage(hss_ue_ctx_t* ue_ctx,
   return;
 }
 
+bool hss::pop_auth_vector(uint64_t imsi, auth_vector_t* av)
+{
+  std::lock_guard<std::mutex> lock(m_auth_vectors_mutex);
+  auto                        it = m_auth_vectors.find(imsi);
+  if (it == m_auth_vectors.end()) {
+    return false;
+  }
+  auth_vectors_t& avs = it->second;
+  *av                 = avs.vectors[avs.next++];
+  if (avs.next == avs.nof_vectors) {
+    m_auth_vectors.erase(imsi);
+  }
+  return true;
+}
+
 void hss::gen_auth_info_answer_xor(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres)
 {
   // Get K, AMF, OPC and SQN
@@ -440,13 +522,12 @@ void hss::gen_auth_info_answer_xor(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_
 
 bool hss::gen_update_loc_answer(uint64_t imsi, uint8_t* qci)
 {
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
-  if (ue_ctx_it == m_imsi_to_ue_ctx.end()) {
+  const hss_ue_ctx_t* ue_ctx = m_db.find(imsi);
+  if (ue_ctx == nullptr) {
     m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
     srsran::console("User not found at HSS. IMSI: %015" PRIu64 "\n", imsi);
     return false;
   }
-  const std::unique_ptr<hss_ue_ctx_t>& ue_ctx = ue_ctx_it->second;
   m_logger.info("Found User %015" PRIu64 "", imsi);
   *qci = ue_ctx->qci;
   return true;
@@ -472,6 +553,12 @@ bool hss::resync_sqn(uint64_t imsi, uint8_t* auts)
   }
 
   increment_seq_after_resync(ue_ctx);
+
+  // The precomputed vectors are not valid anymore with the new SQN
+  {
+    std::lock_guard<std::mutex> lock(m_auth_vectors_mutex);
+    m_auth_vectors.erase(imsi);
+  }
   return true;
 }
 
@@ -612,13 +699,11 @@ void hss::gen_rand(uint8_t rand_[16])
 
 hss_ue_ctx_t* hss::get_ue_ctx(uint64_t imsi)
 {
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
-  if (ue_ctx_it == m_imsi_to_ue_ctx.end()) {
+  hss_ue_ctx_t* ue_ctx = m_db.find(imsi);
+  if (ue_ctx == nullptr) {
     m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
-    return nullptr;
   }
-
-  return ue_ctx_it->second.get();
+  return ue_ctx;
 }
 
 std::map<std::string, uint64_t> hss::get_ip_to_imsi(void) const
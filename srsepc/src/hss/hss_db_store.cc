@@ -0,0 +1,243 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "srsepc/hdr/hss/hss_db_store.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace srsepc {
+
+#define HSS_DB_MAGIC "SRSHSSDB"
+#define HSS_DB_VERSION 1
+#define HSS_DB_MIN_INDEX_BITS 4
+
+/*
+ * File layout: header, records and the IMSI index (open addressing with linear probing, at most half full)
+ */
+struct hss_db_header_t {
+  char     magic[8];
+  uint32_t version;
+  uint32_t record_size;
+  uint32_t nof_records;
+  uint32_t index_bits;
+  uint32_t nof_static_ips;
+  uint32_t reserved;
+};
+
+static size_t get_records_offset()
+{
+  return (sizeof(hss_db_header_t) + alignof(hss_ue_ctx_t) - 1) & ~(alignof(hss_ue_ctx_t) - 1);
+}
+
+static size_t get_map_len(uint32_t nof_records, uint32_t index_bits)
+{
+  return get_records_offset() + nof_records * sizeof(hss_ue_ctx_t) + (sizeof(uint32_t) << index_bits);
+}
+
+bool hss_db_store::open(const std::string& filename)
+{
+  close();
+
+  int fd = ::open(filename.c_str(), O_RDWR);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(hss_db_header_t)) {
+    m_logger.warning("Invalid HSS DB store %s", filename.c_str());
+    ::close(fd);
+    return false;
+  }
+  if (!map(st.st_size, fd)) {
+    ::close(fd);
+    return false;
+  }
+
+  if (memcmp(m_header->magic, HSS_DB_MAGIC, sizeof(m_header->magic)) != 0 || m_header->version != HSS_DB_VERSION ||
+      m_header->record_size != sizeof(hss_ue_ctx_t) || m_header->index_bits < HSS_DB_MIN_INDEX_BITS ||
+      m_header->index_bits > 31 || get_map_len(m_header->nof_records, m_header->index_bits) != m_map_len) {
+    m_logger.warning("Invalid HSS DB store %s. Wrong format or version", filename.c_str());
+    close();
+    return false;
+  }
+  m_idx_bits = m_header->index_bits;
+  m_idx_mask = (1U << m_idx_bits) - 1;
+  m_index    = (uint32_t*)(m_records + m_header->nof_records);
+  return true;
+}
+
+bool hss_db_store::create(const std::string& filename, const std::vector<hss_ue_ctx_t>& ues)
+{
+  close();
+
+  // Size the index for a load factor of at most 1/2
+  uint32_t index_bits = HSS_DB_MIN_INDEX_BITS;
+  while ((1UL << index_bits) < 2 * ues.size()) {
+    index_bits++;
+  }
+  size_t      len = get_map_len(ues.size(), index_bits);
+  std::string tmp_filename;
+  int         fd = -1;
+  if (!filename.empty()) {
+    // The store is built in a temporary file and renamed, so that a crash never leaves a partial database
+    tmp_filename = filename + ".tmp";
+    fd           = ::open(tmp_filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+      m_logger.error("Could not create HSS DB store %s. %s", tmp_filename.c_str(), strerror(errno));
+      return false;
+    }
+    if (ftruncate(fd, len) < 0) {
+      m_logger.error("Could not resize HSS DB store %s. %s", tmp_filename.c_str(), strerror(errno));
+      ::close(fd);
+      unlink(tmp_filename.c_str());
+      return false;
+    }
+  }
+  if (!map(len, fd)) {
+    if (fd >= 0) {
+      ::close(fd);
+      unlink(tmp_filename.c_str());
+    }
+    return false;
+  }
+
+  memcpy(m_header->magic, HSS_DB_MAGIC, sizeof(m_header->magic));
+  m_header->version     = HSS_DB_VERSION;
+  m_header->record_size = sizeof(hss_ue_ctx_t);
+  m_header->index_bits  = index_bits;
+  m_idx_bits            = index_bits;
+  m_idx_mask            = (1U << index_bits) - 1;
+  m_index               = (uint32_t*)(m_records + ues.size());
+  memset(m_index, 0, sizeof(uint32_t) << index_bits);
+
+  // Fill the records and the index
+  uint32_t nof_records    = 0;
+  uint32_t nof_static_ips = 0;
+  for (const hss_ue_ctx_t& ue : ues) {
+    uint32_t pos = get_index_pos(ue.imsi);
+    if (m_index[pos] != 0) {
+      m_logger.warning("Duplicated IMSI %015" PRIu64 " in the HSS DB. Ignoring it", ue.imsi);
+      continue;
+    }
+    m_records[nof_records] = ue;
+    m_index[pos]           = ++nof_records;
+    nof_static_ips += ue.static_ip_addr != 0 ? 1 : 0;
+  }
+  m_header->nof_records    = nof_records;
+  m_header->nof_static_ips = nof_static_ips;
+  if (nof_records != ues.size()) {
+    // Move the index right after the records, where it will be looked up when the file is opened again
+    uint32_t* index = (uint32_t*)(m_records + nof_records);
+    memmove(index, m_index, sizeof(uint32_t) << index_bits);
+    m_index = index;
+  }
+
+  if (fd >= 0) {
+    if (nof_records != ues.size()) {
+      m_map_len = get_map_len(nof_records, index_bits);
+      if (ftruncate(fd, m_map_len) < 0) {
+        m_logger.error("Could not resize HSS DB store %s. %s", tmp_filename.c_str(), strerror(errno));
+      }
+    }
+    sync();
+    if (rename(tmp_filename.c_str(), filename.c_str()) < 0) {
+      m_logger.error("Could not create HSS DB store %s. %s", filename.c_str(), strerror(errno));
+      close();
+      unlink(tmp_filename.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+bool hss_db_store::map(size_t len, int fd)
+{
+  int flags = fd >= 0 ? MAP_SHARED : (MAP_PRIVATE | MAP_ANONYMOUS);
+  m_map     = mmap(nullptr, len, PROT_READ | PROT_WRITE, flags, fd, 0);
+  if (m_map == MAP_FAILED) {
+    m_logger.error("Could not map the HSS DB. %s", strerror(errno));
+    m_map = nullptr;
+    return false;
+  }
+  m_fd      = fd;
+  m_map_len = len;
+  m_header  = (hss_db_header_t*)m_map;
+  m_records = (hss_ue_ctx_t*)((uint8_t*)m_map + get_records_offset());
+  return true;
+}
+
+void hss_db_store::sync()
+{
+  if (m_fd >= 0 && msync(m_map, m_map_len, MS_SYNC) < 0) {
+    m_logger.error("Could not write back the HSS DB store. %s", strerror(errno));
+  }
+}
+
+void hss_db_store::close()
+{
+  if (m_map != nullptr) {
+    sync();
+    munmap(m_map, m_map_len);
+  }
+  if (m_fd >= 0) {
+    ::close(m_fd);
+  }
+  m_fd      = -1;
+  m_map     = nullptr;
+  m_map_len = 0;
+  m_header  = nullptr;
+  m_records = nullptr;
+  m_index   = nullptr;
+}
+
+uint32_t hss_db_store::size() const
+{
+  return m_header != nullptr ? m_header->nof_records : 0;
+}
+
+uint32_t hss_db_store::nof_static_ips() const
+{
+  return m_header != nullptr ? m_header->nof_static_ips : 0;
+}
+
+uint32_t hss_db_store::get_index_pos(uint64_t imsi) const
+{
+  // Fibonacci hashing, then linear probing until the IMSI or an empty slot is found
+  uint32_t pos = (imsi * 0x9E3779B97F4A7C15ULL) >> (64 - m_idx_bits);
+  while (m_index[pos] != 0 && m_records[m_index[pos] - 1].imsi != imsi) {
+    pos = (pos + 1) & m_idx_mask;
+  }
+  return pos;
+}
+
+hss_ue_ctx_t* hss_db_store::find(uint64_t imsi)
+{
+  if (m_header == nullptr) {
+    return nullptr;
+  }
+  uint32_t pos = get_index_pos(imsi);
+  return m_index[pos] != 0 ? &m_records[m_index[pos] - 1] : nullptr;
+}
+
+} // namespace srsepc
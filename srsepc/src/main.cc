@@ -87,6 +87,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   string   integrity_algo;
   uint16_t paging_timer     = 0;
   uint32_t max_paging_queue = 0;
+  uint32_t nof_up_threads   = 0;
+  bool     sgi_vnet_hdr     = false;
   string   spgw_bind_addr;
   string   sgi_if_addr;
   string   sgi_if_name;
@@ -126,11 +128,16 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("mme.paging_timer",    bpo::value<uint16_t>(&paging_timer)->default_value(2),           "Set paging timer value in seconds (T3413)")
     ("mme.request_imeisv",  bpo::value<bool>(&request_imeisv)->default_value(false),         "Enable IMEISV request in Security mode command")
     ("mme.lac",             bpo::value<string>(&lac)->default_value("0x01"),                 "Location Area Code")
+    ("mme.nof_workers",     bpo::value<uint32_t>(&args->mme_args.s1ap_args.nof_workers)->default_value(0), "Number of S1AP/NAS worker threads, UEs are partitioned across them. 0 processes everything in the MME thread")
     ("hss.db_file",         bpo::value<string>(&hss_db_file)->default_value("ue_db.csv"),    ".csv file that stores UE's keys")
+    ("hss.db_store",        bpo::value<string>(&args->hss_args.db_store)->default_value(""), "Binary HSS database imported from the .csv file. Empty keeps the users in memory only")
+    ("hss.nof_auth_vectors", bpo::value<uint32_t>(&args->hss_args.nof_auth_vectors)->default_value(1), "Milenage authentication vectors computed at once per UE (1-8), the unused ones are kept for its next requests")
     ("spgw.gtpu_bind_addr", bpo::value<string>(&spgw_bind_addr)->default_value("127.0.0.1"), "IP address of SP-GW for the S1-U connection")
     ("spgw.sgi_if_addr",    bpo::value<string>(&sgi_if_addr)->default_value("176.16.0.1"),   "IP address of TUN interface for the SGi connection")
     ("spgw.sgi_if_name",    bpo::value<string>(&sgi_if_name)->default_value("srs_spgw_sgi"), "Name of TUN interface for the SGi connection")
     ("spgw.max_paging_queue", bpo::value<uint32_t>(&max_paging_queue)->default_value(100), "Max number of packets in paging queue")
+    ("spgw.nof_up_threads", bpo::value<uint32_t>(&nof_up_threads)->default_value(0), "Number of user plane threads, sharded by UE IP (downlink) and TEID (uplink). 0 handles the user plane in the SP-GW thread")
+    ("spgw.sgi_vnet_hdr", bpo::value<bool>(&sgi_vnet_hdr)->default_value(false), "Read the TCP segments coalesced by the kernel (GSO) from the SGi TUN interface and split them in the SP-GW")
 
     ("pcap.enable",   bpo::value<bool>(&args->mme_args.s1ap_args.pcap_enable)->default_value(false),         "Enable S1AP PCAP")
     ("pcap.filename", bpo::value<string>(&args->mme_args.s1ap_args.pcap_filename)->default_value("/tmp/epc.pcap"), "PCAP filename")
@@ -287,6 +294,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   args->spgw_args.sgi_if_addr             = sgi_if_addr;
   args->spgw_args.sgi_if_name             = sgi_if_name;
   args->spgw_args.max_paging_queue        = max_paging_queue;
+  args->spgw_args.nof_up_threads          = nof_up_threads;
+  args->spgw_args.sgi_vnet_hdr            = sgi_vnet_hdr;
   args->hss_args.db_file                  = hss_db_file;
 
   // Apply all_level to any unset layers
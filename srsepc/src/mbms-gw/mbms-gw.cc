@@ -22,15 +22,18 @@
 #include "srsepc/hdr/mbms-gw/mbms-gw.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/network_utils.h"
+#include "srsran/common/string_helpers.h"
 #include "srsran/upper/gtpu.h"
 #include <algorithm>
 #include <fcntl.h>
+#include <inttypes.h>
 #include <iostream>
 #include <linux/if.h>
 #include <linux/if_tun.h>
 #include <linux/ip.h>
 #include <netinet/in.h>
 #include <netinet/udp.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 
@@ -87,6 +90,17 @@ int mbms_gw::init(mbms_gw_args_t* args)
     m_logger.error("Error initializing SGi-MB.");
     return SRSRAN_ERROR_CANT_START;
   }
+
+  // The buffers of the batches are allocated once and reused
+  for (srsran::unique_byte_buffer_t& pdu : m_rx_pdus) {
+    pdu = srsran::make_byte_buffer();
+    if (pdu == nullptr) {
+      m_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+      return SRSRAN_ERROR_CANT_START;
+    }
+  }
+  m_metrics_period = args->metrics_period;
+
   m_logger.info("MBMS GW Initiated");
   srsran::console("MBMS GW Initiated\n");
   return SRSRAN_SUCCESS;
@@ -137,6 +151,13 @@ int mbms_gw::init_sgi_mb_if(mbms_gw_args_t* args)
     m_logger.debug("Set TUN device name: %s", args->sgi_mb_if_name.c_str());
   }
 
+  // The packets queued in the TUN are read in batches until it is empty
+  if (fcntl(m_sgi_mb_if, F_SETFL, fcntl(m_sgi_mb_if, F_GETFL) | O_NONBLOCK) < 0) {
+    m_logger.error("Failed to set TUN device non-blocking: %s", strerror(errno));
+    close(m_sgi_mb_if);
+    return SRSRAN_ERROR_CANT_START;
+  }
+
   // Bring up the interface
   int sgi_mb_sock = socket(AF_INET, SOCK_DGRAM, 0);
   if (sgi_mb_sock < 0) {
@@ -240,16 +261,38 @@ int mbms_gw::init_m1_u(mbms_gw_args_t* args)
     return SRSRAN_ERROR_CANT_START;
   }
 
-  bzero(&m_m1u_multi_addr, sizeof(m_m1u_multi_addr));
-  m_m1u_multi_addr.sin_family      = AF_INET;
-  m_m1u_multi_addr.sin_port        = htons(GTPU_RX_PORT + 1);
-  if (inet_pton(m_m1u_multi_addr.sin_family, args->m1u_multi_addr.c_str(), &m_m1u_multi_addr.sin_addr.s_addr) != 1) {
-    m_logger.error("Invalid m1u_multi_addr: %s", args->m1u_multi_addr.c_str());
-    srsran::console("Invalid m1u_multi_addr: %s\n", args->m1u_multi_addr.c_str());
-    perror("inet_pton");
+  // The packets are replicated to every address of the list
+  m_m1u_dests.clear();
+  std::vector<std::string> dest_addrs = srsran::split_string(args->m1u_multi_addr, ',');
+  for (std::string& dest_addr : dest_addrs) {
+    dest_addr.erase(std::remove(dest_addr.begin(), dest_addr.end(), ' '), dest_addr.end());
+    if (dest_addr.empty()) {
+      continue;
+    }
+    struct sockaddr_in dest;
+    bzero(&dest, sizeof(dest));
+    dest.sin_family = AF_INET;
+    dest.sin_port   = htons(GTPU_RX_PORT + 1);
+    if (inet_pton(dest.sin_family, dest_addr.c_str(), &dest.sin_addr.s_addr) != 1) {
+      m_logger.error("Invalid m1u_multi_addr: %s", dest_addr.c_str());
+      srsran::console("Invalid m1u_multi_addr: %s\n", dest_addr.c_str());
+      perror("inet_pton");
+      return SRSRAN_ERROR_CANT_START;
+    }
+    m_m1u_dests.push_back(dest);
+  }
+  if (m_m1u_dests.empty() || m_m1u_dests.size() > MBMS_GW_MAX_M1U_DESTS) {
+    m_logger.error("Invalid number of M1-U destinations %zd, it must be between 1 and %d",
+                   m_m1u_dests.size(),
+                   MBMS_GW_MAX_M1U_DESTS);
+    srsran::console("Invalid number of M1-U destinations %zd\n", m_m1u_dests.size());
     return SRSRAN_ERROR_CANT_START;
   }
-  m_logger.info("Initialized M1-U");
+
+  // Setup GTP-U header
+  srsran::gtpu_set_header_template(m_gtpu_hdr, 0xAAAA); // TODO Harcoded TEID for now
+
+  m_logger.info("Initialized M1-U, %zd destinations", m_m1u_dests.size());
 
   return SRSRAN_SUCCESS;
 }
@@ -257,66 +300,153 @@ int mbms_gw::init_m1_u(mbms_gw_args_t* args)
 void mbms_gw::run_thread()
 {
   // Mark the thread as running
-  m_running                        = true;
-  srsran::unique_byte_buffer_t msg = srsran::make_byte_buffer();
-  if (msg == nullptr) {
-    m_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
-    return;
-  }
+  m_running         = true;
+  m_last_metrics_tp = std::chrono::steady_clock::now();
 
-  uint8_t seq = 0;
   while (m_running) {
-    msg->clear();
-    int n;
-    do {
-      n = read(m_sgi_mb_if, msg->msg, SRSRAN_MAX_BUFFER_SIZE_BYTES);
-    } while (n == -1 && errno == EAGAIN);
-
-    if (n < 0) {
-      m_logger.error("Error reading from TUN interface. Error: %s", strerror(errno));
-    } else {
-      msg->N_bytes = n;
-      handle_sgi_md_pdu(msg.get());
+    uint32_t nof_pkts = read_sgi_mb_batch();
+    if (nof_pkts > 0) {
+      handle_sgi_mb_batch(nof_pkts);
     }
+    log_metrics();
   }
   return;
 }
 
-void mbms_gw::handle_sgi_md_pdu(srsran::byte_buffer_t* msg)
+uint32_t mbms_gw::read_sgi_mb_batch()
 {
-  uint8_t               version;
-  srsran::gtpu_header_t header;
+  // Wait for the first packet, with a timeout so the metrics are logged when there is no traffic
+  struct pollfd pfd = {};
+  pfd.fd            = m_sgi_mb_if;
+  pfd.events        = POLLIN;
+  int n             = poll(&pfd, 1, 1000);
+  if (n < 0 && errno != EINTR) {
+    m_logger.error("Error polling TUN interface. Error: %s", strerror(errno));
+  }
+  if (n <= 0) {
+    return 0;
+  }
 
-  // Setup GTP-U header
-  header.flags        = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
-  header.message_type = GTPU_MSG_DATA_PDU;
-  header.length       = msg->N_bytes;
-  header.teid         = 0xAAAA; // TODO Harcoded TEID for now
-
-  // Sanity Check IP packet
-  if (msg->N_bytes < 20) {
-    m_logger.error("IPv4 min len: %d, drop msg len %d", 20, msg->N_bytes);
-    return;
+  // Read the packets already queued, without blocking
+  uint32_t nof_pkts = 0;
+  while (nof_pkts < MBMS_GW_MAX_BATCH_SIZE) {
+    srsran::byte_buffer_t* msg = m_rx_pdus[nof_pkts].get();
+    msg->clear();
+    n = read(m_sgi_mb_if, msg->msg, SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET);
+    if (n < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        m_logger.error("Error reading from TUN interface. Error: %s", strerror(errno));
+      }
+      break;
+    }
+    msg->N_bytes = n;
+    m_metrics.rx_bytes.fetch_add(n, std::memory_order_relaxed);
+    nof_pkts++;
   }
+  m_metrics.rx_pkts.fetch_add(nof_pkts, std::memory_order_relaxed);
+  return nof_pkts;
+}
 
-  // IP Headers
-  struct iphdr* iph = (struct iphdr*)msg->msg;
-  if (iph->version != 4) {
-    m_logger.info("IPv6 not supported yet.");
-    return;
+void mbms_gw::handle_sgi_mb_batch(uint32_t nof_pkts)
+{
+  uint32_t nof_msgs  = 0;
+  uint32_t tx_pkts   = 0;
+  uint64_t tx_bytes  = 0;
+  uint32_t nof_dests = m_m1u_dests.size();
+  for (uint32_t i = 0; i < nof_pkts; i++) {
+    srsran::byte_buffer_t* msg = m_rx_pdus[i].get();
+
+    // Sanity Check IP packet
+    if (msg->N_bytes < 20) {
+      m_logger.error("IPv4 min len: %d, drop msg len %d", 20, msg->N_bytes);
+      m_metrics.dropped_pkts.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    // IP Headers
+    struct iphdr* iph = (struct iphdr*)msg->msg;
+    if (iph->version != 4) {
+      m_logger.info("IPv6 not supported yet.");
+      m_metrics.dropped_pkts.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    // Write GTP-U header into packet
+    if (!srsran::gtpu_write_header(m_gtpu_hdr, msg, -1)) {
+      srsran::console("Error writing GTP-U header on PDU\n");
+      m_metrics.dropped_pkts.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    // The same buffer is sent to all the destinations
+    struct iovec& iov = m_tx_iovs[i];
+    iov.iov_base      = msg->msg;
+    iov.iov_len       = msg->N_bytes;
+    for (uint32_t d = 0; d < nof_dests; d++) {
+      struct msghdr& hdr = m_tx_msgs[nof_msgs++].msg_hdr;
+      hdr.msg_name       = &m_m1u_dests[d];
+      hdr.msg_namelen    = sizeof(struct sockaddr_in);
+      hdr.msg_iov        = &iov;
+      hdr.msg_iovlen     = 1;
+    }
+    tx_pkts += nof_dests;
+    tx_bytes += (uint64_t)msg->N_bytes * nof_dests;
   }
 
-  // Write GTP-U header into packet
-  if (!srsran::gtpu_write_header(&header, msg, m_logger)) {
-    srsran::console("Error writing GTP-U header on PDU\n");
+  // A message that fails is skipped, so a destination that is not reachable does not block the others
+  uint32_t nof_sent = 0;
+  while (nof_sent < nof_msgs) {
+    int n = sendmmsg(m_m1u, &m_tx_msgs[nof_sent], nof_msgs - nof_sent, 0);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      srsran::console("Error writing to M1-U socket.\n");
+      m_logger.error("Error writing to M1-U socket. Error: %s", strerror(errno));
+      m_metrics.tx_errors.fetch_add(1, std::memory_order_relaxed);
+      tx_pkts--;
+      tx_bytes -= m_tx_msgs[nof_sent].msg_hdr.msg_iov->iov_len;
+      n = 1;
+    }
+    nof_sent += n;
   }
+  m_metrics.tx_pkts.fetch_add(tx_pkts, std::memory_order_relaxed);
+  m_metrics.tx_bytes.fetch_add(tx_bytes, std::memory_order_relaxed);
+  m_logger.debug("Sent %d packets to %d M1-U destinations, %" PRIu64 " Bytes", tx_pkts, nof_dests, tx_bytes);
+}
 
-  int n = sendto(m_m1u, msg->msg, msg->N_bytes, 0, (sockaddr*)&m_m1u_multi_addr, sizeof(struct sockaddr));
-  if (n < 0) {
-    srsran::console("Error writing to M1-U socket.\n");
-  } else {
-    m_logger.debug("Sent %d Bytes", msg->N_bytes);
+void mbms_gw::get_metrics(mbms_gw_metrics_t& metrics)
+{
+  metrics.rx_pkts      = m_metrics.rx_pkts.load(std::memory_order_relaxed);
+  metrics.rx_bytes     = m_metrics.rx_bytes.load(std::memory_order_relaxed);
+  metrics.dropped_pkts = m_metrics.dropped_pkts.load(std::memory_order_relaxed);
+  metrics.tx_pkts      = m_metrics.tx_pkts.load(std::memory_order_relaxed);
+  metrics.tx_bytes     = m_metrics.tx_bytes.load(std::memory_order_relaxed);
+  metrics.tx_errors    = m_metrics.tx_errors.load(std::memory_order_relaxed);
+}
+
+void mbms_gw::log_metrics()
+{
+  if (m_metrics_period == 0) {
+    return;
   }
+  std::chrono::steady_clock::time_point now     = std::chrono::steady_clock::now();
+  double                                elapsed = std::chrono::duration<double>(now - m_last_metrics_tp).count();
+  if (elapsed < m_metrics_period) {
+    return;
+  }
+
+  mbms_gw_metrics_t metrics;
+  get_metrics(metrics);
+  m_logger.info("Metrics: rx %.0f pkt/s %.1f Mbps, tx %.0f pkt/s %.1f Mbps, dropped %" PRIu64 ", tx errors %" PRIu64,
+                (metrics.rx_pkts - m_last_metrics.rx_pkts) / elapsed,
+                (metrics.rx_bytes - m_last_metrics.rx_bytes) * 8 / elapsed / 1e6,
+                (metrics.tx_pkts - m_last_metrics.tx_pkts) / elapsed,
+                (metrics.tx_bytes - m_last_metrics.tx_bytes) * 8 / elapsed / 1e6,
+                metrics.dropped_pkts - m_last_metrics.dropped_pkts,
+                metrics.tx_errors - m_last_metrics.tx_errors);
+  m_last_metrics    = metrics;
+  m_last_metrics_tp = now;
 }
 
 } // namespace srsepc
@@ -23,6 +23,7 @@
 #include <arpa/inet.h>
 #include <inttypes.h> // for printing uint64_t
 #include <netinet/sctp.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 
@@ -77,6 +78,12 @@ int mme::init(mme_args_t* args)
     exit(-1);
   }
 
+  m_timers_event_fd = eventfd(0, EFD_NONBLOCK);
+  if (m_timers_event_fd < 0) {
+    m_s1ap_logger.error("Error creating timer event fd. %s", strerror(errno));
+    exit(-1);
+  }
+
   /*Log successful initialization*/
   m_s1ap_logger.info("MME Initialized. MCC: 0x%x, MNC: 0x%x", args->s1ap_args.mcc, args->s1ap_args.mnc);
   srsran::console("MME Initialized. MCC: 0x%x, MNC: 0x%x\n", args->s1ap_args.mcc, args->s1ap_args.mnc);
@@ -91,6 +98,8 @@ void mme::stop()
     m_running = false;
     thread_cancel();
     wait_thread_finish();
+    close(m_timers_event_fd);
+    m_timers_event_fd = -1;
   }
   return;
 }
@@ -102,7 +111,7 @@ void mme::run_thread()
     m_s1ap_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
     return;
   }
-  uint32_t                     sz  = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  uint32_t sz = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
 
   struct sockaddr_in     enb_addr;
   struct sctp_sndrcvinfo sri;
@@ -120,17 +129,21 @@ void mme::run_thread()
 
   while (m_running) {
     pdu->clear();
-    int max_fd = std::max(s1mme, s11);
+    int max_fd = std::max(std::max(s1mme, s11), m_timers_event_fd);
 
     FD_ZERO(&m_set);
     FD_SET(s1mme, &m_set);
     FD_SET(s11, &m_set);
+    FD_SET(m_timers_event_fd, &m_set);
 
     // Add timers to select
-    for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end(); ++it) {
-      FD_SET(it->fd, &m_set);
-      max_fd = std::max(max_fd, it->fd);
-      m_s1ap_logger.debug("Adding Timer fd %d to fd_set", it->fd);
+    {
+      std::lock_guard<std::mutex> lock(m_timers_mutex);
+      for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end(); ++it) {
+        FD_SET(it->fd, &m_set);
+        max_fd = std::max(max_fd, it->fd);
+        m_s1ap_logger.debug("Adding Timer fd %d to fd_set", it->fd);
+      }
     }
 
     m_s1ap_logger.debug("Waiting for S1-MME or S11 Message");
@@ -165,18 +178,42 @@ void mme::run_thread()
       }
       // Handle S11
       if (FD_ISSET(s11, &m_set)) {
-        pdu->N_bytes = recvfrom(s11, pdu->msg, sz, 0, NULL, NULL);
-        m_mme_gtpc->handle_s11_pdu(pdu.get());
+        // The S11 message is handed over to the worker of the UE, so each message gets its own buffer
+        srsran::unique_byte_buffer_t s11_pdu = srsran::make_byte_buffer("mme::run_thread");
+        if (s11_pdu == nullptr) {
+          m_s1ap_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+        } else {
+          rd_sz = recvfrom(s11, s11_pdu->msg, sz, 0, NULL, NULL);
+          if (rd_sz > 0) {
+            s11_pdu->N_bytes = rd_sz;
+            m_mme_gtpc->handle_s11_pdu(std::move(s11_pdu));
+          }
+        }
+      }
+      // Drain the timer event, the new timers are added to the select in the next iteration
+      if (FD_ISSET(m_timers_event_fd, &m_set)) {
+        uint64_t nof_events;
+        rd_sz = read(m_timers_event_fd, &nof_events, sizeof(uint64_t));
       }
       // Handle NAS Timers
+      std::unique_lock<std::mutex> lock(m_timers_mutex);
       for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end();) {
         if (FD_ISSET(it->fd, &m_set)) {
-          m_s1ap_logger.info("Timer expired");
+          // The fd may have been closed and reused by a worker since the select, so the read doesn't block
           uint64_t exp;
           rd_sz = read(it->fd, &exp, sizeof(uint64_t));
-          m_s1ap->expire_nas_timer(it->type, it->imsi);
+          if (rd_sz != sizeof(uint64_t)) {
+            ++it;
+            continue;
+          }
+          m_s1ap_logger.info("Timer expired");
+          enum nas_timer_type type = it->type;
+          uint64_t            imsi = it->imsi;
           close(it->fd);
-          timers.erase(it);
+          it = timers.erase(it);
+          lock.unlock();
+          m_s1ap->push_ue_task(imsi, [this, type, imsi]() { m_s1ap->expire_nas_timer(type, imsi); });
+          lock.lock();
         } else {
           ++it;
         }
@@ -200,12 +237,22 @@ bool mme::add_nas_timer(int timer_fd, nas_timer_type type, uint64_t imsi)
   timer.type = type;
   timer.imsi = imsi;
 
-  timers.push_back(timer);
+  {
+    std::lock_guard<std::mutex> lock(m_timers_mutex);
+    timers.push_back(timer);
+  }
+
+  // Wake up the MME thread to wait on the new timer
+  uint64_t one = 1;
+  if (write(m_timers_event_fd, &one, sizeof(uint64_t)) != sizeof(uint64_t)) {
+    m_s1ap_logger.warning("Could not signal the new NAS timer");
+  }
   return true;
 }
 
 bool mme::is_nas_timer_running(nas_timer_type type, uint64_t imsi)
 {
+  std::lock_guard<std::mutex>        lock(m_timers_mutex);
   std::vector<mme_timer_t>::iterator it;
   for (it = timers.begin(); it != timers.end(); ++it) {
     if (it->type == type && it->imsi == imsi) {
@@ -217,6 +264,7 @@ bool mme::is_nas_timer_running(nas_timer_type type, uint64_t imsi)
 
 bool mme::remove_nas_timer(nas_timer_type type, uint64_t imsi)
 {
+  std::lock_guard<std::mutex>        lock(m_timers_mutex);
   std::vector<mme_timer_t>::iterator it;
   for (it = timers.begin(); it != timers.end(); ++it) {
     if (it->type == type && it->imsi == imsi) {
@@ -230,7 +278,6 @@ bool mme::remove_nas_timer(nas_timer_type type, uint64_t imsi)
 
   // removing timer
   m_s1ap_logger.debug("Removing NAS timer from MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, it->fd);
-  FD_CLR(it->fd, &m_set);
   close(it->fd);
   timers.erase(it);
   return true;
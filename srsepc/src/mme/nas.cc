@@ -21,6 +21,7 @@
 
 #include "srsepc/hdr/mme/s1ap.h"
 #include "srsepc/hdr/mme/s1ap_nas_transport.h"
+#include "srsran/adt/pool/mem_pool.h"
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/security.h"
 #include <cmath>
@@ -54,6 +55,22 @@ nas::nas(const nas_init_t& args, const nas_if_t& itf) :
   m_logger.debug("NAS Context Initialized. MCC: 0x%x, MNC 0x%x", m_mcc, m_mnc);
 }
 
+static srsran::big_obj_pool<nas, true>& get_nas_pool()
+{
+  static srsran::big_obj_pool<nas, true> pool;
+  return pool;
+}
+
+void* nas::operator new(size_t sz)
+{
+  return get_nas_pool().allocate_node(sz);
+}
+
+void nas::operator delete(void* p)
+{
+  get_nas_pool().deallocate_node(p);
+}
+
 void nas::reset()
 {
   m_emm_ctx = {};
@@ -2050,7 +2067,7 @@ bool nas::start_t3413()
     return false;
   }
 
-  int fdt = timerfd_create(CLOCK_MONOTONIC, 0);
+  int fdt = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
   if (fdt < 0) {
     m_logger.error("Error creating timer. %s", strerror(errno));
     return false;
@@ -22,6 +22,7 @@
 #include "srsepc/hdr/mme/s1ap.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/bcd_helpers.h"
+#include "srsran/common/int_helpers.h"
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/network_utils.h"
 #include <cmath>
@@ -33,7 +34,10 @@ namespace srsepc {
 s1ap*           s1ap::m_instance    = NULL;
 pthread_mutex_t s1ap_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-s1ap::s1ap() : m_s1mme(-1), m_next_mme_ue_s1ap_id(1), m_mme_gtpc(NULL) {}
+// Index of the S1AP/NAS worker running in this thread
+static thread_local uint32_t current_worker = 0;
+
+s1ap::s1ap() : m_s1mme(-1), m_mme_gtpc(NULL) {}
 
 s1ap::~s1ap()
 {
@@ -88,6 +92,19 @@ int s1ap::init(const s1ap_args_t& s1ap_args)
   // Get pointer to GTP-C class
   m_mme_gtpc = mme_gtpc::get_instance();
 
+  // Start the S1AP/NAS workers
+  m_next_mme_ue_s1ap_id.resize(std::max(s1ap_args.nof_workers, 1u));
+  for (uint32_t i = 0; i < m_next_mme_ue_s1ap_id.size(); ++i) {
+    m_next_mme_ue_s1ap_id[i] = i == 0 ? m_next_mme_ue_s1ap_id.size() : i;
+  }
+  for (uint32_t i = 0; i < s1ap_args.nof_workers; ++i) {
+    m_workers.emplace_back(new srsran::task_worker("MME_WORKER" + std::to_string(i), 8192));
+    m_workers.back()->push_task([i]() { current_worker = i; });
+  }
+  if (not m_workers.empty()) {
+    m_logger.info("Started %zd S1AP/NAS workers", m_workers.size());
+  }
+
   // Initialize S1-MME
   m_s1mme = enb_listen();
   if (m_s1mme == SRSRAN_ERROR) {
@@ -108,6 +125,11 @@ void s1ap::stop()
   if (m_s1mme != -1) {
     close(m_s1mme);
   }
+  for (std::unique_ptr<srsran::task_worker>& worker : m_workers) {
+    worker->stop();
+  }
+  m_workers.clear();
+
   std::map<uint16_t, enb_ctx_t*>::iterator enb_it = m_active_enbs.begin();
   while (enb_it != m_active_enbs.end()) {
     m_logger.info("Deleting eNB context. eNB Id: 0x%x", enb_it->second->enb_id);
@@ -116,13 +138,13 @@ void s1ap::stop()
     m_active_enbs.erase(enb_it++);
   }
 
-  std::map<uint64_t, nas*>::iterator ue_it = m_imsi_to_nas_ctx.begin();
-  while (ue_it != m_imsi_to_nas_ctx.end()) {
-    m_logger.info("Deleting UE EMM context. IMSI: %015" PRIu64 "", ue_it->first);
-    srsran::console("Deleting UE EMM context. IMSI: %015" PRIu64 "\n", ue_it->first);
-    delete ue_it->second;
-    m_imsi_to_nas_ctx.erase(ue_it++);
+  for (std::pair<uint64_t, nas*>& ue : m_imsi_to_nas_ctx) {
+    m_logger.info("Deleting UE EMM context. IMSI: %015" PRIu64 "", ue.first);
+    srsran::console("Deleting UE EMM context. IMSI: %015" PRIu64 "\n", ue.first);
+    delete ue.second;
   }
+  m_imsi_to_nas_ctx.clear();
+  m_mme_ue_s1ap_id_to_nas_ctx.clear();
 
   // Cleanup message handlers
   s1ap_mngmt_proc::cleanup();
@@ -143,7 +165,11 @@ int s1ap::get_s1_mme()
 
 uint32_t s1ap::get_next_mme_ue_s1ap_id()
 {
-  return m_next_mme_ue_s1ap_id++;
+  // Each worker allocates the IDs equal to its index modulo the number of workers, so no lock is needed
+  uint32_t& next_id = m_next_mme_ue_s1ap_id[current_worker];
+  uint32_t  id      = next_id;
+  next_id += m_next_mme_ue_s1ap_id.size();
+  return id;
 }
 
 int s1ap::enb_listen()
@@ -223,6 +249,7 @@ bool s1ap::s1ap_tx_pdu(const asn1::s1ap::s1ap_pdu_c& pdu, struct sctp_sndrcvinfo
   }
 
   if (m_pcap_enable) {
+    std::lock_guard<std::mutex> lock(m_pcap_mutex);
     m_pcap.write_s1ap(buf->msg, buf->N_bytes);
   }
 
@@ -233,17 +260,144 @@ void s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo
 {
   // Save PCAP
   if (m_pcap_enable) {
+    std::lock_guard<std::mutex> lock(m_pcap_mutex);
     m_pcap.write_s1ap(pdu->msg, pdu->N_bytes);
   }
 
+  // The messages of the S1 connections are handed over to the worker of the UE without decoding them here
+  asn1::s1ap::s1ap_pdu_peek_t peek;
+  if (asn1::s1ap::peek_s1ap_pdu(peek, pdu->msg, pdu->N_bytes) == asn1::SRSASN_SUCCESS) {
+    int worker = get_rx_pdu_worker(peek);
+    if (worker >= 0) {
+      std::unique_ptr<rx_buf_t> rx(new rx_buf_t);
+      rx->buf     = *pdu;
+      rx->enb_sri = *enb_sri;
+      m_workers[worker]->push_task([this, rx = std::move(rx)]() { decode_and_handle_s1ap_pdu(*rx); });
+      return;
+    }
+  }
+
   // Get PDU type
-  s1ap_pdu_t     rx_pdu;
-  asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
-  if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+  std::unique_ptr<rx_pdu_t> rx(new rx_pdu_t);
+  asn1::cbit_ref            bref(pdu->msg, pdu->N_bytes);
+  if (asn1::unpack_in_arena(rx->pdu, bref, rx->arena) != asn1::SRSASN_SUCCESS) {
+    m_logger.error("Failed to unpack received PDU");
+    return;
+  }
+  rx->enb_sri = *enb_sri;
+
+  // The Initial UE Messages are processed in the worker of the UE, the other messages in the MME thread
+  int worker = get_rx_pdu_worker(rx->pdu, enb_sri->sinfo_assoc_id);
+  if (worker < 0) {
+    handle_s1ap_pdu(rx->pdu, &rx->enb_sri);
+    return;
+  }
+  m_workers[worker]->push_task([this, rx = std::move(rx)]() { handle_s1ap_pdu(rx->pdu, &rx->enb_sri); });
+}
+
+void s1ap::decode_and_handle_s1ap_pdu(rx_buf_t& rx)
+{
+  asn1::static_decode_arena<S1AP_RX_ARENA_SIZE> arena;
+  s1ap_pdu_t                                    rx_pdu;
+  asn1::cbit_ref                                bref(rx.buf.msg, rx.buf.N_bytes);
+  if (asn1::unpack_in_arena(rx_pdu, bref, arena) != asn1::SRSASN_SUCCESS) {
     m_logger.error("Failed to unpack received PDU");
     return;
   }
+  handle_s1ap_pdu(rx_pdu, &rx.enb_sri);
+}
 
+int s1ap::get_rx_pdu_worker(const asn1::s1ap::s1ap_pdu_peek_t& peek)
+{
+  if (m_workers.empty() or not peek.mme_ue_s1ap_id_present) {
+    return -1;
+  }
+  switch (peek.pdu_type) {
+    case s1ap_pdu_t::types_opts::init_msg:
+      if (peek.proc_code == ASN1_S1AP_ID_UL_NAS_TRANSPORT or peek.proc_code == ASN1_S1AP_ID_UE_CONTEXT_RELEASE_REQUEST) {
+        return get_mme_ue_s1ap_id_worker(peek.mme_ue_s1ap_id);
+      }
+      break;
+    case s1ap_pdu_t::types_opts::successful_outcome:
+      // InitialContextSetupResponse and UEContextReleaseComplete
+      if (peek.proc_code == ASN1_S1AP_ID_INIT_CONTEXT_SETUP or peek.proc_code == ASN1_S1AP_ID_UE_CONTEXT_RELEASE) {
+        return get_mme_ue_s1ap_id_worker(peek.mme_ue_s1ap_id);
+      }
+      break;
+    default:
+      break;
+  }
+  return -1;
+}
+
+int s1ap::get_rx_pdu_worker(const s1ap_pdu_t& rx_pdu, int32_t enb_assoc)
+{
+  using init_msg_type_opts_t = asn1::s1ap::s1ap_elem_procs_o::init_msg_c::types_opts;
+
+  if (m_workers.empty() or rx_pdu.type().value != s1ap_pdu_t::types_opts::init_msg or
+      rx_pdu.init_msg().value.type().value != init_msg_type_opts_t::init_ue_msg) {
+    return -1;
+  }
+
+  // The S1 connection is set up in the worker of the UE, if it is known, or in any worker otherwise
+  const asn1::s1ap::init_ue_msg_s& init_ue = rx_pdu.init_msg().value.init_ue_msg();
+  uint64_t                         imsi    = find_imsi_from_initial_ue_msg(init_ue);
+  if (imsi != 0) {
+    return get_imsi_worker(imsi);
+  }
+  return ((uint32_t)enb_assoc * 31 + init_ue->enb_ue_s1ap_id.value.value) % m_workers.size();
+}
+
+uint64_t s1ap::find_imsi_from_initial_ue_msg(const asn1::s1ap::init_ue_msg_s& init_ue)
+{
+  // Service, detach and TAU requests identify the UE with the S-TMSI
+  if (init_ue->s_tmsi_present) {
+    uint32_t m_tmsi = 0;
+    srsran::uint8_to_uint32(init_ue->s_tmsi.value.m_tmsi.data(), &m_tmsi);
+    return find_imsi_from_m_tmsi(m_tmsi);
+  }
+
+  // Attach requests carry the IMSI or the GUTI
+  srsran::unique_byte_buffer_t nas_msg = srsran::make_byte_buffer();
+  if (nas_msg == nullptr or init_ue->nas_pdu.value.size() > nas_msg->get_tailroom()) {
+    return 0;
+  }
+  memcpy(nas_msg->msg, init_ue->nas_pdu.value.data(), init_ue->nas_pdu.value.size());
+  nas_msg->N_bytes = init_ue->nas_pdu.value.size();
+
+  uint8_t pd, msg_type;
+  liblte_mme_parse_msg_header((LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get(), &pd, &msg_type);
+  if (msg_type != LIBLTE_MME_MSG_TYPE_ATTACH_REQUEST) {
+    return 0;
+  }
+  LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT attach_req = {};
+  if (liblte_mme_unpack_attach_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get(), &attach_req) != LIBLTE_SUCCESS) {
+    return 0;
+  }
+  if (attach_req.eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI) {
+    uint64_t imsi = 0;
+    for (int i = 0; i <= 14; i++) {
+      imsi = imsi * 10 + attach_req.eps_mobile_id.imsi[i];
+    }
+    return imsi;
+  }
+  if (attach_req.eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI) {
+    return find_imsi_from_m_tmsi(attach_req.eps_mobile_id.guti.m_tmsi);
+  }
+  return 0;
+}
+
+void s1ap::push_ue_task(uint64_t imsi, worker_task_t task)
+{
+  if (m_workers.empty()) {
+    task();
+    return;
+  }
+  m_workers[get_imsi_worker(imsi)]->push_task(std::move(task));
+}
+
+void s1ap::handle_s1ap_pdu(const s1ap_pdu_t& rx_pdu, struct sctp_sndrcvinfo* enb_sri)
+{
   switch (rx_pdu.type().value) {
     case s1ap_pdu_t::types_opts::init_msg:
       m_logger.info("Received Initiating PDU");
@@ -313,17 +467,18 @@ void s1ap::handle_successful_outcome(const asn1::s1ap::successful_outcome_s& msg
 // eNB Context Managment
 void s1ap::add_new_enb_ctx(const enb_ctx_t& enb_ctx, const struct sctp_sndrcvinfo* enb_sri)
 {
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
   m_logger.info("Adding new eNB context. eNB ID %d", enb_ctx.enb_id);
-  std::set<uint32_t> ue_set;
-  enb_ctx_t*         enb_ptr = new enb_ctx_t;
-  *enb_ptr                   = enb_ctx;
+  enb_ctx_t* enb_ptr = new enb_ctx_t;
+  *enb_ptr           = enb_ctx;
   m_active_enbs.emplace(enb_ptr->enb_id, enb_ptr);
   m_sctp_to_enb_id.emplace(enb_sri->sinfo_assoc_id, enb_ptr->enb_id);
-  m_enb_assoc_to_ue_ids.emplace(enb_sri->sinfo_assoc_id, ue_set);
+  m_enb_assoc_to_ue_ids.emplace(enb_sri->sinfo_assoc_id);
 }
 
 enb_ctx_t* s1ap::find_enb_ctx(uint16_t enb_id)
 {
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
   std::map<uint16_t, enb_ctx_t*>::iterator it = m_active_enbs.find(enb_id);
   if (it == m_active_enbs.end()) {
     return nullptr;
@@ -334,11 +489,16 @@ enb_ctx_t* s1ap::find_enb_ctx(uint16_t enb_id)
 
 void s1ap::delete_enb_ctx(int32_t assoc_id)
 {
+  std::unique_lock<std::mutex>          lock(m_ctx_mutex);
   std::map<int32_t, uint16_t>::iterator it_assoc = m_sctp_to_enb_id.find(assoc_id);
-  uint16_t                              enb_id   = it_assoc->second;
+  if (it_assoc == m_sctp_to_enb_id.end()) {
+    m_logger.error("Could not find eNB to delete. Association: %d", assoc_id);
+    return;
+  }
+  uint16_t enb_id = it_assoc->second;
 
   std::map<uint16_t, enb_ctx_t*>::iterator it_ctx = m_active_enbs.find(enb_id);
-  if (it_ctx == m_active_enbs.end() || it_assoc == m_sctp_to_enb_id.end()) {
+  if (it_ctx == m_active_enbs.end()) {
     m_logger.error("Could not find eNB to delete. Association: %d", assoc_id);
     return;
   }
@@ -347,7 +507,9 @@ void s1ap::delete_enb_ctx(int32_t assoc_id)
   srsran::console("Deleting eNB context. eNB Id: 0x%x\n", enb_id);
 
   // Delete connected UEs ctx
+  lock.unlock();
   release_ues_ecm_ctx_in_enb(assoc_id);
+  lock.lock();
 
   // Delete eNB
   delete it_ctx->second;
@@ -359,13 +521,14 @@ void s1ap::delete_enb_ctx(int32_t assoc_id)
 // UE Context Management
 bool s1ap::add_nas_ctx_to_imsi_map(nas* nas_ctx)
 {
-  std::map<uint64_t, nas*>::iterator ctx_it = m_imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  auto ctx_it = m_imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
   if (ctx_it != m_imsi_to_nas_ctx.end()) {
     m_logger.error("UE Context already exists. IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
   if (nas_ctx->m_ecm_ctx.mme_ue_s1ap_id != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    auto ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
     if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
       m_logger.error("Context identified with IMSI does not match context identified by MME UE S1AP Id.");
       return false;
@@ -378,17 +541,18 @@ bool s1ap::add_nas_ctx_to_imsi_map(nas* nas_ctx)
 
 bool s1ap::add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx)
 {
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
   if (nas_ctx->m_ecm_ctx.mme_ue_s1ap_id == 0) {
     m_logger.error("Could not add UE context to MME UE S1AP map. MME UE S1AP ID 0 is not valid.");
     return false;
   }
-  std::map<uint32_t, nas*>::iterator ctx_it = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+  auto ctx_it = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
   if (ctx_it != m_mme_ue_s1ap_id_to_nas_ctx.end()) {
     m_logger.error("UE Context already exists. MME UE S1AP Id %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
   if (nas_ctx->m_emm_ctx.imsi != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    auto ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
     if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
       m_logger.error("Context identified with MME UE S1AP Id does not match context identified by IMSI.");
       return false;
@@ -401,13 +565,13 @@ bool s1ap::add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx)
 
 bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
 {
-  std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  auto ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
   if (ues_in_enb == m_enb_assoc_to_ue_ids.end()) {
     m_logger.error("Could not find eNB from eNB SCTP association %d", enb_assoc);
     return false;
   }
-  std::set<uint32_t>::iterator ue_id = ues_in_enb->second.find(mme_ue_s1ap_id);
-  if (ue_id != ues_in_enb->second.end()) {
+  if (ues_in_enb->second.contains(mme_ue_s1ap_id)) {
     m_logger.error("UE with MME UE S1AP Id already exists %d", mme_ue_s1ap_id);
     return false;
   }
@@ -418,7 +582,8 @@ bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
 
 nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 {
-  std::map<uint32_t, nas*>::iterator it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  auto it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
   if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
     return NULL;
   } else {
@@ -428,7 +593,8 @@ nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 
 nas* s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
 {
-  std::map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  auto it = m_imsi_to_nas_ctx.find(imsi);
   if (it == m_imsi_to_nas_ctx.end()) {
     return NULL;
   } else {
@@ -439,48 +605,71 @@ nas* s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
 void s1ap::release_ues_ecm_ctx_in_enb(int32_t enb_assoc)
 {
   srsran::console("Releasing UEs context\n");
-  std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
-  std::set<uint32_t>::iterator                     ue_id      = ues_in_enb->second.begin();
-  if (ue_id == ues_in_enb->second.end()) {
+  std::vector<uint32_t> ue_ids;
+  {
+    std::lock_guard<std::mutex> lock(m_ctx_mutex);
+    auto                        ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
+    if (ues_in_enb != m_enb_assoc_to_ue_ids.end()) {
+      ue_ids.assign(ues_in_enb->second.begin(), ues_in_enb->second.end());
+      ues_in_enb->second.clear();
+    }
+  }
+  if (ue_ids.empty()) {
     srsran::console("No UEs to be released\n");
-  } else {
-    while (ue_id != ues_in_enb->second.end()) {
-      std::map<uint32_t, nas*>::iterator nas_ctx = m_mme_ue_s1ap_id_to_nas_ctx.find(*ue_id);
-      emm_ctx_t*                         emm_ctx = &nas_ctx->second->m_emm_ctx;
-      ecm_ctx_t*                         ecm_ctx = &nas_ctx->second->m_ecm_ctx;
-
-      m_logger.info(
-          "Releasing UE context. IMSI: %015" PRIu64 ", UE-MME S1AP Id: %d", emm_ctx->imsi, ecm_ctx->mme_ue_s1ap_id);
-      if (emm_ctx->state == EMM_STATE_REGISTERED) {
-        m_mme_gtpc->send_delete_session_request(emm_ctx->imsi);
-        emm_ctx->state = EMM_STATE_DEREGISTERED;
-      }
-      srsran::console("Releasing UE ECM context. UE-MME S1AP Id: %d\n", ecm_ctx->mme_ue_s1ap_id);
-      ecm_ctx->state          = ECM_STATE_IDLE;
-      ecm_ctx->mme_ue_s1ap_id = 0;
-      ecm_ctx->enb_ue_s1ap_id = 0;
-      ues_in_enb->second.erase(ue_id++);
+    return;
+  }
+
+  // The contexts are released in the workers of the S1 connections, in order with their pending messages
+  for (uint32_t ue_id : ue_ids) {
+    if (m_workers.empty()) {
+      release_ue_ecm_ctx_in_lost_enb(ue_id);
+    } else {
+      m_workers[get_mme_ue_s1ap_id_worker(ue_id)]->push_task(
+          [this, ue_id]() { release_ue_ecm_ctx_in_lost_enb(ue_id); });
     }
   }
 }
 
-bool s1ap::release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
+void s1ap::release_ue_ecm_ctx_in_lost_enb(uint32_t mme_ue_s1ap_id)
 {
   nas* nas_ctx = find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
   if (nas_ctx == NULL) {
     m_logger.error("Cannot release UE ECM context, UE not found. MME-UE S1AP Id: %d", mme_ue_s1ap_id);
-    return false;
+    return;
   }
+  emm_ctx_t* emm_ctx = &nas_ctx->m_emm_ctx;
   ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
 
+  m_logger.info(
+      "Releasing UE context. IMSI: %015" PRIu64 ", UE-MME S1AP Id: %d", emm_ctx->imsi, ecm_ctx->mme_ue_s1ap_id);
+  if (emm_ctx->state == EMM_STATE_REGISTERED) {
+    m_mme_gtpc->send_delete_session_request(emm_ctx->imsi);
+    emm_ctx->state = EMM_STATE_DEREGISTERED;
+  }
+  srsran::console("Releasing UE ECM context. UE-MME S1AP Id: %d\n", ecm_ctx->mme_ue_s1ap_id);
+  ecm_ctx->state          = ECM_STATE_IDLE;
+  ecm_ctx->mme_ue_s1ap_id = 0;
+  ecm_ctx->enb_ue_s1ap_id = 0;
+}
+
+bool s1ap::release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
+{
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  auto                        nas_it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
+  if (nas_it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
+    m_logger.error("Cannot release UE ECM context, UE not found. MME-UE S1AP Id: %d", mme_ue_s1ap_id);
+    return false;
+  }
+  ecm_ctx_t* ecm_ctx = &nas_it->second->m_ecm_ctx;
+
   // Delete UE within eNB UE set
   std::map<int32_t, uint16_t>::iterator it = m_sctp_to_enb_id.find(ecm_ctx->enb_sri.sinfo_assoc_id);
   if (it == m_sctp_to_enb_id.end()) {
     m_logger.error("Could not find eNB for UE release request.");
     return false;
   }
-  uint16_t                                         enb_id = it->second;
-  std::map<int32_t, std::set<uint32_t> >::iterator ue_set = m_enb_assoc_to_ue_ids.find(ecm_ctx->enb_sri.sinfo_assoc_id);
+  uint16_t enb_id = it->second;
+  auto     ue_set = m_enb_assoc_to_ue_ids.find(ecm_ctx->enb_sri.sinfo_assoc_id);
   if (ue_set == m_enb_assoc_to_ue_ids.end()) {
     m_logger.error("Could not find the eNB's UEs.");
     return false;
@@ -511,7 +700,10 @@ bool s1ap::delete_ue_ctx(uint64_t imsi)
   }
 
   // Delete UE context
-  m_imsi_to_nas_ctx.erase(imsi);
+  {
+    std::lock_guard<std::mutex> lock(m_ctx_mutex);
+    m_imsi_to_nas_ctx.erase(imsi);
+  }
   delete nas_ctx;
   m_logger.info("Deleted UE Context.");
   return true;
@@ -520,14 +712,15 @@ bool s1ap::delete_ue_ctx(uint64_t imsi)
 // UE Bearer Managment
 void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 {
-  std::map<uint64_t, nas*>::iterator ue_ctx_it = m_imsi_to_nas_ctx.find(imsi);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  auto ue_ctx_it = m_imsi_to_nas_ctx.find(imsi);
   if (ue_ctx_it == m_imsi_to_nas_ctx.end()) {
     m_logger.error("Could not activate EPS bearer: Could not find UE context");
     return;
   }
   // Make sure NAS is active
-  uint32_t                           mme_ue_s1ap_id = ue_ctx_it->second->m_ecm_ctx.mme_ue_s1ap_id;
-  std::map<uint32_t, nas*>::iterator it             = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
+  uint32_t mme_ue_s1ap_id = ue_ctx_it->second->m_ecm_ctx.mme_ue_s1ap_id;
+  auto     it             = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
   if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
     m_logger.error("Could not activate EPS bearer: ECM context seems to be missing");
     return;
@@ -557,6 +750,7 @@ void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 
 uint32_t s1ap::allocate_m_tmsi(uint64_t imsi)
 {
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
   uint32_t m_tmsi = m_next_m_tmsi;
   m_next_m_tmsi   = (m_next_m_tmsi + 1) % UINT32_MAX;
 
@@ -567,7 +761,8 @@ uint32_t s1ap::allocate_m_tmsi(uint64_t imsi)
 
 uint64_t s1ap::find_imsi_from_m_tmsi(uint32_t m_tmsi)
 {
-  std::map<uint32_t, uint64_t>::iterator it = m_tmsi_to_imsi.find(m_tmsi);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  auto it = m_tmsi_to_imsi.find(m_tmsi);
   if (it != m_tmsi_to_imsi.end()) {
     m_logger.debug("Found IMSI %015" PRIu64 " from M-TMSI 0x%x", it->second, m_tmsi);
     return it->second;
@@ -268,10 +268,8 @@ void spgw::gtpc::handle_modify_bearer_request(const struct srsran::gtpc_header&
   addr3.s_addr = tunnel_ctx->dw_user_fteid.ipv4;
   m_logger.info("eNB Rx User TEID 0x%x, eNB Rx User IP %s", tunnel_ctx->dw_user_fteid.teid, inet_ntoa(addr3));
 
-  // Setup IP to F-TEID map
-  m_gtpu->modify_gtpu_tunnel(tunnel_ctx->ue_ipv4, tunnel_ctx->dw_user_fteid, tunnel_ctx->up_ctrl_fteid.teid);
-
-  // Mark paging as done & send queued packets
+  // Mark paging as done & send queued packets. They are sent before the tunnel is set up, so that they go before the
+  // packets forwarded by the user plane threads once the tunnel is found
   if (tunnel_ctx->paging_pending == true) {
     tunnel_ctx->paging_pending = false;
     m_logger.debug("Modify Bearer Request received after Downling Data Notification was sent");
@@ -279,6 +277,9 @@ void spgw::gtpc::handle_modify_bearer_request(const struct srsran::gtpc_header&
     m_gtpu->send_all_queued_packets(tunnel_ctx->dw_user_fteid, tunnel_ctx->paging_queue);
   }
 
+  // Setup IP to F-TEID map
+  m_gtpu->modify_gtpu_tunnel(tunnel_ctx->ue_ipv4, tunnel_ctx->dw_user_fteid, tunnel_ctx->up_ctrl_fteid.teid);
+
   // Setting up Modify bearer response PDU
   // Header
   srsran::gtpc_pdu mb_resp_pdu;
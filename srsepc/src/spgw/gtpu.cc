@@ -23,20 +23,80 @@
 #include "srsepc/hdr/mme/mme_gtpc.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/common/network_utils.h"
+#include "srsran/common/tun_utils.h"
 #include "srsran/upper/gtpu.h"
 #include <algorithm>
 #include <arpa/inet.h>
+#include <atomic>
 #include <fcntl.h>
 #include <inttypes.h> // for printing uint64_t
+#include <linux/filter.h>
 #include <linux/if.h>
 #include <linux/if_tun.h>
 #include <linux/ip.h>
 #include <netinet/in.h>
 #include <sys/ioctl.h>
+#include <sys/select.h>
 #include <sys/socket.h>
 
 namespace srsepc {
 
+/**************************************
+ *
+ * User plane thread, handles the
+ * packets of one TUN queue and S1-U
+ * socket
+ *
+ **************************************/
+
+class spgw::gtpu::up_worker : public srsran::thread
+{
+public:
+  up_worker(gtpu* parent_, uint32_t queue_idx_) :
+    thread("SPGW_UP" + std::to_string(queue_idx_)), parent(parent_), queue_idx(queue_idx_)
+  {}
+
+  void stop()
+  {
+    running = false;
+    wait_thread_finish();
+  }
+
+private:
+  void run_thread() override
+  {
+    int sgi = parent->m_up_queues[queue_idx].sgi;
+    int s1u = parent->m_up_queues[queue_idx].s1u;
+
+    fd_set set;
+    while (running) {
+      FD_ZERO(&set);
+      FD_SET(sgi, &set);
+      FD_SET(s1u, &set);
+
+      // Wake up periodically to check whether the thread has to stop
+      struct timeval timeout = {0, 100000};
+      int            n       = select(std::max(sgi, s1u) + 1, &set, NULL, NULL, &timeout);
+      if (n == -1) {
+        if (errno != EINTR) {
+          parent->m_logger.error("Error from select in user plane thread %d: %s", queue_idx, strerror(errno));
+        }
+        continue;
+      }
+      if (FD_ISSET(sgi, &set)) {
+        parent->handle_sgi_packets(queue_idx);
+      }
+      if (FD_ISSET(s1u, &set)) {
+        parent->handle_s1u_packets(queue_idx);
+      }
+    }
+  }
+
+  gtpu*             parent;
+  uint32_t          queue_idx;
+  std::atomic<bool> running = {true};
+};
+
 /**************************************
  *
  * GTP-U class that handles the packet
@@ -62,6 +122,15 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
   m_spgw = spgw;
   m_gtpc = gtpc;
 
+  m_sgi_vnet_hdr = args->sgi_vnet_hdr;
+
+  // One TUN queue and S1-U socket per user plane thread, or a single one handled by the SP-GW thread
+  uint32_t nof_queues = std::max(args->nof_up_threads, 1u);
+  m_up_queues.resize(nof_queues);
+  for (uint32_t i = 0; i < nof_queues; ++i) {
+    m_tunnel_shards.emplace_back(new tunnel_shard_t);
+  }
+
   // Init SGi interface
   err = init_sgi(args);
   if (err != SRSRAN_SUCCESS) {
@@ -76,6 +145,15 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
     return err;
   }
 
+  // Start the user plane threads
+  for (uint32_t i = 0; i < args->nof_up_threads; ++i) {
+    m_up_workers.emplace_back(new up_worker(this, i));
+    m_up_workers.back()->start();
+  }
+  if (not m_up_workers.empty()) {
+    m_logger.info("Started %zd user plane threads", m_up_workers.size());
+  }
+
   m_logger.info("SPGW GTP-U Initialized.");
   srsran::console("SPGW GTP-U Initialized.\n");
   return SRSRAN_SUCCESS;
@@ -83,14 +161,33 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
 
 void spgw::gtpu::stop()
 {
-  // Clean up SGi interface
-  if (m_sgi_up) {
-    close(m_sgi);
+  stop_up_workers();
+
+  for (up_queue_t& queue : m_up_queues) {
+    // Clean up SGi interface
+    if (m_sgi_up and queue.sgi >= 0) {
+      close(queue.sgi);
+    }
+    // Clean up S1-U socket
+    if (m_s1u_up and queue.s1u >= 0) {
+      close(queue.s1u);
+    }
+    queue.sgi = -1;
+    queue.s1u = -1;
   }
-  // Clean up S1-U socket
-  if (m_s1u_up) {
-    close(m_s1u);
+}
+
+void spgw::gtpu::stop_up_workers()
+{
+  for (std::unique_ptr<up_worker>& worker : m_up_workers) {
+    worker->stop();
   }
+  m_up_workers.clear();
+}
+
+spgw::gtpu::tunnel_shard_t& spgw::gtpu::get_tunnel_shard(in_addr_t ue_ipv4)
+{
+  return *m_tunnel_shards[ntohl(ue_ipv4) % m_tunnel_shards.size()];
 }
 
 int spgw::gtpu::init_sgi(spgw_args_t* args)
@@ -102,24 +199,47 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
     return SRSRAN_ERROR_ALREADY_STARTED;
   }
 
-  // Construct the TUN device
-  m_sgi = open("/dev/net/tun", O_RDWR);
-  m_logger.info("TUN file descriptor = %d", m_sgi);
-  if (m_sgi < 0) {
-    m_logger.error("Failed to open TUN device: %s", strerror(errno));
-    return SRSRAN_ERROR_CANT_START;
+  // Construct the TUN device, with a queue per user plane thread. The queues are read in batches until they are empty
+  uint32_t nof_queues = m_up_queues.size();
+  for (uint32_t i = 0; i < nof_queues; ++i) {
+    int& sgi = m_up_queues[i].sgi;
+    sgi      = open("/dev/net/tun", O_RDWR | O_NONBLOCK);
+    m_logger.info("TUN file descriptor = %d", sgi);
+    if (sgi < 0) {
+      m_logger.error("Failed to open TUN device: %s", strerror(errno));
+      return SRSRAN_ERROR_CANT_START;
+    }
+    m_sgi_up = true;
+
+    memset(&ifr, 0, sizeof(ifr));
+    ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+    if (nof_queues > 1) {
+      ifr.ifr_flags |= IFF_MULTI_QUEUE;
+    }
+    if (m_sgi_vnet_hdr) {
+      ifr.ifr_flags |= IFF_VNET_HDR;
+    }
+    strncpy(ifr.ifr_ifrn.ifrn_name,
+            args->sgi_if_name.c_str(),
+            std::min(args->sgi_if_name.length(), (size_t)(IFNAMSIZ - 1)));
+    ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = '\0';
+
+    if (ioctl(sgi, TUNSETIFF, &ifr) < 0) {
+      m_logger.error("Failed to set TUN device name: %s", strerror(errno));
+      return SRSRAN_ERROR_CANT_START;
+    }
+
+    if (m_sgi_vnet_hdr) {
+      if (not srsran::tun_vnet_enable_offloads(sgi)) {
+        m_logger.warning("Failed to enable the TUN segmentation offloads: %s", strerror(errno));
+      }
+      m_up_queues[i].sgi_frame.resize(srsran::tun_vnet_max_frame_size);
+    }
   }
 
-  memset(&ifr, 0, sizeof(ifr));
-  ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
-  strncpy(
-      ifr.ifr_ifrn.ifrn_name, args->sgi_if_name.c_str(), std::min(args->sgi_if_name.length(), (size_t)(IFNAMSIZ - 1)));
-  ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = '\0';
-
-  if (ioctl(m_sgi, TUNSETIFF, &ifr) < 0) {
-    m_logger.error("Failed to set TUN device name: %s", strerror(errno));
-    close(m_sgi);
-    return SRSRAN_ERROR_CANT_START;
+  // Spread the downlink packets across the queues by UE IP, so that the tunnels of a UE are used by a single thread
+  if (nof_queues > 1 and not srsran::tun_set_steering_by_daddr(m_up_queues[0].sgi)) {
+    m_logger.warning("Failed to steer the TUN queues by UE IP, the packets are spread by flow: %s", strerror(errno));
   }
 
   // Bring up the interface
@@ -127,7 +247,6 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   if (ioctl(sgi_sock, SIOCGIFFLAGS, &ifr) < 0) {
     m_logger.error("Failed to bring up socket: %s", strerror(errno));
     close(sgi_sock);
-    close(m_sgi);
     return SRSRAN_ERROR_CANT_START;
   }
 
@@ -135,7 +254,6 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   if (ioctl(sgi_sock, SIOCSIFFLAGS, &ifr) < 0) {
     m_logger.error("Failed to set socket flags: %s", strerror(errno));
     close(sgi_sock);
-    close(m_sgi);
     return SRSRAN_ERROR_CANT_START;
   }
 
@@ -150,7 +268,6 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   if (ioctl(sgi_sock, SIOCSIFADDR, &ifr) < 0) {
     m_logger.error(
         "Failed to set TUN interface IP. Address: %s, Error: %s", args->sgi_if_addr.c_str(), strerror(errno));
-    close(m_sgi);
     close(sgi_sock);
     return SRSRAN_ERROR_CANT_START;
   }
@@ -162,57 +279,138 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   }
   if (ioctl(sgi_sock, SIOCSIFNETMASK, &ifr) < 0) {
     m_logger.error("Failed to set TUN interface Netmask. Error: %s", strerror(errno));
-    close(m_sgi);
     close(sgi_sock);
     return SRSRAN_ERROR_CANT_START;
   }
 
   close(sgi_sock);
-  m_sgi_up = true;
   m_logger.info("Initialized SGi interface");
   return SRSRAN_SUCCESS;
 }
 
 int spgw::gtpu::init_s1u(spgw_args_t* args)
 {
-  // Open S1-U socket
-  m_s1u = socket(AF_INET, SOCK_DGRAM, 0);
-  if (m_s1u == -1) {
-    m_logger.error("Failed to open socket: %s", strerror(errno));
-    return SRSRAN_ERROR_CANT_START;
-  }
-  m_s1u_up = true;
-
-  // Bind the socket
-  m_s1u_addr.sin_family      = AF_INET;
+  m_s1u_addr.sin_family = AF_INET;
   if (inet_pton(m_s1u_addr.sin_family, args->gtpu_bind_addr.c_str(), &m_s1u_addr.sin_addr.s_addr) != 1) {
     m_logger.error("Invalid gtpu_bind_addr: %s", args->gtpu_bind_addr.c_str());
     srsran::console("Invalid gtpu_bind_addr: %s\n", args->gtpu_bind_addr.c_str());
     return SRSRAN_ERROR_CANT_START;
   }
-  m_s1u_addr.sin_port        = htons(GTPU_RX_PORT);
-
-  if (bind(m_s1u, (struct sockaddr*)&m_s1u_addr, sizeof(struct sockaddr_in))) {
-    m_logger.error("Failed to bind socket: %s", strerror(errno));
-    return SRSRAN_ERROR_CANT_START;
+  m_s1u_addr.sin_port = htons(GTPU_RX_PORT);
+
+  // Open an S1-U socket per user plane thread, all of them bound to the S1-U address
+  bool reuse_port = m_up_queues.size() > 1;
+  for (up_queue_t& queue : m_up_queues) {
+    queue.s1u = socket(AF_INET, SOCK_DGRAM, 0);
+    if (queue.s1u == -1) {
+      m_logger.error("Failed to open socket: %s", strerror(errno));
+      return SRSRAN_ERROR_CANT_START;
+    }
+    m_s1u_up = true;
+
+    int enable = 1;
+    if (reuse_port and setsockopt(queue.s1u, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0) {
+      m_logger.error("Failed to set SO_REUSEPORT: %s", strerror(errno));
+      return SRSRAN_ERROR_CANT_START;
+    }
+
+    // Bind the socket
+    if (bind(queue.s1u, (struct sockaddr*)&m_s1u_addr, sizeof(struct sockaddr_in))) {
+      m_logger.error("Failed to bind socket: %s", strerror(errno));
+      return SRSRAN_ERROR_CANT_START;
+    }
+    m_logger.info("S1-U socket = %d", queue.s1u);
   }
-  m_logger.info("S1-U socket = %d", m_s1u);
   m_logger.info("S1-U IP = %s, Port = %d ", inet_ntoa(m_s1u_addr.sin_addr), ntohs(m_s1u_addr.sin_port));
 
+  // All the G-PDUs of an eNB have the same addresses and ports, so spread them across the sockets by TEID. The filter
+  // runs with the UDP payload at offset 0 and returns the index of the socket within the group
+  if (reuse_port) {
+    struct sock_filter code[] = {
+        {BPF_LD | BPF_W | BPF_ABS, 0, 0, 4},
+        {BPF_ALU | BPF_MOD | BPF_K, 0, 0, (uint32_t)m_up_queues.size()},
+        {BPF_RET | BPF_A, 0, 0, 0},
+    };
+    struct sock_fprog prog = {sizeof(code) / sizeof(code[0]), code};
+    if (setsockopt(m_up_queues[0].s1u, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) < 0) {
+      m_logger.warning("Failed to spread the G-PDUs by TEID, they are spread by source address: %s", strerror(errno));
+    }
+  }
+
   m_logger.info("Initialized S1-U interface");
   return SRSRAN_SUCCESS;
 }
 
-void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
+void spgw::gtpu::handle_sgi_packets(uint32_t queue_idx)
+{
+  up_queue_t&    queue = m_up_queues[queue_idx];
+  s1u_tx_batch_t tx_batch;
+
+  size_t buf_len = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  for (uint32_t i = 0; i < max_batch_size; ++i) {
+    /*
+     * SGi messages may need to be queued when waiting for UE Paging procedure.
+     * For this reason, buffers for SGi pdus are allocated here and deallocated
+     * once the G-PDU is sent, at handle_sgi_pdu() when the PDU is dropped or at
+     * gtpc::free_all_queued_packets, which is called when the Downlink Data Notification
+     * procedure fails (see handle_downlink_data_notification_acknowledgment and
+     * handle_downlink_data_notification_failure)
+     */
+    if (m_sgi_vnet_hdr) {
+      if (not handle_sgi_frame(queue, tx_batch)) {
+        break;
+      }
+      continue;
+    }
+
+    srsran::unique_byte_buffer_t msg = srsran::make_byte_buffer("spgw::gtpu::handle_sgi_packets");
+    if (msg == nullptr) {
+      break;
+    }
+    int n = read(queue.sgi, msg->msg, buf_len);
+    if (n <= 0) {
+      // The TUN queue is empty
+      break;
+    }
+    msg->N_bytes = n;
+    m_logger.debug("Message received at SPGW: SGi Message");
+    handle_sgi_pdu(std::move(msg), tx_batch);
+  }
+
+  send_s1u_batch(queue.s1u, tx_batch);
+}
+
+// Reads a packet from the SGi queue with its virtio_net_hdr and handles the IP packets it is split into. The TCP
+// segments coalesced by the kernel do not fit in a byte buffer. Returns false if the queue is empty
+bool spgw::gtpu::handle_sgi_frame(up_queue_t& queue, s1u_tx_batch_t& tx_batch)
+{
+  int n = read(queue.sgi, queue.sgi_frame.data(), queue.sgi_frame.size());
+  if (n <= 0) {
+    return false;
+  }
+  queue.sgi_pkts.clear();
+  if (srsran::tun_vnet_split(queue.sgi_frame.data(), n, queue.sgi_pkts) < 0) {
+    m_logger.warning("Failed to split the %d B packet read from the SGi interface. Dropping packet.", n);
+    return true;
+  }
+  for (srsran::unique_byte_buffer_t& msg : queue.sgi_pkts) {
+    if (tx_batch.size == max_batch_size) {
+      send_s1u_batch(queue.s1u, tx_batch);
+    }
+    m_logger.debug("Message received at SPGW: SGi Message");
+    handle_sgi_pdu(std::move(msg), tx_batch);
+  }
+  return true;
+}
+
+void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg, s1u_tx_batch_t& tx_batch)
 {
   bool usr_found = false;
   bool ctr_found = false;
 
-  std::map<uint32_t, srsran::gtpc_f_teid_ie>::iterator gtpu_fteid_it;
-  std::map<in_addr_t, uint32_t>::iterator              gtpc_teid_it;
-  srsran::gtpc_f_teid_ie                               enb_fteid;
-  uint32_t                                             spgw_teid;
-  struct iphdr*                                        iph = (struct iphdr*)msg->msg;
+  srsran::gtpc_f_teid_ie enb_fteid;
+  uint32_t               spgw_teid;
+  struct iphdr*          iph = (struct iphdr*)msg->msg;
   m_logger.debug("Received SGi PDU. Bytes %d", msg->N_bytes);
 
   if (iph->version != 4) {
@@ -225,50 +423,116 @@ void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
   }
 
   // Logging PDU info
-  m_logger.debug("SGi PDU -- IP version %d, Total length %d", int(iph->version), ntohs(iph->tot_len));
-  fmt::memory_buffer buffer;
-  srsran::gtpu_ntoa(buffer, iph->saddr);
-  m_logger.debug("SGi PDU -- IP src addr %s", srsran::to_c_str(buffer));
-  buffer.clear();
-  srsran::gtpu_ntoa(buffer, iph->daddr);
-  m_logger.debug("SGi PDU -- IP dst addr %s", srsran::to_c_str(buffer));
+  if (m_logger.debug.enabled()) {
+    m_logger.debug("SGi PDU -- IP version %d, Total length %d", int(iph->version), ntohs(iph->tot_len));
+    fmt::memory_buffer buffer;
+    srsran::gtpu_ntoa(buffer, iph->saddr);
+    m_logger.debug("SGi PDU -- IP src addr %s", srsran::to_c_str(buffer));
+    buffer.clear();
+    srsran::gtpu_ntoa(buffer, iph->daddr);
+    m_logger.debug("SGi PDU -- IP dst addr %s", srsran::to_c_str(buffer));
+  }
 
   // Find user and control tunnel
-  gtpu_fteid_it = m_ip_to_usr_teid.find(iph->daddr);
-  if (gtpu_fteid_it != m_ip_to_usr_teid.end()) {
-    usr_found = true;
-    enb_fteid = gtpu_fteid_it->second;
-  }
-  gtpc_teid_it = m_ip_to_ctr_teid.find(iph->daddr);
-  if (gtpc_teid_it != m_ip_to_ctr_teid.end()) {
-    ctr_found = true;
-    spgw_teid = gtpc_teid_it->second;
+  tunnel_shard_t& shard = get_tunnel_shard(iph->daddr);
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto                        gtpu_fteid_it = shard.ip_to_usr_teid.find(iph->daddr);
+    if (gtpu_fteid_it != shard.ip_to_usr_teid.end()) {
+      usr_found = true;
+      enb_fteid = gtpu_fteid_it->second;
+    }
+    auto gtpc_teid_it = shard.ip_to_ctr_teid.find(iph->daddr);
+    if (gtpc_teid_it != shard.ip_to_ctr_teid.end()) {
+      ctr_found = true;
+      spgw_teid = gtpc_teid_it->second;
+    }
   }
 
   // Handle SGi packet
   if (usr_found == false && ctr_found == false) {
     m_logger.debug("Packet for unknown UE.");
   } else if (usr_found == false && ctr_found == true) {
-    m_logger.debug("Packet for attached UE that is not ECM connected.");
-    m_logger.debug("Triggering Donwlink Notification Requset.");
-    m_gtpc->send_downlink_data_notification(spgw_teid);
-    m_gtpc->queue_downlink_packet(spgw_teid, std::move(msg));
-    return;
+    // The paging state is kept by GTP-C, shared with the S11 handling. The packets queued during paging are sent
+    // before the user plane tunnel is set up, with the GTP-C lock held, so the tunnel is looked up again under the
+    // lock to keep the packets in order
+    std::lock_guard<std::mutex> gtpc_lock(m_spgw->m_gtpc_mutex);
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto                        gtpu_fteid_it = shard.ip_to_usr_teid.find(iph->daddr);
+      if (gtpu_fteid_it != shard.ip_to_usr_teid.end()) {
+        usr_found = true;
+        enb_fteid = gtpu_fteid_it->second;
+      }
+    }
+    if (not usr_found) {
+      m_logger.debug("Packet for attached UE that is not ECM connected.");
+      m_logger.debug("Triggering Donwlink Notification Requset.");
+      m_gtpc->send_downlink_data_notification(spgw_teid);
+      m_gtpc->queue_downlink_packet(spgw_teid, std::move(msg));
+      return;
+    }
   } else if (usr_found == true && ctr_found == false) {
     m_logger.error("User plane tunnel found without a control plane tunnel present.");
-  } else {
-    send_s1u_pdu(enb_fteid, msg.get());
+    return;
+  }
+
+  // Add the G-PDU to the batch sent to the eNBs
+  if (write_s1u_header(enb_fteid, msg.get(), &tx_batch.addrs[tx_batch.size])) {
+    tx_batch.pdus[tx_batch.size++] = std::move(msg);
   }
 }
 
-void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg)
+void spgw::gtpu::handle_s1u_packets(uint32_t queue_idx)
+{
+  up_queue_t&                          queue = m_up_queues[queue_idx];
+  std::array<mmsghdr, max_batch_size> msgs  = {};
+  std::array<iovec, max_batch_size>   iovs  = {};
+
+  // The Rx buffers are reused, as the G-PDUs are written to the TUN interface right away
+  size_t   buf_len  = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  uint32_t nof_bufs = 0;
+  for (; nof_bufs < max_batch_size; ++nof_bufs) {
+    srsran::unique_byte_buffer_t& pdu = queue.s1u_pdus[nof_bufs];
+    if (pdu == nullptr) {
+      pdu = srsran::make_byte_buffer("spgw::gtpu::handle_s1u_packets");
+      if (pdu == nullptr) {
+        break;
+      }
+    }
+    pdu->clear();
+    iovs[nof_bufs].iov_base           = pdu->msg;
+    iovs[nof_bufs].iov_len            = buf_len;
+    msgs[nof_bufs].msg_hdr.msg_iov    = &iovs[nof_bufs];
+    msgs[nof_bufs].msg_hdr.msg_iovlen = 1;
+  }
+  if (nof_bufs == 0) {
+    m_logger.error("Unable to allocate byte buffer");
+    return;
+  }
+
+  int n_recv = recvmmsg(queue.s1u, msgs.data(), nof_bufs, MSG_DONTWAIT, NULL);
+  if (n_recv < 0) {
+    if (errno != EAGAIN) {
+      m_logger.error("Error reading from S1-U socket: %s", strerror(errno));
+    }
+    return;
+  }
+  for (int i = 0; i < n_recv; ++i) {
+    m_logger.debug("Message received at SPGW: S1-U Message");
+    queue.s1u_pdus[i]->N_bytes = msgs[i].msg_len;
+    handle_s1u_pdu(queue.s1u_pdus[i].get(), queue.sgi);
+  }
+}
+
+void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg, int sgi)
 {
   srsran::gtpu_header_t header;
   srsran::gtpu_read_header(msg, &header, m_logger);
 
   m_logger.debug("Received PDU from S1-U. Bytes=%d", msg->N_bytes);
   m_logger.debug("TEID 0x%x. Bytes=%d", header.teid, msg->N_bytes);
-  int n = write(m_sgi, msg->msg, msg->N_bytes);
+  int n = m_sgi_vnet_hdr ? srsran::tun_vnet_write(sgi, msg->msg, msg->N_bytes) : write(sgi, msg->msg, msg->N_bytes);
   if (n < 0) {
     m_logger.error("Could not write to TUN interface.");
   } else {
@@ -277,13 +541,12 @@ void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg)
   return;
 }
 
-void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg)
+bool spgw::gtpu::write_s1u_header(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg, sockaddr_in* enb_addr)
 {
   // Set eNB destination address
-  struct sockaddr_in enb_addr;
-  enb_addr.sin_family      = AF_INET;
-  enb_addr.sin_port        = htons(GTPU_RX_PORT);
-  enb_addr.sin_addr.s_addr = enb_fteid.ipv4;
+  enb_addr->sin_family      = AF_INET;
+  enb_addr->sin_port        = htons(GTPU_RX_PORT);
+  enb_addr->sin_addr.s_addr = enb_fteid.ipv4;
 
   // Setup GTP-U header
   srsran::gtpu_header_t header;
@@ -293,26 +556,60 @@ void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer
   header.teid         = enb_fteid.teid;
 
   m_logger.debug("User plane tunnel found SGi PDU. Forwarding packet to S1-U.");
-  m_logger.debug("eNB F-TEID -- eNB IP %s, eNB TEID 0x%x.", inet_ntoa(enb_addr.sin_addr), enb_fteid.teid);
+  m_logger.debug("eNB F-TEID -- eNB IP %s, eNB TEID 0x%x.", inet_ntoa(enb_addr->sin_addr), enb_fteid.teid);
 
   // Write header into packet
-  int n;
   if (!srsran::gtpu_write_header(&header, msg, m_logger)) {
     m_logger.error("Error writing GTP-U header on PDU");
-    goto out;
+    return false;
+  }
+  return true;
+}
+
+void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg)
+{
+  struct sockaddr_in enb_addr;
+  if (not write_s1u_header(enb_fteid, msg, &enb_addr)) {
+    return;
   }
 
   // Send packet to destination
-  n = sendto(m_s1u, msg->msg, msg->N_bytes, 0, (struct sockaddr*)&enb_addr, sizeof(enb_addr));
+  int n = sendto(get_s1u(), msg->msg, msg->N_bytes, 0, (struct sockaddr*)&enb_addr, sizeof(enb_addr));
   if (n < 0) {
     m_logger.error("Error sending packet to eNB");
   } else if ((unsigned int)n != msg->N_bytes) {
     m_logger.error("Mis-match between packet bytes and sent bytes: Sent: %d/%d", n, msg->N_bytes);
   }
+}
 
-out:
-  m_logger.debug("Deallocating packet after sending S1-U message");
-  return;
+void spgw::gtpu::send_s1u_batch(int s1u, s1u_tx_batch_t& tx_batch)
+{
+  std::array<mmsghdr, max_batch_size> msgs = {};
+  std::array<iovec, max_batch_size>   iovs = {};
+  for (size_t i = 0; i < tx_batch.size; ++i) {
+    iovs[i].iov_base            = tx_batch.pdus[i]->msg;
+    iovs[i].iov_len             = tx_batch.pdus[i]->N_bytes;
+    msgs[i].msg_hdr.msg_name    = &tx_batch.addrs[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(tx_batch.addrs[i]);
+    msgs[i].msg_hdr.msg_iov     = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen  = 1;
+  }
+
+  size_t nof_sent = 0;
+  while (nof_sent < tx_batch.size) {
+    int n = sendmmsg(s1u, &msgs[nof_sent], tx_batch.size - nof_sent, 0);
+    if (n < 0) {
+      // Drop the G-PDU that could not be sent and carry on with the rest
+      m_logger.error("Error sending packet to eNB: %s", strerror(errno));
+      n = 1;
+    }
+    nof_sent += n;
+  }
+
+  for (size_t i = 0; i < tx_batch.size; ++i) {
+    tx_batch.pdus[i].reset();
+  }
+  tx_batch.size = 0;
 }
 
 void spgw::gtpu::send_all_queued_packets(srsran::gtp_fteid_t                       dw_user_fteid,
@@ -340,16 +637,21 @@ bool spgw::gtpu::modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw
   srsran::gtpu_ntoa(buffer, dw_user_fteid.ipv4);
   m_logger.info("Downlink eNB addr %s, U-TEID 0x%x", srsran::to_c_str(buffer), dw_user_fteid.teid);
   m_logger.info("Uplink C-TEID: 0x%x", up_ctrl_teid);
-  m_ip_to_usr_teid[ue_ipv4] = dw_user_fteid;
-  m_ip_to_ctr_teid[ue_ipv4] = up_ctrl_teid;
+
+  tunnel_shard_t&             shard = get_tunnel_shard(ue_ipv4);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.ip_to_usr_teid[ue_ipv4] = dw_user_fteid;
+  shard.ip_to_ctr_teid[ue_ipv4] = up_ctrl_teid;
   return true;
 }
 
 bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 {
   // Remove GTP-U connections, if any.
-  if (m_ip_to_usr_teid.count(ue_ipv4)) {
-    m_ip_to_usr_teid.erase(ue_ipv4);
+  tunnel_shard_t&             shard = get_tunnel_shard(ue_ipv4);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (shard.ip_to_usr_teid.count(ue_ipv4)) {
+    shard.ip_to_usr_teid.erase(ue_ipv4);
   } else {
     m_logger.error("Could not find GTP-U Tunnel to delete.");
     return false;
@@ -360,8 +662,10 @@ bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 bool spgw::gtpu::delete_gtpc_tunnel(in_addr_t ue_ipv4)
 {
   // Remove Ctrl TEID from IP mapping.
-  if (m_ip_to_ctr_teid.count(ue_ipv4)) {
-    m_ip_to_ctr_teid.erase(ue_ipv4);
+  tunnel_shard_t&             shard = get_tunnel_shard(ue_ipv4);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (shard.ip_to_ctr_teid.count(ue_ipv4)) {
+    shard.ip_to_ctr_teid.erase(ue_ipv4);
   } else {
     m_logger.error("Could not find GTP-C Tunnel info to delete.");
     return false;
@@ -34,6 +34,7 @@
 #include "srsgnb/hdr/stack/sdap/sdap.h"
 
 #include "srsenb/hdr/stack/enb_stack_base.h"
+#include "srsenb/hdr/stack/x2_pdu_channel.h"
 #include "srsran/interfaces/gnb_interfaces.h"
 
 #include "srsran/common/ngap_pcap.h"
@@ -70,9 +71,10 @@ public:
            x2_interface*           x2_);
 
   // eNB stack base interface
-  void        stop() final;
-  std::string get_type() final;
-  bool        get_metrics(srsenb::stack_metrics_t* metrics) final;
+  void                           stop() final;
+  std::string                    get_type() final;
+  bool                           get_metrics(srsenb::stack_metrics_t* metrics) final;
+  const srsenb::mac_kpi_sampler* get_kpi_sampler() final { return nullptr; }
 
   // GW srsue stack_interface_gw dummy interface
   bool is_registered() override { return true; };
@@ -88,6 +90,7 @@ public:
   void process_pdus() final;
 
   void toggle_padding() override {}
+  int  set_sched_tunables(const sched_interface::sched_tunables_t& tunables) override { return SRSRAN_ERROR; }
 
   int         slot_indication(const srsran_slot_cfg_t& slot_cfg) override;
   dl_sched_t* get_dl_sched(const srsran_slot_cfg_t& slot_cfg) override;
@@ -115,10 +118,13 @@ public:
   // X2 data interface
   void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn = -1) final
   {
-    auto task = [this, rnti, lcid, pdcp_sn](srsran::unique_byte_buffer_t& sdu) {
-      pdcp.write_sdu(rnti, lcid, std::move(sdu), pdcp_sn);
-    };
-    gtpu_task_queue.push(std::bind(task, std::move(sdu)));
+    if (x2_dl_channel.push(rnti, lcid, std::move(sdu), pdcp_sn)) {
+      gtpu_task_queue.push([this]() {
+        x2_dl_channel.drain([this](uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn) {
+          pdcp.write_sdu(rnti, lcid, std::move(sdu), pdcp_sn);
+        });
+      });
+    }
   }
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) final
   {
@@ -150,6 +156,7 @@ private:
   srsran::task_scheduler                task_sched;
   srsran::task_multiqueue::queue_handle sync_task_queue, gtpu_task_queue, metrics_task_queue, gnb_task_queue,
       x2_task_queue;
+  x2_pdu_channel x2_dl_channel; ///< DL SDUs of the split bearers, written by the LTE stack
 
   // metrics waiting condition
   std::mutex              metrics_mutex;
@@ -37,10 +37,9 @@ class tx_harq_softbuffer
 {
 public:
   tx_harq_softbuffer() { bzero(&buffer, sizeof(buffer)); }
-  explicit tx_harq_softbuffer(uint32_t nof_prb_)
+  explicit tx_harq_softbuffer(uint32_t max_cb_)
   {
-    // Note: for now we use same size regardless of nof_prb_
-    srsran_softbuffer_tx_init_guru(&buffer, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB);
+    srsran_softbuffer_tx_init_guru(&buffer, max_cb_, SRSRAN_LDPC_MAX_LEN_ENCODED_CB);
   }
   tx_harq_softbuffer(const tx_harq_softbuffer&) = delete;
   tx_harq_softbuffer(tx_harq_softbuffer&& other) noexcept
@@ -60,7 +59,8 @@ public:
   }
   ~tx_harq_softbuffer() { destroy(); }
 
-  void reset() { srsran_softbuffer_tx_reset(&buffer); }
+  void     reset() { srsran_softbuffer_tx_reset(&buffer); }
+  uint32_t max_cb() const { return buffer.max_cb; }
 
   srsran_softbuffer_tx_t&       operator*() { return buffer; }
   const srsran_softbuffer_tx_t& operator*() const { return buffer; }
@@ -79,10 +79,9 @@ class rx_harq_softbuffer
 {
 public:
   rx_harq_softbuffer() { bzero(&buffer, sizeof(buffer)); }
-  explicit rx_harq_softbuffer(uint32_t nof_prb_)
+  explicit rx_harq_softbuffer(uint32_t max_cb_)
   {
-    // Note: for now we use same size regardless of nof_prb_
-    srsran_softbuffer_rx_init_guru(&buffer, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB);
+    srsran_softbuffer_rx_init_guru(&buffer, max_cb_, SRSRAN_LDPC_MAX_LEN_ENCODED_CB);
   }
   rx_harq_softbuffer(const rx_harq_softbuffer&) = delete;
   rx_harq_softbuffer(rx_harq_softbuffer&& other) noexcept
@@ -102,8 +101,9 @@ public:
   }
   ~rx_harq_softbuffer() { destroy(); }
 
-  void reset() { srsran_softbuffer_rx_reset(&buffer); }
-  void reset(uint32_t tbs_bits) { srsran_softbuffer_rx_reset_tbs(&buffer, tbs_bits); }
+  void     reset() { srsran_softbuffer_rx_reset(&buffer); }
+  void     reset(uint32_t tbs_bits) { srsran_softbuffer_rx_reset_tbs(&buffer, tbs_bits); }
+  uint32_t max_cb() const { return buffer.max_cb; }
 
   srsran_softbuffer_rx_t&       operator*() { return buffer; }
   const srsran_softbuffer_rx_t& operator*() const { return buffer; }
@@ -118,6 +118,8 @@ private:
   srsran_softbuffer_rx_t buffer;
 };
 
+/// Pool of HARQ softbuffers shared by all the UEs. Softbuffers are grouped in size classes, so that a HARQ process
+/// only holds the memory its TBS requires, and only while the TB is in flight.
 class harq_softbuffer_pool
 {
 public:
@@ -126,11 +128,30 @@ public:
   harq_softbuffer_pool& operator=(const harq_softbuffer_pool&) = delete;
   harq_softbuffer_pool& operator=(harq_softbuffer_pool&&) = delete;
 
-  void init_pool(uint32_t nof_prb, uint32_t batch_size = MAX_HARQ * 4, uint32_t thres = 0, uint32_t init_size = 0);
+  enum class size_class { small, medium, large, nof_classes };
 
+  /// Number of codeblocks of the softbuffers of each size class
+  static const uint32_t SMALL_MAX_CB  = 1;
+  static const uint32_t MEDIUM_MAX_CB = 8;
+  static const uint32_t LARGE_MAX_CB  = SRSRAN_SCH_NR_MAX_NOF_CB_LDPC;
+
+  /// Larger classes are allocated in smaller batches, as only a few HARQs hold them at the same time
+  void init_pool(uint32_t batch_size = MAX_HARQ * 4, uint32_t thres = 0, uint32_t init_size = 0);
+
+  /// Softbuffers that fit any TB transmitted in nof_prb PRBs, e.g. for broadcast messages
   srsran::unique_pool_ptr<tx_harq_softbuffer> get_tx(uint32_t nof_prb);
   srsran::unique_pool_ptr<rx_harq_softbuffer> get_rx(uint32_t nof_prb);
 
+  /// Softbuffers of the smallest class that fits a TB of tbs bits
+  srsran::unique_pool_ptr<tx_harq_softbuffer> get_tx_tbs(uint32_t tbs);
+  srsran::unique_pool_ptr<rx_harq_softbuffer> get_rx_tbs(uint32_t tbs);
+
+  /// Worst case number of LDPC codeblocks of a TB of tbs bits, regardless of the base graph
+  static uint32_t    get_nof_cb(uint32_t tbs);
+  static size_class  get_size_class(uint32_t tbs);
+  static uint32_t    get_max_cb(size_class c);
+  static const char* to_string(size_class c);
+
   static harq_softbuffer_pool& get_instance()
   {
     static harq_softbuffer_pool pool;
@@ -142,8 +163,10 @@ private:
 
   harq_softbuffer_pool() = default;
 
-  std::array<std::unique_ptr<srsran::obj_pool_itf<tx_harq_softbuffer> >, SRSRAN_MAX_PRB_NR> tx_pool;
-  std::array<std::unique_ptr<srsran::obj_pool_itf<rx_harq_softbuffer> >, SRSRAN_MAX_PRB_NR> rx_pool;
+  const static size_t NOF_CLASSES = static_cast<size_t>(size_class::nof_classes);
+
+  std::array<std::unique_ptr<srsran::obj_pool_itf<tx_harq_softbuffer> >, NOF_CLASSES> tx_pool;
+  std::array<std::unique_ptr<srsran::obj_pool_itf<rx_harq_softbuffer> >, NOF_CLASSES> rx_pool;
 };
 
 } // namespace srsenb
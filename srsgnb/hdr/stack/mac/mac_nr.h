@@ -134,7 +134,7 @@ private:
   // Map of active UEs
   pthread_rwlock_t                                                              rwmutex    = {};
   static const uint16_t                                                         FIRST_RNTI = 0x4601;
-  srsran::static_circular_map<uint16_t, std::unique_ptr<ue_nr>, SRSENB_MAX_UES> ue_db;
+  rnti_map_t<std::unique_ptr<ue_nr> > ue_db;
 
   std::atomic<uint16_t> ue_counter{0};
 
@@ -28,6 +28,7 @@
 #include "srsran/adt/pool/cached_alloc.h"
 #include "srsran/adt/pool/circular_stack_pool.h"
 #include "srsran/common/slot_point.h"
+#include "srsran/common/thread_pool.h"
 #include <array>
 extern "C" {
 #include "srsran/config.h"
@@ -84,6 +85,9 @@ private:
   using slot_cc_worker = sched_nr_impl::cc_worker;
   std::vector<std::unique_ptr<sched_nr_impl::cc_worker> > cc_workers;
 
+  // Threads generating the UE grant candidates, shared by the carriers
+  std::unique_ptr<srsran::task_thread_pool> cand_pool;
+
   // UE Database
   std::unique_ptr<srsran::circular_stack_pool<SRSENB_MAX_UES> > ue_pool;
   using ue_map_t = sched_nr_impl::ue_map_t;
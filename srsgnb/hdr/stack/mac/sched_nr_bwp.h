@@ -25,6 +25,7 @@
 #include "sched_nr_cfg.h"
 #include "sched_nr_grant_allocator.h"
 #include "sched_nr_signalling.h"
+#include "sched_nr_time_pf.h"
 #include "sched_nr_time_rr.h"
 #include "srsran/adt/pool/cached_alloc.h"
 
@@ -68,7 +69,7 @@ private:
 class bwp_manager
 {
 public:
-  explicit bwp_manager(const bwp_params_t& bwp_cfg);
+  explicit bwp_manager(const bwp_params_t& bwp_cfg, srsran::task_thread_pool* cand_pool = nullptr);
 
   const bwp_params_t* cfg;
 
@@ -102,8 +102,25 @@ struct bwp_params_t {
 
   srsran::optional_vector<bwp_cce_pos_list> common_cce_list;
 
+  /// Recurring DL signalling of a slot, which only depends on the cell config and on the slot index
+  struct signalling_slot_cfg {
+    bool     ssb             = false;
+    uint16_t nzp_csi_rs_idx  = 0; ///< first NZP-CSI-RS resource of the slot in signalling_nzp_csi_rs
+    uint16_t nof_nzp_csi_rs  = 0;
+    uint32_t si_window_start = 0; ///< bitmap of the SIB1 (bit 0) and SI messages whose window starts in the slot
+  };
+  /// Table of the signalling of each slot, repeated every signalling period, which divides the hyperframe
+  std::vector<signalling_slot_cfg>          signalling_slots;
+  std::vector<srsran_csi_rs_nzp_resource_t> signalling_nzp_csi_rs;
+  prb_interval                              ssb_prbs; ///< PRBs reserved for the SSB, empty if out of the carrier
+
   bwp_params_t(const cell_config_manager& cell, uint32_t bwp_id, const sched_nr_bwp_cfg_t& bwp_cfg);
 
+  const signalling_slot_cfg& get_signalling_slot(slot_point sl) const
+  {
+    return signalling_slots[sl.to_uint() % signalling_slots.size()];
+  }
+
   prb_interval  coreset_prb_range(uint32_t cs_id) const { return coresets[cs_id].prb_limits; }
   prb_interval  dci_fmt_1_0_prb_lims(uint32_t cs_id) const { return coresets[cs_id].dci_1_0_prb_limits; }
   bwp_rb_bitmap dci_fmt_1_0_excluded_prbs(uint32_t cs_id) const { return coresets[cs_id].usable_common_ss_prb_mask; }
@@ -114,6 +131,8 @@ struct bwp_params_t {
   }
 
 private:
+  void init_signalling_slots();
+
   bwp_rb_bitmap cached_empty_prb_mask;
   struct coreset_cached_params {
     prb_interval  prb_limits;
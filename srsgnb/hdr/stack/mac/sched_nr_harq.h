@@ -90,9 +90,14 @@ class dl_harq_proc : public harq_proc
 public:
   dl_harq_proc(uint32_t id_, uint32_t nprb);
 
+  /// The softbuffer is only held between set_tbs() and the TB being ACKed or discarded
   tx_harq_softbuffer&           get_softbuffer() { return *softbuffer; }
   srsran::unique_byte_buffer_t* get_tx_pdu() { return &pdu; }
 
+  int  ack_info(uint32_t tb_idx, bool ack);
+  bool clear_if_maxretx(slot_point slot_rx);
+  bool set_tbs(uint32_t tbs);
+
   bool new_tx(slot_point          slot_tx,
               slot_point          slot_ack,
               const prb_grant&    grant,
@@ -112,21 +117,18 @@ private:
 class ul_harq_proc : public harq_proc
 {
 public:
-  ul_harq_proc(uint32_t id_, uint32_t nprb) :
-    harq_proc(id_), softbuffer(harq_softbuffer_pool::get_instance().get_rx(nprb))
-  {}
+  ul_harq_proc(uint32_t id_, uint32_t nprb) : harq_proc(id_) {}
 
   bool new_tx(slot_point slot_tx, const prb_grant& grant, uint32_t mcs, uint32_t max_retx, srsran_dci_ul_nr_t& dci);
 
   bool new_retx(slot_point slot_tx, const prb_grant& grant, srsran_dci_ul_nr_t& dci);
 
+  /// The softbuffer is only held between set_tbs() and the TB being decoded or discarded
   rx_harq_softbuffer& get_softbuffer() { return *softbuffer; }
 
-  bool set_tbs(uint32_t tbs)
-  {
-    softbuffer->reset(tbs);
-    return harq_proc::set_tbs(tbs);
-  }
+  int  ack_info(uint32_t tb_idx, bool ack);
+  bool clear_if_maxretx(slot_point slot_rx);
+  bool set_tbs(uint32_t tbs);
 
 private:
   void fill_dci(srsran_dci_ul_nr_t& dci);
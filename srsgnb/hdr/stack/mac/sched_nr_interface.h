@@ -122,6 +122,9 @@ public:
     bool        auto_refill_buffer = false;
     int         fixed_dl_mcs       = 28;
     int         fixed_ul_mcs       = 28;
+    uint32_t    nof_cand_threads   = 0;         ///< Threads deriving the UE grant candidates, 0 or 1 for serial
+    std::string sched_policy       = "time_rr"; ///< Data scheduling policy, i.e. time_rr or time_pf
+    std::string sched_policy_args  = "";        ///< Policy-specific arguments, i.e. the PF fairness coefficient
     std::string logger_name        = "MAC-NR";
   };
 
@@ -73,11 +73,12 @@ private:
 
   // List of PDCCH grants
   struct alloc_record {
-    uint32_t                   aggr_idx;
-    uint32_t                   ss_id;
-    srsran_dci_ctx_t*          dci;
-    bool                       is_dl;
-    const ue_carrier_params_t* ue;
+    uint32_t                     aggr_idx;
+    uint32_t                     ss_id;
+    srsran_dci_ctx_t*            dci;
+    bool                         is_dl;
+    const ue_carrier_params_t*   ue;
+    srsran::span<const uint32_t> cce_locs; ///< Precomputed CCE candidates of the slot, SearchSpace and aggr level
   };
   srsran::bounded_vector<alloc_record, 2 * MAX_GRANTS> dci_list;
 
@@ -88,7 +89,7 @@ private:
     uint32_t              dci_pos_idx = 0;
     srsran_dci_location_t dci_pos     = {0, 0};
     /// Accumulation of all PDCCH masks for the current solution (DFS path)
-    coreset_bitmap total_mask, current_mask;
+    coreset_bitmap total_mask;
   };
   using alloc_tree_dfs_t = std::vector<tree_node>;
   alloc_tree_dfs_t dfs_tree, saved_dfs_tree;
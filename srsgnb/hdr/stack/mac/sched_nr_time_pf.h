@@ -0,0 +1,84 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_NR_TIME_PF_H
+#define SRSRAN_SCHED_NR_TIME_PF_H
+
+#include "sched_nr_time_rr.h"
+#include "srsenb/hdr/common/common_enb.h"
+#include <vector>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/**
+ * Proportional-Fair scheduler in the time domain. The UE candidates are committed in decreasing order of the metric
+ * r / R^fairness_coeff, where r is the rate estimated for the candidate grant and R the average of the rates
+ * allocated to the UE. Retxs always go first. The priority queue is a max-heap built once per slot from the
+ * candidates, and the averages of the UEs that were idle are only updated once they become active again, so that the
+ * cost per slot scales with the number of active UEs
+ */
+class sched_nr_time_pf : public sched_nr_base
+{
+public:
+  explicit sched_nr_time_pf(const bwp_params_t& bwp_cfg_, srsran::task_thread_pool* cand_pool_ = nullptr);
+
+  void sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+  void sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+
+private:
+  //! Coefficient of the exponential average of the allocated rates
+  static constexpr float rate_avg_alpha = 0.01;
+
+  /// Average of the rates allocated in one direction, in bytes per slot
+  struct avg_rate_t {
+    float      avg_rate    = 0;
+    uint32_t   nof_samples = 0;
+    slot_point last_slot; ///< Last slot accounted for in the average
+
+    void add_zero_samples(uint32_t nof_zeros);
+    void save_alloc(uint32_t alloc_bytes);
+    void update(slot_point slot, uint32_t alloc_bytes);
+  };
+  struct ue_pf_ctxt {
+    avg_rate_t dl;
+    avg_rate_t ul;
+  };
+
+  void  sched_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc, bool is_dl);
+  float dl_rate(const ue_candidate& cand) const;
+  float ul_rate(const ue_candidate& cand) const;
+  float grant_nof_prbs(const prb_grant& grant) const;
+
+  const bwp_params_t* bwp_cfg        = nullptr;
+  float               fairness_coeff = 1;
+
+  rnti_map_t<ue_pf_ctxt> ue_ctxt_db;
+
+  // Metric of each candidate, and max-heap of the indexes of the candidates with a grant
+  std::vector<float>    cand_prio;
+  std::vector<uint32_t> queue;
+};
+
+} // namespace sched_nr_impl
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_NR_TIME_PF_H
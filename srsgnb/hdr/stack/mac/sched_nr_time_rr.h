@@ -24,28 +24,65 @@
 
 #include "sched_nr_grant_allocator.h"
 #include "srsran/common/slot_point.h"
+#include <vector>
+
+namespace srsran {
+class task_thread_pool;
+}
 
 namespace srsenb {
 namespace sched_nr_impl {
 
 /**
- * Base class for scheduler algorithms implementations
+ * Base class for scheduler algorithms implementations. The UEs are scheduled in two phases. First, the grant candidate
+ * of each UE (retx or newtx, search space and PRBs) is derived without modifying the slot grid, which is done in
+ * parallel when a thread pool is provided. Then, the derived class commits the candidates into the slot allocator
+ * sequentially, in the order defined by its policy
  */
 class sched_nr_base
 {
 public:
+  explicit sched_nr_base(srsran::task_thread_pool* cand_pool_ = nullptr) : cand_pool(cand_pool_) {}
   virtual ~sched_nr_base() = default;
 
   virtual void sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) = 0;
   virtual void sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) = 0;
 
 protected:
+  enum class cand_type { none, retx, newtx };
+  struct ue_candidate {
+    slot_ue*  ue    = nullptr;
+    cand_type type  = cand_type::none;
+    int       ss_id = -1;
+    prb_grant grant;
+  };
+
+  void make_candidates(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc, bool is_dl);
+
   srslog::basic_logger& logger = srslog::fetch_basic_logger("MAC");
+
+  // Candidates of the slot being scheduled, in the UE map order
+  std::vector<ue_candidate> candidates;
+
+private:
+  static void make_candidate_range(void* arg, uint32_t task_idx);
+  static void make_dl_candidate(ue_candidate& cand, bwp_slot_allocator& slot_alloc);
+  static void make_ul_candidate(ue_candidate& cand, bwp_slot_allocator& slot_alloc);
+
+  srsran::task_thread_pool* cand_pool  = nullptr;
+  bwp_slot_allocator*       cand_alloc = nullptr;
+  bool                      cand_is_dl = true;
 };
 
+/**
+ * Round-Robin scheduler in the time domain. The UE candidates are committed starting at an offset that rotates every
+ * slot, retxs first
+ */
 class sched_nr_time_rr : public sched_nr_base
 {
 public:
+  explicit sched_nr_time_rr(srsran::task_thread_pool* cand_pool_ = nullptr) : sched_nr_base(cand_pool_) {}
+
   void sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
   void sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
 };
@@ -42,7 +42,7 @@ namespace sched_nr_impl {
 class cc_worker
 {
 public:
-  explicit cc_worker(const cell_config_manager& params);
+  explicit cc_worker(const cell_config_manager& params, srsran::task_thread_pool* cand_pool = nullptr);
 
   void dl_rach_info(const sched_nr_interface::rar_info_t& rar_info);
 
@@ -24,9 +24,12 @@
 #include "ngap_metrics.h"
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsran/adt/circular_map.h"
+#include "srsran/adt/dense_id_table.h"
+#include "srsran/adt/flat_hash_map.h"
 #include "srsran/adt/optional.h"
 #include "srsran/asn1/asn1_utils.h"
 #include "srsran/asn1/ngap.h"
+#include "srsran/asn1/ngap_utils.h"
 #include "srsran/common/bcd_helpers.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
@@ -115,7 +118,6 @@ private:
   struct sockaddr_in    amf_addr            = {}; // AMF address
   bool                  amf_connected       = false;
   bool                  running             = false;
-  uint32_t              next_gnb_ue_ngap_id = 1; // Next GNB-side UE identifier
   uint16_t              next_ue_stream_id   = 1; // Next UE SCTP stream identifier
   srsran::unique_timer  amf_connect_timer, ngsetup_timeout;
   std::vector<nssai_t>  nssai_allowed_list;
@@ -138,6 +140,7 @@ private:
 
   // TS 38.413 - Section 8.6.2 - Downlink NAS Transport
   bool handle_dl_nas_transport(const asn1::ngap::dl_nas_transport_s& msg);
+  bool handle_dl_nas_transport(const asn1::ngap::ngap_pdu_peek_t& msg);
   // TS 38.413 - Section 9.2.6.2 - NG Setup Response
   bool handle_ng_setup_response(const asn1::ngap::ng_setup_resp_s& msg);
   // TS 38.413 - Section 9.2.6.3 - NG Setup Failure
@@ -154,19 +157,25 @@ private:
   // PCAP
   srsran::ngap_pcap* pcap = nullptr;
 
+  /// UE contexts indexed by RAN_UE_NGAP_ID, which encodes the slot of the context, with O(1) RNTI and AMF_UE_NGAP_ID
+  /// lookups. The RNTI and AMF_UE_NGAP_ID of a stored context must be changed through set_rnti and set_amf_id.
   class user_list
   {
   public:
     using value_type     = std::unique_ptr<ue>;
-    using iterator       = std::unordered_map<uint32_t, value_type>::iterator;
-    using const_iterator = std::unordered_map<uint32_t, value_type>::const_iterator;
-    using pair_type      = std::unordered_map<uint32_t, value_type>::value_type;
+    using table_type     = srsran::dense_id_table<value_type, 32, 14>;
+    using iterator       = table_type::iterator;
+    using const_iterator = table_type::const_iterator;
+
+    user_list() : rnti_to_gnb_id(1u << 16, table_type::invalid_id) {}
 
     ue*            find_ue_rnti(uint16_t rnti);
     ue*            find_ue_gnbid(uint32_t gnbid);
     ue*            find_ue_amfid(uint64_t amfid);
     ue*            add_user(value_type user);
     void           erase(ue* ue_ptr);
+    bool           set_rnti(ue* ue_ptr, uint16_t rnti);
+    bool           set_amf_id(ue* ue_ptr, uint64_t amfid);
     iterator       begin() { return users.begin(); }
     iterator       end() { return users.end(); }
     const_iterator cbegin() const { return users.begin(); }
@@ -174,7 +183,9 @@ private:
     size_t         size() const { return users.size(); }
 
   private:
-    std::unordered_map<uint32_t, std::unique_ptr<ue> > users; // maps ran_ue_ngap_id to user
+    table_type                                users;          // maps ran_ue_ngap_id to user
+    std::vector<uint32_t>                     rnti_to_gnb_id; // maps RNTI to ran_ue_ngap_id
+    srsran::flat_hash_map<uint64_t, uint32_t> amf_to_gnb_id;  // maps amf_ue_ngap_id to ran_ue_ngap_id
   };
   user_list users;
 
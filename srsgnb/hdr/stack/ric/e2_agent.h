@@ -55,7 +55,9 @@ namespace srsenb {
 class e2_agent : public srsran::thread
 {
 public:
-  e2_agent(srslog::basic_logger& logger, srsenb::e2_interface_metrics* _gnb_metrics);
+  e2_agent(srslog::basic_logger&          logger,
+           srsenb::e2_interface_metrics*  _gnb_metrics,
+           const srsenb::mac_kpi_sampler* _kpi_sampler);
   ~e2_agent() = default;
 
   // Initiate and Stop
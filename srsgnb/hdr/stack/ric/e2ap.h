@@ -59,10 +59,11 @@ class e2_agent;
 class e2ap
 {
 public:
-  e2ap(srslog::basic_logger&         logger,
-       e2_agent*                     _e2_agent,
-       srsenb::e2_interface_metrics* _gnb_metrics,
-       srsran::task_scheduler*       _task_sched_ptr);
+  e2ap(srslog::basic_logger&          logger,
+       e2_agent*                      _e2_agent,
+       srsenb::e2_interface_metrics*  _gnb_metrics,
+       const srsenb::mac_kpi_sampler* _kpi_sampler,
+       srsran::task_scheduler*        _task_sched_ptr);
   ~e2ap();
 
   e2_ap_pdu_c generate_setup_request();
@@ -42,7 +42,9 @@ public:
   static const std::string func_description;
   static const uint32_t    revision;
 
-  e2sm_kpm(srslog::basic_logger& logger_, srsran::task_scheduler* _task_sched_ptr);
+  e2sm_kpm(srslog::basic_logger&          logger_,
+           srsran::task_scheduler*        _task_sched_ptr,
+           const srsenb::mac_kpi_sampler* kpi_sampler_);
   ~e2sm_kpm();
 
   virtual bool generate_ran_function_description(RANfunction_description& desc, ra_nfunction_item_s& ran_func);
@@ -67,10 +69,17 @@ private:
   bool                     _get_meas_definition(std::string meas_name, e2sm_kpm_metric_t& def);
   std::vector<std::string> _get_supported_meas(uint32_t level_mask);
 
-  bool _collect_meas_value(e2sm_kpm_meas_def_t& meas_value, meas_record_item_c& item);
-  bool
-  _extract_integer_type_meas_value(e2sm_kpm_meas_def_t& meas_value, const enb_metrics_t& enb_metrics, uint32_t& value);
-  bool _extract_real_type_meas_value(e2sm_kpm_meas_def_t& meas_value, const enb_metrics_t& enb_metrics, float& value);
+  bool _read_kpi_samples(uint64_t& cursor, e2sm_kpm_kpi_window_t& window);
+  bool _collect_meas_value(e2sm_kpm_meas_def_t&         meas_value,
+                           const e2sm_kpm_kpi_window_t& kpis,
+                           meas_record_item_c&          item);
+  bool _extract_kpi_meas_value(e2sm_kpm_meas_def_t& meas_value, const e2sm_kpm_kpi_window_t& kpis, uint32_t& value);
+  bool _extract_integer_type_meas_value(e2sm_kpm_meas_def_t&            meas_value,
+                                        const e2sm_kpm_meas_registry_t& metrics,
+                                        uint32_t&                       value);
+  bool _extract_real_type_meas_value(e2sm_kpm_meas_def_t&            meas_value,
+                                     const e2sm_kpm_meas_registry_t& metrics,
+                                     float&                          value);
 
   srslog::basic_logger&                        logger;
   std::vector<e2sm_kpm_metric_t>               supported_meas_types;
@@ -78,7 +87,8 @@ private:
 
   srsran_random_t random_gen;
 
-  enb_metrics_t last_enb_metrics;
+  e2sm_kpm_meas_registry_t       meas_registry;
+  const srsenb::mac_kpi_sampler* kpi_sampler = nullptr;
 };
 
 #endif /*E2SM_KPM*/
@@ -21,7 +21,9 @@
 
 #include "srsran/asn1/e2ap.h"
 #include "srsran/asn1/e2sm.h"
+#include "srsenb/hdr/stack/mac/common/mac_kpi_sampler.h"
 #include "srsran/asn1/e2sm_kpm_v2.h"
+#include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/srsran.h"
 
 #ifndef SRSRAN_E2SM_KPM_COMMON_H
@@ -77,4 +79,27 @@ typedef struct {
   uint32_t                   cell_id; // TODO: do we need to use type cgi_c? or we translate to local cell_id?
 } e2sm_kpm_meas_def_t;
 
+/* Values of the eNB metrics read by the measurements, updated in place from every metrics report. The report services
+ * read them directly, instead of a copy of the whole eNB metrics, and the aggregates over the CPUs are computed once
+ * per metrics report instead of once per subscription and measurement */
+struct e2sm_kpm_meas_registry_t {
+  // ENB_LEVEL
+  float cpu0_load    = 0;
+  float cpu_load_min = 0;
+  float cpu_load_max = 0;
+  float cpu_load_avg = 0;
+  // CELL_LEVEL, indexed by cell_id
+  std::vector<uint32_t> cell_rach_counter;
+  // UE_LEVEL, indexed by ue_id
+  std::vector<float> ue_ul_rssi;
+
+  void update(const srsenb::enb_metrics_t& m);
+};
+
+/* MAC KPIs summed over the TTIs of a measurement collection period */
+struct e2sm_kpm_kpi_window_t {
+  srsenb::mac_kpi_sample_t sum;
+  uint32_t                 nof_ttis = 0;
+};
+
 #endif // SRSRAN_E2SM_KPM_COMMON_H
@@ -34,6 +34,11 @@ std::vector<e2sm_kpm_metric_t> get_e2sm_kpm_28_552_metrics()
   // not supported metrics
   metrics.push_back({"RRU.PrbTotDl", false, REAL, "%", true, 0, true, 100, NO_LABEL | AVG_LABEL, CELL_LEVEL | UE_LEVEL });
   metrics.push_back({"RRU.PrbTotUl", false, REAL, "%", true, 0, true, 100, NO_LABEL | AVG_LABEL, CELL_LEVEL | UE_LEVEL });
+  // supported metrics, averaged over the TTIs of the granularity period
+  metrics.push_back({"RRU.PrbUsedDl", true, INTEGER, "PRB", true, 0, false, 0, NO_LABEL, ENB_LEVEL | CELL_LEVEL });
+  metrics.push_back({"RRU.PrbUsedUl", true, INTEGER, "PRB", true, 0, false, 0, NO_LABEL, ENB_LEVEL | CELL_LEVEL });
+  metrics.push_back({"DRB.UEThpDl", true, INTEGER, "kbps", true, 0, false, 0, NO_LABEL, ENB_LEVEL | CELL_LEVEL });
+  metrics.push_back({"DRB.UEThpUl", true, INTEGER, "kbps", true, 0, false, 0, NO_LABEL, ENB_LEVEL | CELL_LEVEL });
   // not supported metrics
   metrics.push_back({"RRU.RachPreambleDedMean", false, REAL, "-", false, 0, false, 100, NO_LABEL, CELL_LEVEL | UE_LEVEL });
   return metrics;
@@ -64,6 +69,9 @@ std::vector<e2sm_kpm_metric_t> e2sm_kpm_custom_metrics()
   metrics.push_back({"random_int", true, INTEGER, "", true, 0, true, 100, NO_LABEL, CELL_LEVEL });
   metrics.push_back({"cpu0_load", true, REAL, "", true, 0, true, 100, NO_LABEL, ENB_LEVEL });
   metrics.push_back({"cpu_load", true, REAL, "", true, 0, true, 100, MIN_LABEL|MAX_LABEL|AVG_LABEL, ENB_LEVEL });
+  metrics.push_back({"dl_cqi", true, INTEGER, "", true, 0, true, 15, NO_LABEL, ENB_LEVEL | CELL_LEVEL });
+  metrics.push_back({"dl_bler", true, INTEGER, "%", true, 0, true, 100, NO_LABEL, ENB_LEVEL | CELL_LEVEL });
+  metrics.push_back({"ul_bler", true, INTEGER, "%", true, 0, true, 100, NO_LABEL, ENB_LEVEL | CELL_LEVEL });
   // not supported metrics
   metrics.push_back({"test123", false,  REAL, "", true, 0, true, 100, NO_LABEL, CELL_LEVEL | UE_LEVEL });
   return metrics;
@@ -73,6 +73,10 @@ public:
 
   uint32_t             granul_period = 0;
   srsran::unique_timer meas_collection_timer; // for measurements collection
+
+  // MAC KPI samples of the current collection period
+  uint64_t              kpi_cursor = 0;
+  e2sm_kpm_kpi_window_t kpi_window;
 };
 
 class e2sm_kpm_report_service_style1 : public e2sm_kpm_report_service
@@ -21,51 +21,112 @@
 
 #include "srsgnb/hdr/stack/mac/harq_softbuffer.h"
 #include "srsran/adt/pool/obj_pool.h"
+extern "C" {
+#include "srsran/phy/fec/cbsegm.h"
+}
 
 namespace srsenb {
 
-void harq_softbuffer_pool::init_pool(uint32_t nof_prb, uint32_t batch_size, uint32_t thres, uint32_t init_size)
+void harq_softbuffer_pool::init_pool(uint32_t batch_size, uint32_t thres, uint32_t init_size)
 {
-  srsran_assert(nof_prb <= SRSRAN_MAX_PRB_NR, "Invalid nof prb=%d", nof_prb);
-  size_t idx = nof_prb - 1;
-  if (tx_pool[idx] != nullptr) {
+  if (tx_pool[0] != nullptr) {
     return;
   }
-  if (thres == 0) {
-    thres = batch_size;
+  for (size_t idx = 0; idx < NOF_CLASSES; ++idx) {
+    uint32_t max_cb      = get_max_cb(static_cast<size_class>(idx));
+    uint32_t class_batch = std::max(batch_size >> (2 * idx), 1U);
+    uint32_t class_thres = thres == 0 ? class_batch : std::max(thres >> (2 * idx), 1U);
+    uint32_t class_init  = init_size == 0 ? class_batch : std::max(init_size >> (2 * idx), 1U);
+
+    auto init_tx_softbuffers    = [max_cb](void* ptr) { new (ptr) tx_harq_softbuffer(max_cb); };
+    auto recycle_tx_softbuffers = [](tx_harq_softbuffer& softbuffer) { softbuffer.reset(); };
+    tx_pool[idx].reset(new srsran::background_obj_pool<tx_harq_softbuffer>(
+        class_batch, class_thres, class_init, init_tx_softbuffers, recycle_tx_softbuffers));
+
+    auto init_rx_softbuffers    = [max_cb](void* ptr) { new (ptr) rx_harq_softbuffer(max_cb); };
+    auto recycle_rx_softbuffers = [](rx_harq_softbuffer& softbuffer) { softbuffer.reset(); };
+    rx_pool[idx].reset(new srsran::background_obj_pool<rx_harq_softbuffer>(
+        class_batch, class_thres, class_init, init_rx_softbuffers, recycle_rx_softbuffers));
+  }
+}
+
+srsran::unique_pool_ptr<tx_harq_softbuffer> harq_softbuffer_pool::get_tx(uint32_t nof_prb)
+{
+  srsran_assert(nof_prb > 0 and nof_prb <= SRSRAN_MAX_PRB_NR, "Invalid Nprb=%d", nof_prb);
+  return get_tx_tbs(nof_prb * SRSRAN_MAX_NRE_NR * SRSRAN_MAX_QM);
+}
+
+srsran::unique_pool_ptr<rx_harq_softbuffer> harq_softbuffer_pool::get_rx(uint32_t nof_prb)
+{
+  srsran_assert(nof_prb > 0 and nof_prb <= SRSRAN_MAX_PRB_NR, "Invalid Nprb=%d", nof_prb);
+  return get_rx_tbs(nof_prb * SRSRAN_MAX_NRE_NR * SRSRAN_MAX_QM);
+}
+
+srsran::unique_pool_ptr<tx_harq_softbuffer> harq_softbuffer_pool::get_tx_tbs(uint32_t tbs)
+{
+  if (tx_pool[0] == nullptr) {
+    init_pool();
+  }
+  return tx_pool[static_cast<size_t>(get_size_class(tbs))]->make();
+}
+
+srsran::unique_pool_ptr<rx_harq_softbuffer> harq_softbuffer_pool::get_rx_tbs(uint32_t tbs)
+{
+  if (rx_pool[0] == nullptr) {
+    init_pool();
   }
-  if (init_size == 0) {
-    init_size = batch_size;
+  return rx_pool[static_cast<size_t>(get_size_class(tbs))]->make();
+}
+
+uint32_t harq_softbuffer_pool::get_nof_cb(uint32_t tbs)
+{
+  // BG2 has the shortest codeblocks, hence it yields the largest number of codeblocks for a given TBS. The large
+  // class fits the largest TB of a slot, as the PHY does
+  srsran_cbsegm_t cbsegm = {};
+  if (srsran_cbsegm_ldpc_bg2(&cbsegm, tbs) < SRSRAN_SUCCESS) {
+    return LARGE_MAX_CB;
   }
-  auto init_tx_softbuffers    = [nof_prb](void* ptr) { new (ptr) tx_harq_softbuffer(nof_prb); };
-  auto recycle_tx_softbuffers = [](tx_harq_softbuffer& softbuffer) { softbuffer.reset(); };
-  tx_pool[idx].reset(new srsran::background_obj_pool<tx_harq_softbuffer>(
-      batch_size, thres, init_size, init_tx_softbuffers, recycle_tx_softbuffers));
+  return SRSRAN_MIN(SRSRAN_MAX(cbsegm.C, 1), LARGE_MAX_CB);
+}
 
-  auto init_rx_softbuffers    = [nof_prb](void* ptr) { new (ptr) rx_harq_softbuffer(nof_prb); };
-  auto recycle_rx_softbuffers = [](rx_harq_softbuffer& softbuffer) { softbuffer.reset(); };
-  rx_pool[idx].reset(new srsran::background_obj_pool<rx_harq_softbuffer>(
-      batch_size, thres, init_size, init_rx_softbuffers, recycle_rx_softbuffers));
+harq_softbuffer_pool::size_class harq_softbuffer_pool::get_size_class(uint32_t tbs)
+{
+  uint32_t nof_cb = get_nof_cb(tbs);
+  if (nof_cb <= SMALL_MAX_CB) {
+    return size_class::small;
+  }
+  if (nof_cb <= MEDIUM_MAX_CB) {
+    return size_class::medium;
+  }
+  return size_class::large;
 }
 
-srsran::unique_pool_ptr<tx_harq_softbuffer> harq_softbuffer_pool::get_tx(uint32_t nof_prb)
+uint32_t harq_softbuffer_pool::get_max_cb(size_class c)
 {
-  srsran_assert(nof_prb <= SRSRAN_MAX_PRB_NR, "Invalid Nprb=%d", nof_prb);
-  size_t idx = nof_prb - 1;
-  if (tx_pool[idx] == nullptr) {
-    init_pool(nof_prb);
+  switch (c) {
+    case size_class::small:
+      return SMALL_MAX_CB;
+    case size_class::medium:
+      return MEDIUM_MAX_CB;
+    default:
+      break;
   }
-  return tx_pool[idx]->make();
+  return LARGE_MAX_CB;
 }
 
-srsran::unique_pool_ptr<rx_harq_softbuffer> harq_softbuffer_pool::get_rx(uint32_t nof_prb)
+const char* harq_softbuffer_pool::to_string(size_class c)
 {
-  srsran_assert(nof_prb <= SRSRAN_MAX_PRB_NR, "Invalid Nprb=%d", nof_prb);
-  size_t idx = nof_prb - 1;
-  if (rx_pool[idx] == nullptr) {
-    init_pool(nof_prb);
+  switch (c) {
+    case size_class::small:
+      return "small";
+    case size_class::medium:
+      return "medium";
+    case size_class::large:
+      return "large";
+    default:
+      break;
   }
-  return rx_pool[idx]->make();
+  return "invalid";
 }
 
 } // namespace srsenb
@@ -302,6 +302,9 @@ sched_nr::~sched_nr()
 void sched_nr::stop()
 {
   metrics_handler->stop();
+  if (cand_pool != nullptr) {
+    cand_pool->stop();
+  }
 }
 
 int sched_nr::config(const sched_args_t& sched_cfg, srsran::const_span<sched_nr_cell_cfg_t> cell_list)
@@ -310,7 +313,7 @@ int sched_nr::config(const sched_args_t& sched_cfg, srsran::const_span<sched_nr_
   logger = &srslog::fetch_basic_logger(sched_cfg.logger_name);
 
   // Initiate UE memory pool
-  ue_pool.reset(new srsran::circular_stack_pool<SRSENB_MAX_UES>(8, sizeof(ue), 4));
+  ue_pool.reset(new srsran::circular_stack_pool<SRSENB_MAX_UES>(8, sizeof(ue), 4, -1, "sched_nr_ue_pool"));
 
   // Initiate Common Sched Configuration
   cfg.cells.reserve(cell_list.size());
@@ -320,10 +323,15 @@ int sched_nr::config(const sched_args_t& sched_cfg, srsran::const_span<sched_nr_
 
   pending_events.reset(new event_manager{cfg});
 
+  // The calling thread also generates candidates, so it is not counted in the pool
+  if (sched_cfg.nof_cand_threads > 1) {
+    cand_pool.reset(new srsran::task_thread_pool(sched_cfg.nof_cand_threads - 1));
+  }
+
   // Initiate cell-specific schedulers
   cc_workers.resize(cfg.cells.size());
   for (uint32_t cc = 0; cc < cfg.cells.size(); ++cc) {
-    cc_workers[cc].reset(new slot_cc_worker{cfg.cells[cc]});
+    cc_workers[cc].reset(new slot_cc_worker{cfg.cells[cc], cand_pool.get()});
   }
 
   return SRSRAN_SUCCESS;
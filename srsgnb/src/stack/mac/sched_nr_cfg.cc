@@ -46,6 +46,18 @@ void get_dci_locs(const srsran_coreset_t&      coreset,
   }
 }
 
+/// Least common multiple of two periods
+static uint32_t period_lcm(uint32_t a, uint32_t b)
+{
+  uint32_t x = a, y = b;
+  while (y != 0) {
+    uint32_t r = x % y;
+    x          = y;
+    y          = r;
+  }
+  return a / x * b;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 bwp_params_t::bwp_params_t(const cell_config_manager& cell, uint32_t bwp_id_, const sched_nr_bwp_cfg_t& bwp_cfg) :
@@ -138,6 +150,86 @@ bwp_params_t::bwp_params_t(const cell_config_manager& cell, uint32_t bwp_id_, co
       }
     }
   }
+
+  init_signalling_slots();
+}
+
+void bwp_params_t::init_signalling_slots()
+{
+  const uint32_t nof_slots_frame = SRSRAN_NSLOTS_PER_FRAME_NR(cfg.numerology_idx);
+  const uint32_t nof_slots_hf    = nof_slots_frame * 1024;
+
+  // If the periodicity is 0, it means that the parameter was not passed by the upper layers.
+  // In that case, we use default value of 5ms (see Clause 4.1, TS 38.213)
+  uint32_t ssb_period_ms    = cell_cfg.ssb.periodicity_ms == 0 ? 5 : cell_cfg.ssb.periodicity_ms;
+  uint32_t ssb_period_slots = ssb_period_ms * SRSRAN_NSLOTS_PER_SF_NR(cfg.numerology_idx);
+
+  // The table covers the LCM of all the signalling periods, SIB1 windows start every two frames
+  uint32_t period = period_lcm(ssb_period_slots, 2 * nof_slots_frame);
+  for (const srsran_csi_rs_nzp_set_t& set : cfg.pdsch.nzp_csi_rs_sets) {
+    for (uint32_t i = 0; i < set.count; ++i) {
+      if (set.data[i].periodicity.period > 0) {
+        period = period_lcm(period, set.data[i].periodicity.period);
+      }
+    }
+  }
+  for (const sched_nr_cell_cfg_sib_t& sib : cell_cfg.sibs) {
+    if (sib.period_rf > 0) {
+      period = period_lcm(period, sib.period_rf * nof_slots_frame);
+    }
+  }
+  if (nof_slots_hf % period != 0) {
+    // The slot count wraps at the end of the hyperframe, so the table must repeat within it
+    period = nof_slots_hf;
+  }
+  srsran_assert(cell_cfg.sibs.size() <= 32, "Too many SIs configured");
+
+  signalling_slots.resize(period);
+  signalling_nzp_csi_rs.clear();
+  for (uint32_t sl = 0; sl < period; ++sl) {
+    signalling_slot_cfg& sig = signalling_slots[sl];
+    uint32_t             sfn = sl / nof_slots_frame;
+
+    sig.ssb = sl % ssb_period_slots == 0;
+
+    srsran_slot_cfg_t slot_cfg = {};
+    slot_cfg.idx               = sl;
+    sig.nzp_csi_rs_idx         = signalling_nzp_csi_rs.size();
+    for (const srsran_csi_rs_nzp_set_t& set : cfg.pdsch.nzp_csi_rs_sets) {
+      for (uint32_t i = 0; i < set.count; ++i) {
+        if (srsran_csi_rs_send(&set.data[i].periodicity, &slot_cfg)) {
+          signalling_nzp_csi_rs.push_back(set.data[i]);
+        }
+      }
+    }
+    sig.nof_nzp_csi_rs = signalling_nzp_csi_rs.size() - sig.nzp_csi_rs_idx;
+
+    for (uint32_t n = 0; n < cell_cfg.sibs.size(); ++n) {
+      bool start_window;
+      if (n == 0) {
+        // SIB1 (slot index zero of even frames)
+        start_window = sl % nof_slots_frame == 0 and sfn % 2 == 0;
+      } else {
+        // 5.2.2.3.2 - Acquisition of SI message
+        uint32_t x   = (n - 1) * cell_cfg.sibs[n].si_window_slots;
+        start_window = cell_cfg.sibs[n].period_rf > 0 and sfn % cell_cfg.sibs[n].period_rf == x / nof_slots_frame and
+                       sl % nof_slots_frame == x % nof_slots_frame;
+      }
+      if (start_window) {
+        sig.si_window_start |= 1U << n;
+      }
+    }
+  }
+  srsran_assert(signalling_nzp_csi_rs.size() <= std::numeric_limits<uint16_t>::max(), "Too many NZP-CSI-RS");
+
+  // SSB region, the code assumes 15kHz subcarrier spacing
+  float    ssb_offset_hz = cell_cfg.carrier.ssb_center_freq_hz - cell_cfg.carrier.dl_center_frequency_hz;
+  int      ssb_offset_rb = ceil(ssb_offset_hz / (15000.0f * 12));
+  int      ssb_start_rb  = cell_cfg.carrier.nof_prb / 2 + ssb_offset_rb - 10;
+  uint32_t ssb_len_rb    = 20;
+  if (ssb_start_rb >= 0 and ssb_start_rb + ssb_len_rb < cell_cfg.carrier.nof_prb) {
+    ssb_prbs = prb_interval{(uint32_t)ssb_start_rb, ssb_start_rb + ssb_len_rb};
+  }
 }
 
 cell_config_manager::cell_config_manager(uint32_t                   cc_,
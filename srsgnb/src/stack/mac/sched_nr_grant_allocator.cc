@@ -277,8 +277,8 @@ alloc_result bwp_slot_allocator::alloc_rar_and_msg3(uint16_t
     // Generate PUSCH content
     success = ue->phy().get_pusch_cfg(slot_cfg, rar_grant.msg3_dci, pusch.sch);
     srsran_assert(success, "Error converting DCI to PUSCH grant");
-    pusch.sch.grant.tb[0].softbuffer.rx = ue.h_ul->get_softbuffer().get();
     ue.h_ul->set_tbs(pusch.sch.grant.tb[0].tbs);
+    pusch.sch.grant.tb[0].softbuffer.rx = ue.h_ul->get_softbuffer().get();
   }
 
   return alloc_result::success;
@@ -473,12 +473,12 @@ alloc_result bwp_slot_allocator::alloc_pusch(slot_ue& ue, const prb_grant& ul_gr
   pusch.pid    = ue.h_ul->pid;
   bool success = ue->phy().get_pusch_cfg(slot_cfg, pdcch.dci, pusch.sch);
   srsran_assert(success, "Error converting DCI to PUSCH grant");
-  pusch.sch.grant.tb[0].softbuffer.rx = ue.h_ul->get_softbuffer().get();
   if (ue.h_ul->nof_retx() == 0) {
     ue.h_ul->set_tbs(pusch.sch.grant.tb[0].tbs); // update HARQ with correct TBS
   } else {
     srsran_assert(pusch.sch.grant.tb[0].tbs == (int)ue.h_ul->tbs(), "The TBS did not remain constant in retx");
   }
+  pusch.sch.grant.tb[0].softbuffer.rx = ue.h_ul->get_softbuffer().get();
 
   return alloc_result::success;
 }
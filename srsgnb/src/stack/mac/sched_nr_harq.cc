@@ -121,9 +121,40 @@ bool harq_proc::new_retx(slot_point slot_tx_, slot_point slot_ack_)
 }
 
 dl_harq_proc::dl_harq_proc(uint32_t id_, uint32_t nprb) :
-  harq_proc(id_), softbuffer(harq_softbuffer_pool::get_instance().get_tx(nprb)), pdu(srsran::make_byte_buffer())
+  harq_proc(id_), pdu(srsran::make_byte_buffer())
 {}
 
+int dl_harq_proc::ack_info(uint32_t tb_idx, bool ack)
+{
+  int ret = harq_proc::ack_info(tb_idx, ack);
+  if (empty()) {
+    // Return the softbuffer to the pool as soon as the TB is ACKed
+    softbuffer.reset();
+  }
+  return ret;
+}
+
+bool dl_harq_proc::clear_if_maxretx(slot_point slot_rx)
+{
+  if (harq_proc::clear_if_maxretx(slot_rx)) {
+    softbuffer.reset();
+    return true;
+  }
+  return false;
+}
+
+bool dl_harq_proc::set_tbs(uint32_t tbs)
+{
+  if (not harq_proc::set_tbs(tbs)) {
+    return false;
+  }
+  // Acquire a softbuffer of the class that fits the TBS, unless the one already held fits it
+  if (softbuffer == nullptr or softbuffer->max_cb() < harq_softbuffer_pool::get_nof_cb(tbs)) {
+    softbuffer = harq_softbuffer_pool::get_instance().get_tx_tbs(tbs);
+  }
+  return true;
+}
+
 void dl_harq_proc::fill_dci(srsran_dci_dl_nr_t& dci)
 {
   const static uint32_t rv_idx[4] = {0, 2, 3, 1};
@@ -190,6 +221,37 @@ bool ul_harq_proc::new_tx(slot_point          slot_tx,
   return false;
 }
 
+int ul_harq_proc::ack_info(uint32_t tb_idx, bool ack)
+{
+  int ret = harq_proc::ack_info(tb_idx, ack);
+  if (empty()) {
+    // Return the softbuffer to the pool as soon as the TB is decoded
+    softbuffer.reset();
+  }
+  return ret;
+}
+
+bool ul_harq_proc::clear_if_maxretx(slot_point slot_rx)
+{
+  if (harq_proc::clear_if_maxretx(slot_rx)) {
+    softbuffer.reset();
+    return true;
+  }
+  return false;
+}
+
+bool ul_harq_proc::set_tbs(uint32_t tbs)
+{
+  if (not harq_proc::set_tbs(tbs)) {
+    return false;
+  }
+  if (softbuffer == nullptr or softbuffer->max_cb() < harq_softbuffer_pool::get_nof_cb(tbs)) {
+    softbuffer = harq_softbuffer_pool::get_instance().get_rx_tbs(tbs);
+  }
+  softbuffer->reset(tbs);
+  return true;
+}
+
 bool ul_harq_proc::new_retx(slot_point slot_tx, const prb_grant& grant, srsran_dci_ul_nr_t& dci)
 {
   if (harq_proc::new_retx(slot_tx, slot_tx, grant)) {
@@ -214,7 +276,7 @@ harq_entity::harq_entity(uint16_t rnti_, uint32_t nprb, uint32_t nof_harq_procs,
 void harq_entity::new_slot(slot_point slot_rx_)
 {
   slot_rx = slot_rx_;
-  for (harq_proc& dl_h : dl_harqs) {
+  for (dl_harq_proc& dl_h : dl_harqs) {
     if (dl_h.clear_if_maxretx(slot_rx)) {
       logger.info("SCHED: discarding rnti=0x%x, DL TB pid=%d. Cause: Maximum number of retx exceeded (%d)",
                   rnti,
@@ -222,7 +284,7 @@ void harq_entity::new_slot(slot_point slot_rx_)
                   dl_h.max_nof_retx());
     }
   }
-  for (harq_proc& ul_h : ul_harqs) {
+  for (ul_harq_proc& ul_h : ul_harqs) {
     if (ul_h.clear_if_maxretx(slot_rx)) {
       logger.info("SCHED: discarding rnti=0x%x, UL TB pid=%d. Cause: Maximum number of retx exceeded (%d)",
                   rnti,
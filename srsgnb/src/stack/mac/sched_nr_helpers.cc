@@ -41,7 +41,7 @@ void log_sched_slot_ues(srslog::basic_logger& logger, slot_point pdcch_slot, uin
 
   const char* use_comma = "";
   for (const auto& ue_pair : slot_ues) {
-    auto& ue = ue_pair->second;
+    auto& ue = ue_pair.second;
 
     fmt::format_to(fmtbuf, "{}{{rnti=0x{:x}", use_comma, ue->rnti);
     if (ue.dl_active) {
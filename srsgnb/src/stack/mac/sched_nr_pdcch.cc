@@ -107,6 +107,7 @@ bool coreset_region::alloc_pdcch(srsran_rnti_type_t         rnti_type,
   record.ss_id          = search_space_id;
   record.is_dl          = is_dl;
   record.dci->rnti_type = rnti_type;
+  record.cce_locs       = get_cce_loc_table(record);
 
   // Try to allocate grant. If it fails, attempt the same grant, but using a different permutation of past grant DCI
   // positions
@@ -158,42 +159,42 @@ bool coreset_region::get_next_dfs()
 bool coreset_region::alloc_dfs_node(const alloc_record& record, uint32_t start_dci_idx)
 {
   alloc_tree_dfs_t& alloc_dfs = dfs_tree;
-  // Get DCI Location Table
-  auto cce_locs = get_cce_loc_table(record);
+  const auto&       cce_locs  = record.cce_locs;
   if (start_dci_idx >= cce_locs.size()) {
     return false;
   }
 
+  // Look for a candidate whose CCEs do not collide with the current solution. The collision check is a range test on
+  // the cumulative PDCCH bitmap, which is done on whole words
+  uint32_t L           = 1U << record.aggr_idx;
+  uint32_t dci_pos_idx = start_dci_idx;
+  if (not alloc_dfs.empty()) {
+    const coreset_bitmap& total_mask = alloc_dfs.back().total_mask;
+    while (dci_pos_idx < cce_locs.size() and total_mask.any(cce_locs[dci_pos_idx], cce_locs[dci_pos_idx] + L)) {
+      // there is a PDCCH collision. Try another CCE position
+      ++dci_pos_idx;
+    }
+    if (dci_pos_idx == cce_locs.size()) {
+      return false;
+    }
+  }
+
+  // Allocation successful
   tree_node node;
-  node.dci_pos_idx = start_dci_idx;
-  node.dci_pos.L   = record.aggr_idx;
-  node.rnti        = record.ue != nullptr ? record.ue->rnti : SRSRAN_INVALID_RNTI;
-  node.current_mask.resize(nof_cces());
+  node.dci_pos_idx  = dci_pos_idx;
+  node.dci_pos.L    = record.aggr_idx;
+  node.dci_pos.ncce = cce_locs[dci_pos_idx];
+  node.rnti         = record.ue != nullptr ? record.ue->rnti : SRSRAN_INVALID_RNTI;
   // get cumulative pdcch bitmap
   if (not alloc_dfs.empty()) {
     node.total_mask = alloc_dfs.back().total_mask;
   } else {
     node.total_mask.resize(nof_cces());
   }
-
-  for (; node.dci_pos_idx < cce_locs.size(); ++node.dci_pos_idx) {
-    node.dci_pos.ncce = cce_locs[node.dci_pos_idx];
-
-    node.current_mask.reset();
-    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
-    if ((node.total_mask & node.current_mask).any()) {
-      // there is a PDCCH collision. Try another CCE position
-      continue;
-    }
-
-    // Allocation successful
-    node.total_mask |= node.current_mask;
-    alloc_dfs.push_back(node);
-    record.dci->location = node.dci_pos;
-    return true;
-  }
-
-  return false;
+  node.total_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + L);
+  alloc_dfs.push_back(node);
+  record.dci->location = node.dci_pos;
+  return true;
 }
 
 srsran::span<const uint32_t> coreset_region::get_cce_loc_table(const alloc_record& record) const
@@ -55,15 +55,35 @@ void sched_nzp_csi_rs(srsran::const_span<srsran_csi_rs_nzp_set_t> nzp_csi_rs_set
   }
 }
 
-void sched_ssb_basic(const slot_point&      sl_point,
-                     uint32_t               ssb_periodicity,
-                     const srsran_mib_nr_t& mib,
-                     ssb_list&              ssb_list)
+/// Packs the MIB of the given slot into a new SSB
+static void alloc_ssb(const slot_point& sl_point, const srsran_mib_nr_t& mib, ssb_list& ssb_list)
 {
   if (ssb_list.full()) {
     srslog::fetch_basic_logger("MAC-NR").error("SCHED: Failed to allocate SSB");
     return;
   }
+
+  // code below is simplified, it assumes 15kHz subcarrier spacing and sub 3GHz carrier
+  ssb_t           ssb_msg = {};
+  srsran_mib_nr_t mib_msg = mib;
+  mib_msg.sfn             = sl_point.sfn();
+  mib_msg.hrf             = (sl_point.slot_idx() % SRSRAN_NSLOTS_PER_FRAME_NR(srsran_subcarrier_spacing_15kHz) >=
+                 SRSRAN_NSLOTS_PER_FRAME_NR(srsran_subcarrier_spacing_15kHz) / 2);
+  // This corresponds to "Position in Burst" = 1000
+  mib_msg.ssb_idx = 0;
+  // Remaining MIB parameters remain constant
+
+  // Pack mib message to be sent to PHY
+  int packing_ret_code = srsran_pbch_msg_nr_mib_pack(&mib_msg, &ssb_msg.pbch_msg);
+  srsran_assert(packing_ret_code == SRSRAN_SUCCESS, "SSB packing returned en error");
+  ssb_list.push_back(ssb_msg);
+}
+
+void sched_ssb_basic(const slot_point&      sl_point,
+                     uint32_t               ssb_periodicity,
+                     const srsran_mib_nr_t& mib,
+                     ssb_list&              ssb_list)
+{
   // If the periodicity is 0, it means that the parameter was not passed by the upper layers.
   // In that case, we use default value of 5ms (see Clause 4.1, TS 38.213)
   if (ssb_periodicity == 0) {
@@ -75,21 +95,8 @@ void sched_ssb_basic(const slot_point&      sl_point,
   // "ssb_periodicity * nof_slots_per_subframe" gives the number of slots in 1 ssb_periodicity time interval
   uint32_t sl_point_mod = sl_cnt % (ssb_periodicity * (uint32_t)sl_point.nof_slots_per_subframe());
 
-  // code below is simplified, it assumes 15kHz subcarrier spacing and sub 3GHz carrier
   if (sl_point_mod == 0) {
-    ssb_t           ssb_msg = {};
-    srsran_mib_nr_t mib_msg = mib;
-    mib_msg.sfn             = sl_point.sfn();
-    mib_msg.hrf             = (sl_point.slot_idx() % SRSRAN_NSLOTS_PER_FRAME_NR(srsran_subcarrier_spacing_15kHz) >=
-                   SRSRAN_NSLOTS_PER_FRAME_NR(srsran_subcarrier_spacing_15kHz) / 2);
-    // This corresponds to "Position in Burst" = 1000
-    mib_msg.ssb_idx = 0;
-    // Remaining MIB parameters remain constant
-
-    // Pack mib message to be sent to PHY
-    int packing_ret_code = srsran_pbch_msg_nr_mib_pack(&mib_msg, &ssb_msg.pbch_msg);
-    srsran_assert(packing_ret_code == SRSRAN_SUCCESS, "SSB packing returned en error");
-    ssb_list.push_back(ssb_msg);
+    alloc_ssb(sl_point, mib, ssb_list);
   }
 }
 
@@ -99,25 +106,26 @@ void sched_dl_signalling(bwp_slot_allocator& bwp_alloc)
   slot_point          sl_pdcch   = bwp_alloc.get_pdcch_tti();
   bwp_slot_grid&      sl_grid    = bwp_alloc.tx_slot_grid();
 
-  srsran_slot_cfg_t cfg;
-  cfg.idx = sl_pdcch.to_uint();
-
-  // Schedule SSB
-  sched_ssb_basic(sl_pdcch, bwp_params.cell_cfg.ssb.periodicity_ms, bwp_params.cell_cfg.mib, sl_grid.dl.phy.ssb);
-
-  // Mark SSB region as occupied
-  if (!sl_grid.dl.phy.ssb.empty()) {
-    float ssb_offset_hz =
-        bwp_params.cell_cfg.carrier.ssb_center_freq_hz - bwp_params.cell_cfg.carrier.dl_center_frequency_hz;
-    int      ssb_offset_rb = ceil(ssb_offset_hz / (15000.0f * 12));
-    int      ssb_start_rb  = bwp_params.cell_cfg.carrier.nof_prb / 2 + ssb_offset_rb - 10;
-    uint32_t ssb_len_rb    = 20;
-    assert(ssb_start_rb >= 0 && ssb_start_rb + ssb_len_rb < bwp_params.cell_cfg.carrier.nof_prb);
-    sl_grid.reserve_pdsch(prb_grant({(uint32_t)ssb_start_rb, ssb_start_rb + ssb_len_rb}));
+  // The recurring signalling of the slot is looked up in the table derived from the cell config
+  const bwp_params_t::signalling_slot_cfg& sig = bwp_params.get_signalling_slot(sl_pdcch);
+
+  // Schedule SSB and mark SSB region as occupied
+  if (sig.ssb) {
+    alloc_ssb(sl_pdcch, bwp_params.cell_cfg.mib, sl_grid.dl.phy.ssb);
+    if (!sl_grid.dl.phy.ssb.empty()) {
+      assert(not bwp_params.ssb_prbs.empty());
+      sl_grid.reserve_pdsch(prb_grant(bwp_params.ssb_prbs));
+    }
   }
 
   // Schedule NZP-CSI-RS
-  sched_nzp_csi_rs(bwp_params.cfg.pdsch.nzp_csi_rs_sets, cfg, sl_grid.dl.phy.nzp_csi_rs);
+  for (uint32_t i = 0; i < sig.nof_nzp_csi_rs; ++i) {
+    if (sl_grid.dl.phy.nzp_csi_rs.full()) {
+      srslog::fetch_basic_logger("MAC-NR").error("SCHED: Failed to allocate NZP-CSI RS");
+      return;
+    }
+    sl_grid.dl.phy.nzp_csi_rs.push_back(bwp_params.signalling_nzp_csi_rs[sig.nzp_csi_rs_idx + i]);
+  }
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -149,21 +157,11 @@ void si_sched::run_slot(bwp_slot_allocator& bwp_alloc)
   prb_bitmap     prbs          = bwp_alloc.res_grid()[sl_pdcch].pdschs.occupied_prbs(ss_id, srsran_dci_format_nr_1_0);
 
   // Update SI windows
-  uint32_t N = bwp_cfg->slots.size();
+  uint32_t win_start_mask = bwp_cfg->get_signalling_slot(sl_pdcch).si_window_start;
   for (si_msg_ctxt_t& si : pending_sis) {
-    uint32_t x = (si.n - 1) * si.win_len_slots;
-
     if (not si.win_start.valid()) {
-      bool start_window;
-      if (si.n == 0) {
-        // SIB1 (slot index zero of even frames)
-        start_window = sl_pdcch.slot_idx() == 0 and sl_pdcch.sfn() % 2 == 0;
-      } else {
-        // 5.2.2.3.2 - Acquisition of SI message
-        start_window =
-            (sl_pdcch.sfn() % si.period_frames == x / N) and sl_pdcch.slot_idx() == x % bwp_cfg->slots.size();
-      }
-      if (start_window) {
+      // SIB1 windows start in the slot index zero of even frames, see 5.2.2.3.2 for the SI messages
+      if ((win_start_mask >> si.n) & 1U) {
         // If start of SI message window
         si.win_start = sl_pdcch;
         si.n_tx      = 0;
@@ -0,0 +1,202 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsgnb/hdr/stack/mac/sched_nr_time_pf.h"
+#include "srsran/phy/phch/ra_nr.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/// Spectral efficiency, in bits per RE, of a C-RNTI grant with the given MCS
+static float mcs_to_se(srsran_mcs_table_t mcs_table, uint32_t mcs)
+{
+  double       R   = srsran_ra_nr_R_from_mcs(
+      mcs_table, srsran_dci_format_nr_1_0, srsran_search_space_type_ue, srsran_rnti_type_c, mcs);
+  srsran_mod_t mod = srsran_ra_nr_mod_from_mcs(
+      mcs_table, srsran_dci_format_nr_1_0, srsran_search_space_type_ue, srsran_rnti_type_c, mcs);
+  if (std::isnan(R) or mod == SRSRAN_MOD_NITEMS) {
+    return 0;
+  }
+  return R * srsran_mod_bits_x_symbol(mod);
+}
+
+sched_nr_time_pf::sched_nr_time_pf(const bwp_params_t& bwp_cfg_, srsran::task_thread_pool* cand_pool_) :
+  sched_nr_base(cand_pool_), bwp_cfg(&bwp_cfg_)
+{
+  if (not bwp_cfg->sched_cfg.sched_policy_args.empty()) {
+    fairness_coeff = std::stof(bwp_cfg->sched_cfg.sched_policy_args);
+  }
+
+  cand_prio.reserve(SRSENB_MAX_UES);
+  queue.reserve(SRSENB_MAX_UES);
+}
+
+void sched_nr_time_pf::sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  sched_users(ue_db, slot_alloc, true);
+}
+
+void sched_nr_time_pf::sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  sched_users(ue_db, slot_alloc, false);
+}
+
+void sched_nr_time_pf::sched_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc, bool is_dl)
+{
+  make_candidates(ue_db, slot_alloc, is_dl);
+
+  // Compute the metric of the active UEs. Their averages are brought up to the previous slot first
+  slot_point slot = slot_alloc.get_pdcch_tti();
+  cand_prio.resize(candidates.size());
+  queue.clear();
+  for (uint32_t i = 0; i < candidates.size(); ++i) {
+    const ue_candidate& cand = candidates[i];
+    if (cand.type == cand_type::none) {
+      continue;
+    }
+    uint16_t rnti = (*cand.ue)->rnti;
+    if (not ue_ctxt_db.contains(rnti)) {
+      // The position may still be taken by a UE that has since been removed
+      ue_ctxt_db.overwrite(rnti, ue_pf_ctxt{});
+    }
+    avg_rate_t& avg = is_dl ? ue_ctxt_db[rnti].dl : ue_ctxt_db[rnti].ul;
+    if (avg.last_slot.valid() and slot - avg.last_slot > 1) {
+      avg.add_zero_samples(slot - avg.last_slot - 1);
+    }
+    avg.last_slot = slot - 1;
+
+    float r = is_dl ? dl_rate(cand) : ul_rate(cand);
+    float R = avg.avg_rate;
+    cand_prio[i] = (R != 0) ? r / std::pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+    queue.push_back(i);
+  }
+
+  // Retxs go first, then the highest metric
+  auto cmp = [this](uint32_t lhs, uint32_t rhs) {
+    bool is_retx1 = candidates[lhs].type == cand_type::retx, is_retx2 = candidates[rhs].type == cand_type::retx;
+    return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and cand_prio[lhs] < cand_prio[rhs]);
+  };
+  std::make_heap(queue.begin(), queue.end(), cmp);
+
+  int alloc_idx = -1;
+  while (not queue.empty()) {
+    ue_candidate& cand = candidates[queue.front()];
+    alloc_result  ret  = is_dl ? slot_alloc.alloc_pdsch(*cand.ue, cand.ss_id, cand.grant)
+                               : slot_alloc.alloc_pusch(*cand.ue, cand.grant);
+    if (ret == alloc_result::success) {
+      alloc_idx = queue.front();
+      break;
+    }
+    std::pop_heap(queue.begin(), queue.end(), cmp);
+    queue.pop_back();
+  }
+
+  // Only newtxs count as allocated rate. The remaining active UEs get a zero sample
+  for (uint32_t i = 0; i < candidates.size(); ++i) {
+    const ue_candidate& cand = candidates[i];
+    if (cand.type == cand_type::none) {
+      continue;
+    }
+    uint32_t alloc_bytes = 0;
+    if ((int)i == alloc_idx and cand.type == cand_type::newtx) {
+      alloc_bytes = is_dl ? cand.ue->h_dl->tbs() / 8 : cand.ue->h_ul->tbs() / 8;
+    }
+    ue_pf_ctxt& ctxt = ue_ctxt_db[(*cand.ue)->rnti];
+    (is_dl ? ctxt.dl : ctxt.ul).update(slot, alloc_bytes);
+  }
+}
+
+float sched_nr_time_pf::grant_nof_prbs(const prb_grant& grant) const
+{
+  return grant.is_alloc_type0() ? grant.rbgs().count() * bwp_cfg->P : grant.prbs().length();
+}
+
+/// The metric only compares UEs, so the rates are estimated in bits per RE of the grant PRBs
+float sched_nr_time_pf::dl_rate(const ue_candidate& cand) const
+{
+  const slot_ue& ue  = *cand.ue;
+  int            mcs = ue->fixed_pdsch_mcs();
+  float          se;
+  if (cand.type == cand_type::retx) {
+    se = mcs_to_se(ue.cfg().phy().pdsch.mcs_table, ue.h_dl->mcs());
+  } else if (mcs < 0) {
+    se = std::max(srsran_ra_nr_cqi_to_se(ue.dl_cqi(), ue.cfg().phy().csi.reports->cqi_table), 0.0);
+  } else {
+    se = mcs_to_se(ue.cfg().phy().pdsch.mcs_table, mcs);
+  }
+  return se * grant_nof_prbs(cand.grant);
+}
+
+float sched_nr_time_pf::ul_rate(const ue_candidate& cand) const
+{
+  const slot_ue& ue  = *cand.ue;
+  int            mcs = cand.type == cand_type::retx ? (int)ue.h_ul->mcs() : ue->fixed_pusch_mcs();
+  float          se  = 0;
+  if (mcs < 0) {
+    se = std::max(srsran_ra_nr_cqi_to_se(std::min(ue.ul_cqi(), 15U), SRSRAN_CSI_CQI_TABLE_1), 0.0);
+  } else {
+    se = mcs_to_se(ue.cfg().phy().pusch.mcs_table, mcs);
+  }
+  return se * grant_nof_prbs(cand.grant);
+}
+
+void sched_nr_time_pf::avg_rate_t::add_zero_samples(uint32_t nof_zeros)
+{
+  // fast start. Each zero sample scales the average by n / (n + 1)
+  uint32_t fast_start_len = static_cast<uint32_t>(std::ceil(1 / rate_avg_alpha));
+  if (nof_samples < fast_start_len) {
+    uint32_t n = std::min(nof_zeros, fast_start_len - nof_samples);
+    avg_rate   = avg_rate * nof_samples / (nof_samples + n);
+    nof_samples += n;
+    nof_zeros -= n;
+  }
+  if (nof_zeros > 0) {
+    avg_rate *= std::pow(1 - rate_avg_alpha, nof_zeros);
+    nof_samples += nof_zeros;
+  }
+}
+
+void sched_nr_time_pf::avg_rate_t::save_alloc(uint32_t alloc_bytes)
+{
+  if (nof_samples < 1 / rate_avg_alpha) {
+    // fast start
+    avg_rate = avg_rate + (alloc_bytes - avg_rate) / (nof_samples + 1);
+  } else {
+    avg_rate = (1 - rate_avg_alpha) * avg_rate + rate_avg_alpha * alloc_bytes;
+  }
+  nof_samples++;
+}
+
+void sched_nr_time_pf::avg_rate_t::update(slot_point slot, uint32_t alloc_bytes)
+{
+  if (alloc_bytes > 0) {
+    save_alloc(alloc_bytes);
+  } else {
+    add_zero_samples(1);
+  }
+  last_slot = slot;
+}
+
+} // namespace sched_nr_impl
+} // namespace srsenb
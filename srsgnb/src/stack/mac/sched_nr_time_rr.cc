@@ -20,31 +20,107 @@
  */
 
 #include "srsgnb/hdr/stack/mac/sched_nr_time_rr.h"
+#include "srsran/common/thread_pool.h"
 
 namespace srsenb {
 namespace sched_nr_impl {
 
+/// Below this number of UEs, waking up the candidate threads takes longer than generating the candidates serially
+static const uint32_t min_parallel_cand_ues = 32;
+
+/// Number of UEs whose candidates are generated by each parallel task
+static const uint32_t nof_cand_ues_per_task = 16;
+
+void sched_nr_base::make_dl_candidate(ue_candidate& cand, bwp_slot_allocator& slot_alloc)
+{
+  slot_ue& ue = *cand.ue;
+  cand.type   = cand_type::none;
+  if (ue.h_dl == nullptr) {
+    return;
+  }
+  if (ue.h_dl->has_pending_retx(slot_alloc.get_tti_rx())) {
+    cand.type  = cand_type::retx;
+    cand.ss_id = ue->find_ss_id(srsran_dci_format_nr_1_0);
+    cand.grant = ue.h_dl->prbs();
+  } else if (ue.dl_bytes > 0 and ue.h_dl->empty()) {
+    cand.ss_id = ue->find_ss_id(srsran_dci_format_nr_1_0);
+    if (cand.ss_id < 0) {
+      return;
+    }
+    cand.type  = cand_type::newtx;
+    cand.grant = find_optimal_dl_grant(slot_alloc, ue, cand.ss_id);
+  }
+}
+
+void sched_nr_base::make_ul_candidate(ue_candidate& cand, bwp_slot_allocator& slot_alloc)
+{
+  slot_ue& ue = *cand.ue;
+  cand.type   = cand_type::none;
+  if (ue.h_ul == nullptr) {
+    return;
+  }
+  if (ue.h_ul->has_pending_retx(slot_alloc.get_tti_rx())) {
+    cand.type  = cand_type::retx;
+    cand.grant = ue.h_ul->prbs();
+  } else if (ue.ul_bytes > 0 and ue.h_ul->empty()) {
+    cand.type  = cand_type::newtx;
+    cand.grant = prb_interval{0, slot_alloc.cfg.cfg.rb_width};
+  }
+}
+
+void sched_nr_base::make_candidate_range(void* arg, uint32_t task_idx)
+{
+  auto*    sched = static_cast<sched_nr_base*>(arg);
+  uint32_t begin = task_idx * nof_cand_ues_per_task;
+  uint32_t end   = std::min(begin + nof_cand_ues_per_task, (uint32_t)sched->candidates.size());
+  for (uint32_t i = begin; i < end; ++i) {
+    if (sched->cand_is_dl) {
+      make_dl_candidate(sched->candidates[i], *sched->cand_alloc);
+    } else {
+      make_ul_candidate(sched->candidates[i], *sched->cand_alloc);
+    }
+  }
+}
+
+/// Phase 1: derives the candidate of every UE. It only reads the slot grid, so the UEs are independent
+void sched_nr_base::make_candidates(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc, bool is_dl)
+{
+  candidates.clear();
+  for (auto& ue_pair : ue_db) {
+    candidates.emplace_back();
+    candidates.back().ue = &ue_pair.second;
+  }
+  cand_alloc = &slot_alloc;
+  cand_is_dl = is_dl;
+
+  uint32_t nof_tasks = (candidates.size() + nof_cand_ues_per_task - 1) / nof_cand_ues_per_task;
+  if (cand_pool != nullptr and candidates.size() >= min_parallel_cand_ues) {
+    cand_pool->parallel_for(nof_tasks, make_candidate_range, this);
+  } else {
+    for (uint32_t task_idx = 0; task_idx < nof_tasks; ++task_idx) {
+      make_candidate_range(this, task_idx);
+    }
+  }
+}
+
 /**
- * @brief Algorithm to select next UE to allocate in a time-domain RR fashion
- * @param ue_db map of "slot_ue"
- * @param rr_count starting index to select next UE
- * @param p callable with signature "bool(slot_ue&)" that returns true if UE allocation was successful
+ * @brief Phase 2: commits the candidates of the given type in a time-domain RR fashion, starting at index rr_count
+ * @param p callable with signature "alloc_result(ue_candidate&)" that allocates the candidate
  * @return true if a UE was allocated
  */
-template <typename Predicate>
-bool round_robin_apply(slot_ue_map_t& ue_db, uint32_t rr_count, Predicate p)
+template <typename Candidates, typename Type, typename Predicate>
+bool round_robin_commit(Candidates& candidates, Type type, uint32_t rr_count, Predicate p)
 {
-  if (ue_db.empty()) {
+  if (candidates.empty()) {
     return false;
   }
-  auto it = ue_db.begin();
-  std::advance(it, (rr_count % ue_db.size()));
-  for (uint32_t count = 0; count < ue_db.size(); ++count, ++it) {
-    if (it == ue_db.end()) {
+  uint32_t idx = rr_count % candidates.size();
+  for (uint32_t count = 0; count < candidates.size(); ++count, ++idx) {
+    if (idx == candidates.size()) {
       // wrap-around
-      it = ue_db.begin();
+      idx = 0;
     }
-    if (p(it->second)) {
+    if (candidates[idx].type == type and p(candidates[idx]) == alloc_result::success) {
       return true;
     }
   }
@@ -53,63 +129,30 @@ bool round_robin_apply(slot_ue_map_t& ue_db, uint32_t rr_count, Predicate p)
 
 void sched_nr_time_rr::sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
 {
-  // Start with retxs
-  auto retx_ue_function = [&slot_alloc](slot_ue& ue) {
-    if (ue.h_dl != nullptr and ue.h_dl->has_pending_retx(slot_alloc.get_tti_rx())) {
-      alloc_result res = slot_alloc.alloc_pdsch(ue, ue->find_ss_id(srsran_dci_format_nr_1_0), ue.h_dl->prbs());
-      if (res == alloc_result::success) {
-        return true;
-      }
-    }
-    return false;
-  };
-  if (round_robin_apply(ue_db, slot_alloc.get_pdcch_tti().to_uint(), retx_ue_function)) {
-    return;
-  }
+  make_candidates(ue_db, slot_alloc, true);
 
-  // Move on to new txs
-  auto newtx_ue_function = [&slot_alloc](slot_ue& ue) {
-    if (ue.dl_bytes > 0 and ue.h_dl != nullptr and ue.h_dl->empty()) {
-      int ss_id = ue->find_ss_id(srsran_dci_format_nr_1_0);
-      if (ss_id < 0) {
-        return false;
-      }
-      prb_grant    prbs = find_optimal_dl_grant(slot_alloc, ue, ss_id);
-      alloc_result res  = slot_alloc.alloc_pdsch(ue, ss_id, prbs);
-      if (res == alloc_result::success) {
-        return true;
-      }
-    }
-    return false;
+  auto alloc_ue = [&slot_alloc](ue_candidate& cand) {
+    return slot_alloc.alloc_pdsch(*cand.ue, cand.ss_id, cand.grant);
   };
-  round_robin_apply(ue_db, slot_alloc.get_pdcch_tti().to_uint(), newtx_ue_function);
+
+  // Start with retxs, then move on to new txs
+  uint32_t rr_count = slot_alloc.get_pdcch_tti().to_uint();
+  if (not round_robin_commit(candidates, cand_type::retx, rr_count, alloc_ue)) {
+    round_robin_commit(candidates, cand_type::newtx, rr_count, alloc_ue);
+  }
 }
 
 void sched_nr_time_rr::sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
 {
-  // Start with retxs
-  if (round_robin_apply(ue_db, slot_alloc.get_pdcch_tti().to_uint(), [&slot_alloc](slot_ue& ue) {
-        if (ue.h_ul != nullptr and ue.h_ul->has_pending_retx(slot_alloc.get_tti_rx())) {
-          alloc_result res = slot_alloc.alloc_pusch(ue, ue.h_ul->prbs());
-          if (res == alloc_result::success) {
-            return true;
-          }
-        }
-        return false;
-      })) {
-    return;
-  }
+  make_candidates(ue_db, slot_alloc, false);
 
-  // Move on to new txs
-  round_robin_apply(ue_db, slot_alloc.get_pdcch_tti().to_uint(), [&slot_alloc](slot_ue& ue) {
-    if (ue.ul_bytes > 0 and ue.h_ul != nullptr and ue.h_ul->empty()) {
-      alloc_result res = slot_alloc.alloc_pusch(ue, prb_interval{0, slot_alloc.cfg.cfg.rb_width});
-      if (res == alloc_result::success) {
-        return true;
-      }
-    }
-    return false;
-  });
+  auto alloc_ue = [&slot_alloc](ue_candidate& cand) { return slot_alloc.alloc_pusch(*cand.ue, cand.grant); };
+
+  // Start with retxs, then move on to new txs
+  uint32_t rr_count = slot_alloc.get_pdcch_tti().to_uint();
+  if (not round_robin_commit(candidates, cand_type::retx, rr_count, alloc_ue)) {
+    round_robin_commit(candidates, cand_type::newtx, rr_count, alloc_ue);
+  }
 }
 
 } // namespace sched_nr_impl
@@ -27,15 +27,15 @@
 namespace srsenb {
 namespace sched_nr_impl {
 
-cc_worker::cc_worker(const cell_config_manager& params) :
+cc_worker::cc_worker(const cell_config_manager& params, srsran::task_thread_pool* cand_pool) :
   cfg(params), logger(srslog::fetch_basic_logger(params.sched_args.logger_name))
 {
   for (uint32_t bwp_id = 0; bwp_id < cfg.bwps.size(); ++bwp_id) {
-    bwps.emplace_back(cfg.bwps[bwp_id]);
+    bwps.emplace_back(cfg.bwps[bwp_id], cand_pool);
   }
 
   // Pre-allocate HARQs in common pool of softbuffers
-  harq_softbuffer_pool::get_instance().init_pool(cfg.nof_prb());
+  harq_softbuffer_pool::get_instance().init_pool();
 }
 
 void cc_worker::dl_rach_info(const sched_nr_interface::rar_info_t& rar_info)
@@ -0,0 +1,340 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Measures how the NR scheduler scales with the number of connected UEs. For each combination of number of UEs, number
+ * of carriers and traffic pattern, the UEs are configured with all the carriers, and the time from the slot indication
+ * until the results of all carriers are available is recorded. The memory per UE is the heap growth of a fresh
+ * scheduler once all the UEs are configured.
+ *
+ * Usage: sched_nr_scale_benchmark [nof_slots] [max_nof_ues]
+ *
+ * UE counts above SRSENB_MAX_UES are skipped. Build with e.g. -DMAX_UES=2048 to benchmark them.
+ */
+
+#include "sched_nr_cfg_generators.h"
+#include "sched_nr_sim_ue.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+#include <malloc.h>
+
+namespace srsenb {
+
+/// Bytes in use by the heap of this process
+static size_t heap_bytes_in_use()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  return mallinfo2().uordblks;
+#elif defined(__GLIBC__)
+  return mallinfo().uordblks;
+#else
+  return 0;
+#endif
+}
+
+/// Every "period" slots, each UE gets new DL and UL data. The slot of arrival is shifted by the RNTI. A period of 0
+/// stands for full buffer, where the scheduler refills the UE buffers by itself
+struct traffic_pattern {
+  const char* name;
+  uint32_t    period;
+  uint32_t    dl_bytes;
+  uint32_t    ul_bytes;
+};
+static const traffic_pattern traffic_patterns[] = {{"full_buffer", 0, 0, 0},
+                                                   {"voip", 20, 40, 40},
+                                                   {"bursty", 100, 15000, 5000}};
+
+struct run_params {
+  uint32_t               nof_ues;
+  uint32_t               nof_cells;
+  const traffic_pattern* traffic;
+  uint32_t               nof_slots;
+};
+
+struct run_data {
+  run_params params;
+  double     mean_usec;
+  double     p50_usec, p90_usec, p99_usec, p999_usec, max_usec;
+  double     dl_mbps, ul_mbps;
+  size_t     base_bytes;
+  size_t     bytes_per_ue;
+};
+
+const uint32_t nof_warmup_slots     = 100;
+const uint32_t drb_lcid             = 4;
+const uint16_t first_rnti           = 0x4601;
+const uint32_t max_ul_pending_bytes = 1000000;
+
+sched_nr_interface::sched_args_t get_sched_args(const traffic_pattern& traffic)
+{
+  sched_nr_interface::sched_args_t args;
+  args.auto_refill_buffer = traffic.period == 0;
+  return args;
+}
+
+sched_nr_interface::ue_cfg_t get_ue_cfg(uint32_t nof_cells)
+{
+  sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(nof_cells);
+  uecfg.lc_ch_to_add.emplace_back();
+  uecfg.lc_ch_to_add.back().lcid          = drb_lcid;
+  uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+  uecfg.lc_ch_to_add.back().cfg.group     = 1;
+  return uecfg;
+}
+
+class sched_nr_tester : public sched_nr_base_test_bench
+{
+public:
+  sched_nr_tester(const sched_nr_interface::sched_args_t& sched_args,
+                  const std::vector<sched_nr_cell_cfg_t>& cells_cfg,
+                  const traffic_pattern&                  traffic_) :
+    sched_nr_base_test_bench(sched_args, cells_cfg, "Scheduler scalability"), traffic(traffic_)
+  {}
+
+  const traffic_pattern& traffic;
+  bool                   record_stats = false;
+
+  std::vector<uint64_t>        slot_latencies_ns;
+  uint64_t                     dl_bytes = 0, ul_bytes = 0;
+  std::map<uint16_t, uint32_t> ul_pending_bytes;
+
+  void add_user(uint16_t rnti, const sched_nr_interface::ue_cfg_t& uecfg)
+  {
+    user_cfg(rnti, uecfg);
+    ul_pending_bytes[rnti] = 0;
+  }
+
+  /// Generates the new DL and UL data of all UEs for the given slot
+  void new_slot_traffic(uint32_t slot_count)
+  {
+    if (traffic.period == 0) {
+      return;
+    }
+    for (auto& ue : ul_pending_bytes) {
+      if ((slot_count + ue.first) % traffic.period == 0) {
+        add_rlc_dl_bytes(ue.first, drb_lcid, traffic.dl_bytes);
+        ue.second = std::min(ue.second + traffic.ul_bytes, max_ul_pending_bytes);
+        sched_ptr->ul_bsr(ue.first, 1, ue.second);
+      }
+    }
+  }
+
+  void set_external_slot_events(const sim_nr_ue_ctxt_t& ue_ctxt, ue_nr_slot_events& pending_events) override
+  {
+    for (auto& cc_events : pending_events.cc_list) {
+      if (cc_events.cqi >= 0) {
+        cc_events.cqi = 15;
+      }
+    }
+  }
+
+  void process_slot_result(const sim_nr_enb_ctxt_t& enb_ctxt, srsran::const_span<cc_result_t> cc_list) override
+  {
+    // The UE reports its remaining UL buffer with each new PUSCH transmission
+    for (const cc_result_t& cc_out : cc_list) {
+      for (const auto& pusch : cc_out.res.ul->pusch) {
+        auto it = ul_pending_bytes.find(pusch.sch.grant.rnti);
+        if (traffic.period > 0 and pusch.sch.grant.tb[0].rv == 0 and it != ul_pending_bytes.end()) {
+          it->second -= std::min(it->second, pusch.sch.grant.tb[0].tbs / 8U);
+          sched_ptr->ul_bsr(it->first, 1, it->second);
+        }
+      }
+    }
+    if (not record_stats) {
+      return;
+    }
+
+    // The latency of the slot is the one of the last carrier to finish
+    uint64_t slot_ns = 0;
+    for (const cc_result_t& cc_out : cc_list) {
+      slot_ns = std::max(slot_ns, (uint64_t)cc_out.cc_latency_ns.count());
+      for (const auto& pdsch : cc_out.res.dl->phy.pdsch) {
+        if (pdsch.sch.grant.rnti_type == srsran_rnti_type_c) {
+          dl_bytes += pdsch.sch.grant.tb[0].tbs / 8U;
+        }
+      }
+      for (const auto& pusch : cc_out.res.ul->pusch) {
+        if (pusch.sch.grant.rnti_type == srsran_rnti_type_c) {
+          ul_bytes += pusch.sch.grant.tb[0].tbs / 8U;
+        }
+      }
+    }
+    slot_latencies_ns.push_back(slot_ns);
+  }
+};
+
+/// Runs one slot of the scheduler, without simulator
+static void run_sched_slot(sched_nr& sched_obj, slot_point slot_tx, uint32_t nof_cells)
+{
+  sched_obj.slot_indication(slot_tx);
+  for (uint32_t cc = 0; cc < nof_cells; ++cc) {
+    sched_obj.get_dl_sched(slot_tx, cc);
+    sched_obj.get_ul_sched(slot_tx, cc);
+  }
+}
+
+/// Heap growth of a scheduler without simulator when "nof_ues" UEs are configured
+void measure_memory(const run_params& params, run_data& result)
+{
+  std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(params.nof_cells);
+  sched_nr_interface::ue_cfg_t     uecfg     = get_ue_cfg(params.nof_cells);
+  slot_point                       slot_tx(0, TX_ENB_DELAY);
+
+  size_t                    heap_start = heap_bytes_in_use();
+  std::unique_ptr<sched_nr> sched_obj(new sched_nr());
+  sched_obj->config(get_sched_args(*params.traffic), cells_cfg);
+  run_sched_slot(*sched_obj, slot_tx++, params.nof_cells);
+  size_t heap_cells = heap_bytes_in_use();
+
+  // The UE configurations are applied in the following slot
+  for (uint32_t i = 0; i < params.nof_ues; ++i) {
+    sched_obj->ue_cfg(first_rnti + i, uecfg);
+  }
+  run_sched_slot(*sched_obj, slot_tx++, params.nof_cells);
+  size_t heap_ues = heap_bytes_in_use();
+
+  result.base_bytes   = heap_cells - heap_start;
+  result.bytes_per_ue = heap_ues > heap_cells ? (heap_ues - heap_cells) / params.nof_ues : 0;
+}
+
+int run_benchmark_scenario(const run_params& params, std::vector<run_data>& run_results)
+{
+  // The test bench keeps a reference to the scheduler arguments
+  sched_nr_interface::sched_args_t sched_args = get_sched_args(*params.traffic);
+  std::vector<sched_nr_cell_cfg_t> cells_cfg  = get_default_cells_cfg(params.nof_cells);
+  sched_nr_interface::ue_cfg_t     uecfg      = get_ue_cfg(params.nof_cells);
+  sched_nr_tester                  tester(sched_args, cells_cfg, *params.traffic);
+
+  for (uint32_t i = 0; i < params.nof_ues; ++i) {
+    tester.add_user(first_rnti + i, uecfg);
+  }
+
+  for (uint32_t nof_slots = 0; nof_slots < nof_warmup_slots + params.nof_slots; ++nof_slots) {
+    slot_point slot_rx(0, nof_slots % 10240);
+    slot_point slot_tx = slot_rx + TX_ENB_DELAY;
+
+    tester.record_stats = nof_slots >= nof_warmup_slots;
+    tester.new_slot_traffic(nof_slots);
+    tester.run_slot(slot_tx);
+  }
+  tester.stop();
+
+  std::vector<uint64_t>& lat = tester.slot_latencies_ns;
+  std::sort(lat.begin(), lat.end());
+  double mean = 0;
+  for (uint64_t v : lat) {
+    mean += v;
+  }
+  auto percentile = [&lat](double q) { return lat[std::min((size_t)(q * lat.size()), lat.size() - 1)] / 1000.0; };
+
+  run_data r  = {};
+  r.params    = params;
+  r.mean_usec = mean / lat.size() / 1000.0;
+  r.p50_usec  = percentile(0.5);
+  r.p90_usec  = percentile(0.9);
+  r.p99_usec  = percentile(0.99);
+  r.p999_usec = percentile(0.999);
+  r.max_usec  = lat.back() / 1000.0;
+  r.dl_mbps   = tester.dl_bytes * 8.0 / params.nof_slots / 1000.0;
+  r.ul_mbps   = tester.ul_bytes * 8.0 / params.nof_slots / 1000.0;
+  measure_memory(params, r);
+  run_results.push_back(r);
+
+  return SRSRAN_SUCCESS;
+}
+
+void print_benchmark_results(const std::vector<run_data>& run_results)
+{
+  srslog::flush();
+  fmt::print("Slot decision latency of all carriers in usec, heap memory of the scheduler and of each UE\n");
+  fmt::print("DL/UL is the rate of granted TBS, as sched_nr grants all the free PRBs of the BWP to a UE with data\n");
+  fmt::print("run    Nue  Ncell      traffic    DL/UL [Mbps]     mean      p50      p90      p99    p99.9      max  "
+             "base [KB]   UE [B]\n");
+  fmt::print("------------------------------------------------------------------------------------------------------"
+             "------------------\n");
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    const run_data& r = run_results[i];
+    fmt::print("{:>3d}{:>7d}{:>7d}{:>13}{:>9.1f}/{:>6.1f}{:>9.1f}{:>9.1f}{:>9.1f}{:>9.1f}{:>9.1f}{:>9.1f}"
+               "{:>11d}{:>9d}\n",
+               i,
+               r.params.nof_ues,
+               r.params.nof_cells,
+               r.params.traffic->name,
+               r.dl_mbps,
+               r.ul_mbps,
+               r.mean_usec,
+               r.p50_usec,
+               r.p90_usec,
+               r.p99_usec,
+               r.p999_usec,
+               r.max_usec,
+               r.base_bytes / 1024,
+               r.bytes_per_ue);
+  }
+}
+
+int run_all(uint32_t nof_slots, uint32_t max_nof_ues)
+{
+  std::vector<uint32_t> nof_ues_list   = {10, 50, 100, 500, 1000, 2000};
+  std::vector<uint32_t> nof_cells_list = {1, 2, 4};
+  srslog::basic_logger& mac_logger     = srslog::fetch_basic_logger("MAC-NR");
+
+  std::vector<run_data> run_results;
+  for (uint32_t nof_ues : nof_ues_list) {
+    if (nof_ues > max_nof_ues) {
+      continue;
+    }
+    if (nof_ues > SRSENB_MAX_UES) {
+      fmt::print("Skipping runs with {} UEs, as SRSENB_MAX_UES={}\n", nof_ues, SRSENB_MAX_UES);
+      continue;
+    }
+    for (uint32_t nof_cells : nof_cells_list) {
+      for (const traffic_pattern& traffic : traffic_patterns) {
+        run_params params = {nof_ues, nof_cells, &traffic, nof_slots};
+        mac_logger.info("\n### New run: nof_ues=%d, nof_cells=%d, traffic=%s ###\n", nof_ues, nof_cells, traffic.name);
+        TESTASSERT(run_benchmark_scenario(params, run_results) == SRSRAN_SUCCESS);
+      }
+    }
+  }
+
+  print_benchmark_results(run_results);
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main(int argc, char* argv[])
+{
+  uint32_t nof_slots   = argc > 1 ? strtoul(argv[1], nullptr, 10) : 10000;
+  uint32_t max_nof_ues = argc > 2 ? strtoul(argv[2], nullptr, 10) : std::numeric_limits<uint32_t>::max();
+
+  auto& test_logger = srslog::fetch_basic_logger("TEST");
+  test_logger.set_level(srslog::basic_levels::error);
+  auto& mac_nr_logger = srslog::fetch_basic_logger("MAC-NR");
+  mac_nr_logger.set_level(srslog::basic_levels::error);
+  srslog::init();
+
+  TESTASSERT(srsenb::run_all(nof_slots, max_nof_ues) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_nr_cfg_generators.h"
+#include "srsgnb/hdr/stack/mac/sched_nr_signalling.h"
+#include "srsran/common/test_common.h"
+
+namespace srsenb {
+
+using namespace sched_nr_impl;
+
+/// The signalling table of the BWP gives the same SSB, NZP-CSI-RS and SI windows as evaluating the rules in every slot
+void test_signalling_table(uint32_t ssb_periodicity_ms, uint32_t csi_rs_period)
+{
+  srsran::test_delimit_logger delimiter{"Test signalling table ssb_period={}ms, csi_rs_period={}",
+                                        ssb_periodicity_ms,
+                                        csi_rs_period};
+
+  sched_nr_interface::sched_args_t sched_args;
+  sched_nr_cell_cfg_t              cellcfg = get_default_sa_cell_cfg_common();
+  cellcfg.ssb_periodicity_ms               = ssb_periodicity_ms;
+  cellcfg.sibs.resize(2);
+  cellcfg.sibs[0].len             = 100;
+  cellcfg.sibs[0].period_rf       = 16;
+  cellcfg.sibs[0].si_window_slots = 20;
+  cellcfg.sibs[1].len             = 100;
+  cellcfg.sibs[1].period_rf       = 32;
+  cellcfg.sibs[1].si_window_slots = 20;
+
+  // Two NZP-CSI-RS sets, the second one with another period and offset
+  for (uint32_t s = 0; s < 2; ++s) {
+    srsran_csi_rs_nzp_set_t& set = cellcfg.bwps[0].pdsch.nzp_csi_rs_sets[s];
+    set                          = {};
+    set.count                    = 2;
+    for (uint32_t i = 0; i < set.count; ++i) {
+      set.data[i].id                 = 10 * s + i;
+      set.data[i].periodicity.period = s == 0 ? 80 : csi_rs_period;
+      set.data[i].periodicity.offset = (i + 3 * s) % set.data[i].periodicity.period;
+    }
+  }
+
+  cell_config_manager cell_params{0, cellcfg, sched_args};
+  const bwp_params_t& bwp_params = cell_params.bwps[0];
+  TESTASSERT(not bwp_params.ssb_prbs.empty());
+
+  const uint32_t N = bwp_params.slots.size();
+  uint32_t       nof_ssb = 0, nof_csi_rs = 0, nof_si_windows = 0;
+  for (uint32_t count = 0; count < 1024 * N; ++count) {
+    slot_point                               sl{(uint8_t)bwp_params.cfg.numerology_idx, count};
+    const bwp_params_t::signalling_slot_cfg& sig = bwp_params.get_signalling_slot(sl);
+
+    ssb_list ssbs;
+    sched_ssb_basic(sl, cell_params.ssb.periodicity_ms, cell_params.mib, ssbs);
+    TESTASSERT(sig.ssb == not ssbs.empty());
+    nof_ssb += ssbs.size();
+
+    srsran_slot_cfg_t slot_cfg = {};
+    slot_cfg.idx               = sl.to_uint();
+    nzp_csi_rs_list csi_rs_list;
+    sched_nzp_csi_rs(bwp_params.cfg.pdsch.nzp_csi_rs_sets, slot_cfg, csi_rs_list);
+    TESTASSERT_EQ(csi_rs_list.size(), sig.nof_nzp_csi_rs);
+    for (uint32_t i = 0; i < csi_rs_list.size(); ++i) {
+      TESTASSERT_EQ(csi_rs_list[i].id, bwp_params.signalling_nzp_csi_rs[sig.nzp_csi_rs_idx + i].id);
+    }
+    nof_csi_rs += csi_rs_list.size();
+
+    for (uint32_t n = 0; n < cellcfg.sibs.size(); ++n) {
+      bool start_window = sl.slot_idx() == 0 and sl.sfn() % 2 == 0;
+      if (n > 0) {
+        uint32_t x   = (n - 1) * cellcfg.sibs[n].si_window_slots;
+        start_window = sl.sfn() % cellcfg.sibs[n].period_rf == x / N and sl.slot_idx() == x % N;
+      }
+      TESTASSERT(start_window == (((sig.si_window_start >> n) & 1U) != 0));
+      nof_si_windows += start_window ? 1 : 0;
+    }
+  }
+
+  // The whole hyperframe was covered
+  TESTASSERT_EQ(10240 / ssb_periodicity_ms, nof_ssb);
+  TESTASSERT(nof_csi_rs > 0 and nof_si_windows > 0);
+}
+
+} // namespace srsenb
+
+int main()
+{
+  auto& test_logger = srslog::fetch_basic_logger("TEST");
+  test_logger.set_level(srslog::basic_levels::info);
+  auto& mac_nr_logger = srslog::fetch_basic_logger("MAC-NR");
+  mac_nr_logger.set_level(srslog::basic_levels::info);
+
+  // Start the log backend.
+  srslog::init();
+
+  srsenb::test_signalling_table(5, 40);
+  srsenb::test_signalling_table(20, 80);
+  srsenb::test_signalling_table(10, 16);
+}
@@ -38,6 +38,7 @@ std::default_random_engine rand_gen;
 struct sim_args_t {
   uint32_t    rand_seed;
   uint32_t    fixed_cqi;
+  std::string sched_policy;
   std::string mac_log_level;
   std::string test_log_level;
 };
@@ -138,6 +139,7 @@ void test_sched_nr_no_data(sim_args_t args)
 
   sched_nr_interface::sched_args_t cfg;
   cfg.auto_refill_buffer                     = false;
+  cfg.sched_policy                           = args.sched_policy;
   std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(nof_sectors);
 
   std::string  test_name = "Test with no data";
@@ -181,6 +183,7 @@ void test_sched_nr_data(sim_args_t args)
 
   sched_nr_interface::sched_args_t cfg;
   cfg.auto_refill_buffer                     = false;
+  cfg.sched_policy                           = args.sched_policy;
   std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(nof_sectors);
 
   std::string  test_name = "Test with data";
@@ -248,6 +251,7 @@ sim_args_t handle_args(int argc, char** argv)
   options_sim.add_options()
       ("seed",            bpo::value<uint32_t>(&args.rand_seed)->default_value(std::chrono::system_clock::now().time_since_epoch().count()), "Simulation Random Seed")
       ("cqi",            bpo::value<uint32_t>(&args.fixed_cqi)->default_value(15), "UE DL CQI")
+      ("policy",         bpo::value<std::string>(&args.sched_policy)->default_value("time_rr"), "Scheduling policy")
       ("log.mac_level",  bpo::value<std::string>(&args.mac_log_level)->default_value("info"), "MAC log level")
       ("log.test_level", bpo::value<std::string>(&args.test_log_level)->default_value("info"), "TEST log level")
       ;
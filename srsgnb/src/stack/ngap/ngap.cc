@@ -300,23 +300,19 @@ ngap::ue* ngap::user_list::find_ue_rnti(uint16_t rnti)
   if (rnti == SRSRAN_INVALID_RNTI) {
     return nullptr;
   }
-  auto it = std::find_if(
-      users.begin(), users.end(), [rnti](const user_list::pair_type& v) { return v.second->ctxt.rnti == rnti; });
-  return it != users.end() ? it->second.get() : nullptr;
+  return find_ue_gnbid(rnti_to_gnb_id[rnti]);
 }
 
 ngap::ue* ngap::user_list::find_ue_gnbid(uint32_t gnbid)
 {
-  auto it = users.find(gnbid);
-  return (it != users.end()) ? it->second.get() : nullptr;
+  value_type* u = users.find(gnbid);
+  return u != nullptr ? u->get() : nullptr;
 }
 
 ngap::ue* ngap::user_list::find_ue_amfid(uint64_t amfid)
 {
-  auto it = std::find_if(users.begin(), users.end(), [amfid](const user_list::pair_type& v) {
-    return v.second->ctxt.amf_ue_ngap_id == amfid;
-  });
-  return it != users.end() ? it->second.get() : nullptr;
+  auto it = amf_to_gnb_id.find(amfid);
+  return it != amf_to_gnb_id.end() ? find_ue_gnbid(it->second) : nullptr;
 }
 
 ngap::ue* ngap::user_list::add_user(std::unique_ptr<ngap::ue> user)
@@ -327,27 +323,71 @@ ngap::ue* ngap::user_list::add_user(std::unique_ptr<ngap::ue> user)
     logger.error("The user to be added with rnti=0x%x already exists", user->ctxt.rnti);
     return nullptr;
   }
-  if (find_ue_gnbid(user->ctxt.ran_ue_ngap_id) != nullptr) {
-    logger.error("The user to be added with ran ue ngap id=%d already exists", user->ctxt.ran_ue_ngap_id);
-    return nullptr;
-  }
   if (user->ctxt.amf_ue_ngap_id.has_value() and find_ue_amfid(user->ctxt.amf_ue_ngap_id.value()) != nullptr) {
     logger.error("The user to be added with amf id=%d already exists", user->ctxt.amf_ue_ngap_id.value());
     return nullptr;
   }
-  auto p = users.insert(std::make_pair(user->ctxt.ran_ue_ngap_id, std::move(user)));
-  return p.second ? p.first->second.get() : nullptr;
+  ue*      u     = user.get();
+  uint16_t rnti  = u->ctxt.rnti;
+  uint32_t gnbid = users.insert(std::move(user));
+  if (gnbid == table_type::invalid_id) {
+    logger.error("The user with rnti=0x%x can't be added. Cause: no free RAN UE NGAP IDs", rnti);
+    return nullptr;
+  }
+  u->ctxt.ran_ue_ngap_id = gnbid;
+  if (u->ctxt.rnti != SRSRAN_INVALID_RNTI) {
+    rnti_to_gnb_id[u->ctxt.rnti] = gnbid;
+  }
+  if (u->ctxt.amf_ue_ngap_id.has_value()) {
+    amf_to_gnb_id.emplace(u->ctxt.amf_ue_ngap_id.value(), gnbid);
+  }
+  return u;
 }
 
 void ngap::user_list::erase(ue* ue_ptr)
 {
   static srslog::basic_logger& logger = srslog::fetch_basic_logger("NGAP");
-  auto                         it     = users.find(ue_ptr->ctxt.ran_ue_ngap_id);
-  if (it == users.end()) {
+  if (find_ue_gnbid(ue_ptr->ctxt.ran_ue_ngap_id) != ue_ptr) {
     logger.error("User to be erased does not exist");
     return;
   }
-  users.erase(it);
+  if (ue_ptr->ctxt.rnti != SRSRAN_INVALID_RNTI) {
+    rnti_to_gnb_id[ue_ptr->ctxt.rnti] = table_type::invalid_id;
+  }
+  if (ue_ptr->ctxt.amf_ue_ngap_id.has_value()) {
+    amf_to_gnb_id.erase(ue_ptr->ctxt.amf_ue_ngap_id.value());
+  }
+  users.erase(ue_ptr->ctxt.ran_ue_ngap_id);
+}
+
+bool ngap::user_list::set_rnti(ue* ue_ptr, uint16_t rnti)
+{
+  ue* other = find_ue_rnti(rnti);
+  if (other != nullptr) {
+    return other == ue_ptr;
+  }
+  if (ue_ptr->ctxt.rnti != SRSRAN_INVALID_RNTI) {
+    rnti_to_gnb_id[ue_ptr->ctxt.rnti] = table_type::invalid_id;
+  }
+  ue_ptr->ctxt.rnti = rnti;
+  if (rnti != SRSRAN_INVALID_RNTI) {
+    rnti_to_gnb_id[rnti] = ue_ptr->ctxt.ran_ue_ngap_id;
+  }
+  return true;
+}
+
+bool ngap::user_list::set_amf_id(ue* ue_ptr, uint64_t amfid)
+{
+  ue* other = find_ue_amfid(amfid);
+  if (other != nullptr) {
+    return other == ue_ptr;
+  }
+  if (ue_ptr->ctxt.amf_ue_ngap_id.has_value()) {
+    amf_to_gnb_id.erase(ue_ptr->ctxt.amf_ue_ngap_id.value());
+  }
+  ue_ptr->ctxt.amf_ue_ngap_id = amfid;
+  amf_to_gnb_id.emplace(amfid, ue_ptr->ctxt.ran_ue_ngap_id);
+  return true;
 }
 
 /*******************************************************************************
@@ -402,6 +442,17 @@ bool ngap::handle_ngap_rx_pdu(srsran::byte_buffer_t* pdu)
     pcap->write_ngap(pdu->msg, pdu->N_bytes);
   }
 
+  // DL NAS Transports only need the UE IDs and the NAS-PDU, which are decoded without unpacking the whole PDU. The
+  // debug log prints the content of the message, so it needs the full unpack
+  asn1::ngap::ngap_pdu_peek_t peek;
+  if (not logger.debug.enabled() and
+      asn1::ngap::peek_ngap_pdu(peek, pdu->msg, pdu->N_bytes) == asn1::SRSASN_SUCCESS and
+      peek.pdu_type == ngap_pdu_c::types_opts::init_msg and peek.proc_code == ASN1_NGAP_ID_DL_NAS_TRANSPORT and
+      peek.ran_ue_ngap_id_present and peek.amf_ue_ngap_id_present and peek.find_ie(ASN1_NGAP_ID_NAS_PDU) != nullptr) {
+    logger.info(pdu->msg, pdu->N_bytes, "Rx - DownlinkNASTransport (%d B)", pdu->N_bytes);
+    return handle_dl_nas_transport(peek);
+  }
+
   // Unpack
   ngap_pdu_c     rx_pdu;
   asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
@@ -509,6 +560,55 @@ bool ngap::handle_ng_setup_failure(const asn1::ngap::ng_setup_fail_s& msg)
   return true;
 }
 
+bool ngap::handle_dl_nas_transport(const asn1::ngap::ngap_pdu_peek_t& msg)
+{
+  if (msg.msg_ext) {
+    logger.warning("Not handling NGAP message extension");
+  }
+  ue* u = handle_ngapmsg_ue_id(msg.ran_ue_ngap_id, msg.amf_ue_ngap_id);
+
+  if (u == nullptr) {
+    logger.warning("Couldn't find user with ran_ue_ngap_id %d and %d", msg.ran_ue_ngap_id, msg.amf_ue_ngap_id);
+    return false;
+  }
+
+  const struct {
+    uint32_t    id;
+    const char* name;
+  } unhandled_ies[] = {{ASN1_NGAP_ID_OLD_AMF, "OldAMF"},
+                       {ASN1_NGAP_ID_RAN_PAGING_PRIO, "RANPagingPriority"},
+                       {ASN1_NGAP_ID_MOB_RESTRICT_LIST, "MobilityRestrictionList"},
+                       {ASN1_NGAP_ID_IDX_TO_RFSP, "IndexToRFSP"},
+                       {ASN1_NGAP_ID_UE_AGGREGATE_MAXIMUM_BIT_RATE, "UEAggregateMaximumBitRate"},
+                       {ASN1_NGAP_ID_ALLOWED_NSSAI, "AllowedNSSAI"}};
+  for (const auto& ie : unhandled_ies) {
+    if (msg.find_ie(ie.id) != nullptr) {
+      logger.warning("Not handling %s", ie.name);
+    }
+  }
+
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  if (pdu == nullptr) {
+    logger.error("Fatal Error: Couldn't allocate buffer in ngap::run_thread().");
+    return false;
+  }
+  // The NAS-PDU octet string is unpacked straight into the buffer passed to RRC
+  const asn1::protocol_ie_ref_t* ie = msg.find_ie(ASN1_NGAP_ID_NAS_PDU);
+  asn1::cbit_ref                 bref(ie->data, ie->len);
+  uint32_t                       nas_len;
+  if (asn1::unpack_length(nas_len, bref, true) != asn1::SRSASN_SUCCESS or nas_len > pdu->get_tailroom() or
+      bref.unpack_bytes(pdu->msg, nas_len) != asn1::SRSASN_SUCCESS) {
+    logger.error("Failed to unpack NAS-PDU of DownlinkNASTransport");
+    cause_c cause;
+    cause.set_protocol().value = cause_protocol_opts::transfer_syntax_error;
+    send_error_indication(cause, msg.ran_ue_ngap_id, msg.amf_ue_ngap_id);
+    return false;
+  }
+  pdu->N_bytes = nas_len;
+  rrc->write_dl_info(u->ctxt.rnti, std::move(pdu));
+  return true;
+}
+
 bool ngap::handle_dl_nas_transport(const asn1::ngap::dl_nas_transport_s& msg)
 {
   if (msg.ext) {
@@ -825,7 +925,7 @@ ngap::ue* ngap::handle_ngapmsg_ue_id(uint32_t gnb_id, uint64_t amf_id)
 
     user_amf_ptr = users.find_ue_amfid(amf_id);
     if (not user_ptr->ctxt.amf_ue_ngap_id.has_value() and user_amf_ptr == nullptr) {
-      user_ptr->ctxt.amf_ue_ngap_id = amf_id;
+      users.set_amf_id(user_ptr, amf_id);
       return user_ptr;
     }
 
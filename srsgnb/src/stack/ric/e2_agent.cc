@@ -120,12 +120,14 @@ void e2_agent::e2_setup_proc_t::then(const srsran::proc_state_t& result)
  *                     E2 Agent class
  *********************************************************/
 
-e2_agent::e2_agent(srslog::basic_logger& logger, e2_interface_metrics* _gnb_metrics) :
+e2_agent::e2_agent(srslog::basic_logger&          logger,
+                   e2_interface_metrics*          _gnb_metrics,
+                   const srsenb::mac_kpi_sampler* _kpi_sampler) :
   task_sched(),
   logger(logger),
   rx_sockets(),
   thread("E2_AGENT_THREAD"),
-  e2ap_(logger, this, _gnb_metrics, &task_sched),
+  e2ap_(logger, this, _gnb_metrics, _kpi_sampler, &task_sched),
   e2_setup_proc(this)
 {
   gnb_metrics = _gnb_metrics;
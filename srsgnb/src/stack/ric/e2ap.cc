@@ -23,11 +23,15 @@
 #include "srsgnb/hdr/stack/ric/e2_agent.h"
 #include "srsgnb/hdr/stack/ric/e2ap_ric_subscription.h"
 
-e2ap::e2ap(srslog::basic_logger&         logger,
-           e2_agent*                     _e2_agent,
-           srsenb::e2_interface_metrics* _gnb_metrics,
-           srsran::task_scheduler*       _task_sched_ptr) :
-  logger(logger), _e2_agent(_e2_agent), e2sm_(logger, _task_sched_ptr), task_sched_ptr(_task_sched_ptr)
+e2ap::e2ap(srslog::basic_logger&          logger,
+           e2_agent*                      _e2_agent,
+           srsenb::e2_interface_metrics*  _gnb_metrics,
+           const srsenb::mac_kpi_sampler* _kpi_sampler,
+           srsran::task_scheduler*        _task_sched_ptr) :
+  logger(logger),
+  _e2_agent(_e2_agent),
+  e2sm_(logger, _task_sched_ptr, _kpi_sampler),
+  task_sched_ptr(_task_sched_ptr)
 {
   gnb_metrics          = _gnb_metrics;
   if (task_sched_ptr) {
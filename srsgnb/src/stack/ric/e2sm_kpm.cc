@@ -22,15 +22,16 @@
 #include "srsgnb/hdr/stack/ric/e2sm_kpm.h"
 #include "srsgnb/hdr/stack/ric/e2sm_kpm_metrics.h"
 #include "srsgnb/hdr/stack/ric/e2sm_kpm_report_service.h"
-#include <numeric>
 
 const std::string e2sm_kpm::short_name       = "ORAN-E2SM-KPM";
 const std::string e2sm_kpm::oid              = "1.3.6.1.4.1.53148.1.2.2.2";
 const std::string e2sm_kpm::func_description = "KPM Monitor";
 const uint32_t    e2sm_kpm::revision         = 0;
 
-e2sm_kpm::e2sm_kpm(srslog::basic_logger& logger_, srsran::task_scheduler* _task_sched_ptr) :
-  e2sm(short_name, oid, func_description, revision, _task_sched_ptr), logger(logger_)
+e2sm_kpm::e2sm_kpm(srslog::basic_logger&          logger_,
+                   srsran::task_scheduler*        _task_sched_ptr,
+                   const srsenb::mac_kpi_sampler* kpi_sampler_) :
+  e2sm(short_name, oid, func_description, revision, _task_sched_ptr), logger(logger_), kpi_sampler(kpi_sampler_)
 {
   random_gen = srsran_random_init(1234);
 
@@ -344,23 +345,37 @@ std::vector<std::string> e2sm_kpm::_get_supported_meas(uint32_t level_mask)
 
 void e2sm_kpm::receive_e2_metrics_callback(const enb_metrics_t& m)
 {
-  last_enb_metrics = m;
-  logger.debug("e2sm_kpm received new enb metrics, CPU0 Load: %.1f", last_enb_metrics.sys.cpu_load[0]);
+  meas_registry.update(m);
+  logger.debug("e2sm_kpm received new enb metrics, CPU0 Load: %.1f", meas_registry.cpu0_load);
 }
 
-bool e2sm_kpm::_collect_meas_value(e2sm_kpm_meas_def_t& meas_value, meas_record_item_c& item)
+bool e2sm_kpm::_read_kpi_samples(uint64_t& cursor, e2sm_kpm_kpi_window_t& window)
 {
-  // here we implement logic of measurement data collection, currently we only read from enb_metrics
+  window = {};
+  if (kpi_sampler == nullptr) {
+    return false;
+  }
+  window.nof_ttis = kpi_sampler->read_samples(cursor, window.sum);
+  return true;
+}
+
+bool e2sm_kpm::_collect_meas_value(e2sm_kpm_meas_def_t&         meas_value,
+                                   const e2sm_kpm_kpi_window_t& kpis,
+                                   meas_record_item_c&          item)
+{
+  // here we implement logic of measurement data collection, we read from the MAC KPI samples of the collection
+  // period and from the enb metrics registry
   if (meas_value.data_type == meas_record_item_c::types::options::integer) {
     uint32_t value;
-    if (_extract_integer_type_meas_value(meas_value, last_enb_metrics, value)) {
+    if (_extract_kpi_meas_value(meas_value, kpis, value) or
+        _extract_integer_type_meas_value(meas_value, meas_registry, value)) {
       item.set_integer() = value;
       return true;
     }
   } else {
     // data_type == meas_record_item_c::types::options::real;
     float value;
-    if (_extract_real_type_meas_value(meas_value, last_enb_metrics, value)) {
+    if (_extract_real_type_meas_value(meas_value, meas_registry, value)) {
       real_s real_value;
       // TODO: real value seems to be not supported in asn1???
       // real_value.value = value;
@@ -372,9 +387,41 @@ bool e2sm_kpm::_collect_meas_value(e2sm_kpm_meas_def_t& meas_value, meas_record_
   return false;
 }
 
-bool e2sm_kpm::_extract_integer_type_meas_value(e2sm_kpm_meas_def_t& meas_value,
-                                                const enb_metrics_t& enb_metrics,
-                                                uint32_t&            value)
+bool e2sm_kpm::_extract_kpi_meas_value(e2sm_kpm_meas_def_t&         meas_value,
+                                       const e2sm_kpm_kpi_window_t& kpis,
+                                       uint32_t&                    value)
+{
+  using kpi = srsenb::mac_kpi_sample_t;
+
+  // all the MAC KPIs are averaged over the TTIs of the collection period, for all the carriers
+  if (meas_value.label != NO_LABEL or not(meas_value.scope & (ENB_LEVEL | CELL_LEVEL)) or kpis.nof_ttis == 0) {
+    return false;
+  }
+  auto ratio = [](uint64_t num, uint64_t den) { return den > 0 ? (uint32_t)(num / den) : 0; };
+  if (meas_value.name.c_str() == std::string("RRU.PrbUsedDl")) {
+    value = ratio(kpis.sum[kpi::dl_nof_prb], kpis.nof_ttis);
+  } else if (meas_value.name.c_str() == std::string("RRU.PrbUsedUl")) {
+    value = ratio(kpis.sum[kpi::ul_nof_prb], kpis.nof_ttis);
+  } else if (meas_value.name.c_str() == std::string("DRB.UEThpDl")) {
+    // bits per TTI, i.e. kbps
+    value = ratio(8ULL * kpis.sum[kpi::dl_bytes], kpis.nof_ttis);
+  } else if (meas_value.name.c_str() == std::string("DRB.UEThpUl")) {
+    value = ratio(8ULL * kpis.sum[kpi::ul_bytes], kpis.nof_ttis);
+  } else if (meas_value.name.c_str() == std::string("dl_cqi")) {
+    value = ratio(kpis.sum[kpi::dl_cqi_sum], kpis.sum[kpi::dl_nof_cqi]);
+  } else if (meas_value.name.c_str() == std::string("dl_bler")) {
+    value = ratio(100ULL * kpis.sum[kpi::dl_nof_nack], kpis.sum[kpi::dl_nof_tb]);
+  } else if (meas_value.name.c_str() == std::string("ul_bler")) {
+    value = ratio(100ULL * kpis.sum[kpi::ul_nof_crc_ko], kpis.sum[kpi::ul_nof_tb]);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool e2sm_kpm::_extract_integer_type_meas_value(e2sm_kpm_meas_def_t&            meas_value,
+                                                const e2sm_kpm_meas_registry_t& metrics,
+                                                uint32_t&                       value)
 {
   // TODO: maybe add ID to metric types in e2sm_kpm_metrics definitions, so we do not have to compare strings?
   // TODO: make string comparison case insensitive
@@ -384,20 +431,26 @@ bool e2sm_kpm::_extract_integer_type_meas_value(e2sm_kpm_meas_def_t& meas_value,
     switch (meas_value.label) {
       case NO_LABEL:
         if (meas_value.scope & ENB_LEVEL) {
-          value = (int32_t)enb_metrics.sys.cpu_load[0];
+          value = (int32_t)metrics.cpu0_load;
           printf("extract last \"test\" value as int, (filled with ENB_LEVEL metric: CPU0_load) value %i \n", value);
           return true;
         }
         if (meas_value.scope & CELL_LEVEL) {
           uint32_t cell_id = meas_value.cell_id;
-          value            = (int32_t)enb_metrics.stack.mac.cc_info[cell_id].cc_rach_counter;
+          if (cell_id >= metrics.cell_rach_counter.size()) {
+            return false;
+          }
+          value = (int32_t)metrics.cell_rach_counter[cell_id];
           printf("extract last \"test\" value as int, (filled with CELL_LEVEL metric: cc_rach_counter) value %i \n",
                  value);
           return true;
         }
         if (meas_value.scope & UE_LEVEL) {
           uint32_t ue_id = meas_value.ue_id;
-          value          = (int32_t)enb_metrics.stack.mac.ues[ue_id].ul_rssi;
+          if (ue_id >= metrics.ue_ul_rssi.size()) {
+            return false;
+          }
+          value = (int32_t)metrics.ue_ul_rssi[ue_id];
           printf("extract last \"test\" value as int, (filled with UE_LEVEL metric: ul_rssi) value %i \n", value);
           return true;
         }
@@ -421,16 +474,16 @@ bool e2sm_kpm::_extract_integer_type_meas_value(e2sm_kpm_meas_def_t& meas_value,
   return false;
 }
 
-bool e2sm_kpm::_extract_real_type_meas_value(e2sm_kpm_meas_def_t& meas_value,
-                                             const enb_metrics_t& enb_metrics,
-                                             float&               value)
+bool e2sm_kpm::_extract_real_type_meas_value(e2sm_kpm_meas_def_t&            meas_value,
+                                             const e2sm_kpm_meas_registry_t& metrics,
+                                             float&                          value)
 {
   // all real type measurements
   // cpu0_load: no_label
   if (meas_value.name.c_str() == std::string("cpu0_load")) {
     switch (meas_value.label) {
       case NO_LABEL:
-        value = enb_metrics.sys.cpu_load[0];
+        value = metrics.cpu0_load;
         return true;
       default:
         return false;
@@ -439,17 +492,15 @@ bool e2sm_kpm::_extract_real_type_meas_value(e2sm_kpm_meas_def_t& meas_value,
 
   // cpu_load: min,max,avg
   if (meas_value.name.c_str() == std::string("cpu_load")) {
-    uint32_t size;
     switch (meas_value.label) {
       case MIN_LABEL:
-        value = *std::min_element(enb_metrics.sys.cpu_load.begin(), enb_metrics.sys.cpu_load.end());
+        value = metrics.cpu_load_min;
         return true;
       case MAX_LABEL:
-        value = *std::max_element(enb_metrics.sys.cpu_load.begin(), enb_metrics.sys.cpu_load.end());
+        value = metrics.cpu_load_max;
         return true;
       case AVG_LABEL:
-        size  = enb_metrics.sys.cpu_load.size();
-        value = std::accumulate(enb_metrics.sys.cpu_load.begin(), enb_metrics.sys.cpu_load.end(), 0.0 / size);
+        value = metrics.cpu_load_avg;
         return true;
       default:
         return false;
@@ -37,4 +37,28 @@ std::string e2sm_kpm_label_2_str(e2sm_kpm_label_enum label)
     default:
       return "UNKNOWN_LABEL";
   }
-}
\ No newline at end of file
+}
+void e2sm_kpm_meas_registry_t::update(const srsenb::enb_metrics_t& m)
+{
+  const auto& cpu_load = m.sys.cpu_load;
+  cpu0_load            = cpu_load[0];
+  cpu_load_min         = cpu_load[0];
+  cpu_load_max         = cpu_load[0];
+  float sum            = 0;
+  for (float load : cpu_load) {
+    cpu_load_min = std::min(cpu_load_min, load);
+    cpu_load_max = std::max(cpu_load_max, load);
+    sum += load;
+  }
+  cpu_load_avg = sum / cpu_load.size();
+
+  // the vectors keep their capacity, so the values are overwritten without allocations once the cells and UEs are known
+  cell_rach_counter.resize(m.stack.mac.cc_info.size());
+  for (uint32_t i = 0; i < cell_rach_counter.size(); ++i) {
+    cell_rach_counter[i] = m.stack.mac.cc_info[i].cc_rach_counter;
+  }
+  ue_ul_rssi.resize(m.stack.mac.ues.size());
+  for (uint32_t i = 0; i < ue_ul_rssi.size(); ++i) {
+    ue_ul_rssi[i] = m.stack.mac.ues[i].ul_rssi;
+  }
+}
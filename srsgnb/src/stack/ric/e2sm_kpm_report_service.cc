@@ -31,6 +31,9 @@ e2sm_kpm_report_service::e2sm_kpm_report_service(e2sm_kpm*                     e
   ric_ind_header(ric_ind_header_generic.ind_hdr_formats.ind_hdr_format1()),
   meas_collection_timer(parent->task_sched_ptr->get_unique_timer())
 {
+  if (parent->kpi_sampler != nullptr) {
+    kpi_cursor = parent->kpi_sampler->skip();
+  }
 }
 
 std::vector<e2sm_kpm_label_enum>
@@ -147,7 +150,6 @@ e2sm_kpm_report_service_style1::e2sm_kpm_report_service_style1(e2sm_kpm*
   this->_initialize_ric_ind_hdr();
   this->_initialize_ric_ind_msg();
 
-  granul_period = 1000; // TODO: overwrite for testing
   _start_meas_collection();
 }
 
@@ -354,6 +356,9 @@ meas_data_item_s& e2sm_kpm_report_service_style1::_get_meas_data_item(std::strin
 
 bool e2sm_kpm_report_service_style1::_collect_meas_data()
 {
+  // the MAC KPIs of the TTIs since the previous collection, which are shared by all the measurements
+  parent->_read_kpi_samples(kpi_cursor, kpi_window);
+
   meas_info_list_l& meas_info_list = ric_ind_message.meas_info_list;
   for (uint32_t i = 0; i < meas_info_list.size(); i++) {
     meas_info_item_s&                meas_def_item = meas_info_list[i];
@@ -388,7 +393,7 @@ bool e2sm_kpm_report_service_style1::_collect_meas_data()
       meas_value.data_type = data_type;
 
       meas_record_item_c item;
-      if (not parent->_collect_meas_value(meas_value, item)) {
+      if (not parent->_collect_meas_value(meas_value, kpi_window, item)) {
         parent->logger.info("Cannot extract value \"%s\" label: %i", meas_name.c_str(), label);
         return false;
       }
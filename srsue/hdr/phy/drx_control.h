@@ -0,0 +1,295 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSUE_DRX_CONTROL_H
+#define SRSUE_DRX_CONTROL_H
+
+#include "phy_metrics.h"
+#include "srsran/interfaces/rrc_interface_types.h"
+#include "srsran/srslog/srslog.h"
+#include <array>
+#include <mutex>
+
+namespace srsue {
+
+/**
+ * Evaluates the connected mode DRX Active Time of TS 36.321 5.7 from the events seen by the PHY, so that the DL
+ * processing of the subframes in which the UE does not monitor the PDCCH can be skipped.
+ *
+ * The timers are counted in subframes, which matches the PDCCH-subframes of FDD. The events that are only known by
+ * the MAC are approximated conservatively: a SR is pending from its transmission until the next UL grant, and the
+ * random access is ongoing from the PRACH transmission until the first PDCCH after the RAR. A PDCCH retransmission
+ * also restarts the inactivity timer and the DRX Command MAC CE is ignored, which keep the UE awake for longer.
+ */
+class drx_control
+{
+private:
+  static const uint32_t MAX_HARQ_PROC = 16;
+
+  /// A TTI difference above this value means that the event happened after the evaluated TTI
+  static const uint32_t MAX_TTI_AGE = 10240 / 2;
+
+  srslog::basic_logger& logger;
+  mutable std::mutex    mutex;
+  srsran::drx_cfg_t     cfg = {};
+
+  // Dynamic state
+  int                            last_pdcch_tti = -1; ///< Last TTI in which the inactivity timer was started
+  std::array<int, MAX_HARQ_PROC> dl_nack_tti    = {}; ///< First TTI of the retransmission timer, -1 if stopped
+  bool                           sr_pending     = false;
+  bool                           ra_ongoing     = false;
+  bool                           ra_rar_rx      = false;
+
+  // Metrics, the processing time is accumulated since the DRX was configured
+  uint32_t nof_active_sf  = 0;
+  uint32_t nof_skipped_sf = 0;
+  uint32_t nof_timed_sf   = 0;
+  uint64_t timed_dl_us    = 0;
+
+  static uint32_t tti_age(uint32_t tti, uint32_t event_tti) { return TTI_SUB(tti, event_tti); }
+
+  static bool is_same_cfg(const srsran::drx_cfg_t& a, const srsran::drx_cfg_t& b)
+  {
+    return a.enabled == b.enabled and a.on_duration_timer == b.on_duration_timer and
+           a.inactivity_timer == b.inactivity_timer and a.retx_timer == b.retx_timer and
+           a.long_cycle == b.long_cycle and a.start_offset == b.start_offset and
+           a.short_cycle_enabled == b.short_cycle_enabled and a.short_cycle == b.short_cycle and
+           a.short_cycle_timer == b.short_cycle_timer;
+  }
+
+  void reset_state()
+  {
+    last_pdcch_tti = -1;
+    dl_nack_tti.fill(-1);
+    sr_pending = false;
+    ra_ongoing = false;
+    ra_rar_rx  = false;
+  }
+
+  bool is_on_duration(uint32_t tti) const
+  {
+    uint32_t cycle = cfg.long_cycle;
+
+    // The short cycle is used while drxShortCycleTimer runs, which starts when drx-InactivityTimer expires
+    if (cfg.short_cycle_enabled and last_pdcch_tti >= 0) {
+      uint32_t age = tti_age(tti, last_pdcch_tti);
+      if (age > cfg.inactivity_timer and age <= cfg.inactivity_timer + cfg.short_cycle_timer * cfg.short_cycle) {
+        cycle = cfg.short_cycle;
+      }
+    }
+
+    // TTI is [(SFN * 10) + subframe number] and all the cycles divide 10240, so it is used modulo the cycle
+    return ((tti + cycle - (cfg.start_offset % cycle)) % cycle) < cfg.on_duration_timer;
+  }
+
+public:
+  explicit drx_control(srslog::basic_logger& logger) : logger(logger) { reset_state(); }
+
+  /**
+   * Sets a new DRX configuration, the configuration is released if it is not enabled. Setting the current
+   * configuration again keeps the timers running.
+   *
+   * @param cfg_ DRX configuration from the MAC main configuration
+   */
+  void set_config(const srsran::drx_cfg_t& cfg_)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (is_same_cfg(cfg, cfg_)) {
+      return;
+    }
+
+    if (cfg_.enabled and (cfg_.long_cycle == 0 or (cfg_.short_cycle_enabled and cfg_.short_cycle == 0))) {
+      logger.error("PHY:   Invalid DRX cycle, DRX is disabled");
+      cfg = {};
+    } else {
+      cfg = cfg_;
+    }
+    reset_state();
+    nof_timed_sf = 0;
+    timed_dl_us  = 0;
+
+    if (cfg.enabled) {
+      logger.info("PHY:   Set DRX: long_cycle=%d, start_offset=%d, on_duration=%d, inactivity=%d, short_cycle=%d",
+                  cfg.long_cycle,
+                  cfg.start_offset,
+                  cfg.on_duration_timer,
+                  cfg.inactivity_timer,
+                  cfg.short_cycle_enabled ? cfg.short_cycle : 0);
+    } else {
+      logger.info("PHY:   DRX released");
+    }
+  }
+
+  /// Clears the timers and pending events, keeping the configuration
+  void reset()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    reset_state();
+  }
+
+  bool is_enabled() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return cfg.enabled;
+  }
+
+  /**
+   * Indicates a PDCCH addressed to the UE (DL assignment or UL grant), which starts drx-InactivityTimer
+   *
+   * @param tti TTI in which the PDCCH was received
+   */
+  void new_pdcch(uint32_t tti)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (last_pdcch_tti < 0 or tti_age(tti, last_pdcch_tti) < MAX_TTI_AGE) {
+      last_pdcch_tti = tti;
+    }
+    if (ra_rar_rx) {
+      ra_ongoing = false;
+      ra_rar_rx  = false;
+    }
+  }
+
+  /// Indicates an UL grant, which ends the wait of a transmitted SR
+  void new_ul_grant()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    sr_pending = false;
+  }
+
+  /**
+   * Indicates that a DL transport block was not decoded, drx-RetransmissionTimer starts when the HARQ RTT Timer expires
+   *
+   * @param tti TTI of the PDSCH
+   * @param pid HARQ process of the PDSCH
+   * @param harq_rtt HARQ RTT in subframes
+   */
+  void new_dl_nack(uint32_t tti, uint32_t pid, uint32_t harq_rtt)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    dl_nack_tti[pid % MAX_HARQ_PROC] = TTI_ADD(tti, harq_rtt);
+  }
+
+  /// Indicates the transmission of a SR, the UE is in Active Time until an UL grant is received
+  void sr_transmitted()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    sr_pending = true;
+  }
+
+  /// Indicates the transmission of a PRACH preamble
+  void ra_started()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ra_ongoing = true;
+    ra_rar_rx  = false;
+  }
+
+  /// Indicates the reception of the RAR, the contention resolution is expected in the following PDCCH
+  void ra_rar_received()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ra_rar_rx = ra_ongoing;
+  }
+
+  /**
+   * Evaluates whether the given TTI belongs to the Active Time, always true if DRX is not configured
+   *
+   * @param tti DL TTI
+   * @return true if the PDCCH shall be monitored in the TTI
+   */
+  bool is_active_time(uint32_t tti)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (not cfg.enabled or sr_pending or ra_ongoing) {
+      return true;
+    }
+
+    bool active = is_on_duration(tti);
+
+    // drx-InactivityTimer runs during the PDCCH subframe and the following ones, stop tracking it once also
+    // drxShortCycleTimer expired
+    if (last_pdcch_tti >= 0) {
+      uint32_t age = tti_age(tti, last_pdcch_tti);
+      if (age <= cfg.inactivity_timer or age >= MAX_TTI_AGE) {
+        // An older TTI evaluated after the PDCCH is kept awake too
+        active = true;
+      } else if (age > cfg.inactivity_timer + (cfg.short_cycle_enabled ? cfg.short_cycle_timer * cfg.short_cycle : 0)) {
+        last_pdcch_tti = -1;
+      }
+    }
+
+    for (int& start_tti : dl_nack_tti) {
+      if (start_tti < 0) {
+        continue;
+      }
+      uint32_t age = tti_age(tti, start_tti);
+      if (age < cfg.retx_timer) {
+        active = true;
+      } else if (age < MAX_TTI_AGE) {
+        start_tti = -1;
+      }
+    }
+
+    return active;
+  }
+
+  /**
+   * Accounts a DL subframe for the metrics
+   *
+   * @param processed true if the DL of the subframe was processed
+   * @param dl_us DL processing time of the subframe in microseconds, only used if it was processed
+   */
+  void count_sf(bool processed, uint32_t dl_us)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (processed) {
+      nof_active_sf++;
+      nof_timed_sf++;
+      timed_dl_us += dl_us;
+    } else {
+      nof_skipped_sf++;
+    }
+  }
+
+  /**
+   * Gets the DRX metrics since the last call. The CPU time saved is estimated from the average DL processing time of
+   * the processed subframes since the DRX was configured.
+   *
+   * @param m Metrics to fill
+   */
+  void get_metrics(drx_metrics_t& m)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    m.nof_active_sf  = nof_active_sf;
+    m.nof_skipped_sf = nof_skipped_sf;
+    m.cpu_saved_ms   = 0.0f;
+    if (nof_timed_sf > 0) {
+      m.cpu_saved_ms = (float)nof_skipped_sf * (float)timed_dl_us / (float)nof_timed_sf * 1e-3f;
+    }
+    nof_active_sf  = 0;
+    nof_skipped_sf = 0;
+  }
+};
+
+} // namespace srsue
+
+#endif // SRSUE_DRX_CONTROL_H
@@ -25,6 +25,8 @@
 #include "srsran/interfaces/ue_interfaces.h"
 #include "srsran/srsran.h"
 #include "srsue/hdr/phy/phy_common.h"
+#include <condition_variable>
+#include <mutex>
 
 namespace srsue {
 namespace lte {
@@ -42,6 +44,7 @@ public:
 
   void  set_tti(uint32_t tti);
   void  set_cfo_nolock(float cfo);
+  void  set_rx_cfo_nolock(float cfo_hz);
   float get_ref_cfo() const;
 
   // Functions to set configuration.
@@ -54,6 +57,10 @@ public:
 
   void set_uci_periodic_cqi(srsran_uci_data_t* uci_data);
 
+  /// Enables for the current subframe the UL grant processing and PUSCH encoding right after the PDCCH and PHICH
+  /// decoding. It must be set before work_dl_regular() and only if work_ul() is called in the same subframe.
+  void set_ul_early_nolock(bool enable);
+
   bool work_dl_regular();
   bool work_dl_mbsfn(srsran_mbsfn_cfg_t mbsfn_cfg);
   bool work_ul(srsran_uci_data_t* uci_data);
@@ -86,6 +93,9 @@ private:
   int  decode_pmch(mac_interface_phy_lte::tb_action_dl_t* action, srsran_mbsfn_cfg_t* mbsfn_cfg);
   void new_mch_dl(mac_interface_phy_lte::tb_action_dl_t*);
   /* Methods for UL */
+  void     prepare_ul(bool pre_encode);
+  void     start_prepare_ul();
+  void     wait_prepare_ul();
   bool     encode_uplink(mac_interface_phy_lte::tb_action_ul_t* action, srsran_uci_data_t* uci_data);
   void     set_uci_sr(srsran_uci_data_t* uci_data);
   void     set_uci_aperiodic_cqi(srsran_uci_data_t* uci_data);
@@ -120,6 +130,23 @@ private:
   /* Objects for UL */
   srsran_ue_ul_t     ue_ul     = {};
   srsran_ue_ul_cfg_t ue_ul_cfg = {};
+
+  /// UL grant of the TTI_TX subframe and MAC action for it, filled by prepare_ul()
+  struct ul_prep_t {
+    srsran_dci_ul_t                       dci_ul             = {};
+    mac_interface_phy_lte::mac_grant_ul_t ul_mac_grant       = {};
+    mac_interface_phy_lte::tb_action_ul_t ul_action          = {};
+    uint32_t                              pid                = 0;
+    bool                                  ul_grant_available = false;
+  };
+  ul_prep_t ul_prep;
+
+  // Early UL preparation, it runs in the code block decoder pool while the worker decodes the PDSCH
+  bool                    ul_early         = false;
+  bool                    ul_prep_started  = false;
+  bool                    ul_prep_finished = false;
+  std::mutex              ul_prep_mutex;
+  std::condition_variable ul_prep_cvar;
 };
 
 } // namespace lte
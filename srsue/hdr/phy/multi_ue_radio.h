@@ -0,0 +1,176 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        multi_ue_radio.h
+ * Description: Radio front-end shared by several simulated UEs. Every UE PHY
+ *              reads the same received samples and the UL signals of all the
+ *              UEs are added together before they are sent to the radio.
+ *****************************************************************************/
+
+#ifndef SRSUE_MULTI_UE_RADIO_H
+#define SRSUE_MULTI_UE_RADIO_H
+
+#include "srsran/interfaces/radio_interfaces.h"
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/radio/radio.h"
+#include "srsran/radio/radio_base.h"
+#include "srsran/srslog/srslog.h"
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace srsue {
+
+/**
+ * Radio shared by the PHYs of nof_ues simulated UEs. It owns the actual radio, which runs at the fixed sampling rate
+ * rf.srate, and gives each UE a port with its own sampling rate that the UE PHY uses as its radio.
+ *
+ * The received samples are kept in a ring buffer. The first port that needs samples that are not in the ring reads them
+ * from the radio, and the other ports read them later from the ring. A port that falls more than the ring length behind
+ * the newest samples is reported an overflow and skips to the newest samples.
+ *
+ * The transmitted samples of every port are added into a second ring at the position given by their timestamp. The
+ * samples are sent to the radio as soon as every port that is transmitting has written them. A port that stops
+ * transmitting (tx_end() or no transmission for ring length / 4) does not hold back the others.
+ */
+class multi_ue_radio final : public srsran::radio_base, public srsran::phy_interface_radio
+{
+public:
+  explicit multi_ue_radio(uint32_t nof_ues);
+  ~multi_ue_radio() override;
+
+  // radio_base, the PHY given to init() is ignored, each UE PHY is set with set_phy()
+  std::string get_type() override { return "multi_ue"; }
+  int         init(const srsran::rf_args_t& args_, srsran::phy_interface_radio* phy_) override;
+  void        stop() override;
+  bool        get_metrics(srsran::rf_metrics_t* metrics) override;
+
+  // phy_interface_radio, forwards the events of the radio to every UE PHY
+  void radio_overflow() override;
+  void radio_failure() override;
+
+  /// Sets the PHY of the UE ue_idx, it must be called before the PHY starts using its port
+  void set_phy(uint32_t ue_idx, srsran::phy_interface_radio* phy_);
+
+  /// Returns the radio of the UE ue_idx
+  srsran::radio_interface_phy* get_port(uint32_t ue_idx);
+
+private:
+  class port final : public srsran::radio_interface_phy
+  {
+  public:
+    port(multi_ue_radio& parent_, uint32_t idx_) : parent(parent_), idx(idx_) {}
+    ~port();
+
+    void tx_end() override { parent.tx_end(*this); }
+    bool tx(srsran::rf_buffer_interface& buffer, const srsran::rf_timestamp_interface& tx_time) override
+    {
+      return parent.tx(*this, buffer, tx_time);
+    }
+    bool rx_now(srsran::rf_buffer_interface& buffer, srsran::rf_timestamp_interface& rxd_time) override
+    {
+      return parent.rx(*this, buffer, rxd_time);
+    }
+
+    // The frequencies and gains are those of the shared radio, so all the UEs shall use the same ones
+    void set_tx_freq(const uint32_t& carrier_idx, const double& freq) override
+    {
+      parent.radio->set_tx_freq(carrier_idx, freq);
+    }
+    void set_rx_freq(const uint32_t& carrier_idx, const double& freq) override
+    {
+      parent.radio->set_rx_freq(carrier_idx, freq);
+    }
+    void release_freq(const uint32_t& carrier_idx) override { parent.radio->release_freq(carrier_idx); }
+    void set_tx_gain(const float& gain) override { parent.radio->set_tx_gain(gain); }
+    void set_rx_gain_th(const float& gain) override { parent.radio->set_rx_gain_th(gain); }
+    void set_rx_gain(const float& gain) override { parent.radio->set_rx_gain(gain); }
+    void set_tx_srate(const double& srate_) override;
+    void set_rx_srate(const double& srate_) override;
+    void set_channel_rx_offset(uint32_t ch, int32_t offset_samples) override
+    {
+      parent.radio->set_channel_rx_offset(ch, offset_samples);
+    }
+
+    double            get_freq_offset() override { return parent.radio->get_freq_offset(); }
+    float             get_rx_gain() override { return parent.radio->get_rx_gain(); }
+    bool              is_continuous_tx() override { return parent.radio->is_continuous_tx(); }
+    bool              get_is_start_of_burst() override { return parent.radio->get_is_start_of_burst(); }
+    bool              is_init() override { return parent.radio->is_init(); }
+    void              reset() override {}
+    srsran_rf_info_t* get_info() override { return parent.radio->get_info(); }
+
+    multi_ue_radio&              parent;
+    uint32_t                     idx;
+    srsran::phy_interface_radio* phy = nullptr;
+
+    // Receive side, protected by rx_mutex
+    bool                                                    rx_started = false;
+    uint64_t                                                rx_pos     = 0; ///< next sample of the ring to read
+    uint32_t                                                rx_ratio   = 1;
+    std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> decimators = {};
+    std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      rx_tmp;
+
+    // Transmit side, protected by tx_mutex
+    bool                                                    tx_active     = false;
+    uint64_t                                                tx_end_pos    = 0; ///< end of the last transmission
+    uint32_t                                                tx_ratio      = 1;
+    std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> interpolators = {};
+    std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      tx_tmp;
+  };
+
+  bool rx(port& p, srsran::rf_buffer_interface& buffer, srsran::rf_timestamp_interface& rxd_time);
+  bool fetch_rx(uint64_t nof_samples);
+  bool tx(port& p, srsran::rf_buffer_interface& buffer, const srsran::rf_timestamp_interface& tx_time);
+  void tx_end(port& p);
+  bool flush_tx(uint64_t end);
+  bool flush_tx_ready();
+
+  static uint32_t get_ratio(double port_srate, double base_srate);
+
+  srslog::basic_logger&              logger;
+  std::unique_ptr<srsran::radio>     radio;
+  std::vector<std::unique_ptr<port>> ports;
+  double                             srate        = 0.0;
+  uint32_t                           nof_channels = 0;
+  uint32_t                           ring_len     = 0;
+  uint32_t                           sf_len       = 0;
+
+  // Received samples, the ring holds the samples [rx_head - ring_len, rx_head)
+  std::mutex                                         rx_mutex;
+  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS> rx_ring;
+  uint64_t                                           rx_head = 0;
+  srsran::rf_timestamp_t                             rx_head_time; ///< time of the sample rx_head
+
+  // Samples to transmit, the ring holds the samples [tx_base, tx_base + ring_len) counted from the radio time origin
+  std::mutex                                         tx_mutex;
+  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS> tx_ring;
+  bool                                               tx_started = false;
+  uint64_t                                           tx_base    = 0;
+  uint64_t                                           tx_ref_pos = 0; ///< sample of tx_ref_time
+  srsran::rf_timestamp_t                             tx_ref_time;
+};
+
+} // namespace srsue
+
+#endif // SRSUE_MULTI_UE_RADIO_H
@@ -22,9 +22,12 @@
 #ifndef SRSUE_CELL_SEARCH_H
 #define SRSUE_CELL_SEARCH_H
 
+#include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/radio_interfaces.h"
 #include "srsran/interfaces/ue_nr_interfaces.h"
 #include "srsran/srsran.h"
+#include <memory>
+#include <vector>
 
 namespace srsue {
 namespace nr {
@@ -33,7 +36,8 @@ class cell_search
 public:
   struct args_t {
     double                      max_srate_hz;
-    srsran_subcarrier_spacing_t ssb_min_scs = srsran_subcarrier_spacing_15kHz;
+    srsran_subcarrier_spacing_t ssb_min_scs          = srsran_subcarrier_spacing_15kHz;
+    uint32_t                    nof_wideband_threads = 0; ///< Extra threads for the wideband search, 0 for none
   };
 
   struct cfg_t {
@@ -43,11 +47,13 @@ public:
     srsran_subcarrier_spacing_t ssb_scs;
     srsran_ssb_pattern_t        ssb_pattern;
     srsran_duplex_mode_t        duplex_mode;
+    std::vector<double>         ssb_freq_list; ///< SSB raster frequencies searched together, overrides ssb_freq_hz
   };
 
   struct ret_t {
     enum { CELL_FOUND = 1, CELL_NOT_FOUND = 0, ERROR = -1 } result;
     srsran_ssb_search_res_t ssb_res;
+    double                  ssb_freq_hz; ///< SSB center frequency the cell was found at
   };
 
   cell_search(srslog::basic_logger& logger);
@@ -59,8 +65,29 @@ public:
   ret_t run_slot(const cf_t* buffer, uint32_t slot_sz);
 
 private:
-  srslog::basic_logger&        logger;
-  srsran_ssb_t                 ssb    = {};
+  /// Wideband search task context, each task uses its own SSB object
+  struct wideband_task_t {
+    srsran_ssb_t            ssb      = {};
+    uint32_t                cand_idx = 0; ///< First candidate correlated, or the candidate decoded
+    uint32_t                nof_cand = 0; ///< Number of candidates correlated, zero when decoding
+    srsran_ssb_search_res_t ssb_res  = {};
+    int                     task_ret = SRSRAN_SUCCESS;
+  };
+
+  bool        start_wideband(const cfg_t& cfg);
+  ret_t       run_slot_wideband(const cf_t* buffer, uint32_t nof_samples);
+  void        run_wideband_tasks(uint32_t nof_tasks);
+  static void run_wideband_task(void* arg, uint32_t task_idx);
+
+  srslog::basic_logger&                     logger;
+  srsran_ssb_t                              ssb            = {};
+  cfg_t                                     cur_cfg        = {};
+  const cf_t*                               wb_buffer      = nullptr;
+  uint32_t                                  wb_nof_samples = 0;
+  std::vector<srsran_ssb_pss_res_t>         wb_cand;
+  std::vector<uint32_t>                     wb_order;
+  std::vector<wideband_task_t>              wb_tasks;
+  std::unique_ptr<srsran::task_thread_pool> wb_pool;
 };
 } // namespace nr
 } // namespace srsue
@@ -25,6 +25,7 @@
 #include "cc_worker.h"
 #include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/phy_common_interface.h"
+#include <chrono>
 
 namespace srsue {
 namespace nr {
@@ -62,12 +63,18 @@ public:
 
   void set_prach(cf_t* prach_ptr, float prach_power);
 
+  /// Sets the time the slot was received, from which the stage latencies of the slot are measured
+  void set_rx_time_point(std::chrono::steady_clock::time_point tp) { rx_tp = tp; }
+
 private:
   /* Inherited from thread_pool::worker. Function called every subframe to run the DL/UL processing */
   void work_imp() override;
 
   void update_cfg(uint32_t cc_idx, const srsran::phy_cfg_nr_t& new_cfg);
 
+  using time_point = std::chrono::steady_clock::time_point;
+  void set_stage_metrics(time_point dl_start, time_point dl_end, time_point ul_start, time_point ul_end);
+
 private:
   std::vector<std::unique_ptr<cc_worker> > cc_workers;
 
@@ -79,6 +86,7 @@ private:
   float                                          prach_power = 0;
   srsran::phy_common_interface::worker_context_t context     = {};
   uint32_t                                       sf_len      = 0;
+  time_point                                     rx_tp       = {};
 };
 
 } // namespace nr
@@ -58,11 +58,12 @@ private:
   mutable std::mutex                                       pending_ack_mutex;
 
   /// Metrics section
-  info_metrics_t     info_metrics = {};
-  sync_metrics_t     sync_metrics = {};
-  ch_metrics_t       ch_metrics   = {};
-  dl_metrics_t       dl_metrics   = {};
-  ul_metrics_t       ul_metrics   = {};
+  info_metrics_t     info_metrics  = {};
+  sync_metrics_t     sync_metrics  = {};
+  ch_metrics_t       ch_metrics    = {};
+  dl_metrics_t       dl_metrics    = {};
+  ul_metrics_t       ul_metrics    = {};
+  stage_metrics_t    stage_metrics = {};
   mutable std::mutex metrics_mutex;
 
   /// CSI-RS measurements
@@ -85,6 +86,7 @@ private:
     ch_metrics.reset();
     dl_metrics.reset();
     ul_metrics.reset();
+    stage_metrics.reset();
   }
 
 public:
@@ -440,6 +442,24 @@ public:
     ul_metrics.set(m);
   }
 
+  /**
+   * @brief Sets the latencies of the processing stages of a slot
+   */
+  void set_stage_metrics(const stage_metrics_t& m)
+  {
+    std::lock_guard<std::mutex> lock(metrics_mutex);
+    stage_metrics.set(m);
+  }
+
+  /**
+   * @brief Accounts a received slot that was dropped without processing
+   */
+  void add_dropped_slot()
+  {
+    std::lock_guard<std::mutex> lock(metrics_mutex);
+    stage_metrics.nof_dropped_slots++;
+  }
+
   /**
    * @brief Resets all metrics (protected)
    */
@@ -463,6 +483,7 @@ public:
     m.ch[cc]    = ch_metrics;
     m.dl[cc]    = dl_metrics;
     m.ul[cc]    = ul_metrics;
+    m.stage[cc] = stage_metrics;
     m.nof_active_cc++;
 
     // Reset all metrics
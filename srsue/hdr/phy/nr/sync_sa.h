@@ -33,6 +33,7 @@
 #include "srsran/srsran.h"
 #include "srsue/hdr/phy/sync_state.h"
 #include "worker_pool.h"
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <srsran/common/tti_sempahore.h>
@@ -47,18 +48,21 @@ class sync_sa : public srsran::thread, public srsran::phy_common_interface
 {
 public:
   struct args_t {
-    double                      srate_hz        = 61.44e6;
-    srsran_subcarrier_spacing_t ssb_min_scs     = srsran_subcarrier_spacing_15kHz;
-    uint32_t                    nof_rx_channels = 1;
-    bool                        disable_cfo     = false;
-    float                       pbch_dmrs_thr   = 0.0f; ///< PBCH DMRS correlation detection threshold (0 means auto)
-    float                       cfo_alpha       = 0.0f; ///< CFO averaging alpha (0 means auto)
-    int                         thread_priority = 1;
+    double                      srate_hz           = 61.44e6;
+    srsran_subcarrier_spacing_t ssb_min_scs        = srsran_subcarrier_spacing_15kHz;
+    uint32_t                    nof_rx_channels    = 1;
+    bool                        disable_cfo        = false;
+    float                       pbch_dmrs_thr      = 0.0f; ///< PBCH DMRS correlation detection threshold (0 means auto)
+    float                       cfo_alpha          = 0.0f; ///< CFO averaging alpha (0 means auto)
+    int                         thread_priority    = 1;
+    uint32_t                    nof_rx_slots       = 0; ///< Slots queued while all workers are busy (0 waits for one)
+    uint32_t                    nof_search_threads = 0; ///< Extra threads for the wideband cell search
 
     cell_search::args_t get_cell_search() const
     {
-      cell_search::args_t ret = {};
-      ret.max_srate_hz        = srate_hz;
+      cell_search::args_t ret  = {};
+      ret.max_srate_hz         = srate_hz;
+      ret.nof_wideband_threads = nof_search_threads;
       return ret;
     }
 
@@ -116,6 +120,17 @@ private:
   uint32_t                     sfn_sync_nof_trials    = 0;
   const static uint32_t        sfn_sync_max_trials    = 100;
 
+  /// Slot received while all the workers were busy, waiting to be handed to a worker
+  struct rx_slot_t {
+    cf_t*                                 buffer = nullptr;
+    uint32_t                              tti    = 0;
+    srsran::rf_timestamp_t                rx_time;
+    std::chrono::steady_clock::time_point rx_tp;
+  };
+  std::vector<rx_slot_t> rx_slots;     ///< RX queue, decouples the reception from the workers when not empty
+  uint32_t               rx_head  = 0; ///< Oldest slot of the RX queue
+  uint32_t               rx_count = 0; ///< Number of slots in the RX queue
+
   cell_search::ret_t cs_ret;
   cell_search        searcher;
   slot_sync          slot_synchronizer;
@@ -129,6 +144,12 @@ private:
   void run_state_cell_search();
   void run_state_sfn_sync();
   void run_state_cell_camping();
+  void run_state_cell_camping_queued();
+  void dispatch_rx_slots();
+  void start_slot(nr::sf_worker*                        worker,
+                  uint32_t                              slot_tti,
+                  srsran::rf_timestamp_t                rx_time,
+                  std::chrono::steady_clock::time_point rx_tp);
 
   int  radio_recv_fnc(srsran::rf_buffer_t& data, srsran_timestamp_t* rx_time);
   void run_stack_tti();
@@ -46,12 +46,15 @@ private:
   std::vector<bool>                        pending_cfgs;
   std::mutex                               cfg_mutex;
 
+  sf_worker* prepare_worker(sf_worker* worker, uint32_t tti);
+
 public:
   sf_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
 
   worker_pool(srslog::basic_logger& logger_, uint32_t max_workers);
   bool       init(const phy_args_nr_t& args_, srsran::phy_common_interface& common, stack_interface_phy_nr* stack_);
   sf_worker* wait_worker(uint32_t tti);
+  sf_worker* wait_worker_nb(uint32_t tti); ///< Returns nullptr if all the workers are busy
   void       start_worker(sf_worker* w);
   void       stop();
   void       send_prach(const uint32_t prach_occasion,
@@ -65,6 +68,7 @@ public:
   bool       set_config(const srsran::phy_cfg_nr_t& cfg);
   bool       has_valid_sr_resource(uint32_t sr_id);
   void       clear_pending_grants();
+  void       add_dropped_slot();
   void       get_metrics(phy_metrics_t& m);
 
   /**
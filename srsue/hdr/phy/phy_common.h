@@ -26,6 +26,7 @@
 #include "srsran/adt/circular_array.h"
 #include "srsran/common/block_queue.h"
 #include "srsran/common/gen_mch_tables.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/common/threads.h"
 #include "srsran/common/tti_sempahore.h"
 #include "srsran/interfaces/phy_common_interface.h"
@@ -37,6 +38,7 @@
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
 #include "srsue/hdr/phy/scell/scell_state.h"
+#include "drx_control.h"
 #include "ta_control.h"
 #include <condition_variable>
 #include <mutex>
@@ -114,9 +116,15 @@ public:
   // Time Aligment Controller, internal thread safe
   ta_control ta;
 
+  // Connected mode DRX Active Time, internal thread safe
+  drx_control drx;
+
   // Last reported RI
   std::atomic<uint32_t> last_ri = {0};
 
+  // Threads shared by all the workers for decoding the PDSCH code blocks in parallel, NULL if disabled
+  std::unique_ptr<srsran::task_thread_pool> cb_decoder_pool;
+
   phy_common(srslog::basic_logger& logger);
 
   ~phy_common();
@@ -147,6 +155,7 @@ public:
                           srsran_phich_grant_t* phich_grant,
                           srsran_dci_ul_t*      dci_ul);
   bool is_any_ul_pending_ack();
+  bool has_ul_pending_ack(uint32_t tti);
 
   bool get_ul_received_ack(srsran_ul_sf_cfg_t* sf, uint32_t cc_idx, bool* ack_value, srsran_dci_ul_t* dci_ul);
   void set_ul_received_ack(srsran_dl_sf_cfg_t* sf,
@@ -168,6 +177,24 @@ public:
 
   void set_rar_grant_tti(uint32_t tti);
 
+  /**
+   * Computes the DL HARQ RTT of TS 36.321 5.7, that is the ACK delay of the PDSCH plus 4 subframes
+   *
+   * @param tti TTI of the PDSCH
+   * @param tdd_config TDD configuration, ignored for FDD
+   * @return the HARQ RTT in subframes
+   */
+  uint32_t get_dl_harq_rtt(uint32_t tti, const srsran_tdd_config_t& tdd_config);
+
+  /**
+   * Evaluates whether the DL of a subframe shall be processed according to the DRX configuration. Besides the DRX
+   * Active Time, the PHICH and the SI-RNTI, P-RNTI and RA-RNTI search windows keep the subframe active.
+   *
+   * @param tti DL TTI
+   * @return true if the DL shall be processed
+   */
+  bool is_drx_active_time(uint32_t tti);
+
   void set_dl_pending_ack(srsran_dl_sf_cfg_t*         sf,
                           uint32_t                    cc_idx,
                           uint8_t                     value[SRSRAN_MAX_CODEWORDS],
@@ -23,6 +23,7 @@
 #define SRSUE_PHY_METRICS_H
 
 #include "srsran/srsran.h"
+#include <algorithm>
 #include <array>
 
 namespace srsue {
@@ -168,15 +169,63 @@ private:
   uint32_t count = 0;
 };
 
+/// Latencies of the NR slot processing stages, in microseconds
+struct stage_metrics_t {
+  typedef std::array<stage_metrics_t, SRSRAN_MAX_CARRIERS> array_t;
+
+  float    rx_queue_us       = 0.0; ///< From the slot reception until a worker starts decoding it
+  float    dl_us             = 0.0; ///< DL decoding
+  float    dl_ul_wait_us     = 0.0; ///< Wait for the DL decoding of the previous slots
+  float    ul_us             = 0.0; ///< UL encoding
+  float    tx_us             = 0.0; ///< Wait for the transmission of the previous slots, and transmission
+  float    max_slot_us       = 0.0; ///< Maximum latency from the slot reception until its transmission
+  uint32_t nof_dropped_slots = 0;   ///< Slots dropped because no worker became available in time
+
+  void set(const stage_metrics_t& other)
+  {
+    count++;
+    PHY_METRICS_SET(rx_queue_us);
+    PHY_METRICS_SET(dl_us);
+    PHY_METRICS_SET(dl_ul_wait_us);
+    PHY_METRICS_SET(ul_us);
+    PHY_METRICS_SET(tx_us);
+    max_slot_us = std::max(max_slot_us, other.max_slot_us);
+  }
+
+  void reset()
+  {
+    count             = 0;
+    rx_queue_us       = 0.0f;
+    dl_us             = 0.0f;
+    dl_ul_wait_us     = 0.0f;
+    ul_us             = 0.0f;
+    tx_us             = 0.0f;
+    max_slot_us       = 0.0f;
+    nof_dropped_slots = 0;
+  }
+
+private:
+  uint32_t count = 0;
+};
+
 #undef PHY_METRICS_SET
 
+/// Connected mode DRX statistics of the LTE DL, counted since the last report
+struct drx_metrics_t {
+  uint32_t nof_active_sf  = 0;    ///< Subframes processed in the Active Time
+  uint32_t nof_skipped_sf = 0;    ///< Subframes whose DL processing was skipped
+  float    cpu_saved_ms   = 0.0f; ///< Estimated DL processing time saved by the skipped subframes
+};
+
 struct phy_metrics_t {
-  info_metrics_t::array_t info          = {};
-  sync_metrics_t::array_t sync          = {};
-  ch_metrics_t::array_t   ch            = {};
-  dl_metrics_t::array_t   dl            = {};
-  ul_metrics_t::array_t   ul            = {};
-  uint32_t                nof_active_cc = 0;
+  info_metrics_t::array_t  info          = {};
+  sync_metrics_t::array_t  sync          = {};
+  ch_metrics_t::array_t    ch            = {};
+  dl_metrics_t::array_t    dl            = {};
+  ul_metrics_t::array_t    ul            = {};
+  stage_metrics_t::array_t stage         = {};
+  drx_metrics_t            drx           = {};
+  uint32_t                 nof_active_cc = 0;
 };
 
 } // namespace srsue
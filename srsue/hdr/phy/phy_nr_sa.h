@@ -103,7 +103,7 @@ private:
   void        init_background();
   std::thread init_thread;
 
-  const static int MAX_WORKERS     = 4;
+  const static int MAX_WORKERS     = 8;
   const static int DEFAULT_WORKERS = 4;
 
   static void set_default_args(phy_args_nr_t& args);
@@ -82,6 +82,7 @@ public:
     uint32_t tti_period        = 0;    ///< Measurement TTI trigger period, set to 0 to trigger at any TTI
     uint32_t tti_offset        = 0;    ///< Measurement TTI trigger offset
     float    rx_gain_offset_db = 0.0f; ///< Gain offset, for calibrated measurements
+    uint32_t duty_cycle_pct    = 100;  ///< Maximum percentage of time spent measuring, it delays the next trigger
   };
 
   /**
@@ -141,6 +142,7 @@ protected:
     uint32_t           meas_period_ms     = 200; ///< Minimum time between measurements
     uint32_t           trigger_tti_period = 0;   ///< Measurement TTI trigger period
     uint32_t           trigger_tti_offset = 0;   ///< Measurement TTI trigger offset
+    uint32_t           duty_cycle_pct     = 100; ///< Maximum percentage of time spent measuring
     meas_itf&          new_cell_itf;
 
     explicit measure_context_t(meas_itf& new_cell_itf_) : new_cell_itf(new_cell_itf_) {}
@@ -243,9 +245,10 @@ private:
   {
     std::lock_guard<std::mutex> lock(mutex);
 
-    // If the elapsed time does not satisfy with the minimum time, do not trigger
+    // If the elapsed time does not satisfy with the minimum time, nor the duty cycle, do not trigger
     uint32_t elapsed_tti = TTI_SUB(tti, last_measure_tti);
-    if (elapsed_tti < context.meas_period_ms and state.get_state() != internal_state::wait_first) {
+    uint32_t min_elapsed = std::max(context.meas_period_ms, duty_cycle_holdoff_ms);
+    if (elapsed_tti < min_elapsed and state.get_state() != internal_state::wait_first) {
       return false;
     }
 
@@ -306,7 +309,8 @@ private:
   internal_state        state;
   srslog::basic_logger& logger;
   mutable std::mutex    mutex;
-  uint32_t              last_measure_tti = 0;
+  uint32_t              last_measure_tti      = 0;
+  uint32_t              duty_cycle_holdoff_ms = 0; ///< Minimum time between triggers given by the last measurement
   measure_context_t     context;
 
   std::vector<cf_t>   search_buffer;
@@ -45,7 +45,12 @@ public:
 
   explicit search(srslog::basic_logger& logger) : logger(logger) {}
   ~search();
-  void     init(srsran::rf_buffer_t& buffer_, uint32_t nof_rx_channels, search_callback* parent, int force_N_id_2_, int force_N_id_1_);
+  void     init(srsran::rf_buffer_t& buffer_,
+                uint32_t             nof_rx_channels,
+                search_callback*     parent,
+                int                  force_N_id_2_,
+                int                  force_N_id_1_,
+                bool                 single_pass_ = false);
   void     reset();
   float    get_last_cfo();
   void     set_agc_enable(bool enable);
@@ -60,6 +65,7 @@ private:
   srsran_ue_mib_sync_t   ue_mib_sync  = {};
   int                    force_N_id_2 = 0;
   int                    force_N_id_1 = 0;
+  bool                   single_pass  = false;
 };
 
 }; // namespace srsue
@@ -28,20 +28,30 @@
 
 #include "proc_bsr.h"
 #include "proc_phr.h"
+#include "srsran/adt/bounded_vector.h"
+#include "srsran/adt/rcu_circular_map.h"
 #include "srsran/common/common.h"
 #include "srsran/interfaces/mac_interface_types.h"
 #include "srsran/mac/pdu.h"
 #include "srsran/srslog/srslog.h"
 #include "srsue/hdr/stack/mac_common/mux_base.h"
+#include <atomic>
 #include <mutex>
 
 namespace srsue {
 
+/**
+ * UE MAC multiplexing unit. The logical channel configuration, sorted by priority, is published as an immutable list
+ * that the PDU assembly reads without locks, and the token buckets Bj are atomic. Hence, the per-TTI update of the
+ * buckets, the logical channel setup and the Msg3 and C-RNTI CE state changes from the stack thread never block the
+ * assembly of a PDU for a PHY worker. Only the assembly itself is serialized, since the PDU builder and Msg3 buffer
+ * are shared.
+ */
 class mux : private mux_base
 {
 public:
   explicit mux(srslog::basic_logger& logger);
-  ~mux(){};
+  ~mux();
   void reset();
   void init(rlc_interface_mac* rlc, bsr_interface_mux* bsr_procedure, phr_proc* phr_procedure_);
 
@@ -66,21 +76,34 @@ public:
   void print_logical_channel_state(const std::string& info);
 
 private:
+  using lch_list_t = srsran::bounded_vector<srsran::logical_channel_config_t, SRSRAN_N_RADIO_BEARERS>;
+
   uint8_t* pdu_get_nolock(srsran::byte_buffer_t* payload, uint32_t pdu_sz);
   bool     pdu_move_to_msg3(uint32_t pdu_sz);
   uint32_t allocate_sdu(uint32_t lcid, srsran::sch_pdu* pdu, int max_sdu_sz);
   bool     sched_sdu(srsran::logical_channel_config_t* ch, int* sdu_space, int max_sdu_sz);
 
+  /// Copies the published logical channel list into channels, with the current Bj of each channel
+  void get_logical_channels(lch_list_t& channels) const;
+
   const static int MAX_NOF_SUBHEADERS = 20;
 
-  // Mutex for exclusive access
-  std::mutex mutex;
+  // Serializes the changes of the logical channel configuration
+  std::mutex config_mutex;
+  // Serializes the assembly of PDUs, which share the PDU builder and the Msg3 buffer
+  std::mutex pdu_mutex;
 
   srslog::basic_logger& logger;
-  rlc_interface_mac*    rlc              = nullptr;
-  bsr_interface_mux*    bsr_procedure    = nullptr;
-  phr_proc*             phr_procedure    = nullptr;
-  uint16_t              pending_crnti_ce = 0;
+  rlc_interface_mac*    rlc           = nullptr;
+  bsr_interface_mux*    bsr_procedure = nullptr;
+  phr_proc*             phr_procedure = nullptr;
+  std::atomic<uint16_t> pending_crnti_ce{0};
+
+  // Logical channel list, sorted by priority, replaced by setup_lcid()
+  srsran::rcu_domain             rcu;
+  std::atomic<const lch_list_t*> active_channels{nullptr};
+  // Token bucket of each logical channel, in bytes, indexed by LCID
+  std::array<std::atomic<int32_t>, SRSRAN_N_RADIO_BEARERS> Bj = {};
 
   /* Msg3 Buffer */
   srsran::byte_buffer_t msg_buff;
@@ -89,8 +112,8 @@ private:
   srsran::sch_pdu pdu_msg;
 
   srsran::byte_buffer_t msg3_buff;
-  bool                  msg3_has_been_transmitted = false;
-  bool                  msg3_pending              = false;
+  std::atomic<bool>     msg3_has_been_transmitted{false};
+  std::atomic<bool>     msg3_pending{false};
 };
 
 } // namespace srsue
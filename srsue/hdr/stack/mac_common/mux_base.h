@@ -61,11 +61,16 @@ public:
     return SRSRAN_SUCCESS;
   }
 
-  void print_logical_channel_state(const std::string& info)
+  void print_logical_channel_state(const std::string& info) { print_channels(info, logical_channels); }
+
+protected:
+  /// Logs the state of a range of logical channels
+  template <typename Channels>
+  static void print_channels(const std::string& info, const Channels& channels)
   {
     std::string logline = info;
 
-    for (auto& channel : logical_channels) {
+    for (auto& channel : channels) {
       logline += "\n";
       logline += "- lcid=";
       logline += std::to_string(channel.lcid);
@@ -87,7 +92,6 @@ public:
     srslog::fetch_basic_logger("MAC").debug("%s", logline.c_str());
   }
 
-protected:
   static bool priority_compare(const srsran::logical_channel_config_t& u1, const srsran::logical_channel_config_t& u2)
   {
     return u1.priority <= u2.priority;
@@ -351,6 +351,7 @@ private:
   void log_rr_config_common();
   void log_phy_config_dedicated();
   void log_mac_config_dedicated();
+  void log_drx_config(const srsran::drx_cfg_t& drx_cfg);
 
   void apply_rr_config_common(asn1::rrc::rr_cfg_common_s* config, bool send_lower_layers);
   bool apply_rr_config_dedicated(const asn1::rrc::rr_cfg_ded_s* cnfg, bool is_handover = false);
@@ -361,6 +362,7 @@ private:
   void apply_phy_scell_config(const asn1::rrc::scell_to_add_mod_r10_s& scell_config, bool enable_cqi);
 
   void apply_mac_config_dedicated_default();
+  void apply_drx_config_default();
 
   void handle_sib1();
   void handle_sib2();
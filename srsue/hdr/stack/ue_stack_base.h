@@ -24,6 +24,7 @@
 
 #include "rrc/rrc_config.h"
 #include "rrc_nr/rrc_nr_config.h"
+#include "srsran/common/pcap_writer.h"
 #include "srsue/hdr/stack/upper/nas_config.h"
 #include "srsue/hdr/ue_metrics_interface.h"
 #include "upper/gw.h"
@@ -37,10 +38,11 @@ typedef struct {
 } pcap_args_t;
 
 typedef struct {
-  std::string enable;
-  pcap_args_t mac_pcap;
-  pcap_args_t mac_nr_pcap;
-  pcap_args_t nas_pcap;
+  std::string                enable;
+  pcap_args_t                mac_pcap;
+  pcap_args_t                mac_nr_pcap;
+  pcap_args_t                nas_pcap;
+  srsran::pcap_writer_args_t writer;
 } pkt_trace_args_t;
 
 typedef struct {
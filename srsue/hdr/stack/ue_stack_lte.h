@@ -32,6 +32,7 @@
 #include "rrc_nr/rrc_nr.h"
 #include "srsran/common/bearer_manager.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/adt/mpmc_queue.h"
 #include "srsran/common/multiqueue.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/common/task_scheduler.h"
@@ -239,7 +240,7 @@ private:
 
   // Thread
   static const int                      STACK_MAIN_THREAD_PRIO = 4; // Next lower priority after PHY workers
-  srsran::block_queue<stack_metrics_t>  pending_stack_metrics;
+  srsran::mpmc_queue<stack_metrics_t>   pending_stack_metrics{64};
   task_scheduler                        task_sched;
   srsran::task_multiqueue::queue_handle sync_task_queue, ue_task_queue, gw_queue_id, cfg_task_queue;
 
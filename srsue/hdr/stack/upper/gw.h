@@ -31,9 +31,11 @@
 #include "srsran/srslog/srslog.h"
 #include "tft_packet_filter.h"
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <net/if.h>
 #include <netinet/in.h>
+#include <vector>
 
 namespace srsue {
 
@@ -47,6 +49,8 @@ struct gw_args_t {
   std::string netns;
   std::string tun_dev_name;
   std::string tun_dev_netmask;
+  uint32_t    nof_tun_queues = 1;     // queues of the TUN device (IFF_MULTI_QUEUE), each one with a reader thread
+  bool        tun_vnet_hdr   = false; // read the TCP segments coalesced by the kernel (GSO) and split them here
 };
 
 class gw : public gw_interface_stack, public srsran::thread
@@ -101,7 +105,28 @@ private:
   uint32_t                                       dl_tput_bytes = 0;
   std::chrono::high_resolution_clock::time_point metrics_tp; // stores time when last metrics have been taken
 
-  void run_thread();
+  // Queues of the TUN device. The first one (tun_fd) is read by the GW thread and used for the writes, the others by
+  // a reader thread each. The counters are protected by gw_mutex
+  class tun_reader;
+  struct tun_queue_t {
+    int32_t                                   fd = -1;
+    std::unique_ptr<tun_reader>               reader;
+    std::vector<uint8_t>                      frame; // packet read with its virtio_net_hdr, if enabled
+    std::vector<srsran::unique_byte_buffer_t> pkts;  // IP packets the frame is split into
+    uint32_t                                  ul_pkts     = 0;
+    uint32_t                                  ul_bytes    = 0;
+    uint32_t                                  ul_gso_pkts = 0;
+    uint32_t                                  ul_dropped  = 0;
+  };
+  std::vector<std::unique_ptr<tun_queue_t>> tun_queues;
+
+  void    run_thread();
+  void    run_tun_queue(tun_queue_t& queue);
+  void    handle_ul_pdu(srsran::unique_byte_buffer_t pdu, tun_queue_t& queue, std::unique_lock<std::mutex>& lock);
+  void    start_tun_readers();
+  void    stop_tun_readers();
+  void    close_tun_queues();
+  ssize_t write_tun(srsran::byte_buffer_t* pdu);
   int  init_if(char* err_str);
   int  setup_if_addr4(uint32_t ip_addr, char* err_str);
   int  setup_if_addr6(uint8_t* ipv6_if_id, char* err_str);
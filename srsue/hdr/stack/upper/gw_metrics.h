@@ -22,11 +22,22 @@
 #ifndef SRSUE_GW_METRICS_H
 #define SRSUE_GW_METRICS_H
 
+#include <cstdint>
+#include <vector>
+
 namespace srsue {
 
+struct gw_tun_queue_metrics_t {
+  double   ul_tput_mbps;
+  uint32_t ul_pkts;     ///< IP packets read, after splitting the GSO packets
+  uint32_t ul_gso_pkts; ///< GSO packets split into several IP packets
+  uint32_t ul_dropped;  ///< Malformed packets dropped
+};
+
 struct gw_metrics_t {
-  double dl_tput_mbps;
-  double ul_tput_mbps;
+  double                              dl_tput_mbps;
+  double                              ul_tput_mbps;
+  std::vector<gw_tun_queue_metrics_t> tun_queues;
 };
 
 } // namespace srsue
@@ -22,10 +22,14 @@
 #ifndef SRSUE_PACKET_FILTER_H
 #define SRSUE_PACKET_FILTER_H
 
+#include "srsran/adt/rcu_circular_map.h"
 #include "srsran/asn1/liblte_mme.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/srslog/srslog.h"
+#include <map>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace srsue {
 
@@ -70,8 +74,8 @@ public:
   tft_packet_filter_t(uint8_t                                eps_bearer_id_,
                       const LIBLTE_MME_PACKET_FILTER_STRUCT& tft_,
                       srslog::basic_logger&                  logger);
-  bool match(const srsran::unique_byte_buffer_t& pdu);
-  bool filter_contains(uint16_t filtertype);
+  bool match(const srsran::unique_byte_buffer_t& pdu) const;
+  bool filter_contains(uint16_t filtertype) const;
 
   uint8_t  eps_bearer_id             = {};
   uint8_t  id                        = {};
@@ -99,11 +103,40 @@ public:
 
   srslog::basic_logger& logger;
 
-  bool match_ip(const srsran::unique_byte_buffer_t& pdu);
-  bool match_protocol(const srsran::unique_byte_buffer_t& pdu);
-  bool match_type_of_service(const srsran::unique_byte_buffer_t& pdu);
-  bool match_flow_label(const srsran::unique_byte_buffer_t& pdu);
-  bool match_port(const srsran::unique_byte_buffer_t& pdu);
+  bool match_ip(const srsran::unique_byte_buffer_t& pdu) const;
+  bool match_protocol(const srsran::unique_byte_buffer_t& pdu) const;
+  bool match_type_of_service(const srsran::unique_byte_buffer_t& pdu) const;
+  bool match_flow_label(const srsran::unique_byte_buffer_t& pdu) const;
+  bool match_port(const srsran::unique_byte_buffer_t& pdu) const;
+};
+
+/**
+ * Classifier compiled from a set of packet filters, using tuple space search. The filters are grouped by the
+ * combination of exact match components they use among protocol, single local port and single remote port, and each
+ * group is a hash table indexed by the values of those components. A packet is looked up once in each group, and only
+ * the filters found there are evaluated completely, in evaluation precedence order. The number of groups is bounded by
+ * the number of combinations, so the classification cost does not grow with the number of filters.
+ */
+class tft_classifier
+{
+public:
+  explicit tft_classifier(const std::map<uint16_t, tft_packet_filter_t>& filter_map);
+
+  /// Returns the matching filter with the lowest evaluation precedence, or nullptr if none matches
+  const tft_packet_filter_t* classify(const srsran::unique_byte_buffer_t& pdu) const;
+
+private:
+  static const uint16_t hashed_flags = PROTOCOL_ID_FLAG | SINGLE_LOCAL_PORT_FLAG | SINGLE_REMOTE_PORT_FLAG;
+
+  struct tuple_t {
+    uint16_t                                             flags; ///< hashed components used by the filters of the group
+    std::unordered_map<uint64_t, std::vector<uint32_t> > table; ///< indexes of the filters, in precedence order
+  };
+
+  static uint64_t make_key(uint16_t flags, uint8_t protocol, uint16_t local_port, uint16_t remote_port);
+
+  std::vector<tft_packet_filter_t> filters; ///< in evaluation precedence order
+  std::vector<tuple_t>             tuples;
 };
 
 /**
@@ -113,7 +146,7 @@ class tft_pdu_matcher
 {
 public:
   explicit tft_pdu_matcher(srslog::basic_logger& logger) : logger(logger) {}
-  ~tft_pdu_matcher(){};
+  ~tft_pdu_matcher() { delete classifier.load(std::memory_order_relaxed); }
 
   void reset();
 
@@ -123,10 +156,18 @@ public:
   void    delete_tft_for_eps_bearer(const uint8_t eps_bearer_id);
 
 private:
+  /// Compiles the filter map into a new classifier and publishes it. Caller must hold tft_mutex
+  void update_classifier();
+
   srslog::basic_logger&                           logger;
   std::mutex                                      tft_mutex;
   typedef std::map<uint16_t, tft_packet_filter_t> tft_filter_map_t;
   tft_filter_map_t                                tft_filter_map;
+
+  // The classifier used by check_tft_filter_match() is replaced on each modification of the filters, and read without
+  // locks inside a read-side critical section of the RCU domain
+  srsran::rcu_domain                 rcu;
+  std::atomic<const tft_classifier*> classifier{nullptr};
 };
 
 } // namespace srsue
@@ -31,6 +31,7 @@
 #include <pthread.h>
 #include <stdarg.h>
 #include <string>
+#include <vector>
 
 #include "phy/ue_phy_base.h"
 #include "srsran/common/buffer_pool.h"
@@ -75,6 +76,13 @@ typedef struct {
   bool        tracing_enable;
   std::string tracing_filename;
   std::size_t tracing_buffcapacity;
+  bool        tracing_hot_enable;
+  std::string tracing_hot_filename;
+  std::size_t tracing_hot_events;
+  bool        mem_lock;
+  uint32_t    mem_reserve_heap_mb;
+  bool        mem_prefault;
+  uint32_t    nof_ues;
 } general_args_t;
 
 typedef struct {
@@ -119,6 +127,14 @@ private:
   std::unique_ptr<ue_stack_base>      stack;
   std::unique_ptr<gw>                 gw_inst;
 
+  // Other UEs that share the radio with the one above when several UEs are simulated
+  struct extra_ue_t {
+    std::unique_ptr<ue_phy_base>   phy;
+    std::unique_ptr<ue_stack_base> stack;
+    std::unique_ptr<gw>            gw_inst;
+  };
+  std::vector<extra_ue_t> extra_ues;
+
   // Generic logger members
   srslog::basic_logger& logger;
 
@@ -129,6 +145,9 @@ private:
 
   // Helper functions
   int parse_args(const all_args_t& args); // parse and validate arguments
+  int init_multi_ue();
+
+  static all_args_t get_ue_args(const all_args_t& args, uint32_t ue_idx);
 
   std::string get_build_mode();
   std::string get_build_info();
@@ -26,6 +26,7 @@
 
 #include "phy/phy_metrics.h"
 #include "srsran/common/metrics_hub.h"
+#include "srsran/common/time_prof.h"
 #include "srsran/radio/radio_metrics.h"
 #include "srsran/rlc/rlc_metrics.h"
 #include "srsran/system/sys_metrics.h"
@@ -48,12 +49,13 @@ typedef struct {
 } stack_metrics_t;
 
 typedef struct {
-  srsran::rf_metrics_t  rf;
-  phy_metrics_t         phy;
-  phy_metrics_t         phy_nr;
-  gw_metrics_t          gw;
-  stack_metrics_t       stack;
-  srsran::sys_metrics_t sys;
+  srsran::rf_metrics_t                           rf;
+  phy_metrics_t                                  phy;
+  phy_metrics_t                                  phy_nr;
+  gw_metrics_t                                   gw;
+  stack_metrics_t                                stack;
+  srsran::sys_metrics_t                          sys;
+  std::vector<srsran::tprof_histogram_metrics_t> stages; ///< processing time of the TTI stages
 } ue_metrics_t;
 
 // UE interface
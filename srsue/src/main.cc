@@ -19,9 +19,11 @@
  *
  */
 
+#include "srsran/adt/pool/pool_registry.h"
 #include "srsran/common/common_helper.h"
 #include "srsran/common/config_file.h"
 #include "srsran/common/crash_handler.h"
+#include "srsran/common/mem_prefault.h"
 #include "srsran/common/metrics_hub.h"
 #include "srsran/common/multiqueue.h"
 #include "srsran/common/tsan_options.h"
@@ -83,6 +85,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
   common.add_options()
     ("ue.radio", bpo::value<string>(&args->rf.type)->default_value("multi"), "Type of the radio [multi]")
     ("ue.phy", bpo::value<string>(&args->phy.type)->default_value("lte"), "Type of the PHY [lte]")
+    ("ue.nof_ues", bpo::value<uint32_t>(&args->general.nof_ues)->default_value(1), "Number of simulated UEs sharing the radio, each one with its own stack and PHY")
 
     ("rf.srate",        bpo::value<double>(&args->rf.srate_hz)->default_value(0.0),          "Force Tx and Rx sampling rate in Hz")
     ("rf.freq_offset",  bpo::value<float>(&args->rf.freq_offset)->default_value(0),          "(optional) Frequency offset")
@@ -169,6 +172,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("pcap.mac_filename", bpo::value<string>(&args->stack.pkt_trace.mac_pcap.filename)->default_value("/tmp/ue_mac.pcap"), "MAC layer capture filename")
     ("pcap.mac_nr_filename", bpo::value<string>(&args->stack.pkt_trace.mac_nr_pcap.filename)->default_value("/tmp/ue_mac_nr.pcap"), "MAC_NR layer capture filename")
     ("pcap.nas_filename", bpo::value<string>(&args->stack.pkt_trace.nas_pcap.filename)->default_value("/tmp/ue_nas.pcap"), "NAS layer capture filename")
+    ("pcap.ring_size_kb", bpo::value<uint32_t>(&args->stack.pkt_trace.writer.ring_size_kb)->default_value(4096), "Size of the record ring of each PCAP file in kB")
+    ("pcap.max_file_size_mb", bpo::value<uint32_t>(&args->stack.pkt_trace.writer.max_file_size_mb)->default_value(0), "Rotate the PCAP files when they reach this size in MB (0 for no limit)")
+    ("pcap.rotation_period_s", bpo::value<uint32_t>(&args->stack.pkt_trace.writer.rotation_period_s)->default_value(0), "Rotate the PCAP files after this many seconds (0 for no limit)")
+    ("pcap.compress", bpo::value<bool>(&args->stack.pkt_trace.writer.compress)->default_value(false), "Compress the PCAP files with gzip")
     
     ("gui.enable", bpo::value<bool>(&args->gui.enable)->default_value(false), "Enable GUI plots")
 
@@ -212,6 +219,8 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("gw.netns", bpo::value<string>(&args->gw.netns)->default_value(""), "Network namespace to for TUN device (empty for default netns)")
     ("gw.ip_devname", bpo::value<string>(&args->gw.tun_dev_name)->default_value("tun_srsue"), "Name of the tun_srsue device")
     ("gw.ip_netmask", bpo::value<string>(&args->gw.tun_dev_netmask)->default_value("255.255.255.0"), "Netmask of the tun_srsue device")
+    ("gw.nof_tun_queues", bpo::value<uint32_t>(&args->gw.nof_tun_queues)->default_value(1), "Number of queues of the tun_srsue device, each one read by its own thread")
+    ("gw.tun_vnet_hdr", bpo::value<bool>(&args->gw.tun_vnet_hdr)->default_value(false), "Read the TCP segments coalesced by the kernel (GSO) from the tun_srsue device and split them in the GW")
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),                 "Enable/Disable internal Downlink channel emulator")
@@ -294,6 +303,14 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<float>(&args->phy.sfo_ema)->default_value(DEFAULT_SFO_EMA_COEFF),
      "EMA coefficient to average sample offsets used to compute SFO")
 
+    ("phy.pss_track_window",
+     bpo::value<uint32_t>(&args->phy.pss_track_window)->default_value(0),
+     "Samples searched around the expected PSS position while tracking, 0 for the default (CP length)")
+
+    ("phy.pss_track_fft",
+     bpo::value<bool>(&args->phy.pss_track_fft)->default_value(false),
+     "Computes the PSS tracking correlation through the DFT")
+
     ("phy.snr_ema_coeff",
      bpo::value<float>(&args->phy.snr_ema_coeff)->default_value(0.1),
      "Sets the SNR exponential moving average coefficient (Default 0.1)")
@@ -326,6 +343,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
        bpo::value<uint32_t>(&args->phy.intra_freq_meas_period_ms)->default_value(200),
        "Period of intra-frequency neighbour cell measurement in ms. Maximum as per 3GPP is 200 ms.")
 
+    ("phy.intra_freq_meas_duty_cycle",
+       bpo::value<uint32_t>(&args->phy.intra_freq_meas_duty_cycle)->default_value(100),
+       "Maximum percentage of time spent in intra-frequency neighbour cell measurements, it delays the next one.")
+
     ("phy.correct_sync_error",
        bpo::value<bool>(&args->phy.correct_sync_error)->default_value(false),
        "Channel estimator measures and pre-compensates time synchronization error. Increases CPU usage, improves PDSCH "
@@ -344,6 +365,11 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<float>(&args->phy.cfo_correct_tol_hz)->default_value(1.0),
      "Tolerance (in Hz) for digital CFO compensation (needs to be low if interpolate_subframe_enabled=true.")
 
+    ("phy.cfo_correct_in_ofdm",
+     bpo::value<bool>(&args->phy.cfo_correct_in_ofdm)->default_value(false),
+     "Corrects the tracked CFO in the OFDM demodulator, on the DFT windows only, instead of in a separate pass over "
+     "every received buffer. It is ignored if NR carriers are enabled.")
+
     ("phy.cfo_pss_ema",
      bpo::value<float>(&args->phy.cfo_pss_ema)->default_value(DEFAULT_CFO_EMA_TRACK),
      "CFO Exponential Moving Average coefficient for PSS estimation during TRACK.")
@@ -393,6 +419,15 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<float>(&args->phy.snr_to_cqi_offset)->default_value(0),
      "Sets an offset in the SNR to CQI table. This is used to adjust the reported CQI.")
 
+    ("phy.pdcch_prescreen_ratio",
+     bpo::value<float>(&args->phy.pdcch_prescreen_ratio)->default_value(0.1f),
+     "Skips the PDCCH candidates whose LLR energy is below this ratio of the strongest candidate (0 disables it).")
+
+    ("phy.dl_ctrl_first",
+     bpo::value<bool>(&args->phy.dl_ctrl_first)->default_value(false),
+     "Demodulates the control region first and the rest of the subframe only if there is a PDSCH to decode. The "
+     "subframes in cfo_ref_mask are always demodulated completely.")
+
     ("phy.sss_algorithm",
      bpo::value<string>(&args->phy.sss_algorithm)->default_value("full"),
      "Selects the SSS estimation algorithm.")
@@ -405,6 +440,15 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
        bpo::value<bool>(&args->phy.pdsch_8bit_decoder)->default_value(false),
        "Use 8-bit for LLR representation and turbo decoder trellis computation (Experimental)")
 
+    ("phy.nof_cb_decoder_threads",
+       bpo::value<uint32_t>(&args->phy.nof_cb_decoder_threads)->default_value(0),
+       "Number of threads helping the PHY workers to decode the PDSCH code blocks in parallel (0 disables it)")
+
+    ("phy.ul_early_encode",
+     bpo::value<bool>(&args->phy.ul_early_encode)->default_value(false),
+     "Processes the UL grant and encodes the PUSCH transport block right after the PDCCH and PHICH decoding, in "
+     "parallel with the PDSCH decoding if nof_cb_decoder_threads > 0.")
+
     ("phy.force_ul_amplitude",
        bpo::value<float>(&args->phy.force_ul_amplitude)->default_value(0.0),
        "Forces the peak amplitude in the PUCCH, PUSCH and SRS (set 0.0 to 1.0, set to 0 or negative for disabling)")
@@ -441,11 +485,23 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<int>(&args->phy.force_N_id_1)->default_value(-1),
      "Force using a specific SSS (set to -1 to allow all SSSs).")
 
+    ("phy.cell_search_single_pass",
+     bpo::value<bool>(&args->phy.cell_search_single_pass)->default_value(false),
+     "Search the three PSSs on the same frames in a single correlation pass, instead of one after another.")
+
     // PHY NR args
     ("phy.nr.store_pdsch_ko",
       bpo::value<bool>(&args->phy.nr_store_pdsch_ko)->default_value(false),
       "Dumps the PDSCH baseband samples into a file on KO reception.")
 
+    ("phy.nr.nof_rx_slots",
+      bpo::value<uint32_t>(&args->phy.nr_nof_rx_slots)->default_value(0),
+      "Slots the SA receiver queues while all the PHY workers are busy, instead of waiting for one (0 waits).")
+
+    ("phy.nr.search_threads",
+      bpo::value<uint32_t>(&args->phy.nr_search_threads)->default_value(0),
+      "Extra threads correlating the SSB raster candidates of a wideband SA cell search.")
+
     // UE simulation args
     ("sim.airplane_t_on_ms",
      bpo::value<int>(&args->stack.nas.sim.airplane_t_on_ms)->default_value(-1),
@@ -496,6 +552,30 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
            bpo::value<std::size_t>(&args->general.tracing_buffcapacity)->default_value(1000000),
            "Tracing buffer capcity")
 
+    ("general.tracing_hot_enable",
+           bpo::value<bool>(&args->general.tracing_hot_enable)->default_value(false),
+           "Hot path tracing of the RLC and PDCP, exported in Chrome trace JSON format at exit")
+
+    ("general.tracing_hot_filename",
+           bpo::value<string>(&args->general.tracing_hot_filename)->default_value("/tmp/ue_trace.json"),
+           "Hot path tracing JSON filename")
+
+    ("general.tracing_hot_events",
+           bpo::value<std::size_t>(&args->general.tracing_hot_events)->default_value(65536),
+           "Number of most recent hot path events kept per thread")
+
+    ("general.mem_lock",
+           bpo::value<bool>(&args->general.mem_lock)->default_value(true),
+           "Lock the memory of the process with mlockall")
+
+    ("general.mem_reserve_heap_mb",
+           bpo::value<uint32_t>(&args->general.mem_reserve_heap_mb)->default_value(0),
+           "Heap faulted in before the PHY allocates its buffers, in MB. 0 disables it")
+
+    ("general.mem_prefault",
+           bpo::value<bool>(&args->general.mem_prefault)->default_value(true),
+           "Fault in the memory of the pools once the UE is initialized")
+
     ("stack.have_tti_time_stats",
         bpo::value<bool>(&args->stack.have_tti_time_stats)->default_value(true),
         "Calculate TTI execution statistics")
@@ -751,6 +831,11 @@ int main(int argc, char* argv[])
       return SRSRAN_ERROR;
     }
   }
+  if (args.general.tracing_hot_enable) {
+    if (!srslog::event_trace_hot_init(args.general.tracing_hot_filename, args.general.tracing_hot_events)) {
+      return SRSRAN_ERROR;
+    }
+  }
 #endif
 
   // Start the log backend.
@@ -761,9 +846,14 @@ int main(int argc, char* argv[])
 
   srsran::check_scaling_governor(args.rf.device_name);
 
-  if (mlockall((uint32_t)MCL_CURRENT | (uint32_t)MCL_FUTURE) == -1) {
-    fprintf(stderr, "Failed to `mlockall`: %d", errno);
+  // Fault in the memory before the PHY allocates its buffers, and the memory of the pools once they are created
+  auto        t_prefault = std::chrono::steady_clock::now();
+  std::string err;
+  if (args.general.mem_lock and not srsran::mem_lock_all(err)) {
+    fprintf(stderr, "Failed to `mlockall`: %s\n", err.c_str());
   }
+  srsran::mem_reserve_heap(size_t(args.general.mem_reserve_heap_mb) << 20U);
+  double prefault_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t_prefault).count();
 
   // Create UE instance.
   srsue::ue ue;
@@ -772,6 +862,15 @@ int main(int argc, char* argv[])
     return SRSRAN_SUCCESS;
   }
 
+  t_prefault        = std::chrono::steady_clock::now();
+  size_t pool_bytes = args.general.mem_prefault ? srsran::pool_registry::get().prefault() : 0;
+  prefault_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t_prefault).count();
+  printf("Memory prefault: lock=%s, heap=%d MB, pools=%.1f MB, %.1f ms\n",
+         args.general.mem_lock ? "yes" : "no",
+         args.general.mem_reserve_heap_mb,
+         pool_bytes / (1024.0 * 1024.0),
+         prefault_ms);
+
   srsran::metrics_hub<ue_metrics_t> metricshub;
   metrics_stdout                    _metrics_screen;
 
@@ -821,6 +920,15 @@ int main(int argc, char* argv[])
   metricshub.stop();
   metrics_file.stop();
   ue.stop();
+#ifdef ENABLE_SRSLOG_EVENT_TRACE
+  if (args.general.tracing_hot_enable) {
+    if (srslog::event_trace_hot_export()) {
+      cout << "Hot path trace written to " << args.general.tracing_hot_filename << endl;
+    } else {
+      cout << "Error writing the hot path trace to " << args.general.tracing_hot_filename << endl;
+    }
+  }
+#endif
   cout << "---  exiting  ---" << endl;
 
   return SRSRAN_SUCCESS;
@@ -76,13 +76,14 @@ void metrics_csv::stop()
   }
 }
 
-void metrics_csv::set_metrics_helper(const srsran::rf_metrics_t&  rf,
-                                     const srsran::sys_metrics_t& sys,
-                                     const phy_metrics_t&         phy,
-                                     const mac_metrics_t          mac[SRSRAN_MAX_CARRIERS],
-                                     const rrc_metrics_t&         rrc,
-                                     const uint32_t               cc,
-                                     const uint32_t               r)
+void metrics_csv::set_metrics_helper(const srsran::rf_metrics_t&                           rf,
+                                     const srsran::sys_metrics_t&                          sys,
+                                     const phy_metrics_t&                                  phy,
+                                     const mac_metrics_t                                   mac[SRSRAN_MAX_CARRIERS],
+                                     const rrc_metrics_t&                                  rrc,
+                                     const std::vector<srsran::tprof_histogram_metrics_t>& stages,
+                                     const uint32_t                                        cc,
+                                     const uint32_t                                        r)
 {
   if (not file.is_open()) {
     return;
@@ -175,6 +176,12 @@ void metrics_csv::set_metrics_helper(const srsran::rf_metrics_t&  rf,
     file << float_to_string(m.cpu_load[i], 2, (i != last_cpu_index));
   }
 
+  // Write the processing time of the TTI stages.
+  for (const srsran::tprof_histogram_metrics_t& s : stages) {
+    file << ";" << float_to_string(s.p50_us, 2) << float_to_string(s.p99_us, 2)
+         << float_to_string(s.max_us, 2, false);
+  }
+
   file << "\n";
 }
 
@@ -198,13 +205,19 @@ void metrics_csv::set_metrics(const ue_metrics_t& metrics, const uint32_t period
         file << ";cpu_" << std::to_string(i);
       }
 
+      // Add the processing time of the TTI stages
+      for (const srsran::tprof_histogram_metrics_t& s : metrics.stages) {
+        file << ";" << s.name << "_p50_us;" << s.name << "_p99_us;" << s.name << "_max_us";
+      }
+
       // Add the new line.
       file << "\n";
     }
 
     // Metrics for LTE carrier
     for (uint32_t r = 0; r < metrics.phy.nof_active_cc; r++) {
-      set_metrics_helper(metrics.rf, metrics.sys, metrics.phy, metrics.stack.mac, metrics.stack.rrc, r, r);
+      set_metrics_helper(
+          metrics.rf, metrics.sys, metrics.phy, metrics.stack.mac, metrics.stack.rrc, metrics.stages, r, r);
     }
 
     // Metrics for NR carrier
@@ -214,6 +227,7 @@ void metrics_csv::set_metrics(const ue_metrics_t& metrics, const uint32_t period
                          metrics.phy_nr,
                          metrics.stack.mac_nr,
                          metrics.stack.rrc,
+                         metrics.stages,
                          metrics.phy.nof_active_cc + r, // NR carrier offset
                          r);
     }
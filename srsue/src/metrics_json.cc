@@ -77,7 +77,17 @@ DECLARE_METRIC_SET("carrier_container",
 DECLARE_METRIC_LIST("carrier_list", mlist_carriers, std::vector<mset_carrier_container>);
 
 /// GW container.
-DECLARE_METRIC_SET("gw_container", mset_gw_container, metric_dl_brate, metric_ul_brate);
+DECLARE_METRIC("ul_pkts", metric_ul_pkts, uint32_t, "");
+DECLARE_METRIC("ul_gso_pkts", metric_ul_gso_pkts, uint32_t, "");
+DECLARE_METRIC("ul_dropped", metric_ul_dropped, uint32_t, "");
+DECLARE_METRIC_SET("tun_queue_container",
+                   mset_tun_queue_container,
+                   metric_ul_brate,
+                   metric_ul_pkts,
+                   metric_ul_gso_pkts,
+                   metric_ul_dropped);
+DECLARE_METRIC_LIST("tun_queue_list", mlist_tun_queues, std::vector<mset_tun_queue_container>);
+DECLARE_METRIC_SET("gw_container", mset_gw_container, metric_dl_brate, metric_ul_brate, mlist_tun_queues);
 
 /// RRC container.
 DECLARE_METRIC("rrc_state", metric_rrc_state, std::string, "");
@@ -121,6 +131,35 @@ DECLARE_METRIC_SET("sys_cpu_container",
                    metric_thread_count,
                    mlist_cpu_core_list);
 
+/// Processing stage container.
+DECLARE_METRIC("stage_name", metric_stage_name, std::string, "");
+DECLARE_METRIC("count", metric_stage_count, uint64_t, "");
+DECLARE_METRIC("avg", metric_stage_avg, float, "us");
+DECLARE_METRIC("p50", metric_stage_p50, float, "us");
+DECLARE_METRIC("p99", metric_stage_p99, float, "us");
+DECLARE_METRIC("p99_9", metric_stage_p999, float, "us");
+DECLARE_METRIC("max", metric_stage_max, float, "us");
+DECLARE_METRIC_SET("stage_container",
+                   mset_stage_container,
+                   metric_stage_name,
+                   metric_stage_count,
+                   metric_stage_avg,
+                   metric_stage_p50,
+                   metric_stage_p99,
+                   metric_stage_p999,
+                   metric_stage_max);
+DECLARE_METRIC_LIST("stage_list", mlist_stage, std::vector<mset_stage_container>);
+
+/// DRX container.
+DECLARE_METRIC("active_sf", metric_drx_active_sf, uint32_t, "");
+DECLARE_METRIC("skipped_sf", metric_drx_skipped_sf, uint32_t, "");
+DECLARE_METRIC("cpu_saved", metric_drx_cpu_saved, float, "ms");
+DECLARE_METRIC_SET("drx_container",
+                   mset_drx_container,
+                   metric_drx_active_sf,
+                   metric_drx_skipped_sf,
+                   metric_drx_cpu_saved);
+
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
@@ -135,7 +174,9 @@ using metric_context_t = srslog::build_context_type<metric_type_tag,
                                                     mset_nas_container,
                                                     mset_rf_container,
                                                     mset_sys_mem_container,
-                                                    mset_sys_cpu_container>;
+                                                    mset_sys_cpu_container,
+                                                    mlist_stage,
+                                                    mset_drx_container>;
 
 } // namespace
 
@@ -201,6 +242,15 @@ void metrics_json::set_metrics(const ue_metrics_t& metrics, const uint32_t perio
   // Fill GW container.
   ctx.get<mset_gw_container>().write<metric_dl_brate>(metrics.gw.dl_tput_mbps);
   ctx.get<mset_gw_container>().write<metric_ul_brate>(metrics.gw.ul_tput_mbps);
+  auto& tun_queue_list = ctx.get<mset_gw_container>().get<mlist_tun_queues>();
+  tun_queue_list.resize(metrics.gw.tun_queues.size());
+  for (uint32_t i = 0, e = tun_queue_list.size(); i != e; ++i) {
+    auto& tun_queue = tun_queue_list[i];
+    tun_queue.write<metric_ul_brate>(metrics.gw.tun_queues[i].ul_tput_mbps);
+    tun_queue.write<metric_ul_pkts>(metrics.gw.tun_queues[i].ul_pkts);
+    tun_queue.write<metric_ul_gso_pkts>(metrics.gw.tun_queues[i].ul_gso_pkts);
+    tun_queue.write<metric_ul_dropped>(metrics.gw.tun_queues[i].ul_dropped);
+  }
 
   // Fill RRC container.
   ctx.get<mset_rrc_container>().write<metric_rrc_state>(rrc_state_text[metrics.stack.rrc.state]);
@@ -238,6 +288,24 @@ void metrics_json::set_metrics(const ue_metrics_t& metrics, const uint32_t perio
     core_list[i].write<metric_proc_core_usage>(metrics.sys.cpu_load[i]);
   }
 
+  // Fill the processing time of the TTI stages.
+  auto& stage_list = ctx.get<mlist_stage>();
+  stage_list.resize(metrics.stages.size());
+  for (uint32_t i = 0, e = stage_list.size(); i != e; ++i) {
+    stage_list[i].write<metric_stage_name>(metrics.stages[i].name);
+    stage_list[i].write<metric_stage_count>(metrics.stages[i].count);
+    stage_list[i].write<metric_stage_avg>(metrics.stages[i].avg_us);
+    stage_list[i].write<metric_stage_p50>(metrics.stages[i].p50_us);
+    stage_list[i].write<metric_stage_p99>(metrics.stages[i].p99_us);
+    stage_list[i].write<metric_stage_p999>(metrics.stages[i].p999_us);
+    stage_list[i].write<metric_stage_max>(metrics.stages[i].max_us);
+  }
+
+  // Fill DRX container.
+  ctx.get<mset_drx_container>().write<metric_drx_active_sf>(metrics.phy.drx.nof_active_sf);
+  ctx.get<mset_drx_container>().write<metric_drx_skipped_sf>(metrics.phy.drx.nof_skipped_sf);
+  ctx.get<mset_drx_container>().write<metric_drx_cpu_saved>(metrics.phy.drx.cpu_saved_ms);
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
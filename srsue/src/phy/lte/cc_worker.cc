@@ -22,6 +22,7 @@
 #include "srsran/srsran.h"
 
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/time_prof.h"
 #include "srsue/hdr/phy/lte/cc_worker.h"
 
 #define Error(fmt, ...)                                                                                                \
@@ -50,6 +51,12 @@ namespace lte {
  *
  */
 
+// Runs the PDSCH code block decoding and channel estimation tasks in the pool shared by all the workers
+static void cb_parallel_for(void* executor, srsran_sch_task_t task, void* arg, uint32_t nof_tasks)
+{
+  static_cast<srsran::task_thread_pool*>(executor)->parallel_for(nof_tasks, task, arg);
+}
+
 cc_worker::cc_worker(uint32_t cc_idx_, uint32_t max_prb, srsue::phy_common* phy_, srslog::basic_logger& logger) :
   logger(logger)
 {
@@ -109,10 +116,22 @@ cc_worker::cc_worker(uint32_t cc_idx_, uint32_t max_prb, srsue::phy_common* phy_
     ue_dl.pdsch.llr_is_8bit        = true;
     ue_dl.pdsch.dl_sch.llr_is_8bit = true;
   }
+
+  // The worker thread takes part in the decoding, hence one more task than threads in the pool
+  if (phy->cb_decoder_pool != nullptr &&
+      srsran_sch_set_cb_executor(
+          &ue_dl.pdsch.dl_sch, cb_parallel_for, phy->cb_decoder_pool.get(), phy->args->nof_cb_decoder_threads + 1)) {
+    Error("Setting parallel code block decoding");
+  }
+  if (phy->cb_decoder_pool != nullptr &&
+      srsran_chest_dl_set_executor(&ue_dl.chest, cb_parallel_for, phy->cb_decoder_pool.get())) {
+    Error("Setting parallel channel estimation");
+  }
 }
 
 cc_worker::~cc_worker()
 {
+  wait_prepare_ul();
   for (uint32_t i = 0; i < phy->args->nof_rx_ant; i++) {
     if (signal_buffer_tx[i]) {
       free(signal_buffer_tx[i]);
@@ -194,6 +213,11 @@ void cc_worker::set_cfo_nolock(float cfo)
   ue_ul_cfg.cfo_value = cfo;
 }
 
+void cc_worker::set_rx_cfo_nolock(float cfo_hz)
+{
+  srsran_ue_dl_set_rx_cfo(&ue_dl, cfo_hz);
+}
+
 float cc_worker::get_ref_cfo() const
 {
   return ue_dl.chest_res.cfo;
@@ -247,8 +271,14 @@ bool cc_worker::work_dl_regular()
       srsran_ue_dl_set_mi_manual(&ue_dl, i);
     }
 
-    /* Do FFT and extract PDCCH LLR, or quit if no actions are required in this subframe */
-    if (srsran_ue_dl_decode_fft_estimate(&ue_dl, &sf_cfg_dl, &ue_dl_cfg) < 0) {
+    /* Do FFT and extract PDCCH LLR, or quit if no actions are required in this subframe. If enabled, the rest of the
+     * subframe is demodulated only if there is a PDSCH to decode */
+    srsran::tprof_measure ofdm_meas;
+    ofdm_meas.start();
+    int ret = phy->args->dl_ctrl_first ? srsran_ue_dl_decode_fft_estimate_ctrl(&ue_dl, &sf_cfg_dl, &ue_dl_cfg)
+                                       : srsran_ue_dl_decode_fft_estimate(&ue_dl, &sf_cfg_dl, &ue_dl_cfg);
+    srsran::get_stage_histogram(srsran::tti_stage::ofdm)(ofdm_meas.stop());
+    if (ret < 0) {
       Error("Getting PDCCH FFT estimate");
       return false;
     }
@@ -261,6 +291,12 @@ bool cc_worker::work_dl_regular()
     }
   }
 
+  // The UL grant of TTI_TX only depends on the PDCCH and the PHICH, so it is processed while the PDSCH is decoded
+  if (ul_early) {
+    decode_phich();
+    start_prepare_ul();
+  }
+
   srsran_dci_dl_t dci_dl       = {};
   uint32_t        grant_cc_idx = 0;
   bool            has_dl_grant = phy->get_dl_pending_grant(CURRENT_TTI, cc_idx, &grant_cc_idx, &dci_dl);
@@ -310,10 +346,21 @@ bool cc_worker::work_dl_regular()
       }
     }
     phy->stack->tb_decoded(cc_idx, mac_grant, dl_ack);
+
+    // A failed transport block keeps the UE in DRX Active Time for its retransmission
+    bool tb_failed = false;
+    for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+      tb_failed |= ue_dl_cfg.cfg.pdsch.grant.tb[i].enabled and not dl_ack[i];
+    }
+    if (tb_failed and SRSRAN_RNTI_ISUSER(dci_dl.rnti) and not dci_dl.is_pdcch_order) {
+      phy->drx.new_dl_nack(CURRENT_TTI, dci_dl.pid, phy->get_dl_harq_rtt(CURRENT_TTI, sf_cfg_dl.tdd_config));
+    }
   }
 
   /* Decode PHICH */
-  decode_phich();
+  if (not ul_early) {
+    decode_phich();
+  }
 
   return true;
 }
@@ -401,6 +448,8 @@ void cc_worker::dl_phy_to_mac_grant(srsran_pdsch_grant_t*
 
 int cc_worker::decode_pdcch_dl()
 {
+  srsran::scoped_stage_prof prof(srsran::tti_stage::pdcch);
+
   int nof_grants = 0;
 
   uint16_t dl_rnti = phy->stack->get_dl_sched_rnti(CURRENT_TTI);
@@ -424,6 +473,11 @@ int cc_worker::decode_pdcch_dl()
       phy->set_rar_grant_tti(CURRENT_TTI);
     }
 
+    // A PDCCH for the UE starts the DRX inactivity timer
+    if (nof_grants > 0 && SRSRAN_RNTI_ISUSER(dl_rnti)) {
+      phy->drx.new_pdcch(CURRENT_TTI);
+    }
+
     for (int k = 0; k < nof_grants; k++) {
       // Save dci to CC index
       phy->set_dl_pending_grant(CURRENT_TTI, dci[k].cif_present ? dci[k].cif : cc_idx, cc_idx, &dci[k]);
@@ -466,11 +520,26 @@ int cc_worker::decode_pdsch(srsran_pdsch_ack_resource_t            ack_resource,
     }
   }
 
-  // Run PDSCH decoder
+  // Run PDSCH decoder. A retransmission of TBs that were already decoded is ACKed again without demodulating the data
+  // region, if only the control region was
   if (decode_enable) {
+    srsran::tprof_measure ofdm_meas;
+    ofdm_meas.start();
+    if (srsran_ue_dl_decode_fft_estimate_data(&ue_dl, &sf_cfg_dl, &ue_dl_cfg) < 0) {
+      Error("Getting PDSCH FFT estimate");
+    }
+    srsran::get_stage_histogram(srsran::tti_stage::ofdm)(ofdm_meas.stop());
+
+    srsran::tprof_measure meas;
+    meas.start();
     if (srsran_ue_dl_decode_pdsch(&ue_dl, &sf_cfg_dl, &ue_dl_cfg.cfg.pdsch, pdsch_dec)) {
       Error("ERROR: Decoding PDSCH");
     }
+    srsran::get_stage_histogram(srsran::tti_stage::pdsch)(meas.stop());
+    uint64_t fec_ns = srsran_sch_last_decode_time_ns(&ue_dl.pdsch.dl_sch);
+    if (fec_ns > 0) {
+      srsran::get_stage_histogram(srsran::tti_stage::fec)(std::chrono::nanoseconds(fec_ns));
+    }
   }
 
   // Generate ACKs for MAC and PUCCH
@@ -597,21 +666,55 @@ void cc_worker::update_measurements(std::vector<phy_meas_t>& serving_cells, cf_t
  *
  */
 
-bool cc_worker::work_ul(srsran_uci_data_t* uci_data)
+void cc_worker::set_ul_early_nolock(bool enable)
 {
-  bool signal_ready;
+  // A preparation whose work_ul() was not called must be finished before the worker is reused
+  wait_prepare_ul();
+  ul_early = enable and phy->args->ul_early_encode;
+}
 
-  srsran_dci_ul_t                       dci_ul       = {};
-  mac_interface_phy_lte::mac_grant_ul_t ul_mac_grant = {};
-  mac_interface_phy_lte::tb_action_ul_t ul_action    = {};
-  uint32_t                              pid          = 0;
+void cc_worker::start_prepare_ul()
+{
+  ul_prep_started = true;
+  if (phy->cb_decoder_pool == nullptr) {
+    prepare_ul(true);
+    ul_prep_finished = true;
+    return;
+  }
 
-  if (!cell_initiated) {
-    logger.warning("Trying to access cc_worker=%d while cell not initialized (UL)", cc_idx);
-    return false;
+  ul_prep_finished = false;
+  phy->cb_decoder_pool->push_task([this]() {
+    prepare_ul(true);
+    std::lock_guard<std::mutex> lock(ul_prep_mutex);
+    ul_prep_finished = true;
+    ul_prep_cvar.notify_one();
+  });
+}
+
+void cc_worker::wait_prepare_ul()
+{
+  if (not ul_prep_started) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(ul_prep_mutex);
+  while (not ul_prep_finished) {
+    ul_prep_cvar.wait(lock);
   }
+  ul_prep_started = false;
+}
 
-  bool ul_grant_available = phy->get_ul_pending_grant(&sf_cfg_ul, cc_idx, &pid, &dci_ul);
+void cc_worker::prepare_ul(bool pre_encode)
+{
+  srsran_dci_ul_t&                       dci_ul             = ul_prep.dci_ul;
+  mac_interface_phy_lte::mac_grant_ul_t& ul_mac_grant       = ul_prep.ul_mac_grant;
+  mac_interface_phy_lte::tb_action_ul_t& ul_action          = ul_prep.ul_action;
+  uint32_t&                              pid                = ul_prep.pid;
+  bool&                                  ul_grant_available = ul_prep.ul_grant_available;
+
+  ul_prep                               = {};
+  ue_ul_cfg.ul_cfg.pusch.tb_pre_encoded = false;
+
+  ul_grant_available = phy->get_ul_pending_grant(&sf_cfg_ul, cc_idx, &pid, &dci_ul);
   ul_mac_grant.phich_available =
       phy->get_ul_received_ack(&sf_cfg_ul, cc_idx, &ul_mac_grant.hi_value, ul_grant_available ? nullptr : &dci_ul);
 
@@ -620,14 +723,6 @@ bool cc_worker::work_ul(srsran_uci_data_t* uci_data)
     pid = phy->ul_pidof(CURRENT_TTI_TX, &sf_cfg_ul.tdd_config);
   }
 
-  /*
-   * Generate aperiodic CQI report if required, note that in case both aperiodic and periodic ones present, only
-   * aperiodic is sent (36.213 section 7.2)
-   */
-  if (ul_grant_available and dci_ul.cqi_request and uci_data != nullptr) {
-    set_uci_aperiodic_cqi(uci_data);
-  }
-
   /* Send UL dci or HARQ information (from PHICH) to MAC and receive actions*/
   if (ul_grant_available || ul_mac_grant.phich_available) {
     // Read last TB info from last retx for this PID
@@ -659,6 +754,44 @@ bool cc_worker::work_ul(srsran_uci_data_t* uci_data)
     }
   }
 
+  // The code blocks do not depend on the UCI, so they can be encoded before the ACKs of this subframe are known
+  if (pre_encode and ul_action.tb.enabled and ul_action.tb.payload != nullptr) {
+    srsran::scoped_stage_prof prof(srsran::tti_stage::pusch);
+    ue_ul_cfg.ul_cfg.pusch.softbuffers.tx = ul_action.tb.softbuffer.tx;
+    if (srsran_ulsch_pre_encode(&ue_ul.pusch.ul_sch, &ue_ul_cfg.ul_cfg.pusch, ul_action.tb.payload)) {
+      Error("Encoding UL code blocks cc=%d", cc_idx);
+    }
+  }
+}
+
+bool cc_worker::work_ul(srsran_uci_data_t* uci_data)
+{
+  bool signal_ready;
+
+  if (!cell_initiated) {
+    logger.warning("Trying to access cc_worker=%d while cell not initialized (UL)", cc_idx);
+    return false;
+  }
+
+  // Process the UL grant, unless it was already started right after the PDCCH decoding
+  if (ul_prep_started) {
+    wait_prepare_ul();
+  } else {
+    prepare_ul(false);
+  }
+  srsran_dci_ul_t&                       dci_ul             = ul_prep.dci_ul;
+  mac_interface_phy_lte::mac_grant_ul_t& ul_mac_grant       = ul_prep.ul_mac_grant;
+  mac_interface_phy_lte::tb_action_ul_t& ul_action          = ul_prep.ul_action;
+  bool                                   ul_grant_available = ul_prep.ul_grant_available;
+
+  /*
+   * Generate aperiodic CQI report if required, note that in case both aperiodic and periodic ones present, only
+   * aperiodic is sent (36.213 section 7.2)
+   */
+  if (ul_grant_available and dci_ul.cqi_request and uci_data != nullptr) {
+    set_uci_aperiodic_cqi(uci_data);
+  }
+
   // Set UL RNTI
   if (ul_grant_available || ul_mac_grant.phich_available) {
     ue_ul_cfg.ul_cfg.pusch.rnti = dci_ul.rnti;
@@ -716,6 +849,8 @@ void cc_worker::ul_phy_to_mac_grant(srsran_pusch_grant_t*
 
 int cc_worker::decode_pdcch_ul()
 {
+  srsran::scoped_stage_prof prof(srsran::tti_stage::pdcch);
+
   int nof_grants = 0;
 
   srsran_dci_ul_t dci[SRSRAN_MAX_CARRIERS];
@@ -735,6 +870,11 @@ int cc_worker::decode_pdcch_ul()
       }
     }
 
+    if (nof_grants > 0) {
+      phy->drx.new_pdcch(CURRENT_TTI);
+      phy->drx.new_ul_grant();
+    }
+
     /* Convert every DCI message to UL dci */
     for (int k = 0; k < nof_grants; k++) {
       // If the DCI does not have Carrier Indicator Field then indicate in which carrier the dci was found
@@ -791,7 +931,10 @@ bool cc_worker::encode_uplink(mac_interface_phy_lte::tb_action_ul_t* action, srs
   }
 
   // Encode signal
+  srsran::tprof_measure meas;
+  meas.start();
   int ret = srsran_ue_ul_encode(&ue_ul, &sf_cfg_ul, &ue_ul_cfg, &data);
+  srsran::get_stage_histogram(srsran::tti_stage::pusch)(meas.stop());
   if (ret < 0) {
     Error("Encoding UL cc=%d", cc_idx);
   }
@@ -821,6 +964,7 @@ void cc_worker::set_uci_sr(srsran_uci_data_t* uci_data)
   if (srsran_ue_ul_gen_sr(&ue_ul_cfg, &sf_cfg_ul, uci_data, phy->sr.is_triggered())) {
     if (phy->sr.set_last_tx_tti(CURRENT_TTI_TX)) {
       Debug("set_uci_sr() sending SR: sr_enabled=true, last_tx_tti=%d", CURRENT_TTI_TX);
+      phy->drx.sr_transmitted();
     }
   }
 }
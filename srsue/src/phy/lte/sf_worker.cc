@@ -23,6 +23,7 @@
 
 #include "srsran/common/standard_streams.h"
 #include "srsue/hdr/phy/lte/sf_worker.h"
+#include <chrono>
 #include <string.h>
 
 #define Error(fmt, ...)                                                                                                \
@@ -134,6 +135,11 @@ void sf_worker::set_cfo_nolock(const uint32_t& cc_idx, float cfo)
   cc_workers[cc_idx]->set_cfo_nolock(cfo);
 }
 
+void sf_worker::set_rx_cfo_nolock(const uint32_t& cc_idx, float cfo_hz)
+{
+  cc_workers[cc_idx]->set_rx_cfo_nolock(cfo_hz);
+}
+
 void sf_worker::set_tdd_config_nolock(srsran_tdd_config_t config)
 {
   for (auto& cc_worker : cc_workers) {
@@ -168,31 +174,53 @@ void sf_worker::work_imp()
   bool     tx_signal_ready = false;
   uint32_t nof_samples     = SRSRAN_SF_LEN_PRB(cell.nof_prb);
 
+  // The UL of the carriers is prepared during the DL processing if they transmit in TTI_TX
+  bool ul_tti =
+      (srsran_sfidx_tdd_type(tdd_config, TTI_TX(tti) % 10) == SRSRAN_TDD_SF_U) || cell.frame_type == SRSRAN_FDD;
+  for (uint32_t carrier_idx = 0; carrier_idx < cc_workers.size(); carrier_idx++) {
+    cc_workers[carrier_idx]->set_ul_early_nolock(ul_tti and !prach_ptr and carrier_idx < phy->args->nof_lte_carriers and
+                                                 phy->cell_state.is_active(carrier_idx, tti));
+  }
+
   /***** Downlink Processing *******/
 
+  // Outside of the DRX Active Time the DL of all the carriers is skipped, the sync keeps tracking the PCell
+  bool dl_sf     = srsran_sfidx_tdd_type(tdd_config, tti % 10) != SRSRAN_TDD_SF_U || cell.frame_type == SRSRAN_FDD;
+  bool drx_en    = dl_sf and phy->drx.is_enabled();
+  bool drx_sleep = drx_en and not phy->is_drx_active_time(tti);
+  bool dl_done   = false;
+  auto dl_start  = std::chrono::steady_clock::now();
+
   // Loop through all carriers. carrier_idx=0 is PCell
   for (uint32_t carrier_idx = 0; carrier_idx < cc_workers.size(); carrier_idx++) {
     // Process all DL and special subframes
-    if (srsran_sfidx_tdd_type(tdd_config, tti % 10) != SRSRAN_TDD_SF_U || cell.frame_type == SRSRAN_FDD) {
+    if (dl_sf) {
       srsran_mbsfn_cfg_t mbsfn_cfg;
       ZERO_OBJECT(mbsfn_cfg);
 
       if (carrier_idx == 0 && phy->is_mbsfn_sf(&mbsfn_cfg, tti)) {
         rx_signal_ok =
             cc_workers[0]->work_dl_mbsfn(mbsfn_cfg); // Don't do chest_ok in mbsfn since it trigger measurements
+        dl_done = true;
       } else {
-        if (phy->cell_state.is_configured(carrier_idx)) {
+        if (phy->cell_state.is_configured(carrier_idx) and not drx_sleep) {
           rx_signal_ok = cc_workers[carrier_idx]->work_dl_regular();
+          dl_done      = true;
         }
       }
     }
   }
+
+  if (drx_en) {
+    auto dl_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - dl_start);
+    phy->drx.count_sf(dl_done, (uint32_t)dl_us.count());
+  }
   tx_signal_ptr.set_nof_samples(nof_samples);
 
   /***** Uplink Generation + Transmission *******/
 
   /* If TTI+4 is an uplink subframe (TODO: Support short PRACH and SRS in UpPts special subframes) */
-  if ((srsran_sfidx_tdd_type(tdd_config, TTI_TX(tti) % 10) == SRSRAN_TDD_SF_U) || cell.frame_type == SRSRAN_FDD) {
+  if (ul_tti) {
     // Generate Uplink signal if no PRACH pending
     if (!prach_ptr) {
       // Common UCI data object for all carriers
@@ -0,0 +1,390 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsue/hdr/phy/multi_ue_radio.h"
+#include "srsran/common/standard_streams.h"
+#include "srsran/phy/utils/vector.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+
+namespace srsue {
+
+/// Length of the rings in milliseconds
+static const uint32_t ring_len_ms = 100;
+
+multi_ue_radio::multi_ue_radio(uint32_t nof_ues) :
+  logger(srslog::fetch_basic_logger("RF", false)), radio(new srsran::radio)
+{
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    ports.emplace_back(new port(*this, i));
+  }
+}
+
+multi_ue_radio::~multi_ue_radio()
+{
+  // Free the ports before the radio they use
+  ports.clear();
+  radio.reset();
+}
+
+multi_ue_radio::port::~port()
+{
+  for (srsran_resampler_fft_t& q : decimators) {
+    srsran_resampler_fft_free(&q);
+  }
+  for (srsran_resampler_fft_t& q : interpolators) {
+    srsran_resampler_fft_free(&q);
+  }
+}
+
+int multi_ue_radio::init(const srsran::rf_args_t& args_, srsran::phy_interface_radio* phy_)
+{
+  // The radio has to run at a fixed rate, each port converts it to the rate of its UE
+  if (not std::isnormal(args_.srate_hz)) {
+    srsran::console("Error: the shared radio of several UEs requires a fixed RF sampling rate (rf.srate).\n");
+    return SRSRAN_ERROR;
+  }
+
+  srate        = args_.srate_hz;
+  nof_channels = args_.nof_carriers * args_.nof_antennas;
+  sf_len       = static_cast<uint32_t>(srate / 1000);
+  ring_len     = sf_len * ring_len_ms;
+  for (uint32_t ch = 0; ch < nof_channels; ch++) {
+    rx_ring[ch].assign(ring_len, 0);
+    tx_ring[ch].assign(ring_len, 0);
+  }
+
+  if (radio->init(args_, this) != SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  radio->set_rx_srate(srate);
+  radio->set_tx_srate(srate);
+
+  logger.info("Shared radio for %zd UEs at %.2f MHz", ports.size(), srate / 1e6);
+  return SRSRAN_SUCCESS;
+}
+
+void multi_ue_radio::stop()
+{
+  radio->stop();
+}
+
+bool multi_ue_radio::get_metrics(srsran::rf_metrics_t* metrics)
+{
+  return radio->get_metrics(metrics);
+}
+
+void multi_ue_radio::radio_overflow()
+{
+  for (std::unique_ptr<port>& p : ports) {
+    if (p->phy != nullptr) {
+      p->phy->radio_overflow();
+    }
+  }
+}
+
+void multi_ue_radio::radio_failure()
+{
+  for (std::unique_ptr<port>& p : ports) {
+    if (p->phy != nullptr) {
+      p->phy->radio_failure();
+    }
+  }
+}
+
+void multi_ue_radio::set_phy(uint32_t ue_idx, srsran::phy_interface_radio* phy_)
+{
+  if (ue_idx < ports.size()) {
+    ports[ue_idx]->phy = phy_;
+  }
+}
+
+srsran::radio_interface_phy* multi_ue_radio::get_port(uint32_t ue_idx)
+{
+  return ue_idx < ports.size() ? ports[ue_idx].get() : nullptr;
+}
+
+uint32_t multi_ue_radio::get_ratio(double port_srate, double base_srate)
+{
+  if (not std::isnormal(port_srate) or port_srate > base_srate) {
+    return 0;
+  }
+  double   ratio   = base_srate / port_srate;
+  uint32_t n_ratio = static_cast<uint32_t>(std::round(ratio));
+  return std::abs(ratio - n_ratio) < 1e-6 ? n_ratio : 0;
+}
+
+void multi_ue_radio::port::set_rx_srate(const double& srate_)
+{
+  uint32_t ratio = get_ratio(srate_, parent.srate);
+  if (ratio == 0) {
+    parent.logger.error("UE %d: RX sampling rate %.2f MHz is not an integer fraction of %.2f MHz",
+                        idx,
+                        srate_ / 1e6,
+                        parent.srate / 1e6);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(parent.rx_mutex);
+  rx_ratio = ratio;
+  for (uint32_t ch = 0; ch < parent.nof_channels and ratio > 1; ch++) {
+    srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+  }
+}
+
+void multi_ue_radio::port::set_tx_srate(const double& srate_)
+{
+  uint32_t ratio = get_ratio(srate_, parent.srate);
+  if (ratio == 0) {
+    parent.logger.error("UE %d: TX sampling rate %.2f MHz is not an integer fraction of %.2f MHz",
+                        idx,
+                        srate_ / 1e6,
+                        parent.srate / 1e6);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(parent.tx_mutex);
+  tx_ratio = ratio;
+  for (uint32_t ch = 0; ch < parent.nof_channels and ratio > 1; ch++) {
+    srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+  }
+}
+
+bool multi_ue_radio::rx(port& p, srsran::rf_buffer_interface& buffer, srsran::rf_timestamp_interface& rxd_time)
+{
+  std::lock_guard<std::mutex> lock(rx_mutex);
+
+  uint32_t nof_samples = buffer.get_nof_samples() * p.rx_ratio;
+  if (nof_samples > ring_len / 2) {
+    logger.error("UE %d: cannot receive %d samples at once, the ring holds %d", p.idx, nof_samples, ring_len);
+    return false;
+  }
+
+  if (not p.rx_started) {
+    p.rx_pos     = rx_head;
+    p.rx_started = true;
+  } else if (p.rx_pos + ring_len < rx_head) {
+    // The samples of this port have already been overwritten, continue from the newest ones
+    logger.warning("UE %d: lost %" PRIu64 " RX samples", p.idx, rx_head - p.rx_pos);
+    p.rx_pos = rx_head;
+    if (p.phy != nullptr) {
+      p.phy->radio_overflow();
+    }
+  }
+
+  // Read from the radio the samples that no port has received yet
+  while (rx_head < p.rx_pos + nof_samples) {
+    if (not fetch_rx(p.rx_pos + nof_samples - rx_head)) {
+      return false;
+    }
+  }
+
+  uint32_t offset = p.rx_pos % ring_len;
+  uint32_t len1   = std::min(nof_samples, ring_len - offset);
+  for (uint32_t ch = 0; ch < nof_channels; ch++) {
+    cf_t* dst = buffer.get(ch);
+    if (dst == nullptr) {
+      continue;
+    }
+    cf_t* out = dst;
+    if (p.rx_ratio > 1) {
+      if (p.rx_tmp[ch].size() < nof_samples) {
+        p.rx_tmp[ch].resize(nof_samples);
+      }
+      out = p.rx_tmp[ch].data();
+    }
+    srsran_vec_cf_copy(out, &rx_ring[ch][offset], len1);
+    srsran_vec_cf_copy(out + len1, rx_ring[ch].data(), nof_samples - len1);
+    if (p.rx_ratio > 1) {
+      srsran_resampler_fft_run(&p.decimators[ch], out, dst, nof_samples);
+    }
+  }
+
+  // Time of the first sample given to the port
+  for (uint32_t i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
+    *rxd_time.get_ptr(i) = rx_head_time.get(i);
+  }
+  rxd_time.sub(static_cast<double>(rx_head - p.rx_pos) / srate);
+
+  p.rx_pos += nof_samples;
+  return true;
+}
+
+bool multi_ue_radio::fetch_rx(uint64_t nof_samples)
+{
+  uint32_t offset = rx_head % ring_len;
+  uint32_t len    = static_cast<uint32_t>(std::min<uint64_t>(nof_samples, ring_len - offset));
+
+  cf_t* ptr[SRSRAN_MAX_CHANNELS] = {};
+  for (uint32_t ch = 0; ch < nof_channels; ch++) {
+    ptr[ch] = &rx_ring[ch][offset];
+  }
+  srsran::rf_buffer_t    rx_buffer(ptr, len);
+  srsran::rf_timestamp_t rx_time;
+  if (not radio->rx_now(rx_buffer, rx_time)) {
+    return false;
+  }
+
+  rx_head += len;
+  for (uint32_t i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
+    *rx_head_time.get_ptr(i) = rx_time.get(i);
+  }
+  rx_head_time.add(static_cast<double>(len) / srate);
+  return true;
+}
+
+bool multi_ue_radio::tx(port& p, srsran::rf_buffer_interface& buffer, const srsran::rf_timestamp_interface& tx_time)
+{
+  std::lock_guard<std::mutex> lock(tx_mutex);
+
+  uint32_t nof_samples = buffer.get_nof_samples() * p.tx_ratio;
+  if (nof_samples > ring_len / 4) {
+    logger.error("UE %d: cannot transmit %d samples at once, the ring holds %d", p.idx, nof_samples, ring_len);
+    return false;
+  }
+
+  uint64_t start = srsran_timestamp_uint64(&tx_time.get(0), srate);
+  uint64_t end   = start + nof_samples;
+  if (not tx_started) {
+    tx_base    = start;
+    tx_started = true;
+  }
+  tx_ref_pos = start;
+  for (uint32_t i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
+    *tx_ref_time.get_ptr(i) = tx_time.get(i);
+  }
+
+  if (end <= tx_base) {
+    logger.warning("UE %d: dropped %d late TX samples", p.idx, nof_samples);
+    return true;
+  }
+
+  // A port far ahead of the others sends the samples they have not written yet
+  if (end > tx_base + ring_len) {
+    flush_tx(end - ring_len);
+  }
+
+  uint32_t skip   = start < tx_base ? static_cast<uint32_t>(tx_base - start) : 0;
+  uint32_t len    = nof_samples - skip;
+  uint32_t offset = (start + skip) % ring_len;
+  uint32_t len1   = std::min(len, ring_len - offset);
+  for (uint32_t ch = 0; ch < nof_channels; ch++) {
+    cf_t* src = buffer.get(ch);
+    if (src == nullptr) {
+      continue;
+    }
+    if (p.tx_ratio > 1) {
+      if (p.tx_tmp[ch].size() < nof_samples) {
+        p.tx_tmp[ch].resize(nof_samples);
+      }
+      srsran_resampler_fft_run(&p.interpolators[ch], src, p.tx_tmp[ch].data(), buffer.get_nof_samples());
+      src = p.tx_tmp[ch].data();
+    }
+    src += skip;
+    srsran_vec_sum_ccc(&tx_ring[ch][offset], src, &tx_ring[ch][offset], len1);
+    srsran_vec_sum_ccc(tx_ring[ch].data(), src + len1, tx_ring[ch].data(), len - len1);
+  }
+
+  p.tx_active  = true;
+  p.tx_end_pos = std::max(p.tx_end_pos, end);
+  return flush_tx_ready();
+}
+
+void multi_ue_radio::tx_end(port& p)
+{
+  std::lock_guard<std::mutex> lock(tx_mutex);
+
+  p.tx_active = false;
+
+  bool     any_active = false;
+  uint64_t end        = tx_base;
+  for (std::unique_ptr<port>& q : ports) {
+    any_active |= q->tx_active;
+    end = std::max(end, q->tx_end_pos);
+  }
+
+  if (any_active) {
+    flush_tx_ready();
+    return;
+  }
+
+  // Nobody is transmitting, send everything and end the burst
+  flush_tx(end);
+  radio->tx_end();
+}
+
+bool multi_ue_radio::flush_tx_ready()
+{
+  uint64_t newest = 0;
+  for (std::unique_ptr<port>& p : ports) {
+    if (p->tx_active) {
+      newest = std::max(newest, p->tx_end_pos);
+    }
+  }
+
+  // Send up to the end of the port that is most behind, ignoring the ports that stopped transmitting
+  uint64_t end = newest;
+  for (std::unique_ptr<port>& p : ports) {
+    if (not p->tx_active) {
+      continue;
+    }
+    if (p->tx_end_pos + ring_len / 4 < newest) {
+      logger.info("UE %d: TX stalled, the other UEs do not wait for it", p->idx);
+      p->tx_active = false;
+      continue;
+    }
+    end = std::min(end, p->tx_end_pos);
+  }
+
+  return flush_tx(end);
+}
+
+bool multi_ue_radio::flush_tx(uint64_t end)
+{
+  bool ret = true;
+  while (tx_base < end) {
+    uint32_t offset = tx_base % ring_len;
+    uint32_t len    = static_cast<uint32_t>(std::min<uint64_t>({end - tx_base, ring_len - offset, sf_len}));
+
+    cf_t* ptr[SRSRAN_MAX_CHANNELS] = {};
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      ptr[ch] = &tx_ring[ch][offset];
+    }
+    srsran::rf_buffer_t    tx_buffer(ptr, len);
+    srsran::rf_timestamp_t tx_time(tx_ref_time);
+    if (tx_base >= tx_ref_pos) {
+      tx_time.add(static_cast<double>(tx_base - tx_ref_pos) / srate);
+    } else {
+      tx_time.sub(static_cast<double>(tx_ref_pos - tx_base) / srate);
+    }
+    ret &= radio->tx(tx_buffer, tx_time);
+
+    // The ring is added to, so the sent samples are cleared for the next round
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      srsran_vec_cf_zero(&tx_ring[ch][offset], len);
+    }
+    tx_base += len;
+  }
+  return ret;
+}
+
+} // namespace srsue
@@ -24,13 +24,39 @@
 #include "srsran/common/buffer_pool.h"
 #include "srsran/radio/rf_buffer.h"
 #include "srsran/radio/rf_timestamp.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 
 namespace srsue {
 namespace nr {
+
+/// Minimum SSB SNR to consider the cell as found
+static const float cell_search_min_snr_dB = -10.0f;
+
+static srsran_ssb_cfg_t make_ssb_cfg(const cell_search::cfg_t& cfg, double ssb_freq_hz)
+{
+  srsran_ssb_cfg_t ssb_cfg = {};
+  ssb_cfg.srate_hz         = cfg.srate_hz;
+  ssb_cfg.center_freq_hz   = cfg.center_freq_hz;
+  ssb_cfg.ssb_freq_hz      = ssb_freq_hz;
+  ssb_cfg.scs              = cfg.ssb_scs;
+  ssb_cfg.pattern          = cfg.ssb_pattern;
+  ssb_cfg.duplex_mode      = cfg.duplex_mode;
+  return ssb_cfg;
+}
+
 cell_search::cell_search(srslog::basic_logger& logger_) : logger(logger_) {}
 
 cell_search::~cell_search()
 {
+  // Stop the wideband search threads before releasing their SSB objects
+  if (wb_pool != nullptr) {
+    wb_pool->stop();
+  }
+  for (wideband_task_t& task : wb_tasks) {
+    srsran_ssb_free(&task.ssb);
+  }
   srsran_ssb_free(&ssb);
 }
 
@@ -49,19 +75,25 @@ bool cell_search::init(const args_t& args)
     return false;
   }
 
+  // Initialise an SSB for every thread taking part in the wideband search, the calling thread included
+  wb_tasks.resize(args.nof_wideband_threads + 1);
+  for (wideband_task_t& task : wb_tasks) {
+    if (srsran_ssb_init(&task.ssb, &ssb_args) < SRSRAN_SUCCESS) {
+      logger.error("Cell search: Error initiating wideband SSB");
+      return false;
+    }
+  }
+  if (args.nof_wideband_threads > 0) {
+    wb_pool.reset(new srsran::task_thread_pool(args.nof_wideband_threads));
+  }
+
   return true;
 }
 
 bool cell_search::start(const cfg_t& cfg)
 {
-  // Prepare SSB configuration
-  srsran_ssb_cfg_t ssb_cfg = {};
-  ssb_cfg.srate_hz         = cfg.srate_hz;
-  ssb_cfg.center_freq_hz   = cfg.center_freq_hz;
-  ssb_cfg.ssb_freq_hz      = cfg.ssb_freq_hz;
-  ssb_cfg.scs              = cfg.ssb_scs;
-  ssb_cfg.pattern          = cfg.ssb_pattern;
-  ssb_cfg.duplex_mode      = cfg.duplex_mode;
+  // Prepare SSB configuration, the wideband search correlates all the candidates with the SSB centered in base-band
+  srsran_ssb_cfg_t ssb_cfg = make_ssb_cfg(cfg, cfg.ssb_freq_list.empty() ? cfg.ssb_freq_hz : cfg.center_freq_hz);
 
   // Print SSB configuration, helps debugging gNb and UE
   if (logger.info.enabled()) {
@@ -75,6 +107,36 @@ bool cell_search::start(const cfg_t& cfg)
     logger.error("Cell search: Error setting SSB configuration");
     return false;
   }
+
+  cur_cfg = cfg;
+  if (not cfg.ssb_freq_list.empty()) {
+    return start_wideband(cfg);
+  }
+  return true;
+}
+
+bool cell_search::start_wideband(const cfg_t& cfg)
+{
+  // Keep the candidates that fit in the base-band and whose offset from DC is a multiple of the subcarrier spacing
+  double scs_hz        = SRSRAN_SUBC_SPACING_NR(cfg.ssb_scs);
+  double max_offset_hz = (cfg.srate_hz - SRSRAN_SSB_BW_SUBC * scs_hz) / 2.0;
+  wb_cand.clear();
+  for (double ssb_freq_hz : cfg.ssb_freq_list) {
+    double offset_hz = ssb_freq_hz - cfg.center_freq_hz;
+    if (std::abs(offset_hz) > max_offset_hz or std::abs(std::remainder(offset_hz, scs_hz)) > 1.0) {
+      logger.debug("Cell search: Skipping SSB frequency %.2f MHz", ssb_freq_hz / 1e6);
+      continue;
+    }
+    srsran_ssb_pss_res_t cand = {};
+    cand.ssb_freq_hz          = ssb_freq_hz;
+    wb_cand.push_back(cand);
+  }
+  wb_order.resize(wb_cand.size());
+
+  logger.info("Cell search: Searching %d SSB frequencies around %.2f MHz with %d threads",
+              (uint32_t)wb_cand.size(),
+              cfg.center_freq_hz / 1e6,
+              (uint32_t)wb_tasks.size());
   return true;
 }
 
@@ -82,18 +144,113 @@ cell_search::ret_t cell_search::run_slot(const cf_t* buffer, uint32_t slot_sz)
 {
   cell_search::ret_t ret = {};
 
+  // Search all the SSB frequencies in the base-band
+  if (not cur_cfg.ssb_freq_list.empty()) {
+    return run_slot_wideband(buffer, slot_sz + ssb.ssb_sz);
+  }
+
   // Search for SSB
   if (srsran_ssb_search(&ssb, buffer, slot_sz + ssb.ssb_sz, &ret.ssb_res) < SRSRAN_SUCCESS) {
     logger.error("Error occurred searching SSB");
     ret.result = ret_t::ERROR;
-  } else if (ret.ssb_res.measurements.snr_dB >= -10.0f and ret.ssb_res.pbch_msg.crc) {
+  } else if (ret.ssb_res.measurements.snr_dB >= cell_search_min_snr_dB and ret.ssb_res.pbch_msg.crc) {
     // Consider the SSB is found and decoded if the PBCH CRC matched
-    ret.result = ret_t::CELL_FOUND;
+    ret.result      = ret_t::CELL_FOUND;
+    ret.ssb_freq_hz = cur_cfg.ssb_freq_hz;
   } else {
     ret.result = ret_t::CELL_NOT_FOUND;
   }
   return ret;
 }
 
+cell_search::ret_t cell_search::run_slot_wideband(const cf_t* buffer, uint32_t nof_samples)
+{
+  cell_search::ret_t ret = {};
+  ret.result             = ret_t::CELL_NOT_FOUND;
+  if (wb_cand.empty()) {
+    return ret;
+  }
+  wb_buffer      = buffer;
+  wb_nof_samples = nof_samples;
+
+  // Phase 1: correlates the PSS of all the candidates at once, splitting them among the threads
+  uint32_t nof_cand_per_task = ((uint32_t)wb_cand.size() + wb_tasks.size() - 1) / wb_tasks.size();
+  uint32_t nof_tasks         = ((uint32_t)wb_cand.size() + nof_cand_per_task - 1) / nof_cand_per_task;
+  for (uint32_t i = 0; i < nof_tasks; ++i) {
+    wb_tasks[i].cand_idx = i * nof_cand_per_task;
+    wb_tasks[i].nof_cand = std::min(nof_cand_per_task, (uint32_t)wb_cand.size() - wb_tasks[i].cand_idx);
+  }
+  run_wideband_tasks(nof_tasks);
+  for (uint32_t i = 0; i < nof_tasks; ++i) {
+    if (wb_tasks[i].task_ret < SRSRAN_SUCCESS) {
+      logger.error("Error occurred correlating SSB candidates");
+      ret.result = ret_t::ERROR;
+      return ret;
+    }
+  }
+
+  // Phase 2: decodes the PBCH of the strongest candidates, one per thread
+  nof_tasks = std::min((uint32_t)wb_tasks.size(), (uint32_t)wb_cand.size());
+  std::iota(wb_order.begin(), wb_order.end(), 0);
+  std::partial_sort(wb_order.begin(), wb_order.begin() + nof_tasks, wb_order.end(), [this](uint32_t a, uint32_t b) {
+    return wb_cand[a].corr > wb_cand[b].corr;
+  });
+  for (uint32_t i = 0; i < nof_tasks; ++i) {
+    wb_tasks[i].cand_idx = wb_order[i];
+    wb_tasks[i].nof_cand = 0;
+  }
+  run_wideband_tasks(nof_tasks);
+
+  // Select the decoded SSB with the best SNR
+  for (uint32_t i = 0; i < nof_tasks; ++i) {
+    const wideband_task_t& task = wb_tasks[i];
+    if (task.task_ret < SRSRAN_SUCCESS) {
+      logger.error("Error occurred searching SSB at %.2f MHz", wb_cand[task.cand_idx].ssb_freq_hz / 1e6);
+      continue;
+    }
+    if (not task.ssb_res.pbch_msg.crc or task.ssb_res.measurements.snr_dB < cell_search_min_snr_dB) {
+      continue;
+    }
+    if (ret.result != ret_t::CELL_FOUND or task.ssb_res.measurements.snr_dB > ret.ssb_res.measurements.snr_dB) {
+      ret.result      = ret_t::CELL_FOUND;
+      ret.ssb_res     = task.ssb_res;
+      ret.ssb_freq_hz = wb_cand[task.cand_idx].ssb_freq_hz;
+    }
+  }
+  return ret;
+}
+
+void cell_search::run_wideband_tasks(uint32_t nof_tasks)
+{
+  if (wb_pool != nullptr and nof_tasks > 1) {
+    wb_pool->parallel_for(nof_tasks, run_wideband_task, this);
+  } else {
+    for (uint32_t i = 0; i < nof_tasks; ++i) {
+      run_wideband_task(this, i);
+    }
+  }
+}
+
+void cell_search::run_wideband_task(void* arg, uint32_t task_idx)
+{
+  cell_search*     cs   = static_cast<cell_search*>(arg);
+  wideband_task_t& task = cs->wb_tasks[task_idx];
+
+  // Correlation tasks use the SSB centered in the base-band, decoding tasks the SSB of their candidate
+  double ssb_freq_hz = (task.nof_cand > 0) ? cs->cur_cfg.center_freq_hz : cs->wb_cand[task.cand_idx].ssb_freq_hz;
+  srsran_ssb_cfg_t ssb_cfg = make_ssb_cfg(cs->cur_cfg, ssb_freq_hz);
+  task.task_ret            = srsran_ssb_set_cfg(&task.ssb, &ssb_cfg);
+  if (task.task_ret < SRSRAN_SUCCESS) {
+    return;
+  }
+
+  if (task.nof_cand > 0) {
+    task.task_ret = srsran_ssb_pss_search_multi(
+        &task.ssb, cs->wb_buffer, cs->wb_nof_samples, &cs->wb_cand[task.cand_idx], task.nof_cand);
+  } else {
+    task.task_ret = srsran_ssb_search(&task.ssb, cs->wb_buffer, cs->wb_nof_samples, &task.ssb_res);
+  }
+}
+
 } // namespace nr
 } // namespace srsue
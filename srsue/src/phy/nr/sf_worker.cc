@@ -86,13 +86,16 @@ void sf_worker::work_imp()
   srsran::rf_buffer_t tx_buffer = {};
 
   // Perform DL processing
+  time_point dl_start = std::chrono::steady_clock::now();
   for (auto& w : cc_workers) {
     w->work_dl();
   }
+  time_point dl_end = std::chrono::steady_clock::now();
 
   // Align workers, wait for previous workers to finish DL processing before starting UL processing
   phy_state.dl_ul_semaphore.wait(this);
   phy_state.dl_ul_semaphore.release();
+  time_point ul_start = std::chrono::steady_clock::now();
 
   // Check if PRACH is available
   if (prach_ptr != nullptr) {
@@ -102,6 +105,7 @@ void sf_worker::work_imp()
 
     // Transmit NR PRACH
     common.worker_end(context, true, tx_buffer);
+    set_stage_metrics(dl_start, dl_end, ul_start, ul_start);
 
     // Reset PRACH pointer
     prach_ptr = nullptr;
@@ -113,6 +117,7 @@ void sf_worker::work_imp()
   for (auto& w : cc_workers) {
     w.get()->work_ul();
   }
+  time_point ul_end = std::chrono::steady_clock::now();
 
   // Set Tx buffers
   for (uint32_t i = 0; i < (uint32_t)cc_workers.size(); i++) {
@@ -122,6 +127,7 @@ void sf_worker::work_imp()
 
   // Always call worker_end before returning
   common.worker_end(context, true, tx_buffer);
+  set_stage_metrics(dl_start, dl_end, ul_start, ul_end);
 
   // Tell the plotting thread to draw the plots
 #ifdef ENABLE_GUI
@@ -131,6 +137,26 @@ void sf_worker::work_imp()
 #endif
 }
 
+void sf_worker::set_stage_metrics(time_point dl_start, time_point dl_end, time_point ul_start, time_point ul_end)
+{
+  auto us = [](time_point from, time_point to) {
+    return std::chrono::duration_cast<std::chrono::duration<float, std::micro> >(to - from).count();
+  };
+  time_point tx_end = std::chrono::steady_clock::now();
+
+  // Workers started without a reception time point have no RX queueing
+  time_point rx_start = (rx_tp == time_point{}) ? dl_start : rx_tp;
+
+  stage_metrics_t m = {};
+  m.rx_queue_us     = us(rx_start, dl_start);
+  m.dl_us           = us(dl_start, dl_end);
+  m.dl_ul_wait_us   = us(dl_end, ul_start);
+  m.ul_us           = us(ul_start, ul_end);
+  m.tx_us           = us(ul_end, tx_end);
+  m.max_slot_us     = us(rx_start, tx_end);
+  phy_state.set_stage_metrics(m);
+}
+
 int sf_worker::read_pdsch_d(cf_t* pdsch_d)
 {
   return cc_workers[0]->read_pdsch_d(pdsch_d);
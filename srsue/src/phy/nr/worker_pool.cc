@@ -91,7 +91,20 @@ void worker_pool::start_worker(sf_worker* w)
 sf_worker* worker_pool::wait_worker(uint32_t tti)
 {
   logger.set_context(tti);
-  sf_worker* worker = (sf_worker*)pool.wait_worker(tti);
+  return prepare_worker((sf_worker*)pool.wait_worker(tti), tti);
+}
+
+sf_worker* worker_pool::wait_worker_nb(uint32_t tti)
+{
+  logger.set_context(tti);
+  return prepare_worker((sf_worker*)pool.wait_worker_nb(tti), tti);
+}
+
+sf_worker* worker_pool::prepare_worker(sf_worker* worker, uint32_t tti)
+{
+  if (worker == nullptr) {
+    return nullptr;
+  }
 
   uint32_t pci = 0;
   {
@@ -295,6 +308,11 @@ void worker_pool::clear_pending_grants()
   phy_state.clear_pending_grants();
 }
 
+void worker_pool::add_dropped_slot()
+{
+  phy_state.add_dropped_slot();
+}
+
 void worker_pool::get_metrics(phy_metrics_t& m)
 {
   phy_state.get_metrics(m);
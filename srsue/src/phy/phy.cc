@@ -92,6 +92,10 @@ bool phy::check_args(const phy_args_t& args_)
     srsran::console("Error in PHY args: nof_phy_threads must be 1, 2 or 3\n");
     return false;
   }
+  if (args_.nof_cb_decoder_threads >= SRSRAN_MAX_CODEBLOCKS) {
+    srsran::console("Error in PHY args: nof_cb_decoder_threads must be lower than %d\n", SRSRAN_MAX_CODEBLOCKS);
+    return false;
+  }
   if (args_.snr_ema_coeff > 1.0) {
     srsran::console("Error in PHY args: snr_ema_coeff must be 0<=w<=1\n");
     return false;
@@ -141,6 +145,11 @@ void phy::run_thread()
   prach_buffer.init(SRSRAN_MAX_PRB);
   common.init(&args, radio, stack, &sfsync);
 
+  // The code block decoders must be running before the workers use them
+  if (args.nof_cb_decoder_threads > 0) {
+    common.cb_decoder_pool.reset(new srsran::task_thread_pool(args.nof_cb_decoder_threads, false, WORKERS_THREAD_PRIO));
+  }
+
   // Initialise workers
   lte_workers.init(&common, WORKERS_THREAD_PRIO);
 
@@ -174,6 +183,9 @@ void phy::stop()
   if (is_configured) {
     sfsync.stop();
     lte_workers.stop();
+    if (common.cb_decoder_pool != nullptr) {
+      common.cb_decoder_pool->stop();
+    }
     nr_workers.stop();
     prach_buffer.stop();
     wait_thread_finish();
@@ -204,6 +216,7 @@ void phy::get_metrics(const srsran::srsran_rat_t& rat, phy_metrics_t* m)
     common.get_dl_metrics(m->dl);
     common.get_ul_metrics(m->ul);
     common.get_sync_metrics(m->sync);
+    common.drx.get_metrics(m->drx);
     m->nof_active_cc = args.nof_lte_carriers;
     return;
   }
@@ -393,6 +406,7 @@ void phy::prach_send(uint32_t preamble_idx, int allowed_subframe, float target_p
 {
   common.ta.set_base_sec(ta_base_sec);
   common.reset_radio();
+  common.drx.ra_started();
   if (!prach_buffer.prepare_to_send(preamble_idx, allowed_subframe, target_power_dbm)) {
     Error("Preparing PRACH to send");
   }
@@ -448,6 +462,7 @@ int phy::sr_last_tx_tti()
 void phy::set_rar_grant(uint8_t grant_payload[SRSRAN_RAR_GRANT_LEN], uint16_t rnti)
 {
   common.set_rar_grant(grant_payload, rnti, tdd_config);
+  common.drx.ra_rar_received();
 }
 
 // Start GUI
@@ -488,6 +503,11 @@ bool phy::set_config(const srsran::phy_cfg_t& config_, uint32_t cc_idx)
     logger_phy.info("Setting new PHY configuration cc_idx=%d...", cc_idx);
     lte_workers.set_config(cc_idx, config_);
 
+    // The DRX is common to all the serving cells
+    if (!cc_idx) {
+      common.drx.set_config(config_.drx_cfg);
+    }
+
     // It is up to the PRACH component to detect whether the cell or the configuration have changed to reconfigure
     configure_prach_params();
     stack->set_config_complete(true);
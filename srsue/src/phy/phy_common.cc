@@ -22,6 +22,7 @@
 #include <sstream>
 #include <string.h>
 
+#include "srsran/interfaces/ue_interfaces.h"
 #include "srsran/srsran.h"
 #include "srsue/hdr/phy/phy_common.h"
 
@@ -42,7 +43,7 @@ namespace srsue {
 
 static srsran::rf_buffer_t zeros_multi(1);
 
-phy_common::phy_common(srslog::basic_logger& logger) : logger(logger), ta(logger)
+phy_common::phy_common(srslog::basic_logger& logger) : logger(logger), ta(logger), drx(logger)
 {
   reset();
 }
@@ -77,7 +78,8 @@ void phy_common::init(phy_args_t*                  _args,
 
 void phy_common::set_ue_dl_cfg(srsran_ue_dl_cfg_t* ue_dl_cfg)
 {
-  ue_dl_cfg->snr_to_cqi_offset = args->snr_to_cqi_offset;
+  ue_dl_cfg->snr_to_cqi_offset     = args->snr_to_cqi_offset;
+  ue_dl_cfg->pdcch_prescreen_ratio = args->pdcch_prescreen_ratio;
 
   srsran_chest_dl_cfg_t* chest_cfg = &ue_dl_cfg->chest_cfg;
 
@@ -319,6 +321,21 @@ bool phy_common::is_any_ul_pending_ack()
   return false;
 }
 
+bool phy_common::has_ul_pending_ack(uint32_t tti)
+{
+  std::lock_guard<std::mutex> lock(pending_ul_ack_mutex);
+
+  for (auto& i : pending_ul_ack) {
+    for (auto& j : i) {
+      if (j[tti].enable) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
 // Computes SF->TTI at which PUSCH will be transmitted according to Section 8 of 36.213
 #define tti_pusch_hi(sf)                                                                                               \
   (sf->tti +                                                                                                           \
@@ -543,6 +560,35 @@ bool phy_common::get_dl_pending_ack(srsran_ul_sf_cfg_t* sf, uint32_t cc_idx, srs
   return ret;
 }
 
+uint32_t phy_common::get_dl_harq_rtt(uint32_t tti, const srsran_tdd_config_t& tdd_config)
+{
+  if (cell.frame_type == SRSRAN_FDD or not tdd_config.configured) {
+    return FDD_HARQ_DELAY_DL_MS + FDD_HARQ_DELAY_UL_MS;
+  }
+
+  // Find the UL subframe that carries the ACK of the PDSCH
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    const das_index_t& das = das_table[tdd_config.sf_config][sf_idx];
+    for (uint32_t i = 0; i < das.M; i++) {
+      if ((sf_idx + 2 * SRSRAN_NOF_SF_X_FRAME - das.K[i]) % SRSRAN_NOF_SF_X_FRAME == tti % SRSRAN_NOF_SF_X_FRAME) {
+        return das.K[i] + FDD_HARQ_DELAY_DL_MS;
+      }
+    }
+  }
+  return FDD_HARQ_DELAY_DL_MS + FDD_HARQ_DELAY_UL_MS;
+}
+
+bool phy_common::is_drx_active_time(uint32_t tti)
+{
+  // The PHICH is received regardless of the DRX
+  if (drx.is_active_time(tti) or has_ul_pending_ack(tti)) {
+    return true;
+  }
+
+  // DRX only applies to the C-RNTI, the system information, paging and random access responses are still searched
+  return SRSRAN_RNTI_ISSIRAPA(stack->get_dl_sched_rnti(tti));
+}
+
 /* The transmission of UL subframes must be in sequence. The correct sequence is guaranteed by a chain of N semaphores,
  * one per SF->TTI%max_workers. Each threads waits for the semaphore for the current thread and after transmission
  * allows next SF->TTI to be transmitted
@@ -907,6 +953,7 @@ void phy_common::reset()
   reset_radio();
 
   sr.reset();
+  drx.reset();
   {
     std::unique_lock<std::mutex> lock(meas_mutex);
     cur_pathloss    = 0;
@@ -20,6 +20,7 @@
  */
 
 #include "srsue/hdr/phy/phy_nr_sa.h"
+#include "srsran/common/band_helper.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/srsran.h"
 
@@ -57,7 +58,7 @@ void phy_nr_sa::set_default_args(phy_args_nr_t& args_)
 bool phy_nr_sa::check_args(const phy_args_nr_t& args_)
 {
   if (args_.nof_phy_threads > MAX_WORKERS) {
-    srsran::console("Error in PHY args: nof_phy_threads must be 1, 2 or 3\n");
+    srsran::console("Error in PHY args: nof_phy_threads must be between 1 and %d\n", MAX_WORKERS);
     return false;
   }
   return true;
@@ -67,7 +68,7 @@ phy_nr_sa::phy_nr_sa(const char* logname) :
   logger(srslog::fetch_basic_logger(logname)),
   logger_phy_lib(srslog::fetch_basic_logger("PHY_LIB")),
   sync(logger, workers),
-  workers(logger, 4)
+  workers(logger, MAX_WORKERS)
 {}
 
 int phy_nr_sa::init(const phy_args_nr_t& args_, stack_interface_phy_nr* stack_, srsran::radio_interface_phy* radio_)
@@ -106,6 +107,8 @@ void phy_nr_sa::init_background()
   nr::sync_sa::args_t sync_args = {};
   sync_args.srate_hz            = args.srate_hz;
   sync_args.thread_priority     = args.slot_recv_thread_prio;
+  sync_args.nof_rx_slots        = args.nof_rx_slots;
+  sync_args.nof_search_threads  = args.nof_search_threads;
   if (not sync.init(sync_args, stack, radio)) {
     logger.error("Error initialising SYNC");
     return;
@@ -181,6 +184,7 @@ bool phy_nr_sa::start_cell_search(const cell_search_args_t& req)
     cfg.ssb_scs                = req.ssb_scs;
     cfg.ssb_pattern            = req.ssb_pattern;
     cfg.duplex_mode            = req.duplex_mode;
+    cfg.ssb_freq_list          = req.ssb_freq_list;
 
     // Request cell search to lower synchronization instance.
     nr::cell_search::ret_t ret = sync.cell_search_run(cfg);
@@ -189,6 +193,7 @@ bool phy_nr_sa::start_cell_search(const cell_search_args_t& req)
     rrc_interface_phy_nr::cell_search_result_t rrc_cs_ret = {};
     rrc_cs_ret.cell_found                                 = ret.result == nr::cell_search::ret_t::CELL_FOUND;
     if (rrc_cs_ret.cell_found) {
+      rrc_cs_ret.ssb_arfcn    = srsran::srsran_band_helper().freq_to_nr_arfcn(ret.ssb_freq_hz);
       rrc_cs_ret.pci          = ret.ssb_res.N_id;
       rrc_cs_ret.pbch_msg     = ret.ssb_res.pbch_msg;
       rrc_cs_ret.measurements = ret.ssb_res.measurements;
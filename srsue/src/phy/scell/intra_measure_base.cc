@@ -19,6 +19,7 @@
  *
  */
 #include "srsue/hdr/phy/scell/intra_measure_base.h"
+#include <chrono>
 
 #define Log(level, fmt, ...)                                                                                           \
   do {                                                                                                                 \
@@ -45,6 +46,7 @@ void intra_measure_base::init_generic(uint32_t cc_idx_, const args_t& args)
   context.meas_period_ms     = args.period_ms;
   context.trigger_tti_period = args.tti_period;
   context.trigger_tti_offset = args.tti_offset;
+  context.duty_cycle_pct     = SRSRAN_MAX(1U, SRSRAN_MIN(100U, args.duty_cycle_pct));
   rx_gain_offset_db          = args.rx_gain_offset_db;
 
   // Compute subframe length from the sampling rate if available
@@ -196,9 +198,20 @@ void intra_measure_base::measure_proc()
   }
 
   // Perform measurements for the actual RAT
+  uint32_t duty_cycle_pct = context_copy.duty_cycle_pct;
+  auto     start          = std::chrono::steady_clock::now();
   if (not measure_rat(std::move(context_copy), search_buffer, rx_gain_offset_db)) {
     Log(error, "Error measuring RAT");
   }
+
+  // Hold off the next trigger so that the processing time does not exceed the duty cycle of the measurement period
+  if (duty_cycle_pct < 100) {
+    auto     elapsed = std::chrono::steady_clock::now() - start;
+    uint32_t proc_ms = (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    duty_cycle_holdoff_ms = SRSRAN_CEIL(proc_ms * 100, duty_cycle_pct);
+  }
 }
 
 void intra_measure_base::run_thread()
@@ -77,7 +77,9 @@ bool intra_measure_lte::measure_rat(const measure_context_t& context, std::vecto
 
   context.new_cell_itf.cell_meas_reset(context.cc_idx);
 
-  // Use Cell Reference signal to measure cells in the time domain for all known active PCI
+  // Use Cell Reference signal to measure cells in the time domain for all known active PCI. All the cells share the
+  // bandwidth, so the buffer DFT is computed once for the first cell and reused for the rest
+  bool buffer_prepared = false;
   for (const uint32_t& id : cells_to_measure) {
     // Do not measure serving cell here since it's measured by workers
     if (id == serving_cell_copy.id) {
@@ -91,8 +93,16 @@ bool intra_measure_lte::measure_rat(const measure_context_t& context, std::vecto
       return false;
     }
 
-    if (srsran_refsignal_dl_sync_run(&refsignal_dl_sync, buffer.data(), context.meas_len_ms * context.sf_len) <
-        SRSRAN_SUCCESS) {
+    if (not buffer_prepared) {
+      if (srsran_refsignal_dl_sync_prepare(&refsignal_dl_sync, buffer.data(), context.meas_len_ms * context.sf_len) <
+          SRSRAN_SUCCESS) {
+        Log(error, "Error preparing refsignal DL measurements");
+        return false;
+      }
+      buffer_prepared = true;
+    }
+
+    if (srsran_refsignal_dl_sync_run_prepared(&refsignal_dl_sync) < SRSRAN_SUCCESS) {
       Log(error, "Error running refsignal DL measurements");
       return false;
     }
@@ -55,7 +55,12 @@ search::~search()
   srsran_ue_cellsearch_free(&cs);
 }
 
-void search::init(srsran::rf_buffer_t& buffer_, uint32_t nof_rx_channels, search_callback* parent, int force_N_id_2_, int force_N_id_1_)
+void search::init(srsran::rf_buffer_t& buffer_,
+                  uint32_t             nof_rx_channels,
+                  search_callback*     parent,
+                  int                  force_N_id_2_,
+                  int                  force_N_id_1_,
+                  bool                 single_pass_)
 {
   p = parent;
 
@@ -75,6 +80,7 @@ void search::init(srsran::rf_buffer_t& buffer_, uint32_t nof_rx_channels, search
 
   force_N_id_2 = force_N_id_2_;
   force_N_id_1 = force_N_id_1_;
+  single_pass  = single_pass_;
 }
 
 void search::set_cp_en(bool enable)
@@ -124,6 +130,9 @@ search::ret_code search::run(srsran_cell_t* cell_, std::array<uint8_t, SRSRAN_BC
   if (force_N_id_2 >= 0 && force_N_id_2 < SRSRAN_NOF_NID_2) {
     ret           = srsran_ue_cellsearch_scan_N_id_2(&cs, force_N_id_2, &found_cells[force_N_id_2]);
     max_peak_cell = force_N_id_2;
+  } else if (single_pass && force_N_id_1 < 0) {
+    // The single pass only detects the strongest cell of each frame, so it is not used to look for a given SSS
+    ret = srsran_ue_cellsearch_scan_all(&cs, found_cells, &max_peak_cell);
   } else {
     ret = srsran_ue_cellsearch_scan(&cs, found_cells, &max_peak_cell);
   }
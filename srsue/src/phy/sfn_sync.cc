@@ -126,6 +126,13 @@ sfn_sync::ret_code sfn_sync::decode_mib(srsran_cell_t*
       return SFX0_FOUND;
     }
 
+    // The UE sync may have left the CFO correction to the OFDM demodulator of the workers
+    float cfo_hz = srsran_ue_sync_get_sf_cfo(ue_sync);
+    if (std::isnormal(cfo_hz)) {
+      srsran_vec_apply_cfo(
+          mib_buffer.get(0), -cfo_hz / (15000.0f * ue_sync->fft_size), mib_buffer.get(0), ue_sync->sf_len);
+    }
+
     int sfn_offset = 0;
     int n          = srsran_ue_mib_decode(&ue_mib, bch_payload.data(), NULL, &sfn_offset);
     switch (n) {
@@ -91,7 +91,12 @@ void sync::init(srsran::radio_interface_phy* _radio,
   }
 
   // Initialize cell searcher
-  search_p.init(sf_buffer, nof_rf_channels, this, worker_com->args->force_N_id_2, worker_com->args->force_N_id_1);
+  search_p.init(sf_buffer,
+                nof_rf_channels,
+                this,
+                worker_com->args->force_N_id_2,
+                worker_com->args->force_N_id_1,
+                worker_com->args->cell_search_single_pass);
   search_p.set_cp_en(worker_com->args->detect_cp);
   // Initialize SFN synchronizer, it uses only pcell buffer
   sfn_p.init(&ue_sync, worker_com->args, sf_buffer, sf_buffer.size());
@@ -104,6 +109,7 @@ void sync::init(srsran::radio_interface_phy* _radio,
       scell::intra_measure_base::args_t args = {};
       args.len_ms                            = worker_com->args->intra_freq_meas_len_ms;
       args.period_ms                         = worker_com->args->intra_freq_meas_period_ms;
+      args.duty_cycle_pct                    = worker_com->args->intra_freq_meas_duty_cycle;
       args.rx_gain_offset_db                 = worker_com->args->rx_gain_offset;
       q->init(i, args);
       intra_freq_meas.push_back(std::unique_ptr<scell::intra_measure_lte>(q));
@@ -535,9 +541,10 @@ void sync::run_camping_in_sync_state(lte::sf_worker*      lte_worker,
   // Execute Serving Cell state FSM
   worker_com->cell_state.run_tti(tti);
 
-  // Set CFO for all Carriers
+  // Set CFO for all Carriers, the Rx CFO is non-zero only if the UE sync left its correction to the OFDM demodulator
   for (uint32_t cc = 0; cc < worker_com->args->nof_lte_carriers; cc++) {
     lte_worker->set_cfo_nolock(cc, get_tx_cfo());
+    lte_worker->set_rx_cfo_nolock(cc, srsran_ue_sync_get_sf_cfo(&ue_sync));
     worker_com->update_cfo_measurement(cc, cfo);
   }
 
@@ -562,6 +569,7 @@ void sync::run_camping_in_sync_state(lte::sf_worker*      lte_worker,
     context.tx_time.copy(last_rx_time);
 
     nr_worker->set_context(context);
+    nr_worker->set_rx_time_point(std::chrono::steady_clock::now());
 
     // As UE sync compensates CFO externally based on LTE signal and the NR carrier may estimate the CFO from the LTE
     // signal. It is necessary setting an NR external CFO offset to compensate it.
@@ -838,6 +846,7 @@ void sync::set_ue_sync_opts(srsran_ue_sync_t* q, float cfo_)
   // Set SFO ema and correct period
   srsran_ue_sync_set_sfo_correct_period(q, worker_com->args->sfo_correct_period);
   srsran_ue_sync_set_sfo_ema(q, worker_com->args->sfo_ema);
+  srsran_ue_sync_set_track_window(q, worker_com->args->pss_track_window, worker_com->args->pss_track_fft);
 
   sss_alg_t sss_alg = SSS_FULL;
   if (!worker_com->args->sss_algorithm.compare("diff")) {
@@ -892,6 +901,10 @@ bool sync::set_cell(float cfo_in)
   // Set options defined in expert section
   set_ue_sync_opts(&ue_sync, cfo_in);
 
+  // Only the LTE workers demodulate the serving cell buffers, so the CFO correction can be left to them if there is no
+  // NR carrier receiving from the same UE sync buffers
+  srsran_ue_sync_set_cfo_correct_defer(&ue_sync, worker_com->args->cfo_correct_in_ofdm && nr_worker_pool == nullptr);
+
   // Reset ue_sync and set CFO/gain from search procedure
   srsran_ue_sync_reset(&ue_sync);
 
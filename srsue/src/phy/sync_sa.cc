@@ -33,6 +33,9 @@ sync_sa::~sync_sa()
   if (rx_buffer != nullptr) {
     free(rx_buffer);
   }
+  for (rx_slot_t& slot : rx_slots) {
+    free(slot.buffer);
+  }
 }
 
 bool sync_sa::init(const args_t& args, stack_interface_phy_nr* stack_, srsran::radio_interface_phy* radio_)
@@ -68,6 +71,16 @@ bool sync_sa::init(const args_t& args, stack_interface_phy_nr* stack_, srsran::r
     return false;
   }
 
+  // Allocate the RX queue
+  rx_slots.resize(args.nof_rx_slots);
+  for (rx_slot_t& slot : rx_slots) {
+    slot.buffer = srsran_vec_cf_malloc(slot_sz);
+    if (slot.buffer == nullptr) {
+      logger.error("Error allocating RX queue buffer");
+      return false;
+    }
+  }
+
   // Thread control
   running = true;
   start(args.thread_priority);
@@ -295,6 +308,11 @@ void sync_sa::run_state_sfn_sync()
 
 void sync_sa::run_state_cell_camping()
 {
+  if (not rx_slots.empty()) {
+    run_state_cell_camping_queued();
+    return;
+  }
+
   nr::sf_worker* nr_worker = workers.wait_worker(tti);
   if (nr_worker == nullptr) {
     running = false;
@@ -312,22 +330,83 @@ void sync_sa::run_state_cell_camping()
     return;
   }
 
+  start_slot(nr_worker, tti, last_rx_time, std::chrono::steady_clock::now());
+
+  tti = TTI_ADD(tti, 1);
+}
+
+/**
+ * Camping with an RX queue. The reception never waits for a worker: the slots received while all the workers are busy
+ * are queued, and handed in order to the workers as they become free. If the queue is full, the oldest slot is dropped
+ */
+void sync_sa::run_state_cell_camping_queued()
+{
+  dispatch_rx_slots();
+
+  if (rx_count == rx_slots.size()) {
+    rx_slot_t& oldest = rx_slots[rx_head];
+    logger.warning("SYNC: no worker became available for slot tti=%d, dropping it", oldest.tti);
+    workers.add_dropped_slot();
+    is_pending_tx_end = true;
+    rx_head           = (rx_head + 1) % rx_slots.size();
+    rx_count--;
+  }
+
+  // Receive samples at the tail of the queue
+  rx_slot_t&          slot      = rx_slots[(rx_head + rx_count) % rx_slots.size()];
+  srsran::rf_buffer_t rf_buffer = {};
+  rf_buffer.set_nof_samples(slot_sz);
+  rf_buffer.set(0, slot.buffer);
+  if (not slot_synchronizer.run_camping(rf_buffer, slot.rx_time)) {
+    logger.error("SYNC: detected out-of-sync... skipping slot ...");
+    is_pending_tx_end = true;
+    return;
+  }
+  slot.tti   = tti;
+  slot.rx_tp = std::chrono::steady_clock::now();
+  rx_count++;
+
+  tti = TTI_ADD(tti, 1);
+
+  dispatch_rx_slots();
+}
+
+void sync_sa::dispatch_rx_slots()
+{
+  while (rx_count > 0) {
+    rx_slot_t&     slot      = rx_slots[rx_head];
+    nr::sf_worker* nr_worker = workers.wait_worker_nb(slot.tti);
+    if (nr_worker == nullptr) {
+      // All the workers are busy
+      return;
+    }
+    srsran_vec_cf_copy(nr_worker->get_buffer(0, 0), slot.buffer, slot_sz);
+    start_slot(nr_worker, slot.tti, slot.rx_time, slot.rx_tp);
+    rx_head = (rx_head + 1) % rx_slots.size();
+    rx_count--;
+  }
+}
+
+void sync_sa::start_slot(nr::sf_worker*                        nr_worker,
+                         uint32_t                              slot_tti,
+                         srsran::rf_timestamp_t                rx_time,
+                         std::chrono::steady_clock::time_point rx_tp)
+{
   srsran::phy_common_interface::worker_context_t context;
-  context.sf_idx     = tti;
+  context.sf_idx     = slot_tti;
   context.worker_ptr = nr_worker;
   context.last       = true; // Set last if standalone
-  last_rx_time.add(FDD_HARQ_DELAY_DL_MS * 1e-3);
-  context.tx_time.copy(last_rx_time);
+  rx_time.add(FDD_HARQ_DELAY_DL_MS * 1e-3);
+  context.tx_time.copy(rx_time);
   // Apply current TA
   context.tx_time.sub((double)ta.get_sec());
 
   nr_worker->set_context(context);
+  nr_worker->set_rx_time_point(rx_tp);
 
   // NR worker needs to be launched first, phy_common::worker_end expects first the NR worker and the LTE worker.
   tti_semaphore.push(nr_worker);
   workers.start_worker(nr_worker);
-
-  tti = TTI_ADD(tti, 1);
 }
 
 void sync_sa::run_thread()
@@ -337,7 +416,13 @@ void sync_sa::run_thread()
 
     logger.debug("SYNC:  state=%s, tti=%d", phy_state.to_string(), tti);
 
-    switch (phy_state.run_state()) {
+    sync_state::state_t state = phy_state.run_state();
+    if (state != sync_state::CAMPING) {
+      // The slots still queued when leaving the camping state are not processed
+      rx_head  = 0;
+      rx_count = 0;
+    }
+    switch (state) {
       case sync_state::IDLE:
         run_state_idle();
         break;
@@ -0,0 +1,216 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsue/hdr/phy/drx_control.h"
+
+using namespace srsue;
+
+static srsran::drx_cfg_t make_drx_cfg()
+{
+  srsran::drx_cfg_t cfg = {};
+  cfg.enabled           = true;
+  cfg.on_duration_timer = 2;
+  cfg.inactivity_timer  = 3;
+  cfg.retx_timer        = 4;
+  cfg.long_cycle        = 40;
+  cfg.start_offset      = 5;
+  return cfg;
+}
+
+// Counts the active TTIs in [tti_start, tti_start + len)
+static uint32_t count_active(drx_control& drx, uint32_t tti_start, uint32_t len)
+{
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < len; i++) {
+    count += drx.is_active_time(TTI_ADD(tti_start, i)) ? 1 : 0;
+  }
+  return count;
+}
+
+int test_disabled(srslog::basic_logger& logger)
+{
+  drx_control drx(logger);
+  TESTASSERT(not drx.is_enabled());
+  TESTASSERT(count_active(drx, 0, 10240) == 10240);
+
+  // An invalid cycle leaves DRX disabled
+  srsran::drx_cfg_t cfg = make_drx_cfg();
+  cfg.long_cycle        = 0;
+  drx.set_config(cfg);
+  TESTASSERT(not drx.is_enabled());
+  TESTASSERT(count_active(drx, 0, 100) == 100);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_long_cycle(srslog::basic_logger& logger)
+{
+  drx_control drx(logger);
+  drx.set_config(make_drx_cfg());
+  TESTASSERT(drx.is_enabled());
+
+  // Only the onDuration of every cycle, including the TTI wrap-around
+  for (uint32_t tti = 0; tti < 10240; tti++) {
+    TESTASSERT(drx.is_active_time(tti) == (tti % 40 == 5 or tti % 40 == 6));
+  }
+  TESTASSERT(count_active(drx, 10200, 80) == 4);
+
+  // The release disables DRX
+  drx.set_config({});
+  TESTASSERT(count_active(drx, 0, 40) == 40);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_inactivity_timer(srslog::basic_logger& logger)
+{
+  drx_control drx(logger);
+  drx.set_config(make_drx_cfg());
+
+  // PDCCH in the last subframe of the onDuration keeps the UE awake for the following 3 subframes
+  drx.new_pdcch(46);
+  TESTASSERT(drx.is_active_time(49));
+  TESTASSERT(not drx.is_active_time(50));
+  TESTASSERT(count_active(drx, 51, 30) == 0);
+
+  // The inactivity timer is restarted by new PDCCHs, also across the TTI wrap-around
+  drx.new_pdcch(10239);
+  TESTASSERT(drx.is_active_time(2));
+  TESTASSERT(not drx.is_active_time(3));
+
+  // A TTI processed late, before the last PDCCH, is kept awake
+  drx.new_pdcch(100);
+  TESTASSERT(drx.is_active_time(99));
+
+  // Setting the same configuration keeps the timers, a new configuration resets them
+  drx.new_pdcch(200);
+  drx.set_config(make_drx_cfg());
+  TESTASSERT(drx.is_active_time(201));
+  srsran::drx_cfg_t cfg = make_drx_cfg();
+  cfg.inactivity_timer  = 1;
+  drx.set_config(cfg);
+  TESTASSERT(not drx.is_active_time(201));
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_short_cycle(srslog::basic_logger& logger)
+{
+  srsran::drx_cfg_t cfg   = make_drx_cfg();
+  cfg.short_cycle_enabled = true;
+  cfg.short_cycle         = 10;
+  cfg.short_cycle_timer   = 2;
+
+  drx_control drx(logger);
+  drx.set_config(cfg);
+
+  // The inactivity timer expires at 49, then the short cycle is used for 20 subframes: onDurations at 55 and 65
+  drx.new_pdcch(46);
+  TESTASSERT(count_active(drx, 50, 5) == 0);
+  TESTASSERT(drx.is_active_time(55) and drx.is_active_time(56) and not drx.is_active_time(57));
+  TESTASSERT(drx.is_active_time(65) and drx.is_active_time(66));
+
+  // Back to the long cycle
+  TESTASSERT(not drx.is_active_time(75));
+  TESTASSERT(drx.is_active_time(85));
+  TESTASSERT(count_active(drx, 87, 38) == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_retx_sr_ra(srslog::basic_logger& logger)
+{
+  drx_control drx(logger);
+  drx.set_config(make_drx_cfg());
+
+  // A DL NACK is active after the HARQ RTT for the retransmission timer
+  drx.new_dl_nack(45, 3, 8);
+  TESTASSERT(not drx.is_active_time(52));
+  TESTASSERT(count_active(drx, 53, 10) == 4);
+  TESTASSERT(count_active(drx, 53, 10) == 0);
+
+  // A transmitted SR is pending until the next UL grant
+  drx.sr_transmitted();
+  TESTASSERT(count_active(drx, 100, 40) == 40);
+  drx.new_ul_grant();
+  TESTASSERT(count_active(drx, 100, 40) == 2);
+
+  // The random access is ongoing until the first PDCCH after the RAR
+  drx.ra_started();
+  drx.new_pdcch(200);
+  TESTASSERT(count_active(drx, 300, 40) == 40);
+  drx.ra_rar_received();
+  TESTASSERT(count_active(drx, 300, 40) == 40);
+  drx.new_pdcch(300);
+  TESTASSERT(count_active(drx, 310, 40) == 2);
+
+  // The reset clears the pending events
+  drx.sr_transmitted();
+  drx.reset();
+  TESTASSERT(count_active(drx, 400, 40) == 2);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_metrics(srslog::basic_logger& logger)
+{
+  drx_control drx(logger);
+  drx.set_config(make_drx_cfg());
+
+  drx_metrics_t m = {};
+  drx.count_sf(true, 300);
+  drx.count_sf(true, 100);
+  drx.count_sf(false, 0);
+  drx.count_sf(false, 0);
+  drx.count_sf(false, 0);
+  drx.get_metrics(m);
+  TESTASSERT(m.nof_active_sf == 2);
+  TESTASSERT(m.nof_skipped_sf == 3);
+  TESTASSERT(std::abs(m.cpu_saved_ms - 0.6f) < 1e-6f);
+
+  // Counters restart on every report, the average processing time is kept
+  drx.count_sf(false, 0);
+  drx.get_metrics(m);
+  TESTASSERT(m.nof_active_sf == 0);
+  TESTASSERT(m.nof_skipped_sf == 1);
+  TESTASSERT(std::abs(m.cpu_saved_ms - 0.2f) < 1e-6f);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  auto& logger = srslog::fetch_basic_logger("PHY", false);
+  logger.set_level(srslog::basic_levels::info);
+  srslog::init();
+
+  TESTASSERT(test_disabled(logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_long_cycle(logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_inactivity_timer(logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_short_cycle(logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_retx_sr_ra(logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_metrics(logger) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -39,6 +39,8 @@ struct args_t {
   uint32_t                    duration_ms     = 1000;
   std::string                 phy_log_level   = "warning";
   std::string                 stack_log_level = "warning";
+  bool                        wideband        = false;
+  uint32_t                    search_threads  = 0;
 
   // Simulation parameters
   uint32_t           sim_ssb_periodicity_ms   = 10;
@@ -135,6 +137,8 @@ int parse_args(int argc, char** argv, args_t& args)
  phy.add_options()
      ("phy.srate", bpo::value<double>(&args.srate_hz)->default_value(args.srate_hz), "Sampling Rate in Hz")
      ("phy.log.level", bpo::value<std::string>(&args.phy_log_level)->default_value(args.phy_log_level), "Physical layer logging level")
+     ("phy.search.wideband", bpo::value<bool>(&args.wideband)->default_value(args.wideband), "Searches all the SSB frequencies in a single capture")
+     ("phy.search.threads", bpo::value<uint32_t>(&args.search_threads)->default_value(args.search_threads), "Extra threads for the wideband search")
      ;
 
  stack.add_options()
@@ -262,23 +266,34 @@ static cell_search_result_t cell_search(const args_t& args, dummy_ue& ue)
   srsran_assert(ss.valid(), "Invalid synchronization raster");
 
   // Iterate every possible frequency in the synchronization raster
+  std::vector<double> ssb_freq_list;
   while (not ss.end()) {
     // Get SSB center frequency
-    cs_args.ssb_freq_hz = ss.get_frequency();
+    double ssb_freq_hz = ss.get_frequency();
 
     // Advance SSB frequency raster
     ss.next();
 
     // Calculate frequency offset between the base-band center frequency and the SSB absolute frequency
-    uint32_t offset_hz = (uint32_t)std::abs(std::round(cs_args.ssb_freq_hz - args.base_carrier.dl_center_frequency_hz));
+    uint32_t offset_hz = (uint32_t)std::abs(std::round(ssb_freq_hz - args.base_carrier.dl_center_frequency_hz));
 
     // The SSB absolute frequency is invalid if it is outside the range and the offset is NOT multiple of the subcarrier
     // spacing
-    if ((cs_args.ssb_freq_hz < ssb_center_freq_min_hz) or (cs_args.ssb_freq_hz > ssb_center_freq_max_hz) or
+    if ((ssb_freq_hz < ssb_center_freq_min_hz) or (ssb_freq_hz > ssb_center_freq_max_hz) or
         (offset_hz % ssb_scs_hz != 0)) {
       // Skip this frequency
       continue;
     }
+    ssb_freq_list.push_back(ssb_freq_hz);
+  }
+
+  // The wideband search looks for all the frequencies at once
+  uint32_t nof_searches = args.wideband ? std::min((uint32_t)ssb_freq_list.size(), 1U) : (uint32_t)ssb_freq_list.size();
+  for (uint32_t search_idx = 0; search_idx < nof_searches; search_idx++) {
+    cs_args.ssb_freq_hz = ssb_freq_list[search_idx];
+    if (args.wideband) {
+      cs_args.ssb_freq_list = ssb_freq_list;
+    }
 
     // Transition PHY to cell search
     srsran_assert(ue.start_cell_search(cs_args), "Failed cell search start");
@@ -296,7 +311,11 @@ static cell_search_result_t cell_search(const args_t& args, dummy_ue& ue)
     }
 
     // Print found cells
-    printf("Cells found at SSB center frequency %.2f MHz:\n", cs_args.ssb_freq_hz / 1e6);
+    if (args.wideband) {
+      printf("Cells found in the SSB raster around %.2f MHz:\n", cs_args.center_freq_hz / 1e6);
+    } else {
+      printf("Cells found at SSB center frequency %.2f MHz:\n", cs_args.ssb_freq_hz / 1e6);
+    }
     printf("| %10s | %10s | %10s | %10s | %10s | %10s | %10s | %10s | %10s | %10s | %10s | %10s |\n",
            "PCI",
            "SSB",
@@ -334,7 +353,8 @@ static cell_search_result_t cell_search(const args_t& args, dummy_ue& ue)
         // If this is the first found cell, then set return value
         if (not ret.found) {
           ret.found           = true;
-          ret.ssb_abs_freq_hz = cs_args.ssb_freq_hz;
+          ret.ssb_abs_freq_hz = args.wideband ? bands.nr_arfcn_to_freq(ssb.second.last_result.ssb_arfcn)
+                                              : cs_args.ssb_freq_hz;
           ret.ssb_scs         = cs_args.ssb_scs;
           ret.ssb_pattern     = cs_args.ssb_pattern;
           ret.duplex_mode     = cs_args.duplex_mode;
@@ -413,9 +433,10 @@ int main(int argc, char** argv)
 
   // Create dummy UE
   dummy_ue::args_t ue_args  = {};
-  ue_args.phy.srate_hz      = args.srate_hz;
-  ue_args.phy.log.phy_level = args.phy_log_level;
-  ue_args.stack.log_level   = args.stack_log_level;
+  ue_args.phy.srate_hz           = args.srate_hz;
+  ue_args.phy.log.phy_level      = args.phy_log_level;
+  ue_args.phy.nof_search_threads = args.search_threads;
+  ue_args.stack.log_level        = args.stack_log_level;
   dummy_ue ue(ue_args, radio.get());
 
   // Perform cell search
@@ -26,6 +26,7 @@
 
 #include "srsue/hdr/stack/mac/mux.h"
 #include "srsran/common/string_helpers.h"
+#include "srsran/common/time_prof.h"
 #include "srsue/hdr/stack/mac/mac.h"
 
 #include <algorithm>
@@ -33,7 +34,14 @@
 
 namespace srsue {
 
-mux::mux(srslog::basic_logger& logger) : logger(logger), pdu_msg(MAX_NOF_SUBHEADERS, logger) {}
+mux::mux(srslog::basic_logger& logger) :
+  logger(logger), active_channels(new lch_list_t), pdu_msg(MAX_NOF_SUBHEADERS, logger)
+{}
+
+mux::~mux()
+{
+  delete active_channels.load(std::memory_order_relaxed);
+}
 
 void mux::init(rlc_interface_mac* rlc_, bsr_interface_mux* bsr_procedure_, phr_proc* phr_procedure_)
 {
@@ -45,10 +53,8 @@ void mux::init(rlc_interface_mac* rlc_, bsr_interface_mux* bsr_procedure_, phr_p
 
 void mux::reset()
 {
-  std::lock_guard<std::mutex> lock(mutex);
-
-  for (auto& channel : logical_channels) {
-    channel.Bj = 0;
+  for (auto& b : Bj) {
+    b.store(0, std::memory_order_relaxed);
   }
   msg3_pending     = false;
   pending_crnti_ce = 0;
@@ -56,22 +62,30 @@ void mux::reset()
 
 void mux::step()
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  srsran::rcu_domain::read_guard guard(rcu);
+  const lch_list_t&              channels = *active_channels.load(std::memory_order_acquire);
 
   // update Bj according to 36.321 Sec 5.4.3.1
-  for (auto& channel : logical_channels) {
-    // Add PRB unless it's infinity
-    if (channel.PBR >= 0) {
-      channel.Bj += channel.PBR; // PBR is in kByte/s, conversion in Byte and ms not needed
-    }
-    channel.Bj = SRSRAN_MIN((uint32_t)channel.Bj, channel.bucket_size);
-    Debug("Update Bj: lcid=%d, Bj=%d", channel.lcid, channel.Bj);
+  for (const auto& channel : channels) {
+    std::atomic<int32_t>& bj     = Bj[channel.lcid];
+    int32_t               old_bj = bj.load(std::memory_order_relaxed);
+    int32_t               new_bj;
+    do {
+      new_bj = old_bj;
+      // Add PRB unless it's infinity
+      if (channel.PBR >= 0) {
+        new_bj += channel.PBR; // PBR is in kByte/s, conversion in Byte and ms not needed
+      }
+      new_bj = SRSRAN_MIN((uint32_t)new_bj, channel.bucket_size);
+    } while (not bj.compare_exchange_weak(old_bj, new_bj, std::memory_order_relaxed));
+    Debug("Update Bj: lcid=%d, Bj=%d", channel.lcid, new_bj);
   }
 }
 
 bool mux::is_pending_any_sdu()
 {
-  for (auto& channel : logical_channels) {
+  srsran::rcu_domain::read_guard guard(rcu);
+  for (const auto& channel : *active_channels.load(std::memory_order_acquire)) {
     if (rlc->has_data_locked(channel.lcid)) {
       return true;
     }
@@ -82,14 +96,41 @@ bool mux::is_pending_any_sdu()
 // This is called by RRC (stack thread) during bearer addition
 void mux::setup_lcid(const logical_channel_config_t& config)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  if (config.lcid >= SRSRAN_N_RADIO_BEARERS) {
+    Error("Invalid LCID=%d", config.lcid);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(config_mutex);
   mux_base::setup_lcid(config);
+  Bj[config.lcid].store(config.Bj, std::memory_order_relaxed);
+
+  // Publish the new list, the PDUs being assembled keep using the previous one
+  lch_list_t* channels = new lch_list_t;
+  for (const auto& channel : logical_channels) {
+    channels->push_back(channel);
+  }
+  const lch_list_t* old_channels = active_channels.exchange(channels, std::memory_order_acq_rel);
+  rcu.synchronize();
+  delete old_channels;
+}
+
+void mux::get_logical_channels(lch_list_t& channels) const
+{
+  {
+    srsran::rcu_domain::read_guard guard(rcu);
+    channels = *active_channels.load(std::memory_order_acquire);
+  }
+  for (auto& channel : channels) {
+    channel.Bj = Bj[channel.lcid].load(std::memory_order_relaxed);
+  }
 }
 
-// mutex should be hold by caller
 void mux::print_logical_channel_state(const std::string& info)
 {
-  mux_base::print_logical_channel_state(info);
+  lch_list_t channels;
+  get_logical_channels(channels);
+  print_channels(info, channels);
 }
 
 srsran::ul_sch_lcid bsr_format_convert(bsr_proc::bsr_format_t format)
@@ -107,32 +148,37 @@ srsran::ul_sch_lcid bsr_format_convert(bsr_proc::bsr_format_t format)
 
 uint8_t* mux::pdu_get(srsran::byte_buffer_t* payload, uint32_t pdu_sz)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  srsran::scoped_stage_prof   prof(srsran::tti_stage::mac_pdu);
+  std::lock_guard<std::mutex> lock(pdu_mutex);
   return pdu_get_nolock(payload, pdu_sz);
 }
 
 // Multiplexing and logical channel priorization as defined in Section 5.4.3
 uint8_t* mux::pdu_get_nolock(srsran::byte_buffer_t* payload, uint32_t pdu_sz)
 {
+  // Work on a copy of the logical channels, the configuration and Bj may change while the PDU is assembled
+  lch_list_t logical_channels;
+  get_logical_channels(logical_channels);
+
   // Logical Channel Procedure
   payload->clear();
   pdu_msg.init_tx(payload, pdu_sz, true);
 
   // MAC control element for C-RNTI or data from UL-CCCH
+  uint16_t crnti_ce = pending_crnti_ce.exchange(0);
   if (!allocate_sdu(0, &pdu_msg, pdu_sz)) {
-    if (pending_crnti_ce) {
+    if (crnti_ce) {
       if (pdu_msg.new_subh()) {
-        if (!pdu_msg.get()->set_c_rnti(pending_crnti_ce)) {
+        if (!pdu_msg.get()->set_c_rnti(crnti_ce)) {
           Warning("Pending C-RNTI CE could not be inserted in MAC PDU");
         }
       }
     }
   } else {
-    if (pending_crnti_ce) {
+    if (crnti_ce) {
       Warning("Pending C-RNTI CE was not inserted because message was for CCCH");
     }
   }
-  pending_crnti_ce = 0;
 
   // Calculate pending UL data per LCID and LCG as well as the total amount
   bsr_proc::bsr_t bsr                = {}; // pending data per LCG
@@ -189,6 +235,7 @@ uint8_t* mux::pdu_get_nolock(srsran::byte_buffer_t* payload, uint32_t pdu_sz)
     if (max_sdu_sz != 0) {
       if (sched_sdu(&channel, &sdu_space, max_sdu_sz)) {
         channel.Bj -= channel.sched_len;
+        Bj[channel.lcid].fetch_sub(channel.sched_len, std::memory_order_relaxed);
         // account for (possible) subheader needed for next SDU
         last_sdu_subheader_len = SRSRAN_MIN((uint32_t)sdu_space, sch_pdu::size_header_sdu(channel.sched_len));
         sdu_space -= last_sdu_subheader_len;
@@ -200,7 +247,7 @@ uint8_t* mux::pdu_get_nolock(srsran::byte_buffer_t* payload, uint32_t pdu_sz)
     sdu_space += last_sdu_subheader_len;
   }
 
-  print_logical_channel_state("First round of allocation:");
+  print_channels("First round of allocation:", logical_channels);
 
   // If resources remain, allocate regardless of their Bj value
   for (auto& channel : logical_channels) {
@@ -213,7 +260,7 @@ uint8_t* mux::pdu_get_nolock(srsran::byte_buffer_t* payload, uint32_t pdu_sz)
     }
   }
 
-  print_logical_channel_state("Second round of allocation:");
+  print_channels("Second round of allocation:", logical_channels);
 
   for (auto& channel : logical_channels) {
     if (channel.sched_len != 0) {
@@ -253,7 +300,6 @@ uint8_t* mux::pdu_get_nolock(srsran::byte_buffer_t* payload, uint32_t pdu_sz)
 
 void mux::append_crnti_ce_next_tx(uint16_t crnti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
   pending_crnti_ce = crnti;
 }
 
@@ -335,7 +381,7 @@ uint32_t mux::allocate_sdu(uint32_t lcid, srsran::sch_pdu* pdu_msg, int max_sdu_
 
 void mux::msg3_flush()
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(pdu_mutex);
   Debug("Msg3 buffer flushed");
   msg3_buff.clear();
   msg3_has_been_transmitted = false;
@@ -344,20 +390,17 @@ void mux::msg3_flush()
 
 bool mux::msg3_is_transmitted()
 {
-  std::lock_guard<std::mutex> lock(mutex);
   return msg3_has_been_transmitted;
 }
 
 void mux::msg3_prepare()
 {
-  std::lock_guard<std::mutex> lock(mutex);
   msg3_has_been_transmitted = false;
   msg3_pending              = true;
 }
 
 bool mux::msg3_is_pending()
 {
-  std::lock_guard<std::mutex> lock(mutex);
   return msg3_pending;
 }
 
@@ -369,7 +412,7 @@ bool mux::msg3_is_empty()
 /* Returns a pointer to the Msg3 buffer */
 uint8_t* mux::msg3_get(srsran::byte_buffer_t* payload, uint32_t pdu_sz)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(pdu_mutex);
   if (pdu_sz < msg3_buff.get_tailroom()) {
     if (msg3_is_empty()) {
       if (!pdu_get_nolock(&msg3_buff, pdu_sz)) {
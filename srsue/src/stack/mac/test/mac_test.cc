@@ -415,6 +415,62 @@ int mac_unpack_test()
   return SRSRAN_SUCCESS;
 }
 
+// A retransmission of a TB that was already decoded is not passed to the PHY for decoding, but it is ACKed again
+int mac_dl_harq_duplicate_test()
+{
+  phy_dummy   phy;
+  rlc_dummy   rlc;
+  rrc_dummy   rrc;
+  stack_dummy stack;
+
+  mac mac("MAC", &stack.task_sched);
+  stack.init(&mac, &phy);
+  mac.init(&phy, &rlc, &rrc);
+
+  // Padding subheader only
+  uint8_t padding_pdu[10]              = {0x1f};
+  bool    dl_ack[SRSRAN_MAX_CODEWORDS] = {true, false};
+
+  mac_interface_phy_lte::mac_grant_dl_t mac_grant = {};
+  mac_grant.rnti                                  = 0xbeaf;
+  mac_grant.pid                                   = 3;
+  mac_grant.tb[0].ndi                             = true;
+  mac_grant.tb[0].ndi_present                     = true;
+  mac_grant.tb[0].tbs                             = sizeof(padding_pdu);
+
+  // First transmission, decoded
+  mac_interface_phy_lte::tb_action_dl_t dl_action = {};
+  mac.new_grant_dl(0, mac_grant, &dl_action);
+  TESTASSERT(dl_action.tb[0].enabled);
+  TESTASSERT(dl_action.generate_ack);
+  memcpy(dl_action.tb[0].payload, padding_pdu, sizeof(padding_pdu));
+  mac.tb_decoded(0, mac_grant, dl_ack);
+
+  // The eNb missed the ACK and retransmits with the same NDI
+  for (uint32_t rv : {2, 3, 1}) {
+    dl_action          = {};
+    mac_grant.tb[0].rv = rv;
+    mac.new_grant_dl(0, mac_grant, &dl_action);
+    TESTASSERT(not dl_action.tb[0].enabled);
+    TESTASSERT(dl_action.generate_ack);
+    mac.tb_decoded(0, mac_grant, dl_ack);
+  }
+
+  // A new transmission in the same process is decoded
+  dl_action           = {};
+  mac_grant.tb[0].ndi = false;
+  mac_grant.tb[0].rv  = 0;
+  mac.new_grant_dl(0, mac_grant, &dl_action);
+  TESTASSERT(dl_action.tb[0].enabled);
+  memcpy(dl_action.tb[0].payload, padding_pdu, sizeof(padding_pdu));
+  mac.tb_decoded(0, mac_grant, dl_ack);
+
+  stack.run_tti(0);
+  mac.stop();
+
+  return SRSRAN_SUCCESS;
+}
+
 // Basic test with a single padding byte and a 10B SCH SDU
 int mac_ul_sch_pdu_test1()
 {
@@ -2368,6 +2424,7 @@ int main(int argc, char** argv)
   srslog::init();
 
   TESTASSERT(mac_unpack_test() == SRSRAN_SUCCESS);
+  TESTASSERT(mac_dl_harq_duplicate_test() == SRSRAN_SUCCESS);
   TESTASSERT(mac_ul_sch_pdu_test1() == SRSRAN_SUCCESS);
   TESTASSERT(mac_ul_logical_channel_prioritization_test1() == SRSRAN_SUCCESS);
   TESTASSERT(mac_ul_logical_channel_prioritization_test2() == SRSRAN_SUCCESS);
@@ -2563,6 +2563,35 @@ void rrc::apply_mac_config_dedicated_default()
   current_mac_cfg.set_mac_main_cfg_default();
   mac->set_config(current_mac_cfg);
   log_mac_config_dedicated();
+  apply_drx_config_default();
+}
+
+// DRX is released by the default MAC main configuration
+void rrc::apply_drx_config_default()
+{
+  srsran::phy_cfg_t& current_pcell = phy_ctrl->current_cell_config()[0];
+  if (current_pcell.drx_cfg.enabled) {
+    logger.info("Releasing DRX configuration");
+    current_pcell.drx_cfg = {};
+    phy_ctrl->set_cell_config(current_pcell);
+  }
+}
+
+void rrc::log_drx_config(const srsran::drx_cfg_t& drx_cfg)
+{
+  if (not drx_cfg.enabled) {
+    logger.info("Set DRX config: release");
+    return;
+  }
+  logger.info("Set DRX config: onDurationTimer=%d, drx-InactivityTimer=%d, drx-RetransmissionTimer=%d, "
+              "longDRX-Cycle=%d, drxStartOffset=%d, shortDRX-Cycle=%d, drxShortCycleTimer=%d",
+              drx_cfg.on_duration_timer,
+              drx_cfg.inactivity_timer,
+              drx_cfg.retx_timer,
+              drx_cfg.long_cycle,
+              drx_cfg.start_offset,
+              drx_cfg.short_cycle_enabled ? drx_cfg.short_cycle : 0,
+              drx_cfg.short_cycle_timer);
 }
 
 /**
@@ -2592,6 +2621,16 @@ bool rrc::apply_rr_config_dedicated(const rr_cfg_ded_s* cnfg, bool is_handover)
     }
     mac->set_config(current_mac_cfg);
     log_mac_config_dedicated();
+
+    // DRX is handled by the PHY, which skips the DL processing outside of the Active Time
+    if (cnfg->mac_main_cfg.type() == rr_cfg_ded_s::mac_main_cfg_c_::types::default_value) {
+      apply_drx_config_default();
+    } else if (cnfg->mac_main_cfg.explicit_value().drx_cfg_present) {
+      srsran::phy_cfg_t& current_pcell = phy_ctrl->current_cell_config()[0];
+      set_phy_cfg_t_drx_cfg(&current_pcell, cnfg->mac_main_cfg.explicit_value().drx_cfg);
+      log_drx_config(current_pcell.drx_cfg);
+      phy_ctrl->set_cell_config(current_pcell);
+    }
   } else if (not is_handover and cnfg->phys_cfg_ded.sched_request_cfg_present) {
     // If MAC-main not set but SR config is set, use directly mac->set_config to update config
     mac->set_config(current_mac_cfg);
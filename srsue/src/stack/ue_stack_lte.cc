@@ -174,7 +174,7 @@ int ue_stack_lte::init(const stack_args_t& args_)
   if (args.pkt_trace.mac_pcap.enable && args.pkt_trace.mac_nr_pcap.enable &&
       args.pkt_trace.mac_pcap.filename == args.pkt_trace.mac_nr_pcap.filename) {
     stack_logger.info("Using same MAC PCAP file %s for LTE and NR", args.pkt_trace.mac_pcap.filename.c_str());
-    if (mac_pcap.open(args.pkt_trace.mac_pcap.filename.c_str()) == SRSRAN_SUCCESS) {
+    if (mac_pcap.open(args.pkt_trace.mac_pcap.filename, 0, args.pkt_trace.writer) == SRSRAN_SUCCESS) {
       mac.start_pcap(&mac_pcap);
       mac_nr.start_pcap(&mac_pcap);
       stack_logger.info("Open mac pcap file %s", args.pkt_trace.mac_pcap.filename.c_str());
@@ -183,7 +183,7 @@ int ue_stack_lte::init(const stack_args_t& args_)
     }
   } else {
     if (args.pkt_trace.mac_pcap.enable) {
-      if (mac_pcap.open(args.pkt_trace.mac_pcap.filename.c_str()) == SRSRAN_SUCCESS) {
+      if (mac_pcap.open(args.pkt_trace.mac_pcap.filename, 0, args.pkt_trace.writer) == SRSRAN_SUCCESS) {
         mac.start_pcap(&mac_pcap);
         stack_logger.info("Open mac pcap file %s", args.pkt_trace.mac_pcap.filename.c_str());
       } else {
@@ -192,7 +192,7 @@ int ue_stack_lte::init(const stack_args_t& args_)
     }
 
     if (args.pkt_trace.mac_nr_pcap.enable) {
-      if (mac_nr_pcap.open(args.pkt_trace.mac_nr_pcap.filename.c_str()) == SRSRAN_SUCCESS) {
+      if (mac_nr_pcap.open(args.pkt_trace.mac_nr_pcap.filename, 0, args.pkt_trace.writer) == SRSRAN_SUCCESS) {
         mac_nr.start_pcap(&mac_nr_pcap);
         stack_logger.info("Open mac nr pcap file %s", args.pkt_trace.mac_nr_pcap.filename.c_str());
       } else {
@@ -202,7 +202,7 @@ int ue_stack_lte::init(const stack_args_t& args_)
   }
 
   if (args.pkt_trace.nas_pcap.enable) {
-    if (nas_pcap.open(args.pkt_trace.nas_pcap.filename.c_str()) == SRSRAN_SUCCESS) {
+    if (nas_pcap.open(args.pkt_trace.nas_pcap.filename, 0, srsran::srsran_rat_t::lte, args.pkt_trace.writer) == SRSRAN_SUCCESS) {
       nas.start_pcap(&nas_pcap);
       nas_5g.start_pcap(&nas_pcap);
       stack_logger.info("Open nas pcap file %s", args.pkt_trace.nas_pcap.filename.c_str());
@@ -375,10 +375,10 @@ bool ue_stack_lte::get_metrics(stack_metrics_t* metrics)
     nas.get_metrics(&metrics.nas);
     rrc.get_metrics(metrics.rrc);
     rrc_nr.get_metrics(metrics.rrc_nr);
-    pending_stack_metrics.push(metrics);
+    pending_stack_metrics.push_blocking(metrics);
   });
   // wait for result
-  *metrics = pending_stack_metrics.wait_pop();
+  *metrics = pending_stack_metrics.pop_blocking();
   return (metrics->nas.state == emm_state_t::state_t::registered && metrics->rrc.state == RRC_STATE_CONNECTED);
 }
 
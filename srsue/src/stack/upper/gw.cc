@@ -21,6 +21,7 @@
 
 #include "srsue/hdr/stack/upper/gw.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/tun_utils.h"
 #include "srsran/interfaces/ue_pdcp_interfaces.h"
 #include "srsran/upper/ipv6.h"
 
@@ -38,6 +39,21 @@
 
 namespace srsue {
 
+// Reads one of the additional queues of the TUN device
+class gw::tun_reader : public srsran::thread
+{
+public:
+  tun_reader(gw* parent_, tun_queue_t* queue_, uint32_t queue_idx) :
+    thread("GW_TUN" + std::to_string(queue_idx)), parent(parent_), queue(queue_)
+  {}
+
+private:
+  void run_thread() override { parent->run_tun_queue(*queue); }
+
+  gw*          parent = nullptr;
+  tun_queue_t* queue  = nullptr;
+};
+
 gw::gw(srslog::basic_logger& logger_) : thread("GW"), logger(logger_), tft_matcher(logger) {}
 
 int gw::init(const gw_args_t& args_, stack_interface_gw* stack_)
@@ -73,9 +89,7 @@ int gw::init(const gw_args_t& args_, stack_interface_gw* stack_)
 
 gw::~gw()
 {
-  if (tun_fd > 0) {
-    close(tun_fd);
-  }
+  close_tun_queues();
 }
 
 void gw::stop()
@@ -84,6 +98,7 @@ void gw::stop()
     run_enable = false;
     if (if_up) {
       if_up = false;
+      stop_tun_readers();
       if (running) {
         thread_cancel();
       }
@@ -124,6 +139,26 @@ void gw::get_metrics(gw_metrics_t& m, const uint32_t nof_tti)
                m.ul_tput_mbps,
                ul_tput_mbps_real_time);
 
+  m.tun_queues.resize(tun_queues.size());
+  for (uint32_t i = 0; i < tun_queues.size(); ++i) {
+    tun_queue_t&            queue = *tun_queues[i];
+    gw_tun_queue_metrics_t& qm    = m.tun_queues[i];
+    qm.ul_tput_mbps = (nof_tti > 0) ? ((queue.ul_bytes * 8 / (double)1e6) / (nof_tti / 1000.0)) : 0.0;
+    qm.ul_pkts      = queue.ul_pkts;
+    qm.ul_gso_pkts  = queue.ul_gso_pkts;
+    qm.ul_dropped   = queue.ul_dropped;
+    logger.debug("TUN queue %d: gw_tx_rate_mbps=%4.2f, pkts=%d, gso_pkts=%d, dropped=%d",
+                 i,
+                 qm.ul_tput_mbps,
+                 qm.ul_pkts,
+                 qm.ul_gso_pkts,
+                 qm.ul_dropped);
+    queue.ul_pkts     = 0;
+    queue.ul_bytes    = 0;
+    queue.ul_gso_pkts = 0;
+    queue.ul_dropped  = 0;
+  }
+
   // reset counters and store time
   metrics_tp    = std::chrono::high_resolution_clock::now();
   dl_tput_bytes = 0;
@@ -151,7 +186,7 @@ void gw::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
     // Only handle IPv4 and IPv6 packets
     struct iphdr* ip_pkt = (struct iphdr*)pdu->msg;
     if (ip_pkt->version == 4 || ip_pkt->version == 6) {
-      int n = write(tun_fd, pdu->msg, pdu->N_bytes);
+      int n = write_tun(pdu.get());
       if (n > 0 && (pdu->N_bytes != (uint32_t)n)) {
         logger.warning("DL TUN/TAP write failure. Wanted to write %d B but only wrote %d B.", pdu->N_bytes, n);
       }
@@ -185,7 +220,7 @@ void gw::write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
         logger.warning("TUN/TAP not up - dropping gw RX message");
       }
     } else {
-      int n = write(tun_fd, pdu->msg, pdu->N_bytes);
+      int n = write_tun(pdu.get());
       if (n > 0 && (pdu->N_bytes != (uint32_t)n)) {
         logger.warning("DL TUN/TAP write failure");
       }
@@ -200,12 +235,13 @@ int gw::setup_if_addr(uint32_t eps_bearer_id, uint8_t pdn_type, uint32_t ip_addr
 {
   int err;
 
-  // Make sure the worker thread is terminated before spawning a new one.
+  // Make sure the worker threads are terminated before spawning new ones.
   if (running) {
     run_enable = false;
     thread_cancel();
     wait_thread_finish();
   }
+  stop_tun_readers();
   if (pdn_type == LIBLTE_MME_PDN_TYPE_IPV4 || pdn_type == LIBLTE_MME_PDN_TYPE_IPV4V6) {
     err = setup_if_addr4(ip_addr, err_str);
     if (err != SRSRAN_SUCCESS) {
@@ -221,9 +257,10 @@ int gw::setup_if_addr(uint32_t eps_bearer_id, uint8_t pdn_type, uint32_t ip_addr
 
   default_eps_bearer_id = static_cast<int>(eps_bearer_id);
 
-  // Setup a thread to receive packets from the TUN device
+  // Setup a thread to receive packets from each queue of the TUN device
   run_enable = true;
   start(GW_THREAD_PRIO);
+  start_tun_readers();
 
   return SRSRAN_SUCCESS;
 }
@@ -273,6 +310,17 @@ void gw::add_mch_port(uint32_t lcid, uint32_t port)
 /*    GW Receive    */
 /********************/
 void gw::run_thread()
+{
+  if (tun_queues.empty()) {
+    logger.error("TUN interface not open - gw receive thread exiting.");
+    return;
+  }
+  running = true;
+  run_tun_queue(*tun_queues[0]);
+  running = false;
+}
+
+void gw::run_tun_queue(tun_queue_t& queue)
 {
   uint32 idx     = 0;
   int32  N_bytes = 0;
@@ -283,22 +331,47 @@ void gw::run_thread()
     return;
   }
 
-  const static uint32_t REGISTER_WAIT_TOUT = 40, SERVICE_WAIT_TOUT = 40; // 4 sec
-  uint32_t              register_wait = 0, service_wait = 0;
-
   logger.info("GW IP packet receiver thread run_enable");
 
-  running = true;
   while (run_enable) {
+    if (args.tun_vnet_hdr) {
+      // The TCP segments coalesced by the kernel do not fit in a PDU, the packet is read whole and split
+      N_bytes = read(queue.fd, queue.frame.data(), queue.frame.size());
+      logger.debug("Read %d bytes from TUN fd=%d", N_bytes, queue.fd);
+      if (N_bytes <= 0) {
+        logger.error("Failed to read from TUN interface - gw receive thread exiting.");
+        srsran::console("Failed to read from TUN interface - gw receive thread exiting.\n");
+        break;
+      }
+
+      queue.pkts.clear();
+      int nof_pkts = srsran::tun_vnet_split(queue.frame.data(), N_bytes, queue.pkts);
+
+      std::unique_lock<std::mutex> lock(gw_mutex);
+      if (nof_pkts < 0) {
+        logger.warning("Failed to split the %d B packet read from TUN fd=%d. Dropping packet.", N_bytes, queue.fd);
+        queue.ul_dropped++;
+        continue;
+      }
+      if (nof_pkts > 1) {
+        queue.ul_gso_pkts++;
+      }
+      for (uint32_t i = 0; i < queue.pkts.size() and run_enable; ++i) {
+        logger.info(queue.pkts[i]->msg, queue.pkts[i]->N_bytes, "TX PDU");
+        handle_ul_pdu(std::move(queue.pkts[i]), queue, lock);
+      }
+      continue;
+    }
+
     // Read packet from TUN
     if (SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET > idx) {
-      N_bytes = read(tun_fd, &pdu->msg[idx], SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET - idx);
+      N_bytes = read(queue.fd, &pdu->msg[idx], SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET - idx);
     } else {
       logger.error("GW pdu buffer full - gw receive thread exiting.");
       srsran::console("GW pdu buffer full - gw receive thread exiting.\n");
       break;
     }
-    logger.debug("Read %d bytes from TUN fd=%d, idx=%d", N_bytes, tun_fd, idx);
+    logger.debug("Read %d bytes from TUN fd=%d, idx=%d", N_bytes, queue.fd, idx);
 
     if (N_bytes <= 0) {
       logger.error("Failed to read from TUN interface - gw receive thread exiting.");
@@ -326,55 +399,10 @@ void gw::run_thread()
       // Check if entire packet was received
       if (pkt_len == pdu->N_bytes) {
         logger.info(pdu->msg, pdu->N_bytes, "TX PDU");
-
-        // Make sure UE is attached and has default EPS bearer activated
-        while (run_enable && default_eps_bearer_id == NOT_ASSIGNED && register_wait < REGISTER_WAIT_TOUT) {
-          if (!register_wait) {
-            logger.info("UE is not attached, waiting for NAS attach (%d/%d)", register_wait, REGISTER_WAIT_TOUT);
-          }
-          lock.unlock();
-          std::this_thread::sleep_for(std::chrono::microseconds(100));
-          lock.lock();
-          register_wait++;
-        }
-        register_wait = 0;
-
-        // If we are still not attached by this stage, drop packet
-        if (run_enable && default_eps_bearer_id == NOT_ASSIGNED) {
-          continue;
-        }
-
+        handle_ul_pdu(std::move(pdu), queue, lock);
         if (!run_enable) {
           break;
         }
-
-        // Beyond this point we should have a activated default EPS bearer
-        srsran_assert(default_eps_bearer_id != NOT_ASSIGNED, "Default EPS bearer not activated");
-
-        uint8_t eps_bearer_id = default_eps_bearer_id;
-        tft_matcher.check_tft_filter_match(pdu, eps_bearer_id);
-
-        // Wait for service request if necessary
-        while (run_enable && !stack->has_active_radio_bearer(eps_bearer_id) && service_wait < SERVICE_WAIT_TOUT) {
-          if (!service_wait) {
-            logger.info(
-                "UE does not have service, waiting for NAS service request (%d/%d)", service_wait, SERVICE_WAIT_TOUT);
-            stack->start_service_request();
-          }
-          usleep(100000);
-          service_wait++;
-        }
-        service_wait = 0;
-
-        // Quit before writing packet if necessary
-        if (!run_enable) {
-          break;
-        }
-
-        // Send PDU directly to PDCP
-        pdu->set_timestamp();
-        ul_tput_bytes += pdu->N_bytes;
-        stack->write_sdu(eps_bearer_id, std::move(pdu));
         do {
           pdu = srsran::make_byte_buffer();
           if (!pdu) {
@@ -389,10 +417,57 @@ void gw::run_thread()
       }
     } // end of holdering gw_mutex
   }
-  running = false;
   logger.info("GW IP receiver thread exiting.");
 }
 
+// Sends an IP packet read from the TUN device to PDCP, the caller holds gw_mutex
+void gw::handle_ul_pdu(srsran::unique_byte_buffer_t pdu, tun_queue_t& queue, std::unique_lock<std::mutex>& lock)
+{
+  const static uint32_t REGISTER_WAIT_TOUT = 40, SERVICE_WAIT_TOUT = 40; // 4 sec
+  uint32_t              register_wait = 0, service_wait = 0;
+
+  // Make sure UE is attached and has default EPS bearer activated
+  while (run_enable && default_eps_bearer_id == NOT_ASSIGNED && register_wait < REGISTER_WAIT_TOUT) {
+    if (!register_wait) {
+      logger.info("UE is not attached, waiting for NAS attach (%d/%d)", register_wait, REGISTER_WAIT_TOUT);
+    }
+    lock.unlock();
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    lock.lock();
+    register_wait++;
+  }
+
+  // If we are still not attached by this stage, drop packet
+  if (!run_enable || default_eps_bearer_id == NOT_ASSIGNED) {
+    return;
+  }
+
+  uint8_t eps_bearer_id = default_eps_bearer_id;
+  tft_matcher.check_tft_filter_match(pdu, eps_bearer_id);
+
+  // Wait for service request if necessary
+  while (run_enable && !stack->has_active_radio_bearer(eps_bearer_id) && service_wait < SERVICE_WAIT_TOUT) {
+    if (!service_wait) {
+      logger.info("UE does not have service, waiting for NAS service request (%d/%d)", service_wait, SERVICE_WAIT_TOUT);
+      stack->start_service_request();
+    }
+    usleep(100000);
+    service_wait++;
+  }
+
+  // Quit before writing packet if necessary
+  if (!run_enable) {
+    return;
+  }
+
+  // Send PDU directly to PDCP
+  pdu->set_timestamp();
+  ul_tput_bytes += pdu->N_bytes;
+  queue.ul_bytes += pdu->N_bytes;
+  queue.ul_pkts++;
+  stack->write_sdu(eps_bearer_id, std::move(pdu));
+}
+
 /**************************/
 /* TUN Interface Helpers  */
 /**************************/
@@ -419,25 +494,55 @@ int gw::init_if(char* err_str)
     }
   }
 
-  // Construct the TUN device
-  tun_fd = open("/dev/net/tun", O_RDWR);
-  logger.info("TUN file descriptor = %d", tun_fd);
-  if (0 > tun_fd) {
-    err_str = strerror(errno);
-    logger.error("Failed to open TUN device: %s", err_str);
-    return SRSRAN_ERROR_CANT_START;
+  // Construct the TUN device, with a queue per reader thread
+  uint32_t nof_queues = std::max(args.nof_tun_queues, 1u);
+  for (uint32_t i = 0; i < nof_queues; ++i) {
+    tun_queue_t* new_queue = new tun_queue_t;
+    {
+      std::lock_guard<std::mutex> lock(gw_mutex);
+      tun_queues.emplace_back(new_queue);
+    }
+    tun_queue_t& queue = *new_queue;
+    queue.fd           = open("/dev/net/tun", O_RDWR);
+    logger.info("TUN file descriptor = %d", queue.fd);
+    if (0 > queue.fd) {
+      err_str = strerror(errno);
+      logger.error("Failed to open TUN device: %s", err_str);
+      close_tun_queues();
+      return SRSRAN_ERROR_CANT_START;
+    }
+
+    memset(&ifr, 0, sizeof(ifr));
+    ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+    if (nof_queues > 1) {
+      ifr.ifr_flags |= IFF_MULTI_QUEUE;
+    }
+    if (args.tun_vnet_hdr) {
+      ifr.ifr_flags |= IFF_VNET_HDR;
+    }
+    strncpy(ifr.ifr_ifrn.ifrn_name,
+            args.tun_dev_name.c_str(),
+            std::min(args.tun_dev_name.length(), (size_t)(IFNAMSIZ - 1)));
+    ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = 0;
+    if (0 > ioctl(queue.fd, TUNSETIFF, &ifr)) {
+      err_str = strerror(errno);
+      logger.error("Failed to set TUN device name: %s", err_str);
+      close_tun_queues();
+      return SRSRAN_ERROR_CANT_START;
+    }
+
+    if (args.tun_vnet_hdr) {
+      if (not srsran::tun_vnet_enable_offloads(queue.fd)) {
+        logger.warning("Failed to enable the TUN segmentation offloads: %s", strerror(errno));
+      }
+      queue.frame.resize(srsran::tun_vnet_max_frame_size);
+    }
   }
+  tun_fd = tun_queues[0]->fd;
 
-  memset(&ifr, 0, sizeof(ifr));
-  ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
-  strncpy(
-      ifr.ifr_ifrn.ifrn_name, args.tun_dev_name.c_str(), std::min(args.tun_dev_name.length(), (size_t)(IFNAMSIZ - 1)));
-  ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = 0;
-  if (0 > ioctl(tun_fd, TUNSETIFF, &ifr)) {
-    err_str = strerror(errno);
-    logger.error("Failed to set TUN device name: %s", err_str);
-    close(tun_fd);
-    return SRSRAN_ERROR_CANT_START;
+  // Spread the uplink packets across the queues by flow, regardless of the queue their downlink packets are written to
+  if (nof_queues > 1 and not srsran::tun_set_steering_by_flow(tun_fd)) {
+    logger.warning("Failed to steer the TUN queues by flow: %s", strerror(errno));
   }
 
   // Bring up the interface
@@ -445,14 +550,14 @@ int gw::init_if(char* err_str)
   if (0 > ioctl(sock, SIOCGIFFLAGS, &ifr)) {
     err_str = strerror(errno);
     logger.error("Failed to bring up socket: %s", err_str);
-    close(tun_fd);
+    close_tun_queues();
     return SRSRAN_ERROR_CANT_START;
   }
   ifr.ifr_flags |= IFF_UP | IFF_RUNNING;
   if (0 > ioctl(sock, SIOCSIFFLAGS, &ifr)) {
     err_str = strerror(errno);
     logger.error("Failed to set socket flags: %s", err_str);
-    close(tun_fd);
+    close_tun_queues();
     return SRSRAN_ERROR_CANT_START;
   }
 
@@ -470,6 +575,45 @@ int gw::init_if(char* err_str)
   return SRSRAN_SUCCESS;
 }
 
+void gw::start_tun_readers()
+{
+  for (uint32_t i = 1; i < tun_queues.size(); ++i) {
+    tun_queues[i]->reader.reset(new tun_reader(this, tun_queues[i].get(), i));
+    tun_queues[i]->reader->start(GW_THREAD_PRIO);
+  }
+}
+
+void gw::stop_tun_readers()
+{
+  for (std::unique_ptr<tun_queue_t>& queue : tun_queues) {
+    if (queue->reader != nullptr) {
+      queue->reader->thread_cancel();
+      queue->reader->wait_thread_finish();
+      queue->reader.reset();
+    }
+  }
+}
+
+void gw::close_tun_queues()
+{
+  std::lock_guard<std::mutex> lock(gw_mutex);
+  for (std::unique_ptr<tun_queue_t>& queue : tun_queues) {
+    if (queue->fd >= 0) {
+      close(queue->fd);
+    }
+  }
+  tun_queues.clear();
+  tun_fd = -1;
+}
+
+ssize_t gw::write_tun(srsran::byte_buffer_t* pdu)
+{
+  if (args.tun_vnet_hdr) {
+    return srsran::tun_vnet_write(tun_fd, pdu->msg, pdu->N_bytes);
+  }
+  return write(tun_fd, pdu->msg, pdu->N_bytes);
+}
+
 int gw::setup_if_addr4(uint32_t ip_addr, char* err_str)
 {
   if (ip_addr != current_ip_addr) {
@@ -490,7 +634,7 @@ int gw::setup_if_addr4(uint32_t ip_addr, char* err_str)
     if (0 > ioctl(sock, SIOCSIFADDR, &ifr)) {
       err_str = strerror(errno);
       logger.debug("Failed to set socket address: %s", err_str);
-      close(tun_fd);
+      close_tun_queues();
       return SRSRAN_ERROR_CANT_START;
     }
     ifr.ifr_netmask.sa_family = AF_INET;
@@ -505,7 +649,7 @@ int gw::setup_if_addr4(uint32_t ip_addr, char* err_str)
     if (0 > ioctl(sock, SIOCSIFNETMASK, &ifr)) {
       err_str = strerror(errno);
       logger.debug("Failed to set socket netmask: %s", err_str);
-      close(tun_fd);
+      close_tun_queues();
       return SRSRAN_ERROR_CANT_START;
     }
     current_ip_addr = ip_addr;
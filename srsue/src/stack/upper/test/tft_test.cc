@@ -409,6 +409,94 @@ int tft_filter_test_ipv4_tos()
   return 0;
 }
 
+/// Creates a TFT with a single packet filter
+LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT
+make_tft(uint8_t filter_id, uint8_t eval_precedence, const uint8_t* filter_message, uint8_t filter_size)
+{
+  LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT tft = {};
+  tft.tft_op_code                             = LIBLTE_MME_TFT_OPERATION_CODE_CREATE_NEW_TFT;
+  tft.packet_filter_list_size                 = 1;
+  tft.packet_filter_list[0].dir               = LIBLTE_MME_TFT_PACKET_FILTER_DIRECTION_BIDIRECTIONAL;
+  tft.packet_filter_list[0].id                = filter_id;
+  tft.packet_filter_list[0].eval_precedence   = eval_precedence;
+  tft.packet_filter_list[0].filter_size       = filter_size;
+  memcpy(tft.packet_filter_list[0].filter, filter_message, filter_size);
+  return tft;
+}
+
+int tft_matcher_test_precedence()
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT");
+  tft_pdu_matcher       matcher(logger);
+
+  srsran::unique_byte_buffer_t ip_msg1 = make_byte_buffer();
+  srsran::unique_byte_buffer_t ip_msg2 = make_byte_buffer();
+  srsran::unique_byte_buffer_t ip_msg3 = make_byte_buffer();
+  TESTASSERT(ip_msg1 != nullptr and ip_msg2 != nullptr and ip_msg3 != nullptr);
+  ip_msg1->N_bytes = ip_message_len1;
+  memcpy(ip_msg1->msg, ip_tst_message1, ip_message_len1);
+  ip_msg2->N_bytes = ip_message_len2;
+  memcpy(ip_msg2->msg, ip_tst_message2, ip_message_len2);
+  ip_msg3->N_bytes = sizeof(ipv6_matched_packet);
+  memcpy(ip_msg3->msg, ipv6_matched_packet, sizeof(ipv6_matched_packet));
+
+  uint8_t eps_bearer_id = 0;
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg1, eps_bearer_id) == SRSRAN_ERROR);
+
+  // Single local port 2222 matches message 1
+  uint8_t local_port_filter[3] = {SINGLE_LOCAL_PORT_TYPE};
+  srsran::uint16_to_uint8(2222, &local_port_filter[1]);
+  LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT tft = make_tft(1, 10, local_port_filter, sizeof(local_port_filter));
+  TESTASSERT(matcher.apply_traffic_flow_template(5, &tft) == SRSRAN_SUCCESS);
+
+  // UDP with single remote port 9000 matches message 2
+  uint8_t remote_port_filter[5] = {PROTOCOL_ID_TYPE, UDP_PROTOCOL, SINGLE_REMOTE_PORT_TYPE};
+  srsran::uint16_to_uint8(9000, &remote_port_filter[3]);
+  tft = make_tft(2, 5, remote_port_filter, sizeof(remote_port_filter));
+  TESTASSERT(matcher.apply_traffic_flow_template(6, &tft) == SRSRAN_SUCCESS);
+
+  // UDP matches all the messages, with a lower priority
+  uint8_t udp_filter[2] = {PROTOCOL_ID_TYPE, UDP_PROTOCOL};
+  tft                   = make_tft(3, 20, udp_filter, sizeof(udp_filter));
+  TESTASSERT(matcher.apply_traffic_flow_template(7, &tft) == SRSRAN_SUCCESS);
+
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg1, eps_bearer_id) == SRSRAN_SUCCESS);
+  TESTASSERT(eps_bearer_id == 5);
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg2, eps_bearer_id) == SRSRAN_SUCCESS);
+  TESTASSERT(eps_bearer_id == 6);
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg3, eps_bearer_id) == SRSRAN_SUCCESS);
+  TESTASSERT(eps_bearer_id == 7);
+
+  // A remote address filter with the highest priority takes message 1 over the port filter
+  uint8_t remote_addr_filter[9] = {IPV4_REMOTE_ADDR_TYPE};
+  inet_pton(AF_INET, "127.0.0.2", &remote_addr_filter[1]);
+  inet_pton(AF_INET, "255.255.255.255", &remote_addr_filter[5]);
+  tft = make_tft(4, 1, remote_addr_filter, sizeof(remote_addr_filter));
+  TESTASSERT(matcher.apply_traffic_flow_template(8, &tft) == SRSRAN_SUCCESS);
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg1, eps_bearer_id) == SRSRAN_SUCCESS);
+  TESTASSERT(eps_bearer_id == 8);
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg2, eps_bearer_id) == SRSRAN_SUCCESS);
+  TESTASSERT(eps_bearer_id == 6);
+
+  // Replacing the port filter of bearer 6 by one on another port sends message 2 to the UDP filter
+  srsran::uint16_to_uint8(9001, &remote_port_filter[3]);
+  tft             = make_tft(2, 5, remote_port_filter, sizeof(remote_port_filter));
+  tft.tft_op_code = LIBLTE_MME_TFT_OPERATION_CODE_REPLACE_PACKET_FILTERS_IN_EXISTING_TFT;
+  TESTASSERT(matcher.apply_traffic_flow_template(6, &tft) == SRSRAN_SUCCESS);
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg2, eps_bearer_id) == SRSRAN_SUCCESS);
+  TESTASSERT(eps_bearer_id == 7);
+
+  // Without the UDP filter, message 2 is not matched
+  matcher.delete_tft_for_eps_bearer(7);
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg2, eps_bearer_id) == SRSRAN_ERROR);
+
+  matcher.reset();
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg1, eps_bearer_id) == SRSRAN_ERROR);
+
+  printf("Test TFT matcher precedence successfull\n");
+  return 0;
+}
+
 int main(int argc, char** argv)
 {
   srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT", false);
@@ -435,4 +523,7 @@ int main(int argc, char** argv)
   if (tft_filter_test_ipv6_combined()) {
     return -1;
   }
+  if (tft_matcher_test_precedence()) {
+    return -1;
+  }
 }
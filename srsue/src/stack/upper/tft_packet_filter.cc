@@ -178,7 +178,7 @@ tft_packet_filter_t::tft_packet_filter_t(uint8_t
   }
 }
 
-bool inline tft_packet_filter_t::filter_contains(uint16_t filtertype)
+bool inline tft_packet_filter_t::filter_contains(uint16_t filtertype) const
 {
   return (active_filters & filtertype) != 0;
 }
@@ -191,7 +191,7 @@ bool inline tft_packet_filter_t::filter_contains(uint16_t filtertype)
  *
  * Note: 'active_filters' is a bitmask; bits set to '1' represent active filter components.
  */
-bool tft_packet_filter_t::match(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match(const srsran::unique_byte_buffer_t& pdu) const
 {
   uint16_t ip_flags = IPV4_REMOTE_ADDR_FLAG | IPV4_LOCAL_ADDR_FLAG | IPV6_REMOTE_ADDR_FLAG |
                       IPV6_REMOTE_ADDR_LENGTH_FLAG | IPV6_LOCAL_ADDR_LENGTH_FLAG;
@@ -226,7 +226,7 @@ bool tft_packet_filter_t::match(const srsran::unique_byte_buffer_t& pdu)
   return true;
 }
 
-bool tft_packet_filter_t::match_ip(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_ip(const srsran::unique_byte_buffer_t& pdu) const
 {
   struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
   struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
@@ -263,7 +263,7 @@ bool tft_packet_filter_t::match_ip(const srsran::unique_byte_buffer_t& pdu)
   return true;
 }
 
-bool tft_packet_filter_t::match_protocol(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_protocol(const srsran::unique_byte_buffer_t& pdu) const
 {
   struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
   struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
@@ -285,7 +285,7 @@ bool tft_packet_filter_t::match_protocol(const srsran::unique_byte_buffer_t& pdu
   return true;
 }
 
-bool tft_packet_filter_t::match_type_of_service(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_type_of_service(const srsran::unique_byte_buffer_t& pdu) const
 {
   struct iphdr* ip_pkt = (struct iphdr*)pdu->msg;
 
@@ -301,7 +301,7 @@ bool tft_packet_filter_t::match_type_of_service(const srsran::unique_byte_buffer
   return true;
 }
 
-bool tft_packet_filter_t::match_flow_label(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_flow_label(const srsran::unique_byte_buffer_t& pdu) const
 {
   struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
 
@@ -314,7 +314,7 @@ bool tft_packet_filter_t::match_flow_label(const srsran::unique_byte_buffer_t& p
   return true;
 }
 
-bool tft_packet_filter_t::match_port(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_port(const srsran::unique_byte_buffer_t& pdu) const
 {
   struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
   struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
@@ -387,9 +387,115 @@ bool tft_packet_filter_t::match_port(const srsran::unique_byte_buffer_t& pdu)
   return true;
 }
 
+tft_classifier::tft_classifier(const std::map<uint16_t, tft_packet_filter_t>& filter_map)
+{
+  for (const std::pair<const uint16_t, tft_packet_filter_t>& filter_pair : filter_map) {
+    const tft_packet_filter_t& filter = filter_pair.second;
+    // Filters without components never match
+    if (filter.active_filters == 0) {
+      continue;
+    }
+    uint32_t idx = filters.size();
+    filters.push_back(filter);
+
+    uint16_t flags = filter.active_filters & hashed_flags;
+    auto     tuple = std::find_if(tuples.begin(), tuples.end(), [flags](const tuple_t& t) { return t.flags == flags; });
+    if (tuple == tuples.end()) {
+      tuples.emplace_back();
+      tuple        = tuples.end() - 1;
+      tuple->flags = flags;
+    }
+    // The filters are visited in precedence order, so the lists of each entry remain sorted
+    tuple->table[make_key(flags, filter.protocol_id, filter.single_local_port, filter.single_remote_port)].push_back(
+        idx);
+  }
+}
+
+uint64_t tft_classifier::make_key(uint16_t flags, uint8_t protocol, uint16_t local_port, uint16_t remote_port)
+{
+  uint64_t key = 0;
+  if (flags & PROTOCOL_ID_FLAG) {
+    key |= (uint64_t)protocol << 32U;
+  }
+  if (flags & SINGLE_LOCAL_PORT_FLAG) {
+    key |= (uint64_t)local_port << 16U;
+  }
+  if (flags & SINGLE_REMOTE_PORT_FLAG) {
+    key |= remote_port;
+  }
+  return key;
+}
+
+const tft_packet_filter_t* tft_classifier::classify(const srsran::unique_byte_buffer_t& pdu) const
+{
+  struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
+  struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
+
+  // Extract the hashed components from the packet, at the same offsets used by the filter matching
+  uint8_t  protocol    = 0;
+  uint32_t l4_offset   = 0;
+  uint16_t local_port  = 0;
+  uint16_t remote_port = 0;
+  if (ip_pkt->version == 4) {
+    protocol  = ip_pkt->protocol;
+    l4_offset = ip_pkt->ihl * 4;
+  } else if (ip_pkt->version == 6) {
+    protocol  = ip6_pkt->nexthdr;
+    l4_offset = sizeof(ipv6hdr);
+  } else {
+    // Unknown versions are rare enough to be checked against every filter
+    for (const tft_packet_filter_t& filter : filters) {
+      if (filter.match(pdu)) {
+        return &filter;
+      }
+    }
+    return nullptr;
+  }
+  bool has_ports = protocol == UDP_PROTOCOL or protocol == TCP_PROTOCOL;
+  if (has_ports) {
+    // UDP and TCP headers start with the source and destination ports. The packet is outgoing, the source is local
+    struct udphdr* udp_pkt = (struct udphdr*)&pdu->msg[l4_offset];
+    local_port             = udp_pkt->source;
+    remote_port            = udp_pkt->dest;
+  }
+
+  uint32_t best = filters.size();
+  for (const tuple_t& tuple : tuples) {
+    // Single port components only match UDP and TCP packets
+    if (not has_ports and (tuple.flags & (SINGLE_LOCAL_PORT_FLAG | SINGLE_REMOTE_PORT_FLAG))) {
+      continue;
+    }
+    auto it = tuple.table.find(make_key(tuple.flags, protocol, local_port, remote_port));
+    if (it == tuple.table.end()) {
+      continue;
+    }
+    for (uint32_t idx : it->second) {
+      if (idx >= best) {
+        break;
+      }
+      if (filters[idx].match(pdu)) {
+        best = idx;
+        break;
+      }
+    }
+  }
+  return best < filters.size() ? &filters[best] : nullptr;
+}
+
 void tft_pdu_matcher::reset()
 {
+  std::lock_guard<std::mutex> lock(tft_mutex);
   tft_filter_map.clear();
+  update_classifier();
+}
+
+void tft_pdu_matcher::update_classifier()
+{
+  const tft_classifier* old_classifier =
+      classifier.exchange(new tft_classifier(tft_filter_map), std::memory_order_acq_rel);
+  // Wait for the packets being classified with the old classifier before releasing it
+  rcu.synchronize();
+  delete old_classifier;
 }
 
 /**
@@ -401,16 +507,18 @@ void tft_pdu_matcher::reset()
  */
 int tft_pdu_matcher::check_tft_filter_match(const srsran::unique_byte_buffer_t& pdu, uint8_t& eps_bearer_id)
 {
-  std::lock_guard<std::mutex> lock(tft_mutex);
-  for (std::pair<const uint16_t, tft_packet_filter_t>& filter_pair : tft_filter_map) {
-    bool match = filter_pair.second.match(pdu);
-    if (match) {
-      eps_bearer_id = filter_pair.second.eps_bearer_id;
-      logger.debug("Found filter match -- EPS bearer Id %d", filter_pair.second.eps_bearer_id);
-      return SRSRAN_SUCCESS;
-    }
+  srsran::rcu_domain::read_guard guard(rcu);
+  const tft_classifier*          c = classifier.load(std::memory_order_acquire);
+  if (c == nullptr) {
+    return SRSRAN_ERROR;
   }
-  return SRSRAN_ERROR;
+  const tft_packet_filter_t* filter = c->classify(pdu);
+  if (filter == nullptr) {
+    return SRSRAN_ERROR;
+  }
+  eps_bearer_id = filter->eps_bearer_id;
+  logger.debug("Found filter match -- EPS bearer Id %d", filter->eps_bearer_id);
+  return SRSRAN_SUCCESS;
 }
 
 /**
@@ -428,6 +536,7 @@ void tft_pdu_matcher::delete_tft_for_eps_bearer(const uint8_t eps_bearer_id)
   if (old_filter != tft_filter_map.end()) {
     logger.debug("Deleting TFT for EPS bearer %d", eps_bearer_id);
     tft_filter_map.erase(old_filter);
+    update_classifier();
   }
 }
 
@@ -445,6 +554,7 @@ int tft_pdu_matcher::apply_traffic_flow_template(const uint8_t&
         auto                it = tft_filter_map.insert(std::make_pair(filter.eval_precedence, filter));
         if (it.second == false) {
           logger.error("Error inserting TFT Packet Filter");
+          update_classifier(); // keep the filters applied before the error
           return SRSRAN_ERROR_CANT_START;
         }
       }
@@ -458,6 +568,7 @@ int tft_pdu_matcher::apply_traffic_flow_template(const uint8_t&
             });
         if (old_filter == tft_filter_map.end()) {
           logger.error("Error couldn't find TFT with id %d", tft->packet_filter_list[i].id);
+          update_classifier(); // keep the filters applied before the error
           return SRSRAN_ERROR_CANT_START;
         }
 
@@ -469,6 +580,7 @@ int tft_pdu_matcher::apply_traffic_flow_template(const uint8_t&
         auto                it = tft_filter_map.insert(std::make_pair(new_filter.eval_precedence, new_filter));
         if (it.second == false) {
           logger.error("Error inserting TFT Packet Filter");
+          update_classifier(); // keep the filters applied before the error
           return SRSRAN_ERROR_CANT_START;
         }
       }
@@ -477,6 +589,7 @@ int tft_pdu_matcher::apply_traffic_flow_template(const uint8_t&
       logger.error("Unhandled TFT OP code");
       return SRSRAN_ERROR_CANT_START;
   }
+  update_classifier();
   return SRSRAN_SUCCESS;
 }
 
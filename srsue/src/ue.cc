@@ -27,6 +27,7 @@
 #include "srsran/radio/radio_null.h"
 #include "srsran/srsran.h"
 #include "srsue/hdr/phy/dummy_phy.h"
+#include "srsue/hdr/phy/multi_ue_radio.h"
 #include "srsue/hdr/phy/phy.h"
 #include "srsue/hdr/phy/phy_nr_sa.h"
 #include "srsue/hdr/stack/ue_stack_lte.h"
@@ -47,6 +48,7 @@ ue::ue() : logger(srslog::fetch_basic_logger("UE", false)), sys_proc(logger)
 
 ue::~ue()
 {
+  extra_ues.clear();
   stack.reset();
 }
 
@@ -64,6 +66,10 @@ int ue::init(const all_args_t& args_)
     return SRSRAN_ERROR;
   }
 
+  if (args.general.nof_ues > 1) {
+    return init_multi_ue();
+  }
+
   // Instantiate layers and stack together our UE
   std::unique_ptr<ue_stack_lte> lte_stack(new ue_stack_lte);
   if (!lte_stack) {
@@ -91,6 +97,8 @@ int ue::init(const all_args_t& args_)
   phy_args_nr.worker_cpu_mask      = args.phy.worker_cpu_mask;
   phy_args_nr.log                  = args.phy.log;
   phy_args_nr.store_pdsch_ko       = args.phy.nr_store_pdsch_ko;
+  phy_args_nr.nof_rx_slots         = args.phy.nr_nof_rx_slots;
+  phy_args_nr.nof_search_threads   = args.phy.nr_search_threads;
   phy_args_nr.srate_hz             = args.rf.srate_hz;
 
   // init layers
@@ -174,6 +182,110 @@ int ue::init(const all_args_t& args_)
   return ret;
 }
 
+int ue::init_multi_ue()
+{
+  int      ret     = SRSRAN_SUCCESS;
+  uint32_t nof_ues = args.general.nof_ues;
+
+  std::unique_ptr<multi_ue_radio> shared_radio(new multi_ue_radio(nof_ues));
+
+  std::vector<std::unique_ptr<srsue::phy>>   phys;
+  std::vector<std::unique_ptr<ue_stack_lte>> stacks;
+  std::vector<std::unique_ptr<gw>>           gws;
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    phys.emplace_back(new srsue::phy);
+    stacks.emplace_back(new ue_stack_lte);
+    gws.emplace_back(new gw(srslog::fetch_basic_logger("GW", false)));
+    shared_radio->set_phy(i, phys.back().get());
+  }
+
+  if (shared_radio->init(args.rf, nullptr)) {
+    srsran::console("Error initializing radio.\n");
+    return SRSRAN_ERROR;
+  }
+
+  // from here onwards do not exit immediately if something goes wrong as sub-layers may already use interfaces
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    all_args_t ue_args = get_ue_args(args, i);
+    if (phys[i]->init(ue_args.phy, stacks[i].get(), shared_radio->get_port(i))) {
+      srsran::console("Error initializing PHY of UE %d.\n", i);
+      ret = SRSRAN_ERROR;
+    }
+    if (stacks[i]->init(ue_args.stack, phys[i].get(), phys[i].get(), gws[i].get())) {
+      srsran::console("Error initializing stack of UE %d.\n", i);
+      ret = SRSRAN_ERROR;
+    }
+    if (gws[i]->init(ue_args.gw, stacks[i].get())) {
+      srsran::console("Error initializing GW of UE %d.\n", i);
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  // move ownership, the first UE provides the metrics and the plots
+  phy     = std::move(phys[0]);
+  stack   = std::move(stacks[0]);
+  gw_inst = std::move(gws[0]);
+  radio   = std::move(shared_radio);
+  extra_ues.resize(nof_ues - 1);
+  for (uint32_t i = 1; i < nof_ues; i++) {
+    extra_ues[i - 1].phy     = std::move(phys[i]);
+    extra_ues[i - 1].stack   = std::move(stacks[i]);
+    extra_ues[i - 1].gw_inst = std::move(gws[i]);
+  }
+
+  srsran::console("Waiting PHY of %d UEs to initialize ... ", nof_ues);
+  phy->wait_initialize();
+  for (extra_ue_t& u : extra_ues) {
+    u.phy->wait_initialize();
+  }
+  srsran::console("done!\n");
+  return ret;
+}
+
+/// Adds n to a number written with a fixed number of digits, e.g. an IMSI
+static std::string add_to_digits(const std::string& digits, uint32_t n)
+{
+  if (digits.empty() or not std::all_of(digits.begin(), digits.end(), ::isdigit)) {
+    return digits;
+  }
+  std::string ret = std::to_string(std::stoull(digits) + n);
+  if (ret.size() < digits.size()) {
+    ret.insert(0, digits.size() - ret.size(), '0');
+  }
+  return ret;
+}
+
+/// Appends the suffix to a filename before its extension
+static std::string add_to_filename(const std::string& filename, const std::string& suffix)
+{
+  size_t dot   = filename.rfind('.');
+  size_t slash = filename.rfind('/');
+  if (dot == std::string::npos or (slash != std::string::npos and dot < slash)) {
+    return filename + suffix;
+  }
+  return filename.substr(0, dot) + suffix + filename.substr(dot);
+}
+
+all_args_t ue::get_ue_args(const all_args_t& args, uint32_t ue_idx)
+{
+  all_args_t ue_args = args;
+  if (ue_idx == 0) {
+    return ue_args;
+  }
+
+  // The identities and the host resources of the other UEs are derived from those of the first one
+  std::string suffix                        = "_" + std::to_string(ue_idx);
+  ue_args.stack.usim.imsi                   = add_to_digits(args.stack.usim.imsi, ue_idx);
+  ue_args.stack.usim.imei                   = add_to_digits(args.stack.usim.imei, ue_idx);
+  ue_args.gw.tun_dev_name                   = args.gw.tun_dev_name + suffix;
+  ue_args.stack.pkt_trace.mac_pcap.filename = add_to_filename(args.stack.pkt_trace.mac_pcap.filename, suffix);
+  ue_args.stack.pkt_trace.nas_pcap.filename = add_to_filename(args.stack.pkt_trace.nas_pcap.filename, suffix);
+  if (not args.gw.netns.empty()) {
+    ue_args.gw.netns = args.gw.netns + suffix;
+  }
+  return ue_args;
+}
+
 int ue::parse_args(const all_args_t& args_)
 {
   // set member variable
@@ -287,6 +399,25 @@ int ue::parse_args(const all_args_t& args_)
     return SRSRAN_ERROR;
   }
 
+  // Several simulated UEs share one LTE radio, each one with its own USIM
+  if (args.general.nof_ues == 0) {
+    args.general.nof_ues = 1;
+  }
+  if (args.general.nof_ues > 1) {
+    if (args.phy.nof_lte_carriers == 0 or args.phy.nof_nr_carriers > 0) {
+      srsran::console("Error. Several UEs (ue.nof_ues=%d) are only supported in LTE mode.\n", args.general.nof_ues);
+      return SRSRAN_ERROR;
+    }
+    if (args.stack.usim.mode != "soft") {
+      srsran::console("Error. Several UEs (ue.nof_ues=%d) require usim.mode=soft.\n", args.general.nof_ues);
+      return SRSRAN_ERROR;
+    }
+    if (not std::isnormal(args.rf.srate_hz)) {
+      srsran::console("Error. Several UEs (ue.nof_ues=%d) require a fixed RF sampling rate.\n", args.general.nof_ues);
+      return SRSRAN_ERROR;
+    }
+  }
+
   // SA params
   if (args.phy.nof_lte_carriers == 0 && args.phy.nof_nr_carriers > 0) {
     // Update NAS-5G args
@@ -331,14 +462,23 @@ void ue::stop()
   if (stack) {
     stack->stop();
   }
+  for (extra_ue_t& u : extra_ues) {
+    u.stack->stop();
+  }
 
   if (gw_inst) {
     gw_inst->stop();
   }
+  for (extra_ue_t& u : extra_ues) {
+    u.gw_inst->stop();
+  }
 
   if (phy) {
     phy->stop();
   }
+  for (extra_ue_t& u : extra_ues) {
+    u.phy->stop();
+  }
 
   if (radio) {
     radio->stop();
@@ -347,7 +487,11 @@ void ue::stop()
 
 bool ue::switch_on()
 {
-  return stack->switch_on();
+  bool ret = stack->switch_on();
+  for (extra_ue_t& u : extra_ues) {
+    ret &= u.stack->switch_on();
+  }
+  return ret;
 }
 
 bool ue::switch_off()
@@ -355,21 +499,35 @@ bool ue::switch_off()
   if (gw_inst) {
     gw_inst->stop();
   }
+  for (extra_ue_t& u : extra_ues) {
+    u.gw_inst->stop();
+  }
 
   // send switch off
   stack->switch_off();
+  for (extra_ue_t& u : extra_ues) {
+    u.stack->switch_off();
+  }
 
   // wait for max. 5s for it to be sent (according to TS 24.301 Sec 25.5.2.2)
-  int             cnt = 0, timeout_s = 5;
-  stack_metrics_t metrics = {};
-  stack->get_metrics(&metrics);
+  int  cnt = 0, timeout_s = 5;
+  auto is_idle = [this]() {
+    stack_metrics_t metrics = {};
+    stack->get_metrics(&metrics);
+    bool idle = metrics.rrc.state == RRC_STATE_IDLE;
+    for (extra_ue_t& u : extra_ues) {
+      metrics = {};
+      u.stack->get_metrics(&metrics);
+      idle &= metrics.rrc.state == RRC_STATE_IDLE;
+    }
+    return idle;
+  };
 
-  while (metrics.rrc.state != RRC_STATE_IDLE && ++cnt <= timeout_s) {
+  while (not is_idle() && ++cnt <= timeout_s) {
     std::this_thread::sleep_for(std::chrono::seconds(1));
-    stack->get_metrics(&metrics);
   }
 
-  if (metrics.rrc.state != RRC_STATE_IDLE) {
+  if (not is_idle()) {
     srslog::fetch_basic_logger("NAS").warning("Detach couldn't be sent after %ds.", timeout_s);
     return false;
   }
@@ -391,6 +549,7 @@ bool ue::get_metrics(ue_metrics_t* m)
   stack->get_metrics(&m->stack);
   gw_inst->get_metrics(m->gw, m->stack.mac[0].nof_tti);
   m->sys = sys_proc.get_metrics();
+  srsran::get_stage_metrics(m->stages);
   return true;
 }
 